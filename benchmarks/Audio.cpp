@@ -0,0 +1,436 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Benchmark.hpp"
+#include <SFML/Audio.hpp>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+    const unsigned int sampleRate = 44100;
+    const unsigned int channelCount = 2;
+
+    ////////////////////////////////////////////////////////////
+    // Decode a whole sound file from memory
+    ////////////////////////////////////////////////////////////
+    struct DecodeTask
+    {
+        void operator ()()
+        {
+            sf::InputSoundFile file;
+            if (!file.openFromMemory(&data[0], data.size()))
+                return;
+
+            while (file.read(&samples[0], samples.size()) > 0)
+                ;
+        }
+
+        std::vector<char>      data;
+        std::vector<sf::Int16> samples;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Ten seconds of a chord with a bit of noise, so that the encoders have some work to do
+    ////////////////////////////////////////////////////////////
+    std::vector<sf::Int16> makeMusic()
+    {
+        std::vector<sf::Int16> music(sampleRate * channelCount * 10);
+        for (std::size_t i = 0; i < music.size(); ++i)
+        {
+            double time = static_cast<double>(i / channelCount) / sampleRate;
+            double value = std::sin(time * 2 * 3.14159265 * 220) + std::sin(time * 2 * 3.14159265 * 277) +
+                           std::sin(time * 2 * 3.14159265 * 330) + (std::rand() % 1000) / 1000.0 - 0.5;
+            music[i] = static_cast<sf::Int16>(value * 6000);
+        }
+
+        return music;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Encode the same music in every format, then decode it
+    ////////////////////////////////////////////////////////////
+    void benchmarkDecoding(Report& report)
+    {
+        std::vector<sf::Int16> music = makeMusic();
+
+        const char* formats[] = {"wav", "ogg", "flac"};
+        for (std::size_t i = 0; i < sizeof(formats) / sizeof(*formats); ++i)
+        {
+            std::string filename = std::string("sfml-benchmark.") + formats[i];
+
+            // The file is written when the output is destroyed
+            {
+                sf::OutputSoundFile output;
+                if (!output.openFromFile(filename, sampleRate, channelCount))
+                    continue;
+                output.write(&music[0], music.size());
+            }
+
+            // The files are decoded from memory, so that the disk is not measured
+            DecodeTask task;
+            std::ifstream file(filename.c_str(), std::ios_base::binary);
+            task.data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            task.samples.resize(4096);
+            file.close();
+            std::remove(filename.c_str());
+
+            if (!task.data.empty())
+                run(report, "audio", "decode", formats[i], task, static_cast<double>(music.size()), "samples");
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Encode a music to a FLAC file, optionally with a task scheduler
+    ////////////////////////////////////////////////////////////
+    struct EncodeTask
+    {
+        void operator ()()
+        {
+            sf::OutputSoundFile file;
+            file.setTaskScheduler(scheduler);
+            if (file.openFromFile(filename, sampleRate, channelCount))
+                file.write(&(*music)[0], music->size());
+        }
+
+        const std::vector<sf::Int16>* music;
+        sf::TaskScheduler*            scheduler;
+        std::string                   filename;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Encode several FLAC files at once, one per task
+    ////////////////////////////////////////////////////////////
+    struct EncodeFile
+    {
+        void operator ()(std::size_t index) const
+        {
+            (*files)[index]();
+        }
+
+        std::vector<EncodeTask>* files;
+    };
+
+    struct BatchEncodeTask
+    {
+        void operator ()()
+        {
+            EncodeFile encode = {&files};
+            scheduler->parallelFor(0, files.size(), encode, 1);
+        }
+
+        std::vector<EncodeTask> files;
+        sf::TaskScheduler*      scheduler;
+    };
+
+    void benchmarkEncoding(Report& report)
+    {
+        std::vector<sf::Int16> music = makeMusic();
+        sf::TaskScheduler scheduler;
+
+        EncodeTask single = {&music, NULL, "sfml-benchmark.flac"};
+        run(report, "audio", "encode_flac", "single thread", single, static_cast<double>(music.size()), "samples", 20);
+
+        EncodeTask parallel = {&music, &scheduler, "sfml-benchmark.flac"};
+        run(report, "audio", "encode_flac", "frames in parallel", parallel, static_cast<double>(music.size()), "samples", 20);
+        std::remove("sfml-benchmark.flac");
+
+        // A batch of files, each one encoded on a single thread
+        BatchEncodeTask batch;
+        batch.scheduler = &scheduler;
+        for (unsigned int i = 0; i < scheduler.getWorkerCount() * 2; ++i)
+        {
+            std::ostringstream filename;
+            filename << "sfml-benchmark-" << i << ".flac";
+            EncodeTask file = {&music, NULL, filename.str()};
+            batch.files.push_back(file);
+        }
+
+        std::ostringstream name;
+        name << batch.files.size() << " files in parallel";
+        run(report, "audio", "encode_flac", name.str(), batch, static_cast<double>(music.size() * batch.files.size()), "samples", 5);
+
+        for (std::size_t i = 0; i < batch.files.size(); ++i)
+            std::remove(batch.files[i].filename.c_str());
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Run an effect over a chunk of stereo music, as a stream does
+    ////////////////////////////////////////////////////////////
+    struct EffectTask
+    {
+        void operator ()()
+        {
+            effect->process(&samples[0], samples.size() / channelCount, channelCount, sampleRate);
+        }
+
+        sf::SoundEffect*   effect;
+        std::vector<float> samples;
+    };
+
+    void benchmarkEffects(Report& report)
+    {
+        std::vector<sf::Int16> music = makeMusic();
+
+        sf::BiquadFilter filter(sf::BiquadFilter::LowPass, 800.f);
+        sf::GainRamp gain;
+        sf::Compressor compressor;
+
+        // A ramp much longer than the benchmark measures the slowest path of the gain
+        gain.setGain(0.5f, sf::seconds(1000));
+        sf::SoundEffect* effects[] = {&filter, &gain, &compressor};
+        const char* names[] = {"biquad filter", "gain ramp", "compressor"};
+
+        for (std::size_t i = 0; i < sizeof(effects) / sizeof(*effects); ++i)
+        {
+            EffectTask task;
+            task.effect = effects[i];
+            task.samples.resize(4096 * channelCount);
+            for (std::size_t j = 0; j < task.samples.size(); ++j)
+                task.samples[j] = music[j] / 32768.f;
+
+            run(report, "audio", "effect", names[i], task, static_cast<double>(task.samples.size()), "samples");
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Look for the finished sounds among many playing ones, as a game recycling its sounds does
+    ////////////////////////////////////////////////////////////
+    struct StatusTask
+    {
+        void operator ()()
+        {
+            if (batched)
+            {
+                sf::Sound::updateStatuses(&finished);
+                finished.clear();
+            }
+            else
+            {
+                for (std::size_t i = 0; i < sounds->size(); ++i)
+                {
+                    if ((*sounds)[i].getStatus() == sf::Sound::Stopped)
+                        finished.push_back(&(*sounds)[i]);
+                }
+                finished.clear();
+            }
+        }
+
+        std::vector<sf::Sound>* sounds;
+        std::vector<sf::Sound*> finished;
+        bool                    batched;
+    };
+
+    void benchmarkStatuses(Report& report)
+    {
+        // Looping silence, so that all the sounds keep their voice during the benchmark
+        std::vector<sf::Int16> silence(sampleRate * channelCount, 0);
+        sf::SoundBuffer buffer;
+        if (!buffer.loadFromSamples(&silence[0], silence.size(), channelCount, sampleRate))
+            return;
+
+        std::vector<sf::Sound> sounds(sf::Sound::getVoiceCount(), sf::Sound(buffer));
+        for (std::size_t i = 0; i < sounds.size(); ++i)
+        {
+            sounds[i].setLoop(true);
+            sounds[i].play();
+        }
+
+        std::ostringstream name;
+        name << sounds.size() << " playing sounds";
+
+        // The per-sound queries go first: the statuses are cached after the first batched update
+        StatusTask task;
+        task.sounds = &sounds;
+        task.batched = false;
+        run(report, "audio", "sound_status", name.str() + ", getStatus", task, static_cast<double>(sounds.size()), "sounds");
+
+        task.batched = true;
+        run(report, "audio", "sound_status", name.str() + ", updateStatuses", task, static_cast<double>(sounds.size()), "sounds");
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Stream of silence recording when it is asked for data
+    ////////////////////////////////////////////////////////////
+    class RefillStream : public sf::SoundStream
+    {
+    public:
+
+        RefillStream(std::size_t frameCount) :
+        m_samples   (frameCount * channelCount, 0),
+        m_refills   (0),
+        m_lastRefill(0)
+        {
+            initialize(channelCount, sampleRate);
+        }
+
+        std::vector<sf::Int64> getIntervals()
+        {
+            sf::Lock lock(m_mutex);
+            return m_intervals;
+        }
+
+    private:
+
+        virtual bool onGetData(Chunk& data)
+        {
+            {
+                sf::Lock lock(m_mutex);
+
+                // The first refills fill the whole queue at once, they don't tell anything about the timing
+                sf::Int64 now = m_clock.getElapsedTime().asMicroseconds();
+                if (++m_refills > getBufferCount())
+                    m_intervals.push_back(now - m_lastRefill);
+                m_lastRefill = now;
+            }
+
+            data.samples = &m_samples[0];
+            data.sampleCount = m_samples.size();
+            return true;
+        }
+
+        virtual void onSeek(sf::Time)
+        {
+        }
+
+        std::vector<sf::Int16> m_samples;
+        sf::Mutex              m_mutex;
+        sf::Clock              m_clock;
+        unsigned int           m_refills;
+        sf::Int64              m_lastRefill;
+        std::vector<sf::Int64> m_intervals;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Measure how regularly a stream is refilled, compared to the duration of its chunks
+    ////////////////////////////////////////////////////////////
+    void benchmarkStreamRefills(Report& report, std::size_t frameCount)
+    {
+        RefillStream stream(frameCount);
+        stream.play();
+        sf::sleep(sf::seconds(3));
+        sf::SoundStream::Statistics statistics = stream.getStatistics();
+        stream.stop();
+
+        std::vector<sf::Int64> intervals = stream.getIntervals();
+        if (intervals.empty())
+            return;
+
+        double expected = frameCount * 1000000.0 / sampleRate;
+        double deviation = 0;
+        for (std::size_t i = 0; i < intervals.size(); ++i)
+            deviation += (intervals[i] - expected) * (intervals[i] - expected);
+
+        std::ostringstream name;
+        name << frameCount << " frames per chunk";
+        report.begin("audio", "stream_refill", name.str());
+        report.add("refills", static_cast<double>(intervals.size()));
+        report.add("expected_us", expected);
+        report.add("jitter_us", std::sqrt(deviation / intervals.size()));
+        report.add("underruns", static_cast<double>(statistics.underruns));
+        report.add("refill_latency_p99_us", static_cast<double>(statistics.refillLatency99.asMicroseconds()));
+        addPercentiles(report, intervals);
+        report.end();
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Recorder measuring how late the captured samples are delivered
+    ////////////////////////////////////////////////////////////
+    class LatencyRecorder : public sf::SoundRecorder
+    {
+    public:
+
+        LatencyRecorder() :
+        m_samples      (0),
+        m_firstDelivery(-1)
+        {
+            setProcessingInterval(sf::milliseconds(10));
+        }
+
+        void start()
+        {
+            m_clock.restart();
+            sf::SoundRecorder::start(sampleRate);
+        }
+
+        sf::Int64 getFirstDelivery()
+        {
+            sf::Lock lock(m_mutex);
+            return m_firstDelivery;
+        }
+
+        std::vector<sf::Int64> getLatencies()
+        {
+            sf::Lock lock(m_mutex);
+            return m_latencies;
+        }
+
+    private:
+
+        virtual bool onProcessSamples(const sf::Int16*, std::size_t sampleCount)
+        {
+            sf::Lock lock(m_mutex);
+
+            // The samples delivered so far cover the first part of the time elapsed since the
+            // capture started, the rest is the latency of the capture (and of the start of the device)
+            sf::Int64 now = m_clock.getElapsedTime().asMicroseconds();
+            if (m_firstDelivery < 0)
+                m_firstDelivery = now;
+
+            m_samples += sampleCount;
+            m_latencies.push_back(now - static_cast<sf::Int64>(m_samples * 1000000 / sampleRate));
+
+            return true;
+        }
+
+        sf::Mutex              m_mutex;
+        sf::Clock              m_clock;
+        sf::Uint64             m_samples;
+        sf::Int64              m_firstDelivery;
+        std::vector<sf::Int64> m_latencies;
+    };
+
+    void benchmarkCapture(Report& report)
+    {
+        if (!sf::SoundRecorder::isAvailable())
+            return;
+
+        LatencyRecorder recorder;
+        recorder.start();
+        sf::sleep(sf::seconds(3));
+        recorder.stop();
+
+        std::vector<sf::Int64> latencies = recorder.getLatencies();
+        if (latencies.empty())
+            return;
+
+        report.begin("audio", "capture_latency", "10 ms processing interval");
+        report.add("first_delivery_us", static_cast<double>(recorder.getFirstDelivery()));
+        report.add("deliveries", static_cast<double>(latencies.size()));
+        addPercentiles(report, latencies);
+        report.end();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void runAudioBenchmarks(Report& report)
+{
+    benchmarkDecoding(report);
+    benchmarkEncoding(report);
+    benchmarkEffects(report);
+    benchmarkStatuses(report);
+
+    benchmarkStreamRefills(report, 512);
+    benchmarkStreamRefills(report, 4096);
+
+    benchmarkCapture(report);
+}
@@ -0,0 +1,91 @@
+
+#ifndef SFML_BENCHMARK_HPP
+#define SFML_BENCHMARK_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System.hpp>
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+////////////////////////////////////////////////////////////
+// Writes the results of the benchmarks as a JSON document:
+// {"results": [{"suite": "...", "benchmark": "...", "case": "...", ...}, ...]}
+//
+// Every result has the suite, benchmark and case names, the
+// other fields depend on what is measured.
+////////////////////////////////////////////////////////////
+class Report
+{
+public:
+
+    Report(std::ostream& stream);
+    ~Report();
+
+    void begin(const char* suite, const char* benchmark, const std::string& name);
+    void add(const char* key, double value);
+    void add(const char* key, const std::string& value);
+    void end();
+
+private:
+
+    void writeKey(const char* key);
+    void writeString(const std::string& value);
+
+    std::ostream& m_stream;
+    bool          m_firstResult;
+};
+
+
+////////////////////////////////////////////////////////////
+// Add the 50th, 90th and 99th percentiles and the maximum of
+// durations, in microseconds, to the current result
+////////////////////////////////////////////////////////////
+void addPercentiles(Report& report, std::vector<sf::Int64>& microseconds);
+
+
+////////////////////////////////////////////////////////////
+// Run a task until enough time has elapsed, and report its throughput
+//
+// The first call of the task is not measured, it fills the
+// caches and allocates the resources.
+////////////////////////////////////////////////////////////
+template <typename Task>
+void run(Report& report, const char* suite, const char* benchmark, const std::string& name, Task& task,
+         double itemsPerIteration, const char* item, int maxIterations = 1000000)
+{
+    const sf::Time minDuration = sf::milliseconds(500);
+
+    task();
+
+    int iterations = 0;
+    sf::Clock clock;
+    do
+    {
+        task();
+        ++iterations;
+    }
+    while ((clock.getElapsedTime() < minDuration) && (iterations < maxIterations));
+    double seconds = clock.getElapsedTime().asNanoseconds() / 1000000000.0;
+
+    report.begin(suite, benchmark, name);
+    report.add("iterations", iterations);
+    report.add("ms_per_iteration", seconds * 1000 / iterations);
+    report.add("items_per_second", itemsPerIteration * iterations / seconds);
+    report.add("item", item);
+    report.end();
+}
+
+
+////////////////////////////////////////////////////////////
+// Suites
+////////////////////////////////////////////////////////////
+void runGraphicsBenchmarks(Report& report);
+void runNetworkBenchmarks(Report& report);
+void runAudioBenchmarks(Report& report);
+
+
+#endif // SFML_BENCHMARK_HPP
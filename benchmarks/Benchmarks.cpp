@@ -0,0 +1,153 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Benchmark.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+
+////////////////////////////////////////////////////////////
+Report::Report(std::ostream& stream) :
+m_stream     (stream),
+m_firstResult(true)
+{
+    m_stream << "{\"results\": [";
+}
+
+
+////////////////////////////////////////////////////////////
+Report::~Report()
+{
+    m_stream << "\n]}" << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////
+void Report::begin(const char* suite, const char* benchmark, const std::string& name)
+{
+    m_stream << (m_firstResult ? "\n    {" : ",\n    {");
+    m_firstResult = false;
+
+    m_stream << "\"suite\": ";
+    writeString(suite);
+    add("benchmark", benchmark);
+    add("case", name);
+}
+
+
+////////////////////////////////////////////////////////////
+void Report::add(const char* key, double value)
+{
+    writeKey(key);
+
+    // JSON has no representation of infinities and NaNs
+    if ((value == value) && (value - value == 0))
+        m_stream << value;
+    else
+        m_stream << "null";
+}
+
+
+////////////////////////////////////////////////////////////
+void Report::add(const char* key, const std::string& value)
+{
+    writeKey(key);
+    writeString(value);
+}
+
+
+////////////////////////////////////////////////////////////
+void Report::end()
+{
+    m_stream << '}' << std::flush;
+}
+
+
+////////////////////////////////////////////////////////////
+void Report::writeKey(const char* key)
+{
+    m_stream << ", ";
+    writeString(key);
+    m_stream << ": ";
+}
+
+
+////////////////////////////////////////////////////////////
+void Report::writeString(const std::string& value)
+{
+    m_stream << '"';
+    for (std::string::const_iterator it = value.begin(); it != value.end(); ++it)
+    {
+        if ((*it == '"') || (*it == '\\'))
+            m_stream << '\\' << *it;
+        else if (static_cast<unsigned char>(*it) < 0x20)
+            m_stream << ' ';
+        else
+            m_stream << *it;
+    }
+    m_stream << '"';
+}
+
+
+////////////////////////////////////////////////////////////
+void addPercentiles(Report& report, std::vector<sf::Int64>& microseconds)
+{
+    if (microseconds.empty())
+        return;
+
+    std::sort(microseconds.begin(), microseconds.end());
+    std::size_t last = microseconds.size() - 1;
+
+    report.add("p50_us", static_cast<double>(microseconds[last * 50 / 100]));
+    report.add("p90_us", static_cast<double>(microseconds[last * 90 / 100]));
+    report.add("p99_us", static_cast<double>(microseconds[last * 99 / 100]));
+    report.add("max_us", static_cast<double>(microseconds[last]));
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// The suites to run can be given on the command line
+/// (graphics, network, audio); all of them run by default.
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    bool graphics = (argc < 2);
+    bool network = (argc < 2);
+    bool audio = (argc < 2);
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "graphics") == 0)
+            graphics = true;
+        else if (std::strcmp(argv[i], "network") == 0)
+            network = true;
+        else if (std::strcmp(argv[i], "audio") == 0)
+            audio = true;
+        else
+        {
+            std::cerr << "Unknown suite \"" << argv[i] << "\", expected graphics, network or audio" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // The results are written to the standard output, the errors of SFML stay on the error output
+    {
+        Report report(std::cout);
+
+        if (graphics)
+            runGraphicsBenchmarks(report);
+        if (network)
+            runNetworkBenchmarks(report);
+        if (audio)
+            runAudioBenchmarks(report);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,545 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Benchmark.hpp"
+#include <SFML/Graphics.hpp>
+#include <SFML/OpenGL.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+    const unsigned int targetWidth = 1024;
+    const unsigned int targetHeight = 768;
+
+    ////////////////////////////////////////////////////////////
+    // Run a task drawing into the target, the GPU work of each
+    // iteration is waited for before the clock is read
+    ////////////////////////////////////////////////////////////
+    template <typename Task>
+    struct FinishedTask
+    {
+        void operator ()()
+        {
+            (*task)();
+
+            target->display();
+            if (target->setActive(true))
+                glFinish();
+        }
+
+        Task*              task;
+        sf::RenderTexture* target;
+    };
+
+    template <typename Task>
+    void runOnTarget(Report& report, const char* benchmark, const std::string& name, Task& task, sf::RenderTexture& target,
+                     double itemsPerIteration, const char* item, int maxIterations = 1000000)
+    {
+        FinishedTask<Task> finishedTask = {&task, &target};
+        run(report, "graphics", benchmark, name, finishedTask, itemsPerIteration, item, maxIterations);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Return a random value in [0, max)
+    ////////////////////////////////////////////////////////////
+    float random(float max)
+    {
+        return static_cast<float>(std::rand()) / (static_cast<float>(RAND_MAX) + 1.f) * max;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Draw sprites which share one texture or each have their own
+    ////////////////////////////////////////////////////////////
+    struct SpriteTask
+    {
+        void operator ()()
+        {
+            target->clear();
+            for (std::size_t i = 0; i < sprites.size(); ++i)
+                target->draw(sprites[i]);
+        }
+
+        sf::RenderTexture*      target;
+        std::vector<sf::Sprite> sprites;
+    };
+
+    // Same sprites, drawn through an explicit batch grouped by texture
+    struct SpriteBatchTask
+    {
+        void operator ()()
+        {
+            target->clear();
+            batch.begin(*target, sf::SpriteBatch::ByTexture);
+            for (std::size_t i = 0; i < sprites->size(); ++i)
+                batch.draw((*sprites)[i]);
+            batch.end();
+        }
+
+        sf::RenderTexture*             target;
+        const std::vector<sf::Sprite>* sprites;
+        sf::SpriteBatch                batch;
+    };
+
+    void benchmarkSprites(Report& report, sf::RenderTexture& target, std::size_t spriteCount, std::size_t textureCount)
+    {
+        std::vector<sf::Uint8> pixels(16 * 16 * 4, 255);
+        std::vector<sf::Texture> textures(textureCount);
+        for (std::size_t i = 0; i < textureCount; ++i)
+        {
+            textures[i].create(16, 16);
+            textures[i].update(&pixels[0]);
+        }
+
+        SpriteTask task;
+        task.target = &target;
+        for (std::size_t i = 0; i < spriteCount; ++i)
+        {
+            sf::Sprite sprite(textures[i % textureCount]);
+            sprite.setPosition(random(targetWidth), random(targetHeight));
+            task.sprites.push_back(sprite);
+        }
+
+        std::ostringstream name;
+        name << spriteCount << " sprites/" << textureCount << (textureCount > 1 ? " textures" : " texture");
+        runOnTarget(report, "sprites", name.str(), task, target, static_cast<double>(spriteCount), "sprites");
+
+        SpriteBatchTask batchTask;
+        batchTask.target = &target;
+        batchTask.sprites = &task.sprites;
+        runOnTarget(report, "sprite_batch", name.str(), batchTask, target, static_cast<double>(spriteCount), "sprites");
+
+        target.clear();
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Draw large overlapping sprites of a disc, as full quads or
+    // trimmed to the disc, to measure the fill rate saved
+    ////////////////////////////////////////////////////////////
+    template <typename SpriteType>
+    struct OverdrawTask
+    {
+        void operator ()()
+        {
+            target->clear();
+            batch.begin(*target);
+            for (std::size_t i = 0; i < sprites.size(); ++i)
+                batch.draw(sprites[i]);
+            batch.end();
+        }
+
+        sf::RenderTexture*      target;
+        std::vector<SpriteType> sprites;
+        sf::SpriteBatch         batch;
+    };
+
+    void benchmarkOverdraw(Report& report, sf::RenderTexture& target, std::size_t spriteCount)
+    {
+        const unsigned int size = 256;
+        sf::Image image;
+        image.create(size, size, sf::Color::Transparent);
+        for (unsigned int y = 0; y < size; ++y)
+            for (unsigned int x = 0; x < size; ++x)
+                if ((x - size / 2.f) * (x - size / 2.f) + (y - size / 2.f) * (y - size / 2.f) < size * size / 4.f)
+                    image.setPixel(x, y, sf::Color::White);
+
+        sf::Texture texture;
+        texture.loadFromImage(image);
+        sf::SpriteMesh mesh;
+        mesh.loadFromImage(image, sf::IntRect(), 8);
+
+        OverdrawTask<sf::Sprite> quadTask;
+        OverdrawTask<sf::TrimmedSprite> trimmedTask;
+        quadTask.target = &target;
+        trimmedTask.target = &target;
+        for (std::size_t i = 0; i < spriteCount; ++i)
+        {
+            sf::Vector2f position(random(targetWidth - size), random(targetHeight - size));
+            quadTask.sprites.push_back(sf::Sprite(texture));
+            quadTask.sprites.back().setPosition(position);
+            trimmedTask.sprites.push_back(sf::TrimmedSprite(texture, mesh));
+            trimmedTask.sprites.back().setPosition(position);
+        }
+
+        std::ostringstream name;
+        name << spriteCount << " discs of " << size << 'x' << size;
+        runOnTarget(report, "sprite_overdraw", name.str() + ", quads", quadTask, target, static_cast<double>(spriteCount), "sprites");
+        runOnTarget(report, "sprite_overdraw", name.str() + ", trimmed to 8 points", trimmedTask, target, static_cast<double>(spriteCount), "sprites");
+
+        target.clear();
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Compute the geometry of a text, with glyphs already in the cache or not
+    ////////////////////////////////////////////////////////////
+    struct TextTask
+    {
+        void operator ()()
+        {
+            // Changing the string or the size invalidates the geometry, getLocalBounds updates it
+            if (growSize)
+                text.setCharacterSize(text.getCharacterSize() + 1);
+            else
+                text.setString(((++iteration) % 2) ? first : second);
+
+            text.getLocalBounds();
+        }
+
+        sf::Text   text;
+        sf::String first;
+        sf::String second;
+        bool       growSize;
+        int        iteration;
+    };
+
+    void benchmarkText(Report& report, sf::RenderTexture& target, const sf::Font& font)
+    {
+        // A paragraph of the printable ASCII characters
+        std::string line;
+        for (char c = ' '; c <= '~'; ++c)
+            line += c;
+        std::string paragraph;
+        for (int i = 0; i < 10; ++i)
+            paragraph += line + '\n';
+
+        TextTask task;
+        task.text.setFont(font);
+        task.text.setCharacterSize(20);
+        task.first = paragraph;
+        task.second = paragraph + ' ';
+        task.iteration = 0;
+
+        // The glyphs are rasterized once, then every layout finds them in the cache
+        task.growSize = false;
+        runOnTarget(report, "text", "layout, glyph cache hits", task, target, static_cast<double>(paragraph.size()), "characters");
+
+        // Every size needs new glyphs; the count is capped so that they stay reasonably small
+        task.text.setString(paragraph);
+        task.growSize = true;
+        runOnTarget(report, "text", "layout, glyph cache misses", task, target, static_cast<double>(paragraph.size()), "characters", 64);
+
+        // A long paragraph wrapped to a fixed width, edited at its end: only the last lines are flowed again
+        std::string words;
+        for (int i = 0; i < 200; ++i)
+            words += (i % 3) ? "lorem " : "ipsum ";
+
+        TextTask wrapped;
+        wrapped.text.setFont(font);
+        wrapped.text.setCharacterSize(20);
+        wrapped.text.setMaxWidth(300.f);
+        wrapped.first = words + "dolor";
+        wrapped.second = words + "sit";
+        wrapped.growSize = false;
+        wrapped.iteration = 0;
+        runOnTarget(report, "text", "wrapped layout, edit at the end", wrapped, target, static_cast<double>(words.size()), "characters");
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Draw a sprite between blocks of raw OpenGL, saving the states around it
+    ////////////////////////////////////////////////////////////
+    struct GLStatesTask
+    {
+        void operator ()()
+        {
+            if (scope)
+            {
+                sf::GLStateScope states(*target);
+                target->draw(sprite);
+            }
+            else
+            {
+                target->pushGLStates();
+                target->draw(sprite);
+                target->popGLStates();
+            }
+        }
+
+        sf::RenderTexture* target;
+        sf::Sprite         sprite;
+        bool               scope;
+    };
+
+    void benchmarkGLStates(Report& report, sf::RenderTexture& target)
+    {
+        sf::Texture texture;
+        if (!texture.create(64, 64))
+            return;
+
+        GLStatesTask task;
+        task.target = &target;
+        task.sprite.setTexture(texture);
+
+        task.scope = false;
+        runOnTarget(report, "gl_states", "push/pop", task, target, 1, "draws");
+
+        task.scope = true;
+        runOnTarget(report, "gl_states", "scope", task, target, 1, "draws");
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Recompute the points of shapes
+    ////////////////////////////////////////////////////////////
+    struct ShapeTask
+    {
+        void operator ()()
+        {
+            radius = (radius < 50.f) ? radius + 1.f : 10.f;
+            for (std::size_t i = 0; i < circles.size(); ++i)
+                circles[i].setRadius(radius);
+        }
+
+        std::vector<sf::CircleShape> circles;
+        float                        radius;
+    };
+
+    void benchmarkShapes(Report& report, sf::RenderTexture& target, std::size_t shapeCount, std::size_t pointCount)
+    {
+        ShapeTask task;
+        task.circles.resize(shapeCount, sf::CircleShape(10.f, pointCount));
+        task.radius = 10.f;
+
+        std::ostringstream name;
+        name << shapeCount << " circles of " << pointCount << " points";
+        runOnTarget(report, "shapes", name.str(), task, target, static_cast<double>(shapeCount), "shapes");
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Draw outlined circles, tessellated or analytic
+    ////////////////////////////////////////////////////////////
+    template <typename Circle>
+    struct CircleDrawTask
+    {
+        void operator ()()
+        {
+            target->clear();
+            for (std::size_t i = 0; i < circles.size(); ++i)
+                target->draw(circles[i]);
+        }
+
+        std::vector<Circle> circles;
+        sf::RenderTarget*   target;
+    };
+
+    template <typename Circle>
+    void benchmarkCircleDraws(Report& report, sf::RenderTexture& target, const char* name, std::size_t shapeCount)
+    {
+        CircleDrawTask<Circle> task;
+        task.target = &target;
+        for (std::size_t i = 0; i < shapeCount; ++i)
+        {
+            Circle circle(5.f + random(20.f));
+            circle.setFillColor(sf::Color(std::rand() % 256, std::rand() % 256, std::rand() % 256));
+            circle.setOutlineColor(sf::Color::White);
+            circle.setOutlineThickness(2.f);
+            circle.setPosition(random(targetWidth), random(targetHeight));
+            task.circles.push_back(circle);
+        }
+
+        runOnTarget(report, "circle_draw", name, task, target, static_cast<double>(shapeCount), "shapes");
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Draw a vertex array enough times to submit a fixed number of vertices
+    ////////////////////////////////////////////////////////////
+    struct VertexArrayTask
+    {
+        void operator ()()
+        {
+            target->clear();
+            for (std::size_t i = 0; i < draws; ++i)
+                target->draw(vertices);
+        }
+
+        sf::RenderTexture* target;
+        sf::VertexArray    vertices;
+        std::size_t        draws;
+    };
+
+    void benchmarkVertexArray(Report& report, sf::RenderTexture& target, std::size_t vertexCount)
+    {
+        const std::size_t verticesPerIteration = 393216;
+
+        VertexArrayTask task;
+        task.target = &target;
+        task.vertices.setPrimitiveType(sf::Triangles);
+        task.vertices.resize(vertexCount);
+        for (std::size_t i = 0; i < vertexCount; i += 3)
+        {
+            sf::Vector2f position(random(targetWidth - 8.f), random(targetHeight - 8.f));
+            task.vertices[i + 0] = sf::Vertex(position, sf::Color::Red);
+            task.vertices[i + 1] = sf::Vertex(position + sf::Vector2f(8.f, 0.f), sf::Color::Green);
+            task.vertices[i + 2] = sf::Vertex(position + sf::Vector2f(0.f, 8.f), sf::Color::Blue);
+        }
+        task.draws = verticesPerIteration / vertexCount;
+
+        std::ostringstream name;
+        name << vertexCount << " vertices x " << task.draws << " draws";
+        runOnTarget(report, "vertex_array", name.str(), task, target, static_cast<double>(vertexCount * task.draws), "vertices");
+
+        target.clear();
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Upload pixels to a texture, or read them back
+    ////////////////////////////////////////////////////////////
+    struct TextureTask
+    {
+        void operator ()()
+        {
+            if (upload)
+                texture.update(&pixels[0]);
+            else
+                texture.copyToImage();
+        }
+
+        sf::Texture            texture;
+        std::vector<sf::Uint8> pixels;
+        bool                   upload;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Publish a frame to a streaming texture and upload it, as a video player does
+    ////////////////////////////////////////////////////////////
+    struct StreamingTask
+    {
+        void operator ()()
+        {
+            texture->update(&(*pixels)[0]);
+            texture->upload();
+        }
+
+        sf::StreamingTexture*         texture;
+        const std::vector<sf::Uint8>* pixels;
+    };
+
+    void benchmarkTexture(Report& report, sf::RenderTexture& target, unsigned int size)
+    {
+        TextureTask task;
+        task.texture.create(size, size);
+        task.pixels.resize(size * size * 4);
+        for (std::size_t i = 0; i < task.pixels.size(); ++i)
+            task.pixels[i] = static_cast<sf::Uint8>(std::rand());
+
+        std::ostringstream name;
+        name << size << 'x' << size;
+        double bytes = static_cast<double>(task.pixels.size());
+
+        task.upload = true;
+        runOnTarget(report, "texture_upload", name.str(), task, target, bytes, "bytes");
+
+        sf::StreamingTexture streaming;
+        if (streaming.create(size, size))
+        {
+            StreamingTask streamingTask = {&streaming, &task.pixels};
+            runOnTarget(report, "texture_upload", name.str() + " streaming", streamingTask, target, bytes, "bytes");
+        }
+
+        task.upload = false;
+        runOnTarget(report, "texture_readback", name.str(), task, target, bytes, "bytes");
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Render a batch of jobs and save each one to a file, serially or through a capture queue
+    ////////////////////////////////////////////////////////////
+    struct CaptureTask
+    {
+        void operator ()()
+        {
+            for (std::size_t i = 0; i < filenames.size(); ++i)
+            {
+                target->clear(sf::Color(static_cast<sf::Uint8>(i * 30), 0, 0));
+                for (std::size_t j = 0; j < shapes.size(); ++j)
+                    target->draw(shapes[j]);
+                target->display();
+
+                if (queue)
+                    queue->capture(*target, filenames[i]);
+                else
+                    target->getTexture().copyToImage().saveToFile(filenames[i]);
+            }
+
+            if (queue)
+                queue->finish();
+        }
+
+        sf::RenderTexture*           target;
+        sf::CaptureQueue*            queue;
+        std::vector<sf::CircleShape> shapes;
+        std::vector<std::string>     filenames;
+    };
+
+    void benchmarkCaptures(Report& report, sf::RenderTexture& target)
+    {
+        CaptureTask task;
+        task.target = &target;
+        task.queue = NULL;
+        for (std::size_t i = 0; i < 100; ++i)
+        {
+            sf::CircleShape shape(random(100.f));
+            shape.setPosition(random(targetWidth), random(targetHeight));
+            shape.setFillColor(sf::Color(static_cast<sf::Uint8>(std::rand()), static_cast<sf::Uint8>(std::rand()), 255));
+            task.shapes.push_back(shape);
+        }
+        for (std::size_t i = 0; i < 8; ++i)
+        {
+            std::ostringstream filename;
+            filename << "sfml-benchmark-capture-" << i << ".png";
+            task.filenames.push_back(filename.str());
+        }
+
+        double jobs = static_cast<double>(task.filenames.size());
+        run(report, "graphics", "capture_save", "8 jobs, copyToImage", task, jobs, "jobs", 10);
+
+        sf::TaskScheduler scheduler;
+        sf::CaptureQueue queue(scheduler);
+        task.queue = &queue;
+        run(report, "graphics", "capture_save", "8 jobs, capture queue", task, jobs, "jobs", 10);
+
+        for (std::size_t i = 0; i < task.filenames.size(); ++i)
+            std::remove(task.filenames[i].c_str());
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void runGraphicsBenchmarks(Report& report)
+{
+    // Render offscreen, so that the results are not limited by the display
+    sf::RenderTexture target;
+    if (!target.create(targetWidth, targetHeight))
+        return;
+
+    std::srand(42);
+
+    benchmarkSprites(report, target, 1000, 1);
+    benchmarkSprites(report, target, 1000, 1000);
+    benchmarkSprites(report, target, 10000, 1);
+    benchmarkSprites(report, target, 10000, 10000);
+    benchmarkOverdraw(report, target, 1000);
+
+    sf::Font font;
+    if (font.loadFromFile("resources/sansation.ttf"))
+        benchmarkText(report, target, font);
+
+    benchmarkGLStates(report, target);
+
+    benchmarkShapes(report, target, 1000, 30);
+    benchmarkShapes(report, target, 1000, 100);
+    benchmarkCircleDraws<sf::CircleShape>(report, target, "1000 outlined circles of 30 points", 1000);
+    if (sf::AnalyticShape::isAvailable())
+        benchmarkCircleDraws<sf::AnalyticCircle>(report, target, "1000 outlined analytic circles", 1000);
+
+    for (std::size_t vertexCount = 6; vertexCount <= 393216; vertexCount *= 16)
+        benchmarkVertexArray(report, target, vertexCount);
+
+    benchmarkTexture(report, target, 256);
+    benchmarkTexture(report, target, 1024);
+    benchmarkTexture(report, target, 2048);
+
+    benchmarkCaptures(report, target);
+}
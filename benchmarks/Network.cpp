@@ -0,0 +1,569 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Benchmark.hpp"
+#include <SFML/Network.hpp>
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+    // Entity state of a typical game protocol
+    struct PlayerState
+    {
+        sf::Uint32 id;
+        float      x;
+        float      y;
+        sf::Int16  health;
+        sf::Int16  ammo;
+    };
+}
+
+
+namespace sf
+{
+    template <>
+    struct Serializer<PlayerState> : SerializerFields<PlayerState,
+        SFML_SERIALIZER_FIELD(PlayerState, sf::Uint32, id),
+        SFML_SERIALIZER_FIELD(PlayerState, float,      x),
+        SFML_SERIALIZER_FIELD(PlayerState, float,      y),
+        SFML_SERIALIZER_FIELD(PlayerState, sf::Int16,  health),
+        SFML_SERIALIZER_FIELD(PlayerState, sf::Int16,  ammo)>
+    {
+    };
+}
+
+
+namespace
+{
+    const std::size_t valuesPerIteration = 1024;
+
+    ////////////////////////////////////////////////////////////
+    // Write values of a type into a packet
+    ////////////////////////////////////////////////////////////
+    template <typename T>
+    struct PacketWriteTask
+    {
+        void operator ()()
+        {
+            packet.clear();
+            for (std::size_t i = 0; i < valuesPerIteration; ++i)
+                packet << value;
+        }
+
+        sf::Packet packet;
+        T          value;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Read values of a type from a packet
+    //
+    // The packet is refilled every iteration, since it can't be
+    // read twice; the copy costs less than a byte per value.
+    ////////////////////////////////////////////////////////////
+    template <typename T>
+    struct PacketReadTask
+    {
+        void operator ()()
+        {
+            packet.clear();
+            packet.append(&data[0], data.size());
+
+            T value;
+            for (std::size_t i = 0; i < valuesPerIteration; ++i)
+                packet >> value;
+        }
+
+        sf::Packet        packet;
+        std::vector<char> data;
+    };
+
+    template <typename T>
+    void benchmarkPacket(Report& report, const char* type, const T& value)
+    {
+        PacketWriteTask<T> write;
+        write.value = value;
+        run(report, "network", "packet_write", type, write, valuesPerIteration, "values");
+
+        PacketReadTask<T> read;
+        const char* data = static_cast<const char*>(write.packet.getData());
+        read.data.assign(data, data + write.packet.getDataSize());
+        run(report, "network", "packet_read", type, read, valuesPerIteration, "values");
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Write and read arrays of values at once
+    ////////////////////////////////////////////////////////////
+    template <typename T>
+    struct PacketWriteArrayTask
+    {
+        void operator ()()
+        {
+            packet.clear();
+            packet.writeArray(&values[0], values.size());
+        }
+
+        sf::Packet     packet;
+        std::vector<T> values;
+    };
+
+    template <typename T>
+    struct PacketReadArrayTask
+    {
+        void operator ()()
+        {
+            packet.clear();
+            packet.append(&data[0], data.size());
+            packet.readArray(&values[0], values.size());
+        }
+
+        sf::Packet        packet;
+        std::vector<char> data;
+        std::vector<T>    values;
+    };
+
+    template <typename T>
+    void benchmarkPacketArray(Report& report, const char* type, const T& value)
+    {
+        PacketWriteArrayTask<T> write;
+        write.values.assign(valuesPerIteration, value);
+        run(report, "network", "packet_write_array", type, write, valuesPerIteration, "values");
+
+        PacketReadArrayTask<T> read;
+        const char* data = static_cast<const char*>(write.packet.getData());
+        read.data.assign(data, data + write.packet.getDataSize());
+        read.values.resize(valuesPerIteration);
+        run(report, "network", "packet_read_array", type, read, valuesPerIteration, "values");
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Write and read structures field by field, or whole with their serializer
+    ////////////////////////////////////////////////////////////
+    struct StructWriteTask
+    {
+        void operator ()()
+        {
+            packet.clear();
+            if (serializer)
+            {
+                packet.write(&players[0], players.size());
+            }
+            else
+            {
+                for (std::size_t i = 0; i < players.size(); ++i)
+                    packet << players[i].id << players[i].x << players[i].y << players[i].health << players[i].ammo;
+            }
+        }
+
+        sf::Packet               packet;
+        std::vector<PlayerState> players;
+        bool                     serializer;
+    };
+
+    struct StructReadTask
+    {
+        void operator ()()
+        {
+            packet.clear();
+            packet.append(&data[0], data.size());
+            if (serializer)
+            {
+                packet.read(&players[0], players.size());
+            }
+            else
+            {
+                for (std::size_t i = 0; i < players.size(); ++i)
+                    packet >> players[i].id >> players[i].x >> players[i].y >> players[i].health >> players[i].ammo;
+            }
+        }
+
+        sf::Packet               packet;
+        std::vector<char>        data;
+        std::vector<PlayerState> players;
+        bool                     serializer;
+    };
+
+    void benchmarkStructs(Report& report)
+    {
+        PlayerState player = {42, 1.5f, -2.5f, 100, 30};
+        const char* names[] = {"field by field", "serializer"};
+
+        for (int i = 0; i < 2; ++i)
+        {
+            StructWriteTask write;
+            write.players.assign(valuesPerIteration, player);
+            write.serializer = (i == 1);
+            run(report, "network", "packet_write_struct", names[i], write, valuesPerIteration, "structs");
+
+            StructReadTask read;
+            const char* data = static_cast<const char*>(write.packet.getData());
+            read.data.assign(data, data + write.packet.getDataSize());
+            read.players.resize(valuesPerIteration);
+            read.serializer = (i == 1);
+            run(report, "network", "packet_read_struct", names[i], read, valuesPerIteration, "structs");
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Encode a snapshot of 4 KB with 1% of its bytes changed since the acknowledged baseline
+    // (the following snapshots are never acknowledged, so that the baseline stays the same)
+    ////////////////////////////////////////////////////////////
+    struct SnapshotEncodeTask
+    {
+        void operator ()()
+        {
+            output.clear();
+            encoder.encode(snapshot, output);
+        }
+
+        sf::SnapshotEncoder encoder;
+        sf::Packet          snapshot;
+        sf::Packet          output;
+    };
+
+    void benchmarkSnapshots(Report& report)
+    {
+        std::vector<char> world(4096);
+        for (std::size_t i = 0; i < world.size(); ++i)
+            world[i] = static_cast<char>(i * 7);
+
+        SnapshotEncodeTask task;
+        task.snapshot.append(&world[0], world.size());
+        task.encoder.acknowledge(task.encoder.encode(task.snapshot, task.output));
+
+        for (std::size_t i = 0; i < world.size(); i += 100)
+            world[i]++;
+        task.snapshot.clear();
+        task.snapshot.append(&world[0], world.size());
+        run(report, "network", "snapshot_encode", "4 KB, 1% changed", task, static_cast<double>(world.size()), "bytes");
+
+        report.begin("network", "snapshot_size", "4 KB, 1% changed");
+        report.add("full_bytes", static_cast<double>(world.size()));
+        report.add("delta_bytes", static_cast<double>(task.output.getDataSize()));
+        report.end();
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Commands sent to the TCP server, in the first byte of the packets
+    ////////////////////////////////////////////////////////////
+    enum Command
+    {
+        Discard,    ///< Drop the packet
+        Echo,       ///< Send the packet back
+        Acknowledge ///< Send an empty packet back, once the previous ones are received
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Stream server (TCP or local) running the commands until the client disconnects
+    ////////////////////////////////////////////////////////////
+    template <typename SocketType>
+    struct StreamServer
+    {
+        void run()
+        {
+            sf::Packet packet;
+            while (socket.receive(packet) == sf::Socket::Done)
+            {
+                sf::Uint8 command;
+                packet >> command;
+
+                if (command == Echo)
+                {
+                    socket.send(packet);
+                }
+                else if (command == Acknowledge)
+                {
+                    sf::Packet acknowledgement;
+                    socket.send(acknowledgement);
+                }
+            }
+        }
+
+        SocketType socket;
+    };
+
+    sf::Packet makePacket(Command command, std::size_t size)
+    {
+        sf::Packet packet;
+        packet << static_cast<sf::Uint8>(command);
+
+        if (size > 1)
+        {
+            std::vector<char> payload(size - 1, 'x');
+            packet.append(&payload[0], payload.size());
+        }
+
+        return packet;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Send what the coalescing of a socket holds (only TCP sockets coalesce)
+    ////////////////////////////////////////////////////////////
+    void flush(sf::TcpSocket& socket)
+    {
+        socket.flush();
+    }
+
+    void flush(sf::LocalSocket&)
+    {
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Send packets to the server and wait until it received them all
+    ////////////////////////////////////////////////////////////
+    template <typename SocketType>
+    void benchmarkStreamThroughput(Report& report, SocketType& socket, const std::string& transport, std::size_t size)
+    {
+        std::size_t count = std::min<std::size_t>(32 * 1024 * 1024 / size, 200000);
+        sf::Packet packet = makePacket(Discard, size);
+        sf::Packet acknowledge = makePacket(Acknowledge, 1);
+        sf::Packet reply;
+
+        sf::Clock clock;
+        for (std::size_t i = 0; i < count; ++i)
+            socket.send(packet);
+        socket.send(acknowledge);
+        flush(socket);
+        socket.receive(reply);
+        double seconds = clock.getElapsedTime().asMicroseconds() / 1000000.0;
+
+        std::ostringstream name;
+        name << size << " bytes";
+        report.begin("network", (transport + "_throughput").c_str(), name.str());
+        report.add("packets", static_cast<double>(count));
+        report.add("packets_per_second", count / seconds);
+        report.add("bytes_per_second", count * size / seconds);
+        report.end();
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Measure round trips of packets echoed by the server
+    ////////////////////////////////////////////////////////////
+    template <typename SocketType>
+    void benchmarkStreamLatency(Report& report, SocketType& socket, const std::string& transport, std::size_t size)
+    {
+        const std::size_t count = 10000;
+        sf::Packet packet = makePacket(Echo, size);
+        sf::Packet reply;
+
+        std::vector<sf::Int64> roundTrips;
+        roundTrips.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            sf::Clock clock;
+            socket.send(packet);
+            socket.receive(reply);
+            roundTrips.push_back(clock.getElapsedTime().asMicroseconds());
+        }
+
+        std::ostringstream name;
+        name << size << " bytes";
+        report.begin("network", (transport + "_round_trip").c_str(), name.str());
+        report.add("round_trips", static_cast<double>(count));
+        addPercentiles(report, roundTrips);
+        report.end();
+    }
+
+    void benchmarkTcp(Report& report)
+    {
+        sf::TcpListener listener;
+        if (listener.listen(sf::Socket::AnyPort) != sf::Socket::Done)
+            return;
+
+        // The connection is established by the system, it can be accepted afterwards
+        sf::TcpSocket socket;
+        StreamServer<sf::TcpSocket> server;
+        if ((socket.connect(sf::IpAddress::LocalHost, listener.getLocalPort(), sf::seconds(5)) != sf::Socket::Done) ||
+            (listener.accept(server.socket) != sf::Socket::Done))
+            return;
+
+        sf::Thread thread(&StreamServer<sf::TcpSocket>::run, &server);
+        thread.launch();
+
+        benchmarkStreamThroughput(report, socket, "tcp", 64);
+        benchmarkStreamThroughput(report, socket, "tcp", 1024);
+        benchmarkStreamThroughput(report, socket, "tcp", 16384);
+
+        benchmarkStreamLatency(report, socket, "tcp", 64);
+        benchmarkStreamLatency(report, socket, "tcp", 1024);
+
+        // Small packets coalesced by the socket, one system call per 16 KB
+        socket.setSendCoalescing(16384);
+        benchmarkStreamThroughput(report, socket, "tcp_coalesced", 64);
+        socket.setSendCoalescing(0);
+
+        socket.disconnect();
+        thread.wait();
+    }
+
+    ////////////////////////////////////////////////////////////
+    // The same measures through a local socket, to compare with the loopback
+    ////////////////////////////////////////////////////////////
+    void benchmarkLocal(Report& report)
+    {
+        sf::LocalListener listener;
+        if (listener.listen("sfml-benchmark.sock") != sf::Socket::Done)
+            return;
+
+        sf::LocalSocket socket;
+        StreamServer<sf::LocalSocket> server;
+        if ((socket.connect(listener.getPath()) != sf::Socket::Done) || (listener.accept(server.socket) != sf::Socket::Done))
+            return;
+
+        sf::Thread thread(&StreamServer<sf::LocalSocket>::run, &server);
+        thread.launch();
+
+        benchmarkStreamThroughput(report, socket, "local", 64);
+        benchmarkStreamThroughput(report, socket, "local", 1024);
+        benchmarkStreamThroughput(report, socket, "local", 16384);
+
+        benchmarkStreamLatency(report, socket, "local", 64);
+        benchmarkStreamLatency(report, socket, "local", 1024);
+
+        socket.disconnect();
+        thread.wait();
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Receive datagrams until they are all there, or none arrive for a while
+    ////////////////////////////////////////////////////////////
+    struct UdpReceiver
+    {
+        void run()
+        {
+            sf::SocketSelector selector;
+            selector.add(*socket);
+
+            std::vector<char> buffers(batchSize * size);
+            std::vector<sf::UdpSocket::Datagram> datagrams(batchSize);
+            for (std::size_t i = 0; i < batchSize; ++i)
+            {
+                datagrams[i].data = &buffers[i * size];
+                datagrams[i].size = size;
+            }
+
+            while ((received < expected) && selector.wait(sf::milliseconds(200)))
+            {
+                std::size_t count = 0;
+                if (batchSize > 1)
+                {
+                    socket->receiveBatch(&datagrams[0], batchSize, count);
+                }
+                else
+                {
+                    sf::IpAddress address;
+                    unsigned short port;
+                    if (socket->receive(&buffers[0], size, count, address, port) == sf::Socket::Done)
+                        count = 1;
+                }
+
+                received += count;
+                lastReceive = clock->getElapsedTime();
+            }
+        }
+
+        sf::UdpSocket*   socket;
+        const sf::Clock* clock;
+        std::size_t      size;
+        std::size_t      batchSize;
+        std::size_t      expected;
+        std::size_t      received;
+        sf::Time         lastReceive;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Send datagrams through the loopback, one by one or in batches
+    ////////////////////////////////////////////////////////////
+    void benchmarkUdp(Report& report, std::size_t size, std::size_t batchSize)
+    {
+        const std::size_t count = 200000;
+
+        sf::UdpSocket receiver;
+        sf::UdpSocket sender;
+        if ((receiver.bind(sf::Socket::AnyPort) != sf::Socket::Done) ||
+            (sender.bind(sf::Socket::AnyPort) != sf::Socket::Done))
+            return;
+
+        std::vector<char> payload(size, 'x');
+        std::vector<sf::UdpSocket::Datagram> datagrams(batchSize);
+        for (std::size_t i = 0; i < batchSize; ++i)
+        {
+            datagrams[i].data = &payload[0];
+            datagrams[i].size = size;
+            datagrams[i].address = sf::IpAddress::LocalHost;
+            datagrams[i].port = receiver.getLocalPort();
+        }
+
+        sf::Clock clock;
+        UdpReceiver task = {&receiver, &clock, size, batchSize, count, 0, sf::Time::Zero};
+        sf::Thread thread(&UdpReceiver::run, &task);
+        thread.launch();
+
+        clock.restart();
+        std::size_t sent = 0;
+        while (sent < count)
+        {
+            std::size_t sentNow = 1;
+            sf::Socket::Status status;
+            if (batchSize > 1)
+                status = sender.sendBatch(&datagrams[0], std::min(batchSize, count - sent), sentNow);
+            else
+                status = sender.send(&payload[0], size, sf::IpAddress::LocalHost, receiver.getLocalPort());
+
+            if (status != sf::Socket::Done)
+                break;
+            sent += sentNow;
+        }
+        double sendSeconds = clock.getElapsedTime().asMicroseconds() / 1000000.0;
+
+        thread.wait();
+        double receiveSeconds = task.lastReceive.asMicroseconds() / 1000000.0;
+
+        std::ostringstream name;
+        name << size << " bytes, " << (batchSize > 1 ? "batches of " : "one by one");
+        if (batchSize > 1)
+            name << batchSize;
+        report.begin("network", "udp", name.str());
+        report.add("datagrams", static_cast<double>(sent));
+        report.add("sent_per_second", sent / sendSeconds);
+        report.add("received_per_second", task.received / receiveSeconds);
+        report.add("lost", static_cast<double>(sent - task.received));
+        report.end();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void runNetworkBenchmarks(Report& report)
+{
+    benchmarkPacket<bool>(report, "bool", true);
+    benchmarkPacket<sf::Int8>(report, "Int8", 42);
+    benchmarkPacket<sf::Int16>(report, "Int16", 4242);
+    benchmarkPacket<sf::Int32>(report, "Int32", 424242);
+    benchmarkPacket<sf::Int64>(report, "Int64", 42424242);
+    benchmarkPacket<float>(report, "float", 42.42f);
+    benchmarkPacket<double>(report, "double", 42.42);
+    benchmarkPacket<std::string>(report, "std::string (16 characters)", std::string(16, 'x'));
+    benchmarkPacket<sf::String>(report, "sf::String (16 characters)", sf::String(std::string(16, 'x')));
+
+    benchmarkPacketArray<sf::Int16>(report, "Int16", 4242);
+    benchmarkPacketArray<sf::Int32>(report, "Int32", 424242);
+    benchmarkPacketArray<sf::Int64>(report, "Int64", 42424242);
+    benchmarkPacketArray<float>(report, "float", 42.42f);
+
+    benchmarkStructs(report);
+
+    benchmarkSnapshots(report);
+
+    benchmarkTcp(report);
+    benchmarkLocal(report);
+
+    benchmarkUdp(report, 64, 1);
+    benchmarkUdp(report, 64, 64);
+    benchmarkUdp(report, 1024, 1);
+    benchmarkUdp(report, 1024, 64);
+}
@@ -0,0 +1,152 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+
+
+namespace
+{
+    const char* intervalNames[] = {"event queue", "processing", "rendering", "presentation", "total"};
+
+    ////////////////////////////////////////////////////////////
+    // Draw the histogram of an interval as a bar chart
+    ////////////////////////////////////////////////////////////
+    void drawHistogram(sf::RenderTarget& target, const sf::LatencyMonitor::Histogram& histogram, sf::Vector2f position, float height)
+    {
+        sf::Uint64 largest = 1;
+        for (std::size_t i = 0; i < histogram.counts.size(); ++i)
+            largest = std::max(largest, histogram.counts[i]);
+
+        sf::RectangleShape background(sf::Vector2f(static_cast<float>(histogram.counts.size() * 4), height));
+        background.setPosition(position);
+        background.setFillColor(sf::Color(0, 0, 0, 160));
+        target.draw(background);
+
+        sf::RectangleShape bar;
+        bar.setFillColor(sf::Color(100, 200, 100));
+        for (std::size_t i = 0; i < histogram.counts.size(); ++i)
+        {
+            float barHeight = height * histogram.counts[i] / largest;
+            bar.setSize(sf::Vector2f(3.f, barHeight));
+            bar.setPosition(position.x + i * 4.f, position.y + height - barHeight);
+            target.draw(bar);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    // Create the window of the application
+    sf::RenderWindow window(sf::VideoMode(800, 600), "SFML Latency", sf::Style::Titlebar | sf::Style::Close);
+    bool verticalSync = true;
+    unsigned int framerateLimit = 0;
+    window.setVerticalSyncEnabled(verticalSync);
+
+    // Load the text font
+    sf::Font font;
+    if (!font.loadFromFile("resources/sansation.ttf"))
+        return EXIT_FAILURE;
+
+    sf::Text overlay;
+    overlay.setFont(font);
+    overlay.setCharacterSize(16);
+    overlay.setPosition(10.f, 10.f);
+
+    // The square follows the mouse: the distance between the two shows the latency
+    sf::RectangleShape square(sf::Vector2f(40.f, 40.f));
+    square.setOrigin(20.f, 20.f);
+    square.setFillColor(sf::Color(200, 100, 100));
+
+    sf::LatencyMonitor monitor;
+    sf::LatencyMonitor::Frame lastFrame;
+
+    while (window.isOpen())
+    {
+        // Handle events, recording when each one is received
+        sf::Event event;
+        while (window.pollEvent(event))
+        {
+            monitor.addEvent(event);
+
+            if ((event.type == sf::Event::Closed) ||
+               ((event.type == sf::Event::KeyPressed) && (event.key.code == sf::Keyboard::Escape)))
+            {
+                window.close();
+                break;
+            }
+
+            if (event.type == sf::Event::KeyPressed)
+            {
+                // Compare the settings, each one starts new histograms
+                if (event.key.code == sf::Keyboard::V)
+                {
+                    verticalSync = !verticalSync;
+                    window.setVerticalSyncEnabled(verticalSync);
+                    monitor.reset();
+                }
+                else if (event.key.code == sf::Keyboard::L)
+                {
+                    framerateLimit = framerateLimit ? 0 : 30;
+                    window.setFramerateLimit(framerateLimit);
+                    monitor.reset();
+                }
+            }
+
+            if (event.type == sf::Event::MouseMoved)
+                square.setPosition(static_cast<float>(event.mouseMove.x), static_cast<float>(event.mouseMove.y));
+        }
+
+        if (!window.isOpen())
+            break;
+
+        // Keep the last frame which responded to an input
+        sf::LatencyMonitor::Frame frame;
+        while (monitor.pollFrame(frame))
+        {
+            if (frame.hasInput)
+                lastFrame = frame;
+        }
+
+        // Describe the settings, the last frame and the percentiles of each interval
+        std::ostringstream text;
+        text << "Vertical sync (V): " << (verticalSync ? "on" : "off")
+             << "    Framerate limit (L): " << (framerateLimit ? "30" : "none") << "\n\n"
+             << "interval: last frame / median / 99th percentile (ms)\n";
+        for (int i = 0; i < sf::LatencyMonitor::IntervalCount; ++i)
+        {
+            sf::LatencyMonitor::Interval interval = static_cast<sf::LatencyMonitor::Interval>(i);
+            const sf::LatencyMonitor::Histogram& histogram = monitor.getHistogram(interval);
+
+            text << intervalNames[i] << ": ";
+            if (lastFrame.isMeasured(interval))
+                text << lastFrame.getDuration(interval).asMicroseconds() / 1000.f;
+            else
+                text << "-";
+            text << " / " << histogram.getPercentile(50).asMilliseconds()
+                 << " / " << histogram.getPercentile(99).asMilliseconds() << "\n";
+        }
+        text << "\nTotal latency, 0 to 100 ms:";
+        overlay.setString(text.str());
+
+        window.clear(sf::Color(50, 50, 60));
+        window.draw(square);
+        window.draw(overlay);
+        drawHistogram(window, monitor.getHistogram(sf::LatencyMonitor::Total), sf::Vector2f(10.f, 220.f), 100.f);
+
+        // Display through the monitor, which measures the end of the rendering and the presentation
+        monitor.display(window);
+    }
+
+    return EXIT_SUCCESS;
+}
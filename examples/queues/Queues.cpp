@@ -0,0 +1,150 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System.hpp>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <vector>
+
+
+namespace
+{
+    const sf::Int32 itemsPerProducer = 1000000;
+    const std::size_t capacity = 1024;
+
+    ////////////////////////////////////////////////////////////
+    // Queue guarded by a mutex, the usual way of passing data between threads
+    ////////////////////////////////////////////////////////////
+    class LockedQueue
+    {
+    public:
+
+        LockedQueue(std::size_t capacity) : m_capacity(capacity) {}
+
+        bool push(sf::Int32 value)
+        {
+            sf::Lock lock(m_mutex);
+            if (m_queue.size() >= m_capacity)
+                return false;
+            m_queue.push_back(value);
+            return true;
+        }
+
+        bool pop(sf::Int32& value)
+        {
+            sf::Lock lock(m_mutex);
+            if (m_queue.empty())
+                return false;
+            value = m_queue.front();
+            m_queue.pop_front();
+            return true;
+        }
+
+    private:
+
+        sf::Mutex             m_mutex;
+        std::deque<sf::Int32> m_queue;
+        std::size_t           m_capacity;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Thread pushing or popping items
+    ////////////////////////////////////////////////////////////
+    template <typename Queue>
+    struct Worker
+    {
+        void operator ()()
+        {
+            if (producer)
+            {
+                for (sf::Int32 i = 0; i < itemsPerProducer; ++i)
+                {
+                    while (!queue->push(i))
+                        ;
+                }
+            }
+            else
+            {
+                sf::Int32 value;
+                for (sf::Int32 i = 0; i < itemsPerProducer; ++i)
+                {
+                    while (!queue->pop(value))
+                        ;
+                    *sum += value;
+                }
+            }
+        }
+
+        Queue*     queue;
+        bool       producer;
+        sf::Int64* sum;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Run as many producers as consumers through a queue, and print the throughput
+    ////////////////////////////////////////////////////////////
+    template <typename Queue>
+    void benchmark(const char* name, unsigned int pairs)
+    {
+        Queue queue(capacity);
+        std::vector<sf::Int64> sums(pairs, 0);
+        std::vector<sf::Thread*> threads;
+        for (unsigned int i = 0; i < pairs; ++i)
+        {
+            Worker<Queue> producer = {&queue, true, NULL};
+            Worker<Queue> consumer = {&queue, false, &sums[i]};
+            threads.push_back(new sf::Thread(producer));
+            threads.push_back(new sf::Thread(consumer));
+        }
+
+        sf::Clock clock;
+        for (std::size_t i = 0; i < threads.size(); ++i)
+            threads[i]->launch();
+        for (std::size_t i = 0; i < threads.size(); ++i)
+        {
+            threads[i]->wait();
+            delete threads[i];
+        }
+        float seconds = clock.getElapsedTime().asSeconds();
+
+        // Check that every item was received once
+        sf::Int64 sum = 0;
+        for (unsigned int i = 0; i < pairs; ++i)
+            sum += sums[i];
+        sf::Int64 expected = static_cast<sf::Int64>(pairs) * itemsPerProducer * (itemsPerProducer - 1) / 2;
+
+        std::cout << "  " << name << ": " << static_cast<sf::Int64>(pairs * itemsPerProducer / seconds / 1000) << " thousand items/s"
+                  << (sum == expected ? "" : " (WRONG RESULT)") << std::endl;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    std::cout << "1 producer, 1 consumer:" << std::endl;
+    benchmark<LockedQueue>("Mutex + std::deque", 1);
+    benchmark<sf::SpscQueue<sf::Int32> >("sf::SpscQueue", 1);
+    benchmark<sf::MpmcQueue<sf::Int32> >("sf::MpmcQueue", 1);
+
+    unsigned int pairs = sf::TaskScheduler::getCoreCount() / 2;
+    if (pairs < 2)
+        pairs = 2;
+
+    std::cout << pairs << " producers, " << pairs << " consumers:" << std::endl;
+    benchmark<LockedQueue>("Mutex + std::deque", pairs);
+    benchmark<sf::MpmcQueue<sf::Int32> >("sf::MpmcQueue", pairs);
+
+    // Wait until the user presses 'enter' key
+    std::cout << "Press enter to exit..." << std::endl;
+    std::cin.ignore(10000, '\n');
+
+    return EXIT_SUCCESS;
+}
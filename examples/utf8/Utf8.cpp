@@ -0,0 +1,178 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+
+namespace
+{
+    const std::size_t corpusSize = 16 * 1024;
+    const int repeats = 1000;
+
+    ////////////////////////////////////////////////////////////
+    // Decode one character at a time, like the generic sf::Utf8::toUtf32 used to
+    ////////////////////////////////////////////////////////////
+    template <typename In, typename Out>
+    Out referenceToUtf32(In begin, In end, Out output)
+    {
+        static const int trailing[256] =
+        {
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+            2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5
+        };
+        static const sf::Uint32 offsets[6] =
+        {
+            0x00000000, 0x00003080, 0x000E2080, 0x03C82080, 0xFA082080, 0x82082080
+        };
+
+        while (begin < end)
+        {
+            sf::Uint32 codepoint = 0;
+            int trailingBytes = trailing[static_cast<sf::Uint8>(*begin)];
+            if (begin + trailingBytes < end)
+            {
+                for (int i = 0; i < trailingBytes; ++i)
+                {
+                    codepoint += static_cast<sf::Uint8>(*begin++);
+                    codepoint <<= 6;
+                }
+                codepoint += static_cast<sf::Uint8>(*begin++);
+                codepoint -= offsets[trailingBytes];
+            }
+            else
+            {
+                begin = end;
+            }
+            *output++ = codepoint;
+        }
+
+        return output;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Build a corpus by repeating a sample text
+    ////////////////////////////////////////////////////////////
+    std::string makeCorpus(const char* sample)
+    {
+        std::string corpus;
+        corpus.reserve(corpusSize + 256);
+        while (corpus.size() < corpusSize)
+            corpus += sample;
+
+        return corpus;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Print the throughput of a conversion
+    ////////////////////////////////////////////////////////////
+    void report(const char* name, sf::Time time, std::size_t bytes, bool correct)
+    {
+        float seconds = time.asSeconds();
+        std::cout << "  " << name << ": " << static_cast<int>(bytes / seconds / (1024 * 1024)) << " MB/s"
+                  << (correct ? "" : " (WRONG RESULT)") << std::endl;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Run the decoders and encoders on a corpus
+    ////////////////////////////////////////////////////////////
+    void benchmark(const char* name, const char* sample)
+    {
+        std::cout << name << ":" << std::endl;
+        std::string corpus = makeCorpus(sample);
+        const char* begin = corpus.data();
+        const char* end = begin + corpus.size();
+        const std::size_t bytes = corpus.size() * repeats;
+
+        std::basic_string<sf::Uint32> reference;
+        referenceToUtf32(corpus.begin(), corpus.end(), std::back_inserter(reference));
+        sf::String string = sf::String::fromUtf8(begin, end);
+
+        sf::Clock clock;
+        bool correct = true;
+        for (int i = 0; i < repeats; ++i)
+        {
+            std::basic_string<sf::Uint32> decoded;
+            referenceToUtf32(corpus.begin(), corpus.end(), std::back_inserter(decoded));
+            correct = correct && (decoded.size() == reference.size());
+        }
+        report("decode, one character at a time", clock.getElapsedTime(), bytes, correct);
+
+        clock.restart();
+        for (int i = 0; i < repeats; ++i)
+        {
+            std::basic_string<sf::Uint32> decoded;
+            sf::Utf8::toUtf32(corpus.begin(), corpus.end(), std::back_inserter(decoded));
+            correct = correct && (decoded.size() == reference.size());
+        }
+        report("decode, generic sf::Utf8::toUtf32", clock.getElapsedTime(), bytes, correct);
+
+        clock.restart();
+        for (int i = 0; i < repeats; ++i)
+        {
+            sf::String decoded = sf::String::fromUtf8(begin, end);
+            correct = correct && (decoded.getSize() == reference.size());
+        }
+        report("decode, sf::String::fromUtf8 on pointers", clock.getElapsedTime(), bytes, correct && (string.toUtf32() == reference));
+
+        clock.restart();
+        for (int i = 0; i < repeats; ++i)
+            correct = correct && (sf::Utf8::count(begin, end) == reference.size());
+        report("count, sf::Utf8::count on pointers", clock.getElapsedTime(), bytes, correct);
+
+        clock.restart();
+        for (int i = 0; i < repeats; ++i)
+            correct = correct && sf::Utf8::isValid(begin, end);
+        report("validate, sf::Utf8::isValid", clock.getElapsedTime(), bytes, correct);
+
+        clock.restart();
+        for (int i = 0; i < repeats; ++i)
+        {
+            std::string encoded;
+            sf::Utf32::toUtf8(reference.begin(), reference.end(), std::back_inserter(encoded));
+            correct = correct && (encoded.size() == corpus.size());
+        }
+        report("encode, generic sf::Utf32::toUtf8", clock.getElapsedTime(), bytes, correct);
+
+        clock.restart();
+        for (int i = 0; i < repeats; ++i)
+        {
+            std::basic_string<sf::Uint8> encoded = string.toUtf8();
+            correct = correct && (encoded.size() == corpus.size());
+        }
+        std::basic_string<sf::Uint8> encoded = string.toUtf8();
+        report("encode, sf::String::toUtf8", clock.getElapsedTime(), bytes, correct && (std::string(encoded.begin(), encoded.end()) == corpus));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    benchmark("ASCII", "The quick brown fox jumps over the lazy dog. Press [Enter] to continue...\n");
+    benchmark("Latin-1", "Le c\xC5\x93ur d\xC3\xA9\xC3\xA7u mais l'\xC3\xA2me plut\xC3\xB4t na\xC3\xAFve, "
+                         "Lou\xC3\xBFs r\xC3\xAAva de crapa\xC3\xBCter en cano\xC3\xAB au del\xC3\xA0 des \xC3\xAEles.\n");
+    benchmark("CJK", "\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E\xE3\x81\xAE\xE3\x83\x86\xE3\x82\xAD\xE3\x82\xB9\xE3\x83\x88\xE3\x80\x82"
+                     "\xE4\xB8\xAD\xE6\x96\x87\xE6\x96\x87\xE6\x9C\xAC\xE3\x80\x82\xED\x95\x9C\xEA\xB5\xAD\xEC\x96\xB4.\n");
+
+    // Wait until the user presses 'enter' key
+    std::cout << "Press enter to exit..." << std::endl;
+    std::cin.ignore(10000, '\n');
+
+    return EXIT_SUCCESS;
+}
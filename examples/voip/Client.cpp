@@ -5,15 +5,13 @@
 #include <SFML/Audio.hpp>
 #include <SFML/Network.hpp>
 #include <iostream>
-
-
-const sf::Uint8 audioData   = 1;
-const sf::Uint8 endOfStream = 2;
+#include <vector>
+#include "VoiceCodec.hpp"
 
 
 ////////////////////////////////////////////////////////////
 /// Specialization of audio recorder for sending recorded audio
-/// data through the network
+/// data through the network, as compressed UDP datagrams
 ////////////////////////////////////////////////////////////
 class NetworkRecorder : public sf::SoundRecorder
 {
@@ -27,9 +25,12 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     NetworkRecorder(const sf::IpAddress& host, unsigned short port) :
-    m_host(host),
-    m_port(port)
+    m_host    (host),
+    m_port    (port),
+    m_sequence(0)
     {
+        // Deliver the samples as soon as a frame is complete
+        setProcessingInterval(sf::milliseconds(20));
     }
 
 private:
@@ -40,15 +41,12 @@ private:
     ////////////////////////////////////////////////////////////
     virtual bool onStart()
     {
-        if (m_socket.connect(m_host, m_port) == sf::Socket::Done)
-        {
-            std::cout << "Connected to server " << m_host << std::endl;
-            return true;
-        }
-        else
-        {
-            return false;
-        }
+        m_sequence = 0;
+        m_state    = VoiceCodec::State();
+        m_pending.clear();
+
+        std::cout << "Sending audio to " << m_host << std::endl;
+        return true;
     }
 
     ////////////////////////////////////////////////////////////
@@ -57,13 +55,28 @@ private:
     ////////////////////////////////////////////////////////////
     virtual bool onProcessSamples(const sf::Int16* samples, std::size_t sampleCount)
     {
-        // Pack the audio samples into a network packet
-        sf::Packet packet;
-        packet << audioData;
-        packet.append(samples, sampleCount * sizeof(sf::Int16));
+        m_pending.insert(m_pending.end(), samples, samples + sampleCount);
+
+        // Send every complete frame in its own datagram
+        std::size_t offset = 0;
+        for (; offset + frameSampleCount <= m_pending.size(); offset += frameSampleCount)
+        {
+            // The header carries the sequence number (for the jitter buffer of the
+            // receiver) and the codec state (so that the frame can be decoded alone)
+            sf::Packet packet;
+            packet << audioData << m_sequence++ << m_state.predictor << m_state.index;
+
+            sf::Uint8 encoded[frameByteCount];
+            VoiceCodec::encode(&m_pending[offset], m_state, encoded);
+            packet.append(encoded, sizeof(encoded));
+
+            if (m_socket.send(packet, m_host, m_port) != sf::Socket::Done)
+                return false;
+        }
 
-        // Send the audio packet to the server
-        return m_socket.send(packet) == sf::Socket::Done;
+        m_pending.erase(m_pending.begin(), m_pending.begin() + offset);
+
+        return true;
     }
 
     ////////////////////////////////////////////////////////////
@@ -72,21 +85,25 @@ private:
     ////////////////////////////////////////////////////////////
     virtual void onStop()
     {
-        // Send a "end-of-stream" packet
-        sf::Packet packet;
-        packet << endOfStream;
-        m_socket.send(packet);
-
-        // Close the socket
-        m_socket.disconnect();
+        // Send a "end-of-stream" packet; datagrams may be lost, so repeat it
+        // (the server also gives up after a few seconds of silence)
+        for (int i = 0; i < 3; ++i)
+        {
+            sf::Packet packet;
+            packet << endOfStream;
+            m_socket.send(packet, m_host, m_port);
+        }
     }
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    sf::IpAddress  m_host;   ///< Address of the remote host
-    unsigned short m_port;   ///< Remote port
-    sf::TcpSocket  m_socket; ///< Socket used to communicate with the server
+    sf::IpAddress          m_host;     ///< Address of the remote host
+    unsigned short         m_port;     ///< Remote port
+    sf::UdpSocket          m_socket;   ///< Socket used to communicate with the server
+    sf::Uint32             m_sequence; ///< Sequence number of the next frame
+    VoiceCodec::State      m_state;    ///< State of the encoder
+    std::vector<sf::Int16> m_pending;  ///< Captured samples that don't fill a frame yet
 };
 
 
@@ -122,7 +139,7 @@ void doClient(unsigned short port)
     std::cin.ignore(10000, '\n');
 
     // Start capturing audio data
-    recorder.start(44100);
+    recorder.start(sampleRate);
     std::cout << "Recording... press enter to stop";
     std::cin.ignore(10000, '\n');
     recorder.stop();
@@ -6,11 +6,17 @@
 #include <SFML/Network.hpp>
 #include <iomanip>
 #include <iostream>
-#include <iterator>
+#include <map>
+#include <vector>
+#include "VoiceCodec.hpp"
 
 
-const sf::Uint8 audioData   = 1;
-const sf::Uint8 endOfStream = 2;
+////////////////////////////////////////////////////////////
+// Jitter buffer parameters
+////////////////////////////////////////////////////////////
+const std::size_t  jitterFrameCount  = 3;  // frames buffered before playback starts (60 ms)
+const std::size_t  maxFrameCount     = 10; // latency above which late frames are dropped (200 ms)
+const unsigned int concealFrameCount = 5;  // lost frames concealed before falling silent
 
 
 ////////////////////////////////////////////////////////////
@@ -26,11 +32,15 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     NetworkAudioStream() :
-    m_offset     (0),
-    m_hasFinished(false)
+    m_nextSequence(0),
+    m_output      (frameSampleCount, 0),
+    m_lastFrame   (frameSampleCount, 0),
+    m_lostCount   (0),
+    m_isBuffering (true),
+    m_hasFinished (false)
     {
         // Set the sound parameters
-        initialize(1, 44100);
+        initialize(1, sampleRate);
     }
 
     ////////////////////////////////////////////////////////////
@@ -39,29 +49,16 @@ public:
     ////////////////////////////////////////////////////////////
     void start(unsigned short port)
     {
-        if (!m_hasFinished)
-        {
-            // Listen to the given port for incoming connections
-            if (m_listener.listen(port) != sf::Socket::Done)
-                return;
-            std::cout << "Server is listening to port " << port << ", waiting for connections... " << std::endl;
-
-            // Wait for a connection
-            if (m_listener.accept(m_client) != sf::Socket::Done)
-                return;
-            std::cout << "Client connected: " << m_client.getRemoteAddress() << std::endl;
+        // Listen to the given port for incoming datagrams
+        if (m_socket.bind(port) != sf::Socket::Done)
+            return;
+        std::cout << "Server is listening to port " << port << ", waiting for audio... " << std::endl;
 
-            // Start playback
-            play();
+        // Start playback; it will wait until the jitter buffer is filled
+        play();
 
-            // Start receiving audio data
-            receiveLoop();
-        }
-        else
-        {
-            // Start playback
-            play();
-        }
+        // Start receiving audio data
+        receiveLoop();
     }
 
 private:
@@ -72,27 +69,62 @@ private:
     ////////////////////////////////////////////////////////////
     virtual bool onGetData(sf::SoundStream::Chunk& data)
     {
-        // We have reached the end of the buffer and all audio data have been played: we can stop playback
-        if ((m_offset >= m_samples.size()) && m_hasFinished)
-            return false;
+        // Wait until enough frames are buffered to absorb the network jitter
+        while (m_isBuffering)
+        {
+            {
+                sf::Lock lock(m_mutex);
+                if (m_frames.size() >= jitterFrameCount)
+                {
+                    m_nextSequence = m_frames.begin()->first;
+                    m_isBuffering  = false;
+                    break;
+                }
+                else if (m_hasFinished)
+                {
+                    return false;
+                }
+            }
 
-        // No new data has arrived since last update: wait until we get some
-        while ((m_offset >= m_samples.size()) && !m_hasFinished)
             sf::sleep(sf::milliseconds(10));
+        }
+
+        sf::Lock lock(m_mutex);
+
+        // We have reached the end of the stream and all audio data have been played: we can stop playback
+        if (m_frames.empty() && m_hasFinished)
+            return false;
 
-        // Copy samples into a local buffer to avoid synchronization problems
-        // (don't forget that we run in two separate threads)
+        // Catch up if a burst of frames piled up, rather than keeping the extra latency
+        while (m_frames.size() > maxFrameCount)
         {
-            sf::Lock lock(m_mutex);
-            m_tempBuffer.assign(m_samples.begin() + m_offset, m_samples.end());
+            m_nextSequence = m_frames.begin()->first + 1;
+            m_frames.erase(m_frames.begin());
         }
 
-        // Fill audio data to pass to the stream
-        data.samples     = &m_tempBuffer[0];
-        data.sampleCount = m_tempBuffer.size();
+        std::map<sf::Uint32, std::vector<sf::Int16> >::iterator it = m_frames.find(m_nextSequence);
+        if (it != m_frames.end())
+        {
+            // The expected frame has arrived: play it
+            m_output.swap(it->second);
+            m_frames.erase(it);
+            m_lostCount = 0;
+        }
+        else
+        {
+            // The frame was lost or is late: conceal it by repeating the
+            // previous frame, fading out until we fall silent
+            bool concealed = (++m_lostCount <= concealFrameCount);
+            for (std::size_t i = 0; i < m_output.size(); ++i)
+                m_output[i] = concealed ? static_cast<sf::Int16>(m_lastFrame[i] / 2) : 0;
+        }
+
+        m_lastFrame = m_output;
+        m_nextSequence++;
 
-        // Update the playing offset
-        m_offset += m_tempBuffer.size();
+        // Fill audio data to pass to the stream
+        data.samples     = &m_output[0];
+        data.sampleCount = m_output.size();
 
         return true;
     }
@@ -101,9 +133,9 @@ private:
     /// /see SoundStream::OnSeek
     ///
     ////////////////////////////////////////////////////////////
-    virtual void onSeek(sf::Time timeOffset)
+    virtual void onSeek(sf::Time)
     {
-        m_offset = timeOffset.asMilliseconds() * getSampleRate() * getChannelCount() / 1000;
+        // A live stream can't be seeked
     }
 
     ////////////////////////////////////////////////////////////
@@ -112,55 +144,88 @@ private:
     ////////////////////////////////////////////////////////////
     void receiveLoop()
     {
+        sf::SocketSelector selector;
+        selector.add(m_socket);
+
+        bool connected = false;
         while (!m_hasFinished)
         {
+            // Datagrams may be lost: give up after a few seconds of silence
+            if (connected && !selector.wait(sf::seconds(3)))
+            {
+                std::cout << "Connection timed out" << std::endl;
+                break;
+            }
+
             // Get waiting audio data from the network
             sf::Packet packet;
-            if (m_client.receive(packet) != sf::Socket::Done)
+            sf::IpAddress sender;
+            unsigned short senderPort;
+            if (m_socket.receive(packet, sender, senderPort) != sf::Socket::Done)
                 break;
 
+            if (!connected)
+                std::cout << "Receiving audio from " << sender << std::endl;
+            connected = true;
+
             // Extract the message ID
             sf::Uint8 id;
             packet >> id;
 
             if (id == audioData)
             {
-                // Extract audio samples from the packet, and append it to our samples buffer
-                const sf::Int16* samples     = reinterpret_cast<const sf::Int16*>(static_cast<const char*>(packet.getData()) + 1);
-                std::size_t      sampleCount = (packet.getDataSize() - 1) / sizeof(sf::Int16);
+                // Extract the frame header
+                sf::Uint32 sequence;
+                VoiceCodec::State state;
+                packet >> sequence >> state.predictor >> state.index;
+                if (!packet || (packet.getDataSize() != 8 + frameByteCount))
+                {
+                    std::cout << "Invalid packet received..." << std::endl;
+                    continue;
+                }
+
+                // Decode the frame
+                std::vector<sf::Int16> samples(frameSampleCount);
+                const sf::Uint8* encoded = static_cast<const sf::Uint8*>(packet.getData()) + 8;
+                VoiceCodec::decode(encoded, state, &samples[0]);
 
-                // Don't forget that the other thread can access the sample array at any time
-                // (so we protect any operation on it with the mutex)
+                // Don't forget that the other thread can access the jitter buffer at any time
+                // (so we protect any operation on it with the mutex);
+                // frames arriving after their playback time are dropped
                 {
                     sf::Lock lock(m_mutex);
-                    std::copy(samples, samples + sampleCount, std::back_inserter(m_samples));
+                    if (m_isBuffering || (sequence >= m_nextSequence))
+                        m_frames[sequence].swap(samples);
                 }
             }
             else if (id == endOfStream)
             {
                 // End of stream reached: we stop receiving audio data
                 std::cout << "Audio data has been 100% received!" << std::endl;
-                m_hasFinished = true;
+                break;
             }
             else
             {
                 // Something's wrong...
                 std::cout << "Invalid packet received..." << std::endl;
-                m_hasFinished = true;
             }
         }
+
+        m_hasFinished = true;
     }
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    sf::TcpListener        m_listener;
-    sf::TcpSocket          m_client;
-    sf::Mutex              m_mutex;
-    std::vector<sf::Int16> m_samples;
-    std::vector<sf::Int16> m_tempBuffer;
-    std::size_t            m_offset;
-    bool                   m_hasFinished;
+    sf::UdpSocket                                 m_socket;
+    sf::Mutex                                     m_mutex;
+    std::map<sf::Uint32, std::vector<sf::Int16> > m_frames;
+    sf::Uint32                                    m_nextSequence;
+    std::vector<sf::Int16>                        m_output;
+    std::vector<sf::Int16>                        m_lastFrame;
+    unsigned int                                  m_lostCount;
+    bool                                          m_isBuffering;
+    bool                                          m_hasFinished;
 };
 
 
@@ -183,18 +248,5 @@ void doServer(unsigned short port)
     }
 
     std::cin.ignore(10000, '\n');
-
-    // Wait until the user presses 'enter' key
-    std::cout << "Press enter to replay the sound..." << std::endl;
-    std::cin.ignore(10000, '\n');
-
-    // Replay the sound (just to make sure replaying the received data is OK)
-    audioStream.play();
-
-    // Loop until the sound playback is finished
-    while (audioStream.getStatus() != sf::SoundStream::Stopped)
-    {
-        // Leave some CPU time for other threads
-        sf::sleep(sf::milliseconds(100));
-    }
 }
+
@@ -0,0 +1,161 @@
+#ifndef VOICECODEC_HPP
+#define VOICECODEC_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <cstddef>
+
+
+////////////////////////////////////////////////////////////
+// Voice stream parameters: 20 ms frames of 8 kHz mono audio,
+// compressed to 4 bits per sample (32 kbps)
+////////////////////////////////////////////////////////////
+const unsigned int sampleRate       = 8000;
+const std::size_t  frameSampleCount = 160;
+const std::size_t  frameByteCount   = frameSampleCount / 2;
+
+const sf::Uint8 audioData   = 1;
+const sf::Uint8 endOfStream = 2;
+
+
+////////////////////////////////////////////////////////////
+/// IMA ADPCM voice codec
+///
+/// Every frame carries the predictor state it starts from,
+/// so that frames can be decoded independently of each other
+/// and a lost datagram doesn't corrupt the following ones.
+///
+////////////////////////////////////////////////////////////
+class VoiceCodec
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// Predictor state at the start of a frame
+    ///
+    ////////////////////////////////////////////////////////////
+    struct State
+    {
+        State() : predictor(0), index(0) {}
+
+        sf::Int16 predictor; ///< Last (predicted) sample
+        sf::Uint8 index;     ///< Index in the step table
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// Encode a frame of frameSampleCount samples
+    ///
+    /// \param samples Samples to encode
+    /// \param state   Encoder state, updated for the next frame
+    /// \param output  Array of frameByteCount bytes to fill
+    ///
+    ////////////////////////////////////////////////////////////
+    static void encode(const sf::Int16* samples, State& state, sf::Uint8* output)
+    {
+        int predictor = state.predictor;
+        int index     = state.index;
+
+        for (std::size_t i = 0; i < frameSampleCount; ++i)
+        {
+            int step = stepTable(index);
+            int diff = samples[i] - predictor;
+
+            // Quantize the difference to a sign bit and 3 magnitude bits
+            int code = 0;
+            if (diff < 0)
+            {
+                code = 8;
+                diff = -diff;
+            }
+            if (diff >= step)     {code |= 4; diff -= step;}
+            if (diff >= step / 2) {code |= 2; diff -= step / 2;}
+            if (diff >= step / 4) {code |= 1;}
+
+            // Track the decoder, so that the prediction doesn't drift
+            predictor = predict(predictor, index, code);
+
+            if (i % 2 == 0)
+                output[i / 2] = static_cast<sf::Uint8>(code);
+            else
+                output[i / 2] |= static_cast<sf::Uint8>(code << 4);
+        }
+
+        state.predictor = static_cast<sf::Int16>(predictor);
+        state.index     = static_cast<sf::Uint8>(index);
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// Decode a frame of frameSampleCount samples
+    ///
+    /// \param input   Array of frameByteCount encoded bytes
+    /// \param state   State the frame was encoded from
+    /// \param samples Array of frameSampleCount samples to fill
+    ///
+    ////////////////////////////////////////////////////////////
+    static void decode(const sf::Uint8* input, const State& state, sf::Int16* samples)
+    {
+        int predictor = state.predictor;
+        int index     = state.index < 89 ? state.index : 88;
+
+        for (std::size_t i = 0; i < frameSampleCount; ++i)
+        {
+            int code = (i % 2 == 0) ? (input[i / 2] & 0x0F) : (input[i / 2] >> 4);
+            predictor = predict(predictor, index, code);
+            samples[i] = static_cast<sf::Int16>(predictor);
+        }
+    }
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// Apply a 4-bit code to the predictor state
+    ///
+    ////////////////////////////////////////////////////////////
+    static int predict(int predictor, int& index, int code)
+    {
+        static const int indexTable[8] = {-1, -1, -1, -1, 2, 4, 6, 8};
+
+        int step = stepTable(index);
+        int diff = step / 8;
+        if (code & 4) diff += step;
+        if (code & 2) diff += step / 2;
+        if (code & 1) diff += step / 4;
+        predictor += (code & 8) ? -diff : diff;
+
+        if (predictor > 32767)
+            predictor = 32767;
+        else if (predictor < -32768)
+            predictor = -32768;
+
+        index += indexTable[code & 7];
+        if (index < 0)
+            index = 0;
+        else if (index > 88)
+            index = 88;
+
+        return predictor;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// Quantizer step size for a given index
+    ///
+    ////////////////////////////////////////////////////////////
+    static int stepTable(int index)
+    {
+        static const int table[89] =
+        {
+            7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+            50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+            253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+            1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+            3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487,
+            12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+        };
+
+        return table[index];
+    }
+};
+
+#endif // VOICECODEC_HPP
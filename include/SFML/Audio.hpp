@@ -30,6 +30,11 @@
 ////////////////////////////////////////////////////////////
 
 #include <SFML/System.hpp>
+#include <SFML/Audio/BiquadFilter.hpp>
+#include <SFML/Audio/CompressedSound.hpp>
+#include <SFML/Audio/CompressedSoundBuffer.hpp>
+#include <SFML/Audio/Compressor.hpp>
+#include <SFML/Audio/GainRamp.hpp>
 #include <SFML/Audio/InputSoundFile.hpp>
 #include <SFML/Audio/Listener.hpp>
 #include <SFML/Audio/Music.hpp>
@@ -37,8 +42,11 @@
 #include <SFML/Audio/Sound.hpp>
 #include <SFML/Audio/SoundBuffer.hpp>
 #include <SFML/Audio/SoundBufferRecorder.hpp>
+#include <SFML/Audio/SoundEffect.hpp>
+#include <SFML/Audio/SoundMixer.hpp>
 #include <SFML/Audio/SoundFileFactory.hpp>
 #include <SFML/Audio/SoundFileReader.hpp>
+#include <SFML/Audio/SoundFileRecorder.hpp>
 #include <SFML/Audio/SoundFileWriter.hpp>
 #include <SFML/Audio/SoundRecorder.hpp>
 #include <SFML/Audio/SoundSource.hpp>
@@ -0,0 +1,229 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_BIQUADFILTER_HPP
+#define SFML_BIQUADFILTER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/SoundEffect.hpp>
+#include <SFML/System/Mutex.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Second-order filter (low-pass, high-pass, equalizer, ...)
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API BiquadFilter : public SoundEffect
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Response of the filter
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Type
+    {
+        LowPass,  ///< Attenuates the frequencies above the cutoff frequency
+        HighPass, ///< Attenuates the frequencies below the cutoff frequency
+        BandPass, ///< Keeps the frequencies around the center frequency
+        Notch,    ///< Removes the frequencies around the center frequency
+        Peak,     ///< Boosts or cuts the frequencies around the center frequency by the gain
+        LowShelf, ///< Boosts or cuts the frequencies below the cutoff frequency by the gain
+        HighShelf ///< Boosts or cuts the frequencies above the cutoff frequency by the gain
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the filter
+    ///
+    /// \param type      Response of the filter
+    /// \param frequency Cutoff or center frequency, in Hz
+    /// \param quality   Quality factor (the default gives a flat low-pass or high-pass response)
+    /// \param gain      Gain of the Peak, LowShelf and HighShelf types, in decibels
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit BiquadFilter(Type type = LowPass, float frequency = 1000.f, float quality = 0.7071f, float gain = 0.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the response of the filter
+    ///
+    /// \param type New response of the filter
+    ///
+    /// \see getType
+    ///
+    ////////////////////////////////////////////////////////////
+    void setType(Type type);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the cutoff or center frequency of the filter
+    ///
+    /// The frequency is clamped below half the sample rate of
+    /// the processed stream. Changing it a little at a time,
+    /// for example every frame of a game, gives a smooth sweep.
+    ///
+    /// \param frequency New frequency, in Hz
+    ///
+    /// \see getFrequency
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFrequency(float frequency);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the quality factor of the filter
+    ///
+    /// Higher values give a narrower band, or a resonance at
+    /// the cutoff frequency. The default value is 0.7071.
+    ///
+    /// \param quality New quality factor (strictly positive)
+    ///
+    /// \see getQuality
+    ///
+    ////////////////////////////////////////////////////////////
+    void setQuality(float quality);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the gain of the Peak, LowShelf and HighShelf filters
+    ///
+    /// \param gain New gain, in decibels
+    ///
+    /// \see getGain
+    ///
+    ////////////////////////////////////////////////////////////
+    void setGain(float gain);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the response of the filter
+    ///
+    /// \return Response of the filter
+    ///
+    /// \see setType
+    ///
+    ////////////////////////////////////////////////////////////
+    Type getType() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the cutoff or center frequency of the filter
+    ///
+    /// \return Frequency, in Hz
+    ///
+    /// \see setFrequency
+    ///
+    ////////////////////////////////////////////////////////////
+    float getFrequency() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the quality factor of the filter
+    ///
+    /// \return Quality factor
+    ///
+    /// \see setQuality
+    ///
+    ////////////////////////////////////////////////////////////
+    float getQuality() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the gain of the filter
+    ///
+    /// \return Gain, in decibels
+    ///
+    /// \see setGain
+    ///
+    ////////////////////////////////////////////////////////////
+    float getGain() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Filter a block of samples, in place
+    ///
+    /// \param samples      Interleaved samples, normalized to [-1, 1]
+    /// \param frameCount   Number of frames in \a samples
+    /// \param channelCount Number of channels
+    /// \param sampleRate   Sample rate of the samples
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void process(float* samples, std::size_t frameCount, unsigned int channelCount, unsigned int sampleRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Clear the delays of the filter
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void reset();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the coefficients of the filter (the mutex must be locked)
+    ///
+    /// \param sampleRate Sample rate of the processed samples
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateCoefficients(unsigned int sampleRate);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Mutex        m_mutex;                      ///< Protects the parameters against the streaming thread
+    Type         m_type;                       ///< Response of the filter
+    float        m_frequency;                  ///< Cutoff or center frequency, in Hz
+    float        m_quality;                    ///< Quality factor
+    float        m_gain;                       ///< Gain of the Peak and shelf filters, in decibels
+    bool         m_coefficientsValid;          ///< Are the coefficients up-to-date with the parameters?
+    unsigned int m_sampleRate;                 ///< Sample rate the coefficients were computed for
+    float        m_coefficients[5];            ///< Normalized coefficients b0, b1, b2, a1 and a2
+    float        m_state[2 * MaxChannelCount]; ///< Delays of the filter (z1 of every channel, then z2)
+};
+
+} // namespace sf
+
+
+#endif // SFML_BIQUADFILTER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::BiquadFilter
+/// \ingroup audio
+///
+/// sf::BiquadFilter is the classic second-order filter of
+/// audio equalizers, computed with SSE2 or NEON instructions
+/// when available. A low-pass filter muffles a sound heard
+/// through a wall (occlusion), a high-pass filter thins a
+/// radio voice, and peak or shelf filters shape the tone of
+/// a music. Several filters can be chained on a stream for
+/// steeper slopes or multi-band equalizers.
+///
+/// Usage example:
+/// \code
+/// sf::BiquadFilter occlusion(sf::BiquadFilter::LowPass, 20000.f);
+/// music.addEffect(occlusion);
+///
+/// // In the game loop
+/// occlusion.setFrequency(playerIsInside ? 800.f : 20000.f);
+/// \endcode
+///
+/// \see sf::SoundEffect, sf::SoundStream
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef SFML_COMPRESSEDSOUND_HPP
+#define SFML_COMPRESSEDSOUND_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/SoundStream.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class CompressedSoundBuffer;
+
+////////////////////////////////////////////////////////////
+/// \brief Sound playing a compressed sound buffer, decoded
+///        while it is played
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API CompressedSound : public SoundStream
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    CompressedSound();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the sound with a buffer
+    ///
+    /// \param buffer Compressed sound buffer containing the audio data to play
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit CompressedSound(const CompressedSoundBuffer& buffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~CompressedSound();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the source buffer containing the audio data to play
+    ///
+    /// The sound is stopped first. It is important to note that
+    /// the buffer is not copied, so it must remain alive as long
+    /// as it is attached to the sound.
+    ///
+    /// \param buffer Compressed sound buffer to attach to the sound
+    ///
+    /// \see getBuffer
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBuffer(const CompressedSoundBuffer& buffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the audio buffer attached to the sound
+    ///
+    /// \return Sound buffer attached to the sound (can be NULL)
+    ///
+    ////////////////////////////////////////////////////////////
+    const CompressedSoundBuffer* getBuffer() const;
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Request a new chunk of audio samples from the stream source
+    ///
+    /// This function decodes the next blocks of the buffer.
+    ///
+    /// \param data Chunk of data to fill
+    ///
+    /// \return True to continue playback, false to stop
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool onGetData(Chunk& data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current playing position in the stream source
+    ///
+    /// \param timeOffset New playing position, from the beginning of the sound
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onSeek(Time timeOffset);
+
+private:
+
+    friend class CompressedSoundBuffer;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop the sound and detach it from its buffer
+    ///
+    /// This function is called by the buffer when it is destroyed.
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetBuffer();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const CompressedSoundBuffer* m_buffer;  ///< Sound buffer played by the sound
+    Uint64                       m_offset;  ///< Index of the next frame to decode
+    std::vector<Int16>           m_samples; ///< Decoded chunk
+    Mutex                        m_mutex;   ///< Mutex protecting the playing position
+};
+
+} // namespace sf
+
+
+#endif // SFML_COMPRESSEDSOUND_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::CompressedSound
+/// \ingroup audio
+///
+/// sf::CompressedSound plays an sf::CompressedSoundBuffer. It
+/// is a sound stream: the buffer is decoded on the streaming
+/// thread, a few blocks at a time, into a small chunk of
+/// samples that is queued to the audio driver like the chunks
+/// of an sf::Music. Only the chunks in the queue are ever held
+/// decoded in memory.
+///
+/// Apart from that, it has the same features as an sf::Sound:
+/// you can play/pause/stop it, loop it, seek in it and change
+/// the way it is played (pitch, volume, 3D position, ...).
+///
+/// \see sf::CompressedSoundBuffer, sf::Sound, sf::SoundStream
+///
+////////////////////////////////////////////////////////////
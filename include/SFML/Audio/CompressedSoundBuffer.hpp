@@ -0,0 +1,292 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef SFML_COMPRESSEDSOUNDBUFFER_HPP
+#define SFML_COMPRESSEDSOUNDBUFFER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <string>
+#include <vector>
+#include <set>
+
+
+namespace sf
+{
+class CompressedSound;
+class InputSoundFile;
+class InputStream;
+
+////////////////////////////////////////////////////////////
+/// \brief Storage for audio samples kept compressed in memory
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API CompressedSoundBuffer : NonCopyable
+{
+public:
+
+    enum {BlockFrameCount = 1024}; ///< Number of frames per compressed block, the unit of random access
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    CompressedSoundBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The sounds using the buffer are stopped and detached.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~CompressedSoundBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the buffer from a file
+    ///
+    /// The file is decoded and compressed block by block, the
+    /// whole decoded sound is never held in memory.
+    /// See the documentation of sf::InputSoundFile for the list
+    /// of supported formats.
+    ///
+    /// \param filename Path of the sound file to load
+    ///
+    /// \return True if loading succeeded, false if it failed
+    ///
+    /// \see loadFromMemory, loadFromStream, loadFromSamples
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromFile(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the buffer from a file in memory
+    ///
+    /// \param data        Pointer to the file data in memory
+    /// \param sizeInBytes Size of the data to load, in bytes
+    ///
+    /// \return True if loading succeeded, false if it failed
+    ///
+    /// \see loadFromFile, loadFromStream, loadFromSamples
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromMemory(const void* data, std::size_t sizeInBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the buffer from a custom stream
+    ///
+    /// \param stream Source stream to read from
+    ///
+    /// \return True if loading succeeded, false if it failed
+    ///
+    /// \see loadFromFile, loadFromMemory, loadFromSamples
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromStream(InputStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the buffer from an array of audio samples
+    ///
+    /// \param samples      Pointer to the array of samples in memory
+    /// \param sampleCount  Number of samples in the array
+    /// \param channelCount Number of channels (1 = mono, 2 = stereo, ...)
+    /// \param sampleRate   Sample rate (number of samples to play per second)
+    ///
+    /// \return True if loading succeeded, false if it failed
+    ///
+    /// \see loadFromFile, loadFromMemory, loadFromStream
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromSamples(const Int16* samples, Uint64 sampleCount, unsigned int channelCount, unsigned int sampleRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of samples stored in the buffer
+    ///
+    /// \return Number of samples (all channels included)
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getSampleCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sample rate of the sound
+    ///
+    /// \return Sample rate (number of samples per second)
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getSampleRate() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of channels used by the sound
+    ///
+    /// \return Number of channels
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getChannelCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the total duration of the sound
+    ///
+    /// \return Sound duration
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getDuration() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the compressed samples in memory
+    ///
+    /// \return Size of the compressed data, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCompressedSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode samples of the buffer
+    ///
+    /// This function can be called from several threads at once.
+    ///
+    /// \param frameOffset Index of the first frame to decode
+    /// \param frameCount  Maximum number of frames to decode
+    /// \param samples     Array to fill with frameCount * getChannelCount() interleaved samples
+    ///
+    /// \return Number of frames decoded (less than \a frameCount at the end of the buffer)
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t decode(Uint64 frameOffset, std::size_t frameCount, Int16* samples) const;
+
+private:
+
+    friend class CompressedSound;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compress the contents of an open sound file
+    ///
+    /// \param file Sound file to read from
+    ///
+    /// \return True on success
+    ///
+    ////////////////////////////////////////////////////////////
+    bool initialize(InputSoundFile& file);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop the sounds using the buffer and clear it
+    ///
+    /// \param channelCount Number of channels of the new contents
+    /// \param sampleRate   Sample rate of the new contents
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset(unsigned int channelCount, unsigned int sampleRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compress a block of frames and append it
+    ///
+    /// \param samples    Interleaved samples of the block
+    /// \param frameCount Number of frames, at most BlockFrameCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void appendBlock(const Int16* samples, std::size_t frameCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Finish loading: update the duration and the sounds
+    ///
+    ////////////////////////////////////////////////////////////
+    void finalize();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a sound to the list of sounds that use this buffer
+    ///
+    /// \param sound Sound instance to attach
+    ///
+    ////////////////////////////////////////////////////////////
+    void attachSound(CompressedSound* sound) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a sound from the list of sounds that use this buffer
+    ///
+    /// \param sound Sound instance to detach
+    ///
+    ////////////////////////////////////////////////////////////
+    void detachSound(CompressedSound* sound) const;
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::set<CompressedSound*> SoundList; ///< Set of unique sound instances
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Uint8> m_blocks;       ///< Compressed blocks, of m_blockSize bytes each
+    std::size_t        m_blockSize;    ///< Size of a compressed block, in bytes
+    Uint64             m_frameCount;   ///< Number of frames in the buffer
+    unsigned int       m_channelCount; ///< Number of channels
+    unsigned int       m_sampleRate;   ///< Sample rate
+    Time               m_duration;     ///< Sound duration
+    mutable SoundList  m_sounds;       ///< List of sounds that are using this buffer
+};
+
+} // namespace sf
+
+
+#endif // SFML_COMPRESSEDSOUNDBUFFER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::CompressedSoundBuffer
+/// \ingroup audio
+///
+/// An sf::SoundBuffer keeps its samples decoded, as 16-bit
+/// integers: 30 seconds of stereo ambience take 5 MB. An
+/// sf::CompressedSoundBuffer keeps them compressed with
+/// IMA-ADPCM (4 bits per sample, a quarter of the size), and
+/// they are only decoded, a small chunk at a time, while they
+/// are played by an sf::CompressedSound.
+///
+/// IMA-ADPCM is lossy but cheap to decode, its quality is fine
+/// for ambiences, voices and most effects; short sounds that
+/// are played very often should rather stay in an sf::SoundBuffer.
+///
+/// The samples are compressed in independent blocks of
+/// BlockFrameCount frames, so that playback can start at any
+/// position. Any number of sf::CompressedSound instances can
+/// play the same buffer at the same time.
+///
+/// Usage example:
+/// \code
+/// sf::CompressedSoundBuffer buffer;
+/// if (!buffer.loadFromFile("ambience.ogg"))
+///     return -1;
+///
+/// sf::CompressedSound wind(buffer);
+/// sf::CompressedSound rain(buffer);
+/// wind.setLoop(true);
+/// wind.play();
+/// rain.setPlayingOffset(sf::seconds(10));
+/// rain.play();
+/// \endcode
+///
+/// \see sf::CompressedSound, sf::SoundBuffer
+///
+////////////////////////////////////////////////////////////
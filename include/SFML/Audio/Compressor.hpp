@@ -0,0 +1,223 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_COMPRESSOR_HPP
+#define SFML_COMPRESSOR_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/SoundEffect.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Dynamic range compressor
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API Compressor : public SoundEffect
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The default settings are a threshold of -18 dB, a ratio
+    /// of 4:1, an attack of 10 ms, a release of 100 ms and no
+    /// makeup gain.
+    ///
+    ////////////////////////////////////////////////////////////
+    Compressor();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the level above which the audio is compressed
+    ///
+    /// \param threshold New threshold, in decibels (0 is the full scale)
+    ///
+    /// \see getThreshold
+    ///
+    ////////////////////////////////////////////////////////////
+    void setThreshold(float threshold);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the compression ratio
+    ///
+    /// Above the threshold, the level of the output increases
+    /// by 1 dB when the level of the input increases by
+    /// \a ratio dB. A high ratio (20 or more) makes a limiter.
+    ///
+    /// \param ratio New ratio (at least 1)
+    ///
+    /// \see getRatio
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRatio(float ratio);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set how fast the compressor reacts to louder audio
+    ///
+    /// \param attack New attack time
+    ///
+    /// \see getAttack
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAttack(Time attack);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set how fast the compressor recovers after louder audio
+    ///
+    /// \param release New release time
+    ///
+    /// \see getRelease
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRelease(Time release);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the gain applied after the compression
+    ///
+    /// \param gain New makeup gain, in decibels
+    ///
+    /// \see getMakeupGain
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMakeupGain(float gain);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the compression threshold
+    ///
+    /// \return Threshold, in decibels
+    ///
+    /// \see setThreshold
+    ///
+    ////////////////////////////////////////////////////////////
+    float getThreshold() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the compression ratio
+    ///
+    /// \return Ratio
+    ///
+    /// \see setRatio
+    ///
+    ////////////////////////////////////////////////////////////
+    float getRatio() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the attack time
+    ///
+    /// \return Attack time
+    ///
+    /// \see setAttack
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getAttack() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the release time
+    ///
+    /// \return Release time
+    ///
+    /// \see setRelease
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getRelease() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the makeup gain
+    ///
+    /// \return Makeup gain, in decibels
+    ///
+    /// \see setMakeupGain
+    ///
+    ////////////////////////////////////////////////////////////
+    float getMakeupGain() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compress a block of samples, in place
+    ///
+    /// \param samples      Interleaved samples, normalized to [-1, 1]
+    /// \param frameCount   Number of frames in \a samples
+    /// \param channelCount Number of channels
+    /// \param sampleRate   Sample rate of the samples
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void process(float* samples, std::size_t frameCount, unsigned int channelCount, unsigned int sampleRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget the level of the audio processed so far
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void reset();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Mutex m_mutex;      ///< Protects the parameters against the streaming thread
+    float m_threshold;  ///< Level above which the audio is compressed, in decibels
+    float m_ratio;      ///< Compression ratio
+    Time  m_attack;     ///< Attack time
+    Time  m_release;    ///< Release time
+    float m_makeupGain; ///< Gain applied after the compression, in decibels
+    float m_envelope;   ///< Smoothed peak level of the input
+    float m_gain;       ///< Gain applied at the end of the last block
+};
+
+} // namespace sf
+
+
+#endif // SFML_COMPRESSOR_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Compressor
+/// \ingroup audio
+///
+/// sf::Compressor reduces the level of the audio which goes
+/// above a threshold, which evens out the loudness of a mix:
+/// on a sound mixer, it keeps explosions from clipping while
+/// quieter sounds stay audible. The level is followed on
+/// the peaks of blocks of 32 frames, and the gain changes
+/// are ramped in between, so the cost per sample is little
+/// more than a multiplication.
+///
+/// Usage example:
+/// \code
+/// sf::SoundMixer effects;
+///
+/// sf::Compressor compressor;
+/// compressor.setThreshold(-12.f);
+/// compressor.setRatio(6.f);
+/// effects.addEffect(compressor);
+/// \endcode
+///
+/// \see sf::SoundEffect, sf::SoundStream, sf::SoundMixer
+///
+////////////////////////////////////////////////////////////
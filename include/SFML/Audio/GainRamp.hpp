@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_GAINRAMP_HPP
+#define SFML_GAINRAMP_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/SoundEffect.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Gain whose changes are applied smoothly
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API GainRamp : public SoundEffect
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the effect
+    ///
+    /// \param gain Initial gain (1 leaves the samples unchanged)
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit GainRamp(float gain = 1.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the gain, over a given duration
+    ///
+    /// The gain moves linearly from its current value to the
+    /// new one, so that the change doesn't produce a click.
+    /// A new call during a ramp starts a new ramp from the
+    /// value reached so far.
+    ///
+    /// \param gain     New gain (1 leaves the samples unchanged)
+    /// \param duration Duration of the transition
+    ///
+    /// \see getGain
+    ///
+    ////////////////////////////////////////////////////////////
+    void setGain(float gain, Time duration = milliseconds(20));
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the gain, as requested by the last call to setGain
+    ///
+    /// \return Gain reached at the end of the current ramp
+    ///
+    /// \see setGain
+    ///
+    ////////////////////////////////////////////////////////////
+    float getGain() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the gain to a block of samples, in place
+    ///
+    /// \param samples      Interleaved samples, normalized to [-1, 1]
+    /// \param frameCount   Number of frames in \a samples
+    /// \param channelCount Number of channels
+    /// \param sampleRate   Sample rate of the samples
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void process(float* samples, std::size_t frameCount, unsigned int channelCount, unsigned int sampleRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Finish the current ramp immediately
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void reset();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Mutex       m_mutex;           ///< Protects the parameters against the streaming thread
+    float       m_target;          ///< Gain at the end of the ramp
+    float       m_current;         ///< Gain reached by the processing
+    Time        m_duration;        ///< Duration of the ramp requested by setGain
+    bool        m_rampRequested;   ///< Has a ramp been requested since the last block?
+    std::size_t m_remainingFrames; ///< Number of frames left in the current ramp
+};
+
+} // namespace sf
+
+
+#endif // SFML_GAINRAMP_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::GainRamp
+/// \ingroup audio
+///
+/// sf::GainRamp scales the samples of a stream, like the
+/// volume of a source, but in the processing chain: it can
+/// be placed before other effects (a compressor, a filter),
+/// and its changes are ramped sample by sample instead of
+/// being applied to the whole queued audio at once. This is
+/// the building block of ducking, where the music is
+/// lowered while a dialog plays, and of fades.
+///
+/// Usage example:
+/// \code
+/// sf::GainRamp ducking;
+/// music.addEffect(ducking);
+///
+/// // When a dialog starts, and when it ends
+/// ducking.setGain(0.3f, sf::milliseconds(200));
+/// ducking.setGain(1.f, sf::seconds(1));
+/// \endcode
+///
+/// \see sf::SoundEffect, sf::SoundStream
+///
+////////////////////////////////////////////////////////////
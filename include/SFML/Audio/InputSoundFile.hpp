@@ -183,6 +183,21 @@ public:
     ////////////////////////////////////////////////////////////
     Uint64 read(Int16* samples, Uint64 maxCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read audio samples from the open file, as 32-bit floats
+    ///
+    /// Samples are normalized to the [-1, 1] range. Formats
+    /// which are decoded to floats (like Vorbis) are read
+    /// without any intermediate conversion.
+    ///
+    /// \param samples  Pointer to the sample array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 read(float* samples, Uint64 maxCount);
+
 private:
 
     ////////////////////////////////////////////////////////////
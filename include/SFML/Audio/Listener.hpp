@@ -194,6 +194,31 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     static Vector3f getUpVector();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start a batch of changes to the audio scene
+    ///
+    /// Until endUpdate is called, the changes made to the
+    /// listener and to the sounds (position, volume, pitch,
+    /// etc.) are stored without being applied: they are all
+    /// applied at once by endUpdate, which recomputes the
+    /// mixing parameters only once instead of once per change.
+    ///
+    /// Calls can be nested, only the outermost pair has an
+    /// effect. Getters keep returning the new values.
+    ///
+    /// \see endUpdate
+    ///
+    ////////////////////////////////////////////////////////////
+    static void beginUpdate();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the batch of changes started by beginUpdate
+    ///
+    /// \see beginUpdate
+    ///
+    ////////////////////////////////////////////////////////////
+    static void endUpdate();
 };
 
 } // namespace sf
@@ -231,4 +256,15 @@ public:
 /// sf::Listener::setGlobalVolume(50);
 /// \endcode
 ///
+/// When many sounds move every frame, their changes can be
+/// applied together, so that the audio engine doesn't recompute
+/// its mixing parameters after each of them:
+/// \code
+/// sf::Listener::beginUpdate();
+/// sf::Listener::setPosition(listenerPosition);
+/// for (std::size_t i = 0; i < emitters.size(); ++i)
+///     emitters[i].sound.setPosition(emitters[i].position);
+/// sf::Listener::endUpdate();
+/// \endcode
+///
 ////////////////////////////////////////////////////////////
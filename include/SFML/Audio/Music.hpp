@@ -31,6 +31,8 @@
 #include <SFML/Audio/Export.hpp>
 #include <SFML/Audio/SoundStream.hpp>
 #include <SFML/Audio/InputSoundFile.hpp>
+#include <SFML/System/BufferedInputStream.hpp>
+#include <SFML/System/FileInputStream.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Time.hpp>
 #include <string>
@@ -111,6 +113,10 @@ public:
     /// continuously, the \a stream must remain alive as long as the
     /// music is playing (i.e. you can't destroy it right after calling
     /// this function).
+    /// The stream is read ahead of time by a background thread (see
+    /// sf::BufferedInputStream), unless it is a sf::MemoryInputStream
+    /// or a sf::MappedFileInputStream. It must not be used elsewhere
+    /// while the music is open.
     ///
     /// \param stream Source stream to read from
     ///
@@ -129,6 +135,82 @@ public:
     ////////////////////////////////////////////////////////////
     Time getDuration() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the duration of the chunks read from the file
+    ///
+    /// Each buffer of the playing queue holds one chunk, so
+    /// the latency of the music (the delay after which a seek
+    /// is heard, see getLatency) is the chunk duration times
+    /// the number of buffers (see setBufferCount). Short chunks
+    /// reduce the latency and the memory used by the music, at
+    /// the cost of more frequent reads.
+    ///
+    /// The new duration applies to the chunks read after the
+    /// call. The default duration is 1 second.
+    ///
+    /// \param duration Duration of a chunk
+    ///
+    /// \see getChunkDuration
+    ///
+    ////////////////////////////////////////////////////////////
+    void setChunkDuration(Time duration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the duration of the chunks read from the file
+    ///
+    /// \return Duration of a chunk
+    ///
+    /// \see setChunkDuration
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getChunkDuration() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the section of the music played in loop
+    ///
+    /// When looping is enabled (see setLoop), the music plays
+    /// from its current position up to the end of the loop,
+    /// then jumps back to its beginning without any gap, so
+    /// that an intro can be followed by a looped section. The
+    /// loop points are rounded to the nearest sample frame,
+    /// and clamped to the duration of the music.
+    ///
+    /// If the music was opened from a file or from memory, the
+    /// beginning of the loop is prepared in advance by a second
+    /// decoder, so that jumping back costs no seek in the
+    /// streaming thread.
+    ///
+    /// The loop points are reset to the whole music when a new
+    /// music is opened. A zero length loops over the whole music.
+    ///
+    /// \param begin  Beginning of the loop, from the beginning of the music
+    /// \param length Length of the loop
+    ///
+    /// \see getLoopBegin, getLoopLength
+    ///
+    ////////////////////////////////////////////////////////////
+    void setLoopPoints(Time begin, Time length);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the beginning of the loop
+    ///
+    /// \return Beginning of the loop, from the beginning of the music
+    ///
+    /// \see setLoopPoints
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getLoopBegin() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the length of the loop
+    ///
+    /// \return Length of the loop
+    ///
+    /// \see setLoopPoints
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getLoopLength() const;
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -152,6 +234,14 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void onSeek(Time timeOffset);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current playing position to the beginning of the loop
+    ///
+    /// \return Position of the beginning of the loop, in samples
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 onLoop();
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -160,13 +250,74 @@ private:
     ////////////////////////////////////////////////////////////
     void initialize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Resize the internal buffer to the chunk duration, if needed
+    ///
+    ////////////////////////////////////////////////////////////
+    void resizeChunk();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open the shadow decoder, if needed, and seek it to the beginning of the loop
+    ///
+    ////////////////////////////////////////////////////////////
+    void prepareShadow();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open a decoder on a file read through a read-ahead buffer
+    ///
+    /// \param decoder  Decoder to open
+    /// \param source   Stream to open on the file
+    /// \param buffer   Read-ahead buffer to open on the stream
+    /// \param filename Path of the music file
+    ///
+    /// \return True if the decoder was successfully opened
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool openBuffered(InputSoundFile& decoder, FileInputStream& source, BufferedInputStream& buffer, const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert a time offset to a whole number of samples
+    ///
+    /// \param offset Time offset to convert
+    ///
+    /// \return Number of samples, rounded to whole sample frames
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 timeToSamples(Time offset) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert a number of samples to a time offset
+    ///
+    /// \param samples Number of samples to convert
+    ///
+    /// \return Time offset
+    ///
+    ////////////////////////////////////////////////////////////
+    Time samplesToTime(Uint64 samples) const;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    InputSoundFile     m_file;     ///< The streamed music file
-    Time               m_duration; ///< Music duration
-    std::vector<Int16> m_samples;  ///< Temporary buffer of samples
-    Mutex              m_mutex;    ///< Mutex protecting the data
+    FileInputStream     m_fileSource;       ///< Music file, when opened from the disk
+    FileInputStream     m_shadowFileSource; ///< Music file read by the shadow decoder
+    BufferedInputStream m_buffer;           ///< Read-ahead buffer in front of the music file or stream
+    BufferedInputStream m_shadowBuffer;     ///< Read-ahead buffer in front of the shadow decoder's file
+    InputSoundFile      m_file;             ///< The streamed music file
+    InputSoundFile      m_shadowFile;       ///< Second decoder of the music, prepared at the beginning of the loop
+    InputSoundFile*     m_decoder;          ///< Decoder currently read (one of the two files)
+    InputSoundFile*     m_shadow;           ///< Decoder waiting at the beginning of the loop (the other file)
+    bool                m_shadowOpen;       ///< Is the shadow decoder open on the current music?
+    bool                m_shadowReady;      ///< Is the shadow decoder open and at the beginning of the loop?
+    std::string         m_filename;         ///< Path of the music file, to open the shadow decoder
+    const void*         m_data;             ///< Music file in memory, to open the shadow decoder
+    std::size_t         m_dataSize;         ///< Size of the music file in memory
+    Uint64              m_position;         ///< Current read position, in samples
+    Uint64              m_loopBegin;        ///< Beginning of the loop, in samples
+    Uint64              m_loopEnd;          ///< End of the loop, in samples
+    Time                m_duration;         ///< Music duration
+    Time                m_chunkDuration;    ///< Duration of the chunks read from the file
+    std::vector<Int16>  m_samples;          ///< Temporary buffer of samples
+    Mutex               m_mutex;            ///< Mutex protecting the data
 };
 
 } // namespace sf
@@ -195,6 +346,17 @@ private:
 /// leave the music alone after calling play(), it will manage itself
 /// very well.
 ///
+/// Files are read ahead of the decoding by a thread of their
+/// own (see sf::BufferedInputStream), so that slow storage
+/// doesn't cause gaps in the playback. This is also the case
+/// for custom streams passed to openFromStream, except for
+/// streams already in memory.
+///
+/// Loop points (see setLoopPoints) restrict the looped part
+/// of the music to a section, which is useful for musics made
+/// of an intro followed by a loop. The jump back to the
+/// beginning of the loop is sample accurate and gapless.
+///
 /// Usage example:
 /// \code
 /// // Declare a new music
@@ -212,6 +374,9 @@ private:
 /// music.setVolume(50);         // reduce the volume
 /// music.setLoop(true);         // make it loop
 ///
+/// // Play the intro once, then loop from 4.5 s to 36 s
+/// music.setLoopPoints(sf::seconds(4.5f), sf::seconds(31.5f));
+///
 /// // Play it
 /// music.play();
 /// \endcode
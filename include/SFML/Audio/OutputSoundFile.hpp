@@ -36,6 +36,7 @@
 namespace sf
 {
 class SoundFileWriter;
+class TaskScheduler;
 
 ////////////////////////////////////////////////////////////
 /// \brief Provide write access to sound files
@@ -73,6 +74,25 @@ public:
     ////////////////////////////////////////////////////////////
     bool openFromFile(const std::string& filename, unsigned int sampleRate, unsigned int channelCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Encode the next files in parallel with a task scheduler
+    ///
+    /// FLAC files are made of frames that can be encoded
+    /// independently: with a scheduler, the samples passed to
+    /// write are split into segments encoded by its workers,
+    /// and the calling thread only writes the encoded frames
+    /// in order. Formats that must be encoded sequentially
+    /// (Ogg/Vorbis, WAV) ignore the scheduler.
+    ///
+    /// The scheduler applies to the files opened after the
+    /// call, and must remain alive until they are closed.
+    /// By default, files are encoded on the calling thread.
+    ///
+    /// \param scheduler Task scheduler to use, or NULL to encode on the calling thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTaskScheduler(TaskScheduler* scheduler);
+
     ////////////////////////////////////////////////////////////
     /// \brief Write audio samples to the file
     ///
@@ -82,18 +102,23 @@ public:
     ////////////////////////////////////////////////////////////
     void write(const Int16* samples, Uint64 count);
 
-private:
-
     ////////////////////////////////////////////////////////////
     /// \brief Close the current file
     ///
+    /// The file is finalized (headers, pending encoded data)
+    /// and can be read by other programs. This is done by the
+    /// destructor as well.
+    ///
     ////////////////////////////////////////////////////////////
     void close();
 
+private:
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    SoundFileWriter* m_writer; ///< Writer that handles I/O on the file's format
+    SoundFileWriter* m_writer;    ///< Writer that handles I/O on the file's format
+    TaskScheduler*   m_scheduler; ///< Task scheduler passed to the next writers
 };
 
 } // namespace sf
@@ -128,6 +153,27 @@ private:
 /// }
 /// \endcode
 ///
+/// Large FLAC files can be encoded on all the cores with
+/// setTaskScheduler. To convert many files, it is usually
+/// better to give each worker of a scheduler its own file:
+/// \code
+/// struct Convert
+/// {
+///     void operator ()(std::size_t index) const
+///     {
+///         sf::InputSoundFile input;
+///         sf::OutputSoundFile output;
+///         ... // read files[index], write its .flac version
+///     }
+///
+///     const std::vector<std::string>& files;
+/// };
+///
+/// sf::TaskScheduler scheduler;
+/// Convert convert = {files};
+/// scheduler.parallelFor(0, files.size(), convert, 1);
+/// \endcode
+///
 /// \see sf::SoundFileWriter, sf::InputSoundFile
 ///
 ////////////////////////////////////////////////////////////
@@ -30,13 +30,16 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Export.hpp>
 #include <SFML/Audio/SoundSource.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Time.hpp>
 #include <cstdlib>
+#include <vector>
 
 
 namespace sf
 {
 class SoundBuffer;
+class SoundMixer;
 
 ////////////////////////////////////////////////////////////
 /// \brief Regular sound that can be played in the audio environment
@@ -46,6 +49,30 @@ class SFML_AUDIO_API Sound : public SoundSource
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Usage of the voices shared by all the sounds
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_AUDIO_API VoiceStatistics
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Sets all the counters to zero.
+        ///
+        ////////////////////////////////////////////////////////////
+        VoiceStatistics();
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        unsigned int voices;        ///< Voices (OpenAL sources) created for the sounds
+        unsigned int busyVoices;    ///< Voices attached to a sound
+        unsigned int sounds;        ///< Existing sounds
+        unsigned int virtualSounds; ///< Sounds playing or paused without a voice
+        Uint64       voiceSteals;   ///< Voices taken from a less important sound since the program started
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -186,11 +213,136 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Get the current status of the sound (stopped, paused, playing)
     ///
+    /// Once updateStatuses() has been called, this function
+    /// returns the status as of its last call (or of the last
+    /// call to play(), pause() or stop()), without querying
+    /// the audio driver.
+    ///
     /// \return Current status of the sound
     ///
+    /// \see updateStatuses
+    ///
     ////////////////////////////////////////////////////////////
     Status getStatus() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the priority of the sound
+    ///
+    /// When all the voices are in use, playing a sound takes
+    /// the voice of a playing sound with a lower priority (or
+    /// with the same priority but quieter), which continues
+    /// virtually until a voice is available again.
+    /// The default priority is 0.
+    ///
+    /// \param priority New priority of the sound
+    ///
+    /// \see getPriority, setVoiceCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPriority(int priority);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the priority of the sound
+    ///
+    /// \return Priority of the sound
+    ///
+    /// \see setPriority
+    ///
+    ////////////////////////////////////////////////////////////
+    int getPriority() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of voices shared by all the sounds
+    ///
+    /// A voice is an OpenAL source; only that many sounds can
+    /// be heard at the same time, the others play virtually.
+    /// Voices are created once, when the first sound is
+    /// constructed, and recycled afterwards. The count can be
+    /// lower than requested if the audio device can't provide
+    /// that many sources. The default count is 64.
+    ///
+    /// \param count Number of voices (at least 1)
+    ///
+    /// \see getVoiceCount, setPriority
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setVoiceCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of voices shared by all the sounds
+    ///
+    /// \return Requested number of voices
+    ///
+    /// \see setVoiceCount
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getVoiceCount();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current usage of the voices
+    ///
+    /// When all the voices are busy and sounds keep playing
+    /// virtually, or voices are often stolen, the voice count
+    /// (see setVoiceCount) is too low for the application.
+    ///
+    /// \return Counters of the voices and the sounds
+    ///
+    /// \see getVoiceCount, SoundStream::getGlobalStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    static VoiceStatistics getVoiceStatistics();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the status of all the sounds at once
+    ///
+    /// Querying the status of a sound is a round-trip to the
+    /// audio driver; games which look for finished sounds every
+    /// frame should call this function once per frame instead.
+    /// It queries the voices in a single pass, gives the voices
+    /// of the finished sounds back to the pool immediately, and
+    /// reports the sounds which finished since the last call.
+    ///
+    /// After the first call, getStatus() returns the statuses
+    /// cached by this function. Sounds routed to a mixer are
+    /// not concerned, their status never involves the driver.
+    ///
+    /// \param finished Vector to append the sounds which finished playing to, or NULL
+    ///
+    /// \return Number of sounds which finished playing since the last call
+    ///
+    /// \see getStatus
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::size_t updateStatuses(std::vector<Sound*>* finished = NULL);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Route the sound to a software mixer
+    ///
+    /// A sound which is routed to a mixer doesn't use any voice
+    /// of the pool: it is mixed by \a mixer, together with the
+    /// other sounds of the mixer, into a single stream.
+    /// The sound is stopped if it was playing. Pass NULL to go
+    /// back to regular playback. The mixer must remain alive
+    /// as long as the sound uses it (if it is destroyed first,
+    /// the sound falls back to regular playback).
+    ///
+    /// \param mixer Mixer to use, or NULL
+    ///
+    /// \see getMixer
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMixer(SoundMixer* mixer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the software mixer the sound is routed to
+    ///
+    /// \return Mixer of the sound, or NULL if it uses regular playback
+    ///
+    /// \see setMixer
+    ///
+    ////////////////////////////////////////////////////////////
+    SoundMixer* getMixer() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -214,10 +366,84 @@ public:
 
 private:
 
+    friend class SoundMixer;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Attach a voice to the sound and resume its playback on it
+    ///
+    /// \param voice OpenAL source to use
+    ///
+    ////////////////////////////////////////////////////////////
+    void attachVoice(unsigned int voice);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Detach the voice of the sound
+    ///
+    /// If the sound was playing or paused, it continues
+    /// virtually from the current sample.
+    ///
+    /// \return OpenAL source that was used by the sound
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int detachVoice();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the status of the sound from its voice or its virtual playback
+    ///
+    /// \return Current status of the sound
+    ///
+    ////////////////////////////////////////////////////////////
+    Status computeStatus() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current playing position of a sound without voice
+    ///
+    /// \return Current position in sample frames, not wrapped by looping
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getVirtualOffset() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the volume at which the listener hears the sound
+    ///
+    /// \return Volume attenuated by the distance to the listener
+    ///
+    ////////////////////////////////////////////////////////////
+    float getAudibility() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find a voice for a sound, taking it from a less important sound if necessary
+    ///
+    /// \param sound Sound which needs a voice
+    ///
+    /// \return True if a voice was attached to the sound
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool acquireVoice(Sound& sound);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give the available voices back to the virtual sounds
+    ///
+    ////////////////////////////////////////////////////////////
+    static void restoreVirtualSounds();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take back the voices of the sounds which played until their end
+    ///
+    ////////////////////////////////////////////////////////////
+    static void reclaimEndedVoices();
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    const SoundBuffer* m_buffer; ///< Sound buffer bound to the source
+    const SoundBuffer* m_buffer;        ///< Sound buffer bound to the source
+    bool               m_loop;          ///< Loop flag (true to loop, false to play once)
+    int                m_priority;      ///< Priority of the sound when voices are stolen
+    Status             m_virtualStatus; ///< Status of the sound while it has no voice
+    Status             m_status;        ///< Status reported when the statuses are cached (see updateStatuses)
+    Uint64             m_virtualOffset; ///< Position (in sample frames) when m_virtualClock was restarted
+    Clock              m_virtualClock;  ///< Time elapsed since the virtual playback was resumed
+    SoundMixer*        m_mixer;         ///< Software mixer the sound is routed to, if any
 };
 
 } // namespace sf
@@ -249,6 +475,18 @@ private:
 /// as long as the sound uses it. Note that multiple sounds
 /// can use the same sound buffer at the same time.
 ///
+/// Sounds share a fixed pool of voices (see setVoiceCount()).
+/// When they are all busy, the least important sounds (lowest
+/// priority, then quietest) are virtualized: they keep playing
+/// silently, and resume on a voice at the right sample as soon
+/// as one is freed by another sound being stopped or played.
+/// To play more sounds at once, route them to a software
+/// mixer instead (see setMixer() and sf::SoundMixer).
+///
+/// Games which recycle many sounds should call
+/// updateStatuses() once per frame: it finds the finished
+/// sounds in a single pass, and makes getStatus() free.
+///
 /// Usage example:
 /// \code
 /// sf::SoundBuffer buffer;
@@ -259,6 +497,6 @@ private:
 /// sound.play();
 /// \endcode
 ///
-/// \see sf::SoundBuffer, sf::Music
+/// \see sf::SoundBuffer, sf::Music, sf::SoundMixer
 ///
 ////////////////////////////////////////////////////////////
@@ -85,6 +85,42 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromFile(const std::string& filename);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading the sound buffer from a file in the background
+    ///
+    /// This function returns immediately: the file is decoded by
+    /// a pool of worker threads (one per CPU core) shared by all
+    /// the sound buffers, so that many files can be loaded in
+    /// parallel. The samples are uploaded to the audio driver by
+    /// isReady(), on the calling thread, when the decoding is over.
+    /// The buffer must not be used by sounds until then.
+    ///
+    /// \param filename Path of the sound file to load
+    ///
+    /// \return True if the loading started
+    ///
+    /// \see isReady, loadFromFile
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromFileAsync(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the background loading is over
+    ///
+    /// This function never blocks. When it returns true for the
+    /// first time after loadFromFileAsync(), it uploads the
+    /// decoded samples; if the loading failed (the errors are
+    /// written to the standard error output), the previous
+    /// content of the buffer is kept. It always returns true for
+    /// buffers loaded with the synchronous functions.
+    ///
+    /// \return True if the loading is over, false if it is still running
+    ///
+    /// \see loadFromFileAsync
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReady();
+
     ////////////////////////////////////////////////////////////
     /// \brief Load the sound buffer from a file in memory
     ///
@@ -156,9 +192,10 @@ public:
     /// (sf::Int16). The total number of samples in this array
     /// is given by the getSampleCount() function.
     ///
-    /// \return Read-only pointer to the array of sound samples
+    /// \return Read-only pointer to the array of sound samples,
+    ///         or NULL if the samples were not kept after upload
     ///
-    /// \see getSampleCount
+    /// \see getSampleCount, setSamplesKept
     ///
     ////////////////////////////////////////////////////////////
     const Int16* getSamples() const;
@@ -213,6 +250,71 @@ public:
     ////////////////////////////////////////////////////////////
     Time getDuration() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Choose whether to keep a copy of the samples after upload
+    ///
+    /// Once uploaded to the audio driver, the samples are only
+    /// needed on the CPU side by getSamples(), saveToFile() and
+    /// the copy of the buffer. Releasing them halves the memory
+    /// used by the sound. In this mode, loadFromFile() also maps
+    /// the file in memory instead of reading it, and uploads the
+    /// samples of 16-bit WAV files directly from the mapped pages.
+    ///
+    /// Changing this setting releases the current samples if
+    /// \a keep is false, but doesn't bring them back otherwise:
+    /// it applies to the next loading.
+    /// The default is to keep the samples.
+    ///
+    /// \param keep True to keep the samples, false to release them after upload
+    ///
+    /// \see areSamplesKept, getSamples
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSamplesKept(bool keep);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a copy of the samples is kept after upload
+    ///
+    /// \return True if the samples are kept, false otherwise
+    ///
+    /// \see setSamplesKept
+    ///
+    ////////////////////////////////////////////////////////////
+    bool areSamplesKept() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the conversion to the mixing rate of the device
+    ///
+    /// When enabled, the samples loaded afterwards are converted
+    /// to the sample rate at which the audio device mixes (often
+    /// 48 kHz), with a high quality filter. The conversion
+    /// happens once, when loading, instead of every time the
+    /// sound is played: the sounds of the buffer then cost no
+    /// resampling when they are played at their normal pitch.
+    /// Loading takes more time, and the buffer uses more memory
+    /// if its sample rate was lower than the device's.
+    ///
+    /// getSampleRate() and getSamples() return the converted
+    /// rate and samples.
+    /// The conversion is disabled by default.
+    ///
+    /// \param enabled True to convert the loaded samples, false to keep their rate
+    ///
+    /// \see isResamplingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setResamplingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the loaded samples are converted to the mixing rate of the device
+    ///
+    /// \return True if the conversion is enabled, false otherwise
+    ///
+    /// \see setResamplingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isResamplingEnabled() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -223,6 +325,20 @@ public:
     ////////////////////////////////////////////////////////////
     SoundBuffer& operator =(const SoundBuffer& right);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the contents of this buffer with those of another
+    ///
+    /// The samples and the OpenAL buffers are exchanged without
+    /// being copied. The sounds using either buffer are stopped,
+    /// and keep using the same sf::SoundBuffer instance (thus its
+    /// new contents). Background loadings of both buffers are
+    /// cancelled.
+    ///
+    /// \param right Instance to swap with
+    ///
+    ////////////////////////////////////////////////////////////
+    void swap(SoundBuffer& right);
+
 private:
 
     friend class Sound;
@@ -248,6 +364,34 @@ private:
     ////////////////////////////////////////////////////////////
     bool update(unsigned int channelCount, unsigned int sampleRate);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload audio samples to the internal buffer
+    ///
+    /// \param samples      Pointer to the array of samples
+    /// \param sampleCount  Number of samples in the array
+    /// \param channelCount Number of channels
+    /// \param sampleRate   Sample rate (number of samples per second)
+    ///
+    /// \return True on success, false if any error happened
+    ///
+    ////////////////////////////////////////////////////////////
+    bool upload(const Int16* samples, Uint64 sampleCount, unsigned int channelCount, unsigned int sampleRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Cancel the background loading of the buffer, if any
+    ///
+    /// If a worker thread is decoding the file, this function
+    /// waits until it is done.
+    ///
+    ////////////////////////////////////////////////////////////
+    void cancelLoading();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Report the changes of the memory used to sf::ResourceMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateAccounting();
+
     ////////////////////////////////////////////////////////////
     /// \brief Add a sound to the list of sounds that use this buffer
     ///
@@ -272,10 +416,16 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    unsigned int       m_buffer;   ///< OpenAL buffer identifier
-    std::vector<Int16> m_samples;  ///< Samples buffer
-    Time               m_duration; ///< Sound duration
-    mutable SoundList  m_sounds;   ///< List of sounds that are using this buffer
+    unsigned int       m_buffer;      ///< OpenAL buffer identifier
+    std::vector<Int16> m_samples;     ///< Samples buffer (empty if they are not kept)
+    Uint64             m_sampleCount; ///< Number of samples in the OpenAL buffer
+    bool               m_keepSamples; ///< Keep m_samples after upload?
+    bool               m_resample;    ///< Convert the loaded samples to the mixing rate of the device?
+    bool               m_loading;     ///< Is a file being loaded in the background?
+    Time               m_duration;    ///< Sound duration
+    mutable SoundList  m_sounds;      ///< List of sounds that are using this buffer
+    Uint64             m_deviceBytes; ///< Size of the OpenAL buffer last reported to ResourceMemory
+    Uint64             m_hostBytes;   ///< Size of the samples last reported to ResourceMemory
 };
 
 } // namespace sf
@@ -320,6 +470,23 @@ private:
 /// used by a sf::Sound (i.e. never write a function that
 /// uses a local sf::SoundBuffer instance for loading a sound).
 ///
+/// Many files can be decoded in parallel with loadFromFileAsync():
+/// \code
+/// std::vector<sf::SoundBuffer> buffers(filenames.size());
+/// for (std::size_t i = 0; i < filenames.size(); ++i)
+///     buffers[i].loadFromFileAsync(filenames[i]);
+///
+/// // Upload the buffers as they are decoded
+/// std::size_t ready = 0;
+/// while (ready < buffers.size())
+/// {
+///     ready = 0;
+///     for (std::size_t i = 0; i < buffers.size(); ++i)
+///         ready += buffers[i].isReady() ? 1 : 0;
+///     // draw a loading screen...
+/// }
+/// \endcode
+///
 /// Usage example:
 /// \code
 /// // Declare a new sound buffer
@@ -0,0 +1,129 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SOUNDEFFECT_HPP
+#define SFML_SOUNDEFFECT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <cstdlib>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Abstract base class for the processing stages of a sound stream
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API SoundEffect
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Maximum number of channels an effect has to handle
+    ///
+    ////////////////////////////////////////////////////////////
+    enum
+    {
+        MaxChannelCount = 8 ///< Channels of the largest format (7.1)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Virtual destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~SoundEffect() {}
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Process a block of samples, in place
+    ///
+    /// This function is called by the streaming thread, for
+    /// every chunk of the streams the effect is attached to.
+    /// It must not allocate, lock for long or block, since
+    /// the audio plays while it runs.
+    ///
+    /// \param samples      Interleaved samples, normalized to [-1, 1]
+    /// \param frameCount   Number of frames in \a samples
+    /// \param channelCount Number of channels (at most MaxChannelCount)
+    /// \param sampleRate   Sample rate of the samples
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void process(float* samples, std::size_t frameCount, unsigned int channelCount, unsigned int sampleRate) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget the samples processed so far
+    ///
+    /// This function is called when a stream starts playing
+    /// or is seeked, so that the state of the effect (delays,
+    /// envelopes, ...) doesn't leak the previous audio into
+    /// the new one. The default implementation does nothing.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void reset() {}
+};
+
+} // namespace sf
+
+
+#endif // SFML_SOUNDEFFECT_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SoundEffect
+/// \ingroup audio
+///
+/// Sound effects process the audio of sound streams (musics,
+/// custom streams and sound mixers) before it is queued for
+/// playback, see sf::SoundStream::addEffect. SFML provides
+/// a biquad filter (sf::BiquadFilter), a smoothed gain
+/// (sf::GainRamp) and a compressor (sf::Compressor); other
+/// effects can be written by overriding the process function.
+///
+/// The samples are given as floats, whatever the format of
+/// the stream, and are processed in place. An effect instance
+/// keeps the state of the audio it processes, so it must be
+/// attached to a single stream.
+///
+/// Usage example:
+/// \code
+/// class Distortion : public sf::SoundEffect
+/// {
+/// public:
+///
+///     virtual void process(float* samples, std::size_t frameCount, unsigned int channelCount, unsigned int)
+///     {
+///         for (std::size_t i = 0; i < frameCount * channelCount; ++i)
+///             samples[i] = std::tanh(samples[i] * 4.f);
+///     }
+/// };
+///
+/// Distortion distortion;
+/// music.addEffect(distortion);
+/// \endcode
+///
+/// \see sf::SoundStream, sf::BiquadFilter, sf::GainRamp, sf::Compressor
+///
+////////////////////////////////////////////////////////////
@@ -86,7 +86,12 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Instantiate the right reader for the given file on disk
     ///
-    /// It's up to the caller to release the returned reader
+    /// It's up to the caller to release the returned reader.
+    ///
+    /// The format found is remembered for the path, and for
+    /// its extension: opening the file again doesn't check it,
+    /// and the reader which matched the extension last time
+    /// is checked first for other files.
     ///
     /// \param filename Path of the sound file
     ///
@@ -138,6 +143,17 @@ public:
     ////////////////////////////////////////////////////////////
     static SoundFileWriter* createWriterFromFilename(const std::string& filename);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget the formats remembered for the files opened so far
+    ///
+    /// Call this function if sound files are replaced by files
+    /// of another format while the program runs.
+    ///
+    /// \see createReaderFromFilename
+    ///
+    ////////////////////////////////////////////////////////////
+    static void clearFormatCache();
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -157,6 +173,20 @@ private:
     };
     typedef std::vector<WriterFactory> WriterFactoryArray;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the reader which can handle a stream
+    ///
+    /// The beginning of the stream is read once and shared by
+    /// the checks of all the readers.
+    ///
+    /// \param stream    Source stream to check, from its beginning
+    /// \param preferred Creation function of the reader to check first, or null
+    ///
+    /// \return Factory of the reader found, or null if no reader can handle the stream
+    ///
+    ////////////////////////////////////////////////////////////
+    static const ReaderFactory* findReader(InputStream& stream, SoundFileReader* (*preferred)());
+
     ////////////////////////////////////////////////////////////
     // Static member data
     ////////////////////////////////////////////////////////////
@@ -97,6 +97,23 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     virtual Uint64 read(Int16* samples, Uint64 maxCount) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read audio samples from the open file, as 32-bit floats
+    ///
+    /// Samples are normalized to the [-1, 1] range. The default
+    /// implementation converts the output of the 16-bit read
+    /// function; readers of formats which are decoded to
+    /// floating point samples should override it, to avoid the
+    /// round trip through 16-bit integers.
+    ///
+    /// \param samples  Pointer to the sample array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Uint64 read(float* samples, Uint64 maxCount);
 };
 
 } // namespace sf
@@ -151,6 +168,12 @@ public:
 ///         // as 16-bits signed integers in the file
 ///         // return the actual number of samples read
 ///     }
+///
+///     // optional: only if samples are decoded as floats
+///     virtual sf::Uint64 read(float* samples, sf::Uint64 maxCount)
+///     {
+///         // same as above, with samples normalized to [-1, 1]
+///     }
 /// };
 ///
 /// sf::SoundFileFactory::registerReader<MySoundFileReader>();
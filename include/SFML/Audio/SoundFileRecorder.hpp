@@ -0,0 +1,222 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef SFML_SOUNDFILERECORDER_HPP
+#define SFML_SOUNDFILERECORDER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/OutputSoundFile.hpp>
+#include <SFML/Audio/SoundRecorder.hpp>
+#include <SFML/System/ConditionVariable.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/Time.hpp>
+#include <deque>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Specialized SoundRecorder which writes the captured
+///        audio data to a sound file while recording
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API SoundFileRecorder : public SoundRecorder
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    SoundFileRecorder();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Stops the capture and closes the file.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SoundFileRecorder();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the path of the sound file to write
+    ///
+    /// The file is created when the capture starts (see start),
+    /// and overwritten if it already exists. Its format is
+    /// deduced from the extension; see the documentation of
+    /// sf::OutputSoundFile for the list of supported formats.
+    ///
+    /// \param filename Path of the sound file to write
+    ///
+    /// \see getFilename
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFilename(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the path of the sound file to write
+    ///
+    /// \return Path of the sound file
+    ///
+    /// \see setFilename
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::string& getFilename() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum duration of audio waiting to be written
+    ///
+    /// The captured samples are queued for the thread which
+    /// encodes and writes them. If it can't keep up (slow disk,
+    /// expensive format), the samples that don't fit in the
+    /// queue are dropped rather than using more memory (see
+    /// getDroppedSampleCount).
+    ///
+    /// The default duration is 10 seconds.
+    ///
+    /// \param duration Maximum duration of the queued samples
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMaxQueuedDuration(Time duration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of samples written to the file
+    ///
+    /// \return Number of samples written since the capture started
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getSampleCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of samples dropped because the queue was full
+    ///
+    /// \return Number of samples dropped since the capture started
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getDroppedSampleCount() const;
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start capturing audio data
+    ///
+    /// \return True to start the capture, or false to abort it
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool onStart();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Process a new chunk of recorded samples
+    ///
+    /// \param samples     Pointer to the new chunk of recorded samples
+    /// \param sampleCount Number of samples pointed by \a samples
+    ///
+    /// \return True to continue the capture, or false to stop it
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool onProcessSamples(const Int16* samples, std::size_t sampleCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop capturing audio data
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onStop();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function of the writing thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void write();
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::vector<Int16> Chunk;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    OutputSoundFile     m_file;               ///< Sound file being written
+    std::string         m_filename;           ///< Path of the sound file
+    Thread              m_thread;             ///< Writing thread
+    mutable Mutex       m_mutex;              ///< Mutex protecting the queue and the counters
+    ConditionVariable   m_condition;          ///< Signals new chunks and the end of the capture
+    std::deque<Chunk*>  m_queue;              ///< Chunks waiting to be written
+    std::vector<Chunk*> m_freeChunks;         ///< Chunks reused for the next samples
+    std::size_t         m_queuedSamples;      ///< Number of samples in the queue
+    Time                m_maxQueuedDuration;  ///< Maximum duration of the queued samples
+    bool                m_stopping;           ///< Must the writing thread stop once the queue is empty?
+    Uint64              m_sampleCount;        ///< Number of samples written
+    Uint64              m_droppedSampleCount; ///< Number of samples dropped
+};
+
+} // namespace sf
+
+
+#endif // SFML_SOUNDFILERECORDER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SoundFileRecorder
+/// \ingroup audio
+///
+/// sf::SoundFileRecorder writes a recorded sound directly to
+/// a sound file. Unlike sf::SoundBufferRecorder, which keeps
+/// the whole recording in memory until it is stopped, its
+/// memory usage doesn't grow with the duration of the capture,
+/// which makes it suitable for long sessions.
+///
+/// The captured samples are passed to a thread of the recorder,
+/// which encodes them and writes them to the file while the
+/// capture goes on. The queue between the two threads is
+/// bounded (see setMaxQueuedDuration).
+///
+/// As usual, don't forget to call the isAvailable() function
+/// before using this class (see sf::SoundRecorder for more details
+/// about this).
+///
+/// Usage example:
+/// \code
+/// if (sf::SoundFileRecorder::isAvailable())
+/// {
+///     sf::SoundFileRecorder recorder;
+///     recorder.setFilename("session.flac");
+///
+///     // The file is complete once the capture is stopped
+///     recorder.start();
+///     ...
+///     recorder.stop();
+/// }
+/// \endcode
+///
+/// \see sf::SoundRecorder, sf::SoundBufferRecorder, sf::OutputSoundFile
+///
+////////////////////////////////////////////////////////////
@@ -34,6 +34,8 @@
 
 namespace sf
 {
+class TaskScheduler;
+
 ////////////////////////////////////////////////////////////
 /// \brief Abstract base class for sound file encoding
 ///
@@ -68,6 +70,20 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     virtual void write(const Int16* samples, Uint64 count) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the task scheduler used to encode in parallel
+    ///
+    /// This function is called before open. Writers of formats
+    /// whose blocks can be encoded independently can use the
+    /// scheduler to encode several blocks at once; the default
+    /// implementation ignores it and encodes on the calling
+    /// thread.
+    ///
+    /// \param scheduler Task scheduler to use, or NULL to encode on the calling thread
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setTaskScheduler(TaskScheduler* scheduler) {(void)scheduler;}
 };
 
 } // namespace sf
@@ -0,0 +1,265 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SOUNDMIXER_HPP
+#define SFML_SOUNDMIXER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/Audio/SoundStream.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Time.hpp>
+#include <set>
+#include <vector>
+
+
+namespace sf
+{
+class Sound;
+
+////////////////////////////////////////////////////////////
+/// \brief Bus which mixes many sounds into a single stream
+///
+////////////////////////////////////////////////////////////
+class SFML_AUDIO_API SoundMixer : public SoundStream
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    ///
+    /// \param sampleRate Sample rate of the mix, in samples per second
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit SoundMixer(unsigned int sampleRate = 44100);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The sounds which are routed to the mixer fall back to
+    /// regular playback.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SoundMixer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of sounds currently being mixed
+    ///
+    /// \return Number of playing or paused sounds
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPlayingCount() const;
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mix the next chunk of audio
+    ///
+    /// \param data Chunk of data to fill
+    ///
+    /// \return Always true, the mix never ends by itself
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool onGetData(FloatChunk& data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current playing position in the stream
+    ///
+    /// The mix can't be seeked, this function does nothing.
+    ///
+    /// \param timeOffset New playing position
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onSeek(Time timeOffset);
+
+private:
+
+    friend class Sound;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Playback state of a sound in the mix
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Voice
+    {
+        const Sound* sound;        ///< Sound being played
+        const Int16* samples;      ///< Samples of the buffer of the sound
+        std::size_t  frameCount;   ///< Number of frames in the buffer
+        unsigned int channelCount; ///< Number of channels of the buffer
+        unsigned int sampleRate;   ///< Sample rate of the buffer
+        double       position;     ///< Position of the next frame to mix, in frames of the buffer
+        bool         paused;       ///< Is the sound paused?
+        bool         hasGains;     ///< Have the gains below been computed yet?
+        float        leftGain;     ///< Gain of the left channel at the end of the last chunk
+        float        rightGain;    ///< Gain of the right channel at the end of the last chunk
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Route a sound to the mixer
+    ///
+    /// \param sound Sound to attach
+    ///
+    ////////////////////////////////////////////////////////////
+    void attachSound(Sound* sound);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop routing a sound to the mixer
+    ///
+    /// \param sound Sound to detach
+    ///
+    ////////////////////////////////////////////////////////////
+    void detachSound(Sound* sound);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start, resume or restart the playback of a sound
+    ///
+    /// \param sound Sound to play
+    ///
+    ////////////////////////////////////////////////////////////
+    void playSound(const Sound& sound);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pause a sound
+    ///
+    /// \param sound Sound to pause
+    ///
+    ////////////////////////////////////////////////////////////
+    void pauseSound(const Sound& sound);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop a sound
+    ///
+    /// \param sound Sound to stop
+    ///
+    ////////////////////////////////////////////////////////////
+    void stopSound(const Sound& sound);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the playing position of a sound
+    ///
+    /// \param sound      Sound to seek
+    /// \param timeOffset New playing position
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSoundOffset(const Sound& sound, Time timeOffset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the playing position of a sound
+    ///
+    /// \param sound Sound to query
+    ///
+    /// \return Current playing position
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getSoundOffset(const Sound& sound) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the status of a sound
+    ///
+    /// \param sound Sound to query
+    ///
+    /// \return Current status of the sound in the mix
+    ///
+    ////////////////////////////////////////////////////////////
+    Status getSoundStatus(const Sound& sound) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the voice of a sound
+    ///
+    /// \param sound Sound to look for
+    ///
+    /// \return Index of the voice, or the number of voices if the sound isn't playing
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t findVoice(const Sound& sound) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    mutable Mutex      m_mutex;  ///< Protects the voices against the mixing thread
+    std::vector<Voice> m_voices; ///< Sounds currently playing or paused
+    std::set<Sound*>   m_sounds; ///< Sounds routed to the mixer
+    std::vector<float> m_output; ///< Mixed chunk, in stereo
+    std::vector<float> m_temp;   ///< Resampled samples of the sound being mixed
+};
+
+} // namespace sf
+
+
+#endif // SFML_SOUNDMIXER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SoundMixer
+/// \ingroup audio
+///
+/// sf::SoundMixer is a software mixing bus: the sounds that
+/// are routed to it (see sf::Sound::setMixer) don't use an
+/// OpenAL source each, they are resampled, attenuated, panned
+/// and summed (with SSE2 or NEON instructions when available)
+/// into a single stereo stream, which uses only one source.
+/// This removes the limit on the number of sounds that can
+/// be heard at the same time, which is useful for dense
+/// crowds, weapons or ambiences.
+///
+/// The mixer spatializes its mono sounds itself, according to
+/// their position, minimum distance and attenuation and to the
+/// position and orientation of the listener; stereo sounds are
+/// mixed at their volume, like OpenAL does. Pitch is applied by
+/// resampling. The mix itself is a regular sound stream: it can
+/// be paused, its volume can be changed, and several mixers can
+/// be used as sub-mixes (one for weapons, one for voices, ...),
+/// each one with its own effects (see sf::SoundStream::addEffect).
+/// By default it is relative to the listener and placed on it,
+/// so that OpenAL doesn't spatialize it a second time.
+///
+/// The mixer starts playing automatically when one of its
+/// sounds is played. Since the sounds are mixed ahead of time,
+/// the attributes of a sound are applied with the latency of
+/// the stream (see sf::SoundStream::setBufferCount). Mixed
+/// sounds need the samples of their buffer, so a buffer whose
+/// samples are not kept (see sf::SoundBuffer::setSamplesKept)
+/// can't be played through a mixer.
+///
+/// Usage example:
+/// \code
+/// sf::SoundBuffer buffer;
+/// buffer.loadFromFile("footstep.wav");
+///
+/// sf::SoundMixer crowd;
+///
+/// std::vector<sf::Sound> steps(300, sf::Sound(buffer));
+/// for (std::size_t i = 0; i < steps.size(); ++i)
+/// {
+///     steps[i].setMixer(&crowd);
+///     steps[i].setPosition(std::rand() % 100, 0, std::rand() % 100);
+///     steps[i].play();
+/// }
+/// \endcode
+///
+/// \see sf::Sound, sf::SoundStream
+///
+////////////////////////////////////////////////////////////
@@ -157,6 +157,25 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isAvailable();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Pull captured samples out of the ring buffer
+    ///
+    /// This function is only meaningful in ring buffer mode (see
+    /// setRingBufferSize). It never blocks nor allocates, and can
+    /// be called from any single consumer thread while the
+    /// capture thread keeps filling the ring: the hand-off
+    /// doesn't take any lock.
+    ///
+    /// \param samples  Pointer to the array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be 0)
+    ///
+    /// \see setRingBufferSize
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t readSamples(Int16* samples, std::size_t maxCount);
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -177,6 +196,8 @@ protected:
     ///
     /// Note: this is only a hint, the actual period may vary.
     /// So don't rely on this parameter to implement precise timing.
+    /// Intervals down to 5 ms are fine for low-latency capture,
+    /// which is best combined with the ring buffer mode.
     ///
     /// The default processing interval is 100 ms.
     ///
@@ -185,6 +206,25 @@ protected:
     ////////////////////////////////////////////////////////////
     void setProcessingInterval(sf::Time interval);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable the ring buffer capture mode
+    ///
+    /// In this mode, the capture thread writes the captured
+    /// samples straight into a preallocated ring buffer, which
+    /// the consumer empties with readSamples(); onProcessSamples
+    /// is not called. When the ring is full, new samples wait in
+    /// the capture device until there is room again.
+    /// The size is rounded up to a power of two. It must be set
+    /// before calling start(). The default size is 0, which
+    /// disables the mode.
+    ///
+    /// \param sampleCount Capacity of the ring buffer, in samples
+    ///
+    /// \see readSamples
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRingBufferSize(std::size_t sampleCount);
+
     ////////////////////////////////////////////////////////////
     /// \brief Start capturing audio data
     ///
@@ -204,7 +244,8 @@ protected:
     /// This virtual function is called every time a new chunk of
     /// recorded data is available. The derived class can then do
     /// whatever it wants with it (storing it, playing it, sending
-    /// it over the network, etc.).
+    /// it over the network, etc.). It is not called in ring buffer
+    /// mode; the default implementation does nothing.
     ///
     /// \param samples     Pointer to the new chunk of recorded samples
     /// \param sampleCount Number of samples pointed by \a samples
@@ -212,7 +253,7 @@ protected:
     /// \return True to continue the capture, or false to stop it
     ///
     ////////////////////////////////////////////////////////////
-    virtual bool onProcessSamples(const Int16* samples, std::size_t sampleCount) = 0;
+    virtual bool onProcessSamples(const Int16* samples, std::size_t sampleCount);
 
     ////////////////////////////////////////////////////////////
     /// \brief Stop capturing audio data
@@ -246,6 +287,12 @@ private:
     ////////////////////////////////////////////////////////////
     void processCapturedSamples();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Move the available audio samples to the ring buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    void captureToRing();
+
     ////////////////////////////////////////////////////////////
     /// \brief Clean up the recorder's internal resources
     ///
@@ -257,12 +304,15 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Thread             m_thread;             ///< Thread running the background recording task
-    std::vector<Int16> m_samples;            ///< Buffer to store captured samples
-    unsigned int       m_sampleRate;         ///< Sample rate
-    sf::Time           m_processingInterval; ///< Time period between calls to onProcessSamples
-    bool               m_isCapturing;        ///< Capturing state
-    std::string        m_deviceName;         ///< Name of the audio capture device
+    Thread               m_thread;             ///< Thread running the background recording task
+    std::vector<Int16>   m_samples;            ///< Buffer to store captured samples
+    unsigned int         m_sampleRate;         ///< Sample rate
+    sf::Time             m_processingInterval; ///< Time period between calls to onProcessSamples
+    bool                 m_isCapturing;        ///< Capturing state
+    std::string          m_deviceName;         ///< Name of the audio capture device
+    std::vector<Int16>   m_ring;               ///< Ring buffer of captured samples (empty if the mode is disabled)
+    volatile std::size_t m_ringWrite;          ///< Total number of samples written to the ring (by the capture thread only)
+    volatile std::size_t m_ringRead;           ///< Total number of samples read from the ring (by the consumer only)
 };
 
 } // namespace sf
@@ -317,6 +367,12 @@ private:
 /// mind, because you may have to take care of synchronization
 /// issues if you share data between threads.
 ///
+/// For low-latency capture (voice chat, for example), a derived
+/// class can instead call setRingBufferSize() and a short
+/// processing interval: the samples are then captured into a
+/// preallocated ring buffer, and any other thread pulls them with
+/// readSamples() without taking any lock.
+///
 /// Usage example:
 /// \code
 /// class CustomRecorder : public sf::SoundRecorder
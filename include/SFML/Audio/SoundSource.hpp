@@ -246,6 +246,8 @@ protected:
     /// \brief Default constructor
     ///
     /// This constructor is meant to be called by derived classes only.
+    /// It doesn't create any OpenAL source: derived classes
+    /// attach their own to m_source.
     ///
     ////////////////////////////////////////////////////////////
     SoundSource();
@@ -258,10 +260,33 @@ protected:
     ////////////////////////////////////////////////////////////
     Status getStatus() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send the current attributes to the OpenAL source
+    ///
+    /// The attributes are stored on the CPU side, so that they
+    /// survive the source while it is not attached to any
+    /// OpenAL source (m_source is 0). Derived classes must call
+    /// this function when they attach a new OpenAL source.
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyAttributes();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int m_source; ///< OpenAL source identifier, 0 if none is attached
+
+private:
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    unsigned int m_source; ///< OpenAL source identifier
+    float    m_pitch;              ///< Pitch of the sound
+    float    m_volume;             ///< Volume of the sound, in the range [0, 100]
+    Vector3f m_position;           ///< 3D position of the sound
+    bool     m_relativeToListener; ///< Is the position relative to the listener?
+    float    m_minDistance;        ///< Distance under which the sound is heard at its maximum volume
+    float    m_attenuation;        ///< Attenuation factor of the sound
 };
 
 } // namespace sf
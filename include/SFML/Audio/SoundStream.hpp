@@ -30,14 +30,24 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Export.hpp>
 #include <SFML/Audio/SoundSource.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/ConditionVariable.hpp>
 #include <SFML/System/Thread.hpp>
 #include <SFML/System/Time.hpp>
 #include <SFML/System/Mutex.hpp>
+#include <vector>
 #include <cstdlib>
 
 
 namespace sf
 {
+namespace priv
+{
+    class SoundStreamScheduler;
+}
+
+class SoundEffect;
+
 ////////////////////////////////////////////////////////////
 /// \brief Abstract base class for streamed audio sources
 ///
@@ -56,6 +66,89 @@ public:
         std::size_t  sampleCount; ///< Number of samples pointed by Samples
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure defining a chunk of 32-bit float audio data to stream
+    ///
+    ////////////////////////////////////////////////////////////
+    struct FloatChunk
+    {
+        const float* samples;     ///< Pointer to the audio samples, normalized to [-1, 1]
+        std::size_t  sampleCount; ///< Number of samples pointed by Samples
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Format of the samples provided by the stream source
+    ///
+    ////////////////////////////////////////////////////////////
+    enum SampleFormat
+    {
+        Int16Samples, ///< 16-bit signed integers, provided through Chunk
+        FloatSamples  ///< 32-bit floats, provided through FloatChunk
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Limits of the streaming queue
+    ///
+    ////////////////////////////////////////////////////////////
+    enum
+    {
+        MaxBufferCount = 32 ///< Maximum number of audio buffers of a stream
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Health of the streaming of a stream
+    ///
+    /// The durations are computed from the last refills of the
+    /// stream (up to 128), so that they follow its recent
+    /// behavior rather than its whole history.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_AUDIO_API Statistics
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Sets all the counters and durations to zero.
+        ///
+        ////////////////////////////////////////////////////////////
+        Statistics();
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        Uint64 underruns;           ///< Times the playing queue ran empty, and the source had to be restarted
+        Uint64 refills;             ///< Chunks requested to onGetData
+        Time   queuedDuration;      ///< Duration of the audio currently queued (see getLatency)
+        Time   refillLatencyMedian; ///< Median delay between the time a buffer was due to be refilled and the end of its refill
+        Time   refillLatency99;     ///< 99th percentile of the refill latency
+        Time   refillLatencyMax;    ///< Highest refill latency
+        Time   decodeTimeMedian;    ///< Median time spent in onGetData per chunk
+        Time   decodeTime99;        ///< 99th percentile of the time spent in onGetData
+        Time   decodeTimeMax;       ///< Highest time spent in onGetData
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Counters shared by all the streams
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_AUDIO_API GlobalStatistics
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Sets all the counters to zero.
+        ///
+        ////////////////////////////////////////////////////////////
+        GlobalStatistics();
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        unsigned int streams;          ///< Existing streams, each one owns an OpenAL source
+        unsigned int streamingStreams; ///< Streams currently playing or paused
+        Uint64       underruns;        ///< Underruns of all the streams since the program started
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
@@ -120,6 +213,14 @@ public:
     ////////////////////////////////////////////////////////////
     unsigned int getSampleRate() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the format of the samples provided by the stream
+    ///
+    /// \return Format of the samples
+    ///
+    ////////////////////////////////////////////////////////////
+    SampleFormat getSampleFormat() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the current status of the stream (stopped, paused, playing)
     ///
@@ -178,6 +279,119 @@ public:
     ////////////////////////////////////////////////////////////
     bool getLoop() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of audio buffers in the playing queue
+    ///
+    /// The latency of the stream (see getLatency) is the number
+    /// of buffers times the duration of the chunks returned by
+    /// onGetData. Low-latency streams (voice, synthesizers)
+    /// typically combine short chunks with a few more buffers,
+    /// so that the queue doesn't run dry between two refills;
+    /// background music can keep a few large chunks.
+    ///
+    /// The count is clamped to [2, MaxBufferCount]. If the
+    /// stream is playing, it is restarted at the same position.
+    /// The default count is 3.
+    ///
+    /// \param count Number of buffers
+    ///
+    /// \see getBufferCount, getLatency
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBufferCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of audio buffers in the playing queue
+    ///
+    /// \return Number of buffers
+    ///
+    /// \see setBufferCount
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getBufferCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an effect at the end of the processing chain of the stream
+    ///
+    /// Every chunk returned by onGetData goes through the
+    /// effects, in the order they were added, before it is
+    /// queued for playback. The effect is not copied: it must
+    /// stay alive, and attached to this stream only, until it
+    /// is removed or the stream is destroyed. Effects can be
+    /// added and removed while the stream plays; they apply
+    /// to the chunks queued afterwards.
+    ///
+    /// \param effect Effect to add
+    ///
+    /// \see removeEffect
+    ///
+    ////////////////////////////////////////////////////////////
+    void addEffect(SoundEffect& effect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove an effect from the processing chain of the stream
+    ///
+    /// \param effect Effect to remove
+    ///
+    /// \see addEffect
+    ///
+    ////////////////////////////////////////////////////////////
+    void removeEffect(SoundEffect& effect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current latency of the stream
+    ///
+    /// The latency is the duration of the audio already queued
+    /// ahead of the playing position, that is the time after
+    /// which the next chunk returned by onGetData will be heard
+    /// (and a seek, or a change in the source data, noticed).
+    /// It is zero when the stream is stopped.
+    ///
+    /// \return Duration of the queued audio
+    ///
+    /// \see setBufferCount
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getLatency() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the streaming statistics of the stream
+    ///
+    /// An underrun happens when the playing queue runs empty
+    /// before it is refilled: the source stops and is restarted,
+    /// which is heard as a gap. Long refill latencies, or decode
+    /// times close to the duration of a chunk, are the signs of
+    /// underruns to come; increasing the number of buffers (see
+    /// setBufferCount) gives the refills more time.
+    ///
+    /// \return Statistics of the stream since it was created, or since the last call to resetStatistics
+    ///
+    /// \see resetStatistics, getGlobalStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    Statistics getStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the streaming statistics of the stream
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetStatistics();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the counters shared by all the streams
+    ///
+    /// The OpenAL sources used by SFML are those of the streams
+    /// and the voices of the sounds (see Sound::getVoiceStatistics).
+    ///
+    /// \return Counters of all the streams
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    static GlobalStatistics getGlobalStatistics();
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -198,11 +412,17 @@ protected:
     /// It can be called multiple times if the settings of the
     /// audio stream change, but only when the stream is stopped.
     ///
+    /// With FloatSamples, the samples are requested through the
+    /// FloatChunk version of onGetData, and uploaded as they are
+    /// if the audio device supports AL_EXT_FLOAT32 (they are
+    /// converted to 16-bit integers otherwise).
+    ///
     /// \param channelCount Number of channels of the stream
     /// \param sampleRate   Sample rate, in samples per second
+    /// \param sampleFormat Format of the samples provided by onGetData
     ///
     ////////////////////////////////////////////////////////////
-    void initialize(unsigned int channelCount, unsigned int sampleRate);
+    void initialize(unsigned int channelCount, unsigned int sampleRate, SampleFormat sampleFormat = Int16Samples);
 
     ////////////////////////////////////////////////////////////
     /// \brief Request a new chunk of audio samples from the stream source
@@ -216,12 +436,29 @@ protected:
     /// the returned array of samples is not empty; this would stop the stream
     /// due to an internal limitation.
     ///
+    /// Streams initialized with FloatSamples override the
+    /// FloatChunk version instead.
+    ///
+    /// \param data Chunk of data to fill
+    ///
+    /// \return True to continue playback, false to stop
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool onGetData(Chunk& data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Request a new chunk of 32-bit float audio samples from the stream source
+    ///
+    /// This function must be overridden by derived classes which
+    /// initialize the stream with FloatSamples. It works exactly
+    /// like the Chunk version of onGetData.
+    ///
     /// \param data Chunk of data to fill
     ///
     /// \return True to continue playback, false to stop
     ///
     ////////////////////////////////////////////////////////////
-    virtual bool onGetData(Chunk& data) = 0;
+    virtual bool onGetData(FloatChunk& data);
 
     ////////////////////////////////////////////////////////////
     /// \brief Change the current playing position in the stream source
@@ -234,17 +471,80 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void onSeek(Time timeOffset) = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current playing position in the stream source to the beginning of the loop
+    ///
+    /// This function is called by the streaming thread when
+    /// onGetData returns false and looping is enabled. It can
+    /// be overridden by derived classes that loop over a part
+    /// of the stream, or that prepare the loop in advance. The
+    /// default implementation seeks to the beginning of the
+    /// stream.
+    ///
+    /// \return Position of the beginning of the loop, in samples, or NoLoop to stop
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 onLoop();
+
+    ////////////////////////////////////////////////////////////
+    // Constants
+    ////////////////////////////////////////////////////////////
+    static const Int64 NoLoop = -1; ///< "Invalid" onLoop return value, telling that the stream must stop
+
 private:
 
+    friend class priv::SoundStreamScheduler;
+
     ////////////////////////////////////////////////////////////
     /// \brief Function called as the entry point of the thread
     ///
-    /// This function starts the streaming loop, and returns
-    /// only when the sound is stopped.
+    /// This function fills the playing queue, starts the
+    /// playback, then refills the buffers each time the
+    /// scheduler wakes the thread up, until the stream stops.
     ///
     ////////////////////////////////////////////////////////////
     void streamData();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wake up the streaming thread to refill the queue
+    ///
+    /// This function is called by the scheduler when the delay
+    /// returned by the last update has elapsed.
+    ///
+    ////////////////////////////////////////////////////////////
+    void wakeUp();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Refill the buffers that have been processed
+    ///
+    /// This function is called by the streaming thread when the
+    /// delay returned by the previous call has elapsed.
+    ///
+    /// \param delay Filled with the delay before the next update
+    ///
+    /// \return True if the stream is still playing, false if it has to be closed
+    ///
+    ////////////////////////////////////////////////////////////
+    bool updateQueue(Time& delay);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the delay after which the next buffer will have been processed
+    ///
+    /// The delay is computed from the samples still queued
+    /// and the sample rate, so that the buffers are refilled
+    /// before the queue is empty.
+    ///
+    /// \return Delay before the next update of the queue
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getUpdateDelay() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop the playback and release the audio buffers
+    ///
+    ////////////////////////////////////////////////////////////
+    void closeQueue();
+
     ////////////////////////////////////////////////////////////
     /// \brief Fill a new buffer with audio samples, and append
     ///        it to the playing queue
@@ -253,7 +553,7 @@ private:
     /// consumed; it fills it again and inserts it back into the
     /// playing queue.
     ///
-    /// \param bufferNum Number of the buffer to fill (in [0, BufferCount])
+    /// \param bufferNum Number of the buffer to fill (in [0, getBufferCount()])
     ///
     /// \return True if the stream source has requested to stop, false otherwise
     ///
@@ -279,25 +579,38 @@ private:
     ////////////////////////////////////////////////////////////
     void clearQueue();
 
-    enum
-    {
-        BufferCount = 3 ///< Number of audio buffers used by the streaming loop
-    };
-
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Thread        m_thread;                  ///< Thread running the background tasks
-    mutable Mutex m_threadMutex;             ///< Thread mutex
-    Status        m_threadStartState;        ///< State the thread starts in (Playing, Paused, Stopped)
-    bool          m_isStreaming;             ///< Streaming state (true = playing, false = stopped)
-    unsigned int  m_buffers[BufferCount];    ///< Sound buffers used to store temporary audio data
-    unsigned int  m_channelCount;            ///< Number of channels (1 = mono, 2 = stereo, ...)
-    unsigned int  m_sampleRate;              ///< Frequency (samples / second)
-    Uint32        m_format;                  ///< Format of the internal sound buffers
-    bool          m_loop;                    ///< Loop flag (true to loop, false to play once)
-    Uint64        m_samplesProcessed;        ///< Number of buffers processed since beginning of the stream
-    bool          m_endBuffers[BufferCount]; ///< Each buffer is marked as "end buffer" or not, for proper duration calculation
+    Thread             m_thread;                     ///< Thread streaming the data in the background
+    mutable Mutex      m_threadMutex;                ///< Thread mutex
+    ConditionVariable  m_updateCondition;            ///< Notified when the queue is due to be refilled, or when the stream stops
+    bool               m_updateDue;                  ///< Has the scheduler woken the thread up?
+    Status             m_threadStartState;           ///< State the thread starts in (Playing, Paused, Stopped)
+    bool               m_isStreaming;                ///< Streaming state (true = playing, false = stopped)
+    unsigned int       m_buffers[MaxBufferCount];    ///< Sound buffers used to store temporary audio data
+    unsigned int       m_channelCount;               ///< Number of channels (1 = mono, 2 = stereo, ...)
+    unsigned int       m_sampleRate;                 ///< Frequency (samples / second)
+    Uint32             m_format;                     ///< Format of the internal sound buffers
+    bool               m_loop;                       ///< Loop flag (true to loop, false to play once)
+    Uint64             m_samplesProcessed;           ///< Number of buffers processed since beginning of the stream
+    Int64              m_bufferSeeks[MaxBufferCount]; ///< Position the playing offset jumps to after each buffer (NoLoop if it doesn't), for proper duration calculation
+    bool               m_requestStop;                ///< Has the derived class run out of data?
+    Uint64             m_queuedSamples;              ///< Number of samples in the buffers of the playing queue
+    unsigned int       m_bufferCount;                ///< Number of audio buffers used by the streaming loop
+    SampleFormat       m_sampleFormat;               ///< Format of the samples provided by the derived class
+    bool               m_convertFloats;              ///< Convert float samples to 16-bit integers (no AL_EXT_FLOAT32)?
+    std::vector<Int16> m_convertedSamples;           ///< Buffer for the converted float samples
+    Mutex              m_effectMutex;                ///< Protects the effects against the streaming thread
+    std::vector<SoundEffect*> m_effects;             ///< Processing chain applied to the chunks
+    std::vector<float> m_effectSamples;              ///< Buffer for the samples processed by the effects
+    Clock              m_statisticsClock;            ///< Clock measuring the refills
+    Time               m_nextUpdate;                 ///< Time at which the next buffer is due to be refilled, on the statistics clock
+    Uint64             m_underruns;                  ///< Underruns since the statistics were reset
+    Uint64             m_refills;                    ///< Chunks requested since the statistics were reset
+    Uint64             m_latencyCount;               ///< Refill latencies measured since the statistics were reset
+    std::vector<Int64> m_refillLatencies;            ///< Last refill latencies, in microseconds (circular)
+    std::vector<Int64> m_decodeTimes;                ///< Last decode times, in microseconds (circular)
 };
 
 } // namespace sf
@@ -331,10 +644,19 @@ private:
 /// \li onGetData fills a new chunk of audio data to be played
 /// \li onSeek changes the current playing position in the source
 ///
-/// It is important to note that each SoundStream is played in its
-/// own separate thread, so that the streaming loop doesn't block the
-/// rest of the program. In particular, the OnGetData and OnSeek
-/// virtual functions may sometimes be called from this separate thread.
+/// Streams which produce floating point samples (decoders,
+/// synthesizers, DSP chains) can call initialize() with
+/// FloatSamples and override the FloatChunk version of
+/// onGetData, so that their samples are played without being
+/// converted to 16-bit integers first.
+///
+/// It is important to note that the streams are fed by separate
+/// threads, so that the streaming loop doesn't block the rest of
+/// the program: each stream has its own thread, which sleeps
+/// until a single timer thread, shared by all the streams, wakes
+/// it up because it has processed a buffer.
+/// In particular, the OnGetData and OnSeek virtual functions may
+/// sometimes be called from these separate threads.
 /// It is important to keep this in mind, because you may have to take
 /// care of synchronization issues if you share data between threads.
 ///
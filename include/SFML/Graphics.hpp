@@ -30,30 +30,67 @@
 ////////////////////////////////////////////////////////////
 
 #include <SFML/Window.hpp>
+#include <SFML/Graphics/AnalyticCircle.hpp>
+#include <SFML/Graphics/AnalyticLine.hpp>
+#include <SFML/Graphics/AnalyticRectangle.hpp>
+#include <SFML/Graphics/AnalyticShape.hpp>
 #include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/CaptureQueue.hpp>
 #include <SFML/Graphics/CircleShape.hpp>
 #include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/CommandBuffer.hpp>
+#include <SFML/Graphics/CompactVertex.hpp>
 #include <SFML/Graphics/ConvexShape.hpp>
 #include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/DynamicResolution.hpp>
 #include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/FrameEncoder.hpp>
+#include <SFML/Graphics/FrameRecorder.hpp>
+#include <SFML/Graphics/GLStateScope.hpp>
 #include <SFML/Graphics/Glyph.hpp>
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/InstancedSprite.hpp>
+#include <SFML/Graphics/LatencyMonitor.hpp>
+#include <SFML/Graphics/LayeredVertex.hpp>
+#include <SFML/Graphics/ParticleSystem.hpp>
+#include <SFML/Graphics/PixelFormat.hpp>
+#include <SFML/Graphics/PixelReadback.hpp>
+#include <SFML/Graphics/PostProcessChain.hpp>
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/RenderQueue.hpp>
 #include <SFML/Graphics/RenderStates.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/RenderTexturePool.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/SamplerMode.hpp>
+#include <SFML/Graphics/SceneNode.hpp>
 #include <SFML/Graphics/Shader.hpp>
 #include <SFML/Graphics/Shape.hpp>
+#include <SFML/Graphics/SpatialIndex.hpp>
 #include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/SpriteBatch.hpp>
+#include <SFML/Graphics/SpriteMesh.hpp>
+#include <SFML/Graphics/StencilMode.hpp>
+#include <SFML/Graphics/StreamingTexture.hpp>
 #include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/TextBatch.hpp>
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/TextureArray.hpp>
+#include <SFML/Graphics/TextureAtlas.hpp>
+#include <SFML/Graphics/TextureManager.hpp>
+#include <SFML/Graphics/TextureStream.hpp>
+#include <SFML/Graphics/TileMap.hpp>
 #include <SFML/Graphics/Transform.hpp>
 #include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/TransformableArray.hpp>
+#include <SFML/Graphics/TrimmedSprite.hpp>
+#include <SFML/Graphics/UniformBuffer.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
 #include <SFML/Graphics/View.hpp>
 
 
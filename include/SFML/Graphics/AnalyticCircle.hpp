@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef SFML_ANALYTICCIRCLE_HPP
+#define SFML_ANALYTICCIRCLE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/AnalyticShape.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Circle drawn by a distance field shader
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API AnalyticCircle : public AnalyticShape
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param radius Radius of the circle
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit AnalyticCircle(float radius = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the radius of the circle
+    ///
+    /// \param radius New radius of the circle
+    ///
+    /// \see getRadius
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRadius(float radius);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the radius of the circle
+    ///
+    /// \return Radius of the circle
+    ///
+    /// \see setRadius
+    ///
+    ////////////////////////////////////////////////////////////
+    float getRadius() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    float m_radius; ///< Radius of the circle
+};
+
+} // namespace sf
+
+
+#endif // SFML_ANALYTICCIRCLE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::AnalyticCircle
+/// \ingroup graphics
+///
+/// sf::AnalyticCircle is the analytic counterpart of
+/// sf::CircleShape: instead of a fan of triangles, it is a
+/// single quad whose edge is computed per pixel, so it is
+/// perfectly round and antialiased at any size. Like
+/// sf::CircleShape, its local origin is the top-left corner
+/// of its bounding box.
+///
+/// Usage example:
+/// \code
+/// sf::AnalyticCircle circle(150);
+/// circle.setFillColor(sf::Color::Green);
+/// circle.setOutlineColor(sf::Color::Red);
+/// circle.setOutlineThickness(5);
+/// circle.setPosition(10, 20);
+/// ...
+/// window.draw(circle);
+/// \endcode
+///
+/// \see sf::AnalyticShape, sf::AnalyticRectangle, sf::AnalyticLine
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef SFML_ANALYTICLINE_HPP
+#define SFML_ANALYTICLINE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/AnalyticShape.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Thick line segment with round caps, drawn by a
+///        distance field shader
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API AnalyticLine : public AnalyticShape
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param start     Start point of the line
+    /// \param end       End point of the line
+    /// \param thickness Thickness of the line
+    ///
+    ////////////////////////////////////////////////////////////
+    AnalyticLine(const Vector2f& start = Vector2f(0, 0), const Vector2f& end = Vector2f(0, 0), float thickness = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the end points of the line
+    ///
+    /// \param start New start point of the line
+    /// \param end   New end point of the line
+    ///
+    /// \see getStart, getEnd
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPoints(const Vector2f& start, const Vector2f& end);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the start point of the line
+    ///
+    /// \return Start point of the line
+    ///
+    /// \see setPoints
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getStart() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the end point of the line
+    ///
+    /// \return End point of the line
+    ///
+    /// \see setPoints
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getEnd() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the thickness of the line
+    ///
+    /// The round caps extend beyond the end points by half the
+    /// thickness.
+    ///
+    /// \param thickness New thickness of the line
+    ///
+    /// \see getThickness
+    ///
+    ////////////////////////////////////////////////////////////
+    void setThickness(float thickness);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the thickness of the line
+    ///
+    /// \return Thickness of the line
+    ///
+    /// \see setThickness
+    ///
+    ////////////////////////////////////////////////////////////
+    float getThickness() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the geometry of the shape
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateGeometry();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2f m_start;     ///< Start point of the line
+    Vector2f m_end;       ///< End point of the line
+    float    m_thickness; ///< Thickness of the line
+};
+
+} // namespace sf
+
+
+#endif // SFML_ANALYTICLINE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::AnalyticLine
+/// \ingroup graphics
+///
+/// sf::AnalyticLine draws a segment of any thickness as a
+/// capsule: a single quad, aligned with the segment, whose
+/// edges and round caps are antialiased per pixel. The end
+/// points are in local coordinates, so the line can also be
+/// moved, rotated and scaled like any other sf::Transformable.
+///
+/// Usage example:
+/// \code
+/// sf::AnalyticLine line(sf::Vector2f(10, 10), sf::Vector2f(200, 120), 4);
+/// line.setFillColor(sf::Color::Yellow);
+/// ...
+/// window.draw(line);
+/// \endcode
+///
+/// \see sf::AnalyticShape, sf::AnalyticCircle, sf::AnalyticRectangle
+///
+////////////////////////////////////////////////////////////
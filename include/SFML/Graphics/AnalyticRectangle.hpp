@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef SFML_ANALYTICRECTANGLE_HPP
+#define SFML_ANALYTICRECTANGLE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/AnalyticShape.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Rectangle with optionally rounded corners, drawn
+///        by a distance field shader
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API AnalyticRectangle : public AnalyticShape
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param size         Size of the rectangle
+    /// \param cornerRadius Radius of the rounded corners
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit AnalyticRectangle(const Vector2f& size = Vector2f(0, 0), float cornerRadius = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the size of the rectangle
+    ///
+    /// \param size New size of the rectangle
+    ///
+    /// \see getSize
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSize(const Vector2f& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the rectangle
+    ///
+    /// \return Size of the rectangle
+    ///
+    /// \see setSize
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the radius of the rounded corners
+    ///
+    /// A radius of 0 (the default) gives sharp corners, a
+    /// radius of half the smallest side or more makes a capsule.
+    ///
+    /// \param radius New radius of the corners
+    ///
+    /// \see getCornerRadius
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCornerRadius(float radius);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the radius of the rounded corners
+    ///
+    /// \return Radius of the corners
+    ///
+    /// \see setCornerRadius
+    ///
+    ////////////////////////////////////////////////////////////
+    float getCornerRadius() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2f m_size;         ///< Size of the rectangle
+    float    m_cornerRadius; ///< Radius of the rounded corners
+};
+
+} // namespace sf
+
+
+#endif // SFML_ANALYTICRECTANGLE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::AnalyticRectangle
+/// \ingroup graphics
+///
+/// sf::AnalyticRectangle is the analytic counterpart of
+/// sf::RectangleShape, with rounded corners in addition.
+/// Whatever the corner radius, it is a single quad (two with
+/// an outline) whose edges are antialiased per pixel. The
+/// outline is rounded too: its outer corners have the corner
+/// radius plus the outline thickness.
+///
+/// Usage example:
+/// \code
+/// sf::AnalyticRectangle button(sf::Vector2f(200, 50), 10);
+/// button.setFillColor(sf::Color(40, 40, 40));
+/// button.setOutlineColor(sf::Color::White);
+/// button.setOutlineThickness(2);
+/// button.setPosition(10, 20);
+/// ...
+/// window.draw(button);
+/// \endcode
+///
+/// \see sf::AnalyticShape, sf::AnalyticCircle, sf::AnalyticLine
+///
+////////////////////////////////////////////////////////////
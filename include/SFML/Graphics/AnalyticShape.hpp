@@ -0,0 +1,258 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef SFML_ANALYTICSHAPE_HPP
+#define SFML_ANALYTICSHAPE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/LayeredVertex.hpp>
+#include <SFML/Graphics/Rect.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Base class for shapes drawn as a single quad by
+///        a distance field shader
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API AnalyticShape : public Drawable, public Transformable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Virtual destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~AnalyticShape();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the fill color of the shape
+    ///
+    /// By default, the shape's fill color is opaque white.
+    ///
+    /// \param color New color of the shape
+    ///
+    /// \see getFillColor, setOutlineColor
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFillColor(const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the outline color of the shape
+    ///
+    /// By default, the shape's outline color is opaque white.
+    ///
+    /// \param color New outline color of the shape
+    ///
+    /// \see getOutlineColor, setFillColor
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOutlineColor(const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the thickness of the shape's outline
+    ///
+    /// The outline is drawn outside the shape. Negative values
+    /// are clamped to 0, which disables the outline (the
+    /// default), and the thickness is rounded to 1/4 unit and
+    /// limited to 511 units.
+    ///
+    /// \param thickness New outline thickness
+    ///
+    /// \see getOutlineThickness
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOutlineThickness(float thickness);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the fill color of the shape
+    ///
+    /// \return Fill color of the shape
+    ///
+    /// \see setFillColor
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getFillColor() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the outline color of the shape
+    ///
+    /// \return Outline color of the shape
+    ///
+    /// \see setOutlineColor
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getOutlineColor() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the outline thickness of the shape
+    ///
+    /// \return Outline thickness of the shape
+    ///
+    /// \see setOutlineThickness
+    ///
+    ////////////////////////////////////////////////////////////
+    float getOutlineThickness() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the entity
+    ///
+    /// The returned rectangle is in local coordinates, which means
+    /// that it ignores the transformations (translation, rotation,
+    /// scale, ...) that are applied to the entity. The outline is
+    /// included.
+    ///
+    /// \return Local bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global (non-minimal) bounding rectangle of the entity
+    ///
+    /// The returned rectangle is in global coordinates, which means
+    /// that it takes into account the transformations (translation,
+    /// rotation, scale, ...) that are applied to the entity.
+    ///
+    /// \return Global bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getGlobalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether analytic shapes can be drawn
+    ///
+    /// They need shaders, see sf::Shader::isAvailable. When
+    /// they are not available, analytic shapes draw nothing.
+    ///
+    /// \return True if analytic shapes can be drawn
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    AnalyticShape();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Define the geometry of the shape
+    ///
+    /// All the analytic shapes are rounded boxes: a box from
+    /// (0, 0) to \a size whose corners are rounded with
+    /// \a cornerRadius, placed in local coordinates by
+    /// \a boxTransform. A radius of half the smallest side (or
+    /// more) makes a circle or a capsule. When the shape has an
+    /// outline, the radius of its outer corners (radius plus
+    /// outline thickness) is rounded to 1/4 unit and limited
+    /// to 255 units, unless the box is fully round.
+    ///
+    /// \param size         Size of the box
+    /// \param cornerRadius Radius of the rounded corners
+    /// \param boxTransform Transform from the box to the local coordinates of the shape
+    ///
+    ////////////////////////////////////////////////////////////
+    void setGeometry(const Vector2f& size, float cornerRadius, const Transform& boxTransform = Transform::Identity);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the shape to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the vertices and the bounds of the shape
+    ///
+    ////////////////////////////////////////////////////////////
+    void update();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write the vertices of a quad covering a rounded box
+    ///
+    /// The box is centered on the box of the shape.
+    ///
+    /// \param vertices Array of 4 vertices to write
+    /// \param halfSize Half the size of the rounded box
+    /// \param shape    Encoded corner radius and ring thickness (see AnalyticShape.cpp)
+    /// \param color    Color of the quad
+    ///
+    ////////////////////////////////////////////////////////////
+    void writeQuad(LayeredVertex* vertices, const Vector2f& halfSize, float shape, const Color& color) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2f      m_size;             ///< Size of the box
+    float         m_cornerRadius;     ///< Radius of the rounded corners of the box
+    Transform     m_boxTransform;     ///< Transform from the box to the local coordinates
+    Color         m_fillColor;        ///< Fill color
+    Color         m_outlineColor;     ///< Outline color
+    float         m_outlineThickness; ///< Thickness of the shape's outline
+    LayeredVertex m_vertices[8];      ///< Quads of the fill and of the outline
+    FloatRect     m_bounds;           ///< Bounding rectangle of the whole shape (outline + fill)
+};
+
+} // namespace sf
+
+
+#endif // SFML_ANALYTICSHAPE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::AnalyticShape
+/// \ingroup graphics
+///
+/// sf::AnalyticShape is the base class of sf::AnalyticCircle,
+/// sf::AnalyticRectangle and sf::AnalyticLine. Unlike the
+/// shapes derived from sf::Shape, they are not approximated
+/// with polygons: each one is a quad (two with an outline)
+/// whose pixels are colored by a fragment shader that computes
+/// their exact distance to the edge of the shape. Their edges
+/// are antialiased whatever the size and the scale, and
+/// changing their size only moves four vertices.
+///
+/// The shape of each quad is passed to the shader as the layer
+/// of its vertices (see sf::LayeredVertex), so each analytic
+/// shape is drawn by its own draw call: they are not merged by
+/// the automatic batching of sf::RenderTarget.
+///
+/// Analytic shapes can't be textured. They need shaders
+/// (see isAvailable), and draw nothing otherwise.
+///
+/// \see sf::AnalyticCircle, sf::AnalyticRectangle, sf::AnalyticLine, sf::Shape
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,261 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_CAPTUREQUEUE_HPP
+#define SFML_CAPTUREQUEUE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/PixelReadback.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/TaskScheduler.hpp>
+#include <deque>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class RenderWindow;
+class RenderTexture;
+
+////////////////////////////////////////////////////////////
+/// \brief Save the contents of render targets to image files,
+///        overlapping the readbacks and the encoding with the rendering
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API CaptureQueue : NonCopyable
+{
+public:
+
+    enum {ReadbackCount = 2}; ///< Number of captures that can be in flight on the graphics card
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the queue
+    ///
+    /// \param scheduler Task scheduler whose workers encode the images
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit CaptureQueue(TaskScheduler& scheduler);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The pending captures are saved, see finish().
+    ///
+    ////////////////////////////////////////////////////////////
+    ~CaptureQueue();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Capture the contents of a render texture and save them to a file
+    ///
+    /// The copy of the pixels is started and the function
+    /// returns immediately: the pixels are retrieved when the
+    /// next captures need the readback, and the image is then
+    /// saved by a worker of the scheduler (the format is
+    /// deduced from the extension, see Image::saveToFile).
+    /// The render texture can be redrawn right away.
+    ///
+    /// This function only blocks when the graphics card is
+    /// ReadbackCount captures late, or when the workers have
+    /// too many images left to save (see setMaxPendingSaves).
+    ///
+    /// \param renderTexture Render texture to capture
+    /// \param filename      Path of the file to write
+    ///
+    /// \return True if the capture started
+    ///
+    ////////////////////////////////////////////////////////////
+    bool capture(RenderTexture& renderTexture, const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Capture the contents of a window and save them to a file
+    ///
+    /// The contents of the back buffer are read, so this
+    /// function should be called after drawing everything
+    /// and before RenderWindow::display().
+    ///
+    /// \param window   Window to capture
+    /// \param filename Path of the file to write
+    ///
+    /// \return True if the capture started
+    ///
+    /// \see capture(RenderTexture&, const std::string&)
+    ///
+    ////////////////////////////////////////////////////////////
+    bool capture(RenderWindow& window, const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save all the pending captures
+    ///
+    /// The captures in flight are retrieved, and this function
+    /// waits until all the images are saved. It must be called
+    /// from the thread that captures, with the captured targets
+    /// still alive.
+    ///
+    ////////////////////////////////////////////////////////////
+    void finish();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum number of images waiting to be saved
+    ///
+    /// This bounds the memory used by the queue: when the
+    /// workers can't keep up, capture() waits for the oldest
+    /// image to be saved rather than dropping the capture.
+    /// The default is 8 images.
+    ///
+    /// \param count Maximum number of pending saves (at least 1)
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMaxPendingSaves(std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of images saved successfully
+    ///
+    /// Only the saves which are known to be finished are
+    /// counted; call finish() first to count all of them.
+    ///
+    /// \return Number of saved images
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getSavedCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of captures which could not be saved
+    ///
+    /// \return Number of failed captures (readback or file error)
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getFailedCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Image retrieved from the graphics card, waiting to be saved
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Save
+    {
+        Image                 image;    ///< Pixels of the capture
+        std::string           filename; ///< Path of the file to write
+        TaskScheduler::TaskId task;     ///< Task saving the image
+        bool                  success;  ///< Was the image saved? (valid once the task is finished)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make room for a new capture
+    ///
+    /// \return The readback to use for the capture
+    ///
+    ////////////////////////////////////////////////////////////
+    PixelReadback& prepareCapture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve a pending readback and give it to the workers
+    ///
+    /// \param index Index of the readback to retrieve
+    ///
+    ////////////////////////////////////////////////////////////
+    void retrieve(std::size_t index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Account for the finished saves and recycle their images
+    ///
+    /// \param count Number of saves to wait for, starting from the oldest
+    ///
+    ////////////////////////////////////////////////////////////
+    void collect(std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function of the tasks saving the images
+    ///
+    /// \param save Image to save
+    ///
+    ////////////////////////////////////////////////////////////
+    static void write(Save* save);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    TaskScheduler&     m_scheduler;                 ///< Scheduler running the saves
+    PixelReadback      m_readbacks[ReadbackCount];  ///< Ring of asynchronous readbacks
+    std::string        m_filenames[ReadbackCount];  ///< Files of the captures in flight
+    std::size_t        m_nextReadback;              ///< Index of the oldest readback, which is used next
+    std::deque<Save*>  m_saves;                     ///< Images being saved, oldest first
+    std::vector<Save*> m_freeSaves;                 ///< Images reused for the next captures
+    std::size_t        m_maxPendingSaves;           ///< Maximum number of images being saved
+    Uint64             m_savedCount;                ///< Number of images saved successfully
+    Uint64             m_failedCount;               ///< Number of captures which could not be saved
+};
+
+} // namespace sf
+
+
+#endif // SFML_CAPTUREQUEUE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::CaptureQueue
+/// \ingroup graphics
+///
+/// Saving a render texture with getTexture().copyToImage()
+/// and Image::saveToFile() is fully serial: the program waits
+/// for the graphics card to finish drawing and to copy the
+/// pixels, then encodes the file, while the graphics card
+/// sits idle.
+///
+/// sf::CaptureQueue pipelines these steps. Each capture
+/// starts an asynchronous copy to a sf::PixelReadback and
+/// returns; the pixels of capture N are retrieved when
+/// capture N + ReadbackCount needs the readback, by which
+/// time the graphics card is done with them, and the file
+/// is written by a worker of a sf::TaskScheduler. While the
+/// program draws job N+1, the graphics card copies job N and
+/// the workers encode the previous ones.
+///
+/// Usage example:
+/// \code
+/// sf::TaskScheduler scheduler;
+/// sf::CaptureQueue captures(scheduler);
+///
+/// sf::RenderTexture target;
+/// target.create(1920, 1080);
+///
+/// for (std::size_t i = 0; i < jobs.size(); ++i)
+/// {
+///     target.clear();
+///     jobs[i].draw(target);
+///     target.display();
+///
+///     captures.capture(target, jobs[i].outputPath);
+/// }
+///
+/// captures.finish();
+/// \endcode
+///
+/// \see sf::PixelReadback, sf::FrameRecorder, sf::TaskScheduler
+///
+////////////////////////////////////////////////////////////
@@ -108,6 +108,12 @@ public:
 
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the geometry, shared by the circles of same radius and point count
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateCircle();
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
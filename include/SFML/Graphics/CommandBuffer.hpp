@@ -0,0 +1,290 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_COMMANDBUFFER_HPP
+#define SFML_COMMANDBUFFER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/LayeredVertex.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class TaskScheduler;
+
+////////////////////////////////////////////////////////////
+/// \brief Render target that records draw commands, to be
+///        submitted later to another render target
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API CommandBuffer : public RenderTarget
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty command buffer. Its size only defines
+    /// its default view, which is only used for culling (see
+    /// RenderTarget::setCullingEnabled): the recorded
+    /// primitives are drawn with the view of the target they
+    /// are submitted to.
+    ///
+    /// \param size Size of the recording area, usually the size of the final target
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit CommandBuffer(const Vector2u& size = Vector2u(0, 0));
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the recorded commands
+    ///
+    /// This function doesn't deallocate the corresponding
+    /// memory, so that recording the next frame doesn't
+    /// involve reallocating it.
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the recorded commands to a render target
+    ///
+    /// The commands are drawn in the order they were recorded.
+    /// This function must be called from the thread that owns
+    /// \a target, and the buffer must not be recorded into at
+    /// the same time.
+    ///
+    /// \param target Render target to draw to
+    /// \param states Render states whose transform is combined with the one of each command
+    ///
+    ////////////////////////////////////////////////////////////
+    void submit(RenderTarget& target, const RenderStates& states = RenderStates::Default) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the number of recorded commands
+    ///
+    /// Consecutive primitives sharing the same states are
+    /// merged into a single command.
+    ///
+    /// \return Number of commands
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCommandCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the number of recorded vertices
+    ///
+    /// \return Number of vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getVertexCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the recording area
+    ///
+    /// \return Size in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record drawables into several command buffers in parallel
+    ///
+    /// The drawables are split into as many contiguous ranges
+    /// as there are buffers, and each range is recorded into
+    /// its buffer by a task of \a scheduler. The buffers are
+    /// reset first, their view and culling settings are kept.
+    /// This function returns when all the buffers are recorded;
+    /// submitting them in order then draws the drawables in
+    /// the order of the array.
+    ///
+    /// \param scheduler     Scheduler running the recording tasks
+    /// \param buffers       Array of pointers to the command buffers
+    /// \param bufferCount   Number of command buffers
+    /// \param drawables     Array of pointers to the drawables
+    /// \param drawableCount Number of drawables
+    /// \param states        Render states used to draw each drawable
+    ///
+    ////////////////////////////////////////////////////////////
+    static void recordParallel(TaskScheduler& scheduler, CommandBuffer* const* buffers, std::size_t bufferCount,
+                               const Drawable* const* drawables, std::size_t drawableCount,
+                               const RenderStates& states = RenderStates::Default);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Activate the target for rendering
+    ///
+    /// A command buffer has no OpenGL context, so this function
+    /// always fails.
+    ///
+    /// \param active True to make the target active, false to deactivate it
+    ///
+    /// \return Always false
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool activate(bool active);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record primitives
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void record(const Vertex* vertices, std::size_t vertexCount,
+                        PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a vertex buffer draw
+    ///
+    /// \param vertexBuffer Vertex buffer to draw
+    /// \param firstVertex  Index of the first vertex to draw
+    /// \param vertexCount  Number of vertices to draw
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void record(const VertexBuffer& vertexBuffer, std::size_t firstVertex,
+                        std::size_t vertexCount, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record layered primitives
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void record(const LayeredVertex* vertices, std::size_t vertexCount,
+                        PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recorded draw command
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Command
+    {
+        RenderStates        states;       ///< Render states of the command (identity transform for sf::Vertex)
+        const VertexBuffer* vertexBuffer; ///< Recorded vertex buffer, or NULL for vertices
+        bool                layered;      ///< Are the vertices in the layered vertex storage?
+        std::size_t         firstVertex;  ///< Index of the first vertex, in the vertex storage or the vertex buffer
+        std::size_t         vertexCount;  ///< Number of vertices
+        PrimitiveType       type;         ///< Type of primitives
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2u                   m_size;            ///< Size of the recording area
+    std::vector<Command>       m_commands;        ///< Recorded commands
+    std::vector<Vertex>        m_vertices;        ///< Pre-transformed vertices of all the commands
+    std::vector<LayeredVertex> m_layeredVertices; ///< Vertices of the layered commands, drawn with their transform
+};
+
+} // namespace sf
+
+
+#endif // SFML_COMMANDBUFFER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::CommandBuffer
+/// \ingroup graphics
+///
+/// sf::CommandBuffer is a render target that doesn't draw
+/// anything: it records the primitives drawn to it, and
+/// submits them later to a real render target. Since it
+/// never uses OpenGL, any thread can record into its own
+/// command buffer without activating a context, which makes
+/// it possible to traverse a scene on several threads while
+/// all the OpenGL calls happen on the rendering thread.
+///
+/// The work done on the recording thread is the expensive
+/// part of drawing on the CPU: the drawables build their
+/// geometry, the vertices are transformed by the states'
+/// transform, connected primitives are converted to lists,
+/// and consecutive primitives sharing the same states
+/// (except the transform) are merged into a single command.
+/// Layered vertices (sf::LayeredVertex) are copied as they
+/// are and keep their own command, like when they are drawn
+/// directly.
+/// Submitting a buffer is then little more than a copy.
+/// Culling, when enabled on the command buffer, is also
+/// applied at recording time.
+///
+/// The textures and shaders of the recorded states, as well
+/// as the recorded vertex buffers, are referenced and not
+/// copied: they must exist until the buffer is submitted, and
+/// they must not be modified by the recording threads (note
+/// that sf::Text may update the texture of its font; preload the
+/// glyphs before recording text on other threads).
+/// Instanced drawing (sf::InstancedSprite) can't be recorded.
+///
+/// The final drawing order only depends on the order in which
+/// the buffers are submitted, not on the order in which the
+/// recording threads finish.
+///
+/// When the scene is a flat list of drawables, recordParallel
+/// splits it over the buffers and records them with the tasks
+/// of an sf::TaskScheduler, so that existing drawing code gets
+/// multi-core recording without being restructured.
+///
+/// Usage example:
+/// \code
+/// // One command buffer per worker thread
+/// std::vector<sf::CommandBuffer*> buffers;
+///
+/// // Worker thread i: record its part of the scene
+/// buffers[i]->reset();
+/// buffers[i]->setView(view);
+/// buffers[i]->setCullingEnabled(true);
+/// for (std::size_t j = begin; j < end; ++j)
+///     buffers[i]->draw(sprites[j]);
+///
+/// // Rendering thread, once all the workers are done
+/// window.setView(view);
+/// for (std::size_t i = 0; i < buffers.size(); ++i)
+///     buffers[i]->submit(window);
+/// window.display();
+/// \endcode
+///
+/// The same, with the scene split automatically:
+/// \code
+/// sf::CommandBuffer::recordParallel(scheduler, &buffers[0], buffers.size(),
+///                                   &drawables[0], drawables.size());
+/// for (std::size_t i = 0; i < buffers.size(); ++i)
+///     buffers[i]->submit(window);
+/// \endcode
+///
+/// \see sf::RenderTarget, sf::RenderQueue, sf::TaskScheduler
+///
+////////////////////////////////////////////////////////////
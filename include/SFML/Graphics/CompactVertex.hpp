@@ -0,0 +1,165 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_COMPACTVERTEX_HPP
+#define SFML_COMPACTVERTEX_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/System/Vector2.hpp>
+
+
+namespace sf
+{
+class Vertex;
+
+////////////////////////////////////////////////////////////
+/// \brief Vertex with 16-bit integer position and texture coordinates
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API CompactVertex
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    CompactVertex();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the vertex from its position, color and texture coordinates
+    ///
+    /// \param thePosition  Vertex position
+    /// \param theColor     Vertex color
+    /// \param theTexCoords Vertex texture coordinates, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    CompactVertex(const Vector2<Int16>& thePosition, const Color& theColor, const Vector2<Int16>& theTexCoords);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the vertex from a regular vertex
+    ///
+    /// The position and texture coordinates are rounded to the
+    /// nearest integer.
+    ///
+    /// \param vertex Vertex to convert
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit CompactVertex(const Vertex& vertex);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2<Int16> position;  ///< 2D position of the vertex
+    Color          color;     ///< Color of the vertex
+    Vector2<Int16> texCoords; ///< Coordinates of the texture's pixel to map to the vertex
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Vertex with 16-bit integer position and texture
+///        coordinates, and no color
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API UncoloredVertex
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    UncoloredVertex();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the vertex from its position and texture coordinates
+    ///
+    /// \param thePosition  Vertex position
+    /// \param theTexCoords Vertex texture coordinates, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    UncoloredVertex(const Vector2<Int16>& thePosition, const Vector2<Int16>& theTexCoords);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the vertex from a regular vertex
+    ///
+    /// The position and texture coordinates are rounded to the
+    /// nearest integer, the color is dropped.
+    ///
+    /// \param vertex Vertex to convert
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit UncoloredVertex(const Vertex& vertex);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2<Int16> position;  ///< 2D position of the vertex
+    Vector2<Int16> texCoords; ///< Coordinates of the texture's pixel to map to the vertex
+};
+
+} // namespace sf
+
+
+#endif // SFML_COMPACTVERTEX_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::CompactVertex
+/// \ingroup graphics
+///
+/// sf::CompactVertex and sf::UncoloredVertex are smaller
+/// alternatives to sf::Vertex (20 bytes) for geometry stored
+/// in a sf::VertexBuffer: sf::CompactVertex takes 12 bytes
+/// and sf::UncoloredVertex 8 bytes. They suit static geometry
+/// whose coordinates are whole pixels in the range
+/// [-32768, 32767], such as tile maps or user interfaces:
+/// less graphics memory is used and the graphics card fetches
+/// less data per vertex.
+///
+/// Like those of sf::Vertex, the texture coordinates are
+/// expressed in pixels. An sf::UncoloredVertex is drawn as
+/// if its color was white.
+///
+/// The vertex buffer must be created with the format that
+/// matches the type of its vertices:
+/// \code
+/// std::vector<sf::CompactVertex> vertices;
+/// ...
+/// sf::VertexBuffer buffer(sf::Triangles, sf::VertexBuffer::Static, sf::VertexBuffer::Compact);
+/// buffer.create(vertices.size());
+/// buffer.update(&vertices[0], vertices.size(), 0);
+/// ...
+/// window.draw(buffer, &texture);
+/// \endcode
+///
+/// Custom shaders read the components as usual, converted
+/// to floats.
+///
+/// \see sf::Vertex, sf::VertexBuffer
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,293 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_DYNAMICRESOLUTION_HPP
+#define SFML_DYNAMICRESOLUTION_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+class RenderTarget;
+class View;
+
+////////////////////////////////////////////////////////////
+/// \brief Renders at a resolution that adapts to the GPU load
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API DynamicResolution : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The target frame time is 1/60 second, and the scale
+    /// can go from 0.5 to 1.
+    ///
+    ////////////////////////////////////////////////////////////
+    DynamicResolution();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~DynamicResolution();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the time that the rendering should fit in
+    ///
+    /// \param time Target frame time
+    ///
+    /// \see getTargetFrameTime
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTargetFrameTime(Time time);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the time that the rendering should fit in
+    ///
+    /// \return Target frame time
+    ///
+    /// \see setTargetFrameTime
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getTargetFrameTime() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the range of the scale
+    ///
+    /// The scale is the size of the rendering relatively to the
+    /// size of the final target, on each axis. The maximum can
+    /// exceed 1 for supersampling. Changing the maximum
+    /// reallocates the internal render texture.
+    ///
+    /// \param minimum Smallest scale
+    /// \param maximum Largest scale
+    ///
+    ////////////////////////////////////////////////////////////
+    void setScaleRange(float minimum, float maximum);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current scale
+    ///
+    /// \return Size of the rendering relatively to the final target
+    ///
+    ////////////////////////////////////////////////////////////
+    float getScale() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current size of the rendering, in pixels
+    ///
+    /// \return Size of the part of the render texture in use
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getRenderSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Begin a frame
+    ///
+    /// The internal render texture is prepared for the size of
+    /// \a target and the current scale, and the view of \a target
+    /// is applied to it. Everything that should be rendered at
+    /// the dynamic resolution must then be drawn to the returned
+    /// render texture, until end() is called.
+    ///
+    /// \param target Target that will receive the final image
+    ///
+    /// \return Render texture to draw the frame to
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderTexture& begin(const RenderTarget& target);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the view of the frame being drawn
+    ///
+    /// Use this function instead of RenderTexture::setView: the
+    /// viewport of \a view, defined relatively to the final
+    /// target, is remapped to the part of the render texture
+    /// which is in use.
+    ///
+    /// \param view New view
+    ///
+    ////////////////////////////////////////////////////////////
+    void setView(const View& view);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief End the frame and draw it to the final target
+    ///
+    /// The frame is stretched to cover the whole target,
+    /// whatever its view. The scale of the next frames is then
+    /// adjusted according to the time measured for the previous
+    /// ones.
+    ///
+    /// \param target Target to draw the frame to, usually a window
+    /// \param states Render states to use for drawing (the
+    ///               texture is replaced by the frame)
+    ///
+    ////////////////////////////////////////////////////////////
+    void end(RenderTarget& target, const RenderStates& states = RenderStates::Default);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Delete the timer queries and forget their measures
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseMeasures();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Issue the query marking the beginning of a frame
+    ///
+    ////////////////////////////////////////////////////////////
+    void beginMeasure();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Issue the query marking the end of a frame
+    ///
+    ////////////////////////////////////////////////////////////
+    void endMeasure();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the measures that are available
+    ///
+    /// This function never waits for the GPU.
+    ///
+    ////////////////////////////////////////////////////////////
+    void collectMeasures();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Adjust the scale according to a new measure
+    ///
+    /// \param time Measured time, in microseconds
+    ///
+    ////////////////////////////////////////////////////////////
+    void adjustScale(float time);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pair of timer queries surrounding a frame
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Measure
+    {
+        unsigned int begin;   ///< Timestamp query issued by begin()
+        unsigned int end;     ///< Timestamp query issued by end()
+        bool         pending; ///< Is the result still to be read?
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    RenderTexture m_texture;          ///< Render texture receiving the frames, at the largest scale
+    Vertex        m_quad[4];          ///< Quad drawing the frame to the final target
+    Vector2u      m_targetSize;       ///< Size of the final target the texture was created for
+    Vector2u      m_renderSize;       ///< Size of the part of the texture in use
+    float         m_scale;            ///< Current scale
+    float         m_minScale;         ///< Smallest scale
+    float         m_maxScale;         ///< Largest scale
+    Time          m_targetFrameTime;  ///< Time that the rendering should fit in
+    float         m_averageTime;      ///< Moving average of the measures, in microseconds (0 when restarted)
+    unsigned int  m_cooldown;         ///< Number of measures to ignore before the scale can change again
+    unsigned int  m_stableMeasures;   ///< Number of consecutive measures within the target
+    Measure       m_measures[3];      ///< Queries of the last frames, read once the GPU is done with them
+    unsigned int  m_currentMeasure;   ///< Index of the queries of the current frame
+    bool          m_measuring;        ///< Were queries issued for the current frame?
+    bool          m_gpuTiming;        ///< Are the frames measured with timer queries?
+    Clock         m_frameClock;       ///< Measures the time between frames, without timer queries
+    bool          m_firstFrame;       ///< Is there no previous frame to measure from?
+};
+
+} // namespace sf
+
+
+#endif // SFML_DYNAMICRESOLUTION_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::DynamicResolution
+/// \ingroup graphics
+///
+/// When the GPU is the bottleneck, the cost of a frame is
+/// mostly proportional to the number of pixels drawn.
+/// sf::DynamicResolution renders the scene into a render
+/// texture whose size follows the measured load, then
+/// stretches it to the window: the frame rate holds, at the
+/// price of a blurrier image while the load is high.
+///
+/// The time spent by the GPU between begin() and end() is
+/// measured with timer queries, read a few frames later so
+/// that the CPU never waits for them. When the average leaves
+/// a band around the target frame time, the scale is changed
+/// in proportion, then kept for a few frames to let the new
+/// measures come in. Where timer queries are not supported
+/// (e.g. OpenGL ES), the time between two frames is used
+/// instead: the scale then decreases when frames are late,
+/// and increases again by small steps after a while without
+/// late frames.
+///
+/// The render texture is allocated once for the largest
+/// scale, and only its top-left part is used, so changing the
+/// scale doesn't allocate anything. The view of the target is
+/// applied to the render texture by begin(); other views must
+/// be set with setView(), which remaps their viewport to the
+/// part in use. Since the frame covers the whole window,
+/// Window::mapPixelToCoords keeps working with the original
+/// views.
+///
+/// Usage example:
+/// \code
+/// sf::DynamicResolution resolution;
+/// resolution.setScaleRange(0.5f, 1.f);
+///
+/// while (window.isOpen())
+/// {
+///     ...
+///     sf::RenderTexture& scene = resolution.begin(window);
+///     scene.clear();
+///     resolution.setView(worldView);
+///     scene.draw(world);
+///
+///     window.clear();
+///     resolution.end(window);
+///
+///     // The interface is drawn at the full resolution
+///     window.setView(window.getDefaultView());
+///     window.draw(hud);
+///     window.display();
+/// }
+/// \endcode
+///
+/// \see sf::RenderTexture
+///
+////////////////////////////////////////////////////////////
@@ -32,8 +32,10 @@
 #include <SFML/Graphics/Glyph.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/String.hpp>
+#include <deque>
 #include <map>
 #include <string>
 #include <vector>
@@ -42,6 +44,12 @@
 namespace sf
 {
 class InputStream;
+class MappedFileInputStream;
+
+namespace priv
+{
+    class GlyphRasterizer;
+}
 
 ////////////////////////////////////////////////////////////
 /// \brief Class for loading and manipulating character fonts
@@ -60,6 +68,19 @@ public:
         std::string family; ///< The font family
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Statistics of the glyph cache
+    ///
+    ////////////////////////////////////////////////////////////
+    struct CacheStatistics
+    {
+        Uint64      hits;          ///< Number of glyphs found in the cache
+        Uint64      misses;        ///< Number of glyphs that had to be loaded
+        Uint64      evictions;     ///< Number of glyphs removed from the cache to respect the budget
+        Uint64      compactions;   ///< Number of pages rebuilt to respect the budget
+        std::size_t residentBytes; ///< Memory used by the textures of the cache, in bytes
+    };
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -174,6 +195,9 @@ public:
     /// closer than other characters. Most of the glyphs pairs have a
     /// kerning offset of zero, though.
     ///
+    /// The kerning of each pair is cached per character size, so
+    /// only the first query of a pair calls FreeType.
+    ///
     /// \param first         Unicode code point of the first character
     /// \param second        Unicode code point of the second character
     /// \param characterSize Reference character size
@@ -239,6 +263,238 @@ public:
     ////////////////////////////////////////////////////////////
     const Texture& getTexture(unsigned int characterSize) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the distance field mode
+    ///
+    /// In distance field mode, glyphs are rendered only once, at
+    /// \a baseSize, into a single texture that stores the distance
+    /// of each pixel to the outline of the glyph instead of its
+    /// coverage. Glyphs of all character sizes are scaled from
+    /// this texture, and sf::Text draws them with a shader that
+    /// turns the distance into a sharp edge at any scale. This
+    /// saves a lot of video memory when the same font is used
+    /// with many sizes, or when text is scaled dynamically.
+    ///
+    /// This mode requires shaders (see Shader::isAvailable) and a
+    /// scalable font, it must be enabled after the font is loaded.
+    /// Changing the mode discards the glyphs loaded so far; it is
+    /// disabled again when another font is loaded.
+    ///
+    /// \param enabled  True to enable the distance field mode, false to disable it
+    /// \param baseSize Character size at which the glyphs are rendered
+    ///
+    /// \return True if the mode was changed, false if it is not supported
+    ///
+    /// \see isDistanceField
+    ///
+    ////////////////////////////////////////////////////////////
+    bool setDistanceField(bool enabled, unsigned int baseSize = 48);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the distance field mode is enabled or not
+    ///
+    /// \return True if the glyphs are rendered as distance fields
+    ///
+    /// \see setDistanceField
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isDistanceField() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the background loading of glyphs
+    ///
+    /// When enabled, the glyphs missing from the cache are
+    /// rasterized by a worker thread instead of stalling the
+    /// caller: getGlyph returns a placeholder (an empty glyph
+    /// with an estimated advance) until the glyph is ready, and
+    /// the finished glyphs are added to the textures, one update
+    /// per character size, by uploadPendingGlyphs. sf::Text
+    /// calls it automatically and updates its geometry when the
+    /// glyphs arrive.
+    ///
+    /// The worker opens its own copy of the font, so this mode
+    /// is only available for fonts loaded from a file or from
+    /// memory; fonts loaded from a stream always load their
+    /// glyphs synchronously. The mode persists when another
+    /// font is loaded.
+    ///
+    /// \param enabled True to load the glyphs in the background, false to load them synchronously
+    ///
+    /// \see isAsyncGlyphLoading, uploadPendingGlyphs
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAsyncGlyphLoading(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether glyphs are loaded in the background or not
+    ///
+    /// \return True if the glyphs are loaded in the background
+    ///
+    /// \see setAsyncGlyphLoading
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isAsyncGlyphLoading() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the glyphs rasterized in the background to the cache
+    ///
+    /// The finished glyphs replace their placeholders, and the
+    /// revision of the glyph cache changes so that the objects
+    /// which store glyph geometry (like sf::Text) know that they
+    /// must rebuild it. This function must be called from the
+    /// thread that renders the text, typically once per frame.
+    ///
+    /// \return Current revision of the glyph cache
+    ///
+    /// \see setAsyncGlyphLoading
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 uploadPendingGlyphs() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a set of glyphs in advance
+    ///
+    /// Glyphs are normally loaded the first time they are
+    /// displayed, which can make the first frames that show a
+    /// new text stall. This function rasterizes all the missing
+    /// glyphs of \a characters at once, and uploads them to the
+    /// texture in a single update.
+    ///
+    /// \param characters    Characters to load
+    /// \param characterSize Reference character size
+    /// \param bold          Load the bold version or the regular one?
+    ///
+    ////////////////////////////////////////////////////////////
+    void preloadGlyphs(const String& characters, unsigned int characterSize, bool bold = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the glyphs loaded for a character size to a file
+    ///
+    /// The file contains the texture of the page and the
+    /// description of its glyphs, so that loadAtlasFromFile can
+    /// later restore them without rasterizing anything. In
+    /// distance field mode, the shared page is saved and
+    /// \a characterSize is ignored.
+    ///
+    /// \param filename      Path of the file to write
+    /// \param characterSize Reference character size
+    ///
+    /// \return True if saving was successful
+    ///
+    /// \see loadAtlasFromFile
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveAtlasToFile(const std::string& filename, unsigned int characterSize) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load prebaked glyphs from a file
+    ///
+    /// The glyphs saved by saveAtlasToFile replace the ones
+    /// loaded for the same character size. If the atlas was
+    /// saved in distance field mode, the mode is enabled.
+    ///
+    /// Atlases only contain glyphs: the font itself must be
+    /// loaded first (loading it discards the glyphs), so that
+    /// metrics such as kerning and line spacing are available
+    /// and missing glyphs can still be rasterized.
+    ///
+    /// \param filename Path of the atlas file to load
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see saveAtlasToFile, loadAtlasFromMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadAtlasFromFile(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load prebaked glyphs from a file in memory
+    ///
+    /// See loadAtlasFromFile.
+    ///
+    /// \param data        Pointer to the file data in memory
+    /// \param sizeInBytes Size of the data to load, in bytes
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see saveAtlasToFile, loadAtlasFromFile
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadAtlasFromMemory(const void* data, std::size_t sizeInBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the memory budget of the glyph cache
+    ///
+    /// Each character size has its own page of glyphs, which
+    /// normally only grows. With a budget, the pages that were
+    /// used least recently are evicted when the textures of the
+    /// cache exceed it, and a page that exceeds it alone is
+    /// rebuilt with only the glyphs requested again (at most
+    /// once per second). The evicted glyphs are loaded again if
+    /// they are needed later.
+    ///
+    /// The budget is a target: the page being filled and the page
+    /// of the last getTexture call are never evicted, so the cache
+    /// can stay above a budget too small for the text displayed.
+    ///
+    /// The texture of an evicted page is destroyed: references
+    /// returned by getTexture must not be kept across glyph loads
+    /// (sf::Text gets the texture every time it is drawn).
+    ///
+    /// \param bytes Maximum memory of the cache textures, in bytes (0 for no limit)
+    ///
+    /// \see getCacheBudget, clearCache, getCacheStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCacheBudget(std::size_t bytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the memory budget of the glyph cache
+    ///
+    /// \return Maximum memory of the cache textures, in bytes (0 if there is no limit)
+    ///
+    /// \see setCacheBudget
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCacheBudget() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove the glyphs of a character size from the cache
+    ///
+    /// The page of \a characterSize and its texture are destroyed,
+    /// the glyphs are loaded again if they are needed later.
+    /// In distance field mode, all the sizes share a single page:
+    /// only the glyph metrics scaled to \a characterSize are
+    /// removed.
+    ///
+    /// \param characterSize Reference character size
+    ///
+    /// \see setCacheBudget
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearCache(unsigned int characterSize);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the glyphs from the cache
+    ///
+    /// \see setCacheBudget
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearCache();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the statistics of the glyph cache
+    ///
+    /// The counters start when the font is created and are
+    /// never reset.
+    ///
+    /// \return Statistics of the glyph cache
+    ///
+    /// \see setCacheBudget
+    ///
+    ////////////////////////////////////////////////////////////
+    CacheStatistics getCacheStatistics() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -249,6 +505,17 @@ public:
     ////////////////////////////////////////////////////////////
     Font& operator =(const Font& right);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the contents of this font with those of another
+    ///
+    /// The font faces and the glyph pages are exchanged without
+    /// being copied.
+    ///
+    /// \param right Instance to swap with
+    ///
+    ////////////////////////////////////////////////////////////
+    void swap(Font& right);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -265,9 +532,139 @@ private:
     };
 
     ////////////////////////////////////////////////////////////
-    // Types
+    /// \brief Table mapping a codepoint (and bold flag) to its glyph
+    ///
+    /// Latin-1 characters are looked up directly in a flat
+    /// array, the other ones in an open-addressing hash table.
+    /// Glyphs are stored in a deque, so that the references
+    /// returned by getGlyph stay valid when the table grows.
+    ///
+    ////////////////////////////////////////////////////////////
+    class GlyphTable
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor, creates an empty table
+        ///
+        ////////////////////////////////////////////////////////////
+        GlyphTable();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Find the glyph of a key
+        ///
+        /// \param key Code point combined with the bold flag
+        ///
+        /// \return Pointer to the glyph, NULL if it is not in the table
+        ///
+        ////////////////////////////////////////////////////////////
+        const Glyph* find(Uint32 key) const;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Add a glyph that is not in the table yet
+        ///
+        /// \param key   Code point combined with the bold flag
+        /// \param glyph Glyph to add
+        ///
+        /// \return Reference to the stored glyph
+        ///
+        ////////////////////////////////////////////////////////////
+        const Glyph& insert(Uint32 key, const Glyph& glyph);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Get the number of glyphs in the table
+        ///
+        ////////////////////////////////////////////////////////////
+        std::size_t getSize() const;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Get the key of a glyph, by insertion order
+        ///
+        ////////////////////////////////////////////////////////////
+        Uint32 getKey(std::size_t index) const;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Get a glyph, by insertion order
+        ///
+        ////////////////////////////////////////////////////////////
+        const Glyph& getGlyph(std::size_t index) const;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Swap the contents of two tables
+        ///
+        ////////////////////////////////////////////////////////////
+        void swap(GlyphTable& other);
+
+    private:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Rebuild the hash table with a new number of slots
+        ///
+        /// \param slotCount New number of slots (power of two)
+        ///
+        ////////////////////////////////////////////////////////////
+        void rehash(std::size_t slotCount);
+
+        typedef std::pair<Uint32, Glyph> Entry; ///< Key and glyph
+        typedef std::pair<Uint32, Uint32> Slot;  ///< Key and index (plus one) of the entry, index is 0 for empty slots
+
+        std::deque<Entry>   m_entries; ///< Glyphs stored in the table, in insertion order
+        std::vector<Uint32> m_direct;  ///< Indices (plus one) of the Latin-1 glyphs, regular then bold
+        std::vector<Slot>   m_slots;   ///< Hash table of the other glyphs (the key is stored to avoid indirections while probing)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Table caching the kerning of pairs of characters
+    ///
+    /// Pairs are stored in an open-addressing hash table; the
+    /// pairs without kerning are stored too, so that FreeType
+    /// is queried only once per pair.
+    ///
     ////////////////////////////////////////////////////////////
-    typedef std::map<Uint32, Glyph> GlyphTable; ///< Table mapping a codepoint to its glyph
+    class KerningTable
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor, creates an empty table
+        ///
+        ////////////////////////////////////////////////////////////
+        KerningTable();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Find the kerning of a pair
+        ///
+        /// \param key Code points of the pair, the first one in the high bits
+        ///
+        /// \return Pointer to the kerning, NULL if it is not in the table
+        ///
+        ////////////////////////////////////////////////////////////
+        const float* find(Uint64 key) const;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Add the kerning of a pair that is not in the table yet
+        ///
+        /// \param key     Code points of the pair, the first one in the high bits
+        /// \param kerning Kerning of the pair
+        ///
+        ////////////////////////////////////////////////////////////
+        void insert(Uint64 key, float kerning);
+
+    private:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Rebuild the hash table with a new number of slots
+        ///
+        /// \param slotCount New number of slots (power of two)
+        ///
+        ////////////////////////////////////////////////////////////
+        void rehash(std::size_t slotCount);
+
+        typedef std::pair<Uint64, float> Slot; ///< Key and kerning, the key is 0 for empty slots
+
+        std::vector<Slot> m_slots; ///< Hash table of the pairs
+        std::size_t       m_size;  ///< Number of pairs in the table
+    };
 
     ////////////////////////////////////////////////////////////
     /// \brief Structure defining a page of glyphs
@@ -281,6 +678,7 @@ private:
         sf::Texture      texture; ///< Texture containing the pixels of the glyphs
         unsigned int     nextRow; ///< Y position of the next new row in the texture
         std::vector<Row> rows;    ///< List containing the position of all the existing rows
+        Uint64           lastUse; ///< Value of the cache clock when the page was last used
     };
 
     ////////////////////////////////////////////////////////////
@@ -301,6 +699,17 @@ private:
     ////////////////////////////////////////////////////////////
     Glyph loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Allocate the texture rectangle of a glyph, with padding
+    ///
+    /// \param page Page of glyphs to allocate from
+    /// \param size Size of the glyph's pixels
+    ///
+    /// \return Rectangle of the glyph's pixels within the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    IntRect allocateGlyphRect(Page& page, const Vector2u& size) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Find a suitable rectangle within the texture for a glyph
     ///
@@ -323,24 +732,100 @@ private:
     ////////////////////////////////////////////////////////////
     bool setCurrentSize(unsigned int characterSize) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the page of glyphs of a character size, creating it if needed
+    ///
+    /// \param characterSize Reference character size
+    ///
+    /// \return Page of the character size
+    ///
+    ////////////////////////////////////////////////////////////
+    Page& getPage(unsigned int characterSize) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Evict the least recently used pages until the cache fits its budget
+    ///
+    /// \param keep       Page that must not be evicted
+    /// \param extraBytes Memory that is about to be added to the cache, in bytes
+    ///
+    /// \return True if the cache (with the extra memory) fits its budget
+    ///
+    ////////////////////////////////////////////////////////////
+    bool trimCache(const Page& keep, std::size_t extraBytes) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Drop the pages whose texture was lost with the OpenGL contexts
+    ///
+    /// The pages loaded from an atlas restore themselves, the
+    /// others are rasterized again as their glyphs are requested.
+    ///
+    ////////////////////////////////////////////////////////////
+    void discardLostPages() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the memory used by the textures of the cache
+    ///
+    /// \return Memory used by the page textures, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getResidentBytes() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the background rasterizer, creating it if needed
+    ///
+    /// \return Pointer to the rasterizer, NULL if glyphs are loaded synchronously
+    ///
+    ////////////////////////////////////////////////////////////
+    priv::GlyphRasterizer* getRasterizer() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a missing glyph to the background rasterizer
+    ///
+    /// \param rasterizer    Background rasterizer
+    /// \param codePoint     Unicode code point of the character to load
+    /// \param characterSize Reference character size
+    /// \param bold          Retrieve the bold version or the regular one?
+    ///
+    /// \return Placeholder to use until the glyph is ready
+    ///
+    ////////////////////////////////////////////////////////////
+    const Glyph& requestGlyph(priv::GlyphRasterizer& rasterizer, Uint32 codePoint, unsigned int characterSize, bool bold) const;
+
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
     typedef std::map<unsigned int, Page> PageTable; ///< Table mapping a character size to its page (texture)
+    typedef std::map<unsigned int, GlyphTable> GlyphSizeTable; ///< Table mapping a character size to its glyphs
+    typedef std::map<unsigned int, KerningTable> KerningSizeTable; ///< Table mapping a character size to its kerning pairs
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    void*                      m_library;     ///< Pointer to the internal library interface (it is typeless to avoid exposing implementation details)
-    void*                      m_face;        ///< Pointer to the internal font face (it is typeless to avoid exposing implementation details)
-    void*                      m_streamRec;   ///< Pointer to the stream rec instance (it is typeless to avoid exposing implementation details)
-    int*                       m_refCount;    ///< Reference counter used by implicit sharing
-    Info                       m_info;        ///< Information about the font
-    mutable PageTable          m_pages;       ///< Table containing the glyphs pages by character size
-    mutable std::vector<Uint8> m_pixelBuffer; ///< Pixel buffer holding a glyph's pixels before being written to the texture
-    #ifdef SFML_SYSTEM_ANDROID
-    void*                      m_stream; ///< Asset file streamer (if loaded from file)
-    #endif
+    void*                          m_library;             ///< Pointer to the internal library interface (it is typeless to avoid exposing implementation details)
+    void*                          m_face;                ///< Pointer to the internal font face (it is typeless to avoid exposing implementation details)
+    void*                          m_streamRec;           ///< Pointer to the stream rec instance (it is typeless to avoid exposing implementation details)
+    MappedFileInputStream*         m_mapping;             ///< Font file mapped in memory, shared like the FreeType pointers
+    int*                           m_refCount;            ///< Reference counter used by implicit sharing
+    Info                           m_info;                ///< Information about the font
+    mutable PageTable              m_pages;               ///< Table containing the glyphs pages by character size
+    mutable Page*                  m_lastPage;            ///< Page returned by the last call to getPage, NULL if none
+    mutable unsigned int           m_lastPageSize;        ///< Character size of the last page
+    mutable std::vector<Uint8>     m_pixelBuffer;         ///< Pixel buffer holding a glyph's pixels before being written to the texture
+    unsigned int                   m_distanceFieldSize;   ///< Base size of the distance field glyphs, 0 if the mode is disabled
+    mutable GlyphSizeTable         m_distanceFieldGlyphs; ///< Distance field glyphs scaled to each character size
+    mutable KerningSizeTable       m_kerning;             ///< Kerning of the pairs of characters queried so far, by character size
+    std::string                    m_sourceFile;          ///< File the font was loaded from, if any
+    const void*                    m_sourceData;          ///< Memory the font was loaded from, if any
+    std::size_t                    m_sourceSize;          ///< Size of the memory the font was loaded from
+    mutable bool                   m_asyncGlyphLoading;   ///< Are the glyphs loaded in the background?
+    mutable priv::GlyphRasterizer* m_rasterizer;          ///< Background rasterizer, created on first use
+    mutable Uint64                 m_glyphRevision;       ///< Revision of the glyph cache, incremented when background glyphs are added or pages are rebuilt
+    std::size_t                    m_cacheBudget;         ///< Maximum memory of the cache textures, 0 if there is no limit
+    mutable Uint64                 m_cacheClock;          ///< Counter incremented at each page access, to find the least recently used pages
+    mutable CacheStatistics        m_cacheStatistics;     ///< Statistics of the glyph cache (the resident bytes are computed on demand)
+    mutable Clock                  m_compactionClock;     ///< Time elapsed since the last page was rebuilt
+    mutable unsigned int           m_lastTextureSize;     ///< Character size of the page of the last getTexture call
+    mutable Uint32                 m_contextGeneration;   ///< Generation of the OpenGL contexts which the pages belong to
 };
 
 } // namespace sf
@@ -418,6 +903,29 @@ private:
 /// If you need to display text of a certain size, make sure the
 /// corresponding bitmap font that supports that size is used.
 ///
+/// Text that is displayed with many different sizes, or whose
+/// scale is animated, should use the distance field mode (see
+/// setDistanceField): all the sizes are then drawn from the same
+/// texture. Each texel stores the distance to the outline of the
+/// glyph, mapped so that 0.5 is the edge and values decrease
+/// outwards; this makes effects such as outlines or glows
+/// simple to implement with a custom shader:
+/// \code
+/// uniform sampler2D texture;
+/// uniform vec4 outlineColor;
+/// void main()
+/// {
+///     float distance = texture2D(texture, gl_TexCoord[0].xy).a;
+///     float width = max(0.7 * fwidth(distance), 0.001);
+///     float fill = smoothstep(0.5 - width, 0.5 + width, distance);
+///     float outline = smoothstep(0.35 - width, 0.35 + width, distance);
+///     vec4 color = mix(outlineColor, gl_Color, fill);
+///     gl_FragColor = vec4(color.rgb, color.a * outline);
+/// }
+/// \endcode
+/// Such a shader replaces the default one when it is passed
+/// in the render states used to draw the sf::Text.
+///
 /// \see sf::Text
 ///
 ////////////////////////////////////////////////////////////
@@ -0,0 +1,161 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef SFML_FRAMEENCODER_HPP
+#define SFML_FRAMEENCODER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class Image;
+
+////////////////////////////////////////////////////////////
+/// \brief Abstract base class for the video encoders of
+///        sf::FrameRecorder
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API FrameEncoder
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Virtual destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~FrameEncoder() {}
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open a video for writing
+    ///
+    /// This function is called by the encoding thread of
+    /// sf::FrameRecorder, with the size of the first frame.
+    ///
+    /// \param filename  Path of the video to write
+    /// \param size      Size of the frames, in pixels
+    /// \param frameRate Number of frames per second
+    ///
+    /// \return True if the video was successfully opened
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool open(const std::string& filename, const Vector2u& size, unsigned int frameRate) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Encode a frame
+    ///
+    /// The frames all have the size given to open().
+    ///
+    /// \param frame RGBA pixels of the frame, top row first
+    ///
+    /// \return True if the frame was written
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool write(const Image& frame) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Finish writing the video
+    ///
+    /// This function is called by the encoding thread once the
+    /// last frame is written. The default implementation does
+    /// nothing.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void close();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert a frame to planar YUV 4:2:0 (I420)
+    ///
+    /// The output holds the full resolution luma plane followed
+    /// by the U and V planes, whose size is half the size of the
+    /// frame rounded up. The BT.601 limited range coefficients
+    /// are used. This is the input format of most video codecs,
+    /// hardware encoders included.
+    ///
+    /// \param frame  Frame to convert
+    /// \param planes Array to fill with the Y, U and V planes
+    ///
+    ////////////////////////////////////////////////////////////
+    static void convertToYuv420(const Image& frame, std::vector<Uint8>& planes);
+};
+
+} // namespace sf
+
+
+#endif // SFML_FRAMEENCODER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::FrameEncoder
+/// \ingroup graphics
+///
+/// This class allows users to plug their own video encoders
+/// into sf::FrameRecorder, for example a hardware encoder or a
+/// pipe to an external program. SFML provides encoders for
+/// uncompressed YUV4MPEG2 videos (.y4m) and sequences of QOI
+/// images (.qoi).
+///
+/// The encoder runs on the encoding thread of the recorder, so
+/// a slow encoder never stalls the rendering thread; the
+/// recorder drops frames instead when too many are waiting.
+///
+/// Usage example:
+/// \code
+/// class MyEncoder : public sf::FrameEncoder
+/// {
+/// public:
+///
+///     virtual bool open(const std::string& filename, const sf::Vector2u& size, unsigned int frameRate)
+///     {
+///         // create the encoding session
+///     }
+///
+///     virtual bool write(const sf::Image& frame)
+///     {
+///         convertToYuv420(frame, m_planes);
+///         // submit m_planes to the encoder
+///     }
+///
+///     virtual void close()
+///     {
+///         // flush the encoder and finish the file
+///     }
+///
+/// private:
+///
+///     std::vector<sf::Uint8> m_planes;
+/// };
+///
+/// MyEncoder encoder;
+/// recorder.start(encoder, "gameplay.mp4", 60);
+/// \endcode
+///
+/// \see sf::FrameRecorder
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,293 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef SFML_FRAMERECORDER_HPP
+#define SFML_FRAMERECORDER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/PixelReadback.hpp>
+#include <SFML/System/ConditionVariable.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <deque>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class FrameEncoder;
+class Image;
+class RenderWindow;
+class RenderTexture;
+
+////////////////////////////////////////////////////////////
+/// \brief Record the frames of a render target to a video,
+///        without stalling the rendering
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API FrameRecorder : NonCopyable
+{
+public:
+
+    enum {ReadbackCount = 3}; ///< Number of frames that can be in flight on the graphics card
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    FrameRecorder();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The recording is stopped, see stop().
+    ///
+    ////////////////////////////////////////////////////////////
+    ~FrameRecorder();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start recording to a file
+    ///
+    /// The encoder is chosen from the extension of the file:
+    /// "y4m" writes an uncompressed YUV4MPEG2 video, "qoi"
+    /// writes one QOI image per frame, named after the file
+    /// with the index of the frame appended.
+    /// A recording in progress is stopped first.
+    ///
+    /// \param filename  Path of the video to write
+    /// \param frameRate Number of frames per second of the video
+    ///
+    /// \return True if the recording started
+    ///
+    ////////////////////////////////////////////////////////////
+    bool start(const std::string& filename, unsigned int frameRate = 60);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start recording with a custom encoder
+    ///
+    /// The encoder must exist until the recording is stopped.
+    /// A recording in progress is stopped first.
+    ///
+    /// \param encoder   Encoder receiving the frames
+    /// \param filename  Path of the video, passed to the encoder
+    /// \param frameRate Number of frames per second of the video
+    ///
+    /// \return True if the recording started
+    ///
+    ////////////////////////////////////////////////////////////
+    bool start(FrameEncoder& encoder, const std::string& filename, unsigned int frameRate = 60);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Capture the contents of a window
+    ///
+    /// The contents of the back buffer are read, so this
+    /// function should be called after drawing everything
+    /// and before RenderWindow::display(), like
+    /// RenderWindow::capture(). It only blocks if the graphics
+    /// card is more than ReadbackCount frames late.
+    ///
+    /// The frame is dropped if the encoder is too far behind
+    /// (see setMaxQueuedFrames), or if its size differs from
+    /// the size of the first frame.
+    ///
+    /// \param window Window to capture
+    ///
+    /// \return True if the frame was captured, false if it was dropped
+    ///
+    ////////////////////////////////////////////////////////////
+    bool capture(RenderWindow& window);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Capture the contents of a render texture
+    ///
+    /// \param renderTexture Render texture to capture
+    ///
+    /// \return True if the frame was captured, false if it was dropped
+    ///
+    /// \see capture(RenderWindow&)
+    ///
+    ////////////////////////////////////////////////////////////
+    bool capture(RenderTexture& renderTexture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop recording
+    ///
+    /// The frames in flight are retrieved, and this function
+    /// waits until they are all encoded. It must be called
+    /// from the thread that captures the frames, with the
+    /// captured target still alive.
+    ///
+    ////////////////////////////////////////////////////////////
+    void stop();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a recording is in progress
+    ///
+    /// \return True if recording
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isRecording() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum number of frames waiting for the encoder
+    ///
+    /// This bounds the memory used by the recorder: at most
+    /// this many frames, including the ones in flight on the
+    /// graphics card, are kept. When the encoder can't keep up,
+    /// new frames are dropped. The default is 8 frames.
+    ///
+    /// \param count Maximum number of queued frames (at least 1)
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMaxQueuedFrames(std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of frames encoded since the recording started
+    ///
+    /// \return Number of encoded frames
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getFrameCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of frames dropped since the recording started
+    ///
+    /// \return Number of dropped frames
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getDroppedFrameCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start the encoding thread
+    ///
+    /// \param encoder   Encoder receiving the frames
+    /// \param filename  Path of the video
+    /// \param frameRate Number of frames per second of the video
+    ///
+    ////////////////////////////////////////////////////////////
+    void launch(FrameEncoder* encoder, const std::string& filename, unsigned int frameRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make room for a new readback
+    ///
+    /// \return The free readback, or NULL if the frame must be dropped
+    ///
+    ////////////////////////////////////////////////////////////
+    PixelReadback* prepareCapture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve a pending readback and queue it for encoding
+    ///
+    /// \param readback Readback to retrieve
+    ///
+    ////////////////////////////////////////////////////////////
+    void retrieve(PixelReadback& readback);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function of the encoding thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void encode();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    PixelReadback       m_readbacks[ReadbackCount]; ///< Ring of asynchronous readbacks
+    std::size_t         m_nextReadback;             ///< Index of the oldest readback, which is used next
+    Thread              m_thread;                   ///< Encoding thread
+    mutable Mutex       m_mutex;                    ///< Mutex protecting the queue and the counters
+    ConditionVariable   m_condition;                ///< Signals new frames and the end of the recording
+    std::deque<Image*>  m_queue;                    ///< Frames waiting for the encoder
+    std::vector<Image*> m_freeImages;               ///< Images reused for the next frames
+    std::size_t         m_maxQueuedFrames;          ///< Maximum number of frames queued or in flight
+    FrameEncoder*       m_encoder;                  ///< Encoder of the current recording
+    bool                m_ownsEncoder;              ///< Was the encoder created by the recorder?
+    std::string         m_filename;                 ///< Path of the video
+    unsigned int        m_frameRate;                ///< Number of frames per second of the video
+    Vector2u            m_size;                     ///< Size of the frames, defined by the first one
+    bool                m_recording;                ///< Is a recording in progress?
+    bool                m_stopping;                 ///< Must the encoding thread stop once the queue is empty?
+    Uint64              m_frameCount;               ///< Number of encoded frames
+    Uint64              m_droppedFrameCount;        ///< Number of dropped frames
+};
+
+} // namespace sf
+
+
+#endif // SFML_FRAMERECORDER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::FrameRecorder
+/// \ingroup graphics
+///
+/// sf::FrameRecorder records the frames of a window or a
+/// render texture to a video in real time. Calling
+/// RenderWindow::capture() and Image::saveToFile() every
+/// frame stalls twice: the pixels are read synchronously,
+/// and the encoding happens on the rendering thread.
+///
+/// The recorder avoids both. The pixels are copied to a ring
+/// of sf::PixelReadback objects and retrieved a few frames
+/// later, when the graphics card is done with them. The frames
+/// are then encoded by a thread of the recorder; the YUV
+/// conversion needed by video formats uses SIMD instructions
+/// when available.
+///
+/// The memory is bounded: when the encoder is slower than the
+/// game, frames are dropped instead of accumulating (see
+/// setMaxQueuedFrames and getDroppedFrameCount).
+///
+/// Out of the box, the recorder writes uncompressed YUV4MPEG2
+/// videos (.y4m, readable by most video tools) or sequences
+/// of QOI images (.qoi, lossless). Other formats, such as
+/// hardware encoders, can be plugged in by deriving from
+/// sf::FrameEncoder.
+///
+/// Usage example:
+/// \code
+/// sf::FrameRecorder recorder;
+/// recorder.start("gameplay.y4m", 60);
+///
+/// while (window.isOpen())
+/// {
+///     // ... draw the frame ...
+///
+///     recorder.capture(window);
+///     window.display();
+/// }
+///
+/// recorder.stop();
+/// \endcode
+///
+/// \see sf::FrameEncoder, sf::PixelReadback
+///
+////////////////////////////////////////////////////////////
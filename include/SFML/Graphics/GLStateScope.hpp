@@ -0,0 +1,162 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_GLSTATESCOPE_HPP
+#define SFML_GLSTATESCOPE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace sf
+{
+class RenderTarget;
+
+////////////////////////////////////////////////////////////
+/// \brief Save the OpenGL states changed by SFML, and restore them at the end of the scope
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API GLStateScope : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the scope, saving the current OpenGL states
+    ///
+    /// The target is activated, and the states that its draw
+    /// calls may change are saved. The target then considers
+    /// its own states as unknown: they are set again by the
+    /// next draw, like after a call to resetGLStates.
+    ///
+    /// \param target Target that is going to be drawn to
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit GLStateScope(RenderTarget& target);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor, restoring the saved OpenGL states
+    ///
+    ////////////////////////////////////////////////////////////
+    ~GLStateScope();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief State of a client-side vertex array
+    ///
+    ////////////////////////////////////////////////////////////
+    struct ArrayState
+    {
+        bool         enabled; ///< Is the array enabled?
+        unsigned int buffer;  ///< Buffer that the pointer refers to, 0 for client memory
+        int          size;    ///< Number of components per element
+        unsigned int type;    ///< Type of the components
+        int          stride;  ///< Bytes between two elements
+        void*        pointer; ///< Address (or offset in the buffer) of the first element
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    RenderTarget& m_target;             ///< Target whose states are saved
+    bool          m_saved;              ///< Were the states saved (was the target activated)?
+    bool          m_coreProfile;        ///< Does the context use a core profile?
+    int           m_viewport[4];        ///< Viewport
+    int           m_scissorBox[4];      ///< Scissor rectangle
+    bool          m_blend;              ///< Is blending enabled?
+    bool          m_depthTest;          ///< Is the depth test enabled?
+    bool          m_scissorTest;        ///< Is the scissor test enabled?
+    bool          m_stencilTest;        ///< Is the stencil test enabled?
+    bool          m_cullFace;           ///< Is face culling enabled?
+    bool          m_lighting;           ///< Is lighting enabled?
+    bool          m_alphaTest;          ///< Is the alpha test enabled?
+    bool          m_texture2D;          ///< Is texturing enabled on the first unit?
+    int           m_blendFunction[4];   ///< Source and destination factors of the color and alpha
+    int           m_blendEquation[2];   ///< Equations of the color and alpha
+    int           m_depthFunction;      ///< Comparison of the depth test
+    bool          m_depthMask;          ///< Are depths written?
+    int           m_stencilFunction[3]; ///< Comparison, reference value and mask of the stencil test
+    int           m_stencilOperation[3]; ///< Operations on stencil fail, depth fail and depth pass
+    int           m_stencilWriteMask;   ///< Bits of the stencil buffer that are written
+    int           m_stencilClear;       ///< Value the stencil buffer is cleared to
+    bool          m_colorMask[4];       ///< Are the color channels written?
+    float         m_clearColor[4];      ///< Color the target is cleared to
+    int           m_activeTexture;      ///< Active texture unit
+    int           m_clientActiveTexture; ///< Texture unit of the texture coordinates array
+    int           m_texture;            ///< Texture bound to the first unit
+    int           m_sampler;            ///< Sampler object bound to the first unit
+    unsigned int  m_program;            ///< Shader program in use
+    int           m_arrayBuffer;        ///< Buffer bound to GL_ARRAY_BUFFER
+    int           m_matrixMode;         ///< Matrix stack that the matrix functions operate on
+    ArrayState    m_arrays[3];          ///< Vertex, color and texture coordinates arrays
+};
+
+} // namespace sf
+
+
+#endif // SFML_GLSTATESCOPE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::GLStateScope
+/// \ingroup graphics
+///
+/// sf::GLStateScope is a lighter alternative to
+/// RenderTarget::pushGLStates and RenderTarget::popGLStates,
+/// for applications that mix SFML drawing with their own
+/// OpenGL code every frame. Instead of pushing all the
+/// attributes of the context, it saves the few states that
+/// SFML actually changes when drawing: the viewport, the
+/// blending, depth, stencil and scissor tests, the color mask
+/// and clear values, the texture and sampler bound to the
+/// first unit, the shader program, the vertex arrays and the
+/// matrices.
+///
+/// The states are restored when the scope ends, and SFML
+/// forgets what it knew about them, so that the next draw
+/// outside the scope sets its own states again.
+///
+/// Usage example:
+/// \code
+/// // OpenGL code here...
+/// {
+///     sf::GLStateScope scope(window);
+///     window.draw(...);
+///     window.draw(...);
+/// }
+/// // OpenGL code here...
+/// \endcode
+///
+/// Textures bound by shaders to the other units, and the
+/// states that SFML never changes (lights, fog, ...) are not
+/// saved. In core-profile contexts, the shader program and
+/// the vertex array bindings are not saved either: they are
+/// reset to 0 at the end of the scope, like popGLStates does.
+///
+/// \see sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
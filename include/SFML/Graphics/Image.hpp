@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/PixelFormat.hpp>
 #include <SFML/Graphics/Rect.hpp>
 #include <string>
 #include <vector>
@@ -55,6 +56,16 @@ public:
     ////////////////////////////////////////////////////////////
     Image();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// A background loading of \a copy is not transferred.
+    ///
+    /// \param copy Instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    Image(const Image& copy);
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
@@ -67,48 +78,94 @@ public:
     /// \param width  Width of the image
     /// \param height Height of the image
     /// \param color  Fill color
+    /// \param format Format of the pixels
     ///
     ////////////////////////////////////////////////////////////
-    void create(unsigned int width, unsigned int height, const Color& color = Color(0, 0, 0));
+    void create(unsigned int width, unsigned int height, const Color& color = Color(0, 0, 0), PixelFormat::Type format = PixelFormat::RGBA8);
 
     ////////////////////////////////////////////////////////////
     /// \brief Create the image from an array of pixels
     ///
-    /// The \a pixel array is assumed to contain 32-bits RGBA pixels,
-    /// and have the given \a width and \a height. If not, this is
-    /// an undefined behavior.
+    /// The \a pixel array is assumed to contain pixels of the
+    /// given \a format (32-bits RGBA by default), and have the
+    /// given \a width and \a height. If not, this is an
+    /// undefined behavior.
     /// If \a pixels is null, an empty image is created.
     ///
     /// \param width  Width of the image
     /// \param height Height of the image
     /// \param pixels Array of pixels to copy to the image
+    /// \param format Format of the pixels
     ///
     ////////////////////////////////////////////////////////////
-    void create(unsigned int width, unsigned int height, const Uint8* pixels);
+    void create(unsigned int width, unsigned int height, const Uint8* pixels, PixelFormat::Type format = PixelFormat::RGBA8);
 
     ////////////////////////////////////////////////////////////
     /// \brief Load the image from a file on disk
     ///
     /// The supported image formats are bmp, png, tga, jpg, gif,
-    /// psd, hdr and pic. Some format options are not supported,
-    /// like progressive jpeg.
+    /// psd, hdr, pic and qoi. Some format options are not supported,
+    /// like CMYK jpeg.
     /// If this function fails, the image is left unchanged.
     ///
+    /// The \a area argument can be used to load only a sub-rectangle
+    /// of the whole image, it is adjusted to fit the image size.
+    /// jpg and qoi files are decoded row by row and only the pixels
+    /// of the area are kept, so that a small part of a huge image
+    /// can be loaded without holding the whole image in memory.
+    ///
     /// \param filename Path of the image file to load
+    /// \param area     Area of the image to load (empty to load the entire image)
     ///
     /// \return True if loading was successful
     ///
     /// \see loadFromMemory, loadFromStream, saveToFile
     ///
     ////////////////////////////////////////////////////////////
-    bool loadFromFile(const std::string& filename);
+    bool loadFromFile(const std::string& filename, const IntRect& area = IntRect());
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading the image from a file in the background
+    ///
+    /// This function returns immediately: the file is decoded by
+    /// a pool of worker threads (one per CPU core) shared by all
+    /// the images, so that many files can be loaded in parallel.
+    /// The decoded pixels replace the content of the image in
+    /// isReady(), on the calling thread, when the decoding is over.
+    /// The image must not be used until then.
+    ///
+    /// \param filename Path of the image file to load
+    ///
+    /// \return True if the loading started
+    ///
+    /// \see isReady, loadFromFile
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromFileAsync(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the background loading is over
+    ///
+    /// This function never blocks. When it returns true for the
+    /// first time after loadFromFileAsync(), the decoded pixels
+    /// are applied to the image; if the loading failed (the errors
+    /// are written to the standard error output), the image is left
+    /// unchanged. It always returns true for images loaded with the
+    /// synchronous functions.
+    ///
+    /// \return True if the loading is over, false if it is still running
+    ///
+    /// \see loadFromFileAsync
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReady();
 
     ////////////////////////////////////////////////////////////
     /// \brief Load the image from a file in memory
     ///
     /// The supported image formats are bmp, png, tga, jpg, gif,
-    /// psd, hdr and pic. Some format options are not supported,
-    /// like progressive jpeg.
+    /// psd, hdr, pic and qoi. Some format options are not supported,
+    /// like CMYK jpeg.
     /// If this function fails, the image is left unchanged.
     ///
     /// \param data Pointer to the file data in memory
@@ -125,8 +182,8 @@ public:
     /// \brief Load the image from a custom stream
     ///
     /// The supported image formats are bmp, png, tga, jpg, gif,
-    /// psd, hdr and pic. Some format options are not supported,
-    /// like progressive jpeg.
+    /// psd, hdr, pic and qoi. Some format options are not supported,
+    /// like CMYK jpeg.
     /// If this function fails, the image is left unchanged.
     ///
     /// \param stream Source stream to read from
@@ -143,9 +200,16 @@ public:
     ///
     /// The format of the image is automatically deduced from
     /// the extension. The supported image formats are bmp, png,
-    /// tga and jpg. The destination file is overwritten
+    /// tga, jpg and qoi. The destination file is overwritten
     /// if it already exists. This function fails if the image is empty.
     ///
+    /// qoi files are a bit bigger than png files but are much
+    /// faster to write, which makes them a good choice to save
+    /// screenshots or replay frames while the application runs.
+    /// This function only reads the image, so it can also be
+    /// called from another thread, for example on a copy of
+    /// the image, while the application keeps running.
+    ///
     /// \param filename Path of the file to save
     ///
     /// \return True if saving was successful
@@ -163,6 +227,63 @@ public:
     ////////////////////////////////////////////////////////////
     Vector2u getSize() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the format of the pixels of the image
+    ///
+    /// \return Format of the pixels
+    ///
+    /// \see convert, setExpandOnLoad
+    ///
+    ////////////////////////////////////////////////////////////
+    PixelFormat::Type getFormat() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert the pixels of the image to another format
+    ///
+    /// Converting to a format with less channels or less bits
+    /// per channel loses information: colors become gray levels
+    /// in single and two channel formats, and the alpha is
+    /// dropped by formats which don't have it (pixels become
+    /// opaque).
+    ///
+    /// \param format New format of the pixels
+    ///
+    /// \see getFormat
+    ///
+    ////////////////////////////////////////////////////////////
+    void convert(PixelFormat::Type format);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the expansion of loaded files to RGBA
+    ///
+    /// When enabled (the default), all the files are loaded as
+    /// PixelFormat::RGBA8 pixels. When disabled, the files
+    /// loaded afterwards keep their channel count when there
+    /// is a matching format: grayscale files are loaded as
+    /// PixelFormat::R8 and grayscale files with alpha as
+    /// PixelFormat::RG8, which takes 4 or 2 times less memory.
+    /// The other files are still loaded as RGBA8.
+    ///
+    /// sf::Texture disables it when it loads files, since it
+    /// stores and samples these formats natively.
+    ///
+    /// \param expand True to expand loaded files to RGBA, false to keep their channels
+    ///
+    /// \see getExpandOnLoad, getFormat
+    ///
+    ////////////////////////////////////////////////////////////
+    void setExpandOnLoad(bool expand);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether loaded files are expanded to RGBA
+    ///
+    /// \return True if loaded files are expanded to RGBA
+    ///
+    /// \see setExpandOnLoad
+    ///
+    ////////////////////////////////////////////////////////////
+    bool getExpandOnLoad() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Create a transparency mask from a specified color-key
     ///
@@ -170,6 +291,9 @@ public:
     /// the given color to \a alpha (0 by default), so that they
     /// become transparent.
     ///
+    /// Formats without alpha are not changed, half float pixels
+    /// are clamped to [0, 1].
+    ///
     /// \param color Color to make transparent
     /// \param alpha Alpha value to assign to transparent pixels
     ///
@@ -189,6 +313,9 @@ public:
     /// source pixels is applied. If it is false, the pixels are
     /// copied unchanged with their alpha value.
     ///
+    /// The pixels are converted if the images have different
+    /// formats.
+    ///
     /// \param source     Source image to copy
     /// \param destX      X coordinate of the destination position
     /// \param destY      Y coordinate of the destination position
@@ -234,9 +361,11 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Get a read-only pointer to the array of pixels
     ///
-    /// The returned value points to an array of RGBA pixels made of
-    /// 8 bits integers components. The size of the array is
-    /// width * height * 4 (getSize().x * getSize().y * 4).
+    /// The returned value points to an array of pixels of the
+    /// format of the image, RGBA pixels made of 8 bits integers
+    /// components by default. The size of the array is
+    /// width * height * pixel size (getSize().x * getSize().y *
+    /// PixelFormat::getPixelSize(getFormat())).
     /// Warning: the returned pointer may become invalid if you
     /// modify the image, so you should never store it for too long.
     /// If the image is empty, a null pointer is returned.
@@ -258,16 +387,76 @@ public:
     ////////////////////////////////////////////////////////////
     void flipVertically();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Multiply the color components of the pixels by their alpha
+    ///
+    /// Premultiplied pixels can be drawn with a blend mode such as
+    /// sf::BlendMode(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha),
+    /// which avoids dark fringes around filtered or scaled
+    /// transparent areas. Each component becomes
+    /// (component * alpha + 127) / 255. Formats without alpha
+    /// are not changed, half float pixels are clamped to [0, 1].
+    ///
+    ////////////////////////////////////////////////////////////
+    void premultiplyAlpha();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the size of the image, interpolating its pixels
+    ///
+    /// The pixels are bilinearly interpolated, which gives good
+    /// results down to half the original size. Smaller sizes
+    /// should be reached with several successive halvings.
+    /// Resizing an empty image creates a black one.
+    /// Half float pixels are clamped to [0, 1].
+    ///
+    /// \param width  New width of the image
+    /// \param height New height of the image
+    ///
+    ////////////////////////////////////////////////////////////
+    void resize(unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// A background loading of \a right is not transferred.
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Image& operator =(const Image& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the contents of this image with those of another
+    ///
+    /// The pixels are exchanged without being copied. Background
+    /// loadings of both images are cancelled.
+    ///
+    /// \param right Instance to swap with
+    ///
+    ////////////////////////////////////////////////////////////
+    void swap(Image& right);
+
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Cancel the background loading of the image, if any
+    ///
+    /// If a worker thread is decoding the file, this function
+    /// waits until it is done.
+    ///
+    ////////////////////////////////////////////////////////////
+    void cancelLoading();
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Vector2u           m_size;   ///< Image size
-    std::vector<Uint8> m_pixels; ///< Pixels of the image
-    #ifdef SFML_SYSTEM_ANDROID
-    void*              m_stream; ///< Asset file streamer (if loaded from file)
-    #endif
+    Vector2u           m_size;         ///< Image size
+    std::vector<Uint8> m_pixels;       ///< Pixels of the image
+    PixelFormat::Type  m_format;       ///< Format of the pixels
+    bool               m_expandOnLoad; ///< Are loaded files expanded to RGBA?
+    bool               m_loading;      ///< Is a file being loaded in the background?
 };
 
 } // namespace sf
@@ -285,19 +474,39 @@ private:
 /// functions to load, read, write and save pixels, as well
 /// as many other useful functions.
 ///
-/// sf::Image can handle a unique internal representation of
-/// pixels, which is RGBA 32 bits. This means that a pixel
-/// must be composed of 8 bits red, green, blue and alpha
-/// channels -- just like a sf::Color.
-/// All the functions that return an array of pixels follow
-/// this rule, and all parameters that you pass to sf::Image
-/// functions (such as loadFromMemory) must use this
-/// representation as well.
+/// By default, sf::Image stores pixels as RGBA 32 bits. This
+/// means that a pixel is composed of 8 bits red, green, blue
+/// and alpha channels -- just like a sf::Color. Images can
+/// also store their pixels in a more compact format (gray
+/// levels with or without alpha, 16 bits colors) or in half
+/// floats for HDR content, see sf::PixelFormat. They are
+/// created in these formats, converted with convert(), or
+/// loaded from grayscale files with setExpandOnLoad(false).
+/// getPixel() and setPixel() convert the colors, the arrays
+/// of pixels (getPixelsPtr(), create()) are in the format of
+/// the image.
 ///
 /// A sf::Image can be copied, but it is a heavy resource and
 /// if possible you should always use [const] references to
 /// pass or return them to avoid useless copies.
 ///
+/// Many files can be decoded in parallel with loadFromFileAsync():
+/// \code
+/// std::vector<sf::Image> images(filenames.size());
+/// for (std::size_t i = 0; i < filenames.size(); ++i)
+///     images[i].loadFromFileAsync(filenames[i]);
+///
+/// // Wait until all the images are decoded
+/// std::size_t ready = 0;
+/// while (ready < images.size())
+/// {
+///     ready = 0;
+///     for (std::size_t i = 0; i < images.size(); ++i)
+///         ready += images[i].isReady() ? 1 : 0;
+///     // draw a loading screen...
+/// }
+/// \endcode
+///
 /// Usage example:
 /// \code
 /// // Load an image file from a file
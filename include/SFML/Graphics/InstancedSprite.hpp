@@ -0,0 +1,363 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_INSTANCEDSPRITE_HPP
+#define SFML_INSTANCEDSPRITE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+class TransformableArray;
+
+////////////////////////////////////////////////////////////
+/// \brief Many copies of a textured quad, each with its
+///        own transform, color and texture rectangle
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API InstancedSprite : public Drawable, public Transformable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty instanced sprite with no source texture.
+    ///
+    ////////////////////////////////////////////////////////////
+    InstancedSprite();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the instanced sprite from a source texture
+    ///
+    /// \param texture Source texture
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit InstancedSprite(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the source texture of the instanced sprite
+    ///
+    /// The \a texture argument refers to a texture that must
+    /// exist as long as the instanced sprite uses it. Indeed, it
+    /// doesn't store its own copy of the texture, but rather keeps
+    /// a pointer to the one that you passed to this function.
+    /// All the instances share the same texture.
+    ///
+    /// \param texture New texture
+    ///
+    /// \see getTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the source texture of the instanced sprite
+    ///
+    /// If the instanced sprite has no source texture, a NULL
+    /// pointer is returned.
+    ///
+    /// \return Pointer to the instanced sprite's texture
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a new instance
+    ///
+    /// The transform of the instance is combined with the
+    /// transform of the instanced sprite itself. The size of
+    /// the instance is the size of its texture rectangle,
+    /// exactly like sf::Sprite.
+    ///
+    /// \param transform   Transform of the instance
+    /// \param textureRect Sub-rectangle of the texture to display
+    /// \param color       Color of the instance
+    ///
+    /// \return Index of the new instance
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t append(const Transform& transform, const IntRect& textureRect, const Color& color = Color::White);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the instances
+    ///
+    /// This function doesn't deallocate the corresponding
+    /// memory, so that adding new instances after clearing
+    /// doesn't involve reallocating all the memory.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resize the instance buffer
+    ///
+    /// If \a instanceCount is greater than the current size,
+    /// the existing instances are kept and new (default-constructed)
+    /// instances are added: identity transform, empty texture
+    /// rectangle and white color.
+    /// If \a instanceCount is less than the current size, existing
+    /// instances are removed from the buffer.
+    ///
+    /// \param instanceCount New number of instances
+    ///
+    ////////////////////////////////////////////////////////////
+    void resize(std::size_t instanceCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the number of instances
+    ///
+    /// \return Number of instances
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getInstanceCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the transform of an instance
+    ///
+    /// This function doesn't check \a index, it must be in range
+    /// [0, getInstanceCount() - 1]. The behavior is undefined
+    /// otherwise.
+    ///
+    /// \param index     Index of the instance
+    /// \param transform New transform of the instance
+    ///
+    /// \see getInstanceTransform
+    ///
+    ////////////////////////////////////////////////////////////
+    void setInstanceTransform(std::size_t index, const Transform& transform);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the transforms of consecutive instances
+    ///
+    /// The transforms of the elements of \a transformables are
+    /// copied to the instances starting at \a first, without
+    /// building their 4x4 matrices. The elements that don't
+    /// have a matching instance are ignored.
+    ///
+    /// \param first          Index of the first instance to change
+    /// \param transformables Transforms of the instances
+    ///
+    /// \see setInstanceTransform
+    ///
+    ////////////////////////////////////////////////////////////
+    void setInstanceTransforms(std::size_t first, const TransformableArray& transformables);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the texture rectangle of an instance
+    ///
+    /// This function doesn't check \a index, it must be in range
+    /// [0, getInstanceCount() - 1]. The behavior is undefined
+    /// otherwise.
+    ///
+    /// \param index       Index of the instance
+    /// \param textureRect Sub-rectangle of the texture to display
+    ///
+    /// \see getInstanceTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    void setInstanceTextureRect(std::size_t index, const IntRect& textureRect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the color of an instance
+    ///
+    /// This function doesn't check \a index, it must be in range
+    /// [0, getInstanceCount() - 1]. The behavior is undefined
+    /// otherwise.
+    ///
+    /// \param index Index of the instance
+    /// \param color New color of the instance
+    ///
+    /// \see getInstanceColor
+    ///
+    ////////////////////////////////////////////////////////////
+    void setInstanceColor(std::size_t index, const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the transform of an instance
+    ///
+    /// \param index Index of the instance
+    ///
+    /// \return Transform of the instance
+    ///
+    /// \see setInstanceTransform
+    ///
+    ////////////////////////////////////////////////////////////
+    Transform getInstanceTransform(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture rectangle of an instance
+    ///
+    /// \param index Index of the instance
+    ///
+    /// \return Texture rectangle of the instance
+    ///
+    /// \see setInstanceTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    IntRect getInstanceTextureRect(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the color of an instance
+    ///
+    /// \param index Index of the instance
+    ///
+    /// \return Color of the instance
+    ///
+    /// \see setInstanceColor
+    ///
+    ////////////////////////////////////////////////////////////
+    Color getInstanceColor(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the entity
+    ///
+    /// The returned rectangle is in local coordinates, which means
+    /// that it ignores the transformations (translation, rotation,
+    /// scale, ...) that are applied to the entity, but includes
+    /// the transforms of the individual instances.
+    ///
+    /// \return Local bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global bounding rectangle of the entity
+    ///
+    /// The returned rectangle is in global coordinates, which means
+    /// that it takes into account the transformations (translation,
+    /// rotation, scale, ...) that are applied to the entity.
+    ///
+    /// \return Global bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getGlobalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports hardware instancing
+    ///
+    /// This function should always be called before relying
+    /// on the hardware path. If it returns false, instanced
+    /// sprites are still drawn correctly, but each instance
+    /// is expanded into vertices on the CPU.
+    ///
+    /// Hardware instancing requires shaders and the
+    /// ARB_draw_instanced extension.
+    ///
+    /// \return True if hardware instancing is supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isInstancingAvailable();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the instanced sprite to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Expand the instances into a triangle list
+    ///
+    /// This is the fallback used when hardware instancing
+    /// is not available, or when the user provides a shader.
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateVertices() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const Texture*              m_texture;      ///< Texture shared by all the instances
+    std::vector<float>          m_instances;    ///< Packed per-instance data (matrix, offset, texture rectangle, color)
+    mutable std::vector<Vertex> m_vertices;     ///< Expanded vertices used by the CPU fallback
+    mutable bool                m_needsUpdate;  ///< Do the expanded vertices need to be rebuilt?
+};
+
+} // namespace sf
+
+
+#endif // SFML_INSTANCEDSPRITE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::InstancedSprite
+/// \ingroup graphics
+///
+/// sf::InstancedSprite draws many copies of the same textured
+/// quad in a single operation. Each copy (instance) has its own
+/// transform, color and texture rectangle, stored in a compact
+/// per-instance buffer instead of four full vertices.
+///
+/// When the system supports it (see isInstancingAvailable()),
+/// all the instances are rendered with a single vertex quad and
+/// hardware instancing, which is much cheaper than drawing as
+/// many sf::Sprite. Otherwise, instances are expanded into
+/// triangles on the CPU and drawn as a single vertex array.
+/// The CPU path is also used when a custom shader is passed
+/// in the render states, since the hardware path relies on an
+/// internal shader.
+///
+/// Like sf::Sprite, sf::InstancedSprite doesn't copy the texture
+/// that it uses, it only keeps a reference to it.
+///
+/// Usage example:
+/// \code
+/// sf::Texture texture;
+/// texture.loadFromFile("particle.png");
+///
+/// sf::InstancedSprite particles(texture);
+/// for (int i = 0; i < 10000; ++i)
+/// {
+///     sf::Transform transform;
+///     transform.translate(std::rand() % 800, std::rand() % 600).rotate(std::rand() % 360);
+///     particles.append(transform, sf::IntRect(0, 0, 16, 16), sf::Color(255, 255, 255, 128));
+/// }
+///
+/// window.draw(particles);
+/// \endcode
+///
+/// \see sf::Sprite, sf::VertexArray
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,334 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef SFML_LATENCYMONITOR_HPP
+#define SFML_LATENCYMONITOR_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <deque>
+#include <vector>
+
+
+namespace sf
+{
+class Event;
+class Window;
+
+////////////////////////////////////////////////////////////
+/// \brief Measures the latency between the input events and
+///        the display of the frames that respond to them
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API LatencyMonitor : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Intervals measured for each frame
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Interval
+    {
+        EventQueue,    ///< From the oldest input event of the frame to its reception by the application
+        Processing,    ///< From the reception of the input event to the submission of the frame
+        Rendering,     ///< From the submission of the frame to the end of its rendering by the GPU
+        Presentation,  ///< From the end of the rendering (or the submission if unknown) to the display of the frame
+        Total,         ///< From the input event to the display of the frame (or to the last known step)
+
+        IntervalCount  ///< Keep last -- the total number of intervals
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Times of the steps of a frame
+    ///
+    /// All the times are on the time line of Window::getEventTime.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_GRAPHICS_API Frame
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Sets all the times to zero.
+        ///
+        ////////////////////////////////////////////////////////////
+        Frame();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Tell whether an interval was measured for the frame
+        ///
+        /// The intervals which start at the input event are only
+        /// measured for the frames that received input events, the
+        /// others need the times reported by the GPU and the display.
+        ///
+        /// \param interval Interval to check
+        ///
+        /// \return True if the times that the interval needs are known
+        ///
+        ////////////////////////////////////////////////////////////
+        bool isMeasured(Interval interval) const;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Get the duration of an interval
+        ///
+        /// \param interval Interval to measure
+        ///
+        /// \return Duration of the interval, Time::Zero if it was not measured
+        ///
+        ////////////////////////////////////////////////////////////
+        Time getDuration(Interval interval) const;
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        Uint64 number;    ///< Number of the frame, counted from the first one submitted to the monitor
+        bool   hasInput;  ///< Did the application receive input events during the frame?
+        Time   input;     ///< Timestamp of the oldest input event received during the frame
+        Time   received;  ///< Time at which the application received this event
+        Time   submitted; ///< Time at which the frame was submitted to the window
+        Time   rendered;  ///< Time at which the GPU finished rendering the frame, Time::Zero if unknown
+        Time   presented; ///< Time at which the frame reached the display, Time::Zero if unknown
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Distribution of the durations of an interval
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_GRAPHICS_API Histogram
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Creates an empty histogram of 1 ms buckets.
+        ///
+        ////////////////////////////////////////////////////////////
+        Histogram();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Get a percentile of the durations
+        ///
+        /// The result is the upper limit of the bucket which
+        /// contains the percentile, so its precision is the
+        /// width of the buckets.
+        ///
+        /// \param percentile Percentile to compute, between 0 and 100
+        ///
+        /// \return Duration below which \a percentile percent of the measures are
+        ///
+        ////////////////////////////////////////////////////////////
+        Time getPercentile(float percentile) const;
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        Time                bucketWidth; ///< Range of durations counted by each bucket
+        std::vector<Uint64> counts;      ///< Number of measures in each bucket; the last one also counts the longer measures
+        Uint64              total;       ///< Total number of measures
+        Time                maximum;     ///< Longest measure
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    LatencyMonitor();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~LatencyMonitor();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record the reception of an event by the application
+    ///
+    /// Call this function for every event returned by
+    /// Window::pollEvent or Window::waitEvent. Only the input
+    /// events (keyboard, mouse, joystick, touch and sensors)
+    /// are measured; the oldest one of each frame starts the
+    /// latency of the frame.
+    ///
+    /// \param event Event received by the application
+    ///
+    ////////////////////////////////////////////////////////////
+    void addEvent(const Event& event);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Submit the current frame and display it
+    ///
+    /// Call this function instead of window.display(). It
+    /// marks the end of the rendering of the frame with a GPU
+    /// timestamp query, displays the window, then collects the
+    /// times of the previous frames which are known by now;
+    /// it never waits for the GPU.
+    ///
+    /// \param window Window which displays the frame
+    ///
+    ////////////////////////////////////////////////////////////
+    void display(Window& window);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pop the next frame whose measures are complete
+    ///
+    /// Frames are complete a few frames after they were
+    /// submitted, once the GPU and the display have reported
+    /// their times. The last 256 complete frames are kept
+    /// until they are popped.
+    ///
+    /// \param frame Frame to fill
+    ///
+    /// \return True if a frame was returned, false if there are none
+    ///
+    ////////////////////////////////////////////////////////////
+    bool pollFrame(Frame& frame);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the distribution of the durations of an interval
+    ///
+    /// The histogram counts all the complete frames since the
+    /// monitor was created or reset.
+    ///
+    /// \param interval Interval whose histogram to get
+    ///
+    /// \return Histogram of the interval
+    ///
+    ////////////////////////////////////////////////////////////
+    const Histogram& getHistogram(Interval interval) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Clear the histograms and the complete frames
+    ///
+    /// The frames in flight are still measured.
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the times of the frames in flight that are known
+    ///
+    /// \param window Window which displayed the frames
+    ///
+    ////////////////////////////////////////////////////////////
+    void collect(Window& window);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Frame waiting for its times
+    ///
+    ////////////////////////////////////////////////////////////
+    struct PendingFrame
+    {
+        Frame        frame;     ///< Times known so far
+        unsigned int query;     ///< Timestamp query issued after the rendering, 0 once read or if there is none
+        bool         presented; ///< Has the display reported the presentation of the frame?
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Frame                     m_current;                   ///< Frame being prepared
+    std::deque<PendingFrame>  m_pending;                   ///< Submitted frames, waiting for their times
+    std::deque<Frame>         m_complete;                  ///< Complete frames, waiting to be popped
+    Histogram                 m_histograms[IntervalCount]; ///< Distributions of the intervals of the complete frames
+    std::vector<unsigned int> m_queries;                   ///< Free timestamp queries
+    Uint64                    m_contextId;                 ///< Context which owns the queries
+    Int64                     m_gpuOffset;                 ///< Time line of the events minus GPU time, in nanoseconds
+    Uint64                    m_presentedFrames;           ///< Number of frames presented by the window, as last reported
+    bool                      m_presentationKnown;         ///< Has the presentation count of the window been read?
+};
+
+} // namespace sf
+
+
+#endif // SFML_LATENCYMONITOR_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::LatencyMonitor
+/// \ingroup graphics
+///
+/// sf::LatencyMonitor breaks down the delay between a user
+/// action and its result on the screen into the steps of the
+/// frame that responds to it:
+/// \li the timestamp of the input event, given by the system
+///     (sf::Event::timestamp)
+/// \li its reception by the application, through pollEvent
+///     or waitEvent
+/// \li the submission of the frame, when it is displayed
+/// \li the end of its rendering, reported by a GPU timestamp
+///     query (desktop OpenGL 3.3 or ARB_timer_query)
+/// \li its presentation on the display, reported by the
+///     driver (see Window::getLastPresentation)
+///
+/// The GPU and the display report their times a few frames
+/// later, so the frames become complete with a delay; the
+/// monitor never waits for them. Where a step can't be
+/// measured, its time is zero and the intervals which depend
+/// on it are skipped; the total latency then ends at the
+/// last known step.
+///
+/// The presentations are matched to the frames by counting
+/// them, which assumes that every frame of the window is
+/// displayed through the monitor.
+///
+/// Comparing the histograms with different settings (vertical
+/// synchronization, framerate limit, batching, ...) shows where
+/// the latency comes from.
+///
+/// Usage example:
+/// \code
+/// sf::LatencyMonitor monitor;
+///
+/// while (window.isOpen())
+/// {
+///     sf::Event event;
+///     while (window.pollEvent(event))
+///     {
+///         monitor.addEvent(event);
+///         ...
+///     }
+///
+///     window.clear();
+///     ...
+///     monitor.display(window);
+///
+///     sf::LatencyMonitor::Frame frame;
+///     while (monitor.pollFrame(frame))
+///     {
+///         if (frame.isMeasured(sf::LatencyMonitor::Total))
+///             log << frame.getDuration(sf::LatencyMonitor::Total).asMicroseconds() << std::endl;
+///     }
+/// }
+///
+/// sf::Time p99 = monitor.getHistogram(sf::LatencyMonitor::Total).getPercentile(99);
+/// \endcode
+///
+/// \see sf::Window::getLastPresentation, sf::Event
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_LAYEREDVERTEX_HPP
+#define SFML_LAYEREDVERTEX_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/System/Vector2.hpp>
+
+
+namespace sf
+{
+class Vertex;
+
+////////////////////////////////////////////////////////////
+/// \brief Vertex with a third texture coordinate, the layer
+///        of a texture array
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API LayeredVertex
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    LayeredVertex();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the vertex from its position, color, texture coordinates and layer
+    ///
+    /// \param thePosition  Vertex position
+    /// \param theColor     Vertex color
+    /// \param theTexCoords Vertex texture coordinates
+    /// \param theLayer     Index of the texture array layer to map to the vertex
+    ///
+    ////////////////////////////////////////////////////////////
+    LayeredVertex(const Vector2f& thePosition, const Color& theColor, const Vector2f& theTexCoords, float theLayer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the vertex from a regular vertex and a layer
+    ///
+    /// \param vertex   Vertex to convert
+    /// \param theLayer Index of the texture array layer to map to the vertex
+    ///
+    ////////////////////////////////////////////////////////////
+    LayeredVertex(const Vertex& vertex, float theLayer);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2f  position;  ///< 2D position of the vertex
+    Color     color;     ///< Color of the vertex
+    Vector2f  texCoords; ///< Coordinates of the texture's pixel to map to the vertex
+    float     layer;     ///< Layer of the texture array to map to the vertex (third texture coordinate)
+};
+
+} // namespace sf
+
+
+#endif // SFML_LAYEREDVERTEX_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::LayeredVertex
+/// \ingroup graphics
+///
+/// sf::LayeredVertex is a sf::Vertex with one more texture
+/// coordinate, which is passed to OpenGL as the third
+/// component of the texture coordinates: shaders find it in
+/// gl_MultiTexCoord0.z. It is meant for geometry that samples
+/// a sf::TextureArray, where it selects the layer, and for
+/// shaders that need one more value per vertex.
+///
+/// Layered vertices take 24 bytes instead of the 20 bytes of
+/// sf::Vertex, so only the draws that need the layer pay for
+/// it. They are drawn from client memory with the
+/// RenderTarget::draw overloads that take them, or stored in
+/// a sf::VertexBuffer created with the Layered format.
+/// Unlike sf::Vertex arrays, they are never merged with the
+/// other draws by the automatic batching.
+///
+/// \see sf::Vertex, sf::TextureArray, sf::VertexBuffer
+///
+////////////////////////////////////////////////////////////
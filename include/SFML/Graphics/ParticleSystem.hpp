@@ -0,0 +1,501 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PARTICLESYSTEM_HPP
+#define SFML_PARTICLESYSTEM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Drawable set of particles, created by emitters and
+///        moved by affectors
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ParticleSystem : public Drawable, public Transformable, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Source of particles
+    ///
+    /// The new particles start at a random point of the
+    /// rectangle of size 2 * \a positionSpread centered on
+    /// \a position, in the local coordinates of the system.
+    /// Their direction, speed and lifetime are taken randomly
+    /// in [value - spread, value + spread].
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_GRAPHICS_API Emitter
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Creates an emitter at (0, 0), which emits 100 particles
+        /// per second in all directions at 100 units per second,
+        /// living for 1 second.
+        ///
+        ////////////////////////////////////////////////////////////
+        Emitter();
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        Vector2f position;       ///< Center of the emission area
+        Vector2f positionSpread; ///< Half size of the emission area
+        float    rate;           ///< Number of particles emitted per second
+        float    angle;          ///< Direction of the particles, in degrees
+        float    angleSpread;    ///< Random variation of the direction, in degrees
+        float    speed;          ///< Speed of the particles, in units per second
+        float    speedSpread;    ///< Random variation of the speed
+        Time     lifetime;       ///< Lifetime of the particles
+        Time     lifetimeSpread; ///< Random variation of the lifetime
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Access to the state of the living particles
+    ///
+    /// The state is stored as a structure of arrays: the values
+    /// of the particle i are positionX[i], positionY[i], etc.
+    /// Setting the age of a particle to its lifetime or more
+    /// kills it.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Particles
+    {
+        std::size_t count;     ///< Number of particles
+        float*      positionX; ///< Horizontal positions
+        float*      positionY; ///< Vertical positions
+        float*      velocityX; ///< Horizontal velocities, in units per second
+        float*      velocityY; ///< Vertical velocities, in units per second
+        float*      age;       ///< Time elapsed since the particles were emitted, in seconds
+        float*      lifetime;  ///< Lifetimes of the particles, in seconds
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Custom modifier of the particles
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_GRAPHICS_API Affector
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Virtual destructor
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual ~Affector();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Modify the particles
+        ///
+        /// This function is called by ParticleSystem::update,
+        /// after the built-in motion is applied.
+        ///
+        /// \param particles State of the living particles
+        /// \param elapsed   Time elapsed since the last update
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void affect(const Particles& particles, Time elapsed) = 0;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param capacity Maximum number of living particles
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit ParticleSystem(std::size_t capacity = 10000);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of living particles
+    ///
+    /// \return Capacity of the system
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCapacity() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of living particles
+    ///
+    /// \return Number of particles
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getParticleCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a continuous emitter
+    ///
+    /// \param emitter Emitter to add
+    ///
+    /// \return Index of the emitter
+    ///
+    /// \see getEmitter, removeEmitter
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t addEmitter(const Emitter& emitter);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get an emitter, to modify it
+    ///
+    /// \param index Index of the emitter
+    ///
+    /// \return Reference to the emitter
+    ///
+    ////////////////////////////////////////////////////////////
+    Emitter& getEmitter(std::size_t index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of continuous emitters
+    ///
+    /// \return Number of emitters
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getEmitterCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a continuous emitter
+    ///
+    /// The indices of the following emitters are decremented.
+    ///
+    /// \param index Index of the emitter
+    ///
+    ////////////////////////////////////////////////////////////
+    void removeEmitter(std::size_t index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Emit a burst of particles at once
+    ///
+    /// The rate of \a emitter is ignored.
+    ///
+    /// \param emitter Properties of the new particles
+    /// \param count   Number of particles to emit
+    ///
+    ////////////////////////////////////////////////////////////
+    void emit(const Emitter& emitter, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a custom affector
+    ///
+    /// The system only keeps a pointer to the affector, it must
+    /// stay alive as long as it is used.
+    /// Custom affectors run on the CPU: they disable the GPU
+    /// simulation.
+    ///
+    /// \param affector Affector to add
+    ///
+    ////////////////////////////////////////////////////////////
+    void addAffector(Affector& affector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a custom affector
+    ///
+    /// \param affector Affector to remove
+    ///
+    ////////////////////////////////////////////////////////////
+    void removeAffector(Affector& affector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the acceleration applied to all the particles
+    ///
+    /// This is typically the gravity. The default acceleration
+    /// is (0, 0).
+    ///
+    /// \param acceleration Acceleration, in units per second squared
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAcceleration(const Vector2f& acceleration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the acceleration applied to all the particles
+    ///
+    /// \return Acceleration, in units per second squared
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getAcceleration() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the drag applied to all the particles
+    ///
+    /// The velocity of the particles decreases exponentially,
+    /// by a factor e every 1 / \a drag seconds. The default
+    /// drag is 0.
+    ///
+    /// \param drag Drag coefficient, per second
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDrag(float drag);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the drag applied to all the particles
+    ///
+    /// \return Drag coefficient, per second
+    ///
+    ////////////////////////////////////////////////////////////
+    float getDrag() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the colors of the particles over their lifetime
+    ///
+    /// The color of a particle is interpolated from \a start,
+    /// when it is emitted, to \a end, when it dies. The default
+    /// colors are opaque white and transparent white.
+    ///
+    /// \param start Color of the new particles
+    /// \param end   Color of the dying particles
+    ///
+    ////////////////////////////////////////////////////////////
+    void setColors(const Color& start, const Color& end);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the sizes of the particles over their lifetime
+    ///
+    /// The size of a particle is interpolated from \a start,
+    /// when it is emitted, to \a end, when it dies. The default
+    /// sizes are 4 and 4.
+    ///
+    /// \param start Size of the new particles, in local units
+    /// \param end   Size of the dying particles, in local units
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSizes(float start, float end);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the texture of the particles
+    ///
+    /// The whole texture is mapped on each particle. If
+    /// \a texture is NULL, the particles are plain squares.
+    ///
+    /// \param texture Texture of the particles
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture* texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture of the particles
+    ///
+    /// \return Texture of the particles, or NULL if none was set
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the simulation on the GPU
+    ///
+    /// When enabled and supported (see isGpuSimulationAvailable),
+    /// and when there is no custom affector, the particles are
+    /// uploaded once when they are emitted, and their motion,
+    /// color and size are computed by a vertex shader. update()
+    /// then only costs the emission of the new particles.
+    /// The lifetime of the particles is limited to 65 seconds
+    /// in this mode, and the shader of the render states is
+    /// ignored.
+    ///
+    /// Switching between the CPU and the GPU simulation removes
+    /// the living particles. It is enabled by default.
+    ///
+    /// \param enabled True to simulate the particles on the GPU when possible
+    ///
+    ////////////////////////////////////////////////////////////
+    void setGpuSimulationEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the simulation on the GPU is enabled
+    ///
+    /// \return True if the GPU simulation is enabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isGpuSimulationEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the particles and emit the new ones
+    ///
+    /// \param elapsed Time elapsed since the last update
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(Time elapsed);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the living particles
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the system supports the simulation on the GPU
+    ///
+    /// This requires shaders, vertex buffers and point sprites.
+    ///
+    /// \return True if the GPU simulation is supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isGpuSimulationAvailable();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the particles to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create new particles
+    ///
+    /// \param emitter Properties of the new particles
+    /// \param count   Number of particles to create
+    ///
+    ////////////////////////////////////////////////////////////
+    void spawn(const Emitter& emitter, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the particles emitted on the GPU since the last upload
+    ///
+    ////////////////////////////////////////////////////////////
+    void uploadSpawns();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a random number in [-1, 1]
+    ///
+    ////////////////////////////////////////////////////////////
+    float random();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the scale of the point sprites, from local units to pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    static float getPointScale(const RenderTarget& target, const Transform& transform);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::size_t                 m_capacity;           ///< Maximum number of living particles
+    std::vector<Emitter>        m_emitters;           ///< Continuous emitters
+    std::vector<float>          m_emissionRemainders; ///< Fractions of particles not emitted yet, per emitter
+    std::vector<Affector*>      m_affectors;          ///< Custom affectors
+    Vector2f                    m_acceleration;       ///< Acceleration of the particles
+    float                       m_drag;               ///< Drag coefficient of the particles
+    Color                       m_startColor;         ///< Color of the new particles
+    Color                       m_endColor;           ///< Color of the dying particles
+    float                       m_startSize;          ///< Size of the new particles
+    float                       m_endSize;            ///< Size of the dying particles
+    const Texture*              m_texture;            ///< Texture of the particles
+    bool                        m_gpuEnabled;         ///< Is the GPU simulation enabled?
+    bool                        m_gpuActive;          ///< Are the living particles simulated on the GPU?
+    Int64                       m_time;               ///< Time of the simulation, in microseconds
+    Uint32                      m_seed;               ///< State of the random number generator
+    std::size_t                 m_count;              ///< Number of particles simulated on the CPU
+    std::vector<float>          m_positionX;          ///< Horizontal positions of the CPU particles
+    std::vector<float>          m_positionY;          ///< Vertical positions of the CPU particles
+    std::vector<float>          m_velocityX;          ///< Horizontal velocities of the CPU particles
+    std::vector<float>          m_velocityY;          ///< Vertical velocities of the CPU particles
+    std::vector<float>          m_age;                ///< Ages of the CPU particles, in seconds
+    std::vector<float>          m_lifetime;           ///< Lifetimes of the CPU particles, in seconds
+    mutable std::vector<Vertex> m_vertices;           ///< Vertices of the CPU particles
+    VertexBuffer                m_spawnBuffer;        ///< Initial state of the GPU particles, as a ring buffer
+    std::vector<Vertex>         m_spawns;             ///< GPU particles emitted since the last upload
+    std::vector<Int64>          m_deathTimes;         ///< Time at which the particle of each slot of the ring dies, in milliseconds
+    std::size_t                 m_ringHead;           ///< Next slot of the ring buffer to write
+    std::size_t                 m_spawnStart;         ///< Slot of the first particle of m_spawns
+};
+
+} // namespace sf
+
+
+#endif // SFML_PARTICLESYSTEM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ParticleSystem
+/// \ingroup graphics
+///
+/// sf::ParticleSystem simulates and draws large numbers of
+/// small particles: fire, smoke, sparks, rain...
+///
+/// Particles are created by emitters, either continuously
+/// (addEmitter) or in bursts (emit). They move with a common
+/// acceleration and drag, and their color and size are
+/// interpolated over their lifetime. Custom affectors can
+/// modify the particles in any other way.
+///
+/// The particles can be simulated in two ways:
+/// \li on the CPU, where the state of the particles is stored as
+///     a structure of arrays and updated with SIMD instructions;
+///     custom affectors require this mode
+/// \li on the GPU, where each particle is uploaded once when it
+///     is emitted, and its motion is computed by a vertex shader
+///     from the time elapsed since its emission
+///
+/// In both modes, each particle is drawn as a single point
+/// sprite whose size is set by a shader. When shaders are not
+/// available, or when the system is drawn with a custom shader,
+/// the particles are drawn as textured quads instead.
+///
+/// Usage example:
+/// \code
+/// sf::ParticleSystem fire(50000);
+/// fire.setTexture(&sparkTexture);
+/// fire.setAcceleration(sf::Vector2f(0, -50));
+/// fire.setColors(sf::Color(255, 200, 0), sf::Color(255, 0, 0, 0));
+/// fire.setSizes(8, 2);
+///
+/// sf::ParticleSystem::Emitter emitter;
+/// emitter.position = sf::Vector2f(400, 500);
+/// emitter.positionSpread = sf::Vector2f(20, 0);
+/// emitter.rate = 10000;
+/// emitter.angle = -90;
+/// emitter.angleSpread = 15;
+/// emitter.lifetime = sf::seconds(2);
+/// fire.addEmitter(emitter);
+///
+/// sf::Clock clock;
+/// while (window.isOpen())
+/// {
+///     ...
+///     fire.update(clock.restart());
+///     window.draw(fire, sf::BlendAdd);
+/// }
+/// \endcode
+///
+/// \see sf::VertexArray
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,71 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef SFML_PIXELFORMAT_HPP
+#define SFML_PIXELFORMAT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace PixelFormat
+{
+    ////////////////////////////////////////////////////////////
+    /// \ingroup graphics
+    /// \brief Layouts of the pixels of images and textures
+    ///
+    /// The single and two channel formats store gray levels:
+    /// they are read as the colors that an RGBA image would
+    /// have, and sampled as such in shaders.
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Type
+    {
+        RGBA8,  ///< 8 bits red, green, blue and alpha channels (4 bytes per pixel), the default
+        R8,     ///< 8 bits gray level, opaque (1 byte per pixel)
+        RG8,    ///< 8 bits gray level and alpha (2 bytes per pixel)
+        RGB565, ///< 5 bits red, 6 bits green and 5 bits blue packed in a native 16 bits integer, opaque (2 bytes per pixel)
+        RGBA16F ///< 16 bits floating point red, green, blue and alpha channels, for HDR rendering (8 bytes per pixel)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \ingroup graphics
+    /// \brief Get the size of a pixel of a given format
+    ///
+    /// \param format Pixel format
+    ///
+    /// \return Size of a pixel, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    SFML_GRAPHICS_API std::size_t getPixelSize(Type format);
+}
+
+} // namespace sf
+
+
+#endif // SFML_PIXELFORMAT_HPP
@@ -0,0 +1,235 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PIXELREADBACK_HPP
+#define SFML_PIXELREADBACK_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+class RenderWindow;
+class RenderTexture;
+
+////////////////////////////////////////////////////////////
+/// \brief Asynchronous copy of pixels from the graphics
+///        card to an image
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API PixelReadback : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    PixelReadback();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~PixelReadback();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start copying the pixels of a texture
+    ///
+    /// The copy is queued and this function returns
+    /// immediately; use isReady() to know when the pixels
+    /// have arrived, and getImage() to retrieve them.
+    /// A previous readback that was not retrieved is discarded.
+    ///
+    /// \param texture Texture to read
+    ///
+    /// \return True if the copy was started
+    ///
+    ////////////////////////////////////////////////////////////
+    bool start(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start copying the contents of a window
+    ///
+    /// The contents of the back buffer are read, so this
+    /// function should be called after drawing everything
+    /// and before RenderWindow::display(), like RenderWindow::capture().
+    ///
+    /// \param window Window to read
+    ///
+    /// \return True if the copy was started
+    ///
+    /// \see start(const Texture&)
+    ///
+    ////////////////////////////////////////////////////////////
+    bool start(RenderWindow& window);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start copying the contents of a render texture
+    ///
+    /// \param renderTexture Render texture to read
+    ///
+    /// \return True if the copy was started
+    ///
+    /// \see start(const Texture&)
+    ///
+    ////////////////////////////////////////////////////////////
+    bool start(RenderTexture& renderTexture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a readback was started and not retrieved yet
+    ///
+    /// \return True if a readback is pending
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isPending() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the pixels have arrived
+    ///
+    /// This function never blocks. If fences are not supported
+    /// by the system, it can't tell and always returns true
+    /// for a pending readback: in this case, waiting for a
+    /// frame or two before calling getImage() usually avoids
+    /// the stall.
+    ///
+    /// \return True if getImage() can be called without blocking
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReady() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Retrieve the pixels of the pending readback
+    ///
+    /// If the pixels have not arrived yet, this function
+    /// blocks until they do. The readback is not pending
+    /// anymore after this call.
+    ///
+    /// \param image Image that receives the pixels
+    ///
+    /// \return True if a readback was pending and the pixels were retrieved
+    ///
+    ////////////////////////////////////////////////////////////
+    bool getImage(Image& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports asynchronous readbacks
+    ///
+    /// Asynchronous readbacks require pixel buffer objects.
+    /// When they are not supported, start() reads the pixels
+    /// synchronously.
+    ///
+    /// \return True if asynchronous readbacks are supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the currently bound framebuffer into the buffer
+    ///
+    /// \param size Size of the framebuffer
+    ///
+    /// \return True if the copy was started
+    ///
+    ////////////////////////////////////////////////////////////
+    bool readFramebuffer(const Vector2u& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Insert a fence after the commands that fill the buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    void insertFence();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the pending fence, if any
+    ///
+    ////////////////////////////////////////////////////////////
+    void deleteFence();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int m_buffer;      ///< Pixel pack buffer receiving the pixels
+    void*        m_fence;       ///< Fence signaled when the copy is done, if supported
+    Image        m_image;       ///< Pixels read synchronously, when buffers are not supported
+    Vector2u     m_size;        ///< Size of the useful area
+    Vector2u     m_bufferSize;  ///< Size of the area stored in the buffer
+    bool         m_flipped;     ///< Are the rows stored bottom to top?
+    bool         m_pending;     ///< Is a readback pending?
+};
+
+} // namespace sf
+
+
+#endif // SFML_PIXELREADBACK_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::PixelReadback
+/// \ingroup graphics
+///
+/// Texture::copyToImage and RenderWindow::capture wait until
+/// the graphics card has finished all the pending drawing
+/// and copied the pixels back, which can take a lot of time.
+///
+/// sf::PixelReadback splits this operation in two: start()
+/// queues the copy into a pixel buffer object and returns
+/// immediately, and getImage() retrieves the pixels later,
+/// typically on the next frame. isReady() polls a fence to
+/// know whether the pixels have arrived without blocking.
+///
+/// Usage example:
+/// \code
+/// sf::PixelReadback readback;
+///
+/// while (window.isOpen())
+/// {
+///     window.clear();
+///     ... draw the scene ...
+///
+///     if (recording && !readback.isPending())
+///         readback.start(window);
+///
+///     window.display();
+///
+///     sf::Image frame;
+///     if (readback.isReady() && readback.getImage(frame))
+///         recorder.addFrame(frame);
+/// }
+/// \endcode
+///
+/// \see sf::Texture, sf::RenderWindow, sf::RenderTexture
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,224 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_POSTPROCESSCHAIN_HPP
+#define SFML_POSTPROCESSCHAIN_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class RenderTarget;
+class RenderTexture;
+class RenderTexturePool;
+class Shader;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Applies a sequence of shaders to a texture
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API PostProcessChain : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the chain
+    ///
+    /// \param pool Pool to take the intermediate render textures from;
+    ///             it must outlive the chain
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit PostProcessChain(RenderTexturePool& pool);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The intermediate render textures are released to the pool.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~PostProcessChain();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a pass at the end of the chain
+    ///
+    /// The shader reads the result of the previous pass (or the
+    /// source texture for the first pass) through a sampler set
+    /// to sf::Shader::CurrentTexture. The shader must outlive
+    /// the chain, or be removed before being destroyed.
+    ///
+    /// \param shader Shader of the pass
+    ///
+    ////////////////////////////////////////////////////////////
+    void addPass(const Shader& shader);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the passes
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearPasses();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of passes of the chain
+    ///
+    /// \return Number of passes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPassCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the smooth filter on the
+    ///        intermediate textures
+    ///
+    /// It is disabled by default.
+    ///
+    /// \param smooth True to enable smoothing, false to disable it
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSmooth(bool smooth);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the smooth filter is enabled on the
+    ///        intermediate textures
+    ///
+    /// \return True if smoothing is enabled, false if it is disabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSmooth() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run the passes on a texture, and draw the result
+    ///
+    /// All the passes but the last one draw into intermediate
+    /// render textures of the size of the source, alternating
+    /// between two of them; the last pass draws directly into
+    /// the target, with the transform and blend mode of
+    /// \a states (its texture and shader are ignored). Without
+    /// passes, the source is drawn as it is.
+    ///
+    /// The intermediate render textures are kept from one call
+    /// to the next, as long as the size of the source doesn't
+    /// change.
+    ///
+    /// \param source Texture to process
+    /// \param target Render target to draw the result to
+    /// \param states Render states of the last pass
+    ///
+    ////////////////////////////////////////////////////////////
+    void apply(const Texture& source, RenderTarget& target, const RenderStates& states = RenderStates::Default);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make sure that the intermediate render textures exist
+    ///
+    /// \param width  Width of the render textures
+    /// \param height Height of the render textures
+    /// \param count  Number of render textures needed (0 to 2)
+    ///
+    /// \return True if the render textures are ready
+    ///
+    ////////////////////////////////////////////////////////////
+    bool ensureTargets(unsigned int width, unsigned int height, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give the intermediate render textures back to the pool
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseTargets();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    RenderTexturePool*         m_pool;       ///< Pool of the intermediate render textures
+    std::vector<const Shader*> m_passes;     ///< Shaders of the passes, in order
+    RenderTexture*             m_targets[2]; ///< Intermediate render textures, used alternately
+    bool                       m_smooth;     ///< Smooth filter of the intermediate textures
+    Vertex                     m_quad[4];    ///< Rectangle covering the source, drawn by every pass
+};
+
+} // namespace sf
+
+
+#endif // SFML_POSTPROCESSCHAIN_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::PostProcessChain
+/// \ingroup graphics
+///
+/// Full-screen effects are often made of several shaders
+/// applied one after the other: the scene is drawn into a
+/// render texture, a first shader extracts the bright parts,
+/// two others blur them, and a last one combines them and
+/// draws the result to the window.
+///
+/// sf::PostProcessChain runs such a sequence of passes. The
+/// intermediate results go to two render textures taken from
+/// a sf::RenderTexturePool, which are drawn alternately and
+/// kept from one frame to the next: nothing is allocated
+/// while the size of the source stays the same, and since
+/// the render textures of a pool share their OpenGL context,
+/// going from one pass to the next doesn't switch contexts.
+///
+/// Each shader reads the output of the previous pass through
+/// its sampler set to sf::Shader::CurrentTexture.
+///
+/// Usage example:
+/// \code
+/// sf::RenderTexturePool pool;
+/// sf::RenderTexture* scene = pool.acquire(800, 600);
+///
+/// sf::Shader bright, blur, tonemap;
+/// ... // load the shaders, and set their "texture" uniform to sf::Shader::CurrentTexture
+///
+/// sf::PostProcessChain chain(pool);
+/// chain.addPass(bright);
+/// chain.addPass(blur);
+/// chain.addPass(tonemap);
+///
+/// while (window.isOpen())
+/// {
+///     ...
+///     scene->clear();
+///     scene->draw(...);
+///     scene->display();
+///
+///     window.clear();
+///     chain.apply(scene->getTexture(), window);
+///     window.display();
+/// }
+/// \endcode
+///
+/// \see sf::RenderTexturePool, sf::Shader
+///
+////////////////////////////////////////////////////////////
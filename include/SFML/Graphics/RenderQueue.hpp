@@ -0,0 +1,351 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_RENDERQUEUE_HPP
+#define SFML_RENDERQUEUE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <vector>
+#include <map>
+
+
+namespace sf
+{
+class Shader;
+class Texture;
+class VertexArray;
+
+////////////////////////////////////////////////////////////
+/// \brief Deferred list of draw commands, sorted to
+///        minimize render-state changes
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API RenderQueue : public Drawable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Ways of drawing the sorted commands
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Mode
+    {
+        Sorted,     ///< Commands are drawn in the sorted order (default)
+        OpaqueFirst ///< Opaque commands are drawn first, in reverse order with a depth test, then the others
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty queue, with batching enabled.
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderQueue();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record primitives defined by an array of vertices
+    ///
+    /// The vertices are copied, so the array doesn't have to
+    /// outlive the call. The texture and shader of \a states,
+    /// however, must exist until the queue is drawn.
+    ///
+    /// Commands are sorted by \a layer first, then by shader,
+    /// texture and blend mode, and finally by \a depth. Commands
+    /// that compare equal are drawn in the order they were added.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    /// \param layer       Layer of the command, lower layers are drawn first
+    /// \param depth       Depth of the command inside its layer and states, lower depths are drawn first
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+             const RenderStates& states = RenderStates::Default, Uint8 layer = 0, float depth = 0.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record the content of a vertex array
+    ///
+    /// \param vertices Vertex array to record
+    /// \param states   Render states to use for drawing
+    /// \param layer    Layer of the command, lower layers are drawn first
+    /// \param depth    Depth of the command inside its layer and states, lower depths are drawn first
+    ///
+    /// \see add(const Vertex*, std::size_t, PrimitiveType, const RenderStates&, Uint8, float)
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(const VertexArray& vertices, const RenderStates& states = RenderStates::Default,
+             Uint8 layer = 0, float depth = 0.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a drawable object
+    ///
+    /// The drawable is not copied, it must exist until the
+    /// queue is drawn. Since the queue can't know the states
+    /// that the drawable sets by itself, only \a states is
+    /// used to compute the sort key of the command.
+    ///
+    /// \param drawable Object to record
+    /// \param states   Render states to use for drawing
+    /// \param layer    Layer of the command, lower layers are drawn first
+    /// \param depth    Depth of the command inside its layer and states, lower depths are drawn first
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(const Drawable& drawable, const RenderStates& states = RenderStates::Default,
+             Uint8 layer = 0, float depth = 0.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the recorded commands
+    ///
+    /// This function doesn't deallocate the corresponding
+    /// memory, so that recording the next frame doesn't
+    /// involve reallocating it.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the number of recorded commands
+    ///
+    /// \return Number of commands
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCommandCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable batching while the queue is drawn
+    ///
+    /// When enabled, the target's batching mode is turned on
+    /// while the sorted commands are replayed, so that consecutive
+    /// commands sharing the same states are merged into large draws
+    /// (see RenderTarget::setBatchingEnabled). The previous mode of
+    /// the target is restored afterwards.
+    /// Batching is enabled by default.
+    ///
+    /// \param enabled True to enable batching, false to disable it
+    ///
+    /// \see isBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBatchingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether batching is enabled while the queue is drawn
+    ///
+    /// \return True if batching is enabled, false otherwise
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isBatchingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the way the sorted commands are drawn
+    ///
+    /// In OpaqueFirst mode, the commands drawn with sf::BlendNone
+    /// are considered opaque. They are drawn first, from the last
+    /// one in the sorted order to the first one, with a depth test
+    /// that writes their depth: the pixels hidden by the commands
+    /// that come later in the sorted order are rejected before
+    /// their fragment processing. The other commands are then
+    /// drawn in the sorted order, tested against the depth of
+    /// the opaque ones. The result is the same as in Sorted mode,
+    /// but the hidden parts of the opaque layers cost nothing.
+    ///
+    /// The depth of the commands is computed from their position
+    /// in the sorted order, the one of the render states given
+    /// to the queue is ignored. The depth buffer of the target
+    /// is cleared when the queue is drawn, and its depth test is
+    /// restored afterwards. The target must have a depth buffer
+    /// (see sf::RenderTarget::setDepthTest).
+    ///
+    /// Drawables are classified with the blend mode of the states
+    /// they were recorded with, not with the one they may set
+    /// themselves. The default mode is Sorted.
+    ///
+    /// \param mode Drawing mode
+    ///
+    /// \see getMode
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMode(Mode mode);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the way the sorted commands are drawn
+    ///
+    /// \return Drawing mode
+    ///
+    /// \see setMode
+    ///
+    ////////////////////////////////////////////////////////////
+    Mode getMode() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Replay the sorted commands into a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states, combined with the states of each command
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the sort key of a new command
+    ///
+    /// \param states Render states of the command
+    /// \param layer  Layer of the command
+    /// \param depth  Depth of the command
+    ///
+    /// \return 64-bits sort key
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 computeKey(const RenderStates& states, Uint8 layer, float depth);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Sort the commands by key, if they changed since the last sort
+    ///
+    ////////////////////////////////////////////////////////////
+    void sort() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the opaque commands then the other ones,
+    ///        with a depth test
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawOpaqueFirst(RenderTarget& target, const RenderStates& states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recorded draw command
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Command
+    {
+        RenderStates    states;      ///< Render states of the command
+        const Drawable* drawable;    ///< Recorded drawable, or NULL for vertices
+        std::size_t     firstVertex; ///< Index of the first vertex in the vertex storage
+        std::size_t     vertexCount; ///< Number of vertices
+        PrimitiveType   type;        ///< Type of primitives
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw a command
+    ///
+    /// \param target  Render target to draw to
+    /// \param command Command to draw
+    /// \param states  Current render states
+    /// \param depth   Depth of the command
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawCommand(RenderTarget& target, const Command& command, const RenderStates& states, float depth) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a command starts a run of commands
+    ///        with the same states, in the sorted order
+    ///
+    /// \param position Position of the command in the sorted order
+    ///
+    /// \return True if the states differ from the previous command
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isRunStart(std::size_t position) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Command>             m_commands;   ///< Recorded commands, in submission order
+    std::vector<Vertex>              m_vertices;   ///< Storage for the vertices of all the commands
+    std::vector<Uint64>              m_keys;       ///< Sort key of each command
+    std::map<const Shader*, Uint64>  m_shaders;    ///< Shaders seen since the last clear, with their part of the key
+    std::map<const Texture*, Uint64> m_textures;   ///< Textures seen since the last clear, with their part of the key
+    std::vector<BlendMode>           m_blendModes; ///< Blend modes seen since the last clear, their index is their part of the key
+    mutable std::vector<std::size_t> m_order;      ///< Indices of the commands, in drawing order
+    mutable std::vector<std::size_t> m_scratch;    ///< Temporary storage for the radix sort
+    mutable bool                     m_sorted;     ///< Is m_order up to date?
+    bool                             m_batching;   ///< Is batching enabled during replay?
+    Mode                             m_mode;       ///< Way of drawing the sorted commands
+};
+
+} // namespace sf
+
+
+#endif // SFML_RENDERQUEUE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::RenderQueue
+/// \ingroup graphics
+///
+/// sf::RenderQueue records draw commands instead of executing
+/// them immediately. When the queue is drawn to a render target,
+/// the commands are sorted by a 64-bits key made of their layer,
+/// shader, texture, blend mode and depth, so that commands sharing
+/// the same states end up next to each other. This minimizes the
+/// number of state changes, and by default the sorted commands
+/// are fed to the batching mode of the target, turning them into
+/// a few large draw calls.
+///
+/// Layers provide explicit ordering: everything in layer 0 is
+/// drawn before anything in layer 1, regardless of the states.
+/// Inside a layer, the order of commands with different states
+/// is not preserved, so overlapping translucent geometry that
+/// must be drawn in a specific order should use different
+/// layers or depths.
+///
+/// The queue keeps its commands until clear() is called, so a
+/// static scene can be recorded once and drawn every frame.
+///
+/// On fill-rate bound hardware, the OpaqueFirst mode draws the
+/// opaque commands (sf::BlendNone) from front to back with a
+/// depth test, so that the pixels they hide are never shaded.
+///
+/// Usage example:
+/// \code
+/// sf::RenderQueue queue;
+///
+/// // Record the frame, in any order
+/// queue.add(terrain, sf::RenderStates(&tileset), 0);
+/// queue.add(characters, sf::RenderStates(&sprites), 1);
+/// queue.add(hud, sf::RenderStates(&uiTexture), 2);
+///
+/// // Draw everything, sorted
+/// window.draw(queue);
+/// queue.clear();
+/// \endcode
+///
+/// \see sf::RenderTarget, sf::VertexArray
+///
+////////////////////////////////////////////////////////////
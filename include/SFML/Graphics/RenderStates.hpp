@@ -30,6 +30,9 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/SamplerMode.hpp>
+#include <SFML/Graphics/StencilMode.hpp>
 #include <SFML/Graphics/Transform.hpp>
 
 
@@ -56,6 +59,8 @@ public:
     /// \li the identity transform
     /// \li a null texture
     /// \li a null shader
+    /// \li no scissor rectangle and a disabled stencil mode
+    /// \li the filter and wrap mode of the texture
     ///
     ////////////////////////////////////////////////////////////
     RenderStates();
@@ -92,6 +97,14 @@ public:
     ////////////////////////////////////////////////////////////
     RenderStates(const Shader* theShader);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a default set of render states with a custom sampler mode
+    ///
+    /// \param theSamplerMode Sampler mode to use
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderStates(const SamplerMode& theSamplerMode);
+
     ////////////////////////////////////////////////////////////
     /// \brief Construct a set of render states with all its attributes
     ///
@@ -112,10 +125,14 @@ public:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    BlendMode      blendMode; ///< Blending mode
-    Transform      transform; ///< Transform
-    const Texture* texture;   ///< Texture
-    const Shader*  shader;    ///< Shader
+    BlendMode      blendMode;   ///< Blending mode
+    Transform      transform;   ///< Transform
+    const Texture* texture;     ///< Texture
+    const Shader*  shader;      ///< Shader
+    float          depth;       ///< Depth of the primitives for the depth test, from -1 (nearest) to 1 (farthest)
+    IntRect        scissor;     ///< Area of the target outside of which nothing is drawn, in pixels (empty to disable)
+    StencilMode    stencilMode; ///< How the primitives use the stencil buffer of the target
+    SamplerMode    samplerMode; ///< Filter and wrap mode of the texture, overriding the texture's own ones
 };
 
 } // namespace sf
@@ -135,6 +152,30 @@ public:
 /// \li the texture: what image is mapped to the object
 /// \li the shader: what custom effect is applied to the object
 ///
+/// The depth of the object is only used when the target has
+/// a depth test enabled (see sf::RenderTarget::setDepthTest):
+/// it lets the graphics card reject the pixels hidden behind
+/// opaque objects that were drawn before.
+///
+/// The scissor rectangle and the stencil mode clip the object
+/// while it is drawn, directly into the target: the scissor
+/// rectangle to an area of the target, given in pixels from
+/// its top-left corner (whatever the view), and the stencil
+/// mode to a mask of any shape drawn before (see sf::StencilMode).
+/// Clipping this way doesn't need an intermediate render
+/// texture or a view per clipped area, and consecutive objects
+/// clipped by the same rectangle are still batched together.
+/// \code
+/// sf::RenderStates states;
+/// states.scissor = sf::IntRect(panelLeft, panelTop, panelWidth, panelHeight);
+/// for (std::size_t i = 0; i < items.size(); ++i)
+///     window.draw(items[i], states);
+/// \endcode
+///
+/// The sampler mode overrides the filter and the wrap mode
+/// of the texture for the draw, so that the same texture can
+/// be drawn both pixelated and smoothed (see sf::SamplerMode).
+///
 /// High-level objects such as sprites or text force some of
 /// these states when they are drawn. For example, a sprite
 /// will set its own texture, so that you don't have to care
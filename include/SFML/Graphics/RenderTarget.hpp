@@ -38,11 +38,20 @@
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <vector>
 
 
 namespace sf
 {
 class Drawable;
+class LayeredVertex;
+class VertexBuffer;
+
+namespace priv
+{
+    class CoreRenderer;
+    class SamplerCache;
+}
 
 ////////////////////////////////////////////////////////////
 /// \brief Base class for all render targets (window, texture, ...)
@@ -52,6 +61,69 @@ class SFML_GRAPHICS_API RenderTarget : NonCopyable
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief OpenGL calls issued by a thread
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_GRAPHICS_API GlStatistics
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Sets all the counters to zero.
+        ///
+        ////////////////////////////////////////////////////////////
+        GlStatistics();
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        Uint64 calls;                 ///< OpenGL functions called by SFML (see getGlStatistics)
+        Uint64 drawCalls;             ///< Draw calls
+        Uint64 textureBinds;          ///< Textures bound
+        Uint64 redundantTextureBinds; ///< Texture bindings skipped because the texture was already bound
+        Uint64 stateQueries;          ///< OpenGL states queried because they were not known yet
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rendering work of a target during one frame
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_GRAPHICS_API Statistics
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Sets all the counters to zero.
+        ///
+        ////////////////////////////////////////////////////////////
+        Statistics();
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        Uint64 drawCalls;             ///< OpenGL draw calls
+        Uint64 vertices;              ///< Vertices submitted to OpenGL
+        Uint64 cachedVertices;        ///< Vertices pre-transformed on the CPU (vertex cache and batch)
+        Uint64 untransformedVertices; ///< Vertices sent untransformed, with the transform as a matrix
+        Uint64 textureChanges;        ///< Texture switches
+        Uint64 shaderChanges;         ///< Shaders bound (shader bindings are not cached)
+        Uint64 blendModeChanges;      ///< Blend mode switches
+        Uint64 viewChanges;           ///< View (viewport and projection) switches
+        Uint64 glStateResets;         ///< Calls to resetGLStates, explicit or implicit
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Ways of testing the depth of the drawn pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    enum DepthTest
+    {
+        NoDepthTest,    ///< Pixels are always drawn and the depth buffer is left untouched (default)
+        DepthTestWrite, ///< Pixels behind the depth buffer are rejected, the others write their depth
+        DepthTestRead   ///< Pixels behind the depth buffer are rejected, the depth buffer is left untouched
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
@@ -69,6 +141,33 @@ public:
     ////////////////////////////////////////////////////////////
     void clear(const Color& color = Color(0, 0, 0, 255));
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Clear the depth buffer of the target
+    ///
+    /// After this call, every pixel passes the depth test. This
+    /// function does nothing useful if the target was created
+    /// without a depth buffer.
+    ///
+    /// \see setDepthTest
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearDepth();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Clear the stencil buffer of the target
+    ///
+    /// The masks drawn with StencilMode::Write are erased: every
+    /// pixel of the stencil buffer is set to \a value. This
+    /// function does nothing useful if the target was created
+    /// without a stencil buffer.
+    ///
+    /// \param value Value to fill the stencil buffer with
+    ///
+    /// \see RenderStates::stencilMode
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearStencil(Uint8 value = 0);
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the current active view
     ///
@@ -247,6 +346,248 @@ public:
     void draw(const Vertex* vertices, std::size_t vertexCount,
               PrimitiveType type, const RenderStates& states = RenderStates::Default);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw indexed primitives defined by an array of vertices
+    ///
+    /// The primitives are assembled from the vertices selected
+    /// by \a indices, so that the vertices shared by several
+    /// primitives (like the 4 corners of a quad made of two
+    /// triangles) are only stored once. Every index must be
+    /// lower than \a vertexCount.
+    ///
+    /// The sf::Quads primitive type can't be used with indices:
+    /// use sf::Triangles with 6 indices per quad instead.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param indices     Pointer to the indices
+    /// \param indexCount  Number of indices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Vertex* vertices, std::size_t vertexCount, const Uint16* indices, std::size_t indexCount,
+              PrimitiveType type, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw indexed primitives defined by an array of vertices
+    ///
+    /// This overload accepts 32-bit indices, for arrays of more
+    /// than 65536 vertices. On OpenGL ES, 32-bit indices are
+    /// converted to 16-bit ones, so larger arrays can't be drawn.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param indices     Pointer to the indices
+    /// \param indexCount  Number of indices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Vertex* vertices, std::size_t vertexCount, const Uint32* indices, std::size_t indexCount,
+              PrimitiveType type, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by an array of layered vertices
+    ///
+    /// The layer of each vertex is passed to the shader as the
+    /// third texture coordinate (see sf::LayeredVertex). These
+    /// primitives are not merged with the other draws by the
+    /// automatic batching.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const LayeredVertex* vertices, std::size_t vertexCount,
+              PrimitiveType type, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw indexed primitives defined by an array of layered vertices
+    ///
+    /// The indices follow the same rules as for sf::Vertex
+    /// arrays; layered vertices only accept 16-bit indices.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param indices     Pointer to the indices
+    /// \param indexCount  Number of indices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const LayeredVertex* vertices, std::size_t vertexCount, const Uint16* indices, std::size_t indexCount,
+              PrimitiveType type, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by a vertex buffer
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by a vertex buffer
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param firstVertex  Index of the first vertex to render
+    /// \param vertexCount  Number of vertices to render
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex,
+              std::size_t vertexCount, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable automatic batching of draw calls
+    ///
+    /// When batching is enabled, consecutive draws that use the
+    /// same texture, shader and blend mode are not sent to the
+    /// graphics card immediately: their vertices are pre-transformed
+    /// and appended to a single vertex stream, which is drawn with
+    /// one OpenGL call when the render states change, when the
+    /// view changes, when the target is cleared or displayed, or
+    /// when flush() is called explicitly.
+    ///
+    /// Because the draw is deferred, the textures and shaders
+    /// used by the batched vertices must stay alive and unchanged
+    /// until the batch is flushed. In particular, if you modify
+    /// a shader parameter between two draws that use the same
+    /// shader, you have to call flush() before changing it.
+    ///
+    /// Batching is disabled by default.
+    ///
+    /// \param enabled True to enable batching, false to disable it
+    ///
+    /// \see isBatchingEnabled, flush
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBatchingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether automatic batching is enabled or not
+    ///
+    /// \return True if batching is enabled, false otherwise
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isBatchingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable automatic culling of draw calls
+    ///
+    /// When culling is enabled, the primitives drawn with the
+    /// draw functions that take vertices (which includes sprites,
+    /// shapes, texts and vertex arrays) are skipped, before any
+    /// transformation and OpenGL call, if their bounding rectangle
+    /// is completely outside the area shown by the current view.
+    /// This is a cheap test, but it still has to go through all
+    /// the vertices; for large scenes, skipping the invisible
+    /// objects before drawing them with isVisible() is even faster.
+    ///
+    /// Draws that use a shader are never culled, because a vertex
+    /// shader may move the vertices anywhere; vertex buffers
+    /// are never culled either. Points and lines are considered
+    /// as infinitely thin.
+    ///
+    /// Culling is disabled by default.
+    ///
+    /// \param enabled True to enable culling, false to disable it
+    ///
+    /// \see isCullingEnabled, isVisible
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCullingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether automatic culling is enabled or not
+    ///
+    /// \return True if culling is enabled, false otherwise
+    ///
+    /// \see setCullingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isCullingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the depth test of the next draws
+    ///
+    /// With a depth test, the pixels of a draw are rejected if
+    /// they are behind (their depth is greater or equal to) the
+    /// ones already drawn, before their fragment processing;
+    /// the depth of a draw is the one of its render states.
+    /// Drawing opaque objects from the nearest to the farthest
+    /// with DepthTestWrite, then translucent ones from the
+    /// farthest to the nearest with DepthTestRead, saves the
+    /// cost of the hidden pixels (see sf::RenderQueue::OpaqueFirst).
+    ///
+    /// The target must have a depth buffer: a window created
+    /// with depth bits in its context settings, or a render
+    /// texture created with a depth buffer.
+    ///
+    /// \param test Depth test to use
+    ///
+    /// \see getDepthTest, clearDepth, RenderStates::depth
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDepthTest(DepthTest test);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the depth test of the next draws
+    ///
+    /// \return Current depth test
+    ///
+    /// \see setDepthTest
+    ///
+    ////////////////////////////////////////////////////////////
+    DepthTest getDepthTest() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a rectangle is in the area shown by the current view
+    ///
+    /// The rectangle is in world coordinates, typically the
+    /// global bounds of the entity to draw:
+    /// \code
+    /// for (std::size_t i = 0; i < tiles.size(); ++i)
+    /// {
+    ///     if (window.isVisible(tiles[i].getGlobalBounds()))
+    ///         window.draw(tiles[i]);
+    /// }
+    /// \endcode
+    /// For rotated views, the tested area is the bounding
+    /// rectangle of what the view shows, so the test is
+    /// conservative. This function works whether culling is
+    /// enabled or not.
+    ///
+    /// \param rectangle Rectangle to test, in world coordinates
+    ///
+    /// \return True if the rectangle intersects or touches the view, false if it is completely outside
+    ///
+    /// \see setCullingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isVisible(const FloatRect& rectangle) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the pending batched primitives, if any
+    ///
+    /// This function is called automatically when needed, you
+    /// only have to call it yourself if you modify a resource
+    /// (texture, shader parameter) that is still referenced by
+    /// the pending batch, or before issuing your own OpenGL
+    /// calls on the target.
+    /// It does nothing if batching is disabled.
+    ///
+    /// \see setBatchingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void flush();
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the rendering region of the target
     ///
@@ -282,7 +623,8 @@ public:
     /// be achieved if you handle OpenGL states yourself (because
     /// you know which states have really changed, and need to be
     /// saved and restored). Take a look at the resetGLStates
-    /// function if you do so.
+    /// function if you do so, or at sf::GLStateScope, which
+    /// only saves the states that SFML changes.
     ///
     /// \see popGLStates
     ///
@@ -323,6 +665,74 @@ public:
     ////////////////////////////////////////////////////////////
     void resetGLStates();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the OpenGL calls issued by SFML on the calling thread
+    ///
+    /// The counters cover all the OpenGL calls made by the
+    /// graphics module on the calling thread since the last
+    /// call to resetGlStatistics, whatever the target or the
+    /// resource (textures, shaders, ...) they were made for.
+    /// Resetting them every frame gives the cost of a frame:
+    /// \code
+    /// sf::RenderTarget::resetGlStatistics();
+    /// window.draw(...);
+    /// window.display();
+    /// sf::RenderTarget::GlStatistics stats = sf::RenderTarget::getGlStatistics();
+    /// \endcode
+    ///
+    /// SFML tracks the texture bindings of the active context,
+    /// so that functions which temporarily bind a texture don't
+    /// have to query and restore the previous binding through
+    /// OpenGL. If you change the bindings with your own OpenGL
+    /// code, use pushGLStates/popGLStates or resetGLStates so
+    /// that SFML forgets them.
+    ///
+    /// Counting every OpenGL call has a cost, so the calls
+    /// counter is only maintained in debug builds, or when SFML
+    /// is built with SFML_ENABLE_GL_STATISTICS or
+    /// SFML_ENABLE_PROFILER; it stays at zero otherwise. The
+    /// other counters are always maintained.
+    ///
+    /// \return Counters of the calling thread
+    ///
+    /// \see resetGlStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    static GlStatistics getGlStatistics();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the OpenGL call counters of the calling thread to zero
+    ///
+    /// \see getGlStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    static void resetGlStatistics();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the rendering statistics of the last frame
+    ///
+    /// The counters are accumulated while drawing, and display()
+    /// makes them the statistics of the frame and starts a new
+    /// count. The returned values are therefore those of the
+    /// last displayed frame, they don't change until the next
+    /// call to display():
+    /// \code
+    /// window.clear();
+    /// window.draw(...);
+    /// window.display();
+    /// sf::RenderTarget::Statistics stats = window.getStatistics();
+    /// \endcode
+    ///
+    /// Unlike getGlStatistics, only the work done by this target
+    /// is counted. Comparing the vertices pre-transformed on the
+    /// CPU to those sent untransformed shows whether the geometry
+    /// benefits from the vertex cache and the batch.
+    ///
+    /// \return Statistics of the last displayed frame
+    ///
+    ////////////////////////////////////////////////////////////
+    const Statistics& getStatistics() const;
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -340,8 +750,163 @@ protected:
     ////////////////////////////////////////////////////////////
     void initialize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Make the current counters the statistics of the frame
+    ///
+    /// The derived classes must call this function when a frame
+    /// is displayed. The counters are reset for the next frame.
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void endFrameStatistics();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make the next draw set all the OpenGL states again
+    ///
+    /// The derived classes must call this function when their
+    /// context was used by another target since they last drew.
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateGLStates();
+
 private:
 
+    friend class CommandBuffer;
+    friend class GLStateScope;
+    friend class InstancedSprite;
+    friend class ParticleSystem;
+    friend class VertexArray;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by an array of vertices, with known bounds
+    ///
+    /// This is the common implementation of the public draw
+    /// function; drawables that cache the bounds of their
+    /// vertices pass them, so that culling doesn't have to
+    /// walk the vertices again.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    /// \param bounds      Local bounds of the vertices, or NULL to compute them if culling needs them
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawVertices(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+                      const RenderStates& states, const FloatRect* bounds);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw indexed primitives, with 16 or 32-bit indices
+    ///
+    /// This is the common implementation of the public indexed
+    /// draw functions.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param indices     Pointer to the indices
+    /// \param indexCount  Number of indices in the array
+    /// \param indexSize   Size of an index, in bytes (2 or 4)
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawIndexed(const Vertex* vertices, std::size_t vertexCount, const void* indices, std::size_t indexCount,
+                     std::size_t indexSize, PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives immediately, bypassing the batch
+    ///
+    /// Quads are drawn as triangles with the shared quad indices,
+    /// since GL_QUADS is not available everywhere.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    /// \param indices     Pointer to the indices, or NULL to draw the vertices in order
+    /// \param indexCount  Number of indices in the array
+    /// \param indexSize   Size of an index, in bytes (2 or 4)
+    /// \param batched     Are the vertices the pre-transformed vertices of the batch?
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawPrimitives(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states,
+                        const void* indices = NULL, std::size_t indexCount = 0, std::size_t indexSize = 2,
+                        bool batched = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw layered primitives immediately
+    ///
+    /// The pending batch is flushed first. The vertices are
+    /// transformed by OpenGL, and quads are drawn as triangles
+    /// with the shared quad indices.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    /// \param indices     Pointer to the 16-bit indices, or NULL to draw the vertices in order
+    /// \param indexCount  Number of indices in the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawLayered(const LayeredVertex* vertices, std::size_t vertexCount, PrimitiveType type,
+                     const RenderStates& states, const Uint16* indices = NULL, std::size_t indexCount = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append primitives to the pending batch
+    ///
+    /// The batch is flushed first if the new primitives can't
+    /// be merged with it.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    /// \param indices     Pointer to the indices, or NULL to take the vertices in order
+    /// \param indexCount  Number of indices in the array
+    /// \param indexSize   Size of an index, in bytes (2 or 4)
+    ///
+    ////////////////////////////////////////////////////////////
+    void batchPrimitives(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states,
+                         const void* indices = NULL, std::size_t indexCount = 0, std::size_t indexSize = 2);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw several instances of primitives with hardware instancing
+    ///
+    /// The per-instance data is uploaded to the uniform array
+    /// found at \a location in the shader of \a states, and the
+    /// instances are drawn in groups of at most \a maxInstances.
+    ///
+    /// \param vertices      Pointer to the vertices shared by all the instances
+    /// \param vertexCount   Number of vertices in the array
+    /// \param type          Type of primitives to draw
+    /// \param instanceData  Pointer to the per-instance data
+    /// \param instanceCount Number of instances to draw
+    /// \param stride        Number of floats of each instance, must be a multiple of 4
+    /// \param maxInstances  Maximum number of instances per draw call
+    /// \param location      Location of the per-instance uniform array
+    /// \param states        Render states to use for drawing, must contain a shader
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawInstances(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+                       const float* instanceData, std::size_t instanceCount, std::size_t stride,
+                       std::size_t maxInstances, int location, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable point sprites sized by the shader
+    ///
+    /// While enabled, the points drawn with a shader are squares
+    /// whose size is set by the vertex shader (gl_PointSize), and
+    /// gl_PointCoord gives the position inside the square to the
+    /// fragment shader. The pending batch is flushed first, so
+    /// that the state only applies to the draws issued while it
+    /// is enabled.
+    ///
+    /// \param enabled True to enable point sprites, false to disable them
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPointSpritesEnabled(bool enabled);
+
     ////////////////////////////////////////////////////////////
     /// \brief Apply the current view
     ///
@@ -360,9 +925,47 @@ private:
     /// \brief Apply a new transform
     ///
     /// \param transform Transform to apply
+    /// \param depth     Depth of the primitives, put in the Z translation of the matrix
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyTransform(const Transform& transform, float depth);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the depth test of the target
     ///
     ////////////////////////////////////////////////////////////
-    void applyTransform(const Transform& transform);
+    void applyDepthTest();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply a new scissor rectangle
+    ///
+    /// \param rect Scissor rectangle in OpenGL coordinates (bottom-left origin), empty to disable the scissor test
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyScissor(const IntRect& rect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply a new stencil mode
+    ///
+    /// \param mode Stencil mode to apply
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyStencilMode(const StencilMode& mode);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind the sampler object of a sampler mode, if it's not bound yet
+    ///
+    /// \param texture Texture of the draw (can be NULL)
+    /// \param mode    Sampler mode of the draw
+    ///
+    ////////////////////////////////////////////////////////////
+    void applySamplerMode(const Texture* texture, const SamplerMode& mode);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Disable the clipping of the last draw before clearing the target
+    ///
+    ////////////////////////////////////////////////////////////
+    void disableClipping();
 
     ////////////////////////////////////////////////////////////
     /// \brief Apply a new texture
@@ -380,6 +983,38 @@ private:
     ////////////////////////////////////////////////////////////
     void applyShader(const Shader* shader);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Setup environment for drawing
+    ///
+    /// \param useVertexCache Are we going to use the vertex cache?
+    /// \param states         Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void setupDraw(bool useVertexCache, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the primitives from the currently set vertex pointers
+    ///
+    /// \param type          Type of primitives to draw
+    /// \param firstVertex   Index of the first vertex to use when drawing
+    /// \param vertexCount   Number of vertices to use when drawing
+    /// \param instanceCount Number of instances to draw, other values than 1 require hardware instancing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawArrays(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount, std::size_t instanceCount = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw indexed primitives from the currently set vertex pointers
+    ///
+    /// \param type       Type of primitives to draw
+    /// \param indices    Pointer to the indices
+    /// \param indexCount Number of indices to draw
+    /// \param indexSize  Size of an index, in bytes (2 or 4)
+    /// \param baseVertex Number added to each index (core profiles only)
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawElements(PrimitiveType type, const void* indices, std::size_t indexCount, std::size_t indexSize, std::size_t baseVertex);
+
     ////////////////////////////////////////////////////////////
     /// \brief Activate the target for rendering
     ///
@@ -394,6 +1029,54 @@ private:
     ////////////////////////////////////////////////////////////
     virtual bool activate(bool active) = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Record primitives instead of drawing them
+    ///
+    /// This function is called instead of drawing when the target
+    /// is in recording mode (see CommandBuffer); the default
+    /// implementation does nothing.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void record(const Vertex* vertices, std::size_t vertexCount,
+                        PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a vertex buffer draw instead of executing it
+    ///
+    /// This function is called instead of drawing when the target
+    /// is in recording mode (see CommandBuffer); the default
+    /// implementation does nothing.
+    ///
+    /// \param vertexBuffer Vertex buffer to draw
+    /// \param firstVertex  Index of the first vertex to draw
+    /// \param vertexCount  Number of vertices to draw
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void record(const VertexBuffer& vertexBuffer, std::size_t firstVertex,
+                        std::size_t vertexCount, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record layered primitives instead of drawing them
+    ///
+    /// This function is called instead of drawing when the target
+    /// is in recording mode (see CommandBuffer); the default
+    /// implementation does nothing.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void record(const LayeredVertex* vertices, std::size_t vertexCount,
+                        PrimitiveType type, const RenderStates& states);
+
     ////////////////////////////////////////////////////////////
     /// \brief Render states cache
     ///
@@ -401,21 +1084,43 @@ private:
     struct StatesCache
     {
         enum {VertexCacheSize = 4};
+        enum {BatchVertexThreshold = 1024};
 
-        bool      glStatesSet;    ///< Are our internal GL states set yet?
-        bool      viewChanged;    ///< Has the current view changed since last draw?
-        BlendMode lastBlendMode;  ///< Cached blending mode
-        Uint64    lastTextureId;  ///< Cached texture
-        bool      useVertexCache; ///< Did we previously use the vertex cache?
-        Vertex    vertexCache[VertexCacheSize]; ///< Pre-transformed vertices cache
+        bool                glStatesSet;    ///< Are our internal GL states set yet?
+        bool                viewChanged;    ///< Has the current view changed since last draw?
+        BlendMode           lastBlendMode;  ///< Cached blending mode
+        Uint64              lastTextureId;  ///< Cached texture
+        bool                useVertexCache; ///< Did we previously use the vertex cache?
+        Vertex              vertexCache[VertexCacheSize]; ///< Pre-transformed vertices cache
+        bool                batchingEnabled; ///< Are draw calls merged into a batch?
+        PrimitiveType       batchType;      ///< Primitive type of the pending batch
+        RenderStates        batchStates;    ///< Render states of the pending batch (transform is always identity)
+        Uint64              batchTextureId; ///< Texture identifier of the pending batch
+        std::vector<Vertex> batchVertices;  ///< Pre-transformed vertices waiting to be drawn
+        std::vector<Uint16> batchIndices;   ///< Indices that assemble the pending vertices into list primitives
+        bool                cullingEnabled; ///< Are the primitives outside the view skipped?
+        bool                recording;      ///< Are the draw calls recorded instead of executed?
+        FloatRect           viewBounds;     ///< Area of the world shown by the current view
+        bool                coreProfile;    ///< Is the target drawn by the core-profile renderer?
+        Uint64              lastShaderId;   ///< Cached shader, left bound by the previous draw (0 if none)
+        float               lastDepth;      ///< Depth of the last applied transform
+        DepthTest           depthTest;      ///< Depth test of the next draws
+        IntRect             lastScissor;    ///< Cached scissor rectangle, in OpenGL coordinates (empty if disabled)
+        StencilMode         lastStencilMode; ///< Cached stencil mode
+        unsigned int        lastSampler;    ///< Sampler object bound to the first texture unit (0 if none)
+        Uint32              contextGeneration; ///< Generation of the contexts the states were set in (see Context::getGeneration)
     };
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    View        m_defaultView; ///< Default view
-    View        m_view;        ///< Current view
-    StatesCache m_cache;       ///< Render states cache
+    View                m_defaultView;  ///< Default view
+    View                m_view;         ///< Current view
+    StatesCache         m_cache;        ///< Render states cache
+    Statistics          m_statistics;   ///< Counters of the frame being drawn
+    Statistics          m_frameStatistics; ///< Counters of the last displayed frame
+    priv::CoreRenderer* m_coreRenderer; ///< Renderer used in core-profile contexts, created on first use
+    priv::SamplerCache* m_samplerCache; ///< Sampler objects of the sampler modes, created on first use
 };
 
 } // namespace sf
@@ -446,6 +1151,15 @@ private:
 /// OpenGL states are not messed up by calling the
 /// pushGLStates/popGLStates functions.
 ///
+/// When the target's context uses a core profile (see
+/// sf::ContextSettings::Core), the fixed-function pipeline is
+/// not available: the vertices are streamed to a vertex buffer
+/// and drawn by built-in shaders, which read the position,
+/// color and texture coordinates from the attribute locations
+/// 0, 1 and 2. pushGLStates and popGLStates have no state stack
+/// to save in this case, they only reset the states and
+/// release SFML's bindings.
+///
 /// \see sf::RenderWindow, sf::RenderTexture, sf::View
 ///
 ////////////////////////////////////////////////////////////
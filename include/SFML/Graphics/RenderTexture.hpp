@@ -31,6 +31,8 @@
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Window/ContextSettings.hpp>
+#include <vector>
 
 
 namespace sf
@@ -38,6 +40,7 @@ namespace sf
 namespace priv
 {
     class RenderTextureImpl;
+    struct FrameBufferContext;
 }
 
 ////////////////////////////////////////////////////////////
@@ -85,6 +88,73 @@ public:
     ////////////////////////////////////////////////////////////
     bool create(unsigned int width, unsigned int height, bool depthBuffer = false);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the render-texture with multisampling or several color targets
+    ///
+    /// The depth bits, stencil bits and antialiasing level of
+    /// \a settings are used, the other attributes are ignored.
+    /// When the antialiasing level is not 0, the render-texture
+    /// draws into multisampled buffers which are resolved into
+    /// the texture by display().
+    ///
+    /// With more than one color target, every draw writes to all
+    /// the textures at once; a fragment shader can write different
+    /// values to each of them with gl_FragData[i], so that effects
+    /// which need several outputs (deferred lighting for example)
+    /// are rendered in a single pass.
+    ///
+    /// \param width            Width of the render-texture
+    /// \param height           Height of the render-texture
+    /// \param settings         Depth, stencil and antialiasing settings of the render-texture
+    /// \param colorTargetCount Number of textures to render to
+    ///
+    /// \return True if creation has been successful
+    ///
+    /// \see getMaximumAntialiasingLevel, getMaximumColorTargetCount
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, const ContextSettings& settings, unsigned int colorTargetCount = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the render-texture with a given pixel format
+    ///
+    /// This function works like the previous one, the textures
+    /// being stored in \a format instead of RGBA8: RGBA16F
+    /// render-textures keep HDR colors, for example before a tone
+    /// mapping pass. The graphics driver must support rendering
+    /// to the format; R8 and RG8 are only renderable in core
+    /// profile contexts (luminance formats are not renderable).
+    ///
+    /// \param width            Width of the render-texture
+    /// \param height           Height of the render-texture
+    /// \param settings         Depth, stencil and antialiasing settings of the render-texture
+    /// \param format           Format of the pixels of the textures
+    /// \param colorTargetCount Number of textures to render to
+    ///
+    /// \return True if creation has been successful
+    ///
+    /// \see Texture::isFormatSupported
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, const ContextSettings& settings, PixelFormat::Type format,
+                unsigned int colorTargetCount = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum antialiasing level supported by render-textures
+    ///
+    /// \return The maximum antialiasing level, 0 if multisampled render-textures are not supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getMaximumAntialiasingLevel();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of color targets of a render-texture
+    ///
+    /// \return The maximum number of textures that a render-texture can draw to at once
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getMaximumColorTargetCount();
+
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable texture smoothing
     ///
@@ -186,8 +256,54 @@ public:
     ////////////////////////////////////////////////////////////
     const Texture& getTexture() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a read-only reference to one of the target textures
+    ///
+    /// Index 0 is the texture returned by getTexture(), the other
+    /// ones exist if the render-texture was created with several
+    /// color targets. An index out of range returns the first texture.
+    ///
+    /// \param index Index of the color target
+    ///
+    /// \return Const reference to the texture
+    ///
+    /// \see getColorTargetCount
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture(unsigned int index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of textures that the render-texture draws to
+    ///
+    /// \return Number of color targets
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getColorTargetCount() const;
+
 private:
 
+    friend class RenderTexturePool;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the render-texture, drawing in a context
+    ///        shared with other render-textures
+    ///
+    /// The context is only used when frame buffer objects are
+    /// available; it must outlive the render-texture.
+    ///
+    /// \param width            Width of the render-texture
+    /// \param height           Height of the render-texture
+    /// \param settings         Additional settings for the underlying OpenGL texture and context
+    /// \param format           Format of the pixels of the textures
+    /// \param colorTargetCount Number of textures to render to
+    /// \param sharedContext    Context to draw in, or NULL to create one
+    ///
+    /// \return True if creation has been successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, const ContextSettings& settings, PixelFormat::Type format,
+                unsigned int colorTargetCount, priv::FrameBufferContext* sharedContext);
+
     ////////////////////////////////////////////////////////////
     /// \brief Activate the target for rendering
     ///
@@ -204,8 +320,9 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    priv::RenderTextureImpl* m_impl;    ///< Platform/hardware specific implementation
-    Texture                  m_texture; ///< Target texture to draw on
+    priv::RenderTextureImpl* m_impl;         ///< Platform/hardware specific implementation
+    Texture                  m_texture;      ///< Target texture to draw on
+    std::vector<Texture*>    m_colorTargets; ///< Additional target textures, when drawing to several color targets
 };
 
 } // namespace sf
@@ -275,6 +392,16 @@ private:
 /// and regular SFML drawing commands. If you need a depth buffer for
 /// 3D rendering, don't forget to request it when calling RenderTexture::create.
 ///
+/// Antialiased rendering doesn't require drawing at a higher
+/// resolution and downscaling: create the render-texture with an
+/// antialiasing level instead, and it will be resolved into the
+/// texture by display().
+///
+/// \code
+/// sf::RenderTexture texture;
+/// texture.create(500, 500, sf::ContextSettings(0, 0, 4));
+/// \endcode
+///
 /// \see sf::RenderTarget, sf::RenderWindow, sf::View, sf::Texture
 ///
 ////////////////////////////////////////////////////////////
@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_RENDERTEXTUREPOOL_HPP
+#define SFML_RENDERTEXTUREPOOL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+    struct FrameBufferContext;
+}
+
+class RenderTexture;
+
+////////////////////////////////////////////////////////////
+/// \brief Reuses render textures of the same size
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API RenderTexturePool : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderTexturePool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// All the render textures of the pool are destroyed, even
+    /// the ones that were not released.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~RenderTexturePool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a render texture for exclusive use
+    ///
+    /// A released render texture of the same size is reused if
+    /// there's one, otherwise a new one is created. The view of
+    /// the render texture is reset to its default view; its
+    /// smooth and repeated settings and its pixels are left as
+    /// the previous user left them.
+    ///
+    /// \param width       Width of the render texture
+    /// \param height      Height of the render texture
+    /// \param depthBuffer Does the render texture need a depth buffer?
+    ///
+    /// \return Render texture, or NULL if it couldn't be created
+    ///
+    /// \see release
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderTexture* acquire(unsigned int width, unsigned int height, bool depthBuffer = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give a render texture back to the pool
+    ///
+    /// The render texture must not be used anymore, until it is
+    /// acquired again. Releasing NULL does nothing.
+    ///
+    /// \param texture Render texture returned by acquire()
+    ///
+    ////////////////////////////////////////////////////////////
+    void release(RenderTexture* texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the render textures that are not in use
+    ///
+    ////////////////////////////////////////////////////////////
+    void purge();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of render textures in the pool
+    ///
+    /// \return Number of render textures, in use or not
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getTextureCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render texture of the pool
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Slot
+    {
+        RenderTexture* texture;     ///< Render texture owned by the pool
+        Vector2u       size;        ///< Size of the render texture
+        bool           depthBuffer; ///< Does the render texture have a depth buffer?
+        bool           used;        ///< Is the render texture acquired?
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Slot>         m_slots;   ///< Render textures of the pool
+    priv::FrameBufferContext* m_context; ///< Context in which all the render textures draw, created with the first one
+};
+
+} // namespace sf
+
+
+#endif // SFML_RENDERTEXTUREPOOL_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::RenderTexturePool
+/// \ingroup graphics
+///
+/// Creating a sf::RenderTexture is slow: it allocates a
+/// texture, a frame buffer, optionally a depth buffer, and
+/// an OpenGL context. Effects which need temporary targets
+/// every frame should take them from a sf::RenderTexturePool,
+/// which keeps the released render textures and gives them
+/// back when the same size is requested again.
+///
+/// All the render textures of a pool draw in the same OpenGL
+/// context (when frame buffer objects are supported), so going
+/// from one to another only binds a different frame buffer,
+/// instead of switching contexts.
+///
+/// Usage example:
+/// \code
+/// sf::RenderTexturePool pool;
+///
+/// // Every frame
+/// sf::RenderTexture* blurred = pool.acquire(800, 600);
+/// blurred->clear();
+/// blurred->draw(scene, &blurShader);
+/// blurred->display();
+/// window.draw(sf::Sprite(blurred->getTexture()));
+/// pool.release(blurred);
+/// \endcode
+///
+/// \see sf::RenderTexture, sf::PostProcessChain
+///
+////////////////////////////////////////////////////////////
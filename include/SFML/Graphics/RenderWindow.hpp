@@ -112,6 +112,16 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Vector2u getSize() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Display on screen what has been rendered to the window so far
+    ///
+    /// This function draws the primitives that are still pending
+    /// in the batch (see RenderTarget::setBatchingEnabled), and
+    /// then calls Window::display.
+    ///
+    ////////////////////////////////////////////////////////////
+    void display();
+
     ////////////////////////////////////////////////////////////
     /// \brief Copy the current contents of the window to an image
     ///
@@ -0,0 +1,168 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SAMPLERMODE_HPP
+#define SFML_SAMPLERMODE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+
+
+namespace sf
+{
+
+////////////////////////////////////////////////////////////
+/// \brief Filtering and wrapping of the texture for drawing
+///
+////////////////////////////////////////////////////////////
+struct SFML_GRAPHICS_API SamplerMode
+{
+    ////////////////////////////////////////////////////////
+    /// \brief Enumeration of the texture filters
+    ///
+    ////////////////////////////////////////////////////////
+    enum Filter
+    {
+        TextureFilter, ///< Use the filter of the texture (see sf::Texture::setSmooth)
+        Nearest,       ///< Pixelated, like a texture that is not smooth
+        Linear         ///< Smoothed, like a smooth texture
+    };
+
+    ////////////////////////////////////////////////////////
+    /// \brief Enumeration of the wrap modes
+    ///
+    ////////////////////////////////////////////////////////
+    enum Wrap
+    {
+        TextureWrap, ///< Use the wrap mode of the texture (see sf::Texture::setRepeated)
+        Clamp,       ///< Coordinates outside the texture are clamped to its edges
+        Repeat       ///< The texture is repeated, like a repeated texture
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Constructs a sampler mode that uses the filter and
+    /// the wrap mode of the texture.
+    ///
+    ////////////////////////////////////////////////////////////
+    SamplerMode();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the sampler mode given the filter and wrap mode
+    ///
+    /// \param theFilter Filter to use
+    /// \param theWrap   Wrap mode to use
+    ///
+    ////////////////////////////////////////////////////////////
+    SamplerMode(Filter theFilter, Wrap theWrap = TextureWrap);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the system supports sampler modes
+    ///
+    /// Sampler modes require OpenGL 3.3 or the
+    /// GL_ARB_sampler_objects extension. When they are not
+    /// available, the textures are drawn with their own
+    /// filter and wrap mode, whatever the sampler mode.
+    ///
+    /// \return True if sampler modes are supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+    ////////////////////////////////////////////////////////////
+    // Member Data
+    ////////////////////////////////////////////////////////////
+    Filter filter; ///< How the texels are filtered
+    Wrap   wrap;   ///< How the coordinates outside the texture are handled
+};
+
+////////////////////////////////////////////////////////////
+/// \relates SamplerMode
+/// \brief Overload of the == operator
+///
+/// \param left  Left operand
+/// \param right Right operand
+///
+/// \return True if sampler modes are equal, false if they are different
+///
+////////////////////////////////////////////////////////////
+SFML_GRAPHICS_API bool operator ==(const SamplerMode& left, const SamplerMode& right);
+
+////////////////////////////////////////////////////////////
+/// \relates SamplerMode
+/// \brief Overload of the != operator
+///
+/// \param left  Left operand
+/// \param right Right operand
+///
+/// \return True if sampler modes are different, false if they are equal
+///
+////////////////////////////////////////////////////////////
+SFML_GRAPHICS_API bool operator !=(const SamplerMode& left, const SamplerMode& right);
+
+} // namespace sf
+
+
+#endif // SFML_SAMPLERMODE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SamplerMode
+/// \ingroup graphics
+///
+/// sf::SamplerMode overrides the filter and the wrap mode of
+/// the texture for a single draw, without changing the
+/// texture itself. The same texture can then be drawn
+/// pixelated in a view and smoothed in another one, in the
+/// same frame, without switching its parameters between the
+/// draws or keeping two copies of it.
+///
+/// \code
+/// // The world is drawn pixelated...
+/// window.draw(world, sf::RenderStates(sf::SamplerMode(sf::SamplerMode::Nearest)));
+///
+/// // ... and the minimap, with the same textures, smoothed
+/// sf::RenderStates minimap;
+/// minimap.transform.scale(0.1f, 0.1f);
+/// minimap.samplerMode = sf::SamplerMode(sf::SamplerMode::Linear);
+/// window.draw(world, minimap);
+/// \endcode
+///
+/// The sampler mode only applies to the texture of the
+/// render states; the textures that a shader samples from
+/// other units keep their own parameters. A texture with
+/// mipmaps still uses them when it is smoothed by a sampler
+/// mode.
+///
+/// The sampler object stays bound after the draw, until the
+/// next draw without sampler mode: OpenGL code that samples
+/// textures between SFML draws should be wrapped with
+/// sf::GLStateScope or RenderTarget::pushGLStates.
+///
+/// \see sf::RenderStates, sf::Texture
+///
+////////////////////////////////////////////////////////////
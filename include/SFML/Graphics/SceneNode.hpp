@@ -0,0 +1,312 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SCENENODE_HPP
+#define SFML_SCENENODE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Node of a hierarchy of transformable objects,
+///        which caches its world transform and bounds
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SceneNode : public Drawable, public Transformable, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates a node without parent nor children.
+    ///
+    ////////////////////////////////////////////////////////////
+    SceneNode();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The node is detached from its parent, and its children
+    /// are detached from it.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~SceneNode();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a child to the node
+    ///
+    /// The node doesn't own its children, it only keeps a
+    /// reference to them: they must stay alive while they are
+    /// attached, or detach themselves by being destroyed.
+    /// If \a child already has a parent, it is detached from it
+    /// first. The children are drawn after their parent, in
+    /// the order in which they were attached.
+    ///
+    /// \param child Node to attach
+    ///
+    /// \see detachChild
+    ///
+    ////////////////////////////////////////////////////////////
+    void attachChild(SceneNode& child);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a child from the node
+    ///
+    /// This function does nothing if \a child is not a child
+    /// of this node.
+    ///
+    /// \param child Node to detach
+    ///
+    /// \see attachChild
+    ///
+    ////////////////////////////////////////////////////////////
+    void detachChild(SceneNode& child);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the parent of the node
+    ///
+    /// \return Parent of the node, or NULL if it is a root
+    ///
+    ////////////////////////////////////////////////////////////
+    SceneNode* getParent() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of children of the node
+    ///
+    /// \return Number of children
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getChildCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a child of the node
+    ///
+    /// This function doesn't check \a index, it must be in range
+    /// [0, getChildCount() - 1]. The behavior is undefined
+    /// otherwise.
+    ///
+    /// \param index Index of the child
+    ///
+    /// \return Reference to the child
+    ///
+    ////////////////////////////////////////////////////////////
+    SceneNode& getChild(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the transform of the node relative to its root
+    ///
+    /// The world transform combines the transforms of all the
+    /// ancestors of the node with its own transform. It is
+    /// cached, and only recomputed when the transform of the
+    /// node or of one of its ancestors changed.
+    ///
+    /// \return World transform of the node
+    ///
+    ////////////////////////////////////////////////////////////
+    const Transform& getWorldTransform() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounds of the node and its descendants
+    ///
+    /// The returned rectangle is in the coordinate system of
+    /// the root, and contains the local bounds of the node and
+    /// of all its descendants (see getLocalBounds). It is
+    /// cached, and only recomputed when something in the
+    /// subtree changed.
+    ///
+    /// \return World-space bounding rectangle of the subtree
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getWorldBounds() const;
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounds of what the node draws itself
+    ///
+    /// The rectangle is in the local coordinate system of the
+    /// node, i.e. before its transform is applied. Derived
+    /// classes that draw something must override this function,
+    /// and call invalidateBounds when its result changes.
+    /// The default implementation returns an empty rectangle.
+    ///
+    /// \return Local bounding rectangle of the node's own drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the node itself, without its children
+    ///
+    /// The transform of \a states already contains the world
+    /// transform of the node. The default implementation draws
+    /// nothing, which is useful for nodes that only group
+    /// their children.
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void drawSelf(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell the node that its local bounds changed
+    ///
+    /// The cached world bounds of the node and of its ancestors
+    /// are recomputed the next time they are needed.
+    ///
+    /// \see getLocalBounds
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateBounds();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the node and its children
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the subtree, with the world transforms
+    ///
+    /// \param target Render target to draw to
+    /// \param states Render states given to the root draw call
+    /// \param base   Transform of the root draw call, or NULL if it is the identity
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawSubtree(RenderTarget& target, const RenderStates& states, const Transform* base) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Invalidate the world transforms of the subtree
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onTransformChanged();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark the world transforms and bounds of the subtree as outdated
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateWorldTransform();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    SceneNode*              m_parent;                   ///< Parent of the node, NULL for a root
+    std::vector<SceneNode*> m_children;                 ///< Children of the node, in drawing order
+    mutable Transform       m_worldTransform;           ///< Cached world transform
+    mutable bool            m_worldTransformNeedUpdate; ///< Does the world transform need to be recomputed?
+    mutable FloatRect       m_worldBounds;              ///< Cached world bounds of the subtree
+    mutable bool            m_worldBoundsNeedUpdate;    ///< Do the world bounds need to be recomputed?
+};
+
+} // namespace sf
+
+
+#endif // SFML_SCENENODE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SceneNode
+/// \ingroup graphics
+///
+/// sf::SceneNode organizes transformable objects in a tree:
+/// each node is positioned, rotated and scaled relative to its
+/// parent, and drawing a node draws its whole subtree.
+///
+/// Passing the transform down the draw calls, as in
+/// \code
+/// states.transform *= getTransform();
+/// \endcode
+/// combines the matrices of every node on every frame, even
+/// when nothing moved. sf::SceneNode instead caches the world
+/// transform of each node, and only recomputes it when the node
+/// or one of its ancestors is moved: static parts of a scene
+/// don't cost any matrix product.
+///
+/// Each node also caches the bounds of its subtree. When culling
+/// is enabled on the render target (see
+/// sf::RenderTarget::setCullingEnabled), the subtrees that are
+/// outside the view are skipped with a single rectangle test,
+/// without visiting their nodes. The visible nodes are drawn in
+/// order, so consecutive nodes sharing a texture are merged by
+/// the batching of the render target.
+///
+/// A node that draws something derives from sf::SceneNode and
+/// overrides drawSelf and getLocalBounds:
+/// \code
+/// class SpriteNode : public sf::SceneNode
+/// {
+/// public:
+///
+///     void setTexture(const sf::Texture& texture)
+///     {
+///         m_sprite.setTexture(texture, true);
+///         invalidateBounds();
+///     }
+///
+/// private:
+///
+///     virtual sf::FloatRect getLocalBounds() const
+///     {
+///         return m_sprite.getGlobalBounds();
+///     }
+///
+///     virtual void drawSelf(sf::RenderTarget& target, sf::RenderStates states) const
+///     {
+///         target.draw(m_sprite, states);
+///     }
+///
+///     sf::Sprite m_sprite;
+/// };
+///
+/// sf::SceneNode world;
+/// SpriteNode ship, turret;
+/// world.attachChild(ship);
+/// ship.attachChild(turret);
+/// turret.setPosition(10, 0);
+///
+/// ship.move(1, 0);    // the turret follows the ship
+/// turret.rotate(5);   // the ship doesn't move
+/// window.draw(world);
+/// \endcode
+///
+/// \see sf::Transformable, sf::RenderTarget::setCullingEnabled
+///
+////////////////////////////////////////////////////////////
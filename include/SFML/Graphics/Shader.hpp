@@ -37,12 +37,19 @@
 #include <SFML/System/Vector3.hpp>
 #include <map>
 #include <string>
+#include <vector>
 
 
 namespace sf
 {
 class InputStream;
 class Texture;
+class TextureArray;
+
+namespace priv
+{
+    class ShaderCompiler;
+}
 
 ////////////////////////////////////////////////////////////
 /// \brief Shader class (vertex and fragment)
@@ -58,8 +65,23 @@ public:
     ////////////////////////////////////////////////////////////
     enum Type
     {
-        Vertex,  ///< Vertex shader
-        Fragment ///< Fragment (pixel) shader
+        Vertex,   ///< Vertex shader
+        Geometry, ///< Geometry shader
+        Fragment, ///< Fragment (pixel) shader
+        Compute   ///< Compute shader
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Ways a shader can access an image
+    ///
+    /// \see setImage
+    ///
+    ////////////////////////////////////////////////////////////
+    enum ImageAccess
+    {
+        ReadOnly,  ///< The shader only loads pixels from the image
+        WriteOnly, ///< The shader only stores pixels to the image
+        ReadWrite  ///< The shader both loads and stores pixels
     };
 
     ////////////////////////////////////////////////////////////
@@ -79,6 +101,14 @@ public:
     ////////////////////////////////////////////////////////////
     static CurrentTextureType CurrentTexture;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Handle to a variable of the shader
+    ///
+    /// \see getUniform
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef int UniformHandle;
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -96,18 +126,20 @@ public:
     ~Shader();
 
     ////////////////////////////////////////////////////////////
-    /// \brief Load either the vertex or fragment shader from a file
+    /// \brief Load either the vertex, geometry, fragment or compute shader from a file
     ///
-    /// This function loads a single shader, either vertex or
-    /// fragment, identified by the second argument.
+    /// This function loads a single shader, either vertex,
+    /// geometry, fragment or compute, identified by the second
+    /// argument. A compute shader can only be loaded alone,
+    /// and is run with dispatch().
     /// The source must be a text file containing a valid
     /// shader in GLSL language. GLSL is a C-like language
     /// dedicated to OpenGL shaders; you'll probably need to
     /// read a good documentation for it before writing your
     /// own shaders.
     ///
-    /// \param filename Path of the vertex or fragment shader file to load
-    /// \param type     Type of shader (vertex or fragment)
+    /// \param filename Path of the shader file to load
+    /// \param type     Type of shader
     ///
     /// \return True if loading succeeded, false if it failed
     ///
@@ -138,17 +170,38 @@ public:
     bool loadFromFile(const std::string& vertexShaderFilename, const std::string& fragmentShaderFilename);
 
     ////////////////////////////////////////////////////////////
-    /// \brief Load either the vertex or fragment shader from a source code in memory
+    /// \brief Load the vertex, geometry and fragment shaders from files
+    ///
+    /// This function loads the vertex, geometry and fragment
+    /// shaders. If one of them fails to load, the shader is left
+    /// empty (the valid shaders are unloaded).
+    /// Geometry shaders require OpenGL 3.2 (see isGeometryAvailable).
+    ///
+    /// \param vertexShaderFilename   Path of the vertex shader file to load
+    /// \param geometryShaderFilename Path of the geometry shader file to load
+    /// \param fragmentShaderFilename Path of the fragment shader file to load
+    ///
+    /// \return True if loading succeeded, false if it failed
+    ///
+    /// \see loadFromMemory, loadFromStream
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromFile(const std::string& vertexShaderFilename, const std::string& geometryShaderFilename, const std::string& fragmentShaderFilename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load either the vertex, geometry, fragment or compute shader from a source code in memory
     ///
-    /// This function loads a single shader, either vertex or
-    /// fragment, identified by the second argument.
+    /// This function loads a single shader, either vertex,
+    /// geometry, fragment or compute, identified by the second
+    /// argument. A compute shader can only be loaded alone,
+    /// and is run with dispatch().
     /// The source code must be a valid shader in GLSL language.
     /// GLSL is a C-like language dedicated to OpenGL shaders;
     /// you'll probably need to read a good documentation for
     /// it before writing your own shaders.
     ///
     /// \param shader String containing the source code of the shader
-    /// \param type   Type of shader (vertex or fragment)
+    /// \param type   Type of shader
     ///
     /// \return True if loading succeeded, false if it failed
     ///
@@ -179,17 +232,38 @@ public:
     bool loadFromMemory(const std::string& vertexShader, const std::string& fragmentShader);
 
     ////////////////////////////////////////////////////////////
-    /// \brief Load either the vertex or fragment shader from a custom stream
+    /// \brief Load the vertex, geometry and fragment shaders from source codes in memory
+    ///
+    /// This function loads the vertex, geometry and fragment
+    /// shaders. If one of them fails to load, the shader is left
+    /// empty (the valid shaders are unloaded).
+    /// Geometry shaders require OpenGL 3.2 (see isGeometryAvailable).
+    ///
+    /// \param vertexShader   String containing the source code of the vertex shader
+    /// \param geometryShader String containing the source code of the geometry shader
+    /// \param fragmentShader String containing the source code of the fragment shader
+    ///
+    /// \return True if loading succeeded, false if it failed
+    ///
+    /// \see loadFromFile, loadFromStream
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromMemory(const std::string& vertexShader, const std::string& geometryShader, const std::string& fragmentShader);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load either the vertex, geometry, fragment or compute shader from a custom stream
     ///
-    /// This function loads a single shader, either vertex or
-    /// fragment, identified by the second argument.
+    /// This function loads a single shader, either vertex,
+    /// geometry, fragment or compute, identified by the second
+    /// argument. A compute shader can only be loaded alone,
+    /// and is run with dispatch().
     /// The source code must be a valid shader in GLSL language.
     /// GLSL is a C-like language dedicated to OpenGL shaders;
     /// you'll probably need to read a good documentation for it
     /// before writing your own shaders.
     ///
     /// \param stream Source stream to read from
-    /// \param type   Type of shader (vertex or fragment)
+    /// \param type   Type of shader
     ///
     /// \return True if loading succeeded, false if it failed
     ///
@@ -219,6 +293,79 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromStream(InputStream& vertexShaderStream, InputStream& fragmentShaderStream);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the vertex, geometry and fragment shaders from custom streams
+    ///
+    /// This function loads the vertex, geometry and fragment
+    /// shaders. If one of them fails to load, the shader is left
+    /// empty (the valid shaders are unloaded).
+    /// Geometry shaders require OpenGL 3.2 (see isGeometryAvailable).
+    ///
+    /// \param vertexShaderStream   Source stream to read the vertex shader from
+    /// \param geometryShaderStream Source stream to read the geometry shader from
+    /// \param fragmentShaderStream Source stream to read the fragment shader from
+    ///
+    /// \return True if loading succeeded, false if it failed
+    ///
+    /// \see loadFromFile, loadFromMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromStream(InputStream& vertexShaderStream, InputStream& geometryShaderStream, InputStream& fragmentShaderStream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading both the vertex and fragment shaders from files in the background
+    ///
+    /// This function reads the files and returns immediately,
+    /// the program is compiled and linked in the background
+    /// (by the driver's threads if it supports
+    /// GL_KHR_parallel_shader_compile, otherwise by a worker
+    /// thread in a shared context). Use isReady() to know when
+    /// the compilation is over. Until then, the parameters are
+    /// not stored and nothing is drawn with the shader.
+    ///
+    /// \param vertexShaderFilename   Path of the vertex shader file to load
+    /// \param fragmentShaderFilename Path of the fragment shader file to load
+    ///
+    /// \return True if the compilation started, false if the files couldn't be read or shaders are not supported
+    ///
+    /// \see loadFromMemoryAsync, isReady
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromFileAsync(const std::string& vertexShaderFilename, const std::string& fragmentShaderFilename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading both the vertex and fragment shaders from source codes in memory in the background
+    ///
+    /// This function returns immediately, the program is compiled
+    /// and linked in the background. See loadFromFileAsync for
+    /// the details.
+    ///
+    /// \param vertexShader   String containing the source code of the vertex shader
+    /// \param fragmentShader String containing the source code of the fragment shader
+    ///
+    /// \return True if the compilation started, false if shaders are not supported
+    ///
+    /// \see loadFromFileAsync, isReady
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromMemoryAsync(const std::string& vertexShader, const std::string& fragmentShader);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the background compilation is over
+    ///
+    /// This function never blocks. Once it returns true, the
+    /// program is used by the shader: getNativeHandle() returns
+    /// 0 if the compilation failed (the errors are written to
+    /// the standard error output). It always returns true for
+    /// shaders loaded with the synchronous functions.
+    ///
+    /// \return True if the compilation is over, false if it is still running
+    ///
+    /// \see loadFromFileAsync, loadFromMemoryAsync
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReady() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Change a float parameter of the shader
     ///
@@ -433,6 +580,33 @@ public:
     ////////////////////////////////////////////////////////////
     void setParameter(const std::string& name, const Texture& texture);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a texture array parameter of the shader
+    ///
+    /// \a name is the name of the variable to change in the shader.
+    /// The corresponding parameter in the shader must be a 2D
+    /// texture array (sampler2DArray GLSL type, which requires
+    /// the GL_EXT_texture_array extension).
+    ///
+    /// Example:
+    /// \code
+    /// #extension GL_EXT_texture_array : enable
+    /// uniform sampler2DArray the_layers; // this is the variable in the shader
+    /// \endcode
+    /// \code
+    /// sf::TextureArray layers;
+    /// ...
+    /// shader.setParameter("the_layers", layers);
+    /// \endcode
+    /// It is important to note that \a textureArray must remain alive
+    /// as long as the shader uses it, no copy is made internally.
+    ///
+    /// \param name         Name of the texture array in the shader
+    /// \param textureArray Texture array to assign
+    ///
+    ////////////////////////////////////////////////////////////
+    void setParameter(const std::string& name, const TextureArray& textureArray);
+
     ////////////////////////////////////////////////////////////
     /// \brief Change a texture parameter of the shader
     ///
@@ -456,6 +630,207 @@ public:
     ////////////////////////////////////////////////////////////
     void setParameter(const std::string& name, CurrentTextureType);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Change an image parameter of the shader
+    ///
+    /// \a name is the name of the variable to change in the shader.
+    /// The corresponding parameter in the shader must be an image
+    /// (image2D GLSL type), declared with the format of the texture
+    /// (rgba8, r8, rg8 or rgba16f; sf::PixelFormat::RGB565
+    /// textures can't be used as images). Unlike a sampler, an
+    /// image can be written by the shader. This requires the
+    /// support of compute shaders (see isComputeAvailable).
+    ///
+    /// Example:
+    /// \code
+    /// layout(rgba8) uniform writeonly image2D the_image; // this is the variable in the shader
+    /// \endcode
+    /// \code
+    /// sf::Texture texture;
+    /// ...
+    /// shader.setImage("the_image", texture, sf::Shader::WriteOnly);
+    /// \endcode
+    /// It is important to note that \a texture must remain alive as long
+    /// as the shader uses it, no copy is made internally. Only the
+    /// first mipmap level is accessed, call Texture::generateMipmap
+    /// again after the shader wrote to the texture if needed.
+    ///
+    /// \param name    Name of the image in the shader
+    /// \param texture Texture to assign
+    /// \param access  How the shader accesses the image
+    ///
+    /// \return True on success, false if the variable was not found,
+    ///         images are not supported or no image unit is left
+    ///
+    ////////////////////////////////////////////////////////////
+    bool setImage(const std::string& name, const Texture& texture, ImageAccess access = ReadWrite);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a handle to a float, vector, color or matrix variable
+    ///
+    /// Unlike setParameter, which looks the variable up by name
+    /// and makes the program current for every call, the values
+    /// assigned through a handle are only stored, and uploaded
+    /// all at once the next time the shader is bound (i.e. when
+    /// something is drawn with it). This is the most efficient
+    /// way to change variables that are updated every frame.
+    ///
+    /// Handles remain valid until the shader is loaded again.
+    ///
+    /// \param name Name of the variable in the shader
+    ///
+    /// \return Handle to the variable, or -1 if it was not found
+    ///
+    /// \see setUniform
+    ///
+    ////////////////////////////////////////////////////////////
+    UniformHandle getUniform(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a float variable through its handle
+    ///
+    /// The value is uploaded the next time the shader is bound.
+    /// Invalid handles are ignored.
+    ///
+    /// \param uniform Handle of the variable (see getUniform)
+    /// \param x       Value to assign
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle uniform, float x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a 2-components vector variable through its handle
+    ///
+    /// \param uniform Handle of the variable (see getUniform)
+    /// \param x       First component of the value to assign
+    /// \param y       Second component of the value to assign
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle uniform, float x, float y);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a 3-components vector variable through its handle
+    ///
+    /// \param uniform Handle of the variable (see getUniform)
+    /// \param x       First component of the value to assign
+    /// \param y       Second component of the value to assign
+    /// \param z       Third component of the value to assign
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle uniform, float x, float y, float z);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a 4-components vector variable through its handle
+    ///
+    /// \param uniform Handle of the variable (see getUniform)
+    /// \param x       First component of the value to assign
+    /// \param y       Second component of the value to assign
+    /// \param z       Third component of the value to assign
+    /// \param w       Fourth component of the value to assign
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle uniform, float x, float y, float z, float w);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a 2-components vector variable through its handle
+    ///
+    /// \param uniform Handle of the variable (see getUniform)
+    /// \param vector  Vector to assign
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle uniform, const Vector2f& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a 3-components vector variable through its handle
+    ///
+    /// \param uniform Handle of the variable (see getUniform)
+    /// \param vector  Vector to assign
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle uniform, const Vector3f& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a color variable through its handle
+    ///
+    /// The color is normalized like in setParameter.
+    ///
+    /// \param uniform Handle of the variable (see getUniform)
+    /// \param color   Color to assign
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle uniform, const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a matrix variable through its handle
+    ///
+    /// \param uniform   Handle of the variable (see getUniform)
+    /// \param transform Transform to assign
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle uniform, const sf::Transform& transform);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Associate a uniform block of the shader to a binding point
+    ///
+    /// The variables of the block are then read from the
+    /// sf::UniformBuffer bound to the same point, which can be
+    /// shared by any number of shaders. The association is
+    /// kept until the shader is loaded again.
+    ///
+    /// \param name    Name of the uniform block in the shader
+    /// \param binding Index of the binding point (see UniformBuffer::bind)
+    ///
+    /// \return True on success, false if the block was not found or
+    ///         uniform buffers are not supported
+    ///
+    /// \see UniformBuffer
+    ///
+    ////////////////////////////////////////////////////////////
+    bool setUniformBlock(const std::string& name, unsigned int binding);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Associate a storage block of the shader to a binding point
+    ///
+    /// The variables of the block are then read from and written
+    /// to the sf::VertexBuffer bound to the same point (see
+    /// VertexBuffer::bindStorage), which is how a compute shader
+    /// can update vertices that are drawn afterwards without
+    /// going through the CPU. The association is kept until the
+    /// shader is loaded again. This requires the support of
+    /// compute shaders (see isComputeAvailable).
+    ///
+    /// \param name    Name of the storage block in the shader
+    /// \param binding Index of the binding point
+    ///
+    /// \return True on success, false if the block was not found or
+    ///         storage buffers are not supported
+    ///
+    /// \see VertexBuffer::bindStorage
+    ///
+    ////////////////////////////////////////////////////////////
+    bool setStorageBlock(const std::string& name, unsigned int binding);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run a compute shader
+    ///
+    /// The shader must have been loaded as a compute shader. The
+    /// number of invocations is the number of work groups times
+    /// the size of a group, declared in the shader with
+    /// layout(local_size_x = ..., ...). The values of the
+    /// variables, the textures and the images are bound as for
+    /// drawing.
+    ///
+    /// The function returns immediately, the driver makes sure
+    /// that everything used afterwards (draws, texture reads,
+    /// buffer reads) sees the results of the shader.
+    ///
+    /// \param groupsX Number of work groups in the X dimension
+    /// \param groupsY Number of work groups in the Y dimension
+    /// \param groupsZ Number of work groups in the Z dimension
+    ///
+    ////////////////////////////////////////////////////////////
+    void dispatch(unsigned int groupsX, unsigned int groupsY = 1, unsigned int groupsZ = 1) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the underlying OpenGL handle of the shader.
     ///
@@ -506,8 +881,59 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isAvailable();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports geometry shaders
+    ///
+    /// This function should always be called before using
+    /// the geometry shader features. If it returns false, then
+    /// any attempt to load a geometry shader will fail.
+    /// Geometry shaders require OpenGL 3.2.
+    ///
+    /// \return True if geometry shaders are supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isGeometryAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports compute shaders
+    ///
+    /// This function should always be called before using
+    /// the compute shader features (including images and storage
+    /// blocks). If it returns false, then any attempt to load
+    /// a compute shader will fail. Compute shaders require
+    /// OpenGL 4.3 or the equivalent extensions.
+    ///
+    /// \return True if compute shaders are supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isComputeAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable the on-disk cache of compiled programs
+    ///
+    /// When a directory is set, the binary of each program
+    /// linked by the driver is saved in it, and loaded back
+    /// instead of compiling the sources the next time the same
+    /// sources are loaded with the same driver (the cache files
+    /// are identified by a hash of the sources and of the GL
+    /// vendor, renderer and version strings). Binaries rejected
+    /// by the driver, for example after an update, are silently
+    /// replaced by a fresh compilation.
+    ///
+    /// The cache requires GL_ARB_get_program_binary (core since
+    /// OpenGL 4.1), it is ignored when it is not supported.
+    /// The directory must exist; it is empty by default, which
+    /// disables the cache.
+    ///
+    /// \param directory Directory where the binaries are stored, or an empty string to disable the cache
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setBinaryCacheDirectory(const std::string& directory);
+
 private:
 
+    friend class RenderTarget;
+
     ////////////////////////////////////////////////////////////
     /// \brief Compile the shader(s) and create the program
     ///
@@ -515,22 +941,68 @@ private:
     /// is not created.
     ///
     /// \param vertexShaderCode   Source code of the vertex shader
+    /// \param geometryShaderCode Source code of the geometry shader
     /// \param fragmentShaderCode Source code of the fragment shader
+    /// \param computeShaderCode  Source code of the compute shader
+    /// \param async              Compile in the background (see isReady)?
+    ///
+    /// \return True on success, false if any error happened
+    ///
+    ////////////////////////////////////////////////////////////
+    bool compile(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode,
+                 const char* computeShaderCode, bool async = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compile a program made of a single shader
+    ///
+    /// \param type       Type of the shader
+    /// \param shaderCode Source code of the shader
     ///
     /// \return True on success, false if any error happened
     ///
     ////////////////////////////////////////////////////////////
-    bool compile(const char* vertexShaderCode, const char* fragmentShaderCode);
+    bool compile(Type type, const char* shaderCode);
 
     ////////////////////////////////////////////////////////////
-    /// \brief Bind all the textures used by the shader
+    /// \brief Bind all the textures and images used by the shader
     ///
     /// This function each texture to a different unit, and
     /// updates the corresponding variables in the shader accordingly.
+    /// The variables are only assigned when the units changed
+    /// since the last call; the program must be current.
     ///
     ////////////////////////////////////////////////////////////
     void bindTextures() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the values assigned through uniform handles
+    ///
+    /// The program must be current.
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyUniforms() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rebuild the program if the OpenGL contexts were lost
+    ///
+    /// The program is built again from its source, and the
+    /// values assigned through uniform handles are uploaded
+    /// again at next bind.
+    ///
+    ////////////////////////////////////////////////////////////
+    void restore() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the uniform of a handle, and mark it for upload
+    ///
+    /// \param uniform Handle of the variable
+    /// \param size    Number of values to assign (1 to 4, 16 for a matrix)
+    ///
+    /// \return Values of the uniform, or NULL if the handle is invalid
+    ///
+    ////////////////////////////////////////////////////////////
+    float* setUniformSize(UniformHandle uniform, unsigned int size);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the location ID of a shader parameter
     ///
@@ -541,19 +1013,55 @@ private:
     ////////////////////////////////////////////////////////////
     int getParamLocation(const std::string& name);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Variable of the shader changed through a handle
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Uniform
+    {
+        int          location;   ///< Location of the variable in the program
+        unsigned int size;       ///< Number of values: 1 to 4 for floats and vectors, 16 for matrices
+        float        values[16]; ///< Values to upload
+        bool         dirty;      ///< Must the values be uploaded at next bind?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Texture accessed as an image by the shader
+    ///
+    ////////////////////////////////////////////////////////////
+    struct ImageUnit
+    {
+        const Texture* texture; ///< Texture bound to the unit
+        ImageAccess    access;  ///< How the shader accesses the texture
+    };
+
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
     typedef std::map<int, const Texture*> TextureTable;
+    typedef std::map<int, const TextureArray*> TextureArrayTable;
+    typedef std::map<int, ImageUnit> ImageTable;
     typedef std::map<std::string, int> ParamTable;
+    typedef std::vector<Uniform> UniformTable;
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    unsigned int m_shaderProgram;  ///< OpenGL identifier for the program
-    int          m_currentTexture; ///< Location of the current texture in the shader
-    TextureTable m_textures;       ///< Texture variables in the shader, mapped to their location
-    ParamTable   m_params;         ///< Parameters location cache
+    mutable unsigned int          m_shaderProgram;  ///< OpenGL identifier for the program
+    mutable Uint64                m_programSize;    ///< Size of the program reported to ResourceMemory
+    mutable Uint64                m_cacheId;        ///< Unique number that identifies the program (used by the render targets)
+    int                           m_currentTexture; ///< Location of the current texture in the shader
+    TextureTable                  m_textures;       ///< Texture variables in the shader, mapped to their location
+    TextureArrayTable             m_textureArrays;  ///< Texture array variables in the shader, mapped to their location
+    ImageTable                    m_images;         ///< Image variables in the shader, mapped to their location
+    ParamTable                    m_params;         ///< Parameters location cache
+    mutable UniformTable          m_uniforms;       ///< Variables changed through handles, indexed by handle
+    mutable bool                  m_uniformsDirty;  ///< Are there values to upload at next bind?
+    mutable bool                  m_samplersDirty;  ///< Must the texture and image units be assigned to the variables at next bind?
+    bool                          m_compute;        ///< Is the program a compute shader?
+    mutable priv::ShaderCompiler* m_compiler;       ///< Compilation running in the background, if any
+    std::vector<std::string>      m_sources;        ///< Source code of each stage (vertex, geometry, fragment, compute), to rebuild the program
+    mutable Uint32                m_generation;     ///< Generation of the OpenGL contexts which the program belongs to
 };
 
 } // namespace sf
@@ -570,13 +1078,38 @@ private:
 /// executed directly by the graphics card and allowing
 /// to apply real-time operations to the rendered entities.
 ///
-/// There are two kinds of shaders:
+/// There are four kinds of shaders:
 /// \li Vertex shaders, that process vertices
+/// \li Geometry shaders, that turn primitives into other primitives
 /// \li Fragment (pixel) shaders, that process pixels
+/// \li Compute shaders, that run arbitrary work outside of drawing
 ///
 /// A sf::Shader can be composed of either a vertex shader
-/// alone, a fragment shader alone, or both combined
-/// (see the variants of the load functions).
+/// alone, a fragment shader alone, or both combined, with an
+/// optional geometry shader between them (see the variants of
+/// the load functions). A geometry shader can for example
+/// expand each point of a particle system into a textured
+/// quad, so that the CPU only updates one vertex per particle.
+/// Geometry shaders require OpenGL 3.2 (see isGeometryAvailable).
+///
+/// A compute shader is always loaded alone, and is not used
+/// for drawing: it is run with dispatch(). It writes its
+/// results to textures bound as images (see setImage) or to
+/// vertex buffers bound as storage blocks (see setStorageBlock
+/// and VertexBuffer::bindStorage), which can then be drawn
+/// directly. Compute shaders require OpenGL 4.3 (see
+/// isComputeAvailable).
+/// \code
+/// sf::VertexBuffer particles(sf::Points, sf::VertexBuffer::Stream);
+/// particles.create(count);
+/// simulation.loadFromFile("simulate.comp", sf::Shader::Compute);
+/// simulation.setStorageBlock("Particles", 0);
+/// ...
+/// sf::VertexBuffer::bindStorage(&particles, 0);
+/// simulation.setUniform(delta, frameTime.asSeconds());
+/// simulation.dispatch((count + 63) / 64);
+/// window.draw(particles);
+/// \endcode
 ///
 /// Shaders are written in GLSL, which is a C-like
 /// language dedicated to OpenGL shaders. You'll probably
@@ -607,6 +1140,20 @@ private:
 /// given texture variable to the current texture of the
 /// object being drawn (which cannot be known in advance).
 ///
+/// Variables that change every frame are better changed
+/// through handles: the name is looked up only once, and
+/// the values are uploaded all at once when the shader is
+/// used for drawing.
+/// \code
+/// sf::Shader::UniformHandle time = shader.getUniform("time");
+/// ...
+/// shader.setUniform(time, clock.getElapsedTime().asSeconds());
+/// \endcode
+///
+/// Data shared by many shaders, such as the view-projection
+/// matrix, can be stored in a sf::UniformBuffer bound to a
+/// uniform block of each shader (see setUniformBlock).
+///
 /// To apply a shader to a drawable, you must pass it as an
 /// additional parameter to the Draw function:
 /// \code
@@ -647,6 +1194,16 @@ private:
 /// second one doesn't impact the rendering process and can be
 /// easily inserted anywhere without impacting all the code.
 ///
+/// Compiling many shaders can take a while; to avoid a freeze,
+/// they can be compiled in the background and used once they
+/// are ready:
+/// \code
+/// shader.loadFromFileAsync("vertex.vert", "fragment.frag");
+/// ...
+/// if (shader.isReady() && shader.getNativeHandle())
+///     shader.setParameter("offset", 2.f);
+/// \endcode
+///
 /// Like sf::Texture that can be used as a raw OpenGL texture,
 /// sf::Shader can also be used directly as a raw shader for
 /// custom OpenGL geometry.
@@ -33,6 +33,7 @@
 #include <SFML/Graphics/Transformable.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/System/Vector2.hpp>
+#include <vector>
 
 
 namespace sf
@@ -249,6 +250,22 @@ public:
 
 protected:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Geometry of a shape
+    ///
+    /// It contains everything that derives from the points, and
+    /// nothing that depends on the colors, the texture or the
+    /// outline thickness; it can thus be computed once and then
+    /// shared by all the shapes made of the same points.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Geometry
+    {
+        std::vector<Vector2f> points;  ///< Positions of the fill vertices: center, points and first point again
+        std::vector<Vector2f> normals; ///< Extrusion direction of the outline at each point
+        FloatRect             bounds;  ///< Bounding rectangle of the points
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -265,6 +282,43 @@ protected:
     ////////////////////////////////////////////////////////////
     void update();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Recompute the internal geometry of the shape from a precomputed one
+    ///
+    /// This function can be called instead of update() by derived
+    /// classes which keep the geometry of identical shapes
+    /// (see getGeometry); getPoint is not called.
+    ///
+    /// \param geometry Geometry of the shape's points
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const Geometry& geometry);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current geometry of the shape
+    ///
+    /// \param geometry Geometry to fill
+    ///
+    /// \see update(const Geometry&)
+    ///
+    ////////////////////////////////////////////////////////////
+    void getGeometry(Geometry& geometry) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recompute the internal geometry after a single point moved
+    ///
+    /// This function can be called by the derived class instead
+    /// of update() when only the point at \a index changed (the
+    /// point count being the same). Only the vertices affected
+    /// by the point are updated, unless the bounding rectangle
+    /// of the points changes too, in which case everything is
+    /// recomputed.
+    ///
+    /// \param index Index of the point that changed
+    ///
+    ////////////////////////////////////////////////////////////
+    void updatePoint(std::size_t index);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -288,12 +342,42 @@ private:
     ////////////////////////////////////////////////////////////
     void updateTexCoords();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the texture coordinates of a single fill vertex
+    ///
+    /// \param index Index of the vertex
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateTexCoords(std::size_t index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the bounds of the points and the center vertex
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateCenter();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the extrusion direction of the outline at a point
+    ///
+    /// \param index Index of the point
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateOutlineNormal(std::size_t index);
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the outline vertices' position
     ///
     ////////////////////////////////////////////////////////////
     void updateOutline();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the outline vertices' position at a single point
+    ///
+    /// \param index Index of the point
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateOutlinePoint(std::size_t index);
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the outline vertices' color
     ///
@@ -305,15 +389,16 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    const Texture* m_texture;          ///< Texture of the shape
-    IntRect        m_textureRect;      ///< Rectangle defining the area of the source texture to display
-    Color          m_fillColor;        ///< Fill color
-    Color          m_outlineColor;     ///< Outline color
-    float          m_outlineThickness; ///< Thickness of the shape's outline
-    VertexArray    m_vertices;         ///< Vertex array containing the fill geometry
-    VertexArray    m_outlineVertices;  ///< Vertex array containing the outline geometry
-    FloatRect      m_insideBounds;     ///< Bounding rectangle of the inside (fill)
-    FloatRect      m_bounds;           ///< Bounding rectangle of the whole shape (outline + fill)
+    const Texture*        m_texture;          ///< Texture of the shape
+    IntRect               m_textureRect;      ///< Rectangle defining the area of the source texture to display
+    Color                 m_fillColor;        ///< Fill color
+    Color                 m_outlineColor;     ///< Outline color
+    float                 m_outlineThickness; ///< Thickness of the shape's outline
+    VertexArray           m_vertices;         ///< Vertex array containing the fill geometry
+    VertexArray           m_outlineVertices;  ///< Vertex array containing the outline geometry
+    std::vector<Vector2f> m_outlineNormals;   ///< Extrusion direction of the outline at each point, for a thickness of 1
+    FloatRect             m_insideBounds;     ///< Bounding rectangle of the inside (fill)
+    FloatRect             m_bounds;           ///< Bounding rectangle of the whole shape (outline + fill)
 };
 
 } // namespace sf
@@ -0,0 +1,364 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SPATIALINDEX_HPP
+#define SFML_SPATIALINDEX_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class View;
+
+////////////////////////////////////////////////////////////
+/// \brief Index of rectangles, to quickly find the ones
+///        overlapping an area or containing a point
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SpatialIndex
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Identifier of an item of the index
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef std::size_t Id;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The cell size should be about the size of a typical
+    /// item: larger cells make the queries test more items,
+    /// smaller cells make each item span more cells. It can be
+    /// adjusted to the actual items later with optimize().
+    ///
+    /// \param cellSize Width and height of the cells of the grid
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit SpatialIndex(float cellSize = 128.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an item to the index
+    ///
+    /// \param bounds Bounding rectangle of the item
+    /// \param data   User data associated to the item
+    ///
+    /// \return Identifier of the new item
+    ///
+    /// \see remove, update
+    ///
+    ////////////////////////////////////////////////////////////
+    Id insert(const FloatRect& bounds, void* data = NULL);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an object which has global bounds to the index
+    ///
+    /// This is a shortcut for
+    /// \code
+    /// index.insert(object.getGlobalBounds(), &object);
+    /// \endcode
+    /// that works with sf::Sprite, sf::Shape, sf::Text, and any
+    /// class that defines a getGlobalBounds() function.
+    ///
+    /// \param object Object to add
+    ///
+    /// \return Identifier of the new item
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename T>
+    Id insert(const T& object);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the bounds of an item
+    ///
+    /// This is cheap when the item stays in the same cells,
+    /// which is the case of most small moves.
+    ///
+    /// \param id     Identifier of the item
+    /// \param bounds New bounding rectangle of the item
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(Id id, const FloatRect& bounds);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update an item from the global bounds of an object
+    ///
+    /// This is a shortcut for
+    /// \code
+    /// index.update(id, object.getGlobalBounds());
+    /// \endcode
+    ///
+    /// \param id     Identifier of the item
+    /// \param object Object whose bounds changed
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename T>
+    void update(Id id, const T& object);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove an item from the index
+    ///
+    /// The identifier of the item may be reused by the items
+    /// inserted afterwards.
+    ///
+    /// \param id Identifier of the item
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(Id id);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the items
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of items in the index
+    ///
+    /// \return Number of items
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getItemCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounds of an item
+    ///
+    /// \param id Identifier of the item
+    ///
+    /// \return Bounding rectangle of the item
+    ///
+    ////////////////////////////////////////////////////////////
+    const FloatRect& getBounds(Id id) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the user data of an item
+    ///
+    /// \param id Identifier of the item
+    ///
+    /// \return User data given when the item was inserted
+    ///
+    ////////////////////////////////////////////////////////////
+    void* getData(Id id) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the items overlapping a rectangle
+    ///
+    /// The identifiers are written to \a result, sorted in
+    /// increasing order so that the items are always returned
+    /// in the same order. Items that only touch the rectangle
+    /// are included.
+    ///
+    /// \param area   Rectangle to test
+    /// \param result Vector filled with the identifiers of the items
+    ///
+    /// \return Number of items found
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t query(const FloatRect& area, std::vector<Id>& result) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the items visible in a view
+    ///
+    /// The area tested is the bounding rectangle of the view,
+    /// which takes its rotation into account.
+    ///
+    /// \param view   View to test
+    /// \param result Vector filled with the identifiers of the items
+    ///
+    /// \return Number of items found
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t query(const View& view, std::vector<Id>& result) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the items containing a point
+    ///
+    /// This is typically used to find the objects under the
+    /// mouse cursor, after converting its position with
+    /// sf::RenderTarget::mapPixelToCoords.
+    ///
+    /// \param point  Point to test
+    /// \param result Vector filled with the identifiers of the items
+    ///
+    /// \return Number of items found
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t query(const Vector2f& point, std::vector<Id>& result) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Adapt the grid to the items currently in the index
+    ///
+    /// The cell size is set to twice the median size of the
+    /// items, and the grid is rebuilt. This is worth calling
+    /// once the world is loaded, when the typical size of the
+    /// items isn't known beforehand.
+    ///
+    ////////////////////////////////////////////////////////////
+    void optimize();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the cells of the grid
+    ///
+    /// \return Width and height of the cells
+    ///
+    ////////////////////////////////////////////////////////////
+    float getCellSize() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Range of cells covered by an item
+    ///
+    ////////////////////////////////////////////////////////////
+    struct CellRange
+    {
+        int left;   ///< First column
+        int top;    ///< First row
+        int right;  ///< Last column
+        int bottom; ///< Last row
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Item of the index
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Item
+    {
+        FloatRect           bounds;    ///< Bounding rectangle
+        void*               data;      ///< User data
+        CellRange           cells;     ///< Cells in which the item is stored
+        bool                oversized; ///< Is the item stored in the list of large items rather than in the grid?
+        bool                used;      ///< Is the item in the index, or is its slot free?
+        mutable std::size_t stamp;     ///< Last query which found the item, to report it once
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the range of cells covered by a rectangle
+    ///
+    ////////////////////////////////////////////////////////////
+    CellRange getCells(const FloatRect& bounds) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bucket storing a cell
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getBucket(int x, int y) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an item to the cells it covers
+    ///
+    ////////////////////////////////////////////////////////////
+    void link(Id id);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove an item from the cells it covers
+    ///
+    ////////////////////////////////////////////////////////////
+    void unlink(Id id);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recreate the buckets and put back all the items
+    ///
+    ////////////////////////////////////////////////////////////
+    void rebuild(std::size_t bucketCount);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    float                         m_cellSize;  ///< Width and height of the cells
+    std::vector<Item>             m_items;     ///< Items, indexed by their identifier
+    std::vector<Id>               m_freeIds;   ///< Identifiers of the free slots of m_items
+    std::vector<std::vector<Id> > m_buckets;   ///< Hashed cells of the grid, with the items overlapping them
+    std::vector<Id>               m_oversized; ///< Items covering too many cells to be stored in the grid
+    mutable std::size_t           m_stamp;     ///< Counter of the queries
+};
+
+#include <SFML/Graphics/SpatialIndex.inl>
+
+} // namespace sf
+
+
+#endif // SFML_SPATIALINDEX_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SpatialIndex
+/// \ingroup graphics
+///
+/// sf::SpatialIndex stores the bounding rectangles of objects,
+/// and quickly finds the ones that overlap an area or contain a
+/// point. It replaces loops over all the objects calling
+/// sf::Rect::intersects, for example to only draw what is
+/// visible in a large world, or to find the object under the
+/// mouse cursor.
+///
+/// The rectangles are stored in a uniform grid, whose cells are
+/// hashed so that the world doesn't need to be bounded. Inserting,
+/// moving and removing an item only touch the few cells that it
+/// covers. Items much larger than the cells are kept in a
+/// separate list, that is tested by every query.
+///
+/// Each item has some user data, typically a pointer to the
+/// object it represents. The index doesn't track the objects:
+/// their bounds must be updated when they move.
+///
+/// Usage example:
+/// \code
+/// std::vector<sf::Sprite> sprites = ...;
+///
+/// sf::SpatialIndex index;
+/// std::vector<sf::SpatialIndex::Id> ids;
+/// for (std::size_t i = 0; i < sprites.size(); ++i)
+///     ids.push_back(index.insert(sprites[i]));
+/// index.optimize();
+///
+/// // when a sprite moves
+/// sprites[i].move(offset);
+/// index.update(ids[i], sprites[i]);
+///
+/// // draw only the visible sprites
+/// std::vector<sf::SpatialIndex::Id> visible;
+/// index.query(window.getView(), visible);
+/// for (std::size_t i = 0; i < visible.size(); ++i)
+///     window.draw(*static_cast<sf::Sprite*>(index.getData(visible[i])));
+///
+/// // find the sprites under the mouse cursor
+/// std::vector<sf::SpatialIndex::Id> picked;
+/// index.query(window.mapPixelToCoords(sf::Mouse::getPosition(window)), picked);
+/// \endcode
+///
+/// The queries are const but not thread-safe, since they mark
+/// the items that they found.
+///
+/// \see sf::RenderTarget::isVisible
+///
+////////////////////////////////////////////////////////////
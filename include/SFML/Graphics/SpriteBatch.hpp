@@ -0,0 +1,263 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef SFML_SPRITEBATCH_HPP
+#define SFML_SPRITEBATCH_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class RenderTarget;
+class Sprite;
+class SpriteMesh;
+class Texture;
+class TrimmedSprite;
+
+////////////////////////////////////////////////////////////
+/// \brief Draws many textured quads and polygons with one
+///        draw call per texture
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SpriteBatch
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Order in which the quads of a batch are drawn
+    ///
+    ////////////////////////////////////////////////////////////
+    enum SortMode
+    {
+        Deferred,    ///< In the order they were added
+        ByTexture,   ///< Grouped by texture, to draw each texture only once
+        BackToFront, ///< From the highest depth to the lowest (for blending)
+        FrontToBack  ///< From the lowest depth to the highest (for depth testing)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    SpriteBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start a new batch
+    ///
+    /// The quads added until end() is called are drawn to
+    /// \a target with \a states; the texture of the states is
+    /// replaced by the texture of each quad, and their
+    /// transform applies to all of them.
+    ///
+    /// \param target   Render target to draw to
+    /// \param sortMode Order in which the quads are drawn
+    /// \param states   Render states to use for drawing
+    ///
+    /// \see end
+    ///
+    ////////////////////////////////////////////////////////////
+    void begin(RenderTarget& target, SortMode sortMode = Deferred, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a sprite to the batch
+    ///
+    /// The sprite is copied: it can be changed or destroyed
+    /// right after the call. Sprites without a texture are
+    /// ignored.
+    ///
+    /// \param sprite Sprite to draw
+    /// \param depth  Depth of the sprite, used by the BackToFront and FrontToBack sort modes
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Sprite& sprite, float depth = 0.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a textured quad to the batch
+    ///
+    /// The quad covers \a rectangle in local coordinates, from
+    /// (0, 0) to its size, like a sprite.
+    ///
+    /// \param texture   Texture of the quad
+    /// \param rectangle Area of the texture to draw
+    /// \param transform Transform of the quad
+    /// \param color     Color that modulates the texture
+    /// \param depth     Depth of the quad, used by the BackToFront and FrontToBack sort modes
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Texture& texture, const IntRect& rectangle, const Transform& transform,
+              const Color& color = Color::White, float depth = 0.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a trimmed sprite to the batch
+    ///
+    /// The polygon of the sprite's mesh is copied, like the
+    /// quads of regular sprites. Sprites without a texture are
+    /// ignored.
+    ///
+    /// \param sprite Sprite to draw
+    /// \param depth  Depth of the sprite, used by the BackToFront and FrontToBack sort modes
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const TrimmedSprite& sprite, float depth = 0.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a textured polygon to the batch
+    ///
+    /// The polygon is the one of \a mesh, placed in \a rectangle
+    /// as sf::TrimmedSprite does.
+    ///
+    /// \param texture   Texture of the polygon
+    /// \param rectangle Area of the texture to draw
+    /// \param mesh      Mesh covering the visible pixels of the area
+    /// \param transform Transform of the polygon
+    /// \param color     Color that modulates the texture
+    /// \param depth     Depth of the polygon, used by the BackToFront and FrontToBack sort modes
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Texture& texture, const IntRect& rectangle, const SpriteMesh& mesh, const Transform& transform,
+              const Color& color = Color::White, float depth = 0.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the quads and polygons of the batch and finish it
+    ///
+    /// Consecutive quads and polygons which use the same
+    /// texture, after sorting, are drawn with a single draw call.
+    ///
+    /// \see begin
+    ///
+    ////////////////////////////////////////////////////////////
+    void end();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of draw calls made by the last batch
+    ///
+    /// \return Number of draw calls issued by the last call to end()
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getDrawCallCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start a new item in the batch
+    ///
+    /// \param texture     Texture of the item
+    /// \param depth       Depth of the item
+    /// \param vertexCount Number of vertices of the item
+    ///
+    /// \return True if the item was added, false if the batch was not started
+    ///
+    ////////////////////////////////////////////////////////////
+    bool addItem(const Texture& texture, float depth, std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw a range of items which share the same texture
+    ///
+    /// The indices of the range must be in m_indices.
+    ///
+    /// \param vertices    Vertices of the items
+    /// \param vertexCount Number of vertices
+    /// \param texture     Texture of the items
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawRun(const Vertex* vertices, std::size_t vertexCount, const Texture* texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Quad or polygon of the batch, and where its vertices are
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Item
+    {
+        const Texture* texture;     ///< Texture of the item
+        float          depth;       ///< Depth of the item
+        std::size_t    firstVertex; ///< Index of the first vertex of the item in the vertices of the batch
+        std::size_t    vertexCount; ///< Number of vertices of the item, drawn as a triangle fan
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    RenderTarget*       m_target;        ///< Target of the current batch, null outside begin/end
+    SortMode            m_sortMode;      ///< Sort mode of the current batch
+    RenderStates        m_states;        ///< Render states of the current batch
+    std::vector<Item>   m_items;         ///< Quads and polygons of the current batch, in the order they were added
+    std::vector<Vertex> m_vertices;      ///< Transformed vertices of the items
+    std::vector<Vertex> m_sorted;        ///< Vertices of the items in the order they are drawn
+    std::vector<Uint16> m_indices;       ///< Indices of the triangles of the run being drawn
+    std::size_t         m_drawCallCount; ///< Number of draw calls issued by the last batch
+};
+
+} // namespace sf
+
+
+#endif // SFML_SPRITEBATCH_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SpriteBatch
+/// \ingroup graphics
+///
+/// sf::SpriteBatch is the explicit counterpart of the
+/// automatic batching of sf::RenderTarget: the quads added
+/// between begin() and end() are transformed on the CPU,
+/// written as indexed triangles into a vertex stream which
+/// keeps its capacity from one batch to the next, and drawn
+/// when end() is called, with one draw call per run of quads
+/// that use the same texture.
+///
+/// The polygons of sf::TrimmedSprite are batched the same
+/// way, as triangle fans in the same vertex stream, so that
+/// trimmed and regular sprites of the same texture share
+/// their draw calls.
+///
+/// The sort mode tells which order the quads are drawn in.
+/// Deferred keeps the order they were added in, ByTexture
+/// groups them by texture so that each one is drawn only once,
+/// BackToFront and FrontToBack sort them by depth. The sorts
+/// are stable: quads which compare equal keep the order they
+/// were added in.
+///
+/// Usage example:
+/// \code
+/// sf::SpriteBatch batch;
+///
+/// batch.begin(window, sf::SpriteBatch::BackToFront);
+/// for (std::size_t i = 0; i < entities.size(); ++i)
+///     batch.draw(entities[i].sprite, entities[i].depth);
+/// batch.draw(atlas, sf::IntRect(0, 0, 32, 32), cursorTransform);
+/// batch.end();
+/// \endcode
+///
+/// \see sf::Sprite, sf::TrimmedSprite, sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
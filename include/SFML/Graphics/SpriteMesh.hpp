@@ -0,0 +1,177 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SPRITEMESH_HPP
+#define SFML_SPRITEMESH_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Image;
+
+////////////////////////////////////////////////////////////
+/// \brief Convex polygon that tightly covers the visible
+///        pixels of a sprite
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SpriteMesh
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty mesh, which covers nothing.
+    ///
+    ////////////////////////////////////////////////////////////
+    SpriteMesh();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Build the mesh from the alpha channel of an image
+    ///
+    /// The mesh is the convex hull of the pixels of \a area
+    /// whose alpha is above \a alphaThreshold, simplified until
+    /// it has at most \a maxPointCount points. The simplification
+    /// only ever grows the polygon, so that all the visible
+    /// pixels stay inside it, and never lets it go outside of
+    /// \a area, so that it doesn't show the neighbours of the
+    /// sprite in a texture atlas. If the hull can't be reduced
+    /// that much, the mesh is the whole rectangle.
+    ///
+    /// The points are in pixels, relative to the top-left
+    /// corner of the area. If \a area is empty, the whole image
+    /// is used. A fully transparent area gives an empty mesh.
+    ///
+    /// \param image          Image to read the alpha channel from
+    /// \param area           Area of the image covered by the sprite
+    /// \param maxPointCount  Maximum number of points of the mesh (at least 3)
+    /// \param alphaThreshold Pixels with an alpha lower than or equal to this value are trimmed
+    ///
+    /// \return True if the mesh was built, false if the area is outside the image
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromImage(const Image& image, const IntRect& area = IntRect(), std::size_t maxPointCount = 8, Uint8 alphaThreshold = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of points of the mesh
+    ///
+    /// \return Number of points of the mesh
+    ///
+    /// \see getPoint
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPointCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a point of the mesh
+    ///
+    /// The points follow the outline of the polygon. The result
+    /// is undefined if \a index is out of the valid range.
+    ///
+    /// \param index Index of the point to get, in range [0 .. getPointCount() - 1]
+    ///
+    /// \return Position of the point, relative to the top-left corner of the area
+    ///
+    /// \see getPointCount
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2f getPoint(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the area the mesh was built for
+    ///
+    /// \return Size of the area, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the fraction of the area covered by the mesh
+    ///
+    /// This is the fraction of the pixels of a full sprite
+    /// quad that are still drawn with the mesh.
+    ///
+    /// \return Area of the polygon divided by the area of the rectangle, in range [0, 1]
+    ///
+    ////////////////////////////////////////////////////////////
+    float getCoverage() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Vector2f> m_points; ///< Points of the polygon
+    Vector2u              m_size;   ///< Size of the area the mesh was built for
+};
+
+} // namespace sf
+
+
+#endif // SFML_SPRITEMESH_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SpriteMesh
+/// \ingroup graphics
+///
+/// Most sprites are mostly transparent around their edges,
+/// and drawing them as full quads makes the GPU blend all
+/// these pixels for nothing. sf::SpriteMesh computes, once
+/// when the sprite is loaded, a convex polygon with a few
+/// points that covers only the visible pixels; drawn with
+/// sf::TrimmedSprite or sf::SpriteBatch, it fills fewer
+/// pixels for the same result.
+///
+/// The vertex budget is a trade-off: more points follow the
+/// outline more closely, but cost more vertices. Between 6
+/// and 8 points usually remove most of the transparent
+/// corners. getCoverage() tells how much of the quad is left.
+///
+/// Usage example:
+/// \code
+/// sf::Image image;
+/// image.loadFromFile("ship.png");
+///
+/// sf::SpriteMesh mesh;
+/// mesh.loadFromImage(image, sf::IntRect(), 8);
+///
+/// sf::Texture texture;
+/// texture.loadFromImage(image);
+///
+/// sf::TrimmedSprite sprite(texture, mesh);
+/// window.draw(sprite);
+/// \endcode
+///
+/// \see sf::TrimmedSprite, sf::SpriteBatch
+///
+////////////////////////////////////////////////////////////
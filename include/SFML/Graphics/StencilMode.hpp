@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_STENCILMODE_HPP
+#define SFML_STENCILMODE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Config.hpp>
+
+
+namespace sf
+{
+
+////////////////////////////////////////////////////////////
+/// \brief Stencil modes for drawing
+///
+////////////////////////////////////////////////////////////
+struct SFML_GRAPHICS_API StencilMode
+{
+    ////////////////////////////////////////////////////////
+    /// \brief Enumeration of the stencil functions
+    ///
+    ////////////////////////////////////////////////////////
+    enum Function
+    {
+        Disabled, ///< The stencil buffer is neither tested nor modified
+        Write,    ///< Every drawn pixel writes the value to the stencil buffer, the color buffer is left untouched
+        Equal,    ///< Pixels are drawn only where the stencil buffer contains the value
+        NotEqual  ///< Pixels are drawn only where the stencil buffer doesn't contain the value
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Constructs a disabled stencil mode.
+    ///
+    ////////////////////////////////////////////////////////////
+    StencilMode();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the stencil mode given the function and value
+    ///
+    /// \param theFunction Function to use
+    /// \param theValue    Value written to or compared with the stencil buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    StencilMode(Function theFunction, Uint8 theValue = 1);
+
+    ////////////////////////////////////////////////////////////
+    // Member Data
+    ////////////////////////////////////////////////////////////
+    Function function; ///< How the stencil buffer is used
+    Uint8    value;    ///< Value written to or compared with the stencil buffer
+};
+
+////////////////////////////////////////////////////////////
+/// \relates StencilMode
+/// \brief Overload of the == operator
+///
+/// \param left  Left operand
+/// \param right Right operand
+///
+/// \return True if stencil modes are equal, false if they are different
+///
+////////////////////////////////////////////////////////////
+SFML_GRAPHICS_API bool operator ==(const StencilMode& left, const StencilMode& right);
+
+////////////////////////////////////////////////////////////
+/// \relates StencilMode
+/// \brief Overload of the != operator
+///
+/// \param left  Left operand
+/// \param right Right operand
+///
+/// \return True if stencil modes are different, false if they are equal
+///
+////////////////////////////////////////////////////////////
+SFML_GRAPHICS_API bool operator !=(const StencilMode& left, const StencilMode& right);
+
+} // namespace sf
+
+
+#endif // SFML_STENCILMODE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::StencilMode
+/// \ingroup graphics
+///
+/// sf::StencilMode clips the drawn objects to a mask of any
+/// shape, stored in the stencil buffer of the render target.
+/// The mask is drawn first with the Write function: its
+/// pixels don't appear, they only store the value in the
+/// stencil buffer. The clipped objects are then drawn with
+/// the Equal function and the same value, so that only
+/// their pixels inside the mask appear (or with NotEqual,
+/// to cut the mask out of them).
+///
+/// Every pixel covered by the mask primitives is written,
+/// including transparent texels: the shape of the mask is
+/// the shape of its geometry.
+///
+/// The target must have a stencil buffer: a window created
+/// with stencil bits in its context settings, or a render
+/// texture created with stencil bits. The stencil buffer is
+/// reset with sf::RenderTarget::clearStencil. Since the
+/// mask must be drawn before the objects it clips, a mask
+/// drawn through a sf::RenderQueue belongs to a lower layer.
+///
+/// \code
+/// window.clearStencil();
+///
+/// // Draw the shape of the panel into the stencil buffer
+/// sf::RenderStates mask;
+/// mask.stencilMode = sf::StencilMode(sf::StencilMode::Write);
+/// window.draw(panelShape, mask);
+///
+/// // Draw the content of the panel, clipped to its shape
+/// sf::RenderStates clipped;
+/// clipped.stencilMode = sf::StencilMode(sf::StencilMode::Equal);
+/// window.draw(content, clipped);
+/// \endcode
+///
+/// For rectangular areas aligned with the target, the scissor
+/// rectangle of sf::RenderStates is cheaper: it needs neither
+/// a stencil buffer nor a mask pass.
+///
+/// \see sf::RenderStates, sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,279 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_STREAMINGTEXTURE_HPP
+#define SFML_STREAMINGTEXTURE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Texture fed with frames written by another thread
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API StreamingTexture : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty streaming texture, create() must be
+    /// called before it can be used.
+    ///
+    ////////////////////////////////////////////////////////////
+    StreamingTexture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The producer thread must not write to the streaming
+    /// texture anymore when it is destroyed.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~StreamingTexture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the texture and the frame buffers
+    ///
+    /// Frames are made of \a width x \a height RGBA pixels.
+    /// This function must be called from the thread that
+    /// draws the texture, before the producer starts writing.
+    ///
+    /// If pixel buffer objects are not available (see
+    /// TextureStream::isAvailable()), the frames are written
+    /// to system memory and uploaded synchronously.
+    ///
+    /// \param width  Width of the frames, in pixels
+    /// \param height Height of the frames, in pixels
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the frames
+    ///
+    /// \return Size in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a buffer to write the next frame to
+    ///
+    /// This function can be called from any thread, it doesn't
+    /// use OpenGL. The returned array has room for getSize().x
+    /// * getSize().y RGBA pixels; it can only be written to,
+    /// reading it may be extremely slow. Calling it again
+    /// before publishFrame() returns the same buffer.
+    ///
+    /// NULL is returned when no buffer is free, which only
+    /// happens if the render thread is still uploading the
+    /// other frames; the producer should drop the frame.
+    ///
+    /// \return Pointer to the frame memory, or NULL if no buffer is free
+    ///
+    /// \see publishFrame
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint8* acquireFrame();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make the frame written to the acquired buffer the latest one
+    ///
+    /// This function can be called from any thread. If the
+    /// previous published frame was not uploaded yet, it is
+    /// dropped: only the latest frame is ever shown.
+    ///
+    /// \see acquireFrame, upload
+    ///
+    ////////////////////////////////////////////////////////////
+    void publishFrame();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy a frame and publish it
+    ///
+    /// This is a shortcut for acquireFrame(), a copy of the
+    /// pixels and publishFrame(). Decoding directly to the
+    /// acquired buffer avoids the copy.
+    ///
+    /// \param pixels Array of getSize().x * getSize().y RGBA pixels
+    ///
+    /// \return True if the frame was published, false if no buffer was free
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const Uint8* pixels);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the latest published frame to the texture
+    ///
+    /// This function must be called from the thread that
+    /// draws the texture, typically once per frame before
+    /// drawing. It performs a single transfer from the buffer
+    /// of the frame to the texture, and does nothing if no
+    /// frame was published since the last call.
+    ///
+    /// \return True if the texture was updated
+    ///
+    ////////////////////////////////////////////////////////////
+    bool upload();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture showing the uploaded frames
+    ///
+    /// \return Read-only reference to the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of published frames that were never uploaded
+    ///
+    /// A frame is dropped when a newer one is published before
+    /// the render thread uploads it.
+    ///
+    /// \return Number of dropped frames since the creation
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getDroppedFrameCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief State of a frame buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    enum SlotState
+    {
+        Free,      ///< Ready to be acquired by the producer
+        Writing,   ///< Acquired by the producer
+        Published, ///< Holds the latest frame, waiting for upload
+        Uploading  ///< Being transferred to the texture by the render thread
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Buffer holding a frame
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Slot
+    {
+        unsigned int buffer; ///< Pixel buffer object, 0 in system memory mode
+        Uint8*       memory; ///< Memory written by the producer (mapped buffer or system memory), NULL if unavailable
+        SlotState    state;  ///< State of the buffer
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Map the pixel buffer of a slot, so that it can be written again
+    ///
+    /// \param slot Slot to map
+    ///
+    ////////////////////////////////////////////////////////////
+    void map(Slot& slot);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the buffers
+    ///
+    ////////////////////////////////////////////////////////////
+    void cleanup();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Texture             m_texture;   ///< Texture showing the uploaded frames
+    std::vector<Slot>   m_slots;     ///< Frame buffers (one written, one published, one uploaded)
+    std::vector<Uint8>  m_pixels;    ///< Memory of the slots when pixel buffers are not available
+    Vector2u            m_size;      ///< Size of the frames
+    int                 m_writing;   ///< Index of the slot acquired by the producer, -1 if none
+    int                 m_published; ///< Index of the slot holding the latest frame, -1 if none
+    Uint64              m_dropped;   ///< Number of frames dropped so far
+    mutable Mutex       m_mutex;     ///< Mutex protecting the states of the slots
+};
+
+} // namespace sf
+
+
+#endif // SFML_STREAMINGTEXTURE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::StreamingTexture
+/// \ingroup graphics
+///
+/// Updating a sf::Texture requires an OpenGL context, so a
+/// thread decoding a video or capturing a camera usually
+/// hands its frames to the render thread through an
+/// intermediate copy and a lock held during the upload.
+///
+/// sf::StreamingTexture gives the producer thread buffers
+/// that it can write to directly, without any OpenGL call:
+/// pixel buffer objects that the render thread keeps mapped.
+/// The render thread then transfers the latest frame to the
+/// texture with a single call to upload(). Frames published
+/// faster than they are uploaded are dropped, so the texture
+/// always shows the most recent one and the producer never
+/// waits for the renderer.
+///
+/// Usage example:
+/// \code
+/// sf::StreamingTexture video;
+/// video.create(1280, 720);
+///
+/// // In the decoding thread
+/// while (decoder.hasFrames())
+/// {
+///     sf::Uint8* pixels = video.acquireFrame();
+///     if (pixels)
+///     {
+///         decoder.decodeFrame(pixels);
+///         video.publishFrame();
+///     }
+/// }
+///
+/// // In the render thread
+/// while (window.isOpen())
+/// {
+///     video.upload();
+///
+///     window.clear();
+///     window.draw(sf::Sprite(video.getTexture()));
+///     window.display();
+/// }
+/// \endcode
+///
+/// \see sf::Texture, sf::TextureStream
+///
+////////////////////////////////////////////////////////////
@@ -35,12 +35,15 @@
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/System/String.hpp>
+#include <SFML/System/Utf8View.hpp>
 #include <string>
 #include <vector>
 
 
 namespace sf
 {
+class Shader;
+
 ////////////////////////////////////////////////////////////
 /// \brief Graphical text that can be drawn to a render target
 ///
@@ -62,6 +65,17 @@ public:
         StrikeThrough = 1 << 3  ///< Strike through characters
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enumeration of the horizontal alignments of the lines
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Alignment
+    {
+        Left,   ///< Lines start at the left of the text
+        Center, ///< Lines are centered
+        Right   ///< Lines end at the right of the text
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -87,6 +101,18 @@ public:
     ////////////////////////////////////////////////////////////
     Text(const String& string, const Font& font, unsigned int characterSize = 30);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the text from a UTF-8 string, a font and a size
+    ///
+    /// \param string         UTF-8 text assigned to the string (copied)
+    /// \param font           Font used to draw the string
+    /// \param characterSize  Base size of characters, in pixels
+    ///
+    /// \see setString(const Utf8View&)
+    ///
+    ////////////////////////////////////////////////////////////
+    Text(const Utf8View& string, const Font& font, unsigned int characterSize = 30);
+
     ////////////////////////////////////////////////////////////
     /// \brief Set the text's string
     ///
@@ -101,6 +127,10 @@ public:
     /// \endcode
     /// A text's string is empty by default.
     ///
+    /// If the new string only appends characters to the previous
+    /// one, or erases characters at its end, only the geometry
+    /// of the affected characters is recomputed.
+    ///
     /// \param string New string
     ///
     /// \see getString
@@ -108,6 +138,26 @@ public:
     ////////////////////////////////////////////////////////////
     void setString(const String& string);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the text's string from UTF-8 bytes
+    ///
+    /// The bytes are copied and kept in UTF-8: the characters are
+    /// decoded while the geometry is computed, so no UTF-32 copy
+    /// of the string is made. This uses much less memory than
+    /// a sf::String (typically 1 byte per character instead of 4)
+    /// and saves the conversion, which matters for user interfaces
+    /// made of many labels.
+    /// \code
+    /// text.setString(sf::Utf8View(label));
+    /// \endcode
+    ///
+    /// \param string New string, encoded in UTF-8
+    ///
+    /// \see getString
+    ///
+    ////////////////////////////////////////////////////////////
+    void setString(const Utf8View& string);
+
     ////////////////////////////////////////////////////////////
     /// \brief Set the text's font
     ///
@@ -170,6 +220,57 @@ public:
     ////////////////////////////////////////////////////////////
     void setColor(const Color& color);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum width of the lines
+    ///
+    /// When a character doesn't fit in the current line, the line
+    /// is broken before the word that contains it (or before the
+    /// character itself, see setWordWrap). The line breaks are
+    /// computed along with the geometry and cached: when the
+    /// string is edited, only the lines from the edited one
+    /// onward are flowed again.
+    ///
+    /// A width of 0 (the default) disables wrapping: lines are
+    /// only broken by end of line characters.
+    ///
+    /// \param width Maximum width of the lines, in pixels
+    ///
+    /// \see getMaxWidth, setAlignment
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMaxWidth(float width);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the horizontal alignment of the lines
+    ///
+    /// Lines are aligned within the maximum width if there's one,
+    /// or else within the width of the widest line.
+    /// Changing the alignment doesn't compute the line breaks again.
+    /// The default alignment is sf::Text::Left.
+    ///
+    /// \param alignment New alignment
+    ///
+    /// \see getAlignment, setMaxWidth
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAlignment(Alignment alignment);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable word wrapping
+    ///
+    /// With word wrapping, lines that exceed the maximum width are
+    /// broken between words; a word longer than a whole line is
+    /// broken between its characters. Without it, lines are filled
+    /// up and broken anywhere. Word wrapping is enabled by default,
+    /// it has no effect if no maximum width is set.
+    ///
+    /// \param wordWrap True to break lines between words
+    ///
+    /// \see getWordWrap, setMaxWidth
+    ///
+    ////////////////////////////////////////////////////////////
+    void setWordWrap(bool wordWrap);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the text's string
     ///
@@ -182,6 +283,9 @@ public:
     /// std::wstring s3 = text.getString();
     /// \endcode
     ///
+    /// If the string was set from UTF-8, it is decoded by
+    /// the first call to this function.
+    ///
     /// \return Text's string
     ///
     /// \see setString
@@ -233,6 +337,47 @@ public:
     ////////////////////////////////////////////////////////////
     const Color& getColor() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum width of the lines
+    ///
+    /// \return Maximum width of the lines, in pixels (0 if lines are not wrapped)
+    ///
+    /// \see setMaxWidth
+    ///
+    ////////////////////////////////////////////////////////////
+    float getMaxWidth() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the horizontal alignment of the lines
+    ///
+    /// \return Alignment of the lines
+    ///
+    /// \see setAlignment
+    ///
+    ////////////////////////////////////////////////////////////
+    Alignment getAlignment() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether word wrapping is enabled
+    ///
+    /// \return True if lines are broken between words
+    ///
+    /// \see setWordWrap
+    ///
+    ////////////////////////////////////////////////////////////
+    bool getWordWrap() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of lines of the text
+    ///
+    /// This includes the lines created by end of line characters
+    /// and the ones created by wrapping.
+    ///
+    /// \return Number of lines (0 if the text is empty)
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getLineCount() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the position of the \a index-th character
     ///
@@ -242,6 +387,8 @@ public:
     /// origin are applied).
     /// If \a index is out of range, the position of the end of
     /// the string is returned.
+    /// The positions are cached along with the geometry, so this
+    /// function doesn't have to walk the string.
     ///
     /// \param index Index of the character
     ///
@@ -280,6 +427,8 @@ public:
 
 private:
 
+    friend class TextBatch;
+
     ////////////////////////////////////////////////////////////
     /// \brief Draw the text to a render target
     ///
@@ -298,17 +447,76 @@ private:
     ////////////////////////////////////////////////////////////
     void ensureGeometryUpdate() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the shader that the text is drawn with when
+    ///        no shader is given
+    ///
+    /// \return Distance field shader if the font needs one, NULL otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    const Shader* getDefaultShader() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the line that contains a character
+    ///
+    /// \param index Index of the character
+    ///
+    /// \return Index of the line
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t findLine(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Layout state of the text before one of its characters
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Layout
+    {
+        Vector2f    position;    ///< Pen position, before the kerning of the character is applied
+        std::size_t vertexCount; ///< Number of vertices generated by the previous characters
+        float       lineWidth;   ///< Width of the previous characters of the line, without the trailing whitespace
+        float       minX;        ///< Left of the bounds of the previous characters of the line
+        float       minY;        ///< Top of the bounds of the previous characters
+        float       maxX;        ///< Right of the bounds of the previous characters of the line
+        float       maxY;        ///< Bottom of the bounds of the previous characters
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Line of the text, ended by an end of line character or by wrapping
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Line
+    {
+        std::size_t start;   ///< Index of the first character of the line
+        float       width;   ///< Width of the line, without the trailing whitespace
+        float       minX;    ///< Left of the bounds of the line, before alignment
+        float       maxX;    ///< Right of the bounds of the line, before alignment
+        float       offset;  ///< Horizontal offset applied to the vertices of the line by the alignment
+        bool        wrapped; ///< Was the line ended by the maximum width?
+        bool        split;   ///< Was the line ended in the middle of a word?
+    };
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    String              m_string;             ///< String to display
-    const Font*         m_font;               ///< Font used to display the string
-    unsigned int        m_characterSize;      ///< Base size of characters, in pixels
-    Uint32              m_style;              ///< Text style (see Style enum)
-    Color               m_color;              ///< Text color
-    mutable VertexArray m_vertices;           ///< Vertex array containing the text's geometry
-    mutable FloatRect   m_bounds;             ///< Bounding rectangle of the text (in local coordinates)
-    mutable bool        m_geometryNeedUpdate; ///< Does the geometry need to be recomputed?
+    mutable String              m_string;             ///< String to display, decoded on demand if set as UTF-8
+    std::string                 m_utf8;               ///< String to display, if set as UTF-8
+    bool                        m_isUtf8;             ///< Is the string stored as UTF-8?
+    const Font*                 m_font;               ///< Font used to display the string
+    unsigned int                m_characterSize;      ///< Base size of characters, in pixels
+    Uint32                      m_style;              ///< Text style (see Style enum)
+    Color                       m_color;              ///< Text color
+    float                       m_maxWidth;           ///< Maximum width of the lines (0 to disable wrapping)
+    Alignment                   m_alignment;          ///< Horizontal alignment of the lines
+    bool                        m_wordWrap;           ///< Are lines broken between words rather than anywhere?
+    mutable VertexArray         m_vertices;           ///< Vertex array containing the text's geometry
+    mutable FloatRect           m_bounds;             ///< Bounding rectangle of the text (in local coordinates)
+    mutable bool                m_geometryNeedUpdate; ///< Does the geometry need to be recomputed?
+    mutable std::size_t         m_validLength;        ///< Number of leading characters whose geometry is still valid
+    mutable std::vector<Layout> m_layout;             ///< Layout before each character, followed by the layout at the end of the string
+    mutable std::vector<Line>   m_lines;              ///< Lines of the text, computed along with the geometry
+    mutable Uint64              m_fontRevision;       ///< Revision of the font's glyph cache that the geometry was built with
+    mutable Uint64              m_revision;           ///< Incremented every time the vertices change (see TextBatch)
 };
 
 } // namespace sf
@@ -333,6 +541,11 @@ private:
 /// graphical size of the text, or to get the global position
 /// of a given character.
 ///
+/// Lines can be wrapped to a maximum width (see setMaxWidth)
+/// and aligned to the left, center or right; the line breaks
+/// are computed together with the geometry, so there's no
+/// need to split the string into several texts.
+///
 /// sf::Text works in combination with the sf::Font class, which
 /// loads and provides the glyphs (visual characters) of a given font.
 ///
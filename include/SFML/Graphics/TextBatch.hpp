@@ -0,0 +1,203 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TEXTBATCH_HPP
+#define SFML_TEXTBATCH_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Shader;
+class Text;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Draws many texts with one draw call per glyph page
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextBatch : public Drawable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty batch.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a text to the batch
+    ///
+    /// The text is not copied, it must exist until it is removed
+    /// or the batch is cleared; its changes are picked up when
+    /// the batch is drawn. Adding a text twice does nothing.
+    ///
+    /// \param text Text to add
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(const Text& text);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a text from the batch
+    ///
+    /// \param text Text to remove
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(const Text& text);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the texts from the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of texts in the batch
+    ///
+    /// \return Number of texts
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getTextCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the texts to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the vertices of the texts that changed
+    ///
+    ////////////////////////////////////////////////////////////
+    void update() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the page of a texture and shader, or create it
+    ///
+    /// \param texture Glyph texture of the page
+    /// \param shader  Default shader of the texts of the page
+    ///
+    /// \return Index of the page
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPage(const Texture* texture, const Shader* shader) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Text of the batch, and where its vertices are
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Label
+    {
+        const Text* text;        ///< Text drawn by the label
+        Uint64      revision;    ///< Revision of the text's vertices when they were copied
+        Transform   transform;   ///< Transform of the text when its vertices were copied
+        std::size_t page;        ///< Page containing the vertices of the label
+        std::size_t firstVertex; ///< Index of the first vertex of the label in its page
+        std::size_t vertexCount; ///< Number of vertices of the label
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Vertices of all the labels that use the same glyph texture
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Page
+    {
+        const Texture*      texture;  ///< Glyph texture of the page
+        const Shader*       shader;   ///< Shader used when none is given (distance field fonts)
+        std::vector<Vertex> vertices; ///< Transformed vertices of the labels, in label order
+        bool                rebuild;  ///< Must the vertices be gathered again?
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    mutable std::vector<Label> m_labels; ///< Texts of the batch, in the order they were added
+    mutable std::vector<Page>  m_pages;  ///< Vertex streams, one per glyph texture
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTBATCH_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextBatch
+/// \ingroup graphics
+///
+/// Each sf::Text is a separate draw call. All the texts that
+/// use the same font and character size share the same glyph
+/// texture though, so a sf::TextBatch can gather their
+/// vertices, already transformed, into a single vertex stream
+/// per texture and draw hundreds of labels at the cost of a
+/// few draw calls.
+///
+/// The batch keeps the vertices from one draw to the next:
+/// only the texts whose string, style, color or transform
+/// changed are copied again. If their number of vertices is
+/// the same, they are updated in place; otherwise the stream
+/// of their texture is rebuilt.
+///
+/// The texts of a page are drawn in the order they were added,
+/// and the pages in the order they were first used.
+///
+/// Usage example:
+/// \code
+/// std::vector<sf::Text> labels(500, sf::Text("", font, 14));
+///
+/// sf::TextBatch batch;
+/// for (std::size_t i = 0; i < labels.size(); ++i)
+///     batch.add(labels[i]);
+///
+/// while (window.isOpen())
+/// {
+///     ...
+///     labels[42].setString("Score: 1000");
+///     labels[43].setPosition(100, 200);
+///
+///     window.clear();
+///     window.draw(batch);
+///     window.display();
+/// }
+/// \endcode
+///
+/// \see sf::Text
+///
+////////////////////////////////////////////////////////////
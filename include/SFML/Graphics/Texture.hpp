@@ -31,6 +31,7 @@
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Image.hpp>
 #include <SFML/Window/GlResource.hpp>
+#include <SFML/System/ResourceMemory.hpp>
 
 
 namespace sf
@@ -40,6 +41,11 @@ class RenderTarget;
 class RenderTexture;
 class InputStream;
 
+namespace priv
+{
+    struct CompressedImage;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Image living on the graphics card that can be used for drawing
 ///
@@ -85,15 +91,25 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Create the texture
     ///
+    /// The \a format defines how the pixels are stored on the
+    /// graphics card: one and two channel formats and 16 bits
+    /// colors use 4 or 2 times less video memory than RGBA8,
+    /// half floats store HDR colors. Gray level formats are
+    /// sampled as opaque gray (R8) or gray with alpha (RG8)
+    /// colors, like the RGBA pixels they stand for.
+    /// If the format is not supported by the graphics driver
+    /// (see isFormatSupported), the creation fails.
+    ///
     /// If this function fails, the texture is left unchanged.
     ///
     /// \param width  Width of the texture
     /// \param height Height of the texture
+    /// \param format Format of the pixels
     ///
     /// \return True if creation was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool create(unsigned int width, unsigned int height);
+    bool create(unsigned int width, unsigned int height, PixelFormat::Type format = PixelFormat::RGBA8);
 
     ////////////////////////////////////////////////////////////
     /// \brief Load the texture from a file on disk
@@ -101,10 +117,14 @@ public:
     /// This function is a shortcut for the following code:
     /// \code
     /// sf::Image image;
-    /// image.loadFromFile(filename);
-    /// texture.loadFromImage(image, area);
+    /// image.setExpandOnLoad(false);
+    /// image.loadFromFile(filename, area);
+    /// texture.loadFromImage(image);
     /// \endcode
     ///
+    /// Grayscale files are therefore stored in the R8 or RG8
+    /// formats when the graphics driver supports them.
+    ///
     /// The \a area argument can be used to load only a sub-rectangle
     /// of the whole image. If you want the entire image then leave
     /// the default value (which is an empty IntRect).
@@ -113,6 +133,9 @@ public:
     ///
     /// The maximum size for a texture depends on the graphics
     /// driver and can be retrieved with the getMaximumSize function.
+    /// Images bigger than that can be split into several textures,
+    /// each one loaded from its own area: for jpg and qoi files, only
+    /// the pixels of the area are kept in memory while decoding.
     ///
     /// If this function fails, the texture is left unchanged.
     ///
@@ -126,6 +149,72 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromFile(const std::string& filename, const IntRect& area = IntRect());
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading the texture from a file in the background
+    ///
+    /// This function returns immediately: the file is decoded by
+    /// the pool of worker threads of sf::Image::loadFromFileAsync,
+    /// and the pixels are uploaded like with loadFromImageAsync()
+    /// when isReady() finds that the decoding is over. Uploading
+    /// the textures which are ready while the other files are
+    /// still being decoded keeps both the CPU cores and the
+    /// graphics driver busy. The texture must not be used until
+    /// isReady() returns true.
+    ///
+    /// \param filename Path of the image file to load
+    /// \param area     Area of the image to load
+    ///
+    /// \return True if the loading started
+    ///
+    /// \see isReady, loadFromFile
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromFileAsync(const std::string& filename, const IntRect& area = IntRect());
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start uploading the texture from an image in the background
+    ///
+    /// This function returns immediately: the image is copied,
+    /// and uploaded to a new texture by a thread which has its
+    /// own OpenGL context, so that the pixels transfer doesn't
+    /// stall the rendering thread. The upload is followed by a
+    /// fence, and isReady() replaces the content of the texture
+    /// with the new one once the graphics driver signals that
+    /// the transfer is complete. Until then, the texture keeps
+    /// its previous content.
+    ///
+    /// Fences require OpenGL 3.2 (or ARB_sync); without them,
+    /// this function is the same as loadFromImage().
+    ///
+    /// \param image Image to load into the texture
+    /// \param area  Area of the image to load
+    ///
+    /// \return True if the upload started
+    ///
+    /// \see isReady, loadFromImage
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromImageAsync(const Image& image, const IntRect& area = IntRect());
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the background loading is over
+    ///
+    /// This function never blocks and must be called on the
+    /// thread that uses the texture. Once the loading started by
+    /// loadFromFileAsync() or loadFromImageAsync() is over, it
+    /// puts the new pixels in the texture and returns true; if
+    /// the loading failed (the errors are written to the standard
+    /// error output), the texture is left unchanged. It always
+    /// returns true for textures loaded with the synchronous
+    /// functions.
+    ///
+    /// \return True if the loading is over, false if it is still running
+    ///
+    /// \see loadFromFileAsync, loadFromImageAsync
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReady();
+
     ////////////////////////////////////////////////////////////
     /// \brief Load the texture from a file in memory
     ///
@@ -198,6 +287,9 @@ public:
     /// If the \a area rectangle crosses the bounds of the image, it
     /// is adjusted to fit the image size.
     ///
+    /// The texture takes the format of the image if the graphics
+    /// driver supports it, RGBA8 otherwise.
+    ///
     /// The maximum size for a texture depends on the graphics
     /// driver and can be retrieved with the getMaximumSize function.
     ///
@@ -213,6 +305,69 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromImage(const Image& image, const IntRect& area = IntRect());
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from a file of pre-compressed data
+    ///
+    /// The supported containers are DDS (DXT1, DXT3 and DXT5
+    /// formats) and KTX (S3TC, ETC2/EAC and ASTC LDR formats).
+    /// The compressed blocks are uploaded to the graphics card
+    /// as they are, which is much faster than decoding an image
+    /// and uses less video memory. If the file contains a full
+    /// mipmap chain, it is uploaded as well and mipmapping is
+    /// enabled; otherwise, only the first level is used.
+    ///
+    /// The compression format must be supported by the graphics
+    /// driver, and the texture cannot be padded: its size must be
+    /// a power of two if the driver doesn't support NPOT textures.
+    /// A compressed texture cannot be modified with the update
+    /// functions.
+    ///
+    /// If this function fails, the texture is left unchanged.
+    ///
+    /// \param filename Path of the file to load
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromCompressedMemory, loadFromCompressedStream
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromCompressedFile(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from a file of pre-compressed data in memory
+    ///
+    /// See loadFromCompressedFile for the supported formats and
+    /// their restrictions.
+    ///
+    /// If this function fails, the texture is left unchanged.
+    ///
+    /// \param data Pointer to the file data in memory
+    /// \param size Size of the data to load, in bytes
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromCompressedFile, loadFromCompressedStream
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromCompressedMemory(const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from a custom stream of pre-compressed data
+    ///
+    /// See loadFromCompressedFile for the supported formats and
+    /// their restrictions.
+    ///
+    /// If this function fails, the texture is left unchanged.
+    ///
+    /// \param stream Source stream to read from
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromCompressedFile, loadFromCompressedMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromCompressedStream(sf::InputStream& stream);
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the texture
     ///
@@ -221,6 +376,16 @@ public:
     ////////////////////////////////////////////////////////////
     Vector2u getSize() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the format of the pixels of the texture
+    ///
+    /// \return Format of the pixels
+    ///
+    /// \see create, isFormatSupported
+    ///
+    ////////////////////////////////////////////////////////////
+    PixelFormat::Type getFormat() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Copy the texture pixels to an image
     ///
@@ -228,6 +393,7 @@ public:
     /// the texture's pixels from the graphics card and copies
     /// them to a new image, potentially applying transformations
     /// to pixels if necessary (texture may be padded or flipped).
+    /// The image has the format of the texture.
     ///
     /// \return Image containing the texture's pixels
     ///
@@ -240,7 +406,8 @@ public:
     /// \brief Update the whole texture from an array of pixels
     ///
     /// The \a pixel array is assumed to have the same size as
-    /// the \a area rectangle, and to contain 32-bits RGBA pixels.
+    /// the \a area rectangle, and to contain pixels of the format
+    /// of the texture (32-bits RGBA by default).
     ///
     /// No additional check is performed on the size of the pixel
     /// array, passing invalid arguments will lead to an undefined
@@ -258,7 +425,8 @@ public:
     /// \brief Update a part of the texture from an array of pixels
     ///
     /// The size of the \a pixel array must match the \a width and
-    /// \a height arguments, and it must contain 32-bits RGBA pixels.
+    /// \a height arguments, and it must contain pixels of the
+    /// format of the texture (32-bits RGBA by default).
     ///
     /// No additional check is performed on the size of the pixel
     /// array or the bounds of the area to update, passing invalid
@@ -288,6 +456,9 @@ public:
     /// passing an image bigger than the texture will lead to an
     /// undefined behavior.
     ///
+    /// The pixels are converted if the image and the texture
+    /// have different formats.
+    ///
     /// This function does nothing if the texture was not
     /// previously created.
     ///
@@ -313,6 +484,47 @@ public:
     ////////////////////////////////////////////////////////////
     void update(const Image& image, unsigned int x, unsigned int y);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the texture from another texture
+    ///
+    /// Although the source texture can be smaller than this texture,
+    /// this function is usually used for updating the whole texture.
+    /// The other overload, which has (x, y) additional arguments,
+    /// is more convenient for updating a sub-area of this texture.
+    ///
+    /// The pixels are copied on the graphics card when framebuffer
+    /// objects are supported, they are never read back to system
+    /// memory in that case.
+    ///
+    /// No additional check is performed on the size of the passed
+    /// texture, passing a texture bigger than this texture
+    /// will lead to an undefined behavior.
+    ///
+    /// This function does nothing if either texture was not
+    /// previously created.
+    ///
+    /// \param texture Source texture to copy to this texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of this texture from another texture
+    ///
+    /// No additional check is performed on the size of the texture,
+    /// passing an invalid combination of texture size and offset
+    /// will lead to an undefined behavior.
+    ///
+    /// This function does nothing if either texture was not
+    /// previously created.
+    ///
+    /// \param texture Source texture to copy to this texture
+    /// \param x       X offset in this texture where to copy the source texture
+    /// \param y       Y offset in this texture where to copy the source texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const Texture& texture, unsigned int x, unsigned int y);
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the texture from the contents of a window
     ///
@@ -410,6 +622,72 @@ public:
     ////////////////////////////////////////////////////////////
     bool isRepeated() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the restoration of the pixels
+    ///        after a loss of the OpenGL contexts
+    ///
+    /// On mobile systems, the driver may destroy the OpenGL
+    /// contexts, and all the textures with them, while the
+    /// application is in the background (see Context::getGeneration).
+    /// A lost texture is recreated the first time it is used
+    /// again, so that the textures drawn first are available
+    /// first; it keeps its size and settings, but its pixels
+    /// are lost unless it is restorable.
+    ///
+    /// A restorable texture remembers where its pixels come from:
+    /// the file and area it was loaded from, or else a copy of
+    /// its pixels compressed in system memory (losslessly, with
+    /// the QOI format, except for the precision of floating-point
+    /// formats). Updating a restorable texture updates the copy;
+    /// the pixels copied from a window or another texture must
+    /// be read back from the graphics card, restorable textures
+    /// should not be updated this way every frame.
+    /// The restoration is disabled by default.
+    ///
+    /// \param restorable True to restore the pixels after a loss, false to lose them
+    ///
+    /// \see isRestorable
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRestorable(bool restorable);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the pixels are restored after a loss
+    ///        of the OpenGL contexts
+    ///
+    /// \return True if the texture is restorable
+    ///
+    /// \see setRestorable
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isRestorable() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Generate a mipmap using the current texture data
+    ///
+    /// Mipmaps are pre-computed chains of optimized textures. Each
+    /// level of texture in a mipmap is generated by halving each of
+    /// the previous level's dimensions. This is done until the final
+    /// level has the size of 1x1. The textures generated in this process
+    /// may make use of more advanced filters which might improve the
+    /// visual quality of textures when they are applied to objects
+    /// much smaller than they are. This is known as minification.
+    /// Because fewer texels (texture elements) have to be sampled from
+    /// when heavily minified, usage of mipmaps can also improve rendering
+    /// performance in certain scenarios.
+    ///
+    /// Mipmap generation relies on the necessary OpenGL extension being
+    /// available. If it is unavailable or generation fails due to another
+    /// reason, this function will return false. Mipmap data is only valid from
+    /// the time it is generated until the next time the base level image is
+    /// modified, at which point this function will have to be called again to
+    /// regenerate it.
+    ///
+    /// \return True if mipmap generation was successful, false if unsuccessful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool generateMipmap();
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -420,6 +698,18 @@ public:
     ////////////////////////////////////////////////////////////
     Texture& operator =(const Texture& right);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the contents of this texture with those of another
+    ///
+    /// Only the OpenGL handles and the settings are exchanged,
+    /// no pixel is copied. Pending background loads follow
+    /// their texture.
+    ///
+    /// \param right Instance to swap with
+    ///
+    ////////////////////////////////////////////////////////////
+    void swap(Texture& right);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the underlying OpenGL handle of the texture.
     ///
@@ -480,10 +770,30 @@ public:
     ////////////////////////////////////////////////////////////
     static unsigned int getMaximumSize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the graphics driver supports a pixel format
+    ///
+    /// RGBA8 and RGB565 are always supported. R8 and RG8 are
+    /// supported everywhere but in core profile contexts without
+    /// texture swizzles. RGBA16F requires half float textures,
+    /// which OpenGL ES doesn't provide.
+    ///
+    /// \param format Format of the pixels
+    ///
+    /// \return True if textures can be created in this format
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isFormatSupported(PixelFormat::Type format);
+
 private:
 
+    friend class Font;
     friend class RenderTexture;
     friend class RenderTarget;
+    friend class StreamingTexture;
+    friend class TextureStream;
+    friend class TextureManager;
+    friend class PixelReadback;
 
     ////////////////////////////////////////////////////////////
     /// \brief Get a valid image size according to hardware support
@@ -500,16 +810,192 @@ private:
     ////////////////////////////////////////////////////////////
     static unsigned int getValidSize(unsigned int size);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the matrix that converts texture coordinates
+    ///        to normalized ones
+    ///
+    /// This is the matrix loaded by bind(); core-profile render
+    /// targets pass it to their shaders instead.
+    ///
+    /// \param coordinateType Type of the texture coordinates
+    /// \param matrix         Array of 16 floats that receives the matrix, in column-major order
+    ///
+    ////////////////////////////////////////////////////////////
+    void getTextureMatrix(CoordinateType coordinateType, float* matrix) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Notify the texture that its pixels were modified
+    ///
+    /// This function must be called after the pixels are
+    /// written outside of the texture's own functions, so that
+    /// the Y orientation and the render targets' cache stay
+    /// consistent.
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidatePixels();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Invalidate the mipmap if one exists
+    ///
+    /// This also resets the texture's minifying function.
+    /// This function is mainly for internal use by RenderTexture.
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateMipmap();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the size of the texture, keeping its pixels
+    ///
+    /// The current pixels are kept at the top-left corner of the
+    /// resized texture, and the new area is filled with \a background.
+    /// When framebuffer objects are available, everything is done
+    /// on the graphics card, without reading the pixels back.
+    /// This function is mainly for internal use by Font, to grow
+    /// its glyph pages.
+    ///
+    /// \param width      New width of the texture
+    /// \param height     New height of the texture
+    /// \param background Color of the new pixels
+    ///
+    /// \return True if resizing was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool resize(unsigned int width, unsigned int height, const Color& background);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy pixels between two textures on the graphics card
+    ///
+    /// The source is attached to a temporary framebuffer object
+    /// which the pixels are copied from.
+    ///
+    /// \param source      Texture to copy the pixels from
+    /// \param destination Texture to copy the pixels to
+    /// \param size        Size of the area to copy, from the top-left corner of the source
+    /// \param position    Position of the area in the destination
+    /// \param background  Color to clear the destination with first, NULL to keep its pixels
+    ///
+    /// \return True if the copy was done, false if framebuffer objects are unavailable
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool copyPixels(const Texture& source, const Texture& destination, const Vector2u& size,
+                           const Vector2u& position, const Color* background);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Halve the resolution of the texture's storage
+    ///
+    /// The storage is replaced by a filtered copy with half the
+    /// width and height, made on the graphics card. The size of
+    /// the texture doesn't change: texture coordinates are
+    /// normalized by the texture matrix, so the texture is drawn
+    /// the same way, only blurrier. The pixels can't be read or
+    /// updated anymore until the texture is loaded again.
+    /// This function is mainly for internal use by TextureManager.
+    ///
+    /// \return True if the storage was reduced, false if framebuffer blits are unavailable
+    ///
+    ////////////////////////////////////////////////////////////
+    bool reduce();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Free the texture's storage, keeping its size and settings
+    ///
+    /// The texture is drawn as if no texture was used until it
+    /// is loaded again.
+    /// This function is mainly for internal use by TextureManager.
+    ///
+    ////////////////////////////////////////////////////////////
+    void release();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the amount of graphics memory used by the texture's storage
+    ///
+    /// \return Size of the storage, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getStorageSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Report the changes of the storage size to sf::ResourceMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateAccounting();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the category under which the texture is accounted
+    ///
+    /// \param category New category of the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAccountingCategory(ResourceMemory::Category category);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload pre-compressed data to the texture
+    ///
+    /// \param image Compressed data to upload
+    ///
+    /// \return True if the upload was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromCompressedImage(const priv::CompressedImage& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Cancel the background loading of the texture, if any
+    ///
+    ////////////////////////////////////////////////////////////
+    void cancelLoading();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a change of the pixels in the source of the texture
+    ///
+    /// The source file doesn't describe the pixels anymore; the
+    /// compressed copy of a restorable texture is updated with
+    /// the new pixels, or read back from the texture when they
+    /// are not given.
+    ///
+    /// \param pixels Pixels written to the texture, in its format (NULL to read them back)
+    /// \param width  Width of the written rectangle
+    /// \param height Height of the written rectangle
+    /// \param x      X offset of the rectangle in the texture
+    /// \param y      Y offset of the rectangle in the texture
+    /// \param pitch  Number of bytes between two rows of pixels, 0 if they are contiguous
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateSource(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y, std::size_t pitch = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recreate the storage if it was lost with the OpenGL contexts
+    ///
+    /// The storage is recreated with the same size and settings,
+    /// and filled from the source of a restorable texture.
+    ///
+    ////////////////////////////////////////////////////////////
+    void restore();
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Vector2u     m_size;          ///< Public texture size
-    Vector2u     m_actualSize;    ///< Actual texture size (can be greater than public size because of padding)
-    unsigned int m_texture;       ///< Internal texture identifier
-    bool         m_isSmooth;      ///< Status of the smooth filter
-    bool         m_isRepeated;    ///< Is the texture in repeat mode?
-    mutable bool m_pixelsFlipped; ///< To work around the inconsistency in Y orientation
-    Uint64       m_cacheId;       ///< Unique number that identifies the texture to the render target's cache
+    Vector2u                 m_size;          ///< Public texture size
+    Vector2u                 m_actualSize;    ///< Actual texture size (can be greater than public size because of padding)
+    PixelFormat::Type        m_format;        ///< Format of the pixels
+    unsigned int             m_texture;       ///< Internal texture identifier
+    Uint32                   m_generation;    ///< Generation of the contexts the texture was created in
+    bool                     m_isSmooth;      ///< Status of the smooth filter
+    bool                     m_isRepeated;    ///< Is the texture in repeat mode?
+    mutable bool             m_pixelsFlipped; ///< To work around the inconsistency in Y orientation
+    bool                     m_hasMipmap;     ///< Has the mipmap been generated?
+    Uint64                   m_cacheId;       ///< Unique number that identifies the texture to the render target's cache
+    Image*                   m_loadingImage;  ///< Image being decoded in the background, if any
+    IntRect                  m_loadingArea;   ///< Area of the image being decoded to upload
+    Uint64                   m_upload;        ///< Background upload of the texture, 0 if none
+    unsigned int             m_reduction;     ///< Number of times the resolution of the storage was halved
+    mutable Uint64           m_useCount;      ///< Number of draws that used the texture (see TextureManager)
+    Uint64                   m_accountedSize; ///< Storage size last reported to ResourceMemory
+    ResourceMemory::Category m_category;      ///< Category under which the texture is accounted
+    bool                     m_restorable;    ///< Are the pixels restored after a loss of the contexts?
+    std::string              m_sourceFile;    ///< File the pixels were loaded from, empty if unknown or changed since
+    IntRect                  m_sourceArea;    ///< Area of the file that was loaded
+    bool                     m_compressed;    ///< Was the file loaded with loadFromCompressedFile?
+    std::vector<Uint8>       m_sourcePixels;  ///< Pixels of a restorable texture not loaded from a file, compressed in QOI (empty if blank)
 };
 
 } // namespace sf
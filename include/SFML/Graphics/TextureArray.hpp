@@ -0,0 +1,331 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TEXTUREARRAY_HPP
+#define SFML_TEXTUREARRAY_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+
+
+namespace sf
+{
+class Image;
+
+////////////////////////////////////////////////////////////
+/// \brief Stack of same-sized images living on the graphics card
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureArray : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty texture array.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureArray();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TextureArray();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the texture array
+    ///
+    /// All the layers have the same size. Their contents are
+    /// undefined until they are updated.
+    ///
+    /// If this function fails, the texture array is left unchanged.
+    ///
+    /// \param width  Width of each layer, in pixels
+    /// \param height Height of each layer, in pixels
+    /// \param layers Number of layers
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, unsigned int layers);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the layers
+    ///
+    /// \return Size of each layer, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the number of layers
+    ///
+    /// \return Number of layers
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getLayerCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a whole layer from an array of pixels
+    ///
+    /// The \a pixel array is assumed to have the same size as
+    /// the layers, and to contain 32-bits RGBA pixels.
+    ///
+    /// This function does nothing if \a pixels is null or if the
+    /// texture array was not previously created.
+    ///
+    /// \param pixels Array of pixels to copy to the layer
+    /// \param layer  Index of the layer to update
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const Uint8* pixels, unsigned int layer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of a layer from an array of pixels
+    ///
+    /// The size of the \a pixel array must match the \a width and
+    /// \a height arguments, and it must contain 32-bits RGBA pixels.
+    ///
+    /// No additional check is performed on the size of the pixel
+    /// array or the bounds of the area to update, passing invalid
+    /// arguments will lead to an undefined behavior.
+    ///
+    /// This function does nothing if \a pixels is null or if the
+    /// texture array was not previously created.
+    ///
+    /// \param pixels Array of pixels to copy to the layer
+    /// \param width  Width of the pixel region contained in \a pixels
+    /// \param height Height of the pixel region contained in \a pixels
+    /// \param x      X offset in the layer where to copy the source pixels
+    /// \param y      Y offset in the layer where to copy the source pixels
+    /// \param layer  Index of the layer to update
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y, unsigned int layer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a layer from an image
+    ///
+    /// The image is copied at the top-left corner of the layer,
+    /// it must not be bigger than the layers.
+    ///
+    /// \param image Image to copy to the layer
+    /// \param layer Index of the layer to update
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const Image& image, unsigned int layer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of a layer from an image
+    ///
+    /// No additional check is performed on the size of the image,
+    /// passing an invalid combination of image size and offset
+    /// will lead to an undefined behavior.
+    ///
+    /// \param image Image to copy to the layer
+    /// \param x     X offset in the layer where to copy the source image
+    /// \param y     Y offset in the layer where to copy the source image
+    /// \param layer Index of the layer to update
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const Image& image, unsigned int x, unsigned int y, unsigned int layer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the smooth filter
+    ///
+    /// The smooth filter is disabled by default.
+    ///
+    /// \param smooth True to enable smoothing, false to disable it
+    ///
+    /// \see isSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSmooth(bool smooth);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the smooth filter is enabled or not
+    ///
+    /// \return True if smoothing is enabled, false if it is disabled
+    ///
+    /// \see setSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSmooth() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable repeating
+    ///
+    /// Repeating applies to each layer separately, texture
+    /// coordinates never wrap to another layer.
+    /// Repeating is disabled by default.
+    ///
+    /// \param repeated True to repeat the layers, false to disable repeating
+    ///
+    /// \see isRepeated
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRepeated(bool repeated);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the layers are repeated or not
+    ///
+    /// \return True if repeat mode is enabled, false if it is disabled
+    ///
+    /// \see setRepeated
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isRepeated() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the underlying OpenGL handle of the texture array
+    ///
+    /// You shouldn't need to use this function, unless you have
+    /// very specific stuff to implement that SFML doesn't support,
+    /// or implement a temporary workaround until a bug is fixed.
+    ///
+    /// \return OpenGL handle of the texture array or 0 if not yet created
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getNativeHandle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a texture array for rendering
+    ///
+    /// This function is not part of the graphics API, it mustn't be
+    /// used when drawing SFML entities. It must be used only if you
+    /// mix sf::TextureArray with OpenGL code. Texture arrays are
+    /// bound to the active texture unit. Passing NULL unbinds the
+    /// current texture array.
+    ///
+    /// \param textureArray Pointer to the texture array to bind, can be null
+    ///
+    ////////////////////////////////////////////////////////////
+    static void bind(const TextureArray* textureArray);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of layers allowed
+    ///
+    /// \return Maximum number of layers allowed
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getMaximumLayerCount();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports texture arrays
+    ///
+    /// This function should always be called before using
+    /// texture arrays; if it returns false, then any attempt
+    /// to create one will fail.
+    ///
+    /// \return True if texture arrays are supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the filtering and wrapping parameters
+    ///
+    /// The texture array must be bound.
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyParameters() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2u     m_size;       ///< Size of each layer
+    unsigned int m_layerCount; ///< Number of layers
+    unsigned int m_texture;    ///< Internal texture identifier
+    bool         m_isSmooth;   ///< Status of the smooth filter
+    bool         m_isRepeated; ///< Is the texture array in repeat mode?
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREARRAY_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureArray
+/// \ingroup graphics
+///
+/// sf::TextureArray is a stack of images of identical size,
+/// stored as a single OpenGL texture (GL_TEXTURE_2D_ARRAY).
+/// Since all the layers share the same binding, geometry that
+/// uses different layers -- for example the tiles of a large
+/// map that wouldn't fit in a single atlas -- can be drawn
+/// together, in the same draw call.
+///
+/// The layer of each vertex is given by the sf::LayeredVertex::layer
+/// member, which is passed to OpenGL as the third texture
+/// coordinate. Texture arrays can't be sampled by the fixed
+/// pipeline, they must be assigned to a shader which reads
+/// them with a sampler2DArray (see Shader::setParameter).
+///
+/// Usage example:
+/// \code
+/// // The fragment shader: texture coordinates are in pixels
+/// const char* fragmentShader =
+///     "#extension GL_EXT_texture_array : enable\n"
+///     "uniform sampler2DArray layers;"
+///     "uniform vec2 size;"
+///     "void main()"
+///     "{"
+///     "    vec3 coords = vec3(gl_TexCoord[0].xy / size, gl_TexCoord[0].z);"
+///     "    gl_FragColor = gl_Color * texture2DArray(layers, coords);"
+///     "}";
+///
+/// // Load the tile sets into the layers
+/// sf::TextureArray tiles;
+/// tiles.create(512, 512, 8);
+/// for (unsigned int i = 0; i < 8; ++i)
+///     tiles.update(tileSets[i], i);
+///
+/// sf::Shader shader;
+/// shader.loadFromMemory(fragmentShader, sf::Shader::Fragment);
+/// shader.setParameter("layers", tiles);
+/// shader.setParameter("size", sf::Vector2f(tiles.getSize()));
+///
+/// // Build the map, each vertex references the layer of its tile
+/// std::vector<sf::LayeredVertex> map;
+/// map.push_back(sf::LayeredVertex(position, sf::Color::White, texCoords, layer));
+/// ...
+///
+/// // Draw all the tiles at once
+/// window.draw(&map[0], map.size(), sf::Triangles, &shader);
+/// \endcode
+///
+/// \see sf::Texture, sf::LayeredVertex, sf::Shader
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,273 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TEXTUREATLAS_HPP
+#define SFML_TEXTUREATLAS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class Image;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Packs many images into a few large textures
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureAtlas : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Location of an image inside the atlas
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Region
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        ////////////////////////////////////////////////////////////
+        Region();
+
+        const Texture* texture; ///< Texture of the page containing the image
+        unsigned int   page;    ///< Index of the page containing the image
+        IntRect        rect;    ///< Rectangle of the image in the texture, in pixels
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param pageSize Initial width and height of the pages, in pixels
+    /// \param padding  Empty space left around each image, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit TextureAtlas(unsigned int pageSize = 512, unsigned int padding = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TextureAtlas();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an image to the atlas
+    ///
+    /// The image is packed in the first page where it fits.
+    /// If it fits in none of them, the last page is made twice
+    /// bigger, up to the maximum texture size (see
+    /// Texture::getMaximumSize), and a new page is created when
+    /// it can't grow anymore.
+    ///
+    /// Regions stay valid when a page grows: the texture
+    /// keeps its address and the images keep their position.
+    /// The returned region can be used directly with
+    /// Sprite::setTexture and Sprite::setTextureRect.
+    ///
+    /// \param image  Image to add
+    /// \param region Receives the location of the image in the atlas
+    ///
+    /// \return True if the image was successfully added
+    ///
+    ////////////////////////////////////////////////////////////
+    bool add(const Image& image, Region& region);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load an image from a file and add it to the atlas
+    ///
+    /// \param filename Path of the image file to load
+    /// \param region   Receives the location of the image in the atlas
+    ///
+    /// \return True if the image was successfully loaded and added
+    ///
+    /// \see add
+    ///
+    ////////////////////////////////////////////////////////////
+    bool addFromFile(const std::string& filename, Region& region);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the pages and images
+    ///
+    /// All the regions returned so far become invalid.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of pages
+    ///
+    /// \return Number of pages (textures) of the atlas
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getPageCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture of a page
+    ///
+    /// This function doesn't check \a page, it must be in range
+    /// [0, getPageCount() - 1]. The behavior is undefined
+    /// otherwise.
+    ///
+    /// \param page Index of the page
+    ///
+    /// \return Texture of the page
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture(unsigned int page) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the smooth filter on all the pages
+    ///
+    /// This applies to existing pages and to the ones that
+    /// will be created. The padding around images should be
+    /// at least 1 pixel when smoothing is enabled, to avoid
+    /// bleeding between neighbour images.
+    ///
+    /// \param smooth True to enable smoothing, false to disable it
+    ///
+    /// \see isSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSmooth(bool smooth);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the smooth filter is enabled or not
+    ///
+    /// \return True if smoothing is enabled, false if it is disabled
+    ///
+    /// \see setSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSmooth() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Horizontal segment of the skyline
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Segment
+    {
+        Segment(unsigned int x, unsigned int y, unsigned int width);
+
+        unsigned int x;     ///< Left coordinate of the segment
+        unsigned int y;     ///< Height of the skyline over the segment
+        unsigned int width; ///< Width of the segment
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Page of the atlas: a texture and its skyline
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Page;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a new page
+    ///
+    /// \param minimumSize Minimum width and height of the page
+    ///
+    /// \return Pointer to the new page, or NULL on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    Page* createPage(unsigned int minimumSize);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find a location for a rectangle in a page
+    ///
+    /// \param page   Page to search
+    /// \param width  Width of the rectangle
+    /// \param height Height of the rectangle
+    /// \param rect   Receives the location of the rectangle
+    ///
+    /// \return True if the rectangle fits in the page
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool findRect(Page& page, unsigned int width, unsigned int height, IntRect& rect);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make a page two times bigger, if possible
+    ///
+    /// \param page Page to grow
+    ///
+    /// \return True if the page was resized
+    ///
+    ////////////////////////////////////////////////////////////
+    bool growPage(Page& page);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Page*> m_pages;    ///< Pages of the atlas
+    unsigned int       m_pageSize; ///< Initial size of the pages
+    unsigned int       m_padding;  ///< Space left around each image
+    bool               m_isSmooth; ///< Status of the smooth filter
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREATLAS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureAtlas
+/// \ingroup graphics
+///
+/// Drawing sprites that use different textures forces the
+/// graphics card to switch textures between them, which
+/// prevents draw calls from being merged and costs time
+/// even when they aren't. sf::TextureAtlas solves this by
+/// packing many small images into a few large textures
+/// (pages), so that most sprites share the same texture.
+///
+/// Images are packed with a skyline bottom-left algorithm,
+/// which is fast and wastes little space for images of
+/// similar heights. When a page is full it grows, and new
+/// pages are added when the maximum texture size is reached.
+///
+/// Usage example:
+/// \code
+/// sf::TextureAtlas atlas;
+///
+/// sf::TextureAtlas::Region hero, tree;
+/// atlas.addFromFile("hero.png", hero);
+/// atlas.addFromFile("tree.png", tree);
+///
+/// sf::Sprite sprite;
+/// sprite.setTexture(*hero.texture);
+/// sprite.setTextureRect(hero.rect);
+/// \endcode
+///
+/// \see sf::Texture, sf::Sprite
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,274 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TEXTUREMANAGER_HPP
+#define SFML_TEXTUREMANAGER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <map>
+#include <string>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Keeps the textures loaded from files within a
+///        graphics memory budget
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureManager : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief State of the managed textures, and what the
+    ///        manager did to them
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Statistics
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        ////////////////////////////////////////////////////////////
+        Statistics();
+
+        std::size_t textures;         ///< Number of managed textures
+        std::size_t reducedTextures;  ///< Textures whose resolution is currently reduced
+        std::size_t evictedTextures;  ///< Textures currently out of graphics memory
+        std::size_t loadingTextures;  ///< Textures currently being reloaded
+        Uint64      residentBytes;    ///< Graphics memory used by the managed textures
+        Uint64      reductions;       ///< Number of times a resolution was halved
+        Uint64      evictions;        ///< Number of times a texture was evicted
+        Uint64      reloads;          ///< Number of textures reloaded from their file
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The budget is unlimited by default.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureManager();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// All the managed textures are destroyed.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TextureManager();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture of an image file
+    ///
+    /// The file is loaded synchronously the first time that it
+    /// is requested; if the loading fails (the errors are
+    /// written to the standard error output), an empty texture
+    /// is returned. When the texture was reduced or evicted, its
+    /// reloading is started and the texture is returned as it is.
+    ///
+    /// The texture stays valid until it is unloaded or the manager
+    /// is destroyed. Its smooth and repeated settings are kept
+    /// when it is reloaded, other changes made to it are lost.
+    ///
+    /// \param filename Path of the image file
+    ///
+    /// \return Texture of the file
+    ///
+    ////////////////////////////////////////////////////////////
+    Texture& get(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the texture of an image file
+    ///
+    /// \param filename Path of the image file
+    ///
+    ////////////////////////////////////////////////////////////
+    void unload(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the amount of graphics memory that the textures can use
+    ///
+    /// When the textures use more, the ones which were not drawn
+    /// for the longest time first have their resolution halved
+    /// (up to the maximum reduction), then are evicted from
+    /// graphics memory. The textures drawn during the last frame
+    /// are never touched, so the budget can be exceeded.
+    ///
+    /// \param bytes Budget in bytes, 0 for no limit
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBudget(Uint64 bytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the amount of graphics memory that the textures can use
+    ///
+    /// \return Budget in bytes, 0 if there's no limit
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getBudget() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set how many times the resolution of a texture can
+    ///        be halved before the texture is evicted
+    ///
+    /// Each reduction divides the memory of the texture by 4.
+    /// With 0, textures are evicted directly. The default is 2.
+    ///
+    /// \param levels Maximum number of reductions
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMaxReduction(unsigned int levels);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get how many times the resolution of a texture can be halved
+    ///
+    /// \return Maximum number of reductions
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getMaxReduction() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief End the current frame
+    ///
+    /// This function must be called once per frame, by the
+    /// thread that draws the textures. It records which textures
+    /// were drawn, starts reloading the reduced or evicted ones
+    /// that were drawn, uploads the reloads that are over, and
+    /// reduces or evicts textures if the budget is exceeded.
+    ///
+    ////////////////////////////////////////////////////////////
+    void update();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the state of the managed textures
+    ///
+    /// \return Statistics of the manager
+    ///
+    ////////////////////////////////////////////////////////////
+    Statistics getStatistics() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Texture of a file, and its history
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        Texture     texture;  ///< Texture of the file
+        std::string filename; ///< Path of the file to reload the texture from
+        Uint64      useCount; ///< Draw count of the texture at the previous update
+        Uint64      lastUse;  ///< Last frame in which the texture was drawn or requested
+        bool        loading;  ///< Is the texture being reloaded?
+        bool        failed;   ///< Did the last reload fail?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start reloading a texture from its file
+    ///
+    /// \param entry Texture to reload
+    ///
+    ////////////////////////////////////////////////////////////
+    void reload(Entry& entry);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reduce or evict textures until the budget is met
+    ///
+    ////////////////////////////////////////////////////////////
+    void enforceBudget();
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::map<std::string, Entry*> EntryTable;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    EntryTable   m_entries;      ///< Managed textures, indexed by file
+    Uint64       m_budget;       ///< Graphics memory that the textures can use, 0 for no limit
+    unsigned int m_maxReduction; ///< Number of times a resolution can be halved before eviction
+    Uint64       m_frame;        ///< Index of the current frame
+    Statistics   m_statistics;   ///< Counters of the reductions, evictions and reloads
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREMANAGER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureManager
+/// \ingroup graphics
+///
+/// When a game has more texture data than the graphics memory
+/// can hold, the textures that are not visible must leave room
+/// for the others. sf::TextureManager loads textures from image
+/// files, and watches which ones are drawn: every draw made by
+/// a sf::RenderTarget with a texture counts as a use.
+///
+/// When the textures use more memory than the budget, the
+/// least recently drawn textures are reduced first: their
+/// resolution is halved on the graphics card, so they still
+/// look right (only blurrier) if they come back in view.
+/// Textures that reached the maximum reduction are evicted,
+/// and draw nothing until they're reloaded.
+///
+/// Reduced and evicted textures are reloaded from their file,
+/// in the background, as soon as they are drawn or requested
+/// again; the reduced version is drawn until the reload is over.
+///
+/// The pixels of a reduced or evicted texture can't be read,
+/// and copying such a texture gives an undefined result. The
+/// textures bound to a sf::Shader as variables don't count as
+/// uses, they must be requested with get() every frame.
+///
+/// Usage example:
+/// \code
+/// sf::TextureManager textures;
+/// textures.setBudget(256 * 1024 * 1024);
+///
+/// while (window.isOpen())
+/// {
+///     ...
+///     window.clear();
+///     for (std::size_t i = 0; i < visibleObjects.size(); ++i)
+///         window.draw(sf::Sprite(textures.get(visibleObjects[i].image)));
+///     window.display();
+///
+///     textures.update();
+/// }
+/// \endcode
+///
+/// \see sf::Texture
+///
+////////////////////////////////////////////////////////////
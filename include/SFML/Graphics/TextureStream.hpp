@@ -0,0 +1,217 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TEXTURESTREAM_HPP
+#define SFML_TEXTURESTREAM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Asynchronous streaming of pixels to textures
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextureStream : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty stream, create() must be called
+    /// before it can be used.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TextureStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the stream's buffers
+    ///
+    /// Each buffer holds \a width x \a height RGBA pixels.
+    /// Buffers are used in turn, so that the pixels of the
+    /// next frame can be written while the graphics card is
+    /// still transferring the previous ones. 2 or 3 buffers
+    /// are usually enough.
+    ///
+    /// If pixel buffer objects are not available (see
+    /// isAvailable()), a single buffer in system memory is
+    /// used and uploads are synchronous.
+    ///
+    /// \param width       Width of the uploaded areas, in pixels
+    /// \param height      Height of the uploaded areas, in pixels
+    /// \param bufferCount Number of buffers in the ring
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height, unsigned int bufferCount = 3);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the uploaded areas
+    ///
+    /// \return Size in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a pointer to the memory of the next buffer
+    ///
+    /// The returned array has room for getSize().x * getSize().y
+    /// RGBA pixels, which must be written before unmap() is
+    /// called. It can only be written to, reading it may be
+    /// extremely slow. The pointer becomes invalid after unmap().
+    ///
+    /// \return Pointer to the buffer memory, or NULL on failure
+    ///
+    /// \see unmap
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint8* map();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the buffer and upload its pixels to a texture
+    ///
+    /// The transfer is queued and performed by the graphics
+    /// card asynchronously; this function returns immediately.
+    /// The area to update must fit in the texture, this is
+    /// not checked.
+    ///
+    /// \param texture Texture to update
+    /// \param x       X offset in the texture where to copy the pixels
+    /// \param y       Y offset in the texture where to copy the pixels
+    ///
+    /// \see map
+    ///
+    ////////////////////////////////////////////////////////////
+    void unmap(Texture& texture, unsigned int x = 0, unsigned int y = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy pixels to the next buffer and upload them to a texture
+    ///
+    /// This is a shortcut for map(), a copy of the pixels and
+    /// unmap(). Writing directly to the mapped buffer avoids
+    /// the copy when the pixels are produced on the fly.
+    ///
+    /// \param texture Texture to update
+    /// \param pixels  Array of getSize().x * getSize().y RGBA pixels
+    /// \param x       X offset in the texture where to copy the pixels
+    /// \param y       Y offset in the texture where to copy the pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(Texture& texture, const Uint8* pixels, unsigned int x = 0, unsigned int y = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports asynchronous uploads
+    ///
+    /// Asynchronous uploads require pixel buffer objects. When
+    /// they are not supported, the stream falls back to regular
+    /// synchronous updates.
+    ///
+    /// \return True if asynchronous uploads are supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the buffers
+    ///
+    ////////////////////////////////////////////////////////////
+    void cleanup();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<unsigned int> m_buffers; ///< Ring of pixel buffer objects
+    std::vector<Uint8>        m_pixels;  ///< Fallback buffer in system memory
+    Vector2u                  m_size;    ///< Size of the uploaded areas
+    std::size_t               m_current; ///< Index of the next buffer to use
+    Uint8*                    m_mapped;  ///< Pointer to the currently mapped memory, if any
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTURESTREAM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextureStream
+/// \ingroup graphics
+///
+/// Texture::update copies pixels from system memory
+/// synchronously: the program waits until the driver has
+/// consumed them. For videos and other content that changes
+/// every frame, this stall can take a large part of the frame.
+///
+/// sf::TextureStream writes pixels into pixel buffer objects
+/// owned by the driver, and lets the graphics card transfer
+/// them to the texture asynchronously. A ring of buffers is
+/// used so that the next frame can be written while the
+/// previous one is still being transferred.
+///
+/// Usage example:
+/// \code
+/// sf::Texture texture;
+/// texture.create(640, 480);
+///
+/// sf::TextureStream stream;
+/// stream.create(640, 480);
+///
+/// while (window.isOpen())
+/// {
+///     // Decode the next video frame directly into the stream
+///     sf::Uint8* pixels = stream.map();
+///     if (pixels)
+///         decoder.decodeFrame(pixels);
+///     stream.unmap(texture);
+///
+///     window.clear();
+///     window.draw(sf::Sprite(texture));
+///     window.display();
+/// }
+/// \endcode
+///
+/// \see sf::Texture
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,348 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TILEMAP_HPP
+#define SFML_TILEMAP_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Grid of tiles taken from a tileset texture, drawn
+///        from cached chunks of geometry
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TileMap : public Drawable, public Transformable, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    // Static member data
+    ////////////////////////////////////////////////////////////
+    static const Uint32 NoTile; ///< Value of the cells that don't contain any tile
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty tile map with no tileset texture.
+    ///
+    ////////////////////////////////////////////////////////////
+    TileMap();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TileMap();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the dimensions of the map
+    ///
+    /// All the cells of all the layers are reset to NoTile.
+    ///
+    /// \param size       Number of tiles of the map, horizontally and vertically
+    /// \param tileSize   Size of a tile, in pixels of the tileset
+    /// \param layerCount Number of layers of tiles, drawn in order
+    ///
+    ////////////////////////////////////////////////////////////
+    void create(const Vector2u& size, const Vector2u& tileSize, std::size_t layerCount = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of tiles of the map
+    ///
+    /// \return Number of tiles, horizontally and vertically
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of a tile
+    ///
+    /// \return Size of a tile, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getTileSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of layers of the map
+    ///
+    /// \return Number of layers
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getLayerCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the tileset texture
+    ///
+    /// The tiles are numbered from left to right and from top
+    /// to bottom in the tileset, starting at 0.
+    /// The \a texture argument refers to a texture that must
+    /// exist as long as the tile map uses it.
+    ///
+    /// \param texture Tileset texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the tileset texture
+    ///
+    /// \return Pointer to the tileset texture, or NULL if none was set
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a tile of the map
+    ///
+    /// Only the chunk containing the cell is rebuilt, the next
+    /// time that it is drawn.
+    /// The coordinates and the layer must be in range, the
+    /// behavior is undefined otherwise.
+    ///
+    /// \param x     Column of the cell
+    /// \param y     Row of the cell
+    /// \param tile  Index of the tile in the tileset, or NoTile
+    /// \param layer Layer of the cell
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTile(unsigned int x, unsigned int y, Uint32 tile, std::size_t layer = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a tile of the map
+    ///
+    /// \param x     Column of the cell
+    /// \param y     Row of the cell
+    /// \param layer Layer of the cell
+    ///
+    /// \return Index of the tile in the tileset, or NoTile
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 getTile(unsigned int x, unsigned int y, std::size_t layer = 0) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set all the cells of a layer to the same tile
+    ///
+    /// \param tile  Index of the tile in the tileset, or NoTile
+    /// \param layer Layer to fill
+    ///
+    ////////////////////////////////////////////////////////////
+    void fill(Uint32 tile, std::size_t layer = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Animate a tile
+    ///
+    /// The frames of the animation are the tiles that follow
+    /// \a tile in the tileset, on the same row: \a tile,
+    /// \a tile + 1, ..., \a tile + \a frameCount - 1.
+    /// All the cells showing \a tile are animated. Setting a
+    /// frame count of 1 or less removes the animation.
+    ///
+    /// The frame count is limited to 255, and the frame
+    /// duration to 65 seconds.
+    ///
+    /// \param tile          First tile of the animation
+    /// \param frameCount    Number of frames of the animation
+    /// \param frameDuration Duration of each frame
+    ///
+    /// \see setAnimationTime
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAnimation(Uint32 tile, unsigned int frameCount, Time frameDuration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the time of the animations
+    ///
+    /// The animated tiles show the frame corresponding to this
+    /// time, typically the time elapsed since the start of the
+    /// level.
+    ///
+    /// \param time Current time of the animations
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAnimationTime(Time time);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the map
+    ///
+    /// \return Local bounding rectangle of the map
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global bounding rectangle of the map
+    ///
+    /// \return Global bounding rectangle of the map
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getGlobalBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the visible chunks to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Animation of a tile
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Animation
+    {
+        unsigned int frameCount;    ///< Number of frames
+        Uint32       frameDuration; ///< Duration of a frame, in milliseconds
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Square block of cells with its own geometry
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Chunk
+    {
+        Chunk();
+
+        VertexBuffer        buffer;        ///< Geometry of all the layers, when vertex buffers are available
+        std::vector<Vertex> vertices;      ///< Geometry of all the layers, when vertex buffers are not available
+        std::size_t         vertexCount;   ///< Number of vertices of the geometry
+        bool                needsUpdate;   ///< Does the geometry need to be rebuilt?
+        bool                animated;      ///< Does the chunk contain animated tiles?
+        bool                gpuAnimation;  ///< Are the animated tiles encoded for the animation shader?
+        Int64               animationTime; ///< Animation time of the frames baked into the geometry
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rebuild the geometry of a chunk
+    ///
+    /// \param chunkX       Column of the chunk
+    /// \param chunkY       Row of the chunk
+    /// \param gpuAnimation Encode the animations for the shader, rather than baking the current frame?
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateChunk(unsigned int chunkX, unsigned int chunkY, bool gpuAnimation) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark all the chunks as outdated
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateChunks();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2u                    m_size;            ///< Number of tiles, horizontally and vertically
+    Vector2u                    m_tileSize;        ///< Size of a tile, in pixels
+    std::size_t                 m_layerCount;      ///< Number of layers
+    const Texture*              m_texture;         ///< Tileset texture
+    mutable Vector2u            m_textureSize;     ///< Size of the tileset that the chunks were built for
+    std::vector<Uint32>         m_tiles;           ///< Tiles of all the layers, layer after layer
+    std::map<Uint32, Animation> m_animations;      ///< Animations, indexed by their first tile
+    Int64                       m_animationTime;   ///< Current time of the animations, in milliseconds
+    Int64                       m_animationPeriod; ///< Duration after which all the animations loop, in milliseconds
+    Vector2u                    m_chunkCount;      ///< Number of chunks, horizontally and vertically
+    std::vector<Chunk*>         m_chunks;          ///< Chunks, row by row
+};
+
+} // namespace sf
+
+
+#endif // SFML_TILEMAP_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TileMap
+/// \ingroup graphics
+///
+/// sf::TileMap draws a grid of tiles taken from a tileset
+/// texture. Building such a map from a sf::VertexArray means
+/// sending all its vertices to the graphics card every frame,
+/// and rebuilding the whole array when a tile changes.
+///
+/// sf::TileMap instead splits the map into square chunks of
+/// cells, each with its own geometry stored in a sf::VertexBuffer:
+/// \li only the chunks that overlap the current view are drawn,
+///     with a single draw call per chunk for all the layers
+/// \li changing a tile only rebuilds its chunk, the next time
+///     that it is visible
+/// \li the geometry of a chunk that doesn't change is never sent
+///     to the graphics card again
+/// \li maps up to 32767 pixels wide and high store their geometry
+///     as sf::CompactVertex, half the size of sf::Vertex
+///
+/// This keeps the cost of drawing a map independent of its
+/// size: a 1000x1000 map costs the same as the few chunks that
+/// fill the screen.
+///
+/// Tiles can be animated (see setAnimation). When shaders are
+/// available, the animations are done by a vertex shader which
+/// offsets the texture coordinates, so they don't rebuild any
+/// chunk. Otherwise, or when the map is drawn with a custom
+/// shader, the visible chunks that contain animated tiles are
+/// rebuilt when the animation time changes.
+///
+/// Usage example:
+/// \code
+/// sf::Texture tileset;
+/// tileset.loadFromFile("tileset.png");
+///
+/// sf::TileMap map;
+/// map.setTexture(tileset);
+/// map.create(sf::Vector2u(1000, 1000), sf::Vector2u(32, 32), 2);
+/// map.fill(0);                // grass everywhere on the ground layer
+/// map.setTile(10, 4, 17, 1);  // a tree on the upper layer
+/// map.setAnimation(8, 4, sf::milliseconds(250)); // water
+///
+/// sf::Clock clock;
+/// while (window.isOpen())
+/// {
+///     ...
+///     map.setAnimationTime(clock.getElapsedTime());
+///     window.draw(map);
+/// }
+/// \endcode
+///
+/// \see sf::VertexBuffer, sf::Texture
+///
+////////////////////////////////////////////////////////////
@@ -31,6 +31,7 @@
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/System/Vector2.hpp>
+#include <cstddef>
 
 
 namespace sf
@@ -118,6 +119,24 @@ public:
     ////////////////////////////////////////////////////////////
     Vector2f transformPoint(const Vector2f& point) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Transform an array of 2D points
+    ///
+    /// This function is equivalent to calling transformPoint
+    /// on each point, but it is much faster for large arrays
+    /// since points are processed several at a time with
+    /// SIMD instructions when the platform supports them.
+    ///
+    /// \a input and \a output may point to the same array,
+    /// in which case the points are transformed in place.
+    ///
+    /// \param input  Pointer to the points to transform
+    /// \param output Pointer to the array that receives the transformed points
+    /// \param count  Number of points to transform
+    ///
+    ////////////////////////////////////////////////////////////
+    void transformPoints(const Vector2f* input, Vector2f* output, std::size_t count) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Transform a rectangle
     ///
@@ -311,6 +311,19 @@ public:
     ////////////////////////////////////////////////////////////
     const Transform& getInverseTransform() const;
 
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called when the transform changes
+    ///
+    /// It is called every time the position, rotation, scale
+    /// or origin of the object is modified, so that derived
+    /// classes can invalidate what they compute from the
+    /// transform. The default implementation does nothing.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onTransformChanged();
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -320,6 +333,9 @@ private:
     Vector2f          m_position;                   ///< Position of the object in the 2D world
     float             m_rotation;                   ///< Orientation of the object, in degrees
     Vector2f          m_scale;                      ///< Scale of the object
+    mutable float     m_trigRotation;               ///< Rotation for which the cosine and sine were computed
+    mutable float     m_cosine;                     ///< Cosine of the rotation
+    mutable float     m_sine;                       ///< Sine of the rotation
     mutable Transform m_transform;                  ///< Combined transformation of the object
     mutable bool      m_transformNeedUpdate;        ///< Does the transform need to be recomputed?
     mutable Transform m_inverseTransform;           ///< Combined transformation of the object
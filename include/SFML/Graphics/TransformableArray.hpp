@@ -0,0 +1,292 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TRANSFORMABLEARRAY_HPP
+#define SFML_TRANSFORMABLEARRAY_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Position, rotation, scale and origin of many
+///        objects, updated all at once
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TransformableArray
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty array.
+    ///
+    ////////////////////////////////////////////////////////////
+    TransformableArray();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the array with a given number of elements
+    ///
+    /// \param count Number of elements
+    ///
+    /// \see resize
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit TransformableArray(std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the number of elements
+    ///
+    /// New elements are at position (0, 0), without rotation,
+    /// with a scale of (1, 1) and an origin of (0, 0), like a
+    /// default sf::Transformable.
+    ///
+    /// \param count New number of elements
+    ///
+    ////////////////////////////////////////////////////////////
+    void resize(std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of elements
+    ///
+    /// \return Number of elements
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the position of an element
+    ///
+    /// \param index    Index of the element
+    /// \param position New position
+    ///
+    /// \see sf::Transformable::setPosition
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPosition(std::size_t index, const Vector2f& position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the orientation of an element
+    ///
+    /// \param index Index of the element
+    /// \param angle New rotation, in degrees
+    ///
+    /// \see sf::Transformable::setRotation
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRotation(std::size_t index, float angle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the scale factors of an element
+    ///
+    /// \param index   Index of the element
+    /// \param factors New scale factors
+    ///
+    /// \see sf::Transformable::setScale
+    ///
+    ////////////////////////////////////////////////////////////
+    void setScale(std::size_t index, const Vector2f& factors);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the local origin of an element
+    ///
+    /// \param index  Index of the element
+    /// \param origin New origin
+    ///
+    /// \see sf::Transformable::setOrigin
+    ///
+    ////////////////////////////////////////////////////////////
+    void setOrigin(std::size_t index, const Vector2f& origin);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the position of an element
+    ///
+    /// \param index Index of the element
+    ///
+    /// \return Current position
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2f getPosition(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the orientation of an element
+    ///
+    /// \param index Index of the element
+    ///
+    /// \return Current rotation, in degrees, in the range [0, 360]
+    ///
+    ////////////////////////////////////////////////////////////
+    float getRotation(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the scale factors of an element
+    ///
+    /// \param index Index of the element
+    ///
+    /// \return Current scale factors
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2f getScale(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local origin of an element
+    ///
+    /// \param index Index of the element
+    ///
+    /// \return Current origin
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2f getOrigin(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move every element by its own offset
+    ///
+    /// \param offsets Array of getSize() offsets, one per element
+    ///
+    ////////////////////////////////////////////////////////////
+    void move(const Vector2f* offsets);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rotate every element by its own angle
+    ///
+    /// \param angles Array of getSize() angles in degrees, one per element
+    ///
+    ////////////////////////////////////////////////////////////
+    void rotate(const float* angles);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the combined transform of an element
+    ///
+    /// The transforms of all the modified elements are
+    /// recomputed at once, the first time one of them is
+    /// requested after a modification.
+    ///
+    /// \param index Index of the element
+    ///
+    /// \return Transform combining the position/rotation/scale/origin of the element
+    ///
+    ////////////////////////////////////////////////////////////
+    Transform getTransform(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the 2D affine transform of an element
+    ///
+    /// The six coefficients are written in row order:
+    /// (a00, a01, a02, a10, a11, a12), where the transformed
+    /// point is (a00 * x + a01 * y + a02, a10 * x + a11 * y + a12).
+    /// This is cheaper than getTransform when the full 4x4
+    /// matrix is not needed.
+    ///
+    /// \param index        Index of the element
+    /// \param coefficients Array of 6 floats to fill
+    ///
+    ////////////////////////////////////////////////////////////
+    void getAffineTransform(std::size_t index, float* coefficients) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Transform a point by the transform of an element
+    ///
+    /// \param index Index of the element
+    /// \param point Point to transform
+    ///
+    /// \return Transformed point
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2f transformPoint(std::size_t index, const Vector2f& point) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recompute the transforms if any element changed
+    ///
+    ////////////////////////////////////////////////////////////
+    void ensureUpdate() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<float>         m_positionX;          ///< X position of the elements
+    std::vector<float>         m_positionY;          ///< Y position of the elements
+    std::vector<float>         m_rotation;           ///< Rotation of the elements, in degrees
+    std::vector<float>         m_scaleX;             ///< Horizontal scale of the elements
+    std::vector<float>         m_scaleY;             ///< Vertical scale of the elements
+    std::vector<float>         m_originX;            ///< X origin of the elements
+    std::vector<float>         m_originY;            ///< Y origin of the elements
+    mutable std::vector<float> m_cosine;             ///< Cosine of the rotation of the elements
+    mutable std::vector<float> m_sine;               ///< Sine of the rotation of the elements
+    mutable std::vector<Uint8> m_rotationChanged;    ///< Does the rotation of each element need new trigonometry?
+    mutable std::vector<float> m_affine[6];          ///< Coefficients of the transforms, one array per coefficient
+    mutable bool               m_needsUpdate;        ///< Does any transform need to be recomputed?
+    mutable bool               m_anyRotationChanged; ///< Does any rotation need new trigonometry?
+};
+
+} // namespace sf
+
+
+#endif // SFML_TRANSFORMABLEARRAY_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TransformableArray
+/// \ingroup graphics
+///
+/// sf::TransformableArray manages the position, rotation,
+/// scale and origin of many objects, like as many
+/// sf::Transformable, but stores each component in its own
+/// contiguous array. When something changed, the transforms
+/// of all the elements are recomputed in a single pass that
+/// processes several elements at once with SIMD instructions,
+/// and the trigonometry is only evaluated for the elements
+/// whose rotation changed.
+///
+/// The transforms are kept as 2D affine transforms (6 floats);
+/// the 4x4 matrix of a sf::Transform is only built when
+/// getTransform is called.
+///
+/// This is most useful for large numbers of similar objects,
+/// such as particles or the instances of a sf::InstancedSprite:
+/// \code
+/// sf::TransformableArray particles(10000);
+/// std::vector<sf::Vector2f> velocities(10000);
+/// std::vector<float> spins(10000);
+/// ...
+///
+/// // Every frame
+/// particles.move(&velocities[0]);
+/// particles.rotate(&spins[0]);
+/// sprites.setInstanceTransforms(0, particles);
+/// window.draw(sprites);
+/// \endcode
+///
+/// \see sf::Transformable, sf::InstancedSprite
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,257 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TRIMMEDSPRITE_HPP
+#define SFML_TRIMMEDSPRITE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/SpriteMesh.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Sprite drawn as a polygon that skips its
+///        transparent pixels
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TrimmedSprite : public Drawable, public Transformable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty sprite with no source texture and an
+    /// empty mesh.
+    ///
+    ////////////////////////////////////////////////////////////
+    TrimmedSprite();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the sprite from a source texture and its mesh
+    ///
+    /// \param texture Source texture
+    /// \param mesh    Mesh covering the visible pixels of the texture
+    ///
+    /// \see setTexture, setMesh
+    ///
+    ////////////////////////////////////////////////////////////
+    TrimmedSprite(const Texture& texture, const SpriteMesh& mesh);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the sprite from a sub-rectangle of a source texture and its mesh
+    ///
+    /// \param texture   Source texture
+    /// \param rectangle Sub-rectangle of the texture to assign to the sprite
+    /// \param mesh      Mesh covering the visible pixels of the sub-rectangle
+    ///
+    /// \see setTexture, setTextureRect, setMesh
+    ///
+    ////////////////////////////////////////////////////////////
+    TrimmedSprite(const Texture& texture, const IntRect& rectangle, const SpriteMesh& mesh);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the source texture of the sprite
+    ///
+    /// Works like sf::Sprite::setTexture: the texture must
+    /// exist as long as the sprite uses it.
+    ///
+    /// \param texture   New texture
+    /// \param resetRect Should the texture rect be reset to the size of the new texture?
+    ///
+    /// \see getTexture, setTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture& texture, bool resetRect = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the sub-rectangle of the texture that the sprite will display
+    ///
+    /// The mesh must have been built for an area of the same
+    /// size. A flipped rectangle (negative width or height)
+    /// flips the mesh with it.
+    ///
+    /// \param rectangle Rectangle defining the region of the texture to display
+    ///
+    /// \see getTextureRect, setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTextureRect(const IntRect& rectangle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the mesh of the sprite
+    ///
+    /// The mesh is copied, it can be destroyed after the call.
+    ///
+    /// \param mesh Mesh covering the visible pixels of the texture rect
+    ///
+    /// \see getMesh
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMesh(const SpriteMesh& mesh);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the global color of the sprite
+    ///
+    /// \param color New color of the sprite
+    ///
+    /// \see getColor
+    ///
+    ////////////////////////////////////////////////////////////
+    void setColor(const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the source texture of the sprite
+    ///
+    /// \return Pointer to the sprite's texture, NULL if it has none
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sub-rectangle of the texture displayed by the sprite
+    ///
+    /// \return Texture rectangle of the sprite
+    ///
+    /// \see setTextureRect
+    ///
+    ////////////////////////////////////////////////////////////
+    const IntRect& getTextureRect() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the mesh of the sprite
+    ///
+    /// \return Mesh of the sprite
+    ///
+    /// \see setMesh
+    ///
+    ////////////////////////////////////////////////////////////
+    const SpriteMesh& getMesh() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global color of the sprite
+    ///
+    /// \return Global color of the sprite
+    ///
+    /// \see setColor
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getColor() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the entity
+    ///
+    /// The bounds are those of the whole texture rect, as for
+    /// sf::Sprite, so that the origin and the layout don't
+    /// depend on the mesh.
+    ///
+    /// \return Local bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global bounding rectangle of the entity
+    ///
+    /// \return Global bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getGlobalBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the sprite to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the positions and texture coordinates of the vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateVertices();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Vertex> m_vertices;    ///< Vertices of the mesh, as a triangle fan
+    SpriteMesh          m_mesh;        ///< Polygon covering the visible pixels
+    Color               m_color;       ///< Global color of the sprite
+    const Texture*      m_texture;     ///< Texture of the sprite
+    IntRect             m_textureRect; ///< Rectangle defining the area of the source texture to display
+};
+
+} // namespace sf
+
+
+#endif // SFML_TRIMMEDSPRITE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TrimmedSprite
+/// \ingroup graphics
+///
+/// sf::TrimmedSprite behaves like sf::Sprite, with the same
+/// texture rect, color, transform and bounds, but draws the
+/// polygon of a sf::SpriteMesh instead of the full quad: the
+/// transparent pixels outside of the polygon are not drawn at
+/// all, which saves fill rate when many large sprites overlap.
+///
+/// The texture coordinates of the vertices are taken from
+/// their position in the texture rect, so the result is the
+/// same as with sf::Sprite as long as the mesh was built from
+/// the pixels of that rect. Trimmed sprites can also be added
+/// to a sf::SpriteBatch, with other sprites of the same
+/// texture.
+///
+/// Usage example:
+/// \code
+/// sf::SpriteMesh mesh;
+/// mesh.loadFromImage(atlasImage, sf::IntRect(64, 0, 64, 64), 8);
+///
+/// sf::TrimmedSprite sprite(atlas, sf::IntRect(64, 0, 64, 64), mesh);
+/// sprite.setPosition(100, 25);
+/// window.draw(sprite);
+/// \endcode
+///
+/// \see sf::SpriteMesh, sf::Sprite, sf::SpriteBatch
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_UNIFORMBUFFER_HPP
+#define SFML_UNIFORMBUFFER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Buffer of shader uniforms stored in graphics memory
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API UniformBuffer : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty uniform buffer.
+    ///
+    ////////////////////////////////////////////////////////////
+    UniformBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~UniformBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the uniform buffer
+    ///
+    /// Allocates \a size bytes of graphics memory; any previously
+    /// allocated memory is freed in the process, and the contents
+    /// of the buffer are undefined until it is updated.
+    ///
+    /// \param size Size of the buffer, in bytes
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the buffer
+    ///
+    /// \return Size of the buffer, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the buffer
+    ///
+    /// The layout of \a data must match the layout of the uniform
+    /// block in the shaders; declaring the block with the std140
+    /// layout makes it the same for all the shaders and drivers.
+    ///
+    /// \param data   Data to copy to the buffer
+    /// \param size   Number of bytes to copy
+    /// \param offset Offset in the buffer to copy to, in bytes
+    ///
+    /// \return True if the update was successful, false if the
+    ///         buffer is not created or the range is out of bounds
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const void* data, std::size_t size, std::size_t offset = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the underlying OpenGL handle of the uniform buffer
+    ///
+    /// You shouldn't need to use this function, unless you have
+    /// very specific stuff to implement that SFML doesn't support,
+    /// or implement a temporary workaround until a bug is fixed.
+    ///
+    /// \return OpenGL handle of the uniform buffer or 0 if not yet created
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getNativeHandle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a uniform buffer to a binding point
+    ///
+    /// All the shaders whose uniform blocks were associated to
+    /// \a binding (see Shader::setUniformBlock) read their values
+    /// from \a buffer, until another buffer is bound to the same
+    /// point.
+    ///
+    /// \param buffer  Pointer to the uniform buffer to bind, can be null to unbind the point
+    /// \param binding Index of the binding point
+    ///
+    ////////////////////////////////////////////////////////////
+    static void bind(const UniformBuffer* buffer, unsigned int binding);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of binding points available
+    ///
+    /// \return Number of binding points, 0 if uniform buffers are not supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getMaximumBindings();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports uniform buffers
+    ///
+    /// This function should always be called before using
+    /// the uniform buffer features. If it returns false, then
+    /// any attempt to use sf::UniformBuffer will fail.
+    ///
+    /// \return True if uniform buffers are supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int m_buffer; ///< Internal buffer identifier
+    std::size_t  m_size;   ///< Size in bytes of the currently allocated buffer
+};
+
+} // namespace sf
+
+
+#endif // SFML_UNIFORMBUFFER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::UniformBuffer
+/// \ingroup graphics
+///
+/// sf::UniformBuffer stores the values of a GLSL uniform
+/// block in graphics memory. Data shared by many shaders,
+/// like the view-projection matrix or the lighting
+/// parameters, is uploaded once per frame into the buffer
+/// instead of once per shader, and the shaders read it
+/// through a binding point.
+///
+/// Uniform buffers require OpenGL 3.1 or the
+/// GL_ARB_uniform_buffer_object extension (see isAvailable()).
+///
+/// Usage example:
+/// \code
+/// // In the shaders
+/// #extension GL_ARB_uniform_buffer_object : enable
+/// layout(std140) uniform Camera
+/// {
+///     mat4 viewProjection;
+/// };
+/// \endcode
+/// \code
+/// sf::UniformBuffer camera;
+/// camera.create(16 * sizeof(float));
+///
+/// // Associate the block of each shader to the binding point 0
+/// shader1.setUniformBlock("Camera", 0);
+/// shader2.setUniformBlock("Camera", 0);
+/// sf::UniformBuffer::bind(&camera, 0);
+///
+/// // Once per frame
+/// camera.update(view.getTransform().getMatrix(), 16 * sizeof(float));
+/// \endcode
+///
+/// \see sf::Shader
+///
+////////////////////////////////////////////////////////////
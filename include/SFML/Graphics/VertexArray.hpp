@@ -78,6 +78,12 @@ public:
     /// [0, getVertexCount() - 1]. The behavior is undefined
     /// otherwise.
     ///
+    /// Since the vertex may be modified, the cached bounds of
+    /// the array are invalidated. The returned reference must
+    /// not be used to move the vertex after the next call to
+    /// getBounds (or to draw with culling enabled): call this
+    /// operator again instead.
+    ///
     /// \param index Index of the vertex to get
     ///
     /// \return Reference to the index-th vertex
@@ -165,12 +171,23 @@ public:
     ///
     /// This function returns the minimal axis-aligned rectangle
     /// that contains all the vertices of the array.
+    /// The result is cached until the vertices are modified.
     ///
     /// \return Bounding rectangle of the vertex array
     ///
     ////////////////////////////////////////////////////////////
     FloatRect getBounds() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the contents of this vertex array with those of another
+    ///
+    /// The vertices are exchanged without being copied.
+    ///
+    /// \param right Instance to swap with
+    ///
+    ////////////////////////////////////////////////////////////
+    void swap(VertexArray& right);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -189,6 +206,8 @@ private:
     ////////////////////////////////////////////////////////////
     std::vector<Vertex> m_vertices;      ///< Vertices contained in the array
     PrimitiveType       m_primitiveType; ///< Type of primitives to draw
+    mutable FloatRect   m_bounds;        ///< Cached bounding rectangle of the vertices
+    mutable bool        m_boundsValid;   ///< Is m_bounds up to date?
 };
 
 } // namespace sf
@@ -0,0 +1,476 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_VERTEXBUFFER_HPP
+#define SFML_VERTEXBUFFER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+class CompactVertex;
+class LayeredVertex;
+class RenderTarget;
+class UncoloredVertex;
+class Vertex;
+
+////////////////////////////////////////////////////////////
+/// \brief Vertex buffer storage for one or more 2D primitives
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API VertexBuffer : public Drawable, GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Usage specifiers
+    ///
+    /// If data is going to be updated once or more every frame,
+    /// set the usage to Stream. If data is going to be set once
+    /// and used for a long time without being modified, set the
+    /// usage to Static. For everything else Dynamic should be a
+    /// good compromise.
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Usage
+    {
+        Stream,  ///< Constantly changing data
+        Dynamic, ///< Occasionally changing data
+        Static   ///< Rarely changing data
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Layouts of the vertices stored in the buffer
+    ///
+    /// The compact formats take less graphics memory and
+    /// bandwidth, at the cost of integer coordinates
+    /// (see sf::CompactVertex). The layered format adds the
+    /// layer of a texture array (see sf::LayeredVertex).
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Format
+    {
+        Full,      ///< sf::Vertex, 20 bytes per vertex
+        Compact,   ///< sf::CompactVertex, 12 bytes per vertex
+        Uncolored, ///< sf::UncoloredVertex, 8 bytes per vertex
+        Layered    ///< sf::LayeredVertex, 24 bytes per vertex
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty vertex buffer, with the sf::Points
+    /// primitive type, the Stream usage and the Full format.
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a vertex buffer with a given primitive type, usage and format
+    ///
+    /// \param type   Type of primitives
+    /// \param usage  Usage specifier
+    /// \param format Layout of the vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit VertexBuffer(PrimitiveType type, Usage usage = Stream, Format format = Full);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~VertexBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the vertex buffer
+    ///
+    /// Creates the vertex buffer and allocates enough graphics
+    /// memory to hold \a vertexCount vertices. Any previously
+    /// allocated memory is freed in the process.
+    ///
+    /// In order to deallocate previously allocated memory pass 0
+    /// as \a vertexCount. Don't forget to recreate with a non-zero
+    /// value when graphics memory should be allocated again.
+    ///
+    /// \param vertexCount Number of vertices worth of memory to allocate
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the vertex count
+    ///
+    /// \return Number of vertices in the vertex buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getVertexCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the whole buffer from an array of vertices
+    ///
+    /// The \a vertices array is assumed to have the same size as
+    /// the \a created buffer.
+    ///
+    /// No additional check is performed on the size of the vertex
+    /// array, passing invalid arguments will lead to undefined
+    /// behavior.
+    ///
+    /// This function does nothing if \a vertices is null or if the
+    /// buffer was not previously created.
+    ///
+    /// \param vertices Array of vertices to copy to the buffer
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const Vertex* vertices);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the buffer from an array of vertices
+    ///
+    /// \a offset is specified as the number of vertices to skip
+    /// from the beginning of the buffer.
+    ///
+    /// If \a offset is 0 and \a vertexCount is equal to the size of
+    /// the currently created buffer, its whole contents are replaced.
+    ///
+    /// If \a offset is 0 and \a vertexCount is greater than the
+    /// size of the currently created buffer, a new buffer is created
+    /// containing the vertex data.
+    ///
+    /// If \a offset is 0 and \a vertexCount is less than the size of
+    /// the currently created buffer, only the corresponding region
+    /// is updated.
+    ///
+    /// If \a offset is not 0 and \a offset + \a vertexCount is greater
+    /// than the size of the currently created buffer, the update fails.
+    ///
+    /// No additional check is performed on the size of the vertex
+    /// array, passing invalid arguments will lead to undefined
+    /// behavior.
+    ///
+    /// \param vertices    Array of vertices to copy to the buffer
+    /// \param vertexCount Number of vertices to copy
+    /// \param offset      Offset in the buffer to copy to
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const Vertex* vertices, std::size_t vertexCount, unsigned int offset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the buffer from an array of compact vertices
+    ///
+    /// This function behaves like the overload that takes
+    /// sf::Vertex, the format of the buffer must be Compact.
+    ///
+    /// \param vertices    Array of vertices to copy to the buffer
+    /// \param vertexCount Number of vertices to copy
+    /// \param offset      Offset in the buffer to copy to
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const CompactVertex* vertices, std::size_t vertexCount, unsigned int offset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the buffer from an array of uncolored vertices
+    ///
+    /// This function behaves like the overload that takes
+    /// sf::Vertex, the format of the buffer must be Uncolored.
+    ///
+    /// \param vertices    Array of vertices to copy to the buffer
+    /// \param vertexCount Number of vertices to copy
+    /// \param offset      Offset in the buffer to copy to
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const UncoloredVertex* vertices, std::size_t vertexCount, unsigned int offset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the buffer from an array of layered vertices
+    ///
+    /// This function behaves like the overload that takes
+    /// sf::Vertex, the format of the buffer must be Layered.
+    ///
+    /// \param vertices    Array of vertices to copy to the buffer
+    /// \param vertexCount Number of vertices to copy
+    /// \param offset      Offset in the buffer to copy to
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const LayeredVertex* vertices, std::size_t vertexCount, unsigned int offset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the contents of this vertex buffer with those of another
+    ///
+    /// \param right Instance to swap with
+    ///
+    ////////////////////////////////////////////////////////////
+    void swap(VertexBuffer& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the underlying OpenGL handle of the vertex buffer
+    ///
+    /// You shouldn't need to use this function, unless you have
+    /// very specific stuff to implement that SFML doesn't support,
+    /// or implement a temporary workaround until a bug is fixed.
+    ///
+    /// \return OpenGL handle of the vertex buffer or 0 if not yet created
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getNativeHandle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the type of primitives to draw
+    ///
+    /// This function defines how the vertices must be interpreted
+    /// when it's time to draw them.
+    ///
+    /// The default primitive type is sf::Points.
+    ///
+    /// \param type Type of primitive
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPrimitiveType(PrimitiveType type);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the type of primitives drawn by the vertex buffer
+    ///
+    /// \return Primitive type
+    ///
+    ////////////////////////////////////////////////////////////
+    PrimitiveType getPrimitiveType() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the usage specifier of this vertex buffer
+    ///
+    /// This function provides a hint about how this vertex buffer
+    /// is going to be used in terms of data update frequency.
+    ///
+    /// After changing the usage specifier, the vertex buffer has
+    /// to be updated with new data for the usage specifier to
+    /// take effect.
+    ///
+    /// The default usage type is sf::VertexBuffer::Stream.
+    ///
+    /// \param usage Usage specifier
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUsage(Usage usage);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the usage specifier of this vertex buffer
+    ///
+    /// \return Usage specifier
+    ///
+    ////////////////////////////////////////////////////////////
+    Usage getUsage() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the layout of the vertices stored in the buffer
+    ///
+    /// The contents of the buffer are discarded when the format
+    /// changes: the buffer has to be created and updated again.
+    ///
+    /// The default format is sf::VertexBuffer::Full.
+    ///
+    /// \param format Layout of the vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFormat(Format format);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the layout of the vertices stored in the buffer
+    ///
+    /// \return Layout of the vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    Format getFormat() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of a vertex in the format of the buffer
+    ///
+    /// This is the stride to use when the buffer is read by
+    /// OpenGL code.
+    ///
+    /// \return Size of a vertex, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getVertexSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a vertex buffer for rendering
+    ///
+    /// This function is not part of the graphics API, it mustn't be
+    /// used when drawing SFML entities. It must be used only if you
+    /// mix sf::VertexBuffer with OpenGL code.
+    ///
+    /// \code
+    /// sf::VertexBuffer vb1, vb2;
+    /// ...
+    /// sf::VertexBuffer::bind(&vb1);
+    /// // draw OpenGL stuff that use vb1...
+    /// sf::VertexBuffer::bind(&vb2);
+    /// // draw OpenGL stuff that use vb2...
+    /// sf::VertexBuffer::bind(NULL);
+    /// // draw OpenGL stuff that use no vertex buffer...
+    /// \endcode
+    ///
+    /// \param vertexBuffer Pointer to the vertex buffer to bind, can be null to use no vertex buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    static void bind(const VertexBuffer* vertexBuffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind a vertex buffer to a storage binding point
+    ///
+    /// All the shaders whose storage blocks were associated to
+    /// \a binding (see Shader::setStorageBlock) read and write
+    /// the vertices of \a vertexBuffer, until another buffer is
+    /// bound to the same point. The block must match the format
+    /// of the buffer, for example with sf::VertexBuffer::Full
+    /// (vectors are split into floats so that nothing is padded,
+    /// and colors are 4 packed bytes, see unpackUnorm4x8):
+    /// \code
+    /// struct Vertex { float x, y; uint color; float u, v; };
+    /// layout(std430) buffer Particles { Vertex vertices[]; };
+    /// \endcode
+    /// Storage buffers require the support of compute shaders
+    /// (see Shader::isComputeAvailable).
+    ///
+    /// \param vertexBuffer Pointer to the vertex buffer to bind, can be null to unbind the point
+    /// \param binding      Index of the binding point
+    ///
+    ////////////////////////////////////////////////////////////
+    static void bindStorage(const VertexBuffer* vertexBuffer, unsigned int binding);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports vertex buffers
+    ///
+    /// This function should always be called before using
+    /// the vertex buffer features. If it returns false, then
+    /// any attempt to use sf::VertexBuffer will fail.
+    ///
+    /// \return True if vertex buffers are supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the vertex buffer to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the buffer from vertices of any format
+    ///
+    /// \param vertices    Array of vertices to copy to the buffer
+    /// \param vertexCount Number of vertices to copy
+    /// \param offset      Offset in the buffer to copy to
+    /// \param format      Format of the vertices
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool updateVertices(const void* vertices, std::size_t vertexCount, unsigned int offset, Format format);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int  m_buffer;        ///< Internal buffer identifier
+    std::size_t   m_size;          ///< Size in Vertexes of the currently allocated buffer
+    PrimitiveType m_primitiveType; ///< Type of primitives to draw
+    Usage         m_usage;         ///< How this vertex buffer is to be used
+    Format        m_format;        ///< Layout of the vertices
+};
+
+} // namespace sf
+
+
+#endif // SFML_VERTEXBUFFER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::VertexBuffer
+/// \ingroup graphics
+///
+/// sf::VertexBuffer is a simple wrapper around a dynamic
+/// buffer of vertices and a primitives type.
+///
+/// Unlike sf::VertexArray, the contents of the buffer are
+/// stored in graphics memory. Vertices don't have to be sent
+/// to the graphics card again every frame, which makes it
+/// the best choice for large or static geometry such as
+/// tile maps. In exchange, updating a vertex buffer is more
+/// expensive than modifying a vertex array, because data
+/// has to be transferred to the graphics card.
+///
+/// When vertex buffers are not supported by the system
+/// (see isAvailable()), sf::VertexBuffer does nothing.
+///
+/// It inherits sf::Drawable, but unlike other drawables it
+/// is not transformable.
+///
+/// Example:
+/// \code
+/// sf::Vertex vertices[15];
+/// ...
+/// sf::VertexBuffer triangles(sf::Triangles, sf::VertexBuffer::Static);
+/// triangles.create(15);
+/// triangles.update(vertices);
+/// ...
+/// window.draw(triangles);
+/// \endcode
+///
+/// Large static geometry whose coordinates are whole pixels
+/// can use a compact format (sf::CompactVertex or
+/// sf::UncoloredVertex) to take less than two thirds or half
+/// of the memory. Geometry that samples a sf::TextureArray
+/// uses the Layered format (sf::LayeredVertex).
+///
+/// \see sf::Vertex, sf::CompactVertex, sf::LayeredVertex, sf::VertexArray
+///
+////////////////////////////////////////////////////////////
@@ -30,15 +30,28 @@
 ////////////////////////////////////////////////////////////
 
 #include <SFML/System.hpp>
+#include <SFML/Network/CompressedPacket.hpp>
 #include <SFML/Network/Ftp.hpp>
+#include <SFML/Network/FtpTransferManager.hpp>
 #include <SFML/Network/Http.hpp>
 #include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/LocalListener.hpp>
+#include <SFML/Network/LocalSocket.hpp>
+#include <SFML/Network/NetworkService.hpp>
 #include <SFML/Network/Packet.hpp>
+#include <SFML/Network/PacketPool.hpp>
+#include <SFML/Network/ReliableUdpConnection.hpp>
+#include <SFML/Network/Serializer.hpp>
+#include <SFML/Network/SharedMemoryRing.hpp>
+#include <SFML/Network/SnapshotDecoder.hpp>
+#include <SFML/Network/SnapshotEncoder.hpp>
 #include <SFML/Network/Socket.hpp>
 #include <SFML/Network/SocketHandle.hpp>
 #include <SFML/Network/SocketSelector.hpp>
 #include <SFML/Network/TcpListener.hpp>
+#include <SFML/Network/TcpServer.hpp>
 #include <SFML/Network/TcpSocket.hpp>
+#include <SFML/Network/TlsBackend.hpp>
 #include <SFML/Network/UdpSocket.hpp>
 
 
@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_COMPRESSEDPACKET_HPP
+#define SFML_COMPRESSEDPACKET_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Packet that is compressed when it is sent over
+///        the network
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API CompressedPacket : public Packet
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty packet, with a compression threshold
+    /// of 128 bytes.
+    ///
+    ////////////////////////////////////////////////////////////
+    CompressedPacket();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the size under which the packet is sent uncompressed
+    ///
+    /// Small payloads hardly compress and are not worth the
+    /// processing time, so packets smaller than this threshold
+    /// are sent as they are (with a single byte of overhead).
+    /// Packets that don't get smaller when compressed are sent
+    /// uncompressed as well.
+    ///
+    /// \param size Minimum size of the data to compress, in bytes
+    ///
+    /// \see getCompressionThreshold
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCompressionThreshold(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size under which the packet is sent uncompressed
+    ///
+    /// \return Minimum size of the data to compress, in bytes
+    ///
+    /// \see setCompressionThreshold
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCompressionThreshold() const;
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compress the packet data before it is sent
+    ///
+    /// \param size Variable to fill with the size of data to send
+    ///
+    /// \return Pointer to the array of bytes to send
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual const void* onSend(std::size_t& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decompress the received data into the packet
+    ///
+    /// \param data Pointer to the received bytes
+    /// \param size Number of bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void onReceive(const void* data, std::size_t size);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::size_t       m_threshold; ///< Minimum size of the data to compress
+    std::vector<char> m_buffer;    ///< Compressed data to send, or decompressed data received (kept to avoid reallocations)
+};
+
+} // namespace sf
+
+
+#endif // SFML_COMPRESSEDPACKET_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::CompressedPacket
+/// \ingroup network
+///
+/// sf::CompressedPacket is a sf::Packet that compresses its
+/// data in onSend and decompresses it in onReceive, so it is
+/// used exactly like a regular packet. Both ends of the
+/// connection must of course use a sf::CompressedPacket.
+///
+/// The data is compressed to the LZ4 block format, which is
+/// very fast to encode and decode and works well on the
+/// repetitive data of typical game messages. Each packet keeps
+/// its compression buffer when it is cleared, so reusing
+/// packets (directly or through a sf::PacketPool) doesn't
+/// allocate memory for each message.
+///
+/// Usage example:
+/// \code
+/// sf::CompressedPacket packet;
+/// packet << snapshot;
+/// socket.send(packet);
+///
+/// -----------------------------------------------------------------
+///
+/// sf::CompressedPacket packet;
+/// socket.receive(packet);
+/// packet >> snapshot;
+/// \endcode
+///
+/// \see sf::Packet
+///
+////////////////////////////////////////////////////////////
@@ -247,6 +247,11 @@ public:
         std::vector<std::string> m_listing; ///< Directory/file names extracted from the data
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    Ftp();
 
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
@@ -454,18 +459,26 @@ public:
     /// of your application.
     /// If a file with the same filename as the distant file
     /// already exists in the local destination path, it will
-    /// be overwritten.
+    /// be overwritten, unless \a resume is true: in this case
+    /// the existing file is considered as the beginning of an
+    /// interrupted download, and only the rest of the distant
+    /// file is downloaded and appended to it (if the server
+    /// doesn't support resuming, the whole file is downloaded
+    /// again). A partially downloaded file is deleted if the
+    /// download fails, unless \a resume is true, so that it
+    /// can be resumed later.
     ///
     /// \param remoteFile Filename of the distant file to download
     /// \param localPath  The directory in which to put the file on the local computer
     /// \param mode       Transfer mode
+    /// \param resume     Resume an interrupted download?
     ///
     /// \return Server response to the request
     ///
     /// \see upload
     ///
     ////////////////////////////////////////////////////////////
-    Response download(const std::string& remoteFile, const std::string& localPath, TransferMode mode = Binary);
+    Response download(const std::string& remoteFile, const std::string& localPath, TransferMode mode = Binary, bool resume = false);
 
     ////////////////////////////////////////////////////////////
     /// \brief Upload a file to the server
@@ -486,6 +499,32 @@ public:
     ////////////////////////////////////////////////////////////
     Response upload(const std::string& localFile, const std::string& remotePath, TransferMode mode = Binary);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the size of the buffer used for file transfers
+    ///
+    /// Downloaded data is received and written to the file by
+    /// blocks of this size; a large buffer reduces the number of
+    /// system calls on fast networks. Uploads use it only when
+    /// the system can't send the file directly from the disk.
+    /// The default size is 256 KB.
+    ///
+    /// \param size New buffer size, in bytes
+    ///
+    /// \see getTransferBufferSize
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTransferBufferSize(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the buffer used for file transfers
+    ///
+    /// \return Buffer size, in bytes
+    ///
+    /// \see setTransferBufferSize
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getTransferBufferSize() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Send a command to the FTP server
     ///
@@ -529,7 +568,8 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    TcpSocket m_commandSocket; ///< Socket holding the control connection with the server
+    TcpSocket   m_commandSocket;      ///< Socket holding the control connection with the server
+    std::size_t m_transferBufferSize; ///< Size of the buffer used for file transfers
 };
 
 } // namespace sf
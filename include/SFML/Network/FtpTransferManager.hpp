@@ -0,0 +1,275 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_FTPTRANSFERMANAGER_HPP
+#define SFML_FTPTRANSFERMANAGER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/Ftp.hpp>
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/System/ConditionVariable.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <deque>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Runs queued FTP transfers on several concurrent sessions
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API FtpTransferManager : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Direction of a transfer
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Direction
+    {
+        Download, ///< Remote file copied to a local directory
+        Upload    ///< Local file copied to a remote directory
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queued file transfer
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Transfer
+    {
+        Direction         direction;   ///< Direction of the transfer
+        std::string       source;      ///< File to copy (remote for downloads, local for uploads)
+        std::string       destination; ///< Directory where to put the file
+        Ftp::TransferMode mode;        ///< Transfer mode
+        bool              resume;      ///< Resume an interrupted download?
+        Ftp::Response     response;    ///< Server response to the transfer, once it is finished
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Aggregate progress of the transfers
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Progress
+    {
+        std::size_t pending;   ///< Number of transfers waiting for a session
+        std::size_t active;    ///< Number of transfers in progress
+        std::size_t completed; ///< Number of successful transfers
+        std::size_t failed;    ///< Number of failed transfers
+        Uint64      bytes;     ///< Total size of the files successfully transferred
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    FtpTransferManager();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Waits for the transfers in progress (the queued ones are
+    /// dropped) and closes the sessions.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~FtpTransferManager();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open the sessions with a FTP server
+    ///
+    /// Each session is connected and logged in before this
+    /// function returns, then starts its own thread running the
+    /// queued transfers. The sessions previously opened, if any,
+    /// are closed first. If \a name is empty, the sessions log
+    /// in anonymously.
+    ///
+    /// \param server       FTP server to connect to
+    /// \param port         Port used for the connection
+    /// \param name         User name
+    /// \param password     Password
+    /// \param sessionCount Number of concurrent sessions
+    /// \param timeout      Maximum time to wait for each connection
+    ///
+    /// \return Server response to the last login, or the first error
+    ///
+    /// \see disconnect
+    ///
+    ////////////////////////////////////////////////////////////
+    Ftp::Response connect(const IpAddress& server, unsigned short port, const std::string& name, const std::string& password, std::size_t sessionCount, Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Close the sessions
+    ///
+    /// The function waits for the transfers in progress; the
+    /// queued ones stay in the queue, and are run by the next
+    /// sessions opened with connect.
+    ///
+    /// \see connect
+    ///
+    ////////////////////////////////////////////////////////////
+    void disconnect();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue the download of a file
+    ///
+    /// The parameters are the same as in Ftp::download.
+    /// This function returns immediately.
+    ///
+    /// \param remoteFile Filename of the distant file to download
+    /// \param localPath  The directory in which to put the file on the local computer
+    /// \param mode       Transfer mode
+    /// \param resume     Resume an interrupted download?
+    ///
+    /// \see addUpload
+    ///
+    ////////////////////////////////////////////////////////////
+    void addDownload(const std::string& remoteFile, const std::string& localPath, Ftp::TransferMode mode = Ftp::Binary, bool resume = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue the upload of a file
+    ///
+    /// The parameters are the same as in Ftp::upload.
+    /// This function returns immediately.
+    ///
+    /// \param localFile  Path of the local file to upload
+    /// \param remotePath The directory in which to put the file on the server
+    /// \param mode       Transfer mode
+    ///
+    /// \see addDownload
+    ///
+    ////////////////////////////////////////////////////////////
+    void addUpload(const std::string& localFile, const std::string& remotePath, Ftp::TransferMode mode = Ftp::Binary);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until all the queued transfers are finished
+    ///
+    /// If no session is open, the function returns immediately.
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the aggregate progress of the transfers
+    ///
+    /// The counters include all the transfers added since the
+    /// manager was created.
+    ///
+    /// \return Current progress
+    ///
+    ////////////////////////////////////////////////////////////
+    Progress getProgress() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the transfers that failed
+    ///
+    /// \return Failed transfers, with the server response that
+    ///         explains the failure
+    ///
+    ////////////////////////////////////////////////////////////
+    std::vector<Transfer> getFailedTransfers() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief FTP session running transfers in its own thread
+    ///
+    ////////////////////////////////////////////////////////////
+    class Session;
+
+    friend class Session;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a transfer
+    ///
+    /// \param transfer Transfer to queue
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(const Transfer& transfer);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Session*> m_sessions;      ///< Open sessions
+    std::deque<Transfer>  m_queue;         ///< Transfers waiting for a session
+    std::vector<Transfer> m_failed;        ///< Transfers that failed
+    Progress              m_progress;      ///< Aggregate progress
+    bool                  m_stopping;      ///< Are the sessions asked to stop?
+    mutable Mutex         m_mutex;         ///< Mutex protecting the queue and the progress
+    ConditionVariable     m_queueChanged;  ///< Notified when a transfer is queued or the sessions must stop
+    ConditionVariable     m_transferEnded; ///< Notified when a session finishes a transfer
+};
+
+} // namespace sf
+
+
+#endif // SFML_FTPTRANSFERMANAGER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::FtpTransferManager
+/// \ingroup network
+///
+/// sf::Ftp runs one transfer at a time on its control
+/// connection, and each transfer waits for a few round trips
+/// (PASV, TYPE, RETR/STOR, final reply) before and after its
+/// data. When many small files are transferred, that latency
+/// dominates. sf::FtpTransferManager keeps several logged-in
+/// sf::Ftp sessions open, each in its own thread, and gives
+/// them the queued transfers as they become available, so
+/// that the round trips of the different files overlap.
+///
+/// Transfers are queued with addDownload and addUpload, which
+/// return immediately; their aggregate progress is available
+/// at any time with getProgress, and the failed ones can be
+/// retrieved with getFailedTransfers.
+///
+/// Usage example:
+/// \code
+/// sf::FtpTransferManager manager;
+/// manager.connect("ftp.myserver.org", 21, "username", "password", 8);
+///
+/// for (std::size_t i = 0; i < files.size(); ++i)
+///     manager.addDownload(files[i], "mirror");
+///
+/// sf::FtpTransferManager::Progress progress = manager.getProgress();
+/// while (progress.pending + progress.active > 0)
+/// {
+///     std::cout << progress.completed << " files downloaded" << std::endl;
+///     sf::sleep(sf::seconds(1));
+///     progress = manager.getProgress();
+/// }
+///
+/// std::cout << manager.getFailedTransfers().size() << " failures" << std::endl;
+/// \endcode
+///
+/// \see sf::Ftp
+///
+////////////////////////////////////////////////////////////
@@ -31,14 +31,23 @@
 #include <SFML/Network/Export.hpp>
 #include <SFML/Network/IpAddress.hpp>
 #include <SFML/Network/TcpSocket.hpp>
+#include <SFML/Network/TlsBackend.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/Time.hpp>
 #include <map>
 #include <string>
+#include <vector>
 
 
 namespace sf
 {
+class InputStream;
+
+namespace priv
+{
+    class Inflater;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief A HTTP client
 ///
@@ -47,6 +56,8 @@ class SFML_NETWORK_API Http : NonCopyable
 {
 public:
 
+    class UploadListener;
+
     ////////////////////////////////////////////////////////////
     /// \brief Define a HTTP request
     ///
@@ -140,9 +151,72 @@ public:
         ///
         /// \param body Content of the body
         ///
+        /// \see setBodyFromFile
+        ///
         ////////////////////////////////////////////////////////////
         void setBody(const std::string& body);
 
+        ////////////////////////////////////////////////////////////
+        /// \brief Set the body of the request from a stream
+        ///
+        /// The body is read from the current position of the stream
+        /// up to its end, and sent in parts while the request is
+        /// sent, so that big payloads never have to be loaded in
+        /// memory. The stream is not owned by the request, it must
+        /// stay alive until the request is sent.
+        /// If the size of the stream is known, the body is sent
+        /// with a "Content-Length" field; otherwise it is sent with
+        /// the chunked transfer-encoding, which requires HTTP/1.1
+        /// (HTTP/1.0 requests are upgraded, with a "Connection:
+        /// close" field to keep the same behavior).
+        /// Streamed bodies are not compressed (see setBodyCompressed).
+        ///
+        /// \param stream Source of the body
+        ///
+        ////////////////////////////////////////////////////////////
+        void setBody(InputStream& stream);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Set the body of the request from a file
+        ///
+        /// The file is opened when the request is sent, and its
+        /// contents are streamed like with setBody(InputStream&).
+        /// If the file can't be opened, sending the request fails.
+        ///
+        /// \param filename Path of the file to send
+        ///
+        ////////////////////////////////////////////////////////////
+        void setBodyFromFile(const std::string& filename);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Set the listener notified of the upload of the body
+        ///
+        /// Only bodies streamed from an input stream or a file
+        /// report their progress. The listener is not owned by the
+        /// request, it must stay alive until the request is sent.
+        ///
+        /// \param listener Listener to notify, or NULL to remove it
+        ///
+        ////////////////////////////////////////////////////////////
+        void setUploadListener(UploadListener* listener);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Compress the body of the request
+        ///
+        /// When enabled, the body is compressed with gzip before
+        /// it is sent, and the "Content-Encoding" field is set
+        /// accordingly (unless the request already defines it).
+        /// Only enable it for servers known to accept compressed
+        /// requests, which is not required by the HTTP standard.
+        /// Bodies streamed from an input stream or a file are
+        /// always sent as they are.
+        /// The body is not compressed by default.
+        ///
+        /// \param compressed True to compress the body, false to send it as is
+        ///
+        ////////////////////////////////////////////////////////////
+        void setBodyCompressed(bool compressed);
+
     private:
 
         friend class Http;
@@ -178,12 +252,18 @@ public:
         ////////////////////////////////////////////////////////////
         // Member data
         ////////////////////////////////////////////////////////////
-        FieldTable   m_fields;       ///< Fields of the header associated to their value
-        Method       m_method;       ///< Method to use for the request
-        std::string  m_uri;          ///< Target URI of the request
-        unsigned int m_majorVersion; ///< Major HTTP version
-        unsigned int m_minorVersion; ///< Minor HTTP version
-        std::string  m_body;         ///< Body of the request
+        FieldTable      m_fields;         ///< Fields of the header associated to their value
+        Method          m_method;         ///< Method to use for the request
+        std::string     m_uri;            ///< Target URI of the request
+        unsigned int    m_majorVersion;   ///< Major HTTP version
+        unsigned int    m_minorVersion;   ///< Minor HTTP version
+        std::string     m_body;           ///< Body of the request
+        bool            m_compressBody;   ///< Compress the body before sending it?
+        InputStream*    m_bodyStream;     ///< Source of a streamed body
+        std::string     m_bodyFile;       ///< File to stream the body from
+        UploadListener* m_uploadListener; ///< Listener notified of the upload of a streamed body
+        Int64           m_bodyStart;      ///< Position of the body in its stream, to send it again
+        Int64           m_bodyLength;     ///< Length of a streamed body, or -1 if it is sent with the chunked transfer-encoding
     };
 
     ////////////////////////////////////////////////////////////
@@ -298,6 +378,10 @@ public:
         /// \li nothing (for HEAD requests)
         /// \li an error message (in case of an error)
         ///
+        /// Bodies compressed with gzip or deflate are decoded, but
+        /// the "Content-Encoding" and "Content-Length" fields are
+        /// kept as the server sent them.
+        ///
         /// \return The response body
         ///
         ////////////////////////////////////////////////////////////
@@ -345,6 +429,81 @@ public:
         std::string  m_body;         ///< Body of the response
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Receiver of a response body streamed by sendRequest
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_NETWORK_API BodyReceiver
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Virtual destructor
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual ~BodyReceiver();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Called when the header of the response has been received
+        ///
+        /// The response has its status and fields, but no body.
+        /// This is where the receiver can prepare its destination
+        /// or read the "Content-Length" field to report progress.
+        /// The default implementation does nothing.
+        ///
+        /// \param response Response header
+        ///
+        /// \return True to receive the body, false to abort the transfer
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool onResponse(const Response& response);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Called each time a part of the body has been received
+        ///
+        /// The parts are given in order and as soon as they arrive
+        /// (chunked transfer-encoding is already decoded), so
+        /// \a data is only valid during the call.
+        ///
+        /// \param data Pointer to the received bytes
+        /// \param size Number of bytes
+        ///
+        /// \return True to continue, false to abort the transfer
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool onBodyData(const char* data, std::size_t size) = 0;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Listener notified of the upload of a streamed request body
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_NETWORK_API UploadListener
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Virtual destructor
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual ~UploadListener();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Called each time a part of the body has been sent
+        ///
+        /// If the connection has to be established again, the body
+        /// is sent again from its beginning, and \a sent starts
+        /// over from 0.
+        ///
+        /// \param sent  Number of bytes of the body sent so far
+        /// \param total Size of the body, or -1 if it is unknown
+        ///
+        /// \return True to continue, false to abort the request
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool onUploadProgress(Uint64 sent, Int64 total) = 0;
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -367,6 +526,12 @@ public:
     ////////////////////////////////////////////////////////////
     Http(const std::string& host, unsigned short port = 0);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~Http();
+
     ////////////////////////////////////////////////////////////
     /// \brief Set the target host
     ///
@@ -374,9 +539,10 @@ public:
     /// doesn't actually connect to it until you send a request.
     /// The port has a default value of 0, which means that the
     /// HTTP client will use the right port according to the
-    /// protocol used (80 for HTTP). You should leave it like
-    /// this unless you really need a port other than the
-    /// standard one, or use an unknown protocol.
+    /// protocol used (80 for HTTP, 443 for HTTPS). You should
+    /// leave it like this unless you really need a port other
+    /// than the standard one, or use an unknown protocol.
+    /// HTTPS hosts require a TLS backend (see setTlsBackend).
     ///
     /// \param host Web server to connect to
     /// \param port Port to use for connection
@@ -384,12 +550,47 @@ public:
     ////////////////////////////////////////////////////////////
     void setHost(const std::string& host, unsigned short port = 0);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the TLS implementation used for HTTPS hosts
+    ///
+    /// The backend is not owned by the HTTP client, it must
+    /// stay alive as long as the client uses it. The state of
+    /// the last TLS session is kept between connections to the
+    /// same host, so that new connections can resume it instead
+    /// of performing a full handshake.
+    ///
+    /// \param backend TLS backend to use, or NULL to disable HTTPS
+    ///
+    /// \see sf::TlsBackend
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTlsBackend(TlsBackend* backend);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the decoding of compressed responses
+    ///
+    /// When enabled, the requests advertise the gzip and deflate
+    /// encodings in their "Accept-Encoding" field (unless they
+    /// define it already), and the bodies of the responses that
+    /// use them are decompressed as they arrive, before they are
+    /// stored in the response or given to the body receiver.
+    /// Decoding is enabled by default.
+    ///
+    /// \param enabled True to decode compressed responses, false to get them as they are sent
+    ///
+    ////////////////////////////////////////////////////////////
+    void setContentDecoding(bool enabled);
+
     ////////////////////////////////////////////////////////////
     /// \brief Send a HTTP request and return the server's response.
     ///
     /// You must have a valid host before sending a request (see setHost).
     /// Any missing mandatory header field in the request will be added
     /// with an appropriate value.
+    /// With HTTP/1.1 requests, the connection is kept open after
+    /// the response (unless the request or the server asks to
+    /// close it), so that the next requests to the same host don't
+    /// have to connect again.
     /// Warning: this function waits for the server's response and may
     /// not return instantly; use a thread if you don't want to block your
     /// application, or use a timeout to limit the time to wait. A value
@@ -404,15 +605,150 @@ public:
     ////////////////////////////////////////////////////////////
     Response sendRequest(const Request& request, Time timeout = Time::Zero);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send a HTTP request and stream the server's response body
+    ///
+    /// This function works like the other overload, except that
+    /// the body of the response is not stored in the returned
+    /// response but given to \a receiver as it arrives. This
+    /// allows to save big files to the disk (or hash them, etc.)
+    /// with a bounded amount of memory, and to report progress.
+    /// If the receiver aborts the transfer, the connection is
+    /// closed and the response (header only) is returned.
+    ///
+    /// \param request  Request to send
+    /// \param receiver Receiver of the response body
+    /// \param timeout  Maximum time to wait
+    ///
+    /// \return Server's response, with an empty body
+    ///
+    ////////////////////////////////////////////////////////////
+    Response sendRequest(const Request& request, BodyReceiver& receiver, Time timeout = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send several HTTP requests at once and return the server's responses
+    ///
+    /// The requests are pipelined: they are all sent on the same
+    /// connection without waiting for the responses, which saves
+    /// a round trip per request. The responses are returned in the
+    /// order of the requests. If the server closes the connection
+    /// before answering all of them, the remaining requests are
+    /// sent again on a new connection.
+    /// Use HTTP/1.1 requests, servers don't pipeline HTTP/1.0 ones.
+    /// Note that a request that was received but not answered
+    /// before a connection failure may be processed twice, so only
+    /// pipeline requests that can safely be repeated.
+    ///
+    /// \param requests Requests to send
+    /// \param timeout  Maximum time to wait for the connection
+    ///
+    /// \return Server's responses, one per request
+    ///
+    /// \see sendRequest
+    ///
+    ////////////////////////////////////////////////////////////
+    std::vector<Response> sendRequests(const std::vector<Request>& requests, Time timeout = Time::Zero);
+
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send requests and receive their responses
+    ///
+    /// \param requests Requests to send
+    /// \param receiver Receiver of the response bodies, or NULL to store them in the responses
+    /// \param timeout  Maximum time to wait for the connection
+    ///
+    /// \return Server's responses, one per request
+    ///
+    ////////////////////////////////////////////////////////////
+    std::vector<Response> performRequests(const std::vector<Request>& requests, BodyReceiver* receiver, Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the missing mandatory fields to a request
+    ///
+    /// \param request Request to complete
+    ///
+    /// \return Request ready to be sent
+    ///
+    ////////////////////////////////////////////////////////////
+    Request prepareRequest(const Request& request) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive one response from the connection
+    ///
+    /// \param response  Response to fill
+    /// \param buffer    Data received but not used yet, updated by the function
+    /// \param head      Is this the response to a HEAD request (which has no body)?
+    /// \param receiver  Receiver of the body, or NULL to store it in the response
+    /// \param keepAlive Set to false if the connection can't be used for another response
+    ///
+    /// \return True if a complete response was received
+    ///
+    ////////////////////////////////////////////////////////////
+    bool receiveResponse(Response& response, std::string& buffer, bool head, BodyReceiver* receiver, bool& keepAlive);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive more data from the connection
+    ///
+    /// \param buffer String to append the received data to
+    ///
+    /// \return True if data was received, false if the connection was closed
+    ///
+    ////////////////////////////////////////////////////////////
+    bool receiveMore(std::string& buffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Connect to the host, with TLS for HTTPS hosts
+    ///
+    /// \param timeout Maximum time to wait for the connection
+    ///
+    /// \return True if the connection is established
+    ///
+    ////////////////////////////////////////////////////////////
+    bool connect(Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send the streamed body of a request
+    ///
+    /// \param request Request whose body to send
+    /// \param aborted Set to true if the request must not be sent again
+    ///
+    /// \return True if the whole body was sent
+    ///
+    ////////////////////////////////////////////////////////////
+    bool sendBody(const Request& request, bool& aborted);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Close the connection, keeping its TLS session for the next one
+    ///
+    ////////////////////////////////////////////////////////////
+    void disconnect();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send data through the connection
+    ///
+    /// \param data Data to send
+    /// \param size Size of the data, in bytes
+    ///
+    /// \return True if all the data was sent
+    ///
+    ////////////////////////////////////////////////////////////
+    bool sendData(const char* data, std::size_t size);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    TcpSocket      m_connection; ///< Connection to the host
-    IpAddress      m_host;       ///< Web host address
-    std::string    m_hostName;   ///< Web host name
-    unsigned short m_port;       ///< Port used for connection with host
+    TcpSocket               m_connection;    ///< Connection to the host
+    bool                    m_connected;     ///< Is the connection open (kept alive from a previous request)?
+    IpAddress               m_host;          ///< Web host address
+    std::string             m_hostName;      ///< Web host name
+    unsigned short          m_port;          ///< Port used for connection with host
+    bool                    m_secure;        ///< Is the host an HTTPS one?
+    TlsBackend*             m_tlsBackend;    ///< TLS implementation used for HTTPS hosts
+    TlsBackend::Connection* m_tls;           ///< Encrypted connection to an HTTPS host
+    std::vector<char>       m_tlsSession;    ///< State of the last TLS session with the host, to resume it
+    bool                    m_decodeContent; ///< Decode the compressed responses?
+    priv::Inflater*         m_inflater;      ///< Decoder of the compressed responses, created on first use
 };
 
 } // namespace sf
@@ -429,7 +765,8 @@ private:
 /// to communicate with a web server. You can retrieve
 /// web pages, send data to an interactive resource,
 /// download a remote file, etc. The HTTPS protocol is
-/// not supported.
+/// supported through a TLS library of your choice, given
+/// to the client with setTlsBackend (see sf::TlsBackend).
 ///
 /// The HTTP client is split into 3 classes:
 /// \li sf::Http::Request
@@ -451,7 +788,18 @@ private:
 ///
 /// sf::Http provides a simple function, SendRequest, to send a
 /// sf::Http::Request and return the corresponding sf::Http::Response
-/// from the server.
+/// from the server. With HTTP/1.1 requests, the connection
+/// to the host is kept alive between requests, and several
+/// requests can be pipelined with sendRequests. Big bodies can
+/// be streamed to a sf::Http::BodyReceiver instead of being
+/// stored in the response. HTTPS connections resume their
+/// previous TLS session when they have to reconnect, so that
+/// they rarely pay for a full handshake. Responses compressed
+/// with gzip or deflate are decoded transparently, and request
+/// bodies can be compressed with Request::setBodyCompressed.
+/// Request bodies can also be streamed from a sf::InputStream
+/// or a file, with a constant amount of memory whatever their
+/// size, and report their progress to a sf::Http::UploadListener.
 ///
 /// Usage example:
 /// \code
@@ -33,12 +33,13 @@
 #include <istream>
 #include <ostream>
 #include <string>
+#include <vector>
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
-/// \brief Encapsulate an IPv4 network address
+/// \brief Encapsulate an IPv4 or IPv6 network address
 ///
 ////////////////////////////////////////////////////////////
 class SFML_NETWORK_API IpAddress
@@ -57,7 +58,14 @@ public:
     /// \brief Construct the address from a string
     ///
     /// Here \a address can be either a decimal address
-    /// (ex: "192.168.1.56") or a network name (ex: "localhost").
+    /// (ex: "192.168.1.56"), an IPv6 address (ex: "2001:db8::1")
+    /// or a network name (ex: "localhost"). A network name is
+    /// resolved to its first IPv4 address, or to its first IPv6
+    /// address if it has no IPv4 one (use resolveAll to get all
+    /// of them). Resolving a network name may block; the results are kept
+    /// in a cache shared by the whole process (see
+    /// setResolveCacheDuration), and resolveAsync can be used
+    /// to resolve a name without blocking.
     ///
     /// \param address IP address or network name
     ///
@@ -108,12 +116,35 @@ public:
     ////////////////////////////////////////////////////////////
     explicit IpAddress(Uint32 address);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct an IPv6 address from its 16 bytes
+    ///
+    /// The bytes are in network order, i.e. the most significant
+    /// first. An IPv4-mapped address (::ffff:a.b.c.d) is stored
+    /// as the IPv4 address a.b.c.d.
+    ///
+    /// \param bytes The 16 bytes of the address
+    ///
+    /// \see toIpv6Bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit IpAddress(const Uint8 (&bytes)[16]);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the address is an IPv6 address
+    ///
+    /// \return True if the address is an IPv6 address, false if it is an IPv4 one
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isIpv6() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get a string representation of the address
     ///
     /// The returned string is the decimal representation of the
-    /// IP address (like "192.168.1.56"), even if it was constructed
-    /// from a host name.
+    /// IP address (like "192.168.1.56"), or the standard notation
+    /// of an IPv6 address (like "2001:db8::1"), even if it was
+    /// constructed from a host name.
     ///
     /// \return String representation of the address
     ///
@@ -130,14 +161,30 @@ public:
     /// (like sending the address through a socket).
     /// The integer produced by this function can then be converted
     /// back to a sf::IpAddress with the proper constructor.
+    /// IPv6 addresses don't fit in an integer, this function
+    /// returns 0 for them (use toIpv6Bytes instead).
     ///
     /// \return 32-bits unsigned integer representation of the address
     ///
-    /// \see toString
+    /// \see toString, toIpv6Bytes
     ///
     ////////////////////////////////////////////////////////////
     Uint32 toInteger() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the 16 bytes of the address, as an IPv6 address
+    ///
+    /// IPv4 addresses are returned as IPv4-mapped IPv6 addresses
+    /// (::ffff:a.b.c.d). The bytes can be converted back to a
+    /// sf::IpAddress with the proper constructor.
+    ///
+    /// \param bytes Array to fill with the 16 bytes of the address, in network order
+    ///
+    /// \see toInteger
+    ///
+    ////////////////////////////////////////////////////////////
+    void toIpv6Bytes(Uint8 (&bytes)[16]) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the computer's local address
     ///
@@ -178,19 +225,80 @@ public:
     ////////////////////////////////////////////////////////////
     static IpAddress getPublicAddress(Time timeout = Time::Zero);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Resolve all the addresses of a network name
+    ///
+    /// The addresses are ordered as recommended for connecting
+    /// to them ("Happy Eyeballs"): in the order of preference of
+    /// the system, but alternating IPv6 and IPv4 addresses, so
+    /// that a connection attempt on each family is made early.
+    /// The result can be given directly to TcpSocket::connect.
+    /// This function blocks, and doesn't use the cache.
+    ///
+    /// \param address IP address or network name
+    ///
+    /// \return Addresses of the host, empty if it couldn't be resolved
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::vector<IpAddress> resolveAll(const std::string& address);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resolve an address without blocking
+    ///
+    /// If \a address is a decimal address, or a network name
+    /// whose resolution is in the cache, \a result is set and
+    /// the function returns true (\a result is IpAddress::None
+    /// if the name couldn't be resolved). Otherwise the
+    /// resolution is started on a background thread and the
+    /// function returns false: call it again later (typically
+    /// once per frame) to get the result.
+    ///
+    /// \param address IP address or network name
+    /// \param result  Resolved address, if the function returns true
+    ///
+    /// \return True if the address is resolved, false if the resolution is in progress
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool resolveAsync(const std::string& address, IpAddress& result);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set how long resolved network names are cached
+    ///
+    /// The system resolver doesn't give the lifetime of its
+    /// records, so the results are kept for a fixed duration:
+    /// 60 seconds by default for successful resolutions, and
+    /// 10 seconds for failed ones. A duration of Time::Zero
+    /// disables the corresponding cache. The new durations apply
+    /// to the next resolutions, not to the ones already cached.
+    ///
+    /// \param success Duration for resolved names
+    /// \param failure Duration for names that couldn't be resolved
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setResolveCacheDuration(Time success, Time failure);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the resolved network names from the cache
+    ///
+    ////////////////////////////////////////////////////////////
+    static void clearResolveCache();
+
     ////////////////////////////////////////////////////////////
     // Static member data
     ////////////////////////////////////////////////////////////
-    static const IpAddress None;      ///< Value representing an empty/invalid address
-    static const IpAddress LocalHost; ///< The "localhost" address (for connecting a computer to itself locally)
-    static const IpAddress Broadcast; ///< The "broadcast" address (for sending UDP messages to everyone on a local network)
+    static const IpAddress None;          ///< Value representing an empty/invalid address
+    static const IpAddress LocalHost;     ///< The "localhost" address (for connecting a computer to itself locally)
+    static const IpAddress Broadcast;     ///< The "broadcast" address (for sending UDP messages to everyone on a local network)
+    static const IpAddress Ipv6LocalHost; ///< The IPv6 "localhost" address (::1)
 
 private:
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Uint32 m_address; ///< Address stored as an unsigned 32 bits integer
+    Uint32 m_address;      ///< IPv4 address stored as an unsigned 32 bits integer
+    Uint8  m_address6[16]; ///< IPv6 address, in network order
+    bool   m_isIpv6;       ///< Is this an IPv6 address?
 };
 
 ////////////////////////////////////////////////////////////
@@ -308,9 +416,29 @@ SFML_NETWORK_API std::ostream& operator <<(std::ostream& stream, const IpAddress
 /// sf::IpAddress a7("www.google.com");                   // a distant address created from a network name
 /// sf::IpAddress a8 = sf::IpAddress::getLocalAddress();  // my address on the local network
 /// sf::IpAddress a9 = sf::IpAddress::getPublicAddress(); // my address on the internet
+/// sf::IpAddress a10("2001:db8::1");                     // an IPv6 address
+/// \endcode
+///
+/// Network names are resolved by the system, which may take
+/// a long time on a bad network. The results are kept in a
+/// cache for a short duration, so that constructing the same
+/// address again (as sf::Http does on every setHost) doesn't
+/// block. A game that can't afford to block at all can use
+/// resolveAsync:
+/// \code
+/// sf::IpAddress server;
+/// if (sf::IpAddress::resolveAsync("game.server.com", server))
+/// {
+///     // Resolved (or failed, if server is None): connect
+/// }
+/// else
+/// {
+///     // Still in progress: try again next frame
+/// }
 /// \endcode
 ///
-/// Note that sf::IpAddress currently doesn't support IPv6
-/// nor other types of network addresses.
+/// IPv6 addresses are supported as well; IPv4 and IPv6 sockets
+/// are handled transparently by the socket classes.
+/// Other types of network addresses are not supported.
 ///
 ////////////////////////////////////////////////////////////
@@ -0,0 +1,162 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef SFML_LOCALLISTENER_HPP
+#define SFML_LOCALLISTENER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/Socket.hpp>
+#include <string>
+
+
+namespace sf
+{
+class LocalSocket;
+
+////////////////////////////////////////////////////////////
+/// \brief Socket that listens to new local connections
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API LocalListener : public Socket
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    LocalListener();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The listener is closed, and its file is removed.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~LocalListener();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the path on which the socket is listening
+    ///
+    /// If the socket is not listening, this function returns
+    /// an empty string.
+    ///
+    /// \return Path of the listener
+    ///
+    /// \see listen
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::string& getPath() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start listening for connections
+    ///
+    /// This functions makes the socket listen to the specified
+    /// path, waiting for new connections from local sockets.
+    /// If the socket was previously listening to another path,
+    /// it will be stopped first and bound to the new path.
+    /// A file left at the path by a listener which didn't close
+    /// (because its process crashed, for example) is replaced,
+    /// but the function fails if another listener is still
+    /// accepting connections on it (it is checked by connecting
+    /// to it, so that listener receives an empty connection).
+    ///
+    /// \param path Path to listen for new connections
+    ///
+    /// \return Status code
+    ///
+    /// \see accept, close
+    ///
+    ////////////////////////////////////////////////////////////
+    Status listen(const std::string& path);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop listening and close the socket
+    ///
+    /// This function gracefully stops the listener, and removes
+    /// the file that it created. If the socket is not listening,
+    /// this function has no effect.
+    ///
+    /// \see listen
+    ///
+    ////////////////////////////////////////////////////////////
+    void close();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Accept a new connection
+    ///
+    /// If the socket is in blocking mode, this function will
+    /// not return until a connection is actually received.
+    ///
+    /// \param socket Socket that will hold the new connection
+    ///
+    /// \return Status code
+    ///
+    /// \see listen
+    ///
+    ////////////////////////////////////////////////////////////
+    Status accept(LocalSocket& socket);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::string m_path; ///< Path on which the socket is listening
+};
+
+} // namespace sf
+
+
+#endif // SFML_LOCALLISTENER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::LocalListener
+/// \ingroup network
+///
+/// A local listener waits for connections of sf::LocalSocket
+/// instances from the processes of the same host, like
+/// sf::TcpListener does for TCP connections. It can be added
+/// to a sf::SocketSelector to wait for both kinds of clients
+/// at the same time.
+///
+/// Usage example:
+/// \code
+/// sf::LocalListener listener;
+/// listener.listen("/tmp/game-server.sock");
+///
+/// while (running)
+/// {
+///     sf::LocalSocket client;
+///     if (listener.accept(client) == sf::Socket::Done)
+///         doSomethingWith(client);
+/// }
+/// \endcode
+///
+/// \see sf::LocalSocket, sf::TcpListener
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,250 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef SFML_LOCALSOCKET_HPP
+#define SFML_LOCALSOCKET_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/Socket.hpp>
+#include <string>
+
+
+namespace sf
+{
+class LocalListener;
+class Packet;
+
+////////////////////////////////////////////////////////////
+/// \brief Specialized socket communicating with another
+///        process of the same host
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API LocalSocket : public Socket
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    LocalSocket();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Connect the socket to a local listener
+    ///
+    /// The path is the one given to sf::LocalListener::listen
+    /// by the other process. If the socket was previously
+    /// connected, it is first disconnected.
+    ///
+    /// \param path Path of the listener
+    ///
+    /// \return Status code
+    ///
+    /// \see disconnect
+    ///
+    ////////////////////////////////////////////////////////////
+    Status connect(const std::string& path);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Disconnect the socket from its peer
+    ///
+    /// This function gracefully closes the connection. If the
+    /// socket is not connected, this function has no effect.
+    ///
+    /// \see connect
+    ///
+    ////////////////////////////////////////////////////////////
+    void disconnect();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send raw data to the peer
+    ///
+    /// To be able to handle partial sends over non-blocking
+    /// sockets, use the send(const void*, std::size_t, std::size_t&)
+    /// overload instead.
+    /// This function will fail if the socket is not connected.
+    ///
+    /// \param data Pointer to the sequence of bytes to send
+    /// \param size Number of bytes to send
+    ///
+    /// \return Status code
+    ///
+    /// \see receive
+    ///
+    ////////////////////////////////////////////////////////////
+    Status send(const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send raw data to the peer
+    ///
+    /// This function will fail if the socket is not connected.
+    ///
+    /// \param data Pointer to the sequence of bytes to send
+    /// \param size Number of bytes to send
+    /// \param sent The number of bytes sent will be written here
+    ///
+    /// \return Status code
+    ///
+    /// \see receive
+    ///
+    ////////////////////////////////////////////////////////////
+    Status send(const void* data, std::size_t size, std::size_t& sent);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive raw data from the peer
+    ///
+    /// In blocking mode, this function will wait until some
+    /// bytes are actually received.
+    /// This function will fail if the socket is not connected.
+    ///
+    /// \param data     Pointer to the array to fill with the received bytes
+    /// \param size     Maximum number of bytes that can be received
+    /// \param received This variable is filled with the actual number of bytes received
+    ///
+    /// \return Status code
+    ///
+    /// \see send
+    ///
+    ////////////////////////////////////////////////////////////
+    Status receive(void* data, std::size_t size, std::size_t& received);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send a formatted packet of data to the peer
+    ///
+    /// In non-blocking mode, if this function returns sf::Socket::Partial,
+    /// you \em must retry sending the same unmodified packet before sending
+    /// anything else in order to guarantee the packet arrives at the
+    /// peer uncorrupted.
+    /// This function will fail if the socket is not connected.
+    ///
+    /// \param packet Packet to send
+    ///
+    /// \return Status code
+    ///
+    /// \see receive
+    ///
+    ////////////////////////////////////////////////////////////
+    Status send(Packet& packet);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive a formatted packet of data from the peer
+    ///
+    /// In blocking mode, this function will wait until the whole packet
+    /// has been received.
+    /// This function will fail if the socket is not connected.
+    ///
+    /// \param packet Packet to fill with the received data
+    ///
+    /// \return Status code
+    ///
+    /// \see send
+    ///
+    ////////////////////////////////////////////////////////////
+    Status receive(Packet& packet);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum size of the packets that can be received
+    ///
+    /// This works like sf::TcpSocket::setMaxPacketSize.
+    /// A value of 0 means no limit, which is the default.
+    ///
+    /// \param size Maximum packet size, in bytes (0 for no limit)
+    ///
+    /// \see getMaxPacketSize
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMaxPacketSize(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum size of the packets that can be received
+    ///
+    /// \return Maximum packet size, in bytes (0 for no limit)
+    ///
+    /// \see setMaxPacketSize
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getMaxPacketSize() const;
+
+private:
+
+    friend class LocalListener;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    PendingPacket m_pendingPacket; ///< Temporary data of the packet currently being received
+    std::size_t   m_maxPacketSize; ///< Maximum size of a received packet (0 for no limit)
+};
+
+} // namespace sf
+
+
+#endif // SFML_LOCALSOCKET_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::LocalSocket
+/// \ingroup network
+///
+/// Local sockets connect two processes running on the same
+/// host, such as a game server and its bots, recorders or
+/// monitoring tools. They work like TCP sockets (reliable,
+/// ordered stream of bytes, same raw and sf::Packet
+/// functions, compatible with sf::SocketSelector), but they
+/// don't go through the network stack: the data is copied
+/// directly from one process to the other by the system,
+/// which is much cheaper than the loopback interface.
+///
+/// They are Unix domain sockets, which are also available on
+/// Windows since Windows 10 version 1803. Their address is a
+/// path in the file system, where the listener creates a
+/// special file. On Linux, paths starting with '@' are in
+/// the abstract namespace, and don't create any file.
+///
+/// Usage example:
+/// \code
+/// // ----- The server -----
+/// sf::LocalListener listener;
+/// listener.listen("/tmp/game-server.sock");
+///
+/// sf::LocalSocket bot;
+/// listener.accept(bot);
+///
+/// sf::Packet packet;
+/// bot.receive(packet);
+///
+/// // ----- The bot -----
+/// sf::LocalSocket socket;
+/// socket.connect("/tmp/game-server.sock");
+///
+/// sf::Packet packet;
+/// packet << "ready";
+/// socket.send(packet);
+/// \endcode
+///
+/// \see sf::LocalListener, sf::TcpSocket, sf::SharedMemoryRing
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,295 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_NETWORKSERVICE_HPP
+#define SFML_NETWORKSERVICE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Socket.hpp>
+#include <SFML/Network/SocketSelector.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/Time.hpp>
+#include <deque>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+class Packet;
+class TcpListener;
+class TcpSocket;
+
+////////////////////////////////////////////////////////////
+/// \brief Thread running asynchronous operations on many sockets
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API NetworkService : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Description of a completed operation
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Completion
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Types of operations
+        ///
+        ////////////////////////////////////////////////////////////
+        enum Operation
+        {
+            Connect, ///< A connection was established (or failed)
+            Accept,  ///< A new connection was accepted by a listener
+            Send,    ///< A packet was sent
+            Receive  ///< A packet was received
+        };
+
+        Operation      operation; ///< Type of the operation
+        Socket::Status status;    ///< Result of the operation: Done, Disconnected or Error
+        TcpSocket*     socket;    ///< Socket of the operation (the accepted socket for Accept)
+        TcpListener*   listener;  ///< Listener of the operation (Accept only)
+        Packet*        packet;    ///< Packet of the operation (Send and Receive only)
+        void*          userData;  ///< Value given when the operation was started
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Starts the thread that runs the operations.
+    ///
+    ////////////////////////////////////////////////////////////
+    NetworkService();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Stops the thread. The operations still in progress are
+    /// abandoned, without completion.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~NetworkService();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start connecting a socket to a remote peer
+    ///
+    /// \param socket        Socket to connect
+    /// \param remoteAddress Address of the remote peer
+    /// \param remotePort    Port of the remote peer
+    /// \param timeout       Maximum time to wait for the connection (Time::Zero for the system's default)
+    /// \param userData      Value to pass back in the completion
+    ///
+    ////////////////////////////////////////////////////////////
+    void connect(TcpSocket& socket, const IpAddress& remoteAddress, unsigned short remotePort, Time timeout = Time::Zero, void* userData = NULL);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start accepting a new connection
+    ///
+    /// \param listener Listening socket
+    /// \param socket   Socket that will hold the new connection
+    /// \param userData Value to pass back in the completion
+    ///
+    ////////////////////////////////////////////////////////////
+    void accept(TcpListener& listener, TcpSocket& socket, void* userData = NULL);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start sending a packet
+    ///
+    /// Packets sent on the same socket are sent in order.
+    ///
+    /// \param socket   Connected socket
+    /// \param packet   Packet to send
+    /// \param userData Value to pass back in the completion
+    ///
+    ////////////////////////////////////////////////////////////
+    void send(TcpSocket& socket, Packet& packet, void* userData = NULL);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start receiving a packet
+    ///
+    /// Several receives can be started on the same socket,
+    /// they complete in order.
+    ///
+    /// \param socket   Connected socket
+    /// \param packet   Packet to fill with the received data
+    /// \param userData Value to pass back in the completion
+    ///
+    ////////////////////////////////////////////////////////////
+    void receive(TcpSocket& socket, Packet& packet, void* userData = NULL);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pop a completed operation, if any
+    ///
+    /// This function never blocks. Completions are returned in
+    /// the order the operations completed.
+    ///
+    /// \param completion Completion to fill
+    ///
+    /// \return True if a completion was returned, false if there was none
+    ///
+    ////////////////////////////////////////////////////////////
+    bool pollCompletion(Completion& completion);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Operation waiting to complete
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Pending
+    {
+        Completion     completion; ///< Completion to report
+        IpAddress      address;    ///< Remote address (Connect only)
+        unsigned short port;       ///< Remote port (Connect only)
+        Time           deadline;   ///< Time after which a connection fails (Connect only, Time::Zero for none)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue an operation for the service thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void post(const Pending& operation);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Report a completed operation
+    ///
+    ////////////////////////////////////////////////////////////
+    void complete(Completion completion, Socket::Status status);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function run by the service thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void run();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start the operations posted since the last call
+    ///
+    ////////////////////////////////////////////////////////////
+    void startOperations();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make progress on the pending connections and sends
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateWrites();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make progress on the reads of a socket ready to receive
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateReads(Socket* socket);
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::deque<Pending> Queue;
+    typedef std::map<Socket*, Queue> QueueMap;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Thread                 m_thread;      ///< Thread running the operations
+    volatile bool          m_running;     ///< Tells the thread to stop
+    Mutex                  m_mutex;       ///< Mutex protecting the posted operations and the completions
+    std::vector<Pending>   m_posted;      ///< Operations posted but not started yet
+    std::deque<Completion> m_completions; ///< Completed operations not polled yet
+    UdpSocket              m_wakeUp;      ///< Socket receiving a datagram when operations are posted
+    SocketSelector         m_selector;    ///< Selector waiting for the sockets to read from
+    Clock                  m_clock;       ///< Clock measuring connection timeouts
+    std::vector<Pending>   m_connecting;  ///< Connections in progress
+    QueueMap               m_reads;       ///< Receives and accepts, by socket
+    QueueMap               m_writes;      ///< Sends, by socket
+};
+
+} // namespace sf
+
+
+#endif // SFML_NETWORKSERVICE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::NetworkService
+/// \ingroup network
+///
+/// sf::NetworkService runs socket operations in the background,
+/// on a single thread that serves all the sockets, so that the
+/// application thread (typically the one that renders) never
+/// blocks on the network nor has to poll each socket.
+///
+/// Operations are started with connect, accept, send and
+/// receive, which return immediately. When an operation
+/// completes, a sf::NetworkService::Completion is queued;
+/// the application retrieves them with pollCompletion, for
+/// example once per frame, like window events.
+///
+/// The sockets, listeners and packets given to the service
+/// must stay alive, and must not be used directly, until all
+/// their operations have completed. They are switched to
+/// non-blocking mode.
+///
+/// Usage example:
+/// \code
+/// sf::NetworkService service;
+/// sf::TcpSocket socket;
+/// sf::Packet incoming;
+///
+/// service.connect(socket, "example.org", 5000);
+///
+/// while (window.isOpen())
+/// {
+///     sf::NetworkService::Completion completion;
+///     while (service.pollCompletion(completion))
+///     {
+///         if (completion.status != sf::Socket::Done)
+///         {
+///             handleError(completion);
+///         }
+///         else if (completion.operation == sf::NetworkService::Completion::Connect)
+///         {
+///             service.receive(socket, incoming);
+///         }
+///         else if (completion.operation == sf::NetworkService::Completion::Receive)
+///         {
+///             handleMessage(incoming);
+///             service.receive(socket, incoming);
+///         }
+///     }
+///
+///     render();
+/// }
+/// \endcode
+///
+/// \see sf::SocketSelector
+///
+////////////////////////////////////////////////////////////
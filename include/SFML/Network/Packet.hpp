@@ -35,9 +35,11 @@
 
 namespace sf
 {
+class ReliableUdpConnection;
 class String;
 class TcpSocket;
 class UdpSocket;
+template <typename T> struct Serializer;
 
 ////////////////////////////////////////////////////////////
 /// \brief Utility class to build blocks of data to transfer
@@ -59,6 +61,34 @@ public:
     ////////////////////////////////////////////////////////////
     Packet();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a packet over external memory
+    ///
+    /// The packet writes its data directly to \a buffer, so that
+    /// building it doesn't allocate anything; this allows to
+    /// serialize messages into an arena or a pooled slab.
+    /// The memory must stay alive as long as the packet uses it.
+    /// If the data grows bigger than \a capacity, it is moved to
+    /// memory owned by the packet, and the external memory is
+    /// not used anymore.
+    ///
+    /// \param buffer   Memory to write the packet data to
+    /// \param capacity Size of the memory, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet(void* buffer, std::size_t capacity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// The new packet always owns its data, even if \a copy
+    /// is built over external memory.
+    ///
+    /// \param copy Instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet(const Packet& copy);
+
     ////////////////////////////////////////////////////////////
     /// \brief Virtual destructor
     ///
@@ -76,6 +106,27 @@ public:
     ////////////////////////////////////////////////////////////
     void append(const void* data, std::size_t sizeInBytes);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the packet data directly from existing memory
+    ///
+    /// The packet becomes a read-only view over \a data: its
+    /// contents are the \a size bytes pointed, and reading them
+    /// doesn't copy anything. This is meant to parse datagrams
+    /// or messages received in a buffer of your own. The memory
+    /// must stay alive and unchanged as long as the packet reads
+    /// it. Writing to the packet first copies the viewed bytes
+    /// to the memory of the packet (its own or external), the
+    /// viewed memory is never modified; clearing the packet
+    /// forgets it.
+    ///
+    /// \param data Pointer to the bytes to read
+    /// \param size Number of bytes
+    ///
+    /// \see clear
+    ///
+    ////////////////////////////////////////////////////////////
+    void openFromMemory(const void* data, std::size_t size);
+
     ////////////////////////////////////////////////////////////
     /// \brief Clear the packet
     ///
@@ -86,6 +137,34 @@ public:
     ////////////////////////////////////////////////////////////
     void clear();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Reserve memory for the packet data
+    ///
+    /// Appending data to the packet reallocates its memory as
+    /// it grows. If you know the final size in advance, reserving
+    /// it at once avoids these reallocations. The reserved memory
+    /// is kept when the packet is cleared, which makes recycling
+    /// packets (see sf::PacketPool) allocation-free.
+    /// A packet built over external memory that is too small
+    /// for \a capacity moves its data to memory of its own.
+    ///
+    /// \param capacity Number of bytes to reserve
+    ///
+    /// \see getCapacity, clear
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(std::size_t capacity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of bytes the packet can hold without reallocating
+    ///
+    /// \return Capacity of the packet, in bytes
+    ///
+    /// \see reserve
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCapacity() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get a pointer to the data contained in the packet
     ///
@@ -128,6 +207,31 @@ public:
     ////////////////////////////////////////////////////////////
     bool endOfPacket() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// Only the contents are copied: the packet keeps writing to
+    /// its own memory, external or not.
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& operator =(const Packet& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the contents of this packet with those of another
+    ///
+    /// When both packets own their memory, the data is exchanged
+    /// without being copied. Otherwise the contents are copied,
+    /// since each packet keeps writing to its own external memory.
+    ///
+    /// \param right Instance to swap with
+    ///
+    ////////////////////////////////////////////////////////////
+    void swap(Packet& right);
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -212,9 +316,257 @@ public:
     Packet& operator <<(const std::wstring& data);
     Packet& operator <<(const String&       data);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Write an array of values into the packet
+    ///
+    /// The values are written exactly as the same number of
+    /// calls to operator << would write them, so they can be read
+    /// back one by one or with readArray. The count itself is
+    /// not written: send it first if the receiver doesn't know it.
+    ///
+    /// Writing a whole array at once reserves the memory and
+    /// converts the values to network byte order in a single
+    /// pass (with SSE2 or NEON instructions when available),
+    /// which is much faster than writing them one by one.
+    ///
+    /// \param data  Pointer to the values to write
+    /// \param count Number of values to write
+    ///
+    /// \return Reference to self
+    ///
+    /// \see readArray
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& writeArray(const bool*   data, std::size_t count);
+    Packet& writeArray(const Int8*   data, std::size_t count);
+    Packet& writeArray(const Uint8*  data, std::size_t count);
+    Packet& writeArray(const Int16*  data, std::size_t count);
+    Packet& writeArray(const Uint16* data, std::size_t count);
+    Packet& writeArray(const Int32*  data, std::size_t count);
+    Packet& writeArray(const Uint32* data, std::size_t count);
+    Packet& writeArray(const Int64*  data, std::size_t count);
+    Packet& writeArray(const Uint64* data, std::size_t count);
+    Packet& writeArray(const float*  data, std::size_t count);
+    Packet& writeArray(const double* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read an array of values from the packet
+    ///
+    /// The packet is checked once for the whole array: if it
+    /// doesn't contain \a count values, nothing is read and
+    /// the packet becomes invalid.
+    ///
+    /// \param data  Pointer to the array to fill
+    /// \param count Number of values to read
+    ///
+    /// \return Reference to self
+    ///
+    /// \see writeArray
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& readArray(bool*   data, std::size_t count);
+    Packet& readArray(Int8*   data, std::size_t count);
+    Packet& readArray(Uint8*  data, std::size_t count);
+    Packet& readArray(Int16*  data, std::size_t count);
+    Packet& readArray(Uint16* data, std::size_t count);
+    Packet& readArray(Int32*  data, std::size_t count);
+    Packet& readArray(Uint32* data, std::size_t count);
+    Packet& readArray(Int64*  data, std::size_t count);
+    Packet& readArray(Uint64* data, std::size_t count);
+    Packet& readArray(float*  data, std::size_t count);
+    Packet& readArray(double* data, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write an object described by a sf::Serializer
+    ///
+    /// The fields of the object are written exactly as the
+    /// operators << would write them, in their declared order.
+    ///
+    /// \param object Object to write
+    ///
+    /// \return Reference to self
+    ///
+    /// \see read
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename T>
+    Packet& write(const T& object);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write an array of objects described by a sf::Serializer
+    ///
+    /// The packet grows once for the whole array, and objects
+    /// made only of numbers are copied in a single pass. The
+    /// count itself is not written: send it first if the
+    /// receiver doesn't know it.
+    ///
+    /// \param objects Pointer to the objects to write
+    /// \param count   Number of objects to write
+    ///
+    /// \return Reference to self
+    ///
+    /// \see read
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename T>
+    Packet& write(const T* objects, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read an object described by a sf::Serializer
+    ///
+    /// \param object Object to fill
+    ///
+    /// \return Reference to self
+    ///
+    /// \see write
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename T>
+    Packet& read(T& object);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read an array of objects described by a sf::Serializer
+    ///
+    /// The packet is checked once for the whole array: if it
+    /// doesn't contain \a count objects, nothing is read and
+    /// the packet becomes invalid.
+    ///
+    /// \param objects Pointer to the objects to fill
+    /// \param count   Number of objects to read
+    ///
+    /// \return Reference to self
+    ///
+    /// \see write
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename T>
+    Packet& read(T* objects, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write an unsigned integer using only the given number of bits
+    ///
+    /// Consecutive writeBits calls are packed together, so that
+    /// a bool only takes 1 bit and a value known to be in [0 .. 63]
+    /// takes 6. Any other write starts at the next byte boundary.
+    ///
+    /// \param value     Value to write (its higher bits are ignored)
+    /// \param bitCount  Number of bits to write, in range [1 .. 32]
+    ///
+    /// \return Reference to self
+    ///
+    /// \see readBits
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& writeBits(Uint32 value, unsigned int bitCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write a float quantized to the given range and precision
+    ///
+    /// The value is clamped to [min .. max] and stored as an
+    /// integer of \a bitCount bits with writeBits, which gives a
+    /// precision of (max - min) / (2^bitCount - 1).
+    ///
+    /// \param value    Value to write
+    /// \param min      Minimum value of the range
+    /// \param max      Maximum value of the range
+    /// \param bitCount Number of bits to write, in range [1 .. 32]
+    ///
+    /// \return Reference to self
+    ///
+    /// \see readFloat
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& writeFloat(float value, float min, float max, unsigned int bitCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write an unsigned integer as a variable-length integer
+    ///
+    /// The value is written in LEB128 encoding: 7 bits per byte,
+    /// so that a value below 128 takes 1 byte, below 16384 takes
+    /// 2 bytes, and so on.
+    ///
+    /// \param value Value to write
+    ///
+    /// \return Reference to self
+    ///
+    /// \see readVarUint
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& writeVarUint(Uint64 value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write a signed integer as a variable-length integer
+    ///
+    /// The value is zigzag-encoded (0, -1, 1, -2, 2...) before
+    /// being written with writeVarUint, so that values close to
+    /// zero are short whatever their sign.
+    ///
+    /// \param value Value to write
+    ///
+    /// \return Reference to self
+    ///
+    /// \see readVarInt
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& writeVarInt(Int64 value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read an unsigned integer written with writeBits
+    ///
+    /// \param value    Variable to fill
+    /// \param bitCount Number of bits to read, in range [1 .. 32]
+    ///
+    /// \return Reference to self
+    ///
+    /// \see writeBits
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& readBits(Uint32& value, unsigned int bitCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a float written with writeFloat
+    ///
+    /// \param value    Variable to fill
+    /// \param min      Minimum value of the range
+    /// \param max      Maximum value of the range
+    /// \param bitCount Number of bits to read, in range [1 .. 32]
+    ///
+    /// \return Reference to self
+    ///
+    /// \see writeFloat
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& readFloat(float& value, float min, float max, unsigned int bitCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read an unsigned integer written with writeVarUint
+    ///
+    /// \param value Variable to fill
+    ///
+    /// \return Reference to self
+    ///
+    /// \see writeVarUint
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& readVarUint(Uint64& value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a signed integer written with writeVarInt
+    ///
+    /// \param value Variable to fill
+    ///
+    /// \return Reference to self
+    ///
+    /// \see writeVarInt
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& readVarInt(Int64& value);
+
 protected:
 
-    friend class TcpSocket;
+    friend class ReliableUdpConnection;
+    friend class SharedMemoryRing;
+    friend class Socket;
     friend class UdpSocket;
 
     ////////////////////////////////////////////////////////////
@@ -277,15 +629,78 @@ private:
     ////////////////////////////////////////////////////////////
     bool checkSize(std::size_t size);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Add bytes to the end of the packet, without writing them
+    ///
+    /// \param sizeInBytes Number of bytes to add
+    ///
+    /// \return Pointer to the first added byte
+    ///
+    ////////////////////////////////////////////////////////////
+    char* grow(std::size_t sizeInBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write an array of values, converted to network byte order
+    ///
+    /// \param data  Pointer to the values to write
+    /// \param count Number of values to write
+    /// \param size  Size of a value, in bytes (1, 2, 4 or 8)
+    /// \param swap  Convert the values to network byte order (integers) or leave them as is (floats)?
+    ///
+    ////////////////////////////////////////////////////////////
+    void writeValues(const void* data, std::size_t count, std::size_t size, bool swap);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read an array of values, converted from network byte order
+    ///
+    /// \param data  Pointer to the array to fill
+    /// \param count Number of values to read
+    /// \param size  Size of a value, in bytes (1, 2, 4 or 8)
+    /// \param swap  Convert the values from network byte order (integers) or leave them as is (floats)?
+    ///
+    ////////////////////////////////////////////////////////////
+    void readValues(void* data, std::size_t count, std::size_t size, bool swap);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move the reading position after an array of values
+    ///
+    /// If the packet doesn't contain the whole array, nothing is
+    /// read and the packet becomes invalid.
+    ///
+    /// \param count Number of values
+    /// \param size  Size of a value, in bytes
+    ///
+    /// \return Pointer to the first byte of the array, or NULL if the packet is too small
+    ///
+    ////////////////////////////////////////////////////////////
+    const char* consume(std::size_t count, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a pointer to the data at the current reading position
+    ///
+    /// \return Pointer to the next byte to read
+    ///
+    ////////////////////////////////////////////////////////////
+    const char* getReadPointer() const;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    std::vector<char> m_data;    ///< Data stored in the packet
-    std::size_t       m_readPos; ///< Current reading position in the packet
-    std::size_t       m_sendPos; ///< Current send position in the packet (for handling partial sends)
-    bool              m_isValid; ///< Reading state of the packet
+    std::vector<char> m_data;             ///< Data stored in the packet, when it owns its memory
+    char*             m_external;         ///< External memory holding the data (NULL if the packet owns its memory)
+    std::size_t       m_externalSize;     ///< Number of bytes used in the external memory
+    std::size_t       m_externalCapacity; ///< Size of the external memory
+    const char*       m_view;             ///< Read-only memory holding the data (see openFromMemory), NULL if none
+    std::size_t       m_viewSize;         ///< Number of bytes in the read-only memory
+    std::size_t       m_readPos;          ///< Current reading position in the packet
+    unsigned int      m_readBitPos;       ///< Number of bits already read in the byte at m_readPos
+    unsigned int      m_writeBitPos;      ///< Number of bits already written in the last byte (0 if it is full)
+    std::size_t       m_sendPos;          ///< Current send position in the packet (for handling partial sends)
+    bool              m_isValid;          ///< Reading state of the packet
 };
 
+#include <SFML/Network/Packet.inl>
+
 } // namespace sf
 
 
@@ -350,6 +765,28 @@ private:
 /// \li floating point numbers (float, double)
 /// \li string types (char*, wchar_t*, std::string, std::wstring, sf::String)
 ///
+/// For compact messages such as game state snapshots, values
+/// can also be written with fewer bits: writeBits packs small
+/// integers and bools bit by bit, writeFloat quantizes floats
+/// to a range, and writeVarUint/writeVarInt store integers in
+/// as few bytes as their value needs. The packed data is
+/// stored in the packet like any other, so it goes through
+/// onSend and onReceive (for compression, etc.) unchanged.
+/// \code
+/// packet.writeVarUint(entityId)
+///       .writeFloat(x, -1000.f, 1000.f, 20)
+///       .writeFloat(y, -1000.f, 1000.f, 20)
+///       .writeBits(isAlive, 1)
+///       .writeBits(weapon, 3);
+/// \endcode
+///
+/// Structures made of fixed-size fields are written and read
+/// faster, especially in arrays, by describing their fields
+/// once with a sf::Serializer and using write and read:
+/// \code
+/// packet.write(&players[0], players.size());
+/// \endcode
+///
 /// Like standard streams, it is also possible to define your own
 /// overloads of operators >> and << in order to handle your
 /// custom types.
@@ -373,6 +810,20 @@ private:
 /// }
 /// \endcode
 ///
+/// Data received by other means (a raw UDP receive into a
+/// buffer of your own, a file mapped in memory, ...) can be
+/// parsed without copying it, by opening a packet over it:
+/// \code
+/// char buffer[sf::UdpSocket::MaxDatagramSize];
+/// std::size_t received;
+/// if (socket.receive(buffer, sizeof(buffer), received, sender, port) == sf::Socket::Done)
+/// {
+///     sf::Packet packet;
+///     packet.openFromMemory(buffer, received);
+///     packet >> x >> s >> d;
+/// }
+/// \endcode
+///
 /// Packets also provide an extra feature that allows to apply
 /// custom transformations to the data before it is sent,
 /// and after it is received. This is typically used to
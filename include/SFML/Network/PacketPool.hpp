@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PACKETPOOL_HPP
+#define SFML_PACKETPOOL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Packet;
+
+////////////////////////////////////////////////////////////
+/// \brief Recycler of packets, to avoid allocating memory
+///        for every message
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API PacketPool : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param packetCapacity Number of bytes reserved in each new packet
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit PacketPool(std::size_t packetCapacity = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// All the packets of the pool are destroyed, including
+    /// the ones that have not been released yet.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~PacketPool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get an empty packet from the pool
+    ///
+    /// A previously released packet is returned if there is one,
+    /// with the memory it had already allocated; otherwise a new
+    /// packet is created.
+    /// This function is thread-safe.
+    ///
+    /// \return Empty packet, owned by the pool
+    ///
+    /// \see release
+    ///
+    ////////////////////////////////////////////////////////////
+    Packet& acquire();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give a packet back to the pool
+    ///
+    /// The packet is cleared, and returned again by a later call
+    /// to acquire. It must have been obtained from this pool, and
+    /// must not be used anymore after it is released.
+    /// This function is thread-safe.
+    ///
+    /// \param packet Packet to release
+    ///
+    /// \see acquire
+    ///
+    ////////////////////////////////////////////////////////////
+    void release(Packet& packet);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of packets ready to be acquired
+    ///
+    /// \return Number of released packets
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getAvailableCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::size_t          m_packetCapacity; ///< Number of bytes reserved in new packets
+    std::vector<Packet*> m_packets;        ///< All the packets created by the pool
+    std::vector<Packet*> m_available;      ///< Packets ready to be acquired
+    mutable Mutex        m_mutex;          ///< Mutex protecting the lists of packets
+};
+
+} // namespace sf
+
+
+#endif // SFML_PACKETPOOL_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::PacketPool
+/// \ingroup network
+///
+/// Servers that handle many messages create and destroy
+/// packets at a high rate, and each new packet allocates
+/// its memory again as data is appended to it. A packet pool
+/// keeps released packets with the memory they allocated,
+/// so that after a warm-up period building a message doesn't
+/// allocate anything.
+///
+/// The pool owns its packets: they stay valid until they are
+/// released, or until the pool is destroyed.
+///
+/// Usage example:
+/// \code
+/// sf::PacketPool pool(256);
+///
+/// sf::Packet& packet = pool.acquire();
+/// packet << x << y << name;
+/// socket.send(packet);
+/// pool.release(packet);
+/// \endcode
+///
+/// \see sf::Packet
+///
+////////////////////////////////////////////////////////////
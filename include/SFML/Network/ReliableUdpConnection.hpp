@@ -0,0 +1,423 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_RELIABLEUDPCONNECTION_HPP
+#define SFML_RELIABLEUDPCONNECTION_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Socket.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <deque>
+#include <map>
+#include <set>
+#include <vector>
+
+
+namespace sf
+{
+class Packet;
+class UdpSocket;
+
+////////////////////////////////////////////////////////////
+/// \brief Reliable and ordered messages over a UDP socket
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API ReliableUdpConnection : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    // Constants
+    ////////////////////////////////////////////////////////////
+    enum
+    {
+        ChannelCount = 32 ///< Number of independent channels of a connection
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Delivery guarantees of a message
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Delivery
+    {
+        Unreliable,        ///< The message may be lost, duplicated messages are not possible
+        ReliableUnordered, ///< The message is resent until it is received, in any order
+        ReliableOrdered    ///< The message is resent until it is received, in the order of its channel
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the connection to a remote peer
+    ///
+    /// The socket is not owned by the connection, it must stay
+    /// alive as long as the connection uses it. It is bound to
+    /// an arbitrary port on the first send if it is not bound yet.
+    ///
+    /// \param socket        Socket to use to communicate with the peer
+    /// \param remoteAddress Address of the remote peer
+    /// \param remotePort    Port of the remote peer
+    ///
+    ////////////////////////////////////////////////////////////
+    ReliableUdpConnection(UdpSocket& socket, const IpAddress& remoteAddress, unsigned short remotePort);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the address of the remote peer
+    ///
+    /// \return Address of the remote peer
+    ///
+    ////////////////////////////////////////////////////////////
+    const IpAddress& getRemoteAddress() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the port of the remote peer
+    ///
+    /// \return Port of the remote peer
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned short getRemotePort() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a packet for sending to the remote peer
+    ///
+    /// The packet is actually sent by the next call to update
+    /// or flush, possibly later if the congestion window is
+    /// full. Packets bigger than the maximum datagram size are
+    /// split into several datagrams and reassembled by the peer.
+    ///
+    /// \param packet   Packet to send
+    /// \param delivery Delivery guarantees of the packet
+    /// \param channel  Channel of the packet, ordering is only guaranteed within a channel
+    ///
+    /// \return Status code
+    ///
+    /// \see receive
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket::Status send(Packet& packet, Delivery delivery, Uint8 channel = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the next packet received from the remote peer
+    ///
+    /// This function never blocks: it returns sf::Socket::NotReady
+    /// if no packet is available, and sf::Socket::Disconnected
+    /// once the peer has timed out and all its packets were read.
+    ///
+    /// \param packet  Packet to fill with the received data
+    /// \param channel Variable to fill with the channel of the packet
+    ///
+    /// \return Status code
+    ///
+    /// \see send
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket::Status receive(Packet& packet, Uint8& channel);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive the pending datagrams and send the queued ones
+    ///
+    /// This function reads all the datagrams available on the
+    /// socket, without blocking, and then calls flush. It must
+    /// be called regularly, typically once per frame. Datagrams
+    /// coming from other peers are discarded: if the socket is
+    /// shared by several connections, dispatch the datagrams to
+    /// them with processDatagram and call flush instead.
+    ///
+    /// \return Status code
+    ///
+    /// \see processDatagram, flush
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket::Status update();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Handle a datagram received from the remote peer
+    ///
+    /// \param data Contents of the datagram
+    /// \param size Size of the datagram, in bytes
+    ///
+    /// \return True if the datagram was valid, false otherwise
+    ///
+    /// \see update
+    ///
+    ////////////////////////////////////////////////////////////
+    bool processDatagram(const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send the queued messages, acknowledgements and resends
+    ///
+    /// \return Status code
+    ///
+    /// \see update
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket::Status flush();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum size of the datagrams sent
+    ///
+    /// Bigger messages are fragmented. The default size of 1200
+    /// bytes avoids IP fragmentation on most networks; it can
+    /// be raised up to sf::UdpSocket::MaxDatagramSize on
+    /// networks known to support it. Both peers can use
+    /// different sizes.
+    ///
+    /// \param size Maximum size of a datagram, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMaximumDatagramSize(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the time after which a silent peer is considered disconnected
+    ///
+    /// The default timeout is 10 seconds. The connection sends
+    /// a keep-alive datagram when it has nothing to send, so
+    /// that a live peer is never silent for long.
+    ///
+    /// \param timeout Disconnection timeout
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTimeout(Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the peer has timed out
+    ///
+    /// \return True if the connection is lost
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isDisconnected() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the smoothed round-trip time to the remote peer
+    ///
+    /// \return Round-trip time, including the delay of the peer's acknowledgements
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getRoundTripTime() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of reliable messages not acknowledged yet
+    ///
+    /// \return Number of reliable messages waiting for an acknowledgement
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPendingReliableCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Datagram sent and not acknowledged yet
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SentDatagram
+    {
+        Time                time;        ///< Time the datagram was sent
+        std::vector<Uint32> reliableIds; ///< Identifiers of the reliable messages it contains
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Message being reassembled from its fragments
+    ///
+    ////////////////////////////////////////////////////////////
+    struct FragmentGroup
+    {
+        Delivery                        delivery; ///< Delivery guarantees of the message
+        Time                            time;     ///< Time the first fragment was received
+        std::vector<std::vector<char> > parts;    ///< Fragments, empty until they are received
+        std::size_t                     received; ///< Number of fragments received
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Ordering state of a channel
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Channel
+    {
+        Channel();
+
+        Uint32                               nextSent;     ///< Order of the next ordered message to send
+        Uint32                               nextReceived; ///< Order of the next ordered message to deliver
+        std::map<Uint32, std::vector<char> > early;        ///< Ordered messages received too early
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Message received and not read yet
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Received
+    {
+        Uint8             channel; ///< Channel of the message
+        std::vector<char> data;    ///< Contents of the message
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue one encoded message for sending
+    ///
+    ////////////////////////////////////////////////////////////
+    void queueMessage(Delivery delivery, Uint8 channel, Uint32 order, const char* data, std::size_t size, Uint32 group, Uint16 index, Uint16 count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Handle one message extracted from a datagram
+    ///
+    ////////////////////////////////////////////////////////////
+    void processMessage(Delivery delivery, Uint8 channel, Uint32 order, std::vector<char>& data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Register the acknowledgements carried by a datagram header
+    ///
+    ////////////////////////////////////////////////////////////
+    void processAcks(Uint16 ack, Uint32 ackBits);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Acknowledge a datagram that we sent
+    ///
+    ////////////////////////////////////////////////////////////
+    void acknowledge(std::map<Uint16, SentDatagram>::iterator datagram, bool measure);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Detect the datagrams that were lost and schedule their reliable messages again
+    ///
+    ////////////////////////////////////////////////////////////
+    void detectLosses();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send a datagram made of the given messages
+    ///
+    /// The first bytes of the datagram are reserved for its
+    /// header, which is filled by this function.
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket::Status sendDatagram(std::vector<char>& datagram, std::vector<Uint32>& reliableIds);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    UdpSocket&                           m_socket;                 ///< Socket used to communicate with the peer
+    IpAddress                            m_remoteAddress;          ///< Address of the remote peer
+    unsigned short                       m_remotePort;             ///< Port of the remote peer
+    std::size_t                          m_datagramSize;           ///< Maximum size of the datagrams sent
+    Time                                 m_timeout;                ///< Disconnection timeout
+    Clock                                m_clock;                  ///< Clock measuring the connection time
+    Time                                 m_lastReceived;           ///< Time of the last datagram received from the peer
+    Time                                 m_lastSent;               ///< Time of the last datagram sent to the peer
+    bool                                 m_disconnected;           ///< Has the peer timed out?
+    Uint16                               m_localSequence;          ///< Sequence number of the next datagram to send
+    Uint16                               m_remoteSequence;         ///< Most recent sequence number received
+    Uint32                               m_receivedBits;           ///< Datagrams received among the 32 before the most recent one
+    bool                                 m_receivedAny;            ///< Has any datagram been received?
+    std::size_t                          m_unacknowledged;         ///< Number of datagrams with messages received since the last acknowledgement
+    unsigned int                         m_acknowledgements;       ///< Number of datagrams that must still carry the last acknowledgement
+    Uint16                               m_highestAcked;           ///< Most recent sequence number acknowledged by the peer
+    bool                                 m_ackedAny;               ///< Has the peer acknowledged any datagram?
+    std::map<Uint16, SentDatagram>       m_sentDatagrams;          ///< Datagrams with reliable messages waiting for an acknowledgement
+    Uint32                               m_nextReliableId;         ///< Identifier of the next reliable message
+    Uint32                               m_nextGroup;              ///< Identifier of the next fragmented message
+    std::map<Uint32, std::vector<char> > m_pendingReliable;        ///< Encoded reliable messages not acknowledged yet
+    std::deque<Uint32>                   m_reliableQueue;          ///< Reliable messages to send or resend
+    std::deque<std::vector<char> >       m_unreliableQueue;        ///< Encoded unreliable messages to send
+    Uint32                               m_reliableBase;           ///< All the reliable messages below this identifier were received
+    std::set<Uint32>                     m_reliableReceived;       ///< Reliable messages received above the base
+    std::map<Uint32, FragmentGroup>      m_fragmentGroups;         ///< Messages being reassembled
+    Channel                              m_channels[ChannelCount]; ///< Ordering state of the channels
+    std::deque<Received>                 m_receivedQueue;          ///< Messages received and not read yet
+    Time                                 m_smoothedRtt;            ///< Smoothed round-trip time
+    Time                                 m_rttVariation;           ///< Variation of the round-trip time
+    Time                                 m_retransmitTimeout;      ///< Time after which an unacknowledged datagram is considered lost
+    bool                                 m_rttMeasured;            ///< Has the round-trip time been measured?
+    float                                m_congestionWindow;       ///< Maximum number of datagrams with reliable messages in flight
+    float                                m_slowStartThreshold;     ///< Window size where the slow start ends
+    Time                                 m_lastReduction;          ///< Time the window was last reduced
+    Time                                 m_lastAcknowledgement;    ///< Time of the last datagram acknowledged by the peer
+    std::vector<char>                    m_buffer;                 ///< Buffer to receive datagrams
+};
+
+} // namespace sf
+
+
+#endif // SFML_RELIABLEUDPCONNECTION_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ReliableUdpConnection
+/// \ingroup network
+///
+/// sf::TcpSocket is reliable, but a single lost segment holds
+/// back everything sent after it (head-of-line blocking), and
+/// sf::UdpSocket has no delivery guarantee at all.
+/// sf::ReliableUdpConnection sits on top of a sf::UdpSocket
+/// and lets each packet choose its guarantees: unreliable,
+/// reliable in any order, or reliable and ordered. Ordering
+/// only applies within one of the ChannelCount channels, so
+/// that a lost message only delays the messages of its own
+/// channel.
+///
+/// Every datagram carries a sequence number and acknowledges
+/// the last 33 datagrams received from the peer, so that
+/// acknowledgements are selective and redundant. A datagram
+/// is considered lost when datagrams sent after it are
+/// acknowledged, or when it is not acknowledged after the
+/// retransmission timeout (derived from the measured
+/// round-trip time); its reliable messages are then sent
+/// again. The number
+/// of datagrams with reliable messages in flight is limited by
+/// a congestion window that grows as acknowledgements arrive
+/// and is halved when losses are detected. Packets bigger than
+/// the maximum datagram size are fragmented and reassembled.
+///
+/// There is no connection handshake: the connection is
+/// established as soon as both peers exchange datagrams, and
+/// is considered lost when the peer has been silent for
+/// longer than the timeout. Both peers must use
+/// sf::ReliableUdpConnection.
+///
+/// Usage example:
+/// \code
+/// sf::UdpSocket socket;
+/// socket.bind(54000);
+/// sf::ReliableUdpConnection connection(socket, "192.168.1.50", 54000);
+///
+/// sf::Packet hello;
+/// hello << "hello";
+/// connection.send(hello, sf::ReliableUdpConnection::ReliableOrdered, 0);
+///
+/// while (!connection.isDisconnected())
+/// {
+///     connection.update();
+///
+///     sf::Packet packet;
+///     sf::Uint8 channel;
+///     while (connection.receive(packet, channel) == sf::Socket::Done)
+///         handlePacket(packet, channel);
+///
+///     sf::sleep(sf::milliseconds(16));
+/// }
+/// \endcode
+///
+/// \see sf::UdpSocket, sf::Packet
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,293 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SERIALIZER_HPP
+#define SFML_SERIALIZER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <cstddef>
+#include <cstring>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Description of how a type is written to packets
+///
+/// This template is not defined: a type becomes serializable
+/// by specializing it, usually by inheriting from
+/// sf::SerializerFields (see the documentation of sf::Serializer).
+///
+/// A specialization provides a compile-time Size (the number
+/// of bytes of an object in a packet) and two static
+/// functions, which write and read arrays of objects in raw
+/// memory:
+/// \code
+/// static void store(char* output, const T* objects, std::size_t count);
+/// static void load(const char* input, T* objects, std::size_t count);
+/// \endcode
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+struct Serializer;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Wire format of a field of a serialized object
+///
+/// Arithmetic types are written like the operators << of
+/// sf::Packet do. Other types are serialized objects
+/// themselves, written with their own sf::Serializer.
+///
+////////////////////////////////////////////////////////////
+template <typename F>
+struct SerializerValue
+{
+    enum {Size     = Serializer<F>::Size}; ///< Number of bytes written
+    enum {Packable = false};               ///< Is the value written as its bytes in memory (possibly swapped)?
+    enum {Swapped  = false};               ///< Are the bytes swapped to network byte order?
+
+    static void store(char* output, const F& value) {Serializer<F>::store(output, &value, 1);}
+    static void load(const char* input, F& value)   {Serializer<F>::load(input, &value, 1);}
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Empty field, filling the unused parameters of sf::SerializerFields
+///
+////////////////////////////////////////////////////////////
+struct SerializerNoField
+{
+    enum {Size = 0};
+    enum {Packable = true};
+
+    template <typename T> static void store(char*&, const T&) {}
+    template <typename T> static void load(const char*&, T&) {}
+    template <typename T> static bool follows(const T&, std::size_t&) {return true;}
+    template <typename T> static void swap(char*, const T&, std::size_t, std::size_t) {}
+};
+
+} // namespace priv
+
+
+////////////////////////////////////////////////////////////
+/// \brief Field of a serialized object, given by its type and member pointer
+///
+////////////////////////////////////////////////////////////
+template <typename T, typename F, F T::*Member>
+struct SerializerField
+{
+    typedef priv::SerializerValue<F> Value;
+
+    enum {Size     = Value::Size};     ///< Number of bytes written
+    enum {Packable = Value::Packable}; ///< Is the field written as its bytes in memory (possibly swapped)?
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write the field of an object, and move the output after it
+    ///
+    ////////////////////////////////////////////////////////////
+    static void store(char*& output, const T& object);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the field of an object, and move the input after it
+    ///
+    ////////////////////////////////////////////////////////////
+    static void load(const char*& input, T& object);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether the field is at the given offset in the object, and move the offset after it
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool follows(const T& object, std::size_t& offset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the bytes of the field in an array of objects copied as is
+    ///
+    ////////////////////////////////////////////////////////////
+    static void swap(char* data, const T& object, std::size_t count, std::size_t stride);
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Shortcut to name a field of a serialized object
+///
+/// \param type   Type of the serialized object
+/// \param field  Type of the field
+/// \param member Name of the field
+///
+////////////////////////////////////////////////////////////
+#define SFML_SERIALIZER_FIELD(type, field, member) sf::SerializerField<type, field, &type::member>
+
+////////////////////////////////////////////////////////////
+/// \brief Serializer of an object made of up to 16 fields
+///
+////////////////////////////////////////////////////////////
+template <typename T,
+          typename F1,                             typename F2  = priv::SerializerNoField,
+          typename F3  = priv::SerializerNoField, typename F4  = priv::SerializerNoField,
+          typename F5  = priv::SerializerNoField, typename F6  = priv::SerializerNoField,
+          typename F7  = priv::SerializerNoField, typename F8  = priv::SerializerNoField,
+          typename F9  = priv::SerializerNoField, typename F10 = priv::SerializerNoField,
+          typename F11 = priv::SerializerNoField, typename F12 = priv::SerializerNoField,
+          typename F13 = priv::SerializerNoField, typename F14 = priv::SerializerNoField,
+          typename F15 = priv::SerializerNoField, typename F16 = priv::SerializerNoField>
+struct SerializerFields
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Number of bytes of an object in a packet
+    ///
+    ////////////////////////////////////////////////////////////
+    enum {Size = F1::Size  + F2::Size  + F3::Size  + F4::Size  + F5::Size  + F6::Size  + F7::Size  + F8::Size +
+                 F9::Size  + F10::Size + F11::Size + F12::Size + F13::Size + F14::Size + F15::Size + F16::Size};
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Can the objects be copied as is?
+    ///
+    /// True when every field is a number (other than bool) and
+    /// the fields cover the whole object, without padding.
+    ///
+    ////////////////////////////////////////////////////////////
+    enum {Packable = F1::Packable  && F2::Packable  && F3::Packable  && F4::Packable  &&
+                     F5::Packable  && F6::Packable  && F7::Packable  && F8::Packable  &&
+                     F9::Packable  && F10::Packable && F11::Packable && F12::Packable &&
+                     F13::Packable && F14::Packable && F15::Packable && F16::Packable &&
+                     (static_cast<std::size_t>(Size) == sizeof(T))};
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write an array of objects
+    ///
+    /// \param output  Memory to write to, at least \a count * Size bytes
+    /// \param objects Objects to write
+    /// \param count   Number of objects
+    ///
+    ////////////////////////////////////////////////////////////
+    static void store(char* output, const T* objects, std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read an array of objects
+    ///
+    /// \param input   Memory to read from, at least \a count * Size bytes
+    /// \param objects Objects to fill
+    /// \param count   Number of objects
+    ///
+    ////////////////////////////////////////////////////////////
+    static void load(const char* input, T* objects, std::size_t count);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether the objects can be copied as is
+    ///
+    /// The fields must also be declared in the order of the
+    /// members of the object.
+    ///
+    /// \param object Any object of the type
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isPacked(const T& object);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert copied objects between host and network byte order
+    ///
+    ////////////////////////////////////////////////////////////
+    static void swap(char* data, const T& object, std::size_t count);
+};
+
+#include <SFML/Network/Serializer.inl>
+
+} // namespace sf
+
+
+#endif // SFML_SERIALIZER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Serializer
+/// \ingroup network
+///
+/// Writing a structure field by field with the operators
+/// << of sf::Packet checks and grows the packet for every
+/// field. sf::Serializer describes the fields of a type
+/// once, so that sf::Packet::write and sf::Packet::read
+/// process whole objects, or arrays of objects, at once:
+/// the size of an object in the packet is known at compile
+/// time, the packet grows only once per call, and the fields
+/// are written directly to their final place.
+///
+/// When the fields are numbers that cover the whole object
+/// in the order of its members, without padding, the
+/// objects are even copied as is, in a single memcpy, and
+/// only the integers are then converted to network byte
+/// order (on big-endian hosts, there's nothing more to do).
+/// Other objects, with bool fields, padding or nested
+/// serialized objects, are written field by field.
+///
+/// Either way, the bytes in the packet are the same as the
+/// ones written by the operators << for each field in their
+/// declared order, so that both sides don't have to use the
+/// same method, or even the same compiler or platform.
+///
+/// A type is made serializable by specializing sf::Serializer
+/// in the sf namespace, and inheriting from sf::SerializerFields
+/// with its fields (up to 16, which may be other serialized
+/// types):
+/// \code
+/// struct PlayerState
+/// {
+///     sf::Uint32 id;
+///     float      x;
+///     float      y;
+///     sf::Int16  health;
+///     sf::Int16  ammo;
+/// };
+///
+/// namespace sf
+/// {
+///     template <>
+///     struct Serializer<PlayerState> : SerializerFields<PlayerState,
+///         SFML_SERIALIZER_FIELD(PlayerState, sf::Uint32, id),
+///         SFML_SERIALIZER_FIELD(PlayerState, float,      x),
+///         SFML_SERIALIZER_FIELD(PlayerState, float,      y),
+///         SFML_SERIALIZER_FIELD(PlayerState, sf::Int16,  health),
+///         SFML_SERIALIZER_FIELD(PlayerState, sf::Int16,  ammo)>
+///     {
+///     };
+/// }
+///
+/// std::vector<PlayerState> players = ...;
+///
+/// sf::Packet packet;
+/// packet << static_cast<sf::Uint32>(players.size());
+/// packet.write(&players[0], players.size());
+/// \endcode
+///
+/// Only fixed-size fields can be serialized this way:
+/// strings and other variable-length data are still written
+/// with the operators of sf::Packet, before or after.
+///
+/// \see sf::Packet
+///
+////////////////////////////////////////////////////////////
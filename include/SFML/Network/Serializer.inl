@@ -0,0 +1,249 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+inline bool isHostBigEndian()
+{
+    const Uint16 one = 1;
+    return *reinterpret_cast<const Uint8*>(&one) == 0;
+}
+
+
+////////////////////////////////////////////////////////////
+// Copy a value, reversing the order of its bytes on little-endian hosts
+template <std::size_t N>
+inline void copyNetworkOrder(char* output, const char* input)
+{
+    if (isHostBigEndian())
+    {
+        std::memcpy(output, input, N);
+    }
+    else
+    {
+        for (std::size_t i = 0; i < N; ++i)
+            output[i] = input[N - 1 - i];
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+// Reverse the order of the bytes of a value in place
+template <std::size_t N>
+inline void swapBytes(char* data)
+{
+    for (std::size_t i = 0; i < N / 2; ++i)
+    {
+        char byte = data[i];
+        data[i] = data[N - 1 - i];
+        data[N - 1 - i] = byte;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+// Numbers are written like the operators << of sf::Packet: integers in network byte order, floats as is
+#define SFML_SERIALIZER_NUMBER(type, swapped) \
+template <> \
+struct SerializerValue<type> \
+{ \
+    enum {Size     = sizeof(type)}; \
+    enum {Packable = true}; \
+    enum {Swapped  = swapped && (sizeof(type) > 1)}; \
+    static void store(char* output, const type& value) \
+    { \
+        if (Swapped) \
+            copyNetworkOrder<sizeof(type)>(output, reinterpret_cast<const char*>(&value)); \
+        else \
+            std::memcpy(output, &value, sizeof(type)); \
+    } \
+    static void load(const char* input, type& value) \
+    { \
+        if (Swapped) \
+            copyNetworkOrder<sizeof(type)>(reinterpret_cast<char*>(&value), input); \
+        else \
+            std::memcpy(&value, input, sizeof(type)); \
+    } \
+};
+
+SFML_SERIALIZER_NUMBER(Int8,   true)
+SFML_SERIALIZER_NUMBER(Uint8,  true)
+SFML_SERIALIZER_NUMBER(Int16,  true)
+SFML_SERIALIZER_NUMBER(Uint16, true)
+SFML_SERIALIZER_NUMBER(Int32,  true)
+SFML_SERIALIZER_NUMBER(Uint32, true)
+SFML_SERIALIZER_NUMBER(Int64,  true)
+SFML_SERIALIZER_NUMBER(Uint64, true)
+SFML_SERIALIZER_NUMBER(float,  false)
+SFML_SERIALIZER_NUMBER(double, false)
+
+#undef SFML_SERIALIZER_NUMBER
+
+
+////////////////////////////////////////////////////////////
+// Bools are written as a byte (0 or 1), which is not necessarily their representation in memory
+template <>
+struct SerializerValue<bool>
+{
+    enum {Size     = 1};
+    enum {Packable = false};
+    enum {Swapped  = false};
+
+    static void store(char* output, const bool& value) {*output = value ? 1 : 0;}
+    static void load(const char* input, bool& value)   {value = (*input != 0);}
+};
+
+} // namespace priv
+
+
+////////////////////////////////////////////////////////////
+template <typename T, typename F, F T::*Member>
+void SerializerField<T, F, Member>::store(char*& output, const T& object)
+{
+    Value::store(output, object.*Member);
+    output += Size;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T, typename F, F T::*Member>
+void SerializerField<T, F, Member>::load(const char*& input, T& object)
+{
+    Value::load(input, object.*Member);
+    input += Size;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T, typename F, F T::*Member>
+bool SerializerField<T, F, Member>::follows(const T& object, std::size_t& offset)
+{
+    // The offset of a member is a constant, the compiler folds this computation
+    const char* field = reinterpret_cast<const char*>(&(object.*Member));
+    bool contiguous = (static_cast<std::size_t>(field - reinterpret_cast<const char*>(&object)) == offset);
+    offset += Size;
+
+    return contiguous;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T, typename F, F T::*Member>
+void SerializerField<T, F, Member>::swap(char* data, const T& object, std::size_t count, std::size_t stride)
+{
+    if (!Value::Swapped)
+        return;
+
+    // Swap the same field of all the objects at once, so that the loop can be vectorized
+    data += reinterpret_cast<const char*>(&(object.*Member)) - reinterpret_cast<const char*>(&object);
+    for (std::size_t i = 0; i < count; ++i)
+        priv::swapBytes<Size>(data + i * stride);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T, typename F1, typename F2, typename F3, typename F4, typename F5, typename F6, typename F7, typename F8,
+          typename F9, typename F10, typename F11, typename F12, typename F13, typename F14, typename F15, typename F16>
+void SerializerFields<T, F1, F2, F3, F4, F5, F6, F7, F8, F9, F10, F11, F12, F13, F14, F15, F16>::store(char* output, const T* objects, std::size_t count)
+{
+    if (count == 0)
+        return;
+
+    if (isPacked(objects[0]))
+    {
+        std::memcpy(output, objects, count * sizeof(T));
+        if (!priv::isHostBigEndian())
+            swap(output, objects[0], count);
+        return;
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const T& object = objects[i];
+        F1::store(output, object);  F2::store(output, object);  F3::store(output, object);  F4::store(output, object);
+        F5::store(output, object);  F6::store(output, object);  F7::store(output, object);  F8::store(output, object);
+        F9::store(output, object);  F10::store(output, object); F11::store(output, object); F12::store(output, object);
+        F13::store(output, object); F14::store(output, object); F15::store(output, object); F16::store(output, object);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T, typename F1, typename F2, typename F3, typename F4, typename F5, typename F6, typename F7, typename F8,
+          typename F9, typename F10, typename F11, typename F12, typename F13, typename F14, typename F15, typename F16>
+void SerializerFields<T, F1, F2, F3, F4, F5, F6, F7, F8, F9, F10, F11, F12, F13, F14, F15, F16>::load(const char* input, T* objects, std::size_t count)
+{
+    if (count == 0)
+        return;
+
+    if (isPacked(objects[0]))
+    {
+        std::memcpy(objects, input, count * sizeof(T));
+        if (!priv::isHostBigEndian())
+            swap(reinterpret_cast<char*>(objects), objects[0], count);
+        return;
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        T& object = objects[i];
+        F1::load(input, object);  F2::load(input, object);  F3::load(input, object);  F4::load(input, object);
+        F5::load(input, object);  F6::load(input, object);  F7::load(input, object);  F8::load(input, object);
+        F9::load(input, object);  F10::load(input, object); F11::load(input, object); F12::load(input, object);
+        F13::load(input, object); F14::load(input, object); F15::load(input, object); F16::load(input, object);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T, typename F1, typename F2, typename F3, typename F4, typename F5, typename F6, typename F7, typename F8,
+          typename F9, typename F10, typename F11, typename F12, typename F13, typename F14, typename F15, typename F16>
+bool SerializerFields<T, F1, F2, F3, F4, F5, F6, F7, F8, F9, F10, F11, F12, F13, F14, F15, F16>::isPacked(const T& object)
+{
+    if (!Packable)
+        return false;
+
+    std::size_t offset = 0;
+    return F1::follows(object, offset)  && F2::follows(object, offset)  && F3::follows(object, offset)  && F4::follows(object, offset)  &&
+           F5::follows(object, offset)  && F6::follows(object, offset)  && F7::follows(object, offset)  && F8::follows(object, offset)  &&
+           F9::follows(object, offset)  && F10::follows(object, offset) && F11::follows(object, offset) && F12::follows(object, offset) &&
+           F13::follows(object, offset) && F14::follows(object, offset) && F15::follows(object, offset) && F16::follows(object, offset);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T, typename F1, typename F2, typename F3, typename F4, typename F5, typename F6, typename F7, typename F8,
+          typename F9, typename F10, typename F11, typename F12, typename F13, typename F14, typename F15, typename F16>
+void SerializerFields<T, F1, F2, F3, F4, F5, F6, F7, F8, F9, F10, F11, F12, F13, F14, F15, F16>::swap(char* data, const T& object, std::size_t count)
+{
+    F1::swap(data, object, count, sizeof(T));  F2::swap(data, object, count, sizeof(T));
+    F3::swap(data, object, count, sizeof(T));  F4::swap(data, object, count, sizeof(T));
+    F5::swap(data, object, count, sizeof(T));  F6::swap(data, object, count, sizeof(T));
+    F7::swap(data, object, count, sizeof(T));  F8::swap(data, object, count, sizeof(T));
+    F9::swap(data, object, count, sizeof(T));  F10::swap(data, object, count, sizeof(T));
+    F11::swap(data, object, count, sizeof(T)); F12::swap(data, object, count, sizeof(T));
+    F13::swap(data, object, count, sizeof(T)); F14::swap(data, object, count, sizeof(T));
+    F15::swap(data, object, count, sizeof(T)); F16::swap(data, object, count, sizeof(T));
+}
@@ -0,0 +1,286 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef SFML_SHAREDMEMORYRING_HPP
+#define SFML_SHAREDMEMORYRING_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <string>
+
+
+namespace sf
+{
+class Packet;
+
+////////////////////////////////////////////////////////////
+/// \brief Ring buffer of messages shared by two processes
+///        of the same host
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API SharedMemoryRing : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The ring is not usable until it is created or opened.
+    ///
+    ////////////////////////////////////////////////////////////
+    SharedMemoryRing();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The ring is closed (see close).
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SharedMemoryRing();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a new shared ring
+    ///
+    /// The name identifies the ring for the other process (see
+    /// open); it must be a simple name, without slashes. The
+    /// capacity is rounded up to a power of two, and limits the
+    /// size of the messages to half of it.
+    /// The function fails if a ring of the same name exists.
+    ///
+    /// \param name     Name of the ring
+    /// \param capacity Number of bytes available for the messages
+    ///
+    /// \return True if the ring was created
+    ///
+    /// \see open, close
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(const std::string& name, std::size_t capacity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open a ring created by another process
+    ///
+    /// \param name Name given to create by the other process
+    ///
+    /// \return True if the ring was opened
+    ///
+    /// \see create, close
+    ///
+    ////////////////////////////////////////////////////////////
+    bool open(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Close the ring
+    ///
+    /// If the ring was created by this instance, its name is
+    /// removed so that it can be created again; the other
+    /// process can keep using its own mapping until it closes
+    /// it. This function has no effect if the ring is not open.
+    ///
+    ////////////////////////////////////////////////////////////
+    void close();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the ring is open
+    ///
+    /// \return True if the ring was created or opened
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isOpen() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum size of a message
+    ///
+    /// \return Maximum size of a message, in bytes (0 if the ring is not open)
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getMaxMessageSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reserve space for a new message
+    ///
+    /// The message is written directly in the shared memory,
+    /// then published with endWrite. This is how big messages
+    /// are handed to the other process without any copy.
+    /// Only one process can write to a ring.
+    ///
+    /// \param size Size of the message, in bytes
+    ///
+    /// \return Address where to write the message, or a null pointer if the ring is full
+    ///
+    /// \see endWrite, write
+    ///
+    ////////////////////////////////////////////////////////////
+    void* beginWrite(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Publish the message reserved by beginWrite
+    ///
+    /// \see beginWrite
+    ///
+    ////////////////////////////////////////////////////////////
+    void endWrite();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy a message to the ring
+    ///
+    /// \param data Data of the message
+    /// \param size Size of the message, in bytes
+    ///
+    /// \return True if the message was written, false if the ring is full
+    ///
+    ////////////////////////////////////////////////////////////
+    bool write(const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy a packet to the ring
+    ///
+    /// \param packet Packet to write
+    ///
+    /// \return True if the packet was written, false if the ring is full
+    ///
+    ////////////////////////////////////////////////////////////
+    bool write(Packet& packet);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Access the next message
+    ///
+    /// The message stays in the shared memory, and can be used
+    /// in place until endRead is called.
+    /// Only one process can read from a ring.
+    ///
+    /// \param size Variable to fill with the size of the message
+    ///
+    /// \return Address of the message, or a null pointer if the ring is empty
+    ///
+    /// \see endRead, read
+    ///
+    ////////////////////////////////////////////////////////////
+    const void* beginRead(std::size_t& size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the message accessed by beginRead
+    ///
+    /// Its space can then be reused by the writer.
+    ///
+    /// \see beginRead
+    ///
+    ////////////////////////////////////////////////////////////
+    void endRead();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the next message into a packet
+    ///
+    /// \param packet Packet to fill with the message
+    ///
+    /// \return True if a message was read, false if the ring is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    bool read(Packet& packet);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Map the shared memory and check its header
+    ///
+    /// \param capacity Capacity of a new ring, or 0 to open an existing one
+    ///
+    /// \return True on success
+    ///
+    ////////////////////////////////////////////////////////////
+    bool map(std::size_t capacity);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::string m_name;      ///< Name of the ring
+    bool        m_owner;     ///< Was the ring created by this instance?
+    void*       m_mapping;   ///< Handle of the shared memory (Windows only)
+    void*       m_memory;    ///< Address of the shared memory
+    std::size_t m_size;      ///< Size of the shared memory
+    char*       m_data;      ///< Address of the messages, after the header
+    Uint32      m_capacity;  ///< Size of the message area, a power of two
+    Uint32      m_reserved;  ///< Position of the message reserved by beginWrite
+    Uint32      m_writeSize; ///< Size of the message reserved by beginWrite (0 if none)
+    Uint32      m_readSize;  ///< Size of the record accessed by beginRead (0 if none)
+};
+
+} // namespace sf
+
+
+#endif // SFML_SHAREDMEMORYRING_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SharedMemoryRing
+/// \ingroup network
+///
+/// sf::SharedMemoryRing is a single-producer single-consumer
+/// queue of messages in a block of memory shared by two
+/// processes of the same host. One process creates the ring
+/// and the other opens it with the same name; then one of them
+/// writes messages and the other reads them, without any system
+/// call: it is the cheapest way to hand large amounts of data
+/// (frames for a recorder, replays, world snapshots) to a
+/// sidecar process. Use two rings for both directions, and a
+/// sf::LocalSocket for the control messages that need a
+/// connection.
+///
+/// The messages can be copied in and out (write and read,
+/// with raw data or packets), or written and read in place,
+/// without any copy (beginWrite/endWrite and beginRead/endRead).
+/// The functions never block: write fails when the ring is full,
+/// and read when it is empty, so that the caller can decide how
+/// to wait.
+///
+/// Usage example:
+/// \code
+/// // ----- The game server -----
+/// sf::SharedMemoryRing frames;
+/// frames.create("game-frames", 64 * 1024 * 1024);
+///
+/// void* frame = frames.beginWrite(frameSize);
+/// if (frame)
+/// {
+///     renderFrameTo(frame);
+///     frames.endWrite();
+/// }
+///
+/// // ----- The recorder -----
+/// sf::SharedMemoryRing frames;
+/// frames.open("game-frames");
+///
+/// std::size_t size;
+/// while (const void* frame = frames.beginRead(size))
+/// {
+///     encode(frame, size);
+///     frames.endRead();
+/// }
+/// \endcode
+///
+/// \see sf::LocalSocket
+///
+////////////////////////////////////////////////////////////
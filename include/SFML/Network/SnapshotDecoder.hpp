@@ -0,0 +1,155 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SNAPSHOTDECODER_HPP
+#define SFML_SNAPSHOTDECODER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <deque>
+#include <vector>
+
+
+namespace sf
+{
+class Packet;
+
+////////////////////////////////////////////////////////////
+/// \brief Decoder of snapshots encoded by a sf::SnapshotEncoder
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API SnapshotDecoder
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    // Constants
+    ////////////////////////////////////////////////////////////
+    enum
+    {
+        MaxSnapshots = 64 ///< Maximum number of decoded snapshots kept as possible baselines
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    SnapshotDecoder();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode a snapshot
+    ///
+    /// The encoded snapshot is read from the current reading
+    /// position of \a input, and the decoded snapshot replaces
+    /// the contents of \a snapshot. Snapshots older than the
+    /// last one decoded are read but not decoded, since they
+    /// are outdated.
+    ///
+    /// \param input    Packet to read the encoded snapshot from
+    /// \param snapshot Packet to fill with the decoded snapshot
+    ///
+    /// \return True if a new snapshot was decoded, false if it was outdated or invalid
+    ///
+    /// \see getLastSequence
+    ///
+    ////////////////////////////////////////////////////////////
+    bool decode(Packet& input, Packet& snapshot);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sequence number of the last snapshot decoded
+    ///
+    /// This is the number to send back to the encoder, so that
+    /// it can use the snapshot as a baseline.
+    ///
+    /// \return Sequence number of the last snapshot decoded, or 0 if none
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 getLastSequence() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget all the decoded snapshots
+    ///
+    /// The encoder must be reset too, so that it sends the next
+    /// snapshot in full.
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Snapshot decoded, which can be used as a baseline
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Snapshot
+    {
+        Uint32            sequence; ///< Sequence number of the snapshot
+        std::vector<char> data;     ///< Contents of the snapshot
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::deque<Snapshot> m_snapshots; ///< Snapshots decoded, sorted by sequence number
+    std::vector<Uint8>   m_masks;     ///< Masks of the changed blocks of the snapshot being decoded
+    std::vector<Uint8>   m_changes;   ///< Changed bytes of the snapshot being decoded
+};
+
+} // namespace sf
+
+
+#endif // SFML_SNAPSHOTDECODER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SnapshotDecoder
+/// \ingroup network
+///
+/// sf::SnapshotDecoder rebuilds the snapshots encoded by a
+/// sf::SnapshotEncoder, from the previous snapshots that it
+/// decoded. After each snapshot decoded, send the sequence
+/// number returned by getLastSequence back to the encoder, so
+/// that it can encode the next ones against it.
+///
+/// Usage example:
+/// \code
+/// sf::Packet packet;
+/// socket.receive(packet, sender, port);
+///
+/// sf::Packet snapshot;
+/// if (decoder.decode(packet, snapshot))
+/// {
+///     readWorld(snapshot);
+///
+///     sf::Packet acknowledgement;
+///     acknowledgement << decoder.getLastSequence();
+///     socket.send(acknowledgement, server, serverPort);
+/// }
+/// \endcode
+///
+/// \see sf::SnapshotEncoder, sf::Packet
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,193 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SNAPSHOTENCODER_HPP
+#define SFML_SNAPSHOTENCODER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <deque>
+#include <vector>
+
+
+namespace sf
+{
+class Packet;
+
+////////////////////////////////////////////////////////////
+/// \brief Encoder of snapshots as differences to the last
+///        snapshot acknowledged by the remote peer
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API SnapshotEncoder
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    // Constants
+    ////////////////////////////////////////////////////////////
+    enum
+    {
+        MaxPendingSnapshots = 64 ///< Maximum number of snapshots kept while waiting for an acknowledgement
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The first snapshot encoded is sent in full.
+    ///
+    ////////////////////////////////////////////////////////////
+    SnapshotEncoder();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Encode a snapshot
+    ///
+    /// The snapshot is encoded as its differences with the last
+    /// snapshot acknowledged by the peer, or in full if none was
+    /// acknowledged yet, and appended to \a output. The encoded
+    /// data must be decoded by a sf::SnapshotDecoder, in the
+    /// same order as the other data of \a output.
+    ///
+    /// \param snapshot Packet containing the snapshot
+    /// \param output   Packet to append the encoded snapshot to
+    ///
+    /// \return Sequence number of the snapshot, to be acknowledged by the peer
+    ///
+    /// \see acknowledge
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 encode(const Packet& snapshot, Packet& output);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Register that the peer received a snapshot
+    ///
+    /// The snapshot becomes the baseline of the next ones, if
+    /// it is more recent than the current baseline. Outdated or
+    /// unknown sequence numbers are ignored, so acknowledgements
+    /// can be sent unreliably and arrive in any order.
+    ///
+    /// \param sequence Sequence number of the snapshot, as returned by sf::SnapshotDecoder::getLastSequence
+    ///
+    /// \see getBaseline
+    ///
+    ////////////////////////////////////////////////////////////
+    void acknowledge(Uint32 sequence);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sequence number of the current baseline
+    ///
+    /// \return Sequence number of the last snapshot acknowledged, or 0 if none
+    ///
+    /// \see acknowledge
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 getBaseline() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget the baseline and the pending snapshots
+    ///
+    /// The next snapshot is sent in full. This must be called
+    /// when the peer's decoder is reset, typically when it
+    /// reconnects.
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Snapshot sent to the peer
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Snapshot
+    {
+        Uint32            sequence; ///< Sequence number of the snapshot
+        std::vector<char> data;     ///< Contents of the snapshot
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Uint32               m_nextSequence; ///< Sequence number of the next snapshot
+    Snapshot             m_baseline;     ///< Last snapshot acknowledged by the peer
+    std::deque<Snapshot> m_pending;      ///< Snapshots sent after the baseline and not acknowledged yet
+    std::vector<Uint8>   m_changes;      ///< Changed bytes of the snapshot being encoded (kept to avoid reallocations)
+};
+
+} // namespace sf
+
+
+#endif // SFML_SNAPSHOTENCODER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SnapshotEncoder
+/// \ingroup network
+///
+/// Game servers typically send the whole state of the world
+/// to each client several times per second, and most of it
+/// doesn't change from one snapshot to the next.
+/// sf::SnapshotEncoder only sends the bytes that changed since
+/// the last snapshot that the client acknowledged, which is
+/// known to be available on its side; lost snapshots are
+/// therefore never a problem, and the snapshots can be sent
+/// with sf::UdpSocket or as unreliable messages of a
+/// sf::ReliableUdpConnection.
+///
+/// The snapshot is XORed with the baseline, 8 bytes at a
+/// time. The resulting data is written with the bit-packed
+/// functions of sf::Packet: one bit per block of 8 bytes
+/// telling whether it changed, plus a mask of 8 bits for each
+/// changed block, followed by the changed bytes only. For the
+/// encoding to be efficient, the snapshots should keep the
+/// data of each entity at the same offset from one snapshot
+/// to the next, for example by writing entities in a stable
+/// order with fixed-size fields.
+///
+/// A server needs one encoder per client, since each client
+/// acknowledges different snapshots. The client sends back
+/// the sequence number of the last snapshot it decoded, by
+/// any mean, and the server passes it to acknowledge.
+///
+/// Usage example:
+/// \code
+/// // Server side, for each client
+/// sf::Packet snapshot;
+/// writeWorld(snapshot);
+///
+/// sf::Packet packet;
+/// client.encoder.encode(snapshot, packet);
+/// socket.send(packet, client.address, client.port);
+///
+/// // Server side, when a client acknowledges a snapshot
+/// sf::Uint32 sequence;
+/// if (acknowledgement >> sequence)
+///     client.encoder.acknowledge(sequence);
+/// \endcode
+///
+/// \see sf::SnapshotDecoder, sf::Packet
+///
+////////////////////////////////////////////////////////////
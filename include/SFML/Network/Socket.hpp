@@ -30,14 +30,25 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Export.hpp>
 #include <SFML/Network/SocketHandle.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <cstddef>
 #include <vector>
 
 
 namespace sf
 {
+class Ftp;
+class NetworkService;
+class Packet;
 class SocketSelector;
 
+namespace priv
+{
+    class NetworkSimulator;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Base class for all the socket types
 ///
@@ -68,6 +79,89 @@ public:
         AnyPort = 0 ///< Special value that tells the system to pick any available port
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Options that tune the behaviour of a socket
+    ///
+    /// Boolean options take 0 or 1, times are in the unit
+    /// given below. Not all options are supported on all
+    /// systems: sf::Socket::setOption returns false for the
+    /// ones that aren't.
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Option
+    {
+        NoDelay,           ///< Disable the Nagle algorithm, so that small writes are sent immediately (TCP, enabled by default)
+        KeepAlive,         ///< Send keep-alive probes on idle connections (TCP)
+        KeepAliveIdle,     ///< Idle time before the first keep-alive probe, in seconds (TCP)
+        KeepAliveInterval, ///< Time between two keep-alive probes, in seconds (TCP)
+        KeepAliveCount,    ///< Number of unanswered keep-alive probes before the connection is dropped (TCP)
+        SendBufferSize,    ///< Size of the system send buffer, in bytes
+        ReceiveBufferSize, ///< Size of the system receive buffer, in bytes
+        ReuseAddress,      ///< Allow binding to a local port that still has connections in the TIME_WAIT state
+        ReusePort,         ///< Allow several sockets to bind the same port, the system spreads the connections or datagrams between them (not on Windows)
+        TypeOfService,     ///< Value of the IPv4 TOS / IPv6 traffic class byte, the DSCP being its 6 upper bits
+        BusyPoll,          ///< Time to busy-poll the network device when receiving, in microseconds (Linux only)
+
+        OptionCount        ///< Keep last -- the total number of socket options
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Traffic counters of a socket, or of all the sockets
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_NETWORK_API Statistics
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Sets all the counters to zero.
+        ///
+        ////////////////////////////////////////////////////////////
+        Statistics();
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        Uint64 bytesSent;          ///< Number of bytes sent
+        Uint64 bytesReceived;      ///< Number of bytes received
+        Uint64 packetsSent;        ///< Number of sf::Packet (TCP) or datagrams (UDP) sent
+        Uint64 packetsReceived;    ///< Number of sf::Packet (TCP) or datagrams (UDP) received
+        Uint64 partialSends;       ///< Number of sends that returned sf::Socket::Partial
+        Uint64 notReadySends;      ///< Number of sends that returned sf::Socket::NotReady
+        Uint64 notReadyReceives;   ///< Number of receives that returned sf::Socket::NotReady
+        Time   waitTime;           ///< Time spent waiting in sf::SocketSelector::wait (global statistics) or in connection timeouts
+        Time   roundTripTime;      ///< Smoothed round-trip time measured by the system (TCP sockets, zero if not available)
+        Time   roundTripVariation; ///< Variation of the round-trip time measured by the system (TCP sockets, zero if not available)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Degraded network conditions simulated on the
+    ///        data sent by a socket
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_NETWORK_API NetworkConditions
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Describes a perfect network: no delay, no loss and
+        /// no bandwidth limit.
+        ///
+        ////////////////////////////////////////////////////////////
+        NetworkConditions();
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        Time   latency;       ///< Delay added to every send
+        Time   jitter;        ///< Maximum random variation of the delay, in both directions
+        float  lossRate;      ///< Probability that a datagram is lost, in [0, 1] (TCP: delayed as if retransmitted)
+        float  duplicateRate; ///< Probability that a datagram is delivered twice, in [0, 1] (UDP only)
+        float  reorderRate;   ///< Probability that a datagram is held back and overtaken by the next ones, in [0, 1] (UDP only)
+        Uint64 bandwidth;     ///< Maximum throughput of the link, in bytes per second (0 for unlimited)
+        Uint32 seed;          ///< Seed of the random generator, the same seed gives the same losses for the same sends
+    };
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -105,6 +199,154 @@ public:
     ////////////////////////////////////////////////////////////
     bool isBlocking() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the value of a socket option
+    ///
+    /// If the socket is not created yet, the option is stored
+    /// and applied when it is; this is needed for options that
+    /// must be set before the socket is bound, like ReuseAddress
+    /// and ReusePort, since sf::TcpListener::listen and
+    /// sf::UdpSocket::bind create and bind the socket at once.
+    /// The options are kept when the socket is closed and
+    /// created again.
+    ///
+    /// \param option Option to set
+    /// \param value  New value of the option
+    ///
+    /// \return True if the option was set (or stored), false if it couldn't be applied
+    ///
+    /// \see getOption
+    ///
+    ////////////////////////////////////////////////////////////
+    bool setOption(Option option, int value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the value of a socket option
+    ///
+    /// If the socket is created, the value is read from the
+    /// system, which may adjust the requested value (Linux
+    /// for example doubles the buffer sizes). Otherwise the
+    /// value stored by setOption is returned.
+    ///
+    /// \param option Option to get
+    ///
+    /// \return Value of the option, or -1 if it is unknown or not supported
+    ///
+    /// \see setOption
+    ///
+    ////////////////////////////////////////////////////////////
+    int getOption(Option option) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a snapshot of the traffic counters of the socket
+    ///
+    /// The counters are only updated while the statistics are
+    /// enabled (see setStatisticsEnabled). The round-trip time
+    /// of TCP sockets is always read from the system when it
+    /// provides it (TCP_INFO).
+    ///
+    /// \return Counters of the socket
+    ///
+    /// \see resetStatistics, getGlobalStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    Statistics getStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the traffic counters of the socket to zero
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetStatistics();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the traffic counters
+    ///
+    /// The counters are disabled by default. When they are
+    /// enabled, every socket operation updates the counters
+    /// of its socket and the global ones; the global update
+    /// takes a lock, so that the counters of all the threads
+    /// can be aggregated.
+    /// This setting should be chosen at startup, before the
+    /// sockets are used from several threads.
+    ///
+    /// \param enabled True to enable the counters, false to disable them
+    ///
+    /// \see isStatisticsEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setStatisticsEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the traffic counters are enabled
+    ///
+    /// \return True if the counters are enabled
+    ///
+    /// \see setStatisticsEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isStatisticsEnabled();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a snapshot of the traffic counters of all the sockets
+    ///
+    /// The round-trip time fields are always zero in the
+    /// global statistics.
+    ///
+    /// \return Counters aggregated over all the sockets
+    ///
+    /// \see resetGlobalStatistics, getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    static Statistics getGlobalStatistics();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the global traffic counters to zero
+    ///
+    /// \see getGlobalStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    static void resetGlobalStatistics();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the internal handle of the socket
+    ///
+    /// The returned handle may be invalid if the socket
+    /// was not created yet (or already destroyed).
+    /// It can be used to integrate the socket with other
+    /// event loops, for example with sf::Window::addEventSource
+    /// on Unix systems. Don't close it or change its blocking
+    /// state directly, use the socket's functions instead.
+    ///
+    /// \return The internal (OS-specific) handle of the socket
+    ///
+    ////////////////////////////////////////////////////////////
+    SocketHandle getHandle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Simulate degraded network conditions on the data
+    ///        sent by the socket
+    ///
+    /// This is meant for testing how an application behaves
+    /// on a bad network: the data sent is delayed, dropped,
+    /// duplicated or reordered before reaching the system,
+    /// according to \a conditions. The send functions then
+    /// always succeed immediately, the data being queued and
+    /// sent later by a background thread.
+    /// TCP data is never lost nor reordered: a loss delays
+    /// the data (and everything sent after it) as long as
+    /// a retransmission would.
+    /// Passing default-constructed conditions (a perfect
+    /// network) disables the simulation. Changing the
+    /// conditions reseeds the random generator, so that
+    /// a test can be replayed exactly.
+    ///
+    /// \param conditions Conditions to simulate
+    ///
+    ////////////////////////////////////////////////////////////
+    void setNetworkConditions(const NetworkConditions& conditions);
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -113,8 +355,55 @@ protected:
     ////////////////////////////////////////////////////////////
     enum Type
     {
-        Tcp, ///< TCP protocol
-        Udp  ///< UDP protocol
+        Tcp,  ///< TCP protocol
+        Udp,  ///< UDP protocol
+        Local ///< Local stream socket (Unix domain socket)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure holding the data of a packet being received
+    ///        on a stream socket
+    ///
+    ////////////////////////////////////////////////////////////
+    struct PendingPacket
+    {
+        PendingPacket();
+
+        Uint32            Size;         ///< Data of packet size
+        std::size_t       SizeReceived; ///< Number of size bytes received so far
+        std::size_t       DataReceived; ///< Number of data bytes received so far
+        std::vector<char> Data;         ///< Data of the packet (its size is the part allocated so far)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure holding the data coalesced by a stream
+    ///        socket before it is sent
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SendBuffer
+    {
+        SendBuffer();
+
+        std::vector<char> Data;      ///< Data waiting to be sent
+        std::size_t       Offset;    ///< Number of bytes at the beginning of Data which were already sent
+        std::size_t       Packets;   ///< Number of packets in Data, for the statistics
+        std::size_t       Threshold; ///< Amount of data that triggers a send (0 if the coalescing is disabled)
+        Time              Delay;     ///< Age of the data that triggers a send (zero for no limit)
+        Clock             Age;       ///< Time elapsed since the oldest data waiting was queued
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure holding the data read ahead by a stream
+    ///        socket and not parsed yet
+    ///
+    ////////////////////////////////////////////////////////////
+    struct ReceiveBuffer
+    {
+        ReceiveBuffer();
+
+        std::vector<char> Data;  ///< Storage of the data read ahead
+        std::size_t       Begin; ///< Position of the first byte not parsed yet
+        std::size_t       End;   ///< Position of the end of the data read ahead
     };
 
     ////////////////////////////////////////////////////////////
@@ -122,30 +411,33 @@ protected:
     ///
     /// This constructor can only be accessed by derived classes.
     ///
-    /// \param type Type of the socket (TCP or UDP)
+    /// \param type Type of the socket (TCP, UDP or local)
     ///
     ////////////////////////////////////////////////////////////
     Socket(Type type);
 
     ////////////////////////////////////////////////////////////
-    /// \brief Return the internal handle of the socket
+    /// \brief Create the internal representation of the socket
     ///
-    /// The returned handle may be invalid if the socket
-    /// was not created yet (or already destroyed).
+    /// This function creates an IPv4 socket.
     /// This function can only be accessed by derived classes.
     ///
-    /// \return The internal (OS-specific) handle of the socket
-    ///
     ////////////////////////////////////////////////////////////
-    SocketHandle getHandle() const;
+    void create();
 
     ////////////////////////////////////////////////////////////
     /// \brief Create the internal representation of the socket
+    ///        for a given address family
     ///
+    /// IPv6 sockets are dual-stack: they can also communicate
+    /// with IPv4 addresses. If the system doesn't support them,
+    /// an IPv4 socket is created instead (see isIpv6).
     /// This function can only be accessed by derived classes.
     ///
+    /// \param ipv6 Create an IPv6 socket?
+    ///
     ////////////////////////////////////////////////////////////
-    void create();
+    void create(bool ipv6);
 
     ////////////////////////////////////////////////////////////
     /// \brief Create the internal representation of the socket
@@ -166,16 +458,216 @@ protected:
     ////////////////////////////////////////////////////////////
     void close();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the socket is an IPv6 (dual-stack) socket
+    ///
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \return True if the socket is an IPv6 socket, false if it is an IPv4 one
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isIpv6() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the counters after a send operation
+    ///
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param bytes   Number of bytes sent
+    /// \param packets Number of packets or datagrams completely sent
+    /// \param status  Status returned by the operation
+    ///
+    ////////////////////////////////////////////////////////////
+    void recordSend(std::size_t bytes, std::size_t packets, Status status);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the counters after a receive operation
+    ///
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param bytes   Number of bytes received
+    /// \param packets Number of packets or datagrams completely received
+    /// \param status  Status returned by the operation
+    ///
+    ////////////////////////////////////////////////////////////
+    void recordReceive(std::size_t bytes, std::size_t packets, Status status);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the counters after waiting for the socket
+    ///
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param duration Time spent waiting
+    ///
+    ////////////////////////////////////////////////////////////
+    void recordWait(Time duration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the network simulator of the socket
+    ///
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \return Simulator of the socket, or a null pointer if the conditions are not simulated
+    ///
+    ////////////////////////////////////////////////////////////
+    priv::NetworkSimulator* getNetworkSimulator() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send raw data through a connected stream socket
+    ///
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param data Pointer to the sequence of bytes to send
+    /// \param size Number of bytes to send
+    /// \param sent The number of bytes sent will be written here
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Status sendStream(const void* data, std::size_t size, std::size_t& sent);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive raw data from a connected stream socket
+    ///
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param data     Pointer to the array to fill with the received bytes
+    /// \param size     Maximum number of bytes that can be received
+    /// \param received This variable is filled with the actual number of bytes received
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Status receiveStream(void* data, std::size_t size, std::size_t& received);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send a packet through a connected stream socket,
+    ///        preceded by its size
+    ///
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param packet Packet to send
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Status sendStreamPacket(Packet& packet);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive a packet sent by sendStreamPacket
+    ///
+    /// The socket is closed if the packet is bigger than the
+    /// limit, since the stream can't be resynchronized after it.
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param packet        Packet to fill with the received data
+    /// \param pending       Packet received so far, kept between non-blocking calls
+    /// \param maxPacketSize Maximum size of a received packet (0 for no limit)
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Status receiveStreamPacket(Packet& packet, PendingPacket& pending, std::size_t maxPacketSize);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive a packet sent by sendStreamPacket, reading
+    ///        as much data as possible at once
+    ///
+    /// Up to \a capacity bytes are read in each system call, and
+    /// the following packets are parsed from the buffer by the
+    /// next calls without reading the socket. A packet bigger
+    /// than the buffer is received like with receiveStreamPacket.
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param packet        Packet to fill with the received data
+    /// \param pending       Packet received so far, kept between non-blocking calls
+    /// \param buffer        Data read ahead, kept between calls
+    /// \param capacity      Maximum amount of data to read ahead, in bytes
+    /// \param maxPacketSize Maximum size of a received packet (0 for no limit)
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Status receiveBufferedPacket(Packet& packet, PendingPacket& pending, ReceiveBuffer& buffer, std::size_t capacity, std::size_t maxPacketSize);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append raw data to the send buffer of a stream socket
+    ///
+    /// A second block of data can be given, to be appended
+    /// right after the first one.
+    ///
+    /// The buffer is flushed when it reaches its threshold, or
+    /// when its oldest data is older than its delay. The data is
+    /// either entirely accepted (Done) or not at all: NotReady is
+    /// returned when the data which couldn't be sent so far
+    /// already fills the buffer.
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param buffer   Send buffer of the socket
+    /// \param data     Pointer to the sequence of bytes to queue
+    /// \param size     Number of bytes to queue
+    /// \param next     Pointer to the bytes to queue after \a data (can be NULL)
+    /// \param nextSize Number of bytes to queue after \a data
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Status queueStream(SendBuffer& buffer, const void* data, std::size_t size, const void* next = NULL, std::size_t nextSize = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append a packet, preceded by its size, to the send
+    ///        buffer of a stream socket
+    ///
+    /// Same as queueStream, with the framing of sendStreamPacket.
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param buffer Send buffer of the socket
+    /// \param packet Packet to queue
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Status queueStreamPacket(SendBuffer& buffer, Packet& packet);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send the data waiting in the send buffer of a
+    ///        stream socket
+    ///
+    /// In non-blocking mode, what can't be sent stays in the
+    /// buffer and NotReady or Partial is returned.
+    /// This function can only be accessed by derived classes.
+    ///
+    /// \param buffer Send buffer of the socket
+    ///
+    /// \return Status code
+    ///
+    ////////////////////////////////////////////////////////////
+    Status flushStream(SendBuffer& buffer);
+
 private:
 
+    friend class Ftp;
+    friend class NetworkService;
     friend class SocketSelector;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the global counters after waiting in a selector
+    ///
+    /// \param duration Time spent waiting
+    ///
+    ////////////////////////////////////////////////////////////
+    static void recordSelectorWait(Time duration);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Type         m_type;       ///< Type of the socket (TCP or UDP)
-    SocketHandle m_socket;     ///< Socket descriptor
-    bool         m_isBlocking; ///< Current blocking mode of the socket
+    Type                    m_type;                 ///< Type of the socket (TCP, UDP or local)
+    SocketHandle            m_socket;               ///< Socket descriptor
+    bool                    m_isBlocking;           ///< Current blocking mode of the socket
+    bool                    m_isIpv6;               ///< Is the socket an IPv6 one?
+    int                     m_options[OptionCount]; ///< Options to apply when the socket is created (-1 for the system default)
+    Statistics              m_statistics;           ///< Traffic counters of the socket
+    priv::NetworkSimulator* m_simulator;            ///< Simulator of degraded network conditions, if any
 };
 
 } // namespace sf
@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Export.hpp>
 #include <SFML/System/Time.hpp>
+#include <cstddef>
 
 
 namespace sf
@@ -141,6 +142,34 @@ public:
     ////////////////////////////////////////////////////////////
     bool isReady(Socket& socket) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of sockets that were ready after the last wait
+    ///
+    /// Together with getReadySocket, this allows to iterate only
+    /// over the sockets that are ready, instead of testing every
+    /// socket of the selector with isReady.
+    ///
+    /// \return Number of ready sockets
+    ///
+    /// \see getReadySocket
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getReadyCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get one of the sockets that were ready after the last wait
+    ///
+    /// The sockets are returned in no particular order.
+    ///
+    /// \param index Index of the socket, in range [0 .. getReadyCount() - 1]
+    ///
+    /// \return Reference to the ready socket
+    ///
+    /// \see getReadyCount
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket& getReadySocket(std::size_t index) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -196,6 +225,14 @@ private:
 /// \li make it wait until there is data available on any of the sockets
 /// \li test each socket to find out which ones are ready
 ///
+/// The selector uses the most scalable mechanism available
+/// on the system (epoll on Linux and Android, kqueue on macOS,
+/// iOS and FreeBSD, select elsewhere), so that waiting doesn't
+/// get slower with the number of observed sockets. With many
+/// sockets, prefer iterating over the ready ones with
+/// getReadyCount and getReadySocket rather than calling
+/// isReady on each of them.
+///
 /// Usage example:
 /// \code
 /// // Create a socket to listen to new connections
@@ -70,6 +70,8 @@ public:
     /// port, waiting for new connections.
     /// If the socket was previously listening to another port,
     /// it will be stopped first and bound to the new port.
+    /// To share the port with other listeners, enable the
+    /// sf::Socket::ReusePort option before calling this function.
     ///
     /// \param port Port to listen for new connections
     ///
@@ -157,6 +159,26 @@ public:
 /// }
 /// \endcode
 ///
+/// Several listeners can share the same port, so that one
+/// thread per listener accepts the connections and the system
+/// balances the incoming connections between them. Each of
+/// them must enable the sf::Socket::ReusePort option before
+/// listening (this is not supported on Windows):
+/// \code
+/// void acceptThread()
+/// {
+///     sf::TcpListener listener;
+///     listener.setOption(sf::Socket::ReusePort, 1);
+///     listener.listen(55001);
+///
+///     sf::TcpSocket client;
+///     while (listener.accept(client) == sf::Socket::Done)
+///         doSomethingWith(client);
+/// }
+///
+/// // Start as many accept threads as there are CPU cores
+/// \endcode
+///
 /// \see sf::TcpSocket, sf::Socket
 ///
 ////////////////////////////////////////////////////////////
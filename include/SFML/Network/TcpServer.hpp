@@ -0,0 +1,274 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TCPSERVER_HPP
+#define SFML_TCPSERVER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/Socket.hpp>
+#include <SFML/Network/TcpListener.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Thread;
+class TcpSocket;
+
+////////////////////////////////////////////////////////////
+/// \brief TCP server spreading its connections over several worker threads
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API TcpServer : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Callbacks receiving the events of the connections
+    ///
+    /// The callbacks of a connection are always called from
+    /// the worker thread that owns it, but callbacks of
+    /// different connections may run concurrently: anything
+    /// shared between connections must be protected.
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_NETWORK_API Handler
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Virtual destructor
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual ~Handler();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Called when a new client is connected
+        ///
+        /// The default implementation does nothing.
+        ///
+        /// \param client Socket connected to the client
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void onConnect(TcpSocket& client);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Called when data is available on a connection
+        ///
+        /// The client socket is non-blocking: receive from it
+        /// until it returns sf::Socket::NotReady, so that no
+        /// client can stall the others of its worker.
+        ///
+        /// \param client Socket connected to the client
+        ///
+        /// \return False to close the connection (typically when receiving returned sf::Socket::Disconnected)
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual bool onReceive(TcpSocket& client) = 0;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Called before a connection is closed
+        ///
+        /// This happens when onReceive returned false, or for
+        /// all the remaining connections when the server stops.
+        /// The default implementation does nothing.
+        ///
+        /// \param client Socket connected to the client
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual void onDisconnect(TcpSocket& client);
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Ways of accepting the new connections
+    ///
+    ////////////////////////////////////////////////////////////
+    enum AcceptMode
+    {
+        SingleAcceptor, ///< One thread accepts the connections and gives them to the workers in turn
+        SharedPort      ///< Each worker accepts on its own listener, the system balances the connections (see sf::Socket::ReusePort)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    TcpServer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Stops the server if it is running.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TcpServer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start listening and serving the connections
+    ///
+    /// The function returns as soon as the threads are started.
+    /// The SharedPort mode is not available on Windows.
+    ///
+    /// \param port        Port to listen to (sf::Socket::AnyPort to let the system pick one)
+    /// \param handler     Callbacks receiving the events of the connections, must stay alive until the server is stopped
+    /// \param workerCount Number of worker threads, typically the number of CPU cores
+    /// \param mode        Way of accepting the new connections
+    ///
+    /// \return Status code
+    ///
+    /// \see stop
+    ///
+    ////////////////////////////////////////////////////////////
+    Socket::Status start(unsigned short port, Handler& handler, unsigned int workerCount, AcceptMode mode = SingleAcceptor);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop the server
+    ///
+    /// The listeners are closed, the remaining connections are
+    /// closed after their onDisconnect callback, and all the
+    /// threads are waited for. This function must not be
+    /// called from a callback.
+    ///
+    /// \see start
+    ///
+    ////////////////////////////////////////////////////////////
+    void stop();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the server is running
+    ///
+    /// \return True if the server is running
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isRunning() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the port the server listens to
+    ///
+    /// \return Port of the server, or 0 if it is not running
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned short getLocalPort() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of connected clients
+    ///
+    /// \return Number of connections over all the workers
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getConnectionCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Event loop serving a part of the connections in its own thread
+    ///
+    ////////////////////////////////////////////////////////////
+    class Worker;
+
+    friend class Worker;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Accept the connections and give them to the workers
+    ///
+    /// This function runs in its own thread in the
+    /// SingleAcceptor mode.
+    ///
+    ////////////////////////////////////////////////////////////
+    void runAcceptor();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the threads are asked to stop
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isStopping() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Worker*> m_workers;  ///< Worker event loops
+    TcpListener          m_listener; ///< Listener of the SingleAcceptor mode
+    Thread*              m_acceptor; ///< Thread accepting the connections in the SingleAcceptor mode
+    Handler*             m_handler;  ///< Callbacks receiving the events of the connections
+    unsigned short       m_port;     ///< Port the server listens to
+    bool                 m_running;  ///< Is the server running?
+    bool                 m_stopping; ///< Are the threads asked to stop?
+    mutable Mutex        m_mutex;    ///< Mutex protecting the stop request
+};
+
+} // namespace sf
+
+
+#endif // SFML_TCPSERVER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TcpServer
+/// \ingroup network
+///
+/// The usual SFML server waits for its sockets with a single
+/// sf::SocketSelector, and therefore runs on a single core.
+/// sf::TcpServer spreads the connections over several worker
+/// threads, each waiting for its own connections with its own
+/// selector, and notifies the events of the connections to a
+/// user-defined sf::TcpServer::Handler.
+///
+/// The new connections are either accepted by a dedicated
+/// thread and given to the workers in turn (SingleAcceptor),
+/// or accepted by the workers themselves on listeners that
+/// share the port (SharedPort), in which case the operating
+/// system balances them and no thread hands them over.
+///
+/// Usage example:
+/// \code
+/// class EchoHandler : public sf::TcpServer::Handler
+/// {
+///     virtual bool onReceive(sf::TcpSocket& client)
+///     {
+///         sf::Packet packet;
+///         sf::Socket::Status status;
+///         while ((status = client.receive(packet)) == sf::Socket::Done)
+///             client.send(packet);
+///
+///         return status == sf::Socket::NotReady;
+///     }
+/// };
+///
+/// EchoHandler handler;
+/// sf::TcpServer server;
+/// server.start(55001, handler, 4);
+///
+/// // ... the server runs in its own threads ...
+///
+/// server.stop();
+/// \endcode
+///
+/// \see sf::TcpListener, sf::SocketSelector
+///
+////////////////////////////////////////////////////////////
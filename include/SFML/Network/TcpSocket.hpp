@@ -31,6 +31,7 @@
 #include <SFML/Network/Export.hpp>
 #include <SFML/Network/Socket.hpp>
 #include <SFML/System/Time.hpp>
+#include <vector>
 
 
 namespace sf
@@ -110,6 +111,31 @@ public:
     ////////////////////////////////////////////////////////////
     Status connect(const IpAddress& remoteAddress, unsigned short remotePort, Time timeout = Time::Zero);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Connect the socket to the first reachable address of a remote peer
+    ///
+    /// This function races connections to the given addresses
+    /// ("Happy Eyeballs", RFC 8305): it starts connecting to the
+    /// first address, then to the next one every 250 ms (or as
+    /// soon as the previous attempts failed), and keeps the first
+    /// connection that succeeds. Use IpAddress::resolveAll to get
+    /// the addresses of a host name in the right order, so that
+    /// a broken IPv6 or IPv4 path doesn't delay the connection.
+    /// This function always waits for the result, even if the
+    /// socket is in non-blocking mode.
+    /// If the socket was previously connected, it is first disconnected.
+    ///
+    /// \param remoteAddresses Addresses of the remote peer, in order of preference
+    /// \param remotePort      Port of the remote peer
+    /// \param timeout         Optional maximum time to wait
+    ///
+    /// \return Status code
+    ///
+    /// \see disconnect, IpAddress::resolveAll
+    ///
+    ////////////////////////////////////////////////////////////
+    Status connect(const std::vector<IpAddress>& remoteAddresses, unsigned short remotePort, Time timeout = Time::Zero);
+
     ////////////////////////////////////////////////////////////
     /// \brief Disconnect the socket from its remote peer
     ///
@@ -207,27 +233,135 @@ public:
     ////////////////////////////////////////////////////////////
     Status receive(Packet& packet);
 
-private:
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum size of the packets that can be received
+    ///
+    /// The size of a packet is announced by the remote peer before
+    /// its data. If a peer announces a packet bigger than this
+    /// limit, receive(Packet&) fails with sf::Socket::Error and
+    /// the socket is disconnected, since the rest of the stream
+    /// can't be interpreted anymore. This protects servers against
+    /// peers trying to exhaust their memory.
+    /// A value of 0 means no limit, which is the default.
+    ///
+    /// \param size Maximum packet size, in bytes (0 for no limit)
+    ///
+    /// \see getMaxPacketSize
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMaxPacketSize(std::size_t size);
 
-    friend class TcpListener;
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum size of the packets that can be received
+    ///
+    /// \return Maximum packet size, in bytes (0 for no limit)
+    ///
+    /// \see setMaxPacketSize
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getMaxPacketSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Coalesce the data sent by the socket
+    ///
+    /// TCP_NODELAY is enabled on TCP sockets, so each send() is
+    /// a system call that usually produces its own network
+    /// segment. When the coalescing is enabled, send() only
+    /// appends the data (or the packet) to a buffer of the
+    /// socket, which is sent in a single call when it holds at
+    /// least \a threshold bytes, when a send() finds that its
+    /// oldest data is older than \a delay, or when flush() is
+    /// called. A server that sends many small packets per client
+    /// typically calls flush() once per client at the end of
+    /// each update, to make one system call instead of one per
+    /// packet.
+    ///
+    /// While the coalescing is enabled, send() never returns
+    /// sf::Socket::Partial: the data is either queued entirely
+    /// (sf::Socket::Done), or not at all (sf::Socket::NotReady)
+    /// when the data that the socket couldn't send yet in
+    /// non-blocking mode already fills the buffer. The data
+    /// waiting in the buffer is dropped when the socket is
+    /// disconnected; call flush() before.
+    ///
+    /// A \a threshold of 0 disables the coalescing, which is the
+    /// default; the data waiting in the buffer is flushed.
+    ///
+    /// \param threshold Amount of queued data that triggers a send, in bytes (0 to disable)
+    /// \param delay     Maximum age of the queued data when a send() is called (zero for no limit)
+    ///
+    /// \see flush
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSendCoalescing(std::size_t threshold, Time delay = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send the data queued by the coalescing
+    ///
+    /// In non-blocking mode, the data that the socket can't take
+    /// stays in the buffer, and this function returns
+    /// sf::Socket::Partial or sf::Socket::NotReady; call it again
+    /// when the socket is ready. Returns sf::Socket::Done
+    /// immediately if nothing is queued.
+    ///
+    /// \return Status code
+    ///
+    /// \see setSendCoalescing
+    ///
+    ////////////////////////////////////////////////////////////
+    Status flush();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read ahead the data received by the socket
+    ///
+    /// Without buffering, receiving a packet takes at least two
+    /// system calls: one for its size and one for its data.
+    /// With buffering, each system call of receive() reads up to
+    /// \a size bytes in a buffer of the socket, and the next
+    /// calls return the packets it holds without reading the
+    /// socket again, so that a stream of small packets is
+    /// received with one system call per \a size bytes (64 KB is
+    /// a good value). Packets bigger than the buffer are still
+    /// received, directly.
+    ///
+    /// The packets waiting in the buffer don't make the socket
+    /// ready for sf::SocketSelector: call receive() until it
+    /// returns sf::Socket::NotReady (in non-blocking mode)
+    /// before waiting again.
+    ///
+    /// A \a size of 0 disables the buffering, which is the
+    /// default; the data left in the buffer is still returned
+    /// first.
+    ///
+    /// \param size Size of the buffer, in bytes (0 to disable)
+    ///
+    /// \see getReceiveBuffering
+    ///
+    ////////////////////////////////////////////////////////////
+    void setReceiveBuffering(std::size_t size);
 
     ////////////////////////////////////////////////////////////
-    /// \brief Structure holding the data of a pending packet
+    /// \brief Get the size of the buffer used to read ahead
+    ///
+    /// \return Size of the buffer, in bytes (0 if buffering is disabled)
+    ///
+    /// \see setReceiveBuffering
     ///
     ////////////////////////////////////////////////////////////
-    struct PendingPacket
-    {
-        PendingPacket();
+    std::size_t getReceiveBuffering() const;
 
-        Uint32            Size;         ///< Data of packet size
-        std::size_t       SizeReceived; ///< Number of size bytes received so far
-        std::vector<char> Data;         ///< Data of the packet
-    };
+private:
+
+    friend class TcpListener;
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
     PendingPacket m_pendingPacket; ///< Temporary data of the packet currently being received
+    std::size_t   m_maxPacketSize; ///< Maximum size of a received packet (0 for no limit)
+    SendBuffer    m_sendBuffer;    ///< Data queued by the send coalescing
+    ReceiveBuffer m_receiveBuffer; ///< Data read ahead by the receive buffering
+    std::size_t   m_receiveSize;   ///< Size of the receive buffering (0 if disabled)
 };
 
 } // namespace sf
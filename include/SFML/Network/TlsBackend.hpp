@@ -0,0 +1,187 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TLSBACKEND_HPP
+#define SFML_TLSBACKEND_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Export.hpp>
+#include <SFML/Network/Socket.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class TcpSocket;
+
+////////////////////////////////////////////////////////////
+/// \brief Interface of the TLS implementations used for
+///        encrypted connections
+///
+////////////////////////////////////////////////////////////
+class SFML_NETWORK_API TlsBackend
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Encrypted connection established by a backend
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_NETWORK_API Connection
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Virtual destructor
+        ///
+        /// The destructor must send the TLS close notification
+        /// if the connection is still open, and release the
+        /// backend resources; the socket is disconnected by
+        /// its owner.
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual ~Connection();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Encrypt and send data to the peer
+        ///
+        /// This function must block until all the data is sent.
+        ///
+        /// \param data Pointer to the sequence of bytes to send
+        /// \param size Number of bytes to send
+        ///
+        /// \return Status code
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual Socket::Status send(const void* data, std::size_t size) = 0;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Receive and decrypt data from the peer
+        ///
+        /// This function must block until some data is received,
+        /// and return sf::Socket::Disconnected when the peer
+        /// closed the connection.
+        ///
+        /// \param data     Pointer to the array to fill with the received bytes
+        /// \param size     Maximum number of bytes that can be received
+        /// \param received This variable is filled with the actual number of bytes received
+        ///
+        /// \return Status code
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual Socket::Status receive(void* data, std::size_t size, std::size_t& received) = 0;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Get the state needed to resume the session later
+        ///
+        /// The returned data (typically a serialized session
+        /// ticket) is given back to TlsBackend::connect for the
+        /// next connection to the same host, so that it can skip
+        /// the full handshake. Servers may send tickets at any
+        /// time, so this function is called again before the
+        /// connection is destroyed. The default implementation
+        /// returns empty data, which disables resumption.
+        ///
+        /// \return Session state, or empty data if the session can't be resumed
+        ///
+        ////////////////////////////////////////////////////////////
+        virtual std::vector<char> getSession() const;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Virtual destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~TlsBackend();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Establish an encrypted connection over a connected socket
+    ///
+    /// This function performs the TLS handshake, including
+    /// the verification of the server certificate for
+    /// \a hostName, and returns the encrypted connection. If
+    /// \a session is not empty, the backend should try to
+    /// resume that session (and fall back to a full handshake
+    /// if the server refuses it).
+    ///
+    /// \param socket   Socket connected to the server, in blocking mode
+    /// \param hostName Name of the server, for the certificate verification and SNI
+    /// \param session  State of a previous session with the same host, as returned by Connection::getSession, or empty data
+    ///
+    /// \return New connection (destroyed by the caller with delete), or NULL if the handshake failed
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Connection* connect(TcpSocket& socket, const std::string& hostName, const std::vector<char>& session) = 0;
+};
+
+} // namespace sf
+
+
+#endif // SFML_TLSBACKEND_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TlsBackend
+/// \ingroup network
+///
+/// SFML doesn't implement TLS itself: cryptography is best
+/// left to dedicated, well-audited libraries, and each
+/// platform comes with its own certificate store.
+/// sf::TlsBackend is the interface that connects SFML to
+/// such a library (mbedTLS, OpenSSL, SChannel,
+/// Secure Transport...). Classes that support encrypted
+/// connections, like sf::Http with "https://" hosts, use the
+/// backend given to them.
+///
+/// A backend only has to establish the TLS session over a
+/// sf::TcpSocket and to encrypt and decrypt the data. Session
+/// resumption is supported through opaque session data: the
+/// client keeps the data of its last connection to a host and
+/// gives it back to the backend for the next one, so that an
+/// abbreviated handshake (TLS 1.2 session tickets, TLS 1.3
+/// pre-shared keys) replaces the full one. Together with
+/// connections kept alive between requests, this removes most
+/// of the handshake latency of repeated requests.
+///
+/// Usage example:
+/// \code
+/// class MbedTlsBackend : public sf::TlsBackend
+/// {
+///     // Implementation with mbedtls_ssl_handshake, mbedtls_ssl_write,
+///     // mbedtls_ssl_read, mbedtls_ssl_get_session and mbedtls_ssl_set_session
+///     ...
+/// };
+///
+/// MbedTlsBackend backend;
+/// sf::Http http("https://api.example.com");
+/// http.setTlsBackend(&backend);
+/// sf::Http::Response response = http.sendRequest(sf::Http::Request("/leaderboard"));
+/// \endcode
+///
+/// \see sf::Http
+///
+////////////////////////////////////////////////////////////
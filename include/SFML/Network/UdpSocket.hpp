@@ -30,12 +30,12 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Export.hpp>
 #include <SFML/Network/Socket.hpp>
+#include <SFML/Network/IpAddress.hpp>
 #include <vector>
 
 
 namespace sf
 {
-class IpAddress;
 class Packet;
 
 ////////////////////////////////////////////////////////////
@@ -54,6 +54,28 @@ public:
         MaxDatagramSize = 65507 ///< The maximum number of bytes that can be sent in a single UDP datagram
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Description of a datagram for the batch functions
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_NETWORK_API Datagram
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        ////////////////////////////////////////////////////////////
+        Datagram();
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        void*          data;     ///< Bytes to send, or buffer to receive into
+        std::size_t    size;     ///< Number of bytes to send, or size of the receive buffer
+        std::size_t    received; ///< Number of bytes actually received (filled by receiveBatch)
+        IpAddress      address;  ///< Address of the receiver, or of the sender (filled by receiveBatch)
+        unsigned short port;     ///< Port of the receiver, or of the sender (filled by receiveBatch)
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -169,6 +191,12 @@ public:
     /// In blocking mode, this function will wait until the whole packet
     /// has been received.
     ///
+    /// The datagram is received in the socket and copied to the
+    /// packet, unless the packet is a plain sf::Packet built over
+    /// external memory of at least MaxDatagramSize bytes (a slab
+    /// of a pool, for example): it is then received directly in
+    /// that memory, without any copy.
+    ///
     /// \param packet        Packet to fill with the received data
     /// \param remoteAddress Address of the peer that sent the data
     /// \param remotePort    Port of the peer that sent the data
@@ -180,12 +208,62 @@ public:
     ////////////////////////////////////////////////////////////
     Status receive(Packet& packet, IpAddress& remoteAddress, unsigned short& remotePort);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Send several datagrams at once
+    ///
+    /// Each datagram is sent to its own address and port, in
+    /// order. On Linux, the datagrams are handed to the system
+    /// in batches with a single call (sendmmsg), which drastically
+    /// reduces the per-datagram overhead at high packet rates;
+    /// elsewhere they are sent one after the other.
+    /// If the socket is non-blocking and the system can't take
+    /// all the datagrams, sf::Socket::Partial is returned and
+    /// \a sent tells how many of them were sent.
+    /// No datagram is sent if one of them is bigger than
+    /// UdpSocket::MaxDatagramSize.
+    ///
+    /// \param datagrams Array of datagrams to send
+    /// \param count     Number of datagrams in the array
+    /// \param sent      This variable is filled with the number of datagrams sent
+    ///
+    /// \return Status code
+    ///
+    /// \see receiveBatch
+    ///
+    ////////////////////////////////////////////////////////////
+    Status sendBatch(const Datagram* datagrams, std::size_t count, std::size_t& sent);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive several datagrams at once
+    ///
+    /// The \a data and \a size members of each datagram describe
+    /// the buffer to receive into, the other members are filled
+    /// with the received datagram. A datagram that doesn't fit in
+    /// its buffer is truncated.
+    /// The function receives as many of the datagrams already
+    /// waiting in the system as possible, up to \a count, and
+    /// doesn't wait for more. In blocking mode, it waits until at
+    /// least one datagram is available. On Linux the datagrams are
+    /// received in batches with a single call (recvmmsg); elsewhere,
+    /// a blocking socket receives only one datagram per call.
+    ///
+    /// \param datagrams Array of datagrams to fill
+    /// \param count     Number of datagrams in the array
+    /// \param received  This variable is filled with the number of datagrams received
+    ///
+    /// \return Status code
+    ///
+    /// \see sendBatch
+    ///
+    ////////////////////////////////////////////////////////////
+    Status receiveBatch(Datagram* datagrams, std::size_t count, std::size_t& received);
+
 private:
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    std::vector<char> m_buffer; ///< Temporary buffer holding the received data in Receive(Packet)
+    std::vector<char> m_buffer; ///< Temporary buffer holding the received data in receive(Packet), allocated on first use
 };
 
 } // namespace sf
@@ -0,0 +1,219 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_ALLOCATOR_HPP
+#define SFML_ALLOCATOR_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Hooks through which SFML allocates its raw memory
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API Allocator
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Subsystems on behalf of which memory is allocated
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Tag
+    {
+        General, ///< Allocations of the SFML containers, like sf::FrameArena
+        Fonts,   ///< Allocations of FreeType, for sf::Font
+        Images,  ///< Allocations of the image decoders, for sf::Image
+
+        TagCount ///< Keep last -- the total number of tags
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function allocating a block of memory
+    ///
+    /// It must return NULL if the allocation fails. The block
+    /// must be aligned for any type, like malloc does.
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef void* (*AllocateFunction)(std::size_t size, Tag tag, void* userData);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function resizing a block of memory
+    ///
+    /// It must behave like realloc: keep the content, accept a
+    /// NULL block and return NULL (leaving the block untouched)
+    /// if the allocation fails.
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef void* (*ReallocateFunction)(void* block, std::size_t size, Tag tag, void* userData);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function releasing a block of memory
+    ///
+    /// It must accept a NULL block.
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef void (*DeallocateFunction)(void* block, Tag tag, void* userData);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set of functions used to allocate memory
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_SYSTEM_API Hooks
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// The default hooks call malloc, realloc and free.
+        ///
+        ////////////////////////////////////////////////////////////
+        Hooks();
+
+        AllocateFunction   allocate;   ///< Function allocating a block
+        ReallocateFunction reallocate; ///< Function resizing a block
+        DeallocateFunction deallocate; ///< Function releasing a block
+        void*              userData;   ///< Pointer passed to every call of the functions
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Replace the functions used to allocate memory
+    ///
+    /// The hooks must be set before SFML allocates anything
+    /// through them, typically at the very beginning of main(),
+    /// and never changed afterwards: a block is always released
+    /// by the hooks that are set at the time, which must be
+    /// able to release it. This function is not thread-safe.
+    ///
+    /// \param hooks New hooks; none of the functions can be NULL
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setHooks(const Hooks& hooks);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the functions currently used to allocate memory
+    ///
+    /// \return Current hooks
+    ///
+    ////////////////////////////////////////////////////////////
+    static const Hooks& getHooks();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Allocate a block of memory through the hooks
+    ///
+    /// \param size Size of the block, in bytes
+    /// \param tag  Subsystem on behalf of which it is allocated
+    ///
+    /// \return Allocated block, NULL on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    static void* allocate(std::size_t size, Tag tag);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resize a block of memory through the hooks
+    ///
+    /// \param block Block to resize, can be NULL
+    /// \param size  New size of the block, in bytes
+    /// \param tag   Subsystem on behalf of which it is allocated
+    ///
+    /// \return Resized block, NULL on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    static void* reallocate(void* block, std::size_t size, Tag tag);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release a block of memory through the hooks
+    ///
+    /// \param block Block to release, can be NULL
+    /// \param tag   Subsystem on behalf of which it was allocated
+    ///
+    ////////////////////////////////////////////////////////////
+    static void deallocate(void* block, Tag tag);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the name of a tag
+    ///
+    /// \param tag Subsystem
+    ///
+    /// \return Name of the tag, like "Fonts"
+    ///
+    ////////////////////////////////////////////////////////////
+    static const char* getName(Tag tag);
+};
+
+} // namespace sf
+
+
+#endif // SFML_ALLOCATOR_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Allocator
+/// \ingroup system
+///
+/// sf::Allocator lets applications route the raw memory
+/// allocated by SFML and its dependencies to their own
+/// heaps, in order to pool, track or cap it. Each allocation
+/// carries a tag telling which subsystem asked for it.
+///
+/// The allocations that go through the hooks are:
+/// \li the memory of FreeType, for every sf::Font
+/// \li the memory of the image decoder of sf::Image
+/// \li the blocks of sf::FrameArena
+///
+/// The other objects of SFML keep using the standard
+/// containers, with the global operator new, which can be
+/// replaced for the whole program the standard way.
+///
+/// Usage example:
+/// \code
+/// void* allocate(std::size_t size, sf::Allocator::Tag tag, void* userData)
+/// {
+///     static_cast<MyHeaps*>(userData)->count(tag, size);
+///     return std::malloc(size);
+/// }
+///
+/// ...
+///
+/// int main()
+/// {
+///     sf::Allocator::Hooks hooks;
+///     hooks.allocate = &allocate;
+///     hooks.reallocate = &reallocate;
+///     hooks.deallocate = &deallocate;
+///     hooks.userData = &heaps;
+///     sf::Allocator::setHooks(hooks);
+///
+///     ...
+/// }
+/// \endcode
+///
+/// \see sf::ResourceMemory
+///
+////////////////////////////////////////////////////////////
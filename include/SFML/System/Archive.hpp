@@ -0,0 +1,282 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_ARCHIVE_HPP
+#define SFML_ARCHIVE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Export.hpp>
+#include <SFML/System/FileInputStream.hpp>
+#include <SFML/System/MappedFileInputStream.hpp>
+#include <SFML/System/MemoryInputStream.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Thread.hpp>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Read-only archive packing many files into a single one
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API Archive : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    Archive();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Waits for the pending prefetches to finish.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~Archive();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open an archive file
+    ///
+    /// Only the index of the archive is read. The file is mapped
+    /// in memory when possible; otherwise (on Android, where the
+    /// assets live inside the APK) the entries are read through
+    /// a single file handle.
+    ///
+    /// \param filename Path of the archive file
+    ///
+    /// \return True if the archive was opened successfully
+    ///
+    ////////////////////////////////////////////////////////////
+    bool open(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the archive contains an entry
+    ///
+    /// \param name Name of the entry
+    ///
+    /// \return True if the entry exists
+    ///
+    ////////////////////////////////////////////////////////////
+    bool contains(const std::string& name) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the names of all the entries, in alphabetical order
+    ///
+    /// \return Names of the entries
+    ///
+    ////////////////////////////////////////////////////////////
+    std::vector<std::string> getEntryNames() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open an entry of the archive as a stream
+    ///
+    /// Uncompressed entries of a mapped archive are read in place.
+    /// The others are decompressed (or read) into a buffer owned
+    /// by the archive, which is kept until releaseEntry() is called
+    /// or the archive is closed. The stream is valid as long as
+    /// its data is.
+    ///
+    /// \param name   Name of the entry
+    /// \param stream Stream to open on the content of the entry
+    ///
+    /// \return True if the entry was opened successfully
+    ///
+    /// \see prefetch, releaseEntry
+    ///
+    ////////////////////////////////////////////////////////////
+    bool openEntry(const std::string& name, MemoryInputStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Prepare an entry in the background
+    ///
+    /// This function returns immediately. The pages of uncompressed
+    /// entries of a mapped archive are read ahead by the system; the
+    /// other entries are decompressed (or read) by a thread of the
+    /// archive, so that a later call to openEntry() doesn't wait.
+    ///
+    /// \param name Name of the entry
+    ///
+    /// \see openEntry
+    ///
+    ////////////////////////////////////////////////////////////
+    void prefetch(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Free the buffer of a decompressed entry
+    ///
+    /// The streams opened on the entry become invalid.
+    ///
+    /// \param name Name of the entry
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseEntry(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pack files into a new archive
+    ///
+    /// The entries are named after the given paths, with '/' as
+    /// separator. With \a compress, each file is compressed with
+    /// LZ4 unless compression doesn't make it smaller (like for
+    /// png, jpg or ogg files).
+    ///
+    /// \param filename Path of the archive file to write
+    /// \param paths    Paths of the files to pack
+    /// \param compress Compress the entries?
+    ///
+    /// \return True if the archive was written successfully
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool create(const std::string& filename, const std::vector<std::string>& paths, bool compress = true);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Entry of the index
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        std::string name;       ///< Name of the entry
+        Uint64      offset;     ///< Position of the data in the archive
+        Uint64      storedSize; ///< Size of the data in the archive
+        Uint64      size;       ///< Size of the uncompressed data
+        Uint32      flags;      ///< Compression of the data
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Close the archive and free all the buffers
+    ///
+    ////////////////////////////////////////////////////////////
+    void close();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find an entry of the index
+    ///
+    /// \param name Name of the entry
+    ///
+    /// \return Pointer to the entry, NULL if not found
+    ///
+    ////////////////////////////////////////////////////////////
+    const Entry* findEntry(const std::string& name) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether an entry can be read in place
+    ///
+    /// \param entry Entry to check
+    ///
+    /// \return True if the entry is stored uncompressed in the mapped file
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isInPlace(const Entry& entry) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the buffer of an entry, decompressing it if needed
+    ///
+    /// \param entry Entry to load
+    ///
+    /// \return Pointer to the buffer, NULL on error
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::vector<char>* loadEntry(const Entry& entry);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function of the prefetching thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void prefetchEntries();
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::map<std::string, std::vector<char> > BufferTable; ///< Buffers of the entries which are not read in place
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    MappedFileInputStream     m_mapping;     ///< Archive mapped in memory, if possible
+    FileInputStream           m_file;        ///< Archive file, used when it can't be mapped
+    bool                      m_mapped;      ///< Is the archive mapped in memory?
+    std::vector<Entry>        m_entries;     ///< Index of the archive, sorted by name
+    BufferTable               m_buffers;     ///< Decompressed entries
+    std::deque<const Entry*>  m_prefetches;  ///< Entries waiting to be prefetched
+    Mutex                     m_mutex;       ///< Mutex protecting the buffers and the prefetch queue
+    Mutex                     m_fileMutex;   ///< Mutex protecting the reading position of the file
+    Thread                    m_thread;      ///< Prefetching thread
+    bool                      m_prefetching; ///< Is the prefetching thread running?
+};
+
+} // namespace sf
+
+
+#endif // SFML_ARCHIVE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Archive
+/// \ingroup system
+///
+/// sf::Archive packs a whole tree of asset files into a
+/// single file, so that opening an asset doesn't cost a
+/// filesystem lookup anymore. The entries are found with a
+/// binary search in a sorted index, and are optionally
+/// compressed with LZ4, which decompresses faster than
+/// most storage devices can read.
+///
+/// Entries are opened as sf::MemoryInputStream, so they can
+/// be passed to the loadFromStream functions of the SFML
+/// resources (sf::Texture, sf::Font, sf::SoundBuffer,
+/// sf::Shader, ...). Fonts and music read their stream while
+/// they are used, so the stream must be kept alive with them.
+///
+/// Archives are created with the static function create(),
+/// typically by a small tool run when building the game.
+///
+/// Usage example:
+/// \code
+/// sf::Archive archive;
+/// if (!archive.open("assets.sfpk"))
+///     return -1;
+///
+/// // Decompress the next level while the current one is played
+/// archive.prefetch("textures/level2.png");
+///
+/// sf::MemoryInputStream stream;
+/// sf::Texture texture;
+/// if (archive.openEntry("textures/level1.png", stream))
+///     texture.loadFromStream(stream);
+/// \endcode
+///
+/// \see sf::MemoryInputStream, sf::MappedFileInputStream
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,164 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_ATOMICINT_HPP
+#define SFML_ATOMICINT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief 32-bit integer with atomic operations
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API AtomicInt : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param value Initial value
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit AtomicInt(Int32 value = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the value
+    ///
+    /// This is an acquire operation: the writes made by another
+    /// thread before it stored the value are visible after it.
+    /// The cache line of the value is only read, never locked.
+    ///
+    /// \return Current value
+    ///
+    ////////////////////////////////////////////////////////////
+    Int32 load() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the value
+    ///
+    /// This is a release operation: the writes made before it
+    /// are visible to the threads that load the new value.
+    ///
+    /// \param value New value
+    ///
+    ////////////////////////////////////////////////////////////
+    void store(Int32 value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the value and return the previous one
+    ///
+    /// \param value New value
+    ///
+    /// \return Previous value
+    ///
+    ////////////////////////////////////////////////////////////
+    Int32 exchange(Int32 value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the value if it is equal to an expected one
+    ///
+    /// \param expected Expected value; receives the current value on failure
+    /// \param desired  Value to store if the current value is \a expected
+    ///
+    /// \return True if the value was changed
+    ///
+    ////////////////////////////////////////////////////////////
+    bool compareExchange(Int32& expected, Int32 desired);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add to the value and return the previous one
+    ///
+    /// \param value Value to add (may be negative)
+    ///
+    /// \return Previous value
+    ///
+    ////////////////////////////////////////////////////////////
+    Int32 fetchAdd(Int32 value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Increment the value
+    ///
+    /// \return New value
+    ///
+    ////////////////////////////////////////////////////////////
+    Int32 operator ++();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decrement the value
+    ///
+    /// \return New value
+    ///
+    ////////////////////////////////////////////////////////////
+    Int32 operator --();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    mutable volatile Int32 m_value; ///< Value, only accessed through atomic operations
+};
+
+} // namespace sf
+
+
+#endif // SFML_ATOMICINT_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::AtomicInt
+/// \ingroup system
+///
+/// sf::AtomicInt is an integer that can be read and modified
+/// by several threads without a mutex. Each operation is
+/// atomic, so that writes made by a thread before changing
+/// the integer are visible to another thread after it reads
+/// the new value. load and store are plain reads and writes
+/// with acquire and release ordering; the read-modify-write
+/// operations act as full memory barriers.
+///
+/// Typical uses are counters, reference counts and flags:
+/// \code
+/// sf::AtomicInt remaining(jobCount);
+///
+/// void runJob(Job& job)
+/// {
+///     job.run();
+///     if (--remaining == 0)
+///         allJobsDone();
+/// }
+/// \endcode
+///
+/// \see sf::Mutex
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,225 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef SFML_BUFFEREDINPUTSTREAM_HPP
+#define SFML_BUFFEREDINPUTSTREAM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Export.hpp>
+#include <SFML/System/ConditionVariable.hpp>
+#include <SFML/System/InputStream.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Thread.hpp>
+#include <cstdlib>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Input stream reading another stream ahead of time
+///        in a background thread
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API BufferedInputStream : public InputStream, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    BufferedInputStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Stops the read-ahead thread.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~BufferedInputStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the amount of data read ahead of the reading position
+    ///
+    /// A bigger window absorbs longer stalls of the source,
+    /// at the cost of memory. The new size applies to the next
+    /// call to open. The default size is 256 KB.
+    ///
+    /// \param size Size of the read-ahead window, in bytes
+    ///
+    /// \see getPrefetchSize
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPrefetchSize(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the amount of data read ahead of the reading position
+    ///
+    /// \return Size of the read-ahead window, in bytes
+    ///
+    /// \see setPrefetchSize
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPrefetchSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start reading a source stream ahead of time
+    ///
+    /// The source is read from its current position by the
+    /// read-ahead thread only: it must not be used elsewhere,
+    /// and must remain alive, until this stream is closed or
+    /// destroyed. The previous source, if any, is closed first.
+    ///
+    /// \param source Stream to read
+    ///
+    /// \return True on success, false if the size of the source is unknown
+    ///
+    ////////////////////////////////////////////////////////////
+    bool open(InputStream& source);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop reading the source stream
+    ///
+    /// The read-ahead thread is stopped, and the source can be
+    /// used again or destroyed.
+    ///
+    ////////////////////////////////////////////////////////////
+    void close();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read data from the stream
+    ///
+    /// The data is copied from the read-ahead window; this
+    /// function only waits for the source when the window
+    /// doesn't contain the requested data yet.
+    ///
+    /// \param data Buffer where to copy the read data
+    /// \param size Desired number of bytes to read
+    ///
+    /// \return The number of bytes actually read, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 read(void* data, Int64 size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current reading position
+    ///
+    /// Seeking forward inside the read-ahead window keeps the
+    /// data that follows; other seeks restart the read-ahead
+    /// from the new position.
+    ///
+    /// \param position The position to seek to, from the beginning
+    ///
+    /// \return The position actually sought to, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 seek(Int64 position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current reading position in the stream
+    ///
+    /// \return The current position, or -1 on error.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 tell();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the stream
+    ///
+    /// \return The total number of bytes available in the stream, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 getSize();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function of the read-ahead thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void prefetch();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    InputStream*      m_source;       ///< Stream read by the read-ahead thread
+    Thread            m_thread;       ///< Read-ahead thread
+    Mutex             m_mutex;        ///< Mutex protecting the window
+    ConditionVariable m_condition;    ///< Signals new data, free room, seeks and the end of the thread
+    std::vector<char> m_window;       ///< Ring buffer holding the data read ahead
+    std::size_t       m_prefetchSize; ///< Size of the window for the next sources
+    std::size_t       m_head;         ///< Index of the data at the reading position in the window
+    std::size_t       m_count;        ///< Number of bytes available in the window
+    Int64             m_position;     ///< Current reading position
+    Int64             m_size;         ///< Size of the source
+    Uint32            m_generation;   ///< Incremented by each seek, to discard the data read before it
+    bool              m_endReached;   ///< Has the read-ahead thread reached the end of the source?
+    bool              m_failed;       ///< Did the source report an error?
+    bool              m_stopping;     ///< Must the read-ahead thread stop?
+};
+
+} // namespace sf
+
+
+#endif // SFML_BUFFEREDINPUTSTREAM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::BufferedInputStream
+/// \ingroup system
+///
+/// This class is a specialization of InputStream that reads
+/// another stream ahead of time, in a thread of its own. The
+/// reads are served from a window of data that follows the
+/// reading position, so that a slow source (network drive,
+/// decompressed archive, Android asset) doesn't block the
+/// thread which reads the stream, as long as it keeps up on
+/// average.
+///
+/// sf::Music reads its files through a buffered stream, so that
+/// the streaming thread doesn't stall on disk accesses. It can
+/// be used in front of any other stream, typically for data
+/// which is read sequentially.
+///
+/// Usage example:
+/// \code
+/// MyNetworkStream source;
+/// source.open("http://example.com/level.dat");
+///
+/// sf::BufferedInputStream stream;
+/// stream.setPrefetchSize(1024 * 1024);
+/// if (!stream.open(source))
+///     return -1;
+///
+/// Level level;
+/// level.loadFromStream(stream);
+/// \endcode
+///
+/// \see InputStream, FileInputStream
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_CONDITIONVARIABLE_HPP
+#define SFML_CONDITIONVARIABLE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <deque>
+
+
+namespace sf
+{
+class Semaphore;
+
+////////////////////////////////////////////////////////////
+/// \brief Lets threads sleep until another one notifies them
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API ConditionVariable : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ConditionVariable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unlock a mutex and wait until the condition is notified
+    ///
+    /// The mutex must be locked exactly once by the calling
+    /// thread; it is locked again before the function returns.
+    /// Like with all condition variables, the thread may wake up
+    /// without having been notified, so the waited-for state must
+    /// be checked again in a loop.
+    ///
+    /// \param mutex Mutex protecting the waited-for state
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait(Mutex& mutex);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unlock a mutex and wait until the condition is notified or a timeout expires
+    ///
+    /// \param mutex   Mutex protecting the waited-for state
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return True if the condition was notified, false if the timeout expired
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wait(Mutex& mutex, Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wake up one of the waiting threads, if any
+    ///
+    ////////////////////////////////////////////////////////////
+    void notifyOne();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wake up all the waiting threads
+    ///
+    ////////////////////////////////////////////////////////////
+    void notifyAll();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Mutex                   m_mutex;   ///< Mutex protecting the list of waiters
+    std::deque<Semaphore*>  m_waiters; ///< Semaphores of the waiting threads, in the order they started waiting
+};
+
+} // namespace sf
+
+
+#endif // SFML_CONDITIONVARIABLE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ConditionVariable
+/// \ingroup system
+///
+/// A condition variable lets a thread sleep until some state,
+/// protected by a mutex, changes. The waiting thread calls
+/// wait() with the mutex locked: the mutex is released while
+/// the thread sleeps, so that other threads can change the
+/// state, then notify the condition.
+///
+/// Usage example:
+/// \code
+/// sf::Mutex mutex;
+/// sf::ConditionVariable ready;
+/// bool loaded = false;
+///
+/// void loader()
+/// {
+///     ... // load the data
+///
+///     sf::Lock lock(mutex);
+///     loaded = true;
+///     ready.notifyAll();
+/// }
+///
+/// void user()
+/// {
+///     sf::Lock lock(mutex);
+///     while (!loaded)
+///         ready.wait(mutex);
+///
+///     ... // use the data
+/// }
+/// \endcode
+///
+/// \see sf::Mutex, sf::Semaphore
+///
+////////////////////////////////////////////////////////////
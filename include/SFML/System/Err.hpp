@@ -54,13 +54,22 @@ SFML_SYSTEM_API std::ostream& err();
 /// (-> the stderr descriptor) which is the console if there's
 /// one available.
 ///
+/// It is a front-end of sf::Log: each complete line becomes an
+/// Error message of the "sfml" category, written immediately,
+/// so that the lines of different threads don't mix. The level
+/// and rate filters of sf::Log apply to these messages. The
+/// warnings of SFML are written to sf::Log directly, at the
+/// Warning level.
+///
 /// It is a standard std::ostream instance, so it supports all the
 /// insertion operations defined by the STL
 /// (operator <<, manipulators, etc.).
 ///
 /// sf::err() can be redirected to write to another output, independently
 /// of std::cerr, by using the rdbuf() function provided by the
-/// std::ostream class.
+/// std::ostream class; the errors then bypass the log, while the
+/// warnings still go to it. To redirect both, redirect the output
+/// of the log with sf::Log::setOutput instead.
 ///
 /// Example:
 /// \code
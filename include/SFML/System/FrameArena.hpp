@@ -0,0 +1,321 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_FRAMEARENA_HPP
+#define SFML_FRAMEARENA_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+#include <limits>
+#include <new>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Linear allocator for the temporary memory of a frame
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API FrameArena : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default alignment of the allocations
+    ///
+    ////////////////////////////////////////////////////////////
+    enum
+    {
+        DefaultAlignment = 16 ///< Enough for any scalar type and SSE vectors
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct an empty arena
+    ///
+    /// No memory is allocated until the first allocation.
+    ///
+    /// \param blockSize Size of the blocks of memory requested from the system, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit FrameArena(std::size_t blockSize = 65536);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// All the memory of the arena is released.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~FrameArena();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Allocate memory from the arena
+    ///
+    /// The memory stays valid until the arena is reset, unless
+    /// it is deallocated first.
+    ///
+    /// \param size      Number of bytes to allocate
+    /// \param alignment Alignment of the memory, a power of two
+    ///
+    /// \return Pointer to the allocated memory
+    ///
+    ////////////////////////////////////////////////////////////
+    void* allocate(std::size_t size, std::size_t alignment = DefaultAlignment);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give memory back to the arena
+    ///
+    /// Only the last allocation can actually be reused before
+    /// the arena is reset: memory freed in the reverse order of
+    /// its allocation, like the temporaries of a function, costs
+    /// nothing. Freeing other allocations does nothing.
+    ///
+    /// \param data Pointer returned by allocate
+    /// \param size Size passed to allocate
+    ///
+    ////////////////////////////////////////////////////////////
+    void deallocate(void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release all the allocations at once
+    ///
+    /// The blocks of memory are kept for the next frame, and
+    /// merged into one if the frame needed several of them.
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of bytes currently allocated
+    ///
+    /// \return Bytes allocated since the last reset, padding included
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getUsedSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of bytes allocated during the last frame
+    ///
+    /// \return Highest number of bytes used between the two last resets
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getLastFrameSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the highest number of bytes ever allocated at once
+    ///
+    /// \return Peak usage of the arena since its construction
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPeakSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of bytes reserved from the system
+    ///
+    /// \return Total size of the blocks of the arena
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCapacity() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the arena of the calling thread
+    ///
+    /// Each thread has its own arena, created on first use.
+    /// sf::Window::display resets the arena of the thread
+    /// which calls it; other threads must reset their arena
+    /// themselves.
+    ///
+    /// \return Arena of the calling thread
+    ///
+    ////////////////////////////////////////////////////////////
+    static FrameArena& getThreadArena();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Block of memory
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Block
+    {
+        Block*      next; ///< Next block of the arena
+        std::size_t size; ///< Number of usable bytes after the header
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the first usable byte of a block
+    ///
+    ////////////////////////////////////////////////////////////
+    static char* getBlockData(Block* block);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::size_t m_blockSize;      ///< Minimum size of the new blocks
+    Block*      m_first;          ///< First block of the arena
+    Block*      m_current;        ///< Block the allocations are taken from
+    std::size_t m_offset;         ///< Number of bytes used in the current block
+    std::size_t m_previousBlocks; ///< Number of bytes used in the blocks before the current one
+    std::size_t m_frameSize;      ///< Highest usage of the current frame
+    std::size_t m_lastFrameSize;  ///< Highest usage of the last frame
+    std::size_t m_peakSize;       ///< Highest usage ever
+    std::size_t m_capacity;       ///< Total size of the blocks
+};
+
+////////////////////////////////////////////////////////////
+/// \brief STL allocator taking its memory from a sf::FrameArena
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+class FrameAllocator
+{
+public:
+
+    typedef T              value_type;
+    typedef T*             pointer;
+    typedef const T*       const_pointer;
+    typedef T&             reference;
+    typedef const T&       const_reference;
+    typedef std::size_t    size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef FrameAllocator<U> other;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct an allocator using the arena of the calling thread
+    ///
+    ////////////////////////////////////////////////////////////
+    FrameAllocator();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct an allocator using a given arena
+    ///
+    /// \param arena Arena to allocate from
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit FrameAllocator(FrameArena& arena);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct from an allocator of another type, sharing its arena
+    ///
+    /// \param other Allocator to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U>& other);
+
+    pointer address(reference value) const;
+    const_pointer address(const_reference value) const;
+    pointer allocate(size_type count, const void* hint = 0);
+    void deallocate(pointer data, size_type count);
+    size_type max_size() const;
+    void construct(pointer data, const T& value);
+    void destroy(pointer data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the arena of the allocator
+    ///
+    /// \return Arena the memory is taken from
+    ///
+    ////////////////////////////////////////////////////////////
+    FrameArena& getArena() const;
+
+private:
+
+    template <typename U>
+    friend class FrameAllocator;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    FrameArena* m_arena; ///< Arena to allocate from
+};
+
+template <typename T, typename U>
+bool operator ==(const FrameAllocator<T>& left, const FrameAllocator<U>& right);
+
+template <typename T, typename U>
+bool operator !=(const FrameAllocator<T>& left, const FrameAllocator<U>& right);
+
+#include <SFML/System/FrameArena.inl>
+
+} // namespace sf
+
+
+#endif // SFML_FRAMEARENA_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::FrameArena
+/// \ingroup system
+///
+/// sf::FrameArena hands out memory by moving a pointer forward
+/// in large blocks, and takes it all back at once when it is
+/// reset, typically once per frame. This makes the temporary
+/// buffers of a frame (scratch vertices, formatted strings,
+/// message payloads...) almost free, and avoids fragmenting
+/// the heap with short-lived allocations.
+///
+/// An arena is not thread-safe: each thread has its own one,
+/// returned by getThreadArena(). sf::Window::display resets
+/// the arena of its thread, so memory taken from it must not
+/// be kept across a display. SFML uses the thread arena for
+/// its own scratch buffers, freeing them before returning,
+/// so that threads which never display (or never reset their
+/// arena) don't accumulate memory.
+///
+/// sf::FrameAllocator adapts an arena to the standard
+/// containers. Memory freed by a container is only reused
+/// if it was the last allocation, so containers should be
+/// sized once (reserve, or construction with a size) rather
+/// than grown element by element.
+///
+/// The usage counters help sizing the blocks: getLastFrameSize()
+/// tells how much the last frame needed, getPeakSize() the most
+/// any frame needed.
+///
+/// Usage example:
+/// \code
+/// typedef std::vector<sf::Vertex, sf::FrameAllocator<sf::Vertex> > ScratchVertices;
+///
+/// void drawParticles(sf::RenderTarget& target)
+/// {
+///     ScratchVertices vertices;
+///     vertices.reserve(particles.size() * 4);
+///     ...
+///     target.draw(&vertices[0], vertices.size(), sf::Quads);
+/// }
+///
+/// // Once per frame, after display
+/// std::cout << sf::FrameArena::getThreadArena().getLastFrameSize() << " bytes of scratch memory" << std::endl;
+/// \endcode
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Compute the alignment of a type
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+struct FrameAlignment
+{
+    struct Padded
+    {
+        char first;
+        T    value;
+    };
+
+    enum
+    {
+        Value = sizeof(Padded) - sizeof(T)
+    };
+};
+
+} // namespace priv
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+FrameAllocator<T>::FrameAllocator() :
+m_arena(&FrameArena::getThreadArena())
+{
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+FrameAllocator<T>::FrameAllocator(FrameArena& arena) :
+m_arena(&arena)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+template <typename U>
+FrameAllocator<T>::FrameAllocator(const FrameAllocator<U>& other) :
+m_arena(other.m_arena)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+typename FrameAllocator<T>::pointer FrameAllocator<T>::address(reference value) const
+{
+    return &value;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+typename FrameAllocator<T>::const_pointer FrameAllocator<T>::address(const_reference value) const
+{
+    return &value;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+typename FrameAllocator<T>::pointer FrameAllocator<T>::allocate(size_type count, const void*)
+{
+    if (count > max_size())
+        throw std::bad_alloc();
+
+    return static_cast<pointer>(m_arena->allocate(count * sizeof(T), priv::FrameAlignment<T>::Value));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void FrameAllocator<T>::deallocate(pointer data, size_type count)
+{
+    m_arena->deallocate(data, count * sizeof(T));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+typename FrameAllocator<T>::size_type FrameAllocator<T>::max_size() const
+{
+    return std::numeric_limits<size_type>::max() / sizeof(T);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void FrameAllocator<T>::construct(pointer data, const T& value)
+{
+    new (data) T(value);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void FrameAllocator<T>::destroy(pointer data)
+{
+    data->~T();
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+FrameArena& FrameAllocator<T>::getArena() const
+{
+    return *m_arena;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T, typename U>
+bool operator ==(const FrameAllocator<T>& left, const FrameAllocator<U>& right)
+{
+    return &left.getArena() == &right.getArena();
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T, typename U>
+bool operator !=(const FrameAllocator<T>& left, const FrameAllocator<U>& right)
+{
+    return !(left == right);
+}
@@ -0,0 +1,222 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_FRAMEPACER_HPP
+#define SFML_FRAMEPACER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Utility class that paces a loop to a fixed frame time
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API FramePacer
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Frame time statistics
+    ///
+    /// The counters cover all the frames since the last call
+    /// to resetStatistics(). The durations are computed over
+    /// the most recent frames only (see HistorySize).
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_SYSTEM_API Statistics
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        ////////////////////////////////////////////////////////////
+        Statistics();
+
+        Uint64 frameCount;      ///< Number of frames paced
+        Uint64 missedDeadlines; ///< Number of frames that ended after their deadline
+        Time   averageDuration; ///< Mean duration of the recent frames
+        Time   medianDuration;  ///< 50th percentile of the duration of the recent frames
+        Time   p99Duration;     ///< 99th percentile of the duration of the recent frames
+        Time   maximumDuration; ///< Longest recent frame
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Number of recent frame durations kept for the statistics
+    ///
+    ////////////////////////////////////////////////////////////
+    enum
+    {
+        HistorySize = 256
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The pacer is disabled (frame time of zero) by default.
+    ///
+    ////////////////////////////////////////////////////////////
+    FramePacer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the target duration of a frame
+    ///
+    /// Changing the frame time restarts the pacing.
+    ///
+    /// \param frameTime Target frame time (use Time::Zero to disable pacing)
+    ///
+    /// \see getFrameTime
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFrameTime(Time frameTime);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the target duration of a frame
+    ///
+    /// \return Target frame time, or Time::Zero if pacing is disabled
+    ///
+    /// \see setFrameTime
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getFrameTime() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restart the pacing from now
+    ///
+    /// The next frame deadline is set to one frame time from now.
+    /// Call this function after a long pause (loading, window
+    /// minimized, ...) so that the pacer doesn't count the pause
+    /// as a missed deadline.
+    ///
+    ////////////////////////////////////////////////////////////
+    void restart();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the end of the current frame
+    ///
+    /// The function sleeps for the coarse part of the remaining
+    /// time, then yields the processor until the deadline is
+    /// reached, so that the precision doesn't depend on the
+    /// granularity of the OS sleep. The margin left for yielding
+    /// adapts to how much the sleeps of the system overshoot.
+    ///
+    /// Deadlines are spaced by exactly one frame time, so errors
+    /// don't accumulate over frames: a frame that ends a little
+    /// late is followed by a slightly shorter wait. If a frame ends
+    /// more than one frame time late, the pacer counts a missed
+    /// deadline and restarts from now instead of trying to catch up.
+    ///
+    /// If pacing is disabled, this function returns immediately
+    /// but still records the frame duration.
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the frame time statistics
+    ///
+    /// \return Statistics of the paced frames
+    ///
+    /// \see resetStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    Statistics getStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the frame time statistics
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetStatistics();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record the duration of the frame that just ended
+    ///
+    /// \param now Current time of the pacer's clock
+    ///
+    ////////////////////////////////////////////////////////////
+    void recordFrame(Time now);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Clock             m_clock;           ///< Clock measuring all the deadlines
+    Time              m_frameTime;       ///< Target frame time
+    Time              m_deadline;        ///< End of the current frame
+    Time              m_frameStart;      ///< Start of the current frame
+    Time              m_sleepOvershoot;  ///< Estimated maximum overshoot of the OS sleep
+    Uint64            m_frameCount;      ///< Number of frames since the statistics were reset
+    Uint64            m_missedDeadlines; ///< Number of missed deadlines since the statistics were reset
+    std::vector<Time> m_durations;       ///< Ring buffer of the recent frame durations
+};
+
+} // namespace sf
+
+
+#endif // SFML_FRAMEPACER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::FramePacer
+/// \ingroup system
+///
+/// sf::FramePacer limits a loop to a fixed frequency with a
+/// better precision than a plain sf::sleep: it sleeps for most
+/// of the remaining frame time, and then yields the processor
+/// until the exact deadline. Deadlines are absolute, so that
+/// the average frequency doesn't drift even if individual
+/// frames are a little late.
+///
+/// sf::Window uses it to implement setFramerateLimit and
+/// setFrameInterval, but it can also pace other loops, like
+/// a fixed-rate simulation thread.
+///
+/// Usage example:
+/// \code
+/// sf::FramePacer pacer;
+/// pacer.setFrameTime(sf::seconds(1.f / 60.f));
+///
+/// while (running)
+/// {
+///     update();
+///     pacer.wait();
+/// }
+///
+/// sf::FramePacer::Statistics stats = pacer.getStatistics();
+/// std::cout << "p99: " << stats.p99Duration.asMilliseconds() << " ms, "
+///           << stats.missedDeadlines << " missed deadlines" << std::endl;
+/// \endcode
+///
+/// \see sf::Clock, sf::sleep
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,267 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_LOG_HPP
+#define SFML_LOG_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/Time.hpp>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+
+////////////////////////////////////////////////////////////
+/// \brief Log a message, formatting it only if it passes the filters
+///
+/// \param level    Level of the message (a sf::Log::Level)
+/// \param category Category of the message (a string literal)
+/// \param message  Expression to insert into a stream, like "x = " << x
+///
+////////////////////////////////////////////////////////////
+#define SFML_LOG(level, category, message)                          \
+    do                                                              \
+    {                                                               \
+        if (sf::Log::isEnabled(level, category))                    \
+        {                                                           \
+            std::ostringstream sfLogStream;                         \
+            sfLogStream << message;                                 \
+            sf::Log::write(level, category, sfLogStream.str());     \
+        }                                                           \
+    }                                                               \
+    while (false)
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Log with levels and categories, optionally
+///        asynchronous and rate limited
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API Log
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Importance of a message
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Level
+    {
+        Debug,   ///< Details only useful when debugging
+        Info,    ///< Normal events
+        Warning, ///< Something unexpected happened, but the program can continue
+        Error,   ///< An operation failed
+        None     ///< Not a message level: filters out all the messages
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the minimum level of the messages written
+    ///
+    /// The default level is Info. It applies to all the
+    /// categories that don't have their own level.
+    ///
+    /// \param level Minimum level of the messages to write
+    ///
+    /// \see setCategoryLevel
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setLevel(Level level);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the minimum level of the messages written
+    ///
+    /// \return Minimum level of the categories without their own level
+    ///
+    ////////////////////////////////////////////////////////////
+    static Level getLevel();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the minimum level of the messages of a category
+    ///
+    /// The messages of SFML itself (sf::err()) are in the
+    /// "sfml" category.
+    ///
+    /// \param category Name of the category
+    /// \param level    Minimum level of the messages of the category to write
+    ///
+    /// \see resetCategoryLevels
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setCategoryLevel(const std::string& category, Level level);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make all the categories use the global level again
+    ///
+    ////////////////////////////////////////////////////////////
+    static void resetCategoryLevels();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a message would pass the level filters
+    ///
+    /// This is cheap when no category has its own level, or
+    /// when the level is below all of them: it only reads an
+    /// atomic variable. Use it (or the SFML_LOG macro) to
+    /// avoid formatting messages which are filtered out.
+    ///
+    /// \param level    Level of the message
+    /// \param category Category of the message
+    ///
+    /// \return True if the message would be written
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isEnabled(Level level, const char* category);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write a message
+    ///
+    /// By default, the message is written before this function
+    /// returns. When the log is asynchronous, the messages below
+    /// the Error level are queued and written by a background
+    /// thread instead, so that this function never waits for
+    /// the output; if the queue is full, the message is dropped
+    /// and the number of dropped messages is reported later.
+    /// Errors are always written immediately, after the queued
+    /// messages. A trailing end of line is removed.
+    ///
+    /// \param level    Level of the message
+    /// \param category Category of the message
+    /// \param message  Text of the message
+    ///
+    ////////////////////////////////////////////////////////////
+    static void write(Level level, const char* category, const std::string& message);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until all the queued messages are written
+    ///
+    ////////////////////////////////////////////////////////////
+    static void flush();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the asynchronous writing of the messages
+    ///
+    /// When enabled, the messages below the Error level are
+    /// written by a background thread, and may be lost if they
+    /// are produced faster than they are written, or if the
+    /// program crashes before they are. It is disabled by
+    /// default. Disabling it writes the queued messages.
+    ///
+    /// \param enable True to queue the messages, false to write them immediately
+    ///
+    /// \see isAsynchronous, flush
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setAsynchronous(bool enable);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the messages are written asynchronously
+    ///
+    /// \return True if the messages below the Error level are queued
+    ///
+    /// \see setAsynchronous
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAsynchronous();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the output of the messages
+    ///
+    /// The stream may be written by any thread that writes a
+    /// message, or by the background thread; it must not be
+    /// used by the program while it is the output, and must
+    /// live until it is replaced. The queued messages are
+    /// written to the previous output first.
+    ///
+    /// \param output Stream to write the messages to, or NULL for the standard error output (default)
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setOutput(std::ostream* output);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Limit how often the same message can be written
+    ///
+    /// Each distinct message (same level, category and text) is
+    /// written at most \a count times per \a period; the next
+    /// ones are counted, and the count is written at the end of
+    /// the period. By default there is no limit, so that no
+    /// message is ever lost.
+    ///
+    /// \param count  Maximum number of identical messages per period, or 0 for no limit
+    /// \param period Duration of a period
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setRateLimit(unsigned int count, Time period);
+};
+
+} // namespace sf
+
+
+#endif // SFML_LOG_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Log
+/// \ingroup system
+///
+/// sf::Log writes messages as "[category] text" lines, one
+/// message at a time, so that the output of different threads
+/// never interleaves. Messages are filtered by level, globally
+/// or per category, and the SFML_LOG macro only formats the
+/// messages that pass the filters.
+///
+/// By default, every message is written before sf::Log::write
+/// returns, and none is ever dropped. Two opt-in features
+/// reduce the cost of logging in a hot loop:
+/// \li setAsynchronous makes the calling thread push the
+///     messages below the Error level to a lock-free queue,
+///     which a background thread writes to the output
+/// \li setRateLimit writes a message repeated every frame a
+///     few times per period, then summarizes it
+///
+/// sf::err() is a front-end of the log: each line written to
+/// it becomes a message of the "sfml" category, at the Error
+/// level. SFML writes its warnings directly to the log, at the
+/// Warning level.
+///
+/// Usage example:
+/// \code
+/// sf::Log::setAsynchronous(true);
+/// sf::Log::setRateLimit(5, sf::seconds(1));
+/// sf::Log::setLevel(sf::Log::Warning);
+/// sf::Log::setCategoryLevel("physics", sf::Log::Debug);
+///
+/// SFML_LOG(sf::Log::Debug, "physics", "step took " << elapsed.asMicroseconds() << " us");
+/// sf::Log::write(sf::Log::Error, "assets", "missing texture " + name);
+///
+/// // Before exiting, or before a crash is likely
+/// sf::Log::flush();
+/// \endcode
+///
+/// \see sf::err
+///
+////////////////////////////////////////////////////////////
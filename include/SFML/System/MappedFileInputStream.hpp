@@ -0,0 +1,190 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_MAPPEDFILEINPUTSTREAM_HPP
+#define SFML_MAPPEDFILEINPUTSTREAM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Export.hpp>
+#include <SFML/System/InputStream.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstdlib>
+#include <string>
+
+#ifdef SFML_SYSTEM_ANDROID
+namespace sf
+{
+namespace priv
+{
+class SFML_SYSTEM_API ResourceStream;
+}
+}
+#endif
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Implementation of input stream based on a file mapped in memory
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API MappedFileInputStream : public InputStream, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    MappedFileInputStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~MappedFileInputStream();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open the stream from a file path
+    ///
+    /// The whole file is mapped read-only in the address space
+    /// of the process; its pages are loaded by the system when
+    /// they are accessed. Mapping fails for empty files.
+    ///
+    /// On Android, \a filename names an asset of the APK.
+    /// Uncompressed assets are mapped straight from the APK,
+    /// compressed ones are inflated once in memory.
+    ///
+    /// \param filename Name of the file to open
+    ///
+    /// \return True on success, false on error
+    ///
+    ////////////////////////////////////////////////////////////
+    bool open(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a pointer to the content of the file
+    ///
+    /// The pointer stays valid until the stream is destroyed or
+    /// another file is opened.
+    ///
+    /// \return Pointer to the mapped file, or NULL if no file is open
+    ///
+    ////////////////////////////////////////////////////////////
+    const void* getData() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read data from the stream
+    ///
+    /// After reading, the stream's reading position must be
+    /// advanced by the amount of bytes read.
+    ///
+    /// \param data Buffer where to copy the read data
+    /// \param size Desired number of bytes to read
+    ///
+    /// \return The number of bytes actually read, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 read(void* data, Int64 size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the current reading position
+    ///
+    /// \param position The position to seek to, from the beginning
+    ///
+    /// \return The position actually sought to, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 seek(Int64 position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current reading position in the stream
+    ///
+    /// \return The current position, or -1 on error.
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 tell();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the stream
+    ///
+    /// \return The total number of bytes available in the stream, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Int64 getSize();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unmap the current file, if any
+    ///
+    ////////////////////////////////////////////////////////////
+    void close();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    void*       m_data;   ///< Address of the mapped file
+    std::size_t m_size;   ///< Size of the file
+    Int64       m_offset; ///< Current reading position
+#ifdef SFML_SYSTEM_ANDROID
+    priv::ResourceStream* m_asset; ///< Asset owning the data
+#endif
+};
+
+} // namespace sf
+
+
+#endif // SFML_MAPPEDFILEINPUTSTREAM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::MappedFileInputStream
+/// \ingroup system
+///
+/// This class is a specialization of InputStream that
+/// reads from a file on disk mapped in memory.
+///
+/// Unlike FileInputStream, the content of the file is not
+/// copied through the buffers of the C library: getData()
+/// gives direct access to it. SFML resource classes detect
+/// this stream in their loadFromStream functions and decode
+/// the mapped file in place, like with loadFromMemory,
+/// which saves time and memory for big files.
+///
+/// Usage example:
+/// \code
+/// sf::MappedFileInputStream stream;
+/// if (!stream.open("big_texture.png"))
+///     return -1;
+///
+/// sf::Image image;
+/// image.loadFromMemory(stream.getData(), stream.getSize());
+/// \endcode
+///
+/// \see InputStream, FileInputStream, MemoryInputStream
+///
+////////////////////////////////////////////////////////////
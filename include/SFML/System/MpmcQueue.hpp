@@ -0,0 +1,156 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_MPMCQUEUE_HPP
+#define SFML_MPMCQUEUE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/AtomicInt.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Bounded lock-free queue for any number of
+///        producer and consumer threads
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+class MpmcQueue : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the queue
+    ///
+    /// The capacity is rounded up to a power of two.
+    ///
+    /// \param capacity Minimum number of elements the queue can hold
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit MpmcQueue(std::size_t capacity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~MpmcQueue();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an element at the end of the queue
+    ///
+    /// \param value Element to add
+    ///
+    /// \return True if the element was added, false if the queue is full
+    ///
+    ////////////////////////////////////////////////////////////
+    bool push(const T& value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove the element at the front of the queue
+    ///
+    /// \param value Receives the element
+    ///
+    /// \return True if an element was removed, false if the queue is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    bool pop(T& value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of elements in the queue
+    ///
+    /// \return Capacity of the queue
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCapacity() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Slot of the queue
+    ////////////////////////////////////////////////////////////
+    struct Cell
+    {
+        AtomicInt sequence; ///< Position for which the cell is ready to be written (== position) or read (== position + 1)
+        T         value;    ///< Element stored in the cell
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Cell*     m_cells;                            ///< Ring buffer of cells
+    Uint32    m_mask;                             ///< Number of cells minus one (the number is a power of two)
+    char      m_padding1[64];                     ///< Keeps the positions on their own cache lines
+    AtomicInt m_pushPosition;                     ///< Position of the next push, shared by the producers
+    char      m_padding2[64 - sizeof(AtomicInt)];
+    AtomicInt m_popPosition;                      ///< Position of the next pop, shared by the consumers
+    char      m_padding3[64 - sizeof(AtomicInt)];
+};
+
+#include <SFML/System/MpmcQueue.inl>
+
+} // namespace sf
+
+
+#endif // SFML_MPMCQUEUE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::MpmcQueue
+/// \ingroup system
+///
+/// sf::MpmcQueue is a fixed-capacity queue which any number
+/// of threads can push to and pop from concurrently, without
+/// locks. Each cell carries a sequence number telling whether
+/// it is ready to be written or read, so that producers and
+/// consumers only contend on their own position counter.
+///
+/// push() and pop() never block: they fail when the queue
+/// is full or empty.
+///
+/// Usage example:
+/// \code
+/// sf::MpmcQueue<Job*> jobs(1024);
+///
+/// // Any thread
+/// if (!jobs.push(new Job(...)))
+///     runNow(...);
+///
+/// // Worker threads
+/// Job* job;
+/// while (jobs.pop(job))
+/// {
+///     job->run();
+///     delete job;
+/// }
+/// \endcode
+///
+/// \see sf::SpscQueue
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+template <typename T>
+MpmcQueue<T>::MpmcQueue(std::size_t capacity) :
+m_mask(1)
+{
+    while (m_mask + 1 < capacity)
+        m_mask = m_mask * 2 + 1;
+
+    m_cells = new Cell[m_mask + 1];
+    for (Uint32 i = 0; i <= m_mask; ++i)
+        m_cells[i].sequence.store(static_cast<Int32>(i));
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+MpmcQueue<T>::~MpmcQueue()
+{
+    delete[] m_cells;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+bool MpmcQueue<T>::push(const T& value)
+{
+    // Positions wrap around, so they are compared through their difference
+    Int32 position = m_pushPosition.load();
+    Cell* cell;
+    for (;;)
+    {
+        cell = &m_cells[static_cast<Uint32>(position) & m_mask];
+        Int32 difference = static_cast<Int32>(static_cast<Uint32>(cell->sequence.load()) - static_cast<Uint32>(position));
+        if (difference == 0)
+        {
+            // The cell is free: claim the position (on failure, position receives the new one)
+            if (m_pushPosition.compareExchange(position, static_cast<Int32>(static_cast<Uint32>(position) + 1)))
+                break;
+        }
+        else if (difference < 0)
+        {
+            // The cell still holds the element of the previous round: the queue is full
+            return false;
+        }
+        else
+        {
+            // Another producer took this position
+            position = m_pushPosition.load();
+        }
+    }
+
+    cell->value = value;
+    cell->sequence.store(static_cast<Int32>(static_cast<Uint32>(position) + 1));
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+bool MpmcQueue<T>::pop(T& value)
+{
+    Int32 position = m_popPosition.load();
+    Cell* cell;
+    for (;;)
+    {
+        cell = &m_cells[static_cast<Uint32>(position) & m_mask];
+        Int32 difference = static_cast<Int32>(static_cast<Uint32>(cell->sequence.load()) - (static_cast<Uint32>(position) + 1));
+        if (difference == 0)
+        {
+            // The cell is filled: claim the position
+            if (m_popPosition.compareExchange(position, static_cast<Int32>(static_cast<Uint32>(position) + 1)))
+                break;
+        }
+        else if (difference < 0)
+        {
+            // The cell hasn't been filled yet: the queue is empty
+            return false;
+        }
+        else
+        {
+            // Another consumer took this position
+            position = m_popPosition.load();
+        }
+    }
+
+    // Free the cell for the next round
+    value = cell->value;
+    cell->sequence.store(static_cast<Int32>(static_cast<Uint32>(position) + m_mask + 1));
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t MpmcQueue<T>::getCapacity() const
+{
+    return m_mask + 1;
+}
@@ -48,11 +48,23 @@ class SFML_SYSTEM_API Mutex : NonCopyable
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Kinds of mutexes
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Type
+    {
+        Recursive, ///< Can be locked several times by the same thread
+        Fast       ///< Can't be locked again by the thread which holds it; briefly spins before sleeping when contended
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
+    /// \param type Kind of mutex
+    ///
     ////////////////////////////////////////////////////////////
-    Mutex();
+    explicit Mutex(Type type = Recursive);
 
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
@@ -143,6 +155,13 @@ private:
 /// However, you must call unlock() exactly as many times as you
 /// called lock(). If you don't, the mutex won't be released.
 ///
+/// Mutexes created with the sf::Mutex::Fast type are not
+/// recursive: locking one again in the thread that holds it
+/// is a deadlock. In exchange, they are cheaper to lock, and
+/// spin for a short while before putting the thread to sleep,
+/// which is faster for the short critical sections typically
+/// protected in games.
+///
 /// \see sf::Lock
 ///
 ////////////////////////////////////////////////////////////
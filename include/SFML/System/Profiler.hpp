@@ -0,0 +1,273 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PROFILER_HPP
+#define SFML_PROFILER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <string>
+#include <vector>
+
+
+////////////////////////////////////////////////////////////
+// Instrumentation macros, which expand to nothing unless
+// SFML_ENABLE_PROFILER is defined
+////////////////////////////////////////////////////////////
+#ifdef SFML_ENABLE_PROFILER
+
+    #define SFML_PROFILER_CONCAT_IMPL(a, b) a##b
+    #define SFML_PROFILER_CONCAT(a, b)      SFML_PROFILER_CONCAT_IMPL(a, b)
+
+    #define SFML_PROFILE_SCOPE(name) sf::Profiler::Scope SFML_PROFILER_CONCAT(sfProfilerScope, __LINE__)(name)
+    #define SFML_PROFILE_FRAME()     sf::Profiler::endFrame()
+
+#else
+
+    #define SFML_PROFILE_SCOPE(name)
+    #define SFML_PROFILE_FRAME()
+
+#endif
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Records timed zones of code, frame by frame
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API Profiler
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Track of the zones measured on the GPU
+    ///
+    ////////////////////////////////////////////////////////////
+    enum
+    {
+        GpuThread = 0 ///< Value of Zone::thread for GPU zones
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Completed zone
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Zone
+    {
+        const char*  name;     ///< Name of the zone
+        Int64        start;    ///< Start of the zone, in nanoseconds (see getTime)
+        Int64        duration; ///< Duration of the zone, in nanoseconds
+        unsigned int thread;   ///< Index of the thread which ran the zone (GpuThread for GPU zones)
+        unsigned int depth;    ///< Number of zones which enclose this one on its thread
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Zone which lasts as long as the object lives
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_SYSTEM_API Scope : NonCopyable
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Begin a zone
+        ///
+        /// \param name Name of the zone, which must stay valid as
+        ///             long as the profiler keeps it (use a literal)
+        ///
+        ////////////////////////////////////////////////////////////
+        explicit Scope(const char* name);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief End the zone
+        ///
+        ////////////////////////////////////////////////////////////
+        ~Scope();
+
+    private:
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        bool m_recording; ///< Was the profiler enabled when the zone began?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the recording of zones
+    ///
+    /// Recording is enabled by default.
+    ///
+    /// \param enabled True to record zones, false to ignore them
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether zones are recorded
+    ///
+    /// \return True if zones are recorded
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isEnabled();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current time of the profiler's clock
+    ///
+    /// \return Current time, in nanoseconds
+    ///
+    ////////////////////////////////////////////////////////////
+    static Int64 getTime();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Begin a zone on the calling thread
+    ///
+    /// Each call must be matched by a call to endZone on the
+    /// same thread; sf::Profiler::Scope does it automatically.
+    ///
+    /// \param name Name of the zone, which must stay valid as
+    ///             long as the profiler keeps it (use a literal)
+    ///
+    ////////////////////////////////////////////////////////////
+    static void beginZone(const char* name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief End the last zone begun on the calling thread
+    ///
+    ////////////////////////////////////////////////////////////
+    static void endZone();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a zone measured by other means
+    ///
+    /// This is how the graphics module submits the GPU zones,
+    /// once their timer queries are available.
+    ///
+    /// \param zone Zone to add
+    ///
+    ////////////////////////////////////////////////////////////
+    static void addZone(const Zone& zone);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Close the current frame
+    ///
+    /// The zones completed since the previous call become the
+    /// last frame, preceded by a zone named "Frame" that covers
+    /// the whole frame. sf::Window::display calls this function
+    /// when SFML is built with the profiler.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void endFrame();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the zones of the last frame
+    ///
+    /// This is meant for drawing a profiler overlay. GPU zones
+    /// appear a few frames late, when their results arrive.
+    ///
+    /// \param zones Vector to fill with the zones of the last frame
+    ///
+    ////////////////////////////////////////////////////////////
+    static void getLastFrame(std::vector<Zone>& zones);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the number of zones kept for the trace
+    ///
+    /// When the history is full, the oldest zones are dropped.
+    /// The default size is 1048576 zones.
+    ///
+    /// \param size Maximum number of zones to keep
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setHistorySize(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget all the recorded zones
+    ///
+    ////////////////////////////////////////////////////////////
+    static void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the recorded zones as a Chrome trace
+    ///
+    /// The file uses the JSON trace event format, which can be
+    /// opened with chrome://tracing, Perfetto or Speedscope.
+    ///
+    /// \param filename Path of the file to write
+    ///
+    /// \return True if the file was written successfully
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool saveChromeTrace(const std::string& filename);
+};
+
+} // namespace sf
+
+
+#endif // SFML_PROFILER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Profiler
+/// \ingroup system
+///
+/// sf::Profiler measures named zones of code on every thread,
+/// with a clock cheap enough to be left around hot paths.
+/// When SFML is built with the SFML_ENABLE_PROFILER option,
+/// the library measures its own expensive functions (text
+/// layout, glyph rasterization, drawing, display...) and
+/// times its draw calls on the GPU with timer queries.
+///
+/// Zones are usually declared with the SFML_PROFILE_SCOPE
+/// macro, which expands to nothing unless SFML_ENABLE_PROFILER
+/// is defined, so that release builds don't pay anything:
+/// \code
+/// void World::update(sf::Time elapsed)
+/// {
+///     SFML_PROFILE_SCOPE("World::update");
+///     ...
+/// }
+/// \endcode
+///
+/// Zones are grouped by frame: sf::Window::display closes
+/// the current frame, or SFML_PROFILE_FRAME() if you don't
+/// use an SFML window. The zones of the last frame can be
+/// drawn as an overlay, and the history can be saved for
+/// chrome://tracing:
+/// \code
+/// std::vector<sf::Profiler::Zone> zones;
+/// sf::Profiler::getLastFrame(zones);
+/// for (std::size_t i = 0; i < zones.size(); ++i)
+///     drawBar(zones[i].name, zones[i].start - zones[0].start, zones[i].duration, zones[i].depth);
+///
+/// sf::Profiler::saveChromeTrace("trace.json");
+/// \endcode
+///
+/// Zone names are not copied: they must be string literals,
+/// or strings that outlive the profiler.
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,208 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef SFML_RESOURCEMEMORY_HPP
+#define SFML_RESOURCEMEMORY_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <ostream>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Accounting of the memory used by the SFML resources
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API ResourceMemory
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Kinds of resources that are accounted
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Category
+    {
+        Textures,       ///< sf::Texture, except the ones below
+        RenderTextures, ///< Textures and attachments of sf::RenderTexture
+        Fonts,          ///< Glyph pages of sf::Font
+        Shaders,        ///< Programs of sf::Shader
+        SoundBuffers,   ///< Samples and OpenAL buffers of sf::SoundBuffer
+
+        CategoryCount   ///< Keep last -- the total number of categories
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Memory used by a category of resources
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_SYSTEM_API Usage
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        ////////////////////////////////////////////////////////////
+        Usage();
+
+        Uint64 objects;         ///< Number of live resources
+        Uint64 deviceBytes;     ///< Bytes allocated by the driver (video memory, OpenAL buffers)
+        Uint64 hostBytes;       ///< Bytes allocated in system memory
+        Uint64 peakDeviceBytes; ///< Highest value of deviceBytes since the last reset
+        Uint64 peakHostBytes;   ///< Highest value of hostBytes since the last reset
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the memory currently used by a category
+    ///
+    /// \param category Category of resources
+    ///
+    /// \return Memory used by the live resources of the category
+    ///
+    ////////////////////////////////////////////////////////////
+    static Usage getUsage(Category category);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the memory currently used by all the categories
+    ///
+    /// The peaks of the total are tracked on their own: they
+    /// are the highest amount of memory used at once, not the
+    /// sum of the peaks of the categories.
+    ///
+    /// \return Memory used by all the live resources
+    ///
+    ////////////////////////////////////////////////////////////
+    static Usage getTotalUsage();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the peaks to the current usage
+    ///
+    /// Call it at the beginning of a level, for example, to
+    /// measure the highest usage of this level only.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void resetPeaks();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the memory budget of a category
+    ///
+    /// The budget applies to the device and host bytes
+    /// together. A warning is written to sf::err() each time
+    /// the usage of the category goes above it; allocations
+    /// are never refused.
+    ///
+    /// \param category Category of resources
+    /// \param bytes    Budget in bytes, 0 to disable it (the default)
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setBudget(Category category, Uint64 bytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the memory budget of a category
+    ///
+    /// \param category Category of resources
+    ///
+    /// \return Budget in bytes, 0 if there's none
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getBudget(Category category);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a category uses more than its budget
+    ///
+    /// \param category Category of resources
+    ///
+    /// \return True if the category has a budget and is above it
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isOverBudget(Category category);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write a table of the usage of every category
+    ///
+    /// \param stream Stream to write to
+    ///
+    ////////////////////////////////////////////////////////////
+    static void dump(std::ostream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the name of a category
+    ///
+    /// \param category Category of resources
+    ///
+    /// \return Name of the category, like "Textures"
+    ///
+    ////////////////////////////////////////////////////////////
+    static const char* getName(Category category);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a change of the memory used by a category
+    ///
+    /// This function is called by the SFML resources; it is
+    /// public so that custom resources can be accounted too.
+    ///
+    /// \param category    Category of the resource
+    /// \param objects     Change of the number of resources
+    /// \param deviceBytes Change of the bytes allocated by the driver
+    /// \param hostBytes   Change of the bytes allocated in system memory
+    ///
+    ////////////////////////////////////////////////////////////
+    static void record(Category category, Int64 objects, Int64 deviceBytes, Int64 hostBytes);
+};
+
+} // namespace sf
+
+
+#endif // SFML_RESOURCEMEMORY_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ResourceMemory
+/// \ingroup system
+///
+/// sf::ResourceMemory keeps count of the memory used by the
+/// live SFML resources, grouped by category: how many of them
+/// exist, how many bytes they use in video memory (or in the
+/// audio driver) and in system memory, and the highest values
+/// reached since the start or since the last call to resetPeaks().
+///
+/// The sizes are the ones actually allocated: a texture
+/// padded to a power of two counts its padded size and its
+/// mipmaps. The driver may allocate a bit more than that,
+/// which can't be queried portably.
+///
+/// Usage example:
+/// \code
+/// sf::ResourceMemory::setBudget(sf::ResourceMemory::Textures, 512 * 1024 * 1024);
+///
+/// // At the end of the loading screen
+/// sf::ResourceMemory::dump(std::cout);
+///
+/// sf::ResourceMemory::Usage usage = sf::ResourceMemory::getTotalUsage();
+/// std::cout << "Peak video memory: " << usage.peakDeviceBytes / 1024 << " KB" << std::endl;
+/// \endcode
+///
+////////////////////////////////////////////////////////////
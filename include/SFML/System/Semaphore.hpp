@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SEMAPHORE_HPP
+#define SFML_SEMAPHORE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+    class SemaphoreImpl;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Counter that threads can wait on until it is positive
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API Semaphore : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param count Initial count of the semaphore
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit Semaphore(unsigned int count = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~Semaphore();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Increment the count
+    ///
+    /// If threads are waiting, one of them is woken up.
+    ///
+    ////////////////////////////////////////////////////////////
+    void post();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the count is positive, then decrement it
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the count is positive, with a timeout
+    ///
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return True if the count was decremented, false if the timeout expired
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wait(Time timeout);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    priv::SemaphoreImpl* m_semaphoreImpl; ///< OS-specific implementation
+};
+
+} // namespace sf
+
+
+#endif // SFML_SEMAPHORE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Semaphore
+/// \ingroup system
+///
+/// A semaphore holds a count: post() increments it, and
+/// wait() blocks until it is positive, then decrements it.
+/// Unlike polling with sf::sleep, a waiting thread wakes up
+/// as soon as the semaphore is posted, and uses no CPU
+/// meanwhile.
+///
+/// A typical use is to count the items of a queue shared by
+/// producer and consumer threads:
+/// \code
+/// sf::Mutex mutex;
+/// sf::Semaphore available;
+/// std::deque<Job> jobs;
+///
+/// void produce(const Job& job)
+/// {
+///     {
+///         sf::Lock lock(mutex);
+///         jobs.push_back(job);
+///     }
+///     available.post();
+/// }
+///
+/// void consume()
+/// {
+///     available.wait();
+///     sf::Lock lock(mutex);
+///     Job job = jobs.front();
+///     jobs.pop_front();
+///     ...
+/// }
+/// \endcode
+///
+/// \see sf::ConditionVariable, sf::Mutex
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SHAREDMUTEX_HPP
+#define SFML_SHAREDMUTEX_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/ConditionVariable.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Mutex that can be held by several readers at once
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API SharedMutex : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    SharedMutex();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Lock the mutex for writing
+    ///
+    /// Blocks until no other thread holds the mutex, for
+    /// reading or writing.
+    ///
+    /// \see unlock
+    ///
+    ////////////////////////////////////////////////////////////
+    void lock();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unlock the mutex locked for writing
+    ///
+    /// \see lock
+    ///
+    ////////////////////////////////////////////////////////////
+    void unlock();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Lock the mutex for reading
+    ///
+    /// Blocks while a thread holds the mutex for writing, or
+    /// waits to do so.
+    ///
+    /// \see unlockShared
+    ///
+    ////////////////////////////////////////////////////////////
+    void lockShared();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unlock the mutex locked for reading
+    ///
+    /// \see lockShared
+    ///
+    ////////////////////////////////////////////////////////////
+    void unlockShared();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Mutex             m_mutex;          ///< Mutex protecting the state
+    ConditionVariable m_readersAllowed; ///< Notified when readers may lock
+    ConditionVariable m_writerAllowed;  ///< Notified when a writer may lock
+    unsigned int      m_readers;        ///< Number of threads holding the mutex for reading
+    unsigned int      m_waitingWriters; ///< Number of threads waiting to lock for writing
+    bool              m_writing;        ///< Is a thread holding the mutex for writing?
+};
+
+} // namespace sf
+
+
+#endif // SFML_SHAREDMUTEX_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SharedMutex
+/// \ingroup system
+///
+/// sf::SharedMutex protects data which is read much more
+/// often than it is written: any number of threads can hold
+/// it for reading at the same time, while writing requires
+/// exclusive access. Writers have priority, so that a steady
+/// flow of readers can't keep them waiting forever.
+///
+/// Shared mutexes are not recursive.
+///
+/// Usage example:
+/// \code
+/// sf::SharedMutex mutex;
+/// std::map<std::string, sf::Texture*> textures;
+///
+/// sf::Texture* find(const std::string& name)
+/// {
+///     mutex.lockShared();
+///     std::map<std::string, sf::Texture*>::iterator it = textures.find(name);
+///     sf::Texture* texture = it != textures.end() ? it->second : NULL;
+///     mutex.unlockShared();
+///     return texture;
+/// }
+///
+/// void insert(const std::string& name, sf::Texture* texture)
+/// {
+///     mutex.lock();
+///     textures[name] = texture;
+///     mutex.unlock();
+/// }
+/// \endcode
+///
+/// \see sf::Mutex
+///
+////////////////////////////////////////////////////////////
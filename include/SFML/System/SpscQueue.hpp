@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SPSCQUEUE_HPP
+#define SFML_SPSCQUEUE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/AtomicInt.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Bounded lock-free queue for one producer thread
+///        and one consumer thread
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+class SpscQueue : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the queue
+    ///
+    /// The capacity is rounded up, to a power of two minus one.
+    ///
+    /// \param capacity Minimum number of elements the queue can hold
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit SpscQueue(std::size_t capacity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an element at the end of the queue
+    ///
+    /// Must only be called by the producer thread.
+    ///
+    /// \param value Element to add
+    ///
+    /// \return True if the element was added, false if the queue is full
+    ///
+    ////////////////////////////////////////////////////////////
+    bool push(const T& value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove the element at the front of the queue
+    ///
+    /// Must only be called by the consumer thread.
+    ///
+    /// \param value Receives the element
+    ///
+    /// \return True if an element was removed, false if the queue is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    bool pop(T& value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of elements in the queue
+    ///
+    /// \return Capacity of the queue
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCapacity() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<T> m_buffer;                         ///< Ring buffer, with one unused slot to tell full from empty
+    Uint32         m_mask;                           ///< Size of the buffer minus one (the size is a power of two)
+    char           m_padding1[64];                   ///< Keeps the indices on their own cache lines
+    AtomicInt      m_head;                           ///< Index of the next element to pop, written by the consumer
+    char           m_padding2[64 - sizeof(AtomicInt)];
+    AtomicInt      m_tail;                           ///< Index of the next slot to push into, written by the producer
+    char           m_padding3[64 - sizeof(AtomicInt)];
+};
+
+#include <SFML/System/SpscQueue.inl>
+
+} // namespace sf
+
+
+#endif // SFML_SPSCQUEUE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SpscQueue
+/// \ingroup system
+///
+/// sf::SpscQueue passes elements from one thread to another
+/// without any lock: push() and pop() never block, they just
+/// fail if the queue is full or empty. The capacity is fixed
+/// at construction, so no memory is allocated afterwards,
+/// which makes it suitable for real-time threads like audio
+/// callbacks.
+///
+/// Exactly one thread may push and exactly one thread may
+/// pop. For several producers or consumers, use sf::MpmcQueue.
+///
+/// Usage example:
+/// \code
+/// sf::SpscQueue<sf::Int16> samples(44100);
+///
+/// // Producer thread
+/// while (!samples.push(nextSample()))
+///     sf::sleep(sf::milliseconds(1));
+///
+/// // Consumer thread
+/// sf::Int16 sample;
+/// while (samples.pop(sample))
+///     play(sample);
+/// \endcode
+///
+/// \see sf::MpmcQueue
+///
+////////////////////////////////////////////////////////////
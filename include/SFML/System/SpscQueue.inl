@@ -0,0 +1,73 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+template <typename T>
+SpscQueue<T>::SpscQueue(std::size_t capacity) :
+m_mask(1)
+{
+    while (m_mask < capacity)
+        m_mask = m_mask * 2 + 1;
+
+    m_buffer.resize(m_mask + 1);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+bool SpscQueue<T>::push(const T& value)
+{
+    Uint32 tail = static_cast<Uint32>(m_tail.load());
+    Uint32 next = (tail + 1) & m_mask;
+    if (next == static_cast<Uint32>(m_head.load()))
+        return false;
+
+    // Publish the index only once the element is written
+    m_buffer[tail] = value;
+    m_tail.store(static_cast<Int32>(next));
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+bool SpscQueue<T>::pop(T& value)
+{
+    Uint32 head = static_cast<Uint32>(m_head.load());
+    if (head == static_cast<Uint32>(m_tail.load()))
+        return false;
+
+    // Release the slot only once the element is read
+    value = m_buffer[head];
+    m_head.store(static_cast<Int32>((head + 1) & m_mask));
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+std::size_t SpscQueue<T>::getCapacity() const
+{
+    return m_mask;
+}
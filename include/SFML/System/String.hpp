@@ -170,6 +170,22 @@ public:
     template <typename T>
     static String fromUtf8(T begin, T end);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a new sf::String from a contiguous UTF-8 encoded string
+    ///
+    /// This overload gives the same result as the generic one,
+    /// but converts runs of ASCII characters in blocks.
+    ///
+    /// \param begin Pointer to the beginning of the UTF-8 sequence
+    /// \param end   Pointer to the end of the UTF-8 sequence
+    ///
+    /// \return A sf::String containing the source string
+    ///
+    /// \see fromUtf16, fromUtf32
+    ///
+    ////////////////////////////////////////////////////////////
+    static String fromUtf8(const char* begin, const char* end);
+
     ////////////////////////////////////////////////////////////
     /// \brief Create a new sf::String from a UTF-16 encoded string
     ///
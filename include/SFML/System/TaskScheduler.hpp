@@ -0,0 +1,361 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TASKSCHEDULER_HPP
+#define SFML_TASKSCHEDULER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Export.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Thread.hpp>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Pool of worker threads running small tasks
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API TaskScheduler : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Identifier of a task
+    ///
+    /// Identifiers are never reused; 0 is never a valid identifier.
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef Uint64 TaskId;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the scheduler and start its workers
+    ///
+    /// \param workerCount Number of worker threads, 0 to use one per core
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit TaskScheduler(unsigned int workerCount = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Waits for all the tasks to finish, then stops the workers.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~TaskScheduler();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a task calling a functor with no argument
+    ///
+    /// This function returns immediately; the task is run by
+    /// one of the workers. Tasks added from a task go to the
+    /// queue of the worker running it, the others are spread
+    /// over the workers; idle workers steal tasks from the
+    /// queues of busy ones.
+    ///
+    /// \param function Functor or free function to call
+    ///
+    /// \return Identifier of the task
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F>
+    TaskId add(F function);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a task calling a functor with one argument
+    ///
+    /// \param function Functor or free function to call
+    /// \param argument Argument passed to the function (copied)
+    ///
+    /// \return Identifier of the task
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F, typename A>
+    TaskId add(F function, A argument);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a task calling a member function
+    ///
+    /// \param function Member function to call
+    /// \param object   Object to call the function on
+    ///
+    /// \return Identifier of the task
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename C>
+    TaskId add(void(C::*function)(), C* object);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a task to run once another one is finished
+    ///
+    /// If \a dependency is already finished, the task is
+    /// scheduled immediately. Use join() to depend on several
+    /// tasks.
+    ///
+    /// \param dependency Task to wait for
+    /// \param function   Functor or free function to call
+    ///
+    /// \return Identifier of the task
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F>
+    TaskId addAfter(TaskId dependency, F function);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a task with one argument to run once another one is finished
+    ///
+    /// \param dependency Task to wait for
+    /// \param function   Functor or free function to call
+    /// \param argument   Argument passed to the function (copied)
+    ///
+    /// \return Identifier of the task
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F, typename A>
+    TaskId addAfter(TaskId dependency, F function, A argument);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a member function task to run once another one is finished
+    ///
+    /// \param dependency Task to wait for
+    /// \param function   Member function to call
+    /// \param object     Object to call the function on
+    ///
+    /// \return Identifier of the task
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename C>
+    TaskId addAfter(TaskId dependency, void(C::*function)(), C* object);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a task which finishes when all the given ones are finished
+    ///
+    /// \param tasks Tasks to wait for
+    ///
+    /// \return Identifier of the joining task
+    ///
+    ////////////////////////////////////////////////////////////
+    TaskId join(const std::vector<TaskId>& tasks);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Call a function for every index of a range, in parallel
+    ///
+    /// The range is split into chunks of \a grain indices, which
+    /// are run as tasks. This function returns when all of them
+    /// are finished; the calling thread runs tasks meanwhile, so
+    /// it can be called from a task.
+    ///
+    /// \param begin    First index of the range
+    /// \param end      Index past the last one of the range
+    /// \param function Functor or free function called with each index
+    /// \param grain    Number of indices per task, 0 to choose one from the number of workers
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename F>
+    void parallelFor(std::size_t begin, std::size_t end, F function, std::size_t grain = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a task is finished
+    ///
+    /// \param task Task to check
+    ///
+    /// \return True if the task has run
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isFinished(TaskId task) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until a task is finished
+    ///
+    /// The calling thread runs other tasks while it waits, so
+    /// this function can be called from a task.
+    ///
+    /// \param task Task to wait for
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait(TaskId task);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until all the tasks are finished
+    ///
+    /// This function must not be called from a task, which
+    /// would wait for itself.
+    ///
+    ////////////////////////////////////////////////////////////
+    void waitAll();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of worker threads
+    ///
+    /// \return Number of workers
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getWorkerCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of processor cores of the system
+    ///
+    /// \return Number of cores
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getCoreCount();
+
+private:
+
+    struct Task;
+    struct Worker;
+    struct Sleeper;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a task
+    ///
+    /// \param function   Function of the task (owned by the task)
+    /// \param dependency Task to wait for, 0 for none
+    ///
+    /// \return Identifier of the task
+    ///
+    ////////////////////////////////////////////////////////////
+    TaskId push(priv::ThreadFunc* function, TaskId dependency);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Put a task whose dependencies are finished in a queue
+    ///
+    /// Must be called with m_mutex locked.
+    ///
+    /// \param task Task to schedule
+    ///
+    ////////////////////////////////////////////////////////////
+    void schedule(Task* task);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take a task from the queue of a worker, or steal one
+    ///
+    /// \param worker Worker of the calling thread, NULL if it isn't a worker
+    ///
+    /// \return Task to run, NULL if all the queues are empty
+    ///
+    ////////////////////////////////////////////////////////////
+    Task* take(Worker* worker);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run a task and schedule its continuations
+    ///
+    /// \param task Task to run
+    ///
+    ////////////////////////////////////////////////////////////
+    void run(Task* task);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the worker of the calling thread
+    ///
+    /// \return Worker, NULL if the calling thread isn't a worker of this scheduler
+    ///
+    ////////////////////////////////////////////////////////////
+    Worker* getCurrentWorker() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function of the worker threads
+    ///
+    /// \param worker Worker of the thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void work(Worker* worker);
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::map<TaskId, Task*> TaskTable; ///< Unfinished tasks, by identifier
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Worker*>  m_workers;   ///< Workers, each with its thread and queue
+    TaskTable             m_tasks;     ///< Unfinished tasks
+    std::vector<Sleeper*> m_sleepers;  ///< Threads waiting for a task to be scheduled
+    TaskId                m_nextId;    ///< Identifier of the next task
+    unsigned int          m_nextQueue; ///< Queue receiving the next task added from outside the workers
+    bool                  m_stopping;  ///< Are the workers stopping?
+    mutable Mutex         m_mutex;     ///< Mutex protecting the tasks and the sleepers
+};
+
+#include <SFML/System/TaskScheduler.inl>
+
+} // namespace sf
+
+
+#endif // SFML_TASKSCHEDULER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TaskScheduler
+/// \ingroup system
+///
+/// sf::TaskScheduler runs many small tasks on a fixed set of
+/// worker threads, typically one per core, instead of creating
+/// an sf::Thread for each job. Each worker has its own queue;
+/// workers with nothing to do steal tasks from the others,
+/// which keeps all the cores busy with little contention.
+///
+/// Tasks are functions, like the entry points of sf::Thread:
+/// functors, free functions with zero or one argument, or
+/// member functions. A task can be made to wait for another
+/// one with addAfter(), and join() gives a task to wait for
+/// several at once. parallelFor() splits a loop into tasks.
+///
+/// A task should not block on anything else than the
+/// scheduler itself (wait(), waitAll(), parallelFor()),
+/// which lets the waiting thread run other tasks.
+///
+/// Usage example:
+/// \code
+/// void loadLevel(int level) { ... }
+/// void startLevel() { ... }
+///
+/// sf::TaskScheduler scheduler;
+///
+/// // Load the level in the background, then start it
+/// sf::TaskScheduler::TaskId loading = scheduler.add(&loadLevel, 2);
+/// scheduler.addAfter(loading, &startLevel);
+///
+/// // Update all the particles in parallel
+/// struct UpdateParticle
+/// {
+///     void operator ()(std::size_t index) const {particles[index].update(dt);}
+///     std::vector<Particle>& particles;
+///     float dt;
+/// };
+/// UpdateParticle update = {particles, dt};
+/// scheduler.parallelFor(0, particles.size(), update);
+/// \endcode
+///
+/// \see sf::Thread
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+namespace priv
+{
+// Task running a functor on a chunk of a range of indices
+template <typename F>
+struct ParallelForChunk : ThreadFunc
+{
+    ParallelForChunk(F function, std::size_t begin, std::size_t end) : m_function(function), m_begin(begin), m_end(end) {}
+    virtual void run() {for (std::size_t i = m_begin; i < m_end; ++i) m_function(i);}
+    F m_function;
+    std::size_t m_begin;
+    std::size_t m_end;
+};
+
+} // namespace priv
+
+
+////////////////////////////////////////////////////////////
+template <typename F>
+TaskScheduler::TaskId TaskScheduler::add(F function)
+{
+    return push(new priv::ThreadFunctor<F>(function), 0);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename F, typename A>
+TaskScheduler::TaskId TaskScheduler::add(F function, A argument)
+{
+    return push(new priv::ThreadFunctorWithArg<F, A>(function, argument), 0);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename C>
+TaskScheduler::TaskId TaskScheduler::add(void(C::*function)(), C* object)
+{
+    return push(new priv::ThreadMemberFunc<C>(function, object), 0);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename F>
+TaskScheduler::TaskId TaskScheduler::addAfter(TaskId dependency, F function)
+{
+    return push(new priv::ThreadFunctor<F>(function), dependency);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename F, typename A>
+TaskScheduler::TaskId TaskScheduler::addAfter(TaskId dependency, F function, A argument)
+{
+    return push(new priv::ThreadFunctorWithArg<F, A>(function, argument), dependency);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename C>
+TaskScheduler::TaskId TaskScheduler::addAfter(TaskId dependency, void(C::*function)(), C* object)
+{
+    return push(new priv::ThreadMemberFunc<C>(function, object), dependency);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename F>
+void TaskScheduler::parallelFor(std::size_t begin, std::size_t end, F function, std::size_t grain)
+{
+    if (end <= begin)
+        return;
+
+    // By default, make a few chunks per worker so that stealing can balance uneven chunks
+    if (grain == 0)
+    {
+        grain = (end - begin) / (getWorkerCount() * 4);
+        if (grain == 0)
+            grain = 1;
+    }
+
+    std::vector<TaskId> chunks;
+    for (std::size_t first = begin; first < end; first += grain)
+    {
+        std::size_t last = end - first > grain ? first + grain : end;
+        chunks.push_back(push(new priv::ParallelForChunk<F>(function, first, last), 0));
+        if (last == end)
+            break;
+    }
+
+    for (std::vector<TaskId>::const_iterator it = chunks.begin(); it != chunks.end(); ++it)
+        wait(*it);
+}
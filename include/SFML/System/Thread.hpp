@@ -28,9 +28,11 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
 #include <SFML/System/Export.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <cstdlib>
+#include <string>
 
 
 namespace sf
@@ -49,6 +51,18 @@ class SFML_SYSTEM_API Thread : NonCopyable
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Scheduling priorities of threads
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Priority
+    {
+        Low,     ///< Background work which can wait
+        Normal,  ///< Default priority of the operating system
+        High,    ///< Work which must not be delayed by normal threads
+        RealTime ///< Short, periodic, latency-critical work such as audio (preempts all the normal threads)
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Construct the thread from a functor with no argument
     ///
@@ -171,6 +185,113 @@ public:
     ////////////////////////////////////////////////////////////
     void terminate();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the scheduling priority of the thread
+    ///
+    /// The priority is applied when the thread is launched.
+    /// It is mapped to the closest level of the operating
+    /// system: RealTime uses the SCHED_FIFO policy on Unix
+    /// systems, and the time-critical priority plus the
+    /// "Pro Audio" task of the multimedia class scheduler on
+    /// Windows. Raising the priority may require privileges
+    /// (on Linux, CAP_SYS_NICE or an RLIMIT_RTPRIO limit); when
+    /// it is denied, the thread falls back to the highest
+    /// priority allowed.
+    ///
+    /// Real-time threads must block regularly, otherwise they
+    /// can freeze the whole system. The default priority is
+    /// Normal.
+    ///
+    /// \param priority Scheduling priority
+    ///
+    /// \see getPriority
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPriority(Priority priority);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the scheduling priority of the thread
+    ///
+    /// \return Scheduling priority
+    ///
+    /// \see setPriority
+    ///
+    ////////////////////////////////////////////////////////////
+    Priority getPriority() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the processors the thread is allowed to run on
+    ///
+    /// Bit N of the mask allows the thread to run on the
+    /// processor N. The affinity is applied when the thread is
+    /// launched, on Windows, Linux and Android; macOS doesn't
+    /// support it. The default mask, 0, lets the system choose.
+    ///
+    /// \param mask Mask of the allowed processors, or 0 for all
+    ///
+    /// \see getAffinity
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAffinity(Uint64 mask);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the processors the thread is allowed to run on
+    ///
+    /// \return Mask of the allowed processors, or 0 for all
+    ///
+    /// \see setAffinity
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getAffinity() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the name of the thread
+    ///
+    /// The name is shown by debuggers and profilers. It is
+    /// applied when the thread is launched; some systems
+    /// truncate it (15 characters on Linux).
+    ///
+    /// \param name Name of the thread
+    ///
+    /// \see getName
+    ///
+    ////////////////////////////////////////////////////////////
+    void setName(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the name of the thread
+    ///
+    /// \return Name of the thread
+    ///
+    /// \see setName
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::string& getName() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the size of the stack of the thread
+    ///
+    /// The size applies to the next launch. It is rounded up
+    /// to the minimum allowed by the system. The default size,
+    /// 0, is the default of the system.
+    ///
+    /// \param size Size of the stack, in bytes, or 0 for the default
+    ///
+    /// \see getStackSize
+    ///
+    ////////////////////////////////////////////////////////////
+    void setStackSize(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the stack of the thread
+    ///
+    /// \return Size of the stack, in bytes, or 0 for the default
+    ///
+    /// \see setStackSize
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getStackSize() const;
+
 private:
 
     friend class priv::ThreadImpl;
@@ -188,6 +309,10 @@ private:
     ////////////////////////////////////////////////////////////
     priv::ThreadImpl* m_impl;       ///< OS-specific implementation of the thread
     priv::ThreadFunc* m_entryPoint; ///< Abstraction of the function to run
+    Priority          m_priority;   ///< Scheduling priority applied at launch
+    Uint64            m_affinity;   ///< Mask of the allowed processors (0 for all)
+    std::string       m_name;       ///< Name of the thread
+    std::size_t       m_stackSize;  ///< Size of the stack (0 for the default)
 };
 
 #include <SFML/System/Thread.inl>
@@ -277,6 +402,13 @@ private:
 /// from multiple threads at the same time. To prevent this
 /// kind of situations, you can use mutexes (see sf::Mutex).
 ///
+/// Before launching a thread, its scheduling priority, the
+/// processors it may run on, its name and the size of its
+/// stack can be changed (see setPriority, setAffinity, setName
+/// and setStackSize). SFML's own audio threads run with the
+/// RealTime priority, so that busy worker threads don't make
+/// the sound skip.
+///
 /// \see sf::Mutex
 ///
 ////////////////////////////////////////////////////////////
@@ -28,7 +28,7 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
-#include <SFML/Config.hpp>
+#include <SFML/System/Export.hpp>
 #include <algorithm>
 #include <locale>
 #include <string>
@@ -45,7 +45,7 @@ class Utf;
 ///
 ////////////////////////////////////////////////////////////
 template <>
-class Utf<8>
+class SFML_SYSTEM_API Utf<8>
 {
 public:
 
@@ -113,6 +113,36 @@ public:
     template <typename In>
     static std::size_t count(In begin, In end);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Count the number of characters of a contiguous UTF-8 sequence
+    ///
+    /// This overload gives the same result as the generic one,
+    /// but skips runs of ASCII characters 16 bytes at a time.
+    ///
+    /// \param begin Pointer to the beginning of the input sequence
+    /// \param end   Pointer to the end of the input sequence
+    ///
+    /// \return Number of characters in the sequence
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::size_t count(const char* begin, const char* end);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether a sequence is well-formed UTF-8
+    ///
+    /// The sequence is rejected if it contains truncated or
+    /// overlong sequences, surrogates, or codepoints beyond
+    /// U+10FFFF. Runs of ASCII characters are checked 16 bytes
+    /// at a time.
+    ///
+    /// \param begin Pointer to the beginning of the input sequence
+    /// \param end   Pointer to the end of the input sequence
+    ///
+    /// \return True if the sequence is valid UTF-8
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isValid(const char* begin, const char* end);
+
     ////////////////////////////////////////////////////////////
     /// \brief Convert an ANSI characters range to UTF-8
     ///
@@ -245,6 +275,22 @@ public:
     ////////////////////////////////////////////////////////////
     template <typename In, typename Out>
     static Out toUtf32(In begin, In end, Out output);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert a contiguous UTF-8 characters range to UTF-32
+    ///
+    /// This overload gives the same result as the generic one,
+    /// but converts runs of ASCII characters 16 bytes at a time.
+    /// The output buffer must be able to hold (end - begin) elements.
+    ///
+    /// \param begin  Pointer to the beginning of the input sequence
+    /// \param end    Pointer to the end of the input sequence
+    /// \param output Pointer to the beginning of the output sequence
+    ///
+    /// \return Pointer to the end of the output sequence which has been written
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint32* toUtf32(const char* begin, const char* end, Uint32* output);
 };
 
 ////////////////////////////////////////////////////////////
@@ -459,7 +505,7 @@ public:
 ///
 ////////////////////////////////////////////////////////////
 template <>
-class Utf<32>
+class SFML_SYSTEM_API Utf<32>
 {
 public:
 
@@ -630,6 +676,22 @@ public:
     template <typename In, typename Out>
     static Out toUtf8(In begin, In end, Out output);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert a contiguous UTF-32 characters range to UTF-8
+    ///
+    /// This overload gives the same result as the generic one,
+    /// but converts runs of ASCII characters 16 at a time.
+    /// The output buffer must be able to hold 4 * (end - begin) elements.
+    ///
+    /// \param begin  Pointer to the beginning of the input sequence
+    /// \param end    Pointer to the end of the input sequence
+    /// \param output Pointer to the beginning of the output sequence
+    ///
+    /// \return Pointer to the end of the output sequence which has been written
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint8* toUtf8(const Uint32* begin, const Uint32* end, Uint8* output);
+
     ////////////////////////////////////////////////////////////
     /// \brief Convert a UTF-32 characters range to UTF-16
     ///
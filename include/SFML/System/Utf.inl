@@ -55,6 +55,13 @@ In Utf<8>::decode(In begin, In end, Uint32& output, Uint32 replacement)
         0x00000000, 0x00003080, 0x000E2080, 0x03C82080, 0xFA082080, 0x82082080
     };
 
+    // ASCII characters decode to themselves
+    if (static_cast<Uint8>(*begin) < 0x80)
+    {
+        output = static_cast<Uint8>(*begin++);
+        return begin;
+    }
+
     // decode the character
     int trailingBytes = trailing[static_cast<Uint8>(*begin)];
     if (begin + trailingBytes < end)
@@ -92,6 +99,13 @@ Out Utf<8>::encode(Uint32 input, Out output, Uint8 replacement)
         0x00, 0x00, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC
     };
 
+    // ASCII characters encode to themselves
+    if (input < 0x80)
+    {
+        *output++ = static_cast<Uint8>(input);
+        return output;
+    }
+
     // encode the character
     if ((input > 0x0010FFFF) || ((input >= 0xD800) && (input <= 0xDBFF)))
     {
@@ -0,0 +1,163 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_UTF8VIEW_HPP
+#define SFML_UTF8VIEW_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/String.hpp>
+#include <cstddef>
+#include <string>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Non-owning reference to a UTF-8 encoded string
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API Utf8View
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty view.
+    ///
+    ////////////////////////////////////////////////////////////
+    Utf8View();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the view from a null-terminated string
+    ///
+    /// \param string UTF-8 string to refer to
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit Utf8View(const char* string);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the view from a sequence of bytes
+    ///
+    /// \param data Pointer to the UTF-8 bytes
+    /// \param size Number of bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    Utf8View(const char* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the view from a standard string
+    ///
+    /// \param string UTF-8 string to refer to
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit Utf8View(const std::string& string);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bytes of the string
+    ///
+    /// The bytes are not null-terminated.
+    ///
+    /// \return Pointer to the first byte
+    ///
+    ////////////////////////////////////////////////////////////
+    const char* getData() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the string, in bytes
+    ///
+    /// \return Number of bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of characters of the string
+    ///
+    /// This function has to decode the string.
+    ///
+    /// \return Number of characters (code points)
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getLength() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether the string is empty
+    ///
+    /// \return True if the string is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isEmpty() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode the string into a sf::String
+    ///
+    /// \return Decoded string
+    ///
+    ////////////////////////////////////////////////////////////
+    String toString() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const char* m_data; ///< First byte of the string
+    std::size_t m_size; ///< Number of bytes
+};
+
+} // namespace sf
+
+
+#endif // SFML_UTF8VIEW_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Utf8View
+/// \ingroup system
+///
+/// sf::String stores its characters as UTF-32, which takes
+/// 4 bytes per character and requires decoding UTF-8 input.
+/// sf::Utf8View simply refers to UTF-8 bytes owned by
+/// someone else, so that the functions accepting it can
+/// keep the text in its compact form, and decode it only
+/// when they need the characters.
+///
+/// The constructors taking a string are explicit, so that
+/// the intent is clear where a function also accepts a
+/// sf::String:
+/// \code
+/// std::string name = "Zoë";
+/// text.setString(sf::Utf8View(name)); // stores the 4 UTF-8 bytes
+/// text.setString(name);               // stores 3 UTF-32 characters, decoded with the locale
+/// \endcode
+///
+/// A view doesn't copy the string: it must not outlive it.
+///
+/// \see sf::String, sf::Utf8
+///
+////////////////////////////////////////////////////////////
@@ -32,6 +32,7 @@
 #include <SFML/Window/GlResource.hpp>
 #include <SFML/Window/ContextSettings.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
 
 
 namespace sf
@@ -51,6 +52,19 @@ class SFML_WINDOW_API Context : GlResource, NonCopyable
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Counters of the context creations
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Statistics
+    {
+        Time         globalInitTime;        ///< Time taken by the global initialization (creation of the hidden shared context)
+        Time         creationTime;          ///< Total time spent creating contexts, including the internal ones
+        unsigned int contextCount;          ///< Number of contexts created, including the internal ones
+        unsigned int internalContextCount;  ///< Number of internal contexts created, for threads without an active context
+        unsigned int internalContextReuses; ///< Number of times an idle internal context was reused instead of creating a new one
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -88,6 +102,73 @@ public:
     ////////////////////////////////////////////////////////////
     static GlFunctionPointer getFunction(const char* name);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the identifier of the context active on the calling thread
+    ///
+    /// Every context (including the windows' contexts and the
+    /// internal ones created by SFML) gets a unique identifier
+    /// when it is created; identifiers are never reused. This
+    /// allows to track OpenGL states on the CPU side and to
+    /// notice when they become invalid because another context
+    /// was activated.
+    ///
+    /// \return Identifier of the active context, or 0 if no context is active
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getActiveContextId();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the generation of the OpenGL contexts
+    ///
+    /// On mobile systems, the driver may destroy all the contexts
+    /// while the application is in the background (EGL reports
+    /// it as EGL_CONTEXT_LOST). SFML then recreates its contexts
+    /// and starts a new generation: the OpenGL objects created in
+    /// the previous generations don't exist anymore. The SFML
+    /// resources recreate theirs when they are used again (see
+    /// Texture::setRestorable); applications that manage their
+    /// own OpenGL objects can compare the generation with the
+    /// one they were created in.
+    ///
+    /// \return Generation of the contexts, 0 until the first loss
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint32 getGeneration();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the internal context of the calling thread
+    ///
+    /// OpenGL calls need an active context: a thread which uses
+    /// graphics resources (like loading a texture) without having
+    /// activated a context of its own gets an internal context
+    /// from SFML. Internal contexts are kept for reuse: when a
+    /// thread activates another context, its internal context is
+    /// given back to SFML, and the next thread which needs one
+    /// reuses it instead of creating a new one.
+    ///
+    /// Call this function at the end of a worker thread which may
+    /// have used an internal context, so that it is deactivated and
+    /// given back as well. Otherwise, it stays assigned to the thread
+    /// until the last graphics resource is destroyed.
+    ///
+    /// Calling this function when the thread has no internal
+    /// context does nothing.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void releaseThreadContext();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the counters of the context creations
+    ///
+    /// Creating a context can take a long time with some drivers:
+    /// these counters show how much of the startup of an application
+    /// is spent in it, and how often threads reuse internal contexts.
+    ///
+    /// \return Counters since the start of the program
+    ///
+    ////////////////////////////////////////////////////////////
+    static Statistics getStatistics();
+
     ////////////////////////////////////////////////////////////
     /// \brief Construct a in-memory context
     ///
@@ -101,6 +182,27 @@ public:
     ////////////////////////////////////////////////////////////
     Context(const ContextSettings& settings, unsigned int width, unsigned int height);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Use the back buffer of an in-memory context as
+    ///        the image of the bound texture
+    ///
+    /// This function is for internal use, you don't need
+    /// to bother with it.
+    ///
+    /// \return True if the back buffer is now the image of the texture bound to GL_TEXTURE_2D
+    ///
+    ////////////////////////////////////////////////////////////
+    bool bindTexImage();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the back buffer bound by bindTexImage
+    ///
+    /// This function is for internal use, you don't need
+    /// to bother with it.
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseTexImage();
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -148,4 +250,12 @@ private:
 /// // by the sf::Context destructor
 /// \endcode
 ///
+/// On Linux, contexts can also be created without an X server
+/// (on a headless server for example): they are then created
+/// with EGL, rendering to offscreen surfaces. This happens
+/// automatically when the DISPLAY environment variable is not
+/// set, and can be forced by setting SFML_HEADLESS to 1.
+/// Only sf::Context and offscreen targets such as
+/// sf::RenderTexture can be used in this mode, not windows.
+///
 ////////////////////////////////////////////////////////////
@@ -117,9 +117,11 @@ struct ContextSettings
 /// a compatibility context is created. You only need to specify
 /// the core flag if you want a core profile context to use with
 /// your own OpenGL rendering.
-/// <b>Warning: The graphics module will not function if you
-/// request a core profile context. Make sure the attributes are
-/// set to Default if you want to use the graphics module.</b>
+/// When a core profile context is requested (OpenGL 3.2 or
+/// greater), the graphics module draws with built-in shaders
+/// instead of the fixed-function pipeline. Instanced drawing,
+/// sf::Quads in vertex buffers and shaders written for the
+/// compatibility profile are not available in this case.
 ///
 /// Setting the debug attribute flag will request a context with
 /// additional debugging features enabled. Depending on the
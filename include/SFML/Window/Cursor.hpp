@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_CURSOR_HPP
+#define SFML_CURSOR_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Window/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+    class CursorImpl;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Cursor image displayed by the operating system
+///
+////////////////////////////////////////////////////////////
+class SFML_WINDOW_API Cursor : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// This constructor doesn't actually create the cursor;
+    /// an empty cursor stands for the default cursor of the
+    /// system.
+    ///
+    ////////////////////////////////////////////////////////////
+    Cursor();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The cursor must not be destroyed while it is in use by
+    /// a window.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~Cursor();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a cursor from an array of pixels
+    ///
+    /// \a pixels must be an array of \a size.x by \a size.y
+    /// pixels in 32-bit RGBA format. The hotspot is the pixel
+    /// of the image which is located at the position of the
+    /// mouse, and must be inside the image.
+    ///
+    /// If the cursor was already loaded, the previous image is
+    /// destroyed.
+    ///
+    /// \param pixels  Array of pixels of the image
+    /// \param size    Width and height of the image
+    /// \param hotspot Position of the hotspot in the image
+    ///
+    /// \return True if the cursor was successfully created
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromPixels(const Uint8* pixels, Vector2u size, Vector2u hotspot);
+
+private:
+
+    friend class Window;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get access to the underlying implementation
+    ///
+    /// \return Reference to the underlying implementation
+    ///
+    ////////////////////////////////////////////////////////////
+    const priv::CursorImpl& getImpl() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    priv::CursorImpl* m_impl; ///< Platform-specific implementation of the cursor
+};
+
+} // namespace sf
+
+
+#endif // SFML_CURSOR_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Cursor
+/// \ingroup window
+///
+/// sf::Cursor defines the image of the mouse cursor of a
+/// window. Unlike a sprite drawn at the position of the
+/// mouse, the cursor is drawn by the operating system: it
+/// follows the mouse at the rate of the system, without
+/// waiting for the next frame of the application.
+///
+/// A cursor is applied to a window with
+/// sf::Window::setMouseCursor. It must stay alive as long as
+/// it is in use by the window.
+///
+/// Usage example:
+/// \code
+/// sf::Image image;
+/// if (!image.loadFromFile("cursor.png"))
+///     return -1;
+///
+/// sf::Cursor cursor;
+/// if (cursor.loadFromPixels(image.getPixelsPtr(), image.getSize(), sf::Vector2u(0, 0)))
+///     window.setMouseCursor(cursor);
+/// \endcode
+///
+/// Hardware cursors are supported on Linux, Windows and
+/// Mac OS X; on other platforms loadFromPixels fails.
+///
+/// \see sf::Window::setMouseCursor
+///
+////////////////////////////////////////////////////////////
@@ -33,6 +33,7 @@
 #include <SFML/Window/Keyboard.hpp>
 #include <SFML/Window/Mouse.hpp>
 #include <SFML/Window/Sensor.hpp>
+#include <SFML/System/Time.hpp>
 
 
 namespace sf
@@ -87,6 +88,16 @@ public:
         int y; ///< Y position of the mouse pointer, relative to the top of the owner window
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Raw mouse motion event parameters (MouseMovedRaw)
+    ///
+    ////////////////////////////////////////////////////////////
+    struct MouseMoveRawEvent
+    {
+        int deltaX; ///< Horizontal motion reported by the device, in device units
+        int deltaY; ///< Vertical motion reported by the device, in device units
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Mouse buttons events parameters
     ///        (MouseButtonPressed, MouseButtonReleased)
@@ -209,6 +220,7 @@ public:
         TouchMoved,             ///< A touch moved (data in event.touch)
         TouchEnded,             ///< A touch event ended (data in event.touch)
         SensorChanged,          ///< A sensor value changed (data in event.sensor)
+        MouseMovedRaw,          ///< The mouse device moved, see Window::setRawMouseInputEnabled (data in event.mouseMoveRaw)
 
         Count                   ///< Keep last -- the total number of event types
     };
@@ -216,7 +228,8 @@ public:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    EventType type; ///< Type of the event
+    EventType type;      ///< Type of the event
+    Time      timestamp; ///< Time at which the event occurred, on the time line of Window::getEventTime
 
     union
     {
@@ -224,6 +237,7 @@ public:
         KeyEvent              key;               ///< Key event parameters (Event::KeyPressed, Event::KeyReleased)
         TextEvent             text;              ///< Text event parameters (Event::TextEntered)
         MouseMoveEvent        mouseMove;         ///< Mouse move event parameters (Event::MouseMoved)
+        MouseMoveRawEvent     mouseMoveRaw;      ///< Raw mouse move event parameters (Event::MouseMovedRaw)
         MouseButtonEvent      mouseButton;       ///< Mouse button event parameters (Event::MouseButtonPressed, Event::MouseButtonReleased)
         MouseWheelEvent       mouseWheel;        ///< Mouse wheel event parameters (Event::MouseWheelMoved) (deprecated)
         MouseWheelScrollEvent mouseWheelScroll;  ///< Mouse wheel event parameters (Event::MouseWheelScrolled)
@@ -260,6 +274,21 @@ public:
 /// event.key member, all other members such as event.MouseMove
 /// or event.text will have undefined values.
 ///
+/// Every event also carries the time at which it occurred. When
+/// the system provides it (keyboard and mouse events on X11 and
+/// Windows, touch and mouse events on Android), it is the time of
+/// the original input, converted to the time line of
+/// sf::Window::getEventTime; otherwise, it is the time at which
+/// SFML received the event. Timestamps allow, for example, to
+/// interpolate input between frames, independently of when the
+/// events are polled.
+///
+/// Touch screens may sample the fingers faster than the display
+/// refreshes. On Android, every sampled position is delivered as
+/// its own TouchMoved event with its own timestamp, so that
+/// drawing or handwriting applications get the full precision of
+/// the digitizer, whatever their frame rate.
+///
 /// Usage example:
 /// \code
 /// sf::Event event;
@@ -0,0 +1,186 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_EVENTRECORDING_HPP
+#define SFML_EVENTRECORDING_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Window/Export.hpp>
+#include <SFML/Window/Event.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Sequence of window events, recorded to be replayed
+///
+////////////////////////////////////////////////////////////
+class SFML_WINDOW_API EventRecording
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Event of the recording
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        Event  event; ///< Recorded event, its timestamp is relative to the start of the recording
+        Uint64 frame; ///< Number of frames displayed since the start of the recording when the event was returned
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty recording.
+    ///
+    ////////////////////////////////////////////////////////////
+    EventRecording();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append an event to the recording
+    ///
+    /// Windows call this function while they record (see
+    /// Window::setEventRecording); it can also be used to
+    /// build recordings from scratch.
+    ///
+    /// \param event Event to append, its timestamp relative to the start of the recording
+    /// \param frame Index of the frame in which the event must be replayed
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(const Event& event, Uint64 frame);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the events
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of events in the recording
+    ///
+    /// \return Number of events
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getEventCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get an event of the recording
+    ///
+    /// \param index Index of the event, in range [0 .. getEventCount() - 1]
+    ///
+    /// \return Event and the frame it belongs to
+    ///
+    ////////////////////////////////////////////////////////////
+    const Entry& getEntry(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a recording from a file
+    ///
+    /// \param filename Path of the file to load
+    ///
+    /// \return True if loading succeeded
+    ///
+    /// \see saveToFile
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromFile(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the recording to a file
+    ///
+    /// The events are stored as they are in memory: the file
+    /// can only be loaded by a program built for the same
+    /// platform, which is what regression runs need.
+    ///
+    /// \param filename Path of the file to write
+    ///
+    /// \return True if saving succeeded
+    ///
+    /// \see loadFromFile
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveToFile(const std::string& filename) const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Entry> m_entries; ///< Events of the recording, in the order they were returned
+};
+
+} // namespace sf
+
+
+#endif // SFML_EVENTRECORDING_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::EventRecording
+/// \ingroup window
+///
+/// sf::EventRecording holds the events returned by a window,
+/// with the time and the frame at which they were returned,
+/// so that they can be replayed later in place of the input
+/// of the system. Replaying the same session of a game makes
+/// its frame times comparable from one build to the next,
+/// which is what performance regression suites need.
+///
+/// A window records its events with Window::setEventRecording
+/// and replays them with Window::replayEvents, either at the
+/// recorded speed or as fast as frames are displayed: each
+/// event is then returned in the same frame as when it was
+/// recorded. The frame times of the replay are collected
+/// by sf::Profiler, like any other frame.
+///
+/// Only the events are replayed: the real-time state of the
+/// devices (sf::Keyboard::isKeyPressed, sf::Mouse::getPosition,
+/// ...) still comes from the system.
+///
+/// Usage example:
+/// \code
+/// // Record a session of the game
+/// sf::EventRecording recording;
+/// window.setEventRecording(&recording);
+/// runGame(window);
+/// window.setEventRecording(NULL);
+/// recording.saveToFile("session.events");
+///
+/// // Later, in the regression suite
+/// sf::EventRecording session;
+/// session.loadFromFile("session.events");
+/// window.replayEvents(&session, false);
+/// while (window.isReplayingEvents())
+///     runFrame(window);
+/// sf::Profiler::saveChromeTrace("frames.json");
+/// \endcode
+///
+/// \see sf::Window, sf::Event, sf::Profiler
+///
+////////////////////////////////////////////////////////////
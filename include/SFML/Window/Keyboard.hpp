@@ -163,6 +163,35 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isKeyPressed(Key key);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the snapshot mode
+    ///
+    /// In snapshot mode, isKeyPressed doesn't query the system
+    /// anymore: it returns the state of the keyboard when
+    /// update() was last called. Enabling the mode takes a first
+    /// snapshot. The snapshot mode is disabled by default.
+    ///
+    /// \param enabled True to enable the snapshot mode, false to disable it
+    ///
+    /// \see update
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setSnapshotEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take a snapshot of the state of all the keys
+    ///
+    /// This function is typically called once per frame, before
+    /// the keys are checked; all the keys are read at once, which
+    /// is much cheaper than many separate queries on some systems
+    /// (a single request to the X server on Linux, instead of
+    /// one per key).
+    ///
+    /// \see setSnapshotEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    static void update();
+
     ////////////////////////////////////////////////////////////
     /// \brief Show or hide the virtual keyboard
     ///
@@ -203,6 +232,12 @@ public:
 /// pressed or released when your window is out of focus and no
 /// event is triggered.
 ///
+/// Each call to isKeyPressed normally queries the system, which
+/// can be slow (on Linux, it's a request to the X server, and it
+/// waits for the answer). Programs that check many keys every
+/// frame should enable the snapshot mode, and call update()
+/// once per frame.
+///
 /// Usage example:
 /// \code
 /// if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left))
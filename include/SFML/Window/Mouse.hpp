@@ -125,6 +125,34 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     static void setPosition(const Vector2i& position, const Window& relativeTo);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the snapshot mode
+    ///
+    /// In snapshot mode, isButtonPressed and getPosition don't
+    /// query the system anymore: they return the state of the
+    /// mouse when update() was last called. The position relative
+    /// to a window is queried once per window after each update.
+    /// Enabling the mode takes a first snapshot. The snapshot mode
+    /// is disabled by default.
+    ///
+    /// \param enabled True to enable the snapshot mode, false to disable it
+    ///
+    /// \see update
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setSnapshotEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take a snapshot of the buttons and the position of the mouse
+    ///
+    /// This function is typically called once per frame; the
+    /// buttons and the position are read at once.
+    ///
+    /// \see setSnapshotEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    static void update();
 };
 
 } // namespace sf
@@ -158,6 +186,10 @@ public:
 /// to the desktop) and one that operates in window coordinates
 /// (relative to a specific window).
 ///
+/// Like sf::Keyboard, sf::Mouse has a snapshot mode which reads
+/// the state of the mouse once per frame instead of querying
+/// the system for each call.
+///
 /// Usage example:
 /// \code
 /// if (sf::Mouse::isButtonPressed(sf::Mouse::Left))
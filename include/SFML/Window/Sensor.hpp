@@ -31,6 +31,7 @@
 #include <SFML/Window/Export.hpp>
 #include <SFML/System/Vector3.hpp>
 #include <SFML/System/Time.hpp>
+#include <cstddef>
 
 
 namespace sf
@@ -93,6 +94,55 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     static Vector3f getValue(Type sensor);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the sampling rate of a sensor
+    ///
+    /// By default, sensors are sampled as fast as the hardware
+    /// allows. A longer \a interval lowers the number of samples
+    /// (and the battery consumption); it is only a hint, the
+    /// system can deliver samples faster or slower.
+    ///
+    /// \a maxLatency is the time that samples are allowed to stay
+    /// in the hardware buffer of the sensor before they are delivered.
+    /// A non-zero latency lets the sensor batch many samples and
+    /// wake the CPU only once for all of them, which is much more
+    /// power-efficient for high rates. Batched samples are not lost:
+    /// read them with getSamples. Latency is ignored on hardware and
+    /// platforms that can't batch.
+    ///
+    /// This function does nothing if the sensor is unavailable.
+    ///
+    /// \param sensor     Sensor to modify
+    /// \param interval   Requested time between two samples
+    /// \param maxLatency Maximum delay before the samples are delivered
+    ///
+    /// \see getSamples
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setSamplingRate(Type sensor, Time interval, Time maxLatency = Time::Zero);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the samples received since the last call
+    ///
+    /// getValue only returns the latest value of a sensor; this
+    /// function returns all the samples received in between,
+    /// oldest first, so that none are missed at high sampling
+    /// rates. The samples that are returned are removed from the
+    /// buffer of the sensor, the remaining ones are returned by
+    /// the next calls. If the samples are not read often enough,
+    /// the oldest ones are dropped.
+    ///
+    /// \param sensor   Sensor to read
+    /// \param samples  Array to fill with the samples
+    /// \param maxCount Maximum number of samples to write to \a samples
+    ///
+    /// \return Number of samples written to \a samples
+    ///
+    /// \see setSamplingRate
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::size_t getSamples(Type sensor, Vector3f* samples, std::size_t maxCount);
 };
 
 } // namespace sf
@@ -147,4 +197,16 @@ public:
 /// sf::Vector3f gravity = sf::Sensor::getValue(sf::Sensor::Gravity);
 /// \endcode
 ///
+/// Applications that need every sample of a fast sensor can
+/// let the hardware batch them, and read them all at once:
+/// \code
+/// // sample the gyroscope at 200 Hz, delivered at least every 100 ms
+/// sf::Sensor::setSamplingRate(sf::Sensor::Gyroscope, sf::milliseconds(5), sf::milliseconds(100));
+/// sf::Sensor::setEnabled(sf::Sensor::Gyroscope, true);
+///
+/// // once per frame
+/// sf::Vector3f samples[64];
+/// std::size_t count = sf::Sensor::getSamples(sf::Sensor::Gyroscope, samples, 64);
+/// \endcode
+///
 ////////////////////////////////////////////////////////////
@@ -30,14 +30,18 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/Export.hpp>
 #include <SFML/Window/ContextSettings.hpp>
+#include <SFML/Window/Event.hpp>
 #include <SFML/Window/VideoMode.hpp>
 #include <SFML/Window/WindowHandle.hpp>
 #include <SFML/Window/WindowStyle.hpp>
 #include <SFML/Window/GlResource.hpp>
-#include <SFML/System/Clock.hpp>
+#include <SFML/System/FramePacer.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/String.hpp>
+#include <SFML/System/Utf8View.hpp>
+#include <SFML/System/Time.hpp>
+#include <vector>
 
 
 namespace sf
@@ -48,7 +52,8 @@ namespace priv
     class WindowImpl;
 }
 
-class Event;
+class Cursor;
+class EventRecording;
 
 ////////////////////////////////////////////////////////////
 /// \brief Window that serves as a target for OpenGL rendering
@@ -58,6 +63,29 @@ class SFML_WINDOW_API Window : GlResource, NonCopyable
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Information about the presentation of the frames
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Presentation
+    {
+        bool   available;    ///< Is presentation feedback supported by the driver?
+        Uint64 frameCount;   ///< Number of frames actually presented on the display so far
+        Uint64 refreshCount; ///< Value of the refresh counter of the display when the last frame was presented
+        Time   time;         ///< Time at which the last frame was presented, on the time line of getEventTime
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Timing of a frame synchronized with the display
+    ///
+    ////////////////////////////////////////////////////////////
+    struct FrameTiming
+    {
+        bool synchronized; ///< Are the times reported by the display (true), or estimated from its refresh rate (false)?
+        Time refreshTime;  ///< Time of the display refresh which starts the frame, on the time line of getEventTime
+        Time deadline;     ///< Expected time of the next refresh, by which the frame should be displayed
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -239,6 +267,94 @@ public:
     ////////////////////////////////////////////////////////////
     bool waitEvent(Event& event);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait for an event, an external event source or a timeout
+    ///
+    /// This function is blocking: if there's no pending event then
+    /// it waits until an event is received, until one of the event
+    /// sources registered with addEventSource becomes ready, or
+    /// until \a timeout has elapsed. It allows a single thread to
+    /// sleep until either user input or other data (typically
+    /// network traffic) arrives, instead of polling both regularly.
+    /// If you pass 0 (sf::Time::Zero) for \a timeout, the function
+    /// only returns when an event or an event source is ready.
+    /// \code
+    /// sf::Event event;
+    /// if (window.waitEvent(event, sf::milliseconds(500)))
+    /// {
+    ///    // process event...
+    /// }
+    /// else
+    /// {
+    ///    // an event source is ready or the timeout expired:
+    ///    // check the sockets, e.g. with selector.wait(sf::microseconds(1))...
+    /// }
+    /// \endcode
+    ///
+    /// The window's own events and external sources are waited for
+    /// simultaneously on platforms that support it (X11 and Windows);
+    /// on other platforms the function falls back to checking the
+    /// window regularly, and event sources are ignored. While a
+    /// joystick is connected or a sensor is enabled, the function
+    /// also wakes up regularly to poll their state.
+    ///
+    /// \param event   Event to be returned
+    /// \param timeout Maximum time to wait (use Time::Zero for infinity)
+    ///
+    /// \return True if an event was returned, false if an event source
+    ///         became ready, the timeout expired or an error occurred
+    ///
+    /// \see pollEvent, addEventSource
+    ///
+    ////////////////////////////////////////////////////////////
+    bool waitEvent(Event& event, Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an external event source to wait for in waitEvent
+    ///
+    /// On Unix systems, an event source is a file descriptor
+    /// which interrupts waitEvent when it becomes readable; the
+    /// handle of an SFML socket (see sf::Socket::getHandle) can
+    /// be used directly. On Windows, it is a waitable object
+    /// handle (event, semaphore, process, ...) which interrupts
+    /// waitEvent when it is signaled; to wait for a socket, create
+    /// an event and associate it with the socket using WSAEventSelect.
+    /// Adding the same source twice has no effect.
+    ///
+    /// \param source Event source to add
+    ///
+    /// \see removeEventSource, waitEvent
+    ///
+    ////////////////////////////////////////////////////////////
+    void addEventSource(EventSource source);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove an external event source
+    ///
+    /// This function doesn't close the source, it only stops
+    /// waitEvent from waiting for it.
+    ///
+    /// \param source Event source to remove
+    ///
+    /// \see addEventSource
+    ///
+    ////////////////////////////////////////////////////////////
+    void removeEventSource(EventSource source);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current time on the time line of the event timestamps
+    ///
+    /// The timestamps of the events (sf::Event::timestamp) are
+    /// measured on a monotonic time line shared by all the
+    /// windows, which starts at an arbitrary point. This function
+    /// returns the current time on this time line, so that you
+    /// can compute how long ago an event occurred.
+    ///
+    /// \return Current time on the time line of the event timestamps
+    ///
+    ////////////////////////////////////////////////////////////
+    static Time getEventTime();
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the position of the window
     ///
@@ -296,6 +412,16 @@ public:
     ////////////////////////////////////////////////////////////
     void setTitle(const String& title);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the title of the window, from UTF-8 bytes
+    ///
+    /// \param title New title, encoded in UTF-8
+    ///
+    /// \see setIcon
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTitle(const Utf8View& title);
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the window's icon
     ///
@@ -340,6 +466,102 @@ public:
     ////////////////////////////////////////////////////////////
     void setVerticalSyncEnabled(bool enabled);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of display refreshes per frame
+    ///
+    /// This function is a more detailed version of
+    /// setVerticalSyncEnabled: an \a interval of 0 disables
+    /// vertical synchronization, 1 enables it, 2 presents a frame
+    /// every two refreshes, and so on.
+    ///
+    /// A negative interval enables adaptive synchronization: the
+    /// swaps are synchronized with an interval of -interval as
+    /// long as the frames are ready in time, but a late frame is
+    /// presented immediately instead of waiting for the next
+    /// refresh. This trades a little tearing on late frames for
+    /// a lower latency and no sudden drop to half the refresh
+    /// rate. When the driver doesn't support it (it requires the
+    /// EXT_swap_control_tear extension), regular synchronization
+    /// with an interval of -interval is used instead.
+    ///
+    /// Intervals other than 0 and 1 are supported on Linux and
+    /// Windows; on other platforms any non-zero interval enables
+    /// regular vertical synchronization.
+    ///
+    /// \param interval Swap interval (0 to disable synchronization, negative for adaptive synchronization)
+    ///
+    /// \see setVerticalSyncEnabled, getRefreshRate
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSwapInterval(int interval);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the refresh rate of the display showing the window
+    ///
+    /// On Linux the rate is the one of the display that actually
+    /// shows the window, when the driver supports the
+    /// GLX_OML_sync_control extension; otherwise, and on other
+    /// platforms, the refresh rate of the desktop is returned.
+    ///
+    /// \return Refresh rate, in Hz (0 if unknown)
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getRefreshRate() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get information about the last frame which was
+    ///        actually presented on the display
+    ///
+    /// display() only queues a frame: with vertical synchronization
+    /// and the buffering of the driver, it can be shown several
+    /// refreshes later. This function tells when the frames really
+    /// reached the display, which lets an application measure its
+    /// actual latency and detect the refreshes that it missed
+    /// (by comparing the refresh counters of consecutive frames).
+    ///
+    /// The information is updated at each call to display() and
+    /// to this function, and its precision is one refresh interval
+    /// if they are not called at least once per frame.
+    ///
+    /// Presentation feedback is supported on Linux, by drivers
+    /// that implement the GLX_OML_sync_control extension; if it
+    /// isn't, the \a available member of the returned structure
+    /// is false.
+    ///
+    /// \return Information about the last presented frame
+    ///
+    /// \see getEventTime
+    ///
+    ////////////////////////////////////////////////////////////
+    Presentation getLastPresentation() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the next refresh of the display
+    ///
+    /// This function sleeps until the display starts a new refresh,
+    /// and tells when it happened and when the next one is expected.
+    /// Calling it at the beginning of each frame starts the frames
+    /// right after the refreshes, which gives the most time to
+    /// render them and makes the input-to-display latency regular;
+    /// since the thread sleeps until then, it also saves power
+    /// compared to blocking in display() with vertical
+    /// synchronization.
+    ///
+    /// The refreshes are reported by the system on Android 7.0+
+    /// (AChoreographer) and iOS (CADisplayLink). On the other
+    /// platforms, or when the system doesn't deliver them (the
+    /// application being in background for example), they are
+    /// estimated from getRefreshRate, on a grid which isn't locked
+    /// to the actual refreshes; the \a synchronized member of the
+    /// returned structure is then false.
+    ///
+    /// \return Timing of the frame that starts
+    ///
+    /// \see getRefreshRate, getEventTime
+    ///
+    ////////////////////////////////////////////////////////////
+    FrameTiming waitForNextFrame();
+
     ////////////////////////////////////////////////////////////
     /// \brief Show or hide the mouse cursor
     ///
@@ -350,6 +572,25 @@ public:
     ////////////////////////////////////////////////////////////
     void setMouseCursorVisible(bool visible);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the image of the mouse cursor
+    ///
+    /// The cursor is drawn by the operating system, so it moves
+    /// with the mouse independently of the frame rate of the
+    /// application. It is displayed while the mouse is over the
+    /// window and the cursor is visible (see
+    /// setMouseCursorVisible). An empty sf::Cursor restores the
+    /// default cursor of the system.
+    ///
+    /// The cursor must stay alive as long as the window uses it.
+    ///
+    /// \param cursor Cursor to display over the window
+    ///
+    /// \see sf::Cursor::loadFromPixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMouseCursor(const Cursor& cursor);
+
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable automatic key-repeat
     ///
@@ -364,23 +605,144 @@ public:
     ////////////////////////////////////////////////////////////
     void setKeyRepeatEnabled(bool enabled);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable raw mouse motion events
+    ///
+    /// When raw mouse input is enabled, the window generates
+    /// sf::Event::MouseMovedRaw events in addition to the usual
+    /// MouseMoved events, while it has the focus. They report
+    /// the motion of the mouse device itself, before any pointer
+    /// acceleration and without being limited by the position of
+    /// the cursor or the borders of the screen, with one event
+    /// per device report instead of one per cursor update. This
+    /// is typically what first-person games need for camera
+    /// control, usually together with a hidden cursor.
+    ///
+    /// Raw mouse input is supported on Linux (XInput 2) and
+    /// Windows (raw input devices); on other platforms this
+    /// function has no effect.
+    ///
+    /// Raw mouse input is disabled by default.
+    ///
+    /// \param enabled True to enable, false to disable
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRawMouseInputEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the coalescing of mouse moves
+    ///
+    /// High-rate mice can produce many more MouseMoved events
+    /// than a frame can use. When coalescing is enabled, the
+    /// consecutive moves that are already waiting in the event
+    /// queue are merged into a single MouseMoved event, holding
+    /// the most recent position. Disable it if the intermediate
+    /// positions matter, e.g. for drawing applications.
+    ///
+    /// Coalescing is supported on Linux; on other platforms
+    /// this function has no effect.
+    ///
+    /// Coalescing is enabled by default.
+    ///
+    /// \param enabled True to enable, false to disable
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMouseMoveCoalescingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the input thread of the window
+    ///
+    /// By default, the joysticks are read when the window looks
+    /// for new events, i.e. once per call to pollEvent (or more
+    /// often while waitEvent is waiting), which usually means
+    /// once per frame: their events are then stamped with the
+    /// time of the frame, and a button that is pressed and
+    /// released within a single frame can be missed entirely.
+    ///
+    /// When the input thread is enabled, a dedicated thread reads
+    /// the joysticks continuously (about 1000 times per second)
+    /// and passes their events to the window through a lock-free
+    /// queue. The events returned by pollEvent and waitEvent are
+    /// then still ordered by their timestamp.
+    ///
+    /// The events of the window itself (keyboard, mouse, etc.)
+    /// are not affected: most operating systems require them to
+    /// be processed by the thread that created the window, and
+    /// they already carry the time at which they occurred.
+    ///
+    /// The input thread is disabled by default.
+    ///
+    /// \param enabled True to enable, false to disable
+    ///
+    /// \see sf::Event::timestamp
+    ///
+    ////////////////////////////////////////////////////////////
+    void setInputThreadEnabled(bool enabled);
+
     ////////////////////////////////////////////////////////////
     /// \brief Limit the framerate to a maximum fixed frequency
     ///
     /// If a limit is set, the window will use a small delay after
     /// each call to display() to ensure that the current frame
     /// lasted long enough to match the framerate limit.
-    /// SFML will try to match the given limit as much as it can,
-    /// but since it internally uses sf::sleep, whose precision
-    /// depends on the underlying OS, the results may be a little
-    /// unprecise as well (for example, you can get 65 FPS when
-    /// requesting 60).
+    /// The delay is implemented by a sf::FramePacer: it sleeps
+    /// for most of the remaining time and then yields the processor
+    /// until the deadline, so the frame times don't depend on the
+    /// precision of the OS sleep, and deadlines are kept on a
+    /// regular grid so that the average framerate doesn't drift.
+    ///
+    /// Don't use this function together with setVerticalSyncEnabled,
+    /// both would try to pace the frames and fight each other.
     ///
     /// \param limit Framerate limit, in frames per seconds (use 0 to disable limit)
     ///
+    /// \see setFrameInterval, getFrameStatistics
+    ///
     ////////////////////////////////////////////////////////////
     void setFramerateLimit(unsigned int limit);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Limit the framerate to a fraction of the display refresh rate
+    ///
+    /// This function works like setFramerateLimit, but the frame
+    /// time is derived from the refresh rate of the display (see
+    /// getRefreshRate): with an \a interval of 1 the window displays one
+    /// frame per refresh, with 2 one frame every two refreshes,
+    /// and so on. If the refresh rate can't be retrieved, 60 Hz
+    /// is assumed. Contrary to vertical synchronization, the
+    /// pacing is not locked to the actual refreshes of the display,
+    /// but it doesn't depend on the driver settings either.
+    ///
+    /// \param interval Number of display refreshes per frame (use 0 to disable limit)
+    ///
+    /// \see setFramerateLimit
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFrameInterval(unsigned int interval);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the frame time statistics of the window
+    ///
+    /// The duration of a frame is measured between two calls to
+    /// display(), whether a framerate limit is set or not. A
+    /// deadline is missed when a frame takes longer than the
+    /// framerate limit.
+    ///
+    /// \return Statistics of the frames displayed since the last reset
+    ///
+    /// \see resetFrameStatistics, setFramerateLimit
+    ///
+    ////////////////////////////////////////////////////////////
+    FramePacer::Statistics getFrameStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the frame time statistics of the window
+    ///
+    /// \see getFrameStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetFrameStatistics();
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the joystick threshold
     ///
@@ -394,6 +756,87 @@ public:
     ////////////////////////////////////////////////////////////
     void setJoystickThreshold(float threshold);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the generation of a type of events
+    ///
+    /// Disabled events are dropped where they are produced,
+    /// before they are translated and queued, so that frequent
+    /// events that the application doesn't handle (mouse moves
+    /// from high-rate mice, joystick moves, sensor changes...)
+    /// don't cost anything in the event loop. Resized events
+    /// can't be disabled, the window needs them.
+    ///
+    /// All the events are enabled by default. This setting
+    /// is reset when the window is recreated.
+    ///
+    /// \param type    Type of events
+    /// \param enabled True to generate the events, false to drop them
+    ///
+    /// \see isEventEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    void setEventEnabled(Event::EventType type, bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a type of events is generated
+    ///
+    /// \param type Type of events
+    ///
+    /// \return True if the events are generated
+    ///
+    /// \see setEventEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isEventEnabled(Event::EventType type) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start or stop recording the events of the window
+    ///
+    /// While recording, every event returned by pollEvent and
+    /// waitEvent is appended to \a recording, with its timestamp
+    /// made relative to the start of the recording and the number
+    /// of frames displayed since then. The recording must stay
+    /// alive until it is stopped. This setting is reset when the
+    /// window is recreated.
+    ///
+    /// \param recording Recording to append the events to, or NULL to stop recording
+    ///
+    /// \see replayEvents
+    ///
+    ////////////////////////////////////////////////////////////
+    void setEventRecording(EventRecording* recording);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start or stop replaying recorded events
+    ///
+    /// While replaying, pollEvent and waitEvent return the
+    /// recorded events instead of the events of the system,
+    /// which are discarded. In real-time mode the events are
+    /// returned at the same times as when they were recorded;
+    /// otherwise each one is returned in the frame (counted by
+    /// display) in which it was recorded, so that the replay
+    /// runs as fast as the frames can be rendered. The replay
+    /// stops by itself after the last recorded event. The
+    /// recording must stay alive until the replay is over.
+    ///
+    /// \param recording Events to replay, or NULL to stop replaying
+    /// \param realTime  True to replay at the recorded speed, false to replay frame by frame
+    ///
+    /// \see isReplayingEvents, setEventRecording
+    ///
+    ////////////////////////////////////////////////////////////
+    void replayEvents(const EventRecording* recording, bool realTime = true);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether recorded events are being replayed
+    ///
+    /// \return True until the last recorded event has been returned
+    ///
+    /// \see replayEvents
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReplayingEvents() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Activate or deactivate the window as the current target
     ///        for OpenGL rendering
@@ -447,6 +890,7 @@ public:
     /// This function is typically called after all OpenGL rendering
     /// has been done for the current frame, in order to show
     /// it on screen.
+    /// It also resets the sf::FrameArena of the calling thread.
     ///
     ////////////////////////////////////////////////////////////
     void display();
@@ -513,11 +957,11 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    priv::WindowImpl* m_impl;           ///< Platform-specific implementation of the window
-    priv::GlContext*  m_context;        ///< Platform-specific implementation of the OpenGL context
-    Clock             m_clock;          ///< Clock for measuring the elapsed time between frames
-    Time              m_frameTimeLimit; ///< Current framerate limit
-    Vector2u          m_size;           ///< Current size of the window
+    priv::WindowImpl*        m_impl;           ///< Platform-specific implementation of the window
+    priv::GlContext*         m_context;        ///< Platform-specific implementation of the OpenGL context
+    FramePacer               m_framePacer;     ///< Frame pacer implementing the framerate limit
+    Vector2u                 m_size;           ///< Current size of the window
+    std::vector<EventSource> m_eventSources;   ///< External event sources to wait for in waitEvent
 };
 
 } // namespace sf
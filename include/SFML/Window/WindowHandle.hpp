@@ -68,6 +68,23 @@ namespace sf
 
 #endif
 
+////////////////////////////////////////////////////////////
+/// Define a low-level handle type for the external event
+/// sources that sf::Window::waitEvent can wait for,
+/// specific to each platform
+////////////////////////////////////////////////////////////
+#if defined(SFML_SYSTEM_WINDOWS)
+
+    // Event source is a waitable HANDLE (void*) on Windows
+    typedef void* EventSource;
+
+#else
+
+    // Event source is a file descriptor (int) on Unix systems
+    typedef int EventSource;
+
+#endif
+
 } // namespace sf
 
 
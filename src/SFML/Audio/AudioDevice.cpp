@@ -41,6 +41,22 @@ namespace
     sf::Vector3f listenerPosition (0.f, 0.f, 0.f);
     sf::Vector3f listenerDirection(0.f, 0.f, -1.f);
     sf::Vector3f listenerUpVector (0.f, 1.f, 0.f);
+
+    // AL_SOFT_deferred_updates entry points, if the implementation supports them
+    typedef void (AL_APIENTRY *UpdatesFunc)();
+    UpdatesFunc deferUpdates   = NULL;
+    UpdatesFunc processUpdates = NULL;
+
+    // State of the deferred update scope
+    enum DeferMode
+    {
+        NotDeferred,
+        DeferredSoft,
+        DeferredSuspend
+    };
+
+    unsigned int updateDepth = 0;
+    DeferMode    deferMode   = NotDeferred;
 }
 
 namespace sf
@@ -73,6 +89,19 @@ AudioDevice::AudioDevice()
             alCheck(alListenerf(AL_GAIN, listenerVolume * 0.01f));
             alCheck(alListener3f(AL_POSITION, listenerPosition.x, listenerPosition.y, listenerPosition.z));
             alCheck(alListenerfv(AL_ORIENTATION, orientation));
+
+            // Deferred updates are applied in a single mixing parameter recomputation
+            if (alIsExtensionPresent("AL_SOFT_deferred_updates") != AL_FALSE)
+            {
+                deferUpdates   = reinterpret_cast<UpdatesFunc>(alGetProcAddress("alDeferUpdatesSOFT"));
+                processUpdates = reinterpret_cast<UpdatesFunc>(alGetProcAddress("alProcessUpdatesSOFT"));
+
+                if (!deferUpdates || !processUpdates)
+                {
+                    deferUpdates   = NULL;
+                    processUpdates = NULL;
+                }
+            }
         }
         else
         {
@@ -89,6 +118,16 @@ AudioDevice::AudioDevice()
 ////////////////////////////////////////////////////////////
 AudioDevice::~AudioDevice()
 {
+    // Apply the updates still deferred, the context won't process them anymore
+    if (deferMode == DeferredSoft)
+        processUpdates();
+    else if (deferMode == DeferredSuspend)
+        alcProcessContext(audioContext);
+    deferMode = NotDeferred;
+
+    deferUpdates   = NULL;
+    processUpdates = NULL;
+
     // Destroy the context
     alcMakeContextCurrent(NULL);
     if (audioContext)
@@ -150,6 +189,56 @@ int AudioDevice::getFormatFromChannelCount(unsigned int channelCount)
 }
 
 
+////////////////////////////////////////////////////////////
+int AudioDevice::getFloatFormatFromChannelCount(unsigned int channelCount)
+{
+    // Create a temporary audio device in case none exists yet
+    std::auto_ptr<AudioDevice> device;
+    if (!audioDevice)
+        device.reset(new AudioDevice);
+
+    if (!isExtensionSupported("AL_EXT_FLOAT32"))
+        return 0;
+
+    // Find the good format according to the number of channels
+    int format = 0;
+    switch (channelCount)
+    {
+        case 1:  format = alGetEnumValue("AL_FORMAT_MONO_FLOAT32");   break;
+        case 2:  format = alGetEnumValue("AL_FORMAT_STEREO_FLOAT32"); break;
+        case 4:  format = alGetEnumValue("AL_FORMAT_QUAD32");         break;
+        case 6:  format = alGetEnumValue("AL_FORMAT_51CHN32");        break;
+        case 7:  format = alGetEnumValue("AL_FORMAT_61CHN32");        break;
+        case 8:  format = alGetEnumValue("AL_FORMAT_71CHN32");        break;
+        default: format = 0;                                          break;
+    }
+
+    // Fixes a bug on OS X
+    if (format == -1)
+        format = 0;
+
+    return format;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int AudioDevice::getSampleRate()
+{
+    // Create a temporary audio device in case none exists yet
+    std::auto_ptr<AudioDevice> device;
+    if (!audioDevice)
+        device.reset(new AudioDevice);
+
+    if (!audioDevice)
+        return 0;
+
+    ALCint sampleRate = 0;
+    alcGetIntegerv(audioDevice, ALC_FREQUENCY, 1, &sampleRate);
+
+    return sampleRate > 0 ? static_cast<unsigned int>(sampleRate) : 0;
+}
+
+
 ////////////////////////////////////////////////////////////
 void AudioDevice::setGlobalVolume(float volume)
 {
@@ -223,6 +312,52 @@ Vector3f AudioDevice::getUpVector()
     return listenerUpVector;
 }
 
+
+////////////////////////////////////////////////////////////
+void AudioDevice::beginUpdate()
+{
+    if ((updateDepth++ > 0) || !audioContext)
+        return;
+
+    // Without AL_SOFT_deferred_updates, suspending the context is the
+    // standard way to batch changes (some implementations ignore it)
+    if (deferUpdates)
+    {
+        alCheck(deferUpdates());
+        deferMode = DeferredSoft;
+    }
+    else
+    {
+        alcSuspendContext(audioContext);
+        deferMode = DeferredSuspend;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void AudioDevice::endUpdate()
+{
+    if (updateDepth == 0)
+    {
+        err() << "Listener::endUpdate called without a matching Listener::beginUpdate" << std::endl;
+        return;
+    }
+
+    if (--updateDepth > 0)
+        return;
+
+    if (deferMode == DeferredSoft)
+    {
+        alCheck(processUpdates());
+    }
+    else if (deferMode == DeferredSuspend)
+    {
+        alcProcessContext(audioContext);
+    }
+
+    deferMode = NotDeferred;
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -83,6 +83,24 @@ public:
     ////////////////////////////////////////////////////////////
     static int getFormatFromChannelCount(unsigned int channelCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the OpenAL 32-bit float format that matches the given number of channels
+    ///
+    /// \param channelCount Number of channels
+    ///
+    /// \return Corresponding format, or 0 if AL_EXT_FLOAT32 is not supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static int getFloatFormatFromChannelCount(unsigned int channelCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sample rate at which the device mixes the sounds
+    ///
+    /// \return Mixing rate of the device, or 0 if it is unknown
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getSampleRate();
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the global volume of all the sounds and musics
     ///
@@ -182,6 +200,20 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     static Vector3f getUpVector();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start deferring the changes of the sources and the listener
+    ///
+    /// Calls can be nested, only the outermost pair has an effect.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void beginUpdate();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the changes deferred since beginUpdate, all at once
+    ///
+    ////////////////////////////////////////////////////////////
+    static void endUpdate();
 };
 
 } // namespace priv
@@ -0,0 +1,238 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/BiquadFilter.hpp>
+#include <SFML/Audio/MixKernels.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+BiquadFilter::BiquadFilter(Type type, float frequency, float quality, float gain) :
+m_mutex            (),
+m_type             (type),
+m_frequency        (frequency),
+m_quality          (quality),
+m_gain             (gain),
+m_coefficientsValid(false),
+m_sampleRate       (0)
+{
+    std::fill(m_coefficients, m_coefficients + 5, 0.f);
+    std::fill(m_state, m_state + 2 * MaxChannelCount, 0.f);
+}
+
+
+////////////////////////////////////////////////////////////
+void BiquadFilter::setType(Type type)
+{
+    Lock lock(m_mutex);
+
+    m_type = type;
+    m_coefficientsValid = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void BiquadFilter::setFrequency(float frequency)
+{
+    Lock lock(m_mutex);
+
+    m_frequency = frequency;
+    m_coefficientsValid = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void BiquadFilter::setQuality(float quality)
+{
+    Lock lock(m_mutex);
+
+    m_quality = quality;
+    m_coefficientsValid = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void BiquadFilter::setGain(float gain)
+{
+    Lock lock(m_mutex);
+
+    m_gain = gain;
+    m_coefficientsValid = false;
+}
+
+
+////////////////////////////////////////////////////////////
+BiquadFilter::Type BiquadFilter::getType() const
+{
+    return m_type;
+}
+
+
+////////////////////////////////////////////////////////////
+float BiquadFilter::getFrequency() const
+{
+    return m_frequency;
+}
+
+
+////////////////////////////////////////////////////////////
+float BiquadFilter::getQuality() const
+{
+    return m_quality;
+}
+
+
+////////////////////////////////////////////////////////////
+float BiquadFilter::getGain() const
+{
+    return m_gain;
+}
+
+
+////////////////////////////////////////////////////////////
+void BiquadFilter::process(float* samples, std::size_t frameCount, unsigned int channelCount, unsigned int sampleRate)
+{
+    if ((channelCount == 0) || (channelCount > MaxChannelCount) || (sampleRate == 0))
+        return;
+
+    float coefficients[5];
+    {
+        Lock lock(m_mutex);
+
+        if (!m_coefficientsValid || (sampleRate != m_sampleRate))
+            updateCoefficients(sampleRate);
+
+        std::copy(m_coefficients, m_coefficients + 5, coefficients);
+    }
+
+    priv::applyBiquad(samples, frameCount, channelCount, coefficients, m_state);
+}
+
+
+////////////////////////////////////////////////////////////
+void BiquadFilter::reset()
+{
+    std::fill(m_state, m_state + 2 * MaxChannelCount, 0.f);
+}
+
+
+////////////////////////////////////////////////////////////
+void BiquadFilter::updateCoefficients(unsigned int sampleRate)
+{
+    // Formulas from the "Audio EQ Cookbook" of Robert Bristow-Johnson
+    const double pi = 3.141592653589793;
+    double frequency = std::max(1.0, std::min(static_cast<double>(m_frequency), sampleRate * 0.499));
+    double quality   = std::max(0.01, static_cast<double>(m_quality));
+    double w0        = 2 * pi * frequency / sampleRate;
+    double cosw0     = std::cos(w0);
+    double alpha     = std::sin(w0) / (2 * quality);
+    double a         = std::pow(10.0, m_gain / 40.0);
+    double shelf     = 2 * std::sqrt(a) * alpha;
+
+    double b0, b1, b2, a0, a1, a2;
+    switch (m_type)
+    {
+        default:
+        case LowPass:
+            b0 = (1 - cosw0) / 2;
+            b1 = 1 - cosw0;
+            b2 = (1 - cosw0) / 2;
+            a0 = 1 + alpha;
+            a1 = -2 * cosw0;
+            a2 = 1 - alpha;
+            break;
+
+        case HighPass:
+            b0 = (1 + cosw0) / 2;
+            b1 = -(1 + cosw0);
+            b2 = (1 + cosw0) / 2;
+            a0 = 1 + alpha;
+            a1 = -2 * cosw0;
+            a2 = 1 - alpha;
+            break;
+
+        case BandPass:
+            b0 = alpha;
+            b1 = 0;
+            b2 = -alpha;
+            a0 = 1 + alpha;
+            a1 = -2 * cosw0;
+            a2 = 1 - alpha;
+            break;
+
+        case Notch:
+            b0 = 1;
+            b1 = -2 * cosw0;
+            b2 = 1;
+            a0 = 1 + alpha;
+            a1 = -2 * cosw0;
+            a2 = 1 - alpha;
+            break;
+
+        case Peak:
+            b0 = 1 + alpha * a;
+            b1 = -2 * cosw0;
+            b2 = 1 - alpha * a;
+            a0 = 1 + alpha / a;
+            a1 = -2 * cosw0;
+            a2 = 1 - alpha / a;
+            break;
+
+        case LowShelf:
+            b0 = a * ((a + 1) - (a - 1) * cosw0 + shelf);
+            b1 = 2 * a * ((a - 1) - (a + 1) * cosw0);
+            b2 = a * ((a + 1) - (a - 1) * cosw0 - shelf);
+            a0 = (a + 1) + (a - 1) * cosw0 + shelf;
+            a1 = -2 * ((a - 1) + (a + 1) * cosw0);
+            a2 = (a + 1) + (a - 1) * cosw0 - shelf;
+            break;
+
+        case HighShelf:
+            b0 = a * ((a + 1) + (a - 1) * cosw0 + shelf);
+            b1 = -2 * a * ((a - 1) + (a + 1) * cosw0);
+            b2 = a * ((a + 1) + (a - 1) * cosw0 - shelf);
+            a0 = (a + 1) - (a - 1) * cosw0 + shelf;
+            a1 = 2 * ((a - 1) - (a + 1) * cosw0);
+            a2 = (a + 1) - (a - 1) * cosw0 - shelf;
+            break;
+    }
+
+    m_coefficients[0] = static_cast<float>(b0 / a0);
+    m_coefficients[1] = static_cast<float>(b1 / a0);
+    m_coefficients[2] = static_cast<float>(b2 / a0);
+    m_coefficients[3] = static_cast<float>(a1 / a0);
+    m_coefficients[4] = static_cast<float>(a2 / a0);
+
+    m_coefficientsValid = true;
+    m_sampleRate = sampleRate;
+}
+
+} // namespace sf
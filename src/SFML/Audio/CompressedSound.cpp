@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/CompressedSound.hpp>
+#include <SFML/Audio/CompressedSoundBuffer.hpp>
+#include <SFML/System/Lock.hpp>
+
+
+namespace
+{
+    // Number of blocks decoded per chunk: about 0.1 second at 44.1 kHz
+    const std::size_t chunkBlockCount = 4;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+CompressedSound::CompressedSound() :
+m_buffer (NULL),
+m_offset (0),
+m_samples(),
+m_mutex  ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+CompressedSound::CompressedSound(const CompressedSoundBuffer& buffer) :
+m_buffer (NULL),
+m_offset (0),
+m_samples(),
+m_mutex  ()
+{
+    setBuffer(buffer);
+}
+
+
+////////////////////////////////////////////////////////////
+CompressedSound::~CompressedSound()
+{
+    // We must stop before the buffer is detached
+    stop();
+
+    if (m_buffer)
+        m_buffer->detachSound(this);
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedSound::setBuffer(const CompressedSoundBuffer& buffer)
+{
+    stop();
+
+    // Detach the previous buffer
+    if (m_buffer)
+        m_buffer->detachSound(this);
+
+    // Assign and use the new buffer
+    m_buffer = &buffer;
+    m_buffer->attachSound(this);
+
+    {
+        Lock lock(m_mutex);
+        m_offset = 0;
+        m_samples.resize(chunkBlockCount * CompressedSoundBuffer::BlockFrameCount * buffer.getChannelCount());
+    }
+
+    if (buffer.getChannelCount() && buffer.getSampleRate())
+        initialize(buffer.getChannelCount(), buffer.getSampleRate());
+}
+
+
+////////////////////////////////////////////////////////////
+const CompressedSoundBuffer* CompressedSound::getBuffer() const
+{
+    return m_buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CompressedSound::onGetData(Chunk& data)
+{
+    Lock lock(m_mutex);
+
+    if (!m_buffer || m_samples.empty())
+        return false;
+
+    std::size_t frameCount = m_samples.size() / m_buffer->getChannelCount();
+    std::size_t decoded = m_buffer->decode(m_offset, frameCount, &m_samples[0]);
+    m_offset += decoded;
+
+    data.samples = &m_samples[0];
+    data.sampleCount = decoded * m_buffer->getChannelCount();
+
+    // Stop once all the frames are played
+    return decoded == frameCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedSound::onSeek(Time timeOffset)
+{
+    Lock lock(m_mutex);
+
+    if (m_buffer)
+        m_offset = static_cast<Uint64>(timeOffset.asMicroseconds()) * m_buffer->getSampleRate() / 1000000;
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedSound::resetBuffer()
+{
+    stop();
+
+    if (m_buffer)
+    {
+        m_buffer->detachSound(this);
+        m_buffer = NULL;
+    }
+}
+
+} // namespace sf
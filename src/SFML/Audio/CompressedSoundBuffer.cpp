@@ -0,0 +1,282 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/CompressedSoundBuffer.hpp>
+#include <SFML/Audio/CompressedSound.hpp>
+#include <SFML/Audio/InputSoundFile.hpp>
+#include <SFML/Audio/ImaAdpcm.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+CompressedSoundBuffer::CompressedSoundBuffer() :
+m_blocks      (),
+m_blockSize   (0),
+m_frameCount  (0),
+m_channelCount(0),
+m_sampleRate  (0),
+m_duration    (),
+m_sounds      ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+CompressedSoundBuffer::~CompressedSoundBuffer()
+{
+    // Work on a copy, resetBuffer detaches the sound from m_sounds
+    SoundList sounds(m_sounds);
+    for (SoundList::const_iterator it = sounds.begin(); it != sounds.end(); ++it)
+        (*it)->resetBuffer();
+}
+
+
+////////////////////////////////////////////////////////////
+bool CompressedSoundBuffer::loadFromFile(const std::string& filename)
+{
+    InputSoundFile file;
+    if (file.openFromFile(filename))
+        return initialize(file);
+    else
+        return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CompressedSoundBuffer::loadFromMemory(const void* data, std::size_t sizeInBytes)
+{
+    InputSoundFile file;
+    if (file.openFromMemory(data, sizeInBytes))
+        return initialize(file);
+    else
+        return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CompressedSoundBuffer::loadFromStream(InputStream& stream)
+{
+    InputSoundFile file;
+    if (file.openFromStream(stream))
+        return initialize(file);
+    else
+        return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CompressedSoundBuffer::loadFromSamples(const Int16* samples, Uint64 sampleCount, unsigned int channelCount, unsigned int sampleRate)
+{
+    if (!samples || !channelCount || !sampleRate)
+    {
+        err() << "Failed to load compressed sound buffer from samples ("
+              << "array: "      << samples      << ", "
+              << "count: "      << sampleCount  << ", "
+              << "channels: "   << channelCount << ", "
+              << "samplerate: " << sampleRate   << ")"
+              << std::endl;
+
+        return false;
+    }
+
+    reset(channelCount, sampleRate);
+
+    Uint64 frameCount = sampleCount / channelCount;
+    m_blocks.reserve(static_cast<std::size_t>((frameCount + BlockFrameCount - 1) / BlockFrameCount) * m_blockSize);
+    for (Uint64 frame = 0; frame < frameCount; frame += BlockFrameCount)
+    {
+        std::size_t count = static_cast<std::size_t>(std::min<Uint64>(BlockFrameCount, frameCount - frame));
+        appendBlock(samples + frame * channelCount, count);
+    }
+
+    finalize();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 CompressedSoundBuffer::getSampleCount() const
+{
+    return m_frameCount * m_channelCount;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int CompressedSoundBuffer::getSampleRate() const
+{
+    return m_sampleRate;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int CompressedSoundBuffer::getChannelCount() const
+{
+    return m_channelCount;
+}
+
+
+////////////////////////////////////////////////////////////
+Time CompressedSoundBuffer::getDuration() const
+{
+    return m_duration;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t CompressedSoundBuffer::getCompressedSize() const
+{
+    return m_blocks.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t CompressedSoundBuffer::decode(Uint64 frameOffset, std::size_t frameCount, Int16* samples) const
+{
+    std::vector<Int16> partial;
+
+    std::size_t decoded = 0;
+    while ((decoded < frameCount) && (frameOffset < m_frameCount))
+    {
+        Uint64 blockIndex = frameOffset / BlockFrameCount;
+        std::size_t blockStart = static_cast<std::size_t>(frameOffset % BlockFrameCount);
+        std::size_t blockFrames = static_cast<std::size_t>(std::min<Uint64>(BlockFrameCount, m_frameCount - blockIndex * BlockFrameCount));
+        std::size_t count = std::min(blockFrames - blockStart, frameCount - decoded);
+
+        const Uint8* block = &m_blocks[static_cast<std::size_t>(blockIndex) * m_blockSize];
+        Int16* output = samples + decoded * m_channelCount;
+
+        if ((blockStart == 0) && (count == blockFrames))
+        {
+            priv::decodeImaAdpcm(block, blockFrames, m_channelCount, output);
+        }
+        else
+        {
+            // Blocks can only be decoded entirely: this happens after seeking, or at the end of the array
+            partial.resize(blockFrames * m_channelCount);
+            priv::decodeImaAdpcm(block, blockFrames, m_channelCount, &partial[0]);
+            std::copy(partial.begin() + blockStart * m_channelCount,
+                      partial.begin() + (blockStart + count) * m_channelCount,
+                      output);
+        }
+
+        decoded += count;
+        frameOffset += count;
+    }
+
+    return decoded;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CompressedSoundBuffer::initialize(InputSoundFile& file)
+{
+    unsigned int channelCount = file.getChannelCount();
+    unsigned int sampleRate = file.getSampleRate();
+    if (!channelCount || !sampleRate)
+    {
+        err() << "Failed to load compressed sound buffer (invalid channel count or sample rate)" << std::endl;
+        return false;
+    }
+
+    reset(channelCount, sampleRate);
+
+    // Decode and compress one block at a time
+    Uint64 frameCount = file.getSampleCount() / channelCount;
+    m_blocks.reserve(static_cast<std::size_t>((frameCount + BlockFrameCount - 1) / BlockFrameCount) * m_blockSize);
+
+    std::vector<Int16> samples(BlockFrameCount * channelCount);
+    for (;;)
+    {
+        std::size_t count = static_cast<std::size_t>(file.read(&samples[0], samples.size()) / channelCount);
+        if (count == 0)
+            break;
+
+        appendBlock(&samples[0], count);
+    }
+
+    finalize();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedSoundBuffer::reset(unsigned int channelCount, unsigned int sampleRate)
+{
+    // The sounds must not decode the buffer while it changes
+    for (SoundList::const_iterator it = m_sounds.begin(); it != m_sounds.end(); ++it)
+        (*it)->stop();
+
+    m_blocks.clear();
+    m_blockSize = priv::getImaAdpcmBlockSize(BlockFrameCount, channelCount);
+    m_frameCount = 0;
+    m_channelCount = channelCount;
+    m_sampleRate = sampleRate;
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedSoundBuffer::appendBlock(const Int16* samples, std::size_t frameCount)
+{
+    // Every block takes the full size, so that they can be found by their index
+    std::size_t offset = m_blocks.size();
+    m_blocks.resize(offset + m_blockSize, 0);
+    priv::encodeImaAdpcm(samples, frameCount, m_channelCount, &m_blocks[offset]);
+
+    m_frameCount += frameCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedSoundBuffer::finalize()
+{
+    m_duration = seconds(static_cast<float>(m_frameCount) / m_sampleRate);
+
+    // Update the attached sounds, the format may have changed
+    SoundList sounds(m_sounds);
+    for (SoundList::const_iterator it = sounds.begin(); it != sounds.end(); ++it)
+        (*it)->setBuffer(*this);
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedSoundBuffer::attachSound(CompressedSound* sound) const
+{
+    m_sounds.insert(sound);
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedSoundBuffer::detachSound(CompressedSound* sound) const
+{
+    m_sounds.erase(sound);
+}
+
+} // namespace sf
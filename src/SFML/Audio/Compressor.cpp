@@ -0,0 +1,187 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Compressor.hpp>
+#include <SFML/Audio/MixKernels.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Number of frames over which the level is measured and the gain is ramped
+    const std::size_t blockSize = 32;
+
+    // Coefficient of a one-pole smoothing reaching 63% of a step after a given time
+    float getSmoothing(sf::Time time, unsigned int sampleRate)
+    {
+        float blocks = time.asSeconds() * sampleRate / blockSize;
+        return (blocks > 0.f) ? std::exp(-1.f / blocks) : 0.f;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Compressor::Compressor() :
+m_mutex     (),
+m_threshold (-18.f),
+m_ratio     (4.f),
+m_attack    (milliseconds(10)),
+m_release   (milliseconds(100)),
+m_makeupGain(0.f),
+m_envelope  (0.f),
+m_gain      (1.f)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Compressor::setThreshold(float threshold)
+{
+    Lock lock(m_mutex);
+    m_threshold = threshold;
+}
+
+
+////////////////////////////////////////////////////////////
+void Compressor::setRatio(float ratio)
+{
+    Lock lock(m_mutex);
+    m_ratio = std::max(ratio, 1.f);
+}
+
+
+////////////////////////////////////////////////////////////
+void Compressor::setAttack(Time attack)
+{
+    Lock lock(m_mutex);
+    m_attack = attack;
+}
+
+
+////////////////////////////////////////////////////////////
+void Compressor::setRelease(Time release)
+{
+    Lock lock(m_mutex);
+    m_release = release;
+}
+
+
+////////////////////////////////////////////////////////////
+void Compressor::setMakeupGain(float gain)
+{
+    Lock lock(m_mutex);
+    m_makeupGain = gain;
+}
+
+
+////////////////////////////////////////////////////////////
+float Compressor::getThreshold() const
+{
+    return m_threshold;
+}
+
+
+////////////////////////////////////////////////////////////
+float Compressor::getRatio() const
+{
+    return m_ratio;
+}
+
+
+////////////////////////////////////////////////////////////
+Time Compressor::getAttack() const
+{
+    return m_attack;
+}
+
+
+////////////////////////////////////////////////////////////
+Time Compressor::getRelease() const
+{
+    return m_release;
+}
+
+
+////////////////////////////////////////////////////////////
+float Compressor::getMakeupGain() const
+{
+    return m_makeupGain;
+}
+
+
+////////////////////////////////////////////////////////////
+void Compressor::process(float* samples, std::size_t frameCount, unsigned int channelCount, unsigned int sampleRate)
+{
+    if ((channelCount == 0) || (sampleRate == 0))
+        return;
+
+    float threshold, slope, makeup, attack, release;
+    {
+        Lock lock(m_mutex);
+
+        threshold = m_threshold;
+        slope     = 1.f - 1.f / m_ratio;
+        makeup    = m_makeupGain;
+        attack    = getSmoothing(m_attack, sampleRate);
+        release   = getSmoothing(m_release, sampleRate);
+    }
+
+    for (std::size_t first = 0; first < frameCount; first += blockSize)
+    {
+        std::size_t count = std::min(blockSize, frameCount - first);
+        float* block = samples + first * channelCount;
+
+        // Follow the level of the input, faster when it rises than when it falls
+        float peak = priv::getPeak(block, count * channelCount);
+        float smoothing = (peak > m_envelope) ? attack : release;
+        m_envelope = peak + (m_envelope - peak) * smoothing;
+
+        // Reduce the part of the level above the threshold, and ramp to the new gain over the block
+        float level = 20.f * std::log10(std::max(m_envelope, 1e-6f));
+        float reduction = (level > threshold) ? (level - threshold) * slope : 0.f;
+        float gain = std::pow(10.f, (makeup - reduction) / 20.f);
+
+        priv::applyGain(block, count, channelCount, m_gain, gain);
+        m_gain = gain;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Compressor::reset()
+{
+    Lock lock(m_mutex);
+
+    m_envelope = 0.f;
+    m_gain = std::pow(10.f, m_makeupGain / 20.f);
+}
+
+} // namespace sf
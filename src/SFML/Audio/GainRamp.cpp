@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/GainRamp.hpp>
+#include <SFML/Audio/MixKernels.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+GainRamp::GainRamp(float gain) :
+m_mutex          (),
+m_target         (gain),
+m_current        (gain),
+m_duration       (Time::Zero),
+m_rampRequested  (false),
+m_remainingFrames(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void GainRamp::setGain(float gain, Time duration)
+{
+    Lock lock(m_mutex);
+
+    // The length of the ramp in frames is computed with the next block, which knows the sample rate
+    m_target = gain;
+    m_duration = duration;
+    m_rampRequested = true;
+}
+
+
+////////////////////////////////////////////////////////////
+float GainRamp::getGain() const
+{
+    return m_target;
+}
+
+
+////////////////////////////////////////////////////////////
+void GainRamp::process(float* samples, std::size_t frameCount, unsigned int channelCount, unsigned int sampleRate)
+{
+    float target;
+    {
+        Lock lock(m_mutex);
+
+        if (m_rampRequested)
+        {
+            m_remainingFrames = static_cast<std::size_t>(std::max(m_duration.asSeconds(), 0.f) * sampleRate);
+            m_rampRequested = false;
+        }
+
+        target = m_target;
+    }
+
+    // Ramp linearly towards the target, then hold it
+    if (m_remainingFrames > 0)
+    {
+        std::size_t count = std::min(frameCount, m_remainingFrames);
+        float end = m_current + (target - m_current) * count / m_remainingFrames;
+        priv::applyGain(samples, count, channelCount, m_current, end);
+
+        m_current = end;
+        m_remainingFrames -= count;
+        samples += count * channelCount;
+        frameCount -= count;
+    }
+
+    if (m_remainingFrames == 0)
+        m_current = target;
+
+    if ((frameCount > 0) && (m_current != 1.f))
+        priv::applyGain(samples, frameCount, channelCount, m_current, m_current);
+}
+
+
+////////////////////////////////////////////////////////////
+void GainRamp::reset()
+{
+    Lock lock(m_mutex);
+
+    m_current = m_target;
+    m_rampRequested = false;
+    m_remainingFrames = 0;
+}
+
+} // namespace sf
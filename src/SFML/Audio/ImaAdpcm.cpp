@@ -0,0 +1,205 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/ImaAdpcm.hpp>
+
+
+namespace
+{
+    const int indexTable[16] =
+    {
+        -1, -1, -1, -1, 2, 4, 6, 8,
+        -1, -1, -1, -1, 2, 4, 6, 8
+    };
+
+    const int stepTable[89] =
+    {
+        7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+        50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+        253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+        1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+        3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487,
+        12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+    };
+
+    // Apply a 4-bit code to the state of a channel, and return the new sample
+    int decodeCode(int code, int& predictor, int& index)
+    {
+        int step = stepTable[index];
+        int difference = step >> 3;
+        if (code & 1)
+            difference += step >> 2;
+        if (code & 2)
+            difference += step >> 1;
+        if (code & 4)
+            difference += step;
+        if (code & 8)
+            difference = -difference;
+
+        predictor += difference;
+        if (predictor > 32767)
+            predictor = 32767;
+        else if (predictor < -32768)
+            predictor = -32768;
+
+        index += indexTable[code];
+        if (index < 0)
+            index = 0;
+        else if (index > 88)
+            index = 88;
+
+        return predictor;
+    }
+
+    // Find the 4-bit code that gets the closest to a sample
+    int encodeCode(int sample, int predictor, int index)
+    {
+        int step = stepTable[index];
+        int difference = sample - predictor;
+
+        int code = 0;
+        if (difference < 0)
+        {
+            code = 8;
+            difference = -difference;
+        }
+
+        if (difference >= step)
+        {
+            code |= 4;
+            difference -= step;
+        }
+        if (difference >= step >> 1)
+        {
+            code |= 2;
+            difference -= step >> 1;
+        }
+        if (difference >= step >> 2)
+            code |= 1;
+
+        return code;
+    }
+
+    // Find the step index that best fits the first difference of a channel
+    int initialIndex(const sf::Int16* samples, std::size_t frameCount, unsigned int channelCount)
+    {
+        if (frameCount < 2)
+            return 0;
+
+        int difference = samples[channelCount] - samples[0];
+        if (difference < 0)
+            difference = -difference;
+
+        int index = 0;
+        while ((index < 88) && (stepTable[index] < difference))
+            ++index;
+
+        return index;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+std::size_t getImaAdpcmBlockSize(std::size_t frameCount, unsigned int channelCount)
+{
+    std::size_t codeBytes = frameCount > 0 ? frameCount / 2 : 0;
+    return channelCount * (4 + codeBytes);
+}
+
+
+////////////////////////////////////////////////////////////
+void encodeImaAdpcm(const Int16* samples, std::size_t frameCount, unsigned int channelCount, Uint8* block)
+{
+    if (frameCount == 0)
+        return;
+
+    std::size_t codeBytes = frameCount / 2;
+    Uint8* codes = block + channelCount * 4;
+
+    for (unsigned int channel = 0; channel < channelCount; ++channel)
+    {
+        // Header: the first sample is stored as is, with the step index to start from
+        int predictor = samples[channel];
+        int index = initialIndex(samples + channel, frameCount, channelCount);
+
+        Uint8* header = block + channel * 4;
+        header[0] = static_cast<Uint8>(predictor & 0xFF);
+        header[1] = static_cast<Uint8>((predictor >> 8) & 0xFF);
+        header[2] = static_cast<Uint8>(index);
+        header[3] = 0;
+
+        // Codes of the following samples, two per byte (low nibble first);
+        // the encoder tracks the decoder's state so that errors don't accumulate
+        Uint8* channelCodes = codes + channel * codeBytes;
+        for (std::size_t i = 1; i < frameCount; ++i)
+        {
+            int code = encodeCode(samples[i * channelCount + channel], predictor, index);
+            decodeCode(code, predictor, index);
+
+            std::size_t position = i - 1;
+            if (position % 2 == 0)
+                channelCodes[position / 2] = static_cast<Uint8>(code);
+            else
+                channelCodes[position / 2] |= static_cast<Uint8>(code << 4);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void decodeImaAdpcm(const Uint8* block, std::size_t frameCount, unsigned int channelCount, Int16* samples)
+{
+    if (frameCount == 0)
+        return;
+
+    std::size_t codeBytes = frameCount / 2;
+    const Uint8* codes = block + channelCount * 4;
+
+    for (unsigned int channel = 0; channel < channelCount; ++channel)
+    {
+        const Uint8* header = block + channel * 4;
+        int predictor = static_cast<Int16>(header[0] | (header[1] << 8));
+        int index = header[2] > 88 ? 88 : header[2];
+
+        samples[channel] = static_cast<Int16>(predictor);
+
+        const Uint8* channelCodes = codes + channel * codeBytes;
+        for (std::size_t i = 1; i < frameCount; ++i)
+        {
+            std::size_t position = i - 1;
+            int code = (channelCodes[position / 2] >> ((position % 2) * 4)) & 0x0F;
+            samples[i * channelCount + channel] = static_cast<Int16>(decodeCode(code, predictor, index));
+        }
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
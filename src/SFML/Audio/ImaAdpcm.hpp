@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef SFML_IMAADPCM_HPP
+#define SFML_IMAADPCM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Get the size of an IMA-ADPCM block
+///
+/// A block starts with a 4-byte header per channel (the
+/// first sample and the step index), followed by the 4-bit
+/// codes of the other samples of each channel in turn.
+///
+/// \param frameCount   Maximum number of frames in the block
+/// \param channelCount Number of channels
+///
+/// \return Size of the block, in bytes
+///
+////////////////////////////////////////////////////////////
+std::size_t getImaAdpcmBlockSize(std::size_t frameCount, unsigned int channelCount);
+
+////////////////////////////////////////////////////////////
+/// \brief Encode interleaved 16-bit samples to an IMA-ADPCM block
+///
+/// Each block is independent, so that decoding can start at
+/// any block.
+///
+/// \param samples      Interleaved samples to encode
+/// \param frameCount   Number of frames to encode
+/// \param channelCount Number of channels
+/// \param block        Block to fill, getImaAdpcmBlockSize(frameCount, channelCount) bytes
+///
+////////////////////////////////////////////////////////////
+void encodeImaAdpcm(const Int16* samples, std::size_t frameCount, unsigned int channelCount, Uint8* block);
+
+////////////////////////////////////////////////////////////
+/// \brief Decode an IMA-ADPCM block to interleaved 16-bit samples
+///
+/// \param block        Block to decode
+/// \param frameCount   Number of frames encoded in the block
+/// \param channelCount Number of channels
+/// \param samples      Array to fill with frameCount * channelCount samples
+///
+////////////////////////////////////////////////////////////
+void decodeImaAdpcm(const Uint8* block, std::size_t frameCount, unsigned int channelCount, Int16* samples);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_IMAADPCM_HPP
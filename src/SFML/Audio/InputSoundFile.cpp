@@ -32,6 +32,7 @@
 #include <SFML/System/FileInputStream.hpp>
 #include <SFML/System/MemoryInputStream.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 
 
 namespace sf
@@ -219,7 +220,9 @@ void InputSoundFile::seek(Uint64 sampleOffset)
 ////////////////////////////////////////////////////////////
 void InputSoundFile::seek(Time timeOffset)
 {
-    seek(static_cast<Uint64>(timeOffset.asSeconds() * m_sampleRate * m_channelCount));
+    // Compute the frame in integers, so that the offset is exact and never falls between two channels
+    Int64 frame = std::max(timeOffset.asMicroseconds(), Int64(0)) * m_sampleRate / 1000000;
+    seek(static_cast<Uint64>(frame) * m_channelCount);
 }
 
 
@@ -233,6 +236,16 @@ Uint64 InputSoundFile::read(Int16* samples, Uint64 maxCount)
 }
 
 
+////////////////////////////////////////////////////////////
+Uint64 InputSoundFile::read(float* samples, Uint64 maxCount)
+{
+    if (m_reader && samples && maxCount)
+        return m_reader->read(samples, maxCount);
+    else
+        return 0;
+}
+
+
 ////////////////////////////////////////////////////////////
 void InputSoundFile::close()
 {
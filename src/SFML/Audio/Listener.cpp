@@ -107,4 +107,18 @@ Vector3f Listener::getUpVector()
     return priv::AudioDevice::getUpVector();
 }
 
+
+////////////////////////////////////////////////////////////
+void Listener::beginUpdate()
+{
+    priv::AudioDevice::beginUpdate();
+}
+
+
+////////////////////////////////////////////////////////////
+void Listener::endUpdate()
+{
+    priv::AudioDevice::endUpdate();
+}
+
 } // namespace sf
@@ -0,0 +1,622 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/MixKernels.hpp>
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SFML_MIX_SSE2
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define SFML_MIX_NEON
+#endif
+
+
+namespace
+{
+    const float sampleScale = 1.f / 32768.f;
+
+    // Convert 16-bit samples to floats
+    void convertSamples(const sf::Int16* input, float* output, std::size_t count)
+    {
+        std::size_t i = 0;
+
+    #if defined(SFML_MIX_SSE2)
+
+        const __m128 scale = _mm_set1_ps(sampleScale);
+        for (; i + 8 <= count; i += 8)
+        {
+            // Sign-extend the samples by placing them in the upper half of 32-bit lanes
+            __m128i x  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+            __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+            __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+            _mm_storeu_ps(output + i,     _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+            _mm_storeu_ps(output + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+        }
+
+    #elif defined(SFML_MIX_NEON)
+
+        for (; i + 8 <= count; i += 8)
+        {
+            int16x8_t x = vld1q_s16(input + i);
+            vst1q_f32(output + i,     vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(x))), sampleScale));
+            vst1q_f32(output + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(x))), sampleScale));
+        }
+
+    #endif
+
+        for (; i < count; ++i)
+            output[i] = input[i] * sampleScale;
+    }
+
+    // Dot product of two arrays of floats, whose size is a multiple of 4
+    float dotProduct(const float* first, const float* second, std::size_t count)
+    {
+    #if defined(SFML_MIX_SSE2)
+
+        __m128 sum = _mm_setzero_ps();
+        for (std::size_t i = 0; i < count; i += 4)
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(first + i), _mm_loadu_ps(second + i)));
+
+        sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+        sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+        return _mm_cvtss_f32(sum);
+
+    #elif defined(SFML_MIX_NEON)
+
+        float32x4_t sum = vdupq_n_f32(0.f);
+        for (std::size_t i = 0; i < count; i += 4)
+            sum = vmlaq_f32(sum, vld1q_f32(first + i), vld1q_f32(second + i));
+
+        float32x2_t half = vadd_f32(vget_low_f32(sum), vget_high_f32(sum));
+        return vget_lane_f32(vpadd_f32(half, half), 0);
+
+    #else
+
+        float sum = 0.f;
+        for (std::size_t i = 0; i < count; ++i)
+            sum += first[i] * second[i];
+        return sum;
+
+    #endif
+    }
+
+    // Greatest common divisor, to reduce the ratio of the sample rates
+    unsigned int gcd(unsigned int a, unsigned int b)
+    {
+        while (b != 0)
+        {
+            unsigned int r = a % b;
+            a = b;
+            b = r;
+        }
+        return a;
+    }
+
+    const std::size_t  filterHalfLength = 32;  // Number of taps on each side of the filter
+    const std::size_t  filterLength = filterHalfLength * 2;
+    const unsigned int maxPhaseCount = 512;    // Phases stored when the reduced ratio is larger
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+std::size_t resample(const Int16* samples, std::size_t frameCount, unsigned int channelCount,
+                     double& position, double step, bool loop, float* output, std::size_t count)
+{
+    if ((frameCount == 0) || (channelCount == 0))
+        return 0;
+
+    std::size_t produced = 0;
+
+    if ((step == 1.0) && (position == std::floor(position)))
+    {
+        // Native rate: copy whole runs of frames until the end of the buffer
+        while (produced < count)
+        {
+            std::size_t index = static_cast<std::size_t>(position);
+            if (index >= frameCount)
+            {
+                if (!loop)
+                    break;
+                index %= frameCount;
+            }
+
+            std::size_t run = frameCount - index;
+            if (run > count - produced)
+                run = count - produced;
+
+            convertSamples(samples + index * channelCount, output + produced * channelCount, run * channelCount);
+            produced += run;
+            position = static_cast<double>(index + run);
+        }
+
+        return produced;
+    }
+
+    for (; produced < count; ++produced)
+    {
+        if (position >= frameCount)
+        {
+            if (!loop)
+                break;
+            position = std::fmod(position, static_cast<double>(frameCount));
+        }
+
+        // Interpolate between the current frame and the next one (the first one when looping)
+        std::size_t index = static_cast<std::size_t>(position);
+        std::size_t next  = (index + 1 < frameCount) ? index + 1 : (loop ? 0 : index);
+        float       t     = static_cast<float>(position - index);
+
+        const Int16* a = samples + index * channelCount;
+        const Int16* b = samples + next * channelCount;
+        float* out = output + produced * channelCount;
+        for (unsigned int c = 0; c < channelCount; ++c)
+            out[c] = (a[c] + (b[c] - a[c]) * t) * sampleScale;
+
+        position += step;
+    }
+
+    return produced;
+}
+
+
+////////////////////////////////////////////////////////////
+void mixMono(float* output, const float* input, std::size_t frameCount,
+             float leftStart, float rightStart, float leftEnd, float rightEnd)
+{
+    if (frameCount == 0)
+        return;
+
+    const float leftStep  = (leftEnd - leftStart) / frameCount;
+    const float rightStep = (rightEnd - rightStart) / frameCount;
+
+    std::size_t i = 0;
+
+#if defined(SFML_MIX_SSE2)
+
+    // Gains of frames (i, i + 1) and (i + 2, i + 3), as (left, right, left, right)
+    __m128 gains01 = _mm_setr_ps(leftStart, rightStart, leftStart + leftStep, rightStart + rightStep);
+    __m128 gains23 = _mm_add_ps(gains01, _mm_setr_ps(2 * leftStep, 2 * rightStep, 2 * leftStep, 2 * rightStep));
+    const __m128 steps = _mm_setr_ps(4 * leftStep, 4 * rightStep, 4 * leftStep, 4 * rightStep);
+
+    for (; i + 4 <= frameCount; i += 4)
+    {
+        // Duplicate every mono sample for both channels
+        __m128 x   = _mm_loadu_ps(input + i);
+        __m128 x01 = _mm_unpacklo_ps(x, x);
+        __m128 x23 = _mm_unpackhi_ps(x, x);
+
+        float* out = output + i * 2;
+        _mm_storeu_ps(out,     _mm_add_ps(_mm_loadu_ps(out),     _mm_mul_ps(x01, gains01)));
+        _mm_storeu_ps(out + 4, _mm_add_ps(_mm_loadu_ps(out + 4), _mm_mul_ps(x23, gains23)));
+
+        gains01 = _mm_add_ps(gains01, steps);
+        gains23 = _mm_add_ps(gains23, steps);
+    }
+
+#elif defined(SFML_MIX_NEON)
+
+    const float initial[4] = {leftStart, rightStart, leftStart + leftStep, rightStart + rightStep};
+    const float deltas[4]  = {2 * leftStep, 2 * rightStep, 2 * leftStep, 2 * rightStep};
+    float32x4_t gains01 = vld1q_f32(initial);
+    float32x4_t gains23 = vaddq_f32(gains01, vld1q_f32(deltas));
+    const float32x4_t steps = vaddq_f32(vld1q_f32(deltas), vld1q_f32(deltas));
+
+    for (; i + 4 <= frameCount; i += 4)
+    {
+        float32x4x2_t x = vzipq_f32(vld1q_f32(input + i), vld1q_f32(input + i));
+
+        float* out = output + i * 2;
+        vst1q_f32(out,     vmlaq_f32(vld1q_f32(out),     x.val[0], gains01));
+        vst1q_f32(out + 4, vmlaq_f32(vld1q_f32(out + 4), x.val[1], gains23));
+
+        gains01 = vaddq_f32(gains01, steps);
+        gains23 = vaddq_f32(gains23, steps);
+    }
+
+#endif
+
+    for (; i < frameCount; ++i)
+    {
+        output[i * 2]     += input[i] * (leftStart + leftStep * i);
+        output[i * 2 + 1] += input[i] * (rightStart + rightStep * i);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void mixStereo(float* output, const float* input, std::size_t frameCount,
+               float leftStart, float rightStart, float leftEnd, float rightEnd)
+{
+    if (frameCount == 0)
+        return;
+
+    const float leftStep  = (leftEnd - leftStart) / frameCount;
+    const float rightStep = (rightEnd - rightStart) / frameCount;
+
+    std::size_t i = 0;
+
+#if defined(SFML_MIX_SSE2)
+
+    __m128 gains01 = _mm_setr_ps(leftStart, rightStart, leftStart + leftStep, rightStart + rightStep);
+    __m128 gains23 = _mm_add_ps(gains01, _mm_setr_ps(2 * leftStep, 2 * rightStep, 2 * leftStep, 2 * rightStep));
+    const __m128 steps = _mm_setr_ps(4 * leftStep, 4 * rightStep, 4 * leftStep, 4 * rightStep);
+
+    for (; i + 4 <= frameCount; i += 4)
+    {
+        const float* in = input + i * 2;
+        float* out = output + i * 2;
+        _mm_storeu_ps(out,     _mm_add_ps(_mm_loadu_ps(out),     _mm_mul_ps(_mm_loadu_ps(in),     gains01)));
+        _mm_storeu_ps(out + 4, _mm_add_ps(_mm_loadu_ps(out + 4), _mm_mul_ps(_mm_loadu_ps(in + 4), gains23)));
+
+        gains01 = _mm_add_ps(gains01, steps);
+        gains23 = _mm_add_ps(gains23, steps);
+    }
+
+#elif defined(SFML_MIX_NEON)
+
+    const float initial[4] = {leftStart, rightStart, leftStart + leftStep, rightStart + rightStep};
+    const float deltas[4]  = {2 * leftStep, 2 * rightStep, 2 * leftStep, 2 * rightStep};
+    float32x4_t gains01 = vld1q_f32(initial);
+    float32x4_t gains23 = vaddq_f32(gains01, vld1q_f32(deltas));
+    const float32x4_t steps = vaddq_f32(vld1q_f32(deltas), vld1q_f32(deltas));
+
+    for (; i + 4 <= frameCount; i += 4)
+    {
+        const float* in = input + i * 2;
+        float* out = output + i * 2;
+        vst1q_f32(out,     vmlaq_f32(vld1q_f32(out),     vld1q_f32(in),     gains01));
+        vst1q_f32(out + 4, vmlaq_f32(vld1q_f32(out + 4), vld1q_f32(in + 4), gains23));
+
+        gains01 = vaddq_f32(gains01, steps);
+        gains23 = vaddq_f32(gains23, steps);
+    }
+
+#endif
+
+    for (; i < frameCount; ++i)
+    {
+        output[i * 2]     += input[i * 2]     * (leftStart + leftStep * i);
+        output[i * 2 + 1] += input[i * 2 + 1] * (rightStart + rightStep * i);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void convertSampleRate(const Int16* input, std::size_t frameCount, unsigned int channelCount,
+                       unsigned int inputRate, unsigned int outputRate, std::vector<Int16>& output)
+{
+    output.clear();
+    if ((frameCount == 0) || (channelCount == 0) || (inputRate == 0) || (outputRate == 0))
+        return;
+
+    if (inputRate == outputRate)
+    {
+        output.assign(input, input + frameCount * channelCount);
+        return;
+    }
+
+    // Output frame n is at position n * step / interpolation in the input
+    unsigned int divisor = gcd(inputRate, outputRate);
+    Uint64 interpolation = outputRate / divisor;
+    Uint64 step = inputRate / divisor;
+    unsigned int phaseCount = interpolation > maxPhaseCount ? maxPhaseCount : static_cast<unsigned int>(interpolation);
+
+    // Blackman-windowed sinc, cut a bit below the lowest of the two Nyquist frequencies;
+    // each phase is normalized so that constant signals keep their level
+    const double pi = 3.141592653589793;
+    double cutoff = 0.95 * (outputRate < inputRate ? static_cast<double>(outputRate) / inputRate : 1.0);
+    std::vector<float> filters(phaseCount * filterLength);
+    for (unsigned int phase = 0; phase < phaseCount; ++phase)
+    {
+        float* filter = &filters[phase * filterLength];
+        double fraction = static_cast<double>(phase) / phaseCount;
+        double sum = 0;
+        for (std::size_t k = 0; k < filterLength; ++k)
+        {
+            double t = static_cast<double>(k) - (filterHalfLength - 1) - fraction;
+            double x = pi * cutoff * t;
+            double sinc = (x == 0) ? 1.0 : std::sin(x) / x;
+            double w = (t + filterHalfLength) / filterLength;
+            double window = 0.42 - 0.5 * std::cos(2 * pi * w) + 0.08 * std::cos(4 * pi * w);
+            double value = (w > 0) && (w < 1) ? cutoff * sinc * window : 0.0;
+
+            filter[k] = static_cast<float>(value);
+            sum += value;
+        }
+
+        for (std::size_t k = 0; k < filterLength; ++k)
+            filter[k] = static_cast<float>(filter[k] / sum);
+    }
+
+    std::size_t outputFrameCount = static_cast<std::size_t>((frameCount * interpolation + step - 1) / step);
+    output.resize(outputFrameCount * channelCount);
+
+    // Filter each channel separately, converted to floats and padded with silence on both sides
+    std::vector<Int16> channelSamples(frameCount);
+    std::vector<float> padded(frameCount + filterLength * 2, 0.f);
+    for (unsigned int channel = 0; channel < channelCount; ++channel)
+    {
+        for (std::size_t i = 0; i < frameCount; ++i)
+            channelSamples[i] = input[i * channelCount + channel];
+        convertSamples(&channelSamples[0], &padded[filterLength], frameCount);
+
+        for (std::size_t n = 0; n < outputFrameCount; ++n)
+        {
+            Uint64 position = n * step;
+            std::size_t index = static_cast<std::size_t>(position / interpolation);
+            std::size_t phase = static_cast<std::size_t>((position % interpolation) * phaseCount / interpolation);
+
+            // The first tap applies to input frame index - (filterHalfLength - 1)
+            const float* samples = &padded[filterLength + index - (filterHalfLength - 1)];
+            float value = dotProduct(samples, &filters[phase * filterLength], filterLength) * 32768.f;
+
+            if (value > 32767.f)
+                value = 32767.f;
+            else if (value < -32768.f)
+                value = -32768.f;
+
+            output[n * channelCount + channel] = static_cast<Int16>(std::floor(value + 0.5f));
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void applyBiquad(float* samples, std::size_t frameCount, unsigned int channelCount,
+                 const float* coefficients, float* state)
+{
+    const float b0 = coefficients[0];
+    const float b1 = coefficients[1];
+    const float b2 = coefficients[2];
+    const float a1 = coefficients[3];
+    const float a2 = coefficients[4];
+
+    float* z1 = state;
+    float* z2 = state + 8;
+
+#if defined(SFML_MIX_SSE2)
+
+    if ((channelCount == 2) || (channelCount == 4) || (channelCount == 8))
+    {
+        const __m128 vb0 = _mm_set1_ps(b0);
+        const __m128 vb1 = _mm_set1_ps(b1);
+        const __m128 vb2 = _mm_set1_ps(b2);
+        const __m128 va1 = _mm_set1_ps(a1);
+        const __m128 va2 = _mm_set1_ps(a2);
+
+        // Each group of (up to) 4 channels is filtered in the lanes of a register
+        for (unsigned int group = 0; group < channelCount; group += 4)
+        {
+            __m128 s1 = _mm_loadu_ps(z1 + group);
+            __m128 s2 = _mm_loadu_ps(z2 + group);
+            float* frame = samples + group;
+
+            for (std::size_t i = 0; i < frameCount; ++i, frame += channelCount)
+            {
+                __m128 x = (channelCount == 2) ? _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(frame))) : _mm_loadu_ps(frame);
+                __m128 y = _mm_add_ps(_mm_mul_ps(vb0, x), s1);
+                s1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(vb1, x), _mm_mul_ps(va1, y)), s2);
+                s2 = _mm_sub_ps(_mm_mul_ps(vb2, x), _mm_mul_ps(va2, y));
+
+                if (channelCount == 2)
+                    _mm_store_sd(reinterpret_cast<double*>(frame), _mm_castps_pd(y));
+                else
+                    _mm_storeu_ps(frame, y);
+            }
+
+            _mm_storeu_ps(z1 + group, s1);
+            _mm_storeu_ps(z2 + group, s2);
+        }
+
+        return;
+    }
+
+#elif defined(SFML_MIX_NEON)
+
+    if ((channelCount == 4) || (channelCount == 8))
+    {
+        for (unsigned int group = 0; group < channelCount; group += 4)
+        {
+            float32x4_t s1 = vld1q_f32(z1 + group);
+            float32x4_t s2 = vld1q_f32(z2 + group);
+            float* frame = samples + group;
+
+            for (std::size_t i = 0; i < frameCount; ++i, frame += channelCount)
+            {
+                float32x4_t x = vld1q_f32(frame);
+                float32x4_t y = vmlaq_n_f32(s1, x, b0);
+                s1 = vmlsq_n_f32(vmlaq_n_f32(s2, x, b1), y, a1);
+                s2 = vmlsq_n_f32(vmulq_n_f32(x, b2), y, a2);
+                vst1q_f32(frame, y);
+            }
+
+            vst1q_f32(z1 + group, s1);
+            vst1q_f32(z2 + group, s2);
+        }
+
+        return;
+    }
+    else if (channelCount == 2)
+    {
+        float32x2_t s1 = vld1_f32(z1);
+        float32x2_t s2 = vld1_f32(z2);
+
+        for (std::size_t i = 0; i < frameCount; ++i)
+        {
+            float32x2_t x = vld1_f32(samples + i * 2);
+            float32x2_t y = vmla_n_f32(s1, x, b0);
+            s1 = vmls_n_f32(vmla_n_f32(s2, x, b1), y, a1);
+            s2 = vmls_n_f32(vmul_n_f32(x, b2), y, a2);
+            vst1_f32(samples + i * 2, y);
+        }
+
+        vst1_f32(z1, s1);
+        vst1_f32(z2, s2);
+        return;
+    }
+
+#endif
+
+    for (unsigned int c = 0; c < channelCount; ++c)
+    {
+        float s1 = z1[c];
+        float s2 = z2[c];
+        for (std::size_t i = 0; i < frameCount; ++i)
+        {
+            float& sample = samples[i * channelCount + c];
+            float x = sample;
+            float y = b0 * x + s1;
+            s1 = b1 * x - a1 * y + s2;
+            s2 = b2 * x - a2 * y;
+            sample = y;
+        }
+
+        z1[c] = s1;
+        z2[c] = s2;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void applyGain(float* samples, std::size_t frameCount, unsigned int channelCount, float startGain, float endGain)
+{
+    if ((frameCount == 0) || (channelCount == 0))
+        return;
+
+    const float step = (endGain - startGain) / frameCount;
+
+    // A constant gain doesn't depend on the layout of the frames
+    std::size_t count = (step == 0.f) ? frameCount * channelCount : frameCount;
+    unsigned int channels = (step == 0.f) ? 1 : channelCount;
+
+    std::size_t i = 0;
+
+#if defined(SFML_MIX_SSE2)
+
+    if (channels == 1)
+    {
+        __m128 gains = _mm_setr_ps(startGain, startGain + step, startGain + 2 * step, startGain + 3 * step);
+        const __m128 steps = _mm_set1_ps(4 * step);
+        for (; i + 4 <= count; i += 4)
+        {
+            _mm_storeu_ps(samples + i, _mm_mul_ps(_mm_loadu_ps(samples + i), gains));
+            gains = _mm_add_ps(gains, steps);
+        }
+    }
+    else if (channels == 2)
+    {
+        // Gains of frames (i, i + 1), as (left, right, left, right)
+        __m128 gains = _mm_setr_ps(startGain, startGain, startGain + step, startGain + step);
+        const __m128 steps = _mm_set1_ps(2 * step);
+        for (; i + 2 <= count; i += 2)
+        {
+            _mm_storeu_ps(samples + i * 2, _mm_mul_ps(_mm_loadu_ps(samples + i * 2), gains));
+            gains = _mm_add_ps(gains, steps);
+        }
+    }
+
+#elif defined(SFML_MIX_NEON)
+
+    if (channels == 1)
+    {
+        const float initial[4] = {startGain, startGain + step, startGain + 2 * step, startGain + 3 * step};
+        float32x4_t gains = vld1q_f32(initial);
+        const float32x4_t steps = vdupq_n_f32(4 * step);
+        for (; i + 4 <= count; i += 4)
+        {
+            vst1q_f32(samples + i, vmulq_f32(vld1q_f32(samples + i), gains));
+            gains = vaddq_f32(gains, steps);
+        }
+    }
+    else if (channels == 2)
+    {
+        const float initial[4] = {startGain, startGain, startGain + step, startGain + step};
+        float32x4_t gains = vld1q_f32(initial);
+        const float32x4_t steps = vdupq_n_f32(2 * step);
+        for (; i + 2 <= count; i += 2)
+        {
+            vst1q_f32(samples + i * 2, vmulq_f32(vld1q_f32(samples + i * 2), gains));
+            gains = vaddq_f32(gains, steps);
+        }
+    }
+
+#endif
+
+    for (; i < count; ++i)
+    {
+        float gain = startGain + step * i;
+        for (unsigned int c = 0; c < channels; ++c)
+            samples[i * channels + c] *= gain;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+float getPeak(const float* samples, std::size_t count)
+{
+    float peak = 0.f;
+    std::size_t i = 0;
+
+#if defined(SFML_MIX_SSE2)
+
+    // Clearing the sign bit gives the absolute value
+    const __m128 mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    __m128 peaks = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4)
+        peaks = _mm_max_ps(peaks, _mm_and_ps(_mm_loadu_ps(samples + i), mask));
+
+    peaks = _mm_max_ps(peaks, _mm_movehl_ps(peaks, peaks));
+    peaks = _mm_max_ss(peaks, _mm_shuffle_ps(peaks, peaks, 1));
+    peak = _mm_cvtss_f32(peaks);
+
+#elif defined(SFML_MIX_NEON)
+
+    float32x4_t peaks = vdupq_n_f32(0.f);
+    for (; i + 4 <= count; i += 4)
+        peaks = vmaxq_f32(peaks, vabsq_f32(vld1q_f32(samples + i)));
+
+    float32x2_t half = vpmax_f32(vget_low_f32(peaks), vget_high_f32(peaks));
+    peak = vget_lane_f32(vpmax_f32(half, half), 0);
+
+#endif
+
+    for (; i < count; ++i)
+        peak = std::max(peak, std::fabs(samples[i]));
+
+    return peak;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,168 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_MIXKERNELS_HPP
+#define SFML_MIXKERNELS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Read samples of a buffer at a given playback rate
+///
+/// Samples are converted to floats in [-1, 1] and linearly
+/// interpolated, unless \a step is exactly 1 and \a position
+/// falls on a frame, in which case they are only converted
+/// (with SSE2 or NEON instructions when available).
+///
+/// \param samples      Interleaved 16-bit samples of the buffer
+/// \param frameCount   Number of frames in the buffer
+/// \param channelCount Number of channels of the buffer
+/// \param position     Position of the next frame to read, updated by the function
+/// \param step         Number of buffer frames to advance per output frame
+/// \param loop         Wrap around at the end of the buffer instead of stopping
+/// \param output       Array to fill with \a count frames of \a channelCount floats
+/// \param count        Number of frames to produce
+///
+/// \return Number of frames actually produced (less than \a count
+///         if the end of a non-looping buffer was reached)
+///
+////////////////////////////////////////////////////////////
+std::size_t resample(const Int16* samples, std::size_t frameCount, unsigned int channelCount,
+                     double& position, double step, bool loop, float* output, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Add mono samples to a stereo mix
+///
+/// Gains are linearly interpolated from their start to their
+/// end value over the block, so that volume and panning
+/// changes don't produce clicks.
+///
+/// \param output     Interleaved stereo samples to add to
+/// \param input      Mono samples to add
+/// \param frameCount Number of frames to mix
+/// \param leftStart  Gain of the left channel at the first frame
+/// \param rightStart Gain of the right channel at the first frame
+/// \param leftEnd    Gain of the left channel after the last frame
+/// \param rightEnd   Gain of the right channel after the last frame
+///
+////////////////////////////////////////////////////////////
+void mixMono(float* output, const float* input, std::size_t frameCount,
+             float leftStart, float rightStart, float leftEnd, float rightEnd);
+
+////////////////////////////////////////////////////////////
+/// \brief Add stereo samples to a stereo mix
+///
+/// \param output     Interleaved stereo samples to add to
+/// \param input      Interleaved stereo samples to add
+/// \param frameCount Number of frames to mix
+/// \param leftStart  Gain of the left channel at the first frame
+/// \param rightStart Gain of the right channel at the first frame
+/// \param leftEnd    Gain of the left channel after the last frame
+/// \param rightEnd   Gain of the right channel after the last frame
+///
+/// \see mixMono
+///
+////////////////////////////////////////////////////////////
+void mixStereo(float* output, const float* input, std::size_t frameCount,
+               float leftStart, float rightStart, float leftEnd, float rightEnd);
+
+////////////////////////////////////////////////////////////
+/// \brief Convert samples to another sample rate, offline
+///
+/// This is a polyphase windowed-sinc resampler, of much higher
+/// quality (and cost) than the linear interpolation of resample:
+/// it is meant to convert buffers once, when they are loaded.
+/// The dot products of the filter use SSE2 or NEON instructions
+/// when available.
+///
+/// \param input        Interleaved samples to convert
+/// \param frameCount   Number of frames in \a input
+/// \param channelCount Number of channels
+/// \param inputRate    Sample rate of \a input
+/// \param outputRate   Sample rate to convert to
+/// \param output       Array to fill with the converted interleaved samples
+///
+////////////////////////////////////////////////////////////
+void convertSampleRate(const Int16* input, std::size_t frameCount, unsigned int channelCount,
+                       unsigned int inputRate, unsigned int outputRate, std::vector<Int16>& output);
+
+////////////////////////////////////////////////////////////
+/// \brief Run a biquad filter over interleaved samples, in place
+///
+/// The filter is computed in transposed direct form II, with
+/// the channels of a frame in the lanes of SSE2 or NEON
+/// registers when there are 2, 4 or 8 of them.
+///
+/// \param samples      Interleaved samples to filter
+/// \param frameCount   Number of frames to filter
+/// \param channelCount Number of channels (at most 8)
+/// \param coefficients Normalized coefficients b0, b1, b2, a1 and a2
+/// \param state        Delays of the filter: z1 of the 8 channels, then their z2, updated by the function
+///
+////////////////////////////////////////////////////////////
+void applyBiquad(float* samples, std::size_t frameCount, unsigned int channelCount,
+                 const float* coefficients, float* state);
+
+////////////////////////////////////////////////////////////
+/// \brief Multiply interleaved samples by a gain, in place
+///
+/// The gain is linearly interpolated from its start to its
+/// end value over the block, like in mixMono.
+///
+/// \param samples      Interleaved samples to scale
+/// \param frameCount   Number of frames to scale
+/// \param channelCount Number of channels
+/// \param startGain    Gain at the first frame
+/// \param endGain      Gain after the last frame
+///
+////////////////////////////////////////////////////////////
+void applyGain(float* samples, std::size_t frameCount, unsigned int channelCount, float startGain, float endGain);
+
+////////////////////////////////////////////////////////////
+/// \brief Get the highest absolute value of an array of samples
+///
+/// \param samples Samples to scan
+/// \param count   Number of samples
+///
+/// \return Peak value of the samples
+///
+////////////////////////////////////////////////////////////
+float getPeak(const float* samples, std::size_t count);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_MIXKERNELS_HPP
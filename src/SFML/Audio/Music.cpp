@@ -28,7 +28,10 @@
 #include <SFML/Audio/Music.hpp>
 #include <SFML/Audio/ALCheck.hpp>
 #include <SFML/System/Lock.hpp>
+#include <SFML/System/MappedFileInputStream.hpp>
+#include <SFML/System/MemoryInputStream.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <fstream>
 
 
@@ -36,8 +39,24 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 Music::Music() :
-m_file    (),
-m_duration()
+m_fileSource      (),
+m_shadowFileSource(),
+m_buffer          (),
+m_shadowBuffer    (),
+m_file            (),
+m_shadowFile      (),
+m_decoder         (&m_file),
+m_shadow          (&m_shadowFile),
+m_shadowOpen      (false),
+m_shadowReady     (false),
+m_filename        (),
+m_data            (NULL),
+m_dataSize        (0),
+m_position        (0),
+m_loopBegin       (0),
+m_loopEnd         (0),
+m_duration        (),
+m_chunkDuration   (seconds(1))
 {
 
 }
@@ -57,10 +76,15 @@ bool Music::openFromFile(const std::string& filename)
     // First stop the music if it was already running
     stop();
 
-    // Open the underlying sound file
-    if (!m_file.openFromFile(filename))
+    // Open the underlying sound file, read ahead so that the streaming thread doesn't wait for the disk
+    if (!openBuffered(m_file, m_fileSource, m_buffer, filename))
         return false;
 
+    // Remember the source, to open the shadow decoder later
+    m_filename = filename;
+    m_data = NULL;
+    m_dataSize = 0;
+
     // Perform common initializations
     initialize();
 
@@ -74,10 +98,16 @@ bool Music::openFromMemory(const void* data, std::size_t sizeInBytes)
     // First stop the music if it was already running
     stop();
 
-    // Open the underlying sound file
+    // Open the underlying sound file (there's no need to read memory ahead)
+    m_buffer.close();
     if (!m_file.openFromMemory(data, sizeInBytes))
         return false;
 
+    // Remember the source, to open the shadow decoder later
+    m_filename.clear();
+    m_data = data;
+    m_dataSize = sizeInBytes;
+
     // Perform common initializations
     initialize();
 
@@ -91,10 +121,25 @@ bool Music::openFromStream(InputStream& stream)
     // First stop the music if it was already running
     stop();
 
-    // Open the underlying sound file
-    if (!m_file.openFromStream(stream))
+    // A mapped file is in memory: play it like a music opened from memory
+    MappedFileInputStream* mapping = dynamic_cast<MappedFileInputStream*>(&stream);
+    if (mapping && mapping->getData())
+        return openFromMemory(mapping->getData(), static_cast<std::size_t>(mapping->getSize()));
+
+    // Open the underlying sound file, read ahead unless it is already in memory
+    m_buffer.close();
+    InputStream* source = &stream;
+    if (!dynamic_cast<MemoryInputStream*>(&stream) && m_buffer.open(stream))
+        source = &m_buffer;
+
+    if (!m_file.openFromStream(*source))
         return false;
 
+    // A stream can't be read by two decoders: the loop will seek instead
+    m_filename.clear();
+    m_data = NULL;
+    m_dataSize = 0;
+
     // Perform common initializations
     initialize();
 
@@ -109,16 +154,89 @@ Time Music::getDuration() const
 }
 
 
+////////////////////////////////////////////////////////////
+void Music::setChunkDuration(Time duration)
+{
+    Lock lock(m_mutex);
+
+    // The buffer is resized by the streaming thread, as it may still be in use
+    m_chunkDuration = duration;
+}
+
+
+////////////////////////////////////////////////////////////
+Time Music::getChunkDuration() const
+{
+    return m_chunkDuration;
+}
+
+
+////////////////////////////////////////////////////////////
+void Music::setLoopPoints(Time begin, Time length)
+{
+    Lock lock(m_mutex);
+
+    // Clamp the loop to the music, an empty loop means the whole music
+    Uint64 sampleCount = m_file.getSampleCount();
+    Uint64 loopBegin = std::min(timeToSamples(begin), sampleCount);
+    Uint64 loopEnd = std::min(loopBegin + timeToSamples(length), sampleCount);
+    if (loopEnd <= loopBegin)
+    {
+        loopBegin = 0;
+        loopEnd = sampleCount;
+    }
+
+    // The shadow decoder must be prepared again if the loop moved
+    if (loopBegin != m_loopBegin)
+        m_shadowReady = false;
+
+    m_loopBegin = loopBegin;
+    m_loopEnd = loopEnd;
+}
+
+
+////////////////////////////////////////////////////////////
+Time Music::getLoopBegin() const
+{
+    return samplesToTime(m_loopBegin);
+}
+
+
+////////////////////////////////////////////////////////////
+Time Music::getLoopLength() const
+{
+    return samplesToTime(m_loopEnd - m_loopBegin);
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Music::onGetData(SoundStream::Chunk& data)
 {
     Lock lock(m_mutex);
 
+    // Apply the latest chunk duration
+    resizeChunk();
+
+    // Stop reading at the end of the loop, if we are before it
+    std::size_t toRead = m_samples.size();
+    bool looping = getLoop() && (m_position <= m_loopEnd);
+    if (looping)
+    {
+        toRead = static_cast<std::size_t>(std::min<Uint64>(toRead, m_loopEnd - m_position));
+
+        // Prepare the beginning of the loop while the queue is still full
+        prepareShadow();
+    }
+
     // Fill the chunk parameters
     data.samples     = &m_samples[0];
-    data.sampleCount = static_cast<std::size_t>(m_file.read(&m_samples[0], m_samples.size()));
+    data.sampleCount = static_cast<std::size_t>(m_decoder->read(&m_samples[0], toRead));
+    m_position += data.sampleCount;
+
+    // Check if we have reached the end of the loop or of the audio file
+    if (looping && (m_position >= m_loopEnd))
+        return false;
 
-    // Check if we have reached the end of the audio file
     return data.sampleCount == m_samples.size();
 }
 
@@ -128,7 +246,37 @@ void Music::onSeek(Time timeOffset)
 {
     Lock lock(m_mutex);
 
-    m_file.seek(timeOffset);
+    m_decoder->seek(timeOffset);
+    m_position = std::min(timeToSamples(timeOffset), m_decoder->getSampleCount());
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 Music::onLoop()
+{
+    Lock lock(m_mutex);
+
+    if (getLoop() && (m_position == m_loopEnd))
+    {
+        // End of the loop: continue with the decoder already waiting at its beginning, if any
+        if (m_shadowReady)
+        {
+            std::swap(m_decoder, m_shadow);
+            m_shadowReady = false;
+        }
+        else
+        {
+            m_decoder->seek(m_loopBegin);
+        }
+
+        m_position = m_loopBegin;
+        return static_cast<Int64>(m_loopBegin);
+    }
+
+    // End of the music after the loop (the position was moved past it): start again
+    m_decoder->seek(static_cast<Uint64>(0));
+    m_position = 0;
+    return 0;
 }
 
 
@@ -138,11 +286,100 @@ void Music::initialize()
     // Compute the music duration
     m_duration = m_file.getDuration();
 
-    // Resize the internal buffer so that it can contain 1 second of audio samples
-    m_samples.resize(m_file.getSampleRate() * m_file.getChannelCount());
+    // Read from the main file, and loop over the whole music by default
+    {
+        Lock lock(m_mutex);
+        m_shadowBuffer.close();
+        m_decoder = &m_file;
+        m_shadow = &m_shadowFile;
+        m_shadowOpen = false;
+        m_shadowReady = false;
+        m_position = 0;
+        m_loopBegin = 0;
+        m_loopEnd = m_file.getSampleCount();
+    }
+
+    // Resize the internal buffer so that it can contain a chunk of audio samples
+    {
+        Lock lock(m_mutex);
+        resizeChunk();
+    }
 
     // Initialize the stream
     SoundStream::initialize(m_file.getChannelCount(), m_file.getSampleRate());
 }
 
+
+////////////////////////////////////////////////////////////
+void Music::resizeChunk()
+{
+    // Keep at least one sample per channel, and whole frames
+    std::size_t frames = static_cast<std::size_t>(m_chunkDuration.asSeconds() * m_file.getSampleRate());
+    m_samples.resize(std::max<std::size_t>(frames, 1) * m_file.getChannelCount());
+}
+
+
+////////////////////////////////////////////////////////////
+void Music::prepareShadow()
+{
+    if (m_shadowReady)
+        return;
+
+    // Open the second decoder on the same source, if it isn't already (streams can't be shared)
+    if (!m_shadowOpen)
+    {
+        if (!m_filename.empty())
+            m_shadowOpen = openBuffered(*m_shadow, m_shadowFileSource, m_shadowBuffer, m_filename);
+        else if (m_data)
+            m_shadowOpen = m_shadow->openFromMemory(m_data, m_dataSize);
+
+        // Don't try again on every chunk: the loop will seek instead
+        if (!m_shadowOpen)
+        {
+            m_filename.clear();
+            m_data = NULL;
+            return;
+        }
+    }
+
+    m_shadow->seek(m_loopBegin);
+    m_shadowReady = true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Music::openBuffered(InputSoundFile& decoder, FileInputStream& source, BufferedInputStream& buffer, const std::string& filename)
+{
+    // The read-ahead thread must stop using the previous file before it is closed
+    buffer.close();
+
+    if (!source.open(filename))
+    {
+        err() << "Failed to open music file \"" << filename << "\"" << std::endl;
+        return false;
+    }
+
+    return buffer.open(source) && decoder.openFromStream(buffer);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Music::timeToSamples(Time offset) const
+{
+    // Round to the nearest sample frame
+    Int64 frames = (offset.asMicroseconds() * m_file.getSampleRate() + 500000) / 1000000;
+    return static_cast<Uint64>(std::max<Int64>(frames, 0)) * m_file.getChannelCount();
+}
+
+
+////////////////////////////////////////////////////////////
+Time Music::samplesToTime(Uint64 samples) const
+{
+    if ((m_file.getSampleRate() == 0) || (m_file.getChannelCount() == 0))
+        return Time::Zero;
+
+    Uint64 frames = samples / m_file.getChannelCount();
+    return microseconds(static_cast<Int64>(frames * 1000000 / m_file.getSampleRate()));
+}
+
 } // namespace sf
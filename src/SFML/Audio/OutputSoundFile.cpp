@@ -35,7 +35,8 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 OutputSoundFile::OutputSoundFile() :
-m_writer(NULL)
+m_writer   (NULL),
+m_scheduler(NULL)
 {
 }
 
@@ -63,6 +64,7 @@ bool OutputSoundFile::openFromFile(const std::string& filename, unsigned int sam
     }
 
     // Pass the stream to the reader
+    m_writer->setTaskScheduler(m_scheduler);
     if (!m_writer->open(filename, sampleRate, channelCount))
     {
         close();
@@ -73,6 +75,13 @@ bool OutputSoundFile::openFromFile(const std::string& filename, unsigned int sam
 }
 
 
+////////////////////////////////////////////////////////////
+void OutputSoundFile::setTaskScheduler(TaskScheduler* scheduler)
+{
+    m_scheduler = scheduler;
+}
+
+
 ////////////////////////////////////////////////////////////
 void OutputSoundFile::write(const Int16* samples, Uint64 count)
 {
@@ -27,34 +27,171 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Sound.hpp>
 #include <SFML/Audio/SoundBuffer.hpp>
+#include <SFML/Audio/SoundMixer.hpp>
+#include <SFML/Audio/Listener.hpp>
 #include <SFML/Audio/ALCheck.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+
+
+namespace
+{
+    // Voices (OpenAL sources) shared by all the sounds, and their mutex
+    sf::Mutex                 voiceMutex;
+    std::vector<unsigned int> freeVoices;
+    std::vector<sf::Sound*>   activeSounds;  // Sounds which own a voice
+    std::vector<sf::Sound*>   virtualSounds; // Sounds which play or are paused without voice
+    std::vector<sf::Sound*>   sounds;        // All the sounds, to update their statuses at once
+    unsigned int              voiceCount    = 0;
+    unsigned int              maxVoiceCount = 64;
+    unsigned int              soundCount    = 0;
+    sf::Uint64                voiceSteals   = 0;
+    bool                      statusCaching = false;
+
+    // Number of sources left to the streams when the device runs out of sources
+    const unsigned int reservedSources = 4;
+
+    // Remove a sound from one of the lists above
+    void removeSound(std::vector<sf::Sound*>& sounds, sf::Sound* sound)
+    {
+        std::vector<sf::Sound*>::iterator it = std::find(sounds.begin(), sounds.end(), sound);
+        if (it != sounds.end())
+        {
+            *it = sounds.back();
+            sounds.pop_back();
+        }
+    }
+
+    // Create voices until the requested count is reached
+    void createVoices()
+    {
+        unsigned int created = 0;
+        while (voiceCount < maxVoiceCount)
+        {
+            alGetError();
+            ALuint source = 0;
+            alGenSources(1, &source);
+            if (alGetError() != AL_NO_ERROR)
+            {
+                // The device is full: give a few sources back, for the streams
+                for (unsigned int i = 0; (i < reservedSources) && (created > 0); ++i, --created, --voiceCount)
+                {
+                    alCheck(alDeleteSources(1, &freeVoices.back()));
+                    freeVoices.pop_back();
+                }
+
+                sf::err() << "Failed to create " << maxVoiceCount << " sound voices, only "
+                          << voiceCount << " are available" << std::endl;
+                maxVoiceCount = voiceCount;
+                break;
+            }
+
+            freeVoices.push_back(source);
+            ++voiceCount;
+            ++created;
+        }
+    }
+
+    // Give a voice back to the pool, or destroy it if there are too many
+    void releaseVoice(unsigned int voice)
+    {
+        if (voiceCount > maxVoiceCount)
+        {
+            alCheck(alDeleteSources(1, &voice));
+            --voiceCount;
+        }
+        else
+        {
+            freeVoices.push_back(voice);
+        }
+    }
+
+    // Check whether a sound is more important than another one
+    bool isMoreImportant(int priority, float audibility, int otherPriority, float otherAudibility)
+    {
+        return (priority > otherPriority) || ((priority == otherPriority) && (audibility > otherAudibility));
+    }
+}
 
 
 namespace sf
 {
+////////////////////////////////////////////////////////////
+Sound::VoiceStatistics::VoiceStatistics() :
+voices       (0),
+busyVoices   (0),
+sounds       (0),
+virtualSounds(0),
+voiceSteals  (0)
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 Sound::Sound() :
-m_buffer(NULL)
+m_buffer       (NULL),
+m_loop         (false),
+m_priority     (0),
+m_virtualStatus(Stopped),
+m_status       (Stopped),
+m_virtualOffset(0),
+m_mixer        (NULL)
 {
+    Lock lock(voiceMutex);
+
+    // Create the voices with the first sound
+    if (soundCount++ == 0)
+        createVoices();
+    sounds.push_back(this);
 }
 
 
 ////////////////////////////////////////////////////////////
 Sound::Sound(const SoundBuffer& buffer) :
-m_buffer(NULL)
+m_buffer       (NULL),
+m_loop         (false),
+m_priority     (0),
+m_virtualStatus(Stopped),
+m_status       (Stopped),
+m_virtualOffset(0),
+m_mixer        (NULL)
 {
+    {
+        Lock lock(voiceMutex);
+        if (soundCount++ == 0)
+            createVoices();
+        sounds.push_back(this);
+    }
+
     setBuffer(buffer);
 }
 
 
 ////////////////////////////////////////////////////////////
 Sound::Sound(const Sound& copy) :
-SoundSource(copy),
-m_buffer   (NULL)
+SoundSource    (copy),
+m_buffer       (NULL),
+m_loop         (copy.m_loop),
+m_priority     (copy.m_priority),
+m_virtualStatus(Stopped),
+m_status       (Stopped),
+m_virtualOffset(0),
+m_mixer        (NULL)
 {
+    {
+        Lock lock(voiceMutex);
+        if (soundCount++ == 0)
+            createVoices();
+        sounds.push_back(this);
+    }
+
     if (copy.m_buffer)
         setBuffer(*copy.m_buffer);
-    setLoop(copy.getLoop());
+    setMixer(copy.m_mixer);
 }
 
 
@@ -64,27 +201,111 @@ Sound::~Sound()
     stop();
     if (m_buffer)
         m_buffer->detachSound(this);
+    if (m_mixer)
+        m_mixer->detachSound(this);
+
+    Lock lock(voiceMutex);
+
+    removeSound(sounds, this);
+
+    // Destroy the voices with the last sound, while the audio device still exists
+    if (--soundCount == 0)
+    {
+        for (std::vector<unsigned int>::iterator it = freeVoices.begin(); it != freeVoices.end(); ++it)
+        {
+            alCheck(alDeleteSources(1, &*it));
+        }
+        freeVoices.clear();
+        voiceCount = 0;
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 void Sound::play()
 {
-    alCheck(alSourcePlay(m_source));
+    if (!m_buffer)
+        return;
+
+    if (m_mixer)
+    {
+        m_mixer->playSound(*this);
+        return;
+    }
+
+    Lock lock(voiceMutex);
+
+    m_status = Playing;
+
+    if (m_source)
+    {
+        alCheck(alSourcePlay(m_source));
+        return;
+    }
+
+    // Start or resume the playback virtually, then look for a voice
+    if (m_virtualStatus == Stopped)
+        virtualSounds.push_back(this);
+    if (m_virtualStatus != Paused)
+        m_virtualOffset = 0;
+    m_virtualStatus = Playing;
+    m_virtualClock.restart();
+
+    // Let the other waiting sounds use the voices freed since the last check first
+    restoreVirtualSounds();
+    if (!m_source)
+        acquireVoice(*this);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Sound::pause()
 {
-    alCheck(alSourcePause(m_source));
+    if (m_mixer)
+    {
+        m_mixer->pauseSound(*this);
+        return;
+    }
+
+    Lock lock(voiceMutex);
+
+    if (m_status == Playing)
+        m_status = Paused;
+
+    if (m_source)
+    {
+        alCheck(alSourcePause(m_source));
+    }
+    else if (m_virtualStatus == Playing)
+    {
+        m_virtualOffset = getVirtualOffset();
+        m_virtualStatus = Paused;
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 void Sound::stop()
 {
-    alCheck(alSourceStop(m_source));
+    if (m_mixer)
+    {
+        m_mixer->stopSound(*this);
+        return;
+    }
+
+    Lock lock(voiceMutex);
+
+    m_status = Stopped;
+
+    if (m_source)
+        releaseVoice(detachVoice());
+
+    if (m_virtualStatus != Stopped)
+        removeSound(virtualSounds, this);
+    m_virtualStatus = Stopped;
+    m_virtualOffset = 0;
+
+    restoreVirtualSounds();
 }
 
 
@@ -98,24 +319,52 @@ void Sound::setBuffer(const SoundBuffer& buffer)
         m_buffer->detachSound(this);
     }
 
-    // Assign and use the new buffer
+    // Assign the new buffer, it will be bound to the voice when the sound is played
     m_buffer = &buffer;
     m_buffer->attachSound(this);
-    alCheck(alSourcei(m_source, AL_BUFFER, m_buffer->m_buffer));
 }
 
 
 ////////////////////////////////////////////////////////////
 void Sound::setLoop(bool loop)
 {
-    alCheck(alSourcei(m_source, AL_LOOPING, loop));
+    Lock lock(voiceMutex);
+
+    // Keep the virtual position consistent with the previous looping state
+    if (m_virtualStatus == Playing)
+    {
+        m_virtualOffset = getVirtualOffset();
+        m_virtualClock.restart();
+    }
+
+    m_loop = loop;
+    if (m_source)
+    {
+        alCheck(alSourcei(m_source, AL_LOOPING, loop));
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 void Sound::setPlayingOffset(Time timeOffset)
 {
-    alCheck(alSourcef(m_source, AL_SEC_OFFSET, timeOffset.asSeconds()));
+    if (m_mixer)
+    {
+        m_mixer->setSoundOffset(*this, timeOffset);
+        return;
+    }
+
+    Lock lock(voiceMutex);
+
+    if (m_source)
+    {
+        alCheck(alSourcef(m_source, AL_SEC_OFFSET, timeOffset.asSeconds()));
+    }
+    else if (m_buffer && (m_virtualStatus != Stopped))
+    {
+        m_virtualOffset = static_cast<Uint64>(std::max(timeOffset.asMicroseconds(), Int64(0))) * m_buffer->getSampleRate() / 1000000;
+        m_virtualClock.restart();
+    }
 }
 
 
@@ -129,27 +378,175 @@ const SoundBuffer* Sound::getBuffer() const
 ////////////////////////////////////////////////////////////
 bool Sound::getLoop() const
 {
-    ALint loop;
-    alCheck(alGetSourcei(m_source, AL_LOOPING, &loop));
-
-    return loop != 0;
+    return m_loop;
 }
 
 
 ////////////////////////////////////////////////////////////
 Time Sound::getPlayingOffset() const
 {
-    ALfloat secs = 0.f;
-    alCheck(alGetSourcef(m_source, AL_SEC_OFFSET, &secs));
+    if (m_mixer)
+        return m_mixer->getSoundOffset(*this);
+
+    Lock lock(voiceMutex);
+
+    if (m_source)
+    {
+        ALfloat secs = 0.f;
+        alCheck(alGetSourcef(m_source, AL_SEC_OFFSET, &secs));
 
-    return seconds(secs);
+        return seconds(secs);
+    }
+
+    if (!m_buffer || (m_virtualStatus == Stopped))
+        return Time::Zero;
+
+    Uint64 frameCount = m_buffer->getSampleCount() / m_buffer->getChannelCount();
+    Uint64 offset = getVirtualOffset();
+    if (offset >= frameCount)
+    {
+        if (!m_loop || (frameCount == 0))
+            return Time::Zero;
+        offset %= frameCount;
+    }
+
+    return microseconds(static_cast<Int64>(offset * 1000000 / m_buffer->getSampleRate()));
 }
 
 
 ////////////////////////////////////////////////////////////
 Sound::Status Sound::getStatus() const
 {
-    return SoundSource::getStatus();
+    if (m_mixer)
+        return m_mixer->getSoundStatus(*this);
+
+    Lock lock(voiceMutex);
+
+    return statusCaching ? m_status : computeStatus();
+}
+
+
+////////////////////////////////////////////////////////////
+void Sound::setPriority(int priority)
+{
+    m_priority = priority;
+}
+
+
+////////////////////////////////////////////////////////////
+int Sound::getPriority() const
+{
+    return m_priority;
+}
+
+
+////////////////////////////////////////////////////////////
+void Sound::setVoiceCount(unsigned int count)
+{
+    Lock lock(voiceMutex);
+
+    maxVoiceCount = std::max(count, 1u);
+
+    if (soundCount > 0)
+    {
+        // Destroy the free voices in excess, the busy ones will be destroyed when released
+        while ((voiceCount > maxVoiceCount) && !freeVoices.empty())
+        {
+            alCheck(alDeleteSources(1, &freeVoices.back()));
+            freeVoices.pop_back();
+            --voiceCount;
+        }
+
+        // Create the missing voices, and give them to the waiting sounds
+        createVoices();
+        restoreVirtualSounds();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Sound::getVoiceCount()
+{
+    Lock lock(voiceMutex);
+
+    return maxVoiceCount;
+}
+
+
+////////////////////////////////////////////////////////////
+Sound::VoiceStatistics Sound::getVoiceStatistics()
+{
+    Lock lock(voiceMutex);
+
+    VoiceStatistics statistics;
+    statistics.voices        = voiceCount;
+    statistics.busyVoices    = static_cast<unsigned int>(activeSounds.size());
+    statistics.sounds        = soundCount;
+    statistics.virtualSounds = static_cast<unsigned int>(virtualSounds.size());
+    statistics.voiceSteals   = voiceSteals;
+
+    return statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Sound::updateStatuses(std::vector<Sound*>* finished)
+{
+    Lock lock(voiceMutex);
+
+    statusCaching = true;
+
+    std::size_t finishedCount = 0;
+    for (std::vector<Sound*>::iterator it = sounds.begin(); it != sounds.end(); ++it)
+    {
+        // Only the sounds which were playing can finish; stopped sounds don't cost anything
+        Sound* sound = *it;
+        if ((sound->m_status == Stopped) || sound->m_mixer)
+            continue;
+
+        Status status = sound->computeStatus();
+        if (status != Stopped)
+            continue;
+
+        // Give the voice back right away, rather than when another sound needs one
+        if (sound->m_source)
+            releaseVoice(sound->detachVoice());
+
+        sound->m_status = Stopped;
+        ++finishedCount;
+        if (finished)
+            finished->push_back(sound);
+    }
+
+    // Let the virtual sounds use the voices freed by the finished ones
+    if (finishedCount > 0)
+        restoreVirtualSounds();
+
+    return finishedCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void Sound::setMixer(SoundMixer* mixer)
+{
+    if (mixer == m_mixer)
+        return;
+
+    // Stop the playback on the previous mixer (or voice)
+    stop();
+    if (m_mixer)
+        m_mixer->detachSound(this);
+
+    m_mixer = mixer;
+    if (m_mixer)
+        m_mixer->attachSound(this);
+}
+
+
+////////////////////////////////////////////////////////////
+SoundMixer* Sound::getMixer() const
+{
+    return m_mixer;
 }
 
 
@@ -170,7 +567,9 @@ Sound& Sound::operator =(const Sound& right)
     // Copy the sound attributes
     if (right.m_buffer)
         setBuffer(*right.m_buffer);
+    setMixer(right.m_mixer);
     setLoop(right.getLoop());
+    setPriority(right.getPriority());
     setPitch(right.getPitch());
     setVolume(right.getVolume());
     setPosition(right.getPosition());
@@ -191,10 +590,211 @@ void Sound::resetBuffer()
     // Detach the buffer
     if (m_buffer)
     {
-        alCheck(alSourcei(m_source, AL_BUFFER, 0));
         m_buffer->detachSound(this);
         m_buffer = NULL;
     }
 }
 
+
+////////////////////////////////////////////////////////////
+void Sound::attachVoice(unsigned int voice)
+{
+    m_source = voice;
+    applyAttributes();
+    alCheck(alSourcei(m_source, AL_BUFFER, m_buffer->m_buffer));
+    alCheck(alSourcei(m_source, AL_LOOPING, m_loop));
+
+    // Resume from the exact sample that the virtual playback reached
+    Uint64 frameCount = m_buffer->getSampleCount() / m_buffer->getChannelCount();
+    Uint64 offset = getVirtualOffset();
+    if (m_loop && (frameCount > 0))
+        offset %= frameCount;
+    alCheck(alSourcei(m_source, AL_SAMPLE_OFFSET, static_cast<ALint>(offset)));
+    alCheck(alSourcePlay(m_source));
+
+    removeSound(virtualSounds, this);
+    activeSounds.push_back(this);
+    m_virtualStatus = Stopped;
+    m_virtualOffset = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Sound::detachVoice()
+{
+    // Save the playing state, so that the sound continues without voice
+    Status status = SoundSource::getStatus();
+    if (status != Stopped)
+    {
+        ALint offset = 0;
+        alCheck(alGetSourcei(m_source, AL_SAMPLE_OFFSET, &offset));
+        m_virtualStatus = status;
+        m_virtualOffset = static_cast<Uint64>(offset);
+        m_virtualClock.restart();
+        virtualSounds.push_back(this);
+    }
+
+    unsigned int voice = m_source;
+    alCheck(alSourceStop(voice));
+    alCheck(alSourcei(voice, AL_BUFFER, 0));
+    m_source = 0;
+    removeSound(activeSounds, this);
+
+    return voice;
+}
+
+
+////////////////////////////////////////////////////////////
+Sound::Status Sound::computeStatus() const
+{
+    if (m_source)
+        return SoundSource::getStatus();
+
+    // A virtual sound which reached its end is stopped
+    if ((m_virtualStatus == Playing) && !m_loop && m_buffer &&
+        (getVirtualOffset() >= m_buffer->getSampleCount() / m_buffer->getChannelCount()))
+        return Stopped;
+
+    return m_virtualStatus;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Sound::getVirtualOffset() const
+{
+    if (m_virtualStatus != Playing)
+        return m_virtualOffset;
+
+    // Advance the position by the time elapsed, at the playback rate of the sound
+    double frames = m_virtualClock.getElapsedTime().asSeconds() * m_buffer->getSampleRate() * getPitch();
+
+    return m_virtualOffset + static_cast<Uint64>(std::max(frames, 0.0));
+}
+
+
+////////////////////////////////////////////////////////////
+float Sound::getAudibility() const
+{
+    // Approximate OpenAL's default inverse distance clamped model
+    Vector3f position = getPosition();
+    if (!isRelativeToListener())
+        position -= Listener::getPosition();
+
+    float distance = std::sqrt(position.x * position.x + position.y * position.y + position.z * position.z);
+    float minDistance = getMinDistance();
+    float volume = getVolume();
+    if (distance > minDistance)
+        volume *= minDistance / (minDistance + getAttenuation() * (distance - minDistance));
+
+    return volume;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Sound::acquireVoice(Sound& sound)
+{
+    // Take the voices of the sounds which ended on their own
+    if (freeVoices.empty())
+        reclaimEndedVoices();
+
+    // Otherwise, virtualize the least important sound if it is less important than this one
+    if (freeVoices.empty())
+    {
+        Sound* victim = NULL;
+        int victimPriority = sound.m_priority;
+        float victimAudibility = sound.getAudibility();
+        for (std::vector<Sound*>::iterator it = activeSounds.begin(); it != activeSounds.end(); ++it)
+        {
+            // A paused sound is silent, whatever its volume
+            float audibility = ((*it)->SoundSource::getStatus() == Paused) ? 0.f : (*it)->getAudibility();
+            if (isMoreImportant(victimPriority, victimAudibility, (*it)->m_priority, audibility))
+            {
+                victim = *it;
+                victimPriority = victim->m_priority;
+                victimAudibility = audibility;
+            }
+        }
+
+        if (!victim)
+            return false;
+
+        releaseVoice(victim->detachVoice());
+        ++voiceSteals;
+    }
+
+    if (freeVoices.empty())
+        return false;
+
+    sound.attachVoice(freeVoices.back());
+    freeVoices.pop_back();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Sound::restoreVirtualSounds()
+{
+    while (!virtualSounds.empty())
+    {
+        // Pick the most important virtual sound which is still playing
+        Sound* best = NULL;
+        float bestAudibility = 0.f;
+        for (std::size_t i = 0; i < virtualSounds.size();)
+        {
+            Sound* sound = virtualSounds[i];
+            if (sound->m_virtualStatus != Playing)
+            {
+                ++i;
+                continue;
+            }
+
+            // Forget the sounds which played until their end
+            if (!sound->m_loop && (sound->getVirtualOffset() >= sound->m_buffer->getSampleCount() / sound->m_buffer->getChannelCount()))
+            {
+                sound->m_virtualStatus = Stopped;
+                sound->m_virtualOffset = 0;
+                virtualSounds[i] = virtualSounds.back();
+                virtualSounds.pop_back();
+                continue;
+            }
+
+            float audibility = sound->getAudibility();
+            if (!best || isMoreImportant(sound->m_priority, audibility, best->m_priority, bestAudibility))
+            {
+                best = sound;
+                bestAudibility = audibility;
+            }
+            ++i;
+        }
+
+        // Only take free voices, or the voices of sounds which ended: stealing
+        // again here would make sounds of similar importance swap voices forever
+        if (!best)
+            break;
+        if (freeVoices.empty())
+            reclaimEndedVoices();
+        if (freeVoices.empty())
+            break;
+
+        best->attachVoice(freeVoices.back());
+        freeVoices.pop_back();
+    }
+}
+
+
+
+////////////////////////////////////////////////////////////
+void Sound::reclaimEndedVoices()
+{
+    for (std::size_t i = 0; i < activeSounds.size();)
+    {
+        // detachVoice() removes the sound from the list
+        if (activeSounds[i]->SoundSource::getStatus() == Stopped)
+            releaseVoice(activeSounds[i]->detachVoice());
+        else
+            ++i;
+    }
+}
+
 } // namespace sf
@@ -30,41 +30,306 @@
 #include <SFML/Audio/OutputSoundFile.hpp>
 #include <SFML/Audio/Sound.hpp>
 #include <SFML/Audio/AudioDevice.hpp>
+#include <SFML/Audio/SoundFileReaderWav.hpp>
+#include <SFML/Audio/MixKernels.hpp>
 #include <SFML/Audio/ALCheck.hpp>
+#include <SFML/System/MappedFileInputStream.hpp>
+#include <SFML/System/MemoryInputStream.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/ConditionVariable.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/ResourceMemory.hpp>
+#include <algorithm>
+#include <deque>
+#include <map>
 #include <memory>
+#if defined(SFML_SYSTEM_WINDOWS)
+    #include <windows.h>
+#else
+    #include <unistd.h>
+#endif
+
+
+namespace
+{
+    // WAV samples are little-endian, they can be uploaded as is on little-endian CPUs only
+    bool isLittleEndian()
+    {
+        sf::Uint16 one = 1;
+        return *reinterpret_cast<sf::Uint8*>(&one) == 1;
+    }
+
+    // Get the number of CPU cores, to size the pool of loading threads
+    unsigned int getCoreCount()
+    {
+    #if defined(SFML_SYSTEM_WINDOWS)
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        long count = static_cast<long>(info.dwNumberOfProcessors);
+    #else
+        long count = sysconf(_SC_NPROCESSORS_ONLN);
+    #endif
+
+        return count > 0 ? static_cast<unsigned int>(count) : 4;
+    }
+
+    // Mutex for the creation of the loader
+    sf::Mutex loaderMutex;
+}
 
 
 namespace sf
 {
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Pool of threads decoding sound files in the background
+///
+/// Workers are launched when jobs are added and exit when
+/// the queue is empty.
+///
+////////////////////////////////////////////////////////////
+class SoundBufferLoader : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    // Result of the decoding of a file
+    ////////////////////////////////////////////////////////////
+    struct Result
+    {
+        bool               success;
+        std::vector<Int16> samples;
+        unsigned int       channelCount;
+        unsigned int       sampleRate;
+    };
+
+    ////////////////////////////////////////////////////////////
+    static SoundBufferLoader& getInstance()
+    {
+        // Never destroyed, so that it outlives the static sound buffers
+        Lock lock(loaderMutex);
+        static SoundBufferLoader* instance = new SoundBufferLoader;
+        return *instance;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void add(const SoundBuffer& buffer, const std::string& filename, unsigned int sampleRate)
+    {
+        Lock lock(m_mutex);
+
+        Job job = {&buffer, filename, sampleRate};
+        m_jobs.push_back(job);
+
+        // Wake up an idle worker, if any
+        for (std::size_t i = 0; i < m_workers.size(); ++i)
+        {
+            if (!m_busy[i])
+            {
+                m_busy[i] = true;
+                m_workers[i]->launch();
+                break;
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void cancel(const SoundBuffer& buffer)
+    {
+        Lock lock(m_mutex);
+
+        for (std::deque<Job>::iterator it = m_jobs.begin(); it != m_jobs.end();)
+        {
+            if (it->buffer == &buffer)
+                it = m_jobs.erase(it);
+            else
+                ++it;
+        }
+
+        // Wait for the worker which is decoding the file
+        while (m_decoding.count(&buffer))
+            m_decoded.wait(m_mutex);
+
+        m_results.erase(&buffer);
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool take(const SoundBuffer& buffer, Result& result)
+    {
+        Lock lock(m_mutex);
+
+        std::map<const SoundBuffer*, Result>::iterator it = m_results.find(&buffer);
+        if (it == m_results.end())
+            return false;
+
+        result.success      = it->second.success;
+        result.channelCount = it->second.channelCount;
+        result.sampleRate   = it->second.sampleRate;
+        result.samples.swap(it->second.samples);
+        m_results.erase(it);
+
+        return true;
+    }
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    struct Job
+    {
+        const SoundBuffer* buffer;
+        std::string        filename;
+        unsigned int       sampleRate; ///< Rate to convert the samples to, 0 to keep theirs
+    };
+
+    ////////////////////////////////////////////////////////////
+    struct Worker
+    {
+        void operator ()()
+        {
+            loader->run(index);
+        }
+
+        SoundBufferLoader* loader;
+        std::size_t        index;
+    };
+
+    ////////////////////////////////////////////////////////////
+    SoundBufferLoader()
+    {
+        unsigned int count = getCoreCount();
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            Worker worker = {this, i};
+            m_workers.push_back(new Thread(worker));
+            m_busy.push_back(false);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void run(std::size_t index)
+    {
+        for (;;)
+        {
+            Job job;
+            {
+                Lock lock(m_mutex);
+                if (m_jobs.empty())
+                {
+                    m_busy[index] = false;
+                    return;
+                }
+
+                job = m_jobs.front();
+                m_jobs.pop_front();
+                m_decoding.insert(job.buffer);
+            }
+
+            // Decode the file, in parallel with the other workers
+            Result result;
+            result.success = false;
+            result.channelCount = 0;
+            result.sampleRate = 0;
+            MappedFileInputStream mapping;
+            InputSoundFile file;
+            bool opened = mapping.open(job.filename) ? file.openFromMemory(mapping.getData(), static_cast<std::size_t>(mapping.getSize()))
+                                                     : file.openFromFile(job.filename);
+            if (opened)
+            {
+                Uint64 sampleCount = file.getSampleCount();
+                result.channelCount = file.getChannelCount();
+                result.sampleRate = file.getSampleRate();
+                result.samples.resize(static_cast<std::size_t>(sampleCount));
+                result.success = (sampleCount > 0) && (file.read(&result.samples[0], sampleCount) == sampleCount);
+
+                // Convert the sample rate here as well, it is the most expensive part of the loading
+                if (result.success && job.sampleRate && (job.sampleRate != result.sampleRate))
+                {
+                    std::vector<Int16> converted;
+                    priv::convertSampleRate(&result.samples[0], result.samples.size() / result.channelCount, result.channelCount,
+                                            result.sampleRate, job.sampleRate, converted);
+                    result.samples.swap(converted);
+                    result.sampleRate = job.sampleRate;
+                }
+            }
+
+            Lock lock(m_mutex);
+            m_decoding.erase(job.buffer);
+            m_decoded.notifyAll();
+            Result& stored = m_results[job.buffer];
+            stored.success = result.success;
+            stored.channelCount = result.channelCount;
+            stored.sampleRate = result.sampleRate;
+            stored.samples.swap(result.samples);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Mutex                                m_mutex;    ///< Mutex protecting all the members
+    std::deque<Job>                      m_jobs;     ///< Files waiting to be decoded
+    std::set<const SoundBuffer*>         m_decoding; ///< Buffers whose file is being decoded
+    ConditionVariable                    m_decoded;  ///< Notified when a worker finishes decoding a file
+    std::map<const SoundBuffer*, Result> m_results;  ///< Decoded files waiting to be uploaded
+    std::vector<Thread*>                 m_workers;  ///< Worker threads
+    std::vector<bool>                    m_busy;     ///< Is each worker running?
+};
+
+} // namespace priv
+
 ////////////////////////////////////////////////////////////
 SoundBuffer::SoundBuffer() :
-m_buffer  (0),
-m_duration()
+m_buffer     (0),
+m_sampleCount(0),
+m_keepSamples(true),
+m_resample   (false),
+m_loading    (false),
+m_duration   (),
+m_deviceBytes(0),
+m_hostBytes  (0)
 {
     // Create the buffer
     alCheck(alGenBuffers(1, &m_buffer));
+    ResourceMemory::record(ResourceMemory::SoundBuffers, 1, 0, 0);
 }
 
 
 ////////////////////////////////////////////////////////////
 SoundBuffer::SoundBuffer(const SoundBuffer& copy) :
-m_buffer  (0),
-m_samples (copy.m_samples),
-m_duration(copy.m_duration),
-m_sounds  () // don't copy the attached sounds
+m_buffer     (0),
+m_samples    (copy.m_samples),
+m_sampleCount(0),
+m_keepSamples(copy.m_keepSamples),
+m_resample   (copy.m_resample),
+m_loading    (false),
+m_duration   (copy.m_duration),
+m_sounds     (), // don't copy the attached sounds
+m_deviceBytes(0),
+m_hostBytes  (0)
 {
     // Create the buffer
     alCheck(alGenBuffers(1, &m_buffer));
+    ResourceMemory::record(ResourceMemory::SoundBuffers, 1, 0, 0);
 
     // Update the internal buffer with the new samples
-    update(copy.getChannelCount(), copy.getSampleRate());
+    if (!copy.m_samples.empty())
+        update(copy.getChannelCount(), copy.getSampleRate());
+    else if (copy.m_sampleCount > 0)
+        err() << "Failed to copy sound buffer (its samples were not kept after upload)" << std::endl;
+
+    updateAccounting();
 }
 
 
 ////////////////////////////////////////////////////////////
 SoundBuffer::~SoundBuffer()
 {
+    // Stop the background loading before the buffer disappears
+    cancelLoading();
+
     // To prevent the iterator from becoming invalid, move the entire buffer to another
     // container. Otherwise calling resetBuffer would result in detachSound being
     // called which removes the sound from the internal list.
@@ -78,12 +343,21 @@ SoundBuffer::~SoundBuffer()
     // Destroy the buffer
     if (m_buffer)
         alCheck(alDeleteBuffers(1, &m_buffer));
+
+    ResourceMemory::record(ResourceMemory::SoundBuffers, -1, -static_cast<Int64>(m_deviceBytes), -static_cast<Int64>(m_hostBytes));
 }
 
 
 ////////////////////////////////////////////////////////////
 bool SoundBuffer::loadFromFile(const std::string& filename)
 {
+    cancelLoading();
+
+    // Decode straight from the mapped file, without copying it through stdio buffers
+    MappedFileInputStream mapping;
+    if (mapping.open(filename))
+        return loadFromMemory(mapping.getData(), static_cast<std::size_t>(mapping.getSize()));
+
     InputSoundFile file;
     if (file.openFromFile(filename))
         return initialize(file);
@@ -92,9 +366,71 @@ bool SoundBuffer::loadFromFile(const std::string& filename)
 }
 
 
+////////////////////////////////////////////////////////////
+bool SoundBuffer::loadFromFileAsync(const std::string& filename)
+{
+    cancelLoading();
+
+    unsigned int sampleRate = m_resample ? priv::AudioDevice::getSampleRate() : 0;
+    priv::SoundBufferLoader::getInstance().add(*this, filename, sampleRate);
+    m_loading = true;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBuffer::isReady()
+{
+    if (!m_loading)
+        return true;
+
+    priv::SoundBufferLoader::Result result;
+    if (!priv::SoundBufferLoader::getInstance().take(*this, result))
+        return false;
+
+    m_loading = false;
+
+    // Upload the decoded samples on this thread, with the other OpenAL calls
+    if (result.success)
+    {
+        m_samples.swap(result.samples);
+        update(result.channelCount, result.sampleRate);
+    }
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool SoundBuffer::loadFromMemory(const void* data, std::size_t sizeInBytes)
 {
+    cancelLoading();
+
+    // Without a CPU copy of the samples, 16-bit WAV samples can be uploaded from the data without any copy
+    if (!m_keepSamples && data && isLittleEndian())
+    {
+        MemoryInputStream stream;
+        stream.open(data, sizeInBytes);
+
+        if (priv::SoundFileReaderWav::check(stream))
+        {
+            stream.seek(0);
+            priv::SoundFileReaderWav reader;
+            SoundFileReader::Info info;
+            if (!reader.open(stream, info))
+                return false;
+
+            Uint64 end = reader.getDataStart() + info.sampleCount * sizeof(Int16);
+            if ((reader.getBytesPerSample() == sizeof(Int16)) && (end <= sizeInBytes))
+            {
+                std::vector<Int16>().swap(m_samples);
+                const Int16* samples = reinterpret_cast<const Int16*>(static_cast<const char*>(data) + reader.getDataStart());
+                return upload(samples, info.sampleCount, info.channelCount, info.sampleRate);
+            }
+        }
+    }
+
     InputSoundFile file;
     if (file.openFromMemory(data, sizeInBytes))
         return initialize(file);
@@ -106,6 +442,13 @@ bool SoundBuffer::loadFromMemory(const void* data, std::size_t sizeInBytes)
 ////////////////////////////////////////////////////////////
 bool SoundBuffer::loadFromStream(InputStream& stream)
 {
+    cancelLoading();
+
+    // Mapped files are decoded in place
+    MappedFileInputStream* mapping = dynamic_cast<MappedFileInputStream*>(&stream);
+    if (mapping && mapping->getData())
+        return loadFromMemory(mapping->getData(), static_cast<std::size_t>(mapping->getSize()));
+
     InputSoundFile file;
     if (file.openFromStream(stream))
         return initialize(file);
@@ -117,8 +460,18 @@ bool SoundBuffer::loadFromStream(InputStream& stream)
 ////////////////////////////////////////////////////////////
 bool SoundBuffer::loadFromSamples(const Int16* samples, Uint64 sampleCount, unsigned int channelCount, unsigned int sampleRate)
 {
+    cancelLoading();
+
     if (samples && sampleCount && channelCount && sampleRate)
     {
+        // Upload the samples directly if no copy has to be kept
+        if (!m_keepSamples)
+        {
+            std::vector<Int16>().swap(m_samples);
+            updateAccounting();
+            return upload(samples, sampleCount, channelCount, sampleRate);
+        }
+
         // Copy the new audio samples
         m_samples.assign(samples, samples + sampleCount);
 
@@ -143,6 +496,12 @@ bool SoundBuffer::loadFromSamples(const Int16* samples, Uint64 sampleCount, unsi
 ////////////////////////////////////////////////////////////
 bool SoundBuffer::saveToFile(const std::string& filename) const
 {
+    if (m_samples.empty() && (m_sampleCount > 0))
+    {
+        err() << "Failed to save sound buffer to \"" << filename << "\" (its samples were not kept after upload)" << std::endl;
+        return false;
+    }
+
     // Create the sound file in write mode
     OutputSoundFile file;
     if (file.openFromFile(filename, getSampleRate(), getChannelCount()))
@@ -169,7 +528,7 @@ const Int16* SoundBuffer::getSamples() const
 ////////////////////////////////////////////////////////////
 Uint64 SoundBuffer::getSampleCount() const
 {
-    return m_samples.size();
+    return m_sampleCount;
 }
 
 
@@ -200,20 +559,93 @@ Time SoundBuffer::getDuration() const
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundBuffer::setSamplesKept(bool keep)
+{
+    m_keepSamples = keep;
+
+    // Release the samples which are already uploaded
+    if (!keep && (m_sampleCount > 0))
+    {
+        std::vector<Int16>().swap(m_samples);
+        updateAccounting();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBuffer::areSamplesKept() const
+{
+    return m_keepSamples;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBuffer::setResamplingEnabled(bool enabled)
+{
+    m_resample = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBuffer::isResamplingEnabled() const
+{
+    return m_resample;
+}
+
+
 ////////////////////////////////////////////////////////////
 SoundBuffer& SoundBuffer::operator =(const SoundBuffer& right)
 {
+    cancelLoading();
+
     SoundBuffer temp(right);
 
-    std::swap(m_samples,  temp.m_samples);
-    std::swap(m_buffer,   temp.m_buffer);
-    std::swap(m_duration, temp.m_duration);
-    std::swap(m_sounds,   temp.m_sounds); // swap sounds too, so that they are detached when temp is destroyed
+    std::swap(m_samples,     temp.m_samples);
+    std::swap(m_buffer,      temp.m_buffer);
+    std::swap(m_sampleCount, temp.m_sampleCount);
+    std::swap(m_keepSamples, temp.m_keepSamples);
+    std::swap(m_resample,    temp.m_resample);
+    std::swap(m_duration,    temp.m_duration);
+    std::swap(m_sounds,      temp.m_sounds); // swap sounds too, so that they are detached when temp is destroyed
+
+    // The reported sizes stay with their objects
+    updateAccounting();
+    temp.updateAccounting();
 
     return *this;
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundBuffer::swap(SoundBuffer& right)
+{
+    cancelLoading();
+    right.cancelLoading();
+
+    // Stop the sounds so that their voices release the OpenAL buffers;
+    // setting the same buffer again does it, and keeps them attached
+    SoundList sounds(m_sounds);
+    for (SoundList::const_iterator it = sounds.begin(); it != sounds.end(); ++it)
+        (*it)->setBuffer(*this);
+
+    SoundList rightSounds(right.m_sounds);
+    for (SoundList::const_iterator it = rightSounds.begin(); it != rightSounds.end(); ++it)
+        (*it)->setBuffer(right);
+
+    m_samples.swap(right.m_samples);
+    std::swap(m_buffer,      right.m_buffer);
+    std::swap(m_sampleCount, right.m_sampleCount);
+    std::swap(m_keepSamples, right.m_keepSamples);
+    std::swap(m_resample,    right.m_resample);
+    std::swap(m_duration,    right.m_duration);
+
+    // The reported sizes stay with their objects
+    updateAccounting();
+    right.updateAccounting();
+}
+
+
 ////////////////////////////////////////////////////////////
 bool SoundBuffer::initialize(InputSoundFile& file)
 {
@@ -231,6 +663,7 @@ bool SoundBuffer::initialize(InputSoundFile& file)
     }
     else
     {
+        updateAccounting();
         return false;
     }
 }
@@ -243,6 +676,29 @@ bool SoundBuffer::update(unsigned int channelCount, unsigned int sampleRate)
     if (!channelCount || !sampleRate || m_samples.empty())
         return false;
 
+    if (!upload(&m_samples[0], m_samples.size(), channelCount, sampleRate))
+    {
+        updateAccounting();
+        return false;
+    }
+
+    // Release the CPU copy of the samples now that the driver has its own
+    if (!m_keepSamples)
+        std::vector<Int16>().swap(m_samples);
+
+    updateAccounting();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBuffer::upload(const Int16* samples, Uint64 sampleCount, unsigned int channelCount, unsigned int sampleRate)
+{
+    // Check parameters
+    if (!channelCount || !sampleRate || !samples || !sampleCount)
+        return false;
+
     // Find the good format according to the number of channels
     ALenum format = priv::AudioDevice::getFormatFromChannelCount(channelCount);
 
@@ -253,6 +709,19 @@ bool SoundBuffer::update(unsigned int channelCount, unsigned int sampleRate)
         return false;
     }
 
+    // Convert the samples to the mixing rate of the device, so that OpenAL doesn't resample them when playing
+    std::vector<Int16> converted;
+    unsigned int deviceRate = m_resample ? priv::AudioDevice::getSampleRate() : 0;
+    bool keptSamples = !m_samples.empty() && (samples == &m_samples[0]);
+    if (deviceRate && (deviceRate != sampleRate) && (sampleCount >= channelCount))
+    {
+        priv::convertSampleRate(samples, static_cast<std::size_t>(sampleCount / channelCount), channelCount,
+                                sampleRate, deviceRate, converted);
+        samples = &converted[0];
+        sampleCount = converted.size();
+        sampleRate = deviceRate;
+    }
+
     // First make a copy of the list of sounds so we can reattach later
     SoundList sounds(m_sounds);
 
@@ -261,11 +730,17 @@ bool SoundBuffer::update(unsigned int channelCount, unsigned int sampleRate)
         (*it)->resetBuffer();
 
     // Fill the buffer
-    ALsizei size = static_cast<ALsizei>(m_samples.size()) * sizeof(Int16);
-    alCheck(alBufferData(m_buffer, format, &m_samples[0], size, sampleRate));
+    ALsizei size = static_cast<ALsizei>(sampleCount) * sizeof(Int16);
+    alCheck(alBufferData(m_buffer, format, samples, size, sampleRate));
+    m_sampleCount = sampleCount;
+
+    // The CPU copy of the samples must match the buffer
+    if (keptSamples && !converted.empty())
+        m_samples.swap(converted);
 
     // Compute the duration
-    m_duration = seconds(static_cast<float>(m_samples.size()) / sampleRate / channelCount);
+    m_duration = seconds(static_cast<float>(sampleCount) / sampleRate / channelCount);
+    updateAccounting();
 
     // Now reattach the buffer to the sounds that use it
     for (SoundList::const_iterator it = sounds.begin(); it != sounds.end(); ++it)
@@ -275,6 +750,33 @@ bool SoundBuffer::update(unsigned int channelCount, unsigned int sampleRate)
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundBuffer::cancelLoading()
+{
+    if (m_loading)
+    {
+        priv::SoundBufferLoader::getInstance().cancel(*this);
+        m_loading = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBuffer::updateAccounting()
+{
+    Uint64 deviceBytes = m_sampleCount * sizeof(Int16);
+    Uint64 hostBytes = m_samples.capacity() * sizeof(Int16);
+    if ((deviceBytes == m_deviceBytes) && (hostBytes == m_hostBytes))
+        return;
+
+    ResourceMemory::record(ResourceMemory::SoundBuffers, 0,
+                           static_cast<Int64>(deviceBytes) - static_cast<Int64>(m_deviceBytes),
+                           static_cast<Int64>(hostBytes) - static_cast<Int64>(m_hostBytes));
+    m_deviceBytes = deviceBytes;
+    m_hostBytes = hostBytes;
+}
+
+
 ////////////////////////////////////////////////////////////
 void SoundBuffer::attachSound(Sound* sound) const
 {
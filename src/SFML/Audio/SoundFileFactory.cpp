@@ -34,13 +34,151 @@
 #include <SFML/Audio/SoundFileWriterWav.hpp>
 #include <SFML/System/FileInputStream.hpp>
 #include <SFML/System/MemoryInputStream.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <map>
 
 
 namespace
 {
+    // Sound files can be opened from several threads (see SoundBuffer::loadFromFileAsync)
+    sf::Mutex registrationMutex;
+
+    // Formats found for the files opened so far, and for their extensions
+    typedef sf::SoundFileReader* (*CreateFunction)();
+    typedef std::map<std::string, CreateFunction> FormatCache;
+    sf::Mutex   cacheMutex;
+    FormatCache pathFormats;
+    FormatCache extensionFormats;
+    const std::size_t maxCachedPaths = 4096;
+
+    // Part of a stream that the checks of the readers can read
+    // (more than enough for the built-in readers, which stop at the first page of data)
+    const sf::Int64 maxHeaderSize = 1024 * 1024;
+
+    // Stream which keeps the beginning of another stream in memory, so that each reader can
+    // check it without reading the source again; the source is read sequentially and only once
+    class HeaderStream : public sf::InputStream
+    {
+    public:
+
+        HeaderStream(sf::InputStream& source) :
+        m_source  (source),
+        m_size    (source.getSize()),
+        m_position(0),
+        m_complete(false)
+        {
+            if (m_source.seek(0) != 0)
+                m_complete = true;
+        }
+
+        virtual sf::Int64 read(void* data, sf::Int64 size)
+        {
+            if (size <= 0)
+                return 0;
+
+            // Read the source ahead by chunks, rather than the few bytes that a check requests
+            sf::Int64 end = m_position + size;
+            sf::Int64 buffered = static_cast<sf::Int64>(m_header.size());
+            if ((end > buffered) && !m_complete && (buffered < maxHeaderSize))
+                fill(std::min(std::max(end, buffered + 4096), maxHeaderSize));
+
+            // Copy the part which is in memory
+            char* output = static_cast<char*>(data);
+            sf::Int64 count = 0;
+            buffered = static_cast<sf::Int64>(m_header.size());
+            if (m_position < buffered)
+            {
+                count = std::min(size, buffered - m_position);
+                std::memcpy(output, &m_header[static_cast<std::size_t>(m_position)], static_cast<std::size_t>(count));
+                m_position += count;
+            }
+
+            // Read what's beyond the kept part directly from the source
+            if ((count < size) && !m_complete && (m_position >= maxHeaderSize))
+            {
+                if (m_source.seek(m_position) != m_position)
+                    return count;
+
+                sf::Int64 read = m_source.read(output + count, size - count);
+                if (read > 0)
+                {
+                    count += read;
+                    m_position += read;
+                }
+
+                // The next chunk of header must be read at its own position
+                m_source.seek(buffered);
+            }
+
+            return count;
+        }
+
+        virtual sf::Int64 seek(sf::Int64 position)
+        {
+            if ((position < 0) || ((m_size >= 0) && (position > m_size)))
+                return -1;
+
+            m_position = position;
+            return m_position;
+        }
+
+        virtual sf::Int64 tell()
+        {
+            return m_position;
+        }
+
+        virtual sf::Int64 getSize()
+        {
+            return m_size;
+        }
+
+    private:
+
+        void fill(sf::Int64 size)
+        {
+            std::size_t previous = m_header.size();
+            m_header.resize(static_cast<std::size_t>(size));
+
+            sf::Int64 requested = size - static_cast<sf::Int64>(previous);
+            sf::Int64 read = m_source.read(&m_header[previous], requested);
+            if (read < requested)
+            {
+                m_header.resize(previous + static_cast<std::size_t>(std::max(read, static_cast<sf::Int64>(0))));
+                m_complete = true;
+            }
+        }
+
+        sf::InputStream&  m_source;
+        sf::Int64         m_size;
+        sf::Int64         m_position;
+        bool              m_complete; // the whole source is in memory, or can't be read anymore
+        std::vector<char> m_header;
+    };
+
+    // Get the extension of a path, in lower case
+    std::string getExtension(const std::string& filename)
+    {
+        std::string::size_type dot = filename.find_last_of('.');
+        std::string::size_type separator = filename.find_last_of("/\\");
+        if ((dot == std::string::npos) || ((separator != std::string::npos) && (separator > dot)))
+            return "";
+
+        std::string extension = filename.substr(dot + 1);
+        for (std::string::iterator it = extension.begin(); it != extension.end(); ++it)
+            *it = static_cast<char>(std::tolower(static_cast<unsigned char>(*it)));
+
+        return extension;
+    }
+
     // Register all the built-in readers and writers if not already done
     void ensureDefaultReadersWritersRegistered()
     {
+        sf::Lock lock(registrationMutex);
+
         static bool registered = false;
         if (!registered)
         {
@@ -67,21 +205,48 @@ SoundFileReader* SoundFileFactory::createReaderFromFilename(const std::string& f
     // Register the built-in readers/writers on first call
     ensureDefaultReadersWritersRegistered();
 
+    // A file opened before doesn't have to be checked again, as long as its reader is still registered
+    std::string extension = getExtension(filename);
+    CreateFunction preferred = NULL;
+    {
+        Lock lock(cacheMutex);
+
+        FormatCache::const_iterator path = pathFormats.find(filename);
+        if (path != pathFormats.end())
+        {
+            for (ReaderFactoryArray::const_iterator it = s_readers.begin(); it != s_readers.end(); ++it)
+            {
+                if (it->create == path->second)
+                    return it->create();
+            }
+        }
+
+        FormatCache::const_iterator format = extensionFormats.find(extension);
+        if (format != extensionFormats.end())
+            preferred = format->second;
+    }
+
     // Wrap the input file into a file stream
     FileInputStream stream;
     if (!stream.open(filename))
         return NULL;
 
-    // Test the filename in all the registered factories
-    for (ReaderFactoryArray::const_iterator it = s_readers.begin(); it != s_readers.end(); ++it)
+    // Test the file with all the registered factories, starting with the one of its extension
+    const ReaderFactory* factory = findReader(stream, preferred);
+    if (!factory)
+        return NULL;
+
     {
-        stream.seek(0);
-        if (it->check(stream))
-            return it->create();
+        Lock lock(cacheMutex);
+
+        if (pathFormats.size() >= maxCachedPaths)
+            pathFormats.clear();
+
+        pathFormats[filename] = factory->create;
+        extensionFormats[extension] = factory->create;
     }
 
-    // No suitable reader found
-    return NULL;
+    return factory->create();
 }
 
 
@@ -96,15 +261,9 @@ SoundFileReader* SoundFileFactory::createReaderFromMemory(const void* data, std:
     stream.open(data, sizeInBytes);
 
     // Test the stream for all the registered factories
-    for (ReaderFactoryArray::const_iterator it = s_readers.begin(); it != s_readers.end(); ++it)
-    {
-        stream.seek(0);
-        if (it->check(stream))
-            return it->create();
-    }
+    const ReaderFactory* factory = findReader(stream, NULL);
 
-    // No suitable reader found
-    return NULL;
+    return factory ? factory->create() : NULL;
 }
 
 
@@ -115,15 +274,9 @@ SoundFileReader* SoundFileFactory::createReaderFromStream(InputStream& stream)
     ensureDefaultReadersWritersRegistered();
 
     // Test the stream for all the registered factories
-    for (ReaderFactoryArray::const_iterator it = s_readers.begin(); it != s_readers.end(); ++it)
-    {
-        stream.seek(0);
-        if (it->check(stream))
-            return it->create();
-    }
+    const ReaderFactory* factory = findReader(stream, NULL);
 
-    // No suitable reader found
-    return NULL;
+    return factory ? factory->create() : NULL;
 }
 
 
@@ -144,4 +297,41 @@ SoundFileWriter* SoundFileFactory::createWriterFromFilename(const std::string& f
     return NULL;
 }
 
+
+////////////////////////////////////////////////////////////
+void SoundFileFactory::clearFormatCache()
+{
+    Lock lock(cacheMutex);
+
+    pathFormats.clear();
+    extensionFormats.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+const SoundFileFactory::ReaderFactory* SoundFileFactory::findReader(InputStream& stream, SoundFileReader* (*preferred)())
+{
+    HeaderStream header(stream);
+
+    if (preferred)
+    {
+        for (ReaderFactoryArray::const_iterator it = s_readers.begin(); it != s_readers.end(); ++it)
+        {
+            header.seek(0);
+            if ((it->create == preferred) && it->check(header))
+                return &*it;
+        }
+    }
+
+    for (ReaderFactoryArray::const_iterator it = s_readers.begin(); it != s_readers.end(); ++it)
+    {
+        header.seek(0);
+        if ((it->create != preferred) && it->check(header))
+            return &*it;
+    }
+
+    // No suitable reader found
+    return NULL;
+}
+
 } // namespace sf
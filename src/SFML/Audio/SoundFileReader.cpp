@@ -0,0 +1,57 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundFileReader.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Uint64 SoundFileReader::read(float* samples, Uint64 maxCount)
+{
+    // Read 16-bit samples by blocks, and convert them
+    Int16 block[1024];
+    Uint64 count = 0;
+    while (count < maxCount)
+    {
+        Uint64 blockCount = std::min<Uint64>(maxCount - count, sizeof(block) / sizeof(*block));
+        Uint64 blockRead = read(block, blockCount);
+
+        for (Uint64 i = 0; i < blockRead; ++i)
+            *samples++ = block[i] / 32768.f;
+        count += blockRead;
+
+        // Error or end of file
+        if (blockRead < blockCount)
+            break;
+    }
+
+    return count;
+}
+
+} // namespace sf
@@ -28,6 +28,7 @@
 #include <SFML/Audio/SoundFileReaderFlac.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <cassert>
 
 
@@ -107,17 +108,22 @@ namespace
     {
         sf::priv::SoundFileReaderFlac::ClientData* data = static_cast<sf::priv::SoundFileReaderFlac::ClientData*>(clientData);
 
-        // If there's no output buffer, it means that we are seeking
-        if (!data->buffer)
-            return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
+        // After a seek through the index, drop the frames which precede the target
+        unsigned int first = 0;
+        if (data->discard > 0)
+        {
+            first = static_cast<unsigned int>(std::min<sf::Uint64>(data->discard, frame->header.blocksize));
+            data->discard -= first;
+        }
 
-        // Reserve memory if we're going to use the leftovers buffer
-        unsigned int frameSamples = frame->header.blocksize * frame->header.channels;
+        // Reserve memory if we're going to use the leftovers buffer (when there's no
+        // output buffer, we are seeking: the samples of the target frame are kept there)
+        unsigned int frameSamples = (frame->header.blocksize - first) * frame->header.channels;
         if (data->remaining < frameSamples)
             data->leftovers.reserve(static_cast<std::size_t>(frameSamples - data->remaining));
 
         // Decode the samples
-        for (unsigned i = 0; i < frame->header.blocksize; ++i)
+        for (unsigned i = first; i < frame->header.blocksize; ++i)
         {
             for (unsigned int j = 0; j < frame->header.channels; ++j)
             {
@@ -168,6 +174,10 @@ namespace
             data->info.sampleCount = meta->data.stream_info.total_samples * meta->data.stream_info.channels;
             data->info.sampleRate = meta->data.stream_info.sample_rate;
             data->info.channelCount = meta->data.stream_info.channels;
+
+            // Frame numbers only map to samples when all the frames have the same size
+            if (meta->data.stream_info.min_blocksize == meta->data.stream_info.max_blocksize)
+                data->blockSize = meta->data.stream_info.max_blocksize;
         }
     }
 
@@ -193,7 +203,11 @@ bool SoundFileReaderFlac::check(InputStream& stream)
     // Initialize the decoder with our callbacks
     ClientData data;
     data.stream = &stream;
+    data.buffer = NULL;
+    data.remaining = 0;
     data.error = false;
+    data.blockSize = 0;
+    data.discard = 0;
     FLAC__stream_decoder_init_stream(decoder, &streamRead, &streamSeek, &streamTell, &streamLength, &streamEof, &streamWrite, NULL, &streamError, &data);
 
     // Read the header
@@ -209,7 +223,9 @@ bool SoundFileReaderFlac::check(InputStream& stream)
 
 ////////////////////////////////////////////////////////////
 SoundFileReaderFlac::SoundFileReaderFlac() :
-m_decoder(NULL)
+m_decoder         (NULL),
+m_firstFrameOffset(0),
+m_seekTableBuilt  (false)
 {
 }
 
@@ -234,6 +250,11 @@ bool SoundFileReaderFlac::open(InputStream& stream, Info& info)
 
     // Initialize the decoder with our callbacks
     m_clientData.stream = &stream;
+    m_clientData.buffer = NULL;
+    m_clientData.remaining = 0;
+    m_clientData.error = false;
+    m_clientData.blockSize = 0;
+    m_clientData.discard = 0;
     FLAC__stream_decoder_init_stream(m_decoder, &streamRead, &streamSeek, &streamTell, &streamLength, &streamEof, &streamWrite, &streamMetadata, &streamError, &m_clientData);
 
     // Read the header
@@ -247,6 +268,13 @@ bool SoundFileReaderFlac::open(InputStream& stream, Info& info)
     // Retrieve the sound properties
     info = m_clientData.info; // was filled in the "metadata" callback
 
+    // Remember where the audio frames start, for the seek index
+    FLAC__uint64 position = 0;
+    if (FLAC__stream_decoder_get_decode_position(m_decoder, &position))
+        m_firstFrameOffset = position;
+    else
+        m_clientData.blockSize = 0;
+
     return true;
 }
 
@@ -260,8 +288,28 @@ void SoundFileReaderFlac::seek(Uint64 sampleOffset)
     m_clientData.buffer = NULL;
     m_clientData.remaining = 0;
     m_clientData.leftovers.clear();
+    m_clientData.discard = 0;
+
+    // The decoder works with frames (one sample per channel)
+    Uint64 frame = sampleOffset / m_clientData.info.channelCount;
 
-    FLAC__stream_decoder_seek_absolute(m_decoder, sampleOffset);
+    // Seeking to the beginning is cheap, don't build the index for it
+    if (frame > 0)
+    {
+        if (!m_seekTableBuilt)
+            buildSeekTable();
+
+        // Jump to the FLAC frame which contains the target, the decoder will resynchronize on it
+        Uint64 index = frame / m_clientData.blockSize;
+        if (!m_seekTable.empty() && (index < m_seekTable.size()) && FLAC__stream_decoder_flush(m_decoder) &&
+            (m_clientData.stream->seek(m_seekTable[index]) == static_cast<Int64>(m_seekTable[index])))
+        {
+            m_clientData.discard = frame - index * m_clientData.blockSize;
+            return;
+        }
+    }
+
+    FLAC__stream_decoder_seek_absolute(m_decoder, frame);
 }
 
 
@@ -277,7 +325,7 @@ Uint64 SoundFileReaderFlac::read(Int16* samples, Uint64 maxCount)
         if (left > maxCount)
         {
             // There are more leftovers than needed
-            std::copy(m_clientData.leftovers.begin(), m_clientData.leftovers.end(), samples);
+            std::copy(m_clientData.leftovers.begin(), m_clientData.leftovers.begin() + static_cast<std::size_t>(maxCount), samples);
             std::vector<Int16> leftovers(m_clientData.leftovers.begin() + maxCount, m_clientData.leftovers.end());
             m_clientData.leftovers.swap(leftovers);
             return maxCount;
@@ -319,9 +367,45 @@ void SoundFileReaderFlac::close()
         FLAC__stream_decoder_finish(m_decoder);
         FLAC__stream_decoder_delete(m_decoder);
         m_decoder = NULL;
+        m_seekTable.clear();
+        m_seekTableBuilt = false;
     }
 }
 
+
+////////////////////////////////////////////////////////////
+void SoundFileReaderFlac::buildSeekTable()
+{
+    m_seekTableBuilt = true;
+
+    // Frame numbers only map to samples when all the frames have the same size
+    if (m_clientData.blockSize == 0)
+        return;
+
+    // Restart from the first frame
+    if (!FLAC__stream_decoder_flush(m_decoder) ||
+        (m_clientData.stream->seek(m_firstFrameOffset) != static_cast<Int64>(m_firstFrameOffset)))
+        return;
+
+    // Walk through the frames, parsing them without decoding their samples
+    std::vector<Uint64> table;
+    while (true)
+    {
+        FLAC__uint64 position = 0;
+        if (!FLAC__stream_decoder_get_decode_position(m_decoder, &position) ||
+            !FLAC__stream_decoder_skip_single_frame(m_decoder) ||
+            (FLAC__stream_decoder_get_state(m_decoder) == FLAC__STREAM_DECODER_END_OF_STREAM))
+            break;
+
+        table.push_back(position);
+    }
+
+    // Only trust the index if it covers the whole stream
+    Uint64 frameCount = m_clientData.info.sampleCount / m_clientData.info.channelCount;
+    if (table.size() == (frameCount + m_clientData.blockSize - 1) / m_clientData.blockSize)
+        m_seekTable.swap(table);
+}
+
 } // namespace priv
 
 } // namespace sf
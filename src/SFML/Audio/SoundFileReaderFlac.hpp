@@ -85,6 +85,11 @@ public:
     /// If the given offset exceeds to total number of samples,
     /// this function must jump to the end of the file.
     ///
+    /// The first seek builds an index of the FLAC frames (for
+    /// streams with a fixed block size), so that the following
+    /// ones jump directly to the right frame instead of
+    /// bisecting through the file.
+    ///
     /// \param sampleOffset Index of the sample to jump to, relative to the beginning
     ///
     ////////////////////////////////////////////////////////////
@@ -115,6 +120,8 @@ public:
         Uint64                remaining;
         std::vector<Int16>    leftovers;
         bool                  error;
+        unsigned int          blockSize;
+        Uint64                discard;
     };
 
 private:
@@ -125,11 +132,20 @@ private:
     ////////////////////////////////////////////////////////////
     void close();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Scan the FLAC frames of the file to build the seek index
+    ///
+    ////////////////////////////////////////////////////////////
+    void buildSeekTable();
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    FLAC__StreamDecoder* m_decoder;    ///< FLAC decoder
-    ClientData           m_clientData; ///< Structure passed to the decoder callbacks
+    FLAC__StreamDecoder* m_decoder;          ///< FLAC decoder
+    ClientData           m_clientData;       ///< Structure passed to the decoder callbacks
+    Uint64               m_firstFrameOffset; ///< Byte offset of the first FLAC frame in the stream
+    std::vector<Uint64>  m_seekTable;        ///< Byte offset of each FLAC frame, empty if not built or unusable
+    bool                 m_seekTableBuilt;   ///< Has the seek index been built yet?
 };
 
 } // namespace priv
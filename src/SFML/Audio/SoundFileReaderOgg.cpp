@@ -31,6 +31,7 @@
 #include <algorithm>
 #include <cctype>
 #include <cassert>
+#include <cstring>
 
 
 namespace
@@ -88,8 +89,10 @@ bool SoundFileReaderOgg::check(InputStream& stream)
 
 ////////////////////////////////////////////////////////////
 SoundFileReaderOgg::SoundFileReaderOgg() :
-m_vorbis      (),
-m_channelCount(0)
+m_vorbis        (),
+m_channelCount  (0),
+m_seekTable     (),
+m_seekTableBuilt(false)
 {
     m_vorbis.datasource = NULL;
 }
@@ -131,7 +134,19 @@ void SoundFileReaderOgg::seek(Uint64 sampleOffset)
 {
     assert(m_vorbis.datasource);
 
-    ov_pcm_seek(&m_vorbis, sampleOffset / m_channelCount);
+    Uint64 frame = sampleOffset / m_channelCount;
+
+    // Seeking to the beginning is cheap, don't build the index for it
+    if (frame > 0)
+    {
+        if (!m_seekTableBuilt)
+            buildSeekTable();
+
+        if (seekWithTable(frame))
+            return;
+    }
+
+    ov_pcm_seek(&m_vorbis, frame);
 }
 
 
@@ -163,6 +178,36 @@ Uint64 SoundFileReaderOgg::read(Int16* samples, Uint64 maxCount)
 }
 
 
+////////////////////////////////////////////////////////////
+Uint64 SoundFileReaderOgg::read(float* samples, Uint64 maxCount)
+{
+    assert(m_vorbis.datasource);
+
+    // Vorbis decodes to floats: interleave them without any conversion
+    Uint64 count = 0;
+    while (count + m_channelCount <= maxCount)
+    {
+        float** channels = NULL;
+        int framesToRead = static_cast<int>(std::min<Uint64>((maxCount - count) / m_channelCount, 4096));
+        long framesRead = ov_read_float(&m_vorbis, &channels, framesToRead, NULL);
+        if (framesRead > 0)
+        {
+            for (long i = 0; i < framesRead; ++i)
+                for (unsigned int j = 0; j < m_channelCount; ++j)
+                    *samples++ = channels[j][i];
+            count += framesRead * m_channelCount;
+        }
+        else
+        {
+            // error or end of file
+            break;
+        }
+    }
+
+    return count;
+}
+
+
 ////////////////////////////////////////////////////////////
 void SoundFileReaderOgg::close()
 {
@@ -171,9 +216,108 @@ void SoundFileReaderOgg::close()
         ov_clear(&m_vorbis);
         m_vorbis.datasource = NULL;
         m_channelCount = 0;
+        m_seekTable.clear();
+        m_seekTableBuilt = false;
     }
 }
 
+
+////////////////////////////////////////////////////////////
+void SoundFileReaderOgg::buildSeekTable()
+{
+    m_seekTableBuilt = true;
+
+    // Chained files restart their granule positions with each link
+    if (!ov_seekable(&m_vorbis) || (ov_streams(&m_vorbis) != 1))
+        return;
+
+    // Walk through the page headers, skipping their content
+    InputStream* stream = static_cast<InputStream*>(m_vorbis.datasource);
+    Int64 size = stream->getSize();
+    Int64 offset = 0;
+    std::vector<SeekPoint> table;
+    while (offset < size)
+    {
+        unsigned char header[27 + 255];
+        if ((stream->seek(offset) != offset) || (stream->read(header, 27) != 27) || (std::memcmp(header, "OggS", 4) != 0))
+            return;
+
+        unsigned int segmentCount = header[26];
+        if (stream->read(header + 27, segmentCount) != segmentCount)
+            return;
+
+        Int64 bodySize = 0;
+        for (unsigned int i = 0; i < segmentCount; ++i)
+            bodySize += header[27 + i];
+
+        // Pages in which no packet ends have no granule position (-1)
+        Uint64 granule = 0;
+        for (int i = 13; i >= 6; --i)
+            granule = (granule << 8) | header[i];
+        if (static_cast<Int64>(granule) >= 0)
+        {
+            SeekPoint point;
+            point.offset = offset;
+            point.granule = static_cast<Int64>(granule);
+            table.push_back(point);
+        }
+
+        offset += 27 + segmentCount + bodySize;
+    }
+
+    m_seekTable.swap(table);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundFileReaderOgg::seekWithTable(Uint64 frame)
+{
+    // Find the first page which ends after the target frame: once its previous
+    // packets are skipped (or used to prime the decoder), it contains the frame
+    std::size_t first = 0;
+    std::size_t last = m_seekTable.size();
+    while (first < last)
+    {
+        std::size_t middle = (first + last) / 2;
+        if (static_cast<Uint64>(m_seekTable[middle].granule) <= frame)
+            first = middle + 1;
+        else
+            last = middle;
+    }
+
+    if (first == m_seekTable.size())
+        return false;
+
+    // Step back a page if the decoding resumes after the target frame
+    for (std::size_t back = 0; (back <= first) && (back < 3); ++back)
+    {
+        if (ov_raw_seek(&m_vorbis, m_seekTable[first - back].offset) != 0)
+            return false;
+
+        ogg_int64_t position = ov_pcm_tell(&m_vorbis);
+        if (position < 0)
+            return false;
+
+        if (static_cast<Uint64>(position) <= frame)
+        {
+            // Decode and drop the frames up to the target
+            Uint64 remaining = frame - position;
+            while (remaining > 0)
+            {
+                float** channels = NULL;
+                long framesRead = ov_read_float(&m_vorbis, &channels, static_cast<int>(std::min<Uint64>(remaining, 4096)), NULL);
+                if (framesRead <= 0)
+                    return false;
+                remaining -= framesRead;
+            }
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundFileReader.hpp>
 #include <vorbis/vorbisfile.h>
+#include <vector>
 
 
 namespace sf
@@ -85,6 +86,10 @@ public:
     /// If the given offset exceeds to total number of samples,
     /// this function must jump to the end of the file.
     ///
+    /// The first seek builds an index of the Ogg pages, so that
+    /// the following ones jump directly to the right page
+    /// instead of bisecting through the file.
+    ///
     /// \param sampleOffset Index of the sample to jump to, relative to the beginning
     ///
     ////////////////////////////////////////////////////////////
@@ -101,6 +106,17 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Uint64 read(Int16* samples, Uint64 maxCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read audio samples from the open file, as 32-bit floats
+    ///
+    /// \param samples  Pointer to the sample array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Uint64 read(float* samples, Uint64 maxCount);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -109,11 +125,39 @@ private:
     ////////////////////////////////////////////////////////////
     void close();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Scan the Ogg pages of the file to build the seek index
+    ///
+    ////////////////////////////////////////////////////////////
+    void buildSeekTable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Seek to a frame with the help of the seek index
+    ///
+    /// \param frame Index of the frame to jump to
+    ///
+    /// \return True on success, false if the index can't be used
+    ///
+    ////////////////////////////////////////////////////////////
+    bool seekWithTable(Uint64 frame);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry of the seek index
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SeekPoint
+    {
+        Int64 offset;  // byte offset of the page in the stream
+        Int64 granule; // granule position (last PCM frame) of the page
+    };
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    OggVorbis_File m_vorbis;       // ogg/vorbis file handle
-    unsigned int   m_channelCount; // number of channels of the open sound file
+    OggVorbis_File         m_vorbis;         // ogg/vorbis file handle
+    unsigned int           m_channelCount;   // number of channels of the open sound file
+    std::vector<SeekPoint> m_seekTable;      // offsets and positions of the pages, empty if not built or unusable
+    bool                   m_seekTableBuilt; // has the seek index been built yet?
 };
 
 } // namespace priv
@@ -38,12 +38,7 @@ namespace
     // The following functions read integers as little endian and
     // return them in the host byte order
 
-    bool decode(sf::InputStream& stream, sf::Uint8& value)
-    {
-         return stream.read(&value, sizeof(value)) == sizeof(value);
-    }
-
-    bool decode(sf::InputStream& stream, sf::Int16& value)
+    bool decode(sf::InputStream& stream, sf::Uint16& value)
     {
         unsigned char bytes[sizeof(value)];
         if (stream.read(bytes, sizeof(bytes)) != sizeof(bytes))
@@ -54,40 +49,57 @@ namespace
         return true;
     }
 
-    bool decode(sf::InputStream& stream, sf::Uint16& value)
+    bool decode(sf::InputStream& stream, sf::Uint32& value)
     {
         unsigned char bytes[sizeof(value)];
         if (stream.read(bytes, sizeof(bytes)) != sizeof(bytes))
             return false;
 
-        value = bytes[0] | (bytes[1] << 8);
+        value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (bytes[3] << 24);
 
         return true;
     }
 
-    bool decode(sf::InputStream& stream, sf::Int32& value)
-    {
-        unsigned char bytes[sizeof(value)];
-        if (stream.read(bytes, sizeof(bytes)) != sizeof(bytes))
-            return false;
+    const sf::Uint64 mainChunkSize = 12;
 
-        value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (bytes[3] << 24);
+    // Size of the blocks read from the stream, so that a stream read is not made for every sample
+    const std::size_t blockSize = 65536;
 
-        return true;
+    // WAV samples are little-endian, 16-bit ones can be read as is on little-endian CPUs only
+    bool isLittleEndian()
+    {
+        sf::Uint16 one = 1;
+        return *reinterpret_cast<sf::Uint8*>(&one) == 1;
     }
 
-    bool decode(sf::InputStream& stream, sf::Uint32& value)
+    // The following functions convert blocks of little-endian samples to 16 bits;
+    // they are simple loops on purpose, so that the compiler can vectorize them
+
+    void convert8(const sf::Uint8* input, sf::Int16* output, std::size_t count)
     {
-        unsigned char bytes[sizeof(value)];
-        if (stream.read(bytes, sizeof(bytes)) != sizeof(bytes))
-            return false;
+        for (std::size_t i = 0; i < count; ++i)
+            output[i] = static_cast<sf::Int16>((input[i] - 128) << 8);
+    }
 
-        value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (bytes[3] << 24);
+    void swap16(sf::Int16* samples, std::size_t count)
+    {
+        sf::Uint8* bytes = reinterpret_cast<sf::Uint8*>(samples);
+        for (std::size_t i = 0; i < count; ++i)
+            samples[i] = static_cast<sf::Int16>(bytes[i * 2] | (bytes[i * 2 + 1] << 8));
+    }
 
-        return true;
+    void convert24(const sf::Uint8* input, sf::Int16* output, std::size_t count)
+    {
+        // Keep the two most significant bytes
+        for (std::size_t i = 0; i < count; ++i)
+            output[i] = static_cast<sf::Int16>(input[i * 3 + 1] | (input[i * 3 + 2] << 8));
     }
 
-    const sf::Uint64 mainChunkSize = 12;
+    void convert32(const sf::Uint8* input, sf::Int16* output, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            output[i] = static_cast<sf::Int16>(input[i * 4 + 2] | (input[i * 4 + 3] << 8));
+    }
 }
 
 namespace sf
@@ -144,49 +156,63 @@ Uint64 SoundFileReaderWav::read(Int16* samples, Uint64 maxCount)
 {
     assert(m_stream);
 
+    // 16-bit samples are read directly into the output
+    if (m_bytesPerSample == 2)
+    {
+        Int64 read = m_stream->read(samples, static_cast<Int64>(maxCount * sizeof(Int16)));
+        if (read <= 0)
+            return 0;
+
+        Uint64 count = static_cast<Uint64>(read) / sizeof(Int16);
+        if (!isLittleEndian())
+            swap16(samples, static_cast<std::size_t>(count));
+
+        return count;
+    }
+
+    // Other sizes are read by blocks, then converted
+    std::size_t samplesPerBlock = blockSize / m_bytesPerSample;
+    m_buffer.resize(samplesPerBlock * m_bytesPerSample);
+
     Uint64 count = 0;
     while (count < maxCount)
     {
+        std::size_t blockCount = static_cast<std::size_t>(std::min<Uint64>(maxCount - count, samplesPerBlock));
+        Int64 read = m_stream->read(&m_buffer[0], static_cast<Int64>(blockCount * m_bytesPerSample));
+        if (read <= 0)
+            break;
+
+        std::size_t readCount = static_cast<std::size_t>(read) / m_bytesPerSample;
         switch (m_bytesPerSample)
         {
-            case 1:
-            {
-                Uint8 sample = 0;
-                if (decode(*m_stream, sample))
-                    *samples++ = (static_cast<Int16>(sample) - 128) << 8;
-                else
-                    return count;
-                break;
-            }
-
-            case 2:
-            {
-                Int16 sample = 0;
-                if (decode(*m_stream, sample))
-                    *samples++ = sample;
-                else
-                    return count;
-                break;
-            }
-
-            case 4:
-            {
-                Int32 sample = 0;
-                if (decode(*m_stream, sample))
-                    *samples++ = sample >> 16;
-                else
-                    return count;
-                break;
-            }
+            case 1: convert8(&m_buffer[0], samples + count, readCount); break;
+            case 3: convert24(&m_buffer[0], samples + count, readCount); break;
+            case 4: convert32(&m_buffer[0], samples + count, readCount); break;
         }
 
-        ++count;
+        count += readCount;
+        if (readCount < blockCount)
+            break;
     }
 
     return count;
 }
 
 
+////////////////////////////////////////////////////////////
+Uint64 SoundFileReaderWav::getDataStart() const
+{
+    return m_dataStart;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoundFileReaderWav::getBytesPerSample() const
+{
+    return m_bytesPerSample;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool SoundFileReaderWav::parseHeader(Info& info)
 {
@@ -249,6 +275,8 @@ bool SoundFileReaderWav::parseHeader(Info& info)
             if (!decode(*m_stream, bitsPerSample))
                 return false;
             m_bytesPerSample = bitsPerSample / 8;
+            if ((m_bytesPerSample == 0) || (m_bytesPerSample > 4))
+                return false;
 
             // Skip potential extra information (should not exist for PCM)
             if (subChunkSize > 16)
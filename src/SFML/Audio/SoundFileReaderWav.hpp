@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundFileReader.hpp>
 #include <string>
+#include <vector>
 
 
 namespace sf
@@ -93,6 +94,25 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Uint64 read(Int16* samples, Uint64 maxCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the position of the first sample in the open file
+    ///
+    /// Samples are stored contiguously from this position, in
+    /// little-endian byte order and interleaved by channel.
+    ///
+    /// \return Offset of the audio data, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getDataStart() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of a sample in the open file
+    ///
+    /// \return Size of a sample, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getBytesPerSample() const;
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -108,9 +128,10 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    InputStream* m_stream;         ///< Source stream to read from
-    unsigned int m_bytesPerSample; ///< Size of a sample, in bytes
-    Uint64       m_dataStart;      ///< Starting position of the audio data in the open file
+    InputStream*       m_stream;         ///< Source stream to read from
+    unsigned int       m_bytesPerSample; ///< Size of a sample, in bytes
+    Uint64             m_dataStart;      ///< Starting position of the audio data in the open file
+    std::vector<Uint8> m_buffer;         ///< Block of raw samples being converted
 };
 
 } // namespace priv
@@ -0,0 +1,207 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundFileRecorder.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SoundFileRecorder::SoundFileRecorder() :
+m_file              (),
+m_filename          (),
+m_thread            (&SoundFileRecorder::write, this),
+m_mutex             (),
+m_condition         (),
+m_queue             (),
+m_freeChunks        (),
+m_queuedSamples     (0),
+m_maxQueuedDuration (seconds(10)),
+m_stopping          (false),
+m_sampleCount       (0),
+m_droppedSampleCount(0)
+{
+    m_thread.setName("sfml-audio-file");
+}
+
+
+////////////////////////////////////////////////////////////
+SoundFileRecorder::~SoundFileRecorder()
+{
+    // Make sure to stop the capture and the writing thread
+    stop();
+
+    for (std::vector<Chunk*>::iterator it = m_freeChunks.begin(); it != m_freeChunks.end(); ++it)
+        delete *it;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileRecorder::setFilename(const std::string& filename)
+{
+    m_filename = filename;
+}
+
+
+////////////////////////////////////////////////////////////
+const std::string& SoundFileRecorder::getFilename() const
+{
+    return m_filename;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileRecorder::setMaxQueuedDuration(Time duration)
+{
+    Lock lock(m_mutex);
+    m_maxQueuedDuration = duration;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 SoundFileRecorder::getSampleCount() const
+{
+    Lock lock(m_mutex);
+    return m_sampleCount;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 SoundFileRecorder::getDroppedSampleCount() const
+{
+    Lock lock(m_mutex);
+    return m_droppedSampleCount;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundFileRecorder::onStart()
+{
+    if (m_filename.empty())
+    {
+        err() << "Failed to start recording to a sound file (no file name was given)" << std::endl;
+        return false;
+    }
+
+    // Open the file now, so that errors are reported by start()
+    if (!m_file.openFromFile(m_filename, getSampleRate(), 1))
+        return false;
+
+    m_queuedSamples = 0;
+    m_stopping = false;
+    m_sampleCount = 0;
+    m_droppedSampleCount = 0;
+
+    m_thread.launch();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundFileRecorder::onProcessSamples(const Int16* samples, std::size_t sampleCount)
+{
+    if (sampleCount == 0)
+        return true;
+
+    Chunk* chunk = NULL;
+    {
+        Lock lock(m_mutex);
+
+        // Drop the samples rather than letting the queue grow when the writer can't keep up
+        std::size_t maxSamples = static_cast<std::size_t>(m_maxQueuedDuration.asSeconds() * getSampleRate());
+        if ((m_queuedSamples > 0) && (m_queuedSamples + sampleCount > maxSamples))
+        {
+            m_droppedSampleCount += sampleCount;
+            return true;
+        }
+
+        if (!m_freeChunks.empty())
+        {
+            chunk = m_freeChunks.back();
+            m_freeChunks.pop_back();
+        }
+    }
+
+    // Copy the samples outside of the lock, the writing thread can go on meanwhile
+    if (!chunk)
+        chunk = new Chunk;
+    chunk->assign(samples, samples + sampleCount);
+
+    Lock lock(m_mutex);
+    m_queue.push_back(chunk);
+    m_queuedSamples += sampleCount;
+    m_condition.notifyOne();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileRecorder::onStop()
+{
+    // Let the writing thread empty the queue, then finish
+    {
+        Lock lock(m_mutex);
+        m_stopping = true;
+        m_condition.notifyAll();
+    }
+    m_thread.wait();
+
+    m_file.close();
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileRecorder::write()
+{
+    for (;;)
+    {
+        Chunk* chunk = NULL;
+        {
+            Lock lock(m_mutex);
+            while (m_queue.empty() && !m_stopping)
+                m_condition.wait(m_mutex);
+
+            if (m_queue.empty())
+                break;
+
+            chunk = m_queue.front();
+            m_queue.pop_front();
+        }
+
+        m_file.write(&(*chunk)[0], chunk->size());
+
+        Lock lock(m_mutex);
+        m_queuedSamples -= chunk->size();
+        m_sampleCount += chunk->size();
+        m_freeChunks.push_back(chunk);
+    }
+}
+
+} // namespace sf
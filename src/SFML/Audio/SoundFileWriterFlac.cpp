@@ -32,6 +32,112 @@
 #include <cassert>
 
 
+namespace
+{
+    // Frames encoded by the parallel encoder have a fixed size, which lets each
+    // segment compute the numbers of its frames in the file on its own
+    const unsigned int blockSize = 4096;
+    const unsigned int blocksPerSegment = 32;
+
+    struct EncodedFrames
+    {
+        std::vector<FLAC__byte>  bytes;
+        std::vector<std::size_t> sizes;
+    };
+
+    FLAC__StreamEncoderWriteStatus streamWrite(const FLAC__StreamEncoder*, const FLAC__byte buffer[], size_t bytes, unsigned samples, unsigned, void* clientData)
+    {
+        // Only the frames are kept (each one comes in a single call), the metadata is written once for the whole file
+        if (samples > 0)
+        {
+            EncodedFrames* frames = static_cast<EncodedFrames*>(clientData);
+            frames->bytes.insert(frames->bytes.end(), buffer, buffer + bytes);
+            frames->sizes.push_back(bytes);
+        }
+
+        return FLAC__STREAM_ENCODER_WRITE_STATUS_OK;
+    }
+
+    sf::Uint8 crc8(const FLAC__byte* data, std::size_t size)
+    {
+        // Polynomial x^8 + x^2 + x + 1, used for the frame headers
+        sf::Uint8 crc = 0;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            crc ^= data[i];
+            for (int bit = 0; bit < 8; ++bit)
+                crc = static_cast<sf::Uint8>((crc & 0x80) ? (crc << 1) ^ 0x07 : (crc << 1));
+        }
+
+        return crc;
+    }
+
+    sf::Uint16 crc16(const FLAC__byte* data, std::size_t size)
+    {
+        // Polynomial x^16 + x^15 + x^2 + 1, used for the whole frames
+        sf::Uint16 crc = 0;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            crc ^= static_cast<sf::Uint16>(data[i] << 8);
+            for (int bit = 0; bit < 8; ++bit)
+                crc = static_cast<sf::Uint16>((crc & 0x8000) ? (crc << 1) ^ 0x8005 : (crc << 1));
+        }
+
+        return crc;
+    }
+
+    std::size_t getFrameNumberSize(FLAC__byte first)
+    {
+        // The frame number is coded like an UTF-8 character: the leading ones give its size
+        std::size_t size = 0;
+        while ((size < 8) && (first & (0x80 >> size)))
+            ++size;
+
+        return size == 0 ? 1 : size;
+    }
+
+    void encodeFrameNumber(sf::Uint32 number, std::vector<FLAC__byte>& output)
+    {
+        if (number < 0x80)
+        {
+            output.push_back(static_cast<FLAC__byte>(number));
+            return;
+        }
+
+        // Count the continuation bytes, each one carries 6 bits
+        std::size_t extra = 1;
+        while ((extra < 5) && (number >= (1u << (5 * extra + 6))))
+            ++extra;
+
+        output.push_back(static_cast<FLAC__byte>((0xFF00 >> (extra + 1)) | (number >> (6 * extra))));
+        for (std::size_t i = extra; i > 0; --i)
+            output.push_back(static_cast<FLAC__byte>(0x80 | ((number >> (6 * (i - 1))) & 0x3F)));
+    }
+
+    void renumberFrame(const FLAC__byte* frame, std::size_t size, sf::Uint32 number, std::vector<FLAC__byte>& output)
+    {
+        // Header: sync code and block parameters, frame number, optional block size and sample rate, CRC-8
+        std::size_t numberEnd = 4 + getFrameNumberSize(frame[4]);
+        unsigned int blockSizeCode = frame[2] >> 4;
+        unsigned int sampleRateCode = frame[2] & 0x0F;
+        std::size_t headerEnd = numberEnd;
+        headerEnd += (blockSizeCode == 6) ? 1 : (blockSizeCode == 7) ? 2 : 0;
+        headerEnd += (sampleRateCode == 12) ? 1 : ((sampleRateCode == 13) || (sampleRateCode == 14)) ? 2 : 0;
+
+        std::size_t start = output.size();
+        output.insert(output.end(), frame, frame + 4);
+        encodeFrameNumber(number, output);
+        output.insert(output.end(), frame + numberEnd, frame + headerEnd);
+        output.push_back(crc8(&output[start], output.size() - start));
+
+        // Subframes, then the CRC-16 of the whole frame
+        output.insert(output.end(), frame + headerEnd + 1, frame + size - 2);
+        sf::Uint16 crc = crc16(&output[start], output.size() - start);
+        output.push_back(static_cast<FLAC__byte>(crc >> 8));
+        output.push_back(static_cast<FLAC__byte>(crc & 0xFF));
+    }
+}
+
 namespace sf
 {
 namespace priv
@@ -50,7 +156,17 @@ bool SoundFileWriterFlac::check(const std::string& filename)
 SoundFileWriterFlac::SoundFileWriterFlac() :
 m_encoder     (NULL),
 m_channelCount(0),
-m_samples32   ()
+m_samples32   (),
+m_scheduler   (NULL),
+m_file        (),
+m_sampleRate  (0),
+m_segment     (NULL),
+m_segments    (),
+m_frameCount  (0),
+m_sampleCount (0),
+m_minFrameSize(0),
+m_maxFrameSize(0),
+m_failed      (false)
 {
 }
 
@@ -65,6 +181,14 @@ SoundFileWriterFlac::~SoundFileWriterFlac()
 ////////////////////////////////////////////////////////////
 bool SoundFileWriterFlac::open(const std::string& filename, unsigned int sampleRate, unsigned int channelCount)
 {
+    // Store the sound parameters
+    m_channelCount = channelCount;
+    m_sampleRate = sampleRate;
+
+    // With a scheduler, the frames are encoded by its workers and written by this class
+    if (m_scheduler)
+        return openParallel(filename);
+
     // Create the encoder
     m_encoder = FLAC__stream_encoder_new();
     if (!m_encoder)
@@ -86,9 +210,6 @@ bool SoundFileWriterFlac::open(const std::string& filename, unsigned int sampleR
         return false;
     }
 
-    // Store the channel count
-    m_channelCount = channelCount;
-
     return true;
 }
 
@@ -96,6 +217,30 @@ bool SoundFileWriterFlac::open(const std::string& filename, unsigned int sampleR
 ////////////////////////////////////////////////////////////
 void SoundFileWriterFlac::write(const Int16* samples, Uint64 count)
 {
+    if (m_scheduler)
+    {
+        // Fill segments of whole blocks, and encode each one as soon as it is full
+        std::size_t segmentSize = blockSize * blocksPerSegment * m_channelCount;
+        while (count > 0)
+        {
+            if (!m_segment)
+            {
+                m_segment = new Segment;
+                m_segment->samples.reserve(segmentSize);
+            }
+
+            std::size_t toCopy = static_cast<std::size_t>(std::min<Uint64>(count, segmentSize - m_segment->samples.size()));
+            m_segment->samples.insert(m_segment->samples.end(), samples, samples + toCopy);
+            samples += toCopy;
+            count -= toCopy;
+
+            if (m_segment->samples.size() == segmentSize)
+                submitSegment();
+        }
+
+        return;
+    }
+
     while (count > 0)
     {
         // Make sure that we don't process too many samples at once
@@ -114,9 +259,185 @@ void SoundFileWriterFlac::write(const Int16* samples, Uint64 count)
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundFileWriterFlac::setTaskScheduler(TaskScheduler* scheduler)
+{
+    m_scheduler = scheduler;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundFileWriterFlac::openParallel(const std::string& filename)
+{
+    m_file.open(filename.c_str(), std::ios_base::binary | std::ios_base::trunc);
+    if (!m_file)
+    {
+        err() << "Failed to write flac file \"" << filename << "\" (failed to open the file)" << std::endl;
+        return false;
+    }
+
+    m_frameCount = 0;
+    m_sampleCount = 0;
+    m_minFrameSize = 0;
+    m_maxFrameSize = 0;
+    m_failed = false;
+
+    // Reserve the room of the header, it is written again once the sizes are known
+    writeStreamInfo();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileWriterFlac::submitSegment()
+{
+    std::size_t frames = m_segment->samples.size() / m_channelCount;
+
+    m_segment->firstFrame = m_frameCount;
+    m_segment->sampleRate = m_sampleRate;
+    m_segment->channelCount = m_channelCount;
+    m_segment->succeeded = false;
+    m_segment->task = m_scheduler->add(&SoundFileWriterFlac::encodeSegment, m_segment);
+    m_frameCount += static_cast<Uint32>((frames + blockSize - 1) / blockSize);
+
+    m_segments.push_back(m_segment);
+    m_segment = NULL;
+
+    // Keep every worker busy, but don't let the encoded data pile up in memory
+    std::size_t maxSegments = 2 * m_scheduler->getWorkerCount() + 2;
+    while (m_segments.size() > maxSegments)
+        flushSegment();
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileWriterFlac::flushSegment()
+{
+    Segment* segment = m_segments.front();
+    m_segments.pop_front();
+    m_scheduler->wait(segment->task);
+
+    // The frames after a failed segment would leave a gap in the file, so they are dropped
+    if (!segment->succeeded && !m_failed)
+    {
+        err() << "Failed to write flac file (failed to encode the samples)" << std::endl;
+        m_failed = true;
+    }
+
+    if (!m_failed)
+    {
+        if (!segment->frames.empty())
+            m_file.write(reinterpret_cast<const char*>(&segment->frames[0]), static_cast<std::streamsize>(segment->frames.size()));
+
+        for (std::vector<std::size_t>::const_iterator it = segment->frameSizes.begin(); it != segment->frameSizes.end(); ++it)
+        {
+            m_minFrameSize = (m_minFrameSize == 0) ? *it : std::min(m_minFrameSize, *it);
+            m_maxFrameSize = std::max(m_maxFrameSize, *it);
+        }
+
+        m_sampleCount += segment->samples.size() / m_channelCount;
+    }
+
+    delete segment;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileWriterFlac::writeStreamInfo()
+{
+    // "fLaC", then the header of the last (and only) metadata block: STREAMINFO, 34 bytes
+    FLAC__byte header[42] = {'f', 'L', 'a', 'C', 0x80, 0, 0, 34};
+
+    // Minimum and maximum block sizes, minimum and maximum frame sizes
+    header[8]  = static_cast<FLAC__byte>(blockSize >> 8);
+    header[9]  = static_cast<FLAC__byte>(blockSize & 0xFF);
+    header[10] = static_cast<FLAC__byte>(blockSize >> 8);
+    header[11] = static_cast<FLAC__byte>(blockSize & 0xFF);
+    for (int i = 0; i < 3; ++i)
+    {
+        header[12 + i] = static_cast<FLAC__byte>(m_minFrameSize >> (16 - 8 * i));
+        header[15 + i] = static_cast<FLAC__byte>(m_maxFrameSize >> (16 - 8 * i));
+    }
+
+    // Sample rate (20 bits), channels - 1 (3 bits), bits per sample - 1 (5 bits), total samples (36 bits)
+    Uint64 fields = (static_cast<Uint64>(m_sampleRate) << 44) |
+                    (static_cast<Uint64>(m_channelCount - 1) << 41) |
+                    (static_cast<Uint64>(15) << 36) |
+                    (m_sampleCount & ((static_cast<Uint64>(1) << 36) - 1));
+    for (int i = 0; i < 8; ++i)
+        header[18 + i] = static_cast<FLAC__byte>(fields >> (56 - 8 * i));
+
+    // The MD5 signature of the samples is left empty, which means "unknown"
+
+    m_file.seekp(0);
+    m_file.write(reinterpret_cast<const char*>(header), sizeof(header));
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileWriterFlac::encodeSegment(Segment* segment)
+{
+    FLAC__StreamEncoder* encoder = FLAC__stream_encoder_new();
+    if (!encoder)
+        return;
+
+    // The settings are the default ones, except for a fixed block size known by the writer
+    FLAC__stream_encoder_set_channels(encoder, segment->channelCount);
+    FLAC__stream_encoder_set_bits_per_sample(encoder, 16);
+    FLAC__stream_encoder_set_sample_rate(encoder, segment->sampleRate);
+    FLAC__stream_encoder_set_blocksize(encoder, blockSize);
+
+    EncodedFrames encoded;
+    if (FLAC__stream_encoder_init_stream(encoder, &streamWrite, NULL, NULL, NULL, &encoded) == FLAC__STREAM_ENCODER_INIT_STATUS_OK)
+    {
+        // Convert the samples to 32-bits, one block at a time
+        std::vector<FLAC__int32> samples32;
+        bool succeeded = true;
+        for (std::size_t offset = 0; succeeded && (offset < segment->samples.size()); offset += blockSize * segment->channelCount)
+        {
+            std::size_t count = std::min<std::size_t>(blockSize * segment->channelCount, segment->samples.size() - offset);
+            samples32.assign(segment->samples.begin() + offset, segment->samples.begin() + offset + count);
+            succeeded = FLAC__stream_encoder_process_interleaved(encoder, &samples32[0], static_cast<unsigned>(count / segment->channelCount)) != 0;
+        }
+
+        segment->succeeded = (FLAC__stream_encoder_finish(encoder) != 0) && succeeded;
+    }
+
+    FLAC__stream_encoder_delete(encoder);
+
+    // The frames are numbered from the beginning of the segment, renumber them for the file
+    segment->frames.reserve(encoded.bytes.size() + encoded.sizes.size() * 4);
+    std::size_t offset = 0;
+    for (std::size_t i = 0; i < encoded.sizes.size(); ++i)
+    {
+        std::size_t start = segment->frames.size();
+        renumberFrame(&encoded.bytes[offset], encoded.sizes[i], segment->firstFrame + static_cast<Uint32>(i), segment->frames);
+        segment->frameSizes.push_back(segment->frames.size() - start);
+        offset += encoded.sizes[i];
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 void SoundFileWriterFlac::close()
 {
+    if (m_file.is_open())
+    {
+        // Encode the remaining samples, then wait for all the segments
+        if (m_segment && !m_segment->samples.empty())
+            submitSegment();
+
+        delete m_segment;
+        m_segment = NULL;
+
+        while (!m_segments.empty())
+            flushSegment();
+
+        writeStreamInfo();
+        m_file.close();
+    }
+
     if (m_encoder)
     {
         // Close the output stream
@@ -29,7 +29,10 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundFileWriter.hpp>
+#include <SFML/System/TaskScheduler.hpp>
 #include <FLAC/stream_encoder.h>
+#include <deque>
+#include <fstream>
 #include <vector>
 
 
@@ -90,8 +93,68 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void write(const Int16* samples, Uint64 count);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the task scheduler used to encode in parallel
+    ///
+    /// \param scheduler Task scheduler to use, or NULL to encode on the calling thread
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setTaskScheduler(TaskScheduler* scheduler);
+
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Samples encoded independently by a task of the scheduler
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Segment
+    {
+        std::vector<Int16>        samples;      ///< Samples to encode
+        std::vector<FLAC__byte>   frames;       ///< Encoded frames, numbered for their place in the file
+        std::vector<std::size_t>  frameSizes;   ///< Size of each encoded frame
+        Uint32                    firstFrame;   ///< Number of the first frame of the segment in the file
+        unsigned int              sampleRate;   ///< Sample rate of the sound
+        unsigned int              channelCount; ///< Number of channels of the sound
+        bool                      succeeded;    ///< Was the segment encoded successfully?
+        TaskScheduler::TaskId     task;         ///< Task encoding the segment
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open the file written by the parallel encoder
+    ///
+    /// \param filename Path of the file to open
+    ///
+    /// \return True if the file was successfully opened
+    ///
+    ////////////////////////////////////////////////////////////
+    bool openParallel(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give the current segment to the scheduler
+    ///
+    ////////////////////////////////////////////////////////////
+    void submitSegment();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait for the oldest segment and write its frames
+    ///
+    ////////////////////////////////////////////////////////////
+    void flushSegment();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write the STREAMINFO block at the beginning of the file
+    ///
+    ////////////////////////////////////////////////////////////
+    void writeStreamInfo();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Encode a segment (executed by a task of the scheduler)
+    ///
+    /// \param segment Segment to encode
+    ///
+    ////////////////////////////////////////////////////////////
+    static void encodeSegment(Segment* segment);
+
     ////////////////////////////////////////////////////////////
     /// \brief Close the file
     ///
@@ -101,9 +164,19 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    FLAC__StreamEncoder* m_encoder;      ///< FLAC stream encoder
-    unsigned int         m_channelCount; ///< Number of channels
-    std::vector<Int32>   m_samples32;    ///< Conversion buffer
+    FLAC__StreamEncoder*  m_encoder;       ///< FLAC stream encoder
+    unsigned int          m_channelCount;  ///< Number of channels
+    std::vector<Int32>    m_samples32;     ///< Conversion buffer
+    TaskScheduler*        m_scheduler;     ///< Scheduler encoding the segments, or NULL to encode on the calling thread
+    std::ofstream         m_file;          ///< File written by the parallel encoder
+    unsigned int          m_sampleRate;    ///< Sample rate of the sound
+    Segment*              m_segment;       ///< Segment being filled by write
+    std::deque<Segment*>  m_segments;      ///< Segments being encoded, oldest first
+    Uint32                m_frameCount;    ///< Number of frames in the segments submitted so far
+    Uint64                m_sampleCount;   ///< Number of samples per channel in the segments submitted so far
+    std::size_t           m_minFrameSize;  ///< Size of the smallest frame written
+    std::size_t           m_maxFrameSize;  ///< Size of the largest frame written
+    bool                  m_failed;        ///< Did the encoding of a segment fail?
 };
 
 } // namespace priv
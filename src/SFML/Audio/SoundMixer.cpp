@@ -0,0 +1,330 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundMixer.hpp>
+#include <SFML/Audio/Sound.hpp>
+#include <SFML/Audio/SoundBuffer.hpp>
+#include <SFML/Audio/Listener.hpp>
+#include <SFML/Audio/MixKernels.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Number of frames mixed at once (about 12 ms at 44.1 kHz)
+    const std::size_t chunkFrameCount = 512;
+
+    // Number of chunks queued in the stream, which sets the latency of the mix
+    const unsigned int chunkBufferCount = 4;
+
+    float length(const sf::Vector3f& v)
+    {
+        return std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SoundMixer::SoundMixer(unsigned int sampleRate) :
+m_output(chunkFrameCount * 2),
+m_temp  (chunkFrameCount * 2)
+{
+    initialize(2, sampleRate, FloatSamples);
+    setBufferCount(chunkBufferCount);
+
+    // The sounds are already spatialized in the mix
+    setRelativeToListener(true);
+}
+
+
+////////////////////////////////////////////////////////////
+SoundMixer::~SoundMixer()
+{
+    // Stop the mixing thread before the voices are destroyed
+    stop();
+
+    Lock lock(m_mutex);
+
+    for (std::set<Sound*>::iterator it = m_sounds.begin(); it != m_sounds.end(); ++it)
+        (*it)->m_mixer = NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SoundMixer::getPlayingCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_voices.size();
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundMixer::onGetData(FloatChunk& data)
+{
+    Lock lock(m_mutex);
+
+    std::fill(m_output.begin(), m_output.end(), 0.f);
+
+    // Right-hand axis of the listener, for panning
+    Vector3f listenerPosition = Listener::getPosition();
+    Vector3f direction = Listener::getDirection();
+    Vector3f up = Listener::getUpVector();
+    Vector3f right(direction.y * up.z - direction.z * up.y,
+                   direction.z * up.x - direction.x * up.z,
+                   direction.x * up.y - direction.y * up.x);
+    float rightLength = length(right);
+    if (rightLength > 0.f)
+        right /= rightLength;
+
+    for (std::size_t i = 0; i < m_voices.size();)
+    {
+        Voice& voice = m_voices[i];
+        if (voice.paused)
+        {
+            ++i;
+            continue;
+        }
+
+        // Read the samples at the playback rate of the sound
+        const Sound& sound = *voice.sound;
+        double step = sound.getPitch() * voice.sampleRate / getSampleRate();
+        std::size_t produced = priv::resample(voice.samples, voice.frameCount, voice.channelCount, voice.position,
+                                              step, sound.getLoop(), &m_temp[0], chunkFrameCount);
+
+        float leftGain = sound.getVolume() / 100.f;
+        float rightGain = leftGain;
+        if (voice.channelCount == 1)
+        {
+            // Attenuate with OpenAL's default inverse distance clamped model
+            Vector3f offset = sound.getPosition();
+            if (!sound.isRelativeToListener())
+                offset -= listenerPosition;
+
+            float distance = length(offset);
+            float minDistance = sound.getMinDistance();
+            if (distance > minDistance)
+                leftGain *= minDistance / (minDistance + sound.getAttenuation() * (distance - minDistance));
+
+            // Pan with an equal-power law
+            float pan = (distance > 0.f) ? (offset.x * right.x + offset.y * right.y + offset.z * right.z) / distance : 0.f;
+            float angle = (pan + 1.f) * 0.785398f;
+            rightGain = leftGain * std::sin(angle);
+            leftGain *= std::cos(angle);
+        }
+
+        // Ramp from the gains of the previous chunk, to avoid clicks
+        if (!voice.hasGains)
+        {
+            voice.leftGain = leftGain;
+            voice.rightGain = rightGain;
+            voice.hasGains = true;
+        }
+
+        if (voice.channelCount == 1)
+            priv::mixMono(&m_output[0], &m_temp[0], produced, voice.leftGain, voice.rightGain, leftGain, rightGain);
+        else
+            priv::mixStereo(&m_output[0], &m_temp[0], produced, voice.leftGain, voice.rightGain, leftGain, rightGain);
+
+        voice.leftGain = leftGain;
+        voice.rightGain = rightGain;
+
+        // Forget the sounds which reached their end
+        if (produced < chunkFrameCount)
+        {
+            m_voices[i] = m_voices.back();
+            m_voices.pop_back();
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    data.samples     = &m_output[0];
+    data.sampleCount = m_output.size();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::onSeek(Time)
+{
+    // A live mix can't be seeked
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::attachSound(Sound* sound)
+{
+    Lock lock(m_mutex);
+
+    m_sounds.insert(sound);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::detachSound(Sound* sound)
+{
+    Lock lock(m_mutex);
+
+    m_sounds.erase(sound);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::playSound(const Sound& sound)
+{
+    // The mixer reads the samples directly
+    const SoundBuffer* buffer = sound.getBuffer();
+    unsigned int channelCount = buffer->getChannelCount();
+    if (!buffer->getSamples() || (channelCount < 1) || (channelCount > 2))
+    {
+        err() << "Failed to play sound on mixer: its buffer must keep its samples and have 1 or 2 channels" << std::endl;
+        return;
+    }
+
+    {
+        Lock lock(m_mutex);
+
+        std::size_t index = findVoice(sound);
+        if (index < m_voices.size())
+        {
+            // Resume a paused sound, restart a playing one
+            if (!m_voices[index].paused)
+                m_voices[index].position = 0;
+            m_voices[index].paused = false;
+        }
+        else
+        {
+            Voice voice;
+            voice.sound        = &sound;
+            voice.samples      = buffer->getSamples();
+            voice.frameCount   = static_cast<std::size_t>(buffer->getSampleCount() / channelCount);
+            voice.channelCount = channelCount;
+            voice.sampleRate   = buffer->getSampleRate();
+            voice.position     = 0;
+            voice.paused       = false;
+            voice.hasGains     = false;
+            voice.leftGain     = 0.f;
+            voice.rightGain    = 0.f;
+            m_voices.push_back(voice);
+        }
+    }
+
+    // Start the mix with its first sound (outside the lock, the stream may already ask for data)
+    if (getStatus() == Stopped)
+        play();
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::pauseSound(const Sound& sound)
+{
+    Lock lock(m_mutex);
+
+    std::size_t index = findVoice(sound);
+    if (index < m_voices.size())
+        m_voices[index].paused = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::stopSound(const Sound& sound)
+{
+    Lock lock(m_mutex);
+
+    std::size_t index = findVoice(sound);
+    if (index < m_voices.size())
+    {
+        m_voices[index] = m_voices.back();
+        m_voices.pop_back();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundMixer::setSoundOffset(const Sound& sound, Time timeOffset)
+{
+    Lock lock(m_mutex);
+
+    std::size_t index = findVoice(sound);
+    if (index < m_voices.size())
+        m_voices[index].position = std::max(timeOffset.asSeconds(), 0.f) * m_voices[index].sampleRate;
+}
+
+
+////////////////////////////////////////////////////////////
+Time SoundMixer::getSoundOffset(const Sound& sound) const
+{
+    Lock lock(m_mutex);
+
+    std::size_t index = findVoice(sound);
+    if (index == m_voices.size())
+        return Time::Zero;
+
+    // The position may lie at the end of a looping buffer until the next chunk wraps it
+    const Voice& voice = m_voices[index];
+    double frameCount = static_cast<double>(voice.frameCount);
+    double position = voice.position;
+    if (position >= frameCount)
+        position = (sound.getLoop() && (frameCount > 0)) ? std::fmod(position, frameCount) : 0;
+
+    return seconds(static_cast<float>(position / voice.sampleRate));
+}
+
+
+////////////////////////////////////////////////////////////
+SoundSource::Status SoundMixer::getSoundStatus(const Sound& sound) const
+{
+    Lock lock(m_mutex);
+
+    std::size_t index = findVoice(sound);
+    if (index == m_voices.size())
+        return Stopped;
+
+    return m_voices[index].paused ? Paused : Playing;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SoundMixer::findVoice(const Sound& sound) const
+{
+    std::size_t index = 0;
+    while ((index < m_voices.size()) && (m_voices[index].sound != &sound))
+        ++index;
+
+    return index;
+}
+
+} // namespace sf
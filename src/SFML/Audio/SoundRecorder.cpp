@@ -30,7 +30,11 @@
 #include <SFML/Audio/ALCheck.hpp>
 #include <SFML/System/Sleep.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <cstring>
+#if defined(_MSC_VER)
+    #include <windows.h>
+#endif
 
 #ifdef _MSC_VER
     #pragma warning(disable: 4355) // 'this' used in base member initializer list
@@ -40,6 +44,17 @@
 namespace
 {
     ALCdevice* captureDevice = NULL;
+
+    // Full memory barrier, ordering the accesses to the ring buffer
+    // and to its indices between the capture thread and the consumer
+    void memoryBarrier()
+    {
+    #if defined(_MSC_VER)
+        MemoryBarrier();
+    #else
+        __sync_synchronize();
+    #endif
+    }
 }
 
 namespace sf
@@ -49,10 +64,16 @@ SoundRecorder::SoundRecorder() :
 m_thread            (&SoundRecorder::record, this),
 m_sampleRate        (0),
 m_processingInterval(milliseconds(100)),
-m_isCapturing       (false)
+m_isCapturing       (false),
+m_ringWrite         (0),
+m_ringRead          (0)
 {
     // Set the device name to the default device
     m_deviceName = getDefaultDevice();
+
+    // Don't let busy threads of the application delay the capture
+    m_thread.setName("sfml-capture");
+    m_thread.setPriority(Thread::RealTime);
 }
 
 
@@ -90,6 +111,8 @@ bool SoundRecorder::start(unsigned int sampleRate)
 
     // Clear the array of samples
     m_samples.clear();
+    m_ringWrite = 0;
+    m_ringRead = 0;
 
     // Store the sample rate
     m_sampleRate = sampleRate;
@@ -209,6 +232,34 @@ bool SoundRecorder::isAvailable()
 }
 
 
+////////////////////////////////////////////////////////////
+std::size_t SoundRecorder::readSamples(Int16* samples, std::size_t maxCount)
+{
+    if (m_ring.empty())
+        return 0;
+
+    // Only the capture thread writes m_ringWrite: read it before the samples it publishes
+    std::size_t write = m_ringWrite;
+    memoryBarrier();
+
+    std::size_t read = m_ringRead;
+    std::size_t count = std::min(write - read, maxCount);
+    std::size_t mask = m_ring.size() - 1;
+
+    // Copy the samples, in two parts if they wrap around the end of the ring
+    std::size_t start = read & mask;
+    std::size_t first = std::min(count, m_ring.size() - start);
+    std::copy(&m_ring[start], &m_ring[start] + first, samples);
+    std::copy(&m_ring[0], &m_ring[0] + (count - first), samples + first);
+
+    // Release the room only once the samples are copied
+    memoryBarrier();
+    m_ringRead = read + count;
+
+    return count;
+}
+
+
 ////////////////////////////////////////////////////////////
 void SoundRecorder::setProcessingInterval(sf::Time interval)
 {
@@ -216,6 +267,28 @@ void SoundRecorder::setProcessingInterval(sf::Time interval)
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundRecorder::setRingBufferSize(std::size_t sampleCount)
+{
+    if (m_isCapturing)
+    {
+        err() << "Failed to set the ring buffer size of the recorder (the capture is running)" << std::endl;
+        return;
+    }
+
+    // Round up to a power of two, so that the indices can wrap around freely
+    std::size_t capacity = 0;
+    if (sampleCount > 0)
+    {
+        capacity = 1;
+        while (capacity < sampleCount)
+            capacity *= 2;
+    }
+
+    std::vector<Int16>(capacity).swap(m_ring);
+}
+
+
 ////////////////////////////////////////////////////////////
 bool SoundRecorder::onStart()
 {
@@ -224,6 +297,14 @@ bool SoundRecorder::onStart()
 }
 
 
+////////////////////////////////////////////////////////////
+bool SoundRecorder::onProcessSamples(const Int16*, std::size_t)
+{
+    // Nothing to do
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void SoundRecorder::onStop()
 {
@@ -251,6 +332,12 @@ void SoundRecorder::record()
 ////////////////////////////////////////////////////////////
 void SoundRecorder::processCapturedSamples()
 {
+    if (!m_ring.empty())
+    {
+        captureToRing();
+        return;
+    }
+
     // Get the number of samples available
     ALCint samplesAvailable;
     alcGetIntegerv(captureDevice, ALC_CAPTURE_SAMPLES, 1, &samplesAvailable);
@@ -271,6 +358,38 @@ void SoundRecorder::processCapturedSamples()
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundRecorder::captureToRing()
+{
+    // Get the number of samples available
+    ALCint samplesAvailable;
+    alcGetIntegerv(captureDevice, ALC_CAPTURE_SAMPLES, 1, &samplesAvailable);
+    if (samplesAvailable <= 0)
+        return;
+
+    // Only the consumer writes m_ringRead: read it before reusing the room it released
+    std::size_t read = m_ringRead;
+    memoryBarrier();
+
+    // Take as many samples as the ring can hold, the others stay in the device
+    std::size_t write = m_ringWrite;
+    std::size_t count = std::min(static_cast<std::size_t>(samplesAvailable), m_ring.size() - (write - read));
+    std::size_t mask = m_ring.size() - 1;
+
+    // Capture directly into the ring, in two parts if they wrap around its end
+    std::size_t start = write & mask;
+    std::size_t first = std::min(count, m_ring.size() - start);
+    if (first > 0)
+        alcCaptureSamples(captureDevice, &m_ring[start], static_cast<ALCsizei>(first));
+    if (count > first)
+        alcCaptureSamples(captureDevice, &m_ring[0], static_cast<ALCsizei>(count - first));
+
+    // Publish the samples only once they are written
+    memoryBarrier();
+    m_ringWrite = write + count;
+}
+
+
 ////////////////////////////////////////////////////////////
 void SoundRecorder::cleanup()
 {
@@ -28,30 +28,299 @@
 #include <SFML/Audio/SoundStream.hpp>
 #include <SFML/Audio/AudioDevice.hpp>
 #include <SFML/Audio/ALCheck.hpp>
-#include <SFML/System/Sleep.hpp>
+#include <SFML/Audio/MixKernels.hpp>
+#include <SFML/Audio/SoundEffect.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/ConditionVariable.hpp>
 #include <SFML/System/Err.hpp>
 #include <SFML/System/Lock.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <algorithm>
+#include <vector>
 
 #ifdef _MSC_VER
     #pragma warning(disable: 4355) // 'this' used in base member initializer list
 #endif
 
 
+namespace
+{
+    // Protects the creation of the streaming scheduler
+    sf::Mutex schedulerMutex;
+
+    // Counters shared by all the streams, and their mutex
+    sf::Mutex    statisticsMutex;
+    unsigned int streamCount          = 0;
+    unsigned int streamingStreamCount = 0;
+    sf::Uint64   totalUnderruns       = 0;
+
+    // Number of refills kept to compute the percentiles
+    const std::size_t statisticsSampleCount = 128;
+
+    // Record a measure in a circular list of the last ones
+    void addSample(std::vector<sf::Int64>& samples, sf::Uint64 index, sf::Int64 value)
+    {
+        if (samples.size() < statisticsSampleCount)
+            samples.push_back(value);
+        else
+            samples[index % statisticsSampleCount] = value;
+    }
+
+    // Get a percentile of the recorded measures (the list is reordered)
+    sf::Time getPercentile(std::vector<sf::Int64>& samples, std::size_t percent)
+    {
+        if (samples.empty())
+            return sf::Time::Zero;
+
+        std::vector<sf::Int64>::iterator nth = samples.begin() + (samples.size() - 1) * percent / 100;
+        std::nth_element(samples.begin(), nth, samples.end());
+
+        return sf::microseconds(*nth);
+    }
+}
+
+
 namespace sf
 {
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Timer thread waking up the streams when their queue is due
+///
+/// Instead of polling its queue, each stream tells when its
+/// next buffer will be processed, and sleeps until the
+/// scheduler wakes it up. The scheduler itself sleeps until
+/// the earliest of these times; it never refills a queue, so
+/// a stream whose onGetData blocks doesn't delay the others.
+///
+////////////////////////////////////////////////////////////
+class SoundStreamScheduler : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the scheduler shared by all the streams
+    ///
+    ////////////////////////////////////////////////////////////
+    static SoundStreamScheduler& getInstance()
+    {
+        Lock lock(schedulerMutex);
+
+        // Never destroyed, so that streams can still be stopped during the static destruction
+        static SoundStreamScheduler* instance = new SoundStreamScheduler;
+
+        return *instance;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wake up a stream after a delay
+    ///
+    /// \param stream Stream to wake up
+    /// \param delay  Delay before waking it up
+    ///
+    ////////////////////////////////////////////////////////////
+    void schedule(SoundStream& stream, Time delay)
+    {
+        Lock lock(m_mutex);
+
+        Entry entry = {&stream, m_clock.getElapsedTime() + delay};
+        std::size_t index = find(stream);
+        if (index < m_entries.size())
+            m_entries[index] = entry;
+        else
+            m_entries.push_back(entry);
+
+        if (!m_running)
+        {
+            m_running = true;
+            m_thread.launch();
+        }
+        else if ((m_entries.size() == 1) || (entry.nextUpdate < m_wakeUp))
+        {
+            // Wake up the timer earlier than it planned
+            m_wakeUp = entry.nextUpdate;
+            m_condition.notifyOne();
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Cancel the wake-up of a stream
+    ///
+    /// Once this function returns, the scheduler no longer
+    /// accesses the stream.
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(SoundStream& stream)
+    {
+        Lock lock(m_mutex);
+
+        std::size_t index = find(stream);
+        if (index < m_entries.size())
+            m_entries.erase(m_entries.begin() + index);
+    }
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stream waiting for the scheduler
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        SoundStream* stream;     ///< Stream to wake up
+        Time         nextUpdate; ///< Time of the wake-up, on the clock of the scheduler
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    SoundStreamScheduler() :
+    m_running(false),
+    m_wakeUp (Time::Zero),
+    m_thread (&SoundStreamScheduler::run, this)
+    {
+        // Waking up the streams is short and latency-critical
+        m_thread.setName("sfml-streams");
+        m_thread.setPriority(Thread::RealTime);
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the entry of a stream (the mutex must be locked)
+    ///
+    /// \return Index of the entry, or the number of entries if not found
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t find(const SoundStream& stream) const
+    {
+        for (std::size_t i = 0; i < m_entries.size(); ++i)
+        {
+            if (m_entries[i].stream == &stream)
+                return i;
+        }
+
+        return m_entries.size();
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wake up the streams that are due, then sleep until the next one
+    ///
+    ////////////////////////////////////////////////////////////
+    void run()
+    {
+        Lock lock(m_mutex);
+
+        for (;;)
+        {
+            // Each wake-up is done once: the stream schedules the next one after refilling its queue
+            Time now = m_clock.getElapsedTime();
+            std::size_t i = 0;
+            while (i < m_entries.size())
+            {
+                if (m_entries[i].nextUpdate <= now)
+                {
+                    m_entries[i].stream->wakeUp();
+                    m_entries.erase(m_entries.begin() + i);
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+
+            // Sleep until the next stream has a processed buffer, or a stream is scheduled
+            if (m_entries.empty())
+            {
+                m_wakeUp = Time::Zero;
+                m_condition.wait(m_mutex);
+                continue;
+            }
+
+            m_wakeUp = m_entries[0].nextUpdate;
+            for (std::size_t j = 1; j < m_entries.size(); ++j)
+                m_wakeUp = std::min(m_wakeUp, m_entries[j].nextUpdate);
+
+            Time delay = m_wakeUp - m_clock.getElapsedTime();
+            if (delay > Time::Zero)
+                m_condition.wait(m_mutex, delay);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Clock              m_clock;     ///< Clock measuring the wake-up times
+    Mutex              m_mutex;     ///< Mutex protecting the entries and the timer state
+    ConditionVariable  m_condition; ///< Notified when the timer must wake up earlier
+    std::vector<Entry> m_entries;   ///< Streams waiting to be woken up
+    bool               m_running;   ///< Has the timer thread been launched?
+    Time               m_wakeUp;    ///< Time at which the timer will wake up the streams
+    Thread             m_thread;    ///< Timer thread, which runs until the program exits
+};
+
+} // namespace priv
+
+
+////////////////////////////////////////////////////////////
+SoundStream::Statistics::Statistics() :
+underruns          (0),
+refills            (0),
+queuedDuration     (Time::Zero),
+refillLatencyMedian(Time::Zero),
+refillLatency99    (Time::Zero),
+refillLatencyMax   (Time::Zero),
+decodeTimeMedian   (Time::Zero),
+decodeTime99       (Time::Zero),
+decodeTimeMax      (Time::Zero)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SoundStream::GlobalStatistics::GlobalStatistics() :
+streams         (0),
+streamingStreams(0),
+underruns       (0)
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 SoundStream::SoundStream() :
 m_thread          (&SoundStream::streamData, this),
 m_threadMutex     (),
+m_updateCondition (),
+m_updateDue       (false),
 m_threadStartState(Stopped),
 m_isStreaming     (false),
 m_channelCount    (0),
 m_sampleRate      (0),
 m_format          (0),
 m_loop            (false),
-m_samplesProcessed(0)
+m_samplesProcessed(0),
+m_requestStop     (false),
+m_queuedSamples   (0),
+m_bufferCount     (3),
+m_sampleFormat    (Int16Samples),
+m_convertFloats   (false),
+m_nextUpdate      (Time::Zero),
+m_underruns       (0),
+m_refills         (0),
+m_latencyCount    (0)
 {
+    // Streams keep their own OpenAL source for their whole lifetime
+    alCheck(alGenSources(1, &m_source));
+    alCheck(alSourcei(m_source, AL_BUFFER, 0));
 
+    {
+        Lock lock(statisticsMutex);
+        ++streamCount;
+    }
+
+    // Don't let busy threads of the application delay the refills; the thread decodes,
+    // which is too long to preempt the whole system like the real-time scheduler does
+    m_thread.setName("sfml-stream");
+    m_thread.setPriority(Thread::High);
 }
 
 
@@ -64,21 +333,39 @@ SoundStream::~SoundStream()
     {
         Lock lock(m_threadMutex);
         m_isStreaming = false;
+        m_updateCondition.notifyOne();
     }
 
     // Wait for the thread to terminate
     m_thread.wait();
+
+    // Destroy the OpenAL source
+    alCheck(alSourcei(m_source, AL_BUFFER, 0));
+    alCheck(alDeleteSources(1, &m_source));
+
+    Lock lock(statisticsMutex);
+    --streamCount;
 }
 
 
 ////////////////////////////////////////////////////////////
-void SoundStream::initialize(unsigned int channelCount, unsigned int sampleRate)
+void SoundStream::initialize(unsigned int channelCount, unsigned int sampleRate, SampleFormat sampleFormat)
 {
-    m_channelCount = channelCount;
-    m_sampleRate   = sampleRate;
-
-    // Deduce the format from the number of channels
-    m_format = priv::AudioDevice::getFormatFromChannelCount(channelCount);
+    m_channelCount  = channelCount;
+    m_sampleRate    = sampleRate;
+    m_sampleFormat  = sampleFormat;
+    m_convertFloats = false;
+
+    // Deduce the format from the number of channels, falling back
+    // to a conversion if the device can't play float samples
+    m_format = 0;
+    if (sampleFormat == FloatSamples)
+        m_format = priv::AudioDevice::getFloatFormatFromChannelCount(channelCount);
+    if (m_format == 0)
+    {
+        m_format = priv::AudioDevice::getFormatFromChannelCount(channelCount);
+        m_convertFloats = (sampleFormat == FloatSamples);
+    }
 
     // Check if the format is valid
     if (m_format == 0)
@@ -89,6 +376,29 @@ void SoundStream::initialize(unsigned int channelCount, unsigned int sampleRate)
     }
 }
 
+////////////////////////////////////////////////////////////
+bool SoundStream::onGetData(Chunk&)
+{
+    err() << "Audio stream doesn't provide 16-bit samples (override onGetData(Chunk&))" << std::endl;
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundStream::onGetData(FloatChunk&)
+{
+    err() << "Audio stream doesn't provide float samples (override onGetData(FloatChunk&))" << std::endl;
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 SoundStream::onLoop()
+{
+    onSeek(Time::Zero);
+    return 0;
+}
+
 
 ////////////////////////////////////////////////////////////
 void SoundStream::play()
@@ -160,6 +470,7 @@ void SoundStream::stop()
     {
         Lock lock(m_threadMutex);
         m_isStreaming = false;
+        m_updateCondition.notifyOne();
     }
 
     // Wait for the thread to terminate
@@ -187,6 +498,13 @@ unsigned int SoundStream::getSampleRate() const
 }
 
 
+////////////////////////////////////////////////////////////
+SoundStream::SampleFormat SoundStream::getSampleFormat() const
+{
+    return m_sampleFormat;
+}
+
+
 ////////////////////////////////////////////////////////////
 SoundStream::Status SoundStream::getStatus() const
 {
@@ -246,6 +564,134 @@ Time SoundStream::getPlayingOffset() const
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundStream::setBufferCount(unsigned int count)
+{
+    count = std::max(2u, std::min(count, static_cast<unsigned int>(MaxBufferCount)));
+    if (count == m_bufferCount)
+        return;
+
+    // The buffers are created when the stream starts
+    Status status = getStatus();
+    if (status == Stopped)
+    {
+        m_bufferCount = count;
+        return;
+    }
+
+    // Restart the stream at the same position with the new buffers
+    Time timeOffset = getPlayingOffset();
+    stop();
+
+    m_bufferCount = count;
+
+    onSeek(timeOffset);
+    m_samplesProcessed = static_cast<Uint64>(timeOffset.asSeconds() * m_sampleRate * m_channelCount);
+    m_isStreaming = true;
+    m_threadStartState = status;
+    m_thread.launch();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoundStream::getBufferCount() const
+{
+    return m_bufferCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::addEffect(SoundEffect& effect)
+{
+    Lock lock(m_effectMutex);
+
+    effect.reset();
+    m_effects.push_back(&effect);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::removeEffect(SoundEffect& effect)
+{
+    Lock lock(m_effectMutex);
+
+    m_effects.erase(std::remove(m_effects.begin(), m_effects.end(), &effect), m_effects.end());
+}
+
+
+////////////////////////////////////////////////////////////
+Time SoundStream::getLatency() const
+{
+    if (!m_channelCount || !m_sampleRate)
+        return Time::Zero;
+
+    // Get the position of the source in the current buffer
+    ALint offset = 0;
+    alCheck(alGetSourcei(m_source, AL_SAMPLE_OFFSET, &offset));
+
+    Lock lock(m_threadMutex);
+
+    // Duration of the samples which are still queued
+    Uint64 played = static_cast<Uint64>(offset) * m_channelCount;
+    Uint64 remaining = (m_queuedSamples > played) ? m_queuedSamples - played : 0;
+
+    return seconds(static_cast<float>(remaining) / m_channelCount / m_sampleRate);
+}
+
+
+////////////////////////////////////////////////////////////
+SoundStream::Statistics SoundStream::getStatistics() const
+{
+    Statistics statistics;
+    statistics.queuedDuration = getLatency();
+
+    Lock lock(m_threadMutex);
+
+    statistics.underruns = m_underruns;
+    statistics.refills   = m_refills;
+
+    // Work on copies, the percentiles reorder the measures
+    std::vector<Int64> latencies = m_refillLatencies;
+    statistics.refillLatencyMedian = getPercentile(latencies, 50);
+    statistics.refillLatency99     = getPercentile(latencies, 99);
+    statistics.refillLatencyMax    = getPercentile(latencies, 100);
+
+    std::vector<Int64> decodeTimes = m_decodeTimes;
+    statistics.decodeTimeMedian = getPercentile(decodeTimes, 50);
+    statistics.decodeTime99     = getPercentile(decodeTimes, 99);
+    statistics.decodeTimeMax    = getPercentile(decodeTimes, 100);
+
+    return statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::resetStatistics()
+{
+    Lock lock(m_threadMutex);
+
+    m_underruns = 0;
+    m_refills = 0;
+    m_latencyCount = 0;
+    m_refillLatencies.clear();
+    m_decodeTimes.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+SoundStream::GlobalStatistics SoundStream::getGlobalStatistics()
+{
+    Lock lock(statisticsMutex);
+
+    GlobalStatistics statistics;
+    statistics.streams          = streamCount;
+    statistics.streamingStreams = streamingStreamCount;
+    statistics.underruns        = totalUnderruns;
+
+    return statistics;
+}
+
+
 ////////////////////////////////////////////////////////////
 void SoundStream::setLoop(bool loop)
 {
@@ -263,8 +709,6 @@ bool SoundStream::getLoop() const
 ////////////////////////////////////////////////////////////
 void SoundStream::streamData()
 {
-    bool requestStop = false;
-
     {
         Lock lock(m_threadMutex);
 
@@ -276,13 +720,24 @@ void SoundStream::streamData()
         }
     }
 
+    // Don't let the effects carry the audio played before a stop or a seek
+    {
+        Lock lock(m_effectMutex);
+        for (std::vector<SoundEffect*>::iterator it = m_effects.begin(); it != m_effects.end(); ++it)
+            (*it)->reset();
+    }
+
     // Create the buffers
-    alCheck(alGenBuffers(BufferCount, m_buffers));
-    for (int i = 0; i < BufferCount; ++i)
-        m_endBuffers[i] = false;
+    alCheck(alGenBuffers(m_bufferCount, m_buffers));
+    for (unsigned int i = 0; i < m_bufferCount; ++i)
+        m_bufferSeeks[i] = NoLoop;
+    {
+        Lock lock(m_threadMutex);
+        m_queuedSamples = 0;
+    }
 
     // Fill the queue
-    requestStop = fillQueue();
+    m_requestStop = fillQueue();
 
     // Play the sound
     alCheck(alSourcePlay(m_source));
@@ -295,93 +750,181 @@ void SoundStream::streamData()
             alCheck(alSourcePause(m_source));
     }
 
+    {
+        Lock lock(statisticsMutex);
+        ++streamingStreamCount;
+    }
+
+    // Refill the buffers when the scheduler tells that they are processed
+    priv::SoundStreamScheduler& scheduler = priv::SoundStreamScheduler::getInstance();
+    Time delay = getUpdateDelay();
+    m_nextUpdate = m_statisticsClock.getElapsedTime() + delay;
     for (;;)
     {
+        scheduler.schedule(*this, delay);
+
+        // Sleep until the wake-up, or until the stream is stopped
         {
             Lock lock(m_threadMutex);
-            if (!m_isStreaming)
-                break;
+            while (!m_updateDue && m_isStreaming)
+                m_updateCondition.wait(m_threadMutex);
+            m_updateDue = false;
         }
 
-        // The stream has been interrupted!
-        if (SoundSource::getStatus() == Stopped)
+        // Refill the queue without holding any lock of the scheduler, so that a slow onGetData only delays this stream
+        if (!updateQueue(delay))
+            break;
+    }
+
+    scheduler.remove(*this);
+    closeQueue();
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::wakeUp()
+{
+    Lock lock(m_threadMutex);
+    m_updateDue = true;
+    m_updateCondition.notifyOne();
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundStream::updateQueue(Time& delay)
+{
+    bool isStreaming;
+    {
+        Lock lock(m_threadMutex);
+        isStreaming = m_isStreaming;
+    }
+    if (!isStreaming)
+        return false;
+
+    // The stream has been interrupted!
+    if (SoundSource::getStatus() == Stopped)
+    {
+        if (!m_requestStop)
         {
-            if (!requestStop)
+            // The queue ran empty before being refilled: count the underrun and just continue
             {
-                // Just continue
-                alCheck(alSourcePlay(m_source));
+                Lock lock(m_threadMutex);
+                ++m_underruns;
             }
-            else
             {
-                // End streaming
-                Lock lock(m_threadMutex);
-                m_isStreaming = false;
+                Lock lock(statisticsMutex);
+                ++totalUnderruns;
             }
+
+            alCheck(alSourcePlay(m_source));
         }
+        else
+        {
+            // End streaming
+            Lock lock(m_threadMutex);
+            m_isStreaming = false;
+            isStreaming = false;
+        }
+    }
 
-        // Get the number of buffers that have been processed (i.e. ready for reuse)
-        ALint nbProcessed = 0;
-        alCheck(alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &nbProcessed));
+    // Get the number of buffers that have been processed (i.e. ready for reuse)
+    ALint nbProcessed = 0;
+    alCheck(alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &nbProcessed));
+    bool refilled = (nbProcessed > 0) && !m_requestStop;
 
-        while (nbProcessed--)
-        {
-            // Pop the first unused buffer from the queue
-            ALuint buffer;
-            alCheck(alSourceUnqueueBuffers(m_source, 1, &buffer));
-
-            // Find its number
-            unsigned int bufferNum = 0;
-            for (int i = 0; i < BufferCount; ++i)
-                if (m_buffers[i] == buffer)
-                {
-                    bufferNum = i;
-                    break;
-                }
+    while (nbProcessed--)
+    {
+        // Pop the first unused buffer from the queue
+        ALuint buffer;
+        alCheck(alSourceUnqueueBuffers(m_source, 1, &buffer));
 
-            // Retrieve its size and add it to the samples count
-            if (m_endBuffers[bufferNum])
+        // Find its number
+        unsigned int bufferNum = 0;
+        for (unsigned int i = 0; i < m_bufferCount; ++i)
+            if (m_buffers[i] == buffer)
             {
-                // This was the last buffer: reset the sample count
-                m_samplesProcessed = 0;
-                m_endBuffers[bufferNum] = false;
+                bufferNum = i;
+                break;
             }
-            else
-            {
-                ALint size, bits;
-                alCheck(alGetBufferi(buffer, AL_SIZE, &size));
-                alCheck(alGetBufferi(buffer, AL_BITS, &bits));
 
-                // Bits can be 0 if the format or parameters are corrupt, avoid division by zero
-                if (bits == 0)
-                {
-                    err() << "Bits in sound stream are 0: make sure that the audio format is not corrupt "
-                          << "and initialize() has been called correctly" << std::endl;
-
-                    // Abort streaming (exit main loop)
-                    Lock lock(m_threadMutex);
-                    m_isStreaming = false;
-                    requestStop = true;
-                    break;
-                }
-                else
-                {
-                    m_samplesProcessed += size / (bits / 8);
-                }
-            }
+        // Retrieve its size
+        ALint size, bits;
+        alCheck(alGetBufferi(buffer, AL_SIZE, &size));
+        alCheck(alGetBufferi(buffer, AL_BITS, &bits));
 
-            // Fill it and push it back into the playing queue
-            if (!requestStop)
-            {
-                if (fillAndPushBuffer(bufferNum))
-                    requestStop = true;
-            }
+        // Bits can be 0 if the format or parameters are corrupt, avoid division by zero
+        if (bits == 0)
+        {
+            err() << "Bits in sound stream are 0: make sure that the audio format is not corrupt "
+                  << "and initialize() has been called correctly" << std::endl;
+
+            // Abort streaming
+            Lock lock(m_threadMutex);
+            m_isStreaming = false;
+            m_requestStop = true;
+            return false;
+        }
+
+        Uint64 samples = static_cast<Uint64>(size / (bits / 8));
+        {
+            Lock lock(m_threadMutex);
+            m_queuedSamples -= std::min(samples, m_queuedSamples);
+        }
+
+        // Add it to the samples count
+        if (m_bufferSeeks[bufferNum] != NoLoop)
+        {
+            // This was the last buffer before a loop or the end: jump to the new position
+            m_samplesProcessed = static_cast<Uint64>(m_bufferSeeks[bufferNum]);
+            m_bufferSeeks[bufferNum] = NoLoop;
+        }
+        else
+        {
+            m_samplesProcessed += samples;
+        }
+
+        // Fill it and push it back into the playing queue
+        if (!m_requestStop)
+        {
+            if (fillAndPushBuffer(bufferNum))
+                m_requestStop = true;
         }
+    }
 
-        // Leave some time for the other threads if the stream is still playing
-        if (SoundSource::getStatus() != Stopped)
-            sleep(milliseconds(10));
+    // Measure how late the refill completed, compared to the time the first buffer was due
+    Time now = m_statisticsClock.getElapsedTime();
+    if (refilled)
+    {
+        Lock lock(m_threadMutex);
+        addSample(m_refillLatencies, m_latencyCount++, std::max(now - m_nextUpdate, Time::Zero).asMicroseconds());
     }
 
+    delay = getUpdateDelay();
+    m_nextUpdate = now + delay;
+
+    return isStreaming;
+}
+
+
+////////////////////////////////////////////////////////////
+Time SoundStream::getUpdateDelay() const
+{
+    ALint nbQueued = 0;
+    alCheck(alGetSourcei(m_source, AL_BUFFERS_QUEUED, &nbQueued));
+    if ((nbQueued == 0) || (m_channelCount == 0) || (m_sampleRate == 0))
+        return milliseconds(10);
+
+    // With equally sized buffers, the first one is processed before this delay
+    // and the queue is still not empty after it
+    Time delay = getLatency() / static_cast<float>(nbQueued);
+
+    return std::max(milliseconds(1), std::min(delay, seconds(1)));
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::closeQueue()
+{
     // Stop the playback
     alCheck(alSourceStop(m_source));
 
@@ -390,7 +933,10 @@ void SoundStream::streamData()
 
     // Delete the buffers
     alCheck(alSourcei(m_source, AL_BUFFER, 0));
-    alCheck(alDeleteBuffers(BufferCount, m_buffers));
+    alCheck(alDeleteBuffers(m_bufferCount, m_buffers));
+
+    Lock lock(statisticsMutex);
+    --streamingStreamCount;
 }
 
 
@@ -400,20 +946,44 @@ bool SoundStream::fillAndPushBuffer(unsigned int bufferNum)
     bool requestStop = false;
 
     // Acquire audio data
-    Chunk data = {NULL, 0};
-    if (!onGetData(data))
+    const void* samples = NULL;
+    std::size_t sampleCount = 0;
+    bool hasData = false;
+    Time decodeStart = m_statisticsClock.getElapsedTime();
+    if (m_sampleFormat == FloatSamples)
+    {
+        FloatChunk data = {NULL, 0};
+        hasData = onGetData(data);
+        samples = data.samples;
+        sampleCount = data.sampleCount;
+    }
+    else
+    {
+        Chunk data = {NULL, 0};
+        hasData = onGetData(data);
+        samples = data.samples;
+        sampleCount = data.sampleCount;
+    }
+
+    {
+        Lock lock(m_threadMutex);
+        addSample(m_decodeTimes, m_refills++, (m_statisticsClock.getElapsedTime() - decodeStart).asMicroseconds());
+    }
+
+    if (!hasData)
     {
         // Mark the buffer as the last one (so that we know when to reset the playing position)
-        m_endBuffers[bufferNum] = true;
+        m_bufferSeeks[bufferNum] = 0;
 
         // Check if the stream must loop or stop
-        if (m_loop)
+        Int64 loopStart = m_loop ? onLoop() : NoLoop;
+        if (loopStart != NoLoop)
         {
-            // Return to the beginning of the stream source
-            onSeek(Time::Zero);
+            // The playing position jumps to the beginning of the loop after this buffer
+            m_bufferSeeks[bufferNum] = loopStart;
 
             // If we previously had no data, try to fill the buffer once again
-            if (!data.samples || (data.sampleCount == 0))
+            if (!samples || (sampleCount == 0))
             {
                 return fillAndPushBuffer(bufferNum);
             }
@@ -426,28 +996,74 @@ bool SoundStream::fillAndPushBuffer(unsigned int bufferNum)
     }
 
     // Fill the buffer if some data was returned
-    if (data.samples && data.sampleCount)
+    if (samples && sampleCount)
     {
         unsigned int buffer = m_buffers[bufferNum];
+        bool floats = (m_sampleFormat == FloatSamples);
+
+        // Run the effects on a float copy of the chunk
+        {
+            Lock lock(m_effectMutex);
+
+            if (!m_effects.empty())
+            {
+                std::size_t frameCount = sampleCount / m_channelCount;
+                m_effectSamples.resize(frameCount * m_channelCount);
+                if (floats)
+                {
+                    const float* source = static_cast<const float*>(samples);
+                    std::copy(source, source + m_effectSamples.size(), m_effectSamples.begin());
+                }
+                else
+                {
+                    double position = 0;
+                    priv::resample(static_cast<const Int16*>(samples), frameCount, m_channelCount, position, 1.0, false, &m_effectSamples[0], frameCount);
+                }
+
+                for (std::vector<SoundEffect*>::iterator it = m_effects.begin(); it != m_effects.end(); ++it)
+                    (*it)->process(&m_effectSamples[0], frameCount, m_channelCount, m_sampleRate);
+
+                samples = &m_effectSamples[0];
+                sampleCount = m_effectSamples.size();
+                floats = true;
+            }
+        }
+
+        // Convert float samples if the device can't play them directly
+        ALsizei sampleSize = floats ? sizeof(float) : sizeof(Int16);
+        if (floats && (m_convertFloats || (m_sampleFormat == Int16Samples)))
+        {
+            const float* input = static_cast<const float*>(samples);
+            m_convertedSamples.resize(sampleCount);
+            for (std::size_t i = 0; i < sampleCount; ++i)
+                m_convertedSamples[i] = static_cast<Int16>(std::max(-1.f, std::min(input[i], 1.f)) * 32767.f);
+
+            samples = &m_convertedSamples[0];
+            sampleSize = sizeof(Int16);
+        }
 
         // Fill the buffer
-        ALsizei size = static_cast<ALsizei>(data.sampleCount) * sizeof(Int16);
-        alCheck(alBufferData(buffer, m_format, data.samples, size, m_sampleRate));
+        ALsizei size = static_cast<ALsizei>(sampleCount) * sampleSize;
+        alCheck(alBufferData(buffer, m_format, samples, size, m_sampleRate));
 
         // Push it into the sound queue
         alCheck(alSourceQueueBuffers(m_source, 1, &buffer));
+
+        Lock lock(m_threadMutex);
+        m_queuedSamples += sampleCount;
     }
 
     return requestStop;
 }
 
 
+
 ////////////////////////////////////////////////////////////
 bool SoundStream::fillQueue()
 {
     // Fill and enqueue all the available buffers
     bool requestStop = false;
-    for (int i = 0; (i < BufferCount) && !requestStop; ++i)
+    for (unsigned int i = 0; (i < m_bufferCount) && !requestStop; ++i)
     {
         if (fillAndPushBuffer(i))
             requestStop = true;
@@ -468,6 +1084,9 @@ void SoundStream::clearQueue()
     ALuint buffer;
     for (ALint i = 0; i < nbQueued; ++i)
         alCheck(alSourceUnqueueBuffers(m_source, 1, &buffer));
+
+    Lock lock(m_threadMutex);
+    m_queuedSamples = 0;
 }
 
 } // namespace sf
@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/AnalyticLine.hpp>
+#include <cmath>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+AnalyticLine::AnalyticLine(const Vector2f& start, const Vector2f& end, float thickness) :
+m_start    (start),
+m_end      (end),
+m_thickness(thickness)
+{
+    updateGeometry();
+}
+
+
+////////////////////////////////////////////////////////////
+void AnalyticLine::setPoints(const Vector2f& start, const Vector2f& end)
+{
+    m_start = start;
+    m_end = end;
+    updateGeometry();
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& AnalyticLine::getStart() const
+{
+    return m_start;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& AnalyticLine::getEnd() const
+{
+    return m_end;
+}
+
+
+////////////////////////////////////////////////////////////
+void AnalyticLine::setThickness(float thickness)
+{
+    m_thickness = thickness;
+    updateGeometry();
+}
+
+
+////////////////////////////////////////////////////////////
+float AnalyticLine::getThickness() const
+{
+    return m_thickness;
+}
+
+
+////////////////////////////////////////////////////////////
+void AnalyticLine::updateGeometry()
+{
+    // The line is a fully round box along the X axis, whose caps are centered on the end points
+    Vector2f direction = m_end - m_start;
+    float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+    float angle = std::atan2(direction.y, direction.x) * 180.f / 3.141592654f;
+    float halfThickness = m_thickness / 2;
+
+    Transform transform;
+    transform.translate(m_start).rotate(angle).translate(-halfThickness, -halfThickness);
+
+    setGeometry(Vector2f(length + m_thickness, m_thickness), halfThickness, transform);
+}
+
+} // namespace sf
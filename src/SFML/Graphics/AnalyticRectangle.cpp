@@ -0,0 +1,71 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/AnalyticRectangle.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+AnalyticRectangle::AnalyticRectangle(const Vector2f& size, float cornerRadius) :
+m_size        (size),
+m_cornerRadius(cornerRadius)
+{
+    setGeometry(m_size, m_cornerRadius);
+}
+
+
+////////////////////////////////////////////////////////////
+void AnalyticRectangle::setSize(const Vector2f& size)
+{
+    m_size = size;
+    setGeometry(m_size, m_cornerRadius);
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& AnalyticRectangle::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+void AnalyticRectangle::setCornerRadius(float radius)
+{
+    m_cornerRadius = radius;
+    setGeometry(m_size, m_cornerRadius);
+}
+
+
+////////////////////////////////////////////////////////////
+float AnalyticRectangle::getCornerRadius() const
+{
+    return m_cornerRadius;
+}
+
+} // namespace sf
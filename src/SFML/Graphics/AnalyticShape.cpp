@@ -0,0 +1,284 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/AnalyticShape.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    sf::Mutex mutex;
+
+    // Distance between the rounded boxes and the edges of their quads, which leaves room
+    // for the antialiasing of the edges (must match the vertex shader below)
+    const float margin = 2.f;
+
+    // Fully round boxes have their own radius code, since their radius depends on their size
+    const unsigned int fullyRound = 1023;
+
+    // The texture coordinates of each corner are its position relative to the center of
+    // the box, so that their absolute value gives the half size of the quad, and the layer
+    // encodes the shape of the box: a positive layer is the corner radius of a filled box,
+    // a negative one is a ring whose outer corner radius and thickness, in quarters of unit,
+    // are packed as radius * 2048 + thickness. The packed values stay below 2^21, so that the
+    // interpolation of the (constant) layer can't shift them by half a unit.
+    const char* vertexSource =
+        "varying vec2 position;\n"
+        "varying vec3 box;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;\n"
+        "    gl_FrontColor = gl_Color;\n"
+        "    position = gl_MultiTexCoord0.xy;\n"
+        "    box = vec3(abs(gl_MultiTexCoord0.xy) - 2.0, gl_MultiTexCoord0.z);\n"
+        "}\n";
+
+    // Fragment shader that computes the signed distance to the edge of a rounded box
+    // and turns it into an antialiased edge, at any scale
+    const char* fragmentSource =
+        "varying vec2 position;\n"
+        "varying vec3 box;\n"
+        "void main()\n"
+        "{\n"
+        "    vec2 halfSize = box.xy;\n"
+        "    float radius = box.z;\n"
+        "    float thickness = 0.0;\n"
+        "    if (box.z < 0.0)\n"
+        "    {\n"
+        "        float code = -box.z;\n"
+        "        float radiusCode = floor((code + 0.5) / 2048.0);\n"
+        "        thickness = floor(code - radiusCode * 2048.0 + 0.5) * 0.25;\n"
+        "        radius = (radiusCode > 1022.5) ? halfSize.x + halfSize.y : radiusCode * 0.25;\n"
+        "    }\n"
+        "    radius = min(radius, min(halfSize.x, halfSize.y));\n"
+        "    vec2 q = abs(position) - halfSize + radius;\n"
+        "    float distance = length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - radius;\n"
+        "    if (thickness > 0.0)\n"
+        "        distance = abs(distance + thickness * 0.5) - thickness * 0.5;\n"
+        "    float width = max(fwidth(distance), 0.0001);\n"
+        "    float alpha = clamp(0.5 - distance / width, 0.0, 1.0);\n"
+        "    gl_FragColor = vec4(gl_Color.rgb, gl_Color.a * alpha);\n"
+        "}\n";
+
+    // Get the shader shared by all the analytic shapes, creating it on first use.
+    // It is intentionally never destroyed, the same way the shared context
+    // is kept alive until the end of the program.
+    const sf::Shader* getAnalyticShader()
+    {
+        // TODO: Remove this lock when it becomes unnecessary in C++11
+        sf::Lock lock(mutex);
+
+        static sf::Shader* shader = NULL;
+        static bool initialized = false;
+
+        if (!initialized)
+        {
+            initialized = true;
+
+            if (sf::Shader::isAvailable())
+            {
+                sf::Shader* program = new sf::Shader;
+                if (program->loadFromMemory(vertexSource, fragmentSource))
+                    shader = program;
+                else
+                    delete program;
+            }
+        }
+
+        return shader;
+    }
+
+    // Two triangles per quad, for the fill and the outline
+    const sf::Uint16 quadIndices[] = {0, 1, 2, 2, 1, 3, 4, 5, 6, 6, 5, 7};
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+AnalyticShape::~AnalyticShape()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void AnalyticShape::setFillColor(const Color& color)
+{
+    m_fillColor = color;
+    update();
+}
+
+
+////////////////////////////////////////////////////////////
+void AnalyticShape::setOutlineColor(const Color& color)
+{
+    m_outlineColor = color;
+    update();
+}
+
+
+////////////////////////////////////////////////////////////
+void AnalyticShape::setOutlineThickness(float thickness)
+{
+    // The thickness is stored in quarters of unit in the vertices
+    m_outlineThickness = std::floor(std::min(std::max(thickness, 0.f), 511.75f) * 4.f + 0.5f) / 4.f;
+    update();
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& AnalyticShape::getFillColor() const
+{
+    return m_fillColor;
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& AnalyticShape::getOutlineColor() const
+{
+    return m_outlineColor;
+}
+
+
+////////////////////////////////////////////////////////////
+float AnalyticShape::getOutlineThickness() const
+{
+    return m_outlineThickness;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect AnalyticShape::getLocalBounds() const
+{
+    return m_bounds;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect AnalyticShape::getGlobalBounds() const
+{
+    return getTransform().transformRect(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+bool AnalyticShape::isAvailable()
+{
+    return getAnalyticShader() != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+AnalyticShape::AnalyticShape() :
+m_size            (0, 0),
+m_cornerRadius    (0),
+m_boxTransform    (),
+m_fillColor       (255, 255, 255),
+m_outlineColor    (255, 255, 255),
+m_outlineThickness(0),
+m_bounds          ()
+{
+    update();
+}
+
+
+////////////////////////////////////////////////////////////
+void AnalyticShape::setGeometry(const Vector2f& size, float cornerRadius, const Transform& boxTransform)
+{
+    m_size = Vector2f(std::max(size.x, 0.f), std::max(size.y, 0.f));
+    m_cornerRadius = std::max(cornerRadius, 0.f);
+    m_boxTransform = boxTransform;
+    update();
+}
+
+
+////////////////////////////////////////////////////////////
+void AnalyticShape::draw(RenderTarget& target, RenderStates states) const
+{
+    // A custom shader replaces the built-in one, the shapes can't be drawn without any
+    if (!states.shader)
+    {
+        states.shader = getAnalyticShader();
+        if (!states.shader)
+            return;
+    }
+
+    states.transform *= getTransform();
+    states.texture = NULL;
+
+    std::size_t quadCount = (m_outlineThickness > 0) ? 2 : 1;
+    target.draw(m_vertices, quadCount * 4, quadIndices, quadCount * 6, Triangles, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void AnalyticShape::update()
+{
+    Vector2f halfSize = m_size / 2.f;
+    float smallest = std::min(halfSize.x, halfSize.y);
+    float radius = std::min(m_cornerRadius, smallest);
+
+    writeQuad(m_vertices, halfSize, radius, m_fillColor);
+
+    // The outline is a ring around the box, drawn by a second quad since a vertex has a single color
+    float thickness = m_outlineThickness;
+    if (thickness > 0)
+    {
+        unsigned int radiusCode = fullyRound;
+        if (m_cornerRadius < smallest)
+            radiusCode = std::min(static_cast<unsigned int>((radius + thickness) * 4.f + 0.5f), fullyRound - 1);
+
+        unsigned int thicknessCode = static_cast<unsigned int>(thickness * 4.f + 0.5f);
+        float shape = -static_cast<float>(radiusCode * 2048 + thicknessCode);
+
+        writeQuad(m_vertices + 4, halfSize + Vector2f(thickness, thickness), shape, m_outlineColor);
+    }
+
+    m_bounds = m_boxTransform.transformRect(FloatRect(-thickness, -thickness, m_size.x + thickness * 2, m_size.y + thickness * 2));
+}
+
+
+////////////////////////////////////////////////////////////
+void AnalyticShape::writeQuad(LayeredVertex* vertices, const Vector2f& halfSize, float shape, const Color& color) const
+{
+    Vector2f center = m_size / 2.f;
+    Vector2f extent = halfSize + Vector2f(margin, margin);
+
+    // Top-left, bottom-left, top-right, bottom-right
+    for (int i = 0; i < 4; ++i)
+    {
+        Vector2f corner(i < 2 ? -extent.x : extent.x, i % 2 ? extent.y : -extent.y);
+        vertices[i] = LayeredVertex(m_boxTransform.transformPoint(center + corner), color, corner, shape);
+    }
+}
+
+} // namespace sf
@@ -0,0 +1,204 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/CaptureQueue.hpp>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+CaptureQueue::CaptureQueue(TaskScheduler& scheduler) :
+m_scheduler      (scheduler),
+m_nextReadback   (0),
+m_saves          (),
+m_freeSaves      (),
+m_maxPendingSaves(8),
+m_savedCount     (0),
+m_failedCount    (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+CaptureQueue::~CaptureQueue()
+{
+    finish();
+
+    for (std::vector<Save*>::iterator it = m_freeSaves.begin(); it != m_freeSaves.end(); ++it)
+        delete *it;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CaptureQueue::capture(RenderTexture& renderTexture, const std::string& filename)
+{
+    PixelReadback& readback = prepareCapture();
+    if (!readback.start(renderTexture))
+    {
+        ++m_failedCount;
+        return false;
+    }
+
+    m_filenames[m_nextReadback] = filename;
+    m_nextReadback = (m_nextReadback + 1) % ReadbackCount;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CaptureQueue::capture(RenderWindow& window, const std::string& filename)
+{
+    PixelReadback& readback = prepareCapture();
+    if (!readback.start(window))
+    {
+        ++m_failedCount;
+        return false;
+    }
+
+    m_filenames[m_nextReadback] = filename;
+    m_nextReadback = (m_nextReadback + 1) % ReadbackCount;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void CaptureQueue::finish()
+{
+    // Retrieve the captures still in flight, oldest first
+    for (std::size_t i = 0; i < ReadbackCount; ++i)
+    {
+        std::size_t index = (m_nextReadback + i) % ReadbackCount;
+        if (m_readbacks[index].isPending())
+            retrieve(index);
+    }
+    m_nextReadback = 0;
+
+    collect(m_saves.size());
+}
+
+
+////////////////////////////////////////////////////////////
+void CaptureQueue::setMaxPendingSaves(std::size_t count)
+{
+    m_maxPendingSaves = std::max<std::size_t>(count, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 CaptureQueue::getSavedCount() const
+{
+    return m_savedCount;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 CaptureQueue::getFailedCount() const
+{
+    return m_failedCount;
+}
+
+
+////////////////////////////////////////////////////////////
+PixelReadback& CaptureQueue::prepareCapture()
+{
+    // Recycle the images saved since the last capture
+    collect(0);
+
+    // The next readback is the oldest one: if it is still pending, the
+    // graphics card is done with it unless it is several captures late
+    if (m_readbacks[m_nextReadback].isPending())
+        retrieve(m_nextReadback);
+
+    return m_readbacks[m_nextReadback];
+}
+
+
+////////////////////////////////////////////////////////////
+void CaptureQueue::retrieve(std::size_t index)
+{
+    // Wait for the oldest saves rather than letting the memory grow when the workers can't keep up
+    if (m_saves.size() >= m_maxPendingSaves)
+        collect(m_saves.size() - m_maxPendingSaves + 1);
+
+    Save* save = NULL;
+    if (!m_freeSaves.empty())
+    {
+        save = m_freeSaves.back();
+        m_freeSaves.pop_back();
+    }
+    else
+    {
+        save = new Save;
+    }
+
+    if (!m_readbacks[index].getImage(save->image))
+    {
+        ++m_failedCount;
+        m_freeSaves.push_back(save);
+        return;
+    }
+
+    save->filename.swap(m_filenames[index]);
+    save->success = false;
+    save->task = m_scheduler.add(&CaptureQueue::write, save);
+    m_saves.push_back(save);
+}
+
+
+////////////////////////////////////////////////////////////
+void CaptureQueue::collect(std::size_t count)
+{
+    for (std::size_t i = 0; !m_saves.empty(); ++i)
+    {
+        // Wait for the requested saves, then take the ones that are already finished
+        Save* save = m_saves.front();
+        if (i < count)
+            m_scheduler.wait(save->task);
+        else if (!m_scheduler.isFinished(save->task))
+            break;
+
+        if (save->success)
+            ++m_savedCount;
+        else
+            ++m_failedCount;
+
+        m_saves.pop_front();
+        m_freeSaves.push_back(save);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void CaptureQueue::write(Save* save)
+{
+    save->success = save->image.saveToFile(save->filename);
+}
+
+} // namespace sf
@@ -26,7 +26,21 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/CircleShape.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
 #include <cmath>
+#include <map>
+#include <typeinfo>
+
+
+namespace
+{
+    // Protects the geometry cache of the circles
+    sf::Mutex mutex;
+
+    // Maximum number of geometries kept by the cache
+    const std::size_t maxCachedGeometries = 64;
+}
 
 
 namespace sf
@@ -36,7 +50,7 @@ CircleShape::CircleShape(float radius, std::size_t pointCount) :
 m_radius    (radius),
 m_pointCount(pointCount)
 {
-    update();
+    updateCircle();
 }
 
 
@@ -44,7 +58,7 @@ m_pointCount(pointCount)
 void CircleShape::setRadius(float radius)
 {
     m_radius = radius;
-    update();
+    updateCircle();
 }
 
 
@@ -59,7 +73,7 @@ float CircleShape::getRadius() const
 void CircleShape::setPointCount(std::size_t count)
 {
     m_pointCount = count;
-    update();
+    updateCircle();
 }
 
 ////////////////////////////////////////////////////////////
@@ -81,4 +95,38 @@ Vector2f CircleShape::getPoint(std::size_t index) const
     return Vector2f(m_radius + x, m_radius + y);
 }
 
+
+////////////////////////////////////////////////////////////
+void CircleShape::updateCircle()
+{
+    // Derived classes may define other points
+    if (typeid(*this) != typeid(CircleShape))
+    {
+        update();
+        return;
+    }
+
+    typedef std::map<std::pair<float, std::size_t>, Geometry> GeometryCache;
+
+    Lock lock(mutex);
+
+    static GeometryCache cache;
+
+    // Reuse the geometry of identical circles
+    std::pair<float, std::size_t> key(m_radius, m_pointCount);
+    GeometryCache::const_iterator it = cache.find(key);
+    if (it != cache.end())
+    {
+        update(it->second);
+        return;
+    }
+
+    // Compute the geometry and keep it for the next circles
+    update();
+
+    if (cache.size() >= maxCachedGeometries)
+        cache.clear();
+    getGeometry(cache[key]);
+}
+
 } // namespace sf
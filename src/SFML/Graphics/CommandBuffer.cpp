@@ -0,0 +1,217 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/CommandBuffer.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/TransformPoints.hpp>
+#include <SFML/System/TaskScheduler.hpp>
+
+
+namespace
+{
+    // Records one range of drawables into one command buffer
+    struct RecordTask
+    {
+        void operator ()(std::size_t index) const
+        {
+            sf::CommandBuffer& buffer = *buffers[index];
+            std::size_t begin = drawableCount * index / bufferCount;
+            std::size_t end = drawableCount * (index + 1) / bufferCount;
+
+            buffer.reset();
+            for (std::size_t i = begin; i < end; ++i)
+                buffer.draw(*drawables[i], *states);
+        }
+
+        sf::CommandBuffer* const*  buffers;
+        std::size_t                bufferCount;
+        const sf::Drawable* const* drawables;
+        std::size_t                drawableCount;
+        const sf::RenderStates*    states;
+    };
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+CommandBuffer::CommandBuffer(const Vector2u& size) :
+m_size           (size),
+m_commands       (),
+m_vertices       (),
+m_layeredVertices()
+{
+    m_cache.recording = true;
+
+    // Setup the default view
+    RenderTarget::initialize();
+}
+
+
+////////////////////////////////////////////////////////////
+void CommandBuffer::reset()
+{
+    m_commands.clear();
+    m_vertices.clear();
+    m_layeredVertices.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void CommandBuffer::submit(RenderTarget& target, const RenderStates& states) const
+{
+    for (std::vector<Command>::const_iterator it = m_commands.begin(); it != m_commands.end(); ++it)
+    {
+        RenderStates commandStates = it->states;
+        commandStates.transform = states.transform * commandStates.transform;
+
+        if (it->vertexBuffer)
+            target.draw(*it->vertexBuffer, it->firstVertex, it->vertexCount, commandStates);
+        else if (it->layered)
+            target.draw(&m_layeredVertices[it->firstVertex], it->vertexCount, it->type, commandStates);
+        else
+            target.draw(&m_vertices[it->firstVertex], it->vertexCount, it->type, commandStates);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t CommandBuffer::getCommandCount() const
+{
+    return m_commands.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t CommandBuffer::getVertexCount() const
+{
+    return m_vertices.size() + m_layeredVertices.size();
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u CommandBuffer::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+void CommandBuffer::recordParallel(TaskScheduler& scheduler, CommandBuffer* const* buffers, std::size_t bufferCount,
+                                   const Drawable* const* drawables, std::size_t drawableCount,
+                                   const RenderStates& states)
+{
+    if (bufferCount == 0)
+        return;
+
+    // One task per buffer: the ranges are contiguous so that the submission order matches the drawables order
+    RecordTask task = {buffers, bufferCount, drawables, drawableCount, &states};
+    scheduler.parallelFor(0, bufferCount, task, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+bool CommandBuffer::activate(bool active)
+{
+    // There's no context to activate, which prevents any OpenGL call
+    (void)active;
+
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void CommandBuffer::record(const Vertex* vertices, std::size_t vertexCount,
+                           PrimitiveType type, const RenderStates& states)
+{
+    PrimitiveType listType = priv::getListPrimitiveType(type);
+
+    // Start a new command if the primitives can't be appended to the last one
+    if (m_commands.empty() ||
+        m_commands.back().vertexBuffer ||
+        m_commands.back().layered ||
+        (m_commands.back().type != listType) ||
+        (m_commands.back().states.texture != states.texture) ||
+        (m_commands.back().states.shader != states.shader) ||
+        (m_commands.back().states.depth != states.depth) ||
+        (m_commands.back().states.blendMode != states.blendMode) ||
+        (m_commands.back().states.scissor != states.scissor) ||
+        (m_commands.back().states.stencilMode != states.stencilMode) ||
+        (m_commands.back().states.samplerMode != states.samplerMode))
+    {
+        // The vertices are stored pre-transformed, every other state is kept as is
+        Command command;
+        command.states           = states;
+        command.states.transform = Transform::Identity;
+        command.vertexBuffer     = NULL;
+        command.layered          = false;
+        command.firstVertex      = m_vertices.size();
+        command.vertexCount      = 0;
+        command.type             = listType;
+        m_commands.push_back(command);
+    }
+
+    // Pre-transform the vertices now, so that this work is done by the recording thread
+    std::size_t size = m_vertices.size();
+    priv::appendPrimitives(m_vertices, states.transform, vertices, vertexCount, type);
+    m_commands.back().vertexCount += m_vertices.size() - size;
+}
+
+
+////////////////////////////////////////////////////////////
+void CommandBuffer::record(const VertexBuffer& vertexBuffer, std::size_t firstVertex,
+                           std::size_t vertexCount, const RenderStates& states)
+{
+    Command command;
+    command.states       = states;
+    command.vertexBuffer = &vertexBuffer;
+    command.layered      = false;
+    command.firstVertex  = firstVertex;
+    command.vertexCount  = vertexCount;
+    command.type         = vertexBuffer.getPrimitiveType();
+    m_commands.push_back(command);
+}
+
+
+////////////////////////////////////////////////////////////
+void CommandBuffer::record(const LayeredVertex* vertices, std::size_t vertexCount,
+                           PrimitiveType type, const RenderStates& states)
+{
+    // Layered vertices are not batched when they are drawn, they keep their transform and a command of their own
+    Command command;
+    command.states       = states;
+    command.vertexBuffer = NULL;
+    command.layered      = true;
+    command.firstVertex  = m_layeredVertices.size();
+    command.vertexCount  = vertexCount;
+    command.type         = type;
+    m_commands.push_back(command);
+
+    m_layeredVertices.insert(m_layeredVertices.end(), vertices, vertices + vertexCount);
+}
+
+} // namespace sf
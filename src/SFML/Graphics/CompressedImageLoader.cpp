@@ -0,0 +1,428 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/CompressedImageLoader.hpp>
+#include <SFML/System/MappedFileInputStream.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+
+
+namespace
+{
+    // Internal formats that can be loaded; the values are the OpenGL enums,
+    // which are also what KTX files store
+    const unsigned int formatDxt1      = 0x83F1; // GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+    const unsigned int formatDxt3      = 0x83F2; // GL_COMPRESSED_RGBA_S3TC_DXT3_EXT
+    const unsigned int formatDxt5      = 0x83F3; // GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+    const unsigned int formatEacFirst  = 0x9270; // GL_COMPRESSED_R11_EAC
+    const unsigned int formatEtc2Last  = 0x9279; // GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC
+    const unsigned int formatAstcFirst = 0x93B0; // GL_COMPRESSED_RGBA_ASTC_4x4_KHR
+    const unsigned int formatAstcLast  = 0x93BD; // GL_COMPRESSED_RGBA_ASTC_12x12_KHR
+    const unsigned int formatAstcSrgb  = 0x93D0; // GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR
+
+    // Get the size of the blocks of a compressed format
+    bool getBlockInfo(unsigned int format, unsigned int& blockWidth, unsigned int& blockHeight, unsigned int& blockBytes)
+    {
+        // S3TC
+        if ((format >= 0x83F0) && (format <= formatDxt5))
+        {
+            blockWidth = 4;
+            blockHeight = 4;
+            blockBytes = (format <= formatDxt1) ? 8 : 16;
+            return true;
+        }
+
+        // ETC2 / EAC: the single channel and RGB (+1 bit alpha) variants use 8 bytes per block
+        if ((format >= formatEacFirst) && (format <= formatEtc2Last))
+        {
+            static const unsigned int bytes[] = {8, 8, 16, 16, 8, 8, 8, 8, 16, 16};
+            blockWidth = 4;
+            blockHeight = 4;
+            blockBytes = bytes[format - formatEacFirst];
+            return true;
+        }
+
+        // ASTC LDR, linear and sRGB
+        unsigned int astc = format;
+        if ((astc >= formatAstcSrgb) && (astc <= formatAstcSrgb + (formatAstcLast - formatAstcFirst)))
+            astc = astc - formatAstcSrgb + formatAstcFirst;
+        if ((astc >= formatAstcFirst) && (astc <= formatAstcLast))
+        {
+            static const unsigned int widths[]  = {4, 5, 5, 6, 6, 8, 8, 8, 10, 10, 10, 10, 12, 12};
+            static const unsigned int heights[] = {4, 4, 5, 5, 6, 5, 6, 8, 5,  6,  8,  10, 10, 12};
+            blockWidth = widths[astc - formatAstcFirst];
+            blockHeight = heights[astc - formatAstcFirst];
+            blockBytes = 16;
+            return true;
+        }
+
+        return false;
+    }
+
+    // Read a 32-bits unsigned integer stored in the given byte order
+    sf::Uint32 readUint32(const sf::Uint8* data, bool bigEndian = false)
+    {
+        if (bigEndian)
+            return (data[0] << 24) | (data[1] << 16) | (data[2] << 8) | data[3];
+        else
+            return data[0] | (data[1] << 8) | (data[2] << 16) | (data[3] << 24);
+    }
+
+    // Read the contents of a file into an array of bytes
+    bool getFileContents(const std::string& filename, std::vector<sf::Uint8>& buffer)
+    {
+        std::ifstream file(filename.c_str(), std::ios_base::binary);
+        if (!file)
+            return false;
+
+        file.seekg(0, std::ios_base::end);
+        std::streamsize size = file.tellg();
+        if (size > 0)
+        {
+            file.seekg(0, std::ios_base::beg);
+            buffer.resize(static_cast<std::size_t>(size));
+            file.read(reinterpret_cast<char*>(&buffer[0]), size);
+        }
+
+        return true;
+    }
+
+    // Read the contents of a stream into an array of bytes
+    bool getStreamContents(sf::InputStream& stream, std::vector<sf::Uint8>& buffer)
+    {
+        bool success = true;
+        sf::Int64 size = stream.getSize();
+        if (size > 0)
+        {
+            buffer.resize(static_cast<std::size_t>(size));
+            stream.seek(0);
+            sf::Int64 read = stream.read(&buffer[0], size);
+            success = (read == size);
+        }
+        return success;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+CompressedImageLoader& CompressedImageLoader::getInstance()
+{
+    static CompressedImageLoader Instance;
+
+    return Instance;
+}
+
+
+////////////////////////////////////////////////////////////
+CompressedImageLoader::CompressedImageLoader()
+{
+    // Nothing to do
+}
+
+
+////////////////////////////////////////////////////////////
+CompressedImageLoader::~CompressedImageLoader()
+{
+    // Nothing to do
+}
+
+
+////////////////////////////////////////////////////////////
+bool CompressedImageLoader::loadFromFile(const std::string& filename, CompressedImage& image)
+{
+    // Parse the mapped file directly, without copying it
+    MappedFileInputStream mapping;
+    if (mapping.open(filename))
+    {
+        if (!loadFromMemory(mapping.getData(), static_cast<std::size_t>(mapping.getSize()), image))
+        {
+            err() << "Failed to load compressed image \"" << filename << "\"" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    std::vector<Uint8> buffer;
+    if (!getFileContents(filename, buffer))
+    {
+        err() << "Failed to load compressed image \"" << filename << "\". Reason: Unable to open file" << std::endl;
+        return false;
+    }
+
+    if (buffer.empty() || !loadFromMemory(&buffer[0], buffer.size(), image))
+    {
+        err() << "Failed to load compressed image \"" << filename << "\"" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CompressedImageLoader::loadFromMemory(const void* data, std::size_t dataSize, CompressedImage& image)
+{
+    // Check input parameters
+    if (!data || !dataSize)
+    {
+        err() << "Failed to load compressed image from memory, no data provided" << std::endl;
+        return false;
+    }
+
+    image.levels.clear();
+
+    static const Uint8 ddsMagic[] = {'D', 'D', 'S', ' '};
+    static const Uint8 ktxMagic[] = {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+    if ((dataSize >= sizeof(ddsMagic)) && (std::memcmp(bytes, ddsMagic, sizeof(ddsMagic)) == 0))
+        return parseDds(bytes, dataSize, image);
+
+    if ((dataSize >= sizeof(ktxMagic)) && (std::memcmp(bytes, ktxMagic, sizeof(ktxMagic)) == 0))
+        return parseKtx(bytes, dataSize, image);
+
+    err() << "Failed to load compressed image from memory. Reason: Unknown container format (DDS and KTX are supported)" << std::endl;
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CompressedImageLoader::loadFromStream(InputStream& stream, CompressedImage& image)
+{
+    // Mapped files are parsed in place
+    MappedFileInputStream* mapping = dynamic_cast<MappedFileInputStream*>(&stream);
+    if (mapping && mapping->getData())
+        return loadFromMemory(mapping->getData(), static_cast<std::size_t>(mapping->getSize()), image);
+
+    std::vector<Uint8> buffer;
+    if (!getStreamContents(stream, buffer) || buffer.empty())
+    {
+        err() << "Failed to load compressed image from stream. Reason: Unable to read the stream" << std::endl;
+        return false;
+    }
+
+    return loadFromMemory(&buffer[0], buffer.size(), image);
+}
+
+
+////////////////////////////////////////////////////////////
+bool CompressedImageLoader::parseDds(const Uint8* data, std::size_t dataSize, CompressedImage& image)
+{
+    // Magic number + DDS_HEADER
+    const std::size_t headerSize = 4 + 124;
+    if ((dataSize < headerSize) || (readUint32(data + 4) != 124))
+    {
+        err() << "Failed to load DDS image. Reason: Invalid header" << std::endl;
+        return false;
+    }
+
+    Uint32 flags       = readUint32(data + 8);
+    Uint32 height      = readUint32(data + 12);
+    Uint32 width       = readUint32(data + 16);
+    Uint32 mipmapCount = readUint32(data + 28);
+    Uint32 pixelFlags  = readUint32(data + 80);
+    const Uint8* fourCC = data + 84;
+
+    const Uint32 ddsdMipmapCount = 0x20000;
+    const Uint32 ddpfFourCC = 0x4;
+
+    if (!(pixelFlags & ddpfFourCC))
+    {
+        err() << "Failed to load DDS image. Reason: Uncompressed pixel formats are not supported" << std::endl;
+        return false;
+    }
+
+    // Find the compression format
+    std::size_t offset = headerSize;
+    unsigned int format = 0;
+    if (std::memcmp(fourCC, "DXT1", 4) == 0)
+    {
+        format = formatDxt1;
+    }
+    else if (std::memcmp(fourCC, "DXT3", 4) == 0)
+    {
+        format = formatDxt3;
+    }
+    else if (std::memcmp(fourCC, "DXT5", 4) == 0)
+    {
+        format = formatDxt5;
+    }
+    else if (std::memcmp(fourCC, "DX10", 4) == 0)
+    {
+        // Extended header, starting with the DXGI format
+        offset += 20;
+        if (dataSize < offset)
+        {
+            err() << "Failed to load DDS image. Reason: Invalid header" << std::endl;
+            return false;
+        }
+
+        switch (readUint32(data + headerSize))
+        {
+            case 71: case 72: format = formatDxt1; break; // DXGI_FORMAT_BC1_UNORM(_SRGB)
+            case 74: case 75: format = formatDxt3; break; // DXGI_FORMAT_BC2_UNORM(_SRGB)
+            case 77: case 78: format = formatDxt5; break; // DXGI_FORMAT_BC3_UNORM(_SRGB)
+            default: break;
+        }
+    }
+
+    if (!format)
+    {
+        err() << "Failed to load DDS image. Reason: Unsupported compression format" << std::endl;
+        return false;
+    }
+
+    if ((width == 0) || (height == 0))
+    {
+        err() << "Failed to load DDS image. Reason: Invalid size (" << width << "x" << height << ")" << std::endl;
+        return false;
+    }
+
+    unsigned int blockWidth, blockHeight, blockBytes;
+    getBlockInfo(format, blockWidth, blockHeight, blockBytes);
+
+    // Read the levels
+    unsigned int levelCount = (flags & ddsdMipmapCount) ? std::max(mipmapCount, 1u) : 1u;
+    unsigned int levelWidth = width;
+    unsigned int levelHeight = height;
+    for (unsigned int i = 0; i < levelCount; ++i)
+    {
+        std::size_t levelSize = ((levelWidth + blockWidth - 1) / blockWidth) *
+                                ((levelHeight + blockHeight - 1) / blockHeight) * blockBytes;
+
+        if (offset + levelSize > dataSize)
+        {
+            // Keep the levels that were complete, if any
+            if (i == 0)
+            {
+                err() << "Failed to load DDS image. Reason: Truncated data" << std::endl;
+                return false;
+            }
+            break;
+        }
+
+        image.levels.push_back(std::vector<Uint8>(data + offset, data + offset + levelSize));
+        offset += levelSize;
+
+        levelWidth = std::max(levelWidth / 2, 1u);
+        levelHeight = std::max(levelHeight / 2, 1u);
+    }
+
+    image.format = format;
+    image.size = Vector2u(width, height);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CompressedImageLoader::parseKtx(const Uint8* data, std::size_t dataSize, CompressedImage& image)
+{
+    // Identifier + 13 fields of 32 bits
+    const std::size_t headerSize = 12 + 13 * 4;
+    if (dataSize < headerSize)
+    {
+        err() << "Failed to load KTX image. Reason: Invalid header" << std::endl;
+        return false;
+    }
+
+    // The endianness field tells the byte order of the file
+    bool bigEndian = false;
+    Uint32 endianness = readUint32(data + 12);
+    if (endianness == 0x01020304)
+    {
+        bigEndian = true;
+    }
+    else if (endianness != 0x04030201)
+    {
+        err() << "Failed to load KTX image. Reason: Invalid header" << std::endl;
+        return false;
+    }
+
+    Uint32 type           = readUint32(data + 16, bigEndian);
+    Uint32 internalFormat = readUint32(data + 28, bigEndian);
+    Uint32 width          = readUint32(data + 36, bigEndian);
+    Uint32 height         = readUint32(data + 40, bigEndian);
+    Uint32 depth          = readUint32(data + 44, bigEndian);
+    Uint32 arrayElements  = readUint32(data + 48, bigEndian);
+    Uint32 faces          = readUint32(data + 52, bigEndian);
+    Uint32 mipmapCount    = readUint32(data + 56, bigEndian);
+    Uint32 keyValueBytes  = readUint32(data + 60, bigEndian);
+
+    unsigned int blockWidth, blockHeight, blockBytes;
+    if ((type != 0) || !getBlockInfo(internalFormat, blockWidth, blockHeight, blockBytes))
+    {
+        err() << "Failed to load KTX image. Reason: Unsupported compression format" << std::endl;
+        return false;
+    }
+
+    if ((width == 0) || (height == 0) || (depth > 1) || (arrayElements > 0) || (faces != 1))
+    {
+        err() << "Failed to load KTX image. Reason: Only 2D textures are supported" << std::endl;
+        return false;
+    }
+
+    // Read the levels, each one is preceded by its size and padded to 4 bytes
+    std::size_t offset = headerSize + keyValueBytes;
+    unsigned int levelCount = std::max(mipmapCount, 1u);
+    for (unsigned int i = 0; i < levelCount; ++i)
+    {
+        if (offset + 4 > dataSize)
+            break;
+
+        std::size_t levelSize = readUint32(data + offset, bigEndian);
+        offset += 4;
+
+        if (offset + levelSize > dataSize)
+            break;
+
+        image.levels.push_back(std::vector<Uint8>(data + offset, data + offset + levelSize));
+        offset += (levelSize + 3) & ~static_cast<std::size_t>(3);
+    }
+
+    if (image.levels.empty())
+    {
+        err() << "Failed to load KTX image. Reason: Truncated data" << std::endl;
+        return false;
+    }
+
+    image.format = internalFormat;
+    image.size = Vector2u(width, height);
+
+    return true;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_COMPRESSEDIMAGELOADER_HPP
+#define SFML_COMPRESSEDIMAGELOADER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class InputStream;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Pre-compressed image data, ready to be uploaded
+///
+////////////////////////////////////////////////////////////
+struct CompressedImage
+{
+    unsigned int                     format; ///< OpenGL internal format of the data
+    Vector2u                         size;   ///< Size of the first level, in pixels
+    std::vector<std::vector<Uint8> > levels; ///< Compressed data of each mipmap level, largest first
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Load DDS and KTX containers of compressed textures
+///
+////////////////////////////////////////////////////////////
+class CompressedImageLoader : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the unique instance of the class
+    ///
+    /// \return Reference to the CompressedImageLoader instance
+    ///
+    ////////////////////////////////////////////////////////////
+    static CompressedImageLoader& getInstance();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load compressed image data from a file on disk
+    ///
+    /// \param filename Path of image file to load
+    /// \param image    Compressed image to fill with the loaded data
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromFile(const std::string& filename, CompressedImage& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load compressed image data from a file in memory
+    ///
+    /// \param data     Pointer to the file data in memory
+    /// \param dataSize Size of the data to load, in bytes
+    /// \param image    Compressed image to fill with the loaded data
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromMemory(const void* data, std::size_t dataSize, CompressedImage& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load compressed image data from a custom stream
+    ///
+    /// \param stream Source stream to read from
+    /// \param image  Compressed image to fill with the loaded data
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromStream(InputStream& stream, CompressedImage& image);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    CompressedImageLoader();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~CompressedImageLoader();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Parse a DDS container
+    ///
+    /// \param data     Pointer to the file data
+    /// \param dataSize Size of the data, in bytes
+    /// \param image    Compressed image to fill
+    ///
+    /// \return True if parsing was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool parseDds(const Uint8* data, std::size_t dataSize, CompressedImage& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Parse a KTX (version 1) container
+    ///
+    /// \param data     Pointer to the file data
+    /// \param dataSize Size of the data, in bytes
+    /// \param image    Compressed image to fill
+    ///
+    /// \return True if parsing was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool parseKtx(const Uint8* data, std::size_t dataSize, CompressedImage& image);
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_COMPRESSEDIMAGELOADER_HPP
@@ -56,7 +56,7 @@ std::size_t ConvexShape::getPointCount() const
 void ConvexShape::setPoint(std::size_t index, const Vector2f& point)
 {
     m_points[index] = point;
-    update();
+    updatePoint(index);
 }
 
 
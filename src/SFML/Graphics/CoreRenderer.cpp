@@ -0,0 +1,896 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/CoreRenderer.hpp>
+#include <SFML/Graphics/CompactVertex.hpp>
+#include <SFML/Graphics/LayeredVertex.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/TransformPoints.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <cstring>
+#include <vector>
+
+
+#ifndef SFML_OPENGL_ES
+
+#if !defined(GL_VERTEX_SHADER)
+    #define GL_VERTEX_SHADER 0x8B31
+#endif
+
+#if !defined(GL_FRAGMENT_SHADER)
+    #define GL_FRAGMENT_SHADER 0x8B30
+#endif
+
+#if !defined(GL_COMPILE_STATUS)
+    #define GL_COMPILE_STATUS 0x8B81
+#endif
+
+#if !defined(GL_LINK_STATUS)
+    #define GL_LINK_STATUS 0x8B82
+#endif
+
+#if !defined(GL_INFO_LOG_LENGTH)
+    #define GL_INFO_LOG_LENGTH 0x8B84
+#endif
+
+#if !defined(GL_ARRAY_BUFFER)
+    #define GL_ARRAY_BUFFER 0x8892
+#endif
+
+#if !defined(GL_ELEMENT_ARRAY_BUFFER)
+    #define GL_ELEMENT_ARRAY_BUFFER 0x8893
+#endif
+
+#if !defined(GL_STATIC_DRAW)
+    #define GL_STATIC_DRAW 0x88E4
+#endif
+
+#if !defined(GL_STREAM_DRAW)
+    #define GL_STREAM_DRAW 0x88E0
+#endif
+
+#if !defined(GL_MAP_WRITE_BIT)
+    #define GL_MAP_WRITE_BIT 0x0002
+#endif
+
+#if !defined(GL_MAP_INVALIDATE_RANGE_BIT)
+    #define GL_MAP_INVALIDATE_RANGE_BIT 0x0004
+#endif
+
+#if !defined(GL_MAP_UNSYNCHRONIZED_BIT)
+    #define GL_MAP_UNSYNCHRONIZED_BIT 0x0020
+#endif
+
+#if !defined(GL_MAP_PERSISTENT_BIT)
+    #define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+
+#if !defined(GL_MAP_COHERENT_BIT)
+    #define GL_MAP_COHERENT_BIT 0x0080
+#endif
+
+#if !defined(GL_SYNC_GPU_COMMANDS_COMPLETE)
+    #define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#endif
+
+#if !defined(GL_SYNC_FLUSH_COMMANDS_BIT)
+    #define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#endif
+
+#if !defined(GL_TIMEOUT_EXPIRED)
+    #define GL_TIMEOUT_EXPIRED 0x911B
+#endif
+
+namespace
+{
+    // The OpenGL 2.0 and 3.0 functions used by the renderer are part of the core API:
+    // core profiles don't advertise them as extensions, so GLLoader doesn't load them
+    struct CoreFunctions
+    {
+        GLuint (CODEGEN_FUNCPTR *createShader)(GLenum);
+        void   (CODEGEN_FUNCPTR *shaderSource)(GLuint, GLsizei, const GLchar* const*, const GLint*);
+        void   (CODEGEN_FUNCPTR *compileShader)(GLuint);
+        void   (CODEGEN_FUNCPTR *getShaderiv)(GLuint, GLenum, GLint*);
+        void   (CODEGEN_FUNCPTR *getShaderInfoLog)(GLuint, GLsizei, GLsizei*, GLchar*);
+        void   (CODEGEN_FUNCPTR *deleteShader)(GLuint);
+        GLuint (CODEGEN_FUNCPTR *createProgram)();
+        void   (CODEGEN_FUNCPTR *attachShader)(GLuint, GLuint);
+        void   (CODEGEN_FUNCPTR *bindAttribLocation)(GLuint, GLuint, const GLchar*);
+        void   (CODEGEN_FUNCPTR *linkProgram)(GLuint);
+        void   (CODEGEN_FUNCPTR *getProgramiv)(GLuint, GLenum, GLint*);
+        void   (CODEGEN_FUNCPTR *getProgramInfoLog)(GLuint, GLsizei, GLsizei*, GLchar*);
+        void   (CODEGEN_FUNCPTR *deleteProgram)(GLuint);
+        void   (CODEGEN_FUNCPTR *useProgram)(GLuint);
+        GLint  (CODEGEN_FUNCPTR *getUniformLocation)(GLuint, const GLchar*);
+        void   (CODEGEN_FUNCPTR *uniform1i)(GLint, GLint);
+        void   (CODEGEN_FUNCPTR *uniformMatrix4fv)(GLint, GLsizei, GLboolean, const GLfloat*);
+        void   (CODEGEN_FUNCPTR *enableVertexAttribArray)(GLuint);
+        void   (CODEGEN_FUNCPTR *disableVertexAttribArray)(GLuint);
+        void   (CODEGEN_FUNCPTR *vertexAttrib4f)(GLuint, GLfloat, GLfloat, GLfloat, GLfloat);
+        void   (CODEGEN_FUNCPTR *vertexAttribPointer)(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*);
+        void   (CODEGEN_FUNCPTR *genVertexArrays)(GLsizei, GLuint*);
+        void   (CODEGEN_FUNCPTR *bindVertexArray)(GLuint);
+        void   (CODEGEN_FUNCPTR *genBuffers)(GLsizei, GLuint*);
+        void   (CODEGEN_FUNCPTR *bindBuffer)(GLenum, GLuint);
+        void   (CODEGEN_FUNCPTR *bufferData)(GLenum, GLsizeiptr, const void*, GLenum);
+        void   (CODEGEN_FUNCPTR *bufferSubData)(GLenum, GLintptr, GLsizeiptr, const void*);
+        void   (CODEGEN_FUNCPTR *deleteBuffers)(GLsizei, const GLuint*);
+        void   (CODEGEN_FUNCPTR *drawElementsBaseVertex)(GLenum, GLsizei, GLenum, const void*, GLint);
+        void*  (CODEGEN_FUNCPTR *mapBufferRange)(GLenum, GLintptr, GLsizeiptr, GLbitfield);
+        GLboolean (CODEGEN_FUNCPTR *unmapBuffer)(GLenum);
+        GLsync (CODEGEN_FUNCPTR *fenceSync)(GLenum, GLbitfield);
+        GLenum (CODEGEN_FUNCPTR *clientWaitSync)(GLsync, GLbitfield, GLuint64);
+        void   (CODEGEN_FUNCPTR *deleteSync)(GLsync);
+        void   (CODEGEN_FUNCPTR *bufferStorage)(GLenum, GLsizeiptr, const void*, GLbitfield); // Optional (OpenGL 4.4)
+    };
+
+    CoreFunctions gl;
+    sf::Mutex functionsMutex;
+
+    // Load a function pointer, return true on success
+    template <typename T>
+    bool loadFunction(T& function, const char* name)
+    {
+        function = reinterpret_cast<T>(sf::Context::getFunction(name));
+        return function != NULL;
+    }
+
+    // Load all the functions used by the renderer, only once
+    bool loadFunctions()
+    {
+        sf::Lock lock(functionsMutex);
+
+        static bool loaded = false;
+        static bool success = false;
+        if (!loaded)
+        {
+            success = loadFunction(gl.createShader,            "glCreateShader")            &&
+                      loadFunction(gl.shaderSource,            "glShaderSource")            &&
+                      loadFunction(gl.compileShader,           "glCompileShader")           &&
+                      loadFunction(gl.getShaderiv,             "glGetShaderiv")             &&
+                      loadFunction(gl.getShaderInfoLog,        "glGetShaderInfoLog")        &&
+                      loadFunction(gl.deleteShader,            "glDeleteShader")            &&
+                      loadFunction(gl.createProgram,           "glCreateProgram")           &&
+                      loadFunction(gl.attachShader,            "glAttachShader")            &&
+                      loadFunction(gl.bindAttribLocation,      "glBindAttribLocation")      &&
+                      loadFunction(gl.linkProgram,             "glLinkProgram")             &&
+                      loadFunction(gl.getProgramiv,            "glGetProgramiv")            &&
+                      loadFunction(gl.getProgramInfoLog,       "glGetProgramInfoLog")       &&
+                      loadFunction(gl.deleteProgram,           "glDeleteProgram")           &&
+                      loadFunction(gl.useProgram,              "glUseProgram")              &&
+                      loadFunction(gl.getUniformLocation,      "glGetUniformLocation")      &&
+                      loadFunction(gl.uniform1i,               "glUniform1i")               &&
+                      loadFunction(gl.uniformMatrix4fv,        "glUniformMatrix4fv")        &&
+                      loadFunction(gl.enableVertexAttribArray, "glEnableVertexAttribArray") &&
+                      loadFunction(gl.disableVertexAttribArray, "glDisableVertexAttribArray") &&
+                      loadFunction(gl.vertexAttrib4f,          "glVertexAttrib4f")          &&
+                      loadFunction(gl.vertexAttribPointer,     "glVertexAttribPointer")     &&
+                      loadFunction(gl.genVertexArrays,         "glGenVertexArrays")         &&
+                      loadFunction(gl.bindVertexArray,         "glBindVertexArray")         &&
+                      loadFunction(gl.genBuffers,              "glGenBuffers")              &&
+                      loadFunction(gl.bindBuffer,              "glBindBuffer")              &&
+                      loadFunction(gl.bufferData,              "glBufferData")              &&
+                      loadFunction(gl.bufferSubData,           "glBufferSubData")           &&
+                      loadFunction(gl.deleteBuffers,           "glDeleteBuffers")           &&
+                      loadFunction(gl.drawElementsBaseVertex,  "glDrawElementsBaseVertex")  &&
+                      loadFunction(gl.mapBufferRange,          "glMapBufferRange")          &&
+                      loadFunction(gl.unmapBuffer,             "glUnmapBuffer")             &&
+                      loadFunction(gl.fenceSync,               "glFenceSync")               &&
+                      loadFunction(gl.clientWaitSync,          "glClientWaitSync")          &&
+                      loadFunction(gl.deleteSync,              "glDeleteSync");
+            loadFunction(gl.bufferStorage, "glBufferStorage");
+            loaded = true;
+        }
+
+        return success;
+    }
+
+    // Uniforms whose value must be uploaded
+    enum DirtyFlags
+    {
+        ProjectionDirty    = 1 << 0,
+        ModelViewDirty     = 1 << 1,
+        TextureMatrixDirty = 1 << 2,
+        AllDirty           = ProjectionDirty | ModelViewDirty | TextureMatrixDirty
+    };
+
+    // Shared by the two built-in programs; GLSL 1.50 is the version of OpenGL 3.2,
+    // the first version that has core profiles
+    const char* vertexSource =
+        "#version 150\n"
+        "uniform mat4 sf_Projection;\n"
+        "uniform mat4 sf_ModelView;\n"
+        "uniform mat4 sf_TextureMatrix;\n"
+        "in vec2 sf_Position;\n"
+        "in vec4 sf_Color;\n"
+        "in vec3 sf_TexCoords;\n"
+        "out vec4 sf_FrontColor;\n"
+        "out vec2 sf_TexCoord;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_Position = sf_Projection * sf_ModelView * vec4(sf_Position, 0.0, 1.0);\n"
+        "    sf_FrontColor = sf_Color;\n"
+        "    sf_TexCoord = (sf_TextureMatrix * vec4(sf_TexCoords.xy, 0.0, 1.0)).xy;\n"
+        "}\n";
+
+    const char* colorFragmentSource =
+        "#version 150\n"
+        "in vec4 sf_FrontColor;\n"
+        "out vec4 sf_FragColor;\n"
+        "void main()\n"
+        "{\n"
+        "    sf_FragColor = sf_FrontColor;\n"
+        "}\n";
+
+    const char* textureFragmentSource =
+        "#version 150\n"
+        "uniform sampler2D sf_Texture;\n"
+        "in vec4 sf_FrontColor;\n"
+        "in vec2 sf_TexCoord;\n"
+        "out vec4 sf_FragColor;\n"
+        "void main()\n"
+        "{\n"
+        "    sf_FragColor = sf_FrontColor * texture(sf_Texture, sf_TexCoord);\n"
+        "}\n";
+
+    // Compile a shader, return 0 on failure
+    GLuint compileShader(GLenum type, const char* source)
+    {
+        GLuint shader = 0;
+        glCheck(shader = gl.createShader(type));
+        glCheck(gl.shaderSource(shader, 1, &source, NULL));
+        glCheck(gl.compileShader(shader));
+
+        GLint success = 0;
+        glCheck(gl.getShaderiv(shader, GL_COMPILE_STATUS, &success));
+        if (success == GL_FALSE)
+        {
+            GLint length = 0;
+            glCheck(gl.getShaderiv(shader, GL_INFO_LOG_LENGTH, &length));
+            std::vector<char> log(static_cast<std::size_t>(length) + 1, '\0');
+            glCheck(gl.getShaderInfoLog(shader, static_cast<GLsizei>(log.size()), NULL, &log[0]));
+
+            sf::err() << "Failed to compile built-in " << ((type == GL_VERTEX_SHADER) ? "vertex" : "fragment")
+                      << " shader:" << std::endl << &log[0] << std::endl;
+
+            glCheck(gl.deleteShader(shader));
+            return 0;
+        }
+
+        return shader;
+    }
+
+    // Tell whether the active context implements at least the given OpenGL version
+    bool isVersionGEQ(char major, char minor)
+    {
+        // Function pointers can't be trusted for that, most platforms return them for any name
+        const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+        if (!version || (version[1] != '.'))
+            return false;
+
+        return (version[0] > major) || ((version[0] == major) && (version[2] >= minor));
+    }
+
+    const float identity[16] = {1.f, 0.f, 0.f, 0.f,
+                                0.f, 1.f, 0.f, 0.f,
+                                0.f, 0.f, 1.f, 0.f,
+                                0.f, 0.f, 0.f, 1.f};
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+CoreRenderer::CoreRenderer() :
+m_initialized     (false),
+m_valid           (false),
+m_currentProgram  (-1),
+m_textured        (false),
+m_vertexArray     (0),
+m_streamBuffer    (0),
+m_streamData      (NULL),
+m_streamHead      (0),
+m_streamSegment   (0),
+m_overflowBuffer  (0),
+m_overflowCapacity(0),
+m_attachedBuffer  (0),
+m_attachedFormat  (VertexBuffer::Full),
+m_colorArray      (true),
+m_indexBuffer     (0),
+m_indexCapacity   (0),
+m_quadIndexBuffer (0),
+m_boundIndexBuffer(0)
+{
+    for (int i = 0; i < SegmentCount; ++i)
+        m_fences[i] = NULL;
+
+    for (int i = 0; i < 2; ++i)
+    {
+        m_programs[i].program = 0;
+        m_programs[i].projection = -1;
+        m_programs[i].modelView = -1;
+        m_programs[i].textureMatrix = -1;
+        m_programs[i].dirty = AllDirty;
+    }
+
+    std::memcpy(m_projection, identity, sizeof(identity));
+    std::memcpy(m_modelView, identity, sizeof(identity));
+    std::memcpy(m_textureMatrix, identity, sizeof(identity));
+}
+
+
+////////////////////////////////////////////////////////////
+CoreRenderer::~CoreRenderer()
+{
+    if (!m_initialized || !loadFunctions())
+        return;
+
+    // Programs and buffers are shared, they can be destroyed in any context
+    ensureGlContext();
+
+    for (int i = 0; i < 2; ++i)
+    {
+        if (m_programs[i].program)
+        {
+            glCheck(gl.deleteProgram(m_programs[i].program));
+        }
+    }
+
+    for (int i = 0; i < SegmentCount; ++i)
+    {
+        if (m_fences[i])
+        {
+            glCheck(gl.deleteSync(static_cast<GLsync>(m_fences[i])));
+        }
+    }
+
+    // Deleting the ring buffer also unmaps it
+    if (m_streamBuffer)
+    {
+        glCheck(gl.deleteBuffers(1, &m_streamBuffer));
+    }
+
+    if (m_overflowBuffer)
+    {
+        glCheck(gl.deleteBuffers(1, &m_overflowBuffer));
+    }
+
+    if (m_indexBuffer)
+    {
+        glCheck(gl.deleteBuffers(1, &m_indexBuffer));
+    }
+
+    if (m_quadIndexBuffer)
+    {
+        glCheck(gl.deleteBuffers(1, &m_quadIndexBuffer));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool CoreRenderer::initialize()
+{
+    if (m_initialized)
+        return m_valid;
+
+    m_initialized = true;
+
+    if (!loadFunctions())
+    {
+        err() << "Failed to load the OpenGL functions of the core-profile renderer" << std::endl;
+        return false;
+    }
+
+    if (!createProgram(m_programs[0], colorFragmentSource) || !createProgram(m_programs[1], textureFragmentSource))
+        return false;
+
+    // Create the ring buffer, persistently mapped if immutable storage is supported
+    GLsizeiptr ringSize = static_cast<GLsizeiptr>(RingVertexCount * sizeof(Vertex));
+    glCheck(gl.genBuffers(1, &m_streamBuffer));
+    glCheck(gl.genBuffers(1, &m_overflowBuffer));
+    glCheck(gl.bindBuffer(GL_ARRAY_BUFFER, m_streamBuffer));
+    if (gl.bufferStorage && isVersionGEQ('4', '4'))
+    {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glCheck(gl.bufferStorage(GL_ARRAY_BUFFER, ringSize, NULL, flags));
+        glCheck(m_streamData = gl.mapBufferRange(GL_ARRAY_BUFFER, 0, ringSize, flags));
+    }
+    else
+    {
+        glCheck(gl.bufferData(GL_ARRAY_BUFFER, ringSize, NULL, GL_STREAM_DRAW));
+    }
+    glCheck(gl.bindBuffer(GL_ARRAY_BUFFER, 0));
+
+    glCheck(gl.genBuffers(1, &m_indexBuffer));
+    glCheck(gl.genBuffers(1, &m_quadIndexBuffer));
+
+    glCheck(gl.genVertexArrays(1, &m_vertexArray));
+
+    // Enabling the attributes is part of the vertex array object's state, it's done once
+    glCheck(gl.bindVertexArray(m_vertexArray));
+    glCheck(gl.enableVertexAttribArray(0));
+    glCheck(gl.enableVertexAttribArray(1));
+    glCheck(gl.enableVertexAttribArray(2));
+
+    // The shared quad indices never change, they are uploaded once
+    GLsizeiptr quadIndicesSize = static_cast<GLsizeiptr>(QuadIndicesQuadCount * 6 * sizeof(Uint16));
+    bindIndexBuffer(m_quadIndexBuffer);
+    glCheck(gl.bufferData(GL_ELEMENT_ARRAY_BUFFER, quadIndicesSize, getQuadIndices(), GL_STATIC_DRAW));
+
+    m_valid = true;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::bind()
+{
+    glCheck(gl.bindVertexArray(m_vertexArray));
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::unbind()
+{
+    glCheck(gl.useProgram(0));
+    glCheck(gl.bindBuffer(GL_ARRAY_BUFFER, 0));
+    glCheck(gl.bindVertexArray(0));
+
+    m_currentProgram = -1;
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::setProjection(const float* matrix)
+{
+    updateMatrix(m_projection, matrix, ProjectionDirty);
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::setModelView(const float* matrix)
+{
+    updateMatrix(m_modelView, matrix, ModelViewDirty);
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::setTexture(const float* matrix)
+{
+    m_textured = (matrix != NULL);
+
+    if (matrix)
+        updateMatrix(m_textureMatrix, matrix, TextureMatrixDirty);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t CoreRenderer::setVertices(const Vertex* vertices, std::size_t vertexCount)
+{
+    return uploadVertices(vertices, vertexCount, VertexBuffer::Full);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t CoreRenderer::setVertices(const LayeredVertex* vertices, std::size_t vertexCount)
+{
+    return uploadVertices(vertices, vertexCount, VertexBuffer::Layered);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t CoreRenderer::uploadVertices(const void* vertices, std::size_t vertexCount, VertexBuffer::Format format)
+{
+    std::size_t vertexSize = (format == VertexBuffer::Layered) ? sizeof(LayeredVertex) : sizeof(Vertex);
+    GLsizeiptr size = static_cast<GLsizeiptr>(vertexCount * vertexSize);
+
+    // The ring is allocated in units of sf::Vertex, other sizes need room to align their first vertex
+    std::size_t padding = (vertexSize == sizeof(Vertex)) ? 0 : vertexSize - 1;
+    std::size_t units = (static_cast<std::size_t>(size) + padding + sizeof(Vertex) - 1) / sizeof(Vertex);
+
+    // Arrays that don't fit in the ring buffer get a buffer of their own
+    if (units > RingVertexCount)
+    {
+        glCheck(gl.bindBuffer(GL_ARRAY_BUFFER, m_overflowBuffer));
+
+        // Orphan the previous storage, so that the draws that still read it don't stall the upload
+        if (static_cast<std::size_t>(size) > m_overflowCapacity)
+        {
+            glCheck(gl.bufferData(GL_ARRAY_BUFFER, size, vertices, GL_STREAM_DRAW));
+            m_overflowCapacity = static_cast<std::size_t>(size);
+        }
+        else
+        {
+            glCheck(gl.bufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_overflowCapacity), NULL, GL_STREAM_DRAW));
+            glCheck(gl.bufferSubData(GL_ARRAY_BUFFER, 0, size, vertices));
+        }
+
+        attachBuffer(m_overflowBuffer, format);
+        return 0;
+    }
+
+    std::size_t first = (allocate(units) * sizeof(Vertex) + padding) / vertexSize;
+    GLintptr offset = static_cast<GLintptr>(first * vertexSize);
+
+    if (m_streamData)
+    {
+        // The mapping is coherent: the copy is the upload
+        std::memcpy(static_cast<char*>(m_streamData) + offset, vertices, static_cast<std::size_t>(size));
+    }
+    else
+    {
+        // The fences already guarantee that the range isn't read anymore, the driver doesn't need to synchronize
+        void* data = NULL;
+        glCheck(gl.bindBuffer(GL_ARRAY_BUFFER, m_streamBuffer));
+        glCheck(data = gl.mapBufferRange(GL_ARRAY_BUFFER, offset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT));
+        if (data)
+        {
+            std::memcpy(data, vertices, static_cast<std::size_t>(size));
+            glCheck(gl.unmapBuffer(GL_ARRAY_BUFFER));
+        }
+        else
+        {
+            glCheck(gl.bufferSubData(GL_ARRAY_BUFFER, offset, size, vertices));
+        }
+    }
+
+    // The attributes point to the start of the ring, the draw call selects the range with its first vertex
+    attachBuffer(m_streamBuffer, format);
+    return first;
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::setVertexBuffer(GLuint buffer, VertexBuffer::Format format)
+{
+    // The buffer may have been deleted and its name reused, the attributes are always set again
+    glCheck(gl.bindBuffer(GL_ARRAY_BUFFER, buffer));
+    setAttributePointers(format);
+
+    m_attachedBuffer = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::drawElements(GLenum mode, const void* indices, std::size_t indexCount, std::size_t indexSize, std::size_t baseVertex)
+{
+    GLsizeiptr size = static_cast<GLsizeiptr>(indexCount * indexSize);
+
+    if (indices == getQuadIndices())
+    {
+        bindIndexBuffer(m_quadIndexBuffer);
+    }
+    else
+    {
+        bindIndexBuffer(m_indexBuffer);
+
+        // Orphan the previous storage, so that the draws that still read it don't stall the upload
+        if (static_cast<std::size_t>(size) > m_indexCapacity)
+        {
+            glCheck(gl.bufferData(GL_ELEMENT_ARRAY_BUFFER, size, indices, GL_STREAM_DRAW));
+            m_indexCapacity = static_cast<std::size_t>(size);
+        }
+        else
+        {
+            glCheck(gl.bufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_indexCapacity), NULL, GL_STREAM_DRAW));
+            glCheck(gl.bufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, size, indices));
+        }
+    }
+
+    // The base vertex selects the range of the ring buffer that holds the vertices
+    GLenum type = (indexSize == 4) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+    glCheck(gl.drawElementsBaseVertex(mode, static_cast<GLsizei>(indexCount), type, NULL, static_cast<GLint>(baseVertex)));
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::applyProgram()
+{
+    int index = m_textured ? 1 : 0;
+    Program& program = m_programs[index];
+
+    if (m_currentProgram != index)
+    {
+        glCheck(gl.useProgram(program.program));
+        m_currentProgram = index;
+    }
+
+    // Only upload the uniforms that changed since this program last drew
+    if (program.dirty & ProjectionDirty)
+    {
+        glCheck(gl.uniformMatrix4fv(program.projection, 1, GL_FALSE, m_projection));
+    }
+    if (program.dirty & ModelViewDirty)
+    {
+        glCheck(gl.uniformMatrix4fv(program.modelView, 1, GL_FALSE, m_modelView));
+    }
+    if ((program.dirty & TextureMatrixDirty) && m_textured)
+    {
+        glCheck(gl.uniformMatrix4fv(program.textureMatrix, 1, GL_FALSE, m_textureMatrix));
+    }
+
+    program.dirty = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::invalidateProgram()
+{
+    m_currentProgram = -1;
+}
+
+
+////////////////////////////////////////////////////////////
+bool CoreRenderer::createProgram(Program& program, const char* fragmentSource)
+{
+    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource);
+    if (!vertexShader)
+        return false;
+
+    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentSource);
+    if (!fragmentShader)
+    {
+        glCheck(gl.deleteShader(vertexShader));
+        return false;
+    }
+
+    glCheck(program.program = gl.createProgram());
+    glCheck(gl.attachShader(program.program, vertexShader));
+    glCheck(gl.attachShader(program.program, fragmentShader));
+
+    // The locations must be known before linking, custom shaders can use the same ones
+    glCheck(gl.bindAttribLocation(program.program, 0, "sf_Position"));
+    glCheck(gl.bindAttribLocation(program.program, 1, "sf_Color"));
+    glCheck(gl.bindAttribLocation(program.program, 2, "sf_TexCoords"));
+    glCheck(gl.linkProgram(program.program));
+
+    // The shaders are only flagged for deletion, the program keeps them alive
+    glCheck(gl.deleteShader(vertexShader));
+    glCheck(gl.deleteShader(fragmentShader));
+
+    GLint success = 0;
+    glCheck(gl.getProgramiv(program.program, GL_LINK_STATUS, &success));
+    if (success == GL_FALSE)
+    {
+        GLint length = 0;
+        glCheck(gl.getProgramiv(program.program, GL_INFO_LOG_LENGTH, &length));
+        std::vector<char> log(static_cast<std::size_t>(length) + 1, '\0');
+        glCheck(gl.getProgramInfoLog(program.program, static_cast<GLsizei>(log.size()), NULL, &log[0]));
+
+        err() << "Failed to link built-in shader:" << std::endl << &log[0] << std::endl;
+
+        glCheck(gl.deleteProgram(program.program));
+        program.program = 0;
+        return false;
+    }
+
+    glCheck(program.projection = gl.getUniformLocation(program.program, "sf_Projection"));
+    glCheck(program.modelView = gl.getUniformLocation(program.program, "sf_ModelView"));
+    glCheck(program.textureMatrix = gl.getUniformLocation(program.program, "sf_TextureMatrix"));
+    program.dirty = AllDirty;
+
+    // The texture is always read from the unit 0
+    GLint texture = -1;
+    glCheck(texture = gl.getUniformLocation(program.program, "sf_Texture"));
+    if (texture != -1)
+    {
+        glCheck(gl.useProgram(program.program));
+        glCheck(gl.uniform1i(texture, 0));
+        glCheck(gl.useProgram(0));
+        m_currentProgram = -1;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::updateMatrix(float* destination, const float* source, unsigned flag)
+{
+    // Most draws reuse the previous matrices, avoid uploading them again
+    if (std::memcmp(destination, source, 16 * sizeof(float)) == 0)
+        return;
+
+    std::memcpy(destination, source, 16 * sizeof(float));
+    m_programs[0].dirty |= flag;
+    m_programs[1].dirty |= flag;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t CoreRenderer::allocate(std::size_t vertexCount)
+{
+    // Go back to the start of the ring when its end is reached
+    if (m_streamHead + vertexCount > RingVertexCount)
+    {
+        fenceSegment(m_streamSegment);
+        m_streamHead = 0;
+        m_streamSegment = 0;
+        waitSegment(0);
+    }
+
+    // Every segment that the vertices enter must have been released by the GPU
+    std::size_t lastSegment = (m_streamHead + vertexCount - 1) / SegmentVertexCount;
+    while (m_streamSegment < lastSegment)
+    {
+        fenceSegment(m_streamSegment);
+        ++m_streamSegment;
+        waitSegment(m_streamSegment);
+    }
+
+    std::size_t first = m_streamHead;
+    m_streamHead += vertexCount;
+
+    return first;
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::waitSegment(std::size_t segment)
+{
+    if (!m_fences[segment])
+        return;
+
+    // The segment is usually released long ago: the ring holds several frames worth of vertices
+    GLsync fence = static_cast<GLsync>(m_fences[segment]);
+    GLenum status = GL_TIMEOUT_EXPIRED;
+    while (status == GL_TIMEOUT_EXPIRED)
+    {
+        glCheck(status = gl.clientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000));
+    }
+
+    glCheck(gl.deleteSync(fence));
+    m_fences[segment] = NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::fenceSegment(std::size_t segment)
+{
+    if (m_fences[segment])
+    {
+        glCheck(gl.deleteSync(static_cast<GLsync>(m_fences[segment])));
+    }
+
+    glCheck(m_fences[segment] = gl.fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::attachBuffer(GLuint buffer, VertexBuffer::Format format)
+{
+    if ((m_attachedBuffer == buffer) && (m_attachedFormat == format))
+        return;
+
+    glCheck(gl.bindBuffer(GL_ARRAY_BUFFER, buffer));
+    setAttributePointers(format);
+
+    m_attachedBuffer = buffer;
+    m_attachedFormat = format;
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::bindIndexBuffer(GLuint buffer)
+{
+    // The index buffer binding is part of the vertex array object's state
+    if (m_boundIndexBuffer == buffer)
+        return;
+
+    glCheck(gl.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer));
+    m_boundIndexBuffer = buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+void CoreRenderer::setAttributePointers(VertexBuffer::Format format)
+{
+    // Uncolored vertices read the constant value of the color attribute
+    bool colorArray = (format != VertexBuffer::Uncolored);
+    if (colorArray != m_colorArray)
+    {
+        if (colorArray)
+        {
+            glCheck(gl.enableVertexAttribArray(1));
+        }
+        else
+        {
+            glCheck(gl.disableVertexAttribArray(1));
+        }
+
+        m_colorArray = colorArray;
+    }
+
+    switch (format)
+    {
+        case VertexBuffer::Compact:
+            glCheck(gl.vertexAttribPointer(0, 2, GL_SHORT, GL_FALSE, sizeof(CompactVertex), reinterpret_cast<const void*>(0)));
+            glCheck(gl.vertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(CompactVertex), reinterpret_cast<const void*>(4)));
+            glCheck(gl.vertexAttribPointer(2, 2, GL_SHORT, GL_FALSE, sizeof(CompactVertex), reinterpret_cast<const void*>(8)));
+            break;
+
+        case VertexBuffer::Uncolored:
+            glCheck(gl.vertexAttribPointer(0, 2, GL_SHORT, GL_FALSE, sizeof(UncoloredVertex), reinterpret_cast<const void*>(0)));
+            glCheck(gl.vertexAttrib4f(1, 1.f, 1.f, 1.f, 1.f));
+            glCheck(gl.vertexAttribPointer(2, 2, GL_SHORT, GL_FALSE, sizeof(UncoloredVertex), reinterpret_cast<const void*>(4)));
+            break;
+
+        case VertexBuffer::Layered:
+            glCheck(gl.vertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(LayeredVertex), reinterpret_cast<const void*>(0)));
+            glCheck(gl.vertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(LayeredVertex), reinterpret_cast<const void*>(8)));
+            glCheck(gl.vertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(LayeredVertex), reinterpret_cast<const void*>(12)));
+            break;
+
+        default:
+            glCheck(gl.vertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const void*>(0)));
+            glCheck(gl.vertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), reinterpret_cast<const void*>(8)));
+            glCheck(gl.vertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const void*>(12)));
+            break;
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
+
+#else // SFML_OPENGL_ES
+
+// OpenGL ES contexts never use a core profile: the renderer is never initialized
+
+namespace sf
+{
+namespace priv
+{
+CoreRenderer::CoreRenderer() : m_initialized(false), m_valid(false), m_currentProgram(-1), m_textured(false),
+                               m_vertexArray(0), m_streamBuffer(0), m_streamData(NULL), m_streamHead(0), m_streamSegment(0),
+                               m_overflowBuffer(0), m_overflowCapacity(0), m_attachedBuffer(0), m_attachedFormat(VertexBuffer::Full), m_colorArray(true), m_indexBuffer(0),
+                               m_indexCapacity(0), m_quadIndexBuffer(0), m_boundIndexBuffer(0) {}
+CoreRenderer::~CoreRenderer() {}
+bool CoreRenderer::initialize() {return false;}
+void CoreRenderer::bind() {}
+void CoreRenderer::unbind() {}
+void CoreRenderer::setProjection(const float*) {}
+void CoreRenderer::setModelView(const float*) {}
+void CoreRenderer::setTexture(const float*) {}
+std::size_t CoreRenderer::setVertices(const Vertex*, std::size_t) {return 0;}
+std::size_t CoreRenderer::setVertices(const LayeredVertex*, std::size_t) {return 0;}
+void CoreRenderer::setVertexBuffer(GLuint, VertexBuffer::Format) {}
+void CoreRenderer::drawElements(GLenum, const void*, std::size_t, std::size_t, std::size_t) {}
+void CoreRenderer::applyProgram() {}
+void CoreRenderer::invalidateProgram() {}
+
+} // namespace priv
+
+} // namespace sf
+
+#endif // SFML_OPENGL_ES
@@ -0,0 +1,346 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_CORERENDERER_HPP
+#define SFML_CORERENDERER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GLExtensions.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+class LayeredVertex;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Renderer used by sf::RenderTarget in core-profile contexts
+///
+/// Core profiles have no fixed-function pipeline: the vertices
+/// are streamed into a vertex buffer and drawn by built-in
+/// shaders (one for untextured and one for textured draws),
+/// the matrices are passed as uniforms.
+///
+/// The vertex attributes are bound to the locations 0
+/// (position), 1 (color) and 2 (texture coordinates, with
+/// the layer of sf::LayeredVertex as third component), so
+/// that custom shaders can read them too.
+///
+/// Vertices in client memory are written to a ring buffer,
+/// split into segments that are protected by fences: a
+/// segment is only overwritten once the GPU is done with the
+/// draws that read it. With OpenGL 4.4 (ARB_buffer_storage)
+/// the ring is persistently mapped and an upload is a plain
+/// copy; otherwise each upload maps its range unsynchronized.
+///
+////////////////////////////////////////////////////////////
+class CoreRenderer : GlResource, NonCopyable
+{
+public:
+
+    enum {RingVertexCount = 1 << 17};                             ///< Capacity of the ring buffer, in vertices
+    enum {SegmentCount = 4};                                      ///< Number of fenced segments in the ring buffer
+    enum {SegmentVertexCount = RingVertexCount / SegmentCount};   ///< Capacity of a segment, in vertices
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// No OpenGL object is created until initialize is called.
+    ///
+    ////////////////////////////////////////////////////////////
+    CoreRenderer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The vertex array object is left to the render target's
+    /// context, which may already be destroyed at this point.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~CoreRenderer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the OpenGL objects of the renderer
+    ///
+    /// This function must be called in the context of the
+    /// render target, which owns the vertex array object.
+    /// Nothing happens if the renderer was already created.
+    ///
+    /// \return True if the renderer is ready to draw
+    ///
+    ////////////////////////////////////////////////////////////
+    bool initialize();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind the vertex array object of the renderer
+    ///
+    ////////////////////////////////////////////////////////////
+    void bind();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unbind the program and the vertex array object
+    ///
+    ////////////////////////////////////////////////////////////
+    void unbind();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the projection matrix
+    ///
+    /// \param matrix 4x4 matrix, in column-major order
+    ///
+    ////////////////////////////////////////////////////////////
+    void setProjection(const float* matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the model-view matrix
+    ///
+    /// \param matrix 4x4 matrix, in column-major order
+    ///
+    ////////////////////////////////////////////////////////////
+    void setModelView(const float* matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the texture matrix, or disable texturing
+    ///
+    /// The texture itself must be bound to GL_TEXTURE_2D of the
+    /// texture unit 0.
+    ///
+    /// \param matrix 4x4 matrix in column-major order, or NULL to draw untextured primitives
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const float* matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload vertices in client memory for the next draw call
+    ///
+    /// The vertices are copied to the ring buffer and the
+    /// vertex attributes point to it. Arrays larger than the
+    /// ring buffer go to a separate buffer, orphaned at every
+    /// upload.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    ///
+    /// \return Index of the first uploaded vertex in the bound buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t setVertices(const Vertex* vertices, std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload layered vertices in client memory for the next draw call
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    ///
+    /// \return Index of the first uploaded vertex in the bound buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t setVertices(const LayeredVertex* vertices, std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Use the vertices of a buffer for the next draw call
+    ///
+    /// \param buffer OpenGL identifier of the vertex buffer
+    /// \param format Layout of the vertices in the buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    void setVertexBuffer(GLuint buffer, VertexBuffer::Format format);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw indexed primitives from the current vertices
+    ///
+    /// The indices are uploaded to an index buffer, except the
+    /// shared quad indices (priv::getQuadIndices) which have a
+    /// static buffer of their own.
+    ///
+    /// \param mode       OpenGL primitive type
+    /// \param indices    Pointer to the indices
+    /// \param indexCount Number of indices to draw
+    /// \param indexSize  Size of an index, in bytes (2 or 4)
+    /// \param baseVertex Number added to each index
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawElements(GLenum mode, const void* indices, std::size_t indexCount, std::size_t indexSize, std::size_t baseVertex);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Activate the built-in program needed by the next
+    ///        draw call and upload the uniforms that changed
+    ///
+    /// This is not needed when the draw uses a custom shader.
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyProgram();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Notify the renderer that another program was activated
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateProgram();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Built-in program and its uniforms
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Program
+    {
+        GLuint   program;       ///< OpenGL identifier of the program
+        GLint    projection;    ///< Location of the projection matrix
+        GLint    modelView;     ///< Location of the model-view matrix
+        GLint    textureMatrix; ///< Location of the texture matrix
+        unsigned dirty;         ///< Uniforms that changed since they were last uploaded
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compile and link a built-in program
+    ///
+    /// \param program        Program to fill
+    /// \param fragmentSource Source code of the fragment shader
+    ///
+    /// \return True on success
+    ///
+    ////////////////////////////////////////////////////////////
+    bool createProgram(Program& program, const char* fragmentSource);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a matrix and mark the corresponding uniform as dirty
+    ///
+    /// \param destination Matrix to update
+    /// \param source      New value of the matrix
+    /// \param flag        Dirty flag of the uniform
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateMatrix(float* destination, const float* source, unsigned flag);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload vertices in client memory, in any format
+    ///
+    /// The ring buffer is allocated in units of sf::Vertex; the
+    /// vertices of other sizes start at an offset aligned to
+    /// their own size, so that they can be reached by a first
+    /// vertex index.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param format      Layout of the vertices (Full or Layered)
+    ///
+    /// \return Index of the first uploaded vertex in the bound buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t uploadVertices(const void* vertices, std::size_t vertexCount, VertexBuffer::Format format);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reserve space for vertices in the ring buffer
+    ///
+    /// \param vertexCount Number of vertices, at most RingVertexCount
+    ///
+    /// \return Index of the first reserved vertex
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t allocate(std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the GPU is done with a segment of the ring buffer
+    ///
+    /// \param segment Index of the segment
+    ///
+    ////////////////////////////////////////////////////////////
+    void waitSegment(std::size_t segment);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Insert a fence after the draws that read a segment
+    ///
+    /// \param segment Index of the segment
+    ///
+    ////////////////////////////////////////////////////////////
+    void fenceSegment(std::size_t segment);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Point the vertex attributes to a buffer, unless they already do
+    ///
+    /// \param buffer OpenGL identifier of the buffer
+    /// \param format Layout of the vertices in the buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    void attachBuffer(GLuint buffer, VertexBuffer::Format format);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind an index buffer to the vertex array object, unless it already is
+    ///
+    /// \param buffer OpenGL identifier of the buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    void bindIndexBuffer(GLuint buffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Point the vertex attributes to the bound buffer
+    ///
+    /// \param format Layout of the vertices in the buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAttributePointers(VertexBuffer::Format format);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    bool                 m_initialized;          ///< Were the OpenGL objects created?
+    bool                 m_valid;                ///< Is the renderer ready to draw?
+    Program              m_programs[2];          ///< Untextured and textured programs
+    int                  m_currentProgram;       ///< Index of the active program, -1 if unknown
+    bool                 m_textured;             ///< Is the next draw textured?
+    float                m_projection[16];       ///< Projection matrix
+    float                m_modelView[16];        ///< Model-view matrix
+    float                m_textureMatrix[16];    ///< Texture matrix
+    GLuint               m_vertexArray;          ///< Vertex array object, owned by the render target's context
+    GLuint               m_streamBuffer;         ///< Ring buffer that receives the vertices in client memory
+    void*                m_streamData;           ///< Persistent mapping of the ring buffer, NULL if ranges are mapped at every upload
+    std::size_t          m_streamHead;           ///< Index of the first free vertex in the ring buffer
+    std::size_t          m_streamSegment;        ///< Segment of the ring buffer being written
+    void*                m_fences[SegmentCount]; ///< Fences placed after the draws that read each segment
+    GLuint               m_overflowBuffer;       ///< Buffer used by the arrays that don't fit in the ring buffer
+    std::size_t          m_overflowCapacity;     ///< Capacity of the overflow buffer, in bytes
+    GLuint               m_attachedBuffer;       ///< Buffer that the vertex attributes point to, 0 if unknown
+    VertexBuffer::Format m_attachedFormat;       ///< Layout that the vertex attributes read from the attached buffer
+    bool                 m_colorArray;           ///< Is the color attribute read from the vertices?
+    GLuint               m_indexBuffer;          ///< Buffer that receives the indices in client memory
+    std::size_t          m_indexCapacity;        ///< Size of the index buffer's storage, in bytes
+    GLuint               m_quadIndexBuffer;      ///< Static buffer that holds the shared quad indices
+    GLuint               m_boundIndexBuffer;     ///< Index buffer bound to the vertex array object
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_CORERENDERER_HPP
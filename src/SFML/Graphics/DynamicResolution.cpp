@@ -0,0 +1,405 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/DynamicResolution.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Weight of a new measure in the moving average
+    const float averageWeight = 0.1f;
+
+    // Band around the target frame time where the GPU time doesn't change the scale,
+    // and load aimed for when it does, leaving some room for the variations
+    const float upperBand = 0.9f;
+    const float lowerBand = 0.7f;
+    const float aimedLoad = 0.8f;
+
+    // Without timer queries: average time between frames considered as late, and
+    // number of measures without late frames before trying a larger scale
+    const float        lateFrames    = 1.2f;
+    const unsigned int probeInterval = 120;
+    const float        probeStep     = 1.05f;
+
+    // Largest changes of the scale at once
+    const float minStep = 0.75f;
+    const float maxStep = 1.1f;
+
+    // Number of measures ignored after a change, while the frames at the previous scale finish
+    const unsigned int cooldownMeasures = 8;
+
+    // Number of frames that can be measured at the same time
+    const unsigned int measureCount = 3;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+DynamicResolution::DynamicResolution() :
+m_texture        (),
+m_targetSize     (0, 0),
+m_renderSize     (0, 0),
+m_scale          (1.f),
+m_minScale       (0.5f),
+m_maxScale       (1.f),
+m_targetFrameTime(microseconds(16667)),
+m_averageTime    (0.f),
+m_cooldown       (0),
+m_stableMeasures (0),
+m_currentMeasure (0),
+m_measuring      (false),
+m_gpuTiming      (false),
+m_frameClock     (),
+m_firstFrame     (true)
+{
+    for (unsigned int i = 0; i < measureCount; ++i)
+    {
+        m_measures[i].begin = 0;
+        m_measures[i].end = 0;
+        m_measures[i].pending = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+DynamicResolution::~DynamicResolution()
+{
+    releaseMeasures();
+}
+
+
+////////////////////////////////////////////////////////////
+void DynamicResolution::setTargetFrameTime(Time time)
+{
+    m_targetFrameTime = time;
+}
+
+
+////////////////////////////////////////////////////////////
+Time DynamicResolution::getTargetFrameTime() const
+{
+    return m_targetFrameTime;
+}
+
+
+////////////////////////////////////////////////////////////
+void DynamicResolution::setScaleRange(float minimum, float maximum)
+{
+    minimum = std::max(minimum, 0.01f);
+    maximum = std::max(maximum, minimum);
+
+    // The texture must be created again for a new largest scale
+    if (maximum != m_maxScale)
+        m_targetSize = Vector2u(0, 0);
+
+    m_minScale = minimum;
+    m_maxScale = maximum;
+    m_scale = std::max(m_minScale, std::min(m_scale, m_maxScale));
+}
+
+
+////////////////////////////////////////////////////////////
+float DynamicResolution::getScale() const
+{
+    return m_scale;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u DynamicResolution::getRenderSize() const
+{
+    return m_renderSize;
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTexture& DynamicResolution::begin(const RenderTarget& target)
+{
+    Vector2u size = target.getSize();
+
+    // The texture is created for the largest scale, the smaller ones use its top-left part
+    if (size != m_targetSize)
+    {
+        // The queries belong to the context of the previous texture
+        releaseMeasures();
+
+        unsigned int width = std::max(1u, static_cast<unsigned int>(std::ceil(size.x * m_maxScale)));
+        unsigned int height = std::max(1u, static_cast<unsigned int>(std::ceil(size.y * m_maxScale)));
+
+        if (!m_texture.create(width, height))
+            err() << "Failed to create the render texture for dynamic resolution" << std::endl;
+
+        m_texture.setSmooth(true);
+        m_targetSize = size;
+        m_firstFrame = true;
+
+#ifndef SFML_OPENGL_ES
+        m_gpuTiming = m_texture.setActive(true) && GLEXT_timer_query;
+#endif
+    }
+
+    Vector2u textureSize = m_texture.getSize();
+    m_renderSize.x = std::max(1u, std::min(static_cast<unsigned int>(size.x * m_scale + 0.5f), textureSize.x));
+    m_renderSize.y = std::max(1u, std::min(static_cast<unsigned int>(size.y * m_scale + 0.5f), textureSize.y));
+
+    setView(target.getView());
+
+    if (m_texture.setActive(true))
+        beginMeasure();
+
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void DynamicResolution::setView(const View& view)
+{
+    // Shrink the viewport to the part of the texture in use
+    Vector2u textureSize = m_texture.getSize();
+    float scaleX = textureSize.x ? static_cast<float>(m_renderSize.x) / textureSize.x : 1.f;
+    float scaleY = textureSize.y ? static_cast<float>(m_renderSize.y) / textureSize.y : 1.f;
+
+    const FloatRect& viewport = view.getViewport();
+
+    View scaledView(view);
+    scaledView.setViewport(FloatRect(viewport.left * scaleX, viewport.top * scaleY,
+                                     viewport.width * scaleX, viewport.height * scaleY));
+    m_texture.setView(scaledView);
+}
+
+
+////////////////////////////////////////////////////////////
+void DynamicResolution::end(RenderTarget& target, const RenderStates& states)
+{
+    if (m_texture.setActive(true))
+    {
+        endMeasure();
+        collectMeasures();
+    }
+
+    m_texture.display();
+
+    // Stretch the part of the texture in use to the whole target
+    Vector2f targetSize(static_cast<float>(m_targetSize.x), static_cast<float>(m_targetSize.y));
+    Vector2f renderSize(static_cast<float>(m_renderSize.x), static_cast<float>(m_renderSize.y));
+
+    m_quad[0] = Vertex(Vector2f(0, 0), Vector2f(0, 0));
+    m_quad[1] = Vertex(Vector2f(0, targetSize.y), Vector2f(0, renderSize.y));
+    m_quad[2] = Vertex(Vector2f(targetSize.x, 0), Vector2f(renderSize.x, 0));
+    m_quad[3] = Vertex(targetSize, renderSize);
+
+    RenderStates quadStates(states);
+    quadStates.texture = &m_texture.getTexture();
+
+    View view = target.getView();
+    target.setView(View(FloatRect(0, 0, targetSize.x, targetSize.y)));
+    target.draw(m_quad, 4, TrianglesStrip, quadStates);
+    target.setView(view);
+}
+
+
+////////////////////////////////////////////////////////////
+void DynamicResolution::releaseMeasures()
+{
+#ifndef SFML_OPENGL_ES
+
+    // Query objects are not shared between contexts, they must be deleted in the texture's one
+    if (m_measures[0].begin && m_texture.setActive(true))
+    {
+        for (unsigned int i = 0; i < measureCount; ++i)
+        {
+            GLuint queries[] = {m_measures[i].begin, m_measures[i].end};
+            glCheck(GLEXT_glDeleteQueries(2, queries));
+        }
+    }
+
+#endif
+
+    for (unsigned int i = 0; i < measureCount; ++i)
+    {
+        m_measures[i].begin = 0;
+        m_measures[i].end = 0;
+        m_measures[i].pending = false;
+    }
+
+    m_currentMeasure = 0;
+    m_measuring = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void DynamicResolution::beginMeasure()
+{
+    m_measuring = false;
+
+#ifndef SFML_OPENGL_ES
+
+    if (!m_gpuTiming)
+        return;
+
+    // All the queries are in flight: the GPU is a few frames behind, this one is not measured
+    Measure& measure = m_measures[m_currentMeasure];
+    if (measure.pending)
+        return;
+
+    if (!measure.begin)
+    {
+        for (unsigned int i = 0; i < measureCount; ++i)
+        {
+            glCheck(GLEXT_glGenQueries(1, &m_measures[i].begin));
+            glCheck(GLEXT_glGenQueries(1, &m_measures[i].end));
+        }
+    }
+
+    glCheck(GLEXT_glQueryCounter(measure.begin, GLEXT_GL_TIMESTAMP));
+    m_measuring = true;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void DynamicResolution::endMeasure()
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!m_measuring)
+        return;
+
+    Measure& measure = m_measures[m_currentMeasure];
+    glCheck(GLEXT_glQueryCounter(measure.end, GLEXT_GL_TIMESTAMP));
+    measure.pending = true;
+
+    m_currentMeasure = (m_currentMeasure + 1) % measureCount;
+    m_measuring = false;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void DynamicResolution::collectMeasures()
+{
+    if (!m_gpuTiming)
+    {
+        // Fall back to the time between two frames
+        Time elapsed = m_frameClock.restart();
+        if (!m_firstFrame)
+            adjustScale(static_cast<float>(elapsed.asMicroseconds()));
+
+        m_firstFrame = false;
+        return;
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    // Read the finished measures, from the oldest one
+    for (unsigned int i = 0; i < measureCount; ++i)
+    {
+        Measure& measure = m_measures[(m_currentMeasure + i) % measureCount];
+        if (!measure.pending)
+            continue;
+
+        GLuint available = 0;
+        glCheck(GLEXT_glGetQueryObjectuiv(measure.end, GLEXT_GL_QUERY_RESULT_AVAILABLE, &available));
+        if (!available)
+            break;
+
+        GLuint64 begin = 0;
+        GLuint64 end = 0;
+        glCheck(GLEXT_glGetQueryObjectui64v(measure.begin, GLEXT_GL_QUERY_RESULT, &begin));
+        glCheck(GLEXT_glGetQueryObjectui64v(measure.end, GLEXT_GL_QUERY_RESULT, &end));
+        measure.pending = false;
+
+        adjustScale(static_cast<float>(end - begin) / 1000.f);
+    }
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void DynamicResolution::adjustScale(float time)
+{
+    m_averageTime = (m_averageTime > 0.f) ? m_averageTime + (time - m_averageTime) * averageWeight : time;
+
+    if (m_cooldown > 0)
+    {
+        --m_cooldown;
+        return;
+    }
+
+    if (m_averageTime <= 0.f)
+        return;
+
+    float target = static_cast<float>(m_targetFrameTime.asMicroseconds());
+    float scale = m_scale;
+
+    if (m_gpuTiming)
+    {
+        // The cost of a frame is roughly proportional to its number of pixels, i.e. to the
+        // square of the scale; the small variations inside the band are ignored
+        if ((m_averageTime > target * upperBand) || (m_averageTime < target * lowerBand))
+            scale = m_scale * std::sqrt(target * aimedLoad / m_averageTime);
+    }
+    else
+    {
+        // The time between frames doesn't go below the refresh period with vertical
+        // synchronization, so it can only tell when frames are late: the scale is
+        // decreased then, and increased by a small step after a while without them
+        if (m_averageTime > target * lateFrames)
+        {
+            scale = m_scale * std::sqrt(target / m_averageTime);
+            m_stableMeasures = 0;
+        }
+        else if (++m_stableMeasures >= probeInterval)
+        {
+            scale = m_scale * probeStep;
+            m_stableMeasures = 0;
+        }
+    }
+
+    scale = std::max(m_scale * minStep, std::min(scale, m_scale * maxStep));
+    scale = std::max(m_minScale, std::min(scale, m_maxScale));
+
+    if (scale != m_scale)
+    {
+        // Start a new average at the new scale
+        m_scale = scale;
+        m_averageTime = 0.f;
+        m_cooldown = cooldownMeasures;
+    }
+}
+
+} // namespace sf
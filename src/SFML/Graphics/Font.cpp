@@ -27,18 +27,31 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Font.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
-#ifdef SFML_SYSTEM_ANDROID
-    #include <SFML/System/Android/ResourceStream.hpp>
-#endif
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Window/Context.hpp>
 #include <SFML/System/InputStream.hpp>
+#include <SFML/System/MappedFileInputStream.hpp>
+#include <SFML/System/Allocator.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/FrameArena.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Profiler.hpp>
+#include <SFML/System/Thread.hpp>
 #include <ft2build.h>
 #include FT_FREETYPE_H
 #include FT_GLYPH_H
 #include FT_OUTLINE_H
 #include FT_BITMAP_H
+#include FT_ADVANCES_H
+#include FT_MODULE_H
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
+#include <set>
 
 
 namespace
@@ -60,39 +73,617 @@ namespace
     void close(FT_Stream)
     {
     }
+
+    // FreeType memory callbacks that go through the allocator hooks
+    void* allocate(FT_Memory, long size)
+    {
+        return sf::Allocator::allocate(static_cast<std::size_t>(size), sf::Allocator::Fonts);
+    }
+    void* reallocate(FT_Memory, long, long size, void* block)
+    {
+        return sf::Allocator::reallocate(block, static_cast<std::size_t>(size), sf::Allocator::Fonts);
+    }
+    void deallocate(FT_Memory, void* block)
+    {
+        sf::Allocator::deallocate(block, sf::Allocator::Fonts);
+    }
+
+    // Create a FreeType library whose memory goes through the allocator hooks;
+    // it must be destroyed with FT_Done_Library, since its memory manager is shared
+    FT_Error createLibrary(FT_Library* library)
+    {
+        static FT_MemoryRec_ memory = {NULL, &allocate, &deallocate, &reallocate};
+
+        FT_Error error = FT_New_Library(&memory, library);
+        if (error == 0)
+            FT_Add_Default_Modules(*library);
+
+        return error;
+    }
+
+    // Number of code points whose glyphs are looked up directly (Latin-1)
+    const sf::Uint32 directGlyphCount = 256;
+
+    // Hash a glyph key, mixing all its bits into the lowest ones
+    std::size_t hashGlyphKey(sf::Uint32 key)
+    {
+        key ^= key >> 16;
+        key *= 0x45D9F3B;
+        key ^= key >> 16;
+        return key;
+    }
+
+    // Hash function for the kerning pairs (the two code points of a pair are in the high and low bits of the key)
+    std::size_t hashKerningKey(sf::Uint64 key)
+    {
+        return hashGlyphKey((static_cast<sf::Uint32>(key >> 32) * 0x9E3779B1) ^ static_cast<sf::Uint32>(key));
+    }
+
+    // Identifier and version of the glyph atlas files
+    const char        atlasMagic[4] = {'S', 'F', 'G', 'A'};
+    const sf::Uint32  atlasVersion  = 1;
+    const sf::Uint32  atlasDistanceField = 1;
+
+    // Write values to an atlas file, in little endian byte order
+    void writeUint32(std::ostream& stream, sf::Uint32 value)
+    {
+        char bytes[4] = {static_cast<char>(value & 0xFF),
+                         static_cast<char>((value >> 8) & 0xFF),
+                         static_cast<char>((value >> 16) & 0xFF),
+                         static_cast<char>((value >> 24) & 0xFF)};
+        stream.write(bytes, 4);
+    }
+    void writeFloat(std::ostream& stream, float value)
+    {
+        sf::Uint32 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        writeUint32(stream, bits);
+    }
+
+    // Read values from an atlas file in memory, checking the bounds
+    bool readUint32(const sf::Uint8*& data, const sf::Uint8* end, sf::Uint32& value)
+    {
+        if (end - data < 4)
+            return false;
+
+        value = data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<sf::Uint32>(data[3]) << 24);
+        data += 4;
+        return true;
+    }
+    bool readFloat(const sf::Uint8*& data, const sf::Uint8* end, float& value)
+    {
+        sf::Uint32 bits;
+        if (!readUint32(data, end, bits))
+            return false;
+
+        std::memcpy(&value, &bits, sizeof(value));
+        return true;
+    }
+    bool readInt(const sf::Uint8*& data, const sf::Uint8* end, int& value)
+    {
+        sf::Uint32 bits;
+        if (!readUint32(data, end, bits))
+            return false;
+
+        value = static_cast<int>(static_cast<sf::Int32>(bits));
+        return true;
+    }
+
+    // Distance (in pixels of the base size) covered by the values of a distance field
+    int getDistanceFieldSpread(unsigned int baseSize)
+    {
+        return std::max(2, static_cast<int>(baseSize / 8));
+    }
+
+    // One dimensional squared Euclidean distance transform (Felzenszwalb & Huttenlocher)
+    void distanceTransform(const float* input, float* output, int count, int* hulls, float* bounds)
+    {
+        const float infinity = 1e20f;
+
+        int k = 0;
+        hulls[0] = 0;
+        bounds[0] = -infinity;
+        bounds[1] = infinity;
+        for (int q = 1; q < count; ++q)
+        {
+            float s = ((input[q] + q * q) - (input[hulls[k]] + hulls[k] * hulls[k])) / (2 * q - 2 * hulls[k]);
+            while (s <= bounds[k])
+            {
+                --k;
+                s = ((input[q] + q * q) - (input[hulls[k]] + hulls[k] * hulls[k])) / (2 * q - 2 * hulls[k]);
+            }
+            ++k;
+            hulls[k] = q;
+            bounds[k] = s;
+            bounds[k + 1] = infinity;
+        }
+
+        k = 0;
+        for (int q = 0; q < count; ++q)
+        {
+            while (bounds[k + 1] < q)
+                ++k;
+            output[q] = static_cast<float>((q - hulls[k]) * (q - hulls[k])) + input[hulls[k]];
+        }
+    }
+
+    // Scratch buffers of the distance transforms, taken from the arena of the calling thread
+    typedef std::vector<float, sf::FrameAllocator<float> > ScratchFloats;
+    typedef std::vector<int, sf::FrameAllocator<int> >     ScratchInts;
+
+    // Two dimensional squared Euclidean distance transform, in place
+    void distanceTransform(ScratchFloats& grid, int width, int height)
+    {
+        int size = std::max(width, height);
+        ScratchFloats input(size);
+        ScratchFloats output(size);
+        ScratchInts   hulls(size);
+        ScratchFloats bounds(size + 1);
+
+        // Columns
+        for (int x = 0; x < width; ++x)
+        {
+            for (int y = 0; y < height; ++y)
+                input[y] = grid[x + y * width];
+            distanceTransform(&input[0], &output[0], height, &hulls[0], &bounds[0]);
+            for (int y = 0; y < height; ++y)
+                grid[x + y * width] = output[y];
+        }
+
+        // Rows
+        for (int y = 0; y < height; ++y)
+        {
+            distanceTransform(&grid[y * width], &output[0], width, &hulls[0], &bounds[0]);
+            std::copy(output.begin(), output.begin() + width, grid.begin() + y * width);
+        }
+    }
+
+    // Build the RGBA distance field of a glyph from the alpha channel of its RGBA coverage,
+    // the result is larger than the glyph by the spread distance on each side
+    void computeDistanceField(const std::vector<sf::Uint8>& coverage, int width, int height, int spread, std::vector<sf::Uint8>& field)
+    {
+        const float infinity = 1e20f;
+
+        int fieldWidth = width + 2 * spread;
+        int fieldHeight = height + 2 * spread;
+
+        // Squared distances to the nearest pixel inside and outside the glyph
+        ScratchFloats toInside(fieldWidth * fieldHeight, 0.f);
+        ScratchFloats toOutside(fieldWidth * fieldHeight, 0.f);
+        for (int y = 0; y < fieldHeight; ++y)
+        {
+            for (int x = 0; x < fieldWidth; ++x)
+            {
+                int glyphX = x - spread;
+                int glyphY = y - spread;
+                bool inside = (glyphX >= 0) && (glyphX < width) && (glyphY >= 0) && (glyphY < height) &&
+                              (coverage[(glyphX + glyphY * width) * 4 + 3] >= 128);
+
+                toInside[x + y * fieldWidth] = inside ? 0.f : infinity;
+                toOutside[x + y * fieldWidth] = inside ? infinity : 0.f;
+            }
+        }
+        distanceTransform(toInside, fieldWidth, fieldHeight);
+        distanceTransform(toOutside, fieldWidth, fieldHeight);
+
+        // Map the signed distances so that the edge is at 0.5
+        field.assign(fieldWidth * fieldHeight * 4, 255);
+        for (int i = 0; i < fieldWidth * fieldHeight; ++i)
+        {
+            float distance = (toInside[i] > 0.f) ? std::sqrt(toInside[i]) - 0.5f : 0.5f - std::sqrt(toOutside[i]);
+            float value = 0.5f - distance / (2.f * spread);
+            value = std::max(0.f, std::min(1.f, value));
+            field[i * 4 + 3] = static_cast<sf::Uint8>(value * 255.f + 0.5f);
+        }
+    }
+
+    // Change the current size of a face
+    bool setFaceSize(FT_Face face, unsigned int characterSize)
+    {
+        // FT_Set_Pixel_Sizes is an expensive function, so we must call it
+        // only when necessary to avoid killing performances
+
+        FT_UShort currentSize = face->size->metrics.x_ppem;
+
+        if (currentSize != characterSize)
+        {
+            FT_Error result = FT_Set_Pixel_Sizes(face, 0, characterSize);
+
+            if (result == FT_Err_Invalid_Pixel_Size)
+            {
+                // In the case of bitmap fonts, resizing can
+                // fail if the requested size is not available
+                if (!FT_IS_SCALABLE(face))
+                {
+                    sf::err() << "Failed to set bitmap font size to " << characterSize << std::endl;
+                    sf::err() << "Available sizes are: ";
+                    for (int i = 0; i < face->num_fixed_sizes; ++i)
+                        sf::err() << face->available_sizes[i].height << " ";
+                    sf::err() << std::endl;
+                }
+            }
+
+            return result == FT_Err_Ok;
+        }
+        else
+        {
+            return true;
+        }
+    }
+
+    // Rasterize a glyph with a FreeType face; the pixels are RGBA, size is zero if the glyph is empty
+    sf::Glyph rasterizeGlyph(FT_Library library, FT_Face face, unsigned int distanceFieldSize, sf::Uint32 codePoint,
+                             unsigned int characterSize, bool bold, std::vector<sf::Uint8>& pixels, sf::Vector2u& size)
+    {
+        // The glyph to return
+        sf::Glyph glyph;
+        size = sf::Vector2u(0, 0);
+
+        if (!face)
+            return glyph;
+
+        // Set the character size
+        if (!setFaceSize(face, characterSize))
+            return glyph;
+
+        // Load the glyph corresponding to the code point
+        // (distance fields are scaled, hinting for the base size would only distort them)
+        FT_Int32 flags = distanceFieldSize ? FT_LOAD_TARGET_NORMAL | FT_LOAD_NO_HINTING : FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT;
+        if (FT_Load_Char(face, codePoint, flags) != 0)
+            return glyph;
+
+        // Retrieve the glyph
+        FT_Glyph glyphDesc;
+        if (FT_Get_Glyph(face->glyph, &glyphDesc) != 0)
+            return glyph;
+
+        // Apply bold if necessary -- first technique using outline (highest quality)
+        FT_Pos weight = 1 << 6;
+        bool outline = (glyphDesc->format == FT_GLYPH_FORMAT_OUTLINE);
+        if (bold && outline)
+        {
+            FT_OutlineGlyph outlineGlyph = (FT_OutlineGlyph)glyphDesc;
+            FT_Outline_Embolden(&outlineGlyph->outline, weight);
+        }
+
+        // Convert the glyph to a bitmap (i.e. rasterize it)
+        FT_Glyph_To_Bitmap(&glyphDesc, FT_RENDER_MODE_NORMAL, 0, 1);
+        FT_Bitmap& bitmap = reinterpret_cast<FT_BitmapGlyph>(glyphDesc)->bitmap;
+
+        // Apply bold if necessary -- fallback technique using bitmap (lower quality)
+        if (bold && !outline)
+        {
+            FT_Bitmap_Embolden(library, &bitmap, weight, weight);
+        }
+
+        // Compute the glyph's advance offset
+        glyph.advance = static_cast<float>(face->glyph->metrics.horiAdvance) / static_cast<float>(1 << 6);
+        if (bold)
+            glyph.advance += static_cast<float>(weight) / static_cast<float>(1 << 6);
+
+        int width  = bitmap.width;
+        int height = bitmap.rows;
+
+        if ((width > 0) && (height > 0))
+        {
+            // Compute the glyph's bounding box
+            glyph.bounds.left   = static_cast<float>(face->glyph->metrics.horiBearingX) / static_cast<float>(1 << 6);
+            glyph.bounds.top    = -static_cast<float>(face->glyph->metrics.horiBearingY) / static_cast<float>(1 << 6);
+            glyph.bounds.width  = static_cast<float>(face->glyph->metrics.width) / static_cast<float>(1 << 6);
+            glyph.bounds.height = static_cast<float>(face->glyph->metrics.height) / static_cast<float>(1 << 6);
+
+            // Extract the glyph's pixels from the bitmap
+            pixels.resize(width * height * 4, 255);
+            const sf::Uint8* source = bitmap.buffer;
+            if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+            {
+                // Pixels are 1 bit monochrome values
+                for (int y = 0; y < height; ++y)
+                {
+                    for (int x = 0; x < width; ++x)
+                    {
+                        // The color channels remain white, just fill the alpha channel
+                        std::size_t index = (x + y * width) * 4 + 3;
+                        pixels[index] = ((source[x / 8]) & (1 << (7 - (x % 8)))) ? 255 : 0;
+                    }
+                    source += bitmap.pitch;
+                }
+            }
+            else
+            {
+                // Pixels are 8 bits gray levels
+                for (int y = 0; y < height; ++y)
+                {
+                    for (int x = 0; x < width; ++x)
+                    {
+                        // The color channels remain white, just fill the alpha channel
+                        std::size_t index = (x + y * width) * 4 + 3;
+                        pixels[index] = source[x];
+                    }
+                    source += bitmap.pitch;
+                }
+            }
+
+            // Convert the coverage to a distance field
+            if (distanceFieldSize)
+            {
+                // Distance fields extend beyond the glyph, up to the spread distance
+                int spread = getDistanceFieldSpread(distanceFieldSize);
+
+                std::vector<sf::Uint8> field;
+                computeDistanceField(pixels, width, height, spread, field);
+                pixels.swap(field);
+
+                // The quad must cover the whole distance field, so that it maps exactly onto the texture
+                FT_BitmapGlyph bitmapGlyph = reinterpret_cast<FT_BitmapGlyph>(glyphDesc);
+                glyph.bounds.left   = static_cast<float>(bitmapGlyph->left - spread);
+                glyph.bounds.top    = static_cast<float>(-bitmapGlyph->top - spread);
+                glyph.bounds.width  = static_cast<float>(width + 2 * spread);
+                glyph.bounds.height = static_cast<float>(height + 2 * spread);
+
+                width += 2 * spread;
+                height += 2 * spread;
+            }
+
+            size = sf::Vector2u(width, height);
+        }
+
+        // Delete the FT glyph
+        FT_Done_Glyph(glyphDesc);
+
+        return glyph;
+    }
+
+    // Write several glyphs into a texture, reading it back and uploading it only once
+    void writeGlyphs(sf::Texture& texture, const std::vector<sf::IntRect>& rects, const std::vector<const sf::Uint8*>& pixels)
+    {
+        if (rects.empty())
+            return;
+
+        sf::Image image = texture.copyToImage();
+        for (std::size_t i = 0; i < rects.size(); ++i)
+        {
+            sf::Image glyphImage;
+            glyphImage.create(rects[i].width, rects[i].height, pixels[i]);
+            image.copy(glyphImage, rects[i].left, rects[i].top);
+        }
+        texture.update(image);
+    }
 }
 
 
 namespace sf
 {
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Worker thread rasterizing glyphs with its own FreeType face
+///
+////////////////////////////////////////////////////////////
+class GlyphRasterizer : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Glyph rasterized by the worker
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Result
+    {
+        unsigned int       characterSize; ///< Size at which the glyph was rendered
+        Uint32             key;           ///< Code point combined with the bold flag
+        Glyph              glyph;         ///< Glyph, without texture rectangle
+        std::vector<Uint8> pixels;        ///< RGBA pixels of the glyph
+        Vector2u           size;          ///< Size of the pixels, zero if the glyph is empty
+    };
+
+    typedef std::pair<unsigned int, Uint32> GlyphId; ///< Character size and key of a glyph
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open a new face on the font file or memory, and create the rasterizer
+    ///
+    /// \return New rasterizer, NULL if the face couldn't be opened
+    ///
+    ////////////////////////////////////////////////////////////
+    static GlyphRasterizer* create(const std::string& filename, const void* data, std::size_t sizeInBytes, unsigned int distanceFieldSize)
+    {
+        // FreeType objects must not be shared between threads, so the worker gets its own library and face
+        FT_Library library;
+        if (createLibrary(&library) != 0)
+            return NULL;
+
+        FT_Face face = NULL;
+        FT_Error error = data ? FT_New_Memory_Face(library, reinterpret_cast<const FT_Byte*>(data), static_cast<FT_Long>(sizeInBytes), 0, &face)
+                              : FT_New_Face(library, filename.c_str(), 0, &face);
+        if ((error != 0) || (FT_Select_Charmap(face, FT_ENCODING_UNICODE) != 0))
+        {
+            err() << "Failed to create the font face of the glyph loading thread, glyphs will be loaded synchronously" << std::endl;
+            if (error == 0)
+                FT_Done_Face(face);
+            FT_Done_Library(library);
+            return NULL;
+        }
+
+        return new GlyphRasterizer(library, face, distanceFieldSize);
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor, discards the glyphs that are not rasterized yet
+    ///
+    ////////////////////////////////////////////////////////////
+    ~GlyphRasterizer()
+    {
+        {
+            Lock lock(m_mutex);
+            m_requests.clear();
+        }
+        m_thread.wait();
+
+        FT_Done_Face(m_face);
+        FT_Done_Library(m_library);
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a glyph, starting the worker if it is idle
+    ///
+    ////////////////////////////////////////////////////////////
+    void request(const GlyphId& id)
+    {
+        bool launch;
+        {
+            Lock lock(m_mutex);
+            m_requests.push_back(id);
+            launch = !m_running;
+            m_running = true;
+        }
+
+        // The worker stops when the queue is empty (there's no condition variable to wait on),
+        // so it is launched again for the next batch; launch first joins the previous run
+        if (launch)
+            m_thread.launch();
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take the glyphs rasterized since the last call
+    ///
+    ////////////////////////////////////////////////////////////
+    void takeResults(std::deque<Result>& results)
+    {
+        Lock lock(m_mutex);
+        results.swap(m_results);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Member data (placeholders and pending are only used by the font's thread)
+    ////////////////////////////////////////////////////////////
+    std::map<GlyphId, Glyph> placeholders; ///< Placeholders returned by getGlyph, by displayed character size
+    std::set<GlyphId>        pending;      ///< Glyphs queued to the worker, by rendered character size
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    GlyphRasterizer(FT_Library library, FT_Face face, unsigned int distanceFieldSize) :
+    m_library          (library),
+    m_face             (face),
+    m_distanceFieldSize(distanceFieldSize),
+    m_running          (false),
+    m_thread           (&GlyphRasterizer::run, this)
+    {
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize the queued glyphs until the queue is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    void run()
+    {
+        for (;;)
+        {
+            GlyphId id;
+            {
+                Lock lock(m_mutex);
+                if (m_requests.empty())
+                {
+                    m_running = false;
+                    return;
+                }
+                id = m_requests.front();
+                m_requests.pop_front();
+            }
+
+            Result result;
+            result.characterSize = id.first;
+            result.key = id.second;
+            result.glyph = rasterizeGlyph(m_library, m_face, m_distanceFieldSize, id.second & 0x7FFFFFFF, id.first,
+                                          (id.second >> 31) != 0, result.pixels, result.size);
+
+            // Move the pixels rather than copying them while the mutex is locked
+            Lock lock(m_mutex);
+            m_results.push_back(Result());
+            m_results.back().characterSize = result.characterSize;
+            m_results.back().key = result.key;
+            m_results.back().glyph = result.glyph;
+            m_results.back().size = result.size;
+            m_results.back().pixels.swap(result.pixels);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    FT_Library          m_library;           ///< FreeType library of the worker
+    FT_Face             m_face;              ///< FreeType face of the worker
+    unsigned int        m_distanceFieldSize; ///< Base size of the distance field glyphs, 0 if the mode is disabled
+    Mutex               m_mutex;             ///< Mutex protecting the queues and the running flag
+    std::deque<GlyphId> m_requests;          ///< Glyphs waiting to be rasterized
+    std::deque<Result>  m_results;           ///< Glyphs rasterized, waiting to be uploaded
+    bool                m_running;           ///< Is the worker running?
+    Thread              m_thread;            ///< Worker thread
+};
+
+} // namespace priv
+
+
 ////////////////////////////////////////////////////////////
 Font::Font() :
-m_library  (NULL),
-m_face     (NULL),
-m_streamRec(NULL),
-m_refCount (NULL),
-m_info     ()
+m_library            (NULL),
+m_face               (NULL),
+m_streamRec          (NULL),
+m_mapping            (NULL),
+m_refCount           (NULL),
+m_info               (),
+m_lastPage           (NULL),
+m_lastPageSize       (0),
+m_distanceFieldSize  (0),
+m_distanceFieldGlyphs(),
+m_kerning            (),
+m_sourceFile         (),
+m_sourceData         (NULL),
+m_sourceSize         (0),
+m_asyncGlyphLoading  (false),
+m_rasterizer         (NULL),
+m_glyphRevision      (0),
+m_cacheBudget        (0),
+m_cacheClock         (0),
+m_cacheStatistics    (),
+m_compactionClock    (),
+m_lastTextureSize    (0),
+m_contextGeneration  (Context::getGeneration())
 {
-    #ifdef SFML_SYSTEM_ANDROID
-        m_stream = NULL;
-    #endif
 }
 
 
 ////////////////////////////////////////////////////////////
 Font::Font(const Font& copy) :
-m_library    (copy.m_library),
-m_face       (copy.m_face),
-m_streamRec  (copy.m_streamRec),
-m_refCount   (copy.m_refCount),
-m_info       (copy.m_info),
-m_pages      (copy.m_pages),
-m_pixelBuffer(copy.m_pixelBuffer)
-{
-    #ifdef SFML_SYSTEM_ANDROID
-        m_stream = NULL;
-    #endif
-
+m_library            (copy.m_library),
+m_face               (copy.m_face),
+m_streamRec          (copy.m_streamRec),
+m_mapping            (copy.m_mapping),
+m_refCount           (copy.m_refCount),
+m_info               (copy.m_info),
+m_pages              (copy.m_pages),
+m_lastPage           (NULL),
+m_lastPageSize       (0),
+m_pixelBuffer        (copy.m_pixelBuffer),
+m_distanceFieldSize  (copy.m_distanceFieldSize),
+m_distanceFieldGlyphs(copy.m_distanceFieldGlyphs),
+m_kerning            (copy.m_kerning),
+m_sourceFile         (copy.m_sourceFile),
+m_sourceData         (copy.m_sourceData),
+m_sourceSize         (copy.m_sourceSize),
+m_asyncGlyphLoading  (copy.m_asyncGlyphLoading),
+m_rasterizer         (NULL),
+m_glyphRevision      (copy.m_glyphRevision),
+m_cacheBudget        (copy.m_cacheBudget),
+m_cacheClock         (copy.m_cacheClock),
+m_cacheStatistics    (copy.m_cacheStatistics),
+m_compactionClock    (),
+m_lastTextureSize    (copy.m_lastTextureSize),
+m_contextGeneration  (copy.m_contextGeneration)
+{
     // Note: as FreeType doesn't provide functions for copying/cloning,
     // we must share all the FreeType pointers
 
@@ -105,21 +696,12 @@ m_pixelBuffer(copy.m_pixelBuffer)
 Font::~Font()
 {
     cleanup();
-
-    #ifdef SFML_SYSTEM_ANDROID
-
-    if (m_stream)
-        delete (priv::ResourceStream*)m_stream;
-
-    #endif
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Font::loadFromFile(const std::string& filename)
 {
-    #ifndef SFML_SYSTEM_ANDROID
-
     // Cleanup the previous resources
     cleanup();
     m_refCount = new int(1);
@@ -128,16 +710,31 @@ bool Font::loadFromFile(const std::string& filename)
     // Note: we initialize FreeType for every font instance in order to avoid having a single
     // global manager that would create a lot of issues regarding creation and destruction order.
     FT_Library library;
-    if (FT_Init_FreeType(&library) != 0)
+    if (createLibrary(&library) != 0)
     {
         err() << "Failed to load font \"" << filename << "\" (failed to initialize FreeType)" << std::endl;
         return false;
     }
     m_library = library;
 
+    // Map the file in memory, so that FreeType reads it in place instead of through stdio
+    // (on Android, the asset manager maps or inflates the asset from the APK)
+    MappedFileInputStream* mapping = new MappedFileInputStream;
+    if (mapping->open(filename))
+    {
+        m_mapping = mapping;
+    }
+    else
+    {
+        delete mapping;
+    }
+
     // Load the new font face from the specified file
     FT_Face face;
-    if (FT_New_Face(static_cast<FT_Library>(m_library), filename.c_str(), 0, &face) != 0)
+    FT_Error error = m_mapping ? FT_New_Memory_Face(static_cast<FT_Library>(m_library), static_cast<const FT_Byte*>(m_mapping->getData()),
+                                                    static_cast<FT_Long>(m_mapping->getSize()), 0, &face)
+                               : FT_New_Face(static_cast<FT_Library>(m_library), filename.c_str(), 0, &face);
+    if (error != 0)
     {
         err() << "Failed to load font \"" << filename << "\" (failed to create the font face)" << std::endl;
         return false;
@@ -153,21 +750,18 @@ bool Font::loadFromFile(const std::string& filename)
 
     // Store the loaded font in our ugly void* :)
     m_face = face;
+    m_sourceFile = filename;
+    if (m_mapping)
+    {
+        // The background rasterizer opens its face on the mapped file too
+        m_sourceData = m_mapping->getData();
+        m_sourceSize = static_cast<std::size_t>(m_mapping->getSize());
+    }
 
     // Store the font information
     m_info.family = face->family_name ? face->family_name : std::string();
 
     return true;
-
-    #else
-
-    if (m_stream)
-        delete (priv::ResourceStream*)m_stream;
-
-    m_stream = new priv::ResourceStream(filename);
-    return loadFromStream(*(priv::ResourceStream*)m_stream);
-
-    #endif
 }
 
 
@@ -182,7 +776,7 @@ bool Font::loadFromMemory(const void* data, std::size_t sizeInBytes)
     // Note: we initialize FreeType for every font instance in order to avoid having a single
     // global manager that would create a lot of issues regarding creation and destruction order.
     FT_Library library;
-    if (FT_Init_FreeType(&library) != 0)
+    if (createLibrary(&library) != 0)
     {
         err() << "Failed to load font from memory (failed to initialize FreeType)" << std::endl;
         return false;
@@ -207,6 +801,8 @@ bool Font::loadFromMemory(const void* data, std::size_t sizeInBytes)
 
     // Store the loaded font in our ugly void* :)
     m_face = face;
+    m_sourceData = data;
+    m_sourceSize = sizeInBytes;
 
     // Store the font information
     m_info.family = face->family_name ? face->family_name : std::string();
@@ -218,6 +814,11 @@ bool Font::loadFromMemory(const void* data, std::size_t sizeInBytes)
 ////////////////////////////////////////////////////////////
 bool Font::loadFromStream(InputStream& stream)
 {
+    // Mapped files are read in place
+    MappedFileInputStream* mapping = dynamic_cast<MappedFileInputStream*>(&stream);
+    if (mapping && mapping->getData())
+        return loadFromMemory(mapping->getData(), static_cast<std::size_t>(mapping->getSize()));
+
     // Cleanup the previous resources
     cleanup();
     m_refCount = new int(1);
@@ -226,7 +827,7 @@ bool Font::loadFromStream(InputStream& stream)
     // Note: we initialize FreeType for every font instance in order to avoid having a single
     // global manager that would create a lot of issues regarding creation and destruction order.
     FT_Library library;
-    if (FT_Init_FreeType(&library) != 0)
+    if (createLibrary(&library) != 0)
     {
         err() << "Failed to load font from stream (failed to initialize FreeType)" << std::endl;
         return false;
@@ -291,24 +892,72 @@ const Font::Info& Font::getInfo() const
 ////////////////////////////////////////////////////////////
 const Glyph& Font::getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const
 {
-    // Get the page corresponding to the character size
-    GlyphTable& glyphs = m_pages[characterSize].glyphs;
+    discardLostPages();
 
     // Build the key by combining the code point and the bold flag
     Uint32 key = ((bold ? 1 : 0) << 31) | codePoint;
 
+    if (m_distanceFieldSize)
+    {
+        // Glyphs of all sizes are scaled from the one rendered at the base size
+        GlyphTable& glyphs = m_distanceFieldGlyphs[characterSize];
+        if (const Glyph* scaled = glyphs.find(key))
+        {
+            ++m_cacheStatistics.hits;
+            return *scaled;
+        }
+
+        // The base glyphs are stored in the single distance field page
+        GlyphTable& baseGlyphs = getPage(0).glyphs;
+        const Glyph* base = baseGlyphs.find(key);
+        if (base)
+        {
+            ++m_cacheStatistics.hits;
+        }
+        else
+        {
+            ++m_cacheStatistics.misses;
+
+            // Placeholders are not scaled copies, they must not be cached
+            if (priv::GlyphRasterizer* rasterizer = getRasterizer())
+                return requestGlyph(*rasterizer, codePoint, characterSize, bold);
+
+            base = &baseGlyphs.insert(key, loadGlyph(codePoint, m_distanceFieldSize, bold));
+        }
+
+        float scale = static_cast<float>(characterSize) / m_distanceFieldSize;
+        Glyph glyph = *base;
+        glyph.advance       *= scale;
+        glyph.bounds.left   *= scale;
+        glyph.bounds.top    *= scale;
+        glyph.bounds.width  *= scale;
+        glyph.bounds.height *= scale;
+
+        return glyphs.insert(key, glyph);
+    }
+
+    // Get the page corresponding to the character size
+    GlyphTable& glyphs = getPage(characterSize).glyphs;
+
     // Search the glyph into the cache
-    GlyphTable::const_iterator it = glyphs.find(key);
-    if (it != glyphs.end())
+    if (const Glyph* glyph = glyphs.find(key))
     {
         // Found: just return it
-        return it->second;
+        ++m_cacheStatistics.hits;
+        return *glyph;
+    }
+
+    ++m_cacheStatistics.misses;
+
+    if (priv::GlyphRasterizer* rasterizer = getRasterizer())
+    {
+        // Not found: let the background rasterizer load it
+        return requestGlyph(*rasterizer, codePoint, characterSize, bold);
     }
     else
     {
         // Not found: we have to load it
-        Glyph glyph = loadGlyph(codePoint, characterSize, bold);
-        return glyphs.insert(std::make_pair(key, glyph)).first->second;
+        return glyphs.insert(key, loadGlyph(codePoint, characterSize, bold));
     }
 }
 
@@ -322,7 +971,18 @@ float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize)
 
     FT_Face face = static_cast<FT_Face>(m_face);
 
-    if (face && FT_HAS_KERNING(face) && setCurrentSize(characterSize))
+    // Invalid font, or no kerning
+    if (!face || !FT_HAS_KERNING(face))
+        return 0.f;
+
+    // Look for the pair in the cache
+    KerningTable& table = m_kerning[characterSize];
+    Uint64 key = (static_cast<Uint64>(first) << 32) | second;
+    if (const float* cached = table.find(key))
+        return *cached;
+
+    float offset = 0.f;
+    if (setCurrentSize(characterSize))
     {
         // Convert the characters to indices
         FT_UInt index1 = FT_Get_Char_Index(face, first);
@@ -330,20 +990,19 @@ float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize)
 
         // Get the kerning vector
         FT_Vector kerning;
-        FT_Get_Kerning(face, index1, index2, FT_KERNING_DEFAULT, &kerning);
+        if (FT_Get_Kerning(face, index1, index2, FT_KERNING_DEFAULT, &kerning) == 0)
+        {
+            // X advance is already in pixels for bitmap fonts
+            if (FT_IS_SCALABLE(face))
+                offset = static_cast<float>(kerning.x) / static_cast<float>(1 << 6);
+            else
+                offset = static_cast<float>(kerning.x);
+        }
+    }
 
-        // X advance is already in pixels for bitmap fonts
-        if (!FT_IS_SCALABLE(face))
-            return static_cast<float>(kerning.x);
+    table.insert(key, offset);
 
-        // Return the X advance
-        return static_cast<float>(kerning.x) / static_cast<float>(1 << 6);
-    }
-    else
-    {
-        // Invalid font, or no kerning
-        return 0.f;
-    }
+    return offset;
 }
 
 
@@ -406,41 +1065,525 @@ float Font::getUnderlineThickness(unsigned int characterSize) const
 ////////////////////////////////////////////////////////////
 const Texture& Font::getTexture(unsigned int characterSize) const
 {
-    return m_pages[characterSize].texture;
+    discardLostPages();
+
+    // All the sizes share the same page in distance field mode
+    m_lastTextureSize = m_distanceFieldSize ? 0 : characterSize;
+    return getPage(m_lastTextureSize).texture;
 }
 
 
 ////////////////////////////////////////////////////////////
-Font& Font::operator =(const Font& right)
+bool Font::setDistanceField(bool enabled, unsigned int baseSize)
 {
-    Font temp(right);
+    unsigned int size = enabled ? baseSize : 0;
+    if (size == m_distanceFieldSize)
+        return true;
+
+    if (enabled)
+    {
+        FT_Face face = static_cast<FT_Face>(m_face);
+        if (!face || !FT_IS_SCALABLE(face))
+        {
+            err() << "Failed to enable distance field mode: the font is not loaded or is not scalable" << std::endl;
+            return false;
+        }
 
-    std::swap(m_library,     temp.m_library);
-    std::swap(m_face,        temp.m_face);
-    std::swap(m_streamRec,   temp.m_streamRec);
-    std::swap(m_refCount,    temp.m_refCount);
-    std::swap(m_info,        temp.m_info);
-    std::swap(m_pages,       temp.m_pages);
-    std::swap(m_pixelBuffer, temp.m_pixelBuffer);
+        if (!Shader::isAvailable())
+        {
+            err() << "Failed to enable distance field mode: shaders are not available on this system" << std::endl;
+            return false;
+        }
 
-    return *this;
+        if (baseSize == 0)
+        {
+            err() << "Failed to enable distance field mode: invalid base size" << std::endl;
+            return false;
+        }
+    }
+
+    // The glyphs loaded so far are not valid anymore
+    m_distanceFieldSize = size;
+    m_pages.clear();
+    m_lastPage = NULL;
+    m_distanceFieldGlyphs.clear();
+
+    // The glyphs being rasterized in the background as well
+    delete m_rasterizer;
+    m_rasterizer = NULL;
+
+    return true;
 }
 
 
 ////////////////////////////////////////////////////////////
-void Font::cleanup()
+bool Font::isDistanceField() const
 {
-    // Check if we must destroy the FreeType pointers
-    if (m_refCount)
-    {
-        // Decrease the reference counter
-        (*m_refCount)--;
+    return m_distanceFieldSize != 0;
+}
 
-        // Free the resources only if we are the last owner
-        if (*m_refCount == 0)
-        {
-            // Delete the reference counter
-            delete m_refCount;
+
+////////////////////////////////////////////////////////////
+void Font::setAsyncGlyphLoading(bool enabled)
+{
+    m_asyncGlyphLoading = enabled;
+
+    // The pending glyphs will be requested again, synchronously
+    if (!enabled)
+    {
+        delete m_rasterizer;
+        m_rasterizer = NULL;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::isAsyncGlyphLoading() const
+{
+    return m_asyncGlyphLoading;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Font::uploadPendingGlyphs() const
+{
+    discardLostPages();
+
+    if (!m_rasterizer)
+        return m_glyphRevision;
+
+    std::deque<priv::GlyphRasterizer::Result> results;
+    m_rasterizer->takeResults(results);
+    if (results.empty())
+        return m_glyphRevision;
+
+    // Group the glyphs by page, so that each page texture is updated only once
+    std::map<unsigned int, std::vector<std::size_t> > pages;
+    for (std::size_t i = 0; i < results.size(); ++i)
+        pages[m_distanceFieldSize ? 0 : results[i].characterSize].push_back(i);
+
+    for (std::map<unsigned int, std::vector<std::size_t> >::const_iterator it = pages.begin(); it != pages.end(); ++it)
+    {
+        Page& page = getPage(it->first);
+
+        std::vector<IntRect> rects;
+        std::vector<const Uint8*> pixels;
+        for (std::vector<std::size_t>::const_iterator index = it->second.begin(); index != it->second.end(); ++index)
+        {
+            priv::GlyphRasterizer::Result& result = results[*index];
+
+            // The glyph may have been added in the meantime (by preloadGlyphs or an atlas)
+            if (!page.glyphs.find(result.key))
+            {
+                if ((result.size.x > 0) && (result.size.y > 0))
+                {
+                    result.glyph.textureRect = allocateGlyphRect(page, result.size);
+                    rects.push_back(result.glyph.textureRect);
+                    pixels.push_back(&result.pixels[0]);
+                }
+                page.glyphs.insert(result.key, result.glyph);
+            }
+
+            // Remove the placeholders of the glyph (of all the sizes scaled from it in distance field mode)
+            m_rasterizer->pending.erase(priv::GlyphRasterizer::GlyphId(result.characterSize, result.key));
+            std::map<priv::GlyphRasterizer::GlyphId, Glyph>::iterator placeholder = m_rasterizer->placeholders.begin();
+            while (placeholder != m_rasterizer->placeholders.end())
+            {
+                if ((placeholder->first.second == result.key) && (m_distanceFieldSize || (placeholder->first.first == result.characterSize)))
+                    m_rasterizer->placeholders.erase(placeholder++);
+                else
+                    ++placeholder;
+            }
+        }
+
+        writeGlyphs(page.texture, rects, pixels);
+    }
+
+    // Force an OpenGL flush, so that the font's texture will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+
+    return ++m_glyphRevision;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::preloadGlyphs(const String& characters, unsigned int characterSize, bool bold)
+{
+    if (!m_face)
+        return;
+
+    // In distance field mode, the base glyphs are the ones to load
+    unsigned int renderSize = m_distanceFieldSize ? m_distanceFieldSize : characterSize;
+    Page& page = getPage(m_distanceFieldSize ? 0 : characterSize);
+
+    // Rasterize all the missing glyphs and allocate their rectangles first, so
+    // that the page is resized (if needed) before any new pixel is written
+    std::vector<IntRect> rects;
+    std::deque<std::vector<Uint8> > pixels;
+    std::vector<const Uint8*> glyphPixels;
+    std::vector<Uint8> buffer;
+    for (std::size_t i = 0; i < characters.getSize(); ++i)
+    {
+        Uint32 key = ((bold ? 1 : 0) << 31) | characters[i];
+        if (page.glyphs.find(key))
+            continue;
+
+        Vector2u size;
+        Glyph glyph = rasterizeGlyph(static_cast<FT_Library>(m_library), static_cast<FT_Face>(m_face), m_distanceFieldSize,
+                                     characters[i], renderSize, bold, buffer, size);
+        if ((size.x > 0) && (size.y > 0))
+        {
+            glyph.textureRect = allocateGlyphRect(page, size);
+            rects.push_back(glyph.textureRect);
+            pixels.push_back(std::vector<Uint8>(buffer.begin(), buffer.begin() + size.x * size.y * 4));
+            glyphPixels.push_back(&pixels.back()[0]);
+        }
+
+        page.glyphs.insert(key, glyph);
+    }
+
+    if (rects.empty())
+        return;
+
+    // Write all the new glyphs to the page at once
+    writeGlyphs(page.texture, rects, glyphPixels);
+
+    // The scaled copies of the distance field glyphs are created on demand
+    m_distanceFieldGlyphs.clear();
+
+    // Force an OpenGL flush, so that the font's texture will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::saveAtlasToFile(const std::string& filename, unsigned int characterSize) const
+{
+    PageTable::const_iterator page = m_pages.find(m_distanceFieldSize ? 0 : characterSize);
+    if (page == m_pages.end())
+    {
+        err() << "Failed to save font atlas \"" << filename << "\" (no glyph loaded for character size " << characterSize << ")" << std::endl;
+        return false;
+    }
+
+    std::ofstream file(filename.c_str(), std::ios_base::binary);
+    if (!file)
+    {
+        err() << "Failed to save font atlas \"" << filename << "\" (cannot open file)" << std::endl;
+        return false;
+    }
+
+    Image image = page->second.texture.copyToImage();
+    Vector2u size = image.getSize();
+
+    // Header
+    file.write(atlasMagic, sizeof(atlasMagic));
+    writeUint32(file, atlasVersion);
+    writeUint32(file, m_distanceFieldSize ? m_distanceFieldSize : characterSize);
+    writeUint32(file, m_distanceFieldSize ? atlasDistanceField : 0);
+    writeUint32(file, size.x);
+    writeUint32(file, size.y);
+
+    // Rows, to be able to add more glyphs after loading
+    const std::vector<Row>& rows = page->second.rows;
+    writeUint32(file, page->second.nextRow);
+    writeUint32(file, static_cast<Uint32>(rows.size()));
+    for (std::vector<Row>::const_iterator it = rows.begin(); it != rows.end(); ++it)
+    {
+        writeUint32(file, it->width);
+        writeUint32(file, it->top);
+        writeUint32(file, it->height);
+    }
+
+    // Glyphs
+    const GlyphTable& glyphs = page->second.glyphs;
+    writeUint32(file, static_cast<Uint32>(glyphs.getSize()));
+    for (std::size_t i = 0; i < glyphs.getSize(); ++i)
+    {
+        const Glyph& glyph = glyphs.getGlyph(i);
+        writeUint32(file, glyphs.getKey(i));
+        writeFloat(file, glyph.advance);
+        writeFloat(file, glyph.bounds.left);
+        writeFloat(file, glyph.bounds.top);
+        writeFloat(file, glyph.bounds.width);
+        writeFloat(file, glyph.bounds.height);
+        writeUint32(file, static_cast<Uint32>(glyph.textureRect.left));
+        writeUint32(file, static_cast<Uint32>(glyph.textureRect.top));
+        writeUint32(file, static_cast<Uint32>(glyph.textureRect.width));
+        writeUint32(file, static_cast<Uint32>(glyph.textureRect.height));
+    }
+
+    // Pixels: the color channels are always white, only the alpha channel is stored
+    std::vector<char> alpha(size.x * size.y);
+    const Uint8* pixels = image.getPixelsPtr();
+    for (std::size_t i = 0; i < alpha.size(); ++i)
+        alpha[i] = static_cast<char>(pixels[i * 4 + 3]);
+    if (!alpha.empty())
+        file.write(&alpha[0], alpha.size());
+
+    if (!file)
+    {
+        err() << "Failed to save font atlas \"" << filename << "\" (write error)" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::loadAtlasFromFile(const std::string& filename)
+{
+    std::ifstream file(filename.c_str(), std::ios_base::binary);
+    if (!file)
+    {
+        err() << "Failed to load font atlas \"" << filename << "\" (cannot open file)" << std::endl;
+        return false;
+    }
+
+    file.seekg(0, std::ios_base::end);
+    std::streamsize size = file.tellg();
+    file.seekg(0, std::ios_base::beg);
+
+    std::vector<char> buffer(size > 0 ? static_cast<std::size_t>(size) : 0);
+    if (!buffer.empty())
+        file.read(&buffer[0], size);
+
+    if (buffer.empty() || !loadAtlasFromMemory(&buffer[0], buffer.size()))
+    {
+        err() << "Failed to load font atlas \"" << filename << "\"" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::loadAtlasFromMemory(const void* data, std::size_t sizeInBytes)
+{
+    const Uint8* current = static_cast<const Uint8*>(data);
+    const Uint8* end = current + sizeInBytes;
+
+    // Header
+    Uint32 version = 0, characterSize = 0, flags = 0, width = 0, height = 0;
+    if ((sizeInBytes < sizeof(atlasMagic)) || (std::memcmp(current, atlasMagic, sizeof(atlasMagic)) != 0))
+    {
+        err() << "Failed to load font atlas from memory (not an atlas)" << std::endl;
+        return false;
+    }
+    current += sizeof(atlasMagic);
+
+    if (!readUint32(current, end, version) || (version != atlasVersion) ||
+        !readUint32(current, end, characterSize) || (characterSize == 0) ||
+        !readUint32(current, end, flags) ||
+        !readUint32(current, end, width) || (width == 0) ||
+        !readUint32(current, end, height) || (height == 0))
+    {
+        err() << "Failed to load font atlas from memory (invalid or unsupported header)" << std::endl;
+        return false;
+    }
+
+    // Rows
+    Uint32 nextRow = 0, rowCount = 0;
+    std::vector<Row> rows;
+    bool valid = readUint32(current, end, nextRow) && readUint32(current, end, rowCount);
+    for (Uint32 i = 0; valid && (i < rowCount); ++i)
+    {
+        Uint32 rowWidth = 0, rowTop = 0, rowHeight = 0;
+        valid = readUint32(current, end, rowWidth) && readUint32(current, end, rowTop) && readUint32(current, end, rowHeight);
+
+        rows.push_back(Row(rowTop, rowHeight));
+        rows.back().width = rowWidth;
+    }
+
+    // Glyphs
+    Uint32 glyphCount = 0;
+    GlyphTable glyphs;
+    valid = valid && readUint32(current, end, glyphCount);
+    for (Uint32 i = 0; valid && (i < glyphCount); ++i)
+    {
+        Uint32 key = 0;
+        Glyph glyph;
+        valid = readUint32(current, end, key)                  &&
+                readFloat(current, end, glyph.advance)         &&
+                readFloat(current, end, glyph.bounds.left)     &&
+                readFloat(current, end, glyph.bounds.top)      &&
+                readFloat(current, end, glyph.bounds.width)    &&
+                readFloat(current, end, glyph.bounds.height)   &&
+                readInt(current, end, glyph.textureRect.left)  &&
+                readInt(current, end, glyph.textureRect.top)   &&
+                readInt(current, end, glyph.textureRect.width) &&
+                readInt(current, end, glyph.textureRect.height);
+
+        if (!glyphs.find(key))
+            glyphs.insert(key, glyph);
+    }
+
+    // Pixels
+    if (!valid || (static_cast<std::size_t>(end - current) < static_cast<std::size_t>(width) * height))
+    {
+        err() << "Failed to load font atlas from memory (truncated data)" << std::endl;
+        return false;
+    }
+
+    std::vector<Uint8> pixels(width * height * 4, 255);
+    for (std::size_t i = 0; i < static_cast<std::size_t>(width) * height; ++i)
+        pixels[i * 4 + 3] = current[i];
+
+    // Switch to the mode of the atlas
+    unsigned int distanceFieldSize = (flags & atlasDistanceField) ? characterSize : 0;
+    if (distanceFieldSize != m_distanceFieldSize)
+    {
+        if (distanceFieldSize && !Shader::isAvailable())
+        {
+            err() << "Failed to load font atlas from memory (distance field atlases require shaders)" << std::endl;
+            return false;
+        }
+
+        m_distanceFieldSize = distanceFieldSize;
+        m_pages.clear();
+        m_lastPage = NULL;
+        delete m_rasterizer;
+        m_rasterizer = NULL;
+    }
+    m_distanceFieldGlyphs.clear();
+
+    // Replace the page (it can't be rasterized again if the contexts are lost, so it keeps a copy)
+    Page& page = getPage(distanceFieldSize ? 0 : characterSize);
+    Image image;
+    image.create(width, height, &pixels[0]);
+    page.texture.setRestorable(true);
+    if (!page.texture.loadFromImage(image))
+        return false;
+
+    page.glyphs.swap(glyphs);
+    page.rows.swap(rows);
+    page.nextRow = nextRow;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Font& Font::operator =(const Font& right)
+{
+    Font temp(right);
+
+    swap(temp);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::swap(Font& right)
+{
+    std::swap(m_library,             right.m_library);
+    std::swap(m_face,                right.m_face);
+    std::swap(m_streamRec,           right.m_streamRec);
+    std::swap(m_mapping,             right.m_mapping);
+    std::swap(m_refCount,            right.m_refCount);
+    std::swap(m_info,                right.m_info);
+    std::swap(m_pages,               right.m_pages);
+    std::swap(m_lastPage,            right.m_lastPage);
+    std::swap(m_lastPageSize,        right.m_lastPageSize);
+    std::swap(m_pixelBuffer,         right.m_pixelBuffer);
+    std::swap(m_distanceFieldSize,   right.m_distanceFieldSize);
+    std::swap(m_distanceFieldGlyphs, right.m_distanceFieldGlyphs);
+    std::swap(m_kerning,             right.m_kerning);
+    std::swap(m_sourceFile,          right.m_sourceFile);
+    std::swap(m_sourceData,          right.m_sourceData);
+    std::swap(m_sourceSize,          right.m_sourceSize);
+    std::swap(m_asyncGlyphLoading,   right.m_asyncGlyphLoading);
+    std::swap(m_rasterizer,          right.m_rasterizer);
+    std::swap(m_glyphRevision,       right.m_glyphRevision);
+    std::swap(m_cacheBudget,         right.m_cacheBudget);
+    std::swap(m_cacheClock,          right.m_cacheClock);
+    std::swap(m_cacheStatistics,     right.m_cacheStatistics);
+    std::swap(m_compactionClock,     right.m_compactionClock);
+    std::swap(m_lastTextureSize,     right.m_lastTextureSize);
+    std::swap(m_contextGeneration,   right.m_contextGeneration);
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::setCacheBudget(std::size_t bytes)
+{
+    m_cacheBudget = bytes;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Font::getCacheBudget() const
+{
+    return m_cacheBudget;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::clearCache(unsigned int characterSize)
+{
+    if (m_distanceFieldSize)
+    {
+        m_distanceFieldGlyphs.erase(characterSize);
+    }
+    else
+    {
+        PageTable::iterator page = m_pages.find(characterSize);
+        if (page == m_pages.end())
+            return;
+
+        if (m_lastPage == &page->second)
+            m_lastPage = NULL;
+        m_pages.erase(page);
+    }
+
+    ++m_glyphRevision;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::clearCache()
+{
+    m_pages.clear();
+    m_lastPage = NULL;
+    m_distanceFieldGlyphs.clear();
+
+    ++m_glyphRevision;
+}
+
+
+////////////////////////////////////////////////////////////
+Font::CacheStatistics Font::getCacheStatistics() const
+{
+    CacheStatistics statistics = m_cacheStatistics;
+    statistics.residentBytes = getResidentBytes();
+
+    return statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::cleanup()
+{
+    // Stop the background rasterizer
+    delete m_rasterizer;
+    m_rasterizer = NULL;
+
+    // Check if we must destroy the FreeType pointers
+    if (m_refCount)
+    {
+        // Decrease the reference counter
+        (*m_refCount)--;
+
+        // Free the resources only if we are the last owner
+        if (*m_refCount == 0)
+        {
+            // Delete the reference counter
+            delete m_refCount;
 
             // Destroy the font face
             if (m_face)
@@ -450,9 +1593,12 @@ void Font::cleanup()
             if (m_streamRec)
                 delete static_cast<FT_StreamRec*>(m_streamRec);
 
+            // Unmap the font file, if any (must be done after FT_Done_Face too)
+            delete m_mapping;
+
             // Close the library
             if (m_library)
-                FT_Done_FreeType(static_cast<FT_Library>(m_library));
+                FT_Done_Library(static_cast<FT_Library>(m_library));
         }
     }
 
@@ -460,120 +1606,61 @@ void Font::cleanup()
     m_library   = NULL;
     m_face      = NULL;
     m_streamRec = NULL;
+    m_mapping   = NULL;
     m_refCount  = NULL;
     m_pages.clear();
+    m_lastPage = NULL;
     m_pixelBuffer.clear();
+    m_distanceFieldSize = 0;
+    m_distanceFieldGlyphs.clear();
+    m_kerning.clear();
+    m_sourceFile.clear();
+    m_sourceData = NULL;
+    m_sourceSize = 0;
 }
 
 
 ////////////////////////////////////////////////////////////
 Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) const
 {
-    // The glyph to return
-    Glyph glyph;
-
-    // First, transform our ugly void* to a FT_Face
-    FT_Face face = static_cast<FT_Face>(m_face);
-    if (!face)
-        return glyph;
-
-    // Set the character size
-    if (!setCurrentSize(characterSize))
-        return glyph;
-
-    // Load the glyph corresponding to the code point
-    if (FT_Load_Char(face, codePoint, FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT) != 0)
-        return glyph;
-
-    // Retrieve the glyph
-    FT_Glyph glyphDesc;
-    if (FT_Get_Glyph(face->glyph, &glyphDesc) != 0)
-        return glyph;
-
-    // Apply bold if necessary -- first technique using outline (highest quality)
-    FT_Pos weight = 1 << 6;
-    bool outline = (glyphDesc->format == FT_GLYPH_FORMAT_OUTLINE);
-    if (bold && outline)
-    {
-        FT_OutlineGlyph outlineGlyph = (FT_OutlineGlyph)glyphDesc;
-        FT_Outline_Embolden(&outlineGlyph->outline, weight);
-    }
+    SFML_PROFILE_SCOPE("Font::loadGlyph");
 
-    // Convert the glyph to a bitmap (i.e. rasterize it)
-    FT_Glyph_To_Bitmap(&glyphDesc, FT_RENDER_MODE_NORMAL, 0, 1);
-    FT_Bitmap& bitmap = reinterpret_cast<FT_BitmapGlyph>(glyphDesc)->bitmap;
+    // Rasterize the glyph
+    Vector2u size;
+    Glyph glyph = rasterizeGlyph(static_cast<FT_Library>(m_library), static_cast<FT_Face>(m_face), m_distanceFieldSize,
+                                 codePoint, characterSize, bold, m_pixelBuffer, size);
 
-    // Apply bold if necessary -- fallback technique using bitmap (lower quality)
-    if (bold && !outline)
+    if ((size.x > 0) && (size.y > 0))
     {
-        FT_Bitmap_Embolden(static_cast<FT_Library>(m_library), &bitmap, weight, weight);
-    }
-
-    // Compute the glyph's advance offset
-    glyph.advance = static_cast<float>(face->glyph->metrics.horiAdvance) / static_cast<float>(1 << 6);
-    if (bold)
-        glyph.advance += static_cast<float>(weight) / static_cast<float>(1 << 6);
-
-    int width  = bitmap.width;
-    int height = bitmap.rows;
-
-    if ((width > 0) && (height > 0))
-    {
-        // Leave a small padding around characters, so that filtering doesn't
-        // pollute them with pixels from neighbors
-        const unsigned int padding = 1;
-
         // Get the glyphs page corresponding to the character size
-        Page& page = m_pages[characterSize];
+        Page& page = getPage(m_distanceFieldSize ? 0 : characterSize);
 
-        // Find a good position for the new glyph into the texture
-        glyph.textureRect = findGlyphRect(page, width + 2 * padding, height + 2 * padding);
-
-        // Make sure the texture data is positioned in the center
-        // of the allocated texture rectangle
-        glyph.textureRect.left += padding;
-        glyph.textureRect.top += padding;
-        glyph.textureRect.width -= 2 * padding;
-        glyph.textureRect.height -= 2 * padding;
-
-        // Compute the glyph's bounding box
-        glyph.bounds.left   = static_cast<float>(face->glyph->metrics.horiBearingX) / static_cast<float>(1 << 6);
-        glyph.bounds.top    = -static_cast<float>(face->glyph->metrics.horiBearingY) / static_cast<float>(1 << 6);
-        glyph.bounds.width  = static_cast<float>(face->glyph->metrics.width) / static_cast<float>(1 << 6);
-        glyph.bounds.height = static_cast<float>(face->glyph->metrics.height) / static_cast<float>(1 << 6);
-
-        // Extract the glyph's pixels from the bitmap
-        m_pixelBuffer.resize(width * height * 4, 255);
-        const Uint8* pixels = bitmap.buffer;
-        if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
-        {
-            // Pixels are 1 bit monochrome values
-            for (int y = 0; y < height; ++y)
-            {
-                for (int x = 0; x < width; ++x)
-                {
-                    // The color channels remain white, just fill the alpha channel
-                    std::size_t index = (x + y * width) * 4 + 3;
-                    m_pixelBuffer[index] = ((pixels[x / 8]) & (1 << (7 - (x % 8)))) ? 255 : 0;
-                }
-                pixels += bitmap.pitch;
-            }
-        }
-        else
+        // If the cache exceeds its budget even without the other pages, rebuild this one: only
+        // the glyphs requested again will be loaded. This is done at most once per second, so
+        // that a budget too small for the text displayed doesn't rebuild the page constantly.
+        if (m_cacheBudget && !trimCache(page, 0) && (m_compactionClock.getElapsedTime() >= seconds(1)))
         {
-            // Pixels are 8 bits gray levels
-            for (int y = 0; y < height; ++y)
-            {
-                for (int x = 0; x < width; ++x)
-                {
-                    // The color channels remain white, just fill the alpha channel
-                    std::size_t index = (x + y * width) * 4 + 3;
-                    m_pixelBuffer[index] = pixels[x];
-                }
-                pixels += bitmap.pitch;
-            }
+            m_cacheStatistics.evictions += page.glyphs.getSize();
+            ++m_cacheStatistics.compactions;
+            m_compactionClock.restart();
+
+            Page empty;
+            page.glyphs.swap(empty.glyphs);
+            page.texture.swap(empty.texture);
+            page.rows.swap(empty.rows);
+            page.nextRow = empty.nextRow;
+
+            // The scaled copies refer to the old base glyphs; the tables are kept
+            // since getGlyph may hold a reference to one of them
+            for (GlyphSizeTable::iterator it = m_distanceFieldGlyphs.begin(); it != m_distanceFieldGlyphs.end(); ++it)
+                GlyphTable().swap(it->second);
+
+            ++m_glyphRevision;
         }
 
+        // Find a good position for the new glyph into the texture
+        glyph.textureRect = allocateGlyphRect(page, size);
+
         // Write the pixels to the texture
         unsigned int x = glyph.textureRect.left;
         unsigned int y = glyph.textureRect.top;
@@ -582,9 +1669,6 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) c
         page.texture.update(&m_pixelBuffer[0], w, h, x, y);
     }
 
-    // Delete the FT glyph
-    FT_Done_Glyph(glyphDesc);
-
     // Force an OpenGL flush, so that the font's texture will appear updated
     // in all contexts immediately (solves problems in multi-threaded apps)
     glCheck(glFlush());
@@ -594,6 +1678,26 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold) c
 }
 
 
+////////////////////////////////////////////////////////////
+IntRect Font::allocateGlyphRect(Page& page, const Vector2u& size) const
+{
+    // Leave a small padding around characters, so that filtering doesn't
+    // pollute them with pixels from neighbors
+    const unsigned int padding = 1;
+
+    IntRect rect = findGlyphRect(page, size.x + 2 * padding, size.y + 2 * padding);
+
+    // Make sure the texture data is positioned in the center
+    // of the allocated texture rectangle
+    rect.left += padding;
+    rect.top += padding;
+    rect.width -= 2 * padding;
+    rect.height -= 2 * padding;
+
+    return rect;
+}
+
+
 ////////////////////////////////////////////////////////////
 IntRect Font::findGlyphRect(Page& page, unsigned int width, unsigned int height) const
 {
@@ -632,11 +1736,16 @@ IntRect Font::findGlyphRect(Page& page, unsigned int width, unsigned int height)
             unsigned int textureHeight = page.texture.getSize().y;
             if ((textureWidth * 2 <= Texture::getMaximumSize()) && (textureHeight * 2 <= Texture::getMaximumSize()))
             {
-                // Make the texture 2 times bigger
-                Image newImage;
-                newImage.create(textureWidth * 2, textureHeight * 2, Color(255, 255, 255, 0));
-                newImage.copy(page.texture.copyToImage(), 0, 0);
-                page.texture.loadFromImage(newImage);
+                // Make room for the bigger texture by evicting other pages
+                if (m_cacheBudget)
+                    trimCache(page, textureWidth * textureHeight * 4 * 3);
+
+                // Make the texture 2 times bigger, on the graphics card when possible
+                if (!page.texture.resize(textureWidth * 2, textureHeight * 2, Color(255, 255, 255, 0)))
+                {
+                    err() << "Failed to add a new character to the font: the texture could not be resized" << std::endl;
+                    return IntRect(0, 0, 2, 2);
+                }
             }
             else
             {
@@ -665,42 +1774,339 @@ IntRect Font::findGlyphRect(Page& page, unsigned int width, unsigned int height)
 ////////////////////////////////////////////////////////////
 bool Font::setCurrentSize(unsigned int characterSize) const
 {
-    // FT_Set_Pixel_Sizes is an expensive function, so we must call it
-    // only when necessary to avoid killing performances
+    return setFaceSize(static_cast<FT_Face>(m_face), characterSize);
+}
 
-    FT_Face face = static_cast<FT_Face>(m_face);
-    FT_UShort currentSize = face->size->metrics.x_ppem;
 
-    if (currentSize != characterSize)
+////////////////////////////////////////////////////////////
+Font::Page& Font::getPage(unsigned int characterSize) const
+{
+    // Consecutive glyphs almost always belong to the same page: avoid searching it again
+    if (!m_lastPage || (m_lastPageSize != characterSize))
     {
-        FT_Error result = FT_Set_Pixel_Sizes(face, 0, characterSize);
+        PageTable::iterator it = m_pages.find(characterSize);
+        bool created = (it == m_pages.end());
+        if (created)
+        {
+            // The texture of the inserted copy is accounted as a regular texture until now
+            it = m_pages.insert(std::make_pair(characterSize, Page())).first;
+            it->second.texture.setAccountingCategory(ResourceMemory::Fonts);
+        }
+
+        m_lastPage = &it->second;
+        m_lastPageSize = characterSize;
+
+        if (created && m_cacheBudget)
+            trimCache(it->second, 0);
+    }
+
+    m_lastPage->lastUse = ++m_cacheClock;
+
+    return *m_lastPage;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::discardLostPages() const
+{
+    if (m_contextGeneration == Context::getGeneration())
+        return;
+
+    m_contextGeneration = Context::getGeneration();
 
-        if (result == FT_Err_Invalid_Pixel_Size)
+    // Glyphs are rasterized again as they are requested, so what is drawn first comes back first
+    PageTable::iterator page = m_pages.begin();
+    while (page != m_pages.end())
+    {
+        if (page->second.texture.isRestorable())
+            ++page;
+        else
+            m_pages.erase(page++);
+    }
+
+    m_lastPage = NULL;
+    m_distanceFieldGlyphs.clear();
+    ++m_glyphRevision;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::trimCache(const Page& keep, std::size_t extraBytes) const
+{
+    std::size_t resident = getResidentBytes() + extraBytes;
+
+    while (resident > m_cacheBudget)
+    {
+        // Find the least recently used page, the one being filled and the one being drawn excluded
+        PageTable::iterator victim = m_pages.end();
+        for (PageTable::iterator it = m_pages.begin(); it != m_pages.end(); ++it)
         {
-            // In the case of bitmap fonts, resizing can
-            // fail if the requested size is not available
-            if (!FT_IS_SCALABLE(face))
-            {
-                err() << "Failed to set bitmap font size to " << characterSize << std::endl;
-                err() << "Available sizes are: ";
-                for (int i = 0; i < face->num_fixed_sizes; ++i)
-                    err() << face->available_sizes[i].height << " ";
-                err() << std::endl;
-            }
+            if ((&it->second != &keep) && (it->first != m_lastTextureSize) &&
+                ((victim == m_pages.end()) || (it->second.lastUse < victim->second.lastUse)))
+                victim = it;
         }
 
-        return result == FT_Err_Ok;
+        if (victim == m_pages.end())
+            return false;
+
+        Vector2u size = victim->second.texture.getSize();
+        resident -= std::min<std::size_t>(resident, size.x * size.y * 4);
+        m_cacheStatistics.evictions += victim->second.glyphs.getSize();
+
+        if (m_lastPage == &victim->second)
+            m_lastPage = NULL;
+        m_pages.erase(victim);
+
+        // The text using the evicted glyphs must rebuild its geometry
+        ++m_glyphRevision;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Font::getResidentBytes() const
+{
+    std::size_t bytes = 0;
+    for (PageTable::const_iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+    {
+        Vector2u size = it->second.texture.getSize();
+        bytes += size.x * size.y * 4;
+    }
+
+    return bytes;
+}
+
+
+////////////////////////////////////////////////////////////
+priv::GlyphRasterizer* Font::getRasterizer() const
+{
+    // Fonts loaded from a stream can't be opened a second time
+    if (!m_rasterizer && m_asyncGlyphLoading && m_face && (m_sourceData || !m_sourceFile.empty()))
+    {
+        m_rasterizer = priv::GlyphRasterizer::create(m_sourceFile, m_sourceData, m_sourceSize, m_distanceFieldSize);
+
+        // Don't try again if the face couldn't be opened
+        if (!m_rasterizer)
+            m_asyncGlyphLoading = false;
+    }
+
+    return m_rasterizer;
+}
+
+
+////////////////////////////////////////////////////////////
+const Glyph& Font::requestGlyph(priv::GlyphRasterizer& rasterizer, Uint32 codePoint, unsigned int characterSize, bool bold) const
+{
+    Uint32 key = ((bold ? 1 : 0) << 31) | codePoint;
+
+    // Queue the glyph only once
+    priv::GlyphRasterizer::GlyphId id(m_distanceFieldSize ? m_distanceFieldSize : characterSize, key);
+    if (rasterizer.pending.insert(id).second)
+        rasterizer.request(id);
+
+    // Create the placeholder: an empty glyph, with an advance that doesn't require loading the glyph
+    std::pair<std::map<priv::GlyphRasterizer::GlyphId, Glyph>::iterator, bool> placeholder =
+        rasterizer.placeholders.insert(std::make_pair(priv::GlyphRasterizer::GlyphId(characterSize, key), Glyph()));
+    if (placeholder.second && setCurrentSize(characterSize))
+    {
+        FT_Face face = static_cast<FT_Face>(m_face);
+        FT_Fixed advance;
+        if (FT_Get_Advance(face, FT_Get_Char_Index(face, codePoint), FT_LOAD_TARGET_NORMAL | FT_LOAD_NO_HINTING, &advance) == 0)
+            placeholder.first->second.advance = static_cast<float>(advance) / static_cast<float>(1 << 16) + (bold ? 1.f : 0.f);
+    }
+
+    return placeholder.first->second;
+}
+
+
+////////////////////////////////////////////////////////////
+Font::GlyphTable::GlyphTable() :
+m_entries(),
+m_direct (directGlyphCount * 2, 0),
+m_slots  ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+const Glyph* Font::GlyphTable::find(Uint32 key) const
+{
+    // Latin-1 characters: direct access
+    Uint32 codePoint = key & 0x7FFFFFFF;
+    if (codePoint < directGlyphCount)
+    {
+        Uint32 index = m_direct[codePoint + (key >> 31) * directGlyphCount];
+        return index ? &m_entries[index - 1].second : NULL;
+    }
+
+    // Other characters: linear probing until the key or an empty slot is found
+    if (m_slots.empty())
+        return NULL;
+
+    std::size_t mask = m_slots.size() - 1;
+    for (std::size_t slot = hashGlyphKey(key) & mask; m_slots[slot].second; slot = (slot + 1) & mask)
+    {
+        if (m_slots[slot].first == key)
+            return &m_entries[m_slots[slot].second - 1].second;
+    }
+
+    return NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+const Glyph& Font::GlyphTable::insert(Uint32 key, const Glyph& glyph)
+{
+    m_entries.push_back(std::make_pair(key, glyph));
+    Uint32 index = static_cast<Uint32>(m_entries.size());
+
+    // Latin-1 characters: direct access
+    Uint32 codePoint = key & 0x7FFFFFFF;
+    if (codePoint < directGlyphCount)
+    {
+        m_direct[codePoint + (key >> 31) * directGlyphCount] = index;
+        return m_entries.back().second;
+    }
+
+    // Other characters: keep the load factor of the hash table below one half
+    if (2 * m_entries.size() > m_slots.size())
+    {
+        rehash(std::max<std::size_t>(64, m_slots.size() * 2));
     }
     else
     {
-        return true;
+        std::size_t mask = m_slots.size() - 1;
+        std::size_t slot = hashGlyphKey(key) & mask;
+        while (m_slots[slot].second)
+            slot = (slot + 1) & mask;
+        m_slots[slot] = Slot(key, index);
+    }
+
+    return m_entries.back().second;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Font::GlyphTable::getSize() const
+{
+    return m_entries.size();
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 Font::GlyphTable::getKey(std::size_t index) const
+{
+    return m_entries[index].first;
+}
+
+
+////////////////////////////////////////////////////////////
+const Glyph& Font::GlyphTable::getGlyph(std::size_t index) const
+{
+    return m_entries[index].second;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::GlyphTable::swap(GlyphTable& other)
+{
+    m_entries.swap(other.m_entries);
+    m_direct.swap(other.m_direct);
+    m_slots.swap(other.m_slots);
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::GlyphTable::rehash(std::size_t slotCount)
+{
+    std::vector<Slot> slots(slotCount, Slot(0, 0));
+    std::size_t mask = slotCount - 1;
+
+    for (std::size_t i = 0; i < m_entries.size(); ++i)
+    {
+        Uint32 key = m_entries[i].first;
+        if ((key & 0x7FFFFFFF) < directGlyphCount)
+            continue;
+
+        std::size_t slot = hashGlyphKey(key) & mask;
+        while (slots[slot].second)
+            slot = (slot + 1) & mask;
+        slots[slot] = Slot(key, static_cast<Uint32>(i + 1));
+    }
+
+    m_slots.swap(slots);
+}
+
+
+////////////////////////////////////////////////////////////
+Font::KerningTable::KerningTable() :
+m_slots(),
+m_size (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+const float* Font::KerningTable::find(Uint64 key) const
+{
+    if (m_slots.empty())
+        return NULL;
+
+    // Linear probing until the key or an empty slot is found
+    std::size_t mask = m_slots.size() - 1;
+    for (std::size_t slot = hashKerningKey(key) & mask; m_slots[slot].first; slot = (slot + 1) & mask)
+    {
+        if (m_slots[slot].first == key)
+            return &m_slots[slot].second;
     }
+
+    return NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::KerningTable::insert(Uint64 key, float kerning)
+{
+    // Keep the load factor of the hash table below one half
+    if (2 * (m_size + 1) > m_slots.size())
+        rehash(std::max<std::size_t>(64, m_slots.size() * 2));
+
+    std::size_t mask = m_slots.size() - 1;
+    std::size_t slot = hashKerningKey(key) & mask;
+    while (m_slots[slot].first)
+        slot = (slot + 1) & mask;
+    m_slots[slot] = Slot(key, kerning);
+    ++m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::KerningTable::rehash(std::size_t slotCount)
+{
+    std::vector<Slot> slots(slotCount, Slot(0, 0.f));
+    std::size_t mask = slotCount - 1;
+
+    for (std::size_t i = 0; i < m_slots.size(); ++i)
+    {
+        if (!m_slots[i].first)
+            continue;
+
+        std::size_t slot = hashKerningKey(m_slots[i].first) & mask;
+        while (slots[slot].first)
+            slot = (slot + 1) & mask;
+        slots[slot] = m_slots[i];
+    }
+
+    m_slots.swap(slots);
 }
 
 
 ////////////////////////////////////////////////////////////
 Font::Page::Page() :
-nextRow(3)
+nextRow(3),
+lastUse(0)
 {
     // Make sure that the texture is initialized by default
     sf::Image image;
@@ -712,6 +2118,7 @@ nextRow(3)
             image.setPixel(x, y, Color(255, 255, 255, 255));
 
     // Create the texture
+    texture.setAccountingCategory(ResourceMemory::Fonts);
     texture.loadFromImage(image);
     texture.setSmooth(true);
 }
@@ -0,0 +1,65 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/FrameEncoder.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/ImageKernels.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+void FrameEncoder::close()
+{
+    // Nothing to do by default
+}
+
+
+////////////////////////////////////////////////////////////
+void FrameEncoder::convertToYuv420(const Image& frame, std::vector<Uint8>& planes)
+{
+    // The conversion reads RGBA pixels
+    if (frame.getFormat() != PixelFormat::RGBA8)
+    {
+        Image rgba(frame);
+        rgba.convert(PixelFormat::RGBA8);
+        convertToYuv420(rgba, planes);
+        return;
+    }
+
+    Vector2u size = frame.getSize();
+    std::size_t lumaSize = static_cast<std::size_t>(size.x) * size.y;
+    std::size_t chromaSize = static_cast<std::size_t>((size.x + 1) / 2) * ((size.y + 1) / 2);
+
+    planes.resize(lumaSize + 2 * chromaSize);
+    if (planes.empty())
+        return;
+
+    priv::convertToYuv420(frame.getPixelsPtr(), size.x, size.y,
+                          &planes[0], &planes[lumaSize], &planes[lumaSize + chromaSize]);
+}
+
+} // namespace sf
@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/FrameEncoderQoi.hpp>
+#include <SFML/Graphics/ImageCodecQoi.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool FrameEncoderQoi::check(const std::string& filename)
+{
+    std::string extension = filename.substr(filename.find_last_of(".") + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+    return extension == "qoi";
+}
+
+
+////////////////////////////////////////////////////////////
+FrameEncoderQoi::FrameEncoderQoi() :
+m_prefix    (),
+m_frameIndex(0),
+m_pixels    (),
+m_data      ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool FrameEncoderQoi::open(const std::string& filename, const Vector2u& size, unsigned int frameRate)
+{
+    // Each frame is a standalone image, the size and the rate are not stored anywhere
+    (void)size;
+    (void)frameRate;
+
+    m_prefix = filename.substr(0, filename.find_last_of("."));
+    m_frameIndex = 0;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool FrameEncoderQoi::write(const Image& frame)
+{
+    // QOI files store RGBA pixels
+    if (frame.getFormat() != PixelFormat::RGBA8)
+    {
+        Image rgba(frame);
+        rgba.convert(PixelFormat::RGBA8);
+        return write(rgba);
+    }
+
+    Vector2u size = frame.getSize();
+    const Uint8* pixels = frame.getPixelsPtr();
+    m_pixels.assign(pixels, pixels + static_cast<std::size_t>(size.x) * size.y * 4);
+    encodeQoi(m_pixels, size, m_data);
+
+    char suffix[32];
+    std::sprintf(suffix, "_%06u.qoi", m_frameIndex++);
+    std::string filename = m_prefix + suffix;
+
+    FILE* file = std::fopen(filename.c_str(), "wb");
+    if (!file)
+    {
+        err() << "Failed to write QOI frame \"" << filename << "\"" << std::endl;
+        return false;
+    }
+
+    bool written = std::fwrite(&m_data[0], 1, m_data.size(), file) == m_data.size();
+    return (std::fclose(file) == 0) && written;
+}
+
+
+////////////////////////////////////////////////////////////
+void FrameEncoderQoi::close()
+{
+    m_frameIndex = 0;
+}
+
+} // namespace priv
+
+} // namespace sf
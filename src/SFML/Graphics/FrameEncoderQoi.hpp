@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef SFML_FRAMEENCODERQOI_HPP
+#define SFML_FRAMEENCODERQOI_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/FrameEncoder.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Frame encoder that writes sequences of QOI images (.qoi)
+///
+/// The frames of "video.qoi" are written to "video_000000.qoi",
+/// "video_000001.qoi", etc.
+///
+////////////////////////////////////////////////////////////
+class FrameEncoderQoi : public FrameEncoder
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check if this encoder can handle a file
+    ///
+    /// \param filename Path of the video to check
+    ///
+    /// \return True if the video can be written by this encoder
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool check(const std::string& filename);
+
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    FrameEncoderQoi();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open a video for writing
+    ///
+    /// \param filename  Path of the video to write
+    /// \param size      Size of the frames, in pixels
+    /// \param frameRate Number of frames per second
+    ///
+    /// \return True if the video was successfully opened
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool open(const std::string& filename, const Vector2u& size, unsigned int frameRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Encode a frame
+    ///
+    /// \param frame RGBA pixels of the frame, top row first
+    ///
+    /// \return True if the frame was written
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool write(const Image& frame);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Finish writing the video
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void close();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::string        m_prefix;     ///< Path of the images, without the index and the extension
+    unsigned int       m_frameIndex; ///< Index of the next image
+    std::vector<Uint8> m_pixels;     ///< Pixels of the current frame
+    std::vector<Uint8> m_data;       ///< Encoded image
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_FRAMEENCODERQOI_HPP
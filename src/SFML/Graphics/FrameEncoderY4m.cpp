@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/FrameEncoderY4m.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cctype>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool FrameEncoderY4m::check(const std::string& filename)
+{
+    std::string extension = filename.substr(filename.find_last_of(".") + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+    return extension == "y4m";
+}
+
+
+////////////////////////////////////////////////////////////
+bool FrameEncoderY4m::open(const std::string& filename, const Vector2u& size, unsigned int frameRate)
+{
+    m_file.open(filename.c_str(), std::ios_base::binary);
+    if (!m_file)
+    {
+        err() << "Failed to open Y4M video \"" << filename << "\" for writing" << std::endl;
+        return false;
+    }
+
+    // Progressive frames, square pixels, chroma sited at the center of each 2x2 block
+    m_file << "YUV4MPEG2 W" << size.x << " H" << size.y << " F" << frameRate << ":1 Ip A1:1 C420jpeg\n";
+
+    return m_file.good();
+}
+
+
+////////////////////////////////////////////////////////////
+bool FrameEncoderY4m::write(const Image& frame)
+{
+    convertToYuv420(frame, m_planes);
+
+    m_file << "FRAME\n";
+    if (!m_planes.empty())
+        m_file.write(reinterpret_cast<const char*>(&m_planes[0]), static_cast<std::streamsize>(m_planes.size()));
+
+    return m_file.good();
+}
+
+
+////////////////////////////////////////////////////////////
+void FrameEncoderY4m::close()
+{
+    m_file.close();
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,328 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/FrameRecorder.hpp>
+#include <SFML/Graphics/FrameEncoderQoi.hpp>
+#include <SFML/Graphics/FrameEncoderY4m.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+FrameRecorder::FrameRecorder() :
+m_nextReadback     (0),
+m_thread           (&FrameRecorder::encode, this),
+m_mutex            (),
+m_condition        (),
+m_queue            (),
+m_freeImages       (),
+m_maxQueuedFrames  (8),
+m_encoder          (NULL),
+m_ownsEncoder      (false),
+m_filename         (),
+m_frameRate        (60),
+m_size             (0, 0),
+m_recording        (false),
+m_stopping         (false),
+m_frameCount       (0),
+m_droppedFrameCount(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+FrameRecorder::~FrameRecorder()
+{
+    stop();
+
+    for (std::vector<Image*>::iterator it = m_freeImages.begin(); it != m_freeImages.end(); ++it)
+        delete *it;
+}
+
+
+////////////////////////////////////////////////////////////
+bool FrameRecorder::start(const std::string& filename, unsigned int frameRate)
+{
+    stop();
+
+    FrameEncoder* encoder = NULL;
+    if (priv::FrameEncoderY4m::check(filename))
+        encoder = new priv::FrameEncoderY4m;
+    else if (priv::FrameEncoderQoi::check(filename))
+        encoder = new priv::FrameEncoderQoi;
+
+    if (!encoder)
+    {
+        err() << "Failed to start recording to \"" << filename << "\" (unsupported video format)" << std::endl;
+        return false;
+    }
+
+    m_ownsEncoder = true;
+    launch(encoder, filename, frameRate);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool FrameRecorder::start(FrameEncoder& encoder, const std::string& filename, unsigned int frameRate)
+{
+    stop();
+
+    m_ownsEncoder = false;
+    launch(&encoder, filename, frameRate);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool FrameRecorder::capture(RenderWindow& window)
+{
+    PixelReadback* readback = prepareCapture();
+    if (!readback || !readback->start(window))
+        return false;
+
+    m_nextReadback = (m_nextReadback + 1) % ReadbackCount;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool FrameRecorder::capture(RenderTexture& renderTexture)
+{
+    PixelReadback* readback = prepareCapture();
+    if (!readback || !readback->start(renderTexture))
+        return false;
+
+    m_nextReadback = (m_nextReadback + 1) % ReadbackCount;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void FrameRecorder::stop()
+{
+    if (!m_recording)
+        return;
+
+    // Retrieve the frames still in flight, oldest first
+    for (std::size_t i = 0; i < ReadbackCount; ++i)
+    {
+        PixelReadback& readback = m_readbacks[(m_nextReadback + i) % ReadbackCount];
+        if (readback.isPending())
+            retrieve(readback);
+    }
+    m_nextReadback = 0;
+
+    // Let the encoding thread empty the queue, then finish
+    {
+        Lock lock(m_mutex);
+        m_stopping = true;
+        m_condition.notifyAll();
+    }
+    m_thread.wait();
+
+    if (m_ownsEncoder)
+        delete m_encoder;
+    m_encoder = NULL;
+    m_recording = false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool FrameRecorder::isRecording() const
+{
+    return m_recording;
+}
+
+
+////////////////////////////////////////////////////////////
+void FrameRecorder::setMaxQueuedFrames(std::size_t count)
+{
+    Lock lock(m_mutex);
+    m_maxQueuedFrames = std::max<std::size_t>(count, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 FrameRecorder::getFrameCount() const
+{
+    Lock lock(m_mutex);
+    return m_frameCount;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 FrameRecorder::getDroppedFrameCount() const
+{
+    Lock lock(m_mutex);
+    return m_droppedFrameCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void FrameRecorder::launch(FrameEncoder* encoder, const std::string& filename, unsigned int frameRate)
+{
+    m_encoder = encoder;
+    m_filename = filename;
+    m_frameRate = frameRate;
+    m_size = Vector2u(0, 0);
+    m_recording = true;
+    m_stopping = false;
+    m_frameCount = 0;
+    m_droppedFrameCount = 0;
+
+    m_thread.launch();
+}
+
+
+////////////////////////////////////////////////////////////
+PixelReadback* FrameRecorder::prepareCapture()
+{
+    if (!m_recording)
+        return NULL;
+
+    // The next readback is the oldest one: if it is still pending, the
+    // graphics card is done with it unless it is several frames late
+    PixelReadback& readback = m_readbacks[m_nextReadback];
+    if (readback.isPending())
+        retrieve(readback);
+
+    std::size_t inFlight = 0;
+    for (std::size_t i = 0; i < ReadbackCount; ++i)
+    {
+        if (m_readbacks[i].isPending())
+            ++inFlight;
+    }
+
+    // Drop the frame rather than letting the queue grow when the encoder can't keep up
+    Lock lock(m_mutex);
+    if (m_queue.size() + inFlight >= m_maxQueuedFrames)
+    {
+        ++m_droppedFrameCount;
+        return NULL;
+    }
+
+    return &readback;
+}
+
+
+////////////////////////////////////////////////////////////
+void FrameRecorder::retrieve(PixelReadback& readback)
+{
+    Image* image = NULL;
+    {
+        Lock lock(m_mutex);
+        if (!m_freeImages.empty())
+        {
+            image = m_freeImages.back();
+            m_freeImages.pop_back();
+        }
+    }
+
+    if (!image)
+        image = new Image;
+
+    bool valid = readback.getImage(*image);
+
+    // The first frame defines the size of the video
+    if (valid && (m_size == Vector2u(0, 0)))
+        m_size = image->getSize();
+
+    if (valid && (image->getSize() != m_size))
+    {
+        err() << "Frame dropped by the recorder, its size differs from the size of the video" << std::endl;
+        valid = false;
+    }
+
+    Lock lock(m_mutex);
+    if (valid)
+    {
+        m_queue.push_back(image);
+        m_condition.notifyOne();
+    }
+    else
+    {
+        m_freeImages.push_back(image);
+        ++m_droppedFrameCount;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void FrameRecorder::encode()
+{
+    bool opened = false;
+    bool failed = false;
+
+    for (;;)
+    {
+        Image* image = NULL;
+        {
+            Lock lock(m_mutex);
+            while (m_queue.empty() && !m_stopping)
+                m_condition.wait(m_mutex);
+
+            if (m_queue.empty())
+                break;
+
+            image = m_queue.front();
+            m_queue.pop_front();
+        }
+
+        // The encoder is opened with the first frame, whose size is the size of the video
+        bool written = false;
+        if (!failed)
+        {
+            if (!opened)
+            {
+                opened = m_encoder->open(m_filename, image->getSize(), m_frameRate);
+                failed = !opened;
+            }
+
+            written = opened && m_encoder->write(*image);
+        }
+
+        Lock lock(m_mutex);
+        m_freeImages.push_back(image);
+        if (written)
+            ++m_frameCount;
+        else
+            ++m_droppedFrameCount;
+    }
+
+    if (opened)
+        m_encoder->close();
+}
+
+} // namespace sf
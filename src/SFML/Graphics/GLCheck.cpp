@@ -26,22 +26,235 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/ThreadLocalPtr.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <map>
+#include <vector>
+
+
+namespace
+{
+    // Location of the OpenGL call being made by a thread, and how the errors of its context are checked
+    struct CallSite
+    {
+        const char* file;        // Source file of the call, NULL outside of glCheck
+        unsigned int line;       // Line of the call
+        sf::Uint64   context;    // Context whose checking mode is known
+        bool         callback;   // Does the context report its errors to debugCallback?
+    };
+
+    // This per-thread variable holds the call site of each thread
+    sf::ThreadLocalPtr<CallSite> threadCallSite(NULL);
+
+    // Call sites of all the threads, destroyed at exit
+    struct CallSiteList
+    {
+        ~CallSiteList()
+        {
+            for (std::vector<CallSite*>::iterator it = sites.begin(); it != sites.end(); ++it)
+                delete *it;
+
+            destroyed = true;
+        }
+
+        std::vector<CallSite*> sites;
+        static bool            destroyed;
+    };
+
+    bool CallSiteList::destroyed = false;
+    CallSiteList callSiteList;
+    sf::Mutex callSiteListMutex;
+
+    // Used by the OpenGL calls made after the call sites were destroyed (global resources)
+    CallSite exitCallSite = {NULL, 0, 0, false};
+
+    // Get the call site of the calling thread
+    CallSite& getCallSite()
+    {
+        if (CallSiteList::destroyed)
+            return exitCallSite;
+
+        CallSite* site = threadCallSite;
+        if (!site)
+        {
+            site = new CallSite;
+            site->file = NULL;
+            site->line = 0;
+            site->context = 0;
+            site->callback = false;
+
+            sf::Lock lock(callSiteListMutex);
+            callSiteList.sites.push_back(site);
+            threadCallSite = site;
+        }
+
+        return *site;
+    }
+
+    // Kind of error at a given location
+    struct ErrorKey
+    {
+        std::string  file;
+        unsigned int line;
+        unsigned int code; // glGetError code, or identifier of the debug message
+
+        bool operator <(const ErrorKey& other) const
+        {
+            if (line != other.line)
+                return line < other.line;
+            if (code != other.code)
+                return code < other.code;
+            return file < other.file;
+        }
+    };
+
+    // Number of errors of each kind reported so far
+    std::map<ErrorKey, sf::Uint64> errorCounts;
+    sf::Mutex errorCountsMutex;
+
+    // Log an error: the first one of each kind is logged, then only when their count reaches a power of 10
+    void reportError(const char* file, unsigned int line, unsigned int code, const std::string& description)
+    {
+        std::string fileString(file ? file : "");
+        ErrorKey key = {fileString, line, code};
+
+        sf::Uint64 count;
+        {
+            sf::Lock lock(errorCountsMutex);
+            count = ++errorCounts[key];
+        }
+
+        sf::Uint64 power = 1;
+        while (power < count)
+            power *= 10;
+        if (power != count)
+            return;
+
+        if (file)
+        {
+            sf::err() << "An internal OpenGL call failed in "
+                      << fileString.substr(fileString.find_last_of("\\/") + 1) << " (" << line << ") : "
+                      << description;
+        }
+        else
+        {
+            sf::err() << "An OpenGL call made outside of SFML failed: " << description;
+        }
+
+        if (count > 1)
+            sf::err() << " (" << count << " times)";
+
+        sf::err() << std::endl;
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    // Identifies the callback installed by SFML, through its user parameter
+    const int callbackTag = 0;
+
+    // Receive the errors of the debug output (synchronous: called by the thread that made the failing call)
+    void APIENTRY debugCallback(GLenum, GLenum type, GLuint id, GLenum, GLsizei, const GLchar* message, const void*)
+    {
+        if (type != GLEXT_GL_DEBUG_TYPE_ERROR)
+            return;
+
+        CallSite& site = getCallSite();
+        reportError(site.file, site.line, id, message);
+    }
+
+#endif
+
+    // Install the debug output callback in the active context; returns false if glGetError must be polled instead
+    bool enableDebugOutput()
+    {
+    #if defined(SFML_OPENGL_ES) || defined(SFML_GL_CHECK_POLLING)
+
+        return false;
+
+    #else
+
+        // These calls are not checked, they would come back here
+        sf::priv::ensureExtensionsInit();
+        if (!GLEXT_debug_output)
+            return false;
+
+        // Only debug contexts are required to report their errors
+        GLint flags = 0;
+        glGetIntegerv(GLEXT_GL_CONTEXT_FLAGS, &flags);
+        if (!(flags & GLEXT_GL_CONTEXT_FLAG_DEBUG_BIT))
+            return false;
+
+        // Don't replace the callback of the application, if it has one
+        GLvoid* userParam = NULL;
+        glGetPointerv(GLEXT_GL_DEBUG_CALLBACK_USER_PARAM, &userParam);
+        GLvoid* callback = NULL;
+        glGetPointerv(GLEXT_GL_DEBUG_CALLBACK_FUNCTION, &callback);
+        if (callback && (userParam != &callbackTag))
+            return false;
+
+        // Only the errors are reported, the other messages of the driver are too verbose for the log
+        GLEXT_glDebugMessageControl(GLEXT_GL_DONT_CARE, GLEXT_GL_DONT_CARE, GLEXT_GL_DONT_CARE, 0, NULL, GL_FALSE);
+        GLEXT_glDebugMessageControl(GLEXT_GL_DONT_CARE, GLEXT_GL_DEBUG_TYPE_ERROR, GLEXT_GL_DONT_CARE, 0, NULL, GL_TRUE);
+        GLEXT_glDebugMessageCallback(debugCallback, &callbackTag);
+        glEnable(GLEXT_GL_DEBUG_OUTPUT);
+        glEnable(GLEXT_GL_DEBUG_OUTPUT_SYNCHRONOUS);
+
+        return true;
+
+    #endif
+    }
+
+    // Get the call site of the calling thread, knowing how the errors of the active context are checked
+    CallSite& getContextCallSite()
+    {
+        CallSite& site = getCallSite();
+
+        sf::Uint64 context = sf::Context::getActiveContextId();
+        if (site.context != context)
+        {
+            site.context = context;
+            site.callback = (context != 0) && enableDebugOutput();
+        }
+
+        return site;
+    }
+}
 
 
 namespace sf
 {
 namespace priv
 {
+////////////////////////////////////////////////////////////
+void glCheckBegin(const char* file, unsigned int line)
+{
+    CallSite& site = getContextCallSite();
+    site.file = file;
+    site.line = line;
+}
+
+
 ////////////////////////////////////////////////////////////
 void glCheckError(const char* file, unsigned int line)
 {
+    countGlCall();
+
+    // The errors reported from now on don't come from SFML
+    CallSite& site = getCallSite();
+    site.file = NULL;
+
+    // The driver already reported the errors of the call, if any
+    if (site.callback)
+        return;
+
     // Get the last error
     GLenum errorCode = glGetError();
 
     if (errorCode != GL_NO_ERROR)
     {
-        std::string fileString(file);
         std::string error = "unknown error";
         std::string description  = "no description";
 
@@ -99,14 +312,17 @@ void glCheckError(const char* file, unsigned int line)
         }
 
         // Log the error
-        err() << "An internal OpenGL call failed in "
-              << fileString.substr(fileString.find_last_of("\\/") + 1) << " (" << line << ") : "
-              << error << ", " << description
-              << std::endl;
+        reportError(file, line, errorCode, error + ", " + description);
     }
 }
 
 
+////////////////////////////////////////////////////////////
+bool isGlDebugOutputActive()
+{
+    return getContextCallSite().callback;
+}
+
 } // namespace priv
 
 } // namespace sf
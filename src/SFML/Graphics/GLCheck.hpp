@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Config.hpp>
 #include <SFML/Graphics/GLExtensions.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
 #include <string>
 
 
@@ -43,7 +44,12 @@ namespace priv
 #ifdef SFML_DEBUG
 
     // In debug mode, perform a test on every OpenGL call
-    #define glCheck(x) x; sf::priv::glCheckError(__FILE__, __LINE__);
+    #define glCheck(x) (sf::priv::glCheckBegin(__FILE__, __LINE__), x); sf::priv::glCheckError(__FILE__, __LINE__);
+
+#elif defined(SFML_ENABLE_GL_STATISTICS) || defined(SFML_ENABLE_PROFILER)
+
+    // Else, when the statistics are wanted, we only count the call
+    #define glCheck(call) (sf::priv::countGlCall(), (call))
 
 #else
 
@@ -52,15 +58,51 @@ namespace priv
 
 #endif
 
+////////////////////////////////////////////////////////////
+/// \brief Remember the location of the OpenGL call about to be made
+///
+/// The errors reported by the driver during the call are
+/// attributed to this location. The first call made by a
+/// thread in a context chooses how the errors of the context
+/// are checked (see glCheckError).
+///
+/// \param file Source file where the call is located
+/// \param line Line number of the source file where the call is located
+///
+////////////////////////////////////////////////////////////
+void glCheckBegin(const char* file, unsigned int line);
+
 ////////////////////////////////////////////////////////////
 /// \brief Check the last OpenGL error
 ///
+/// In a debug context that supports KHR_debug, the driver
+/// reports the errors to a callback while the call is made,
+/// so there's nothing left to do. Otherwise, or when
+/// SFML_GL_CHECK_POLLING is defined, glGetError is polled,
+/// which waits for the GPU.
+///
+/// The errors are aggregated per location and kind: the first
+/// one is logged, then only when their count reaches a power
+/// of 10. The call is also counted (see countGlCall).
+///
 /// \param file Source file where the call is located
 /// \param line Line number of the source file where the call is located
 ///
 ////////////////////////////////////////////////////////////
 void glCheckError(const char* file, unsigned int line);
 
+////////////////////////////////////////////////////////////
+/// \brief Tell whether the errors of the active context are reported by the driver
+///
+/// When it's the case, the errors of the OpenGL calls made
+/// outside of SFML are also reported, and glGetError must not
+/// be polled to find them.
+///
+/// \return True if the debug output callback is used, false if glGetError is polled
+///
+////////////////////////////////////////////////////////////
+bool isGlDebugOutputActive();
+
 } // namespace priv
 
 } // namespace sf
@@ -27,6 +27,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/GLExtensions.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Profiler.hpp>
 
 
 namespace sf
@@ -40,6 +41,10 @@ void ensureExtensionsInit()
     static bool initialized = false;
     if (!initialized)
     {
+        SFML_PROFILE_SCOPE("ensureExtensionsInit");
+
+        // Only the availability of the extensions is checked here,
+        // their functions are loaded the first time they are needed
         sfogl_LoadFunctions();
 
         if (!sfogl_IsVersionGEQ(1, 1))
@@ -49,8 +49,12 @@
     #define GLEXT_glClientActiveTexture               glClientActiveTexture
     #define GLEXT_glActiveTexture                     glActiveTexture
     #define GLEXT_GL_TEXTURE0                         GL_TEXTURE0
+    #define GLEXT_GL_ACTIVE_TEXTURE                   GL_ACTIVE_TEXTURE
+    #define GLEXT_GL_CLIENT_ACTIVE_TEXTURE            GL_CLIENT_ACTIVE_TEXTURE
     #define GLEXT_GL_CLAMP                            GL_CLAMP_TO_EDGE
     #define GLEXT_GL_CLAMP_TO_EDGE                    GL_CLAMP_TO_EDGE
+    #define GLEXT_texture_compression                 true
+    #define GLEXT_glCompressedTexImage2D              glCompressedTexImage2D
 
     // The following extensions are listed chronologically
     // Extension macro first, followed by tokens then
@@ -62,6 +66,7 @@
     #define GLEXT_blend_subtract                      GL_OES_blend_subtract
     #define GLEXT_glBlendEquation                     glBlendEquationOES
     #define GLEXT_GL_FUNC_ADD                         GL_FUNC_ADD_OES
+    #define GLEXT_GL_BLEND_EQUATION                   GL_BLEND_EQUATION_OES
     #define GLEXT_GL_FUNC_SUBTRACT                    GL_FUNC_SUBTRACT_OES
 
     // The following extensions are optional.
@@ -74,6 +79,10 @@
         #define GLEXT_blend_func_separate                 GL_OES_blend_func_separate
     #endif
     #define GLEXT_glBlendFuncSeparate                 glBlendFuncSeparateOES
+    #define GLEXT_GL_BLEND_SRC_RGB                    GL_BLEND_SRC_RGB_OES
+    #define GLEXT_GL_BLEND_DST_RGB                    GL_BLEND_DST_RGB_OES
+    #define GLEXT_GL_BLEND_SRC_ALPHA                  GL_BLEND_SRC_ALPHA_OES
+    #define GLEXT_GL_BLEND_DST_ALPHA                  GL_BLEND_DST_ALPHA_OES
 
     // Core since 2.0 - OES_blend_equation_separate
     #ifdef SFML_SYSTEM_ANDROID
@@ -83,10 +92,40 @@
         #define GLEXT_blend_equation_separate             GL_OES_blend_equation_separate
     #endif
     #define GLEXT_glBlendEquationSeparate             glBlendEquationSeparateOES
+    #define GLEXT_GL_BLEND_EQUATION_RGB               GL_BLEND_EQUATION_RGB_OES
+    #define GLEXT_GL_BLEND_EQUATION_ALPHA             GL_BLEND_EQUATION_ALPHA_OES
+
+    // Core since 1.1 - vertex buffer objects
+    #define GLEXT_vertex_buffer_object                true
+    #define GLEXT_glBindBuffer                        glBindBuffer
+    #define GLEXT_glBufferData                        glBufferData
+    #define GLEXT_glBufferSubData                     glBufferSubData
+    #define GLEXT_glDeleteBuffers                     glDeleteBuffers
+    #define GLEXT_glGenBuffers                        glGenBuffers
+    #define GLEXT_GL_ARRAY_BUFFER                     GL_ARRAY_BUFFER
+    #define GLEXT_GL_ELEMENT_ARRAY_BUFFER             GL_ELEMENT_ARRAY_BUFFER
+    #define GLEXT_GL_STATIC_DRAW                      GL_STATIC_DRAW
+    #define GLEXT_GL_DYNAMIC_DRAW                     GL_DYNAMIC_DRAW
+    #define GLEXT_GL_STREAM_DRAW                      GL_DYNAMIC_DRAW
+    #define GLEXT_GL_ARRAY_BUFFER_BINDING             GL_ARRAY_BUFFER_BINDING
+    #define GLEXT_GL_VERTEX_ARRAY_BUFFER_BINDING      GL_VERTEX_ARRAY_BUFFER_BINDING
+    #define GLEXT_GL_COLOR_ARRAY_BUFFER_BINDING       GL_COLOR_ARRAY_BUFFER_BINDING
+    #define GLEXT_GL_TEXTURE_COORD_ARRAY_BUFFER_BINDING GL_TEXTURE_COORD_ARRAY_BUFFER_BINDING
 
     // Core since 2.0 - OES_texture_npot
     #define GLEXT_texture_non_power_of_two            false
 
+    // Compressed formats, not required by OpenGL ES 1.x/2.0
+    #define GLEXT_ES3_compatibility                   false
+    #define GLEXT_texture_compression_s3tc            false
+    #define GLEXT_texture_compression_astc_ldr        false
+
+    // Core since 3.0 - EXT_texture_array, only available with OpenGL ES 3.0
+    #define GLEXT_texture_array                       false
+
+    // Core since 3.0 - uniform buffer objects, only available with OpenGL ES 3.0
+    #define GLEXT_uniform_buffer_object               false
+
     // Core since 2.0 - OES_framebuffer_object
     #define GLEXT_framebuffer_object                  GL_OES_framebuffer_object
     #define GLEXT_glBindRenderbuffer                  glBindRenderbufferOES
@@ -99,6 +138,7 @@
     #define GLEXT_glCheckFramebufferStatus            glCheckFramebufferStatusOES
     #define GLEXT_glFramebufferTexture2D              glFramebufferTexture2DOES
     #define GLEXT_glFramebufferRenderbuffer           glFramebufferRenderbufferOES
+    #define GLEXT_glGenerateMipmap                    glGenerateMipmapOES
     #define GLEXT_GL_FRAMEBUFFER                      GL_FRAMEBUFFER_OES
     #define GLEXT_GL_RENDERBUFFER                     GL_RENDERBUFFER_OES
     #define GLEXT_GL_DEPTH_COMPONENT                  GL_DEPTH_COMPONENT16_OES
@@ -108,6 +148,37 @@
     #define GLEXT_GL_FRAMEBUFFER_BINDING              GL_FRAMEBUFFER_BINDING_OES
     #define GLEXT_GL_INVALID_FRAMEBUFFER_OPERATION    GL_INVALID_FRAMEBUFFER_OPERATION_OES
 
+    // Core since 3.0 - multisampled frame buffers and multiple render targets, only available with OpenGL ES 3.0
+    #define GLEXT_framebuffer_multisample             false
+    #define GLEXT_framebuffer_blit                    false
+    #define GLEXT_draw_buffers                        false
+
+    // Core since 3.3 - timer queries, only available on desktop OpenGL
+    #define GLEXT_timer_query                         false
+
+    // Core since 3.3 - sampler objects, only available with OpenGL ES 3.0
+    #define GLEXT_sampler_objects                     false
+
+    // Core since 2.0 - point sprites sized by a shader, not used with OpenGL ES
+    #define GLEXT_point_sprite                        false
+
+    // Core since 3.0 - one and two channel textures, half float textures and swizzles,
+    // not used with OpenGL ES (which has luminance textures and 16 bits packed pixels)
+    #define GLEXT_texture_rg                          false
+    #define GLEXT_texture_swizzle                     false
+    #define GLEXT_texture_float                       false
+    #define GLEXT_GL_UNSIGNED_SHORT_5_6_5             GL_UNSIGNED_SHORT_5_6_5
+
+    // Core since 3.2 and 4.3 - geometry and compute shaders, GLSL shaders are only used on desktop OpenGL
+    #define GLEXT_geometry_shader                     false
+    #define GLEXT_compute_shader                      false
+
+    // Core since 4.3 - KHR_debug, not used with OpenGL ES
+    #define GLEXT_debug_output                        false
+
+    // Core since 3.0 - packed depth and stencil buffers, not used with OpenGL ES
+    #define GLEXT_packed_depth_stencil                false
+
 #else
 
     #include <SFML/Graphics/GLLoader.hpp>
@@ -131,29 +202,71 @@
     #define GLEXT_GL_CLAMP_TO_EDGE                    GL_CLAMP_TO_EDGE_SGIS
 
     // Core since 1.2 - EXT_blend_minmax
-    #define GLEXT_blend_minmax                        sfogl_ext_EXT_blend_minmax
+    #define GLEXT_blend_minmax                        sfogl_LoadExtension(&sfogl_ext_EXT_blend_minmax)
     #define GLEXT_glBlendEquation                     glBlendEquationEXT
     #define GLEXT_GL_FUNC_ADD                         GL_FUNC_ADD_EXT
+    #define GLEXT_GL_BLEND_EQUATION                   GL_BLEND_EQUATION_EXT
 
     // Core since 1.2 - EXT_blend_subtract
     #define GLEXT_blend_subtract                      sfogl_ext_EXT_blend_subtract
     #define GLEXT_GL_FUNC_SUBTRACT                    GL_FUNC_SUBTRACT_EXT
 
+    // Core since 1.2 - packed pixels
+    #define GLEXT_GL_UNSIGNED_SHORT_5_6_5             GL_UNSIGNED_SHORT_5_6_5
+
+    // Core since 1.2 - EXT_texture3D
+    #define GLEXT_texture3D                           sfogl_LoadExtension(&sfogl_ext_EXT_texture3D)
+    #define GLEXT_glTexImage3D                        glTexImage3DEXT
+    #define GLEXT_glTexSubImage3D                     glTexSubImage3DEXT
+    #define GLEXT_GL_TEXTURE_WRAP_R                   GL_TEXTURE_WRAP_R_EXT
+
     // Core since 1.3 - ARB_multitexture
-    #define GLEXT_multitexture                        sfogl_ext_ARB_multitexture
+    #define GLEXT_multitexture                        sfogl_LoadExtension(&sfogl_ext_ARB_multitexture)
     #define GLEXT_glClientActiveTexture               glClientActiveTextureARB
     #define GLEXT_glActiveTexture                     glActiveTextureARB
     #define GLEXT_GL_TEXTURE0                         GL_TEXTURE0_ARB
+    #define GLEXT_GL_ACTIVE_TEXTURE                   GL_ACTIVE_TEXTURE_ARB
+    #define GLEXT_GL_CLIENT_ACTIVE_TEXTURE            GL_CLIENT_ACTIVE_TEXTURE_ARB
+
+    // Core since 1.3 - ARB_texture_compression
+    #define GLEXT_texture_compression                 sfogl_LoadExtension(&sfogl_ext_ARB_texture_compression)
+    #define GLEXT_glCompressedTexImage2D              glCompressedTexImage2DARB
 
     // Core since 1.4 - EXT_blend_func_separate
-    #define GLEXT_blend_func_separate                 sfogl_ext_EXT_blend_func_separate
+    #define GLEXT_blend_func_separate                 sfogl_LoadExtension(&sfogl_ext_EXT_blend_func_separate)
     #define GLEXT_glBlendFuncSeparate                 glBlendFuncSeparateEXT
+    #define GLEXT_GL_BLEND_SRC_RGB                    GL_BLEND_SRC_RGB_EXT
+    #define GLEXT_GL_BLEND_DST_RGB                    GL_BLEND_DST_RGB_EXT
+    #define GLEXT_GL_BLEND_SRC_ALPHA                  GL_BLEND_SRC_ALPHA_EXT
+    #define GLEXT_GL_BLEND_DST_ALPHA                  GL_BLEND_DST_ALPHA_EXT
+
+    // Core since 1.5 - ARB_vertex_buffer_object
+    #define GLEXT_vertex_buffer_object                sfogl_LoadExtension(&sfogl_ext_ARB_vertex_buffer_object)
+    #define GLEXT_glBindBuffer                        glBindBufferARB
+    #define GLEXT_glBufferData                        glBufferDataARB
+    #define GLEXT_glBufferSubData                     glBufferSubDataARB
+    #define GLEXT_glDeleteBuffers                     glDeleteBuffersARB
+    #define GLEXT_glGenBuffers                        glGenBuffersARB
+    #define GLEXT_glMapBuffer                         glMapBufferARB
+    #define GLEXT_glUnmapBuffer                       glUnmapBufferARB
+    #define GLEXT_GL_ARRAY_BUFFER                     GL_ARRAY_BUFFER_ARB
+    #define GLEXT_GL_ELEMENT_ARRAY_BUFFER             GL_ELEMENT_ARRAY_BUFFER_ARB
+    #define GLEXT_GL_STATIC_DRAW                      GL_STATIC_DRAW_ARB
+    #define GLEXT_GL_DYNAMIC_DRAW                     GL_DYNAMIC_DRAW_ARB
+    #define GLEXT_GL_STREAM_DRAW                      GL_STREAM_DRAW_ARB
+    #define GLEXT_GL_ARRAY_BUFFER_BINDING             GL_ARRAY_BUFFER_BINDING_ARB
+    #define GLEXT_GL_VERTEX_ARRAY_BUFFER_BINDING      GL_VERTEX_ARRAY_BUFFER_BINDING_ARB
+    #define GLEXT_GL_COLOR_ARRAY_BUFFER_BINDING       GL_COLOR_ARRAY_BUFFER_BINDING_ARB
+    #define GLEXT_GL_TEXTURE_COORD_ARRAY_BUFFER_BINDING GL_TEXTURE_COORD_ARRAY_BUFFER_BINDING_ARB
+    #define GLEXT_GL_STREAM_READ                      GL_STREAM_READ_ARB
+    #define GLEXT_GL_READ_ONLY                        GL_READ_ONLY_ARB
+    #define GLEXT_GL_WRITE_ONLY                       GL_WRITE_ONLY_ARB
 
     // Core since 2.0 - ARB_shading_language_100
     #define GLEXT_shading_language_100                sfogl_ext_ARB_shading_language_100
 
     // Core since 2.0 - ARB_shader_objects
-    #define GLEXT_shader_objects                      sfogl_ext_ARB_shader_objects
+    #define GLEXT_shader_objects                      sfogl_LoadExtension(&sfogl_ext_ARB_shader_objects)
     #define GLEXT_glDeleteObject                      glDeleteObjectARB
     #define GLEXT_glGetHandle                         glGetHandleARB
     #define GLEXT_glCreateShaderObject                glCreateShaderObjectARB
@@ -167,6 +280,7 @@
     #define GLEXT_glUniform2f                         glUniform2fARB
     #define GLEXT_glUniform3f                         glUniform3fARB
     #define GLEXT_glUniform4f                         glUniform4fARB
+    #define GLEXT_glUniform4fv                        glUniform4fvARB
     #define GLEXT_glUniform1i                         glUniform1iARB
     #define GLEXT_glUniformMatrix4fv                  glUniformMatrix4fvARB
     #define GLEXT_glGetObjectParameteriv              glGetObjectParameterivARB
@@ -178,9 +292,11 @@
     #define GLEXT_GLhandle                            GLhandleARB
 
     // Core since 2.0 - ARB_vertex_shader
-    #define GLEXT_vertex_shader                       sfogl_ext_ARB_vertex_shader
+    #define GLEXT_vertex_shader                       sfogl_LoadExtension(&sfogl_ext_ARB_vertex_shader)
     #define GLEXT_GL_VERTEX_SHADER                    GL_VERTEX_SHADER_ARB
+    #define GLEXT_GL_MAX_VERTEX_UNIFORM_COMPONENTS    GL_MAX_VERTEX_UNIFORM_COMPONENTS_ARB
     #define GLEXT_GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS_ARB
+    #define GLEXT_GL_VERTEX_PROGRAM_POINT_SIZE        GL_VERTEX_PROGRAM_POINT_SIZE_ARB
 
     // Core since 2.0 - ARB_fragment_shader
     #define GLEXT_fragment_shader                     sfogl_ext_ARB_fragment_shader
@@ -189,12 +305,28 @@
     // Core since 2.0 - ARB_texture_non_power_of_two
     #define GLEXT_texture_non_power_of_two            sfogl_ext_ARB_texture_non_power_of_two
 
+    // Core since 2.0 - ARB_point_sprite
+    #define GLEXT_point_sprite                        sfogl_ext_ARB_point_sprite
+    #define GLEXT_GL_POINT_SPRITE                     GL_POINT_SPRITE_ARB
+
     // Core since 2.0 - EXT_blend_equation_separate
-    #define GLEXT_blend_equation_separate             sfogl_ext_EXT_blend_equation_separate
+    #define GLEXT_blend_equation_separate             sfogl_LoadExtension(&sfogl_ext_EXT_blend_equation_separate)
     #define GLEXT_glBlendEquationSeparate             glBlendEquationSeparateEXT
+    #define GLEXT_GL_BLEND_EQUATION_RGB               GL_BLEND_EQUATION_RGB_EXT
+    #define GLEXT_GL_BLEND_EQUATION_ALPHA             GL_BLEND_EQUATION_ALPHA_EXT
+
+    // Core since 2.0 - ARB_draw_buffers
+    #define GLEXT_draw_buffers                        sfogl_LoadExtension(&sfogl_ext_ARB_draw_buffers)
+    #define GLEXT_glDrawBuffers                       glDrawBuffersARB
+    #define GLEXT_GL_MAX_DRAW_BUFFERS                 GL_MAX_DRAW_BUFFERS_ARB
+
+    // Core since 2.1 - ARB_pixel_buffer_object
+    #define GLEXT_pixel_buffer_object                 sfogl_ext_ARB_pixel_buffer_object
+    #define GLEXT_GL_PIXEL_PACK_BUFFER                GL_PIXEL_PACK_BUFFER_ARB
+    #define GLEXT_GL_PIXEL_UNPACK_BUFFER              GL_PIXEL_UNPACK_BUFFER_ARB
 
     // Core since 3.0 - EXT_framebuffer_object
-    #define GLEXT_framebuffer_object                  sfogl_ext_EXT_framebuffer_object
+    #define GLEXT_framebuffer_object                  sfogl_LoadExtension(&sfogl_ext_EXT_framebuffer_object)
     #define GLEXT_glBindRenderbuffer                  glBindRenderbufferEXT
     #define GLEXT_glDeleteRenderbuffers               glDeleteRenderbuffersEXT
     #define GLEXT_glGenRenderbuffers                  glGenRenderbuffersEXT
@@ -205,13 +337,162 @@
     #define GLEXT_glCheckFramebufferStatus            glCheckFramebufferStatusEXT
     #define GLEXT_glFramebufferTexture2D              glFramebufferTexture2DEXT
     #define GLEXT_glFramebufferRenderbuffer           glFramebufferRenderbufferEXT
+    #define GLEXT_glGenerateMipmap                    glGenerateMipmapEXT
     #define GLEXT_GL_FRAMEBUFFER                      GL_FRAMEBUFFER_EXT
     #define GLEXT_GL_RENDERBUFFER                     GL_RENDERBUFFER_EXT
     #define GLEXT_GL_COLOR_ATTACHMENT0                GL_COLOR_ATTACHMENT0_EXT
     #define GLEXT_GL_DEPTH_ATTACHMENT                 GL_DEPTH_ATTACHMENT_EXT
+    #define GLEXT_GL_STENCIL_ATTACHMENT               GL_STENCIL_ATTACHMENT_EXT
     #define GLEXT_GL_FRAMEBUFFER_COMPLETE             GL_FRAMEBUFFER_COMPLETE_EXT
     #define GLEXT_GL_FRAMEBUFFER_BINDING              GL_FRAMEBUFFER_BINDING_EXT
     #define GLEXT_GL_INVALID_FRAMEBUFFER_OPERATION    GL_INVALID_FRAMEBUFFER_OPERATION_EXT
+    #define GLEXT_GL_MAX_COLOR_ATTACHMENTS            GL_MAX_COLOR_ATTACHMENTS_EXT
+
+    // Core since 3.0 - EXT_framebuffer_blit
+    #define GLEXT_framebuffer_blit                    sfogl_LoadExtension(&sfogl_ext_EXT_framebuffer_blit)
+    #define GLEXT_glBlitFramebuffer                   glBlitFramebufferEXT
+    #define GLEXT_GL_READ_FRAMEBUFFER                 GL_READ_FRAMEBUFFER_EXT
+    #define GLEXT_GL_DRAW_FRAMEBUFFER                 GL_DRAW_FRAMEBUFFER_EXT
+
+    // Core since 3.0 - EXT_framebuffer_multisample
+    #define GLEXT_framebuffer_multisample             sfogl_LoadExtension(&sfogl_ext_EXT_framebuffer_multisample)
+    #define GLEXT_glRenderbufferStorageMultisample    glRenderbufferStorageMultisampleEXT
+    #define GLEXT_GL_MAX_SAMPLES                      GL_MAX_SAMPLES_EXT
+
+    // Core since 3.0 - ARB_texture_rg
+    #define GLEXT_texture_rg                          sfogl_ext_ARB_texture_rg
+    #define GLEXT_GL_R8                               GL_R8
+    #define GLEXT_GL_RG8                              GL_RG8
+    #define GLEXT_GL_RG                               GL_RG
+
+    // Core since 3.0 - ARB_texture_float and ARB_half_float_pixel
+    #define GLEXT_texture_float                       (sfogl_ext_ARB_texture_float && sfogl_ext_ARB_half_float_pixel)
+    #define GLEXT_GL_RGBA16F                          GL_RGBA16F_ARB
+    #define GLEXT_GL_HALF_FLOAT                       GL_HALF_FLOAT_ARB
+
+    // Core since 3.0 - EXT_texture_array
+    #define GLEXT_texture_array                       sfogl_LoadExtension(&sfogl_ext_EXT_texture_array)
+    #define GLEXT_glFramebufferTextureLayer           glFramebufferTextureLayerEXT
+    #define GLEXT_GL_TEXTURE_2D_ARRAY                 GL_TEXTURE_2D_ARRAY_EXT
+    #define GLEXT_GL_TEXTURE_BINDING_2D_ARRAY         GL_TEXTURE_BINDING_2D_ARRAY_EXT
+    #define GLEXT_GL_MAX_ARRAY_TEXTURE_LAYERS         GL_MAX_ARRAY_TEXTURE_LAYERS_EXT
+
+    // Core since 3.1 - ARB_draw_instanced
+    #define GLEXT_draw_instanced                      sfogl_LoadExtension(&sfogl_ext_ARB_draw_instanced)
+    #define GLEXT_glDrawArraysInstanced               glDrawArraysInstancedARB
+
+    // Core since 3.1 - ARB_uniform_buffer_object
+    #define GLEXT_uniform_buffer_object               sfogl_LoadExtension(&sfogl_ext_ARB_uniform_buffer_object)
+    #define GLEXT_glGetUniformBlockIndex              glGetUniformBlockIndex
+    #define GLEXT_glUniformBlockBinding               glUniformBlockBinding
+    #define GLEXT_glBindBufferBase                    glBindBufferBase
+    #define GLEXT_glBindBufferRange                   glBindBufferRange
+    #define GLEXT_GL_UNIFORM_BUFFER                   GL_UNIFORM_BUFFER
+    #define GLEXT_GL_MAX_UNIFORM_BUFFER_BINDINGS      GL_MAX_UNIFORM_BUFFER_BINDINGS
+    #define GLEXT_GL_INVALID_INDEX                    GL_INVALID_INDEX
+
+    // Core since 3.2 - geometry shaders (the stage of ARB_geometry_shader4 has a different interface)
+    #define GLEXT_geometry_shader                     sfogl_IsVersionGEQ(3, 2)
+    #define GLEXT_GL_GEOMETRY_SHADER                  GL_GEOMETRY_SHADER
+
+    // Core since 3.2 - ARB_sync
+    #define GLEXT_sync                                sfogl_LoadExtension(&sfogl_ext_ARB_sync)
+    #define GLEXT_glFenceSync                         glFenceSync
+    #define GLEXT_glDeleteSync                        glDeleteSync
+    #define GLEXT_glClientWaitSync                    glClientWaitSync
+    #define GLEXT_GLsync                              GLsync
+    #define GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE       GL_SYNC_GPU_COMMANDS_COMPLETE
+    #define GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT          GL_SYNC_FLUSH_COMMANDS_BIT
+    #define GLEXT_GL_ALREADY_SIGNALED                 GL_ALREADY_SIGNALED
+    #define GLEXT_GL_CONDITION_SATISFIED              GL_CONDITION_SATISFIED
+    #define GLEXT_GL_TIMEOUT_IGNORED                  GL_TIMEOUT_IGNORED
+
+    // Core since 3.3 - ARB_timer_query (queries are core since 1.5 - ARB_occlusion_query)
+    #define GLEXT_timer_query                         (sfogl_LoadExtension(&sfogl_ext_ARB_timer_query) && sfogl_LoadExtension(&sfogl_ext_ARB_occlusion_query))
+    #define GLEXT_glGenQueries                        glGenQueriesARB
+    #define GLEXT_glDeleteQueries                     glDeleteQueriesARB
+    #define GLEXT_glGetQueryObjectuiv                 glGetQueryObjectuivARB
+    #define GLEXT_glGetQueryObjectui64v               glGetQueryObjectui64v
+    #define GLEXT_glQueryCounter                      glQueryCounter
+    #define GLEXT_GL_QUERY_RESULT                     GL_QUERY_RESULT_ARB
+    #define GLEXT_GL_QUERY_RESULT_AVAILABLE           GL_QUERY_RESULT_AVAILABLE_ARB
+    #define GLEXT_GL_TIMESTAMP                        GL_TIMESTAMP
+
+    // Core since 3.3 - ARB_sampler_objects
+    #define GLEXT_sampler_objects                     sfogl_LoadExtension(&sfogl_ext_ARB_sampler_objects)
+    #define GLEXT_glGenSamplers                       glGenSamplers
+    #define GLEXT_glDeleteSamplers                    glDeleteSamplers
+    #define GLEXT_glBindSampler                       glBindSampler
+    #define GLEXT_glSamplerParameteri                 glSamplerParameteri
+    #define GLEXT_GL_SAMPLER_BINDING                  GL_SAMPLER_BINDING
+
+    // Core since 3.3 - ARB_texture_swizzle
+    #define GLEXT_texture_swizzle                     sfogl_ext_ARB_texture_swizzle
+    #define GLEXT_GL_TEXTURE_SWIZZLE_RGBA             GL_TEXTURE_SWIZZLE_RGBA
+
+    // Core since 4.1 - ARB_get_program_binary
+    #define GLEXT_get_program_binary                  sfogl_LoadExtension(&sfogl_ext_ARB_get_program_binary)
+    #define GLEXT_glGetProgramBinary                  glGetProgramBinary
+    #define GLEXT_glProgramBinary                     glProgramBinary
+    #define GLEXT_glProgramParameteri                 glProgramParameteri
+    #define GLEXT_GL_PROGRAM_BINARY_RETRIEVABLE_HINT  GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+    #define GLEXT_GL_PROGRAM_BINARY_LENGTH            GL_PROGRAM_BINARY_LENGTH
+    #define GLEXT_GL_NUM_PROGRAM_BINARY_FORMATS       GL_NUM_PROGRAM_BINARY_FORMATS
+
+    // Core since 4.3 - ARB_compute_shader, ARB_shader_image_load_store (core since 4.2),
+    // ARB_shader_storage_buffer_object and ARB_program_interface_query
+    // (storage buffers are bound with the functions of ARB_uniform_buffer_object)
+    #define GLEXT_compute_shader                      (GLEXT_uniform_buffer_object &&                                     \
+                                                       sfogl_LoadExtension(&sfogl_ext_ARB_compute_shader) &&              \
+                                                       sfogl_LoadExtension(&sfogl_ext_ARB_shader_image_load_store) &&     \
+                                                       sfogl_LoadExtension(&sfogl_ext_ARB_shader_storage_buffer_object) && \
+                                                       sfogl_LoadExtension(&sfogl_ext_ARB_program_interface_query))
+    #define GLEXT_glDispatchCompute                   glDispatchCompute
+    #define GLEXT_glBindImageTexture                  glBindImageTexture
+    #define GLEXT_glMemoryBarrier                     glMemoryBarrier
+    #define GLEXT_glShaderStorageBlockBinding         glShaderStorageBlockBinding
+    #define GLEXT_glGetProgramResourceIndex           glGetProgramResourceIndex
+    #define GLEXT_GL_COMPUTE_SHADER                   GL_COMPUTE_SHADER
+    #define GLEXT_GL_MAX_COMPUTE_WORK_GROUP_COUNT     GL_MAX_COMPUTE_WORK_GROUP_COUNT
+    #define GLEXT_GL_MAX_IMAGE_UNITS                  GL_MAX_IMAGE_UNITS
+    #define GLEXT_GL_ALL_BARRIER_BITS                 GL_ALL_BARRIER_BITS
+    #define GLEXT_GL_READ_ONLY                        GL_READ_ONLY_ARB
+    #define GLEXT_GL_WRITE_ONLY                       GL_WRITE_ONLY_ARB
+    #define GLEXT_GL_READ_WRITE                       GL_READ_WRITE_ARB
+    #define GLEXT_GL_SHADER_STORAGE_BUFFER            GL_SHADER_STORAGE_BUFFER
+    #define GLEXT_GL_SHADER_STORAGE_BLOCK             GL_SHADER_STORAGE_BLOCK
+    #define GLEXT_GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS
+
+    // Core since 4.3 - KHR_debug
+    #define GLEXT_debug_output                        sfogl_LoadExtension(&sfogl_ext_KHR_debug)
+    #define GLEXT_glDebugMessageCallback              glDebugMessageCallback
+    #define GLEXT_glDebugMessageControl               glDebugMessageControl
+    #define GLEXT_GL_CONTEXT_FLAGS                    GL_CONTEXT_FLAGS
+    #define GLEXT_GL_CONTEXT_FLAG_DEBUG_BIT           GL_CONTEXT_FLAG_DEBUG_BIT
+    #define GLEXT_GL_DEBUG_CALLBACK_FUNCTION          GL_DEBUG_CALLBACK_FUNCTION
+    #define GLEXT_GL_DEBUG_CALLBACK_USER_PARAM        GL_DEBUG_CALLBACK_USER_PARAM
+    #define GLEXT_GL_DEBUG_OUTPUT                     GL_DEBUG_OUTPUT
+    #define GLEXT_GL_DEBUG_OUTPUT_SYNCHRONOUS         GL_DEBUG_OUTPUT_SYNCHRONOUS
+    #define GLEXT_GL_DEBUG_TYPE_ERROR                 GL_DEBUG_TYPE_ERROR
+    #define GLEXT_GL_DONT_CARE                        GL_DONT_CARE
+
+    // Core since 3.0 - EXT_packed_depth_stencil
+    #define GLEXT_packed_depth_stencil                sfogl_ext_EXT_packed_depth_stencil
+    #define GLEXT_GL_DEPTH24_STENCIL8                 GL_DEPTH24_STENCIL8_EXT
+
+    // Core since 4.3 - ARB_ES3_compatibility
+    #define GLEXT_ES3_compatibility                   sfogl_ext_ARB_ES3_compatibility
+
+    // Not in core - EXT_texture_compression_s3tc
+    #define GLEXT_texture_compression_s3tc            sfogl_ext_EXT_texture_compression_s3tc
+
+    // Not in core - KHR_texture_compression_astc_ldr
+    #define GLEXT_texture_compression_astc_ldr        sfogl_ext_KHR_texture_compression_astc_ldr
+
+    // Not in core - KHR_parallel_shader_compile
+    #define GLEXT_parallel_shader_compile             sfogl_LoadExtension(&sfogl_ext_KHR_parallel_shader_compile)
+    #define GLEXT_glMaxShaderCompilerThreads          glMaxShaderCompilerThreadsKHR
+    #define GLEXT_GL_COMPLETION_STATUS                GL_COMPLETION_STATUS_KHR
 
 #endif
 
@@ -185,6 +185,36 @@ extern int sfogl_ext_ARB_fragment_shader;
 extern int sfogl_ext_ARB_texture_non_power_of_two;
 extern int sfogl_ext_EXT_blend_equation_separate;
 extern int sfogl_ext_EXT_framebuffer_object;
+extern int sfogl_ext_ARB_vertex_buffer_object;
+extern int sfogl_ext_ARB_draw_instanced;
+extern int sfogl_ext_ARB_pixel_buffer_object;
+extern int sfogl_ext_ARB_sync;
+extern int sfogl_ext_ARB_texture_compression;
+extern int sfogl_ext_EXT_texture_compression_s3tc;
+extern int sfogl_ext_ARB_ES3_compatibility;
+extern int sfogl_ext_KHR_texture_compression_astc_ldr;
+extern int sfogl_ext_EXT_texture3D;
+extern int sfogl_ext_EXT_texture_array;
+extern int sfogl_ext_ARB_uniform_buffer_object;
+extern int sfogl_ext_ARB_get_program_binary;
+extern int sfogl_ext_KHR_parallel_shader_compile;
+extern int sfogl_ext_EXT_framebuffer_multisample;
+extern int sfogl_ext_EXT_framebuffer_blit;
+extern int sfogl_ext_ARB_draw_buffers;
+extern int sfogl_ext_ARB_occlusion_query;
+extern int sfogl_ext_ARB_timer_query;
+extern int sfogl_ext_ARB_sampler_objects;
+extern int sfogl_ext_ARB_point_sprite;
+extern int sfogl_ext_ARB_texture_rg;
+extern int sfogl_ext_ARB_texture_swizzle;
+extern int sfogl_ext_ARB_texture_float;
+extern int sfogl_ext_ARB_half_float_pixel;
+extern int sfogl_ext_ARB_compute_shader;
+extern int sfogl_ext_ARB_shader_image_load_store;
+extern int sfogl_ext_ARB_shader_storage_buffer_object;
+extern int sfogl_ext_ARB_program_interface_query;
+extern int sfogl_ext_KHR_debug;
+extern int sfogl_ext_EXT_packed_depth_stencil;
 
 #define GL_CLAMP_TO_EDGE_SGIS 0x812F
 
@@ -280,6 +310,8 @@ extern int sfogl_ext_EXT_framebuffer_object;
 #define GL_MAX_VERTEX_UNIFORM_COMPONENTS_ARB 0x8B4A
 #define GL_OBJECT_ACTIVE_ATTRIBUTES_ARB 0x8B89
 #define GL_OBJECT_ACTIVE_ATTRIBUTE_MAX_LENGTH_ARB 0x8B8A
+#define GL_VERTEX_PROGRAM_POINT_SIZE_ARB 0x8642
+#define GL_VERTEX_PROGRAM_TWO_SIDE_ARB 0x8643
 #define GL_VERTEX_SHADER_ARB 0x8B31
 
 #define GL_FRAGMENT_SHADER_ARB 0x8B30
@@ -341,6 +373,197 @@ extern int sfogl_ext_EXT_framebuffer_object;
 #define GL_STENCIL_INDEX4_EXT 0x8D47
 #define GL_STENCIL_INDEX8_EXT 0x8D48
 
+#define GL_ARRAY_BUFFER_ARB 0x8892
+#define GL_ARRAY_BUFFER_BINDING_ARB 0x8894
+#define GL_BUFFER_ACCESS_ARB 0x88BB
+#define GL_BUFFER_MAPPED_ARB 0x88BC
+#define GL_BUFFER_MAP_POINTER_ARB 0x88BD
+#define GL_BUFFER_SIZE_ARB 0x8764
+#define GL_BUFFER_USAGE_ARB 0x8765
+#define GL_COLOR_ARRAY_BUFFER_BINDING_ARB 0x8898
+#define GL_DYNAMIC_COPY_ARB 0x88EA
+#define GL_DYNAMIC_DRAW_ARB 0x88E8
+#define GL_DYNAMIC_READ_ARB 0x88E9
+#define GL_ELEMENT_ARRAY_BUFFER_ARB 0x8893
+#define GL_ELEMENT_ARRAY_BUFFER_BINDING_ARB 0x8895
+#define GL_READ_ONLY_ARB 0x88B8
+#define GL_READ_WRITE_ARB 0x88BA
+#define GL_STATIC_COPY_ARB 0x88E6
+#define GL_STATIC_DRAW_ARB 0x88E4
+#define GL_STATIC_READ_ARB 0x88E5
+#define GL_STREAM_COPY_ARB 0x88E2
+#define GL_STREAM_DRAW_ARB 0x88E0
+#define GL_STREAM_READ_ARB 0x88E1
+#define GL_TEXTURE_COORD_ARRAY_BUFFER_BINDING_ARB 0x889A
+#define GL_VERTEX_ARRAY_BUFFER_BINDING_ARB 0x8896
+#define GL_WRITE_ONLY_ARB 0x88B9
+
+#define GL_PIXEL_PACK_BUFFER_ARB 0x88EB
+#define GL_PIXEL_PACK_BUFFER_BINDING_ARB 0x88ED
+#define GL_PIXEL_UNPACK_BUFFER_ARB 0x88EC
+#define GL_PIXEL_UNPACK_BUFFER_BINDING_ARB 0x88EF
+
+#define GL_ALREADY_SIGNALED 0x911A
+#define GL_CONDITION_SATISFIED 0x911C
+#define GL_MAX_SERVER_WAIT_TIMEOUT 0x9111
+#define GL_OBJECT_TYPE 0x9112
+#define GL_SIGNALED 0x9119
+#define GL_SYNC_CONDITION 0x9113
+#define GL_SYNC_FENCE 0x9116
+#define GL_SYNC_FLAGS 0x9115
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#define GL_SYNC_STATUS 0x9114
+#define GL_TIMEOUT_EXPIRED 0x911B
+#define GL_TIMEOUT_IGNORED 0xFFFFFFFFFFFFFFFFull
+#define GL_UNSIGNALED 0x9118
+#define GL_WAIT_FAILED 0x911D
+
+#define GL_COMPRESSED_ALPHA_ARB 0x84E9
+#define GL_COMPRESSED_INTENSITY_ARB 0x84EC
+#define GL_COMPRESSED_LUMINANCE_ALPHA_ARB 0x84EB
+#define GL_COMPRESSED_LUMINANCE_ARB 0x84EA
+#define GL_COMPRESSED_RGBA_ARB 0x84EE
+#define GL_COMPRESSED_RGB_ARB 0x84ED
+#define GL_COMPRESSED_TEXTURE_FORMATS_ARB 0x86A3
+#define GL_NUM_COMPRESSED_TEXTURE_FORMATS_ARB 0x86A2
+#define GL_TEXTURE_COMPRESSED_ARB 0x86A1
+#define GL_TEXTURE_COMPRESSED_IMAGE_SIZE_ARB 0x86A0
+#define GL_TEXTURE_COMPRESSION_HINT_ARB 0x84EF
+
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#define GL_COMPRESSED_RGBA_S3TC_DXT3_EXT 0x83F2
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+
+#define GL_ANY_SAMPLES_PASSED_CONSERVATIVE 0x8D6A
+#define GL_COMPRESSED_R11_EAC 0x9270
+#define GL_COMPRESSED_RG11_EAC 0x9272
+#define GL_COMPRESSED_RGB8_ETC2 0x9274
+#define GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2 0x9276
+#define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#define GL_COMPRESSED_SIGNED_R11_EAC 0x9271
+#define GL_COMPRESSED_SIGNED_RG11_EAC 0x9273
+#define GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC 0x9279
+#define GL_COMPRESSED_SRGB8_ETC2 0x9275
+#define GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2 0x9277
+#define GL_MAX_ELEMENT_INDEX 0x8D6B
+#define GL_PRIMITIVE_RESTART_FIXED_INDEX 0x8D69
+
+#define GL_COMPRESSED_RGBA_ASTC_10x10_KHR 0x93BB
+#define GL_COMPRESSED_RGBA_ASTC_10x5_KHR 0x93B8
+#define GL_COMPRESSED_RGBA_ASTC_10x6_KHR 0x93B9
+#define GL_COMPRESSED_RGBA_ASTC_10x8_KHR 0x93BA
+#define GL_COMPRESSED_RGBA_ASTC_12x10_KHR 0x93BC
+#define GL_COMPRESSED_RGBA_ASTC_12x12_KHR 0x93BD
+#define GL_COMPRESSED_RGBA_ASTC_4x4_KHR 0x93B0
+#define GL_COMPRESSED_RGBA_ASTC_5x4_KHR 0x93B1
+#define GL_COMPRESSED_RGBA_ASTC_5x5_KHR 0x93B2
+#define GL_COMPRESSED_RGBA_ASTC_6x5_KHR 0x93B3
+#define GL_COMPRESSED_RGBA_ASTC_6x6_KHR 0x93B4
+#define GL_COMPRESSED_RGBA_ASTC_8x5_KHR 0x93B5
+#define GL_COMPRESSED_RGBA_ASTC_8x6_KHR 0x93B6
+#define GL_COMPRESSED_RGBA_ASTC_8x8_KHR 0x93B7
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x10_KHR 0x93DB
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x5_KHR 0x93D8
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x6_KHR 0x93D9
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x8_KHR 0x93DA
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x10_KHR 0x93DC
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x12_KHR 0x93DD
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR 0x93D0
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x4_KHR 0x93D1
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x5_KHR 0x93D2
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x5_KHR 0x93D3
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x6_KHR 0x93D4
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x5_KHR 0x93D5
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x6_KHR 0x93D6
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x8_KHR 0x93D7
+
+#define GL_MAX_3D_TEXTURE_SIZE_EXT 0x8073
+#define GL_TEXTURE_3D_EXT 0x806F
+#define GL_TEXTURE_WRAP_R_EXT 0x8072
+
+#define GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_LAYER_EXT 0x8CD4
+#define GL_MAX_ARRAY_TEXTURE_LAYERS_EXT 0x88FF
+#define GL_TEXTURE_1D_ARRAY_EXT 0x8C18
+#define GL_TEXTURE_2D_ARRAY_EXT 0x8C1A
+#define GL_TEXTURE_BINDING_1D_ARRAY_EXT 0x8C1C
+#define GL_TEXTURE_BINDING_2D_ARRAY_EXT 0x8C1D
+
+#define GL_INVALID_INDEX 0xFFFFFFFFu
+#define GL_MAX_UNIFORM_BUFFER_BINDINGS 0x8A2F
+#define GL_UNIFORM_BUFFER 0x8A11
+
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#define GL_PROGRAM_BINARY_FORMATS 0x87FF
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+
+#define GL_FRAMEBUFFER_INCOMPLETE_MULTISAMPLE_EXT 0x8D56
+#define GL_MAX_SAMPLES_EXT 0x8D57
+#define GL_RENDERBUFFER_SAMPLES_EXT 0x8CAB
+
+#define GL_DRAW_FRAMEBUFFER_BINDING_EXT 0x8CA6
+#define GL_DRAW_FRAMEBUFFER_EXT 0x8CA9
+#define GL_READ_FRAMEBUFFER_BINDING_EXT 0x8CAA
+#define GL_READ_FRAMEBUFFER_EXT 0x8CA8
+
+#define GL_DRAW_BUFFER0_ARB 0x8825
+#define GL_MAX_DRAW_BUFFERS_ARB 0x8824
+
+#define GL_CURRENT_QUERY_ARB 0x8865
+#define GL_QUERY_COUNTER_BITS_ARB 0x8864
+#define GL_QUERY_RESULT_ARB 0x8866
+#define GL_QUERY_RESULT_AVAILABLE_ARB 0x8867
+#define GL_SAMPLES_PASSED_ARB 0x8914
+
+#define GL_TIMESTAMP 0x8E28
+#define GL_TIME_ELAPSED 0x88BF
+
+#define GL_SAMPLER_BINDING 0x8919
+
+#define GL_COORD_REPLACE_ARB 0x8862
+#define GL_POINT_SPRITE_ARB 0x8861
+
+#define GL_R8 0x8229
+#define GL_RG 0x8227
+#define GL_RG8 0x822B
+
+#define GL_TEXTURE_SWIZZLE_RGBA 0x8E46
+
+#define GL_RGBA16F_ARB 0x881A
+
+#define GL_HALF_FLOAT_ARB 0x140B
+
+#define GL_UNSIGNED_SHORT_5_6_5 0x8363
+
+#define GL_GEOMETRY_SHADER 0x8DD9
+
+#define GL_COMPUTE_SHADER 0x91B9
+#define GL_MAX_COMPUTE_WORK_GROUP_COUNT 0x91BE
+
+#define GL_ALL_BARRIER_BITS 0xFFFFFFFF
+#define GL_MAX_IMAGE_UNITS 0x8F38
+
+#define GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS 0x90DD
+#define GL_SHADER_STORAGE_BUFFER 0x90D2
+
+#define GL_SHADER_STORAGE_BLOCK 0x92E6
+
+#define GL_CONTEXT_FLAGS 0x821E
+#define GL_CONTEXT_FLAG_DEBUG_BIT 0x00000002
+#define GL_DEBUG_CALLBACK_FUNCTION 0x8244
+#define GL_DEBUG_CALLBACK_USER_PARAM 0x8245
+#define GL_DEBUG_OUTPUT 0x92E0
+#define GL_DEBUG_OUTPUT_SYNCHRONOUS 0x8242
+#define GL_DEBUG_TYPE_ERROR 0x824C
+#define GL_DONT_CARE 0x1100
+
+#define GL_DEPTH24_STENCIL8_EXT 0x88F0
+
 #define GL_2D 0x0600
 #define GL_2_BYTES 0x1407
 #define GL_3D 0x0601
@@ -943,12 +1166,219 @@ extern void (CODEGEN_FUNCPTR *sf_ptrc_glRenderbufferStorageEXT)(GLenum, GLenum,
 #define glRenderbufferStorageEXT sf_ptrc_glRenderbufferStorageEXT
 #endif /*GL_EXT_framebuffer_object*/
 
+#ifndef GL_ARB_vertex_buffer_object
+#define GL_ARB_vertex_buffer_object 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glBindBufferARB)(GLenum, GLuint);
+#define glBindBufferARB sf_ptrc_glBindBufferARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glBufferDataARB)(GLenum, GLsizeiptrARB, const void *, GLenum);
+#define glBufferDataARB sf_ptrc_glBufferDataARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glBufferSubDataARB)(GLenum, GLintptrARB, GLsizeiptrARB, const void *);
+#define glBufferSubDataARB sf_ptrc_glBufferSubDataARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glDeleteBuffersARB)(GLsizei, const GLuint *);
+#define glDeleteBuffersARB sf_ptrc_glDeleteBuffersARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGenBuffersARB)(GLsizei, GLuint *);
+#define glGenBuffersARB sf_ptrc_glGenBuffersARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGetBufferParameterivARB)(GLenum, GLenum, GLint *);
+#define glGetBufferParameterivARB sf_ptrc_glGetBufferParameterivARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGetBufferPointervARB)(GLenum, GLenum, void **);
+#define glGetBufferPointervARB sf_ptrc_glGetBufferPointervARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGetBufferSubDataARB)(GLenum, GLintptrARB, GLsizeiptrARB, void *);
+#define glGetBufferSubDataARB sf_ptrc_glGetBufferSubDataARB
+extern GLboolean (CODEGEN_FUNCPTR *sf_ptrc_glIsBufferARB)(GLuint);
+#define glIsBufferARB sf_ptrc_glIsBufferARB
+extern void * (CODEGEN_FUNCPTR *sf_ptrc_glMapBufferARB)(GLenum, GLenum);
+#define glMapBufferARB sf_ptrc_glMapBufferARB
+extern GLboolean (CODEGEN_FUNCPTR *sf_ptrc_glUnmapBufferARB)(GLenum);
+#define glUnmapBufferARB sf_ptrc_glUnmapBufferARB
+#endif /*GL_ARB_vertex_buffer_object*/
+
+#ifndef GL_ARB_draw_instanced
+#define GL_ARB_draw_instanced 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glDrawArraysInstancedARB)(GLenum, GLint, GLsizei, GLsizei);
+#define glDrawArraysInstancedARB sf_ptrc_glDrawArraysInstancedARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glDrawElementsInstancedARB)(GLenum, GLsizei, GLenum, const void *, GLsizei);
+#define glDrawElementsInstancedARB sf_ptrc_glDrawElementsInstancedARB
+#endif /*GL_ARB_draw_instanced*/
+
+#ifndef GL_ARB_sync
+#define GL_ARB_sync 1
+extern GLenum (CODEGEN_FUNCPTR *sf_ptrc_glClientWaitSync)(GLsync, GLbitfield, GLuint64);
+#define glClientWaitSync sf_ptrc_glClientWaitSync
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glDeleteSync)(GLsync);
+#define glDeleteSync sf_ptrc_glDeleteSync
+extern GLsync (CODEGEN_FUNCPTR *sf_ptrc_glFenceSync)(GLenum, GLbitfield);
+#define glFenceSync sf_ptrc_glFenceSync
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGetInteger64v)(GLenum, GLint64 *);
+#define glGetInteger64v sf_ptrc_glGetInteger64v
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGetSynciv)(GLsync, GLenum, GLsizei, GLsizei *, GLint *);
+#define glGetSynciv sf_ptrc_glGetSynciv
+extern GLboolean (CODEGEN_FUNCPTR *sf_ptrc_glIsSync)(GLsync);
+#define glIsSync sf_ptrc_glIsSync
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glWaitSync)(GLsync, GLbitfield, GLuint64);
+#define glWaitSync sf_ptrc_glWaitSync
+#endif /*GL_ARB_sync*/
+
+#ifndef GL_ARB_texture_compression
+#define GL_ARB_texture_compression 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glCompressedTexImage1DARB)(GLenum, GLint, GLenum, GLsizei, GLint, GLsizei, const void *);
+#define glCompressedTexImage1DARB sf_ptrc_glCompressedTexImage1DARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glCompressedTexImage2DARB)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLint, GLsizei, const void *);
+#define glCompressedTexImage2DARB sf_ptrc_glCompressedTexImage2DARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glCompressedTexImage3DARB)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLsizei, GLint, GLsizei, const void *);
+#define glCompressedTexImage3DARB sf_ptrc_glCompressedTexImage3DARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glCompressedTexSubImage1DARB)(GLenum, GLint, GLint, GLsizei, GLenum, GLsizei, const void *);
+#define glCompressedTexSubImage1DARB sf_ptrc_glCompressedTexSubImage1DARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glCompressedTexSubImage2DARB)(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLsizei, const void *);
+#define glCompressedTexSubImage2DARB sf_ptrc_glCompressedTexSubImage2DARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glCompressedTexSubImage3DARB)(GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLsizei, const void *);
+#define glCompressedTexSubImage3DARB sf_ptrc_glCompressedTexSubImage3DARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGetCompressedTexImageARB)(GLenum, GLint, void *);
+#define glGetCompressedTexImageARB sf_ptrc_glGetCompressedTexImageARB
+#endif /*GL_ARB_texture_compression*/
+
+#ifndef GL_EXT_texture3D
+#define GL_EXT_texture3D 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glTexImage3DEXT)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLsizei, GLint, GLenum, GLenum, const void *);
+#define glTexImage3DEXT sf_ptrc_glTexImage3DEXT
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glTexSubImage3DEXT)(GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLenum, const void *);
+#define glTexSubImage3DEXT sf_ptrc_glTexSubImage3DEXT
+#endif /*GL_EXT_texture3D*/
+
+#ifndef GL_EXT_texture_array
+#define GL_EXT_texture_array 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glFramebufferTextureLayerEXT)(GLenum, GLenum, GLuint, GLint, GLint);
+#define glFramebufferTextureLayerEXT sf_ptrc_glFramebufferTextureLayerEXT
+#endif /*GL_EXT_texture_array*/
+
+#ifndef GL_ARB_uniform_buffer_object
+#define GL_ARB_uniform_buffer_object 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glBindBufferBase)(GLenum, GLuint, GLuint);
+#define glBindBufferBase sf_ptrc_glBindBufferBase
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glBindBufferRange)(GLenum, GLuint, GLuint, GLintptr, GLsizeiptr);
+#define glBindBufferRange sf_ptrc_glBindBufferRange
+extern GLuint (CODEGEN_FUNCPTR *sf_ptrc_glGetUniformBlockIndex)(GLuint, const GLchar*);
+#define glGetUniformBlockIndex sf_ptrc_glGetUniformBlockIndex
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glUniformBlockBinding)(GLuint, GLuint, GLuint);
+#define glUniformBlockBinding sf_ptrc_glUniformBlockBinding
+#endif /*GL_ARB_uniform_buffer_object*/
+
+#ifndef GL_ARB_get_program_binary
+#define GL_ARB_get_program_binary 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGetProgramBinary)(GLuint, GLsizei, GLsizei*, GLenum*, void*);
+#define glGetProgramBinary sf_ptrc_glGetProgramBinary
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glProgramBinary)(GLuint, GLenum, const void*, GLsizei);
+#define glProgramBinary sf_ptrc_glProgramBinary
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glProgramParameteri)(GLuint, GLenum, GLint);
+#define glProgramParameteri sf_ptrc_glProgramParameteri
+#endif /*GL_ARB_get_program_binary*/
+
+#ifndef GL_KHR_parallel_shader_compile
+#define GL_KHR_parallel_shader_compile 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glMaxShaderCompilerThreadsKHR)(GLuint);
+#define glMaxShaderCompilerThreadsKHR sf_ptrc_glMaxShaderCompilerThreadsKHR
+#endif /*GL_KHR_parallel_shader_compile*/
+
+#ifndef GL_EXT_framebuffer_multisample
+#define GL_EXT_framebuffer_multisample 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glRenderbufferStorageMultisampleEXT)(GLenum, GLsizei, GLenum, GLsizei, GLsizei);
+#define glRenderbufferStorageMultisampleEXT sf_ptrc_glRenderbufferStorageMultisampleEXT
+#endif /*GL_EXT_framebuffer_multisample*/
+
+#ifndef GL_EXT_framebuffer_blit
+#define GL_EXT_framebuffer_blit 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glBlitFramebufferEXT)(GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLbitfield, GLenum);
+#define glBlitFramebufferEXT sf_ptrc_glBlitFramebufferEXT
+#endif /*GL_EXT_framebuffer_blit*/
+
+#ifndef GL_ARB_draw_buffers
+#define GL_ARB_draw_buffers 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glDrawBuffersARB)(GLsizei, const GLenum *);
+#define glDrawBuffersARB sf_ptrc_glDrawBuffersARB
+#endif /*GL_ARB_draw_buffers*/
+
+#ifndef GL_ARB_occlusion_query
+#define GL_ARB_occlusion_query 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glBeginQueryARB)(GLenum, GLuint);
+#define glBeginQueryARB sf_ptrc_glBeginQueryARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glDeleteQueriesARB)(GLsizei, const GLuint *);
+#define glDeleteQueriesARB sf_ptrc_glDeleteQueriesARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glEndQueryARB)(GLenum);
+#define glEndQueryARB sf_ptrc_glEndQueryARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGenQueriesARB)(GLsizei, GLuint *);
+#define glGenQueriesARB sf_ptrc_glGenQueriesARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGetQueryObjectivARB)(GLuint, GLenum, GLint *);
+#define glGetQueryObjectivARB sf_ptrc_glGetQueryObjectivARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGetQueryObjectuivARB)(GLuint, GLenum, GLuint *);
+#define glGetQueryObjectuivARB sf_ptrc_glGetQueryObjectuivARB
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGetQueryivARB)(GLenum, GLenum, GLint *);
+#define glGetQueryivARB sf_ptrc_glGetQueryivARB
+extern GLboolean (CODEGEN_FUNCPTR *sf_ptrc_glIsQueryARB)(GLuint);
+#define glIsQueryARB sf_ptrc_glIsQueryARB
+#endif /*GL_ARB_occlusion_query*/
+
+#ifndef GL_ARB_timer_query
+#define GL_ARB_timer_query 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGetQueryObjecti64v)(GLuint, GLenum, GLint64 *);
+#define glGetQueryObjecti64v sf_ptrc_glGetQueryObjecti64v
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGetQueryObjectui64v)(GLuint, GLenum, GLuint64 *);
+#define glGetQueryObjectui64v sf_ptrc_glGetQueryObjectui64v
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glQueryCounter)(GLuint, GLenum);
+#define glQueryCounter sf_ptrc_glQueryCounter
+#endif /*GL_ARB_timer_query*/
+
+#ifndef GL_ARB_sampler_objects
+#define GL_ARB_sampler_objects 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glBindSampler)(GLuint, GLuint);
+#define glBindSampler sf_ptrc_glBindSampler
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glDeleteSamplers)(GLsizei, const GLuint *);
+#define glDeleteSamplers sf_ptrc_glDeleteSamplers
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glGenSamplers)(GLsizei, GLuint *);
+#define glGenSamplers sf_ptrc_glGenSamplers
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glSamplerParameteri)(GLuint, GLenum, GLint);
+#define glSamplerParameteri sf_ptrc_glSamplerParameteri
+#endif /*GL_ARB_sampler_objects*/
+
+#ifndef GL_ARB_compute_shader
+#define GL_ARB_compute_shader 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glDispatchCompute)(GLuint, GLuint, GLuint);
+#define glDispatchCompute sf_ptrc_glDispatchCompute
+#endif /*GL_ARB_compute_shader*/
+
+#ifndef GL_ARB_shader_image_load_store
+#define GL_ARB_shader_image_load_store 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glBindImageTexture)(GLuint, GLuint, GLint, GLboolean, GLint, GLenum, GLenum);
+#define glBindImageTexture sf_ptrc_glBindImageTexture
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glMemoryBarrier)(GLbitfield);
+#define glMemoryBarrier sf_ptrc_glMemoryBarrier
+#endif /*GL_ARB_shader_image_load_store*/
+
+#ifndef GL_ARB_shader_storage_buffer_object
+#define GL_ARB_shader_storage_buffer_object 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glShaderStorageBlockBinding)(GLuint, GLuint, GLuint);
+#define glShaderStorageBlockBinding sf_ptrc_glShaderStorageBlockBinding
+#endif /*GL_ARB_shader_storage_buffer_object*/
+
+#ifndef GL_ARB_program_interface_query
+#define GL_ARB_program_interface_query 1
+extern GLuint (CODEGEN_FUNCPTR *sf_ptrc_glGetProgramResourceIndex)(GLuint, GLenum, const GLchar*);
+#define glGetProgramResourceIndex sf_ptrc_glGetProgramResourceIndex
+#endif /*GL_ARB_program_interface_query*/
+
+#ifndef GL_KHR_debug
+#define GL_KHR_debug 1
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glDebugMessageCallback)(GLDEBUGPROC, const void*);
+#define glDebugMessageCallback sf_ptrc_glDebugMessageCallback
+extern void (CODEGEN_FUNCPTR *sf_ptrc_glDebugMessageControl)(GLenum, GLenum, GLenum, GLsizei, const GLuint*, GLboolean);
+#define glDebugMessageControl sf_ptrc_glDebugMessageControl
+#endif /*GL_KHR_debug*/
+
 GLAPI void APIENTRY glBlendFunc(GLenum, GLenum);
 GLAPI void APIENTRY glClear(GLbitfield);
 GLAPI void APIENTRY glClearColor(GLfloat, GLfloat, GLfloat, GLfloat);
 GLAPI void APIENTRY glClearDepth(GLdouble);
 GLAPI void APIENTRY glClearStencil(GLint);
 GLAPI void APIENTRY glClipPlane(GLenum, const GLdouble *);
+GLAPI void APIENTRY glColor4ub(GLubyte, GLubyte, GLubyte, GLubyte);
 GLAPI void APIENTRY glColorMask(GLboolean, GLboolean, GLboolean, GLboolean);
 GLAPI void APIENTRY glCopyPixels(GLint, GLint, GLsizei, GLsizei, GLenum);
 GLAPI void APIENTRY glCullFace(GLenum);
@@ -989,6 +1419,7 @@ GLAPI void APIENTRY glMatrixMode(GLenum);
 GLAPI void APIENTRY glMultMatrixd(const GLdouble *);
 GLAPI void APIENTRY glMultMatrixf(const GLfloat *);
 GLAPI void APIENTRY glOrtho(GLdouble, GLdouble, GLdouble, GLdouble, GLdouble, GLdouble);
+GLAPI void APIENTRY glPixelStorei(GLenum, GLint);
 GLAPI void APIENTRY glPointSize(GLfloat);
 GLAPI void APIENTRY glPopAttrib();
 GLAPI void APIENTRY glPopMatrix();
@@ -1033,12 +1464,21 @@ GLAPI void APIENTRY glVertexPointer(GLint, GLenum, GLsizei, const GLvoid *);
 
 enum sfogl_LoadStatus
 {
+    sfogl_LOAD_PENDING = -1,
     sfogl_LOAD_FAILED = 0,
     sfogl_LOAD_SUCCEEDED = 1
 };
 
 int sfogl_LoadFunctions();
 
+/* The functions of the available extensions are only loaded when they are first needed */
+int sfogl_LoadPendingExtension(int *extensionVariable);
+
+inline int sfogl_LoadExtension(int *extensionVariable)
+{
+    return (*extensionVariable == sfogl_LOAD_PENDING) ? sfogl_LoadPendingExtension(extensionVariable) : *extensionVariable;
+}
+
 int sfogl_GetMinorVersion();
 int sfogl_GetMajorVersion();
 int sfogl_IsVersionGEQ(int majorVersion, int minorVersion);
@@ -0,0 +1,322 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GLStateCache.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/ThreadLocalPtr.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <cstring>
+#include <vector>
+
+
+#if !defined(GL_CONTEXT_PROFILE_MASK)
+    #define GL_CONTEXT_PROFILE_MASK 0x9126
+#endif
+
+#if !defined(GL_CONTEXT_CORE_PROFILE_BIT)
+    #define GL_CONTEXT_CORE_PROFILE_BIT 0x00000001
+#endif
+
+
+namespace
+{
+    // Texture targets whose bindings are tracked
+    enum Target
+    {
+        Texture2D,
+        Texture2DArray,
+        TargetCount,
+        Untracked = TargetCount
+    };
+
+    // Number of texture units tracked per target; bindings of the following units always reach OpenGL
+    const unsigned int unitCount = 16;
+
+    // States of the context active on a thread, as far as SFML knows them
+    struct ThreadState
+    {
+        sf::Uint64           context;                          // Context that the cached states belong to
+        sf::Uint32           generation;                       // Value of textureGeneration when the cache was filled
+        int                  activeUnit;                       // Active texture unit, -1 if unknown
+        GLuint               bindings[TargetCount][unitCount]; // Bound textures
+        bool                 known[TargetCount][unitCount];    // Whether the bindings are known
+        sf::priv::GlCounters counters;                         // OpenGL calls issued by the thread
+        sf::Uint64           profileContext;                   // Context whose profile is known
+        bool                 coreProfile;                      // Whether profileContext is a core-profile context
+    };
+
+    // This per-thread variable holds the states of each thread
+    sf::ThreadLocalPtr<ThreadState> threadState(NULL);
+
+    // Incremented every time a texture is deleted, so that all the caches are invalidated.
+    // Reads are not synchronized: the thread that reuses the name of a deleted texture
+    // must receive the sf::Texture from the deleting thread, which already synchronizes them
+    volatile sf::Uint32 textureGeneration = 0;
+    sf::Mutex textureGenerationMutex;
+
+    // States of all the threads, destroyed at exit
+    struct StateList
+    {
+        ~StateList()
+        {
+            for (std::vector<ThreadState*>::iterator it = states.begin(); it != states.end(); ++it)
+                delete *it;
+
+            destroyed = true;
+        }
+
+        std::vector<ThreadState*> states;
+        static bool               destroyed;
+    };
+
+    bool StateList::destroyed = false;
+    StateList stateList;
+    sf::Mutex stateListMutex;
+
+    // Used by the OpenGL calls made after the states were destroyed (global resources)
+    ThreadState exitState;
+
+    // Forget everything known about the OpenGL states
+    void clearStates(ThreadState& state)
+    {
+        state.activeUnit = -1;
+        std::memset(state.known, 0, sizeof(state.known));
+    }
+
+    // Get the states of the calling thread
+    ThreadState& getThreadState()
+    {
+        if (StateList::destroyed)
+            return exitState;
+
+        ThreadState* state = threadState;
+        if (!state)
+        {
+            state = new ThreadState;
+            std::memset(state, 0, sizeof(ThreadState));
+            clearStates(*state);
+
+            sf::Lock lock(stateListMutex);
+            stateList.states.push_back(state);
+            threadState = state;
+        }
+
+        return *state;
+    }
+
+    // Get the states of the calling thread, valid for the active context
+    ThreadState& getCache()
+    {
+        ThreadState& state = getThreadState();
+
+        sf::Uint64 context = sf::Context::getActiveContextId();
+        sf::Uint32 generation = textureGeneration;
+        if ((state.context != context) || (state.generation != generation))
+        {
+            clearStates(state);
+            state.context = context;
+            state.generation = generation;
+        }
+
+        return state;
+    }
+
+    // Find the cache slot of a texture target
+    Target getTarget(GLenum target)
+    {
+        if (target == GL_TEXTURE_2D)
+            return Texture2D;
+
+    #ifndef SFML_OPENGL_ES
+        if (target == GLEXT_GL_TEXTURE_2D_ARRAY)
+            return Texture2DArray;
+    #endif
+
+        return Untracked;
+    }
+
+    // Make sure that the active texture unit is known
+    int getActiveUnit(ThreadState& state)
+    {
+        if (state.activeUnit < 0)
+        {
+            if (GLEXT_multitexture)
+            {
+                GLint unit = GLEXT_GL_TEXTURE0;
+                glCheck(glGetIntegerv(GLEXT_GL_ACTIVE_TEXTURE, &unit));
+                ++state.counters.stateQueries;
+                state.activeUnit = unit - GLEXT_GL_TEXTURE0;
+            }
+            else
+            {
+                state.activeUnit = 0;
+            }
+        }
+
+        return state.activeUnit;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void countGlCall()
+{
+    ++getThreadState().counters.calls;
+}
+
+
+////////////////////////////////////////////////////////////
+void countDrawCall()
+{
+    ++getThreadState().counters.drawCalls;
+}
+
+
+////////////////////////////////////////////////////////////
+GlCounters& getGlCounters()
+{
+    return getThreadState().counters;
+}
+
+
+////////////////////////////////////////////////////////////
+void bindTexture(GLenum target, GLuint texture, bool force)
+{
+    ThreadState& state = getCache();
+
+    Target slot = getTarget(target);
+    int unit = getActiveUnit(state);
+    if ((slot == Untracked) || (unit < 0) || (unit >= static_cast<int>(unitCount)))
+    {
+        glCheck(glBindTexture(target, texture));
+        ++state.counters.textureBinds;
+        return;
+    }
+
+    if (!force && state.known[slot][unit] && (state.bindings[slot][unit] == texture))
+    {
+        ++state.counters.redundantTextureBinds;
+        return;
+    }
+
+    glCheck(glBindTexture(target, texture));
+    ++state.counters.textureBinds;
+
+    state.bindings[slot][unit] = texture;
+    state.known[slot][unit] = true;
+}
+
+
+////////////////////////////////////////////////////////////
+GLuint getTextureBinding(GLenum target, GLenum binding)
+{
+    ThreadState& state = getCache();
+
+    Target slot = getTarget(target);
+    int unit = getActiveUnit(state);
+    bool tracked = (slot != Untracked) && (unit >= 0) && (unit < static_cast<int>(unitCount));
+    if (tracked && state.known[slot][unit])
+        return state.bindings[slot][unit];
+
+    GLint texture = 0;
+    glCheck(glGetIntegerv(binding, &texture));
+    ++state.counters.stateQueries;
+
+    if (tracked)
+    {
+        state.bindings[slot][unit] = static_cast<GLuint>(texture);
+        state.known[slot][unit] = true;
+    }
+
+    return static_cast<GLuint>(texture);
+}
+
+
+////////////////////////////////////////////////////////////
+void setActiveTextureUnit(unsigned int unit)
+{
+    ThreadState& state = getCache();
+
+    if (state.activeUnit == static_cast<int>(unit))
+        return;
+
+    glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0 + unit));
+    state.activeUnit = static_cast<int>(unit);
+}
+
+
+////////////////////////////////////////////////////////////
+void notifyTextureDeleted()
+{
+    Lock lock(textureGenerationMutex);
+    textureGeneration = textureGeneration + 1;
+}
+
+
+////////////////////////////////////////////////////////////
+bool isCoreProfile()
+{
+    ThreadState& state = getThreadState();
+
+    sf::Uint64 context = sf::Context::getActiveContextId();
+    if (state.profileContext != context)
+    {
+        state.coreProfile = false;
+        state.profileContext = context;
+
+    #ifndef SFML_OPENGL_ES
+        // Profiles only exist since OpenGL 3.2, older versions would fail the query
+        const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+        if (version && ((version[0] > '3') || ((version[0] == '3') && (version[1] == '.') && (version[2] >= '2'))))
+        {
+            GLint mask = 0;
+            glCheck(glGetIntegerv(GL_CONTEXT_PROFILE_MASK, &mask));
+            ++state.counters.stateQueries;
+            state.coreProfile = (mask & GL_CONTEXT_CORE_PROFILE_BIT) != 0;
+        }
+    #endif
+    }
+
+    return state.coreProfile;
+}
+
+
+////////////////////////////////////////////////////////////
+void invalidateGLStateCache()
+{
+    clearStates(getThreadState());
+}
+
+} // namespace priv
+
+} // namespace sf
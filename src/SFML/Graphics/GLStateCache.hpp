@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_GLSTATECACHE_HPP
+#define SFML_GLSTATECACHE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/Graphics/GLExtensions.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief OpenGL calls issued by the calling thread
+///
+////////////////////////////////////////////////////////////
+struct GlCounters
+{
+    Uint64 calls;                 ///< OpenGL functions called through glCheck
+    Uint64 drawCalls;             ///< Draw calls (glDrawArrays and variants)
+    Uint64 textureBinds;          ///< glBindTexture calls issued
+    Uint64 redundantTextureBinds; ///< glBindTexture calls skipped because the texture was already bound
+    Uint64 stateQueries;          ///< glGet calls issued to fill the state cache
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Count an OpenGL call (used by the glCheck macro)
+///
+////////////////////////////////////////////////////////////
+void countGlCall();
+
+////////////////////////////////////////////////////////////
+/// \brief Count a draw call
+///
+////////////////////////////////////////////////////////////
+void countDrawCall();
+
+////////////////////////////////////////////////////////////
+/// \brief Access the counters of the calling thread
+///
+/// \return Counters of the calling thread
+///
+////////////////////////////////////////////////////////////
+GlCounters& getGlCounters();
+
+////////////////////////////////////////////////////////////
+/// \brief Bind a texture, unless it is already bound
+///
+/// The bindings of GL_TEXTURE_2D and GL_TEXTURE_2D_ARRAY are
+/// tracked per texture unit for the context active on the
+/// calling thread; other targets are always bound.
+///
+/// \param target  Texture target
+/// \param texture OpenGL identifier of the texture, or 0
+/// \param force   Issue the call even if the cache says it's redundant
+///
+////////////////////////////////////////////////////////////
+void bindTexture(GLenum target, GLuint texture, bool force = false);
+
+////////////////////////////////////////////////////////////
+/// \brief Get the texture bound to a target of the active unit
+///
+/// OpenGL is only queried when the binding is not known yet.
+///
+/// \param target  Texture target (GL_TEXTURE_2D, ...)
+/// \param binding Query that returns the target's binding
+///
+/// \return OpenGL identifier of the bound texture
+///
+////////////////////////////////////////////////////////////
+GLuint getTextureBinding(GLenum target, GLenum binding);
+
+////////////////////////////////////////////////////////////
+/// \brief Change the active texture unit
+///
+/// \param unit Index of the texture unit (0 for GL_TEXTURE0)
+///
+////////////////////////////////////////////////////////////
+void setActiveTextureUnit(unsigned int unit);
+
+////////////////////////////////////////////////////////////
+/// \brief Notify the cache that a texture was deleted
+///
+/// OpenGL may reuse the name of a deleted texture, while the
+/// texture stays bound in other contexts: the caches of all
+/// the threads are invalidated.
+///
+////////////////////////////////////////////////////////////
+void notifyTextureDeleted();
+
+////////////////////////////////////////////////////////////
+/// \brief Tell whether the active context uses a core profile
+///
+/// The profile is queried once per context; it's never
+/// forgotten, since it can't change.
+///
+/// \return True if the active context is a core-profile context
+///
+////////////////////////////////////////////////////////////
+bool isCoreProfile();
+
+////////////////////////////////////////////////////////////
+/// \brief Forget everything known about the current context
+///
+/// This must be called when the OpenGL states may have been
+/// changed behind SFML's back (glPopAttrib, user code).
+///
+////////////////////////////////////////////////////////////
+void invalidateGLStateCache();
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_GLSTATECACHE_HPP
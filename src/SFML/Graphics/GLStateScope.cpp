@@ -0,0 +1,395 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GLStateScope.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/CoreRenderer.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
+
+
+#ifndef SFML_OPENGL_ES
+
+#if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
+
+    #define castToGlHandle(x) reinterpret_cast<GLEXT_GLhandle>(static_cast<ptrdiff_t>(x))
+    #define castFromGlHandle(x) static_cast<unsigned int>(reinterpret_cast<ptrdiff_t>(x))
+
+#else
+
+    #define castToGlHandle(x) (x)
+    #define castFromGlHandle(x) (x)
+
+#endif
+
+#endif
+
+
+namespace
+{
+    // Names of the queries of the vertex arrays, in the order of GLStateScope::m_arrays
+    const GLenum arrayNames[3][5] =
+    {
+        {GL_VERTEX_ARRAY,        GL_VERTEX_ARRAY_SIZE,        GL_VERTEX_ARRAY_TYPE,        GL_VERTEX_ARRAY_STRIDE,        GL_VERTEX_ARRAY_POINTER},
+        {GL_COLOR_ARRAY,         GL_COLOR_ARRAY_SIZE,         GL_COLOR_ARRAY_TYPE,         GL_COLOR_ARRAY_STRIDE,         GL_COLOR_ARRAY_POINTER},
+        {GL_TEXTURE_COORD_ARRAY, GL_TEXTURE_COORD_ARRAY_SIZE, GL_TEXTURE_COORD_ARRAY_TYPE, GL_TEXTURE_COORD_ARRAY_STRIDE, GL_TEXTURE_COORD_ARRAY_POINTER}
+    };
+
+    const GLenum arrayBufferBindings[3] =
+    {
+        GLEXT_GL_VERTEX_ARRAY_BUFFER_BINDING,
+        GLEXT_GL_COLOR_ARRAY_BUFFER_BINDING,
+        GLEXT_GL_TEXTURE_COORD_ARRAY_BUFFER_BINDING
+    };
+
+    // Query an integer state
+    int getInteger(GLenum name)
+    {
+        GLint value = 0;
+        glCheck(glGetIntegerv(name, &value));
+        return value;
+    }
+
+    // Query whether a capability is enabled
+    bool isEnabled(GLenum capability)
+    {
+        GLboolean enabled = glCheck(glIsEnabled(capability));
+        return enabled != GL_FALSE;
+    }
+
+    // Enable or disable a capability
+    void setEnabled(GLenum capability, bool enabled)
+    {
+        if (enabled)
+        {
+            glCheck(glEnable(capability));
+        }
+        else
+        {
+            glCheck(glDisable(capability));
+        }
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+GLStateScope::GLStateScope(RenderTarget& target) :
+m_target     (target),
+m_saved      (false),
+m_coreProfile(false)
+{
+    // Pending primitives were batched with SFML's states
+    target.flush();
+
+    if (!target.activate(true))
+        return;
+
+    priv::ensureExtensionsInit();
+    m_coreProfile = priv::isCoreProfile();
+
+    // States shared by all the profiles
+    glCheck(glGetIntegerv(GL_VIEWPORT, m_viewport));
+    glCheck(glGetIntegerv(GL_SCISSOR_BOX, m_scissorBox));
+
+    m_blend       = isEnabled(GL_BLEND);
+    m_depthTest   = isEnabled(GL_DEPTH_TEST);
+    m_scissorTest = isEnabled(GL_SCISSOR_TEST);
+    m_stencilTest = isEnabled(GL_STENCIL_TEST);
+    m_cullFace    = isEnabled(GL_CULL_FACE);
+
+    if (GLEXT_blend_func_separate)
+    {
+        m_blendFunction[0] = getInteger(GLEXT_GL_BLEND_SRC_RGB);
+        m_blendFunction[1] = getInteger(GLEXT_GL_BLEND_DST_RGB);
+        m_blendFunction[2] = getInteger(GLEXT_GL_BLEND_SRC_ALPHA);
+        m_blendFunction[3] = getInteger(GLEXT_GL_BLEND_DST_ALPHA);
+    }
+    else
+    {
+        m_blendFunction[0] = m_blendFunction[2] = getInteger(GL_BLEND_SRC);
+        m_blendFunction[1] = m_blendFunction[3] = getInteger(GL_BLEND_DST);
+    }
+
+    if (GLEXT_blend_minmax && GLEXT_blend_subtract)
+    {
+        if (GLEXT_blend_equation_separate)
+        {
+            m_blendEquation[0] = getInteger(GLEXT_GL_BLEND_EQUATION_RGB);
+            m_blendEquation[1] = getInteger(GLEXT_GL_BLEND_EQUATION_ALPHA);
+        }
+        else
+        {
+            m_blendEquation[0] = m_blendEquation[1] = getInteger(GLEXT_GL_BLEND_EQUATION);
+        }
+    }
+
+    GLboolean depthMask = GL_TRUE;
+    glCheck(glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMask));
+    m_depthMask = (depthMask != GL_FALSE);
+    m_depthFunction = getInteger(GL_DEPTH_FUNC);
+
+    m_stencilFunction[0]  = getInteger(GL_STENCIL_FUNC);
+    m_stencilFunction[1]  = getInteger(GL_STENCIL_REF);
+    m_stencilFunction[2]  = getInteger(GL_STENCIL_VALUE_MASK);
+    m_stencilOperation[0] = getInteger(GL_STENCIL_FAIL);
+    m_stencilOperation[1] = getInteger(GL_STENCIL_PASS_DEPTH_FAIL);
+    m_stencilOperation[2] = getInteger(GL_STENCIL_PASS_DEPTH_PASS);
+    m_stencilWriteMask    = getInteger(GL_STENCIL_WRITEMASK);
+    m_stencilClear        = getInteger(GL_STENCIL_CLEAR_VALUE);
+
+    GLboolean colorMask[4];
+    glCheck(glGetBooleanv(GL_COLOR_WRITEMASK, colorMask));
+    for (int i = 0; i < 4; ++i)
+        m_colorMask[i] = (colorMask[i] != GL_FALSE);
+    glCheck(glGetFloatv(GL_COLOR_CLEAR_VALUE, m_clearColor));
+
+    // SFML only binds textures to the first unit
+    m_activeTexture = GLEXT_GL_TEXTURE0;
+    if (GLEXT_multitexture)
+    {
+        m_activeTexture = getInteger(GLEXT_GL_ACTIVE_TEXTURE);
+        glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0));
+    }
+    m_texture = getInteger(GL_TEXTURE_BINDING_2D);
+
+    m_sampler = 0;
+    #ifndef SFML_OPENGL_ES
+        if (GLEXT_sampler_objects)
+            m_sampler = getInteger(GLEXT_GL_SAMPLER_BINDING);
+    #endif
+
+    if (!m_coreProfile)
+    {
+        // States of the fixed-function pipeline
+        m_lighting  = isEnabled(GL_LIGHTING);
+        m_alphaTest = isEnabled(GL_ALPHA_TEST);
+        m_texture2D = isEnabled(GL_TEXTURE_2D);
+
+        m_program = 0;
+        #ifndef SFML_OPENGL_ES
+            if (GLEXT_shader_objects)
+            {
+                GLEXT_GLhandle program = glCheck(GLEXT_glGetHandle(GLEXT_GL_PROGRAM_OBJECT));
+                m_program = castFromGlHandle(program);
+            }
+        #endif
+
+        // The texture coordinates array is the one of the first unit too
+        m_clientActiveTexture = GLEXT_GL_TEXTURE0;
+        if (GLEXT_multitexture)
+        {
+            m_clientActiveTexture = getInteger(GLEXT_GL_CLIENT_ACTIVE_TEXTURE);
+            glCheck(GLEXT_glClientActiveTexture(GLEXT_GL_TEXTURE0));
+        }
+
+        m_arrayBuffer = GLEXT_vertex_buffer_object ? getInteger(GLEXT_GL_ARRAY_BUFFER_BINDING) : 0;
+        for (int i = 0; i < 3; ++i)
+        {
+            ArrayState& array = m_arrays[i];
+            array.enabled = isEnabled(arrayNames[i][0]);
+            array.buffer  = GLEXT_vertex_buffer_object ? static_cast<unsigned int>(getInteger(arrayBufferBindings[i])) : 0;
+            array.size    = getInteger(arrayNames[i][1]);
+            array.type    = static_cast<unsigned int>(getInteger(arrayNames[i][2]));
+            array.stride  = getInteger(arrayNames[i][3]);
+            array.pointer = NULL;
+            glCheck(glGetPointerv(arrayNames[i][4], &array.pointer));
+        }
+
+        // The matrices are saved on their stacks, which is cheaper than reading them back
+        m_matrixMode = getInteger(GL_MATRIX_MODE);
+        glCheck(glMatrixMode(GL_TEXTURE));
+        glCheck(glPushMatrix());
+        glCheck(glMatrixMode(GL_PROJECTION));
+        glCheck(glPushMatrix());
+        glCheck(glMatrixMode(GL_MODELVIEW));
+        glCheck(glPushMatrix());
+    }
+
+    // SFML's states are unknown now, the next draw sets them again
+    priv::invalidateGLStateCache();
+    target.m_cache.glStatesSet = false;
+    target.m_cache.lastShaderId = 0;
+
+    m_saved = true;
+}
+
+
+////////////////////////////////////////////////////////////
+GLStateScope::~GLStateScope()
+{
+    if (!m_saved)
+        return;
+
+    // Pending primitives must be drawn with SFML's states
+    m_target.flush();
+
+    if (!m_target.activate(true))
+        return;
+
+    // The core-profile renderer only binds its program and vertex array once SFML's states are set
+    bool statesSet = m_target.m_cache.glStatesSet;
+
+    if (GLEXT_multitexture)
+    {
+        glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0));
+    }
+    glCheck(glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(m_texture)));
+
+    #ifndef SFML_OPENGL_ES
+        if (GLEXT_sampler_objects)
+        {
+            glCheck(GLEXT_glBindSampler(0, static_cast<GLuint>(m_sampler)));
+        }
+    #endif
+
+    if (m_coreProfile)
+    {
+        if (statesSet && m_target.m_coreRenderer)
+            m_target.m_coreRenderer->unbind();
+    }
+    else
+    {
+        glCheck(glMatrixMode(GL_TEXTURE));
+        glCheck(glPopMatrix());
+        glCheck(glMatrixMode(GL_PROJECTION));
+        glCheck(glPopMatrix());
+        glCheck(glMatrixMode(GL_MODELVIEW));
+        glCheck(glPopMatrix());
+        glCheck(glMatrixMode(static_cast<GLenum>(m_matrixMode)));
+
+        setEnabled(GL_LIGHTING, m_lighting);
+        setEnabled(GL_ALPHA_TEST, m_alphaTest);
+        setEnabled(GL_TEXTURE_2D, m_texture2D);
+
+        #ifndef SFML_OPENGL_ES
+            if (GLEXT_shader_objects)
+            {
+                glCheck(GLEXT_glUseProgramObject(castToGlHandle(m_program)));
+            }
+        #endif
+
+        if (GLEXT_multitexture)
+        {
+            glCheck(GLEXT_glClientActiveTexture(GLEXT_GL_TEXTURE0));
+        }
+
+        // The pointers refer to the buffer that was bound when they were set
+        for (int i = 0; i < 3; ++i)
+        {
+            const ArrayState& array = m_arrays[i];
+            if (GLEXT_vertex_buffer_object)
+            {
+                glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, array.buffer));
+            }
+
+            switch (i)
+            {
+                case 0:  glCheck(glVertexPointer(array.size, array.type, array.stride, array.pointer)); break;
+                case 1:  glCheck(glColorPointer(array.size, array.type, array.stride, array.pointer)); break;
+                default: glCheck(glTexCoordPointer(array.size, array.type, array.stride, array.pointer)); break;
+            }
+
+            if (array.enabled)
+            {
+                glCheck(glEnableClientState(arrayNames[i][0]));
+            }
+            else
+            {
+                glCheck(glDisableClientState(arrayNames[i][0]));
+            }
+        }
+
+        if (GLEXT_vertex_buffer_object)
+        {
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, static_cast<GLuint>(m_arrayBuffer)));
+        }
+
+        if (GLEXT_multitexture)
+        {
+            glCheck(GLEXT_glClientActiveTexture(static_cast<GLenum>(m_clientActiveTexture)));
+        }
+    }
+
+    if (GLEXT_multitexture)
+    {
+        glCheck(GLEXT_glActiveTexture(static_cast<GLenum>(m_activeTexture)));
+    }
+
+    // States shared by all the profiles
+    setEnabled(GL_BLEND, m_blend);
+    setEnabled(GL_DEPTH_TEST, m_depthTest);
+    setEnabled(GL_SCISSOR_TEST, m_scissorTest);
+    setEnabled(GL_STENCIL_TEST, m_stencilTest);
+    setEnabled(GL_CULL_FACE, m_cullFace);
+
+    if (GLEXT_blend_func_separate)
+    {
+        glCheck(GLEXT_glBlendFuncSeparate(static_cast<GLenum>(m_blendFunction[0]), static_cast<GLenum>(m_blendFunction[1]),
+                                          static_cast<GLenum>(m_blendFunction[2]), static_cast<GLenum>(m_blendFunction[3])));
+    }
+    else
+    {
+        glCheck(glBlendFunc(static_cast<GLenum>(m_blendFunction[0]), static_cast<GLenum>(m_blendFunction[1])));
+    }
+
+    if (GLEXT_blend_minmax && GLEXT_blend_subtract)
+    {
+        if (GLEXT_blend_equation_separate)
+        {
+            glCheck(GLEXT_glBlendEquationSeparate(static_cast<GLenum>(m_blendEquation[0]), static_cast<GLenum>(m_blendEquation[1])));
+        }
+        else
+        {
+            glCheck(GLEXT_glBlendEquation(static_cast<GLenum>(m_blendEquation[0])));
+        }
+    }
+
+    glCheck(glDepthFunc(static_cast<GLenum>(m_depthFunction)));
+    glCheck(glDepthMask(m_depthMask ? GL_TRUE : GL_FALSE));
+
+    glCheck(glStencilFunc(static_cast<GLenum>(m_stencilFunction[0]), m_stencilFunction[1], static_cast<GLuint>(m_stencilFunction[2])));
+    glCheck(glStencilOp(static_cast<GLenum>(m_stencilOperation[0]), static_cast<GLenum>(m_stencilOperation[1]),
+                        static_cast<GLenum>(m_stencilOperation[2])));
+    glCheck(glStencilMask(static_cast<GLuint>(m_stencilWriteMask)));
+    glCheck(glClearStencil(m_stencilClear));
+
+    glCheck(glColorMask(m_colorMask[0] ? GL_TRUE : GL_FALSE, m_colorMask[1] ? GL_TRUE : GL_FALSE,
+                        m_colorMask[2] ? GL_TRUE : GL_FALSE, m_colorMask[3] ? GL_TRUE : GL_FALSE));
+    glCheck(glClearColor(m_clearColor[0], m_clearColor[1], m_clearColor[2], m_clearColor[3]));
+
+    glCheck(glViewport(m_viewport[0], m_viewport[1], m_viewport[2], m_viewport[3]));
+    glCheck(glScissor(m_scissorBox[0], m_scissorBox[1], m_scissorBox[2], m_scissorBox[3]));
+
+    // The restored states are not SFML's
+    priv::invalidateGLStateCache();
+    m_target.m_cache.glStatesSet = false;
+    m_target.m_cache.lastShaderId = 0;
+}
+
+} // namespace sf
@@ -0,0 +1,238 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GpuProfiler.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <deque>
+#include <map>
+#include <vector>
+
+
+#ifndef SFML_OPENGL_ES
+
+namespace
+{
+    // Zones that a context can have in flight, the others are dropped
+    const std::size_t maxPendingZones = 1024;
+
+    // Marks the open zones that were dropped
+    const std::size_t droppedZone = static_cast<std::size_t>(-1);
+
+    // Zone waiting for its timestamps
+    struct PendingZone
+    {
+        const char*  name;
+        GLuint       begin;
+        GLuint       end;
+        unsigned int depth;
+        bool         ended;
+    };
+
+    // Queries of a context (query objects are not shared between contexts)
+    struct ContextZones
+    {
+        ContextZones() : collected(0), offset(0), calibrated(false) {}
+
+        std::vector<GLuint>      queries;   // free query objects
+        std::deque<PendingZone>  pending;   // zones in the order they began
+        std::vector<std::size_t> open;      // indices of the open zones, counting the collected ones
+        std::size_t              collected; // number of zones popped from the pending queue
+        sf::Int64                offset;    // profiler time minus GPU time, in nanoseconds
+        bool                     calibrated;
+    };
+
+    sf::Mutex                           gpuMutex;
+    std::map<sf::Uint64, ContextZones>  contexts;
+
+    // Get a free query object
+    GLuint acquireQuery(ContextZones& zones)
+    {
+        if (zones.queries.empty())
+        {
+            GLuint query = 0;
+            glCheck(GLEXT_glGenQueries(1, &query));
+            return query;
+        }
+
+        GLuint query = zones.queries.back();
+        zones.queries.pop_back();
+        return query;
+    }
+
+    // Get the queries of the active context, ready to be used
+    ContextZones& getContextZones()
+    {
+        ContextZones& zones = contexts[sf::Context::getActiveContextId()];
+
+        if (!zones.calibrated)
+        {
+            // Read a timestamp synchronously, to map the GPU clock to the profiler's clock
+            GLuint query = acquireQuery(zones);
+            GLuint64 timestamp = 0;
+            glCheck(GLEXT_glQueryCounter(query, GLEXT_GL_TIMESTAMP));
+            glCheck(GLEXT_glGetQueryObjectui64v(query, GLEXT_GL_QUERY_RESULT, &timestamp));
+            zones.offset = sf::Profiler::getTime() - static_cast<sf::Int64>(timestamp);
+            zones.queries.push_back(query);
+            zones.calibrated = true;
+        }
+
+        return zones;
+    }
+}
+
+#endif
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void beginGpuZone(const char* name)
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!GLEXT_timer_query)
+        return;
+
+    Lock lock(gpuMutex);
+    ContextZones& zones = getContextZones();
+
+    if (zones.pending.size() >= maxPendingZones)
+    {
+        zones.open.push_back(droppedZone);
+        return;
+    }
+
+    PendingZone zone = {name, acquireQuery(zones), 0, static_cast<unsigned int>(zones.open.size()), false};
+    glCheck(GLEXT_glQueryCounter(zone.begin, GLEXT_GL_TIMESTAMP));
+
+    zones.open.push_back(zones.collected + zones.pending.size());
+    zones.pending.push_back(zone);
+
+#else
+
+    // Timer queries are not available on OpenGL ES
+    (void)name;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void endGpuZone()
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!GLEXT_timer_query)
+        return;
+
+    Lock lock(gpuMutex);
+    ContextZones& zones = getContextZones();
+
+    if (zones.open.empty())
+        return;
+
+    std::size_t index = zones.open.back();
+    zones.open.pop_back();
+    if (index == droppedZone)
+        return;
+
+    PendingZone& zone = zones.pending[index - zones.collected];
+    zone.end = acquireQuery(zones);
+    zone.ended = true;
+    glCheck(GLEXT_glQueryCounter(zone.end, GLEXT_GL_TIMESTAMP));
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void collectGpuZones()
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!GLEXT_timer_query || !Profiler::isEnabled())
+        return;
+
+    Lock lock(gpuMutex);
+    ContextZones& zones = getContextZones();
+
+    // Zones end in order on the GPU: stop at the first one which is not finished
+    while (!zones.pending.empty() && zones.pending.front().ended)
+    {
+        PendingZone& zone = zones.pending.front();
+
+        GLuint available = 0;
+        glCheck(GLEXT_glGetQueryObjectuiv(zone.end, GLEXT_GL_QUERY_RESULT_AVAILABLE, &available));
+        if (!available)
+            break;
+
+        GLuint64 begin = 0;
+        GLuint64 end = 0;
+        glCheck(GLEXT_glGetQueryObjectui64v(zone.begin, GLEXT_GL_QUERY_RESULT, &begin));
+        glCheck(GLEXT_glGetQueryObjectui64v(zone.end, GLEXT_GL_QUERY_RESULT, &end));
+
+        Profiler::Zone result = {zone.name,
+                                 static_cast<Int64>(begin) + zones.offset,
+                                 static_cast<Int64>(end - begin),
+                                 Profiler::GpuThread,
+                                 zone.depth};
+        Profiler::addZone(result);
+
+        zones.queries.push_back(zone.begin);
+        zones.queries.push_back(zone.end);
+        zones.pending.pop_front();
+        ++zones.collected;
+    }
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+GpuZone::GpuZone(const char* name) :
+m_recording(Profiler::isEnabled())
+{
+    if (m_recording)
+        beginGpuZone(name);
+}
+
+
+////////////////////////////////////////////////////////////
+GpuZone::~GpuZone()
+{
+    if (m_recording)
+        endGpuZone();
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_GPUPROFILER_HPP
+#define SFML_GPUPROFILER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Profiler.hpp>
+
+
+////////////////////////////////////////////////////////////
+// Instrumentation macros, which expand to nothing unless
+// SFML_ENABLE_PROFILER is defined
+////////////////////////////////////////////////////////////
+#ifdef SFML_ENABLE_PROFILER
+
+    #define SFML_PROFILE_GPU_SCOPE(name) sf::priv::GpuZone SFML_PROFILER_CONCAT(sfGpuZone, __LINE__)(name)
+    #define SFML_PROFILE_GPU_COLLECT()   sf::priv::collectGpuZones()
+
+#else
+
+    #define SFML_PROFILE_GPU_SCOPE(name)
+    #define SFML_PROFILE_GPU_COLLECT()
+
+#endif
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Begin a GPU zone in the active context
+///
+/// A timestamp query is issued, its result is read later by
+/// collectGpuZones. Nothing happens if the profiler is
+/// disabled or if timer queries are not supported.
+///
+/// \param name Name of the zone (a literal)
+///
+////////////////////////////////////////////////////////////
+void beginGpuZone(const char* name);
+
+////////////////////////////////////////////////////////////
+/// \brief End the last GPU zone begun in the active context
+///
+////////////////////////////////////////////////////////////
+void endGpuZone();
+
+////////////////////////////////////////////////////////////
+/// \brief Submit the finished GPU zones of the active context
+///
+/// The zones whose queries are available are added to
+/// sf::Profiler; the others are kept for a later call,
+/// this function never waits for the GPU.
+///
+////////////////////////////////////////////////////////////
+void collectGpuZones();
+
+////////////////////////////////////////////////////////////
+/// \brief GPU zone which lasts as long as the object lives
+///
+////////////////////////////////////////////////////////////
+class GpuZone : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Begin the zone
+    ///
+    /// \param name Name of the zone (a literal)
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit GpuZone(const char* name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief End the zone
+    ///
+    ////////////////////////////////////////////////////////////
+    ~GpuZone();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    bool m_recording; ///< Was the profiler enabled when the zone began?
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_GPUPROFILER_HPP
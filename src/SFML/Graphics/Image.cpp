@@ -27,43 +27,294 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/ImageKernels.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/ConditionVariable.hpp>
+#include <SFML/System/Profiler.hpp>
 #include <SFML/System/Err.hpp>
-#ifdef SFML_SYSTEM_ANDROID
-    #include <SFML/System/Android/ResourceStream.hpp>
-#endif
 #include <algorithm>
 #include <cstring>
+#include <deque>
+#include <map>
+#include <set>
+#if defined(SFML_SYSTEM_WINDOWS)
+    #include <windows.h>
+#else
+    #include <unistd.h>
+#endif
+
+
+namespace
+{
+    // Find the source pixels and the interpolation weight (in [0, 256]) of each destination pixel of a line
+    void computeSamples(unsigned int sourceSize, unsigned int size, std::vector<unsigned int>& first,
+                        std::vector<unsigned int>& second, std::vector<unsigned int>& weights)
+    {
+        first.resize(size);
+        second.resize(size);
+        weights.resize(size);
+
+        // Pixel centers are aligned, so that the image doesn't shift
+        float scale = static_cast<float>(sourceSize) / size;
+        for (unsigned int i = 0; i < size; ++i)
+        {
+            float position = std::max((i + 0.5f) * scale - 0.5f, 0.f);
+            unsigned int index = std::min(static_cast<unsigned int>(position), sourceSize - 1);
+
+            first[i]   = index;
+            second[i]  = std::min(index + 1, sourceSize - 1);
+            weights[i] = static_cast<unsigned int>((position - index) * 256.f + 0.5f);
+        }
+    }
+
+    // Get the number of CPU cores, to size the pool of loading threads
+    unsigned int getCoreCount()
+    {
+    #if defined(SFML_SYSTEM_WINDOWS)
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        long count = static_cast<long>(info.dwNumberOfProcessors);
+    #else
+        long count = sysconf(_SC_NPROCESSORS_ONLN);
+    #endif
+
+        return count > 0 ? static_cast<unsigned int>(count) : 4;
+    }
+
+    // Tell whether a format has an alpha channel
+    bool hasAlpha(sf::PixelFormat::Type format)
+    {
+        return (format == sf::PixelFormat::RG8) || (format == sf::PixelFormat::RGBA8) || (format == sf::PixelFormat::RGBA16F);
+    }
+
+    // Reverse the order of the pixels of a row, whatever their size
+    void reverseRow(sf::Uint8* row, std::size_t count, std::size_t pixelSize)
+    {
+        sf::Uint8* left = row;
+        sf::Uint8* right = row + (count - 1) * pixelSize;
+        for (; left < right; left += pixelSize, right -= pixelSize)
+            std::swap_ranges(left, left + pixelSize, right);
+    }
+
+    // Mutex for the creation of the loader
+    sf::Mutex loaderMutex;
+}
 
 
 namespace sf
 {
+namespace priv
+{
 ////////////////////////////////////////////////////////////
-Image::Image() :
-m_size(0, 0)
+/// \brief Pool of threads decoding image files in the background
+///
+/// Workers are launched when jobs are added and exit when
+/// the queue is empty.
+///
+////////////////////////////////////////////////////////////
+class ImageFileLoader : NonCopyable
 {
-    #ifdef SFML_SYSTEM_ANDROID
+public:
 
-    m_stream = NULL;
+    ////////////////////////////////////////////////////////////
+    // Result of the decoding of a file
+    ////////////////////////////////////////////////////////////
+    struct Result
+    {
+        bool               success;
+        std::vector<Uint8> pixels;
+        Vector2u           size;
+        PixelFormat::Type  format;
+    };
+
+    ////////////////////////////////////////////////////////////
+    static ImageFileLoader& getInstance()
+    {
+        // Never destroyed, so that it outlives the static images
+        Lock lock(loaderMutex);
+        static ImageFileLoader* instance = new ImageFileLoader;
+        return *instance;
+    }
 
-    #endif
+    ////////////////////////////////////////////////////////////
+    void add(const Image& image, const std::string& filename, bool expand)
+    {
+        Lock lock(m_mutex);
+
+        Job job = {&image, filename, expand};
+        m_jobs.push_back(job);
+
+        // Wake up an idle worker, if any
+        for (std::size_t i = 0; i < m_workers.size(); ++i)
+        {
+            if (!m_busy[i])
+            {
+                m_busy[i] = true;
+                m_workers[i]->launch();
+                break;
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void cancel(const Image& image)
+    {
+        Lock lock(m_mutex);
+
+        for (std::deque<Job>::iterator it = m_jobs.begin(); it != m_jobs.end();)
+        {
+            if (it->image == &image)
+                it = m_jobs.erase(it);
+            else
+                ++it;
+        }
+
+        // Wait for the worker which is decoding the file
+        while (m_decoding.count(&image))
+            m_decoded.wait(m_mutex);
+
+        m_results.erase(&image);
+    }
+
+    ////////////////////////////////////////////////////////////
+    bool take(const Image& image, Result& result)
+    {
+        Lock lock(m_mutex);
+
+        std::map<const Image*, Result>::iterator it = m_results.find(&image);
+        if (it == m_results.end())
+            return false;
+
+        result.success = it->second.success;
+        result.size    = it->second.size;
+        result.format  = it->second.format;
+        result.pixels.swap(it->second.pixels);
+        m_results.erase(it);
+
+        return true;
+    }
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    struct Job
+    {
+        const Image* image;
+        std::string  filename;
+        bool         expand;
+    };
+
+    ////////////////////////////////////////////////////////////
+    struct Worker
+    {
+        void operator ()()
+        {
+            loader->run(index);
+        }
+
+        ImageFileLoader* loader;
+        std::size_t      index;
+    };
+
+    ////////////////////////////////////////////////////////////
+    ImageFileLoader()
+    {
+        unsigned int count = getCoreCount();
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            Worker worker = {this, i};
+            m_workers.push_back(new Thread(worker));
+            m_busy.push_back(false);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void run(std::size_t index)
+    {
+        for (;;)
+        {
+            Job job;
+            {
+                Lock lock(m_mutex);
+                if (m_jobs.empty())
+                {
+                    m_busy[index] = false;
+                    return;
+                }
+
+                job = m_jobs.front();
+                m_jobs.pop_front();
+                m_decoding.insert(job.image);
+            }
+
+            // Decode the file, in parallel with the other workers
+            Result result;
+            result.success = ImageLoader::getInstance().loadImageFromFile(job.filename, result.pixels, result.size, result.format, job.expand);
+
+            Lock lock(m_mutex);
+            m_decoding.erase(job.image);
+            m_decoded.notifyAll();
+            Result& stored = m_results[job.image];
+            stored.success = result.success;
+            stored.size = result.size;
+            stored.format = result.format;
+            stored.pixels.swap(result.pixels);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Mutex                          m_mutex;    ///< Mutex protecting all the members
+    std::deque<Job>                m_jobs;     ///< Files waiting to be decoded
+    std::set<const Image*>         m_decoding; ///< Images whose file is being decoded
+    ConditionVariable              m_decoded;  ///< Notified when a worker finishes decoding a file
+    std::map<const Image*, Result> m_results;  ///< Decoded files waiting to be applied
+    std::vector<Thread*>           m_workers;  ///< Worker threads
+    std::vector<bool>              m_busy;     ///< Is each worker running?
+};
+
+} // namespace priv
+
+////////////////////////////////////////////////////////////
+Image::Image() :
+m_size        (0, 0),
+m_format      (PixelFormat::RGBA8),
+m_expandOnLoad(true),
+m_loading     (false)
+{
 }
 
 
 ////////////////////////////////////////////////////////////
-Image::~Image()
+Image::Image(const Image& copy) :
+m_size        (copy.m_size),
+m_pixels      (copy.m_pixels),
+m_format      (copy.m_format),
+m_expandOnLoad(copy.m_expandOnLoad),
+m_loading     (false)
 {
-    #ifdef SFML_SYSTEM_ANDROID
+}
 
-        if (m_stream)
-            delete (priv::ResourceStream*)m_stream;
 
-    #endif
+////////////////////////////////////////////////////////////
+Image::~Image()
+{
+    // Stop the background loading before the image disappears
+    cancelLoading();
 }
 
 
 ////////////////////////////////////////////////////////////
-void Image::create(unsigned int width, unsigned int height, const Color& color)
+void Image::create(unsigned int width, unsigned int height, const Color& color, PixelFormat::Type format)
 {
+    cancelLoading();
+
+    m_format = format;
+
     if (width && height)
     {
         // Assign the new size
@@ -71,18 +322,18 @@ void Image::create(unsigned int width, unsigned int height, const Color& color)
         m_size.y = height;
 
         // Resize the pixel buffer
-        m_pixels.resize(width * height * 4);
+        std::size_t pixelSize = PixelFormat::getPixelSize(format);
+        m_pixels.resize(width * height * pixelSize);
+
+        // Fill it with the specified color, encoded once in the format of the image
+        const Uint8 rgba[4] = {color.r, color.g, color.b, color.a};
+        Uint8 pixel[8];
+        priv::encodePixel(pixel, format, rgba);
 
-        // Fill it with the specified color
         Uint8* ptr = &m_pixels[0];
         Uint8* end = ptr + m_pixels.size();
-        while (ptr < end)
-        {
-            *ptr++ = color.r;
-            *ptr++ = color.g;
-            *ptr++ = color.b;
-            *ptr++ = color.a;
-        }
+        for (; ptr < end; ptr += pixelSize)
+            std::memcpy(ptr, pixel, pixelSize);
     }
     else
     {
@@ -95,8 +346,12 @@ void Image::create(unsigned int width, unsigned int height, const Color& color)
 
 
 ////////////////////////////////////////////////////////////
-void Image::create(unsigned int width, unsigned int height, const Uint8* pixels)
+void Image::create(unsigned int width, unsigned int height, const Uint8* pixels, PixelFormat::Type format)
 {
+    cancelLoading();
+
+    m_format = format;
+
     if (pixels && width && height)
     {
         // Assign the new size
@@ -104,7 +359,7 @@ void Image::create(unsigned int width, unsigned int height, const Uint8* pixels)
         m_size.y = height;
 
         // Copy the pixels
-        std::size_t size = width * height * 4;
+        std::size_t size = width * height * PixelFormat::getPixelSize(format);
         m_pixels.resize(size);
         std::memcpy(&m_pixels[0], pixels, size); // faster than vector::assign
     }
@@ -119,42 +374,92 @@ void Image::create(unsigned int width, unsigned int height, const Uint8* pixels)
 
 
 ////////////////////////////////////////////////////////////
-bool Image::loadFromFile(const std::string& filename)
+bool Image::loadFromFile(const std::string& filename, const IntRect& area)
+{
+    SFML_PROFILE_SCOPE("Image::loadFromFile");
+
+    cancelLoading();
+
+    // On Android, the asset is mapped or inflated from the APK by the asset manager
+    return priv::ImageLoader::getInstance().loadImageFromFile(filename, m_pixels, m_size, m_format, m_expandOnLoad, area);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Image::loadFromFileAsync(const std::string& filename)
 {
     #ifndef SFML_SYSTEM_ANDROID
 
-        return priv::ImageLoader::getInstance().loadImageFromFile(filename, m_pixels, m_size);
+        cancelLoading();
 
-    #else
+        priv::ImageFileLoader::getInstance().add(*this, filename, m_expandOnLoad);
+        m_loading = true;
 
-        if (m_stream)
-            delete (priv::ResourceStream*)m_stream;
+        return true;
 
-        m_stream = new priv::ResourceStream(filename);
-        return loadFromStream(*(priv::ResourceStream*)m_stream);
+    #else
+
+        // Assets are read through the activity, which worker threads can't use
+        return loadFromFile(filename);
 
     #endif
 }
 
 
+////////////////////////////////////////////////////////////
+bool Image::isReady()
+{
+    if (!m_loading)
+        return true;
+
+    priv::ImageFileLoader::Result result;
+    if (!priv::ImageFileLoader::getInstance().take(*this, result))
+        return false;
+
+    m_loading = false;
+
+    if (result.success)
+    {
+        m_size = result.size;
+        m_format = result.format;
+        m_pixels.swap(result.pixels);
+    }
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Image::loadFromMemory(const void* data, std::size_t size)
 {
-    return priv::ImageLoader::getInstance().loadImageFromMemory(data, size, m_pixels, m_size);
+    cancelLoading();
+
+    return priv::ImageLoader::getInstance().loadImageFromMemory(data, size, m_pixels, m_size, m_format, m_expandOnLoad);
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Image::loadFromStream(InputStream& stream)
 {
-    return priv::ImageLoader::getInstance().loadImageFromStream(stream, m_pixels, m_size);
+    cancelLoading();
+
+    return priv::ImageLoader::getInstance().loadImageFromStream(stream, m_pixels, m_size, m_format, m_expandOnLoad);
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Image::saveToFile(const std::string& filename) const
 {
-    return priv::ImageLoader::getInstance().saveImageToFile(filename, m_pixels, m_size);
+    // Gray levels are written as they are, the other formats as RGBA
+    if ((m_format == PixelFormat::R8) || (m_format == PixelFormat::RG8) || (m_format == PixelFormat::RGBA8))
+    {
+        int channels = static_cast<int>(PixelFormat::getPixelSize(m_format));
+        return priv::ImageLoader::getInstance().saveImageToFile(filename, m_pixels, m_size, channels);
+    }
+
+    Image rgba(*this);
+    rgba.convert(PixelFormat::RGBA8);
+    return rgba.saveToFile(filename);
 }
 
 
@@ -165,21 +470,58 @@ Vector2u Image::getSize() const
 }
 
 
+////////////////////////////////////////////////////////////
+PixelFormat::Type Image::getFormat() const
+{
+    return m_format;
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::convert(PixelFormat::Type format)
+{
+    if (format == m_format)
+        return;
+
+    std::size_t count = m_size.x * m_size.y;
+    std::vector<Uint8> pixels(count * PixelFormat::getPixelSize(format));
+    if (count > 0)
+        priv::convertPixels(&pixels[0], format, &m_pixels[0], m_format, count);
+
+    m_pixels.swap(pixels);
+    m_format = format;
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::setExpandOnLoad(bool expand)
+{
+    m_expandOnLoad = expand;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Image::getExpandOnLoad() const
+{
+    return m_expandOnLoad;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Image::createMaskFromColor(const Color& color, Uint8 alpha)
 {
-    // Make sure that the image is not empty
-    if (!m_pixels.empty())
+    // Make sure that the image is not empty and has an alpha channel
+    if (!m_pixels.empty() && hasAlpha(m_format))
     {
+        // The kernel works on RGBA pixels, the other formats go through a converted copy
+        PixelFormat::Type format = m_format;
+        convert(PixelFormat::RGBA8);
+
         // Replace the alpha of the pixels that match the transparent color
-        Uint8* ptr = &m_pixels[0];
-        Uint8* end = ptr + m_pixels.size();
-        while (ptr < end)
-        {
-            if ((ptr[0] == color.r) && (ptr[1] == color.g) && (ptr[2] == color.b) && (ptr[3] == color.a))
-                ptr[3] = alpha;
-            ptr += 4;
-        }
+        const Uint8 key[4] = {color.r, color.g, color.b, color.a};
+        priv::maskPixels(&m_pixels[0], m_pixels.size() / 4, key, alpha);
+
+        convert(format);
     }
 }
 
@@ -219,37 +561,50 @@ void Image::copy(const Image& source, unsigned int destX, unsigned int destY, co
         return;
 
     // Precompute as much as possible
-    int          pitch     = width * 4;
+    int          srcSize   = static_cast<int>(PixelFormat::getPixelSize(source.m_format));
+    int          dstSize   = static_cast<int>(PixelFormat::getPixelSize(m_format));
+    int          pitch     = width * dstSize;
     int          rows      = height;
-    int          srcStride = source.m_size.x * 4;
-    int          dstStride = m_size.x * 4;
-    const Uint8* srcPixels = &source.m_pixels[0] + (srcRect.left + srcRect.top * source.m_size.x) * 4;
-    Uint8*       dstPixels = &m_pixels[0] + (destX + destY * m_size.x) * 4;
+    int          srcStride = source.m_size.x * srcSize;
+    int          dstStride = m_size.x * dstSize;
+    const Uint8* srcPixels = &source.m_pixels[0] + (srcRect.left + srcRect.top * source.m_size.x) * srcSize;
+    Uint8*       dstPixels = &m_pixels[0] + (destX + destY * m_size.x) * dstSize;
 
     // Copy the pixels
-    if (applyAlpha)
+    if ((source.m_format != m_format) || (applyAlpha && (m_format != PixelFormat::RGBA8)))
     {
-        // Interpolation using alpha values, pixel by pixel (slower)
+        // Different or non-RGBA formats: convert the rows to RGBA, blend or copy them and convert them back
+        std::vector<Uint8> srcRow(width * 4);
+        std::vector<Uint8> dstRow(width * 4);
         for (int i = 0; i < rows; ++i)
         {
-            for (int j = 0; j < width; ++j)
+            priv::convertPixels(&srcRow[0], PixelFormat::RGBA8, srcPixels, source.m_format, width);
+            if (applyAlpha)
             {
-                // Get a direct pointer to the components of the current pixel
-                const Uint8* src = srcPixels + j * 4;
-                Uint8*       dst = dstPixels + j * 4;
-
-                // Interpolate RGBA components using the alpha value of the source pixel
-                Uint8 alpha = src[3];
-                dst[0] = (src[0] * alpha + dst[0] * (255 - alpha)) / 255;
-                dst[1] = (src[1] * alpha + dst[1] * (255 - alpha)) / 255;
-                dst[2] = (src[2] * alpha + dst[2] * (255 - alpha)) / 255;
-                dst[3] = alpha + dst[3] * (255 - alpha) / 255;
+                priv::convertPixels(&dstRow[0], PixelFormat::RGBA8, dstPixels, m_format, width);
+                priv::blendPixels(&dstRow[0], &srcRow[0], width);
+                priv::convertPixels(dstPixels, m_format, &dstRow[0], PixelFormat::RGBA8, width);
+            }
+            else
+            {
+                priv::convertPixels(dstPixels, m_format, &srcRow[0], PixelFormat::RGBA8, width);
             }
 
             srcPixels += srcStride;
             dstPixels += dstStride;
         }
     }
+    else if (applyAlpha)
+    {
+        // Interpolation using alpha values, several pixels at once when SIMD instructions are available
+        for (int i = 0; i < rows; ++i)
+        {
+            priv::blendPixels(dstPixels, srcPixels, width);
+
+            srcPixels += srcStride;
+            dstPixels += dstStride;
+        }
+    }
     else
     {
         // Optimized copy ignoring alpha values, row by row (faster)
@@ -266,19 +621,17 @@ void Image::copy(const Image& source, unsigned int destX, unsigned int destY, co
 ////////////////////////////////////////////////////////////
 void Image::setPixel(unsigned int x, unsigned int y, const Color& color)
 {
-    Uint8* pixel = &m_pixels[(x + y * m_size.x) * 4];
-    *pixel++ = color.r;
-    *pixel++ = color.g;
-    *pixel++ = color.b;
-    *pixel++ = color.a;
+    const Uint8 rgba[4] = {color.r, color.g, color.b, color.a};
+    priv::encodePixel(&m_pixels[(x + y * m_size.x) * PixelFormat::getPixelSize(m_format)], m_format, rgba);
 }
 
 
 ////////////////////////////////////////////////////////////
 Color Image::getPixel(unsigned int x, unsigned int y) const
 {
-    const Uint8* pixel = &m_pixels[(x + y * m_size.x) * 4];
-    return Color(pixel[0], pixel[1], pixel[2], pixel[3]);
+    Uint8 rgba[4];
+    priv::decodePixel(&m_pixels[(x + y * m_size.x) * PixelFormat::getPixelSize(m_format)], m_format, rgba);
+    return Color(rgba[0], rgba[1], rgba[2], rgba[3]);
 }
 
 
@@ -302,20 +655,15 @@ void Image::flipHorizontally()
 {
     if (!m_pixels.empty())
     {
-        std::size_t rowSize = m_size.x * 4;
+        std::size_t pixelSize = PixelFormat::getPixelSize(m_format);
+        std::size_t rowSize = m_size.x * pixelSize;
 
         for (std::size_t y = 0; y < m_size.y; ++y)
         {
-            std::vector<Uint8>::iterator left = m_pixels.begin() + y * rowSize;
-            std::vector<Uint8>::iterator right = m_pixels.begin() + (y + 1) * rowSize - 4;
-
-            for (std::size_t x = 0; x < m_size.x / 2; ++x)
-            {
-                std::swap_ranges(left, left + 4, right);
-
-                left += 4;
-                right -= 4;
-            }
+            if (pixelSize == 4)
+                priv::reversePixels(&m_pixels[y * rowSize], m_size.x);
+            else
+                reverseRow(&m_pixels[y * rowSize], m_size.x, pixelSize);
         }
     }
 }
@@ -326,14 +674,14 @@ void Image::flipVertically()
 {
     if (!m_pixels.empty())
     {
-        std::size_t rowSize = m_size.x * 4;
+        std::size_t rowSize = m_size.x * PixelFormat::getPixelSize(m_format);
 
-        std::vector<Uint8>::iterator top = m_pixels.begin();
-        std::vector<Uint8>::iterator bottom = m_pixels.end() - rowSize;
+        Uint8* top = &m_pixels[0];
+        Uint8* bottom = &m_pixels[0] + m_pixels.size() - rowSize;
 
         for (std::size_t y = 0; y < m_size.y / 2; ++y)
         {
-            std::swap_ranges(top, top + rowSize, bottom);
+            priv::swapBytes(top, bottom, rowSize);
 
             top += rowSize;
             bottom -= rowSize;
@@ -341,4 +689,115 @@ void Image::flipVertically()
     }
 }
 
+
+////////////////////////////////////////////////////////////
+void Image::premultiplyAlpha()
+{
+    if (!m_pixels.empty() && hasAlpha(m_format))
+    {
+        // The kernel works on RGBA pixels, the other formats go through a converted copy
+        PixelFormat::Type format = m_format;
+        convert(PixelFormat::RGBA8);
+        priv::premultiplyPixels(&m_pixels[0], m_pixels.size() / 4);
+        convert(format);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::resize(unsigned int width, unsigned int height)
+{
+    // Nothing to interpolate?
+    if (m_pixels.empty() || !width || !height)
+    {
+        create(width, height, Color(0, 0, 0), m_format);
+        return;
+    }
+
+    if ((width == m_size.x) && (height == m_size.y))
+        return;
+
+    // The byte formats are interpolated directly, packed and float channels go through RGBA
+    if ((m_format == PixelFormat::RGB565) || (m_format == PixelFormat::RGBA16F))
+    {
+        PixelFormat::Type format = m_format;
+        convert(PixelFormat::RGBA8);
+        resize(width, height);
+        convert(format);
+        return;
+    }
+
+    std::size_t pixelSize = PixelFormat::getPixelSize(m_format);
+
+    std::vector<unsigned int> first;
+    std::vector<unsigned int> second;
+    std::vector<unsigned int> weights;
+
+    // Interpolate the rows horizontally
+    computeSamples(m_size.x, width, first, second, weights);
+
+    std::vector<Uint8> rows(width * m_size.y * pixelSize);
+    for (unsigned int y = 0; y < m_size.y; ++y)
+    {
+        const Uint8* source = &m_pixels[y * m_size.x * pixelSize];
+        Uint8* destination = &rows[y * width * pixelSize];
+
+        for (unsigned int x = 0; x < width; ++x)
+            priv::lerpBytes(destination + x * pixelSize, source + first[x] * pixelSize, source + second[x] * pixelSize, pixelSize, weights[x]);
+    }
+
+    // Then interpolate the resized rows vertically, a whole row at a time
+    computeSamples(m_size.y, height, first, second, weights);
+
+    std::vector<Uint8> pixels(width * height * pixelSize);
+    std::size_t rowSize = width * pixelSize;
+    for (unsigned int y = 0; y < height; ++y)
+        priv::lerpBytes(&pixels[y * rowSize], &rows[first[y] * rowSize], &rows[second[y] * rowSize], rowSize, weights[y]);
+
+    m_pixels.swap(pixels);
+    m_size.x = width;
+    m_size.y = height;
+}
+
+
+////////////////////////////////////////////////////////////
+Image& Image::operator =(const Image& right)
+{
+    if (this != &right)
+    {
+        cancelLoading();
+
+        m_size = right.m_size;
+        m_pixels = right.m_pixels;
+        m_format = right.m_format;
+        m_expandOnLoad = right.m_expandOnLoad;
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::swap(Image& right)
+{
+    cancelLoading();
+    right.cancelLoading();
+
+    std::swap(m_size, right.m_size);
+    m_pixels.swap(right.m_pixels);
+    std::swap(m_format, right.m_format);
+    std::swap(m_expandOnLoad, right.m_expandOnLoad);
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::cancelLoading()
+{
+    if (m_loading)
+    {
+        priv::ImageFileLoader::getInstance().cancel(*this);
+        m_loading = false;
+    }
+}
+
 } // namespace sf
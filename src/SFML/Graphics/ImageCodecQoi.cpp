@@ -0,0 +1,285 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageCodecQoi.hpp>
+#include <SFML/Graphics/ImageLoader.hpp>
+#include <cstring>
+
+
+namespace
+{
+    // Chunk tags, see https://qoiformat.org/qoi-specification.pdf
+    const sf::Uint8 opIndex = 0x00;
+    const sf::Uint8 opDiff  = 0x40;
+    const sf::Uint8 opLuma  = 0x80;
+    const sf::Uint8 opRun   = 0xC0;
+    const sf::Uint8 opRgb   = 0xFE;
+    const sf::Uint8 opRgba  = 0xFF;
+    const sf::Uint8 mask    = 0xC0;
+
+    const std::size_t headerSize  = 14;
+    const std::size_t paddingSize = 8;
+
+    // Limit the decoded size, so that corrupt headers can't exhaust the memory
+    const sf::Uint64 maxPixelCount = 400000000;
+
+    // Slot of a pixel in the table of recently seen pixels
+    unsigned int hash(const sf::Uint8* pixel)
+    {
+        return (pixel[0] * 3 + pixel[1] * 5 + pixel[2] * 7 + pixel[3] * 11) % 64;
+    }
+
+    // Big-endian 32-bits integers of the header
+    sf::Uint32 readUint32(const sf::Uint8* data)
+    {
+        return (static_cast<sf::Uint32>(data[0]) << 24) | (static_cast<sf::Uint32>(data[1]) << 16) |
+               (static_cast<sf::Uint32>(data[2]) << 8)  |  static_cast<sf::Uint32>(data[3]);
+    }
+    void writeUint32(std::vector<sf::Uint8>& output, sf::Uint32 value)
+    {
+        output.push_back(static_cast<sf::Uint8>(value >> 24));
+        output.push_back(static_cast<sf::Uint8>(value >> 16));
+        output.push_back(static_cast<sf::Uint8>(value >> 8));
+        output.push_back(static_cast<sf::Uint8>(value));
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool isQoi(const void* data, std::size_t size)
+{
+    return (size >= 4) && (std::memcmp(data, "qoif", 4) == 0);
+}
+
+
+////////////////////////////////////////////////////////////
+bool decodeQoi(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size, const IntRect& area)
+{
+    if (!isQoi(data, dataSize) || (dataSize < headerSize + paddingSize))
+        return false;
+
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+    Uint32 width = readUint32(bytes + 4);
+    Uint32 height = readUint32(bytes + 8);
+    if (!width || !height || (static_cast<Uint64>(width) * height > maxPixelCount))
+        return false;
+
+    IntRect rectangle = adjustImageArea(area, Vector2u(width, height));
+    if ((rectangle.width == 0) || (rectangle.height == 0))
+        return false;
+
+    // Pixels are decoded in order, the ones before the area are decoded but not stored
+    std::size_t first = (static_cast<std::size_t>(rectangle.top) * width + rectangle.left) * 4;
+    std::size_t last = (static_cast<std::size_t>(rectangle.top + rectangle.height - 1) * width + rectangle.left + rectangle.width) * 4;
+    std::size_t left = static_cast<std::size_t>(rectangle.left) * 4;
+    std::size_t right = static_cast<std::size_t>(rectangle.left + rectangle.width) * 4;
+    std::size_t rowSize = static_cast<std::size_t>(width) * 4;
+    pixels.resize(static_cast<std::size_t>(rectangle.width) * rectangle.height * 4);
+
+    Uint8 index[64 * 4];
+    std::memset(index, 0, sizeof(index));
+    Uint8 pixel[4] = {0, 0, 0, 255};
+
+    // Chunks are at most 5 bytes long and the padding is 8 bytes long,
+    // so checking the position once per chunk is enough
+    std::size_t position = headerSize;
+    std::size_t end = dataSize - paddingSize;
+    unsigned int run = 0;
+    std::size_t output = 0;
+    std::size_t column = 0;
+    for (std::size_t i = 0; i < last; i += 4, column += 4)
+    {
+        if (run > 0)
+        {
+            --run;
+        }
+        else if (position < end)
+        {
+            Uint8 tag = bytes[position++];
+            if (tag == opRgb)
+            {
+                pixel[0] = bytes[position++];
+                pixel[1] = bytes[position++];
+                pixel[2] = bytes[position++];
+            }
+            else if (tag == opRgba)
+            {
+                pixel[0] = bytes[position++];
+                pixel[1] = bytes[position++];
+                pixel[2] = bytes[position++];
+                pixel[3] = bytes[position++];
+            }
+            else if ((tag & mask) == opIndex)
+            {
+                std::memcpy(pixel, &index[tag * 4], 4);
+            }
+            else if ((tag & mask) == opDiff)
+            {
+                pixel[0] = static_cast<Uint8>(pixel[0] + ((tag >> 4) & 0x03) - 2);
+                pixel[1] = static_cast<Uint8>(pixel[1] + ((tag >> 2) & 0x03) - 2);
+                pixel[2] = static_cast<Uint8>(pixel[2] + (tag & 0x03) - 2);
+            }
+            else if ((tag & mask) == opLuma)
+            {
+                Uint8 next = bytes[position++];
+                int green = (tag & 0x3F) - 32;
+                pixel[0] = static_cast<Uint8>(pixel[0] + green - 8 + ((next >> 4) & 0x0F));
+                pixel[1] = static_cast<Uint8>(pixel[1] + green);
+                pixel[2] = static_cast<Uint8>(pixel[2] + green - 8 + (next & 0x0F));
+            }
+            else
+            {
+                run = tag & 0x3F;
+            }
+
+            std::memcpy(&index[hash(pixel) * 4], pixel, 4);
+        }
+        else
+        {
+            // Truncated file
+            pixels.clear();
+            return false;
+        }
+
+        // Keep the pixels inside the area
+        if (column == rowSize)
+            column = 0;
+        if ((i >= first) && (column >= left) && (column < right))
+        {
+            std::memcpy(&pixels[output], pixel, 4);
+            output += 4;
+        }
+    }
+
+    size.x = static_cast<unsigned int>(rectangle.width);
+    size.y = static_cast<unsigned int>(rectangle.height);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void encodeQoi(const std::vector<Uint8>& pixels, const Vector2u& size, std::vector<Uint8>& output)
+{
+    output.clear();
+    output.reserve(headerSize + pixels.size() / 2 + paddingSize);
+
+    // Header: magic, size, 4 channels, sRGB color space
+    output.push_back('q');
+    output.push_back('o');
+    output.push_back('i');
+    output.push_back('f');
+    writeUint32(output, size.x);
+    writeUint32(output, size.y);
+    output.push_back(4);
+    output.push_back(0);
+
+    Uint8 index[64 * 4];
+    std::memset(index, 0, sizeof(index));
+    Uint8 previous[4] = {0, 0, 0, 255};
+
+    unsigned int run = 0;
+    for (std::size_t i = 0; i < pixels.size(); i += 4)
+    {
+        const Uint8* pixel = &pixels[i];
+
+        if (std::memcmp(pixel, previous, 4) == 0)
+        {
+            // Runs are limited to 62 pixels, the longer tags are taken by opRgb and opRgba
+            if ((++run == 62) || (i + 4 == pixels.size()))
+            {
+                output.push_back(static_cast<Uint8>(opRun | (run - 1)));
+                run = 0;
+            }
+            continue;
+        }
+
+        if (run > 0)
+        {
+            output.push_back(static_cast<Uint8>(opRun | (run - 1)));
+            run = 0;
+        }
+
+        unsigned int slot = hash(pixel);
+        if (std::memcmp(&index[slot * 4], pixel, 4) == 0)
+        {
+            output.push_back(static_cast<Uint8>(opIndex | slot));
+        }
+        else
+        {
+            std::memcpy(&index[slot * 4], pixel, 4);
+
+            if (pixel[3] == previous[3])
+            {
+                int red   = static_cast<signed char>(pixel[0] - previous[0]);
+                int green = static_cast<signed char>(pixel[1] - previous[1]);
+                int blue  = static_cast<signed char>(pixel[2] - previous[2]);
+                int redGreen  = red - green;
+                int blueGreen = blue - green;
+
+                if ((red >= -2) && (red <= 1) && (green >= -2) && (green <= 1) && (blue >= -2) && (blue <= 1))
+                {
+                    output.push_back(static_cast<Uint8>(opDiff | ((red + 2) << 4) | ((green + 2) << 2) | (blue + 2)));
+                }
+                else if ((redGreen >= -8) && (redGreen <= 7) && (green >= -32) && (green <= 31) && (blueGreen >= -8) && (blueGreen <= 7))
+                {
+                    output.push_back(static_cast<Uint8>(opLuma | (green + 32)));
+                    output.push_back(static_cast<Uint8>(((redGreen + 8) << 4) | (blueGreen + 8)));
+                }
+                else
+                {
+                    output.push_back(opRgb);
+                    output.push_back(pixel[0]);
+                    output.push_back(pixel[1]);
+                    output.push_back(pixel[2]);
+                }
+            }
+            else
+            {
+                output.push_back(opRgba);
+                output.push_back(pixel[0]);
+                output.push_back(pixel[1]);
+                output.push_back(pixel[2]);
+                output.push_back(pixel[3]);
+            }
+        }
+
+        std::memcpy(previous, pixel, 4);
+    }
+
+    // End marker
+    output.insert(output.end(), paddingSize - 1, 0);
+    output.push_back(1);
+}
+
+} // namespace priv
+
+} // namespace sf
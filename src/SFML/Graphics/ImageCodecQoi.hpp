@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_IMAGECODECQOI_HPP
+#define SFML_IMAGECODECQOI_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Check if some data is a QOI ("Quite OK Image") file
+///
+/// \param data Pointer to the beginning of the file data
+/// \param size Size of the data, in bytes
+///
+/// \return True if the data starts with a QOI header
+///
+////////////////////////////////////////////////////////////
+bool isQoi(const void* data, std::size_t size);
+
+////////////////////////////////////////////////////////////
+/// \brief Decode a QOI file, or an area of it, to RGBA pixels
+///
+/// Only the pixels of the area are stored, and the decoding
+/// stops after its last row.
+///
+/// \param data     Pointer to the file data
+/// \param dataSize Size of the data, in bytes
+/// \param pixels   Array of pixels to fill with the decoded image
+/// \param size     Size of the decoded image, in pixels
+/// \param area     Area of the image to decode (empty to decode the entire image)
+///
+/// \return True if decoding was successful
+///
+////////////////////////////////////////////////////////////
+bool decodeQoi(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size, const IntRect& area = IntRect());
+
+////////////////////////////////////////////////////////////
+/// \brief Encode RGBA pixels to a QOI file
+///
+/// QOI compresses a bit less than PNG but is an order of
+/// magnitude faster, which makes it suitable for saving
+/// screenshots or replay frames on the fly.
+///
+/// \param pixels Array of pixels to encode
+/// \param size   Size of the image, in pixels
+/// \param output Array to fill with the file data
+///
+////////////////////////////////////////////////////////////
+void encodeQoi(const std::vector<Uint8>& pixels, const Vector2u& size, std::vector<Uint8>& output);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_IMAGECODECQOI_HPP
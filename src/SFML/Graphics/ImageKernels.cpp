@@ -0,0 +1,662 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageKernels.hpp>
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SFML_IMAGE_SSE2
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define SFML_IMAGE_NEON
+#endif
+
+
+namespace
+{
+    // Gray level of a color, with weights which keep gray colors unchanged
+    sf::Uint8 luma(const sf::Uint8* rgba)
+    {
+        return static_cast<sf::Uint8>((77 * rgba[0] + 150 * rgba[1] + 29 * rgba[2]) >> 8);
+    }
+
+    // Convert a half float (IEEE 754 binary16) to a float
+    float halfToFloat(sf::Uint16 half)
+    {
+        sf::Uint32 sign = static_cast<sf::Uint32>(half & 0x8000) << 16;
+        sf::Uint32 exponent = (half >> 10) & 0x1F;
+        sf::Uint32 mantissa = half & 0x3FF;
+
+        sf::Uint32 bits;
+        if (exponent == 0x1F)
+        {
+            // Infinity or NaN
+            bits = sign | 0x7F800000 | (mantissa << 13);
+        }
+        else if (exponent != 0)
+        {
+            // Normalized number
+            bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+        }
+        else if (mantissa != 0)
+        {
+            // Denormalized number, which is a normalized float
+            exponent = 113;
+            while (!(mantissa & 0x400))
+            {
+                mantissa <<= 1;
+                --exponent;
+            }
+            bits = sign | (exponent << 23) | ((mantissa & 0x3FF) << 13);
+        }
+        else
+        {
+            // Zero
+            bits = sign;
+        }
+
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    // Convert a float to a half float (IEEE 754 binary16), rounding to the nearest
+    sf::Uint16 floatToHalf(float value)
+    {
+        sf::Uint32 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        sf::Uint16 sign = static_cast<sf::Uint16>((bits >> 16) & 0x8000);
+        int exponent = static_cast<int>((bits >> 23) & 0xFF) - 112;
+        sf::Uint32 mantissa = bits & 0x7FFFFF;
+
+        // Infinity and NaN
+        if (exponent == 143)
+            return static_cast<sf::Uint16>(sign | 0x7C00 | (mantissa ? 0x200 : 0));
+
+        // Too large: infinity
+        if (exponent >= 31)
+            return static_cast<sf::Uint16>(sign | 0x7C00);
+
+        // Too small for a normalized half: denormalized or zero
+        if (exponent <= 0)
+        {
+            if (exponent < -10)
+                return sign;
+
+            mantissa |= 0x800000;
+            unsigned int shift = static_cast<unsigned int>(14 - exponent);
+            sf::Uint32 rounded = (mantissa + (1u << (shift - 1))) >> shift;
+            return static_cast<sf::Uint16>(sign | rounded);
+        }
+
+        // A carry of the rounding into the exponent gives the right result
+        sf::Uint32 half = (static_cast<sf::Uint32>(exponent) << 10) | (mantissa >> 13);
+        half += (mantissa >> 12) & 1;
+        return static_cast<sf::Uint16>(sign | std::min<sf::Uint32>(half, 0x7C00));
+    }
+
+#if defined(SFML_IMAGE_SSE2)
+
+    // Divide 16-bit lanes in [0, 65152] by 255, rounding down like the integer division
+    __m128i divide255(__m128i x)
+    {
+        return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)), _mm_srli_epi16(x, 8)), 8);
+    }
+
+    // Broadcast the alpha of each of the two pixels held in 16-bit lanes
+    __m128i broadcastAlpha(__m128i x)
+    {
+        return _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    }
+
+    // Mask of the alpha lanes of two pixels held in 16-bit lanes
+    __m128i alphaLanes()
+    {
+        return _mm_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1);
+    }
+
+    // Blend two source pixels over two destination pixels, held in 16-bit lanes
+    __m128i blendHalf(__m128i source, __m128i destination)
+    {
+        __m128i alpha = broadcastAlpha(source);
+        __m128i kept  = _mm_mullo_epi16(destination, _mm_sub_epi16(_mm_set1_epi16(255), alpha));
+        __m128i color = divide255(_mm_add_epi16(_mm_mullo_epi16(source, alpha), kept));
+        __m128i cover = _mm_add_epi16(alpha, divide255(kept));
+
+        return _mm_or_si128(_mm_andnot_si128(alphaLanes(), color), _mm_and_si128(alphaLanes(), cover));
+    }
+
+    // Premultiply two pixels held in 16-bit lanes
+    __m128i premultiplyHalf(__m128i pixels)
+    {
+        __m128i alpha = broadcastAlpha(pixels);
+        __m128i color = divide255(_mm_add_epi16(_mm_mullo_epi16(pixels, alpha), _mm_set1_epi16(127)));
+
+        return _mm_or_si128(_mm_andnot_si128(alphaLanes(), color), _mm_and_si128(alphaLanes(), pixels));
+    }
+
+    // Interpolate 8 bytes held in 16-bit lanes
+    __m128i lerpHalf(__m128i first, __m128i second, __m128i firstWeight, __m128i secondWeight)
+    {
+        __m128i sum = _mm_add_epi16(_mm_mullo_epi16(first, firstWeight), _mm_mullo_epi16(second, secondWeight));
+        return _mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(128)), 8);
+    }
+
+    // Weighted sums of the RGB components of four pixels, the weights are repeated for two pixels
+    __m128i dotPixels(__m128i pixels, __m128i weights)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        __m128 low  = _mm_castsi128_ps(_mm_madd_epi16(_mm_unpacklo_epi8(pixels, zero), weights));
+        __m128 high = _mm_castsi128_ps(_mm_madd_epi16(_mm_unpackhi_epi8(pixels, zero), weights));
+
+        // Each pixel produced two partial sums (RG and BA), add them together
+        __m128i first  = _mm_castps_si128(_mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0)));
+        __m128i second = _mm_castps_si128(_mm_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1)));
+        return _mm_add_epi32(first, second);
+    }
+
+#elif defined(SFML_IMAGE_NEON)
+
+    // Divide 16-bit lanes in [0, 65152] by 255, rounding down like the integer division
+    uint8x8_t divide255(uint16x8_t x)
+    {
+        return vshrn_n_u16(vaddq_u16(vaddq_u16(x, vdupq_n_u16(1)), vshrq_n_u16(x, 8)), 8);
+    }
+
+#endif
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void blendPixels(Uint8* destination, const Uint8* source, std::size_t count)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_IMAGE_SSE2)
+
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i src = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4));
+        __m128i dst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(destination + i * 4));
+
+        __m128i low  = blendHalf(_mm_unpacklo_epi8(src, zero), _mm_unpacklo_epi8(dst, zero));
+        __m128i high = blendHalf(_mm_unpackhi_epi8(src, zero), _mm_unpackhi_epi8(dst, zero));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4), _mm_packus_epi16(low, high));
+    }
+
+#elif defined(SFML_IMAGE_NEON)
+
+    for (; i + 8 <= count; i += 8)
+    {
+        uint8x8x4_t src = vld4_u8(source + i * 4);
+        uint8x8x4_t dst = vld4_u8(destination + i * 4);
+
+        uint8x8_t alpha   = src.val[3];
+        uint8x8_t inverse = vsub_u8(vdup_n_u8(255), alpha);
+
+        for (int c = 0; c < 3; ++c)
+            dst.val[c] = divide255(vmlal_u8(vmull_u8(src.val[c], alpha), dst.val[c], inverse));
+        dst.val[3] = vadd_u8(alpha, divide255(vmull_u8(dst.val[3], inverse)));
+
+        vst4_u8(destination + i * 4, dst);
+    }
+
+#endif
+
+    for (; i < count; ++i)
+    {
+        const Uint8* src = source + i * 4;
+        Uint8*       dst = destination + i * 4;
+
+        // Interpolate RGBA components using the alpha value of the source pixel
+        Uint8 alpha = src[3];
+        dst[0] = (src[0] * alpha + dst[0] * (255 - alpha)) / 255;
+        dst[1] = (src[1] * alpha + dst[1] * (255 - alpha)) / 255;
+        dst[2] = (src[2] * alpha + dst[2] * (255 - alpha)) / 255;
+        dst[3] = alpha + dst[3] * (255 - alpha) / 255;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void maskPixels(Uint8* pixels, std::size_t count, const Uint8* key, Uint8 alpha)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_IMAGE_SSE2) || defined(SFML_IMAGE_NEON)
+
+    // Matching pixels are equal to the key, so they can be replaced as a whole
+    const Uint8 keyPixels[16]    = {key[0], key[1], key[2], key[3], key[0], key[1], key[2], key[3],
+                                    key[0], key[1], key[2], key[3], key[0], key[1], key[2], key[3]};
+    const Uint8 maskedPixels[16] = {key[0], key[1], key[2], alpha, key[0], key[1], key[2], alpha,
+                                    key[0], key[1], key[2], alpha, key[0], key[1], key[2], alpha};
+
+#endif
+
+#if defined(SFML_IMAGE_SSE2)
+
+    const __m128i keys   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keyPixels));
+    const __m128i masked = _mm_loadu_si128(reinterpret_cast<const __m128i*>(maskedPixels));
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i* block  = reinterpret_cast<__m128i*>(pixels + i * 4);
+        __m128i  x      = _mm_loadu_si128(block);
+        __m128i  equals = _mm_cmpeq_epi32(x, keys);
+
+        _mm_storeu_si128(block, _mm_or_si128(_mm_and_si128(equals, masked), _mm_andnot_si128(equals, x)));
+    }
+
+#elif defined(SFML_IMAGE_NEON)
+
+    const uint32x4_t keys   = vreinterpretq_u32_u8(vld1q_u8(keyPixels));
+    const uint32x4_t masked = vreinterpretq_u32_u8(vld1q_u8(maskedPixels));
+    for (; i + 4 <= count; i += 4)
+    {
+        uint32x4_t x = vreinterpretq_u32_u8(vld1q_u8(pixels + i * 4));
+        vst1q_u8(pixels + i * 4, vreinterpretq_u8_u32(vbslq_u32(vceqq_u32(x, keys), masked, x)));
+    }
+
+#endif
+
+    for (; i < count; ++i)
+    {
+        Uint8* ptr = pixels + i * 4;
+        if ((ptr[0] == key[0]) && (ptr[1] == key[1]) && (ptr[2] == key[2]) && (ptr[3] == key[3]))
+            ptr[3] = alpha;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void reversePixels(Uint8* pixels, std::size_t count)
+{
+    Uint8* left  = pixels;
+    Uint8* right = pixels + count * 4;
+
+#if defined(SFML_IMAGE_SSE2)
+
+    // Swap blocks of 4 pixels from both ends, reversing them on the way
+    while (right - left >= 32)
+    {
+        right -= 16;
+
+        __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(left));
+        __m128i last  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(left),  _mm_shuffle_epi32(last,  _MM_SHUFFLE(0, 1, 2, 3)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(right), _mm_shuffle_epi32(first, _MM_SHUFFLE(0, 1, 2, 3)));
+
+        left += 16;
+    }
+
+#elif defined(SFML_IMAGE_NEON)
+
+    while (right - left >= 32)
+    {
+        right -= 16;
+
+        uint32x4_t first = vrev64q_u32(vreinterpretq_u32_u8(vld1q_u8(left)));
+        uint32x4_t last  = vrev64q_u32(vreinterpretq_u32_u8(vld1q_u8(right)));
+        vst1q_u8(left,  vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(last),  vget_low_u32(last))));
+        vst1q_u8(right, vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(first), vget_low_u32(first))));
+
+        left += 16;
+    }
+
+#endif
+
+    while (right - left >= 8)
+    {
+        right -= 4;
+        std::swap_ranges(left, left + 4, right);
+        left += 4;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void swapBytes(Uint8* first, Uint8* second, std::size_t size)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_IMAGE_SSE2)
+
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+        __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(first + i),  y);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(second + i), x);
+    }
+
+#elif defined(SFML_IMAGE_NEON)
+
+    for (; i + 16 <= size; i += 16)
+    {
+        uint8x16_t x = vld1q_u8(first + i);
+        uint8x16_t y = vld1q_u8(second + i);
+        vst1q_u8(first + i,  y);
+        vst1q_u8(second + i, x);
+    }
+
+#endif
+
+    std::swap_ranges(first + i, first + size, second + i);
+}
+
+
+////////////////////////////////////////////////////////////
+void premultiplyPixels(Uint8* pixels, std::size_t count)
+{
+    std::size_t i = 0;
+
+#if defined(SFML_IMAGE_SSE2)
+
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i* block = reinterpret_cast<__m128i*>(pixels + i * 4);
+        __m128i  x     = _mm_loadu_si128(block);
+
+        __m128i low  = premultiplyHalf(_mm_unpacklo_epi8(x, zero));
+        __m128i high = premultiplyHalf(_mm_unpackhi_epi8(x, zero));
+
+        _mm_storeu_si128(block, _mm_packus_epi16(low, high));
+    }
+
+#elif defined(SFML_IMAGE_NEON)
+
+    const uint16x8_t half = vdupq_n_u16(127);
+    for (; i + 8 <= count; i += 8)
+    {
+        uint8x8x4_t x = vld4_u8(pixels + i * 4);
+
+        for (int c = 0; c < 3; ++c)
+            x.val[c] = divide255(vaddq_u16(vmull_u8(x.val[c], x.val[3]), half));
+
+        vst4_u8(pixels + i * 4, x);
+    }
+
+#endif
+
+    for (; i < count; ++i)
+    {
+        Uint8* ptr = pixels + i * 4;
+        ptr[0] = (ptr[0] * ptr[3] + 127) / 255;
+        ptr[1] = (ptr[1] * ptr[3] + 127) / 255;
+        ptr[2] = (ptr[2] * ptr[3] + 127) / 255;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void lerpBytes(Uint8* destination, const Uint8* first, const Uint8* second, std::size_t size, unsigned int weight)
+{
+    const unsigned int firstWeight = 256 - weight;
+
+    std::size_t i = 0;
+
+#if defined(SFML_IMAGE_SSE2)
+
+    const __m128i zero  = _mm_setzero_si128();
+    const __m128i wx    = _mm_set1_epi16(static_cast<short>(firstWeight));
+    const __m128i wy    = _mm_set1_epi16(static_cast<short>(weight));
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+        __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + i));
+
+        __m128i low  = lerpHalf(_mm_unpacklo_epi8(x, zero), _mm_unpacklo_epi8(y, zero), wx, wy);
+        __m128i high = lerpHalf(_mm_unpackhi_epi8(x, zero), _mm_unpackhi_epi8(y, zero), wx, wy);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_packus_epi16(low, high));
+    }
+
+#elif defined(SFML_IMAGE_NEON)
+
+    const uint16x8_t rounding = vdupq_n_u16(128);
+    for (; i + 8 <= size; i += 8)
+    {
+        uint16x8_t sum = vmlaq_n_u16(vmulq_n_u16(vmovl_u8(vld1_u8(first + i)), static_cast<uint16_t>(firstWeight)),
+                                     vmovl_u8(vld1_u8(second + i)), static_cast<uint16_t>(weight));
+        vst1_u8(destination + i, vshrn_n_u16(vaddq_u16(sum, rounding), 8));
+    }
+
+#endif
+
+    for (; i < size; ++i)
+        destination[i] = static_cast<Uint8>((first[i] * firstWeight + second[i] * weight + 128) >> 8);
+}
+
+
+////////////////////////////////////////////////////////////
+void convertToYuv420(const Uint8* pixels, unsigned int width, unsigned int height,
+                     Uint8* luma, Uint8* blueChroma, Uint8* redChroma)
+{
+    // Luma: Y = ((66 R + 129 G + 25 B + 128) >> 8) + 16
+    const std::size_t count = static_cast<std::size_t>(width) * height;
+
+    std::size_t i = 0;
+
+#if defined(SFML_IMAGE_SSE2)
+
+    const __m128i weights = _mm_setr_epi16(66, 129, 25, 0, 66, 129, 25, 0);
+    const __m128i rounding = _mm_set1_epi32(128);
+    const __m128i offset = _mm_set1_epi16(16);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i sums = dotPixels(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i * 4)), weights);
+        __m128i values = _mm_srli_epi32(_mm_add_epi32(sums, rounding), 8);
+        __m128i bytes = _mm_packus_epi16(_mm_add_epi16(_mm_packs_epi32(values, values), offset), offset);
+
+        int packed = _mm_cvtsi128_si32(bytes);
+        std::memcpy(luma + i, &packed, 4);
+    }
+
+#elif defined(SFML_IMAGE_NEON)
+
+    const uint16x8_t rounding = vdupq_n_u16(128);
+    const uint8x8_t offset = vdup_n_u8(16);
+    for (; i + 8 <= count; i += 8)
+    {
+        uint8x8x4_t rgba = vld4_u8(pixels + i * 4);
+        uint16x8_t sum = vmlal_u8(vmlal_u8(vmull_u8(rgba.val[0], vdup_n_u8(66)), rgba.val[1], vdup_n_u8(129)),
+                                  rgba.val[2], vdup_n_u8(25));
+        vst1_u8(luma + i, vadd_u8(vshrn_n_u16(vaddq_u16(sum, rounding), 8), offset));
+    }
+
+#endif
+
+    for (; i < count; ++i)
+    {
+        const Uint8* pixel = pixels + i * 4;
+        luma[i] = static_cast<Uint8>(((66 * pixel[0] + 129 * pixel[1] + 25 * pixel[2] + 128) >> 8) + 16);
+    }
+
+    // Chroma: U = ((-38 R - 74 G + 112 B + 128) >> 8) + 128, V = ((112 R - 94 G - 18 B + 128) >> 8) + 128,
+    // computed from the average of each 2x2 block
+    const unsigned int chromaWidth = (width + 1) / 2;
+    const unsigned int chromaHeight = (height + 1) / 2;
+    for (unsigned int y = 0; y < chromaHeight; ++y)
+    {
+        const Uint8* top = pixels + static_cast<std::size_t>(2 * y) * width * 4;
+        const Uint8* bottom = (2 * y + 1 < height) ? top + static_cast<std::size_t>(width) * 4 : top;
+
+        for (unsigned int x = 0; x < chromaWidth; ++x)
+        {
+            std::size_t left = static_cast<std::size_t>(2 * x) * 4;
+            std::size_t right = (2 * x + 1 < width) ? left + 4 : left;
+
+            int r = (top[left + 0] + top[right + 0] + bottom[left + 0] + bottom[right + 0] + 2) >> 2;
+            int g = (top[left + 1] + top[right + 1] + bottom[left + 1] + bottom[right + 1] + 2) >> 2;
+            int b = (top[left + 2] + top[right + 2] + bottom[left + 2] + bottom[right + 2] + 2) >> 2;
+
+            std::size_t index = static_cast<std::size_t>(y) * chromaWidth + x;
+            blueChroma[index] = static_cast<Uint8>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+            redChroma[index]  = static_cast<Uint8>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void decodePixel(const Uint8* pixel, PixelFormat::Type format, Uint8* rgba)
+{
+    switch (format)
+    {
+        case PixelFormat::R8:
+        {
+            rgba[0] = rgba[1] = rgba[2] = pixel[0];
+            rgba[3] = 255;
+            break;
+        }
+
+        case PixelFormat::RG8:
+        {
+            rgba[0] = rgba[1] = rgba[2] = pixel[0];
+            rgba[3] = pixel[1];
+            break;
+        }
+
+        case PixelFormat::RGB565:
+        {
+            // Expand the channels by replicating their high bits in the low bits
+            Uint16 packed;
+            std::memcpy(&packed, pixel, sizeof(packed));
+            unsigned int r = (packed >> 11) & 0x1F;
+            unsigned int g = (packed >> 5) & 0x3F;
+            unsigned int b = packed & 0x1F;
+            rgba[0] = static_cast<Uint8>((r << 3) | (r >> 2));
+            rgba[1] = static_cast<Uint8>((g << 2) | (g >> 4));
+            rgba[2] = static_cast<Uint8>((b << 3) | (b >> 2));
+            rgba[3] = 255;
+            break;
+        }
+
+        case PixelFormat::RGBA16F:
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                Uint16 half;
+                std::memcpy(&half, pixel + i * 2, sizeof(half));
+                float value = std::min(std::max(halfToFloat(half), 0.f), 1.f);
+                rgba[i] = static_cast<Uint8>(value * 255.f + 0.5f);
+            }
+            break;
+        }
+
+        default:
+        {
+            std::memcpy(rgba, pixel, 4);
+            break;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void encodePixel(Uint8* pixel, PixelFormat::Type format, const Uint8* rgba)
+{
+    switch (format)
+    {
+        case PixelFormat::R8:
+        {
+            pixel[0] = luma(rgba);
+            break;
+        }
+
+        case PixelFormat::RG8:
+        {
+            pixel[0] = luma(rgba);
+            pixel[1] = rgba[3];
+            break;
+        }
+
+        case PixelFormat::RGB565:
+        {
+            // Round to the nearest value of each channel
+            unsigned int r = (rgba[0] * 31 + 127) / 255;
+            unsigned int g = (rgba[1] * 63 + 127) / 255;
+            unsigned int b = (rgba[2] * 31 + 127) / 255;
+            Uint16 packed = static_cast<Uint16>((r << 11) | (g << 5) | b);
+            std::memcpy(pixel, &packed, sizeof(packed));
+            break;
+        }
+
+        case PixelFormat::RGBA16F:
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                Uint16 half = floatToHalf(rgba[i] / 255.f);
+                std::memcpy(pixel + i * 2, &half, sizeof(half));
+            }
+            break;
+        }
+
+        default:
+        {
+            std::memcpy(pixel, rgba, 4);
+            break;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void convertPixels(Uint8* destination, PixelFormat::Type destinationFormat, const Uint8* source,
+                   PixelFormat::Type sourceFormat, std::size_t count)
+{
+    std::size_t destinationSize = PixelFormat::getPixelSize(destinationFormat);
+    std::size_t sourceSize = PixelFormat::getPixelSize(sourceFormat);
+
+    if (destinationFormat == sourceFormat)
+    {
+        std::memcpy(destination, source, count * sourceSize);
+        return;
+    }
+
+    // Every conversion goes through 8 bits RGBA
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Uint8 rgba[4];
+        decodePixel(source + i * sourceSize, sourceFormat, rgba);
+        encodePixel(destination + i * destinationSize, destinationFormat, rgba);
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,175 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_IMAGEKERNELS_HPP
+#define SFML_IMAGEKERNELS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/Graphics/PixelFormat.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Blend RGBA pixels over other pixels, using the alpha of the source
+///
+/// The results are exactly the ones of the scalar formula used
+/// by sf::Image::copy, SSE2 or NEON instructions process several
+/// pixels at once when available.
+///
+/// \param destination Pixels to blend into
+/// \param source      Pixels to blend
+/// \param count       Number of pixels
+///
+////////////////////////////////////////////////////////////
+void blendPixels(Uint8* destination, const Uint8* source, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Replace the alpha of the pixels that match a color
+///
+/// \param pixels Pixels to modify
+/// \param count  Number of pixels
+/// \param key    RGBA components of the color to match
+/// \param alpha  New alpha of the matching pixels
+///
+////////////////////////////////////////////////////////////
+void maskPixels(Uint8* pixels, std::size_t count, const Uint8* key, Uint8 alpha);
+
+////////////////////////////////////////////////////////////
+/// \brief Reverse the order of an array of RGBA pixels
+///
+/// \param pixels Pixels to reverse
+/// \param count  Number of pixels
+///
+////////////////////////////////////////////////////////////
+void reversePixels(Uint8* pixels, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Exchange the contents of two non-overlapping byte arrays
+///
+/// \param first  First array
+/// \param second Second array
+/// \param size   Size of the arrays, in bytes
+///
+////////////////////////////////////////////////////////////
+void swapBytes(Uint8* first, Uint8* second, std::size_t size);
+
+////////////////////////////////////////////////////////////
+/// \brief Multiply the color components of pixels by their alpha
+///
+/// Each component becomes (component * alpha + 127) / 255.
+///
+/// \param pixels Pixels to modify
+/// \param count  Number of pixels
+///
+////////////////////////////////////////////////////////////
+void premultiplyPixels(Uint8* pixels, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Linearly interpolate between two arrays of bytes
+///
+/// Each byte becomes (first * (256 - weight) + second * weight + 128) / 256.
+///
+/// \param destination Array to fill
+/// \param first       First array to interpolate
+/// \param second      Second array to interpolate
+/// \param size        Size of the arrays, in bytes
+/// \param weight      Weight of the second array, in [0, 256]
+///
+////////////////////////////////////////////////////////////
+void lerpBytes(Uint8* destination, const Uint8* first, const Uint8* second, std::size_t size, unsigned int weight);
+
+////////////////////////////////////////////////////////////
+/// \brief Convert RGBA pixels to planar YUV 4:2:0 (I420)
+///
+/// The conversion uses the BT.601 limited range coefficients;
+/// each chroma sample is computed from the average of a 2x2
+/// block of pixels (the blocks of the last column and row are
+/// clamped for odd sizes). The luma plane, which is most of
+/// the work, uses SSE2 or NEON instructions when available.
+///
+/// \param pixels     Pixels to convert
+/// \param width      Width of the image, in pixels
+/// \param height     Height of the image, in pixels
+/// \param luma       Plane of width * height luma samples to fill
+/// \param blueChroma Plane of ((width + 1) / 2) * ((height + 1) / 2) U samples to fill
+/// \param redChroma  Plane of ((width + 1) / 2) * ((height + 1) / 2) V samples to fill
+///
+////////////////////////////////////////////////////////////
+void convertToYuv420(const Uint8* pixels, unsigned int width, unsigned int height,
+                     Uint8* luma, Uint8* blueChroma, Uint8* redChroma);
+
+////////////////////////////////////////////////////////////
+/// \brief Read a pixel of any format as 8 bits RGBA components
+///
+/// Gray levels are copied to the three color components,
+/// formats without alpha are opaque and half floats are
+/// clamped to [0, 1].
+///
+/// \param pixel  Pixel to read
+/// \param format Format of the pixel
+/// \param rgba   Array of 4 components to fill
+///
+////////////////////////////////////////////////////////////
+void decodePixel(const Uint8* pixel, PixelFormat::Type format, Uint8* rgba);
+
+////////////////////////////////////////////////////////////
+/// \brief Write a pixel of any format from 8 bits RGBA components
+///
+/// Colors are converted to their luma for gray formats, and
+/// the alpha is dropped by formats which don't have it.
+///
+/// \param pixel  Pixel to write
+/// \param format Format of the pixel
+/// \param rgba   RGBA components of the pixel
+///
+////////////////////////////////////////////////////////////
+void encodePixel(Uint8* pixel, PixelFormat::Type format, const Uint8* rgba);
+
+////////////////////////////////////////////////////////////
+/// \brief Convert an array of pixels to another format
+///
+/// \param destination       Pixels to write
+/// \param destinationFormat Format of the pixels to write
+/// \param source            Pixels to read
+/// \param sourceFormat      Format of the pixels to read
+/// \param count             Number of pixels
+///
+////////////////////////////////////////////////////////////
+void convertPixels(Uint8* destination, PixelFormat::Type destinationFormat, const Uint8* source,
+                   PixelFormat::Type sourceFormat, std::size_t count);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_IMAGEKERNELS_HPP
@@ -26,9 +26,16 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/ImageLoader.hpp>
-#include <SFML/System/InputStream.hpp>
+#include <SFML/Graphics/ImageCodecQoi.hpp>
+#include <SFML/Graphics/ImageKernels.hpp>
+#include <SFML/System/FileInputStream.hpp>
+#include <SFML/System/MappedFileInputStream.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Allocator.hpp>
 #define STB_IMAGE_IMPLEMENTATION
+#define STBI_MALLOC(size)            sf::Allocator::allocate(size, sf::Allocator::Images)
+#define STBI_REALLOC(pointer, size)  sf::Allocator::reallocate(pointer, size, sf::Allocator::Images)
+#define STBI_FREE(pointer)           sf::Allocator::deallocate(pointer, sf::Allocator::Images)
 #include <stb_image.h>
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include <stb_image_write.h>
@@ -37,7 +44,16 @@ extern "C"
     #include <jpeglib.h>
     #include <jerror.h>
 }
+#include <algorithm>
 #include <cctype>
+#include <csetjmp>
+#include <cstdio>
+#include <cstring>
+
+// jpeg_mem_src appeared in libjpeg 8, libjpeg-turbo provides it with the libjpeg 6b API too
+#if (JPEG_LIB_VERSION >= 80) || defined(MEM_SRCDST_SUPPORTED)
+    #define SFML_JPEG_MEMORY_SOURCE
+#endif
 
 
 namespace
@@ -50,6 +66,26 @@ namespace
         return str;
     }
 
+    // Choose the channels to load from a file with a given number of channels:
+    // gray levels (with or without alpha) are kept, the other files are loaded as RGBA
+    int getLoadedChannels(int channels, sf::PixelFormat::Type& format)
+    {
+        if (channels == STBI_grey)
+        {
+            format = sf::PixelFormat::R8;
+            return STBI_grey;
+        }
+
+        if (channels == STBI_grey_alpha)
+        {
+            format = sf::PixelFormat::RG8;
+            return STBI_grey_alpha;
+        }
+
+        format = sf::PixelFormat::RGBA8;
+        return STBI_rgb_alpha;
+    }
+
     // stb_image callbacks that operate on a sf::InputStream
     int read(void* user, char* data, int size)
     {
@@ -66,6 +102,210 @@ namespace
         sf::InputStream* stream = static_cast<sf::InputStream*>(user);
         return stream->tell() >= stream->getSize();
     }
+
+#ifdef SFML_JPEG_MEMORY_SOURCE
+
+    // Check if some data is a JPEG file, which libjpeg decodes faster than stb_image
+    // (especially libjpeg-turbo) and without its limitations, like progressive files
+    bool isJpg(const void* data, std::size_t size)
+    {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        return (size >= 3) && (bytes[0] == 0xFF) && (bytes[1] == 0xD8) && (bytes[2] == 0xFF);
+    }
+
+    // libjpeg calls exit() on errors by default, jump back to the decoder instead
+    struct JpegErrorManager
+    {
+        jpeg_error_mgr base;
+        std::jmp_buf   jump;
+        char           message[JMSG_LENGTH_MAX];
+    };
+    void onJpegError(j_common_ptr info)
+    {
+        JpegErrorManager* manager = reinterpret_cast<JpegErrorManager*>(info->err);
+        (*info->err->format_message)(info, manager->message);
+        std::longjmp(manager->jump, 1);
+    }
+
+    // Decode an area of a JPEG file in memory
+    bool decodeJpg(const void* data, std::size_t dataSize, std::vector<sf::Uint8>& pixels, sf::Vector2u& size,
+                   sf::PixelFormat::Type& format, bool expand, const sf::IntRect& area, std::string& reason)
+    {
+        // Declared before setjmp, so that a jump doesn't skip its destructor
+        std::vector<sf::Uint8> row;
+
+        jpeg_decompress_struct info;
+        JpegErrorManager error;
+        info.err = jpeg_std_error(&error.base);
+        error.base.error_exit = &onJpegError;
+
+        if (setjmp(error.jump))
+        {
+            jpeg_destroy_decompress(&info);
+            pixels.clear();
+            reason = error.message;
+            return false;
+        }
+
+        jpeg_create_decompress(&info);
+        jpeg_mem_src(&info, static_cast<unsigned char*>(const_cast<void*>(data)), static_cast<unsigned long>(dataSize));
+        jpeg_read_header(&info, TRUE);
+
+        if ((info.jpeg_color_space == JCS_CMYK) || (info.jpeg_color_space == JCS_YCCK))
+        {
+            jpeg_destroy_decompress(&info);
+            reason = "CMYK JPEG files are not supported";
+            return false;
+        }
+
+        // Grayscale files are kept as they are if allowed; libjpeg-turbo can write RGBA
+        // pixels directly, the others are expanded below
+        bool gray = !expand && (info.num_components == 1);
+    #ifdef JCS_EXTENSIONS
+        info.out_color_space = gray ? JCS_GRAYSCALE : JCS_EXT_RGBA;
+    #else
+        info.out_color_space = (info.num_components == 1) ? JCS_GRAYSCALE : JCS_RGB;
+    #endif
+        jpeg_start_decompress(&info);
+
+        sf::IntRect rectangle = sf::priv::adjustImageArea(area, sf::Vector2u(info.output_width, info.output_height));
+        if ((rectangle.width == 0) || (rectangle.height == 0))
+        {
+            jpeg_destroy_decompress(&info);
+            reason = "the area to load is outside of the image";
+            return false;
+        }
+
+        // The rows are decoded one at a time, so that only the area is stored;
+        // libjpeg-turbo can even skip the rows above it without decoding them
+        // (columns are not cropped with jpeg_crop_scanline, which changes the upsampling at the edges)
+    #ifdef LIBJPEG_TURBO_VERSION_NUMBER
+        jpeg_skip_scanlines(&info, static_cast<JDIMENSION>(rectangle.top));
+    #endif
+
+        unsigned int width = info.output_width;
+        unsigned int components = static_cast<unsigned int>(info.output_components);
+        std::size_t pixelSize = gray ? 1 : 4;
+        std::size_t rowSize = static_cast<std::size_t>(rectangle.width) * pixelSize;
+        pixels.resize(rowSize * rectangle.height);
+        row.resize(static_cast<std::size_t>(width) * 4);
+
+        JDIMENSION bottom = static_cast<JDIMENSION>(rectangle.top + rectangle.height);
+        while (info.output_scanline < bottom)
+        {
+            int y = static_cast<int>(info.output_scanline);
+            JSAMPROW rowPointer = &row[0];
+            jpeg_read_scanlines(&info, &rowPointer, 1);
+            if (y < rectangle.top)
+                continue;
+
+            // Expand the row in place, from the end so that no pixel is overwritten before it is read
+            if (components == 3)
+            {
+                for (unsigned int x = width; x-- > 0;)
+                {
+                    row[x * 4 + 3] = 255;
+                    row[x * 4 + 2] = row[x * 3 + 2];
+                    row[x * 4 + 1] = row[x * 3 + 1];
+                    row[x * 4 + 0] = row[x * 3 + 0];
+                }
+            }
+            else if ((components == 1) && !gray)
+            {
+                for (unsigned int x = width; x-- > 0;)
+                {
+                    sf::Uint8 level = row[x];
+                    row[x * 4 + 0] = level;
+                    row[x * 4 + 1] = level;
+                    row[x * 4 + 2] = level;
+                    row[x * 4 + 3] = 255;
+                }
+            }
+
+            std::memcpy(&pixels[(y - rectangle.top) * rowSize], &row[rectangle.left * pixelSize], rowSize);
+        }
+
+        size.x = rectangle.width;
+        size.y = rectangle.height;
+        format = gray ? sf::PixelFormat::R8 : sf::PixelFormat::RGBA8;
+
+        // The rows below the area are not decoded at all
+        if (info.output_scanline == info.output_height)
+            jpeg_finish_decompress(&info);
+        jpeg_destroy_decompress(&info);
+
+        return true;
+    }
+
+#endif
+
+    // Decode an area of an image file in memory
+    bool decodeFromMemory(const void* data, std::size_t dataSize, std::vector<sf::Uint8>& pixels, sf::Vector2u& size,
+                          sf::PixelFormat::Type& format, bool expand, const sf::IntRect& area, std::string& reason)
+    {
+        if (sf::priv::isQoi(data, dataSize))
+        {
+            format = sf::PixelFormat::RGBA8;
+            if (sf::priv::decodeQoi(data, dataSize, pixels, size, area))
+                return true;
+
+            reason = "corrupt QOI file, or area outside of the image";
+            return false;
+        }
+
+    #ifdef SFML_JPEG_MEMORY_SOURCE
+        if (isJpg(data, dataSize))
+            return decodeJpg(data, dataSize, pixels, size, format, expand, area, reason);
+    #endif
+
+        // Load the image and get a pointer to the pixels in memory
+        int width, height, channels;
+        const unsigned char* buffer = static_cast<const unsigned char*>(data);
+        if (expand || !stbi_info_from_memory(buffer, static_cast<int>(dataSize), &width, &height, &channels))
+            channels = STBI_rgb_alpha;
+        int pixelSize = getLoadedChannels(channels, format);
+        unsigned char* ptr = stbi_load_from_memory(buffer, static_cast<int>(dataSize), &width, &height, &channels, pixelSize);
+
+        if (!ptr || !width || !height)
+        {
+            reason = stbi_failure_reason();
+            return false;
+        }
+
+        // The other formats can't be decoded partially, crop the decoded pixels
+        sf::IntRect rectangle = sf::priv::adjustImageArea(area, sf::Vector2u(width, height));
+        if ((rectangle.width == 0) || (rectangle.height == 0))
+        {
+            stbi_image_free(ptr);
+            reason = "the area to load is outside of the image";
+            return false;
+        }
+
+        // Assign the image properties
+        size.x = rectangle.width;
+        size.y = rectangle.height;
+
+        // Copy the loaded pixels to the pixel buffer
+        std::size_t rowSize = static_cast<std::size_t>(rectangle.width) * pixelSize;
+        pixels.resize(rowSize * rectangle.height);
+        for (int y = 0; y < rectangle.height; ++y)
+            std::memcpy(&pixels[y * rowSize], ptr + ((rectangle.top + y) * width + rectangle.left) * pixelSize, rowSize);
+
+        // Free the loaded pixels (they are now in our own pixel buffer)
+        stbi_image_free(ptr);
+
+        return true;
+    }
+
+    // Tell whether stb_image is bypassed for some data, so that it needs to be in memory
+    bool isDecodedFromMemory(const void* data, std::size_t size)
+    {
+    #ifdef SFML_JPEG_MEMORY_SOURCE
+        return sf::priv::isQoi(data, size) || isJpg(data, size);
+    #else
+        return sf::priv::isQoi(data, size);
+    #endif
+    }
 }
 
 
@@ -97,42 +337,49 @@ ImageLoader::~ImageLoader()
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::loadImageFromFile(const std::string& filename, std::vector<Uint8>& pixels, Vector2u& size)
+bool ImageLoader::loadImageFromFile(const std::string& filename, std::vector<Uint8>& pixels, Vector2u& size, PixelFormat::Type& format,
+                                    bool expand, const IntRect& area)
 {
     // Clear the array (just in case)
     pixels.clear();
 
-    // Load the image and get a pointer to the pixels in memory
-    int width, height, channels;
-    unsigned char* ptr = stbi_load(filename.c_str(), &width, &height, &channels, STBI_rgb_alpha);
-
-    if (ptr && width && height)
+    // Decode straight from the mapped file, without copying it through stdio buffers
+    MappedFileInputStream mapping;
+    std::vector<char> buffer;
+    const void* data = NULL;
+    std::size_t dataSize = 0;
+    if (mapping.open(filename))
     {
-        // Assign the image properties
-        size.x = width;
-        size.y = height;
-
-        // Copy the loaded pixels to the pixel buffer
-        pixels.resize(width * height * 4);
-        memcpy(&pixels[0], ptr, pixels.size());
-
-        // Free the loaded pixels (they are now in our own pixel buffer)
-        stbi_image_free(ptr);
-
-        return true;
+        data = mapping.getData();
+        dataSize = static_cast<std::size_t>(mapping.getSize());
     }
     else
     {
-        // Error, failed to load the image
-        err() << "Failed to load image \"" << filename << "\". Reason: " << stbi_failure_reason() << std::endl;
-
-        return false;
+        // Mapping is not available (empty or special files), read the file
+        FileInputStream file;
+        if (file.open(filename) && (file.getSize() > 0))
+        {
+            buffer.resize(static_cast<std::size_t>(file.getSize()));
+            Int64 read = file.read(&buffer[0], static_cast<Int64>(buffer.size()));
+            data = &buffer[0];
+            dataSize = read > 0 ? static_cast<std::size_t>(read) : 0;
+        }
     }
+
+    std::string reason = "unable to open the file";
+    if (dataSize && decodeFromMemory(data, dataSize, pixels, size, format, expand, area, reason))
+        return true;
+
+    // Error, failed to load the image
+    err() << "Failed to load image \"" << filename << "\". Reason: " << reason << std::endl;
+
+    return false;
 }
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size)
+bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size,
+                                      PixelFormat::Type& format, bool expand)
 {
     // Check input parameters
     if (data && dataSize)
@@ -140,33 +387,14 @@ bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, st
         // Clear the array (just in case)
         pixels.clear();
 
-        // Load the image and get a pointer to the pixels in memory
-        int width, height, channels;
-        const unsigned char* buffer = static_cast<const unsigned char*>(data);
-        unsigned char* ptr = stbi_load_from_memory(buffer, static_cast<int>(dataSize), &width, &height, &channels, STBI_rgb_alpha);
-
-        if (ptr && width && height)
-        {
-            // Assign the image properties
-            size.x = width;
-            size.y = height;
-
-            // Copy the loaded pixels to the pixel buffer
-            pixels.resize(width * height * 4);
-            memcpy(&pixels[0], ptr, pixels.size());
-
-            // Free the loaded pixels (they are now in our own pixel buffer)
-            stbi_image_free(ptr);
-
+        std::string reason;
+        if (decodeFromMemory(data, dataSize, pixels, size, format, expand, IntRect(), reason))
             return true;
-        }
-        else
-        {
-            // Error, failed to load the image
-            err() << "Failed to load image from memory. Reason: " << stbi_failure_reason() << std::endl;
 
-            return false;
-        }
+        // Error, failed to load the image
+        err() << "Failed to load image from memory. Reason: " << reason << std::endl;
+
+        return false;
     }
     else
     {
@@ -177,14 +405,37 @@ bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, st
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size)
+bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size, PixelFormat::Type& format, bool expand)
 {
+    // Mapped files are decoded in place
+    MappedFileInputStream* mapping = dynamic_cast<MappedFileInputStream*>(&stream);
+    if (mapping && mapping->getData())
+        return loadImageFromMemory(mapping->getData(), static_cast<std::size_t>(mapping->getSize()), pixels, size, format, expand);
+
     // Clear the array (just in case)
     pixels.clear();
 
     // Make sure that the stream's reading position is at the beginning
     stream.seek(0);
 
+    // The other decoders work on the whole file in memory
+    char header[4];
+    Int64 headerSize = stream.read(header, sizeof(header));
+    if ((headerSize > 0) && isDecodedFromMemory(header, static_cast<std::size_t>(headerSize)) && (stream.getSize() > 0))
+    {
+        std::vector<char> data(static_cast<std::size_t>(stream.getSize()));
+        stream.seek(0);
+        Int64 dataSize = stream.read(&data[0], static_cast<Int64>(data.size()));
+
+        std::string reason = "failed to read the stream";
+        if ((dataSize > 0) && decodeFromMemory(&data[0], static_cast<std::size_t>(dataSize), pixels, size, format, expand, IntRect(), reason))
+            return true;
+
+        err() << "Failed to load image from stream. Reason: " << reason << std::endl;
+        return false;
+    }
+    stream.seek(0);
+
     // Setup the stb_image callbacks
     stbi_io_callbacks callbacks;
     callbacks.read = &read;
@@ -193,7 +444,11 @@ bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& p
 
     // Load the image and get a pointer to the pixels in memory
     int width, height, channels;
-    unsigned char* ptr = stbi_load_from_callbacks(&callbacks, &stream, &width, &height, &channels, STBI_rgb_alpha);
+    if (expand || !stbi_info_from_callbacks(&callbacks, &stream, &width, &height, &channels))
+        channels = STBI_rgb_alpha;
+    int pixelSize = getLoadedChannels(channels, format);
+    stream.seek(0);
+    unsigned char* ptr = stbi_load_from_callbacks(&callbacks, &stream, &width, &height, &channels, pixelSize);
 
     if (ptr && width && height)
     {
@@ -202,7 +457,7 @@ bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& p
         size.y = height;
 
         // Copy the loaded pixels to the pixel buffer
-        pixels.resize(width * height * 4);
+        pixels.resize(width * height * pixelSize);
         memcpy(&pixels[0], ptr, pixels.size());
 
         // Free the loaded pixels (they are now in our own pixel buffer)
@@ -221,7 +476,7 @@ bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& p
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size)
+bool ImageLoader::saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size, int channels)
 {
     // Make sure the image is not empty
     if (!pixels.empty() && (size.x > 0) && (size.y > 0))
@@ -235,25 +490,34 @@ bool ImageLoader::saveImageToFile(const std::string& filename, const std::vector
             if (extension == "bmp")
             {
                 // BMP format
-                if (stbi_write_bmp(filename.c_str(), size.x, size.y, 4, &pixels[0]))
+                if (stbi_write_bmp(filename.c_str(), size.x, size.y, channels, &pixels[0]))
                     return true;
             }
             else if (extension == "tga")
             {
                 // TGA format
-                if (stbi_write_tga(filename.c_str(), size.x, size.y, 4, &pixels[0]))
+                if (stbi_write_tga(filename.c_str(), size.x, size.y, channels, &pixels[0]))
                     return true;
             }
             else if (extension == "png")
             {
                 // PNG format
-                if (stbi_write_png(filename.c_str(), size.x, size.y, 4, &pixels[0], 0))
+                if (stbi_write_png(filename.c_str(), size.x, size.y, channels, &pixels[0], 0))
                     return true;
             }
-            else if (extension == "jpg")
+            else if ((extension == "jpg") || (extension == "qoi"))
             {
-                // JPG format
-                if (writeJpg(filename, pixels, size.x, size.y))
+                // These writers take RGBA pixels, expand the gray levels
+                std::vector<Uint8> expanded;
+                if (channels != 4)
+                {
+                    std::size_t count = static_cast<std::size_t>(size.x) * size.y;
+                    expanded.resize(count * 4);
+                    convertPixels(&expanded[0], PixelFormat::RGBA8, &pixels[0], channels == 1 ? PixelFormat::R8 : PixelFormat::RG8, count);
+                }
+                const std::vector<Uint8>& rgba = (channels != 4) ? expanded : pixels;
+
+                if ((extension == "jpg") ? writeJpg(filename, rgba, size.x, size.y) : writeQoi(filename, rgba, size))
                     return true;
             }
         }
@@ -317,6 +581,43 @@ bool ImageLoader::writeJpg(const std::string& filename, const std::vector<Uint8>
     return true;
 }
 
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::writeQoi(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size)
+{
+    std::vector<Uint8> data;
+    encodeQoi(pixels, size, data);
+
+    FILE* file = fopen(filename.c_str(), "wb");
+    if (!file)
+        return false;
+
+    bool written = fwrite(&data[0], 1, data.size(), file) == data.size();
+    return (fclose(file) == 0) && written;
+}
+
+
+////////////////////////////////////////////////////////////
+IntRect adjustImageArea(const IntRect& area, const Vector2u& size)
+{
+    int width = static_cast<int>(size.x);
+    int height = static_cast<int>(size.y);
+
+    // An empty area stands for the entire image
+    if ((area.width <= 0) || (area.height <= 0))
+        return IntRect(0, 0, width, height);
+
+    int left   = std::max(area.left, 0);
+    int top    = std::max(area.top, 0);
+    int right  = std::min(area.left + area.width, width);
+    int bottom = std::min(area.top + area.height, height);
+
+    if ((left >= right) || (top >= bottom))
+        return IntRect();
+
+    return IntRect(left, top, right - left, bottom - top);
+}
+
 } // namespace priv
 
 } // namespace sf
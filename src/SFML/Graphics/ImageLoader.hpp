@@ -28,6 +28,8 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/PixelFormat.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <string>
@@ -57,16 +59,29 @@ public:
     static ImageLoader& getInstance();
 
     ////////////////////////////////////////////////////////////
-    /// \brief Load an image from a file on disk
+    /// \brief Load an image, or an area of it, from a file on disk
+    ///
+    /// JPEG and QOI files are decoded row by row, so that only
+    /// the pixels of the area are stored; the other formats
+    /// are decoded entirely and cropped.
+    ///
+    /// Unless \a expand is true, grayscale files are loaded as
+    /// PixelFormat::R8 and grayscale files with alpha as
+    /// PixelFormat::RG8; the other files are always loaded
+    /// as PixelFormat::RGBA8.
     ///
     /// \param filename Path of image file to load
     /// \param pixels   Array of pixels to fill with loaded image
     /// \param size     Size of loaded image, in pixels
+    /// \param format   Format of the loaded pixels
+    /// \param expand   Load all the files as RGBA pixels?
+    /// \param area     Area of the image to load (empty to load the entire image)
     ///
     /// \return True if loading was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool loadImageFromFile(const std::string& filename, std::vector<Uint8>& pixels, Vector2u& size);
+    bool loadImageFromFile(const std::string& filename, std::vector<Uint8>& pixels, Vector2u& size, PixelFormat::Type& format,
+                           bool expand, const IntRect& area = IntRect());
 
     ////////////////////////////////////////////////////////////
     /// \brief Load an image from a file in memory
@@ -75,11 +90,14 @@ public:
     /// \param dataSize Size of the data to load, in bytes
     /// \param pixels   Array of pixels to fill with loaded image
     /// \param size     Size of loaded image, in pixels
+    /// \param format   Format of the loaded pixels
+    /// \param expand   Load all the files as RGBA pixels?
     ///
     /// \return True if loading was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size);
+    bool loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size,
+                             PixelFormat::Type& format, bool expand);
 
     ////////////////////////////////////////////////////////////
     /// \brief Load an image from a custom stream
@@ -87,23 +105,29 @@ public:
     /// \param stream Source stream to read from
     /// \param pixels Array of pixels to fill with loaded image
     /// \param size   Size of loaded image, in pixels
+    /// \param format Format of the loaded pixels
+    /// \param expand Load all the files as RGBA pixels?
     ///
     /// \return True if loading was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size);
+    bool loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size, PixelFormat::Type& format, bool expand);
 
     ////////////////////////////////////////////////////////////
     /// \brief Save an array of pixels as an image file
     ///
+    /// The pixels have 1 (gray), 2 (gray and alpha) or 4 (RGBA)
+    /// 8 bits channels.
+    ///
     /// \param filename Path of image file to save
     /// \param pixels   Array of pixels to save to image
     /// \param size     Size of image to save, in pixels
+    /// \param channels Number of channels of the pixels
     ///
     /// \return True if saving was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size);
+    bool saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size, int channels = 4);
 
 private:
 
@@ -131,8 +155,31 @@ private:
     ///
     ////////////////////////////////////////////////////////////
     bool writeJpg(const std::string& filename, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save an image file in QOI format
+    ///
+    /// \param filename Path of image file to save
+    /// \param pixels   Array of pixels to save to image
+    /// \param size     Size of image to save, in pixels
+    ///
+    /// \return True if saving was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool writeQoi(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size);
 };
 
+////////////////////////////////////////////////////////////
+/// \brief Adjust an area to the bounds of an image
+///
+/// \param area Area to adjust (empty for the entire image)
+/// \param size Size of the image, in pixels
+///
+/// \return Area inside the image, empty if \a area is outside of it
+///
+////////////////////////////////////////////////////////////
+IntRect adjustImageArea(const IntRect& area, const Vector2u& size);
+
 } // namespace priv
 
 } // namespace sf
@@ -0,0 +1,491 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/InstancedSprite.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/TransformableArray.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+#include <sstream>
+#include <cstdlib>
+
+
+#if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
+
+    #define castToGlHandle(x) reinterpret_cast<GLEXT_GLhandle>(static_cast<ptrdiff_t>(x))
+
+#else
+
+    #define castToGlHandle(x) (x)
+
+#endif
+
+namespace
+{
+    sf::Mutex mutex;
+
+    // Number of floats stored for each instance:
+    // 2x2 matrix, translation, texture rectangle position, texture rectangle size, padding, color
+    const std::size_t InstanceStride = 16;
+
+    // Unit quad expanded by the instancing shader, in the same order as sf::Sprite's vertices
+    const sf::Vertex unitQuad[4] =
+    {
+        sf::Vertex(sf::Vector2f(0.f, 0.f)),
+        sf::Vertex(sf::Vector2f(0.f, 1.f)),
+        sf::Vertex(sf::Vector2f(1.f, 0.f)),
+        sf::Vertex(sf::Vector2f(1.f, 1.f))
+    };
+
+    // Fragment shader of the hardware path, it does what the fixed pipeline does
+    const char* fragmentSource =
+        "uniform sampler2D texture;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = gl_Color * texture2D(texture, gl_TexCoord[0].xy);\n"
+        "}\n";
+
+    bool checkInstancingAvailable()
+    {
+        // Create a temporary context in case the user checks
+        // before a GlResource is created, thus initializing
+        // the shared context
+        sf::Context context;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+    #ifndef SFML_OPENGL_ES
+        return sf::Shader::isAvailable() && GLEXT_draw_instanced;
+    #else
+        return false;
+    #endif
+    }
+
+    // Internal shader of the hardware path and its properties, shared by all the instanced sprites
+    struct InstancingProgram
+    {
+        sf::Shader* shader;
+        int         location;
+        std::size_t maxInstances;
+    };
+
+    // Get the internal shader of the hardware path, creating it on first use.
+    // It is intentionally never destroyed, the same way the shared context
+    // is kept alive until the end of the program.
+    const InstancingProgram* getInstancingProgram()
+    {
+        // TODO: Remove this lock when it becomes unnecessary in C++11
+        sf::Lock lock(mutex);
+
+        static InstancingProgram program = {NULL, -1, 0};
+        static bool initialized = false;
+
+        if (!initialized)
+        {
+            initialized = true;
+
+        #ifndef SFML_OPENGL_ES
+
+            // Make sure that a context is active for the queries below
+            sf::Context context;
+
+            // Per-instance data is passed in a uniform array: size it according to the
+            // number of uniforms available, keeping some room for the built-in matrices
+            GLint maxComponents = 0;
+            glCheck(glGetIntegerv(GLEXT_GL_MAX_VERTEX_UNIFORM_COMPONENTS, &maxComponents));
+            GLint vectors = maxComponents / 4 - 16;
+            std::size_t maxInstances = vectors > 4 ? std::min<std::size_t>(vectors / 4, 256) : 1;
+
+            std::ostringstream vertexSource;
+            vertexSource << "#version 110\n"
+                         << "#extension GL_ARB_draw_instanced : require\n"
+                         << "uniform vec4 instances[" << maxInstances * 4 << "];\n"
+                         << "void main()\n"
+                         << "{\n"
+                         << "    int base = gl_InstanceIDARB * 4;\n"
+                         << "    vec4 matrix = instances[base];\n"
+                         << "    vec4 offset = instances[base + 1];\n"
+                         << "    vec2 size = instances[base + 2].xy;\n"
+                         << "    vec2 corner = gl_Vertex.xy;\n"
+                         << "    vec2 local = corner * abs(size);\n"
+                         << "    vec2 position = vec2(dot(matrix.xy, local), dot(matrix.zw, local)) + offset.xy;\n"
+                         << "    gl_Position = gl_ModelViewProjectionMatrix * vec4(position, 0.0, 1.0);\n"
+                         << "    gl_TexCoord[0] = gl_TextureMatrix[0] * vec4(offset.zw + corner * size, 0.0, 1.0);\n"
+                         << "    gl_FrontColor = gl_Color * instances[base + 3];\n"
+                         << "}\n";
+
+            sf::Shader* shader = new sf::Shader;
+            if (shader->loadFromMemory(vertexSource.str(), fragmentSource))
+            {
+                shader->setParameter("texture", sf::Shader::CurrentTexture);
+
+                GLint location = -1;
+                glCheck(location = GLEXT_glGetUniformLocation(castToGlHandle(shader->getNativeHandle()), "instances"));
+
+                if (location != -1)
+                {
+                    program.shader = shader;
+                    program.location = location;
+                    program.maxInstances = maxInstances;
+                }
+            }
+
+            if (!program.shader)
+                delete shader;
+
+        #endif
+        }
+
+        return program.shader ? &program : NULL;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+InstancedSprite::InstancedSprite() :
+m_texture    (NULL),
+m_instances  (),
+m_vertices   (),
+m_needsUpdate(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+InstancedSprite::InstancedSprite(const Texture& texture) :
+m_texture    (&texture),
+m_instances  (),
+m_vertices   (),
+m_needsUpdate(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void InstancedSprite::setTexture(const Texture& texture)
+{
+    m_texture = &texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* InstancedSprite::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t InstancedSprite::append(const Transform& transform, const IntRect& textureRect, const Color& color)
+{
+    std::size_t index = getInstanceCount();
+    resize(index + 1);
+
+    setInstanceTransform(index, transform);
+    setInstanceTextureRect(index, textureRect);
+    setInstanceColor(index, color);
+
+    return index;
+}
+
+
+////////////////////////////////////////////////////////////
+void InstancedSprite::clear()
+{
+    m_instances.clear();
+    m_needsUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void InstancedSprite::resize(std::size_t instanceCount)
+{
+    std::size_t previousCount = getInstanceCount();
+    m_instances.resize(instanceCount * InstanceStride, 0.f);
+
+    // New instances get an identity matrix and a white color
+    for (std::size_t i = previousCount; i < instanceCount; ++i)
+    {
+        float* instance = &m_instances[i * InstanceStride];
+        for (int j = 0; j < 4; ++j)
+            instance[12 + j] = 1.f;
+        instance[0] = 1.f;
+        instance[3] = 1.f;
+    }
+
+    m_needsUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t InstancedSprite::getInstanceCount() const
+{
+    return m_instances.size() / InstanceStride;
+}
+
+
+////////////////////////////////////////////////////////////
+void InstancedSprite::setInstanceTransform(std::size_t index, const Transform& transform)
+{
+    const float* matrix = transform.getMatrix();
+    float* instance = &m_instances[index * InstanceStride];
+
+    instance[0] = matrix[0];
+    instance[1] = matrix[4];
+    instance[2] = matrix[1];
+    instance[3] = matrix[5];
+    instance[4] = matrix[12];
+    instance[5] = matrix[13];
+
+    m_needsUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void InstancedSprite::setInstanceTransforms(std::size_t first, const TransformableArray& transformables)
+{
+    std::size_t instanceCount = getInstanceCount();
+    if (first >= instanceCount)
+        return;
+
+    std::size_t count = std::min(transformables.getSize(), instanceCount - first);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        float coefficients[6];
+        transformables.getAffineTransform(i, coefficients);
+
+        float* instance = &m_instances[(first + i) * InstanceStride];
+        instance[0] = coefficients[0];
+        instance[1] = coefficients[1];
+        instance[2] = coefficients[3];
+        instance[3] = coefficients[4];
+        instance[4] = coefficients[2];
+        instance[5] = coefficients[5];
+    }
+
+    m_needsUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void InstancedSprite::setInstanceTextureRect(std::size_t index, const IntRect& textureRect)
+{
+    float* instance = &m_instances[index * InstanceStride];
+
+    instance[6] = static_cast<float>(textureRect.left);
+    instance[7] = static_cast<float>(textureRect.top);
+    instance[8] = static_cast<float>(textureRect.width);
+    instance[9] = static_cast<float>(textureRect.height);
+
+    m_needsUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void InstancedSprite::setInstanceColor(std::size_t index, const Color& color)
+{
+    float* instance = &m_instances[index * InstanceStride];
+
+    instance[12] = color.r / 255.f;
+    instance[13] = color.g / 255.f;
+    instance[14] = color.b / 255.f;
+    instance[15] = color.a / 255.f;
+
+    m_needsUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+Transform InstancedSprite::getInstanceTransform(std::size_t index) const
+{
+    const float* instance = &m_instances[index * InstanceStride];
+
+    return Transform(instance[0], instance[1], instance[4],
+                     instance[2], instance[3], instance[5],
+                     0.f,         0.f,         1.f);
+}
+
+
+////////////////////////////////////////////////////////////
+IntRect InstancedSprite::getInstanceTextureRect(std::size_t index) const
+{
+    const float* instance = &m_instances[index * InstanceStride];
+
+    return IntRect(static_cast<int>(instance[6]), static_cast<int>(instance[7]),
+                   static_cast<int>(instance[8]), static_cast<int>(instance[9]));
+}
+
+
+////////////////////////////////////////////////////////////
+Color InstancedSprite::getInstanceColor(std::size_t index) const
+{
+    const float* instance = &m_instances[index * InstanceStride];
+
+    return Color(static_cast<Uint8>(instance[12] * 255.f + 0.5f),
+                 static_cast<Uint8>(instance[13] * 255.f + 0.5f),
+                 static_cast<Uint8>(instance[14] * 255.f + 0.5f),
+                 static_cast<Uint8>(instance[15] * 255.f + 0.5f));
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect InstancedSprite::getLocalBounds() const
+{
+    std::size_t count = getInstanceCount();
+    if (count == 0)
+        return FloatRect();
+
+    float left = 0.f;
+    float top = 0.f;
+    float right = 0.f;
+    float bottom = 0.f;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const float* instance = &m_instances[i * InstanceStride];
+        float width = std::abs(instance[8]);
+        float height = std::abs(instance[9]);
+        FloatRect bounds = getInstanceTransform(i).transformRect(FloatRect(0.f, 0.f, width, height));
+
+        if (i == 0)
+        {
+            left = bounds.left;
+            top = bounds.top;
+            right = bounds.left + bounds.width;
+            bottom = bounds.top + bounds.height;
+        }
+        else
+        {
+            left = std::min(left, bounds.left);
+            top = std::min(top, bounds.top);
+            right = std::max(right, bounds.left + bounds.width);
+            bottom = std::max(bottom, bounds.top + bounds.height);
+        }
+    }
+
+    return FloatRect(left, top, right - left, bottom - top);
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect InstancedSprite::getGlobalBounds() const
+{
+    return getTransform().transformRect(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+bool InstancedSprite::isInstancingAvailable()
+{
+    // TODO: Remove this lock when it becomes unnecessary in C++11
+    Lock lock(mutex);
+
+    static bool available = checkInstancingAvailable();
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+void InstancedSprite::draw(RenderTarget& target, RenderStates states) const
+{
+    if (!m_texture || m_instances.empty())
+        return;
+
+    states.transform *= getTransform();
+    states.texture = m_texture;
+
+    // Use hardware instancing, unless a custom shader is provided
+    if (!states.shader && isInstancingAvailable())
+    {
+        const InstancingProgram* program = getInstancingProgram();
+        if (program)
+        {
+            RenderStates instancingStates(states);
+            instancingStates.shader = program->shader;
+            target.drawInstances(unitQuad, 4, TrianglesStrip, &m_instances[0], getInstanceCount(),
+                                 InstanceStride, program->maxInstances, program->location, instancingStates);
+            return;
+        }
+    }
+
+    // Fallback: expand the instances on the CPU
+    if (m_needsUpdate)
+        updateVertices();
+
+    target.draw(&m_vertices[0], m_vertices.size(), Triangles, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void InstancedSprite::updateVertices() const
+{
+    std::size_t count = getInstanceCount();
+    m_vertices.resize(count * 6);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const float* instance = &m_instances[i * InstanceStride];
+        Transform transform = getInstanceTransform(i);
+        Color color = getInstanceColor(i);
+
+        float width = std::abs(instance[8]);
+        float height = std::abs(instance[9]);
+        float left = instance[6];
+        float right = left + instance[8];
+        float top = instance[7];
+        float bottom = top + instance[9];
+
+        Vertex quad[4] =
+        {
+            Vertex(transform.transformPoint(0.f, 0.f),       color, Vector2f(left, top)),
+            Vertex(transform.transformPoint(0.f, height),    color, Vector2f(left, bottom)),
+            Vertex(transform.transformPoint(width, 0.f),     color, Vector2f(right, top)),
+            Vertex(transform.transformPoint(width, height),  color, Vector2f(right, bottom))
+        };
+
+        Vertex* vertices = &m_vertices[i * 6];
+        vertices[0] = quad[0];
+        vertices[1] = quad[1];
+        vertices[2] = quad[2];
+        vertices[3] = quad[2];
+        vertices[4] = quad[1];
+        vertices[5] = quad[3];
+    }
+
+    m_needsUpdate = false;
+}
+
+} // namespace sf
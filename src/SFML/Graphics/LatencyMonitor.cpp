@@ -0,0 +1,397 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/LatencyMonitor.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/Window/Event.hpp>
+#include <SFML/Window/Window.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Buckets of the histograms
+    const sf::Time    histogramBucketWidth = sf::milliseconds(1);
+    const std::size_t histogramBucketCount = 100;
+
+    // Frames which can wait for their times; older ones are completed with what is known
+    const std::size_t maxPendingFrames = 8;
+
+    // Complete frames kept until they are popped
+    const std::size_t maxCompleteFrames = 256;
+
+    // Tell whether an event comes from an input device
+    bool isInputEvent(const sf::Event& event)
+    {
+        switch (event.type)
+        {
+            case sf::Event::TextEntered:
+            case sf::Event::KeyPressed:
+            case sf::Event::KeyReleased:
+            case sf::Event::MouseWheelMoved:
+            case sf::Event::MouseWheelScrolled:
+            case sf::Event::MouseButtonPressed:
+            case sf::Event::MouseButtonReleased:
+            case sf::Event::MouseMoved:
+            case sf::Event::MouseMovedRaw:
+            case sf::Event::JoystickButtonPressed:
+            case sf::Event::JoystickButtonReleased:
+            case sf::Event::JoystickMoved:
+            case sf::Event::TouchBegan:
+            case sf::Event::TouchMoved:
+            case sf::Event::TouchEnded:
+            case sf::Event::SensorChanged:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+LatencyMonitor::Frame::Frame() :
+number   (0),
+hasInput (false),
+input    (Time::Zero),
+received (Time::Zero),
+submitted(Time::Zero),
+rendered (Time::Zero),
+presented(Time::Zero)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool LatencyMonitor::Frame::isMeasured(Interval interval) const
+{
+    switch (interval)
+    {
+        case EventQueue:   return hasInput;
+        case Processing:   return hasInput;
+        case Rendering:    return rendered != Time::Zero;
+        case Presentation: return presented != Time::Zero;
+        case Total:        return hasInput;
+        default:           return false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Time LatencyMonitor::Frame::getDuration(Interval interval) const
+{
+    if (!isMeasured(interval))
+        return Time::Zero;
+
+    switch (interval)
+    {
+        case EventQueue:   return received - input;
+        case Processing:   return submitted - received;
+        case Rendering:    return rendered - submitted;
+        case Presentation: return presented - ((rendered != Time::Zero) ? rendered : submitted);
+        default:           break;
+    }
+
+    // Total: up to the last known step
+    if (presented != Time::Zero)
+        return presented - input;
+    else if (rendered != Time::Zero)
+        return rendered - input;
+    else
+        return submitted - input;
+}
+
+
+////////////////////////////////////////////////////////////
+LatencyMonitor::Histogram::Histogram() :
+bucketWidth(histogramBucketWidth),
+counts     (histogramBucketCount, 0),
+total      (0),
+maximum    (Time::Zero)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Time LatencyMonitor::Histogram::getPercentile(float percentile) const
+{
+    if (total == 0)
+        return Time::Zero;
+
+    // Find the bucket which contains the requested rank
+    Uint64 rank = static_cast<Uint64>(total * percentile / 100.f + 0.5f);
+    Uint64 count = 0;
+    for (std::size_t i = 0; i < counts.size(); ++i)
+    {
+        count += counts[i];
+        if ((count >= rank) && (count > 0))
+            return (i + 1 < counts.size()) ? bucketWidth * static_cast<Int64>(i + 1) : maximum;
+    }
+
+    return maximum;
+}
+
+
+////////////////////////////////////////////////////////////
+LatencyMonitor::LatencyMonitor() :
+m_current          (),
+m_pending          (),
+m_complete         (),
+m_queries          (),
+m_contextId        (0),
+m_gpuOffset        (0),
+m_presentedFrames  (0),
+m_presentationKnown(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+LatencyMonitor::~LatencyMonitor()
+{
+#ifndef SFML_OPENGL_ES
+
+    // Query objects belong to the window's context: they can only be deleted while it is active,
+    // otherwise they are released along with the context
+    if (m_contextId && (Context::getActiveContextId() == m_contextId))
+    {
+        for (std::size_t i = 0; i < m_pending.size(); ++i)
+        {
+            if (m_pending[i].query)
+                m_queries.push_back(m_pending[i].query);
+        }
+
+        if (!m_queries.empty())
+        {
+            glCheck(GLEXT_glDeleteQueries(static_cast<GLsizei>(m_queries.size()), &m_queries[0]));
+        }
+    }
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void LatencyMonitor::addEvent(const Event& event)
+{
+    if (!isInputEvent(event))
+        return;
+
+    // The latency of the frame starts at its oldest input event
+    if (!m_current.hasInput || (event.timestamp < m_current.input))
+    {
+        m_current.hasInput = true;
+        m_current.input    = event.timestamp;
+        m_current.received = Window::getEventTime();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void LatencyMonitor::display(Window& window)
+{
+    PendingFrame pending;
+    pending.frame           = m_current;
+    pending.frame.submitted = Window::getEventTime();
+    pending.query           = 0;
+    pending.presented       = false;
+
+#ifndef SFML_OPENGL_ES
+
+    if (window.setActive(true) && GLEXT_timer_query)
+    {
+        // The queries of another context can't be used here: forget them (they are released with their context)
+        Uint64 contextId = Context::getActiveContextId();
+        if (contextId != m_contextId)
+        {
+            m_queries.clear();
+            for (std::size_t i = 0; i < m_pending.size(); ++i)
+                m_pending[i].query = 0;
+
+            // Read a timestamp synchronously, to map the GPU clock to the time line of the events
+            GLuint query = 0;
+            GLuint64 timestamp = 0;
+            glCheck(GLEXT_glGenQueries(1, &query));
+            glCheck(GLEXT_glQueryCounter(query, GLEXT_GL_TIMESTAMP));
+            glCheck(GLEXT_glGetQueryObjectui64v(query, GLEXT_GL_QUERY_RESULT, &timestamp));
+            m_gpuOffset = Window::getEventTime().asMicroseconds() * 1000 - static_cast<Int64>(timestamp);
+            m_queries.push_back(query);
+            m_contextId = contextId;
+        }
+
+        // The timestamp is written once all the previous commands are complete
+        if (m_queries.empty())
+        {
+            glCheck(GLEXT_glGenQueries(1, &pending.query));
+        }
+        else
+        {
+            pending.query = m_queries.back();
+            m_queries.pop_back();
+        }
+
+        glCheck(GLEXT_glQueryCounter(pending.query, GLEXT_GL_TIMESTAMP));
+    }
+
+#endif
+
+    // The frames presented so far are not ours
+    if (!m_presentationKnown)
+    {
+        m_presentedFrames = window.getLastPresentation().frameCount;
+        m_presentationKnown = true;
+    }
+
+    window.display();
+
+    m_pending.push_back(pending);
+    collect(window);
+
+    // Start the next frame
+    Uint64 number = m_current.number + 1;
+    m_current = Frame();
+    m_current.number = number;
+}
+
+
+////////////////////////////////////////////////////////////
+bool LatencyMonitor::pollFrame(Frame& frame)
+{
+    if (m_complete.empty())
+        return false;
+
+    frame = m_complete.front();
+    m_complete.pop_front();
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+const LatencyMonitor::Histogram& LatencyMonitor::getHistogram(Interval interval) const
+{
+    return m_histograms[interval];
+}
+
+
+////////////////////////////////////////////////////////////
+void LatencyMonitor::reset()
+{
+    m_complete.clear();
+    for (int i = 0; i < IntervalCount; ++i)
+        m_histograms[i] = Histogram();
+}
+
+
+////////////////////////////////////////////////////////////
+void LatencyMonitor::collect(Window& window)
+{
+    // The frames are presented in order: the last of the newly presented ones was displayed at the reported time
+    Window::Presentation presentation = window.getLastPresentation();
+    if (presentation.available && (presentation.frameCount > m_presentedFrames))
+    {
+        Uint64 count = presentation.frameCount - m_presentedFrames;
+        m_presentedFrames = presentation.frameCount;
+
+        for (std::size_t i = 0; (i < m_pending.size()) && (count > 0); ++i)
+        {
+            if (m_pending[i].presented)
+                continue;
+
+            m_pending[i].presented = true;
+            if (--count == 0)
+                m_pending[i].frame.presented = presentation.time;
+        }
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    // The GPU completes the frames in order: stop at the first one which is not finished
+    if (m_contextId && (Context::getActiveContextId() == m_contextId))
+    {
+        for (std::size_t i = 0; i < m_pending.size(); ++i)
+        {
+            PendingFrame& pending = m_pending[i];
+            if (!pending.query)
+                continue;
+
+            GLuint available = 0;
+            glCheck(GLEXT_glGetQueryObjectuiv(pending.query, GLEXT_GL_QUERY_RESULT_AVAILABLE, &available));
+            if (!available)
+                break;
+
+            GLuint64 timestamp = 0;
+            glCheck(GLEXT_glGetQueryObjectui64v(pending.query, GLEXT_GL_QUERY_RESULT, &timestamp));
+            pending.frame.rendered = microseconds((static_cast<Int64>(timestamp) + m_gpuOffset) / 1000);
+
+            m_queries.push_back(pending.query);
+            pending.query = 0;
+        }
+    }
+
+#endif
+
+    // Complete the frames whose times are all known; the oldest ones are completed anyway
+    // when too many frames are waiting (no presentation feedback, minimized window, ...)
+    while (!m_pending.empty())
+    {
+        PendingFrame& pending = m_pending.front();
+        bool known = !pending.query && (pending.presented || !presentation.available);
+        if (!known && (m_pending.size() <= maxPendingFrames))
+            break;
+
+        const Frame& frame = pending.frame;
+        for (int i = 0; i < IntervalCount; ++i)
+        {
+            Interval interval = static_cast<Interval>(i);
+            if (!frame.isMeasured(interval))
+                continue;
+
+            Time duration = frame.getDuration(interval);
+            Histogram& histogram = m_histograms[i];
+            Int64 bucket = duration.asMicroseconds() / histogram.bucketWidth.asMicroseconds();
+            bucket = std::max<Int64>(0, std::min<Int64>(bucket, static_cast<Int64>(histogram.counts.size()) - 1));
+            histogram.counts[static_cast<std::size_t>(bucket)]++;
+            histogram.total++;
+            histogram.maximum = std::max(histogram.maximum, duration);
+        }
+
+        if (m_complete.size() >= maxCompleteFrames)
+            m_complete.pop_front();
+        m_complete.push_back(frame);
+
+        // A query whose result is not read yet can be issued again, its previous result is discarded
+        if (pending.query)
+            m_queries.push_back(pending.query);
+
+        m_pending.pop_front();
+    }
+}
+
+} // namespace sf
@@ -0,0 +1,747 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ParticleSystem.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/GLExtensions.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SFML_PARTICLES_SSE2
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define SFML_PARTICLES_NEON
+#endif
+
+
+namespace
+{
+    sf::Mutex mutex;
+
+    // The GPU particles store their emission time and lifetime in 16 bits of milliseconds
+    const sf::Int64 TimeWrap = 65536;
+    const sf::Int64 MaxGpuLifetime = 65535;
+
+    // Vertex shader of the GPU simulation: the position of a vertex is the initial position of its particle,
+    // its texture coordinates are the initial velocity, and its color holds the emission time and the lifetime
+    const char* simulationVertexSource =
+        "#version 120\n"
+        "uniform float time;\n"
+        "uniform vec2 acceleration;\n"
+        "uniform float drag;\n"
+        "uniform vec4 startColor;\n"
+        "uniform vec4 endColor;\n"
+        "uniform vec2 sizes;\n"
+        "uniform float pointScale;\n"
+        "void main()\n"
+        "{\n"
+        "    vec4 encoded = floor(gl_Color * 255.0 + 0.5);\n"
+        "    float emission = encoded.r * 256.0 + encoded.g;\n"
+        "    float lifetime = encoded.b * 256.0 + encoded.a;\n"
+        "    float age = mod(time - emission + 65536.0, 65536.0);\n"
+        "    if (age >= lifetime)\n"
+        "    {\n"
+        "        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);\n"
+        "        gl_PointSize = 0.0;\n"
+        "        gl_FrontColor = vec4(0.0);\n"
+        "        return;\n"
+        "    }\n"
+        "    float t = age / 1000.0;\n"
+        "    vec2 velocity = gl_MultiTexCoord0.xy;\n"
+        "    vec2 offset;\n"
+        "    if (drag > 0.0)\n"
+        "    {\n"
+        "        float factor = (1.0 - exp(-drag * t)) / drag;\n"
+        "        offset = velocity * factor + acceleration * (t - factor) / drag;\n"
+        "    }\n"
+        "    else\n"
+        "    {\n"
+        "        offset = velocity * t + 0.5 * acceleration * t * t;\n"
+        "    }\n"
+        "    float ratio = age / lifetime;\n"
+        "    gl_Position = gl_ModelViewProjectionMatrix * vec4(gl_Vertex.xy + offset, 0.0, 1.0);\n"
+        "    gl_PointSize = mix(sizes.x, sizes.y, ratio) * pointScale;\n"
+        "    gl_FrontColor = mix(startColor, endColor, ratio);\n"
+        "}\n";
+
+    // Vertex shader of the CPU simulation: the size of the particle is in the first texture coordinate
+    const char* pointVertexSource =
+        "#version 120\n"
+        "uniform float pointScale;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;\n"
+        "    gl_PointSize = gl_MultiTexCoord0.x * pointScale;\n"
+        "    gl_FrontColor = gl_Color;\n"
+        "}\n";
+
+    const char* fragmentSource =
+        "#version 120\n"
+        "uniform sampler2D texture;\n"
+        "uniform float textured;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = gl_Color * mix(vec4(1.0), texture2D(texture, gl_PointCoord), textured);\n"
+        "}\n";
+
+    // Shaders of the point sprites, shared by all the particle systems
+    struct ParticleShaders
+    {
+        sf::Shader* simulation;
+        sf::Shader* points;
+    };
+
+    // Get the shaders of the point sprites, creating them on first use. They
+    // are intentionally never destroyed, like the instancing shader.
+    const ParticleShaders& getShaders()
+    {
+        // TODO: Remove this lock when it becomes unnecessary in C++11
+        sf::Lock lock(mutex);
+
+        static ParticleShaders shaders = {NULL, NULL};
+        static bool initialized = false;
+
+        if (!initialized)
+        {
+            initialized = true;
+
+            // Make sure that a context is active for the checks and the compilation
+            sf::Context context;
+            sf::priv::ensureExtensionsInit();
+
+            if (sf::Shader::isAvailable() && GLEXT_point_sprite)
+            {
+                const char* vertexSources[2] = {simulationVertexSource, pointVertexSource};
+                sf::Shader** outputs[2] = {&shaders.simulation, &shaders.points};
+
+                for (int i = 0; i < 2; ++i)
+                {
+                    sf::Shader* shader = new sf::Shader;
+                    if (shader->loadFromMemory(vertexSources[i], fragmentSource))
+                    {
+                        shader->setParameter("texture", sf::Shader::CurrentTexture);
+                        *outputs[i] = shader;
+                    }
+                    else
+                    {
+                        delete shader;
+                    }
+                }
+            }
+        }
+
+        return shaders;
+    }
+
+    // Integrate the motion of particles along one axis over a time step:
+    // position += velocity * factor + positionOffset, velocity = velocity * decay + velocityOffset
+    void integrate(float* position, float* velocity, std::size_t count, float factor, float decay,
+                   float positionOffset, float velocityOffset)
+    {
+        std::size_t i = 0;
+
+#if defined(SFML_PARTICLES_SSE2)
+
+        __m128 factors         = _mm_set1_ps(factor);
+        __m128 decays          = _mm_set1_ps(decay);
+        __m128 positionOffsets = _mm_set1_ps(positionOffset);
+        __m128 velocityOffsets = _mm_set1_ps(velocityOffset);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 v = _mm_loadu_ps(velocity + i);
+            __m128 p = _mm_loadu_ps(position + i);
+            p = _mm_add_ps(p, _mm_add_ps(_mm_mul_ps(v, factors), positionOffsets));
+            v = _mm_add_ps(_mm_mul_ps(v, decays), velocityOffsets);
+            _mm_storeu_ps(position + i, p);
+            _mm_storeu_ps(velocity + i, v);
+        }
+
+#elif defined(SFML_PARTICLES_NEON)
+
+        float32x4_t factors         = vdupq_n_f32(factor);
+        float32x4_t decays          = vdupq_n_f32(decay);
+        float32x4_t positionOffsets = vdupq_n_f32(positionOffset);
+        float32x4_t velocityOffsets = vdupq_n_f32(velocityOffset);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            float32x4_t v = vld1q_f32(velocity + i);
+            float32x4_t p = vld1q_f32(position + i);
+            p = vaddq_f32(p, vmlaq_f32(positionOffsets, v, factors));
+            v = vmlaq_f32(velocityOffsets, v, decays);
+            vst1q_f32(position + i, p);
+            vst1q_f32(velocity + i, v);
+        }
+
+#endif
+
+        for (; i < count; ++i)
+        {
+            float v = velocity[i];
+            position[i] += v * factor + positionOffset;
+            velocity[i] = v * decay + velocityOffset;
+        }
+    }
+
+    // Add the same value to an array of floats
+    void increase(float* values, std::size_t count, float value)
+    {
+        std::size_t i = 0;
+
+#if defined(SFML_PARTICLES_SSE2)
+
+        __m128 values4 = _mm_set1_ps(value);
+        for (; i + 4 <= count; i += 4)
+            _mm_storeu_ps(values + i, _mm_add_ps(_mm_loadu_ps(values + i), values4));
+
+#elif defined(SFML_PARTICLES_NEON)
+
+        float32x4_t values4 = vdupq_n_f32(value);
+        for (; i + 4 <= count; i += 4)
+            vst1q_f32(values + i, vaddq_f32(vld1q_f32(values + i), values4));
+
+#endif
+
+        for (; i < count; ++i)
+            values[i] += value;
+    }
+
+    // Interpolate between two colors
+    sf::Color interpolate(const sf::Color& start, const sf::Color& end, float ratio)
+    {
+        return sf::Color(static_cast<sf::Uint8>(start.r + (end.r - start.r) * ratio),
+                         static_cast<sf::Uint8>(start.g + (end.g - start.g) * ratio),
+                         static_cast<sf::Uint8>(start.b + (end.b - start.b) * ratio),
+                         static_cast<sf::Uint8>(start.a + (end.a - start.a) * ratio));
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ParticleSystem::Emitter::Emitter() :
+position      (0.f, 0.f),
+positionSpread(0.f, 0.f),
+rate          (100.f),
+angle         (0.f),
+angleSpread   (180.f),
+speed         (100.f),
+speedSpread   (0.f),
+lifetime      (seconds(1.f)),
+lifetimeSpread(Time::Zero)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ParticleSystem::Affector::~Affector()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ParticleSystem::ParticleSystem(std::size_t capacity) :
+m_capacity          (capacity),
+m_emitters          (),
+m_emissionRemainders(),
+m_affectors         (),
+m_acceleration      (0.f, 0.f),
+m_drag              (0.f),
+m_startColor        (Color::White),
+m_endColor          (255, 255, 255, 0),
+m_startSize         (4.f),
+m_endSize           (4.f),
+m_texture           (NULL),
+m_gpuEnabled        (true),
+m_gpuActive         (false),
+m_time              (0),
+m_seed              (0x9E3779B9),
+m_count             (0),
+m_positionX         (capacity),
+m_positionY         (capacity),
+m_velocityX         (capacity),
+m_velocityY         (capacity),
+m_age               (capacity),
+m_lifetime          (capacity),
+m_vertices          (),
+m_spawnBuffer       (Points, VertexBuffer::Stream),
+m_spawns            (),
+m_deathTimes        (),
+m_ringHead          (0),
+m_spawnStart        (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ParticleSystem::getCapacity() const
+{
+    return m_capacity;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ParticleSystem::getParticleCount() const
+{
+    if (!m_gpuActive)
+        return m_count;
+
+    Int64 now = m_time / 1000;
+    return static_cast<std::size_t>(std::count_if(m_deathTimes.begin(), m_deathTimes.end(),
+                                                  std::bind2nd(std::greater<Int64>(), now)));
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ParticleSystem::addEmitter(const Emitter& emitter)
+{
+    m_emitters.push_back(emitter);
+    m_emissionRemainders.push_back(0.f);
+
+    return m_emitters.size() - 1;
+}
+
+
+////////////////////////////////////////////////////////////
+ParticleSystem::Emitter& ParticleSystem::getEmitter(std::size_t index)
+{
+    return m_emitters[index];
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ParticleSystem::getEmitterCount() const
+{
+    return m_emitters.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::removeEmitter(std::size_t index)
+{
+    m_emitters.erase(m_emitters.begin() + index);
+    m_emissionRemainders.erase(m_emissionRemainders.begin() + index);
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::emit(const Emitter& emitter, std::size_t count)
+{
+    spawn(emitter, count);
+
+    if (m_gpuActive)
+        uploadSpawns();
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::addAffector(Affector& affector)
+{
+    m_affectors.push_back(&affector);
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::removeAffector(Affector& affector)
+{
+    m_affectors.erase(std::remove(m_affectors.begin(), m_affectors.end(), &affector), m_affectors.end());
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setAcceleration(const Vector2f& acceleration)
+{
+    m_acceleration = acceleration;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& ParticleSystem::getAcceleration() const
+{
+    return m_acceleration;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setDrag(float drag)
+{
+    m_drag = std::max(drag, 0.f);
+}
+
+
+////////////////////////////////////////////////////////////
+float ParticleSystem::getDrag() const
+{
+    return m_drag;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setColors(const Color& start, const Color& end)
+{
+    m_startColor = start;
+    m_endColor = end;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setSizes(float start, float end)
+{
+    m_startSize = start;
+    m_endSize = end;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setTexture(const Texture* texture)
+{
+    m_texture = texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* ParticleSystem::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setGpuSimulationEnabled(bool enabled)
+{
+    m_gpuEnabled = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ParticleSystem::isGpuSimulationEnabled() const
+{
+    return m_gpuEnabled;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::update(Time elapsed)
+{
+    // The particles can't move from one simulation to the other
+    bool gpu = m_gpuEnabled && m_affectors.empty() && isGpuSimulationAvailable();
+    if (gpu != m_gpuActive)
+    {
+        clear();
+        m_gpuActive = gpu;
+
+        if (gpu)
+        {
+            // The slots of the ring buffer start empty, with a lifetime of 0
+            m_spawnBuffer.create(m_capacity);
+            std::vector<Vertex> empty(m_capacity, Vertex(Vector2f(0.f, 0.f), Color(0, 0, 0, 0)));
+            if (!empty.empty())
+                m_spawnBuffer.update(&empty[0]);
+
+            m_deathTimes.assign(m_capacity, 0);
+        }
+        else
+        {
+            m_spawnBuffer.create(0);
+            std::vector<Int64>().swap(m_deathTimes);
+        }
+    }
+
+    float dt = elapsed.asSeconds();
+    m_time += elapsed.asMicroseconds();
+
+    // The GPU particles move by themselves, only the CPU ones have to be updated
+    if (!m_gpuActive && (m_count > 0) && (dt > 0.f))
+    {
+        // Exact motion with a constant acceleration a and a drag k:
+        // v(t) = v0 e^-kt + a (1 - e^-kt) / k, the position being its integral
+        float decay = std::exp(-m_drag * dt);
+        float factor = (m_drag > 0.f) ? (1.f - decay) / m_drag : dt;
+        float accelerationFactor = (m_drag > 0.f) ? (dt - factor) / m_drag : dt * dt / 2;
+
+        integrate(&m_positionX[0], &m_velocityX[0], m_count, factor, decay,
+                  m_acceleration.x * accelerationFactor, m_acceleration.x * factor);
+        integrate(&m_positionY[0], &m_velocityY[0], m_count, factor, decay,
+                  m_acceleration.y * accelerationFactor, m_acceleration.y * factor);
+        increase(&m_age[0], m_count, dt);
+
+        if (!m_affectors.empty())
+        {
+            Particles particles = {m_count, &m_positionX[0], &m_positionY[0], &m_velocityX[0],
+                                   &m_velocityY[0], &m_age[0], &m_lifetime[0]};
+
+            for (std::vector<Affector*>::iterator it = m_affectors.begin(); it != m_affectors.end(); ++it)
+                (*it)->affect(particles, elapsed);
+        }
+
+        // Remove the dead particles, replacing them with the last ones
+        for (std::size_t i = 0; i < m_count;)
+        {
+            if (m_age[i] >= m_lifetime[i])
+            {
+                --m_count;
+                m_positionX[i] = m_positionX[m_count];
+                m_positionY[i] = m_positionY[m_count];
+                m_velocityX[i] = m_velocityX[m_count];
+                m_velocityY[i] = m_velocityY[m_count];
+                m_age[i] = m_age[m_count];
+                m_lifetime[i] = m_lifetime[m_count];
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    }
+
+    // Emit the new particles, keeping the fractions for the next updates
+    for (std::size_t i = 0; i < m_emitters.size(); ++i)
+    {
+        float& remainder = m_emissionRemainders[i];
+        remainder += std::max(m_emitters[i].rate, 0.f) * dt;
+
+        std::size_t count = static_cast<std::size_t>(remainder);
+        remainder -= static_cast<float>(count);
+
+        spawn(m_emitters[i], count);
+    }
+
+    if (m_gpuActive)
+        uploadSpawns();
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::clear()
+{
+    m_count = 0;
+    std::fill(m_deathTimes.begin(), m_deathTimes.end(), 0);
+    m_spawns.clear();
+
+    // The dead particles of the GPU are those whose lifetime has elapsed, the
+    // cleared slots of the ring buffer have to be overwritten with empty ones
+    if (m_gpuActive && (m_capacity > 0))
+    {
+        std::vector<Vertex> empty(m_capacity, Vertex(Vector2f(0.f, 0.f), Color(0, 0, 0, 0)));
+        m_spawnBuffer.update(&empty[0]);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool ParticleSystem::isGpuSimulationAvailable()
+{
+    return VertexBuffer::isAvailable() && getShaders().simulation;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::draw(RenderTarget& target, RenderStates states) const
+{
+    states.transform *= getTransform();
+    states.texture = m_texture;
+
+    if (m_gpuActive)
+    {
+        Shader* shader = getShaders().simulation;
+
+        // Enable the point sprites first, it flushes the batch that may still use the shared shader
+        target.setPointSpritesEnabled(true);
+
+        shader->setParameter("time", static_cast<float>((m_time / 1000) % TimeWrap));
+        shader->setParameter("acceleration", m_acceleration);
+        shader->setParameter("drag", m_drag);
+        shader->setParameter("startColor", m_startColor);
+        shader->setParameter("endColor", m_endColor);
+        shader->setParameter("sizes", m_startSize, m_endSize);
+        shader->setParameter("pointScale", getPointScale(target, states.transform));
+        shader->setParameter("textured", m_texture ? 1.f : 0.f);
+        states.shader = shader;
+
+        target.draw(m_spawnBuffer, states);
+        target.setPointSpritesEnabled(false);
+        return;
+    }
+
+    if (m_count == 0)
+        return;
+
+    Shader* shader = states.shader ? NULL : getShaders().points;
+    if (shader)
+    {
+        // One point per particle, its size is in the first texture coordinate
+        m_vertices.resize(m_count);
+        for (std::size_t i = 0; i < m_count; ++i)
+        {
+            float ratio = m_age[i] / m_lifetime[i];
+            Vertex& vertex = m_vertices[i];
+            vertex.position = Vector2f(m_positionX[i], m_positionY[i]);
+            vertex.color = interpolate(m_startColor, m_endColor, ratio);
+            vertex.texCoords = Vector2f(m_startSize + (m_endSize - m_startSize) * ratio, 0.f);
+        }
+
+        target.setPointSpritesEnabled(true);
+
+        shader->setParameter("pointScale", getPointScale(target, states.transform));
+        shader->setParameter("textured", m_texture ? 1.f : 0.f);
+        states.shader = shader;
+
+        target.draw(&m_vertices[0], m_count, Points, states);
+        target.setPointSpritesEnabled(false);
+    }
+    else
+    {
+        // Fallback: two triangles per particle
+        Vector2f textureSize = m_texture ? Vector2f(m_texture->getSize()) : Vector2f(0.f, 0.f);
+
+        m_vertices.resize(m_count * 6);
+        for (std::size_t i = 0; i < m_count; ++i)
+        {
+            float ratio = m_age[i] / m_lifetime[i];
+            float half = (m_startSize + (m_endSize - m_startSize) * ratio) / 2;
+            float left = m_positionX[i] - half;
+            float top = m_positionY[i] - half;
+            float right = m_positionX[i] + half;
+            float bottom = m_positionY[i] + half;
+            Color color = interpolate(m_startColor, m_endColor, ratio);
+
+            Vertex* vertices = &m_vertices[i * 6];
+            vertices[0] = Vertex(Vector2f(left, top), color, Vector2f(0.f, 0.f));
+            vertices[1] = Vertex(Vector2f(left, bottom), color, Vector2f(0.f, textureSize.y));
+            vertices[2] = Vertex(Vector2f(right, top), color, Vector2f(textureSize.x, 0.f));
+            vertices[3] = vertices[2];
+            vertices[4] = vertices[1];
+            vertices[5] = Vertex(Vector2f(right, bottom), color, textureSize);
+        }
+
+        target.draw(&m_vertices[0], m_vertices.size(), Triangles, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::spawn(const Emitter& emitter, std::size_t count)
+{
+    const float degreesToRadians = 3.141592654f / 180.f;
+    Int64 now = m_time / 1000;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        // The new particles are dropped when the system is full
+        if (m_gpuActive ? (m_deathTimes.empty() || (m_deathTimes[m_ringHead] > now)) : (m_count == m_capacity))
+            break;
+
+        float x = emitter.position.x + emitter.positionSpread.x * random();
+        float y = emitter.position.y + emitter.positionSpread.y * random();
+        float angle = (emitter.angle + emitter.angleSpread * random()) * degreesToRadians;
+        float speed = emitter.speed + emitter.speedSpread * random();
+        float lifetime = std::max(emitter.lifetime.asSeconds() + emitter.lifetimeSpread.asSeconds() * random(), 0.001f);
+
+        if (m_gpuActive)
+        {
+            // Write the particle in the next slot of the ring buffer, encoding its emission time and lifetime
+            Uint32 emission = static_cast<Uint32>(now % TimeWrap);
+            Uint32 lifetimeMs = static_cast<Uint32>(std::min<Int64>(static_cast<Int64>(lifetime * 1000), MaxGpuLifetime));
+            lifetimeMs = std::max<Uint32>(lifetimeMs, 1);
+
+            if (m_spawns.empty())
+                m_spawnStart = m_ringHead;
+
+            m_spawns.push_back(Vertex(Vector2f(x, y),
+                                      Color(static_cast<Uint8>(emission >> 8), static_cast<Uint8>(emission & 0xFF),
+                                            static_cast<Uint8>(lifetimeMs >> 8), static_cast<Uint8>(lifetimeMs & 0xFF)),
+                                      Vector2f(std::cos(angle) * speed, std::sin(angle) * speed)));
+
+            m_deathTimes[m_ringHead] = now + lifetimeMs;
+            m_ringHead = (m_ringHead + 1) % m_capacity;
+        }
+        else
+        {
+            m_positionX[m_count] = x;
+            m_positionY[m_count] = y;
+            m_velocityX[m_count] = std::cos(angle) * speed;
+            m_velocityY[m_count] = std::sin(angle) * speed;
+            m_age[m_count] = 0.f;
+            m_lifetime[m_count] = lifetime;
+            ++m_count;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::uploadSpawns()
+{
+    if (m_spawns.empty())
+        return;
+
+    // The new particles are contiguous in the ring buffer, except when they wrap around its end
+    std::size_t first = std::min(m_spawns.size(), m_capacity - m_spawnStart);
+    m_spawnBuffer.update(&m_spawns[0], first, static_cast<unsigned int>(m_spawnStart));
+    if (first < m_spawns.size())
+        m_spawnBuffer.update(&m_spawns[first], m_spawns.size() - first, 0);
+
+    m_spawns.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+float ParticleSystem::random()
+{
+    // Xorshift generator, much faster than std::rand for the amount of numbers needed
+    m_seed ^= m_seed << 13;
+    m_seed ^= m_seed >> 17;
+    m_seed ^= m_seed << 5;
+
+    return static_cast<float>(m_seed >> 8) * (2.f / 16777216.f) - 1.f;
+}
+
+
+////////////////////////////////////////////////////////////
+float ParticleSystem::getPointScale(const RenderTarget& target, const Transform& transform)
+{
+    // Pixels per unit of the view, times the scale of the transform
+    const View& view = target.getView();
+    float viewScale = static_cast<float>(target.getViewport(view).height) / std::abs(view.getSize().y);
+
+    const float* matrix = transform.getMatrix();
+    float transformScale = std::sqrt(std::abs(matrix[0] * matrix[5] - matrix[1] * matrix[4]));
+
+    return viewScale * transformScale;
+}
+
+} // namespace sf
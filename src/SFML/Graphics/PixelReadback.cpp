@@ -0,0 +1,395 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/PixelReadback.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/TextureSaver.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <cstring>
+
+
+namespace
+{
+    sf::Mutex mutex;
+
+    bool checkPixelBuffersAvailable()
+    {
+        // Create a temporary context in case the user checks
+        // before a GlResource is created, thus initializing
+        // the shared context
+        sf::Context context;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+    #ifndef SFML_OPENGL_ES
+        return GLEXT_vertex_buffer_object && GLEXT_pixel_buffer_object;
+    #else
+        return false;
+    #endif
+    }
+
+    bool checkFencesAvailable()
+    {
+    #ifndef SFML_OPENGL_ES
+        return GLEXT_sync;
+    #else
+        return false;
+    #endif
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+PixelReadback::PixelReadback() :
+m_buffer    (0),
+m_fence     (NULL),
+m_image     (),
+m_size      (0, 0),
+m_bufferSize(0, 0),
+m_flipped   (false),
+m_pending   (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+PixelReadback::~PixelReadback()
+{
+#ifndef SFML_OPENGL_ES
+
+    if (m_buffer || m_fence)
+    {
+        ensureGlContext();
+
+        deleteFence();
+
+        if (m_buffer)
+        {
+            GLuint buffer = static_cast<GLuint>(m_buffer);
+            glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+        }
+    }
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+bool PixelReadback::start(const Texture& texture)
+{
+    m_pending = false;
+
+    if (!texture.m_texture)
+        return false;
+
+    if (!isAvailable())
+    {
+        // Fallback: synchronous copy
+        m_image = texture.copyToImage();
+        m_pending = true;
+        return true;
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    ensureGlContext();
+
+    if (!m_buffer)
+    {
+        GLuint buffer = 0;
+        glCheck(GLEXT_glGenBuffers(1, &buffer));
+        m_buffer = static_cast<unsigned int>(buffer);
+    }
+
+    if (!m_buffer)
+    {
+        err() << "Failed to start pixel readback, buffer generation failed" << std::endl;
+        return false;
+    }
+
+    // The whole texture is read, including padding, it is cropped when the pixels are retrieved
+    m_size = texture.m_size;
+    m_bufferSize = texture.m_actualSize;
+    m_flipped = texture.m_pixelsFlipped;
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    // With a pack buffer bound, the pixel pointer is an offset into the buffer
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, m_buffer));
+    glCheck(GLEXT_glBufferData(GLEXT_GL_PIXEL_PACK_BUFFER, m_bufferSize.x * m_bufferSize.y * 4, NULL, GLEXT_GL_STREAM_READ));
+    priv::bindTexture(GL_TEXTURE_2D, texture.m_texture);
+    glCheck(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, 0));
+
+    insertFence();
+    m_pending = true;
+
+#endif
+
+    return m_pending;
+}
+
+
+////////////////////////////////////////////////////////////
+bool PixelReadback::start(RenderWindow& window)
+{
+    m_pending = false;
+
+    // Pending batched primitives must be part of the image
+    window.flush();
+
+    if (!isAvailable())
+    {
+        // Fallback: synchronous copy
+        m_image = window.capture();
+        m_pending = true;
+        return true;
+    }
+
+    return window.setActive() && readFramebuffer(window.getSize());
+}
+
+
+////////////////////////////////////////////////////////////
+bool PixelReadback::start(RenderTexture& renderTexture)
+{
+    m_pending = false;
+
+    // Pending batched primitives must be part of the image
+    renderTexture.flush();
+
+    if (!isAvailable())
+    {
+        // Fallback: synchronous copy
+        m_image = renderTexture.getTexture().copyToImage();
+        m_pending = true;
+        return true;
+    }
+
+    return renderTexture.setActive() && readFramebuffer(renderTexture.getSize());
+}
+
+
+////////////////////////////////////////////////////////////
+bool PixelReadback::isPending() const
+{
+    return m_pending;
+}
+
+
+////////////////////////////////////////////////////////////
+bool PixelReadback::isReady() const
+{
+    if (!m_pending)
+        return false;
+
+#ifndef SFML_OPENGL_ES
+
+    if (m_fence)
+    {
+        // Poll the fence without waiting
+        GLenum status = GLEXT_glClientWaitSync(static_cast<GLEXT_GLsync>(m_fence), 0, 0);
+        return (status == GLEXT_GL_ALREADY_SIGNALED) || (status == GLEXT_GL_CONDITION_SATISFIED);
+    }
+
+#endif
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool PixelReadback::getImage(Image& image)
+{
+    if (!m_pending)
+        return false;
+
+    m_pending = false;
+
+    if (!isAvailable())
+    {
+        image = m_image;
+        m_image = Image();
+        return true;
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    ensureGlContext();
+
+    deleteFence();
+
+    // Mapping the buffer waits for the copy to be done, if it is not already
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, m_buffer));
+
+    const Uint8* src = NULL;
+    glCheck(src = static_cast<const Uint8*>(GLEXT_glMapBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, GLEXT_GL_READ_ONLY)));
+
+    bool success = false;
+    if (src)
+    {
+        // Copy the useful pixels, flipping the rows if they are stored bottom to top
+        std::vector<Uint8> pixels(m_size.x * m_size.y * 4);
+        Uint8* dst = &pixels[0];
+        int srcPitch = m_bufferSize.x * 4;
+        int dstPitch = m_size.x * 4;
+
+        if (m_flipped)
+        {
+            src += srcPitch * (m_size.y - 1);
+            srcPitch = -srcPitch;
+        }
+
+        for (unsigned int i = 0; i < m_size.y; ++i)
+        {
+            std::memcpy(dst, src, dstPitch);
+            src += srcPitch;
+            dst += dstPitch;
+        }
+
+        glCheck(GLEXT_glUnmapBuffer(GLEXT_GL_PIXEL_PACK_BUFFER));
+
+        image.create(m_size.x, m_size.y, &pixels[0]);
+        success = true;
+    }
+    else
+    {
+        err() << "Failed to retrieve pixel readback, the buffer could not be mapped" << std::endl;
+    }
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, 0));
+
+    return success;
+
+#else
+
+    return false;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+bool PixelReadback::isAvailable()
+{
+    // TODO: Remove this lock when it becomes unnecessary in C++11
+    Lock lock(mutex);
+
+    static bool available = checkPixelBuffersAvailable();
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+bool PixelReadback::readFramebuffer(const Vector2u& size)
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!m_buffer)
+    {
+        GLuint buffer = 0;
+        glCheck(GLEXT_glGenBuffers(1, &buffer));
+        m_buffer = static_cast<unsigned int>(buffer);
+    }
+
+    if (!m_buffer)
+    {
+        err() << "Failed to start pixel readback, buffer generation failed" << std::endl;
+        return false;
+    }
+
+    // OpenGL's origin is bottom while SFML's origin is top: rows are flipped when retrieved
+    m_size = size;
+    m_bufferSize = size;
+    m_flipped = true;
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, m_buffer));
+    glCheck(GLEXT_glBufferData(GLEXT_GL_PIXEL_PACK_BUFFER, size.x * size.y * 4, NULL, GLEXT_GL_STREAM_READ));
+    glCheck(glReadPixels(0, 0, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, 0));
+
+    insertFence();
+    m_pending = true;
+
+    return true;
+
+#else
+
+    (void)size;
+    return false;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void PixelReadback::insertFence()
+{
+#ifndef SFML_OPENGL_ES
+
+    deleteFence();
+
+    if (checkFencesAvailable())
+    {
+        GLEXT_GLsync fence = NULL;
+        glCheck(fence = GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+        m_fence = fence;
+    }
+
+    // Make sure that the commands are submitted, so that polling from another context works
+    glCheck(glFlush());
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void PixelReadback::deleteFence()
+{
+#ifndef SFML_OPENGL_ES
+
+    if (m_fence)
+    {
+        glCheck(GLEXT_glDeleteSync(static_cast<GLEXT_GLsync>(m_fence)));
+        m_fence = NULL;
+    }
+
+#endif
+}
+
+} // namespace sf
@@ -0,0 +1,171 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/PostProcessChain.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/RenderTexturePool.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+PostProcessChain::PostProcessChain(RenderTexturePool& pool) :
+m_pool  (&pool),
+m_passes(),
+m_smooth(false)
+{
+    m_targets[0] = NULL;
+    m_targets[1] = NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+PostProcessChain::~PostProcessChain()
+{
+    releaseTargets();
+}
+
+
+////////////////////////////////////////////////////////////
+void PostProcessChain::addPass(const Shader& shader)
+{
+    m_passes.push_back(&shader);
+}
+
+
+////////////////////////////////////////////////////////////
+void PostProcessChain::clearPasses()
+{
+    m_passes.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t PostProcessChain::getPassCount() const
+{
+    return m_passes.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void PostProcessChain::setSmooth(bool smooth)
+{
+    m_smooth = smooth;
+
+    for (int i = 0; i < 2; ++i)
+    {
+        if (m_targets[i])
+            m_targets[i]->setSmooth(smooth);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool PostProcessChain::isSmooth() const
+{
+    return m_smooth;
+}
+
+
+////////////////////////////////////////////////////////////
+void PostProcessChain::apply(const Texture& source, RenderTarget& target, const RenderStates& states)
+{
+    Vector2u size = source.getSize();
+    if ((size.x == 0) || (size.y == 0))
+        return;
+
+    // A single pass draws directly into the target, two passes need one intermediate texture
+    std::size_t targetCount = m_passes.empty() ? 0 : std::min<std::size_t>(m_passes.size() - 1, 2);
+    if (!ensureTargets(size.x, size.y, targetCount))
+        return;
+
+    // The rectangle covers the source, and the intermediate textures which have the same size
+    float width = static_cast<float>(size.x);
+    float height = static_cast<float>(size.y);
+    m_quad[0] = Vertex(Vector2f(0, 0), Vector2f(0, 0));
+    m_quad[1] = Vertex(Vector2f(0, height), Vector2f(0, height));
+    m_quad[2] = Vertex(Vector2f(width, 0), Vector2f(width, 0));
+    m_quad[3] = Vertex(Vector2f(width, height), Vector2f(width, height));
+
+    // Intermediate passes replace the pixels of their target, no need to clear or blend
+    const Texture* input = &source;
+    for (std::size_t i = 0; i + 1 < m_passes.size(); ++i)
+    {
+        RenderTexture& output = *m_targets[i % 2];
+        output.draw(m_quad, 4, TrianglesStrip, RenderStates(BlendNone, Transform::Identity, input, m_passes[i]));
+        output.display();
+
+        input = &output.getTexture();
+    }
+
+    RenderStates last = states;
+    last.texture = input;
+    last.shader = m_passes.empty() ? NULL : m_passes.back();
+    target.draw(m_quad, 4, TrianglesStrip, last);
+}
+
+
+////////////////////////////////////////////////////////////
+bool PostProcessChain::ensureTargets(unsigned int width, unsigned int height, std::size_t count)
+{
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+        // Textures of another size go back to the pool, the ones that are not needed anymore too
+        if (m_targets[i] && ((i >= count) || (m_targets[i]->getSize() != Vector2u(width, height))))
+        {
+            m_pool->release(m_targets[i]);
+            m_targets[i] = NULL;
+        }
+
+        if (!m_targets[i] && (i < count))
+        {
+            m_targets[i] = m_pool->acquire(width, height);
+            if (!m_targets[i])
+                return false;
+
+            m_targets[i]->setSmooth(m_smooth);
+        }
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void PostProcessChain::releaseTargets()
+{
+    for (int i = 0; i < 2; ++i)
+    {
+        m_pool->release(m_targets[i]);
+        m_targets[i] = NULL;
+    }
+}
+
+} // namespace sf
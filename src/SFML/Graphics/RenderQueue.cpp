@@ -0,0 +1,376 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RenderQueue.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+    // Layout of the sort key, from the most significant bits to the least significant ones
+    const unsigned int layerShift   = 56;
+    const unsigned int shaderShift  = 44;
+    const unsigned int textureShift = 28;
+    const unsigned int blendShift   = 20;
+    const unsigned int depthShift   = 0;
+    const sf::Uint64   layerMask    = 0xFF;
+    const sf::Uint64   shaderMask   = 0xFFF;
+    const sf::Uint64   textureMask  = 0xFFFF;
+    const sf::Uint64   blendMask    = 0xFF;
+    const sf::Uint64   depthMask    = 0xFFFFF;
+
+    // Commands are opaque if they replace the pixels behind them
+    bool isOpaque(const sf::RenderStates& states)
+    {
+        return states.blendMode == sf::BlendNone;
+    }
+
+    // Convert a float to an unsigned integer that keeps the same ordering
+    sf::Uint32 sortableDepth(float depth)
+    {
+        sf::Uint32 bits;
+        std::memcpy(&bits, &depth, sizeof(bits));
+
+        // Negative numbers have all their bits flipped, positive ones only the sign bit
+        return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+    }
+
+    // Find the id of an object in a map, or assign it the next available one.
+    // NULL objects always have the id 0, so that they are sorted first.
+    template <typename T>
+    sf::Uint64 getIndex(std::map<const T*, sf::Uint64>& ids, const T* object, sf::Uint64 mask)
+    {
+        if (!object)
+            return 0;
+
+        typename std::map<const T*, sf::Uint64>::iterator it = ids.find(object);
+        if (it != ids.end())
+            return it->second;
+
+        // Objects that don't fit in the key share the last id, they are still correctly drawn
+        sf::Uint64 id = std::min<sf::Uint64>(ids.size() + 1, mask);
+        ids.insert(std::make_pair(object, id));
+        return id;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+RenderQueue::RenderQueue() :
+m_commands  (),
+m_vertices  (),
+m_keys      (),
+m_shaders   (),
+m_textures  (),
+m_blendModes(),
+m_order     (),
+m_scratch   (),
+m_sorted    (true),
+m_batching  (true),
+m_mode      (Sorted)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::add(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+                      const RenderStates& states, Uint8 layer, float depth)
+{
+    // Nothing to draw?
+    if (!vertices || (vertexCount == 0))
+        return;
+
+    Command command;
+    command.states = states;
+    command.drawable = NULL;
+    command.firstVertex = m_vertices.size();
+    command.vertexCount = vertexCount;
+    command.type = type;
+
+    m_vertices.insert(m_vertices.end(), vertices, vertices + vertexCount);
+    m_commands.push_back(command);
+    m_keys.push_back(computeKey(states, layer, depth));
+    m_sorted = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::add(const VertexArray& vertices, const RenderStates& states, Uint8 layer, float depth)
+{
+    if (vertices.getVertexCount() > 0)
+        add(&vertices[0], vertices.getVertexCount(), vertices.getPrimitiveType(), states, layer, depth);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::add(const Drawable& drawable, const RenderStates& states, Uint8 layer, float depth)
+{
+    Command command;
+    command.states = states;
+    command.drawable = &drawable;
+    command.firstVertex = 0;
+    command.vertexCount = 0;
+    command.type = Points;
+
+    m_commands.push_back(command);
+    m_keys.push_back(computeKey(states, layer, depth));
+    m_sorted = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::clear()
+{
+    m_commands.clear();
+    m_vertices.clear();
+    m_keys.clear();
+    m_shaders.clear();
+    m_textures.clear();
+    m_blendModes.clear();
+    m_order.clear();
+    m_sorted = true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderQueue::getCommandCount() const
+{
+    return m_commands.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::setBatchingEnabled(bool enabled)
+{
+    m_batching = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderQueue::isBatchingEnabled() const
+{
+    return m_batching;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::setMode(Mode mode)
+{
+    m_mode = mode;
+}
+
+
+////////////////////////////////////////////////////////////
+RenderQueue::Mode RenderQueue::getMode() const
+{
+    return m_mode;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::draw(RenderTarget& target, RenderStates states) const
+{
+    if (m_commands.empty())
+        return;
+
+    sort();
+
+    bool wasBatching = target.isBatchingEnabled();
+    if (m_batching)
+        target.setBatchingEnabled(true);
+
+    if (m_mode == OpaqueFirst)
+    {
+        drawOpaqueFirst(target, states);
+    }
+    else
+    {
+        for (std::vector<std::size_t>::const_iterator it = m_order.begin(); it != m_order.end(); ++it)
+            drawCommand(target, m_commands[*it], states, m_commands[*it].states.depth);
+    }
+
+    // Restore the batching mode of the target, this flushes what we added if it was disabled
+    if (m_batching && !wasBatching)
+        target.setBatchingEnabled(false);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::drawOpaqueFirst(RenderTarget& target, const RenderStates& states) const
+{
+    // Consecutive commands with the same states share a depth: in the opaque pass they are
+    // drawn in reverse order, so the depth test (which rejects equal depths) keeps the last one
+    // on top, as in the sorted order
+    std::size_t count = m_order.size();
+    std::size_t runCount = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (isRunStart(i))
+            ++runCount;
+    }
+
+    // The first run is the farthest one, depths go from 1 (excluded) to -1 (excluded)
+    float step = 2.f / static_cast<float>(runCount + 1);
+
+    RenderTarget::DepthTest previousTest = target.getDepthTest();
+    target.clearDepth();
+
+    // Opaque commands, from the nearest to the farthest
+    target.setDepthTest(RenderTarget::DepthTestWrite);
+    std::size_t run = runCount;
+    for (std::size_t i = count; i > 0; --i)
+    {
+        const Command& command = m_commands[m_order[i - 1]];
+        if (isOpaque(command.states))
+            drawCommand(target, command, states, 1.f - static_cast<float>(run) * step);
+
+        if (isRunStart(i - 1))
+            --run;
+    }
+
+    // Translucent commands, from the farthest to the nearest, tested against the opaque ones
+    target.setDepthTest(RenderTarget::DepthTestRead);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (isRunStart(i))
+            ++run;
+
+        const Command& command = m_commands[m_order[i]];
+        if (!isOpaque(command.states))
+            drawCommand(target, command, states, 1.f - static_cast<float>(run) * step);
+    }
+
+    target.setDepthTest(previousTest);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::drawCommand(RenderTarget& target, const Command& command, const RenderStates& states, float depth) const
+{
+    RenderStates commandStates(command.states);
+    commandStates.transform = states.transform * command.states.transform;
+    commandStates.depth = depth;
+
+    if (command.drawable)
+        target.draw(*command.drawable, commandStates);
+    else
+        target.draw(&m_vertices[command.firstVertex], command.vertexCount, command.type, commandStates);
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderQueue::isRunStart(std::size_t position) const
+{
+    if (position == 0)
+        return true;
+
+    // Runs never mix opaque and translucent commands, even if their blend modes share a key
+    const Command& previous = m_commands[m_order[position - 1]];
+    const Command& current = m_commands[m_order[position]];
+    return ((m_keys[m_order[position]] >> blendShift) != (m_keys[m_order[position - 1]] >> blendShift)) ||
+           (isOpaque(current.states) != isOpaque(previous.states));
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 RenderQueue::computeKey(const RenderStates& states, Uint8 layer, float depth)
+{
+    Uint64 shader = getIndex(m_shaders, states.shader, shaderMask);
+    Uint64 texture = getIndex(m_textures, states.texture, textureMask);
+
+    // There are only a few different blend modes, a linear search is enough
+    Uint64 blend = 0;
+    while ((blend < m_blendModes.size()) && !(m_blendModes[static_cast<std::size_t>(blend)] == states.blendMode))
+        ++blend;
+    if (blend == m_blendModes.size())
+        m_blendModes.push_back(states.blendMode);
+    blend = std::min(blend, blendMask);
+
+    Uint64 depthBits = sortableDepth(depth) >> 12;
+
+    return ((static_cast<Uint64>(layer) & layerMask) << layerShift)
+         | ((shader & shaderMask) << shaderShift)
+         | ((texture & textureMask) << textureShift)
+         | ((blend & blendMask) << blendShift)
+         | ((depthBits & depthMask) << depthShift);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderQueue::sort() const
+{
+    if (m_sorted)
+        return;
+
+    std::size_t count = m_commands.size();
+    m_order.resize(count);
+    m_scratch.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
+        m_order[i] = i;
+
+    // Stable LSD radix sort of the command indices, 8 bits per pass;
+    // commands with equal keys keep their submission order
+    for (unsigned int shift = 0; shift < 64; shift += 8)
+    {
+        std::size_t histogram[257] = {0};
+        for (std::size_t i = 0; i < count; ++i)
+            histogram[((m_keys[i] >> shift) & 0xFF) + 1]++;
+
+        // Skip the pass if all the keys have the same byte, which is frequent for unused fields
+        bool trivial = false;
+        for (std::size_t bucket = 1; bucket <= 256; ++bucket)
+        {
+            if (histogram[bucket] == count)
+            {
+                trivial = true;
+                break;
+            }
+        }
+        if (trivial)
+            continue;
+
+        for (std::size_t bucket = 1; bucket <= 256; ++bucket)
+            histogram[bucket] += histogram[bucket - 1];
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::size_t index = m_order[i];
+            m_scratch[histogram[(m_keys[index] >> shift) & 0xFF]++] = index;
+        }
+
+        m_order.swap(m_scratch);
+    }
+
+    m_sorted = true;
+}
+
+} // namespace sf
@@ -41,50 +41,84 @@ const RenderStates RenderStates::Default(BlendMode(
 
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates() :
-blendMode(BlendAlpha),
-transform(),
-texture  (NULL),
-shader   (NULL)
+blendMode  (BlendAlpha),
+transform  (),
+texture    (NULL),
+shader     (NULL),
+depth      (0.f),
+scissor    (),
+stencilMode(),
+samplerMode()
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates(const Transform& theTransform) :
-blendMode(BlendAlpha),
-transform(theTransform),
-texture  (NULL),
-shader   (NULL)
+blendMode  (BlendAlpha),
+transform  (theTransform),
+texture    (NULL),
+shader     (NULL),
+depth      (0.f),
+scissor    (),
+stencilMode(),
+samplerMode()
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates(const BlendMode& theBlendMode) :
-blendMode(theBlendMode),
-transform(),
-texture  (NULL),
-shader   (NULL)
+blendMode  (theBlendMode),
+transform  (),
+texture    (NULL),
+shader     (NULL),
+depth      (0.f),
+scissor    (),
+stencilMode(),
+samplerMode()
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates(const Texture* theTexture) :
-blendMode(BlendAlpha),
-transform(),
-texture  (theTexture),
-shader   (NULL)
+blendMode  (BlendAlpha),
+transform  (),
+texture    (theTexture),
+shader     (NULL),
+depth      (0.f),
+scissor    (),
+stencilMode(),
+samplerMode()
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates(const Shader* theShader) :
-blendMode(BlendAlpha),
-transform(),
-texture  (NULL),
-shader   (theShader)
+blendMode  (BlendAlpha),
+transform  (),
+texture    (NULL),
+shader     (theShader),
+depth      (0.f),
+scissor    (),
+stencilMode(),
+samplerMode()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+RenderStates::RenderStates(const SamplerMode& theSamplerMode) :
+blendMode  (BlendAlpha),
+transform  (),
+texture    (NULL),
+shader     (NULL),
+depth      (0.f),
+scissor    (),
+stencilMode(),
+samplerMode(theSamplerMode)
 {
 }
 
@@ -92,10 +126,14 @@ shader   (theShader)
 ////////////////////////////////////////////////////////////
 RenderStates::RenderStates(const BlendMode& theBlendMode, const Transform& theTransform,
                            const Texture* theTexture, const Shader* theShader) :
-blendMode(theBlendMode),
-transform(theTransform),
-texture  (theTexture),
-shader   (theShader)
+blendMode  (theBlendMode),
+transform  (theTransform),
+texture    (theTexture),
+shader     (theShader),
+depth      (0.f),
+scissor    (),
+stencilMode(),
+samplerMode()
 {
 }
 
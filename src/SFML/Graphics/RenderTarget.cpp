@@ -30,8 +30,18 @@
 #include <SFML/Graphics/Shader.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/CompactVertex.hpp>
+#include <SFML/Graphics/LayeredVertex.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/CoreRenderer.hpp>
+#include <SFML/Graphics/GpuProfiler.hpp>
+#include <SFML/Graphics/SamplerCache.hpp>
+#include <SFML/Graphics/TransformPoints.hpp>
+#include <SFML/Window/Context.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/FrameArena.hpp>
+#include <algorithm>
 #include <iostream>
 
 
@@ -65,34 +75,169 @@ namespace
             case sf::BlendMode::Subtract:        return GLEXT_GL_FUNC_SUBTRACT;
         }
     }
+
+
+    // GL_QUADS is unavailable on OpenGL ES, quads never reach the driver
+    #ifdef SFML_OPENGL_ES
+        #define GL_QUADS 0
+    #endif
+
+
+    // Convert an sf::PrimitiveType constant to the corresponding OpenGL constant.
+    GLenum primitiveTypeToGlConstant(sf::PrimitiveType type)
+    {
+        static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
+                                       GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS};
+        return modes[type];
+    }
+
+
+    // Point the fixed-function vertex arrays to an array of sf::Vertex
+    // (the address is an offset when a vertex buffer is bound)
+    void setVertexPointers(const char* data)
+    {
+        glCheck(glVertexPointer(2, GL_FLOAT, sizeof(sf::Vertex), data + 0));
+        glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(sf::Vertex), data + 8));
+        glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(sf::Vertex), data + 12));
+    }
+
+
+    // Point the fixed-function vertex arrays to vertices of a given format; uncolored
+    // vertices disable the color array, which must be enabled again after the draw
+    void setVertexPointers(const char* data, sf::VertexBuffer::Format format)
+    {
+        switch (format)
+        {
+            case sf::VertexBuffer::Compact:
+                glCheck(glVertexPointer(2, GL_SHORT, sizeof(sf::CompactVertex), data + 0));
+                glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(sf::CompactVertex), data + 4));
+                glCheck(glTexCoordPointer(2, GL_SHORT, sizeof(sf::CompactVertex), data + 8));
+                break;
+
+            case sf::VertexBuffer::Uncolored:
+                glCheck(glVertexPointer(2, GL_SHORT, sizeof(sf::UncoloredVertex), data + 0));
+                glCheck(glDisableClientState(GL_COLOR_ARRAY));
+                glCheck(glColor4ub(255, 255, 255, 255));
+                glCheck(glTexCoordPointer(2, GL_SHORT, sizeof(sf::UncoloredVertex), data + 4));
+                break;
+
+            case sf::VertexBuffer::Layered:
+                glCheck(glVertexPointer(2, GL_FLOAT, sizeof(sf::LayeredVertex), data + 0));
+                glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(sf::LayeredVertex), data + 8));
+                glCheck(glTexCoordPointer(3, GL_FLOAT, sizeof(sf::LayeredVertex), data + 12));
+                break;
+
+            default:
+                setVertexPointers(data);
+                break;
+        }
+    }
+
+
+    // Get the area of the world shown by a view
+    sf::FloatRect getViewBounds(const sf::View& view)
+    {
+        // The visible area is the [-1, 1] clip space cube, brought back to world coordinates
+        return view.getInverseTransform().transformRect(sf::FloatRect(-1.f, -1.f, 2.f, 2.f));
+    }
+
+
+    // Compute the bounding rectangle of an array of vertices
+    sf::FloatRect getVertexBounds(const sf::Vertex* vertices, std::size_t vertexCount)
+    {
+        float left   = vertices[0].position.x;
+        float top    = vertices[0].position.y;
+        float right  = vertices[0].position.x;
+        float bottom = vertices[0].position.y;
+
+        for (std::size_t i = 1; i < vertexCount; ++i)
+        {
+            const sf::Vector2f& position = vertices[i].position;
+
+            left   = std::min(left, position.x);
+            right  = std::max(right, position.x);
+            top    = std::min(top, position.y);
+            bottom = std::max(bottom, position.y);
+        }
+
+        return sf::FloatRect(left, top, right - left, bottom - top);
+    }
 }
 
 
 namespace sf
 {
+////////////////////////////////////////////////////////////
+RenderTarget::GlStatistics::GlStatistics() :
+calls                (0),
+drawCalls            (0),
+textureBinds         (0),
+redundantTextureBinds(0),
+stateQueries         (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTarget::Statistics::Statistics() :
+drawCalls            (0),
+vertices             (0),
+cachedVertices       (0),
+untransformedVertices(0),
+textureChanges       (0),
+shaderChanges        (0),
+blendModeChanges     (0),
+viewChanges          (0),
+glStateResets        (0)
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 RenderTarget::RenderTarget() :
-m_defaultView(),
-m_view       (),
-m_cache      ()
+m_defaultView    (),
+m_view           (),
+m_cache          (),
+m_statistics     (),
+m_frameStatistics(),
+m_coreRenderer   (NULL),
+m_samplerCache   (NULL)
 {
     m_cache.glStatesSet = false;
+    m_cache.batchingEnabled = false;
+    m_cache.batchTextureId = 0;
+    m_cache.cullingEnabled = false;
+    m_cache.recording = false;
+    m_cache.coreProfile = false;
+    m_cache.lastShaderId = 0;
+    m_cache.lastSampler = 0;
+    m_cache.lastDepth = 0.f;
+    m_cache.depthTest = NoDepthTest;
+    m_cache.contextGeneration = Context::getGeneration();
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderTarget::~RenderTarget()
 {
+    delete m_coreRenderer;
+    delete m_samplerCache;
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::clear(const Color& color)
 {
+    SFML_PROFILE_SCOPE("RenderTarget::clear");
+
+    // Pending primitives must be drawn before the target is cleared
+    flush();
+
     if (activate(true))
     {
         // Unbind texture to fix RenderTexture preventing clear
         applyTexture(NULL);
+        disableClipping();
 
         glCheck(glClearColor(color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f));
         glCheck(glClear(GL_COLOR_BUFFER_BIT));
@@ -100,11 +245,53 @@ void RenderTarget::clear(const Color& color)
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderTarget::clearDepth()
+{
+    // Pending primitives must be tested against the previous depths
+    flush();
+
+    if (activate(true))
+    {
+        disableClipping();
+
+        // The depth mask also applies to glClear
+        glCheck(glDepthMask(GL_TRUE));
+        glCheck(glClear(GL_DEPTH_BUFFER_BIT));
+
+        if (m_cache.glStatesSet)
+            applyDepthTest();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::clearStencil(Uint8 value)
+{
+    // Pending primitives must be tested against the previous masks
+    flush();
+
+    if (activate(true))
+    {
+        disableClipping();
+
+        // The stencil mask also applies to glClear
+        glCheck(glStencilMask(0xFF));
+        glCheck(glClearStencil(value));
+        glCheck(glClear(GL_STENCIL_BUFFER_BIT));
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::setView(const View& view)
 {
+    // Pending primitives must be drawn with the previous view
+    flush();
+
     m_view = view;
     m_cache.viewChanged = true;
+    m_cache.viewBounds = getViewBounds(m_view);
 }
 
 
@@ -180,139 +367,731 @@ Vector2i RenderTarget::mapCoordsToPixel(const Vector2f& point, const View& view)
 }
 
 
-////////////////////////////////////////////////////////////
-void RenderTarget::draw(const Drawable& drawable, const RenderStates& states)
-{
-    drawable.draw(*this, states);
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const Drawable& drawable, const RenderStates& states)
+{
+    drawable.draw(*this, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
+                        PrimitiveType type, const RenderStates& states)
+{
+    drawVertices(vertices, vertexCount, type, states, NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawVertices(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+                                const RenderStates& states, const FloatRect* bounds)
+{
+    SFML_PROFILE_SCOPE("RenderTarget::draw");
+
+    // Nothing to draw?
+    if (!vertices || (vertexCount == 0))
+        return;
+
+    // Skip the primitives that are outside the view (a vertex shader could move them back in)
+    if (m_cache.cullingEnabled && !states.shader &&
+        !isVisible(states.transform.transformRect(bounds ? *bounds : getVertexBounds(vertices, vertexCount))))
+        return;
+
+    // Recording targets store the primitives, they will be drawn later by another target
+    if (m_cache.recording)
+    {
+        record(vertices, vertexCount, type, states);
+        return;
+    }
+
+    // Large arrays are cheaper to transform on the GPU than to merge into the batch
+    if (m_cache.batchingEnabled && (vertexCount <= StatesCache::BatchVertexThreshold))
+    {
+        batchPrimitives(vertices, vertexCount, type, states);
+    }
+    else
+    {
+        flush();
+        drawPrimitives(vertices, vertexCount, type, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount, const Uint16* indices,
+                        std::size_t indexCount, PrimitiveType type, const RenderStates& states)
+{
+    drawIndexed(vertices, vertexCount, indices, indexCount, sizeof(Uint16), type, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount, const Uint32* indices,
+                        std::size_t indexCount, PrimitiveType type, const RenderStates& states)
+{
+    drawIndexed(vertices, vertexCount, indices, indexCount, sizeof(Uint32), type, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const LayeredVertex* vertices, std::size_t vertexCount,
+                        PrimitiveType type, const RenderStates& states)
+{
+    drawLayered(vertices, vertexCount, type, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const LayeredVertex* vertices, std::size_t vertexCount, const Uint16* indices,
+                        std::size_t indexCount, PrimitiveType type, const RenderStates& states)
+{
+    // Nothing to draw?
+    if (!indices || !indexCount)
+        return;
+
+    // Quads are only meant for drawing without indices
+    if (type == Quads)
+    {
+        err() << "sf::Quads primitive type can't be drawn with indices, drawing skipped" << std::endl;
+        return;
+    }
+
+    drawLayered(vertices, vertexCount, type, states, indices, indexCount);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setBatchingEnabled(bool enabled)
+{
+    if (!enabled)
+        flush();
+
+    m_cache.batchingEnabled = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isBatchingEnabled() const
+{
+    return m_cache.batchingEnabled;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setCullingEnabled(bool enabled)
+{
+    m_cache.cullingEnabled = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isCullingEnabled() const
+{
+    return m_cache.cullingEnabled;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setDepthTest(DepthTest test)
+{
+    if (test == m_cache.depthTest)
+        return;
+
+    // Pending primitives must be drawn with the previous test
+    flush();
+
+    m_cache.depthTest = test;
+
+    // Without our states, the test is applied with them by the next draw
+    if (m_cache.glStatesSet && activate(true))
+        applyDepthTest();
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTarget::DepthTest RenderTarget::getDepthTest() const
+{
+    return m_cache.depthTest;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isVisible(const FloatRect& rectangle) const
+{
+    // Rectangles that only touch the view are kept, lines and points can be infinitely thin
+    const FloatRect& view = m_cache.viewBounds;
+
+    return (rectangle.left <= view.left + view.width) && (rectangle.left + rectangle.width >= view.left) &&
+           (rectangle.top <= view.top + view.height) && (rectangle.top + rectangle.height >= view.top);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::flush()
+{
+    if (m_cache.batchVertices.empty())
+        return;
+
+    SFML_PROFILE_SCOPE("RenderTarget::flush");
+
+    // Move the pending primitives out of the cache, so that the flushes
+    // triggered by the state changes while drawing them are no-ops
+    std::vector<Vertex> vertices;
+    std::vector<Uint16> indices;
+    vertices.swap(m_cache.batchVertices);
+    indices.swap(m_cache.batchIndices);
+
+    if (!indices.empty())
+        drawPrimitives(&vertices[0], vertices.size(), m_cache.batchType, m_cache.batchStates,
+                       &indices[0], indices.size(), sizeof(Uint16), true);
+
+    // Give the storage back, the next batch will most likely have a similar size
+    vertices.clear();
+    indices.clear();
+    m_cache.batchVertices.swap(vertices);
+    m_cache.batchIndices.swap(indices);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawIndexed(const Vertex* vertices, std::size_t vertexCount, const void* indices,
+                               std::size_t indexCount, std::size_t indexSize, PrimitiveType type,
+                               const RenderStates& states)
+{
+    // Nothing to draw?
+    if (!vertices || !vertexCount || !indices || !indexCount)
+        return;
+
+    // Quads are only meant for drawing without indices
+    if (type == Quads)
+    {
+        err() << "sf::Quads primitive type can't be drawn with indices, drawing skipped" << std::endl;
+        return;
+    }
+
+    // Skip the primitives that are outside the view (a vertex shader could move them back in)
+    if (m_cache.cullingEnabled && !states.shader &&
+        !isVisible(states.transform.transformRect(getVertexBounds(vertices, vertexCount))))
+        return;
+
+    // Recording targets only store plain vertices, the indices are resolved now
+    if (m_cache.recording)
+    {
+        std::vector<Vertex, FrameAllocator<Vertex> > assembled(indexCount);
+        for (std::size_t i = 0; i < indexCount; ++i)
+        {
+            std::size_t index = (indexSize == sizeof(Uint32)) ? static_cast<const Uint32*>(indices)[i]
+                                                              : static_cast<const Uint16*>(indices)[i];
+            assembled[i] = vertices[index];
+        }
+
+        record(&assembled[0], indexCount, type, states);
+        return;
+    }
+
+    // Large arrays are cheaper to transform on the GPU than to merge into the batch
+    if (m_cache.batchingEnabled && (vertexCount <= StatesCache::BatchVertexThreshold))
+    {
+        batchPrimitives(vertices, vertexCount, type, states, indices, indexCount, indexSize);
+    }
+    else
+    {
+        flush();
+        drawPrimitives(vertices, vertexCount, type, states, indices, indexCount, indexSize);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::batchPrimitives(const Vertex* vertices, std::size_t vertexCount,
+                                   PrimitiveType type, const RenderStates& states,
+                                   const void* indices, std::size_t indexCount, std::size_t indexSize)
+{
+    PrimitiveType batchType = priv::getListPrimitiveType(type);
+    Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
+
+    // Flush the pending primitives if they can't be merged with the new ones
+    if (!m_cache.batchVertices.empty() &&
+        ((batchType != m_cache.batchType) ||
+         (textureId != m_cache.batchTextureId) ||
+         (states.shader != m_cache.batchStates.shader) ||
+         (states.blendMode != m_cache.batchStates.blendMode) ||
+         (states.depth != m_cache.batchStates.depth) ||
+         (states.scissor != m_cache.batchStates.scissor) ||
+         (states.stencilMode != m_cache.batchStates.stencilMode) ||
+         (states.samplerMode != m_cache.batchStates.samplerMode) ||
+         (m_cache.batchVertices.size() + vertexCount > 65536)))
+    {
+        flush();
+    }
+
+    if (m_cache.batchVertices.empty())
+    {
+        m_cache.batchType = batchType;
+        m_cache.batchTextureId = textureId;
+        m_cache.batchStates = RenderStates(states.blendMode, Transform::Identity, states.texture, states.shader);
+        m_cache.batchStates.depth = states.depth;
+        m_cache.batchStates.scissor = states.scissor;
+        m_cache.batchStates.stencilMode = states.stencilMode;
+        m_cache.batchStates.samplerMode = states.samplerMode;
+    }
+
+    // Pre-transform the vertices and convert connected primitives to indexed lists, so that they can be concatenated
+    // (the batch is drawn with 16-bit indices, hence the vertex limit above)
+    priv::appendIndexedPrimitives(m_cache.batchVertices, m_cache.batchIndices, states.transform,
+                                  vertices, vertexCount, type, indices, indexCount, indexSize);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawPrimitives(const Vertex* vertices, std::size_t vertexCount,
+                                  PrimitiveType type, const RenderStates& states,
+                                  const void* indices, std::size_t indexCount, std::size_t indexSize,
+                                  bool batched)
+{
+    // GL_QUADS is deprecated or missing, quads are drawn as triangles with the shared quad indices
+    if (type == Quads)
+    {
+        for (std::size_t first = 0; first + 4 <= vertexCount; first += priv::QuadIndicesQuadCount * 4)
+        {
+            std::size_t quadCount = std::min<std::size_t>(priv::QuadIndicesQuadCount, (vertexCount - first) / 4);
+            drawPrimitives(vertices + first, quadCount * 4, Triangles, states,
+                           priv::getQuadIndices(), quadCount * 6, sizeof(Uint16), batched);
+        }
+
+        return;
+    }
+
+    // OpenGL ES only guarantees 16-bit indices
+    #ifdef SFML_OPENGL_ES
+        std::vector<Uint16, FrameAllocator<Uint16> > shortIndices;
+        if (indices && (indexSize == sizeof(Uint32)))
+        {
+            if (vertexCount > 65536)
+            {
+                err() << "32-bit indices are not supported on OpenGL ES platforms, drawing skipped" << std::endl;
+                return;
+            }
+
+            const Uint32* wideIndices = static_cast<const Uint32*>(indices);
+            shortIndices.assign(wideIndices, wideIndices + indexCount);
+            indices = &shortIndices[0];
+            indexSize = sizeof(Uint16);
+        }
+    #endif
+
+    if (activate(true))
+    {
+        SFML_PROFILE_GPU_SCOPE("RenderTarget::drawPrimitives");
+
+        // The states tell which pipeline draws the primitives (they are lost with the contexts)
+        if (!m_cache.glStatesSet || (m_cache.contextGeneration != Context::getGeneration()))
+            resetGLStates();
+
+        // Check if the vertex count is low enough so that we can pre-transform them
+        bool useVertexCache = (vertexCount <= StatesCache::VertexCacheSize);
+        if (useVertexCache)
+        {
+            // Pre-transform the vertices and store them into the vertex cache
+            priv::transformVertices(states.transform, vertices, m_cache.vertexCache, vertexCount);
+        }
+
+        // The vertices of the batch were already transformed when they were appended
+        m_statistics.vertices += vertexCount;
+        if (useVertexCache || batched)
+            m_statistics.cachedVertices += vertexCount;
+        else
+            m_statistics.untransformedVertices += vertexCount;
+
+        setupDraw(useVertexCache, states);
+
+        // If we pre-transform the vertices, we must use our internal vertex cache
+        if (useVertexCache)
+        {
+            // ... and if we already used it previously, we don't need to set the pointers again
+            // (core profiles can't read client memory, the vertices are always streamed)
+            if (!m_cache.useVertexCache || m_cache.coreProfile)
+                vertices = m_cache.vertexCache;
+            else
+                vertices = NULL;
+        }
+
+        // Setup the pointers to the vertices' components
+        // (in core profiles, the vertices are suballocated from a ring buffer)
+        std::size_t firstVertex = 0;
+        if (m_cache.coreProfile)
+        {
+            firstVertex = m_coreRenderer->setVertices(vertices, vertexCount);
+        }
+        else if (vertices)
+        {
+            setVertexPointers(reinterpret_cast<const char*>(vertices));
+        }
+
+        if (indices)
+            drawElements(type, indices, indexCount, indexSize, firstVertex);
+        else
+            drawArrays(type, firstVertex, vertexCount);
+
+        // Update the cache
+        m_cache.useVertexCache = useVertexCache;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawLayered(const LayeredVertex* vertices, std::size_t vertexCount, PrimitiveType type,
+                               const RenderStates& states, const Uint16* indices, std::size_t indexCount)
+{
+    SFML_PROFILE_SCOPE("RenderTarget::draw");
+
+    // Nothing to draw?
+    if (!vertices || (vertexCount == 0))
+        return;
+
+    // Layered vertices are read by shaders, which may move them anywhere: they are never culled
+
+    // Recording targets only store plain vertices, the indices are resolved now
+    if (m_cache.recording)
+    {
+        if (indices)
+        {
+            std::vector<LayeredVertex, FrameAllocator<LayeredVertex> > assembled(indexCount);
+            for (std::size_t i = 0; i < indexCount; ++i)
+                assembled[i] = vertices[indices[i]];
+
+            record(&assembled[0], indexCount, type, states);
+        }
+        else
+        {
+            record(vertices, vertexCount, type, states);
+        }
+
+        return;
+    }
+
+    // GL_QUADS is deprecated or missing, quads are drawn as triangles with the shared quad indices
+    if (type == Quads)
+    {
+        for (std::size_t first = 0; first + 4 <= vertexCount; first += priv::QuadIndicesQuadCount * 4)
+        {
+            std::size_t quadCount = std::min<std::size_t>(priv::QuadIndicesQuadCount, (vertexCount - first) / 4);
+            drawLayered(vertices + first, quadCount * 4, Triangles, states, priv::getQuadIndices(), quadCount * 6);
+        }
+
+        return;
+    }
+
+    // The layered vertices can't be merged with the pending batch
+    flush();
+
+    if (activate(true))
+    {
+        SFML_PROFILE_GPU_SCOPE("RenderTarget::drawLayered");
+
+        setupDraw(false, states);
+
+        m_statistics.vertices += vertexCount;
+        m_statistics.untransformedVertices += vertexCount;
+
+        // Setup the pointers to the vertices' components
+        // (in core profiles, the vertices are suballocated from a ring buffer)
+        std::size_t firstVertex = 0;
+        if (m_cache.coreProfile)
+            firstVertex = m_coreRenderer->setVertices(vertices, vertexCount);
+        else
+            setVertexPointers(reinterpret_cast<const char*>(vertices), VertexBuffer::Layered);
+
+        if (indices)
+            drawElements(type, indices, indexCount, sizeof(Uint16), firstVertex);
+        else
+            drawArrays(type, firstVertex, vertexCount);
+
+        // The vertex pointers now refer to the layered vertices, they must be set again for the vertex cache
+        m_cache.useVertexCache = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer& vertexBuffer, const RenderStates& states)
+{
+    draw(vertexBuffer, 0, vertexBuffer.getVertexCount(), states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex,
+                        std::size_t vertexCount, const RenderStates& states)
+{
+    // Recording targets only keep a reference to the buffer, it doesn't have to be usable yet
+    if (m_cache.recording)
+    {
+        if (firstVertex < vertexBuffer.getVertexCount())
+            record(vertexBuffer, firstVertex, std::min(vertexCount, vertexBuffer.getVertexCount() - firstVertex), states);
+
+        return;
+    }
+
+    // VertexBuffer not supported?
+    if (!VertexBuffer::isAvailable())
+    {
+        err() << "sf::VertexBuffer is not available, drawing skipped" << std::endl;
+        return;
+    }
+
+    // Sanity check
+    if (firstVertex > vertexBuffer.getVertexCount())
+        return;
+
+    // Clamp vertexCount to something that makes sense
+    vertexCount = std::min(vertexCount, vertexBuffer.getVertexCount() - firstVertex);
+
+    // Nothing to draw?
+    if (!vertexCount || !vertexBuffer.getNativeHandle())
+        return;
+
+    // The vertices of the buffer can't be merged with the pending batch
+    flush();
+
+    if (activate(true))
+    {
+        setupDraw(false, states);
+
+        m_statistics.vertices += vertexCount;
+        m_statistics.untransformedVertices += vertexCount;
+
+        // Bind vertex buffer, the attributes are set up for the layout of its vertices
+        VertexBuffer::Format format = vertexBuffer.getFormat();
+        std::size_t vertexSize = vertexBuffer.getVertexSize();
+        if (m_cache.coreProfile)
+            m_coreRenderer->setVertexBuffer(vertexBuffer.getNativeHandle(), format);
+        else
+            VertexBuffer::bind(&vertexBuffer);
+
+        if (vertexBuffer.getPrimitiveType() == Quads)
+        {
+            // GL_QUADS is deprecated or missing, quads are drawn as triangles with the shared quad indices;
+            // each chunk starts at a base vertex, or at an offset of the pointers when base vertices are unavailable
+            for (std::size_t first = 0; first + 4 <= vertexCount; first += priv::QuadIndicesQuadCount * 4)
+            {
+                std::size_t quadCount = std::min<std::size_t>(priv::QuadIndicesQuadCount, (vertexCount - first) / 4);
+
+                if (!m_cache.coreProfile)
+                    setVertexPointers(reinterpret_cast<const char*>((firstVertex + first) * vertexSize), format);
+
+                drawElements(Triangles, priv::getQuadIndices(), quadCount * 6, sizeof(Uint16), firstVertex + first);
+            }
+        }
+        else
+        {
+            // Setup the pointers to the vertices' components, they are offsets into the bound buffer
+            if (!m_cache.coreProfile)
+                setVertexPointers(NULL, format);
+
+            drawArrays(vertexBuffer.getPrimitiveType(), firstVertex, vertexCount);
+        }
+
+        // Unbind vertex buffer
+        if (!m_cache.coreProfile)
+        {
+            VertexBuffer::bind(NULL);
+
+            // The other draws read the color of their vertices
+            if (format == VertexBuffer::Uncolored)
+            {
+                glCheck(glEnableClientState(GL_COLOR_ARRAY));
+            }
+        }
+
+        // The vertex pointers now refer to the buffer, they must be set again for the vertex cache
+        m_cache.useVertexCache = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawInstances(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+                                 const float* instanceData, std::size_t instanceCount, std::size_t stride,
+                                 std::size_t maxInstances, int location, const RenderStates& states)
+{
+    // Nothing to draw?
+    if (!vertices || !vertexCount || !instanceData || !instanceCount)
+        return;
+
+    // The per-instance data is not owned by the caller, so it can't be recorded safely
+    if (m_cache.recording)
+    {
+        err() << "Instanced drawing can't be recorded, drawing skipped" << std::endl;
+        return;
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    // The instances can't be merged with the pending batch
+    flush();
+
+    if (activate(true))
+    {
+        // The states are lost with the contexts
+        if (!m_cache.glStatesSet || (m_cache.contextGeneration != Context::getGeneration()))
+            resetGLStates();
+
+        // The instance data is passed to a compatibility-profile shader through the fixed-function pointers
+        if (m_cache.coreProfile)
+        {
+            err() << "Instanced drawing is not supported in core-profile contexts, drawing skipped" << std::endl;
+            return;
+        }
+
+        setupDraw(false, states);
+
+        m_statistics.vertices += vertexCount * instanceCount;
+        m_statistics.untransformedVertices += vertexCount * instanceCount;
+
+        // Setup the pointers to the vertices' components
+        setVertexPointers(reinterpret_cast<const char*>(vertices));
+
+        // Upload the per-instance data and draw, as many instances at once as the shader can hold
+        for (std::size_t first = 0; first < instanceCount; first += maxInstances)
+        {
+            std::size_t count = std::min(maxInstances, instanceCount - first);
+            GLsizei vectors = static_cast<GLsizei>(count * stride / 4);
+
+            glCheck(GLEXT_glUniform4fv(location, vectors, instanceData + first * stride));
+            drawArrays(type, 0, vertexCount, count);
+        }
+
+        // The vertex pointers now refer to the given vertices, they must be set again for the vertex cache
+        m_cache.useVertexCache = false;
+    }
+
+#else
+
+    // Hardware instancing is not supported on OpenGL ES
+    (void)type;
+    (void)stride;
+    (void)maxInstances;
+    (void)location;
+    (void)states;
+
+#endif
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
-                        PrimitiveType type, const RenderStates& states)
+void RenderTarget::setPointSpritesEnabled(bool enabled)
 {
-    // Nothing to draw?
-    if (!vertices || (vertexCount == 0))
+    // The state would not be part of the recorded commands
+    if (m_cache.recording)
         return;
 
-    // GL_QUADS is unavailable on OpenGL ES
-    #ifdef SFML_OPENGL_ES
-        if (type == Quads)
-        {
-            err() << "sf::Quads primitive type is not supported on OpenGL ES platforms, drawing skipped" << std::endl;
-            return;
-        }
-        #define GL_QUADS 0
-    #endif
+#ifndef SFML_OPENGL_ES
+
+    flush();
 
     if (activate(true))
     {
-        // First set the persistent OpenGL states if it's the very first call
-        if (!m_cache.glStatesSet)
-            resetGLStates();
-
-        // Check if the vertex count is low enough so that we can pre-transform them
-        bool useVertexCache = (vertexCount <= StatesCache::VertexCacheSize);
-        if (useVertexCache)
+        // Point sprites are always enabled in core-profile contexts, only the size has to come from the shader
+        if (enabled)
         {
-            // Pre-transform the vertices and store them into the vertex cache
-            for (std::size_t i = 0; i < vertexCount; ++i)
+            if (!m_cache.coreProfile)
             {
-                Vertex& vertex = m_cache.vertexCache[i];
-                vertex.position = states.transform * vertices[i].position;
-                vertex.color = vertices[i].color;
-                vertex.texCoords = vertices[i].texCoords;
+                glCheck(glEnable(GLEXT_GL_POINT_SPRITE));
             }
-
-            // Since vertices are transformed, we must use an identity transform to render them
-            if (!m_cache.useVertexCache)
-                applyTransform(Transform::Identity);
+            glCheck(glEnable(GLEXT_GL_VERTEX_PROGRAM_POINT_SIZE));
         }
         else
         {
-            applyTransform(states.transform);
+            if (!m_cache.coreProfile)
+            {
+                glCheck(glDisable(GLEXT_GL_POINT_SPRITE));
+            }
+            glCheck(glDisable(GLEXT_GL_VERTEX_PROGRAM_POINT_SIZE));
         }
+    }
 
-        // Apply the view
-        if (m_cache.viewChanged)
-            applyCurrentView();
-
-        // Apply the blend mode
-        if (states.blendMode != m_cache.lastBlendMode)
-            applyBlendMode(states.blendMode);
+#else
 
-        // Apply the texture
-        Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
-        if (textureId != m_cache.lastTextureId)
-            applyTexture(states.texture);
+    // Point sprites are not supported on OpenGL ES
+    (void)enabled;
 
-        // Apply the shader
-        if (states.shader)
-            applyShader(states.shader);
+#endif
+}
 
-        // If we pre-transform the vertices, we must use our internal vertex cache
-        if (useVertexCache)
-        {
-            // ... and if we already used it previously, we don't need to set the pointers again
-            if (!m_cache.useVertexCache)
-                vertices = m_cache.vertexCache;
-            else
-                vertices = NULL;
-        }
 
-        // Setup the pointers to the vertices' components
-        if (vertices)
-        {
-            const char* data = reinterpret_cast<const char*>(vertices);
-            glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
-            glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + 8));
-            glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
-        }
+////////////////////////////////////////////////////////////
+void RenderTarget::record(const Vertex* vertices, std::size_t vertexCount,
+                          PrimitiveType type, const RenderStates& states)
+{
+    // Only recording targets implement this function
+    (void)vertices;
+    (void)vertexCount;
+    (void)type;
+    (void)states;
+}
 
-        // Find the OpenGL primitive type
-        static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
-                                       GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS};
-        GLenum mode = modes[type];
 
-        // Draw the primitives
-        glCheck(glDrawArrays(mode, 0, vertexCount));
+////////////////////////////////////////////////////////////
+void RenderTarget::record(const VertexBuffer& vertexBuffer, std::size_t firstVertex,
+                          std::size_t vertexCount, const RenderStates& states)
+{
+    // Only recording targets implement this function
+    (void)vertexBuffer;
+    (void)firstVertex;
+    (void)vertexCount;
+    (void)states;
+}
 
-        // Unbind the shader, if any
-        if (states.shader)
-            applyShader(NULL);
 
-        // Update the cache
-        m_cache.useVertexCache = useVertexCache;
-    }
+////////////////////////////////////////////////////////////
+void RenderTarget::record(const LayeredVertex* vertices, std::size_t vertexCount,
+                          PrimitiveType type, const RenderStates& states)
+{
+    // Only recording targets implement this function
+    (void)vertices;
+    (void)vertexCount;
+    (void)type;
+    (void)states;
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::pushGLStates()
 {
+    flush();
+
     if (activate(true))
     {
         #ifdef SFML_DEBUG
             // make sure that the user didn't leave an unchecked OpenGL error
-            GLenum error = glGetError();
-            if (error != GL_NO_ERROR)
+            // (the driver already reported it if it uses the debug output)
+            if (!priv::isGlDebugOutputActive())
             {
-                err() << "OpenGL error (" << error << ") detected in user code, "
-                      << "you should check for errors with glGetError()"
-                      << std::endl;
+                GLenum error = glGetError();
+                if (error != GL_NO_ERROR)
+                {
+                    err() << "OpenGL error (" << error << ") detected in user code, "
+                          << "you should check for errors with glGetError()"
+                          << std::endl;
+                }
             }
         #endif
 
-        #ifndef SFML_OPENGL_ES
-            glCheck(glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS));
-            glCheck(glPushAttrib(GL_ALL_ATTRIB_BITS));
-        #endif
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glPushMatrix());
-        glCheck(glMatrixMode(GL_PROJECTION));
-        glCheck(glPushMatrix());
-        glCheck(glMatrixMode(GL_TEXTURE));
-        glCheck(glPushMatrix());
+        // Core profiles have no state stacks, the states are only reset
+        if (!priv::isCoreProfile())
+        {
+            #ifndef SFML_OPENGL_ES
+                glCheck(glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS));
+                glCheck(glPushAttrib(GL_ALL_ATTRIB_BITS));
+            #endif
+            glCheck(glMatrixMode(GL_MODELVIEW));
+            glCheck(glPushMatrix());
+            glCheck(glMatrixMode(GL_PROJECTION));
+            glCheck(glPushMatrix());
+            glCheck(glMatrixMode(GL_TEXTURE));
+            glCheck(glPushMatrix());
+        }
     }
 
     resetGLStates();
@@ -322,18 +1101,42 @@ void RenderTarget::pushGLStates()
 ////////////////////////////////////////////////////////////
 void RenderTarget::popGLStates()
 {
+    flush();
+
     if (activate(true))
     {
-        glCheck(glMatrixMode(GL_PROJECTION));
-        glCheck(glPopMatrix());
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glPopMatrix());
-        glCheck(glMatrixMode(GL_TEXTURE));
-        glCheck(glPopMatrix());
-        #ifndef SFML_OPENGL_ES
-            glCheck(glPopClientAttrib());
-            glCheck(glPopAttrib());
-        #endif
+        if (m_cache.coreProfile)
+        {
+            // Give the default bindings back to the user's code, they are set again by the next draw
+            m_coreRenderer->unbind();
+            m_cache.glStatesSet = false;
+        }
+        else
+        {
+            glCheck(glMatrixMode(GL_PROJECTION));
+            glCheck(glPopMatrix());
+            glCheck(glMatrixMode(GL_MODELVIEW));
+            glCheck(glPopMatrix());
+            glCheck(glMatrixMode(GL_TEXTURE));
+            glCheck(glPopMatrix());
+            #ifndef SFML_OPENGL_ES
+                glCheck(glPopClientAttrib());
+                glCheck(glPopAttrib());
+            #endif
+        }
+
+        // Sampler bindings are not part of the attribute stack, SFML's one must not stay bound
+        if (m_cache.lastSampler)
+        {
+            #ifndef SFML_OPENGL_ES
+                glCheck(GLEXT_glBindSampler(0, 0));
+            #endif
+            m_cache.lastSampler = 0;
+        }
+
+        // The restored bindings are unknown
+        priv::invalidateGLStateCache();
+        m_cache.lastShaderId = 0;
     }
 }
 
@@ -341,41 +1144,95 @@ void RenderTarget::popGLStates()
 ////////////////////////////////////////////////////////////
 void RenderTarget::resetGLStates()
 {
+    // Pending primitives were recorded with the previous states
+    flush();
+
     // Check here to make sure a context change does not happen after activate(true)
     bool shaderAvailable = Shader::isAvailable();
+    bool vertexBufferAvailable = VertexBuffer::isAvailable();
 
     if (activate(true))
     {
+        ++m_statistics.glStateResets;
+
         // Make sure that extensions are initialized
         priv::ensureExtensionsInit();
 
-        // Make sure that the texture unit which is active is the number 0
-        if (GLEXT_multitexture)
+        // User code may have changed the bindings
+        priv::invalidateGLStateCache();
+
+        // The objects of the renderers were lost with the previous contexts; they are abandoned,
+        // deleting their names could destroy the new objects which already reuse them
+        Uint32 generation = Context::getGeneration();
+        if (m_cache.contextGeneration != generation)
         {
-            glCheck(GLEXT_glClientActiveTexture(GLEXT_GL_TEXTURE0));
-            glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0));
+            m_coreRenderer = NULL;
+            m_samplerCache = NULL;
+            m_cache.contextGeneration = generation;
         }
 
-        // Define the default OpenGL states
-        glCheck(glDisable(GL_CULL_FACE));
-        glCheck(glDisable(GL_LIGHTING));
-        glCheck(glDisable(GL_DEPTH_TEST));
-        glCheck(glDisable(GL_ALPHA_TEST));
-        glCheck(glEnable(GL_TEXTURE_2D));
-        glCheck(glEnable(GL_BLEND));
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glEnableClientState(GL_VERTEX_ARRAY));
-        glCheck(glEnableClientState(GL_COLOR_ARRAY));
-        glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+        // Core profiles have no fixed-function pipeline, built-in shaders replace it
+        m_cache.coreProfile = priv::isCoreProfile();
+
+        if (m_cache.coreProfile)
+        {
+            if (!m_coreRenderer)
+                m_coreRenderer = new priv::CoreRenderer;
+
+            m_coreRenderer->initialize();
+            m_coreRenderer->bind();
+            m_coreRenderer->invalidateProgram();
+
+            // Define the default OpenGL states
+            glCheck(glDisable(GL_CULL_FACE));
+            glCheck(glDisable(GL_DEPTH_TEST));
+            glCheck(glEnable(GL_BLEND));
+        }
+        else
+        {
+            // Make sure that the texture unit which is active is the number 0
+            if (GLEXT_multitexture)
+            {
+                glCheck(GLEXT_glClientActiveTexture(GLEXT_GL_TEXTURE0));
+                priv::setActiveTextureUnit(0);
+            }
+
+            // Define the default OpenGL states
+            glCheck(glDisable(GL_CULL_FACE));
+            glCheck(glDisable(GL_LIGHTING));
+            glCheck(glDisable(GL_DEPTH_TEST));
+            glCheck(glDisable(GL_ALPHA_TEST));
+            glCheck(glEnable(GL_TEXTURE_2D));
+            glCheck(glEnable(GL_BLEND));
+            glCheck(glMatrixMode(GL_MODELVIEW));
+            glCheck(glEnableClientState(GL_VERTEX_ARRAY));
+            glCheck(glEnableClientState(GL_COLOR_ARRAY));
+            glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+        }
         m_cache.glStatesSet = true;
 
         // Apply the default SFML states
         applyBlendMode(BlendAlpha);
-        applyTransform(Transform::Identity);
+        applyTransform(Transform::Identity, 0.f);
+        applyDepthTest();
+        applyScissor(IntRect());
+        applyStencilMode(StencilMode());
         applyTexture(NULL);
+        m_cache.lastSampler = 0;
+        #ifndef SFML_OPENGL_ES
+            if (GLEXT_sampler_objects)
+            {
+                glCheck(GLEXT_glBindSampler(0, 0));
+            }
+        #endif
+        m_cache.lastShaderId = 0;
         if (shaderAvailable)
             applyShader(NULL);
 
+        // Make sure that vertex pointers refer to client memory
+        if (vertexBufferAvailable)
+            VertexBuffer::bind(NULL);
+
         m_cache.useVertexCache = false;
 
         // Set the default view
@@ -384,15 +1241,73 @@ void RenderTarget::resetGLStates()
 }
 
 
+////////////////////////////////////////////////////////////
+RenderTarget::GlStatistics RenderTarget::getGlStatistics()
+{
+    const priv::GlCounters& counters = priv::getGlCounters();
+
+    GlStatistics statistics;
+    statistics.calls                 = counters.calls;
+    statistics.drawCalls             = counters.drawCalls;
+    statistics.textureBinds          = counters.textureBinds;
+    statistics.redundantTextureBinds = counters.redundantTextureBinds;
+    statistics.stateQueries          = counters.stateQueries;
+
+    return statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::resetGlStatistics()
+{
+    priv::GlCounters& counters = priv::getGlCounters();
+
+    counters.calls                 = 0;
+    counters.drawCalls             = 0;
+    counters.textureBinds          = 0;
+    counters.redundantTextureBinds = 0;
+    counters.stateQueries          = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+const RenderTarget::Statistics& RenderTarget::getStatistics() const
+{
+    return m_frameStatistics;
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::initialize()
 {
     // Setup the default and current views
     m_defaultView.reset(FloatRect(0, 0, static_cast<float>(getSize().x), static_cast<float>(getSize().y)));
     m_view = m_defaultView;
+    m_cache.viewBounds = getViewBounds(m_view);
 
     // Set GL states only on first draw, so that we don't pollute user's states
     m_cache.glStatesSet = false;
+
+    // The vertex array object of the core-profile renderer belonged to the previous context
+    delete m_coreRenderer;
+    m_coreRenderer = NULL;
+    m_cache.coreProfile = false;
+    m_cache.lastShaderId = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::invalidateGLStates()
+{
+    m_cache.glStatesSet = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::endFrameStatistics()
+{
+    m_frameStatistics = m_statistics;
+    m_statistics = Statistics();
 }
 
 
@@ -405,13 +1320,21 @@ void RenderTarget::applyCurrentView()
     glCheck(glViewport(viewport.left, top, viewport.width, viewport.height));
 
     // Set the projection matrix
-    glCheck(glMatrixMode(GL_PROJECTION));
-    glCheck(glLoadMatrixf(m_view.getTransform().getMatrix()));
+    if (m_cache.coreProfile)
+    {
+        m_coreRenderer->setProjection(m_view.getTransform().getMatrix());
+    }
+    else
+    {
+        glCheck(glMatrixMode(GL_PROJECTION));
+        glCheck(glLoadMatrixf(m_view.getTransform().getMatrix()));
 
-    // Go back to model-view mode
-    glCheck(glMatrixMode(GL_MODELVIEW));
+        // Go back to model-view mode
+        glCheck(glMatrixMode(GL_MODELVIEW));
+    }
 
     m_cache.viewChanged = false;
+    ++m_statistics.viewChanges;
 }
 
 
@@ -460,15 +1383,135 @@ void RenderTarget::applyBlendMode(const BlendMode& mode)
     }
 
     m_cache.lastBlendMode = mode;
+    ++m_statistics.blendModeChanges;
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::applyTransform(const Transform& transform)
+void RenderTarget::applyTransform(const Transform& transform, float depth)
 {
+    // The view doesn't scale Z, so the depth goes through to the depth test unchanged
+    const float* matrix = transform.getMatrix();
+    float withDepth[16];
+    if (depth != 0.f)
+    {
+        std::copy(matrix, matrix + 16, withDepth);
+        withDepth[14] = depth;
+        matrix = withDepth;
+    }
+
+    m_cache.lastDepth = depth;
+
+    if (m_cache.coreProfile)
+    {
+        m_coreRenderer->setModelView(matrix);
+        return;
+    }
+
     // No need to call glMatrixMode(GL_MODELVIEW), it is always the
     // current mode (for optimization purpose, since it's the most used)
-    glCheck(glLoadMatrixf(transform.getMatrix()));
+    glCheck(glLoadMatrixf(matrix));
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::applyDepthTest()
+{
+    if (m_cache.depthTest == NoDepthTest)
+    {
+        glCheck(glDisable(GL_DEPTH_TEST));
+    }
+    else
+    {
+        glCheck(glEnable(GL_DEPTH_TEST));
+        glCheck(glDepthFunc(GL_LESS));
+        glCheck(glDepthMask((m_cache.depthTest == DepthTestWrite) ? GL_TRUE : GL_FALSE));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::applyScissor(const IntRect& rect)
+{
+    if ((rect.width > 0) && (rect.height > 0))
+    {
+        glCheck(glEnable(GL_SCISSOR_TEST));
+        glCheck(glScissor(rect.left, rect.top, rect.width, rect.height));
+    }
+    else
+    {
+        glCheck(glDisable(GL_SCISSOR_TEST));
+    }
+
+    m_cache.lastScissor = rect;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::applyStencilMode(const StencilMode& mode)
+{
+    if (mode.function == StencilMode::Disabled)
+    {
+        glCheck(glDisable(GL_STENCIL_TEST));
+    }
+    else if (mode.function == StencilMode::Write)
+    {
+        glCheck(glEnable(GL_STENCIL_TEST));
+        glCheck(glStencilFunc(GL_ALWAYS, mode.value, 0xFF));
+        glCheck(glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE));
+    }
+    else
+    {
+        glCheck(glEnable(GL_STENCIL_TEST));
+        glCheck(glStencilFunc((mode.function == StencilMode::Equal) ? GL_EQUAL : GL_NOTEQUAL, mode.value, 0xFF));
+        glCheck(glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP));
+    }
+
+    // Masks are only written to the stencil buffer
+    GLboolean writeColor = (mode.function == StencilMode::Write) ? GL_FALSE : GL_TRUE;
+    glCheck(glColorMask(writeColor, writeColor, writeColor, writeColor));
+
+    m_cache.lastStencilMode = mode;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::applySamplerMode(const Texture* texture, const SamplerMode& mode)
+{
+    // Without texture, or with the texture's own parameters, no sampler is bound
+    GLuint sampler = 0;
+    if (texture && (mode != SamplerMode()) && GLEXT_sampler_objects)
+    {
+        if (!m_samplerCache)
+            m_samplerCache = new priv::SamplerCache;
+
+        bool smooth   = (mode.filter == SamplerMode::TextureFilter) ? texture->m_isSmooth : (mode.filter == SamplerMode::Linear);
+        bool repeated = (mode.wrap == SamplerMode::TextureWrap) ? texture->m_isRepeated : (mode.wrap == SamplerMode::Repeat);
+        sampler = m_samplerCache->getSampler(smooth, repeated, texture->m_hasMipmap);
+    }
+
+    if (sampler != m_cache.lastSampler)
+    {
+        #ifndef SFML_OPENGL_ES
+            glCheck(GLEXT_glBindSampler(0, sampler));
+        #endif
+        m_cache.lastSampler = sampler;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::disableClipping()
+{
+    // The whole target is cleared, whatever the scissor and stencil mode of the last draw
+    if (!m_cache.glStatesSet)
+        return;
+
+    if (m_cache.lastScissor != IntRect())
+        applyScissor(IntRect());
+
+    if (m_cache.lastStencilMode != StencilMode())
+        applyStencilMode(StencilMode());
 }
 
 
@@ -477,16 +1520,164 @@ void RenderTarget::applyTexture(const Texture* texture)
 {
     Texture::bind(texture, Texture::Pixels);
 
+    // Core profiles have no texture matrix, the built-in shaders receive it as a uniform
+    if (m_cache.coreProfile)
+    {
+        if (texture && texture->m_texture)
+        {
+            float matrix[16];
+            texture->getTextureMatrix(Texture::Pixels, matrix);
+            m_coreRenderer->setTexture(matrix);
+        }
+        else
+        {
+            m_coreRenderer->setTexture(NULL);
+        }
+    }
+
     m_cache.lastTextureId = texture ? texture->m_cacheId : 0;
+    ++m_statistics.textureChanges;
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyShader(const Shader* shader)
 {
+    // The shader left bound by the previous draw only needs its new values and textures
+    if (shader && m_cache.lastShaderId && (shader->m_cacheId == m_cache.lastShaderId))
+    {
+        shader->applyUniforms();
+        shader->bindTextures();
+        return;
+    }
+
     Shader::bind(shader);
+
+    // A shader whose program is not ready yet binds no program
+    m_cache.lastShaderId = (shader && shader->m_shaderProgram) ? shader->m_cacheId : 0;
+
+    if (shader)
+        ++m_statistics.shaderChanges;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::setupDraw(bool useVertexCache, const RenderStates& states)
+{
+    // First set the persistent OpenGL states if it's the very first call, or if they were lost with the contexts
+    if (!m_cache.glStatesSet || (m_cache.contextGeneration != Context::getGeneration()))
+        resetGLStates();
+
+    if (useVertexCache)
+    {
+        // Since vertices are transformed, we must use an identity transform to render them
+        if (!m_cache.useVertexCache || (states.depth != m_cache.lastDepth))
+            applyTransform(Transform::Identity, states.depth);
+    }
+    else
+    {
+        applyTransform(states.transform, states.depth);
+    }
+
+    // Apply the view
+    if (m_cache.viewChanged)
+        applyCurrentView();
+
+    // Apply the blend mode
+    if (states.blendMode != m_cache.lastBlendMode)
+        applyBlendMode(states.blendMode);
+
+    // Apply the scissor rectangle, converted to OpenGL coordinates so that a resized target updates it
+    IntRect scissor;
+    if ((states.scissor.width > 0) && (states.scissor.height > 0))
+    {
+        int top = getSize().y - (states.scissor.top + states.scissor.height);
+        scissor = IntRect(states.scissor.left, top, states.scissor.width, states.scissor.height);
+    }
+    if (scissor != m_cache.lastScissor)
+        applyScissor(scissor);
+
+    // Apply the stencil mode
+    if (states.stencilMode != m_cache.lastStencilMode)
+        applyStencilMode(states.stencilMode);
+
+    // Apply the texture, and tell the texture manager (if any) that it's still needed
+    Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
+    if (textureId != m_cache.lastTextureId)
+        applyTexture(states.texture);
+    if (states.texture)
+        ++states.texture->m_useCount;
+
+    // Apply the sampler mode, which depends on the parameters of the texture when it doesn't override all of them
+    if ((states.samplerMode != SamplerMode()) || m_cache.lastSampler)
+        applySamplerMode(states.texture, states.samplerMode);
+
+    // Apply the shader; it stays bound after the draw, so that the next draws with the same one don't rebind it
+    if (states.shader)
+    {
+        applyShader(states.shader);
+
+        // The built-in program must be activated again by the next draw without shader
+        if (m_cache.coreProfile)
+            m_coreRenderer->invalidateProgram();
+    }
+    else if (m_cache.coreProfile)
+    {
+        m_cache.lastShaderId = 0;
+        m_coreRenderer->applyProgram();
+    }
+    else if (m_cache.lastShaderId)
+    {
+        applyShader(NULL);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawArrays(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount, std::size_t instanceCount)
+{
+    // Find the OpenGL primitive type
+    GLenum mode = primitiveTypeToGlConstant(type);
+
+    // Draw the primitives
+    priv::countDrawCall();
+    ++m_statistics.drawCalls;
+#ifndef SFML_OPENGL_ES
+    if (instanceCount != 1)
+    {
+        glCheck(GLEXT_glDrawArraysInstanced(mode, static_cast<GLint>(firstVertex), static_cast<GLsizei>(vertexCount), static_cast<GLsizei>(instanceCount)));
+        return;
+    }
+#else
+    (void)instanceCount;
+#endif
+
+    glCheck(glDrawArrays(mode, static_cast<GLint>(firstVertex), static_cast<GLsizei>(vertexCount)));
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawElements(PrimitiveType type, const void* indices, std::size_t indexCount,
+                                std::size_t indexSize, std::size_t baseVertex)
+{
+    // Find the OpenGL primitive type
+    GLenum mode = primitiveTypeToGlConstant(type);
+
+    // Draw the primitives
+    priv::countDrawCall();
+    ++m_statistics.drawCalls;
+    if (m_cache.coreProfile)
+    {
+        m_coreRenderer->drawElements(mode, indices, indexCount, indexSize, baseVertex);
+        return;
+    }
+
+    // The other pipelines read the indices from client memory, the pointers already include the base vertex
+    GLenum indexType = (indexSize == sizeof(Uint32)) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+    glCheck(glDrawElements(mode, static_cast<GLsizei>(indexCount), indexType, indices));
 }
 
+
 } // namespace sf
 
 
@@ -511,6 +1702,12 @@ void RenderTarget::applyShader(const Shader* shader)
 //   whether any of the 6 blending components changed and,
 //   thus, whether we need to update the blend mode.
 //
+// * Scissor and stencil mode
+//   Like the blend mode, they are compared with the last
+//   applied ones. The scissor rectangle is cached in OpenGL
+//   coordinates, which depend on the size of the target, so
+//   that a resized window applies it again.
+//
 // * Texture
 //   Storing the pointer or OpenGL ID of the last used texture
 //   is not enough; if the sf::Texture instance is destroyed,
@@ -521,8 +1718,21 @@ void RenderTarget::applyShader(const Shader* shader)
 // * Shader
 //   Shaders are very hard to optimize, because they have
 //   parameters that can be hard (if not impossible) to track,
-//   like matrices or textures. The only optimization that we
-//   do is that we avoid setting a null shader if there was
-//   already none for the previous draw.
+//   like matrices or textures. The shader of a draw is left
+//   bound afterwards: consecutive draws with the same shader
+//   only upload the values changed since the previous one,
+//   and bind the textures that are not bound yet. Shaders are
+//   identified like textures, so that a destroyed shader is
+//   never mistaken for a new one. The shader is unbound by
+//   the next draw that doesn't use it.
+//
+// * Batching
+//   When enabled, consecutive draws that share the same
+//   texture, shader, blend mode and clipping are pre-transformed like
+//   the vertex cache does, converted to indexed list primitives
+//   and appended to a single vertex stream. Quads keep their 4
+//   vertices and get 6 indices. The stream is drawn with an
+//   identity transform as soon as anything that it depends on
+//   changes.
 //
 ////////////////////////////////////////////////////////////
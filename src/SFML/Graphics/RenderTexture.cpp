@@ -28,6 +28,7 @@
 #include <SFML/Graphics/RenderTexture.hpp>
 #include <SFML/Graphics/RenderTextureImplFBO.hpp>
 #include <SFML/Graphics/RenderTextureImplDefault.hpp>
+#include <SFML/Graphics/GpuProfiler.hpp>
 #include <SFML/System/Err.hpp>
 
 
@@ -37,7 +38,7 @@ namespace sf
 RenderTexture::RenderTexture() :
 m_impl(NULL)
 {
-
+    m_texture.setAccountingCategory(ResourceMemory::RenderTextures);
 }
 
 
@@ -45,19 +46,72 @@ m_impl(NULL)
 RenderTexture::~RenderTexture()
 {
     delete m_impl;
+
+    for (std::size_t i = 0; i < m_colorTargets.size(); ++i)
+        delete m_colorTargets[i];
 }
 
 
 ////////////////////////////////////////////////////////////
 bool RenderTexture::create(unsigned int width, unsigned int height, bool depthBuffer)
 {
+    return create(width, height, ContextSettings(depthBuffer ? 32 : 0));
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTexture::create(unsigned int width, unsigned int height, const ContextSettings& settings, unsigned int colorTargetCount)
+{
+    return create(width, height, settings, PixelFormat::RGBA8, colorTargetCount, NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTexture::create(unsigned int width, unsigned int height, const ContextSettings& settings, PixelFormat::Type format,
+                           unsigned int colorTargetCount)
+{
+    return create(width, height, settings, format, colorTargetCount, NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTexture::create(unsigned int width, unsigned int height, const ContextSettings& settings, PixelFormat::Type format,
+                           unsigned int colorTargetCount, priv::FrameBufferContext* sharedContext)
+{
+    if (colorTargetCount == 0)
+    {
+        err() << "Impossible to create render texture (at least one color target is required)" << std::endl;
+        return false;
+    }
+
     // Create the texture
-    if (!m_texture.create(width, height))
+    if (!m_texture.create(width, height, format))
     {
         err() << "Impossible to create render texture (failed to create the target texture)" << std::endl;
         return false;
     }
 
+    // Create the additional color targets
+    for (std::size_t i = 0; i < m_colorTargets.size(); ++i)
+        delete m_colorTargets[i];
+    m_colorTargets.clear();
+
+    std::vector<unsigned int> textureIds(1, m_texture.m_texture);
+    for (unsigned int i = 1; i < colorTargetCount; ++i)
+    {
+        Texture* texture = new Texture;
+        texture->setAccountingCategory(ResourceMemory::RenderTextures);
+        m_colorTargets.push_back(texture);
+
+        if (!texture->create(width, height, format))
+        {
+            err() << "Impossible to create render texture (failed to create the target texture)" << std::endl;
+            return false;
+        }
+
+        textureIds.push_back(texture->m_texture);
+    }
+
     // We disable smoothing by default for render textures
     setSmooth(false);
 
@@ -66,16 +120,17 @@ bool RenderTexture::create(unsigned int width, unsigned int height, bool depthBu
     if (priv::RenderTextureImplFBO::isAvailable())
     {
         // Use frame-buffer object (FBO)
-        m_impl = new priv::RenderTextureImplFBO;
+        m_impl = new priv::RenderTextureImplFBO(sharedContext);
     }
     else
     {
-        // Use default implementation
-        m_impl = new priv::RenderTextureImplDefault;
+        // Use default implementation; its context can be bound to the texture if they have the same size and format
+        bool bindTexture = (format == PixelFormat::RGBA8) && (m_texture.m_actualSize == m_texture.getSize());
+        m_impl = new priv::RenderTextureImplDefault(bindTexture);
     }
 
     // Initialize the render texture
-    if (!m_impl->create(width, height, m_texture.m_texture, depthBuffer))
+    if (!m_impl->create(width, height, &textureIds[0], colorTargetCount, settings))
         return false;
 
     // We can now initialize the render target part
@@ -85,10 +140,34 @@ bool RenderTexture::create(unsigned int width, unsigned int height, bool depthBu
 }
 
 
+////////////////////////////////////////////////////////////
+unsigned int RenderTexture::getMaximumAntialiasingLevel()
+{
+    if (priv::RenderTextureImplFBO::isAvailable())
+        return priv::RenderTextureImplFBO::getMaximumAntialiasingLevel();
+
+    // The default implementation draws in a context, whose multisampling can't be queried up front
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int RenderTexture::getMaximumColorTargetCount()
+{
+    if (priv::RenderTextureImplFBO::isAvailable())
+        return priv::RenderTextureImplFBO::getMaximumColorTargetCount();
+
+    return 1;
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTexture::setSmooth(bool smooth)
 {
     m_texture.setSmooth(smooth);
+
+    for (std::size_t i = 0; i < m_colorTargets.size(); ++i)
+        m_colorTargets[i]->setSmooth(smooth);
 }
 
 
@@ -103,6 +182,9 @@ bool RenderTexture::isSmooth() const
 void RenderTexture::setRepeated(bool repeated)
 {
     m_texture.setRepeated(repeated);
+
+    for (std::size_t i = 0; i < m_colorTargets.size(); ++i)
+        m_colorTargets[i]->setRepeated(repeated);
 }
 
 
@@ -123,11 +205,26 @@ bool RenderTexture::setActive(bool active)
 ////////////////////////////////////////////////////////////
 void RenderTexture::display()
 {
+    SFML_PROFILE_SCOPE("RenderTexture::display");
+
+    // Draw the pending batch before the texture is updated
+    flush();
+    endFrameStatistics();
+
     // Update the target texture
     if (setActive(true))
     {
+        SFML_PROFILE_GPU_COLLECT();
+
         m_impl->updateTexture(m_texture.m_texture);
         m_texture.m_pixelsFlipped = true;
+        m_texture.invalidateMipmap();
+
+        for (std::size_t i = 0; i < m_colorTargets.size(); ++i)
+        {
+            m_colorTargets[i]->m_pixelsFlipped = true;
+            m_colorTargets[i]->invalidateMipmap();
+        }
     }
 }
 
@@ -146,10 +243,34 @@ const Texture& RenderTexture::getTexture() const
 }
 
 
+////////////////////////////////////////////////////////////
+const Texture& RenderTexture::getTexture(unsigned int index) const
+{
+    if ((index == 0) || (index > m_colorTargets.size()))
+        return m_texture;
+
+    return *m_colorTargets[index - 1];
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int RenderTexture::getColorTargetCount() const
+{
+    return static_cast<unsigned int>(m_colorTargets.size()) + 1;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool RenderTexture::activate(bool active)
 {
-    return setActive(active);
+    if (!setActive(active))
+        return false;
+
+    // Another render texture drew in the shared context since our last draw
+    if (active && m_impl->takeStatesChange())
+        invalidateGLStates();
+
+    return true;
 }
 
 } // namespace sf
@@ -38,6 +38,14 @@ RenderTextureImpl::~RenderTextureImpl()
     // Nothing to do
 }
 
+
+////////////////////////////////////////////////////////////
+bool RenderTextureImpl::takeStatesChange()
+{
+    // By default each render texture has its own context
+    return false;
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -29,6 +29,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/System/NonCopyable.hpp>
+#include <SFML/Window/ContextSettings.hpp>
 
 
 namespace sf
@@ -52,15 +53,17 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Create the render texture implementation
     ///
-    /// \param width       Width of the texture to render to
-    /// \param height      Height of the texture to render to
-    /// \param textureId   OpenGL identifier of the target texture
-    /// \param depthBuffer Is a depth buffer requested?
+    /// \param width        Width of the textures to render to
+    /// \param height       Height of the textures to render to
+    /// \param textureIds   OpenGL identifiers of the target textures
+    /// \param textureCount Number of target textures
+    /// \param settings     Depth, stencil and antialiasing requested for the render texture
     ///
     /// \return True if creation has been successful
     ///
     ////////////////////////////////////////////////////////////
-    virtual bool create(unsigned int width, unsigned int height, unsigned int textureId, bool depthBuffer) = 0;
+    virtual bool create(unsigned int width, unsigned int height, const unsigned int* textureIds, unsigned int textureCount,
+                        const ContextSettings& settings) = 0;
 
     ////////////////////////////////////////////////////////////
     /// \brief Activate or deactivate the render texture for rendering
@@ -79,6 +82,18 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     virtual void updateTexture(unsigned int textureId) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether another render texture drew in the
+    ///        context since the last call
+    ///
+    /// Render textures that share their context must set all
+    /// their OpenGL states again when this happens.
+    ///
+    /// \return True if the OpenGL states were changed by another render texture
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool takeStatesChange();
 };
 
 } // namespace priv
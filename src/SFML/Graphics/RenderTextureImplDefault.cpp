@@ -37,10 +37,11 @@ namespace sf
 namespace priv
 {
 ////////////////////////////////////////////////////////////
-RenderTextureImplDefault::RenderTextureImplDefault() :
-m_context(0),
-m_width  (0),
-m_height (0)
+RenderTextureImplDefault::RenderTextureImplDefault(bool bindTexture) :
+m_context    (0),
+m_width      (0),
+m_height     (0),
+m_bindTexture(bindTexture)
 {
 
 }
@@ -55,14 +56,22 @@ RenderTextureImplDefault::~RenderTextureImplDefault()
 
 
 ////////////////////////////////////////////////////////////
-bool RenderTextureImplDefault::create(unsigned int width, unsigned int height, unsigned int, bool depthBuffer)
+bool RenderTextureImplDefault::create(unsigned int width, unsigned int height, const unsigned int*, unsigned int textureCount,
+                                      const ContextSettings& settings)
 {
+    // The pixels are copied from the context's single color buffer
+    if (textureCount != 1)
+    {
+        err() << "Impossible to create render texture (multiple color targets require frame buffer objects)" << std::endl;
+        return false;
+    }
+
     // Store the dimensions
     m_width = width;
     m_height = height;
 
-    // Create the in-memory OpenGL context
-    m_context = new Context(ContextSettings(depthBuffer ? 32 : 0), width, height);
+    // Create the in-memory OpenGL context, its multisampled pixels are resolved by the copy
+    m_context = new Context(settings, width, height);
 
     return true;
 }
@@ -71,6 +80,10 @@ bool RenderTextureImplDefault::create(unsigned int width, unsigned int height, u
 ////////////////////////////////////////////////////////////
 bool RenderTextureImplDefault::activate(bool active)
 {
+    // The back buffer can't be drawn to while it is the image of the texture
+    if (active)
+        m_context->releaseTexImage();
+
     return m_context->setActive(active);
 }
 
@@ -81,8 +94,19 @@ void RenderTextureImplDefault::updateTexture(unsigned int textureId)
     // Make sure that the current texture binding will be preserved
     priv::TextureSaver save;
 
+    priv::bindTexture(GL_TEXTURE_2D, textureId);
+
+    // Use the back buffer as the image of the texture, without any copy, when the context allows it
+    if (m_bindTexture)
+    {
+        if (m_context->bindTexImage())
+            return;
+
+        // Copy from now on, this context can't bind its back buffer
+        m_bindTexture = false;
+    }
+
     // Copy the rendered pixels to the texture
-    glCheck(glBindTexture(GL_TEXTURE_2D, textureId));
     glCheck(glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, m_width, m_height));
 }
 
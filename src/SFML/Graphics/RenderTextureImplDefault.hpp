@@ -49,8 +49,19 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
+    /// When \a bindTexture is true and the context supports it,
+    /// display() makes the back buffer of the context the image
+    /// of the target texture instead of copying it; the texture
+    /// must then have the size of the render texture, without
+    /// padding, and the RGBA8 format of the back buffer. The
+    /// image is released when the render texture is activated
+    /// to draw again, so that the texture only shows what was
+    /// displayed until the next drawing starts.
+    ///
+    /// \param bindTexture Can the back buffer be bound to the target texture?
+    ///
     ////////////////////////////////////////////////////////////
-    RenderTextureImplDefault();
+    RenderTextureImplDefault(bool bindTexture = false);
 
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
@@ -63,15 +74,17 @@ private:
     ////////////////////////////////////////////////////////////
     /// \brief Create the render texture implementation
     ///
-    /// \param width       Width of the texture to render to
-    /// \param height      Height of the texture to render to
-    /// \param textureId   OpenGL identifier of the target texture
-    /// \param depthBuffer Is a depth buffer requested?
+    /// \param width        Width of the textures to render to
+    /// \param height       Height of the textures to render to
+    /// \param textureIds   OpenGL identifiers of the target textures
+    /// \param textureCount Number of target textures
+    /// \param settings     Depth, stencil and antialiasing requested for the render texture
     ///
     /// \return True if creation has been successful
     ///
     ////////////////////////////////////////////////////////////
-    virtual bool create(unsigned int width, unsigned int height, unsigned int textureId, bool depthBuffer);
+    virtual bool create(unsigned int width, unsigned int height, const unsigned int* textureIds, unsigned int textureCount,
+                        const ContextSettings& settings);
 
     ////////////////////////////////////////////////////////////
     /// \brief Activate or deactivate the render texture for rendering
@@ -94,9 +107,10 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Context*     m_context; ///< P-Buffer based context
-    unsigned int m_width;   ///< Width of the P-Buffer
-    unsigned int m_height;  ///< Height of the P-Buffer
+    Context*     m_context;     ///< P-Buffer based context
+    unsigned int m_width;       ///< Width of the P-Buffer
+    unsigned int m_height;      ///< Height of the P-Buffer
+    bool         m_bindTexture; ///< Is the P-Buffer bound to the texture instead of being copied?
 };
 
 } // namespace priv
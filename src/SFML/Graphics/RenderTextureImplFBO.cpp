@@ -28,7 +28,53 @@
 #include <SFML/Graphics/RenderTextureImplFBO.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/TextureSaver.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/ResourceMemory.hpp>
+#include <algorithm>
+
+
+namespace
+{
+#ifndef SFML_OPENGL_ES
+
+    // Send the fragments to the first color attachments of the bound frame buffer
+    // (they are written to all of them, gl_FragData[i] selects the i-th one in shaders)
+    void selectDrawBuffers(unsigned int count)
+    {
+        if (count < 2)
+            return;
+
+        std::vector<GLenum> drawBuffers(count);
+        for (unsigned int i = 0; i < count; ++i)
+            drawBuffers[i] = GLEXT_GL_COLOR_ATTACHMENT0 + i;
+
+        glCheck(GLEXT_glDrawBuffers(static_cast<GLsizei>(count), &drawBuffers[0]));
+    }
+
+    // Get the storage format of a texture and the size of its pixels,
+    // so that its multisampled color buffer stores the same pixels
+    GLint getColorFormat(unsigned int texture, unsigned int& pixelSize)
+    {
+        sf::priv::TextureSaver save;
+        sf::priv::bindTexture(GL_TEXTURE_2D, texture);
+
+        GLint format = GL_RGBA8;
+        glCheck(glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT, &format));
+
+        switch (format)
+        {
+            case GLEXT_GL_R8:      pixelSize = 1; return format;
+            case GLEXT_GL_RG8:     pixelSize = 2; return format;
+            case GL_RGB5:          pixelSize = 2; return format;
+            case GLEXT_GL_RGBA16F: pixelSize = 8; return format;
+            case GL_RGBA8:         pixelSize = 4; return format;
+            default:               pixelSize = 4; return GL_RGBA8; // unsized RGBA
+        }
+    }
+
+#endif
+}
 
 
 namespace sf
@@ -36,9 +82,25 @@ namespace sf
 namespace priv
 {
 ////////////////////////////////////////////////////////////
-RenderTextureImplFBO::RenderTextureImplFBO() :
-m_frameBuffer(0),
-m_depthBuffer(0)
+FrameBufferContext::FrameBufferContext() :
+context(),
+current(NULL)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTextureImplFBO::RenderTextureImplFBO(FrameBufferContext* sharedContext) :
+m_context           (NULL),
+m_sharedContext     (sharedContext),
+m_statesChanged     (false),
+m_frameBuffer       (0),
+m_depthBuffer       (0),
+m_resolveFrameBuffer(0),
+m_width             (0),
+m_height            (0),
+m_attachmentSize    (0)
 {
 
 }
@@ -47,7 +109,17 @@ m_depthBuffer(0)
 ////////////////////////////////////////////////////////////
 RenderTextureImplFBO::~RenderTextureImplFBO()
 {
-    ensureGlContext();
+    // Frame buffers are not shared between contexts, they must be destroyed in the one they belong to
+    if (m_sharedContext)
+    {
+        m_sharedContext->context.setActive(true);
+        if (m_sharedContext->current == this)
+            m_sharedContext->current = NULL;
+    }
+    else
+    {
+        ensureGlContext();
+    }
 
     // Destroy the depth buffer
     if (m_depthBuffer)
@@ -56,13 +128,29 @@ RenderTextureImplFBO::~RenderTextureImplFBO()
         glCheck(GLEXT_glDeleteRenderbuffers(1, &depthBuffer));
     }
 
-    // Destroy the frame buffer
+    // Destroy the multisampled color buffers
+    for (std::size_t i = 0; i < m_colorBuffers.size(); ++i)
+    {
+        GLuint colorBuffer = static_cast<GLuint>(m_colorBuffers[i]);
+        glCheck(GLEXT_glDeleteRenderbuffers(1, &colorBuffer));
+    }
+
+    if (m_attachmentSize)
+        ResourceMemory::record(ResourceMemory::RenderTextures, 0, -static_cast<Int64>(m_attachmentSize), 0);
+
+    // Destroy the frame buffers
     if (m_frameBuffer)
     {
         GLuint frameBuffer = static_cast<GLuint>(m_frameBuffer);
         glCheck(GLEXT_glDeleteFramebuffers(1, &frameBuffer));
     }
 
+    if (m_resolveFrameBuffer)
+    {
+        GLuint frameBuffer = static_cast<GLuint>(m_resolveFrameBuffer);
+        glCheck(GLEXT_glDeleteFramebuffers(1, &frameBuffer));
+    }
+
     // Delete the context
     delete m_context;
 }
@@ -81,10 +169,99 @@ bool RenderTextureImplFBO::isAvailable()
 
 
 ////////////////////////////////////////////////////////////
-bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsigned int textureId, bool depthBuffer)
+unsigned int RenderTextureImplFBO::getMaximumAntialiasingLevel()
+{
+    ensureGlContext();
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    GLint samples = 0;
+
+#ifndef SFML_OPENGL_ES
+
+    // The multisampled pixels must be resolved into the textures with a blit
+    if (GLEXT_framebuffer_object && GLEXT_framebuffer_multisample && GLEXT_framebuffer_blit)
+    {
+        glCheck(glGetIntegerv(GLEXT_GL_MAX_SAMPLES, &samples));
+    }
+
+#endif
+
+    return static_cast<unsigned int>(samples);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int RenderTextureImplFBO::getMaximumColorTargetCount()
+{
+    ensureGlContext();
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    GLint count = 1;
+
+#ifndef SFML_OPENGL_ES
+
+    // Each target texture needs both an attachment point and a draw buffer
+    if (GLEXT_framebuffer_object && GLEXT_draw_buffers)
+    {
+        GLint attachments = 0;
+        GLint drawBuffers = 0;
+        glCheck(glGetIntegerv(GLEXT_GL_MAX_COLOR_ATTACHMENTS, &attachments));
+        glCheck(glGetIntegerv(GLEXT_GL_MAX_DRAW_BUFFERS, &drawBuffers));
+        count = std::max(1, std::min(attachments, drawBuffers));
+    }
+
+#endif
+
+    return static_cast<unsigned int>(count);
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, const unsigned int* textureIds, unsigned int textureCount,
+                                  const ContextSettings& settings)
 {
-    // Create the context
-    m_context = new Context;
+    // Check the requested number of color targets
+    if (textureCount > getMaximumColorTargetCount())
+    {
+        err() << "Impossible to create render texture (" << textureCount << " color targets requested, the maximum is "
+              << getMaximumColorTargetCount() << ")" << std::endl;
+        return false;
+    }
+
+    // Clamp the antialiasing level to what the frame buffers support
+    unsigned int samples = settings.antialiasingLevel;
+    if (samples > 0)
+    {
+        unsigned int maxSamples = getMaximumAntialiasingLevel();
+        if (samples > maxSamples)
+        {
+            err() << "Requested antialiasing level (" << samples << ") is not supported by render textures, "
+                  << "using " << maxSamples << " instead" << std::endl;
+            samples = maxSamples;
+        }
+    }
+
+    m_width = width;
+    m_height = height;
+
+    // Create the context, or draw in the shared one
+    if (m_sharedContext)
+    {
+        if (!m_sharedContext->context.setActive(true))
+        {
+            err() << "Impossible to create render texture (failed to activate the shared context)" << std::endl;
+            return false;
+        }
+        m_sharedContext->current = this;
+    }
+    else
+    {
+        m_context = new Context;
+    }
 
     // Create the framebuffer object
     GLuint frameBuffer = 0;
@@ -97,8 +274,26 @@ bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsig
     }
     glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, m_frameBuffer));
 
+    // Stencil bits are stored along with the depth, in a single packed buffer
+    GLenum depthFormat = GLEXT_GL_DEPTH_COMPONENT;
+    bool stencil = false;
+#ifndef SFML_OPENGL_ES
+    if (settings.stencilBits > 0)
+    {
+        if (GLEXT_packed_depth_stencil)
+        {
+            depthFormat = GLEXT_GL_DEPTH24_STENCIL8;
+            stencil = true;
+        }
+        else
+        {
+            err() << "Impossible to create render texture with a stencil buffer (packed depth and stencil buffers are not supported)" << std::endl;
+        }
+    }
+#endif
+
     // Create the depth buffer if requested
-    if (depthBuffer)
+    if ((settings.depthBits > 0) || stencil)
     {
         GLuint depth = 0;
         glCheck(GLEXT_glGenRenderbuffers(1, &depth));
@@ -109,12 +304,82 @@ bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsig
             return false;
         }
         glCheck(GLEXT_glBindRenderbuffer(GLEXT_GL_RENDERBUFFER, m_depthBuffer));
-        glCheck(GLEXT_glRenderbufferStorage(GLEXT_GL_RENDERBUFFER, GLEXT_GL_DEPTH_COMPONENT, width, height));
+
+        if (samples > 0)
+        {
+        #ifndef SFML_OPENGL_ES
+            glCheck(GLEXT_glRenderbufferStorageMultisample(GLEXT_GL_RENDERBUFFER, samples, depthFormat, width, height));
+        #endif
+        }
+        else
+        {
+            glCheck(GLEXT_glRenderbufferStorage(GLEXT_GL_RENDERBUFFER, depthFormat, width, height));
+        }
+
         glCheck(GLEXT_glFramebufferRenderbuffer(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_DEPTH_ATTACHMENT, GLEXT_GL_RENDERBUFFER, m_depthBuffer));
+#ifndef SFML_OPENGL_ES
+        if (stencil)
+        {
+            glCheck(GLEXT_glFramebufferRenderbuffer(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_STENCIL_ATTACHMENT, GLEXT_GL_RENDERBUFFER, m_depthBuffer));
+        }
+#endif
+
+        // Drivers store depth (and stencil) in 32 bits, whatever the requested precision
+        recordAttachment(static_cast<Uint64>(width) * height * 4 * std::max(samples, 1u));
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    if (samples > 0)
+    {
+        // Textures can't be multisampled: render to multisampled color buffers,
+        // and resolve them into the textures attached to a second frame buffer
+        for (unsigned int i = 0; i < textureCount; ++i)
+        {
+            GLuint color = 0;
+            glCheck(GLEXT_glGenRenderbuffers(1, &color));
+            if (!color)
+            {
+                err() << "Impossible to create render texture (failed to create the multisampled color buffer)" << std::endl;
+                return false;
+            }
+            m_colorBuffers.push_back(static_cast<unsigned int>(color));
+
+            unsigned int pixelSize = 4;
+            GLint format = getColorFormat(textureIds[i], pixelSize);
+
+            glCheck(GLEXT_glBindRenderbuffer(GLEXT_GL_RENDERBUFFER, color));
+            glCheck(GLEXT_glRenderbufferStorageMultisample(GLEXT_GL_RENDERBUFFER, samples, format, width, height));
+            glCheck(GLEXT_glFramebufferRenderbuffer(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0 + i, GLEXT_GL_RENDERBUFFER, color));
+            recordAttachment(static_cast<Uint64>(width) * height * pixelSize * samples);
+        }
+
+        selectDrawBuffers(textureCount);
+
+        GLenum status = glCheck(GLEXT_glCheckFramebufferStatus(GLEXT_GL_FRAMEBUFFER));
+        if (status != GLEXT_GL_FRAMEBUFFER_COMPLETE)
+        {
+            glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, 0));
+            err() << "Impossible to create render texture (failed to create the multisampled frame buffer)" << std::endl;
+            return false;
+        }
+
+        GLuint resolveFrameBuffer = 0;
+        glCheck(GLEXT_glGenFramebuffers(1, &resolveFrameBuffer));
+        m_resolveFrameBuffer = static_cast<unsigned int>(resolveFrameBuffer);
+        if (!m_resolveFrameBuffer)
+        {
+            glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, 0));
+            err() << "Impossible to create render texture (failed to create the resolve frame buffer)" << std::endl;
+            return false;
+        }
+        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, m_resolveFrameBuffer));
     }
 
-    // Link the texture to the frame buffer
-    glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textureId, 0));
+#endif
+
+    // Link the textures to the frame buffer
+    attachTextures(textureIds, textureCount);
 
     // A final check, just to be sure...
     GLenum status = glCheck(GLEXT_glCheckFramebufferStatus(GLEXT_GL_FRAMEBUFFER));
@@ -125,6 +390,12 @@ bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsig
         return false;
     }
 
+    // Draw into the multisampled frame buffer, if any
+    if (m_resolveFrameBuffer)
+    {
+        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, m_frameBuffer));
+    }
+
     return true;
 }
 
@@ -132,16 +403,92 @@ bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsig
 ////////////////////////////////////////////////////////////
 bool RenderTextureImplFBO::activate(bool active)
 {
-    return m_context->setActive(active);
+    if (!m_sharedContext)
+        return m_context->setActive(active);
+
+    if (!m_sharedContext->context.setActive(active))
+        return false;
+
+    // Switching between the render textures of a shared context only rebinds the frame buffer,
+    // but the OpenGL states that the previous one left must be set again
+    if (active && (m_sharedContext->current != this))
+    {
+        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, m_frameBuffer));
+        m_statesChanged = true;
+        m_sharedContext->current = this;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTextureImplFBO::takeStatesChange()
+{
+    bool changed = m_statesChanged;
+    m_statesChanged = false;
+    return changed;
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTextureImplFBO::updateTexture(unsigned int)
 {
+#ifndef SFML_OPENGL_ES
+
+    if (m_resolveFrameBuffer)
+    {
+        // Resolve each multisampled color buffer into its texture, without any intermediate copy
+        GLint width = static_cast<GLint>(m_width);
+        GLint height = static_cast<GLint>(m_height);
+
+        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_READ_FRAMEBUFFER, m_frameBuffer));
+        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_DRAW_FRAMEBUFFER, m_resolveFrameBuffer));
+
+        for (std::size_t i = 0; i < m_colorBuffers.size(); ++i)
+        {
+            GLenum attachment = GLEXT_GL_COLOR_ATTACHMENT0 + static_cast<GLenum>(i);
+            glCheck(glReadBuffer(attachment));
+            glCheck(glDrawBuffer(attachment));
+            glCheck(GLEXT_glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST));
+        }
+
+        // Restore the multisampled frame buffer for the next draws
+        glCheck(glReadBuffer(GLEXT_GL_COLOR_ATTACHMENT0));
+        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, m_frameBuffer));
+    }
+
+#endif
+
     glCheck(glFlush());
 }
 
+
+////////////////////////////////////////////////////////////
+void RenderTextureImplFBO::attachTextures(const unsigned int* textureIds, unsigned int textureCount)
+{
+    for (unsigned int i = 0; i < textureCount; ++i)
+    {
+        glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, textureIds[i], 0));
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    // The resolve frame buffer selects its draw buffer for each blit
+    if (!m_resolveFrameBuffer)
+        selectDrawBuffers(textureCount);
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTextureImplFBO::recordAttachment(Uint64 bytes)
+{
+    ResourceMemory::record(ResourceMemory::RenderTextures, 0, static_cast<Int64>(bytes), 0);
+    m_attachmentSize += bytes;
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -31,12 +31,32 @@
 #include <SFML/Graphics/RenderTextureImpl.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/Window/GlResource.hpp>
+#include <cstddef>
+#include <vector>
 
 
 namespace sf
 {
 namespace priv
 {
+class RenderTextureImplFBO;
+
+////////////////////////////////////////////////////////////
+/// \brief OpenGL context shared by several FBO render textures
+///
+////////////////////////////////////////////////////////////
+struct FrameBufferContext
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    FrameBufferContext();
+
+    Context                     context; ///< Context in which the frame buffers are created and drawn
+    const RenderTextureImplFBO* current; ///< Render texture whose frame buffer is bound in the context
+};
+
 ////////////////////////////////////////////////////////////
 /// \brief Specialization of RenderTextureImpl using the
 ///        FrameBuffer Object OpenGL extension
@@ -49,8 +69,13 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
+    /// Without a shared context, the render texture creates its
+    /// own context. A shared context must outlive the render texture.
+    ///
+    /// \param sharedContext Context to share with other render textures, or NULL
+    ///
     ////////////////////////////////////////////////////////////
-    RenderTextureImplFBO();
+    explicit RenderTextureImplFBO(FrameBufferContext* sharedContext = NULL);
 
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
@@ -66,20 +91,38 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isAvailable();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum antialiasing level supported by FBOs
+    ///
+    /// \return Maximum number of samples, 0 if multisampled FBOs are not supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getMaximumAntialiasingLevel();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of textures that a FBO can render to at once
+    ///
+    /// \return Maximum number of color targets
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getMaximumColorTargetCount();
+
 private:
 
     ////////////////////////////////////////////////////////////
     /// \brief Create the render texture implementation
     ///
-    /// \param width       Width of the texture to render to
-    /// \param height      Height of the texture to render to
-    /// \param textureId   OpenGL identifier of the target texture
-    /// \param depthBuffer Is a depth buffer requested?
+    /// \param width        Width of the textures to render to
+    /// \param height       Height of the textures to render to
+    /// \param textureIds   OpenGL identifiers of the target textures
+    /// \param textureCount Number of target textures
+    /// \param settings     Depth, stencil and antialiasing requested for the render texture
     ///
     /// \return True if creation has been successful
     ///
     ////////////////////////////////////////////////////////////
-    virtual bool create(unsigned int width, unsigned int height, unsigned int textureId, bool depthBuffer);
+    virtual bool create(unsigned int width, unsigned int height, const unsigned int* textureIds, unsigned int textureCount,
+                        const ContextSettings& settings);
 
     ////////////////////////////////////////////////////////////
     /// \brief Activate or deactivate the render texture for rendering
@@ -94,17 +137,53 @@ private:
     ////////////////////////////////////////////////////////////
     /// \brief Update the pixels of the target texture
     ///
+    /// Multisampled color buffers are resolved into the target
+    /// textures, the other frame buffers render to them directly.
+    ///
     /// \param textureId OpenGL identifier of the target texture
     ///
     ////////////////////////////////////////////////////////////
     virtual void updateTexture(unsigned textureId);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether another render texture drew in the
+    ///        context since the last call
+    ///
+    /// \return True if the OpenGL states were changed by another render texture
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool takeStatesChange();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Attach the target textures and select them as draw buffers
+    ///
+    /// \param textureIds   OpenGL identifiers of the target textures
+    /// \param textureCount Number of target textures
+    ///
+    ////////////////////////////////////////////////////////////
+    void attachTextures(const unsigned int* textureIds, unsigned int textureCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Account the storage of a new render buffer
+    ///
+    /// \param bytes Size of the render buffer, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void recordAttachment(Uint64 bytes);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Context*     m_context;     ///< Needs a separate OpenGL context for not messing up the other ones
-    unsigned int m_frameBuffer; ///< OpenGL frame buffer object
-    unsigned int m_depthBuffer; ///< Optional depth buffer attached to the frame buffer
+    Context*                  m_context;            ///< Needs a separate OpenGL context for not messing up the other ones
+    FrameBufferContext*       m_sharedContext;      ///< Context shared with other render textures, used instead of m_context
+    bool                      m_statesChanged;      ///< Did another render texture draw in the shared context?
+    unsigned int              m_frameBuffer;        ///< OpenGL frame buffer object
+    unsigned int              m_depthBuffer;        ///< Optional depth (and stencil) buffer attached to the frame buffer
+    unsigned int              m_resolveFrameBuffer; ///< Frame buffer that holds the textures when the color buffers are multisampled
+    std::vector<unsigned int> m_colorBuffers;       ///< Multisampled color buffers, one per target texture
+    unsigned int              m_width;              ///< Width of the frame buffers
+    unsigned int              m_height;             ///< Height of the frame buffers
+    Uint64                    m_attachmentSize;     ///< Bytes of the depth and multisampled color buffers (see ResourceMemory)
 };
 
 } // namespace priv
@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RenderTexturePool.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/RenderTextureImplFBO.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+RenderTexturePool::RenderTexturePool() :
+m_slots  (),
+m_context(NULL)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTexturePool::~RenderTexturePool()
+{
+    // The render textures use the shared context, it must be destroyed last
+    for (std::size_t i = 0; i < m_slots.size(); ++i)
+        delete m_slots[i].texture;
+
+    delete m_context;
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTexture* RenderTexturePool::acquire(unsigned int width, unsigned int height, bool depthBuffer)
+{
+    for (std::size_t i = 0; i < m_slots.size(); ++i)
+    {
+        Slot& slot = m_slots[i];
+        if (!slot.used && (slot.size.x == width) && (slot.size.y == height) && (slot.depthBuffer == depthBuffer))
+        {
+            slot.used = true;
+            slot.texture->setView(slot.texture->getDefaultView());
+            return slot.texture;
+        }
+    }
+
+    // No render texture to reuse: create one, in the context shared by the pool
+    if (!m_context && priv::RenderTextureImplFBO::isAvailable())
+        m_context = new priv::FrameBufferContext;
+
+    RenderTexture* texture = new RenderTexture;
+    if (!texture->create(width, height, ContextSettings(depthBuffer ? 32 : 0), PixelFormat::RGBA8, 1, m_context))
+    {
+        delete texture;
+        return NULL;
+    }
+
+    Slot slot;
+    slot.texture = texture;
+    slot.size = Vector2u(width, height);
+    slot.depthBuffer = depthBuffer;
+    slot.used = true;
+    m_slots.push_back(slot);
+
+    return texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTexturePool::release(RenderTexture* texture)
+{
+    for (std::size_t i = 0; i < m_slots.size(); ++i)
+    {
+        if (m_slots[i].texture == texture)
+        {
+            m_slots[i].used = false;
+            return;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTexturePool::purge()
+{
+    std::vector<Slot> slots;
+    for (std::size_t i = 0; i < m_slots.size(); ++i)
+    {
+        if (m_slots[i].used)
+            slots.push_back(m_slots[i]);
+        else
+            delete m_slots[i].texture;
+    }
+
+    m_slots.swap(slots);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderTexturePool::getTextureCount() const
+{
+    return m_slots.size();
+}
+
+} // namespace sf
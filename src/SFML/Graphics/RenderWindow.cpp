@@ -27,6 +27,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GpuProfiler.hpp>
 
 
 namespace sf
@@ -75,6 +76,24 @@ Vector2u RenderWindow::getSize() const
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderWindow::display()
+{
+    // Draw the pending batch before the back buffer is presented
+    flush();
+    endFrameStatistics();
+
+#ifdef SFML_ENABLE_PROFILER
+    // Submit the GPU zones of the previous frames, and time the presentation
+    if (setActive())
+        priv::collectGpuZones();
+    priv::GpuZone presentZone("RenderWindow::display");
+#endif
+
+    Window::display();
+}
+
+
 ////////////////////////////////////////////////////////////
 Image RenderWindow::capture() const
 {
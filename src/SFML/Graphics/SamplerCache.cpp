@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SamplerCache.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+
+
+#ifndef SFML_OPENGL_ES
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+SamplerCache::SamplerCache()
+{
+    for (int i = 0; i < 8; ++i)
+        m_samplers[i] = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+SamplerCache::~SamplerCache()
+{
+    // Samplers are shared, they can be destroyed in any context
+    ensureGlContext();
+
+    for (int i = 0; i < 8; ++i)
+    {
+        if (m_samplers[i])
+        {
+            glCheck(GLEXT_glDeleteSamplers(1, &m_samplers[i]));
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+GLuint SamplerCache::getSampler(bool smooth, bool repeated, bool mipmapped)
+{
+    GLuint& sampler = m_samplers[(smooth ? 1 : 0) | (repeated ? 2 : 0) | (mipmapped ? 4 : 0)];
+    if (sampler)
+        return sampler;
+
+    glCheck(GLEXT_glGenSamplers(1, &sampler));
+
+    // Same parameters as the ones sf::Texture sets on itself
+    GLint wrap = repeated ? GL_REPEAT : GLEXT_GL_CLAMP_TO_EDGE;
+    GLint minFilter = mipmapped ? (smooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR) : (smooth ? GL_LINEAR : GL_NEAREST);
+    glCheck(GLEXT_glSamplerParameteri(sampler, GL_TEXTURE_WRAP_S, wrap));
+    glCheck(GLEXT_glSamplerParameteri(sampler, GL_TEXTURE_WRAP_T, wrap));
+    glCheck(GLEXT_glSamplerParameteri(sampler, GL_TEXTURE_MAG_FILTER, smooth ? GL_LINEAR : GL_NEAREST));
+    glCheck(GLEXT_glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, minFilter));
+
+    return sampler;
+}
+
+} // namespace priv
+
+} // namespace sf
+
+#else // SFML_OPENGL_ES
+
+// Sampler objects are not used with OpenGL ES: the cache is never asked for one
+
+namespace sf
+{
+namespace priv
+{
+SamplerCache::SamplerCache() {}
+SamplerCache::~SamplerCache() {}
+GLuint SamplerCache::getSampler(bool, bool, bool) {return 0;}
+
+} // namespace priv
+
+} // namespace sf
+
+#endif // SFML_OPENGL_ES
@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SAMPLERCACHE_HPP
+#define SFML_SAMPLERCACHE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GLExtensions.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Sampler objects used by sf::RenderTarget for the sampler modes
+///
+/// There is one sampler per combination of filter, wrap mode
+/// and mipmapping, created on first use. Sampler objects are
+/// shared between contexts, like textures.
+///
+////////////////////////////////////////////////////////////
+class SamplerCache : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    SamplerCache();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor, destroying the sampler objects
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SamplerCache();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the sampler object with the given parameters
+    ///
+    /// A context must be active, and sampler objects supported.
+    ///
+    /// \param smooth    Are the texels filtered linearly?
+    /// \param repeated  Are the coordinates repeated?
+    /// \param mipmapped Does the texture have mipmaps?
+    ///
+    /// \return OpenGL identifier of the sampler object
+    ///
+    ////////////////////////////////////////////////////////////
+    GLuint getSampler(bool smooth, bool repeated, bool mipmapped);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    GLuint m_samplers[8]; ///< Sampler objects, indexed by their parameters (0 if not created yet)
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SAMPLERCACHE_HPP
@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SamplerMode.hpp>
+#include <SFML/Graphics/GLExtensions.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+
+
+namespace
+{
+    sf::Mutex mutex;
+
+    bool checkSamplersAvailable()
+    {
+        // Create a temporary context in case the user checks
+        // before a GlResource is created, thus initializing
+        // the shared context
+        sf::Context context;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        return GLEXT_sampler_objects;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SamplerMode::SamplerMode() :
+filter(SamplerMode::TextureFilter),
+wrap  (SamplerMode::TextureWrap)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+SamplerMode::SamplerMode(Filter theFilter, Wrap theWrap) :
+filter(theFilter),
+wrap  (theWrap)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+bool SamplerMode::isAvailable()
+{
+    // TODO: Remove this lock when it becomes unnecessary in C++11
+    Lock lock(mutex);
+
+    static bool available = checkSamplersAvailable();
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+bool operator ==(const SamplerMode& left, const SamplerMode& right)
+{
+    return (left.filter == right.filter) &&
+           (left.wrap   == right.wrap);
+}
+
+
+////////////////////////////////////////////////////////////
+bool operator !=(const SamplerMode& left, const SamplerMode& right)
+{
+    return !(left == right);
+}
+
+} // namespace sf
@@ -0,0 +1,250 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SceneNode.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+    // Compute the smallest rectangle containing two rectangles, ignoring the empty ones
+    sf::FloatRect merge(const sf::FloatRect& first, const sf::FloatRect& second)
+    {
+        if ((second.width <= 0) && (second.height <= 0))
+            return first;
+        if ((first.width <= 0) && (first.height <= 0))
+            return second;
+
+        float left   = std::min(first.left, second.left);
+        float top    = std::min(first.top, second.top);
+        float right  = std::max(first.left + first.width, second.left + second.width);
+        float bottom = std::max(first.top + first.height, second.top + second.height);
+
+        return sf::FloatRect(left, top, right - left, bottom - top);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SceneNode::SceneNode() :
+m_parent                  (NULL),
+m_children                (),
+m_worldTransform          (),
+m_worldTransformNeedUpdate(true),
+m_worldBounds             (),
+m_worldBoundsNeedUpdate   (true)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SceneNode::~SceneNode()
+{
+    if (m_parent)
+        m_parent->detachChild(*this);
+
+    while (!m_children.empty())
+        detachChild(*m_children.back());
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::attachChild(SceneNode& child)
+{
+    if ((child.m_parent == this) || (&child == this))
+        return;
+
+    if (child.m_parent)
+        child.m_parent->detachChild(child);
+
+    child.m_parent = this;
+    m_children.push_back(&child);
+
+    child.invalidateWorldTransform();
+    invalidateBounds();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::detachChild(SceneNode& child)
+{
+    std::vector<SceneNode*>::iterator it = std::find(m_children.begin(), m_children.end(), &child);
+    if (it == m_children.end())
+        return;
+
+    m_children.erase(it);
+    child.m_parent = NULL;
+
+    child.invalidateWorldTransform();
+    invalidateBounds();
+}
+
+
+////////////////////////////////////////////////////////////
+SceneNode* SceneNode::getParent() const
+{
+    return m_parent;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SceneNode::getChildCount() const
+{
+    return m_children.size();
+}
+
+
+////////////////////////////////////////////////////////////
+SceneNode& SceneNode::getChild(std::size_t index) const
+{
+    return *m_children[index];
+}
+
+
+////////////////////////////////////////////////////////////
+const Transform& SceneNode::getWorldTransform() const
+{
+    if (m_worldTransformNeedUpdate)
+    {
+        if (m_parent)
+            m_worldTransform = m_parent->getWorldTransform() * getTransform();
+        else
+            m_worldTransform = getTransform();
+
+        m_worldTransformNeedUpdate = false;
+    }
+
+    return m_worldTransform;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect SceneNode::getWorldBounds() const
+{
+    if (m_worldBoundsNeedUpdate)
+    {
+        // The world transform is always updated, so that the dirty flags of the subtree stay consistent
+        const Transform& transform = getWorldTransform();
+        FloatRect local = getLocalBounds();
+        if ((local.width > 0) || (local.height > 0))
+            m_worldBounds = transform.transformRect(local);
+        else
+            m_worldBounds = FloatRect();
+
+        for (std::vector<SceneNode*>::const_iterator it = m_children.begin(); it != m_children.end(); ++it)
+            m_worldBounds = merge(m_worldBounds, (*it)->getWorldBounds());
+
+        m_worldBoundsNeedUpdate = false;
+    }
+
+    return m_worldBounds;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect SceneNode::getLocalBounds() const
+{
+    return FloatRect();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::drawSelf(RenderTarget&, RenderStates) const
+{
+    // Nothing to draw by default
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::invalidateBounds()
+{
+    // Once a node is outdated, so are all its ancestors
+    for (SceneNode* node = this; node && !node->m_worldBoundsNeedUpdate; node = node->m_parent)
+        node->m_worldBoundsNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::draw(RenderTarget& target, RenderStates states) const
+{
+    // The cached world transforms can be used as is, unless the node is drawn with an additional transform
+    const float* matrix = states.transform.getMatrix();
+    if (std::memcmp(matrix, Transform::Identity.getMatrix(), 16 * sizeof(float)) == 0)
+        drawSubtree(target, states, NULL);
+    else
+        drawSubtree(target, states, &states.transform);
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::drawSubtree(RenderTarget& target, const RenderStates& states, const Transform* base) const
+{
+    // Skip the whole subtree if it is out of the view; culling is only
+    // reliable without a base transform, which the bounds don't include
+    if (!base && target.isCullingEnabled())
+    {
+        FloatRect bounds = getWorldBounds();
+        if (((bounds.width > 0) || (bounds.height > 0)) && !target.isVisible(bounds))
+            return;
+    }
+
+    RenderStates nodeStates(states);
+    nodeStates.transform = base ? *base * getWorldTransform() : getWorldTransform();
+    drawSelf(target, nodeStates);
+
+    for (std::vector<SceneNode*>::const_iterator it = m_children.begin(); it != m_children.end(); ++it)
+        (*it)->drawSubtree(target, states, base);
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::onTransformChanged()
+{
+    invalidateWorldTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneNode::invalidateWorldTransform()
+{
+    // The subtree of a node whose world transform is outdated is already outdated too
+    if (!m_worldTransformNeedUpdate)
+    {
+        m_worldTransformNeedUpdate = true;
+        for (std::vector<SceneNode*>::iterator it = m_children.begin(); it != m_children.end(); ++it)
+            (*it)->invalidateWorldTransform();
+    }
+
+    // The bounds of the node and its ancestors depend on the world transforms
+    invalidateBounds();
+}
+
+} // namespace sf
@@ -28,13 +28,20 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Shader.hpp>
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/TextureArray.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/Profiler.hpp>
+#include <SFML/System/ResourceMemory.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <iterator>
 #include <vector>
 
 
@@ -56,6 +63,17 @@ namespace
 {
     sf::Mutex mutex;
 
+    // Thread-safe unique identifier generator,
+    // is used for states cache (see RenderTarget)
+    sf::Uint64 getUniqueId()
+    {
+        sf::Lock lock(mutex);
+
+        static sf::Uint64 id = 1; // start at 1, zero is "no shader"
+
+        return id++;
+    }
+
     GLint checkMaxTextureUnits()
     {
         GLint maxUnits = 0;
@@ -114,6 +132,233 @@ namespace
         return success;
     }
 
+    // Number of shader stages, and their properties in the order of sf::Shader::Type
+    const int stageCount = 4;
+    const GLenum stageTypes[stageCount] = {GLEXT_GL_VERTEX_SHADER, GLEXT_GL_GEOMETRY_SHADER, GLEXT_GL_FRAGMENT_SHADER, GLEXT_GL_COMPUTE_SHADER};
+    const char* const stageNames[stageCount] = {"vertex", "geometry", "fragment", "compute"};
+
+    // Directory of the program binary cache, empty if the cache is disabled
+    std::string binaryCacheDirectory;
+
+    // Identifier of the program binary cache files
+    const char binaryCacheMagic[4] = {'S', 'F', 'P', 'B'};
+
+    // Get the path of the cache file of a program, empty if the cache can't be used
+    std::string getBinaryCachePath(const char* const* codes)
+    {
+        std::string directory;
+        {
+            sf::Lock lock(mutex);
+            directory = binaryCacheDirectory;
+        }
+
+        if (directory.empty() || !GLEXT_get_program_binary)
+            return "";
+
+        // Some drivers expose the extension without supporting any format
+        GLint formatCount = 0;
+        glCheck(glGetIntegerv(GLEXT_GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount));
+        if (formatCount <= 0)
+            return "";
+
+        // Binaries are only valid for the driver that produced them, so it is part of the key (FNV-1a hash)
+        const char* strings[3 + stageCount] = {reinterpret_cast<const char*>(glGetString(GL_VENDOR)),
+                                               reinterpret_cast<const char*>(glGetString(GL_RENDERER)),
+                                               reinterpret_cast<const char*>(glGetString(GL_VERSION))};
+        std::copy(codes, codes + stageCount, strings + 3);
+        sf::Uint64 hash = 14695981039346656037ULL;
+        for (int i = 0; i < 3 + stageCount; ++i)
+        {
+            // Separate the strings, and distinguish a missing shader from an empty one
+            const char* string = strings[i] ? strings[i] : "";
+            for (std::size_t j = 0; string[j]; ++j)
+                hash = (hash ^ static_cast<unsigned char>(string[j])) * 1099511628211ULL;
+            hash = (hash ^ (strings[i] ? 0xFF : 0xFE)) * 1099511628211ULL;
+        }
+
+        char name[17];
+        for (int i = 0; i < 16; ++i)
+            name[i] = "0123456789abcdef"[(hash >> ((15 - i) * 4)) & 0xF];
+        name[16] = '\0';
+
+        char last = directory[directory.size() - 1];
+        if ((last != '/') && (last != '\\'))
+            directory += '/';
+
+        return directory + name + ".glbin";
+    }
+
+    // Create a program from its cached binary, returns 0 if there's no valid binary
+    GLEXT_GLhandle loadProgramBinary(const std::string& path)
+    {
+        std::ifstream file(path.c_str(), std::ios_base::binary);
+        if (!file)
+            return 0;
+
+        // Header: identifier and binary format
+        char magic[4];
+        unsigned char format[4];
+        if (!file.read(magic, 4) || (std::memcmp(magic, binaryCacheMagic, 4) != 0) || !file.read(reinterpret_cast<char*>(format), 4))
+            return 0;
+
+        GLenum binaryFormat = format[0] | (format[1] << 8) | (format[2] << 16) | (static_cast<GLenum>(format[3]) << 24);
+        std::vector<char> binary((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (binary.empty())
+            return 0;
+
+        GLEXT_GLhandle program = glCheck(GLEXT_glCreateProgramObject());
+        glCheck(GLEXT_glProgramBinary(castFromGlHandle(program), binaryFormat, &binary[0], static_cast<GLsizei>(binary.size())));
+
+        // The driver rejects binaries that it can't use anymore (e.g. after an update)
+        GLint success;
+        glCheck(GLEXT_glGetObjectParameteriv(program, GLEXT_GL_OBJECT_LINK_STATUS, &success));
+        if (success == GL_FALSE)
+        {
+            glCheck(GLEXT_glDeleteObject(program));
+            return 0;
+        }
+
+        return program;
+    }
+
+    // Write the binary of a linked program to the cache
+    void saveProgramBinary(GLEXT_GLhandle program, const std::string& path)
+    {
+        GLint length = 0;
+        glCheck(GLEXT_glGetObjectParameteriv(program, GLEXT_GL_PROGRAM_BINARY_LENGTH, &length));
+        if (length <= 0)
+            return;
+
+        std::vector<char> binary(length);
+        GLenum binaryFormat = 0;
+        glCheck(GLEXT_glGetProgramBinary(castFromGlHandle(program), length, &length, &binaryFormat, &binary[0]));
+
+        std::ofstream file(path.c_str(), std::ios_base::binary);
+        if (!file)
+        {
+            sf::err() << "Failed to write shader binary cache file \"" << path << "\"" << std::endl;
+            return;
+        }
+
+        char format[4] = {static_cast<char>(binaryFormat & 0xFF),
+                          static_cast<char>((binaryFormat >> 8) & 0xFF),
+                          static_cast<char>((binaryFormat >> 16) & 0xFF),
+                          static_cast<char>((binaryFormat >> 24) & 0xFF)};
+        file.write(binaryCacheMagic, 4);
+        file.write(format, 4);
+        file.write(&binary[0], length);
+    }
+
+    // Report a new program to the memory accounting, and return the size reported
+    sf::Uint64 recordProgramCreated(GLEXT_GLhandle program)
+    {
+        // The size of the binary is the best estimate available of the driver's allocation
+        GLint length = 0;
+        if (GLEXT_get_program_binary)
+        {
+            glCheck(GLEXT_glGetObjectParameteriv(program, GLEXT_GL_PROGRAM_BINARY_LENGTH, &length));
+        }
+
+        sf::Uint64 size = (length > 0) ? static_cast<sf::Uint64>(length) : 0;
+        sf::ResourceMemory::record(sf::ResourceMemory::Shaders, 1, static_cast<sf::Int64>(size), 0);
+        return size;
+    }
+
+    // Create a shader object and start compiling it, without checking the result
+    GLEXT_GLhandle createShaderObject(GLenum type, const char* code)
+    {
+        GLEXT_GLhandle shader = glCheck(GLEXT_glCreateShaderObject(type));
+        glCheck(GLEXT_glShaderSource(shader, 1, &code, NULL));
+        glCheck(GLEXT_glCompileShader(shader));
+
+        return shader;
+    }
+
+    // Check whether a shader object was successfully compiled, and print its log if not
+    bool checkCompileStatus(GLEXT_GLhandle shader, const char* name)
+    {
+        GLint success;
+        glCheck(GLEXT_glGetObjectParameteriv(shader, GLEXT_GL_OBJECT_COMPILE_STATUS, &success));
+        if (success == GL_FALSE)
+        {
+            char log[1024];
+            glCheck(GLEXT_glGetInfoLog(shader, sizeof(log), 0, log));
+            sf::err() << "Failed to compile " << name << " shader:" << std::endl
+                      << log << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    // Check whether a program was successfully linked, and print its log if not
+    bool checkLinkStatus(GLEXT_GLhandle program)
+    {
+        GLint success;
+        glCheck(GLEXT_glGetObjectParameteriv(program, GLEXT_GL_OBJECT_LINK_STATUS, &success));
+        if (success == GL_FALSE)
+        {
+            char log[1024];
+            glCheck(GLEXT_glGetInfoLog(program, sizeof(log), 0, log));
+            sf::err() << "Failed to link shader:" << std::endl
+                      << log << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    // Link a program (keeping its binary retrievable if it has to be cached)
+    void linkProgram(GLEXT_GLhandle program, const std::string& cachePath)
+    {
+        if (!cachePath.empty())
+        {
+            glCheck(GLEXT_glProgramParameteri(castFromGlHandle(program), GLEXT_GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+        }
+        glCheck(GLEXT_glLinkProgram(program));
+    }
+
+    // Compile the shaders (one code per stage) and link the program; if one of
+    // the codes is NULL, the corresponding shader is not created. Returns 0 on failure
+    GLEXT_GLhandle buildProgram(const char* const* codes, const std::string& cachePath)
+    {
+        // Create the program
+        GLEXT_GLhandle program = glCheck(GLEXT_glCreateProgramObject());
+
+        // Create the shaders
+        for (int i = 0; i < stageCount; ++i)
+        {
+            if (!codes[i])
+                continue;
+
+            GLEXT_GLhandle shader = createShaderObject(stageTypes[i], codes[i]);
+            if (!checkCompileStatus(shader, stageNames[i]))
+            {
+                glCheck(GLEXT_glDeleteObject(shader));
+                glCheck(GLEXT_glDeleteObject(program));
+                return 0;
+            }
+
+            // Attach the shader to the program, and delete it (not needed anymore)
+            glCheck(GLEXT_glAttachObject(program, shader));
+            glCheck(GLEXT_glDeleteObject(shader));
+        }
+
+        // Link the program
+        linkProgram(program, cachePath);
+        if (!checkLinkStatus(program))
+        {
+            glCheck(GLEXT_glDeleteObject(program));
+            return 0;
+        }
+
+        // Store the binary of the program, so that the next compilation is skipped
+        if (!cachePath.empty())
+            saveProgramBinary(program, cachePath);
+
+        return program;
+    }
+
     bool checkShadersAvailable()
     {
         // Create a temporary context in case the user checks
@@ -132,11 +377,260 @@ namespace
 
         return available;
     }
+
+    bool checkGeometryShadersAvailable()
+    {
+        sf::Context context;
+
+        sf::priv::ensureExtensionsInit();
+
+        return GLEXT_geometry_shader;
+    }
+
+    bool checkComputeShadersAvailable()
+    {
+        sf::Context context;
+
+        sf::priv::ensureExtensionsInit();
+
+        return GLEXT_compute_shader;
+    }
+
+    // Get the format under which the shaders access a texture bound as an image, 0 if it can't be bound
+    GLenum getImageFormat(sf::PixelFormat::Type format)
+    {
+        switch (format)
+        {
+            case sf::PixelFormat::RGBA8:   return GL_RGBA8;
+            case sf::PixelFormat::R8:      return GLEXT_GL_R8;
+            case sf::PixelFormat::RG8:     return GLEXT_GL_RG8;
+            case sf::PixelFormat::RGBA16F: return GLEXT_GL_RGBA16F;
+            default:                       return 0; // Packed formats have no image equivalent
+        }
+    }
+
+    // Convert an sf::Shader::ImageAccess constant to the corresponding OpenGL constant
+    GLenum imageAccessToGlEnum(sf::Shader::ImageAccess access)
+    {
+        switch (access)
+        {
+            case sf::Shader::ReadOnly:  return GLEXT_GL_READ_ONLY;
+            case sf::Shader::WriteOnly: return GLEXT_GL_WRITE_ONLY;
+            default:                    return GLEXT_GL_READ_WRITE;
+        }
+    }
 }
 
 
 namespace sf
 {
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Compilation of a program running in the background
+///
+/// The driver's own threads are used when it supports
+/// GL_KHR_parallel_shader_compile, otherwise the program is
+/// built by a worker thread in a context shared with the
+/// other ones.
+///
+////////////////////////////////////////////////////////////
+class ShaderCompiler : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start compiling a program
+    ///
+    /// A GL context must be active, if the compilation is
+    /// handed to the driver.
+    ///
+    ////////////////////////////////////////////////////////////
+    ShaderCompiler(const char* const* codes, const std::string& cachePath) :
+    m_cachePath(cachePath),
+    m_parallel (GLEXT_parallel_shader_compile != 0),
+    m_program  (0),
+    m_finished (false),
+    m_thread   (&ShaderCompiler::run, this)
+    {
+        for (int i = 0; i < stageCount; ++i)
+        {
+            m_codes[i] = codes[i] ? codes[i] : "";
+            m_hasCode[i] = (codes[i] != NULL);
+            m_shaders[i] = 0;
+        }
+
+        if (m_parallel)
+        {
+            // Let the driver use as many threads as it wants
+            {
+                Lock lock(mutex);
+
+                static bool threadCountSet = false;
+                if (!threadCountSet)
+                {
+                    glCheck(GLEXT_glMaxShaderCompilerThreads(0xFFFFFFFF));
+                    threadCountSet = true;
+                }
+            }
+
+            // Issue all the commands without querying any result, so that nothing blocks
+            GLEXT_GLhandle program = glCheck(GLEXT_glCreateProgramObject());
+            for (int i = 0; i < stageCount; ++i)
+            {
+                if (!m_hasCode[i])
+                    continue;
+
+                GLEXT_GLhandle shader = createShaderObject(stageTypes[i], m_codes[i].c_str());
+                glCheck(GLEXT_glAttachObject(program, shader));
+                m_shaders[i] = castFromGlHandle(shader);
+            }
+            linkProgram(program, m_cachePath);
+            m_program = castFromGlHandle(program);
+        }
+        else
+        {
+            m_thread.launch();
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor, waits for the compilation and discards its result
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ShaderCompiler()
+    {
+        m_thread.wait();
+
+        ensureGlContext();
+
+        deleteShaders();
+        if (m_program)
+        {
+            glCheck(GLEXT_glDeleteObject(castToGlHandle(m_program)));
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the compilation is over
+    ///
+    /// With the driver's threads, this checks the result of
+    /// the compilation once it is complete. A GL context must
+    /// be active.
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isFinished()
+    {
+        if (!m_parallel)
+        {
+            Lock lock(m_mutex);
+            return m_finished;
+        }
+
+        if (m_finished)
+            return true;
+
+        GLint complete;
+        glCheck(GLEXT_glGetObjectParameteriv(castToGlHandle(m_program), GLEXT_GL_COMPLETION_STATUS, &complete));
+        if (complete == GL_FALSE)
+            return false;
+
+        // The compilation is complete, now we can check its result without blocking
+        bool success = true;
+        for (int i = 0; (i < stageCount) && success; ++i)
+            success = !m_shaders[i] || checkCompileStatus(castToGlHandle(m_shaders[i]), stageNames[i]);
+        success = success && checkLinkStatus(castToGlHandle(m_program));
+        deleteShaders();
+
+        if (success)
+        {
+            if (!m_cachePath.empty())
+                saveProgramBinary(castToGlHandle(m_program), m_cachePath);
+        }
+        else
+        {
+            glCheck(GLEXT_glDeleteObject(castToGlHandle(m_program)));
+            m_program = 0;
+        }
+
+        m_finished = true;
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take the ownership of the compiled program
+    ///
+    /// \return OpenGL identifier of the program, 0 if the compilation failed
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int takeProgram()
+    {
+        Lock lock(m_mutex);
+
+        unsigned int program = m_program;
+        m_program = 0;
+
+        return program;
+    }
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Build the program in a shared context (worker thread)
+    ///
+    ////////////////////////////////////////////////////////////
+    void run()
+    {
+        Context context;
+
+        const char* codes[stageCount];
+        for (int i = 0; i < stageCount; ++i)
+            codes[i] = m_hasCode[i] ? m_codes[i].c_str() : NULL;
+
+        GLEXT_GLhandle program = buildProgram(codes, m_cachePath);
+
+        // Make sure that the program is complete before other contexts use it
+        glCheck(glFinish());
+
+        Lock lock(m_mutex);
+        m_program = castFromGlHandle(program);
+        m_finished = true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Delete the shader objects created for the driver's threads
+    ///
+    ////////////////////////////////////////////////////////////
+    void deleteShaders()
+    {
+        for (int i = 0; i < stageCount; ++i)
+        {
+            if (m_shaders[i])
+            {
+                glCheck(GLEXT_glDeleteObject(castToGlHandle(m_shaders[i])));
+            }
+
+            m_shaders[i] = 0;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::string  m_codes[stageCount];   ///< Source code of the shader of each stage
+    bool         m_hasCode[stageCount]; ///< Is there a shader for each stage?
+    std::string  m_cachePath;           ///< Where to store the binary of the program, empty if the cache is disabled
+    bool         m_parallel;            ///< Is the program compiled by the driver's threads?
+    unsigned int m_program;             ///< OpenGL identifier of the program, 0 until it is built
+    unsigned int m_shaders[stageCount]; ///< Shader objects being compiled by the driver, per stage
+    Mutex        m_mutex;               ///< Mutex protecting the result of the worker thread
+    bool         m_finished;            ///< Is the compilation over?
+    Thread       m_thread;              ///< Worker thread
+};
+
+} // namespace priv
+
+
 ////////////////////////////////////////////////////////////
 Shader::CurrentTextureType Shader::CurrentTexture;
 
@@ -144,9 +638,20 @@ Shader::CurrentTextureType Shader::CurrentTexture;
 ////////////////////////////////////////////////////////////
 Shader::Shader() :
 m_shaderProgram (0),
+m_programSize   (0),
+m_cacheId       (getUniqueId()),
 m_currentTexture(-1),
 m_textures      (),
-m_params        ()
+m_textureArrays (),
+m_images        (),
+m_params        (),
+m_uniforms      (),
+m_uniformsDirty (false),
+m_samplersDirty (false),
+m_compute       (false),
+m_compiler      (NULL),
+m_sources       (stageCount),
+m_generation    (Context::getGeneration())
 {
 }
 
@@ -156,9 +661,18 @@ Shader::~Shader()
 {
     ensureGlContext();
 
-    // Destroy effect program
+    // Discard the pending compilation
+    delete m_compiler;
+
+    // Destroy effect program (a program lost with its context doesn't exist anymore)
     if (m_shaderProgram)
-        glCheck(GLEXT_glDeleteObject(castToGlHandle(m_shaderProgram)));
+    {
+        if (m_generation == Context::getGeneration())
+        {
+            glCheck(GLEXT_glDeleteObject(castToGlHandle(m_shaderProgram)));
+        }
+        ResourceMemory::record(ResourceMemory::Shaders, -1, -static_cast<Int64>(m_programSize), 0);
+    }
 }
 
 
@@ -174,10 +688,7 @@ bool Shader::loadFromFile(const std::string& filename, Type type)
     }
 
     // Compile the shader program
-    if (type == Vertex)
-        return compile(&shader[0], NULL);
-    else
-        return compile(NULL, &shader[0]);
+    return compile(type, &shader[0]);
 }
 
 
@@ -201,7 +712,39 @@ bool Shader::loadFromFile(const std::string& vertexShaderFilename, const std::st
     }
 
     // Compile the shader program
-    return compile(&vertexShader[0], &fragmentShader[0]);
+    return compile(&vertexShader[0], NULL, &fragmentShader[0], NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::loadFromFile(const std::string& vertexShaderFilename, const std::string& geometryShaderFilename, const std::string& fragmentShaderFilename)
+{
+    // Read the vertex shader file
+    std::vector<char> vertexShader;
+    if (!getFileContents(vertexShaderFilename, vertexShader))
+    {
+        err() << "Failed to open vertex shader file \"" << vertexShaderFilename << "\"" << std::endl;
+        return false;
+    }
+
+    // Read the geometry shader file
+    std::vector<char> geometryShader;
+    if (!getFileContents(geometryShaderFilename, geometryShader))
+    {
+        err() << "Failed to open geometry shader file \"" << geometryShaderFilename << "\"" << std::endl;
+        return false;
+    }
+
+    // Read the fragment shader file
+    std::vector<char> fragmentShader;
+    if (!getFileContents(fragmentShaderFilename, fragmentShader))
+    {
+        err() << "Failed to open fragment shader file \"" << fragmentShaderFilename << "\"" << std::endl;
+        return false;
+    }
+
+    // Compile the shader program
+    return compile(&vertexShader[0], &geometryShader[0], &fragmentShader[0], NULL);
 }
 
 
@@ -209,10 +752,7 @@ bool Shader::loadFromFile(const std::string& vertexShaderFilename, const std::st
 bool Shader::loadFromMemory(const std::string& shader, Type type)
 {
     // Compile the shader program
-    if (type == Vertex)
-        return compile(shader.c_str(), NULL);
-    else
-        return compile(NULL, shader.c_str());
+    return compile(type, shader.c_str());
 }
 
 
@@ -220,7 +760,15 @@ bool Shader::loadFromMemory(const std::string& shader, Type type)
 bool Shader::loadFromMemory(const std::string& vertexShader, const std::string& fragmentShader)
 {
     // Compile the shader program
-    return compile(vertexShader.c_str(), fragmentShader.c_str());
+    return compile(vertexShader.c_str(), NULL, fragmentShader.c_str(), NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::loadFromMemory(const std::string& vertexShader, const std::string& geometryShader, const std::string& fragmentShader)
+{
+    // Compile the shader program
+    return compile(vertexShader.c_str(), geometryShader.c_str(), fragmentShader.c_str(), NULL);
 }
 
 
@@ -236,10 +784,7 @@ bool Shader::loadFromStream(InputStream& stream, Type type)
     }
 
     // Compile the shader program
-    if (type == Vertex)
-        return compile(&shader[0], NULL);
-    else
-        return compile(NULL, &shader[0]);
+    return compile(type, &shader[0]);
 }
 
 
@@ -263,7 +808,95 @@ bool Shader::loadFromStream(InputStream& vertexShaderStream, InputStream& fragme
     }
 
     // Compile the shader program
-    return compile(&vertexShader[0], &fragmentShader[0]);
+    return compile(&vertexShader[0], NULL, &fragmentShader[0], NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::loadFromStream(InputStream& vertexShaderStream, InputStream& geometryShaderStream, InputStream& fragmentShaderStream)
+{
+    // Read the vertex shader code from the stream
+    std::vector<char> vertexShader;
+    if (!getStreamContents(vertexShaderStream, vertexShader))
+    {
+        err() << "Failed to read vertex shader from stream" << std::endl;
+        return false;
+    }
+
+    // Read the geometry shader code from the stream
+    std::vector<char> geometryShader;
+    if (!getStreamContents(geometryShaderStream, geometryShader))
+    {
+        err() << "Failed to read geometry shader from stream" << std::endl;
+        return false;
+    }
+
+    // Read the fragment shader code from the stream
+    std::vector<char> fragmentShader;
+    if (!getStreamContents(fragmentShaderStream, fragmentShader))
+    {
+        err() << "Failed to read fragment shader from stream" << std::endl;
+        return false;
+    }
+
+    // Compile the shader program
+    return compile(&vertexShader[0], &geometryShader[0], &fragmentShader[0], NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::loadFromFileAsync(const std::string& vertexShaderFilename, const std::string& fragmentShaderFilename)
+{
+    // Read the vertex shader file
+    std::vector<char> vertexShader;
+    if (!getFileContents(vertexShaderFilename, vertexShader))
+    {
+        err() << "Failed to open vertex shader file \"" << vertexShaderFilename << "\"" << std::endl;
+        return false;
+    }
+
+    // Read the fragment shader file
+    std::vector<char> fragmentShader;
+    if (!getFileContents(fragmentShaderFilename, fragmentShader))
+    {
+        err() << "Failed to open fragment shader file \"" << fragmentShaderFilename << "\"" << std::endl;
+        return false;
+    }
+
+    // Start compiling the shader program
+    return compile(&vertexShader[0], NULL, &fragmentShader[0], NULL, true);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::loadFromMemoryAsync(const std::string& vertexShader, const std::string& fragmentShader)
+{
+    // Start compiling the shader program
+    return compile(vertexShader.c_str(), NULL, fragmentShader.c_str(), NULL, true);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isReady() const
+{
+    if (!m_compiler)
+        return true;
+
+    ensureGlContext();
+
+    if (!m_compiler->isFinished())
+        return false;
+
+    // Adopt the compiled program
+    m_shaderProgram = m_compiler->takeProgram();
+    if (m_shaderProgram)
+        m_programSize = recordProgramCreated(castToGlHandle(m_shaderProgram));
+    m_cacheId = getUniqueId();
+    m_samplersDirty = true;
+    delete m_compiler;
+    m_compiler = NULL;
+
+    return true;
 }
 
 
@@ -425,13 +1058,16 @@ void Shader::setParameter(const std::string& name, const Texture& texture)
             {
                 // New entry, make sure there are enough texture units
                 GLint maxUnits = getMaxTextureUnits();
-                if (m_textures.size() + 1 >= static_cast<std::size_t>(maxUnits))
+                if (m_textures.size() + m_textureArrays.size() + 1 >= static_cast<std::size_t>(maxUnits))
                 {
                     err() << "Impossible to use texture \"" << name << "\" for shader: all available texture units are used" << std::endl;
                     return;
                 }
 
                 m_textures[location] = &texture;
+
+                // The units that follow the new entry are shifted
+                m_samplersDirty = true;
             }
             else
             {
@@ -443,6 +1079,44 @@ void Shader::setParameter(const std::string& name, const Texture& texture)
 }
 
 
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, const TextureArray& textureArray)
+{
+    if (m_shaderProgram)
+    {
+        ensureGlContext();
+
+        // Find the location of the variable in the shader
+        int location = getParamLocation(name);
+        if (location != -1)
+        {
+            // Store the location -> texture array mapping
+            TextureArrayTable::iterator it = m_textureArrays.find(location);
+            if (it == m_textureArrays.end())
+            {
+                // New entry, make sure there are enough texture units
+                GLint maxUnits = getMaxTextureUnits();
+                if (m_textures.size() + m_textureArrays.size() + 1 >= static_cast<std::size_t>(maxUnits))
+                {
+                    err() << "Impossible to use texture array \"" << name << "\" for shader: all available texture units are used" << std::endl;
+                    return;
+                }
+
+                m_textureArrays[location] = &textureArray;
+
+                // The units that follow the new entry are shifted
+                m_samplersDirty = true;
+            }
+            else
+            {
+                // Location already used, just replace the texture array
+                it->second = &textureArray;
+            }
+        }
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::setParameter(const std::string& name, CurrentTextureType)
 {
@@ -452,13 +1126,259 @@ void Shader::setParameter(const std::string& name, CurrentTextureType)
 
         // Find the location of the variable in the shader
         m_currentTexture = getParamLocation(name);
+        m_samplersDirty = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::setImage(const std::string& name, const Texture& texture, ImageAccess access)
+{
+    if (!m_shaderProgram)
+        return false;
+
+    if (!isComputeAvailable())
+    {
+        err() << "Failed to set image \"" << name << "\": your system doesn't support images in shaders" << std::endl;
+        return false;
+    }
+
+    if (!getImageFormat(texture.getFormat()))
+    {
+        err() << "Failed to set image \"" << name << "\": the format of the texture can't be used as an image" << std::endl;
+        return false;
+    }
+
+    ensureGlContext();
+
+    // Find the location of the variable in the shader
+    int location = getParamLocation(name);
+    if (location == -1)
+        return false;
+
+    // Store the location -> image mapping
+    ImageUnit image = {&texture, access};
+    ImageTable::iterator it = m_images.find(location);
+    if (it == m_images.end())
+    {
+        // New entry, make sure there are enough image units
+        GLint maxUnits = 0;
+        glCheck(glGetIntegerv(GLEXT_GL_MAX_IMAGE_UNITS, &maxUnits));
+        if (m_images.size() + 1 > static_cast<std::size_t>(maxUnits))
+        {
+            err() << "Impossible to use image \"" << name << "\" for shader: all available image units are used" << std::endl;
+            return false;
+        }
+
+        m_images[location] = image;
+
+        // The units that follow the new entry are shifted
+        m_samplersDirty = true;
+    }
+    else
+    {
+        // Location already used, just replace the image
+        it->second = image;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::UniformHandle Shader::getUniform(const std::string& name)
+{
+    if (!m_shaderProgram)
+        return -1;
+
+    ensureGlContext();
+
+    int location = getParamLocation(name);
+    if (location == -1)
+        return -1;
+
+    // Return the existing handle if the variable already has one
+    for (std::size_t i = 0; i < m_uniforms.size(); ++i)
+    {
+        if (m_uniforms[i].location == location)
+            return static_cast<UniformHandle>(i);
+    }
+
+    Uniform uniform;
+    uniform.location = location;
+    uniform.size = 0;
+    uniform.dirty = false;
+    m_uniforms.push_back(uniform);
+
+    return static_cast<UniformHandle>(m_uniforms.size() - 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, float x)
+{
+    if (float* values = setUniformSize(uniform, 1))
+        values[0] = x;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, float x, float y)
+{
+    if (float* values = setUniformSize(uniform, 2))
+    {
+        values[0] = x;
+        values[1] = y;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, float x, float y, float z)
+{
+    if (float* values = setUniformSize(uniform, 3))
+    {
+        values[0] = x;
+        values[1] = y;
+        values[2] = z;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, float x, float y, float z, float w)
+{
+    if (float* values = setUniformSize(uniform, 4))
+    {
+        values[0] = x;
+        values[1] = y;
+        values[2] = z;
+        values[3] = w;
     }
 }
 
 
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, const Vector2f& v)
+{
+    setUniform(uniform, v.x, v.y);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, const Vector3f& v)
+{
+    setUniform(uniform, v.x, v.y, v.z);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, const Color& color)
+{
+    setUniform(uniform, color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, const sf::Transform& transform)
+{
+    if (float* values = setUniformSize(uniform, 16))
+        std::copy(transform.getMatrix(), transform.getMatrix() + 16, values);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::setUniformBlock(const std::string& name, unsigned int binding)
+{
+    if (!m_shaderProgram)
+        return false;
+
+    if (!GLEXT_uniform_buffer_object)
+    {
+        err() << "Failed to set uniform block \"" << name << "\": your system doesn't support uniform buffers" << std::endl;
+        return false;
+    }
+
+    ensureGlContext();
+
+    // Block bindings are part of the program state: no need to make it current
+    GLuint index = glCheck(GLEXT_glGetUniformBlockIndex(m_shaderProgram, name.c_str()));
+    if (index == GLEXT_GL_INVALID_INDEX)
+    {
+        err() << "Uniform block \"" << name << "\" not found in shader" << std::endl;
+        return false;
+    }
+
+    glCheck(GLEXT_glUniformBlockBinding(m_shaderProgram, index, binding));
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::setStorageBlock(const std::string& name, unsigned int binding)
+{
+    if (!m_shaderProgram)
+        return false;
+
+    if (!isComputeAvailable())
+    {
+        err() << "Failed to set storage block \"" << name << "\": your system doesn't support storage buffers" << std::endl;
+        return false;
+    }
+
+    ensureGlContext();
+
+    // Block bindings are part of the program state: no need to make it current
+    GLuint index = glCheck(GLEXT_glGetProgramResourceIndex(m_shaderProgram, GLEXT_GL_SHADER_STORAGE_BLOCK, name.c_str()));
+    if (index == GLEXT_GL_INVALID_INDEX)
+    {
+        err() << "Storage block \"" << name << "\" not found in shader" << std::endl;
+        return false;
+    }
+
+    glCheck(GLEXT_glShaderStorageBlockBinding(m_shaderProgram, index, binding));
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::dispatch(unsigned int groupsX, unsigned int groupsY, unsigned int groupsZ) const
+{
+    if (!m_shaderProgram)
+        return;
+
+    if (!m_compute)
+    {
+        err() << "Failed to dispatch shader: it is not a compute shader" << std::endl;
+        return;
+    }
+
+    ensureGlContext();
+    restore();
+
+    // Enable the program, upload its variables and bind its textures and images
+    GLEXT_GLhandle program = glCheck(GLEXT_glGetHandle(GLEXT_GL_PROGRAM_OBJECT));
+    glCheck(GLEXT_glUseProgramObject(castToGlHandle(m_shaderProgram)));
+    applyUniforms();
+    bindTextures();
+
+    glCheck(GLEXT_glDispatchCompute(groupsX, groupsY, groupsZ));
+
+    // The writes of the shader must be visible to whatever reads its results next
+    // (vertices, textures, buffers), which can't be known here
+    glCheck(GLEXT_glMemoryBarrier(GLEXT_GL_ALL_BARRIER_BITS));
+
+    // Restore the previous program
+    glCheck(GLEXT_glUseProgramObject(program));
+}
+
+
 ////////////////////////////////////////////////////////////
 unsigned int Shader::getNativeHandle() const
 {
+    restore();
     return m_shaderProgram;
 }
 
@@ -476,41 +1396,79 @@ void Shader::bind(const Shader* shader)
         return;
     }
 
-    if (shader && shader->m_shaderProgram)
+    if (shader && shader->isReady())
+        shader->restore();
+
+    if (shader && shader->isReady() && shader->m_shaderProgram)
     {
         // Enable the program
         glCheck(GLEXT_glUseProgramObject(castToGlHandle(shader->m_shaderProgram)));
 
-        // Bind the textures
-        shader->bindTextures();
+        // Upload the values changed through handles
+        shader->applyUniforms();
+
+        // Bind the textures
+        shader->bindTextures();
+    }
+    else
+    {
+        // Bind no shader
+        glCheck(GLEXT_glUseProgramObject(0));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setBinaryCacheDirectory(const std::string& directory)
+{
+    Lock lock(mutex);
+
+    binaryCacheDirectory = directory;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isAvailable()
+{
+    // TODO: Remove this lock when it becomes unnecessary in C++11
+    Lock lock(mutex);
+
+    static bool available = checkShadersAvailable();
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isGeometryAvailable()
+{
+    // TODO: Remove this lock when it becomes unnecessary in C++11
+    Lock lock(mutex);
+
+    static bool available = isAvailable() && checkGeometryShadersAvailable();
 
-        // Bind the current texture
-        if (shader->m_currentTexture != -1)
-            glCheck(GLEXT_glUniform1i(shader->m_currentTexture, 0));
-    }
-    else
-    {
-        // Bind no shader
-        glCheck(GLEXT_glUseProgramObject(0));
-    }
+    return available;
 }
 
 
 ////////////////////////////////////////////////////////////
-bool Shader::isAvailable()
+bool Shader::isComputeAvailable()
 {
     // TODO: Remove this lock when it becomes unnecessary in C++11
     Lock lock(mutex);
 
-    static bool available = checkShadersAvailable();
+    static bool available = isAvailable() && checkComputeShadersAvailable();
 
     return available;
 }
 
 
 ////////////////////////////////////////////////////////////
-bool Shader::compile(const char* vertexShaderCode, const char* fragmentShaderCode)
+bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode,
+                     const char* computeShaderCode, bool async)
 {
+    SFML_PROFILE_SCOPE("Shader::compile");
+
     ensureGlContext();
 
     // First make sure that we can use shaders
@@ -521,92 +1479,87 @@ bool Shader::compile(const char* vertexShaderCode, const char* fragmentShaderCod
         return false;
     }
 
+    // Make sure that we can use the optional stages
+    if (geometryShaderCode && !isGeometryAvailable())
+    {
+        err() << "Failed to create a shader: your system doesn't support geometry shaders "
+              << "(you should test Shader::isGeometryAvailable() before trying to use geometry shaders)" << std::endl;
+        return false;
+    }
+
+    if (computeShaderCode && !isComputeAvailable())
+    {
+        err() << "Failed to create a shader: your system doesn't support compute shaders "
+              << "(you should test Shader::isComputeAvailable() before trying to use compute shaders)" << std::endl;
+        return false;
+    }
+
+    // Discard the pending compilation
+    delete m_compiler;
+    m_compiler = NULL;
+
     // Destroy the shader if it was already created
     if (m_shaderProgram)
     {
-        glCheck(GLEXT_glDeleteObject(castToGlHandle(m_shaderProgram)));
+        if (m_generation == Context::getGeneration())
+        {
+            glCheck(GLEXT_glDeleteObject(castToGlHandle(m_shaderProgram)));
+        }
+        ResourceMemory::record(ResourceMemory::Shaders, -1, -static_cast<Int64>(m_programSize), 0);
         m_shaderProgram = 0;
+        m_programSize = 0;
     }
 
     // Reset the internal state
     m_currentTexture = -1;
     m_textures.clear();
+    m_textureArrays.clear();
+    m_images.clear();
     m_params.clear();
-
-    // Create the program
-    GLEXT_GLhandle shaderProgram = glCheck(GLEXT_glCreateProgramObject());
-
-    // Create the vertex shader if needed
-    if (vertexShaderCode)
+    m_uniforms.clear();
+    m_uniformsDirty = false;
+    m_samplersDirty = true;
+    m_compute = (computeShaderCode != NULL);
+    m_cacheId = getUniqueId();
+
+    // Use the cached binary of the program if there is one
+    const char* codes[stageCount] = {vertexShaderCode, geometryShaderCode, fragmentShaderCode, computeShaderCode};
+    std::string cachePath = getBinaryCachePath(codes);
+
+    // Keep the sources, to build the program again if the contexts are lost
+    for (int i = 0; i < stageCount; ++i)
+        m_sources[i] = codes[i] ? codes[i] : "";
+    m_generation = Context::getGeneration();
+    if (!cachePath.empty())
     {
-        // Create and compile the shader
-        GLEXT_GLhandle vertexShader = glCheck(GLEXT_glCreateShaderObject(GLEXT_GL_VERTEX_SHADER));
-        glCheck(GLEXT_glShaderSource(vertexShader, 1, &vertexShaderCode, NULL));
-        glCheck(GLEXT_glCompileShader(vertexShader));
-
-        // Check the compile log
-        GLint success;
-        glCheck(GLEXT_glGetObjectParameteriv(vertexShader, GLEXT_GL_OBJECT_COMPILE_STATUS, &success));
-        if (success == GL_FALSE)
+        GLEXT_GLhandle cachedProgram = loadProgramBinary(cachePath);
+        if (cachedProgram)
         {
-            char log[1024];
-            glCheck(GLEXT_glGetInfoLog(vertexShader, sizeof(log), 0, log));
-            err() << "Failed to compile vertex shader:" << std::endl
-                  << log << std::endl;
-            glCheck(GLEXT_glDeleteObject(vertexShader));
-            glCheck(GLEXT_glDeleteObject(shaderProgram));
-            return false;
-        }
-
-        // Attach the shader to the program, and delete it (not needed anymore)
-        glCheck(GLEXT_glAttachObject(shaderProgram, vertexShader));
-        glCheck(GLEXT_glDeleteObject(vertexShader));
-    }
+            m_shaderProgram = castFromGlHandle(cachedProgram);
+            m_programSize = recordProgramCreated(cachedProgram);
 
-    // Create the fragment shader if needed
-    if (fragmentShaderCode)
-    {
-        // Create and compile the shader
-        GLEXT_GLhandle fragmentShader = glCheck(GLEXT_glCreateShaderObject(GLEXT_GL_FRAGMENT_SHADER));
-        glCheck(GLEXT_glShaderSource(fragmentShader, 1, &fragmentShaderCode, NULL));
-        glCheck(GLEXT_glCompileShader(fragmentShader));
+            // Force an OpenGL flush, so that the shader will appear updated
+            // in all contexts immediately (solves problems in multi-threaded apps)
+            glCheck(glFlush());
 
-        // Check the compile log
-        GLint success;
-        glCheck(GLEXT_glGetObjectParameteriv(fragmentShader, GLEXT_GL_OBJECT_COMPILE_STATUS, &success));
-        if (success == GL_FALSE)
-        {
-            char log[1024];
-            glCheck(GLEXT_glGetInfoLog(fragmentShader, sizeof(log), 0, log));
-            err() << "Failed to compile fragment shader:" << std::endl
-                  << log << std::endl;
-            glCheck(GLEXT_glDeleteObject(fragmentShader));
-            glCheck(GLEXT_glDeleteObject(shaderProgram));
-            return false;
+            return true;
         }
-
-        // Attach the shader to the program, and delete it (not needed anymore)
-        glCheck(GLEXT_glAttachObject(shaderProgram, fragmentShader));
-        glCheck(GLEXT_glDeleteObject(fragmentShader));
     }
 
-    // Link the program
-    glCheck(GLEXT_glLinkProgram(shaderProgram));
-
-    // Check the link log
-    GLint success;
-    glCheck(GLEXT_glGetObjectParameteriv(shaderProgram, GLEXT_GL_OBJECT_LINK_STATUS, &success));
-    if (success == GL_FALSE)
+    // Let the compilation run in the background
+    if (async)
     {
-        char log[1024];
-        glCheck(GLEXT_glGetInfoLog(shaderProgram, sizeof(log), 0, log));
-        err() << "Failed to link shader:" << std::endl
-              << log << std::endl;
-        glCheck(GLEXT_glDeleteObject(shaderProgram));
-        return false;
+        m_compiler = new priv::ShaderCompiler(codes, cachePath);
+        return true;
     }
 
+    // Compile and link the program
+    GLEXT_GLhandle shaderProgram = buildProgram(codes, cachePath);
+    if (!shaderProgram)
+        return false;
+
     m_shaderProgram = castFromGlHandle(shaderProgram);
+    m_programSize = recordProgramCreated(shaderProgram);
 
     // Force an OpenGL flush, so that the shader will appear updated
     // in all contexts immediately (solves problems in multi-threaded apps)
@@ -616,21 +1569,158 @@ bool Shader::compile(const char* vertexShaderCode, const char* fragmentShaderCod
 }
 
 
+////////////////////////////////////////////////////////////
+bool Shader::compile(Type type, const char* shaderCode)
+{
+    return compile((type == Vertex)   ? shaderCode : NULL,
+                   (type == Geometry) ? shaderCode : NULL,
+                   (type == Fragment) ? shaderCode : NULL,
+                   (type == Compute)  ? shaderCode : NULL);
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::bindTextures() const
 {
+    // The variables keep their units in the program, they only change when the tables do
+    bool assignUnits = m_samplersDirty;
+    m_samplersDirty = false;
+
+    // The current texture is always on the unit 0
+    if (assignUnits && (m_currentTexture != -1))
+    {
+        glCheck(GLEXT_glUniform1i(m_currentTexture, 0));
+    }
+
     TextureTable::const_iterator it = m_textures.begin();
     for (std::size_t i = 0; i < m_textures.size(); ++i)
     {
         GLint index = static_cast<GLsizei>(i + 1);
-        glCheck(GLEXT_glUniform1i(it->first, index));
-        glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0 + index));
+        if (assignUnits)
+        {
+            glCheck(GLEXT_glUniform1i(it->first, index));
+        }
+        priv::setActiveTextureUnit(static_cast<unsigned int>(index));
         Texture::bind(it->second);
         ++it;
     }
 
+    // Texture arrays use the units that follow the regular textures
+    TextureArrayTable::const_iterator arrayIt = m_textureArrays.begin();
+    for (std::size_t i = 0; i < m_textureArrays.size(); ++i)
+    {
+        GLint index = static_cast<GLsizei>(m_textures.size() + i + 1);
+        if (assignUnits)
+        {
+            glCheck(GLEXT_glUniform1i(arrayIt->first, index));
+        }
+        priv::setActiveTextureUnit(static_cast<unsigned int>(index));
+        TextureArray::bind(arrayIt->second);
+        ++arrayIt;
+    }
+
     // Make sure that the texture unit which is left active is the number 0
-    glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0));
+    priv::setActiveTextureUnit(0);
+
+    // Images have their own units, numbered from 0
+    GLuint imageUnit = 0;
+    for (ImageTable::const_iterator it = m_images.begin(); it != m_images.end(); ++it, ++imageUnit)
+    {
+        if (assignUnits)
+        {
+            glCheck(GLEXT_glUniform1i(it->first, static_cast<GLint>(imageUnit)));
+        }
+        glCheck(GLEXT_glBindImageTexture(imageUnit, it->second.texture->getNativeHandle(), 0, GL_FALSE, 0,
+                                         imageAccessToGlEnum(it->second.access), getImageFormat(it->second.texture->getFormat())));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::applyUniforms() const
+{
+    if (!m_uniformsDirty)
+        return;
+
+    for (UniformTable::iterator it = m_uniforms.begin(); it != m_uniforms.end(); ++it)
+    {
+        if (!it->dirty)
+            continue;
+
+        switch (it->size)
+        {
+            case 1:  glCheck(GLEXT_glUniform1f(it->location, it->values[0])); break;
+            case 2:  glCheck(GLEXT_glUniform2f(it->location, it->values[0], it->values[1])); break;
+            case 3:  glCheck(GLEXT_glUniform3f(it->location, it->values[0], it->values[1], it->values[2])); break;
+            case 4:  glCheck(GLEXT_glUniform4f(it->location, it->values[0], it->values[1], it->values[2], it->values[3])); break;
+            default: glCheck(GLEXT_glUniformMatrix4fv(it->location, 1, GL_FALSE, it->values)); break;
+        }
+
+        it->dirty = false;
+    }
+
+    m_uniformsDirty = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::restore() const
+{
+    if (m_generation == Context::getGeneration())
+        return;
+
+    m_generation = Context::getGeneration();
+    if (!m_shaderProgram)
+        return;
+
+    ensureGlContext();
+
+    // The old program was lost with its context, it must not be deleted
+    ResourceMemory::record(ResourceMemory::Shaders, -1, -static_cast<Int64>(m_programSize), 0);
+    m_shaderProgram = 0;
+    m_programSize = 0;
+
+    const char* codes[stageCount];
+    for (int i = 0; i < stageCount; ++i)
+        codes[i] = m_sources[i].empty() ? NULL : m_sources[i].c_str();
+
+    // The binary cache makes the rebuild almost free when it is enabled
+    std::string cachePath = getBinaryCachePath(codes);
+    GLEXT_GLhandle program = cachePath.empty() ? 0 : loadProgramBinary(cachePath);
+    if (!program)
+        program = buildProgram(codes, cachePath);
+    if (!program)
+        return;
+
+    m_shaderProgram = castFromGlHandle(program);
+    m_programSize = recordProgramCreated(program);
+    m_cacheId = getUniqueId();
+
+    // The values of the variables were lost with the program
+    m_samplersDirty = true;
+    for (UniformTable::iterator it = m_uniforms.begin(); it != m_uniforms.end(); ++it)
+    {
+        if (it->size > 0)
+        {
+            it->dirty = true;
+            m_uniformsDirty = true;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+float* Shader::setUniformSize(UniformHandle uniform, unsigned int size)
+{
+    if ((uniform < 0) || (static_cast<std::size_t>(uniform) >= m_uniforms.size()))
+        return NULL;
+
+    Uniform& entry = m_uniforms[uniform];
+    entry.size = size;
+    entry.dirty = true;
+    m_uniformsDirty = true;
+
+    return entry.values;
 }
 
 
@@ -672,7 +1762,14 @@ Shader::CurrentTextureType Shader::CurrentTexture;
 ////////////////////////////////////////////////////////////
 Shader::Shader() :
 m_shaderProgram (0),
-m_currentTexture(-1)
+m_programSize   (0),
+m_cacheId       (0),
+m_currentTexture(-1),
+m_uniformsDirty (false),
+m_samplersDirty (false),
+m_compute       (false),
+m_compiler      (NULL),
+m_generation    (0)
 {
 }
 
@@ -697,6 +1794,13 @@ bool Shader::loadFromFile(const std::string& vertexShaderFilename, const std::st
 }
 
 
+////////////////////////////////////////////////////////////
+bool Shader::loadFromFile(const std::string& vertexShaderFilename, const std::string& geometryShaderFilename, const std::string& fragmentShaderFilename)
+{
+    return false;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Shader::loadFromMemory(const std::string& shader, Type type)
 {
@@ -711,6 +1815,13 @@ bool Shader::loadFromMemory(const std::string& vertexShader, const std::string&
 }
 
 
+////////////////////////////////////////////////////////////
+bool Shader::loadFromMemory(const std::string& vertexShader, const std::string& geometryShader, const std::string& fragmentShader)
+{
+    return false;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Shader::loadFromStream(InputStream& stream, Type type)
 {
@@ -725,6 +1836,34 @@ bool Shader::loadFromStream(InputStream& vertexShaderStream, InputStream& fragme
 }
 
 
+////////////////////////////////////////////////////////////
+bool Shader::loadFromStream(InputStream& vertexShaderStream, InputStream& geometryShaderStream, InputStream& fragmentShaderStream)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::loadFromFileAsync(const std::string& vertexShaderFilename, const std::string& fragmentShaderFilename)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::loadFromMemoryAsync(const std::string& vertexShader, const std::string& fragmentShader)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isReady() const
+{
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::setParameter(const std::string& name, float x)
 {
@@ -779,12 +1918,100 @@ void Shader::setParameter(const std::string& name, const Texture& texture)
 }
 
 
+////////////////////////////////////////////////////////////
+void Shader::setParameter(const std::string& name, const TextureArray& textureArray)
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::setParameter(const std::string& name, CurrentTextureType)
 {
 }
 
 
+////////////////////////////////////////////////////////////
+bool Shader::setImage(const std::string& name, const Texture& texture, ImageAccess access)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::UniformHandle Shader::getUniform(const std::string& name)
+{
+    return -1;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, float x)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, float x, float y)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, float x, float y, float z)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, float x, float y, float z, float w)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, const Vector2f& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, const Vector3f& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, const Color& color)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle uniform, const sf::Transform& transform)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::setUniformBlock(const std::string& name, unsigned int binding)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::setStorageBlock(const std::string& name, unsigned int binding)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::dispatch(unsigned int groupsX, unsigned int groupsY, unsigned int groupsZ) const
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 unsigned int Shader::getNativeHandle() const
 {
@@ -798,6 +2025,12 @@ void Shader::bind(const Shader* shader)
 }
 
 
+////////////////////////////////////////////////////////////
+void Shader::setBinaryCacheDirectory(const std::string& directory)
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Shader::isAvailable()
 {
@@ -806,7 +2039,29 @@ bool Shader::isAvailable()
 
 
 ////////////////////////////////////////////////////////////
-bool Shader::compile(const char* vertexShaderCode, const char* fragmentShaderCode)
+bool Shader::isGeometryAvailable()
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::isComputeAvailable()
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode,
+                     const char* computeShaderCode, bool async)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Shader::compile(Type type, const char* shaderCode)
 {
     return false;
 }
@@ -817,6 +2072,25 @@ void Shader::bindTextures() const
 {
 }
 
+
+////////////////////////////////////////////////////////////
+void Shader::applyUniforms() const
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::restore() const
+{
+}
+
+
+////////////////////////////////////////////////////////////
+float* Shader::setUniformSize(UniformHandle uniform, unsigned int size)
+{
+    return NULL;
+}
+
 } // namespace sf
 
 #endif // SFML_OPENGL_ES
@@ -131,7 +131,10 @@ const Color& Shape::getOutlineColor() const
 void Shape::setOutlineThickness(float thickness)
 {
     m_outlineThickness = thickness;
-    update(); // recompute everything because the whole shape must be offset
+
+    // The extrusion directions don't depend on the thickness, only the outline points move
+    if (m_vertices.getVertexCount() > 0)
+        updateOutline();
 }
 
 
@@ -165,6 +168,7 @@ m_outlineColor    (255, 255, 255),
 m_outlineThickness(0),
 m_vertices        (TrianglesFan),
 m_outlineVertices (TrianglesStrip),
+m_outlineNormals  (),
 m_insideBounds    (),
 m_bounds          ()
 {
@@ -180,6 +184,7 @@ void Shape::update()
     {
         m_vertices.resize(0);
         m_outlineVertices.resize(0);
+        m_outlineNormals.clear();
         return;
     }
 
@@ -190,13 +195,13 @@ void Shape::update()
         m_vertices[i + 1].position = getPoint(i);
     m_vertices[count + 1].position = m_vertices[1].position;
 
-    // Update the bounding rectangle
-    m_vertices[0] = m_vertices[1]; // so that the result of getBounds() is correct
-    m_insideBounds = m_vertices.getBounds();
+    // Bounds and center
+    updateCenter();
 
-    // Compute the center and make it the first vertex
-    m_vertices[0].position.x = m_insideBounds.left + m_insideBounds.width / 2;
-    m_vertices[0].position.y = m_insideBounds.top + m_insideBounds.height / 2;
+    // Extrusion directions of the outline
+    m_outlineNormals.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
+        updateOutlineNormal(i);
 
     // Color
     updateFillColors();
@@ -209,6 +214,89 @@ void Shape::update()
 }
 
 
+////////////////////////////////////////////////////////////
+void Shape::update(const Geometry& geometry)
+{
+    std::size_t count = geometry.normals.size();
+    if ((count < 3) || (geometry.points.size() != count + 2))
+    {
+        m_vertices.resize(0);
+        m_outlineVertices.resize(0);
+        m_outlineNormals.clear();
+        return;
+    }
+
+    // Copy the precomputed geometry
+    m_vertices.resize(count + 2);
+    for (std::size_t i = 0; i < count + 2; ++i)
+        m_vertices[i].position = geometry.points[i];
+    m_outlineNormals = geometry.normals;
+    m_insideBounds = geometry.bounds;
+
+    // Update the attributes which belong to this shape
+    updateFillColors();
+    updateTexCoords();
+    updateOutline();
+}
+
+
+////////////////////////////////////////////////////////////
+void Shape::getGeometry(Geometry& geometry) const
+{
+    geometry.points.resize(m_vertices.getVertexCount());
+    for (std::size_t i = 0; i < geometry.points.size(); ++i)
+        geometry.points[i] = m_vertices[i].position;
+    geometry.normals = m_outlineNormals;
+    geometry.bounds = m_insideBounds;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shape::updatePoint(std::size_t index)
+{
+    // Simple edits only: anything else goes through a full update
+    std::size_t count = getPointCount();
+    if ((count < 3) || (m_vertices.getVertexCount() != count + 2) || (index >= count))
+    {
+        update();
+        return;
+    }
+
+    // Position
+    m_vertices[index + 1].position = getPoint(index);
+    if (index == 0)
+        m_vertices[count + 1].position = m_vertices[1].position;
+
+    // The texture coordinates, the center and thus the orientation of all the
+    // normals depend on the bounding rectangle: if it changed, everything is affected
+    FloatRect previousBounds = m_insideBounds;
+    updateCenter();
+    if (m_insideBounds != previousBounds)
+    {
+        update();
+        return;
+    }
+
+    // Texture coordinates of the moved point
+    updateTexCoords(index + 1);
+    if (index == 0)
+        updateTexCoords(count + 1);
+
+    // Only the outline of the point and of its two neighbours changes
+    std::size_t previous = (index + count - 1) % count;
+    std::size_t next = (index + 1) % count;
+    updateOutlineNormal(previous);
+    updateOutlineNormal(index);
+    updateOutlineNormal(next);
+    updateOutlinePoint(previous);
+    updateOutlinePoint(index);
+    updateOutlinePoint(next);
+
+    // Update the shape's bounds
+    m_bounds = m_outlineVertices.getBounds();
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shape::draw(RenderTarget& target, RenderStates states) const
 {
@@ -239,12 +327,57 @@ void Shape::updateFillColors()
 void Shape::updateTexCoords()
 {
     for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i)
-    {
-        float xratio = m_insideBounds.width > 0 ? (m_vertices[i].position.x - m_insideBounds.left) / m_insideBounds.width : 0;
-        float yratio = m_insideBounds.height > 0 ? (m_vertices[i].position.y - m_insideBounds.top) / m_insideBounds.height : 0;
-        m_vertices[i].texCoords.x = m_textureRect.left + m_textureRect.width * xratio;
-        m_vertices[i].texCoords.y = m_textureRect.top + m_textureRect.height * yratio;
-    }
+        updateTexCoords(i);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shape::updateTexCoords(std::size_t index)
+{
+    float xratio = m_insideBounds.width > 0 ? (m_vertices[index].position.x - m_insideBounds.left) / m_insideBounds.width : 0;
+    float yratio = m_insideBounds.height > 0 ? (m_vertices[index].position.y - m_insideBounds.top) / m_insideBounds.height : 0;
+    m_vertices[index].texCoords.x = m_textureRect.left + m_textureRect.width * xratio;
+    m_vertices[index].texCoords.y = m_textureRect.top + m_textureRect.height * yratio;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shape::updateCenter()
+{
+    // Update the bounding rectangle
+    m_vertices[0].position = m_vertices[1].position; // so that the result of getBounds() is correct
+    m_insideBounds = m_vertices.getBounds();
+
+    // Compute the center and make it the first vertex
+    m_vertices[0].position.x = m_insideBounds.left + m_insideBounds.width / 2;
+    m_vertices[0].position.y = m_insideBounds.top + m_insideBounds.height / 2;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shape::updateOutlineNormal(std::size_t index)
+{
+    std::size_t count = m_vertices.getVertexCount() - 2;
+
+    // Get the two segments shared by the point
+    Vector2f p0 = (index == 0) ? m_vertices[count].position : m_vertices[index].position;
+    Vector2f p1 = m_vertices[index + 1].position;
+    Vector2f p2 = m_vertices[index + 2].position;
+
+    // Compute their normal
+    Vector2f n1 = computeNormal(p0, p1);
+    Vector2f n2 = computeNormal(p1, p2);
+
+    // Make sure that the normals point towards the outside of the shape
+    // (this depends on the order in which the points were defined)
+    if (dotProduct(n1, m_vertices[0].position - p1) > 0)
+        n1 = -n1;
+    if (dotProduct(n2, m_vertices[0].position - p1) > 0)
+        n2 = -n2;
+
+    // Combine them to get the extrusion direction
+    float factor = 1.f + (n1.x * n2.x + n1.y * n2.y);
+    m_outlineNormals[index] = (n1 + n2) / factor;
 }
 
 
@@ -256,31 +389,8 @@ void Shape::updateOutline()
 
     for (std::size_t i = 0; i < count; ++i)
     {
-        std::size_t index = i + 1;
-
-        // Get the two segments shared by the current point
-        Vector2f p0 = (i == 0) ? m_vertices[count].position : m_vertices[index - 1].position;
-        Vector2f p1 = m_vertices[index].position;
-        Vector2f p2 = m_vertices[index + 1].position;
-
-        // Compute their normal
-        Vector2f n1 = computeNormal(p0, p1);
-        Vector2f n2 = computeNormal(p1, p2);
-
-        // Make sure that the normals point towards the outside of the shape
-        // (this depends on the order in which the points were defined)
-        if (dotProduct(n1, m_vertices[0].position - p1) > 0)
-            n1 = -n1;
-        if (dotProduct(n2, m_vertices[0].position - p1) > 0)
-            n2 = -n2;
-
-        // Combine them to get the extrusion direction
-        float factor = 1.f + (n1.x * n2.x + n1.y * n2.y);
-        Vector2f normal = (n1 + n2) / factor;
-
-        // Update the outline points
-        m_outlineVertices[i * 2 + 0].position = p1;
-        m_outlineVertices[i * 2 + 1].position = p1 + normal * m_outlineThickness;
+        m_outlineVertices[i * 2 + 0].position = m_vertices[i + 1].position;
+        m_outlineVertices[i * 2 + 1].position = m_vertices[i + 1].position + m_outlineNormals[i] * m_outlineThickness;
     }
 
     // Duplicate the first point at the end, to close the outline
@@ -295,6 +405,23 @@ void Shape::updateOutline()
 }
 
 
+////////////////////////////////////////////////////////////
+void Shape::updateOutlinePoint(std::size_t index)
+{
+    std::size_t count = m_vertices.getVertexCount() - 2;
+
+    m_outlineVertices[index * 2 + 0].position = m_vertices[index + 1].position;
+    m_outlineVertices[index * 2 + 1].position = m_vertices[index + 1].position + m_outlineNormals[index] * m_outlineThickness;
+
+    // Keep the outline closed
+    if (index == 0)
+    {
+        m_outlineVertices[count * 2 + 0].position = m_outlineVertices[0].position;
+        m_outlineVertices[count * 2 + 1].position = m_outlineVertices[1].position;
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shape::updateOutlineColors()
 {
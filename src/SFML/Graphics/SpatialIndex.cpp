@@ -0,0 +1,359 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SpatialIndex.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <SFML/Config.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Items covering more cells are stored in a separate list, rather than in every cell
+    const sf::Int64 maxCellsPerItem = 16;
+
+    // Number of buckets of a new index; it grows with the number of items
+    const std::size_t initialBucketCount = 64;
+
+    // Convert a coordinate to a cell index, with a range that can't overflow
+    int toCell(float coordinate, float cellSize)
+    {
+        float cell = std::floor(coordinate / cellSize);
+        const float limit = 1 << 30;
+
+        if (!(cell > -limit)) // also catches NaN
+            return -(1 << 30);
+        if (cell > limit)
+            return 1 << 30;
+
+        return static_cast<int>(cell);
+    }
+
+    // Check whether two rectangles overlap; unlike FloatRect::intersects, rectangles that
+    // only touch each other overlap, so that empty rectangles and points can be found
+    bool overlaps(const sf::FloatRect& first, const sf::FloatRect& second)
+    {
+        return (first.left <= second.left + second.width) && (first.left + first.width >= second.left) &&
+               (first.top <= second.top + second.height) && (first.top + first.height >= second.top);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SpatialIndex::SpatialIndex(float cellSize) :
+m_cellSize (cellSize > 0 ? cellSize : 128.f),
+m_items    (),
+m_freeIds  (),
+m_buckets  (initialBucketCount),
+m_oversized(),
+m_stamp    (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SpatialIndex::Id SpatialIndex::insert(const FloatRect& bounds, void* data)
+{
+    Id id;
+    if (!m_freeIds.empty())
+    {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+    }
+    else
+    {
+        id = m_items.size();
+        m_items.push_back(Item());
+        m_items[id].stamp = 0;
+    }
+
+    Item& item = m_items[id];
+    item.bounds = bounds;
+    item.data = data;
+    item.used = true;
+    link(id);
+
+    // Keep the buckets short, so that the queries don't test items of other cells
+    if (getItemCount() > m_buckets.size() * 2)
+        rebuild(m_buckets.size() * 4);
+
+    return id;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::update(Id id, const FloatRect& bounds)
+{
+    Item& item = m_items[id];
+
+    // Most moves are small enough for the item to stay in the same cells
+    CellRange cells = getCells(bounds);
+    if ((cells.left == item.cells.left) && (cells.top == item.cells.top) &&
+        (cells.right == item.cells.right) && (cells.bottom == item.cells.bottom))
+    {
+        item.bounds = bounds;
+        return;
+    }
+
+    unlink(id);
+    item.bounds = bounds;
+    link(id);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::remove(Id id)
+{
+    unlink(id);
+
+    Item& item = m_items[id];
+    item.data = NULL;
+    item.used = false;
+    m_freeIds.push_back(id);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::clear()
+{
+    m_items.clear();
+    m_freeIds.clear();
+    m_buckets.assign(initialBucketCount, std::vector<Id>());
+    m_oversized.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpatialIndex::getItemCount() const
+{
+    return m_items.size() - m_freeIds.size();
+}
+
+
+////////////////////////////////////////////////////////////
+const FloatRect& SpatialIndex::getBounds(Id id) const
+{
+    return m_items[id].bounds;
+}
+
+
+////////////////////////////////////////////////////////////
+void* SpatialIndex::getData(Id id) const
+{
+    return m_items[id].data;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpatialIndex::query(const FloatRect& area, std::vector<Id>& result) const
+{
+    result.clear();
+    ++m_stamp;
+
+    CellRange cells = getCells(area);
+    Int64 cellCount = (static_cast<Int64>(cells.right) - cells.left + 1) * (static_cast<Int64>(cells.bottom) - cells.top + 1);
+
+    if (cellCount > static_cast<Int64>(getItemCount()))
+    {
+        // The area covers more cells than there are items, testing them all is faster
+        for (Id id = 0; id < m_items.size(); ++id)
+        {
+            if (m_items[id].used && overlaps(m_items[id].bounds, area))
+                result.push_back(id);
+        }
+
+        return result.size();
+    }
+
+    for (int y = cells.top; y <= cells.bottom; ++y)
+    {
+        for (int x = cells.left; x <= cells.right; ++x)
+        {
+            // A bucket may contain items of other cells, and an item may be in several of the cells
+            const std::vector<Id>& bucket = m_buckets[getBucket(x, y)];
+            for (std::vector<Id>::const_iterator it = bucket.begin(); it != bucket.end(); ++it)
+            {
+                const Item& item = m_items[*it];
+                if ((item.stamp != m_stamp) && overlaps(item.bounds, area))
+                {
+                    item.stamp = m_stamp;
+                    result.push_back(*it);
+                }
+            }
+        }
+    }
+
+    for (std::vector<Id>::const_iterator it = m_oversized.begin(); it != m_oversized.end(); ++it)
+    {
+        if (overlaps(m_items[*it].bounds, area))
+            result.push_back(*it);
+    }
+
+    std::sort(result.begin(), result.end());
+
+    return result.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpatialIndex::query(const View& view, std::vector<Id>& result) const
+{
+    // The visible area is the [-1, 1] clip space cube, brought back to world coordinates
+    return query(view.getInverseTransform().transformRect(FloatRect(-1.f, -1.f, 2.f, 2.f)), result);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpatialIndex::query(const Vector2f& point, std::vector<Id>& result) const
+{
+    return query(FloatRect(point.x, point.y, 0.f, 0.f), result);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::optimize()
+{
+    std::vector<float> sizes;
+    sizes.reserve(getItemCount());
+    for (std::vector<Item>::const_iterator it = m_items.begin(); it != m_items.end(); ++it)
+    {
+        if (it->used)
+            sizes.push_back(std::max(it->bounds.width, it->bounds.height));
+    }
+
+    if (!sizes.empty())
+    {
+        std::nth_element(sizes.begin(), sizes.begin() + sizes.size() / 2, sizes.end());
+        float median = sizes[sizes.size() / 2];
+        if (median > 0)
+            m_cellSize = median * 2;
+    }
+
+    std::size_t bucketCount = initialBucketCount;
+    while (bucketCount < getItemCount())
+        bucketCount *= 2;
+
+    rebuild(bucketCount);
+}
+
+
+////////////////////////////////////////////////////////////
+float SpatialIndex::getCellSize() const
+{
+    return m_cellSize;
+}
+
+
+////////////////////////////////////////////////////////////
+SpatialIndex::CellRange SpatialIndex::getCells(const FloatRect& bounds) const
+{
+    CellRange cells;
+    cells.left   = toCell(bounds.left, m_cellSize);
+    cells.top    = toCell(bounds.top, m_cellSize);
+    cells.right  = std::max(cells.left, toCell(bounds.left + bounds.width, m_cellSize));
+    cells.bottom = std::max(cells.top, toCell(bounds.top + bounds.height, m_cellSize));
+
+    return cells;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpatialIndex::getBucket(int x, int y) const
+{
+    // The number of buckets is a power of two
+    Uint32 hash = (static_cast<Uint32>(x) * 73856093u) ^ (static_cast<Uint32>(y) * 19349663u);
+    return hash & (m_buckets.size() - 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::link(Id id)
+{
+    Item& item = m_items[id];
+    item.cells = getCells(item.bounds);
+
+    const CellRange& cells = item.cells;
+    Int64 cellCount = (static_cast<Int64>(cells.right) - cells.left + 1) * (static_cast<Int64>(cells.bottom) - cells.top + 1);
+    item.oversized = cellCount > maxCellsPerItem;
+
+    if (item.oversized)
+    {
+        m_oversized.push_back(id);
+        return;
+    }
+
+    for (int y = cells.top; y <= cells.bottom; ++y)
+        for (int x = cells.left; x <= cells.right; ++x)
+            m_buckets[getBucket(x, y)].push_back(id);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::unlink(Id id)
+{
+    const Item& item = m_items[id];
+
+    if (item.oversized)
+    {
+        std::vector<Id>::iterator it = std::find(m_oversized.begin(), m_oversized.end(), id);
+        *it = m_oversized.back();
+        m_oversized.pop_back();
+        return;
+    }
+
+    // The order of the items in a bucket doesn't matter, the removed one can be replaced by the last one
+    const CellRange& cells = item.cells;
+    for (int y = cells.top; y <= cells.bottom; ++y)
+    {
+        for (int x = cells.left; x <= cells.right; ++x)
+        {
+            std::vector<Id>& bucket = m_buckets[getBucket(x, y)];
+            std::vector<Id>::iterator it = std::find(bucket.begin(), bucket.end(), id);
+            *it = bucket.back();
+            bucket.pop_back();
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::rebuild(std::size_t bucketCount)
+{
+    m_buckets.assign(bucketCount, std::vector<Id>());
+    m_oversized.clear();
+
+    for (Id id = 0; id < m_items.size(); ++id)
+    {
+        if (m_items[id].used)
+            link(id);
+    }
+}
+
+} // namespace sf
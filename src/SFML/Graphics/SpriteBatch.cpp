@@ -0,0 +1,288 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SpriteBatch.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/TrimmedSprite.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+
+namespace
+{
+    // 16-bit indices can address this many vertices in a single draw call
+    const std::size_t maxVerticesPerDraw = 65536;
+
+    // Orders of the sort modes; std::stable_sort keeps the order of the items that compare equal
+    template <typename Item>
+    struct CompareTexture
+    {
+        bool operator ()(const Item& left, const Item& right) const
+        {
+            return std::less<const sf::Texture*>()(left.texture, right.texture);
+        }
+    };
+
+    template <typename Item>
+    struct CompareBackToFront
+    {
+        bool operator ()(const Item& left, const Item& right) const
+        {
+            return left.depth > right.depth;
+        }
+    };
+
+    template <typename Item>
+    struct CompareFrontToBack
+    {
+        bool operator ()(const Item& left, const Item& right) const
+        {
+            return left.depth < right.depth;
+        }
+    };
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SpriteBatch::SpriteBatch() :
+m_target       (NULL),
+m_sortMode     (Deferred),
+m_states       (),
+m_items        (),
+m_vertices     (),
+m_sorted       (),
+m_indices      (),
+m_drawCallCount(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::begin(RenderTarget& target, SortMode sortMode, const RenderStates& states)
+{
+    if (m_target)
+    {
+        err() << "SpriteBatch::begin called twice without end, the pending quads are drawn first" << std::endl;
+        end();
+    }
+
+    m_target = &target;
+    m_sortMode = sortMode;
+    m_states = states;
+    m_items.clear();
+    m_vertices.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::draw(const Sprite& sprite, float depth)
+{
+    if (sprite.getTexture())
+        draw(*sprite.getTexture(), sprite.getTextureRect(), sprite.getTransform(), sprite.getColor(), depth);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::draw(const Texture& texture, const IntRect& rectangle, const Transform& transform,
+                       const Color& color, float depth)
+{
+    if (!addItem(texture, depth, 4))
+        return;
+
+    // Same corners and texture coordinates as sf::Sprite, transformed now, in the order of a triangle fan
+    float width  = static_cast<float>(std::abs(rectangle.width));
+    float height = static_cast<float>(std::abs(rectangle.height));
+    float left   = static_cast<float>(rectangle.left);
+    float right  = left + rectangle.width;
+    float top    = static_cast<float>(rectangle.top);
+    float bottom = top + rectangle.height;
+
+    m_vertices.push_back(Vertex(transform.transformPoint(0, 0), color, Vector2f(left, top)));
+    m_vertices.push_back(Vertex(transform.transformPoint(0, height), color, Vector2f(left, bottom)));
+    m_vertices.push_back(Vertex(transform.transformPoint(width, height), color, Vector2f(right, bottom)));
+    m_vertices.push_back(Vertex(transform.transformPoint(width, 0), color, Vector2f(right, top)));
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::draw(const TrimmedSprite& sprite, float depth)
+{
+    if (sprite.getTexture())
+        draw(*sprite.getTexture(), sprite.getTextureRect(), sprite.getMesh(), sprite.getTransform(), sprite.getColor(), depth);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::draw(const Texture& texture, const IntRect& rectangle, const SpriteMesh& mesh, const Transform& transform,
+                       const Color& color, float depth)
+{
+    if (mesh.getPointCount() < 3)
+        return;
+
+    if (mesh.getPointCount() > maxVerticesPerDraw)
+    {
+        err() << "SpriteBatch::draw called with a mesh of more than " << maxVerticesPerDraw << " points, polygon ignored" << std::endl;
+        return;
+    }
+
+    if (!addItem(texture, depth, mesh.getPointCount()))
+        return;
+
+    // Same positions and texture coordinates as sf::TrimmedSprite, transformed now
+    float width  = static_cast<float>(std::abs(rectangle.width));
+    float height = static_cast<float>(std::abs(rectangle.height));
+    float left   = static_cast<float>(std::min(rectangle.left, rectangle.left + rectangle.width));
+    float top    = static_cast<float>(std::min(rectangle.top, rectangle.top + rectangle.height));
+
+    for (std::size_t i = 0; i < mesh.getPointCount(); ++i)
+    {
+        Vector2f point = mesh.getPoint(i);
+        Vector2f position((rectangle.width < 0) ? width - point.x : point.x, (rectangle.height < 0) ? height - point.y : point.y);
+        m_vertices.push_back(Vertex(transform.transformPoint(position), color, Vector2f(left + point.x, top + point.y)));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::end()
+{
+    if (!m_target)
+    {
+        err() << "SpriteBatch::end called without begin" << std::endl;
+        return;
+    }
+
+    m_drawCallCount = 0;
+
+    // Put the vertices in the order of the sorted items
+    const Vertex* vertices = m_vertices.empty() ? NULL : &m_vertices[0];
+    if ((m_sortMode != Deferred) && (m_items.size() > 1))
+    {
+        switch (m_sortMode)
+        {
+            case ByTexture:   std::stable_sort(m_items.begin(), m_items.end(), CompareTexture<Item>()); break;
+            case BackToFront: std::stable_sort(m_items.begin(), m_items.end(), CompareBackToFront<Item>()); break;
+            case FrontToBack: std::stable_sort(m_items.begin(), m_items.end(), CompareFrontToBack<Item>()); break;
+            default:          break;
+        }
+
+        m_sorted.resize(m_vertices.size());
+        std::size_t sortedVertex = 0;
+        for (std::size_t i = 0; i < m_items.size(); ++i)
+        {
+            const Vertex* first = &m_vertices[m_items[i].firstVertex];
+            std::copy(first, first + m_items[i].vertexCount, &m_sorted[sortedVertex]);
+            m_items[i].firstVertex = sortedVertex;
+            sortedVertex += m_items[i].vertexCount;
+        }
+
+        vertices = &m_sorted[0];
+    }
+
+    // Draw each run of items that use the same texture at once; the
+    // vertices of the items are contiguous, in the order of the items
+    std::size_t first = 0;
+    m_indices.clear();
+    for (std::size_t i = 0; i < m_items.size(); ++i)
+    {
+        const Item& item = m_items[i];
+        std::size_t runVertex = m_items[first].firstVertex;
+        if ((item.texture != m_items[first].texture) || (item.firstVertex + item.vertexCount - runVertex > maxVerticesPerDraw))
+        {
+            drawRun(vertices + runVertex, item.firstVertex - runVertex, m_items[first].texture);
+            first = i;
+            runVertex = item.firstVertex;
+        }
+
+        // Triangle fan of the item, relative to the first vertex of the run
+        Uint16 center = static_cast<Uint16>(item.firstVertex - runVertex);
+        for (std::size_t j = 2; j < item.vertexCount; ++j)
+        {
+            m_indices.push_back(center);
+            m_indices.push_back(static_cast<Uint16>(center + j - 1));
+            m_indices.push_back(static_cast<Uint16>(center + j));
+        }
+    }
+
+    if (!m_items.empty())
+    {
+        std::size_t runVertex = m_items[first].firstVertex;
+        drawRun(vertices + runVertex, m_vertices.size() - runVertex, m_items[first].texture);
+    }
+
+    m_target = NULL;
+    m_items.clear();
+    m_vertices.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteBatch::getDrawCallCount() const
+{
+    return m_drawCallCount;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SpriteBatch::addItem(const Texture& texture, float depth, std::size_t vertexCount)
+{
+    if (!m_target)
+    {
+        err() << "SpriteBatch::draw called outside begin/end, sprite ignored" << std::endl;
+        return false;
+    }
+
+    Item item;
+    item.texture = &texture;
+    item.depth = depth;
+    item.firstVertex = m_vertices.size();
+    item.vertexCount = vertexCount;
+    m_items.push_back(item);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::drawRun(const Vertex* vertices, std::size_t vertexCount, const Texture* texture)
+{
+    if (!m_indices.empty())
+    {
+        RenderStates states = m_states;
+        states.texture = texture;
+        m_target->draw(vertices, vertexCount, &m_indices[0], m_indices.size(), Triangles, states);
+        ++m_drawCallCount;
+    }
+
+    m_indices.clear();
+}
+
+} // namespace sf
@@ -0,0 +1,265 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SpriteMesh.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Points are computed in double precision, the extended edges meet at fractional positions
+    struct Point
+    {
+        Point(double px = 0, double py = 0) : x(px), y(py) {}
+
+        bool operator <(const Point& other) const
+        {
+            return (x < other.x) || ((x == other.x) && (y < other.y));
+        }
+
+        double x;
+        double y;
+    };
+
+    double cross(const Point& o, const Point& a, const Point& b)
+    {
+        return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Convex hull of a set of points (monotone chain), without collinear points
+    ////////////////////////////////////////////////////////////
+    std::vector<Point> convexHull(std::vector<Point> points)
+    {
+        std::sort(points.begin(), points.end());
+
+        std::vector<Point> hull(points.size() * 2);
+        std::size_t count = 0;
+
+        // Lower hull, then upper hull
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            while ((count >= 2) && (cross(hull[count - 2], hull[count - 1], points[i]) <= 0))
+                --count;
+            hull[count++] = points[i];
+        }
+        for (std::size_t i = points.size() - 1, lower = count + 1; i > 0; --i)
+        {
+            while ((count >= lower) && (cross(hull[count - 2], hull[count - 1], points[i - 1]) <= 0))
+                --count;
+            hull[count++] = points[i - 1];
+        }
+
+        // The last point is the first one again
+        hull.resize(count > 1 ? count - 1 : count);
+        return hull;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Remove the edge of a convex polygon which adds the least
+    // area when its two neighbouring edges are extended until
+    // they meet, as long as they meet inside the bounds
+    ////////////////////////////////////////////////////////////
+    bool removeCheapestEdge(std::vector<Point>& polygon, double width, double height)
+    {
+        const double epsilon = 1e-9;
+        const std::size_t count = polygon.size();
+
+        std::size_t best = count;
+        double bestCost = 0;
+        Point bestPoint;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const Point& previous = polygon[(i + count - 1) % count];
+            const Point& first    = polygon[i];
+            const Point& second   = polygon[(i + 1) % count];
+            const Point& next     = polygon[(i + 2) % count];
+
+            // Directions of the edges before and after the removed one; they only meet
+            // beyond the edge if they turn by less than half a turn in total (the hull is
+            // counter-clockwise, in a y-up frame)
+            double d1x = first.x - previous.x, d1y = first.y - previous.y;
+            double d2x = next.x - second.x,    d2y = next.y - second.y;
+            double denominator = d1x * d2y - d1y * d2x;
+            if (denominator <= epsilon)
+                continue;
+
+            double t = ((second.x - first.x) * d2y - (second.y - first.y) * d2x) / denominator;
+            Point meeting(first.x + d1x * t, first.y + d1y * t);
+            if ((meeting.x < -epsilon) || (meeting.y < -epsilon) || (meeting.x > width + epsilon) || (meeting.y > height + epsilon))
+                continue;
+
+            double cost = std::fabs(cross(first, second, meeting)) / 2;
+            if ((best == count) || (cost < bestCost))
+            {
+                best = i;
+                bestCost = cost;
+                bestPoint = Point(std::min(std::max(meeting.x, 0.0), width), std::min(std::max(meeting.y, 0.0), height));
+            }
+        }
+
+        if (best == count)
+            return false;
+
+        polygon[best] = bestPoint;
+        polygon.erase(polygon.begin() + static_cast<std::ptrdiff_t>((best + 1) % count));
+        return true;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SpriteMesh::SpriteMesh() :
+m_points(),
+m_size  (0, 0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool SpriteMesh::loadFromImage(const Image& image, const IntRect& area, std::size_t maxPointCount, Uint8 alphaThreshold)
+{
+    m_points.clear();
+    m_size = Vector2u(0, 0);
+
+    // Adjust the area to the size of the image, like sf::Texture does
+    int width  = static_cast<int>(image.getSize().x);
+    int height = static_cast<int>(image.getSize().y);
+    IntRect rectangle = ((area.width == 0) || (area.height == 0)) ? IntRect(0, 0, width, height) : area;
+    if (rectangle.left < 0) rectangle.left = 0;
+    if (rectangle.top  < 0) rectangle.top  = 0;
+    if (rectangle.left + rectangle.width > width)  rectangle.width  = width - rectangle.left;
+    if (rectangle.top + rectangle.height > height) rectangle.height = height - rectangle.top;
+
+    if ((rectangle.width <= 0) || (rectangle.height <= 0))
+    {
+        err() << "Failed to build sprite mesh, the area is outside of the image" << std::endl;
+        return false;
+    }
+
+    m_size = Vector2u(static_cast<unsigned int>(rectangle.width), static_cast<unsigned int>(rectangle.height));
+
+    // The hull of the visible pixels only depends on the leftmost and rightmost ones of each row
+    std::vector<Point> corners;
+    for (int y = 0; y < rectangle.height; ++y)
+    {
+        int left = -1;
+        int right = -1;
+        for (int x = 0; x < rectangle.width; ++x)
+        {
+            if (image.getPixel(static_cast<unsigned int>(rectangle.left + x), static_cast<unsigned int>(rectangle.top + y)).a > alphaThreshold)
+            {
+                if (left < 0)
+                    left = x;
+                right = x;
+            }
+        }
+
+        if (left >= 0)
+        {
+            corners.push_back(Point(left, y));
+            corners.push_back(Point(left, y + 1));
+            corners.push_back(Point(right + 1, y));
+            corners.push_back(Point(right + 1, y + 1));
+        }
+    }
+
+    // Nothing is visible
+    if (corners.empty())
+        return true;
+
+    std::vector<Point> polygon = convexHull(corners);
+
+    // Grow the polygon until it fits in the budget, or fall back to the whole rectangle
+    maxPointCount = std::max<std::size_t>(maxPointCount, 4);
+    while (polygon.size() > maxPointCount)
+    {
+        if (!removeCheapestEdge(polygon, rectangle.width, rectangle.height))
+        {
+            polygon.clear();
+            polygon.push_back(Point(0, 0));
+            polygon.push_back(Point(rectangle.width, 0));
+            polygon.push_back(Point(rectangle.width, rectangle.height));
+            polygon.push_back(Point(0, rectangle.height));
+            break;
+        }
+    }
+
+    m_points.reserve(polygon.size());
+    for (std::size_t i = 0; i < polygon.size(); ++i)
+        m_points.push_back(Vector2f(static_cast<float>(polygon[i].x), static_cast<float>(polygon[i].y)));
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpriteMesh::getPointCount() const
+{
+    return m_points.size();
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2f SpriteMesh::getPoint(std::size_t index) const
+{
+    return m_points[index];
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u SpriteMesh::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+float SpriteMesh::getCoverage() const
+{
+    if ((m_size.x == 0) || (m_size.y == 0))
+        return 0.f;
+
+    // Shoelace formula
+    double area = 0;
+    for (std::size_t i = 0; i < m_points.size(); ++i)
+    {
+        const Vector2f& a = m_points[i];
+        const Vector2f& b = m_points[(i + 1) % m_points.size()];
+        area += static_cast<double>(a.x) * b.y - static_cast<double>(b.x) * a.y;
+    }
+
+    return static_cast<float>(std::fabs(area) / 2 / (static_cast<double>(m_size.x) * m_size.y));
+}
+
+} // namespace sf
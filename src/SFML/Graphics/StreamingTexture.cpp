@@ -0,0 +1,342 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/StreamingTexture.hpp>
+#include <SFML/Graphics/TextureStream.hpp>
+#include <SFML/Graphics/TextureSaver.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <cstring>
+
+
+namespace
+{
+    // One frame written by the producer, one waiting for upload and one being uploaded:
+    // the producer never has to wait for the render thread
+    const std::size_t slotCount = 3;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+StreamingTexture::StreamingTexture() :
+m_texture  (),
+m_slots    (),
+m_pixels   (),
+m_size     (0, 0),
+m_writing  (-1),
+m_published(-1),
+m_dropped  (0),
+m_mutex    ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+StreamingTexture::~StreamingTexture()
+{
+    cleanup();
+}
+
+
+////////////////////////////////////////////////////////////
+bool StreamingTexture::create(unsigned int width, unsigned int height)
+{
+    // Check if the size is valid before creating anything
+    if ((width == 0) || (height == 0))
+    {
+        err() << "Failed to create streaming texture, invalid size (" << width << "x" << height << ")" << std::endl;
+        return false;
+    }
+
+    cleanup();
+
+    if (!m_texture.create(width, height))
+        return false;
+
+    m_size = Vector2u(width, height);
+    m_slots.resize(slotCount);
+    for (std::size_t i = 0; i < m_slots.size(); ++i)
+    {
+        m_slots[i].buffer = 0;
+        m_slots[i].memory = NULL;
+        m_slots[i].state = Free;
+    }
+
+    if (!TextureStream::isAvailable())
+    {
+        // Fallback: the frames are written to system memory, and uploaded synchronously
+        std::size_t frameSize = static_cast<std::size_t>(width) * height * 4;
+        m_pixels.resize(frameSize * m_slots.size());
+        for (std::size_t i = 0; i < m_slots.size(); ++i)
+            m_slots[i].memory = &m_pixels[i * frameSize];
+
+        return true;
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    ensureGlContext();
+
+    for (std::size_t i = 0; i < m_slots.size(); ++i)
+    {
+        GLuint buffer = 0;
+        glCheck(GLEXT_glGenBuffers(1, &buffer));
+        if (!buffer)
+        {
+            err() << "Failed to create streaming texture, pixel buffer generation failed" << std::endl;
+            cleanup();
+            return false;
+        }
+
+        m_slots[i].buffer = buffer;
+        map(m_slots[i]);
+    }
+
+#endif
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u StreamingTexture::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint8* StreamingTexture::acquireFrame()
+{
+    Lock lock(m_mutex);
+
+    if (m_writing >= 0)
+        return m_slots[m_writing].memory;
+
+    for (std::size_t i = 0; i < m_slots.size(); ++i)
+    {
+        if ((m_slots[i].state == Free) && m_slots[i].memory)
+        {
+            m_slots[i].state = Writing;
+            m_writing = static_cast<int>(i);
+            return m_slots[i].memory;
+        }
+    }
+
+    return NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamingTexture::publishFrame()
+{
+    Lock lock(m_mutex);
+
+    if (m_writing < 0)
+        return;
+
+    // Latest frame wins: the one that was still waiting is dropped
+    if (m_published >= 0)
+    {
+        m_slots[m_published].state = Free;
+        ++m_dropped;
+    }
+
+    m_slots[m_writing].state = Published;
+    m_published = m_writing;
+    m_writing = -1;
+}
+
+
+////////////////////////////////////////////////////////////
+bool StreamingTexture::update(const Uint8* pixels)
+{
+    if (!pixels)
+        return false;
+
+    Uint8* memory = acquireFrame();
+    if (!memory)
+        return false;
+
+    std::memcpy(memory, pixels, static_cast<std::size_t>(m_size.x) * m_size.y * 4);
+    publishFrame();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool StreamingTexture::upload()
+{
+    // Take the latest frame; the producer can publish new ones during the transfer
+    int index;
+    {
+        Lock lock(m_mutex);
+
+        if (m_published < 0)
+            return false;
+
+        index = m_published;
+        m_published = -1;
+        m_slots[index].state = Uploading;
+    }
+
+    Slot& slot = m_slots[index];
+    bool updated = true;
+
+    if (!slot.buffer)
+    {
+        m_texture.update(slot.memory, m_size.x, m_size.y, 0, 0);
+    }
+    else
+    {
+    #ifndef SFML_OPENGL_ES
+
+        ensureGlContext();
+
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, slot.buffer));
+
+        GLboolean valid = GL_TRUE;
+        glCheck(valid = GLEXT_glUnmapBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER));
+        slot.memory = NULL;
+
+        // The content of the buffer can be lost (e.g. on video mode changes),
+        // in which case the frame is skipped
+        updated = (valid == GL_TRUE);
+        if (updated)
+        {
+            // Make sure that the current texture binding will be preserved
+            priv::TextureSaver save;
+
+            // With an unpack buffer bound, the pixel pointer is an offset into the buffer
+            priv::bindTexture(GL_TEXTURE_2D, m_texture.m_texture);
+            glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_size.x, m_size.y, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+            m_texture.invalidatePixels();
+        }
+
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+
+        // Give the buffer back to the producer right away
+        map(slot);
+
+    #endif
+    }
+
+    {
+        Lock lock(m_mutex);
+        slot.state = Free;
+    }
+
+    return updated;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& StreamingTexture::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 StreamingTexture::getDroppedFrameCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_dropped;
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamingTexture::map(Slot& slot)
+{
+#ifndef SFML_OPENGL_ES
+
+    // Orphan the previous storage of the buffer, so that the driver doesn't
+    // have to wait for the pending transfer before giving us the memory
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, slot.buffer));
+    glCheck(GLEXT_glBufferData(GLEXT_GL_PIXEL_UNPACK_BUFFER, m_size.x * m_size.y * 4, NULL, GLEXT_GL_STREAM_DRAW));
+
+    void* memory = NULL;
+    glCheck(memory = GLEXT_glMapBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, GLEXT_GL_WRITE_ONLY));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+
+    if (!memory)
+        err() << "Failed to map streaming texture buffer" << std::endl;
+
+    slot.memory = static_cast<Uint8*>(memory);
+
+#else
+
+    (void)slot;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void StreamingTexture::cleanup()
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!m_slots.empty() && m_slots[0].buffer)
+    {
+        ensureGlContext();
+
+        for (std::size_t i = 0; i < m_slots.size(); ++i)
+        {
+            GLuint buffer = static_cast<GLuint>(m_slots[i].buffer);
+            if (!buffer)
+                continue;
+
+            if (m_slots[i].memory)
+            {
+                glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, buffer));
+                glCheck(GLEXT_glUnmapBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER));
+                glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+            }
+
+            glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+        }
+    }
+
+#endif
+
+    Lock lock(m_mutex);
+
+    m_slots.clear();
+    m_pixels.clear();
+    m_size = Vector2u(0, 0);
+    m_writing = -1;
+    m_published = -1;
+    m_dropped = 0;
+}
+
+} // namespace sf
@@ -28,21 +28,136 @@
 #include <SFML/Graphics/Text.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Profiler.hpp>
+#include <algorithm>
 #include <cmath>
 
 
+namespace
+{
+    sf::Mutex mutex;
+
+    // Reads the characters of a text, either stored in UTF-32 or decoded on the fly from UTF-8
+    class CharacterReader
+    {
+    public:
+
+        CharacterReader(const sf::String& string, const std::string& utf8, bool isUtf8) :
+        m_utf32   (isUtf8 ? NULL : string.getData()),
+        m_utf32End(isUtf8 ? NULL : string.getData() + string.getSize()),
+        m_utf8    (isUtf8 ? utf8.data() : NULL),
+        m_utf8End (isUtf8 ? utf8.data() + utf8.size() : NULL)
+        {
+        }
+
+        bool atEnd() const
+        {
+            return m_utf8 ? (m_utf8 == m_utf8End) : (m_utf32 == m_utf32End);
+        }
+
+        sf::Uint32 next()
+        {
+            if (!m_utf8)
+                return *m_utf32++;
+
+            sf::Uint32 character;
+            m_utf8 = sf::Utf8::decode(m_utf8, m_utf8End, character);
+            return character;
+        }
+
+        std::size_t getLength() const
+        {
+            return m_utf8 ? sf::Utf8::count(m_utf8, m_utf8End) : static_cast<std::size_t>(m_utf32End - m_utf32);
+        }
+
+    private:
+
+        const sf::Uint32* m_utf32;
+        const sf::Uint32* m_utf32End;
+        const char*       m_utf8;
+        const char*       m_utf8End;
+    };
+
+    // Fragment shader that turns a distance field into a sharp edge, at any scale
+    const char* distanceFieldSource =
+        "uniform sampler2D texture;\n"
+        "void main()\n"
+        "{\n"
+        "    float distance = texture2D(texture, gl_TexCoord[0].xy).a;\n"
+        "    float width = max(0.7 * fwidth(distance), 0.001);\n"
+        "    float alpha = smoothstep(0.5 - width, 0.5 + width, distance);\n"
+        "    gl_FragColor = vec4(gl_Color.rgb, gl_Color.a * alpha);\n"
+        "}\n";
+
+    // Get the shader used to draw texts whose font is in distance field mode, creating it on first use.
+    // It is intentionally never destroyed, the same way the shared context
+    // is kept alive until the end of the program.
+    const sf::Shader* getDistanceFieldShader()
+    {
+        // TODO: Remove this lock when it becomes unnecessary in C++11
+        sf::Lock lock(mutex);
+
+        static sf::Shader* shader = NULL;
+        static bool initialized = false;
+
+        if (!initialized)
+        {
+            initialized = true;
+
+            sf::Shader* program = new sf::Shader;
+            if (program->loadFromMemory(distanceFieldSource, sf::Shader::Fragment))
+            {
+                program->setParameter("texture", sf::Shader::CurrentTexture);
+                shader = program;
+            }
+            else
+            {
+                delete program;
+            }
+        }
+
+        return shader;
+    }
+
+    // Add an underline or strike through line to the geometry of a text
+    void addLine(sf::VertexArray& vertices, float width, float position, float thickness, const sf::Color& color)
+    {
+        float top = std::floor(position - (thickness / 2) + 0.5f);
+        float bottom = top + std::floor(thickness + 0.5f);
+
+        vertices.append(sf::Vertex(sf::Vector2f(0, top),        color, sf::Vector2f(1, 1)));
+        vertices.append(sf::Vertex(sf::Vector2f(width, top),    color, sf::Vector2f(1, 1)));
+        vertices.append(sf::Vertex(sf::Vector2f(width, bottom), color, sf::Vector2f(1, 1)));
+        vertices.append(sf::Vertex(sf::Vector2f(0, bottom),     color, sf::Vector2f(1, 1)));
+    }
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 Text::Text() :
 m_string            (),
+m_utf8              (),
+m_isUtf8            (false),
 m_font              (NULL),
 m_characterSize     (30),
 m_style             (Regular),
 m_color             (255, 255, 255),
-m_vertices          (Triangles),
+m_maxWidth          (0.f),
+m_alignment         (Left),
+m_wordWrap          (true),
+m_vertices          (Quads),
 m_bounds            (),
-m_geometryNeedUpdate(false)
+m_geometryNeedUpdate(false),
+m_validLength       (0),
+m_layout            (),
+m_lines             (),
+m_fontRevision      (0),
+m_revision          (0)
 {
 
 }
@@ -51,13 +166,48 @@ m_geometryNeedUpdate(false)
 ////////////////////////////////////////////////////////////
 Text::Text(const String& string, const Font& font, unsigned int characterSize) :
 m_string            (string),
+m_utf8              (),
+m_isUtf8            (false),
+m_font              (&font),
+m_characterSize     (characterSize),
+m_style             (Regular),
+m_color             (255, 255, 255),
+m_maxWidth          (0.f),
+m_alignment         (Left),
+m_wordWrap          (true),
+m_vertices          (Quads),
+m_bounds            (),
+m_geometryNeedUpdate(true),
+m_validLength       (0),
+m_layout            (),
+m_lines             (),
+m_fontRevision      (0),
+m_revision          (0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+Text::Text(const Utf8View& string, const Font& font, unsigned int characterSize) :
+m_string            (),
+m_utf8              (string.getData(), string.getSize()),
+m_isUtf8            (true),
 m_font              (&font),
 m_characterSize     (characterSize),
 m_style             (Regular),
 m_color             (255, 255, 255),
-m_vertices          (Triangles),
+m_maxWidth          (0.f),
+m_alignment         (Left),
+m_wordWrap          (true),
+m_vertices          (Quads),
 m_bounds            (),
-m_geometryNeedUpdate(true)
+m_geometryNeedUpdate(true),
+m_validLength       (0),
+m_layout            (),
+m_lines             (),
+m_fontRevision      (0),
+m_revision          (0)
 {
 
 }
@@ -66,9 +216,56 @@ m_geometryNeedUpdate(true)
 ////////////////////////////////////////////////////////////
 void Text::setString(const String& string)
 {
-    if (m_string != string)
+    if (m_isUtf8)
+    {
+        m_utf8.clear();
+        m_isUtf8 = false;
+        m_string = string;
+        m_validLength = 0;
+        m_geometryNeedUpdate = true;
+    }
+    else if (m_string != string)
     {
+        // The geometry of the characters common to both strings can be kept
+        std::size_t length = std::min(m_validLength, std::min(m_string.getSize(), string.getSize()));
+        std::size_t prefix = 0;
+        while ((prefix < length) && (m_string[prefix] == string[prefix]))
+            ++prefix;
+
         m_string = string;
+        m_validLength = prefix;
+        m_geometryNeedUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::setString(const Utf8View& string)
+{
+    if (!m_isUtf8)
+    {
+        m_string.clear();
+        m_isUtf8 = true;
+        m_utf8.assign(string.getData(), string.getSize());
+        m_validLength = 0;
+        m_geometryNeedUpdate = true;
+    }
+    else if ((m_utf8.size() != string.getSize()) || (m_utf8.compare(0, m_utf8.size(), string.getData(), string.getSize()) != 0))
+    {
+        // The geometry of the characters common to both strings can be kept:
+        // find the common bytes, without the incomplete character at their end
+        std::size_t length = std::min(m_utf8.size(), string.getSize());
+        std::size_t prefix = 0;
+        while ((prefix < length) && (m_utf8[prefix] == string.getData()[prefix]))
+            ++prefix;
+        while ((prefix > 0) && (prefix < m_utf8.size()) && ((m_utf8[prefix] & 0xC0) == 0x80))
+            --prefix;
+
+        std::size_t characters = Utf8::count(m_utf8.data(), m_utf8.data() + prefix);
+        m_validLength = std::min(m_validLength, characters);
+
+        m_utf8.assign(string.getData(), string.getSize());
+        m_string.clear();
         m_geometryNeedUpdate = true;
     }
 }
@@ -80,6 +277,7 @@ void Text::setFont(const Font& font)
     if (m_font != &font)
     {
         m_font = &font;
+        m_validLength = 0;
         m_geometryNeedUpdate = true;
     }
 }
@@ -91,6 +289,7 @@ void Text::setCharacterSize(unsigned int size)
     if (m_characterSize != size)
     {
         m_characterSize = size;
+        m_validLength = 0;
         m_geometryNeedUpdate = true;
     }
 }
@@ -102,6 +301,7 @@ void Text::setStyle(Uint32 style)
     if (m_style != style)
     {
         m_style = style;
+        m_validLength = 0;
         m_geometryNeedUpdate = true;
     }
 }
@@ -115,12 +315,46 @@ void Text::setColor(const Color& color)
         m_color = color;
 
         // Change vertex colors directly, no need to update whole geometry
-        // (if geometry is updated anyway, we can skip this step)
-        if (!m_geometryNeedUpdate)
-        {
-            for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i)
-                m_vertices[i].color = m_color;
-        }
+        // (the vertices that are kept by the next update must have the new color too)
+        for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i)
+            m_vertices[i].color = m_color;
+        ++m_revision;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::setMaxWidth(float width)
+{
+    if (m_maxWidth != width)
+    {
+        m_maxWidth = width;
+        m_validLength = 0;
+        m_geometryNeedUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::setAlignment(Alignment alignment)
+{
+    if (m_alignment != alignment)
+    {
+        // The line breaks don't change, only the offsets of the lines are updated
+        m_alignment = alignment;
+        m_geometryNeedUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::setWordWrap(bool wordWrap)
+{
+    if (m_wordWrap != wordWrap)
+    {
+        m_wordWrap = wordWrap;
+        m_validLength = 0;
+        m_geometryNeedUpdate = true;
     }
 }
 
@@ -128,6 +362,9 @@ void Text::setColor(const Color& color)
 ////////////////////////////////////////////////////////////
 const String& Text::getString() const
 {
+    if (m_isUtf8 && m_string.isEmpty() && !m_utf8.empty())
+        m_string = String::fromUtf8(m_utf8.data(), m_utf8.data() + m_utf8.size());
+
     return m_string;
 }
 
@@ -160,6 +397,36 @@ const Color& Text::getColor() const
 }
 
 
+////////////////////////////////////////////////////////////
+float Text::getMaxWidth() const
+{
+    return m_maxWidth;
+}
+
+
+////////////////////////////////////////////////////////////
+Text::Alignment Text::getAlignment() const
+{
+    return m_alignment;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Text::getWordWrap() const
+{
+    return m_wordWrap;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Text::getLineCount() const
+{
+    ensureGeometryUpdate();
+
+    return m_lines.size();
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2f Text::findCharacterPos(std::size_t index) const
 {
@@ -167,36 +434,20 @@ Vector2f Text::findCharacterPos(std::size_t index) const
     if (!m_font)
         return Vector2f();
 
-    // Adjust the index if it's out of range
-    if (index > m_string.getSize())
-        index = m_string.getSize();
+    ensureGeometryUpdate();
 
-    // Precompute the variables needed by the algorithm
-    bool  bold   = (m_style & Bold) != 0;
-    float hspace = static_cast<float>(m_font->getGlyph(L' ', m_characterSize, bold).advance);
-    float vspace = static_cast<float>(m_font->getLineSpacing(m_characterSize));
+    // Adjust the index if it's out of range (the layout has one more entry than the string has characters)
+    if (!m_layout.empty() && (index >= m_layout.size()))
+        index = m_layout.size() - 1;
 
-    // Compute the position
+    // The layout was computed together with the geometry, which starts one line below the origin;
+    // it doesn't include the alignment offset of the line
     Vector2f position;
-    Uint32 prevChar = 0;
-    for (std::size_t i = 0; i < index; ++i)
+    if (index < m_layout.size())
     {
-        Uint32 curChar = m_string[i];
-
-        // Apply the kerning offset
-        position.x += static_cast<float>(m_font->getKerning(prevChar, curChar, m_characterSize));
-        prevChar = curChar;
-
-        // Handle special characters
-        switch (curChar)
-        {
-            case ' ':  position.x += hspace;                 continue;
-            case '\t': position.x += hspace * 4;             continue;
-            case '\n': position.y += vspace; position.x = 0; continue;
-        }
-
-        // For regular characters, add the advance offset of the glyph
-        position.x += static_cast<float>(m_font->getGlyph(curChar, m_characterSize, bold).advance);
+        position = m_layout[index].position;
+        position.x += m_lines[findLine(index)].offset;
+        position.y -= static_cast<float>(m_characterSize);
     }
 
     // Transform the position to global coordinates
@@ -231,32 +482,58 @@ void Text::draw(RenderTarget& target, RenderStates states) const
 
         states.transform *= getTransform();
         states.texture = &m_font->getTexture(m_characterSize);
+
+        // Distance field glyphs must be drawn through a shader, use the default one unless a custom one is given
+        if (!states.shader)
+            states.shader = getDefaultShader();
+
         target.draw(m_vertices, states);
     }
 }
 
 
+////////////////////////////////////////////////////////////
+const Shader* Text::getDefaultShader() const
+{
+    return (m_font && m_font->isDistanceField()) ? getDistanceFieldShader() : NULL;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Text::ensureGeometryUpdate() const
 {
+    // Glyphs loaded in the background replace their placeholders: rebuild the geometry
+    if (m_font)
+    {
+        Uint64 revision = m_font->uploadPendingGlyphs();
+        if (revision != m_fontRevision)
+        {
+            m_fontRevision = revision;
+            m_validLength = 0;
+            m_geometryNeedUpdate = true;
+        }
+    }
+
     // Do nothing, if geometry has not changed
     if (!m_geometryNeedUpdate)
         return;
 
+    SFML_PROFILE_SCOPE("Text::ensureGeometryUpdate");
+
     // Mark geometry as updated
     m_geometryNeedUpdate = false;
+    ++m_revision;
 
-    // Clear the previous geometry
-    m_vertices.clear();
-    m_bounds = FloatRect();
-
-    // No font: nothing to draw
-    if (!m_font)
-        return;
-
-    // No text: nothing to draw
-    if (m_string.isEmpty())
+    // No font or no text: nothing to draw
+    if (!m_font || (m_isUtf8 ? m_utf8.empty() : m_string.isEmpty()))
+    {
+        m_vertices.clear();
+        m_layout.clear();
+        m_lines.clear();
+        m_validLength = 0;
+        m_bounds = FloatRect();
         return;
+    }
 
     // Compute values related to the text style
     bool  bold               = (m_style & Bold) != 0;
@@ -275,18 +552,106 @@ void Text::ensureGeometryUpdate() const
     // Precompute the variables needed by the algorithm
     float hspace = static_cast<float>(m_font->getGlyph(L' ', m_characterSize, bold).advance);
     float vspace = static_cast<float>(m_font->getLineSpacing(m_characterSize));
-    float x      = 0.f;
-    float y      = static_cast<float>(m_characterSize);
+    bool  wrap   = m_maxWidth > 0.f;
+
+    // Resume after the last character whose geometry is still valid, or start from scratch
+    std::size_t start = m_layout.empty() ? 0 : std::min(m_validLength, m_layout.size() - 1);
+    std::size_t line = 0;
+    if (start > 0)
+    {
+        line = findLine(start);
+
+        // When wrapping, the whole line is flowed again; so is the previous one if it was broken
+        // by the maximum width, since the first word of the line may now fit at its end (as well
+        // as all the lines that this word was split across)
+        if (wrap)
+        {
+            while ((line > 0) && m_lines[line - 1].split)
+                --line;
+            if ((line > 0) && m_lines[line - 1].wrapped)
+                --line;
+
+            start = m_lines[line].start;
+        }
+    }
+
+    if (start == 0)
+    {
+        Layout initial;
+        initial.position    = Vector2f(0.f, static_cast<float>(m_characterSize));
+        initial.vertexCount = 0;
+        initial.lineWidth   = 0.f;
+        initial.minX        = static_cast<float>(m_characterSize);
+        initial.minY        = static_cast<float>(m_characterSize);
+        initial.maxX        = 0.f;
+        initial.maxY        = 0.f;
+
+        m_layout.assign(1, initial);
+        m_lines.clear();
+    }
+    else
+    {
+        m_layout.resize(start + 1);
+    }
+
+    // Drop the geometry of the characters that changed, as well as the lines of the last row
+    const Layout& resume = m_layout.back();
+    m_vertices.resize(resume.vertexCount);
+
+    float       x         = resume.position.x;
+    float       y         = resume.position.y;
+    float       lineWidth = resume.lineWidth;
+    float       minX      = resume.minX;
+    float       minY      = resume.minY;
+    float       maxX      = resume.maxX;
+    float       maxY      = resume.maxY;
+    std::size_t lineStart = start;
+    Uint32      prevChar  = 0;
+
+    // The line being resumed is flowed again from its start position: remove its alignment
+    if (start > 0)
+    {
+        lineStart = m_lines[line].start;
+        for (std::size_t i = m_layout[lineStart].vertexCount; i < m_vertices.getVertexCount(); ++i)
+            m_vertices[i].position.x -= m_lines[line].offset;
+
+        m_lines.resize(line);
+    }
+
+    // Skip the characters whose geometry is kept
+    CharacterReader reader(m_string, m_utf8, m_isUtf8);
+    for (std::size_t i = 0; (i < start) && !reader.atEnd(); ++i)
+        prevChar = reader.next();
+    if (start == lineStart)
+        prevChar = 0;
+
+    // Position of the current word, where the line is broken if the word doesn't fit in it
+    std::size_t     wordStart  = start;
+    CharacterReader wordReader = reader;
+    bool            inWord     = false;
 
     // Create one quad for each character
-    float minX = static_cast<float>(m_characterSize);
-    float minY = static_cast<float>(m_characterSize);
-    float maxX = 0.f;
-    float maxY = 0.f;
-    Uint32 prevChar = 0;
-    for (std::size_t i = 0; i < m_string.getSize(); ++i)
+    m_layout.reserve(start + reader.getLength() + 1);
+    std::size_t i = start;
+    while (!reader.atEnd())
     {
-        Uint32 curChar = m_string[i];
+        // Store the layout before the current character
+        if (i > start)
+        {
+            Layout layout;
+            layout.position    = Vector2f(x, y);
+            layout.vertexCount = m_vertices.getVertexCount();
+            layout.lineWidth   = lineWidth;
+            layout.minX        = minX;
+            layout.minY        = minY;
+            layout.maxX        = maxX;
+            layout.maxY        = maxY;
+
+            m_layout.push_back(layout);
+        }
+
+        CharacterReader charReader = reader;
+        Uint32 curChar = reader.next();
 
         // Apply the kerning offset
         x += static_cast<float>(m_font->getKerning(prevChar, curChar, m_characterSize));
@@ -294,35 +659,17 @@ void Text::ensureGeometryUpdate() const
 
         // If we're using the underlined style and there's a new line, draw a line
         if (underlined && (curChar == L'\n'))
-        {
-            float top = std::floor(y + underlineOffset - (underlineThickness / 2) + 0.5f);
-            float bottom = top + std::floor(underlineThickness + 0.5f);
-
-            m_vertices.append(Vertex(Vector2f(0, top),    m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(x, bottom), m_color, Vector2f(1, 1)));
-        }
+            addLine(m_vertices, x, y + underlineOffset, underlineThickness, m_color);
 
         // If we're using the strike through style and there's a new line, draw a line across all characters
         if (strikeThrough && (curChar == L'\n'))
-        {
-            float top = std::floor(y + strikeThroughOffset - (underlineThickness / 2) + 0.5f);
-            float bottom = top + std::floor(underlineThickness + 0.5f);
-
-            m_vertices.append(Vertex(Vector2f(0, top),    m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-            m_vertices.append(Vertex(Vector2f(x, bottom), m_color, Vector2f(1, 1)));
-        }
+            addLine(m_vertices, x, y + strikeThroughOffset, underlineThickness, m_color);
 
         // Handle special characters
         if ((curChar == ' ') || (curChar == '\t') || (curChar == '\n'))
         {
+            inWord = false;
+
             // Update the current bounds (min coordinates)
             minX = std::min(minX, x);
             minY = std::min(minY, y);
@@ -338,13 +685,70 @@ void Text::ensureGeometryUpdate() const
             maxX = std::max(maxX, x);
             maxY = std::max(maxY, y);
 
+            // Start a new line after an end of line character
+            if (curChar == '\n')
+            {
+                Line ended = {lineStart, lineWidth, minX, maxX, 0.f, false, false};
+                m_lines.push_back(ended);
+
+                lineStart = i + 1;
+                lineWidth = 0.f;
+                minX      = static_cast<float>(m_characterSize);
+                maxX      = 0.f;
+                prevChar  = 0;
+            }
+
             // Next glyph, no need to create a quad for whitespace
+            ++i;
             continue;
         }
 
+        if (!inWord)
+        {
+            inWord     = true;
+            wordStart  = i;
+            wordReader = charReader;
+        }
+
         // Extract the current glyph's description
         const Glyph& glyph = m_font->getGlyph(curChar, m_characterSize, bold);
 
+        // Break the line if the character doesn't fit in it: before the current word if it
+        // doesn't start the line, otherwise (or without word wrap) before the character itself
+        if (wrap && (i > lineStart) && (x + glyph.advance > m_maxWidth))
+        {
+            bool        beforeWord = m_wordWrap && (wordStart > lineStart);
+            std::size_t breakIndex = beforeWord ? wordStart : i;
+
+            // Restore the layout of the break position, the characters after it are flowed again
+            Layout before = m_layout[breakIndex];
+            m_layout.resize(breakIndex);
+            m_vertices.resize(before.vertexCount);
+            lineWidth = before.lineWidth;
+
+            if (underlined)
+                addLine(m_vertices, lineWidth, y + underlineOffset, underlineThickness, m_color);
+            if (strikeThrough)
+                addLine(m_vertices, lineWidth, y + strikeThroughOffset, underlineThickness, m_color);
+
+            Line ended = {lineStart, lineWidth, before.minX, before.maxX, 0.f, true, m_wordWrap && !beforeWord};
+            m_lines.push_back(ended);
+
+            x         = 0.f;
+            y        += vspace;
+            lineStart = breakIndex;
+            lineWidth = 0.f;
+            minX      = static_cast<float>(m_characterSize);
+            minY      = before.minY;
+            maxX      = 0.f;
+            maxY      = before.maxY;
+            prevChar  = 0;
+            inWord    = false;
+            reader    = beforeWord ? wordReader : charReader;
+            i         = breakIndex;
+            continue;
+        }
+
         float left   = glyph.bounds.left;
         float top    = glyph.bounds.top;
         float right  = glyph.bounds.left + glyph.bounds.width;
@@ -358,10 +762,8 @@ void Text::ensureGeometryUpdate() const
         // Add a quad for the current character
         m_vertices.append(Vertex(Vector2f(x + left  - italic * top,    y + top),    m_color, Vector2f(u1, v1)));
         m_vertices.append(Vertex(Vector2f(x + right - italic * top,    y + top),    m_color, Vector2f(u2, v1)));
-        m_vertices.append(Vertex(Vector2f(x + left  - italic * bottom, y + bottom), m_color, Vector2f(u1, v2)));
-        m_vertices.append(Vertex(Vector2f(x + left  - italic * bottom, y + bottom), m_color, Vector2f(u1, v2)));
-        m_vertices.append(Vertex(Vector2f(x + right - italic * top,    y + top),    m_color, Vector2f(u2, v1)));
         m_vertices.append(Vertex(Vector2f(x + right - italic * bottom, y + bottom), m_color, Vector2f(u2, v2)));
+        m_vertices.append(Vertex(Vector2f(x + left  - italic * bottom, y + bottom), m_color, Vector2f(u1, v2)));
 
         // Update the current bounds
         minX = std::min(minX, x + left - italic * bottom);
@@ -371,41 +773,98 @@ void Text::ensureGeometryUpdate() const
 
         // Advance to the next character
         x += glyph.advance;
+        lineWidth = x;
+        ++i;
     }
 
-    // If we're using the underlined style, add the last line
-    if (underlined)
+    // Store the layout at the end of the string
+    if (i > start)
     {
-        float top = std::floor(y + underlineOffset - (underlineThickness / 2) + 0.5f);
-        float bottom = top + std::floor(underlineThickness + 0.5f);
-
-        m_vertices.append(Vertex(Vector2f(0, top),    m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(x, bottom), m_color, Vector2f(1, 1)));
+        Layout layout;
+        layout.position    = Vector2f(x, y);
+        layout.vertexCount = m_vertices.getVertexCount();
+        layout.lineWidth   = lineWidth;
+        layout.minX        = minX;
+        layout.minY        = minY;
+        layout.maxX        = maxX;
+        layout.maxY        = maxY;
+
+        m_layout.push_back(layout);
     }
 
+    m_validLength = i;
+
+    // If we're using the underlined style, add the last line
+    if (underlined)
+        addLine(m_vertices, x, y + underlineOffset, underlineThickness, m_color);
+
     // If we're using the strike through style, add the last line across all characters
     if (strikeThrough)
+        addLine(m_vertices, x, y + strikeThroughOffset, underlineThickness, m_color);
+
+    Line last = {lineStart, lineWidth, minX, maxX, 0.f, false, false};
+    m_lines.push_back(last);
+
+    // Align the lines to the maximum width, or to the widest line if there's none;
+    // only the lines whose offset changed have their vertices moved
+    float alignWidth = m_maxWidth;
+    if (!wrap && (m_alignment != Left))
+    {
+        alignWidth = 0.f;
+        for (std::size_t l = 0; l < m_lines.size(); ++l)
+            alignWidth = std::max(alignWidth, m_lines[l].width);
+    }
+
+    float boundsLeft  = m_lines.front().minX;
+    float boundsRight = m_lines.front().maxX;
+    for (std::size_t l = 0; l < m_lines.size(); ++l)
     {
-        float top = std::floor(y + strikeThroughOffset - (underlineThickness / 2) + 0.5f);
-        float bottom = top + std::floor(underlineThickness + 0.5f);
-
-        m_vertices.append(Vertex(Vector2f(0, top),    m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(0, bottom), m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(x, top),    m_color, Vector2f(1, 1)));
-        m_vertices.append(Vertex(Vector2f(x, bottom), m_color, Vector2f(1, 1)));
+        Line& current = m_lines[l];
+
+        float offset = 0.f;
+        if (m_alignment == Center)
+            offset = std::floor((alignWidth - current.width) / 2.f);
+        else if (m_alignment == Right)
+            offset = alignWidth - current.width;
+
+        if (offset != current.offset)
+        {
+            std::size_t first = m_layout[current.start].vertexCount;
+            std::size_t end   = (l + 1 < m_lines.size()) ? m_layout[m_lines[l + 1].start].vertexCount : m_vertices.getVertexCount();
+            for (std::size_t v = first; v < end; ++v)
+                m_vertices[v].position.x += offset - current.offset;
+
+            current.offset = offset;
+        }
+
+        boundsLeft  = std::min(boundsLeft, current.minX + offset);
+        boundsRight = std::max(boundsRight, current.maxX + offset);
     }
 
     // Update the bounding rectangle
-    m_bounds.left = minX;
+    m_bounds.left = boundsLeft;
     m_bounds.top = minY;
-    m_bounds.width = maxX - minX;
+    m_bounds.width = boundsRight - boundsLeft;
     m_bounds.height = maxY - minY;
 }
 
+
+////////////////////////////////////////////////////////////
+std::size_t Text::findLine(std::size_t index) const
+{
+    // Binary search of the last line that starts before the character
+    std::size_t first = 0;
+    std::size_t last = m_lines.size();
+    while (last - first > 1)
+    {
+        std::size_t middle = (first + last) / 2;
+        if (m_lines[middle].start <= index)
+            first = middle;
+        else
+            last = middle;
+    }
+
+    return first;
+}
+
 } // namespace sf
@@ -0,0 +1,221 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextBatch.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Texts without a font have no page
+    const std::size_t noPage = static_cast<std::size_t>(-1);
+
+    // Compare two transforms
+    bool equal(const sf::Transform& left, const sf::Transform& right)
+    {
+        const float* a = left.getMatrix();
+        const float* b = right.getMatrix();
+        return std::equal(a, a + 16, b);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextBatch::TextBatch() :
+m_labels(),
+m_pages ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::add(const Text& text)
+{
+    for (std::size_t i = 0; i < m_labels.size(); ++i)
+    {
+        if (m_labels[i].text == &text)
+            return;
+    }
+
+    // The label is placed in its page by the next update
+    Label label;
+    label.text = &text;
+    label.revision = 0;
+    label.page = noPage;
+    label.firstVertex = 0;
+    label.vertexCount = 0;
+    m_labels.push_back(label);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::remove(const Text& text)
+{
+    for (std::vector<Label>::iterator it = m_labels.begin(); it != m_labels.end(); ++it)
+    {
+        if (it->text == &text)
+        {
+            if (it->page != noPage)
+                m_pages[it->page].rebuild = true;
+
+            m_labels.erase(it);
+            return;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::clear()
+{
+    m_labels.clear();
+    m_pages.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextBatch::getTextCount() const
+{
+    return m_labels.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::draw(RenderTarget& target, RenderStates states) const
+{
+    update();
+
+    for (std::vector<Page>::const_iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+    {
+        if (it->vertices.empty())
+            continue;
+
+        RenderStates pageStates(states);
+        pageStates.texture = it->texture;
+        if (!pageStates.shader)
+            pageStates.shader = it->shader;
+
+        target.draw(&it->vertices[0], it->vertices.size(), Quads, pageStates);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::update() const
+{
+    // Find the labels that changed; the ones that kept their page and number
+    // of vertices are updated in place, the others rebuild their pages
+    for (std::vector<Label>::iterator it = m_labels.begin(); it != m_labels.end(); ++it)
+    {
+        Label& label = *it;
+        const Text& text = *label.text;
+        text.ensureGeometryUpdate();
+
+        std::size_t page = noPage;
+        if (text.m_font && (text.m_vertices.getVertexCount() > 0))
+            page = getPage(&text.m_font->getTexture(text.m_characterSize), text.getDefaultShader());
+
+        const Transform& transform = text.getTransform();
+        if ((page == label.page) && (text.m_revision == label.revision) && equal(transform, label.transform))
+            continue;
+
+        if ((page != noPage) && (page == label.page) && (text.m_vertices.getVertexCount() == label.vertexCount) &&
+            !m_pages[page].rebuild)
+        {
+            Vertex* vertices = &m_pages[page].vertices[label.firstVertex];
+            for (std::size_t i = 0; i < label.vertexCount; ++i)
+            {
+                vertices[i] = text.m_vertices[i];
+                vertices[i].position = transform.transformPoint(vertices[i].position);
+            }
+        }
+        else
+        {
+            if (label.page != noPage)
+                m_pages[label.page].rebuild = true;
+            if (page != noPage)
+                m_pages[page].rebuild = true;
+        }
+
+        label.page = page;
+        label.revision = text.m_revision;
+        label.transform = transform;
+        label.vertexCount = text.m_vertices.getVertexCount();
+    }
+
+    // Gather again the vertices of the pages whose labels moved
+    for (std::size_t i = 0; i < m_pages.size(); ++i)
+    {
+        if (m_pages[i].rebuild)
+            m_pages[i].vertices.clear();
+    }
+
+    for (std::vector<Label>::iterator it = m_labels.begin(); it != m_labels.end(); ++it)
+    {
+        Label& label = *it;
+        if ((label.page == noPage) || !m_pages[label.page].rebuild)
+            continue;
+
+        std::vector<Vertex>& vertices = m_pages[label.page].vertices;
+        label.firstVertex = vertices.size();
+        for (std::size_t i = 0; i < label.vertexCount; ++i)
+        {
+            Vertex vertex = label.text->m_vertices[i];
+            vertex.position = label.transform.transformPoint(vertex.position);
+            vertices.push_back(vertex);
+        }
+    }
+
+    for (std::size_t i = 0; i < m_pages.size(); ++i)
+        m_pages[i].rebuild = false;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextBatch::getPage(const Texture* texture, const Shader* shader) const
+{
+    // There are only a few different pages, a linear search is enough
+    for (std::size_t i = 0; i < m_pages.size(); ++i)
+    {
+        if ((m_pages[i].texture == texture) && (m_pages[i].shader == shader))
+            return i;
+    }
+
+    Page page;
+    page.texture = texture;
+    page.shader = shader;
+    page.rebuild = false;
+    m_pages.push_back(page);
+
+    return m_pages.size() - 1;
+}
+
+} // namespace sf
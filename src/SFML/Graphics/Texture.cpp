@@ -29,11 +29,17 @@
 #include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/Graphics/TextureSaver.hpp>
+#include <SFML/Graphics/TextureUploader.hpp>
+#include <SFML/Graphics/CompressedImageLoader.hpp>
+#include <SFML/Graphics/ImageCodecQoi.hpp>
+#include <SFML/Graphics/ImageKernels.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/Window/Window.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
+#include <SFML/System/Profiler.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
@@ -65,6 +71,147 @@ namespace
 
         return static_cast<unsigned int>(size);
     }
+
+    // Check whether the driver can sample from textures in the given compressed format
+    bool isCompressedFormatSupported(unsigned int format)
+    {
+        if (!GLEXT_texture_compression)
+            return false;
+
+        // S3TC (DXT1 to DXT5)
+        if ((format >= 0x83F0) && (format <= 0x83F3))
+            return GLEXT_texture_compression_s3tc;
+
+        // ETC2 and EAC
+        if ((format >= 0x9270) && (format <= 0x9279))
+            return GLEXT_ES3_compatibility;
+
+        // ASTC LDR, linear and sRGB
+        if (((format >= 0x93B0) && (format <= 0x93BD)) || ((format >= 0x93D0) && (format <= 0x93DD)))
+            return GLEXT_texture_compression_astc_ldr;
+
+        return false;
+    }
+
+    // Check whether the driver can store and sample textures in the given pixel format
+    bool isPixelFormatSupported(sf::PixelFormat::Type format)
+    {
+        sf::priv::ensureExtensionsInit();
+
+        switch (format)
+        {
+            case sf::PixelFormat::R8:
+            case sf::PixelFormat::RG8:
+                // Core profiles have no luminance formats, their red and green channels must be swizzled
+                return !sf::priv::isCoreProfile() || (GLEXT_texture_rg && GLEXT_texture_swizzle);
+
+            case sf::PixelFormat::RGBA16F:
+                return GLEXT_texture_float;
+
+            default:
+                return true;
+        }
+    }
+
+    // OpenGL formats of the storage and of the pixels of a texture
+    struct TextureFormat
+    {
+        GLint  internalFormat;
+        GLenum format;
+        GLenum type;
+        GLint  alphaSwizzle; // source of the alpha, if the channels are swizzled
+    };
+
+    TextureFormat getTextureFormat(sf::PixelFormat::Type format)
+    {
+        TextureFormat result;
+        result.internalFormat = GL_RGBA;
+        result.format         = GL_RGBA;
+        result.type           = GL_UNSIGNED_BYTE;
+        result.alphaSwizzle   = 0;
+
+        switch (format)
+        {
+            case sf::PixelFormat::R8:
+            case sf::PixelFormat::RG8:
+            {
+                bool single = (format == sf::PixelFormat::R8);
+
+            #ifndef SFML_OPENGL_ES
+                if (sf::priv::isCoreProfile())
+                {
+                    // Red (and green) channels, spread to the color by a swizzle
+                    result.internalFormat = single ? GLEXT_GL_R8 : GLEXT_GL_RG8;
+                    result.format         = single ? GL_RED : GLEXT_GL_RG;
+                    result.alphaSwizzle   = single ? GL_ONE : GL_GREEN;
+                    break;
+                }
+            #endif
+
+                // Luminance (and alpha) channels, sampled as gray colors as they are
+                result.internalFormat = single ? GL_LUMINANCE : GL_LUMINANCE_ALPHA;
+                result.format         = static_cast<GLenum>(result.internalFormat);
+                break;
+            }
+
+            case sf::PixelFormat::RGB565:
+            {
+            #ifndef SFML_OPENGL_ES
+                result.internalFormat = GL_RGB5;
+            #else
+                result.internalFormat = GL_RGB;
+            #endif
+                result.format         = GL_RGB;
+                result.type           = GLEXT_GL_UNSIGNED_SHORT_5_6_5;
+                break;
+            }
+
+            case sf::PixelFormat::RGBA16F:
+            {
+            #ifndef SFML_OPENGL_ES
+                result.internalFormat = GLEXT_GL_RGBA16F;
+                result.type           = GLEXT_GL_HALF_FLOAT;
+            #endif
+                break;
+            }
+
+            default:
+                break;
+        }
+
+        return result;
+    }
+
+    // Set the swizzle of the bound texture, or reset it to the identity
+    void setSwizzle(const TextureFormat& format, bool reset)
+    {
+    #ifndef SFML_OPENGL_ES
+        if (format.alphaSwizzle || reset)
+        {
+            GLint swizzle[4] = {GL_RED, GL_GREEN, GL_BLUE, GL_ALPHA};
+            if (format.alphaSwizzle)
+            {
+                swizzle[1] = GL_RED;
+                swizzle[2] = GL_RED;
+                swizzle[3] = format.alphaSwizzle;
+            }
+
+            glCheck(glTexParameteriv(GL_TEXTURE_2D, GLEXT_GL_TEXTURE_SWIZZLE_RGBA, swizzle));
+        }
+    #else
+        (void)format;
+        (void)reset;
+    #endif
+    }
+
+    // Rows of 1 and 2 bytes pixels are not padded to the default alignment of 4 bytes
+    void setRowAlignment(GLenum parameter, sf::PixelFormat::Type format, bool packed)
+    {
+        if (sf::PixelFormat::getPixelSize(format) < 4)
+        {
+            glCheck(glPixelStorei(parameter, packed ? 1 : 4));
+        }
+    }
 }
 
 
@@ -74,11 +221,25 @@ namespace sf
 Texture::Texture() :
 m_size         (0, 0),
 m_actualSize   (0, 0),
+m_format       (PixelFormat::RGBA8),
 m_texture      (0),
+m_generation   (Context::getGeneration()),
 m_isSmooth     (false),
 m_isRepeated   (false),
 m_pixelsFlipped(false),
-m_cacheId      (getUniqueId())
+m_hasMipmap    (false),
+m_cacheId      (getUniqueId()),
+m_loadingImage (NULL),
+m_upload       (0),
+m_reduction    (0),
+m_useCount     (0),
+m_accountedSize(0),
+m_category     (ResourceMemory::Textures),
+m_restorable   (false),
+m_sourceFile   (),
+m_sourceArea   (),
+m_compressed   (false),
+m_sourcePixels ()
 {
 }
 
@@ -87,33 +248,65 @@ m_cacheId      (getUniqueId())
 Texture::Texture(const Texture& copy) :
 m_size         (0, 0),
 m_actualSize   (0, 0),
+m_format       (PixelFormat::RGBA8),
 m_texture      (0),
+m_generation   (Context::getGeneration()),
 m_isSmooth     (copy.m_isSmooth),
 m_isRepeated   (copy.m_isRepeated),
 m_pixelsFlipped(false),
-m_cacheId      (getUniqueId())
+m_hasMipmap    (false),
+m_cacheId      (getUniqueId()),
+m_loadingImage (NULL),
+m_upload       (0),
+m_reduction    (0),
+m_useCount     (0),
+m_accountedSize(0),
+m_category     (ResourceMemory::Textures),
+m_restorable   (false),
+m_sourceFile   (),
+m_sourceArea   (),
+m_compressed   (false),
+m_sourcePixels ()
 {
-    if (copy.m_texture)
-        loadFromImage(copy.copyToImage());
+    // Copy the pixels on the graphics card, without reading them back
+    if (copy.m_texture && create(copy.m_size.x, copy.m_size.y, copy.m_format))
+        update(copy);
+
+    // The source describes the copied pixels as well, they don't have to be read back
+    m_restorable   = copy.m_restorable;
+    m_sourceFile   = copy.m_sourceFile;
+    m_sourceArea   = copy.m_sourceArea;
+    m_compressed   = copy.m_compressed;
+    m_sourcePixels = copy.m_sourcePixels;
 }
 
 
 ////////////////////////////////////////////////////////////
 Texture::~Texture()
 {
-    // Destroy the OpenGL texture
+    // Stop the background loading before the texture disappears
+    cancelLoading();
+
+    // Destroy the OpenGL texture (unless it was lost with the contexts, its identifier may name another texture now)
     if (m_texture)
     {
         ensureGlContext();
 
-        GLuint texture = static_cast<GLuint>(m_texture);
-        glCheck(glDeleteTextures(1, &texture));
+        if (m_generation == Context::getGeneration())
+        {
+            GLuint texture = static_cast<GLuint>(m_texture);
+            glCheck(glDeleteTextures(1, &texture));
+            priv::notifyTextureDeleted();
+        }
+
+        m_texture = 0;
+        updateAccounting();
     }
 }
 
 
 ////////////////////////////////////////////////////////////
-bool Texture::create(unsigned int width, unsigned int height)
+bool Texture::create(unsigned int width, unsigned int height, PixelFormat::Type format)
 {
     // Check if texture parameters are valid before creating it
     if ((width == 0) || (height == 0))
@@ -136,20 +329,35 @@ bool Texture::create(unsigned int width, unsigned int height)
         return false;
     }
 
+    // Check the format of the pixels
+    if (!isPixelFormatSupported(format))
+    {
+        err() << "Failed to create texture, its pixel format is not supported by the graphics driver" << std::endl;
+        return false;
+    }
+
+    // A swizzle set for the previous format of the storage must be removed
+    bool resetSwizzle = m_texture && getTextureFormat(m_format).alphaSwizzle && !getTextureFormat(format).alphaSwizzle;
+
     // All the validity checks passed, we can store the new texture settings
     m_size.x        = width;
     m_size.y        = height;
     m_actualSize    = actualSize;
+    m_format        = format;
     m_pixelsFlipped = false;
+    m_hasMipmap     = false;
+    m_reduction     = 0;
 
     ensureGlContext();
 
-    // Create the OpenGL texture if it doesn't exist yet
-    if (!m_texture)
+    // Create the OpenGL texture if it doesn't exist yet, or was lost with the contexts
+    Uint32 generation = Context::getGeneration();
+    if (!m_texture || (m_generation != generation))
     {
         GLuint texture;
         glCheck(glGenTextures(1, &texture));
         m_texture = static_cast<unsigned int>(texture);
+        m_generation = generation;
     }
 
     // Make sure that extensions are initialized
@@ -173,13 +381,20 @@ bool Texture::create(unsigned int width, unsigned int height)
     }
 
     // Initialize the texture
-    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-    glCheck(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_actualSize.x, m_actualSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+    TextureFormat glFormat = getTextureFormat(m_format);
+    priv::bindTexture(GL_TEXTURE_2D, m_texture);
+    glCheck(glTexImage2D(GL_TEXTURE_2D, 0, glFormat.internalFormat, m_actualSize.x, m_actualSize.y, 0, glFormat.format, glFormat.type, NULL));
+    setSwizzle(glFormat, resetSwizzle);
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_isRepeated ? GL_REPEAT : (GLEXT_texture_edge_clamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_isRepeated ? GL_REPEAT : (GLEXT_texture_edge_clamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
     m_cacheId = getUniqueId();
+    updateAccounting();
+
+    // The new storage is blank
+    m_sourceFile.clear();
+    m_sourcePixels.clear();
 
     return true;
 }
@@ -188,15 +403,120 @@ bool Texture::create(unsigned int width, unsigned int height)
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromFile(const std::string& filename, const IntRect& area)
 {
+    cancelLoading();
+
+    // Only the area is decoded, when the format allows it;
+    // gray levels are kept as they are, they are stored natively
     Image image;
-    return image.loadFromFile(filename) && loadFromImage(image, area);
+    image.setExpandOnLoad(false);
+
+    // A restorable texture reads the file again instead of keeping a copy of its pixels
+    bool restorable = m_restorable;
+    m_restorable = false;
+    bool loaded = image.loadFromFile(filename, area) && loadFromImage(image);
+    m_restorable = restorable;
+
+    if (loaded)
+    {
+        m_sourceFile = filename;
+        m_sourceArea = area;
+        m_compressed = false;
+    }
+
+    return loaded;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::loadFromFileAsync(const std::string& filename, const IntRect& area)
+{
+    cancelLoading();
+
+    m_loadingImage = new Image;
+    m_loadingImage->setExpandOnLoad(false);
+    m_loadingArea = area;
+
+    return m_loadingImage->loadFromFileAsync(filename);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::loadFromImageAsync(const Image& image, const IntRect& area)
+{
+    cancelLoading();
+
+    if (!priv::TextureUploader::isAvailable())
+        return loadFromImage(image, area);
+
+    m_upload = priv::TextureUploader::getInstance().add(new Image(image), area, m_isSmooth, m_isRepeated);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::isReady()
+{
+    if (m_upload)
+    {
+        ensureGlContext();
+
+        Texture* texture = NULL;
+        if (!priv::TextureUploader::getInstance().take(m_upload, texture))
+            return false;
+
+        m_upload = 0;
+        if (texture)
+        {
+            // The settings changed during the upload apply to the new texture
+            Uint64 useCount = m_useCount;
+            texture->setSmooth(m_isSmooth);
+            texture->setRepeated(m_isRepeated);
+            texture->setRestorable(m_restorable);
+            swap(*texture);
+            m_useCount = useCount;
+            delete texture;
+
+            // The pixels written by another context are seen by this one after the texture is bound again
+            priv::TextureSaver save;
+            priv::bindTexture(GL_TEXTURE_2D, m_texture, true);
+        }
+
+        return true;
+    }
+
+    if (!m_loadingImage)
+        return true;
+
+    if (!m_loadingImage->isReady())
+        return false;
+
+    Image* image = m_loadingImage;
+    m_loadingImage = NULL;
+    if ((image->getSize().x > 0) && (image->getSize().y > 0))
+    {
+        // Upload the decoded pixels in the background if possible, on this thread otherwise
+        if (priv::TextureUploader::isAvailable())
+        {
+            m_upload = priv::TextureUploader::getInstance().add(image, m_loadingArea, m_isSmooth, m_isRepeated);
+            return false;
+        }
+
+        loadFromImage(*image, m_loadingArea);
+    }
+    delete image;
+
+    return true;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromMemory(const void* data, std::size_t size, const IntRect& area)
 {
+    cancelLoading();
+
     Image image;
+    image.setExpandOnLoad(false);
     return image.loadFromMemory(data, size) && loadFromImage(image, area);
 }
 
@@ -204,24 +524,71 @@ bool Texture::loadFromMemory(const void* data, std::size_t size, const IntRect&
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromStream(InputStream& stream, const IntRect& area)
 {
+    cancelLoading();
+
     Image image;
+    image.setExpandOnLoad(false);
     return image.loadFromStream(stream) && loadFromImage(image, area);
 }
 
 
+////////////////////////////////////////////////////////////
+bool Texture::loadFromCompressedFile(const std::string& filename)
+{
+    cancelLoading();
+
+    priv::CompressedImage image;
+    if (!priv::CompressedImageLoader::getInstance().loadFromFile(filename, image) || !loadFromCompressedImage(image))
+        return false;
+
+    // Compressed blocks can't be copied to the QOI format, a restorable texture reads the file again
+    m_sourceFile = filename;
+    m_sourceArea = IntRect();
+    m_compressed = true;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::loadFromCompressedMemory(const void* data, std::size_t size)
+{
+    cancelLoading();
+
+    priv::CompressedImage image;
+    return priv::CompressedImageLoader::getInstance().loadFromMemory(data, size, image) && loadFromCompressedImage(image);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::loadFromCompressedStream(InputStream& stream)
+{
+    cancelLoading();
+
+    priv::CompressedImage image;
+    return priv::CompressedImageLoader::getInstance().loadFromStream(stream, image) && loadFromCompressedImage(image);
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromImage(const Image& image, const IntRect& area)
 {
+    cancelLoading();
+
     // Retrieve the image size
     int width = static_cast<int>(image.getSize().x);
     int height = static_cast<int>(image.getSize().y);
 
+    // Keep the format of the image if the driver supports it
+    ensureGlContext();
+    PixelFormat::Type format = isPixelFormatSupported(image.getFormat()) ? image.getFormat() : PixelFormat::RGBA8;
+
     // Load the entire image if the source area is either empty or contains the whole image
     if (area.width == 0 || (area.height == 0) ||
        ((area.left <= 0) && (area.top <= 0) && (area.width >= width) && (area.height >= height)))
     {
         // Load the entire image
-        if (create(image.getSize().x, image.getSize().y))
+        if (create(image.getSize().x, image.getSize().y, format))
         {
             update(image);
 
@@ -248,19 +615,34 @@ bool Texture::loadFromImage(const Image& image, const IntRect& area)
         if (rectangle.top + rectangle.height > height) rectangle.height = height - rectangle.top;
 
         // Create the texture and upload the pixels
-        if (create(rectangle.width, rectangle.height))
+        if (create(rectangle.width, rectangle.height, format))
         {
             // Make sure that the current texture binding will be preserved
             priv::TextureSaver save;
 
+            // The pixels are uploaded in the format of the texture
+            Image converted;
+            const Image* source = &image;
+            if (image.getFormat() != format)
+            {
+                converted = image;
+                converted.convert(format);
+                source = &converted;
+            }
+
             // Copy the pixels to the texture, row by row
-            const Uint8* pixels = image.getPixelsPtr() + 4 * (rectangle.left + (width * rectangle.top));
-            glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+            TextureFormat glFormat = getTextureFormat(format);
+            int pixelSize = static_cast<int>(PixelFormat::getPixelSize(format));
+            const Uint8* pixels = source->getPixelsPtr() + pixelSize * (rectangle.left + (width * rectangle.top));
+            updateSource(pixels, rectangle.width, rectangle.height, 0, 0, pixelSize * width);
+            priv::bindTexture(GL_TEXTURE_2D, m_texture);
+            setRowAlignment(GL_UNPACK_ALIGNMENT, format, true);
             for (int i = 0; i < rectangle.height; ++i)
             {
-                glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, i, rectangle.width, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
-                pixels += 4 * width;
+                glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, i, rectangle.width, 1, glFormat.format, glFormat.type, pixels));
+                pixels += pixelSize * width;
             }
+            setRowAlignment(GL_UNPACK_ALIGNMENT, format, false);
 
             // Force an OpenGL flush, so that the texture will appear updated
             // in all contexts immediately (solves problems in multi-threaded apps)
@@ -283,6 +665,13 @@ Vector2u Texture::getSize() const
 }
 
 
+////////////////////////////////////////////////////////////
+PixelFormat::Type Texture::getFormat() const
+{
+    return m_format;
+}
+
+
 ////////////////////////////////////////////////////////////
 Image Texture::copyToImage() const
 {
@@ -292,11 +681,15 @@ Image Texture::copyToImage() const
 
     ensureGlContext();
 
+    // The storage is only modified if it was lost, the pixels are logically the same
+    const_cast<Texture*>(this)->restore();
+
     // Make sure that the current texture binding will be preserved
     priv::TextureSaver save;
 
     // Create an array of pixels
-    std::vector<Uint8> pixels(m_size.x * m_size.y * 4);
+    std::size_t pixelSize = PixelFormat::getPixelSize(m_format);
+    std::vector<Uint8> pixels(m_size.x * m_size.y * pixelSize);
 
 #ifdef SFML_OPENGL_ES
 
@@ -311,7 +704,10 @@ Image Texture::copyToImage() const
 
         glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, frameBuffer));
         glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_texture, 0));
-        glCheck(glReadPixels(0, 0, m_size.x, m_size.y, GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]));
+        // Only RGBA pixels can be read in all the implementations, they are converted afterwards
+        std::vector<Uint8> rgba(m_size.x * m_size.y * 4);
+        glCheck(glReadPixels(0, 0, m_size.x, m_size.y, GL_RGBA, GL_UNSIGNED_BYTE, &rgba[0]));
+        priv::convertPixels(&pixels[0], m_format, &rgba[0], PixelFormat::RGBA8, m_size.x * m_size.y);
         glCheck(GLEXT_glDeleteFramebuffers(1, &frameBuffer));
 
         glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, previousFrameBuffer));
@@ -319,26 +715,29 @@ Image Texture::copyToImage() const
 
 #else
 
+    TextureFormat glFormat = getTextureFormat(m_format);
+    setRowAlignment(GL_PACK_ALIGNMENT, m_format, true);
+
     if ((m_size == m_actualSize) && !m_pixelsFlipped)
     {
         // Texture is not padded nor flipped, we can use a direct copy
-        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-        glCheck(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]));
+        priv::bindTexture(GL_TEXTURE_2D, m_texture);
+        glCheck(glGetTexImage(GL_TEXTURE_2D, 0, glFormat.format, glFormat.type, &pixels[0]));
     }
     else
     {
         // Texture is either padded or flipped, we have to use a slower algorithm
 
         // All the pixels will first be copied to a temporary array
-        std::vector<Uint8> allPixels(m_actualSize.x * m_actualSize.y * 4);
-        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-        glCheck(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, &allPixels[0]));
+        std::vector<Uint8> allPixels(m_actualSize.x * m_actualSize.y * pixelSize);
+        priv::bindTexture(GL_TEXTURE_2D, m_texture);
+        glCheck(glGetTexImage(GL_TEXTURE_2D, 0, glFormat.format, glFormat.type, &allPixels[0]));
 
         // Then we copy the useful pixels from the temporary array to the final one
         const Uint8* src = &allPixels[0];
         Uint8* dst = &pixels[0];
-        int srcPitch = m_actualSize.x * 4;
-        int dstPitch = m_size.x * 4;
+        int srcPitch = static_cast<int>(m_actualSize.x * pixelSize);
+        int dstPitch = static_cast<int>(m_size.x * pixelSize);
 
         // Handle the case where source pixels are flipped vertically
         if (m_pixelsFlipped)
@@ -355,11 +754,13 @@ Image Texture::copyToImage() const
         }
     }
 
+    setRowAlignment(GL_PACK_ALIGNMENT, m_format, false);
+
 #endif // SFML_OPENGL_ES
 
     // Create the image
     Image image;
-    image.create(m_size.x, m_size.y, &pixels[0]);
+    image.create(m_size.x, m_size.y, &pixels[0], m_format);
 
     return image;
 }
@@ -376,21 +777,29 @@ void Texture::update(const Uint8* pixels)
 ////////////////////////////////////////////////////////////
 void Texture::update(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y)
 {
+    SFML_PROFILE_SCOPE("Texture::update");
+
     assert(x + width <= m_size.x);
     assert(y + height <= m_size.y);
 
     if (pixels && m_texture)
     {
         ensureGlContext();
+        restore();
 
         // Make sure that the current texture binding will be preserved
         priv::TextureSaver save;
 
         // Copy pixels from the given array to the texture
-        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-        glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+        TextureFormat glFormat = getTextureFormat(m_format);
+        priv::bindTexture(GL_TEXTURE_2D, m_texture);
+        setRowAlignment(GL_UNPACK_ALIGNMENT, m_format, true);
+        glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, glFormat.format, glFormat.type, pixels));
+        setRowAlignment(GL_UNPACK_ALIGNMENT, m_format, false);
+        invalidateMipmap();
         m_pixelsFlipped = false;
         m_cacheId = getUniqueId();
+        updateSource(pixels, width, height, x, y);
     }
 }
 
@@ -399,13 +808,22 @@ void Texture::update(const Uint8* pixels, unsigned int width, unsigned int heigh
 void Texture::update(const Image& image)
 {
     // Update the whole texture
-    update(image.getPixelsPtr(), image.getSize().x, image.getSize().y, 0, 0);
+    update(image, 0, 0);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Texture::update(const Image& image, unsigned int x, unsigned int y)
 {
+    // The pixels are uploaded in the format of the texture
+    if ((image.getFormat() != m_format) && (image.getSize().x > 0) && (image.getSize().y > 0))
+    {
+        Image converted(image);
+        converted.convert(m_format);
+        update(converted.getPixelsPtr(), converted.getSize().x, converted.getSize().y, x, y);
+        return;
+    }
+
     update(image.getPixelsPtr(), image.getSize().x, image.getSize().y, x, y);
 }
 
@@ -425,15 +843,53 @@ void Texture::update(const Window& window, unsigned int x, unsigned int y)
 
     if (m_texture && window.setActive(true))
     {
+        restore();
+
         // Make sure that the current texture binding will be preserved
         priv::TextureSaver save;
 
         // Copy pixels from the back-buffer to the texture
-        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+        priv::bindTexture(GL_TEXTURE_2D, m_texture);
         glCheck(glCopyTexSubImage2D(GL_TEXTURE_2D, 0, x, y, 0, 0, window.getSize().x, window.getSize().y));
+        invalidateMipmap();
         m_pixelsFlipped = true;
         m_cacheId = getUniqueId();
+        updateSource(NULL, 0, 0, 0, 0);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::update(const Texture& texture)
+{
+    update(texture, 0, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::update(const Texture& texture, unsigned int x, unsigned int y)
+{
+    assert(x + texture.m_size.x <= m_size.x);
+    assert(y + texture.m_size.y <= m_size.y);
+
+    if (!m_texture || !texture.m_texture)
+        return;
+
+    ensureGlContext();
+    restore();
+    const_cast<Texture&>(texture).restore();
+
+    // Flipped pixels would have to be flipped back, which a plain copy can't do
+    if (texture.m_pixelsFlipped || !copyPixels(texture, *this, texture.m_size, Vector2u(x, y), NULL))
+    {
+        update(texture.copyToImage(), x, y);
+        return;
     }
+
+    invalidateMipmap();
+    m_pixelsFlipped = false;
+    m_cacheId = getUniqueId();
+    updateSource(NULL, 0, 0, 0, 0);
 }
 
 
@@ -447,13 +903,22 @@ void Texture::setSmooth(bool smooth)
         if (m_texture)
         {
             ensureGlContext();
+            restore();
 
             // Make sure that the current texture binding will be preserved
             priv::TextureSaver save;
 
-            glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+            priv::bindTexture(GL_TEXTURE_2D, m_texture);
             glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
-            glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+
+            if (m_hasMipmap)
+            {
+                glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR));
+            }
+            else
+            {
+                glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+            }
         }
     }
 }
@@ -476,6 +941,7 @@ void Texture::setRepeated(bool repeated)
         if (m_texture)
         {
             ensureGlContext();
+            restore();
 
             // Make sure that the current texture binding will be preserved
             priv::TextureSaver save;
@@ -494,7 +960,7 @@ void Texture::setRepeated(bool repeated)
                 }
             }
 
-            glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+            priv::bindTexture(GL_TEXTURE_2D, m_texture);
             glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_isRepeated ? GL_REPEAT : (GLEXT_texture_edge_clamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
             glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_isRepeated ? GL_REPEAT : (GLEXT_texture_edge_clamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
         }
@@ -509,6 +975,62 @@ bool Texture::isRepeated() const
 }
 
 
+////////////////////////////////////////////////////////////
+void Texture::setRestorable(bool restorable)
+{
+    if (restorable == m_restorable)
+        return;
+
+    m_restorable = restorable;
+
+    if (!m_restorable)
+    {
+        std::vector<Uint8>().swap(m_sourcePixels);
+    }
+    else if (m_texture && m_sourceFile.empty())
+    {
+        // The pixels uploaded so far are only known by the texture
+        updateSource(NULL, 0, 0, 0, 0);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::isRestorable() const
+{
+    return m_restorable;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::generateMipmap()
+{
+    if (!m_texture)
+        return false;
+
+    ensureGlContext();
+    restore();
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    if (!GLEXT_framebuffer_object)
+        return false;
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    priv::bindTexture(GL_TEXTURE_2D, m_texture);
+    glCheck(GLEXT_glGenerateMipmap(GL_TEXTURE_2D));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR));
+
+    m_hasMipmap = true;
+    updateAccounting();
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::bind(const Texture* texture, CoordinateType coordinateType)
 {
@@ -516,31 +1038,17 @@ void Texture::bind(const Texture* texture, CoordinateType coordinateType)
 
     if (texture && texture->m_texture)
     {
+        // A texture lost with the contexts is recreated on first use, the pixels are logically the same
+        const_cast<Texture*>(texture)->restore();
+
         // Bind the texture
-        glCheck(glBindTexture(GL_TEXTURE_2D, texture->m_texture));
+        priv::bindTexture(GL_TEXTURE_2D, texture->m_texture, true);
 
-        // Check if we need to define a special texture matrix
-        if ((coordinateType == Pixels) || texture->m_pixelsFlipped)
+        // Check if we need to define a special texture matrix (core profiles have no matrix stack)
+        if (((coordinateType == Pixels) || texture->m_pixelsFlipped) && !priv::isCoreProfile())
         {
-            GLfloat matrix[16] = {1.f, 0.f, 0.f, 0.f,
-                                  0.f, 1.f, 0.f, 0.f,
-                                  0.f, 0.f, 1.f, 0.f,
-                                  0.f, 0.f, 0.f, 1.f};
-
-            // If non-normalized coordinates (= pixels) are requested, we need to
-            // setup scale factors that convert the range [0 .. size] to [0 .. 1]
-            if (coordinateType == Pixels)
-            {
-                matrix[0] = 1.f / texture->m_actualSize.x;
-                matrix[5] = 1.f / texture->m_actualSize.y;
-            }
-
-            // If pixels are flipped we must invert the Y axis
-            if (texture->m_pixelsFlipped)
-            {
-                matrix[5] = -matrix[5];
-                matrix[13] = static_cast<float>(texture->m_size.y) / texture->m_actualSize.y;
-            }
+            GLfloat matrix[16];
+            texture->getTextureMatrix(coordinateType, matrix);
 
             // Load the matrix
             glCheck(glMatrixMode(GL_TEXTURE));
@@ -553,14 +1061,17 @@ void Texture::bind(const Texture* texture, CoordinateType coordinateType)
     else
     {
         // Bind no texture
-        glCheck(glBindTexture(GL_TEXTURE_2D, 0));
+        priv::bindTexture(GL_TEXTURE_2D, 0, true);
 
         // Reset the texture matrix
-        glCheck(glMatrixMode(GL_TEXTURE));
-        glCheck(glLoadIdentity());
+        if (!priv::isCoreProfile())
+        {
+            glCheck(glMatrixMode(GL_TEXTURE));
+            glCheck(glLoadIdentity());
 
-        // Go back to model-view mode (sf::RenderTarget relies on it)
-        glCheck(glMatrixMode(GL_MODELVIEW));
+            // Go back to model-view mode (sf::RenderTarget relies on it)
+            glCheck(glMatrixMode(GL_MODELVIEW));
+        }
     }
 }
 
@@ -577,39 +1088,112 @@ unsigned int Texture::getMaximumSize()
 }
 
 
+////////////////////////////////////////////////////////////
+bool Texture::isFormatSupported(PixelFormat::Type format)
+{
+    // Create a temporary context if none is active, like getMaximumSize
+    if (!Context::getActiveContextId())
+    {
+        Context context;
+        return isPixelFormatSupported(format);
+    }
+
+    return isPixelFormatSupported(format);
+}
+
+
 ////////////////////////////////////////////////////////////
 Texture& Texture::operator =(const Texture& right)
 {
     Texture temp(right);
 
-    std::swap(m_size,          temp.m_size);
-    std::swap(m_actualSize,    temp.m_actualSize);
-    std::swap(m_texture,       temp.m_texture);
-    std::swap(m_isSmooth,      temp.m_isSmooth);
-    std::swap(m_isRepeated,    temp.m_isRepeated);
-    std::swap(m_pixelsFlipped, temp.m_pixelsFlipped);
-    m_cacheId = getUniqueId();
+    swap(temp);
+    cancelLoading();
 
     return *this;
 }
 
 
 ////////////////////////////////////////////////////////////
-unsigned int Texture::getNativeHandle() const
+void Texture::swap(Texture& right)
 {
-    return m_texture;
+    std::swap(m_size,          right.m_size);
+    std::swap(m_actualSize,    right.m_actualSize);
+    std::swap(m_format,        right.m_format);
+    std::swap(m_texture,       right.m_texture);
+    std::swap(m_isSmooth,      right.m_isSmooth);
+    std::swap(m_isRepeated,    right.m_isRepeated);
+    std::swap(m_pixelsFlipped, right.m_pixelsFlipped);
+    std::swap(m_hasMipmap,     right.m_hasMipmap);
+    std::swap(m_loadingImage,  right.m_loadingImage);
+    std::swap(m_loadingArea,   right.m_loadingArea);
+    std::swap(m_upload,        right.m_upload);
+    std::swap(m_reduction,     right.m_reduction);
+    std::swap(m_useCount,      right.m_useCount);
+    std::swap(m_generation,    right.m_generation);
+    std::swap(m_restorable,    right.m_restorable);
+    std::swap(m_sourceFile,    right.m_sourceFile);
+    std::swap(m_sourceArea,    right.m_sourceArea);
+    std::swap(m_compressed,    right.m_compressed);
+    std::swap(m_sourcePixels,  right.m_sourcePixels);
+    m_cacheId = getUniqueId();
+    right.m_cacheId = getUniqueId();
+
+    // The accounted sizes stay with their objects, which may be in different categories
+    updateAccounting();
+    right.updateAccounting();
 }
 
 
 ////////////////////////////////////////////////////////////
-unsigned int Texture::getValidSize(unsigned int size)
+unsigned int Texture::getNativeHandle() const
 {
-    ensureGlContext();
+    // The handle given to OpenGL code must be valid in the current generation of the contexts
+    if (m_texture && (m_generation != Context::getGeneration()))
+    {
+        ensureGlContext();
+        const_cast<Texture*>(this)->restore();
+    }
 
-    // Make sure that extensions are initialized
-    priv::ensureExtensionsInit();
+    return m_texture;
+}
 
-    if (GLEXT_texture_non_power_of_two)
+
+////////////////////////////////////////////////////////////
+void Texture::getTextureMatrix(CoordinateType coordinateType, float* matrix) const
+{
+    static const float identity[16] = {1.f, 0.f, 0.f, 0.f,
+                                       0.f, 1.f, 0.f, 0.f,
+                                       0.f, 0.f, 1.f, 0.f,
+                                       0.f, 0.f, 0.f, 1.f};
+    std::memcpy(matrix, identity, sizeof(identity));
+
+    // If non-normalized coordinates (= pixels) are requested, we need to
+    // setup scale factors that convert the range [0 .. size] to [0 .. 1]
+    if (coordinateType == Pixels)
+    {
+        matrix[0] = 1.f / m_actualSize.x;
+        matrix[5] = 1.f / m_actualSize.y;
+    }
+
+    // If pixels are flipped we must invert the Y axis
+    if (m_pixelsFlipped)
+    {
+        matrix[5] = -matrix[5];
+        matrix[13] = static_cast<float>(m_size.y) / m_actualSize.y;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Texture::getValidSize(unsigned int size)
+{
+    ensureGlContext();
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    if (GLEXT_texture_non_power_of_two)
     {
         // If hardware supports NPOT textures, then just return the unmodified size
         return size;
@@ -625,4 +1209,540 @@ unsigned int Texture::getValidSize(unsigned int size)
     }
 }
 
+
+////////////////////////////////////////////////////////////
+void Texture::invalidatePixels()
+{
+    invalidateMipmap();
+
+    m_pixelsFlipped = false;
+    m_cacheId = getUniqueId();
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::invalidateMipmap()
+{
+    if (!m_hasMipmap)
+        return;
+
+    ensureGlContext();
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    priv::bindTexture(GL_TEXTURE_2D, m_texture);
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+
+    m_hasMipmap = false;
+    updateAccounting();
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::resize(unsigned int width, unsigned int height, const Color& background)
+{
+    // Easy case: empty texture
+    if (!m_texture)
+    {
+        Image image;
+        image.create(width, height, background, m_format);
+        return loadFromImage(image);
+    }
+
+    ensureGlContext();
+    restore();
+
+    Texture resized;
+    resized.m_isSmooth = m_isSmooth;
+    resized.m_isRepeated = m_isRepeated;
+    if (!resized.create(width, height, m_format))
+        return false;
+
+    Vector2u size(std::min(m_size.x, width), std::min(m_size.y, height));
+    if (m_pixelsFlipped || !copyPixels(*this, resized, size, Vector2u(0, 0), &background))
+    {
+        // Fallback: go through an image in system memory
+        Image image;
+        image.create(width, height, background, m_format);
+        image.copy(copyToImage(), 0, 0);
+        resized.update(image);
+    }
+
+    std::swap(m_size,       resized.m_size);
+    std::swap(m_actualSize, resized.m_actualSize);
+    std::swap(m_texture,    resized.m_texture);
+    m_pixelsFlipped = false;
+    m_hasMipmap = false;
+    m_cacheId = getUniqueId();
+    updateAccounting();
+    resized.updateAccounting();
+    updateSource(NULL, 0, 0, 0, 0);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::copyPixels(const Texture& source, const Texture& destination, const Vector2u& size,
+                         const Vector2u& position, const Color* background)
+{
+    ensureGlContext();
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    if (!GLEXT_framebuffer_object)
+        return false;
+
+    GLuint frameBuffer = 0;
+    glCheck(GLEXT_glGenFramebuffers(1, &frameBuffer));
+    if (!frameBuffer)
+        return false;
+
+    GLint previousFrameBuffer;
+    glCheck(glGetIntegerv(GLEXT_GL_FRAMEBUFFER_BINDING, &previousFrameBuffer));
+    glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, frameBuffer));
+
+    bool success = true;
+
+    // Clear the destination first if requested, through the same framebuffer
+    if (background)
+    {
+        glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, destination.m_texture, 0));
+        GLenum status = glCheck(GLEXT_glCheckFramebufferStatus(GLEXT_GL_FRAMEBUFFER));
+        success = (status == GLEXT_GL_FRAMEBUFFER_COMPLETE);
+
+        if (success)
+        {
+            GLboolean scissor = glCheck(glIsEnabled(GL_SCISSOR_TEST));
+            GLfloat clearColor[4];
+            glCheck(glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor));
+
+            glCheck(glDisable(GL_SCISSOR_TEST));
+            glCheck(glClearColor(background->r / 255.f, background->g / 255.f, background->b / 255.f, background->a / 255.f));
+            glCheck(glClear(GL_COLOR_BUFFER_BIT));
+
+            glCheck(glClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]));
+            if (scissor)
+            {
+                glCheck(glEnable(GL_SCISSOR_TEST));
+            }
+        }
+    }
+
+    // Copy the pixels, reading them from the framebuffer the source is attached to
+    if (success)
+    {
+        glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, source.m_texture, 0));
+        GLenum status = glCheck(GLEXT_glCheckFramebufferStatus(GLEXT_GL_FRAMEBUFFER));
+        success = (status == GLEXT_GL_FRAMEBUFFER_COMPLETE);
+
+        if (success)
+        {
+            // Make sure that the current texture binding will be preserved
+            priv::TextureSaver save;
+
+            priv::bindTexture(GL_TEXTURE_2D, destination.m_texture);
+            glCheck(glCopyTexSubImage2D(GL_TEXTURE_2D, 0, position.x, position.y, 0, 0, size.x, size.y));
+        }
+    }
+
+    glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, previousFrameBuffer));
+    glCheck(GLEXT_glDeleteFramebuffers(1, &frameBuffer));
+
+    return success;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::loadFromCompressedImage(const priv::CompressedImage& image)
+{
+    unsigned int width = image.size.x;
+    unsigned int height = image.size.y;
+
+    ensureGlContext();
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    if (!isCompressedFormatSupported(image.format))
+    {
+        err() << "Failed to create compressed texture, format 0x" << std::hex << image.format << std::dec
+              << " is not supported by the graphics driver" << std::endl;
+        return false;
+    }
+
+    // Compressed data can't be padded, the size must be valid as it is
+    if ((getValidSize(width) != width) || (getValidSize(height) != height))
+    {
+        err() << "Failed to create compressed texture, its size must be a power of two "
+              << "(" << width << "x" << height << ")" << std::endl;
+        return false;
+    }
+
+    // Check the maximum texture size
+    unsigned int maxSize = getMaximumSize();
+    if ((width > maxSize) || (height > maxSize))
+    {
+        err() << "Failed to create compressed texture, its size is too high "
+              << "(" << width << "x" << height << ", "
+              << "maximum is " << maxSize << "x" << maxSize << ")"
+              << std::endl;
+        return false;
+    }
+
+    // Use the mipmap only if the chain is complete, down to 1x1
+    std::size_t fullChain = 1;
+    for (unsigned int size = std::max(width, height); size > 1; size /= 2)
+        ++fullChain;
+    std::size_t levelCount = (image.levels.size() >= fullChain) ? fullChain : 1;
+
+    // All the validity checks passed, we can store the new texture settings
+    m_size.x        = width;
+    m_size.y        = height;
+    m_actualSize    = m_size;
+    m_pixelsFlipped = false;
+    m_hasMipmap     = (levelCount > 1);
+    m_reduction     = 0;
+
+    // Create the OpenGL texture if it doesn't exist yet, or was lost with the contexts
+    Uint32 generation = Context::getGeneration();
+    if (!m_texture || (m_generation != generation))
+    {
+        GLuint texture;
+        glCheck(glGenTextures(1, &texture));
+        m_texture = static_cast<unsigned int>(texture);
+        m_generation = generation;
+    }
+
+    // Only the files of compressed textures are remembered (see loadFromCompressedFile)
+    m_sourceFile.clear();
+    m_sourcePixels.clear();
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    // Upload the compressed blocks of each level
+    priv::bindTexture(GL_TEXTURE_2D, m_texture);
+    unsigned int levelWidth = width;
+    unsigned int levelHeight = height;
+    for (std::size_t i = 0; i < levelCount; ++i)
+    {
+        const std::vector<Uint8>& level = image.levels[i];
+        glCheck(GLEXT_glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), image.format, levelWidth, levelHeight, 0,
+                                             static_cast<GLsizei>(level.size()), &level[0]));
+
+        levelWidth = std::max(levelWidth / 2, 1u);
+        levelHeight = std::max(levelHeight / 2, 1u);
+    }
+
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_isRepeated ? GL_REPEAT : (GLEXT_texture_edge_clamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_isRepeated ? GL_REPEAT : (GLEXT_texture_edge_clamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+
+    if (m_hasMipmap)
+    {
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR));
+    }
+    else
+    {
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+    }
+
+    m_cacheId = getUniqueId();
+    updateAccounting();
+
+    // Force an OpenGL flush, so that the texture will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::reduce()
+{
+    if (!m_texture)
+        return false;
+
+#ifndef SFML_OPENGL_ES
+
+    ensureGlContext();
+    restore();
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    if (!GLEXT_framebuffer_object || !GLEXT_framebuffer_blit)
+        return false;
+
+    GLint width = static_cast<GLint>(std::max(m_actualSize.x >> m_reduction, 1u));
+    GLint height = static_cast<GLint>(std::max(m_actualSize.y >> m_reduction, 1u));
+    if ((width == 1) && (height == 1))
+        return false;
+
+    GLint reducedWidth = std::max(width / 2, 1);
+    GLint reducedHeight = std::max(height / 2, 1);
+
+    // Create the reduced storage, with the same settings
+    GLuint reduced = 0;
+    glCheck(glGenTextures(1, &reduced));
+    if (!reduced)
+        return false;
+
+    {
+        // Make sure that the current texture binding will be preserved
+        priv::TextureSaver save;
+
+        GLint wrap = m_isRepeated ? GL_REPEAT : (GLEXT_texture_edge_clamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP);
+        TextureFormat glFormat = getTextureFormat(m_format);
+        priv::bindTexture(GL_TEXTURE_2D, reduced);
+        glCheck(glTexImage2D(GL_TEXTURE_2D, 0, glFormat.internalFormat, reducedWidth, reducedHeight, 0, glFormat.format, glFormat.type, NULL));
+        setSwizzle(glFormat, false);
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap));
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap));
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+    }
+
+    // Downsample the current storage into the reduced one, with a filtered blit between two framebuffers
+    GLuint frameBuffers[2] = {0, 0};
+    glCheck(GLEXT_glGenFramebuffers(2, frameBuffers));
+
+    GLint previousFrameBuffer;
+    glCheck(glGetIntegerv(GLEXT_GL_FRAMEBUFFER_BINDING, &previousFrameBuffer));
+
+    glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_READ_FRAMEBUFFER, frameBuffers[0]));
+    glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_READ_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_texture, 0));
+    glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_DRAW_FRAMEBUFFER, frameBuffers[1]));
+    glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_DRAW_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, reduced, 0));
+
+    GLenum readStatus = glCheck(GLEXT_glCheckFramebufferStatus(GLEXT_GL_READ_FRAMEBUFFER));
+    GLenum drawStatus = glCheck(GLEXT_glCheckFramebufferStatus(GLEXT_GL_DRAW_FRAMEBUFFER));
+    bool success = (readStatus == GLEXT_GL_FRAMEBUFFER_COMPLETE) && (drawStatus == GLEXT_GL_FRAMEBUFFER_COMPLETE);
+
+    if (success)
+    {
+        // The scissor test applies to blits too
+        GLboolean scissor = glCheck(glIsEnabled(GL_SCISSOR_TEST));
+        glCheck(glDisable(GL_SCISSOR_TEST));
+
+        glCheck(GLEXT_glBlitFramebuffer(0, 0, width, height, 0, 0, reducedWidth, reducedHeight, GL_COLOR_BUFFER_BIT, GL_LINEAR));
+
+        if (scissor)
+        {
+            glCheck(glEnable(GL_SCISSOR_TEST));
+        }
+    }
+
+    glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, previousFrameBuffer));
+    glCheck(GLEXT_glDeleteFramebuffers(2, frameBuffers));
+
+    // Replace the storage, or discard the reduced one if the blit was impossible
+    GLuint texture = success ? static_cast<GLuint>(m_texture) : reduced;
+    glCheck(glDeleteTextures(1, &texture));
+    priv::notifyTextureDeleted();
+
+    if (!success)
+        return false;
+
+    m_texture = static_cast<unsigned int>(reduced);
+    m_hasMipmap = false;
+    m_cacheId = getUniqueId();
+    ++m_reduction;
+    updateAccounting();
+
+    return true;
+
+#else
+
+    return false;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::release()
+{
+    if (!m_texture)
+        return;
+
+    ensureGlContext();
+
+    // A texture lost with the contexts has nothing to delete
+    if (m_generation == Context::getGeneration())
+    {
+        GLuint texture = static_cast<GLuint>(m_texture);
+        glCheck(glDeleteTextures(1, &texture));
+        priv::notifyTextureDeleted();
+    }
+
+    m_texture = 0;
+    m_hasMipmap = false;
+    m_reduction = 0;
+    m_cacheId = getUniqueId();
+    updateAccounting();
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Texture::getStorageSize() const
+{
+    if (!m_texture)
+        return 0;
+
+    Uint64 width = std::max(m_actualSize.x >> m_reduction, 1u);
+    Uint64 height = std::max(m_actualSize.y >> m_reduction, 1u);
+    Uint64 size = width * height * PixelFormat::getPixelSize(m_format);
+
+    // A full chain of mipmaps adds a third of the base level
+    return m_hasMipmap ? size + size / 3 : size;
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::updateAccounting()
+{
+    Uint64 size = getStorageSize();
+    if (size == m_accountedSize)
+        return;
+
+    // A texture counts as an object while it has a storage
+    Int64 objects = (m_accountedSize == 0) ? 1 : ((size == 0) ? -1 : 0);
+    ResourceMemory::record(m_category, objects, static_cast<Int64>(size) - static_cast<Int64>(m_accountedSize), 0);
+    m_accountedSize = size;
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::setAccountingCategory(ResourceMemory::Category category)
+{
+    if (category == m_category)
+        return;
+
+    if (m_accountedSize > 0)
+    {
+        ResourceMemory::record(m_category, -1, -static_cast<Int64>(m_accountedSize), 0);
+        ResourceMemory::record(category, 1, static_cast<Int64>(m_accountedSize), 0);
+    }
+
+    m_category = category;
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::cancelLoading()
+{
+    // The image stops its own background loading
+    delete m_loadingImage;
+    m_loadingImage = NULL;
+
+    if (m_upload)
+    {
+        priv::TextureUploader::getInstance().cancel(m_upload);
+        m_upload = 0;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::updateSource(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y, std::size_t pitch)
+{
+    // The file doesn't describe the pixels anymore
+    bool loadedFromFile = !m_sourceFile.empty();
+    m_sourceFile.clear();
+
+    if (!m_restorable || !m_texture)
+        return;
+
+    std::vector<Uint8> rgba;
+    Vector2u size;
+
+    if (!pixels || loadedFromFile)
+    {
+        // The pixels are only known by the texture, they are read back (with the new ones)
+        Image image = copyToImage();
+        image.convert(PixelFormat::RGBA8);
+        const Uint8* data = image.getPixelsPtr();
+        rgba.assign(data, data + image.getSize().x * image.getSize().y * 4);
+    }
+    else
+    {
+        // The new pixels are written over the previous copy, or over a blank texture
+        if (m_sourcePixels.empty() || !priv::decodeQoi(&m_sourcePixels[0], m_sourcePixels.size(), rgba, size) || (size != m_size))
+            rgba.assign(m_size.x * m_size.y * 4, 0);
+
+        if (!pitch)
+            pitch = width * PixelFormat::getPixelSize(m_format);
+
+        for (unsigned int i = 0; i < height; ++i)
+            priv::convertPixels(&rgba[((y + i) * m_size.x + x) * 4], PixelFormat::RGBA8, pixels + i * pitch, m_format, width);
+    }
+
+    priv::encodeQoi(rgba, m_size, m_sourcePixels);
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::restore()
+{
+    Uint32 generation = Context::getGeneration();
+    if (m_generation == generation)
+        return;
+
+    m_generation = generation;
+    if (!m_texture)
+        return;
+
+    // The identifier belonged to the lost contexts: it must not be deleted, it may name another texture now
+    m_texture = 0;
+    bool hasMipmap = m_hasMipmap;
+
+    // The source is put aside while the storage is created again and filled, so that it's not reset
+    std::string file;
+    std::vector<Uint8> pixels;
+    file.swap(m_sourceFile);
+    pixels.swap(m_sourcePixels);
+    bool restorable = m_restorable;
+    m_restorable = false;
+
+    priv::CompressedImage compressed;
+    if (restorable && m_compressed && !file.empty() &&
+        priv::CompressedImageLoader::getInstance().loadFromFile(file, compressed) && loadFromCompressedImage(compressed))
+    {
+        // The mipmap levels were restored with the file
+    }
+    else if (create(m_size.x, m_size.y, m_format) && restorable)
+    {
+        Image image;
+        if (!file.empty())
+        {
+            image.setExpandOnLoad(false);
+            image.loadFromFile(file, m_sourceArea);
+        }
+        else if (!pixels.empty())
+        {
+            std::vector<Uint8> rgba;
+            Vector2u size;
+            if (priv::decodeQoi(&pixels[0], pixels.size(), rgba, size))
+                image.create(size.x, size.y, &rgba[0]);
+        }
+
+        // The file may have changed since it was loaded
+        if (image.getSize() == m_size)
+        {
+            update(image);
+            if (hasMipmap)
+                generateMipmap();
+        }
+    }
+
+    m_restorable = restorable;
+    m_sourceFile.swap(file);
+    m_sourcePixels.swap(pixels);
+}
+
 } // namespace sf
@@ -0,0 +1,376 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureArray.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/TextureSaver.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <cassert>
+
+
+namespace
+{
+    sf::Mutex mutex;
+
+    bool checkTextureArraysAvailable()
+    {
+        // Create a temporary context in case the user checks
+        // before a GlResource is created, thus initializing
+        // the shared context
+        sf::Context context;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+    #ifndef SFML_OPENGL_ES
+        return GLEXT_texture3D && GLEXT_texture_array;
+    #else
+        return false;
+    #endif
+    }
+
+    unsigned int checkMaximumLayerCount()
+    {
+        sf::Context context;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        GLint count = 0;
+
+    #ifndef SFML_OPENGL_ES
+        if (GLEXT_texture_array)
+        {
+            glCheck(glGetIntegerv(GLEXT_GL_MAX_ARRAY_TEXTURE_LAYERS, &count));
+        }
+    #endif
+
+        return static_cast<unsigned int>(count);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextureArray::TextureArray() :
+m_size      (0, 0),
+m_layerCount(0),
+m_texture   (0),
+m_isSmooth  (false),
+m_isRepeated(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureArray::~TextureArray()
+{
+    // Destroy the OpenGL texture
+    if (m_texture)
+    {
+        ensureGlContext();
+
+        GLuint texture = static_cast<GLuint>(m_texture);
+        glCheck(glDeleteTextures(1, &texture));
+        priv::notifyTextureDeleted();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::create(unsigned int width, unsigned int height, unsigned int layers)
+{
+    if (!isAvailable())
+    {
+        err() << "Failed to create texture array, texture arrays are not available on this system" << std::endl;
+        return false;
+    }
+
+    // Check if texture parameters are valid before creating it
+    if ((width == 0) || (height == 0) || (layers == 0))
+    {
+        err() << "Failed to create texture array, invalid size (" << width << "x" << height << "x" << layers << ")" << std::endl;
+        return false;
+    }
+
+    // Check the maximum sizes
+    unsigned int maxSize = Texture::getMaximumSize();
+    unsigned int maxLayers = getMaximumLayerCount();
+    if ((width > maxSize) || (height > maxSize) || (layers > maxLayers))
+    {
+        err() << "Failed to create texture array, its size is too high "
+              << "(" << width << "x" << height << "x" << layers << ", "
+              << "maximum is " << maxSize << "x" << maxSize << "x" << maxLayers << ")"
+              << std::endl;
+        return false;
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    ensureGlContext();
+
+    // Create the OpenGL texture if it doesn't exist yet
+    if (!m_texture)
+    {
+        GLuint texture;
+        glCheck(glGenTextures(1, &texture));
+        m_texture = static_cast<unsigned int>(texture);
+    }
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save(GLEXT_GL_TEXTURE_2D_ARRAY, GLEXT_GL_TEXTURE_BINDING_2D_ARRAY);
+
+    // Initialize the texture array
+    priv::bindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, m_texture);
+    glCheck(GLEXT_glTexImage3D(GLEXT_GL_TEXTURE_2D_ARRAY, 0, GL_RGBA, width, height, layers, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+    applyParameters();
+
+    // All the operations succeeded, we can store the new texture array settings
+    m_size.x     = width;
+    m_size.y     = height;
+    m_layerCount = layers;
+
+    return true;
+
+#else
+
+    return false;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TextureArray::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureArray::getLayerCount() const
+{
+    return m_layerCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::update(const Uint8* pixels, unsigned int layer)
+{
+    // Update the whole layer
+    update(pixels, m_size.x, m_size.y, 0, 0, layer);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::update(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y, unsigned int layer)
+{
+    assert(x + width <= m_size.x);
+    assert(y + height <= m_size.y);
+    assert(layer < m_layerCount);
+
+#ifndef SFML_OPENGL_ES
+
+    if (pixels && m_texture)
+    {
+        ensureGlContext();
+
+        // Make sure that the current texture binding will be preserved
+        priv::TextureSaver save(GLEXT_GL_TEXTURE_2D_ARRAY, GLEXT_GL_TEXTURE_BINDING_2D_ARRAY);
+
+        // Copy pixels from the given array to the layer
+        priv::bindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, m_texture);
+        glCheck(GLEXT_glTexSubImage3D(GLEXT_GL_TEXTURE_2D_ARRAY, 0, x, y, layer, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+    }
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::update(const Image& image, unsigned int layer)
+{
+    update(image, 0, 0, layer);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::update(const Image& image, unsigned int x, unsigned int y, unsigned int layer)
+{
+    // The layers store RGBA pixels
+    if ((image.getFormat() != PixelFormat::RGBA8) && (image.getSize().x > 0) && (image.getSize().y > 0))
+    {
+        Image rgba(image);
+        rgba.convert(PixelFormat::RGBA8);
+        update(rgba.getPixelsPtr(), rgba.getSize().x, rgba.getSize().y, x, y, layer);
+        return;
+    }
+
+    update(image.getPixelsPtr(), image.getSize().x, image.getSize().y, x, y, layer);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::setSmooth(bool smooth)
+{
+    if (smooth != m_isSmooth)
+    {
+        m_isSmooth = smooth;
+
+#ifndef SFML_OPENGL_ES
+
+        if (m_texture)
+        {
+            ensureGlContext();
+
+            // Make sure that the current texture binding will be preserved
+            priv::TextureSaver save(GLEXT_GL_TEXTURE_2D_ARRAY, GLEXT_GL_TEXTURE_BINDING_2D_ARRAY);
+
+            priv::bindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, m_texture);
+            applyParameters();
+        }
+
+#endif
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::isSmooth() const
+{
+    return m_isSmooth;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::setRepeated(bool repeated)
+{
+    if (repeated != m_isRepeated)
+    {
+        m_isRepeated = repeated;
+
+#ifndef SFML_OPENGL_ES
+
+        if (m_texture)
+        {
+            ensureGlContext();
+
+            // Make sure that the current texture binding will be preserved
+            priv::TextureSaver save(GLEXT_GL_TEXTURE_2D_ARRAY, GLEXT_GL_TEXTURE_BINDING_2D_ARRAY);
+
+            priv::bindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, m_texture);
+            applyParameters();
+        }
+
+#endif
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::isRepeated() const
+{
+    return m_isRepeated;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureArray::getNativeHandle() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::bind(const TextureArray* textureArray)
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!isAvailable())
+        return;
+
+    ensureGlContext();
+
+    if (textureArray && textureArray->m_texture)
+    {
+        priv::bindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, textureArray->m_texture, true);
+    }
+    else
+    {
+        priv::bindTexture(GLEXT_GL_TEXTURE_2D_ARRAY, 0, true);
+    }
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureArray::getMaximumLayerCount()
+{
+    // TODO: Remove this lock when it becomes unnecessary in C++11
+    Lock lock(mutex);
+
+    static unsigned int count = checkMaximumLayerCount();
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureArray::isAvailable()
+{
+    // TODO: Remove this lock when it becomes unnecessary in C++11
+    Lock lock(mutex);
+
+    static bool available = checkTextureArraysAvailable();
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureArray::applyParameters() const
+{
+#ifndef SFML_OPENGL_ES
+
+    // Texture arrays require OpenGL 3.0 class hardware, which always supports edge clamping
+    GLint wrap = m_isRepeated ? GL_REPEAT : GLEXT_GL_CLAMP_TO_EDGE;
+    glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, wrap));
+    glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, wrap));
+    glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+    glCheck(glTexParameteri(GLEXT_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+
+#endif
+}
+
+} // namespace sf
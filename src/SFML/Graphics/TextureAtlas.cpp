@@ -0,0 +1,340 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureAtlas.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct TextureAtlas::Page
+{
+    Texture              texture;  ///< Texture containing the packed images
+    std::vector<Segment> skyline;  ///< Top edge of the occupied area, from left to right
+};
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::Region::Region() :
+texture(NULL),
+page   (0),
+rect   ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::Segment::Segment(unsigned int x, unsigned int y, unsigned int width) :
+x    (x),
+y    (y),
+width(width)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::TextureAtlas(unsigned int pageSize, unsigned int padding) :
+m_pages   (),
+m_pageSize(std::max(pageSize, 1u)),
+m_padding (padding),
+m_isSmooth(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::~TextureAtlas()
+{
+    clear();
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::add(const Image& image, Region& region)
+{
+    unsigned int width = image.getSize().x;
+    unsigned int height = image.getSize().y;
+    if ((width == 0) || (height == 0))
+    {
+        err() << "Failed to add an image to the texture atlas: the image is empty" << std::endl;
+        return false;
+    }
+
+    // Reserve the padding on the right and bottom sides, the left and top
+    // sides are covered by the padding of the neighbours or by the page border
+    unsigned int paddedWidth = width + m_padding;
+    unsigned int paddedHeight = height + m_padding;
+
+    unsigned int maximumSize = Texture::getMaximumSize();
+    if ((paddedWidth > maximumSize) || (paddedHeight > maximumSize))
+    {
+        err() << "Failed to add an image to the texture atlas: its size (" << width << "x" << height
+              << ") exceeds the maximum texture size (" << maximumSize << ")" << std::endl;
+        return false;
+    }
+
+    // Try the existing pages first, with their current size
+    IntRect rect;
+    Page* page = NULL;
+    unsigned int pageIndex = 0;
+    for (; pageIndex < m_pages.size(); ++pageIndex)
+    {
+        if (findRect(*m_pages[pageIndex], paddedWidth, paddedHeight, rect))
+        {
+            page = m_pages[pageIndex];
+            break;
+        }
+    }
+
+    // Then grow the last page as much as needed
+    if (!page && !m_pages.empty())
+    {
+        Page& last = *m_pages.back();
+        while (growPage(last))
+        {
+            if (findRect(last, paddedWidth, paddedHeight, rect))
+            {
+                page = &last;
+                pageIndex = static_cast<unsigned int>(m_pages.size() - 1);
+                break;
+            }
+        }
+    }
+
+    // Finally, create a new page
+    if (!page)
+    {
+        page = createPage(std::max(paddedWidth, paddedHeight));
+        if (!page || !findRect(*page, paddedWidth, paddedHeight, rect))
+            return false;
+
+        pageIndex = static_cast<unsigned int>(m_pages.size() - 1);
+    }
+
+    // Copy the pixels to the texture
+    page->texture.update(image, rect.left, rect.top);
+
+    region.texture = &page->texture;
+    region.page = pageIndex;
+    region.rect = IntRect(rect.left, rect.top, width, height);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::addFromFile(const std::string& filename, Region& region)
+{
+    Image image;
+    return image.loadFromFile(filename) && add(image, region);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::clear()
+{
+    for (std::vector<Page*>::iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+        delete *it;
+
+    m_pages.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureAtlas::getPageCount() const
+{
+    return static_cast<unsigned int>(m_pages.size());
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture& TextureAtlas::getTexture(unsigned int page) const
+{
+    return m_pages[page]->texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::setSmooth(bool smooth)
+{
+    m_isSmooth = smooth;
+
+    for (std::vector<Page*>::iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+        (*it)->texture.setSmooth(smooth);
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::isSmooth() const
+{
+    return m_isSmooth;
+}
+
+
+////////////////////////////////////////////////////////////
+TextureAtlas::Page* TextureAtlas::createPage(unsigned int minimumSize)
+{
+    // Start with the configured size, doubled until the first image fits
+    unsigned int size = std::min(m_pageSize, Texture::getMaximumSize());
+    while ((size < minimumSize) && (size * 2 <= Texture::getMaximumSize()))
+        size *= 2;
+    size = std::max(size, minimumSize);
+
+    Page* page = new Page;
+    if (!page->texture.create(size, size))
+    {
+        err() << "Failed to create a new page for the texture atlas" << std::endl;
+        delete page;
+        return NULL;
+    }
+
+    // Clear the page, the padding areas would contain garbage otherwise
+    Image empty;
+    empty.create(size, size, Color(0, 0, 0, 0));
+    page->texture.update(empty);
+    page->texture.setSmooth(m_isSmooth);
+
+    page->skyline.push_back(Segment(0, 0, size));
+    m_pages.push_back(page);
+
+    return page;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::findRect(Page& page, unsigned int width, unsigned int height, IntRect& rect)
+{
+    unsigned int pageWidth = page.texture.getSize().x;
+    unsigned int pageHeight = page.texture.getSize().y;
+    std::vector<Segment>& skyline = page.skyline;
+
+    // Find the position where the top of the rectangle is the lowest
+    // (bottom-left rule), preferring the narrowest segment on ties
+    std::size_t bestIndex = skyline.size();
+    unsigned int bestTop = pageHeight + 1;
+    unsigned int bestWidth = 0;
+    unsigned int bestY = 0;
+    for (std::size_t i = 0; i < skyline.size(); ++i)
+    {
+        if (skyline[i].x + width > pageWidth)
+            break;
+
+        // The rectangle rests on the highest segment that it covers
+        unsigned int y = 0;
+        unsigned int covered = 0;
+        for (std::size_t j = i; covered < width; ++j)
+        {
+            y = std::max(y, skyline[j].y);
+            covered += skyline[j].width;
+        }
+
+        unsigned int top = y + height;
+        if (top > pageHeight)
+            continue;
+
+        if ((top < bestTop) || ((top == bestTop) && (skyline[i].width < bestWidth)))
+        {
+            bestIndex = i;
+            bestTop = top;
+            bestWidth = skyline[i].width;
+            bestY = y;
+        }
+    }
+
+    if (bestIndex == skyline.size())
+        return false;
+
+    unsigned int x = skyline[bestIndex].x;
+    rect = IntRect(x, bestY, width, height);
+
+    // Insert the new segment, then shrink or remove the ones that it covers
+    skyline.insert(skyline.begin() + bestIndex, Segment(x, bestTop, width));
+    std::size_t next = bestIndex + 1;
+    while (next < skyline.size())
+    {
+        Segment& segment = skyline[next];
+        unsigned int end = x + width;
+        if (segment.x >= end)
+            break;
+
+        unsigned int segmentEnd = segment.x + segment.width;
+        if (segmentEnd <= end)
+        {
+            skyline.erase(skyline.begin() + next);
+        }
+        else
+        {
+            segment.width = segmentEnd - end;
+            segment.x = end;
+            break;
+        }
+    }
+
+    // Merge neighbour segments of the same height
+    for (std::size_t i = 0; i + 1 < skyline.size();)
+    {
+        if (skyline[i].y == skyline[i + 1].y)
+        {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::growPage(Page& page)
+{
+    unsigned int width = page.texture.getSize().x;
+    unsigned int height = page.texture.getSize().y;
+    if ((width * 2 > Texture::getMaximumSize()) || (height * 2 > Texture::getMaximumSize()))
+        return false;
+
+    // Make the texture 2 times bigger, keeping the existing images at the same place
+    Image newImage;
+    newImage.create(width * 2, height * 2, Color(0, 0, 0, 0));
+    newImage.copy(page.texture.copyToImage(), 0, 0);
+    if (!page.texture.loadFromImage(newImage))
+        return false;
+
+    // The new area on the right starts empty
+    page.skyline.push_back(Segment(width, 0, width));
+
+    return true;
+}
+
+} // namespace sf
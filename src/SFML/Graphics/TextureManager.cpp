@@ -0,0 +1,271 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureManager.hpp>
+#include <algorithm>
+#include <vector>
+
+
+namespace
+{
+    // Order of the eviction candidates: least recently used first
+    struct LessRecentlyUsed
+    {
+        template <typename T>
+        bool operator ()(const T* left, const T* right) const
+        {
+            return left->lastUse < right->lastUse;
+        }
+    };
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextureManager::Statistics::Statistics() :
+textures       (0),
+reducedTextures(0),
+evictedTextures(0),
+loadingTextures(0),
+residentBytes  (0),
+reductions     (0),
+evictions      (0),
+reloads        (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureManager::TextureManager() :
+m_entries     (),
+m_budget      (0),
+m_maxReduction(2),
+m_frame       (1),
+m_statistics  ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureManager::~TextureManager()
+{
+    for (EntryTable::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+        delete it->second;
+}
+
+
+////////////////////////////////////////////////////////////
+Texture& TextureManager::get(const std::string& filename)
+{
+    EntryTable::iterator it = m_entries.find(filename);
+    if (it == m_entries.end())
+    {
+        Entry* entry = new Entry;
+        entry->filename = filename;
+        entry->useCount = 0;
+        entry->lastUse = m_frame;
+        entry->loading = false;
+        entry->failed = !entry->texture.loadFromFile(filename);
+
+        m_entries.insert(std::make_pair(filename, entry));
+
+        return entry->texture;
+    }
+
+    // An explicit request gives a failed reload another chance
+    Entry& entry = *it->second;
+    entry.lastUse = m_frame;
+    entry.failed = false;
+    if (!entry.loading && (entry.texture.m_reduction > 0 || !entry.texture.m_texture))
+        reload(entry);
+
+    return entry.texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureManager::unload(const std::string& filename)
+{
+    EntryTable::iterator it = m_entries.find(filename);
+    if (it != m_entries.end())
+    {
+        delete it->second;
+        m_entries.erase(it);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureManager::setBudget(Uint64 bytes)
+{
+    m_budget = bytes;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 TextureManager::getBudget() const
+{
+    return m_budget;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureManager::setMaxReduction(unsigned int levels)
+{
+    m_maxReduction = levels;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextureManager::getMaxReduction() const
+{
+    return m_maxReduction;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureManager::update()
+{
+    for (EntryTable::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        Entry& entry = *it->second;
+
+        // Upload the reloads that are over; if the texture is still degraded, the file couldn't be decoded
+        if (entry.loading && entry.texture.isReady())
+        {
+            entry.loading = false;
+            entry.failed = (entry.texture.m_reduction > 0) || !entry.texture.m_texture;
+        }
+
+        // The draw count of the texture changed: it was drawn during this frame
+        if (entry.texture.m_useCount != entry.useCount)
+        {
+            entry.useCount = entry.texture.m_useCount;
+            entry.lastUse = m_frame;
+
+            if (!entry.loading && !entry.failed && (entry.texture.m_reduction > 0 || !entry.texture.m_texture))
+                reload(entry);
+        }
+    }
+
+    enforceBudget();
+
+    ++m_frame;
+}
+
+
+////////////////////////////////////////////////////////////
+TextureManager::Statistics TextureManager::getStatistics() const
+{
+    Statistics statistics = m_statistics;
+
+    for (EntryTable::const_iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        const Entry& entry = *it->second;
+
+        statistics.textures++;
+        statistics.residentBytes += entry.texture.getStorageSize();
+        if (entry.loading)
+            statistics.loadingTextures++;
+        if (!entry.texture.m_texture)
+            statistics.evictedTextures++;
+        else if (entry.texture.m_reduction > 0)
+            statistics.reducedTextures++;
+    }
+
+    return statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureManager::reload(Entry& entry)
+{
+    // The current storage (if any) is still drawn until the new pixels are uploaded
+    entry.loading = entry.texture.loadFromFileAsync(entry.filename);
+    if (entry.loading)
+        m_statistics.reloads++;
+    else
+        entry.failed = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureManager::enforceBudget()
+{
+    if (m_budget == 0)
+        return;
+
+    Uint64 residentBytes = 0;
+    for (EntryTable::const_iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+        residentBytes += it->second->texture.getStorageSize();
+
+    if (residentBytes <= m_budget)
+        return;
+
+    // The textures used during this frame and the ones being reloaded are left alone
+    std::vector<Entry*> candidates;
+    for (EntryTable::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        Entry* entry = it->second;
+        if ((entry->lastUse < m_frame) && !entry->loading && entry->texture.m_texture)
+            candidates.push_back(entry);
+    }
+    std::sort(candidates.begin(), candidates.end(), LessRecentlyUsed());
+
+    // Halve the resolution of the least recently used textures first (one step per frame,
+    // so that a texture that comes back soon doesn't lose too much)
+    std::vector<bool> evictable(candidates.size(), true);
+    for (std::size_t i = 0; (i < candidates.size()) && (residentBytes > m_budget); ++i)
+    {
+        Texture& texture = candidates[i]->texture;
+        if (texture.m_reduction < m_maxReduction)
+        {
+            Uint64 previousBytes = texture.getStorageSize();
+            if (texture.reduce())
+            {
+                residentBytes -= previousBytes - texture.getStorageSize();
+                m_statistics.reductions++;
+                evictable[i] = false;
+            }
+        }
+    }
+
+    // Then evict the ones that can't be reduced anymore
+    for (std::size_t i = 0; (i < candidates.size()) && (residentBytes > m_budget); ++i)
+    {
+        Texture& texture = candidates[i]->texture;
+        if (evictable[i])
+        {
+            residentBytes -= texture.getStorageSize();
+            texture.release();
+            m_statistics.evictions++;
+        }
+    }
+}
+
+} // namespace sf
@@ -33,16 +33,25 @@ namespace sf
 namespace priv
 {
 ////////////////////////////////////////////////////////////
-TextureSaver::TextureSaver()
+TextureSaver::TextureSaver() :
+m_textureType(GL_TEXTURE_2D)
 {
-    glCheck(glGetIntegerv(GL_TEXTURE_BINDING_2D, &m_textureBinding));
+    m_textureBinding = static_cast<GLint>(getTextureBinding(GL_TEXTURE_2D, GL_TEXTURE_BINDING_2D));
+}
+
+
+////////////////////////////////////////////////////////////
+TextureSaver::TextureSaver(GLenum textureType, GLenum bindingType) :
+m_textureType(textureType)
+{
+    m_textureBinding = static_cast<GLint>(getTextureBinding(textureType, bindingType));
 }
 
 
 ////////////////////////////////////////////////////////////
 TextureSaver::~TextureSaver()
 {
-    glCheck(glBindTexture(GL_TEXTURE_2D, m_textureBinding));
+    bindTexture(m_textureType, static_cast<GLuint>(m_textureBinding));
 }
 
 } // namespace priv
@@ -46,15 +46,29 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
-    /// The current texture binding is saved.
+    /// The current texture binding is saved. It is read from
+    /// the state cache when known, so that OpenGL doesn't
+    /// have to be queried.
     ///
     ////////////////////////////////////////////////////////////
     TextureSaver();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the saver for another kind of texture
+    ///
+    /// The current binding of the \a textureType target is saved.
+    ///
+    /// \param textureType Texture target (GL_TEXTURE_2D, ...)
+    /// \param bindingType Query that returns the target's binding
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureSaver(GLenum textureType, GLenum bindingType);
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
-    /// The previous texture binding is restored.
+    /// The previous texture binding is restored, unless the
+    /// texture is still bound.
     ///
     ////////////////////////////////////////////////////////////
     ~TextureSaver();
@@ -64,7 +78,8 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    GLint m_textureBinding; ///< Texture binding to restore
+    GLenum m_textureType;    ///< Texture target whose binding is saved
+    GLint  m_textureBinding; ///< Texture binding to restore
 };
 
 } // namespace priv
@@ -0,0 +1,286 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureStream.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/TextureSaver.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <cstring>
+
+
+namespace
+{
+    sf::Mutex mutex;
+
+    bool checkPixelBuffersAvailable()
+    {
+        // Create a temporary context in case the user checks
+        // before a GlResource is created, thus initializing
+        // the shared context
+        sf::Context context;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+    #ifndef SFML_OPENGL_ES
+        return GLEXT_vertex_buffer_object && GLEXT_pixel_buffer_object;
+    #else
+        return false;
+    #endif
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextureStream::TextureStream() :
+m_buffers(),
+m_pixels (),
+m_size   (0, 0),
+m_current(0),
+m_mapped (NULL)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextureStream::~TextureStream()
+{
+    cleanup();
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureStream::create(unsigned int width, unsigned int height, unsigned int bufferCount)
+{
+    // Check if stream parameters are valid before creating it
+    if ((width == 0) || (height == 0) || (bufferCount == 0))
+    {
+        err() << "Failed to create texture stream, invalid size (" << width << "x" << height
+              << ", " << bufferCount << " buffers)" << std::endl;
+        return false;
+    }
+
+    cleanup();
+
+    m_size = Vector2u(width, height);
+
+    if (!isAvailable())
+    {
+        // Fallback: a single buffer in system memory, uploaded synchronously
+        m_pixels.resize(width * height * 4);
+        return true;
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    ensureGlContext();
+
+    m_buffers.resize(bufferCount, 0);
+    glCheck(GLEXT_glGenBuffers(static_cast<GLsizei>(bufferCount), &m_buffers[0]));
+
+    for (std::size_t i = 0; i < m_buffers.size(); ++i)
+    {
+        if (!m_buffers[i])
+        {
+            err() << "Failed to create texture stream, pixel buffer generation failed" << std::endl;
+            cleanup();
+            return false;
+        }
+
+        // Allocate the storage now, so that the first frames don't pay for it
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, m_buffers[i]));
+        glCheck(GLEXT_glBufferData(GLEXT_GL_PIXEL_UNPACK_BUFFER, width * height * 4, NULL, GLEXT_GL_STREAM_DRAW));
+    }
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+
+#endif
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TextureStream::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint8* TextureStream::map()
+{
+    // Already mapped?
+    if (m_mapped)
+        return m_mapped;
+
+    if (!m_pixels.empty())
+    {
+        m_mapped = &m_pixels[0];
+        return m_mapped;
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    if (m_buffers.empty())
+        return NULL;
+
+    ensureGlContext();
+
+    // Orphan the previous storage of the buffer, so that the driver doesn't
+    // have to wait for a pending transfer before giving us the memory
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, m_buffers[m_current]));
+    glCheck(GLEXT_glBufferData(GLEXT_GL_PIXEL_UNPACK_BUFFER, m_size.x * m_size.y * 4, NULL, GLEXT_GL_STREAM_DRAW));
+
+    void* memory = NULL;
+    glCheck(memory = GLEXT_glMapBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, GLEXT_GL_WRITE_ONLY));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+
+    if (!memory)
+        err() << "Failed to map texture stream buffer" << std::endl;
+
+    m_mapped = static_cast<Uint8*>(memory);
+
+#endif
+
+    return m_mapped;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureStream::unmap(Texture& texture, unsigned int x, unsigned int y)
+{
+    if (!m_mapped)
+        return;
+
+    m_mapped = NULL;
+
+    if (!m_pixels.empty())
+    {
+        texture.update(&m_pixels[0], m_size.x, m_size.y, x, y);
+        return;
+    }
+
+#ifndef SFML_OPENGL_ES
+
+    ensureGlContext();
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, m_buffers[m_current]));
+
+    GLboolean valid = GL_TRUE;
+    glCheck(valid = GLEXT_glUnmapBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER));
+
+    // The content of the buffer can be lost (e.g. on video mode changes),
+    // in which case the frame is skipped
+    if (valid && texture.m_texture)
+    {
+        // Make sure that the current texture binding will be preserved
+        priv::TextureSaver save;
+
+        // With an unpack buffer bound, the pixel pointer is an offset into the buffer
+        priv::bindTexture(GL_TEXTURE_2D, texture.m_texture);
+        glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, m_size.x, m_size.y, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+        texture.invalidatePixels();
+    }
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+
+    // Next frame goes to the next buffer of the ring
+    m_current = (m_current + 1) % m_buffers.size();
+
+#else
+
+    (void)texture;
+    (void)x;
+    (void)y;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureStream::update(Texture& texture, const Uint8* pixels, unsigned int x, unsigned int y)
+{
+    if (!pixels)
+        return;
+
+    Uint8* memory = map();
+    if (memory)
+        std::memcpy(memory, pixels, m_size.x * m_size.y * 4);
+
+    unmap(texture, x, y);
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureStream::isAvailable()
+{
+    // TODO: Remove this lock when it becomes unnecessary in C++11
+    Lock lock(mutex);
+
+    static bool available = checkPixelBuffersAvailable();
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureStream::cleanup()
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!m_buffers.empty())
+    {
+        ensureGlContext();
+
+        // Release the mapping, if the user didn't
+        if (m_mapped)
+        {
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, m_buffers[m_current]));
+            glCheck(GLEXT_glUnmapBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER));
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_UNPACK_BUFFER, 0));
+        }
+
+        glCheck(GLEXT_glDeleteBuffers(static_cast<GLsizei>(m_buffers.size()), &m_buffers[0]));
+    }
+
+#endif
+
+    m_buffers.clear();
+    m_pixels.clear();
+    m_size = Vector2u(0, 0);
+    m_current = 0;
+    m_mapped = NULL;
+}
+
+} // namespace sf
@@ -0,0 +1,260 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextureUploader.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Lock.hpp>
+
+
+namespace
+{
+    // Mutex for the creation of the uploader
+    sf::Mutex uploaderMutex;
+
+    bool checkFencesAvailable()
+    {
+        // Create a temporary context in case the user checks
+        // before a GlResource is created, thus initializing
+        // the shared context
+        sf::Context context;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+    #ifndef SFML_OPENGL_ES
+        return GLEXT_sync;
+    #else
+        return false;
+    #endif
+    }
+
+    void deleteFence(void* fence)
+    {
+    #ifndef SFML_OPENGL_ES
+        glCheck(GLEXT_glDeleteSync(static_cast<GLEXT_GLsync>(fence)));
+    #else
+        (void)fence;
+    #endif
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+TextureUploader& TextureUploader::getInstance()
+{
+    // Never destroyed, so that it outlives the static textures
+    Lock lock(uploaderMutex);
+    static TextureUploader* instance = new TextureUploader;
+    return *instance;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureUploader::isAvailable()
+{
+    // TODO: Remove this lock when it becomes unnecessary in C++11
+    Lock lock(uploaderMutex);
+
+    static bool available = checkFencesAvailable();
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 TextureUploader::add(Image* image, const IntRect& area, bool smooth, bool repeated)
+{
+    Lock lock(m_mutex);
+
+    Job job = {m_nextId++, image, area, smooth, repeated};
+    m_jobs.push_back(job);
+
+    if (!m_running)
+    {
+        m_running = true;
+        m_thread.launch();
+    }
+
+    return job.upload;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TextureUploader::take(Uint64 upload, Texture*& texture)
+{
+    Lock lock(m_mutex);
+
+    std::map<Uint64, Result>::iterator it = m_results.find(upload);
+    if (it == m_results.end())
+        return false;
+
+#ifndef SFML_OPENGL_ES
+
+    if (it->second.fence)
+    {
+        // Poll the fence without waiting
+        GLenum status = GLEXT_glClientWaitSync(static_cast<GLEXT_GLsync>(it->second.fence), 0, 0);
+        if ((status != GLEXT_GL_ALREADY_SIGNALED) && (status != GLEXT_GL_CONDITION_SATISFIED))
+            return false;
+    }
+
+#endif
+
+    texture = it->second.texture;
+    if (it->second.fence)
+        deleteFence(it->second.fence);
+    m_results.erase(it);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureUploader::cancel(Uint64 upload)
+{
+    Lock lock(m_mutex);
+
+    for (std::deque<Job>::iterator it = m_jobs.begin(); it != m_jobs.end();)
+    {
+        if (it->upload == upload)
+        {
+            delete it->image;
+            it = m_jobs.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    // Wait for the thread if it is uploading the image
+    while (m_uploading == upload)
+        m_uploaded.wait(m_mutex);
+
+    std::map<Uint64, Result>::iterator it = m_results.find(upload);
+    if (it != m_results.end())
+    {
+        destroy(it->second);
+        m_results.erase(it);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+TextureUploader::TextureUploader() :
+m_uploading(0),
+m_nextId   (1),
+m_thread   (&TextureUploader::run, this),
+m_running  (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureUploader::run()
+{
+    // The context shares its objects with all the other ones,
+    // the textures created here can be used on any thread
+    Context context;
+
+    for (;;)
+    {
+        Job job;
+        {
+            Lock lock(m_mutex);
+            if (m_jobs.empty())
+            {
+                m_running = false;
+                return;
+            }
+
+            job = m_jobs.front();
+            m_jobs.pop_front();
+            m_uploading = job.upload;
+        }
+
+        Result result = {NULL, NULL};
+        Texture* texture = new Texture;
+        texture->setSmooth(job.smooth);
+        texture->setRepeated(job.repeated);
+        if (texture->loadFromImage(*job.image, job.area))
+        {
+            result.texture = texture;
+
+        #ifndef SFML_OPENGL_ES
+            GLEXT_GLsync fence = NULL;
+            glCheck(fence = GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+            result.fence = fence;
+        #endif
+
+            // The fence must reach the driver, other contexts would wait for it forever otherwise
+            glCheck(glFlush());
+        }
+        else
+        {
+            delete texture;
+        }
+        delete job.image;
+
+        Lock lock(m_mutex);
+        m_uploading = 0;
+        m_results[job.upload] = result;
+        m_uploaded.notifyAll();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TextureUploader::destroy(const Result& result)
+{
+    delete result.texture;
+
+    if (result.fence)
+    {
+        // Create a temporary context if none is active, like Texture::isFormatSupported
+        if (!Context::getActiveContextId())
+        {
+            Context context;
+            deleteFence(result.fence);
+        }
+        else
+        {
+            deleteFence(result.fence);
+        }
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
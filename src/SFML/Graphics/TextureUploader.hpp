@@ -0,0 +1,174 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TEXTUREUPLOADER_HPP
+#define SFML_TEXTUREUPLOADER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/ConditionVariable.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Thread.hpp>
+#include <deque>
+#include <map>
+
+
+namespace sf
+{
+class Image;
+class Texture;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Thread uploading images to new textures
+///
+/// The thread owns a context shared with all the others, and
+/// inserts a fence after each upload: a texture is handed
+/// over only once the graphics driver has finished copying
+/// its pixels. The thread is launched when uploads are added
+/// and exits when the queue is empty.
+///
+////////////////////////////////////////////////////////////
+class TextureUploader : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the unique instance of the class
+    ///
+    /// \return Reference to the TextureUploader instance
+    ///
+    ////////////////////////////////////////////////////////////
+    static TextureUploader& getInstance();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether uploads can run in the background
+    ///
+    /// Background uploads need fences (OpenGL 3.2 or ARB_sync).
+    ///
+    /// \return True if background uploads are supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue the upload of an image to a new texture
+    ///
+    /// \param image    Image to upload, owned by the uploader
+    /// \param area     Area of the image to upload
+    /// \param smooth   Smooth filter of the new texture
+    /// \param repeated Repeat mode of the new texture
+    ///
+    /// \return Identifier of the upload, never 0
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 add(Image* image, const IntRect& area, bool smooth, bool repeated);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take the texture of a finished upload
+    ///
+    /// Must be called on a thread with an active context, which
+    /// polls the fence of the upload without waiting.
+    ///
+    /// \param upload  Identifier of the upload
+    /// \param texture Filled with the new texture, or NULL if the upload failed
+    ///
+    /// \return True if the upload is over, false if it is still running
+    ///
+    ////////////////////////////////////////////////////////////
+    bool take(Uint64 upload, Texture*& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Cancel an upload
+    ///
+    /// Waits for the upload if it is running, and destroys
+    /// its texture if it is over.
+    ///
+    /// \param upload Identifier of the upload
+    ///
+    ////////////////////////////////////////////////////////////
+    void cancel(Uint64 upload);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    struct Job
+    {
+        Uint64  upload;
+        Image*  image;
+        IntRect area;
+        bool    smooth;
+        bool    repeated;
+    };
+
+    ////////////////////////////////////////////////////////////
+    struct Result
+    {
+        Texture* texture;
+        void*    fence;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    TextureUploader();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the queued images until the queue is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    void run();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the texture and the fence of a result
+    ///
+    /// \param result Result to destroy
+    ///
+    ////////////////////////////////////////////////////////////
+    static void destroy(const Result& result);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Mutex                    m_mutex;     ///< Mutex protecting all the members
+    std::deque<Job>          m_jobs;      ///< Images waiting to be uploaded
+    Uint64                   m_uploading; ///< Upload which is running, 0 if none
+    ConditionVariable        m_uploaded;  ///< Notified when an upload is over
+    std::map<Uint64, Result> m_results;   ///< Finished uploads waiting to be taken
+    Uint64                   m_nextId;    ///< Identifier of the next upload
+    Thread                   m_thread;    ///< Uploading thread
+    bool                     m_running;   ///< Is the thread running?
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_TEXTUREUPLOADER_HPP
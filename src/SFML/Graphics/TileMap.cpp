@@ -0,0 +1,513 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TileMap.hpp>
+#include <SFML/Graphics/CompactVertex.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    sf::Mutex mutex;
+
+    // Number of cells of a chunk, horizontally and vertically
+    const unsigned int ChunkSize = 32;
+
+    // Frame duration marking the tiles that are not animated, in the colors decoded by the shader
+    const sf::Uint32 StaticTile = 65535;
+
+    // Longest animation period that the shader can represent exactly with a float, in milliseconds
+    const sf::Int64 MaxAnimationPeriod = 1 << 24;
+
+    // Largest coordinate, in pixels, that compact vertices can hold
+    const unsigned int MaxCompactCoordinate = 32767;
+
+    // Vertex shader offsetting the texture coordinates of the animated tiles;
+    // the color of a vertex holds the frame count and the frame duration of its tile
+    const char* vertexSource =
+        "uniform float time;\n"
+        "uniform float tileWidth;\n"
+        "void main()\n"
+        "{\n"
+        "    vec3 encoded = floor(gl_Color.rgb * 255.0 + 0.5);\n"
+        "    float duration = encoded.g * 256.0 + encoded.b;\n"
+        "    float frame = 0.0;\n"
+        "    if (duration < 65535.0)\n"
+        "        frame = mod(floor(time / duration), encoded.r);\n"
+        "    gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;\n"
+        "    gl_TexCoord[0] = gl_TextureMatrix[0] * (gl_MultiTexCoord0 + vec4(frame * tileWidth, 0.0, 0.0, 0.0));\n"
+        "    gl_FrontColor = vec4(1.0, 1.0, 1.0, gl_Color.a);\n"
+        "}\n";
+
+    const char* fragmentSource =
+        "uniform sampler2D texture;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = gl_Color * texture2D(texture, gl_TexCoord[0].xy);\n"
+        "}\n";
+
+    // Get the animation shader, creating it on first use. It is shared by all the
+    // tile maps and intentionally never destroyed, like the instancing shader.
+    sf::Shader* getAnimationShader()
+    {
+        // TODO: Remove this lock when it becomes unnecessary in C++11
+        sf::Lock lock(mutex);
+
+        static sf::Shader* shader = NULL;
+        static bool initialized = false;
+
+        if (!initialized)
+        {
+            initialized = true;
+
+            // Make sure that a context is active for the shader compilation
+            sf::Context context;
+
+            if (sf::Shader::isAvailable())
+            {
+                shader = new sf::Shader;
+                if (shader->loadFromMemory(vertexSource, fragmentSource))
+                {
+                    shader->setParameter("texture", sf::Shader::CurrentTexture);
+                }
+                else
+                {
+                    delete shader;
+                    shader = NULL;
+                }
+            }
+        }
+
+        return shader;
+    }
+
+    // Compute the greatest common divisor of two positive numbers
+    sf::Int64 gcd(sf::Int64 a, sf::Int64 b)
+    {
+        while (b != 0)
+        {
+            sf::Int64 remainder = a % b;
+            a = b;
+            b = remainder;
+        }
+
+        return a;
+    }
+
+    // Convert a coordinate to a chunk index, clamped to the range of the map
+    unsigned int toChunk(float coordinate, float chunkSize, unsigned int chunkCount)
+    {
+        float chunk = std::floor(coordinate / chunkSize);
+
+        if (!(chunk > 0.f)) // also catches NaN
+            return 0;
+        if (chunk >= static_cast<float>(chunkCount))
+            return chunkCount - 1;
+
+        return static_cast<unsigned int>(chunk);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+const Uint32 TileMap::NoTile = 0xFFFFFFFF;
+
+
+////////////////////////////////////////////////////////////
+TileMap::TileMap() :
+m_size           (0, 0),
+m_tileSize       (0, 0),
+m_layerCount     (0),
+m_texture        (NULL),
+m_textureSize    (0, 0),
+m_tiles          (),
+m_animations     (),
+m_animationTime  (0),
+m_animationPeriod(MaxAnimationPeriod),
+m_chunkCount     (0, 0),
+m_chunks         ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TileMap::~TileMap()
+{
+    for (std::vector<Chunk*>::iterator it = m_chunks.begin(); it != m_chunks.end(); ++it)
+        delete *it;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::create(const Vector2u& size, const Vector2u& tileSize, std::size_t layerCount)
+{
+    m_size = size;
+    m_tileSize = tileSize;
+    m_layerCount = layerCount;
+    m_tiles.assign(static_cast<std::size_t>(size.x) * size.y * layerCount, NoTile);
+
+    if ((tileSize.x > 0) && (tileSize.y > 0))
+        m_chunkCount = Vector2u((size.x + ChunkSize - 1) / ChunkSize, (size.y + ChunkSize - 1) / ChunkSize);
+    else
+        m_chunkCount = Vector2u(0, 0);
+
+    for (std::vector<Chunk*>::iterator it = m_chunks.begin(); it != m_chunks.end(); ++it)
+        delete *it;
+
+    m_chunks.resize(static_cast<std::size_t>(m_chunkCount.x) * m_chunkCount.y);
+    for (std::vector<Chunk*>::iterator it = m_chunks.begin(); it != m_chunks.end(); ++it)
+        *it = new Chunk;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TileMap::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TileMap::getTileSize() const
+{
+    return m_tileSize;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TileMap::getLayerCount() const
+{
+    return m_layerCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setTexture(const Texture& texture)
+{
+    m_texture = &texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* TileMap::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setTile(unsigned int x, unsigned int y, Uint32 tile, std::size_t layer)
+{
+    Uint32& cell = m_tiles[(layer * m_size.y + y) * m_size.x + x];
+    if (cell == tile)
+        return;
+
+    cell = tile;
+    m_chunks[(y / ChunkSize) * m_chunkCount.x + x / ChunkSize]->needsUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 TileMap::getTile(unsigned int x, unsigned int y, std::size_t layer) const
+{
+    return m_tiles[(layer * m_size.y + y) * m_size.x + x];
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::fill(Uint32 tile, std::size_t layer)
+{
+    std::size_t layerSize = static_cast<std::size_t>(m_size.x) * m_size.y;
+    std::fill(m_tiles.begin() + layer * layerSize, m_tiles.begin() + (layer + 1) * layerSize, tile);
+
+    invalidateChunks();
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setAnimation(Uint32 tile, unsigned int frameCount, Time frameDuration)
+{
+    if (frameCount > 1)
+    {
+        Animation animation;
+        animation.frameCount = std::min(frameCount, 255u);
+        animation.frameDuration = static_cast<Uint32>(std::max<Int64>(1, std::min<Int64>(frameDuration.asMilliseconds(), StaticTile - 1)));
+        m_animations[tile] = animation;
+    }
+    else
+    {
+        m_animations.erase(tile);
+    }
+
+    // The shader only gets the animation time modulo a period, which must be
+    // a multiple of every animation cycle for the animations not to jump
+    m_animationPeriod = 1;
+    for (std::map<Uint32, Animation>::const_iterator it = m_animations.begin(); it != m_animations.end(); ++it)
+    {
+        Int64 cycle = static_cast<Int64>(it->second.frameCount) * it->second.frameDuration;
+        m_animationPeriod = m_animationPeriod / gcd(m_animationPeriod, cycle) * cycle;
+
+        if (m_animationPeriod > MaxAnimationPeriod)
+        {
+            m_animationPeriod = MaxAnimationPeriod;
+            break;
+        }
+    }
+
+    invalidateChunks();
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setAnimationTime(Time time)
+{
+    m_animationTime = time.asMilliseconds();
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TileMap::getLocalBounds() const
+{
+    return FloatRect(0.f, 0.f, static_cast<float>(m_size.x * m_tileSize.x), static_cast<float>(m_size.y * m_tileSize.y));
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TileMap::getGlobalBounds() const
+{
+    return getTransform().transformRect(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::draw(RenderTarget& target, RenderStates states) const
+{
+    if (!m_texture || m_chunks.empty())
+        return;
+
+    states.transform *= getTransform();
+    states.texture = m_texture;
+
+    // The texture coordinates depend on the number of tiles per row of the tileset
+    if (m_texture->getSize() != m_textureSize)
+    {
+        m_textureSize = m_texture->getSize();
+        for (std::vector<Chunk*>::const_iterator it = m_chunks.begin(); it != m_chunks.end(); ++it)
+            (*it)->needsUpdate = true;
+    }
+
+    // Animate the tiles with the shader, unless a custom shader is provided
+    Int64 animationTime = ((m_animationTime % m_animationPeriod) + m_animationPeriod) % m_animationPeriod;
+    bool gpuAnimation = false;
+    if (!m_animations.empty() && !states.shader)
+    {
+        Shader* shader = getAnimationShader();
+        if (shader)
+        {
+            // The shader may still be referenced by the pending batch of another tile map
+            target.flush();
+
+            shader->setParameter("time", static_cast<float>(animationTime));
+            shader->setParameter("tileWidth", static_cast<float>(m_tileSize.x));
+            states.shader = shader;
+            gpuAnimation = true;
+        }
+    }
+
+    // Find the chunks overlapping the view, in the local coordinates of the map
+    const View& view = target.getView();
+    FloatRect area = states.transform.getInverse().transformRect(
+                     view.getInverseTransform().transformRect(FloatRect(-1.f, -1.f, 2.f, 2.f)));
+    if (!area.intersects(getLocalBounds()))
+        return;
+
+    float chunkWidth = static_cast<float>(ChunkSize * m_tileSize.x);
+    float chunkHeight = static_cast<float>(ChunkSize * m_tileSize.y);
+    unsigned int left   = toChunk(area.left, chunkWidth, m_chunkCount.x);
+    unsigned int top    = toChunk(area.top, chunkHeight, m_chunkCount.y);
+    unsigned int right  = toChunk(area.left + area.width, chunkWidth, m_chunkCount.x);
+    unsigned int bottom = toChunk(area.top + area.height, chunkHeight, m_chunkCount.y);
+
+    for (unsigned int y = top; y <= bottom; ++y)
+    {
+        for (unsigned int x = left; x <= right; ++x)
+        {
+            Chunk& chunk = *m_chunks[y * m_chunkCount.x + x];
+
+            // Animated chunks have to be rebuilt when the way their frames are computed changes
+            if (chunk.animated && ((chunk.gpuAnimation != gpuAnimation) || (!gpuAnimation && (chunk.animationTime != animationTime))))
+                chunk.needsUpdate = true;
+
+            if (chunk.needsUpdate)
+                updateChunk(x, y, gpuAnimation);
+
+            if (!chunk.vertices.empty())
+                target.draw(&chunk.vertices[0], chunk.vertices.size(), Triangles, states);
+            else if (chunk.vertexCount > 0)
+                target.draw(chunk.buffer, 0, chunk.vertexCount, states);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+TileMap::Chunk::Chunk() :
+buffer       (Triangles, VertexBuffer::Static),
+vertices     (),
+vertexCount  (0),
+needsUpdate  (true),
+animated     (false),
+gpuAnimation (false),
+animationTime(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::updateChunk(unsigned int chunkX, unsigned int chunkY, bool gpuAnimation) const
+{
+    Chunk& chunk = *m_chunks[chunkY * m_chunkCount.x + chunkX];
+    Int64 animationTime = ((m_animationTime % m_animationPeriod) + m_animationPeriod) % m_animationPeriod;
+
+    unsigned int columns = std::max(1u, m_textureSize.x / m_tileSize.x);
+    unsigned int left = chunkX * ChunkSize;
+    unsigned int top = chunkY * ChunkSize;
+    unsigned int right = std::min(left + ChunkSize, m_size.x);
+    unsigned int bottom = std::min(top + ChunkSize, m_size.y);
+    float width = static_cast<float>(m_tileSize.x);
+    float height = static_cast<float>(m_tileSize.y);
+
+    // The layers are stored one after the other, so that they are drawn in order by a single call
+    std::vector<Vertex> vertices;
+    vertices.reserve(static_cast<std::size_t>(right - left) * (bottom - top) * m_layerCount * 6);
+    chunk.animated = false;
+
+    for (std::size_t layer = 0; layer < m_layerCount; ++layer)
+    {
+        for (unsigned int y = top; y < bottom; ++y)
+        {
+            const Uint32* row = &m_tiles[(layer * m_size.y + y) * m_size.x];
+            for (unsigned int x = left; x < right; ++x)
+            {
+                Uint32 tile = row[x];
+                if (tile == NoTile)
+                    continue;
+
+                // Animated tiles either tell the shader how to animate them, or show their current frame
+                Color color = Color::White;
+                std::map<Uint32, Animation>::const_iterator animation = m_animations.find(tile);
+                if (animation != m_animations.end())
+                {
+                    chunk.animated = true;
+                    const Animation& frames = animation->second;
+
+                    if (gpuAnimation)
+                        color = Color(static_cast<Uint8>(frames.frameCount), static_cast<Uint8>(frames.frameDuration >> 8),
+                                      static_cast<Uint8>(frames.frameDuration & 0xFF));
+                    else
+                        tile += static_cast<Uint32>((animationTime / frames.frameDuration) % frames.frameCount);
+                }
+
+                float textureLeft = static_cast<float>((tile % columns) * m_tileSize.x);
+                float textureTop = static_cast<float>((tile / columns) * m_tileSize.y);
+                float positionLeft = x * width;
+                float positionTop = y * height;
+
+                Vertex quad[4] =
+                {
+                    Vertex(Vector2f(positionLeft, positionTop),                  color, Vector2f(textureLeft, textureTop)),
+                    Vertex(Vector2f(positionLeft, positionTop + height),         color, Vector2f(textureLeft, textureTop + height)),
+                    Vertex(Vector2f(positionLeft + width, positionTop),          color, Vector2f(textureLeft + width, textureTop)),
+                    Vertex(Vector2f(positionLeft + width, positionTop + height), color, Vector2f(textureLeft + width, textureTop + height))
+                };
+
+                vertices.push_back(quad[0]);
+                vertices.push_back(quad[1]);
+                vertices.push_back(quad[2]);
+                vertices.push_back(quad[2]);
+                vertices.push_back(quad[1]);
+                vertices.push_back(quad[3]);
+            }
+        }
+    }
+
+    // Upload the geometry once, or keep it on the CPU if vertex buffers are not available;
+    // the coordinates are whole pixels, compact vertices hold them when the map is not too large
+    bool uploaded = false;
+    if (VertexBuffer::isAvailable() && !vertices.empty())
+    {
+        bool compact = (m_size.x * m_tileSize.x <= MaxCompactCoordinate) && (m_size.y * m_tileSize.y <= MaxCompactCoordinate) &&
+                       (m_textureSize.x <= MaxCompactCoordinate) && (m_textureSize.y <= MaxCompactCoordinate);
+        chunk.buffer.setFormat(compact ? VertexBuffer::Compact : VertexBuffer::Full);
+
+        if (vertices.size() > chunk.buffer.getVertexCount())
+            chunk.buffer.create(vertices.size());
+
+        if (compact)
+        {
+            std::vector<CompactVertex> compactVertices;
+            compactVertices.reserve(vertices.size());
+            for (std::size_t i = 0; i < vertices.size(); ++i)
+                compactVertices.push_back(CompactVertex(vertices[i]));
+
+            uploaded = chunk.buffer.update(&compactVertices[0], compactVertices.size(), 0);
+        }
+        else
+        {
+            uploaded = chunk.buffer.update(&vertices[0], vertices.size(), 0);
+        }
+    }
+
+    chunk.vertexCount = vertices.size();
+    if (uploaded || vertices.empty())
+        std::vector<Vertex>().swap(chunk.vertices);
+    else
+        chunk.vertices.swap(vertices);
+
+    chunk.needsUpdate = false;
+    chunk.gpuAnimation = gpuAnimation;
+    chunk.animationTime = animationTime;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::invalidateChunks()
+{
+    for (std::vector<Chunk*>::iterator it = m_chunks.begin(); it != m_chunks.end(); ++it)
+        (*it)->needsUpdate = true;
+}
+
+} // namespace sf
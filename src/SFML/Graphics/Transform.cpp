@@ -26,8 +26,82 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/TransformPoints.hpp>
 #include <cmath>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SFML_TRANSFORM_SSE2
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define SFML_TRANSFORM_NEON
+#endif
+
+
+namespace
+{
+    // Check whether a 4x4 matrix is a 2D affine transform, i.e. whether its last row is (0, 0, 1);
+    // only the 6 other coefficients are then meaningful
+    inline bool isAffine(const float* matrix)
+    {
+        return (matrix[3] == 0.f) && (matrix[7] == 0.f) && (matrix[15] == 1.f);
+    }
+
+    // Combine two affine transforms, writing only the 6 coefficients of the result (result may be left)
+    inline void combineAffine(const float* a, const float* b, float* result)
+    {
+#if defined(SFML_TRANSFORM_SSE2)
+
+        // The first two columns are computed together as (r0, r1, r4, r5)
+        __m128 columnX     = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(a + 0));
+        __m128 columnY     = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(a + 4));
+        __m128 translation = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(a + 12));
+        columnX = _mm_movelh_ps(columnX, columnX);
+        columnY = _mm_movelh_ps(columnY, columnY);
+
+        __m128 linear = _mm_add_ps(_mm_mul_ps(columnX, _mm_setr_ps(b[0], b[0], b[4], b[4])),
+                                   _mm_mul_ps(columnY, _mm_setr_ps(b[1], b[1], b[5], b[5])));
+        __m128 offset = _mm_add_ps(_mm_add_ps(_mm_mul_ps(columnX, _mm_set1_ps(b[12])),
+                                              _mm_mul_ps(columnY, _mm_set1_ps(b[13]))), translation);
+
+        _mm_storel_pi(reinterpret_cast<__m64*>(result + 0), linear);
+        _mm_storeh_pi(reinterpret_cast<__m64*>(result + 4), linear);
+        _mm_storel_pi(reinterpret_cast<__m64*>(result + 12), offset);
+
+#elif defined(SFML_TRANSFORM_NEON)
+
+        float32x2_t columnX = vld1_f32(a + 0);
+        float32x2_t columnY = vld1_f32(a + 4);
+        float32x2_t translation = vld1_f32(a + 12);
+
+        float32x2_t r0 = vmla_n_f32(vmul_n_f32(columnX, b[0]), columnY, b[1]);
+        float32x2_t r1 = vmla_n_f32(vmul_n_f32(columnX, b[4]), columnY, b[5]);
+        float32x2_t r3 = vmla_n_f32(vmla_n_f32(translation, columnX, b[12]), columnY, b[13]);
+
+        vst1_f32(result + 0, r0);
+        vst1_f32(result + 4, r1);
+        vst1_f32(result + 12, r3);
+
+#else
+
+        float r0  = a[0] * b[0]  + a[4] * b[1];
+        float r1  = a[1] * b[0]  + a[5] * b[1];
+        float r4  = a[0] * b[4]  + a[4] * b[5];
+        float r5  = a[1] * b[4]  + a[5] * b[5];
+        float r12 = a[0] * b[12] + a[4] * b[13] + a[12];
+        float r13 = a[1] * b[12] + a[5] * b[13] + a[13];
+
+        result[0]  = r0;
+        result[1]  = r1;
+        result[4]  = r4;
+        result[5]  = r5;
+        result[12] = r12;
+        result[13] = r13;
+
+#endif
+    }
+}
+
 
 namespace sf
 {
@@ -68,6 +142,23 @@ const float* Transform::getMatrix() const
 ////////////////////////////////////////////////////////////
 Transform Transform::getInverse() const
 {
+    // Most transforms are affine, their inverse only involves the 2x2 linear part
+    if (isAffine(m_matrix))
+    {
+        float det = m_matrix[0] * m_matrix[5] - m_matrix[1] * m_matrix[4];
+        if (det == 0.f)
+            return Identity;
+
+        float a00 =  m_matrix[5] / det;
+        float a01 = -m_matrix[4] / det;
+        float a10 = -m_matrix[1] / det;
+        float a11 =  m_matrix[0] / det;
+
+        return Transform(a00, a01, -(a00 * m_matrix[12] + a01 * m_matrix[13]),
+                         a10, a11, -(a10 * m_matrix[12] + a11 * m_matrix[13]),
+                         0.f, 0.f, 1.f);
+    }
+
     // Compute the determinant
     float det = m_matrix[0] * (m_matrix[15] * m_matrix[5] - m_matrix[7] * m_matrix[13]) -
                 m_matrix[1] * (m_matrix[15] * m_matrix[4] - m_matrix[7] * m_matrix[12]) +
@@ -109,6 +200,13 @@ Vector2f Transform::transformPoint(const Vector2f& point) const
 }
 
 
+////////////////////////////////////////////////////////////
+void Transform::transformPoints(const Vector2f* input, Vector2f* output, std::size_t count) const
+{
+    priv::transformPoints(m_matrix, input, sizeof(Vector2f), output, sizeof(Vector2f), count);
+}
+
+
 ////////////////////////////////////////////////////////////
 FloatRect Transform::transformRect(const FloatRect& rectangle) const
 {
@@ -144,6 +242,13 @@ Transform& Transform::combine(const Transform& transform)
     const float* a = m_matrix;
     const float* b = transform.m_matrix;
 
+    // The product of two affine transforms is affine, the other coefficients don't change
+    if (isAffine(a) && isAffine(b))
+    {
+        combineAffine(a, b, m_matrix);
+        return *this;
+    }
+
     *this = Transform(a[0] * b[0]  + a[4] * b[1]  + a[12] * b[3],
                       a[0] * b[4]  + a[4] * b[5]  + a[12] * b[7],
                       a[0] * b[12] + a[4] * b[13] + a[12] * b[15],
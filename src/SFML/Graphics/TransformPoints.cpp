@@ -0,0 +1,399 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TransformPoints.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SFML_TRANSFORM_SSE2
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define SFML_TRANSFORM_NEON
+#endif
+
+
+namespace
+{
+    // Access a point of a strided array
+    inline const float* pointAt(const void* base, std::size_t stride, std::size_t index)
+    {
+        return reinterpret_cast<const float*>(static_cast<const char*>(base) + index * stride);
+    }
+
+    inline float* pointAt(void* base, std::size_t stride, std::size_t index)
+    {
+        return reinterpret_cast<float*>(static_cast<char*>(base) + index * stride);
+    }
+
+    // The shared quad indices, filled once at static initialization so that
+    // no thread ever reads them while they are being written
+    struct QuadIndices
+    {
+        QuadIndices()
+        {
+            for (std::size_t i = 0; i < sf::priv::QuadIndicesQuadCount; ++i)
+            {
+                sf::Uint16 first = static_cast<sf::Uint16>(i * 4);
+                indices[i * 6 + 0] = first + 0;
+                indices[i * 6 + 1] = first + 1;
+                indices[i * 6 + 2] = first + 2;
+                indices[i * 6 + 3] = first + 0;
+                indices[i * 6 + 4] = first + 2;
+                indices[i * 6 + 5] = first + 3;
+            }
+        }
+
+        sf::Uint16 indices[sf::priv::QuadIndicesQuadCount * 6];
+    };
+
+    const QuadIndices quadIndices;
+
+    // Append a transformed vertex to a vertex stream; only the position changes,
+    // every other attribute of the vertex is kept
+    inline void appendTransformed(std::vector<sf::Vertex>& stream, const sf::Vertex& vertex, const sf::Transform& transform)
+    {
+        stream.push_back(vertex);
+        stream.back().position = transform.transformPoint(vertex.position);
+    }
+
+    // Read 16 or 32-bit indices (or take the vertices in order) and offset them into an index stream
+    class IndexReader
+    {
+    public:
+
+        IndexReader(std::size_t base, const void* indices, std::size_t indexSize) :
+        m_base     (base),
+        m_indices16(indexSize == 2 ? static_cast<const sf::Uint16*>(indices) : NULL),
+        m_indices32(indexSize == 4 ? static_cast<const sf::Uint32*>(indices) : NULL)
+        {
+        }
+
+        sf::Uint16 operator [](std::size_t i) const
+        {
+            std::size_t index = m_indices16 ? m_indices16[i] : (m_indices32 ? m_indices32[i] : i);
+            return static_cast<sf::Uint16>(m_base + index);
+        }
+
+    private:
+
+        std::size_t       m_base;
+        const sf::Uint16* m_indices16;
+        const sf::Uint32* m_indices32;
+    };
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void transformPoints(const float* matrix, const void* input, std::size_t inputStride,
+                     void* output, std::size_t outputStride, std::size_t count)
+{
+    const float a00 = matrix[0];
+    const float a01 = matrix[4];
+    const float a02 = matrix[12];
+    const float a10 = matrix[1];
+    const float a11 = matrix[5];
+    const float a12 = matrix[13];
+
+    std::size_t i = 0;
+
+#if defined(SFML_TRANSFORM_SSE2)
+
+    // Two points are stored in each register as (x0, y0, x1, y1)
+    const __m128 columnX     = _mm_setr_ps(a00, a10, a00, a10);
+    const __m128 columnY     = _mm_setr_ps(a01, a11, a01, a11);
+    const __m128 translation = _mm_setr_ps(a02, a12, a02, a12);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 p01 = _mm_setzero_ps();
+        __m128 p23 = _mm_setzero_ps();
+        p01 = _mm_loadl_pi(p01, reinterpret_cast<const __m64*>(pointAt(input, inputStride, i + 0)));
+        p01 = _mm_loadh_pi(p01, reinterpret_cast<const __m64*>(pointAt(input, inputStride, i + 1)));
+        p23 = _mm_loadl_pi(p23, reinterpret_cast<const __m64*>(pointAt(input, inputStride, i + 2)));
+        p23 = _mm_loadh_pi(p23, reinterpret_cast<const __m64*>(pointAt(input, inputStride, i + 3)));
+
+        // Broadcast x and y of each point to both lanes of its half
+        __m128 x01 = _mm_shuffle_ps(p01, p01, _MM_SHUFFLE(2, 2, 0, 0));
+        __m128 y01 = _mm_shuffle_ps(p01, p01, _MM_SHUFFLE(3, 3, 1, 1));
+        __m128 x23 = _mm_shuffle_ps(p23, p23, _MM_SHUFFLE(2, 2, 0, 0));
+        __m128 y23 = _mm_shuffle_ps(p23, p23, _MM_SHUFFLE(3, 3, 1, 1));
+
+        __m128 r01 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x01, columnX), _mm_mul_ps(y01, columnY)), translation);
+        __m128 r23 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x23, columnX), _mm_mul_ps(y23, columnY)), translation);
+
+        _mm_storel_pi(reinterpret_cast<__m64*>(pointAt(output, outputStride, i + 0)), r01);
+        _mm_storeh_pi(reinterpret_cast<__m64*>(pointAt(output, outputStride, i + 1)), r01);
+        _mm_storel_pi(reinterpret_cast<__m64*>(pointAt(output, outputStride, i + 2)), r23);
+        _mm_storeh_pi(reinterpret_cast<__m64*>(pointAt(output, outputStride, i + 3)), r23);
+    }
+
+#elif defined(SFML_TRANSFORM_NEON)
+
+    for (; i + 4 <= count; i += 4)
+    {
+        // Gather x and y of four points into separate registers
+        float32x2x2_t p01 = vtrn_f32(vld1_f32(pointAt(input, inputStride, i + 0)), vld1_f32(pointAt(input, inputStride, i + 1)));
+        float32x2x2_t p23 = vtrn_f32(vld1_f32(pointAt(input, inputStride, i + 2)), vld1_f32(pointAt(input, inputStride, i + 3)));
+        float32x4_t x = vcombine_f32(p01.val[0], p23.val[0]);
+        float32x4_t y = vcombine_f32(p01.val[1], p23.val[1]);
+
+        float32x4_t rx = vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(a02), x, a00), y, a01);
+        float32x4_t ry = vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(a12), x, a10), y, a11);
+
+        // Interleave the results back into (x, y) pairs
+        float32x2x2_t r01 = vzip_f32(vget_low_f32(rx), vget_low_f32(ry));
+        float32x2x2_t r23 = vzip_f32(vget_high_f32(rx), vget_high_f32(ry));
+        vst1_f32(pointAt(output, outputStride, i + 0), r01.val[0]);
+        vst1_f32(pointAt(output, outputStride, i + 1), r01.val[1]);
+        vst1_f32(pointAt(output, outputStride, i + 2), r23.val[0]);
+        vst1_f32(pointAt(output, outputStride, i + 3), r23.val[1]);
+    }
+
+#endif
+
+    // Remaining points (or all of them without SIMD support)
+    for (; i < count; ++i)
+    {
+        const float* in = pointAt(input, inputStride, i);
+        float* out = pointAt(output, outputStride, i);
+        float x = in[0];
+        float y = in[1];
+        out[0] = a00 * x + a01 * y + a02;
+        out[1] = a10 * x + a11 * y + a12;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void transformVertices(const Transform& transform, const Vertex* input, Vertex* output, std::size_t count)
+{
+    if (!count)
+        return;
+
+    // Copy colors and texture coordinates all at once, then overwrite positions
+    std::memcpy(output, input, count * sizeof(Vertex));
+    transformPoints(transform.getMatrix(), &output->position, sizeof(Vertex), &output->position, sizeof(Vertex), count);
+}
+
+
+////////////////////////////////////////////////////////////
+PrimitiveType getListPrimitiveType(PrimitiveType type)
+{
+    switch (type)
+    {
+        case Points:         return Points;
+        case Lines:          return Lines;
+        case LinesStrip:     return Lines;
+        case Triangles:      return Triangles;
+        case TrianglesStrip: return Triangles;
+        case TrianglesFan:   return Triangles;
+        case Quads:          return Triangles;
+    }
+
+    return Triangles;
+}
+
+
+////////////////////////////////////////////////////////////
+void appendPrimitives(std::vector<Vertex>& stream, const Transform& transform,
+                      const Vertex* vertices, std::size_t vertexCount, PrimitiveType type)
+{
+    switch (type)
+    {
+        case Points:
+        case Lines:
+        case Triangles:
+        {
+            std::size_t size = stream.size();
+            stream.resize(size + vertexCount);
+            transformVertices(transform, vertices, &stream[size], vertexCount);
+            break;
+        }
+
+        case LinesStrip:
+        {
+            for (std::size_t i = 1; i < vertexCount; ++i)
+            {
+                appendTransformed(stream, vertices[i - 1], transform);
+                appendTransformed(stream, vertices[i], transform);
+            }
+            break;
+        }
+
+        case TrianglesStrip:
+        {
+            // Keep the winding order consistent by swapping the first two vertices of odd triangles
+            for (std::size_t i = 2; i < vertexCount; ++i)
+            {
+                bool odd = (i % 2) != 0;
+                appendTransformed(stream, vertices[odd ? i - 1 : i - 2], transform);
+                appendTransformed(stream, vertices[odd ? i - 2 : i - 1], transform);
+                appendTransformed(stream, vertices[i], transform);
+            }
+            break;
+        }
+
+        case TrianglesFan:
+        {
+            for (std::size_t i = 2; i < vertexCount; ++i)
+            {
+                appendTransformed(stream, vertices[0], transform);
+                appendTransformed(stream, vertices[i - 1], transform);
+                appendTransformed(stream, vertices[i], transform);
+            }
+            break;
+        }
+
+        case Quads:
+        {
+            for (std::size_t i = 3; i < vertexCount; i += 4)
+            {
+                appendTransformed(stream, vertices[i - 3], transform);
+                appendTransformed(stream, vertices[i - 2], transform);
+                appendTransformed(stream, vertices[i - 1], transform);
+                appendTransformed(stream, vertices[i - 3], transform);
+                appendTransformed(stream, vertices[i - 1], transform);
+                appendTransformed(stream, vertices[i], transform);
+            }
+            break;
+        }
+    }
+}
+
+
+
+////////////////////////////////////////////////////////////
+void appendIndexedPrimitives(std::vector<Vertex>& vertexStream, std::vector<Uint16>& indexStream,
+                             const Transform& transform, const Vertex* vertices, std::size_t vertexCount,
+                             PrimitiveType type, const void* indices, std::size_t indexCount,
+                             std::size_t indexSize)
+{
+    // The vertices are copied as they are, the indices do the conversion
+    std::size_t base = vertexStream.size();
+    vertexStream.resize(base + vertexCount);
+    transformVertices(transform, vertices, &vertexStream[base], vertexCount);
+
+    IndexReader index(base, indices, indexSize);
+    std::size_t count = indices ? indexCount : vertexCount;
+
+    switch (type)
+    {
+        case Points:
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                indexStream.push_back(index[i]);
+            break;
+        }
+
+        case Lines:
+        {
+            for (std::size_t i = 1; i < count; i += 2)
+            {
+                indexStream.push_back(index[i - 1]);
+                indexStream.push_back(index[i]);
+            }
+            break;
+        }
+
+        case LinesStrip:
+        {
+            for (std::size_t i = 1; i < count; ++i)
+            {
+                indexStream.push_back(index[i - 1]);
+                indexStream.push_back(index[i]);
+            }
+            break;
+        }
+
+        case Triangles:
+        {
+            for (std::size_t i = 2; i < count; i += 3)
+            {
+                indexStream.push_back(index[i - 2]);
+                indexStream.push_back(index[i - 1]);
+                indexStream.push_back(index[i]);
+            }
+            break;
+        }
+
+        case TrianglesStrip:
+        {
+            // Keep the winding order consistent by swapping the first two vertices of odd triangles
+            for (std::size_t i = 2; i < count; ++i)
+            {
+                bool odd = (i % 2) != 0;
+                indexStream.push_back(index[odd ? i - 1 : i - 2]);
+                indexStream.push_back(index[odd ? i - 2 : i - 1]);
+                indexStream.push_back(index[i]);
+            }
+            break;
+        }
+
+        case TrianglesFan:
+        {
+            for (std::size_t i = 2; i < count; ++i)
+            {
+                indexStream.push_back(index[0]);
+                indexStream.push_back(index[i - 1]);
+                indexStream.push_back(index[i]);
+            }
+            break;
+        }
+
+        case Quads:
+        {
+            for (std::size_t i = 3; i < count; i += 4)
+            {
+                indexStream.push_back(index[i - 3]);
+                indexStream.push_back(index[i - 2]);
+                indexStream.push_back(index[i - 1]);
+                indexStream.push_back(index[i - 3]);
+                indexStream.push_back(index[i - 1]);
+                indexStream.push_back(index[i]);
+            }
+            break;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const Uint16* getQuadIndices()
+{
+    return quadIndices.indices;
+}
+
+} // namespace priv
+
+} // namespace sf
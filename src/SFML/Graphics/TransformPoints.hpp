@@ -0,0 +1,160 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TRANSFORMPOINTS_HPP
+#define SFML_TRANSFORMPOINTS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+struct Vertex;
+class Transform;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Transform an array of 2D points
+///
+/// Points are read from and written to arrays of arbitrary
+/// stride, so that this function can work directly on the
+/// positions of vertices. \a input and \a output may be
+/// the same array, but must not partially overlap.
+///
+/// Depending on the target architecture, points are
+/// processed with SSE2 or NEON instructions.
+///
+/// \param matrix       4x4 matrix of the transform, as returned by Transform::getMatrix
+/// \param input        Pointer to the first point to transform (two floats)
+/// \param inputStride  Distance in bytes between two input points
+/// \param output       Pointer to the first transformed point (two floats)
+/// \param outputStride Distance in bytes between two output points
+/// \param count        Number of points to transform
+///
+////////////////////////////////////////////////////////////
+void transformPoints(const float* matrix, const void* input, std::size_t inputStride,
+                     void* output, std::size_t outputStride, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Copy an array of vertices and transform their positions
+///
+/// Colors and texture coordinates are copied as a whole
+/// block, then positions are transformed in place.
+///
+/// \param transform Transform to apply to the positions
+/// \param input     Pointer to the vertices to transform
+/// \param output    Pointer to the destination vertices, must not overlap \a input
+/// \param count     Number of vertices to transform
+///
+////////////////////////////////////////////////////////////
+void transformVertices(const Transform& transform, const Vertex* input, Vertex* output, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Get the list primitive type into which primitives
+///        of the given type are converted by appendPrimitives
+///
+/// \param type Type of primitives
+///
+/// \return Points, Lines or Triangles
+///
+////////////////////////////////////////////////////////////
+PrimitiveType getListPrimitiveType(PrimitiveType type);
+
+////////////////////////////////////////////////////////////
+/// \brief Append transformed primitives to a vertex stream
+///
+/// Connected primitives (strips, fans, quads) are converted
+/// to the corresponding list type (see getListPrimitiveType),
+/// so that the primitives of several calls can be concatenated
+/// and drawn at once.
+///
+/// \param stream      Vertex stream to append to
+/// \param transform   Transform to apply to the positions
+/// \param vertices    Pointer to the vertices to append
+/// \param vertexCount Number of vertices in the array
+/// \param type        Type of primitives
+///
+////////////////////////////////////////////////////////////
+void appendPrimitives(std::vector<Vertex>& stream, const Transform& transform,
+                      const Vertex* vertices, std::size_t vertexCount, PrimitiveType type);
+
+////////////////////////////////////////////////////////////
+/// \brief Append transformed primitives to an indexed stream
+///
+/// The vertices are appended as they are (only their position
+/// is transformed), and the indices that assemble them are
+/// converted to the corresponding list type (see
+/// getListPrimitiveType): a quad or a 4-vertex strip costs
+/// 4 vertices instead of 6, and the primitives keep the
+/// exact same triangulation. The new indices refer to the
+/// vertices of the stream, which must not hold more than
+/// 65536 vertices once the new ones are appended.
+///
+/// \param vertexStream Vertex stream to append to
+/// \param indexStream  Index stream to append to
+/// \param transform    Transform to apply to the positions
+/// \param vertices     Pointer to the vertices to append
+/// \param vertexCount  Number of vertices in the array
+/// \param type         Type of primitives
+/// \param indices      Indices that assemble the vertices (2 or 4 bytes each), or NULL to take the vertices in order
+/// \param indexCount   Number of indices
+/// \param indexSize    Size of an index, in bytes
+///
+////////////////////////////////////////////////////////////
+void appendIndexedPrimitives(std::vector<Vertex>& vertexStream, std::vector<Uint16>& indexStream,
+                             const Transform& transform, const Vertex* vertices, std::size_t vertexCount,
+                             PrimitiveType type, const void* indices = NULL, std::size_t indexCount = 0,
+                             std::size_t indexSize = 2);
+
+////////////////////////////////////////////////////////////
+/// \brief Maximum number of quads drawn by the shared quad indices
+///
+////////////////////////////////////////////////////////////
+enum {QuadIndicesQuadCount = 16384};
+
+////////////////////////////////////////////////////////////
+/// \brief Get the indices that draw quads as triangle lists
+///
+/// The array contains the indices of QuadIndicesQuadCount
+/// consecutive quads, i.e. (0, 1, 2, 0, 2, 3), then the same
+/// triangles for the vertices 4 to 7, etc.
+///
+/// \return Pointer to the shared quad indices
+///
+////////////////////////////////////////////////////////////
+const Uint16* getQuadIndices();
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_TRANSFORMPOINTS_HPP
@@ -37,6 +37,9 @@ m_origin                    (0, 0),
 m_position                  (0, 0),
 m_rotation                  (0),
 m_scale                     (1, 1),
+m_trigRotation              (0),
+m_cosine                    (1),
+m_sine                      (0),
 m_transform                 (),
 m_transformNeedUpdate       (true),
 m_inverseTransform          (),
@@ -58,6 +61,8 @@ void Transformable::setPosition(float x, float y)
     m_position.y = y;
     m_transformNeedUpdate = true;
     m_inverseTransformNeedUpdate = true;
+
+    onTransformChanged();
 }
 
 
@@ -77,6 +82,8 @@ void Transformable::setRotation(float angle)
 
     m_transformNeedUpdate = true;
     m_inverseTransformNeedUpdate = true;
+
+    onTransformChanged();
 }
 
 
@@ -87,6 +94,8 @@ void Transformable::setScale(float factorX, float factorY)
     m_scale.y = factorY;
     m_transformNeedUpdate = true;
     m_inverseTransformNeedUpdate = true;
+
+    onTransformChanged();
 }
 
 
@@ -104,6 +113,8 @@ void Transformable::setOrigin(float x, float y)
     m_origin.y = y;
     m_transformNeedUpdate = true;
     m_inverseTransformNeedUpdate = true;
+
+    onTransformChanged();
 }
 
 
@@ -183,9 +194,17 @@ const Transform& Transformable::getTransform() const
     // Recompute the combined transform if needed
     if (m_transformNeedUpdate)
     {
-        float angle  = -m_rotation * 3.141592654f / 180.f;
-        float cosine = static_cast<float>(std::cos(angle));
-        float sine   = static_cast<float>(std::sin(angle));
+        // Moving or scaling an object doesn't change its rotation, the trigonometry can be skipped
+        if (m_rotation != m_trigRotation)
+        {
+            float angle = -m_rotation * 3.141592654f / 180.f;
+            m_cosine = static_cast<float>(std::cos(angle));
+            m_sine = static_cast<float>(std::sin(angle));
+            m_trigRotation = m_rotation;
+        }
+
+        float cosine = m_cosine;
+        float sine   = m_sine;
         float sxc    = m_scale.x * cosine;
         float syc    = m_scale.y * cosine;
         float sxs    = m_scale.x * sine;
@@ -216,4 +235,11 @@ const Transform& Transformable::getInverseTransform() const
     return m_inverseTransform;
 }
 
+
+////////////////////////////////////////////////////////////
+void Transformable::onTransformChanged()
+{
+    // Nothing to do by default
+}
+
 } // namespace sf
@@ -0,0 +1,338 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TransformableArray.hpp>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SFML_TRANSFORM_SSE2
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define SFML_TRANSFORM_NEON
+#endif
+
+
+namespace
+{
+    // Bring an angle back to [0, 360], like sf::Transformable does
+    float normalizeAngle(float angle)
+    {
+        angle = static_cast<float>(std::fmod(angle, 360.f));
+        if (angle < 0)
+            angle += 360.f;
+
+        return angle;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TransformableArray::TransformableArray() :
+m_needsUpdate       (false),
+m_anyRotationChanged(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TransformableArray::TransformableArray(std::size_t count) :
+m_needsUpdate       (false),
+m_anyRotationChanged(false)
+{
+    resize(count);
+}
+
+
+////////////////////////////////////////////////////////////
+void TransformableArray::resize(std::size_t count)
+{
+    m_positionX.resize(count, 0.f);
+    m_positionY.resize(count, 0.f);
+    m_rotation.resize(count, 0.f);
+    m_scaleX.resize(count, 1.f);
+    m_scaleY.resize(count, 1.f);
+    m_originX.resize(count, 0.f);
+    m_originY.resize(count, 0.f);
+    m_cosine.resize(count, 1.f);
+    m_sine.resize(count, 0.f);
+    m_rotationChanged.resize(count, 0);
+    for (int i = 0; i < 6; ++i)
+        m_affine[i].resize(count, 0.f);
+
+    m_needsUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TransformableArray::getSize() const
+{
+    return m_positionX.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void TransformableArray::setPosition(std::size_t index, const Vector2f& position)
+{
+    m_positionX[index] = position.x;
+    m_positionY[index] = position.y;
+    m_needsUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TransformableArray::setRotation(std::size_t index, float angle)
+{
+    m_rotation[index] = normalizeAngle(angle);
+    m_rotationChanged[index] = 1;
+    m_anyRotationChanged = true;
+    m_needsUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TransformableArray::setScale(std::size_t index, const Vector2f& factors)
+{
+    m_scaleX[index] = factors.x;
+    m_scaleY[index] = factors.y;
+    m_needsUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TransformableArray::setOrigin(std::size_t index, const Vector2f& origin)
+{
+    m_originX[index] = origin.x;
+    m_originY[index] = origin.y;
+    m_needsUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2f TransformableArray::getPosition(std::size_t index) const
+{
+    return Vector2f(m_positionX[index], m_positionY[index]);
+}
+
+
+////////////////////////////////////////////////////////////
+float TransformableArray::getRotation(std::size_t index) const
+{
+    return m_rotation[index];
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2f TransformableArray::getScale(std::size_t index) const
+{
+    return Vector2f(m_scaleX[index], m_scaleY[index]);
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2f TransformableArray::getOrigin(std::size_t index) const
+{
+    return Vector2f(m_originX[index], m_originY[index]);
+}
+
+
+////////////////////////////////////////////////////////////
+void TransformableArray::move(const Vector2f* offsets)
+{
+    for (std::size_t i = 0; i < m_positionX.size(); ++i)
+    {
+        m_positionX[i] += offsets[i].x;
+        m_positionY[i] += offsets[i].y;
+    }
+
+    m_needsUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TransformableArray::rotate(const float* angles)
+{
+    for (std::size_t i = 0; i < m_rotation.size(); ++i)
+    {
+        if (angles[i] != 0.f)
+        {
+            m_rotation[i] = normalizeAngle(m_rotation[i] + angles[i]);
+            m_rotationChanged[i] = 1;
+            m_anyRotationChanged = true;
+        }
+    }
+
+    m_needsUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+Transform TransformableArray::getTransform(std::size_t index) const
+{
+    ensureUpdate();
+
+    return Transform(m_affine[0][index], m_affine[1][index], m_affine[2][index],
+                     m_affine[3][index], m_affine[4][index], m_affine[5][index],
+                     0.f,                0.f,                1.f);
+}
+
+
+////////////////////////////////////////////////////////////
+void TransformableArray::getAffineTransform(std::size_t index, float* coefficients) const
+{
+    ensureUpdate();
+
+    for (int i = 0; i < 6; ++i)
+        coefficients[i] = m_affine[i][index];
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2f TransformableArray::transformPoint(std::size_t index, const Vector2f& point) const
+{
+    ensureUpdate();
+
+    return Vector2f(m_affine[0][index] * point.x + m_affine[1][index] * point.y + m_affine[2][index],
+                    m_affine[3][index] * point.x + m_affine[4][index] * point.y + m_affine[5][index]);
+}
+
+
+////////////////////////////////////////////////////////////
+void TransformableArray::ensureUpdate() const
+{
+    if (!m_needsUpdate)
+        return;
+
+    std::size_t count = m_positionX.size();
+
+    // Only the elements whose rotation changed need new trigonometry
+    if (m_anyRotationChanged)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (m_rotationChanged[i])
+            {
+                float angle = -m_rotation[i] * 3.141592654f / 180.f;
+                m_cosine[i] = static_cast<float>(std::cos(angle));
+                m_sine[i] = static_cast<float>(std::sin(angle));
+                m_rotationChanged[i] = 0;
+            }
+        }
+
+        m_anyRotationChanged = false;
+    }
+
+    if (!count)
+    {
+        m_needsUpdate = false;
+        return;
+    }
+
+    // Same computation as sf::Transformable::getTransform, for several elements at once
+    const float* px = &m_positionX[0];
+    const float* py = &m_positionY[0];
+    const float* sx = &m_scaleX[0];
+    const float* sy = &m_scaleY[0];
+    const float* ox = &m_originX[0];
+    const float* oy = &m_originY[0];
+    const float* cosine = &m_cosine[0];
+    const float* sine = &m_sine[0];
+    float* a00 = &m_affine[0][0];
+    float* a01 = &m_affine[1][0];
+    float* a02 = &m_affine[2][0];
+    float* a10 = &m_affine[3][0];
+    float* a11 = &m_affine[4][0];
+    float* a12 = &m_affine[5][0];
+
+    std::size_t i = 0;
+
+#if defined(SFML_TRANSFORM_SSE2)
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 c   = _mm_loadu_ps(cosine + i);
+        __m128 s   = _mm_loadu_ps(sine + i);
+        __m128 sxc = _mm_mul_ps(_mm_loadu_ps(sx + i), c);
+        __m128 syc = _mm_mul_ps(_mm_loadu_ps(sy + i), c);
+        __m128 sxs = _mm_mul_ps(_mm_loadu_ps(sx + i), s);
+        __m128 sys = _mm_mul_ps(_mm_loadu_ps(sy + i), s);
+        __m128 x   = _mm_loadu_ps(ox + i);
+        __m128 y   = _mm_loadu_ps(oy + i);
+
+        _mm_storeu_ps(a00 + i, sxc);
+        _mm_storeu_ps(a01 + i, sys);
+        _mm_storeu_ps(a02 + i, _mm_sub_ps(_mm_loadu_ps(px + i), _mm_add_ps(_mm_mul_ps(x, sxc), _mm_mul_ps(y, sys))));
+        _mm_storeu_ps(a10 + i, _mm_sub_ps(_mm_setzero_ps(), sxs));
+        _mm_storeu_ps(a11 + i, syc);
+        _mm_storeu_ps(a12 + i, _mm_add_ps(_mm_loadu_ps(py + i), _mm_sub_ps(_mm_mul_ps(x, sxs), _mm_mul_ps(y, syc))));
+    }
+
+#elif defined(SFML_TRANSFORM_NEON)
+
+    for (; i + 4 <= count; i += 4)
+    {
+        float32x4_t c   = vld1q_f32(cosine + i);
+        float32x4_t s   = vld1q_f32(sine + i);
+        float32x4_t sxc = vmulq_f32(vld1q_f32(sx + i), c);
+        float32x4_t syc = vmulq_f32(vld1q_f32(sy + i), c);
+        float32x4_t sxs = vmulq_f32(vld1q_f32(sx + i), s);
+        float32x4_t sys = vmulq_f32(vld1q_f32(sy + i), s);
+        float32x4_t x   = vld1q_f32(ox + i);
+        float32x4_t y   = vld1q_f32(oy + i);
+
+        vst1q_f32(a00 + i, sxc);
+        vst1q_f32(a01 + i, sys);
+        vst1q_f32(a02 + i, vmlsq_f32(vmlsq_f32(vld1q_f32(px + i), x, sxc), y, sys));
+        vst1q_f32(a10 + i, vnegq_f32(sxs));
+        vst1q_f32(a11 + i, syc);
+        vst1q_f32(a12 + i, vmlsq_f32(vmlaq_f32(vld1q_f32(py + i), x, sxs), y, syc));
+    }
+
+#endif
+
+    // Remaining elements (or all of them without SIMD support)
+    for (; i < count; ++i)
+    {
+        float sxc = sx[i] * cosine[i];
+        float syc = sy[i] * cosine[i];
+        float sxs = sx[i] * sine[i];
+        float sys = sy[i] * sine[i];
+
+        a00[i] = sxc;
+        a01[i] = sys;
+        a02[i] = -ox[i] * sxc - oy[i] * sys + px[i];
+        a10[i] = -sxs;
+        a11[i] = syc;
+        a12[i] = ox[i] * sxs - oy[i] * syc + py[i];
+    }
+
+    m_needsUpdate = false;
+}
+
+} // namespace sf
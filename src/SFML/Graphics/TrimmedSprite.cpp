@@ -0,0 +1,194 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TrimmedSprite.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
+#include <cstdlib>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TrimmedSprite::TrimmedSprite() :
+m_vertices   (),
+m_mesh       (),
+m_color      (Color::White),
+m_texture    (NULL),
+m_textureRect()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TrimmedSprite::TrimmedSprite(const Texture& texture, const SpriteMesh& mesh) :
+m_vertices   (),
+m_mesh       (mesh),
+m_color      (Color::White),
+m_texture    (NULL),
+m_textureRect()
+{
+    setTexture(texture);
+    updateVertices();
+}
+
+
+////////////////////////////////////////////////////////////
+TrimmedSprite::TrimmedSprite(const Texture& texture, const IntRect& rectangle, const SpriteMesh& mesh) :
+m_vertices   (),
+m_mesh       (mesh),
+m_color      (Color::White),
+m_texture    (NULL),
+m_textureRect()
+{
+    setTexture(texture);
+    setTextureRect(rectangle);
+    updateVertices();
+}
+
+
+////////////////////////////////////////////////////////////
+void TrimmedSprite::setTexture(const Texture& texture, bool resetRect)
+{
+    // Recompute the texture area if requested, or if there was no valid texture & rect before
+    if (resetRect || (!m_texture && (m_textureRect == sf::IntRect())))
+        setTextureRect(IntRect(0, 0, texture.getSize().x, texture.getSize().y));
+
+    // Assign the new texture
+    m_texture = &texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void TrimmedSprite::setTextureRect(const IntRect& rectangle)
+{
+    if (rectangle != m_textureRect)
+    {
+        m_textureRect = rectangle;
+        updateVertices();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TrimmedSprite::setMesh(const SpriteMesh& mesh)
+{
+    m_mesh = mesh;
+    updateVertices();
+}
+
+
+////////////////////////////////////////////////////////////
+void TrimmedSprite::setColor(const Color& color)
+{
+    m_color = color;
+    for (std::size_t i = 0; i < m_vertices.size(); ++i)
+        m_vertices[i].color = color;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* TrimmedSprite::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const IntRect& TrimmedSprite::getTextureRect() const
+{
+    return m_textureRect;
+}
+
+
+////////////////////////////////////////////////////////////
+const SpriteMesh& TrimmedSprite::getMesh() const
+{
+    return m_mesh;
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& TrimmedSprite::getColor() const
+{
+    return m_color;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TrimmedSprite::getLocalBounds() const
+{
+    float width = static_cast<float>(std::abs(m_textureRect.width));
+    float height = static_cast<float>(std::abs(m_textureRect.height));
+
+    return FloatRect(0.f, 0.f, width, height);
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TrimmedSprite::getGlobalBounds() const
+{
+    return getTransform().transformRect(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void TrimmedSprite::draw(RenderTarget& target, RenderStates states) const
+{
+    if (m_texture && (m_vertices.size() >= 3))
+    {
+        states.transform *= getTransform();
+        states.texture = m_texture;
+        target.draw(&m_vertices[0], m_vertices.size(), TrianglesFan, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TrimmedSprite::updateVertices()
+{
+    m_vertices.resize(m_mesh.getPointCount());
+
+    // The mesh points are offsets in the unflipped area of the texture; a flipped
+    // rect mirrors their positions, as sf::Sprite mirrors its texture coordinates
+    float width  = static_cast<float>(std::abs(m_textureRect.width));
+    float height = static_cast<float>(std::abs(m_textureRect.height));
+    float left   = static_cast<float>(std::min(m_textureRect.left, m_textureRect.left + m_textureRect.width));
+    float top    = static_cast<float>(std::min(m_textureRect.top, m_textureRect.top + m_textureRect.height));
+
+    for (std::size_t i = 0; i < m_vertices.size(); ++i)
+    {
+        Vector2f point = m_mesh.getPoint(i);
+        m_vertices[i].position.x = (m_textureRect.width < 0) ? width - point.x : point.x;
+        m_vertices[i].position.y = (m_textureRect.height < 0) ? height - point.y : point.y;
+        m_vertices[i].texCoords = Vector2f(left + point.x, top + point.y);
+        m_vertices[i].color = m_color;
+    }
+}
+
+} // namespace sf
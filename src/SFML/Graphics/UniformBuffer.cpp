@@ -0,0 +1,220 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/UniformBuffer.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace
+{
+    sf::Mutex mutex;
+
+    bool checkUniformBuffersAvailable()
+    {
+        // Create a temporary context in case the user checks
+        // before a GlResource is created, thus initializing
+        // the shared context
+        sf::Context context;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        return GLEXT_vertex_buffer_object && GLEXT_uniform_buffer_object;
+    }
+
+    unsigned int checkMaximumBindings()
+    {
+        GLint bindings = 0;
+
+    #ifndef SFML_OPENGL_ES
+        if (GLEXT_vertex_buffer_object && GLEXT_uniform_buffer_object)
+        {
+            glCheck(glGetIntegerv(GLEXT_GL_MAX_UNIFORM_BUFFER_BINDINGS, &bindings));
+        }
+    #endif
+
+        return static_cast<unsigned int>(bindings);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+UniformBuffer::UniformBuffer() :
+m_buffer(0),
+m_size  (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+UniformBuffer::~UniformBuffer()
+{
+    if (m_buffer)
+    {
+        ensureGlContext();
+
+        GLuint buffer = static_cast<GLuint>(m_buffer);
+        glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool UniformBuffer::create(std::size_t size)
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!isAvailable())
+    {
+        err() << "Failed to create uniform buffer: your system doesn't support uniform buffers "
+              << "(you should test UniformBuffer::isAvailable() before trying to use the UniformBuffer class)" << std::endl;
+        return false;
+    }
+
+    ensureGlContext();
+
+    if (!m_buffer)
+    {
+        GLuint buffer = 0;
+        glCheck(GLEXT_glGenBuffers(1, &buffer));
+        m_buffer = static_cast<unsigned int>(buffer);
+    }
+
+    if (!m_buffer)
+    {
+        err() << "Could not create uniform buffer, generation failed" << std::endl;
+        return false;
+    }
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_UNIFORM_BUFFER, m_buffer));
+    glCheck(GLEXT_glBufferData(GLEXT_GL_UNIFORM_BUFFER, size, 0, GLEXT_GL_DYNAMIC_DRAW));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_UNIFORM_BUFFER, 0));
+
+    m_size = size;
+
+    return true;
+
+#else
+
+    err() << "Failed to create uniform buffer: uniform buffers are not supported with OpenGL ES 1" << std::endl;
+    return false;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t UniformBuffer::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+bool UniformBuffer::update(const void* data, std::size_t size, std::size_t offset)
+{
+#ifndef SFML_OPENGL_ES
+
+    // Sanity checks
+    if (!m_buffer || !data || (offset + size > m_size))
+        return false;
+
+    ensureGlContext();
+
+    // The binding points are left untouched, only the generic binding is used
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_UNIFORM_BUFFER, m_buffer));
+    glCheck(GLEXT_glBufferSubData(GLEXT_GL_UNIFORM_BUFFER, offset, size, data));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_UNIFORM_BUFFER, 0));
+
+    return true;
+
+#else
+
+    return false;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int UniformBuffer::getNativeHandle() const
+{
+    return m_buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+void UniformBuffer::bind(const UniformBuffer* buffer, unsigned int binding)
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!isAvailable())
+        return;
+
+    ensureGlContext();
+
+    glCheck(GLEXT_glBindBufferBase(GLEXT_GL_UNIFORM_BUFFER, binding, buffer ? buffer->m_buffer : 0));
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int UniformBuffer::getMaximumBindings()
+{
+    if (!isAvailable())
+        return 0;
+
+    ensureGlContext();
+
+    // TODO: Remove this lock when it becomes unnecessary in C++11
+    Lock lock(mutex);
+
+    static unsigned int bindings = checkMaximumBindings();
+
+    return bindings;
+}
+
+
+////////////////////////////////////////////////////////////
+bool UniformBuffer::isAvailable()
+{
+    // TODO: Remove this lock when it becomes unnecessary in C++11
+    Lock lock(mutex);
+
+    static bool available = checkUniformBuffersAvailable();
+
+    return available;
+}
+
+} // namespace sf
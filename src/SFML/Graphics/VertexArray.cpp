@@ -27,6 +27,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
 
 
 namespace sf
@@ -34,7 +35,9 @@ namespace sf
 ////////////////////////////////////////////////////////////
 VertexArray::VertexArray() :
 m_vertices     (),
-m_primitiveType(Points)
+m_primitiveType(Points),
+m_bounds       (),
+m_boundsValid  (true)
 {
 }
 
@@ -42,7 +45,9 @@ m_primitiveType(Points)
 ////////////////////////////////////////////////////////////
 VertexArray::VertexArray(PrimitiveType type, std::size_t vertexCount) :
 m_vertices     (vertexCount),
-m_primitiveType(type)
+m_primitiveType(type),
+m_bounds       (),
+m_boundsValid  (false)
 {
 }
 
@@ -57,6 +62,9 @@ std::size_t VertexArray::getVertexCount() const
 ////////////////////////////////////////////////////////////
 Vertex& VertexArray::operator [](std::size_t index)
 {
+    // The vertex may be modified through the reference
+    m_boundsValid = false;
+
     return m_vertices[index];
 }
 
@@ -72,6 +80,8 @@ const Vertex& VertexArray::operator [](std::size_t index) const
 void VertexArray::clear()
 {
     m_vertices.clear();
+    m_bounds = FloatRect();
+    m_boundsValid = true;
 }
 
 
@@ -79,12 +89,30 @@ void VertexArray::clear()
 void VertexArray::resize(std::size_t vertexCount)
 {
     m_vertices.resize(vertexCount);
+    m_boundsValid = false;
 }
 
 
 ////////////////////////////////////////////////////////////
 void VertexArray::append(const Vertex& vertex)
 {
+    // Extend valid bounds instead of computing them again
+    if (m_boundsValid)
+    {
+        if (m_vertices.empty())
+        {
+            m_bounds = FloatRect(vertex.position.x, vertex.position.y, 0, 0);
+        }
+        else
+        {
+            float left   = std::min(m_bounds.left, vertex.position.x);
+            float top    = std::min(m_bounds.top, vertex.position.y);
+            float right  = std::max(m_bounds.left + m_bounds.width, vertex.position.x);
+            float bottom = std::max(m_bounds.top + m_bounds.height, vertex.position.y);
+            m_bounds = FloatRect(left, top, right - left, bottom - top);
+        }
+    }
+
     m_vertices.push_back(vertex);
 }
 
@@ -106,6 +134,9 @@ PrimitiveType VertexArray::getPrimitiveType() const
 ////////////////////////////////////////////////////////////
 FloatRect VertexArray::getBounds() const
 {
+    if (m_boundsValid)
+        return m_bounds;
+
     if (!m_vertices.empty())
     {
         float left   = m_vertices[0].position.x;
@@ -130,21 +161,43 @@ FloatRect VertexArray::getBounds() const
                 bottom = position.y;
         }
 
-        return FloatRect(left, top, right - left, bottom - top);
+        m_bounds = FloatRect(left, top, right - left, bottom - top);
     }
     else
     {
         // Array is empty
-        return FloatRect();
+        m_bounds = FloatRect();
     }
+
+    m_boundsValid = true;
+
+    return m_bounds;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexArray::swap(VertexArray& right)
+{
+    m_vertices.swap(right.m_vertices);
+    std::swap(m_primitiveType, right.m_primitiveType);
+    std::swap(m_bounds,        right.m_bounds);
+    std::swap(m_boundsValid,   right.m_boundsValid);
 }
 
 
 ////////////////////////////////////////////////////////////
 void VertexArray::draw(RenderTarget& target, RenderStates states) const
 {
-    if (!m_vertices.empty())
-        target.draw(&m_vertices[0], m_vertices.size(), m_primitiveType, states);
+    if (m_vertices.empty())
+        return;
+
+    // Give the cached bounds to the culling, instead of letting it walk the vertices
+    FloatRect bounds;
+    if (target.isCullingEnabled())
+        bounds = getBounds();
+
+    target.drawVertices(&m_vertices[0], m_vertices.size(), m_primitiveType, states,
+                        target.isCullingEnabled() ? &bounds : NULL);
 }
 
 } // namespace sf
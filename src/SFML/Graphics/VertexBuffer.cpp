@@ -0,0 +1,348 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/CompactVertex.hpp>
+#include <SFML/Graphics/LayeredVertex.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    sf::Mutex mutex;
+
+    bool checkVertexBuffersAvailable()
+    {
+        // Create a temporary context in case the user checks
+        // before a GlResource is created, thus initializing
+        // the shared context
+        sf::Context context;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        return GLEXT_vertex_buffer_object;
+    }
+
+    // Convert an sf::VertexBuffer::Usage constant to the corresponding OpenGL constant.
+    GLenum usageToGlEnum(sf::VertexBuffer::Usage usage)
+    {
+        switch (usage)
+        {
+            case sf::VertexBuffer::Static:  return GLEXT_GL_STATIC_DRAW;
+            case sf::VertexBuffer::Dynamic: return GLEXT_GL_DYNAMIC_DRAW;
+            default:                        return GLEXT_GL_STREAM_DRAW;
+        }
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+VertexBuffer::VertexBuffer() :
+m_buffer       (0),
+m_size         (0),
+m_primitiveType(Points),
+m_usage        (Stream),
+m_format       (Full)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+VertexBuffer::VertexBuffer(PrimitiveType type, Usage usage, Format format) :
+m_buffer       (0),
+m_size         (0),
+m_primitiveType(type),
+m_usage        (usage),
+m_format       (format)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+VertexBuffer::~VertexBuffer()
+{
+    if (m_buffer)
+    {
+        ensureGlContext();
+
+        GLuint buffer = static_cast<GLuint>(m_buffer);
+        glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexBuffer::create(std::size_t vertexCount)
+{
+    if (!isAvailable())
+        return false;
+
+    ensureGlContext();
+
+    if (!m_buffer)
+    {
+        GLuint buffer = 0;
+        glCheck(GLEXT_glGenBuffers(1, &buffer));
+        m_buffer = static_cast<unsigned int>(buffer);
+    }
+
+    if (!m_buffer)
+    {
+        err() << "Could not create vertex buffer, generation failed" << std::endl;
+        return false;
+    }
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
+    glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, getVertexSize() * vertexCount, 0, usageToGlEnum(m_usage)));
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+
+    m_size = vertexCount;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t VertexBuffer::getVertexCount() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexBuffer::update(const Vertex* vertices)
+{
+    return update(vertices, m_size, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexBuffer::update(const Vertex* vertices, std::size_t vertexCount, unsigned int offset)
+{
+    return updateVertices(vertices, vertexCount, offset, Full);
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexBuffer::update(const CompactVertex* vertices, std::size_t vertexCount, unsigned int offset)
+{
+    return updateVertices(vertices, vertexCount, offset, Compact);
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexBuffer::update(const UncoloredVertex* vertices, std::size_t vertexCount, unsigned int offset)
+{
+    return updateVertices(vertices, vertexCount, offset, Uncolored);
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexBuffer::update(const LayeredVertex* vertices, std::size_t vertexCount, unsigned int offset)
+{
+    return updateVertices(vertices, vertexCount, offset, Layered);
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexBuffer::updateVertices(const void* vertices, std::size_t vertexCount, unsigned int offset, Format format)
+{
+    // Sanity checks
+    if (!m_buffer)
+        return false;
+
+    if (format != m_format)
+    {
+        err() << "Failed to update vertex buffer: the vertices don't match the format of the buffer" << std::endl;
+        return false;
+    }
+
+    if (!vertices)
+        return false;
+
+    if (offset && (offset + vertexCount > m_size))
+        return false;
+
+    ensureGlContext();
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
+
+    std::size_t vertexSize = getVertexSize();
+
+    // Check if we need to enlarge the buffer
+    if (vertexCount > m_size)
+    {
+        glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, vertexSize * vertexCount, 0, usageToGlEnum(m_usage)));
+
+        m_size = vertexCount;
+    }
+
+    glCheck(GLEXT_glBufferSubData(GLEXT_GL_ARRAY_BUFFER, vertexSize * offset, vertexSize * vertexCount, vertices));
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexBuffer::swap(VertexBuffer& right)
+{
+    std::swap(m_size,          right.m_size);
+    std::swap(m_buffer,        right.m_buffer);
+    std::swap(m_primitiveType, right.m_primitiveType);
+    std::swap(m_usage,         right.m_usage);
+    std::swap(m_format,        right.m_format);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int VertexBuffer::getNativeHandle() const
+{
+    return m_buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexBuffer::setPrimitiveType(PrimitiveType type)
+{
+    m_primitiveType = type;
+}
+
+
+////////////////////////////////////////////////////////////
+PrimitiveType VertexBuffer::getPrimitiveType() const
+{
+    return m_primitiveType;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexBuffer::setUsage(Usage usage)
+{
+    m_usage = usage;
+}
+
+
+////////////////////////////////////////////////////////////
+VertexBuffer::Usage VertexBuffer::getUsage() const
+{
+    return m_usage;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexBuffer::setFormat(Format format)
+{
+    // The allocated memory was sized for the previous format
+    if (format != m_format)
+    {
+        m_format = format;
+        m_size = 0;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+VertexBuffer::Format VertexBuffer::getFormat() const
+{
+    return m_format;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t VertexBuffer::getVertexSize() const
+{
+    switch (m_format)
+    {
+        case Compact:   return sizeof(CompactVertex);
+        case Uncolored: return sizeof(UncoloredVertex);
+        case Layered:   return sizeof(LayeredVertex);
+        default:        return sizeof(Vertex);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexBuffer::bind(const VertexBuffer* vertexBuffer)
+{
+    if (!isAvailable())
+        return;
+
+    ensureGlContext();
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, vertexBuffer ? vertexBuffer->m_buffer : 0));
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexBuffer::bindStorage(const VertexBuffer* vertexBuffer, unsigned int binding)
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!isAvailable() || !Shader::isComputeAvailable())
+        return;
+
+    ensureGlContext();
+
+    glCheck(GLEXT_glBindBufferBase(GLEXT_GL_SHADER_STORAGE_BUFFER, binding, vertexBuffer ? vertexBuffer->m_buffer : 0));
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexBuffer::isAvailable()
+{
+    // TODO: Remove this lock when it becomes unnecessary in C++11
+    Lock lock(mutex);
+
+    static bool available = checkVertexBuffersAvailable();
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexBuffer::draw(RenderTarget& target, RenderStates states) const
+{
+    if (m_buffer && m_size)
+        target.draw(*this, 0, m_size, states);
+}
+
+} // namespace sf
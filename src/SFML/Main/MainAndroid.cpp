@@ -42,7 +42,7 @@
 #include <SFML/System/Sleep.hpp>
 #include <SFML/System/Thread.hpp>
 #include <SFML/System/Lock.hpp>
-#include <SFML/System/Err.hpp>
+#include <SFML/System/Log.hpp>
 #include <android/window.h>
 #include <android/native_activity.h>
 
@@ -486,8 +486,10 @@ void ANativeActivity_onCreate(ANativeActivity* activity, void* savedState, size_
 
     getScreenSizeInPixels(activity, &states->screenSize.x, &states->screenSize.y);
 
-    // Redirect error messages to logcat
-    sf::err().rdbuf(&states->logcat);
+    // Redirect the log, which receives the error and warning messages, to logcat
+    static std::ostream logcatOutput(NULL);
+    logcatOutput.rdbuf(&states->logcat);
+    sf::Log::setOutput(&logcatOutput);
 
     // Launch the main thread
     sf::Thread* thread = new sf::Thread(sf::priv::main, states);
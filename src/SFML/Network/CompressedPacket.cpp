@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/CompressedPacket.hpp>
+#include <SFML/Network/Lz4.hpp>
+#include <SFML/System/Err.hpp>
+#include <cstring>
+
+
+namespace
+{
+    // The first byte of the data sent tells how the rest is encoded
+    const sf::Uint8 uncompressed = 0;
+    const sf::Uint8 lz4          = 1;
+
+    // Size of the header of compressed data: method and original size
+    const std::size_t headerSize = 5;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+CompressedPacket::CompressedPacket() :
+m_threshold(128),
+m_buffer   ()
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedPacket::setCompressionThreshold(std::size_t size)
+{
+    m_threshold = size;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t CompressedPacket::getCompressionThreshold() const
+{
+    return m_threshold;
+}
+
+
+////////////////////////////////////////////////////////////
+const void* CompressedPacket::onSend(std::size_t& size)
+{
+    const Uint8* data = static_cast<const Uint8*>(getData());
+    std::size_t dataSize = getDataSize();
+
+    m_buffer.resize(headerSize + priv::lz4CompressBound(dataSize));
+    Uint8* header = reinterpret_cast<Uint8*>(&m_buffer[0]);
+
+    if (dataSize >= m_threshold)
+    {
+        std::size_t compressedSize = priv::lz4Compress(data, dataSize, header + headerSize);
+
+        // Only keep the compressed version if it is actually smaller
+        if (headerSize + compressedSize < 1 + dataSize)
+        {
+            header[0] = lz4;
+            header[1] = static_cast<Uint8>(dataSize >> 24);
+            header[2] = static_cast<Uint8>(dataSize >> 16);
+            header[3] = static_cast<Uint8>(dataSize >> 8);
+            header[4] = static_cast<Uint8>(dataSize);
+
+            size = headerSize + compressedSize;
+            return header;
+        }
+    }
+
+    header[0] = uncompressed;
+    if (dataSize > 0)
+        std::memcpy(header + 1, data, dataSize);
+
+    size = 1 + dataSize;
+    return header;
+}
+
+
+////////////////////////////////////////////////////////////
+void CompressedPacket::onReceive(const void* data, std::size_t size)
+{
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+
+    if ((size >= 1) && (bytes[0] == uncompressed))
+    {
+        append(bytes + 1, size - 1);
+    }
+    else if ((size >= headerSize) && (bytes[0] == lz4))
+    {
+        std::size_t originalSize = (static_cast<std::size_t>(bytes[1]) << 24) |
+                                   (static_cast<std::size_t>(bytes[2]) << 16) |
+                                   (static_cast<std::size_t>(bytes[3]) << 8)  |
+                                    static_cast<std::size_t>(bytes[4]);
+
+        // LZ4 can't expand data more than 255 times: don't let a forged size allocate more
+        if (originalSize / 255 > size)
+        {
+            err() << "Failed to decompress received packet (invalid size)" << std::endl;
+            return;
+        }
+
+        m_buffer.resize(originalSize);
+        if ((originalSize > 0) && !priv::lz4Decompress(bytes + headerSize, size - headerSize, reinterpret_cast<Uint8*>(&m_buffer[0]), originalSize))
+        {
+            err() << "Failed to decompress received packet (corrupted data)" << std::endl;
+            return;
+        }
+
+        append(m_buffer.empty() ? NULL : &m_buffer[0], originalSize);
+    }
+    else
+    {
+        err() << "Failed to decompress received packet (unknown format)" << std::endl;
+    }
+}
+
+} // namespace sf
@@ -0,0 +1,792 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Deflate.hpp>
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+    // Constants of the DEFLATE format
+    const std::size_t windowSize = 32768;
+    const std::size_t minMatch   = 3;
+    const std::size_t maxMatch   = 258;
+    const unsigned int hashLog   = 14;
+
+    // Symbol returned for the codes that don't exist
+    const unsigned int invalidSymbol = 0xFFFF;
+
+    const sf::Uint16 lengthBase[29]      = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+    const sf::Uint8  lengthExtra[29]     = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+    const sf::Uint16 distanceBase[30]    = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+    const sf::Uint8  distanceExtra[30]   = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+    const sf::Uint8  codeLengthOrder[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+    // Table of the CRC-32 used by gzip, computed once
+    struct CrcTable
+    {
+        CrcTable()
+        {
+            for (sf::Uint32 i = 0; i < 256; ++i)
+            {
+                sf::Uint32 value = i;
+                for (int j = 0; j < 8; ++j)
+                    value = (value & 1) ? (0xEDB88320u ^ (value >> 1)) : (value >> 1);
+                values[i] = value;
+            }
+        }
+
+        sf::Uint32 values[256];
+    };
+    const CrcTable crcTable;
+
+    sf::Uint32 updateCrc(sf::Uint32 crc, const sf::Uint8* data, std::size_t size)
+    {
+        crc = ~crc;
+        for (std::size_t i = 0; i < size; ++i)
+            crc = crcTable.values[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    sf::Uint32 updateAdler(sf::Uint32 adler, const sf::Uint8* data, std::size_t size)
+    {
+        sf::Uint32 a = adler & 0xFFFF;
+        sf::Uint32 b = adler >> 16;
+        while (size > 0)
+        {
+            // The sums can't overflow before 5552 bytes
+            std::size_t count = std::min<std::size_t>(size, 5552);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                a += data[i];
+                b += a;
+            }
+
+            a %= 65521;
+            b %= 65521;
+            data += count;
+            size -= count;
+        }
+
+        return (b << 16) | a;
+    }
+
+    // Writer of the bits of a DEFLATE stream, lowest bits first
+    struct BitWriter
+    {
+        BitWriter(std::string& output) : output(output), bits(0), count(0) {}
+
+        void write(sf::Uint32 value, unsigned int bitCount)
+        {
+            bits |= value << count;
+            count += bitCount;
+            while (count >= 8)
+            {
+                output.push_back(static_cast<char>(bits & 0xFF));
+                bits >>= 8;
+                count -= 8;
+            }
+        }
+
+        // Huffman codes are stored from their highest bit
+        void writeCode(sf::Uint32 code, unsigned int bitCount)
+        {
+            sf::Uint32 reversed = 0;
+            for (unsigned int i = 0; i < bitCount; ++i)
+                reversed |= ((code >> i) & 1) << (bitCount - 1 - i);
+            write(reversed, bitCount);
+        }
+
+        void writeSymbol(unsigned int symbol)
+        {
+            // Fixed Huffman code of the literals and lengths
+            if (symbol < 144)
+                writeCode(0x30 + symbol, 8);
+            else if (symbol < 256)
+                writeCode(0x190 + symbol - 144, 9);
+            else if (symbol < 280)
+                writeCode(symbol - 256, 7);
+            else
+                writeCode(0xC0 + symbol - 280, 8);
+        }
+
+        void flush()
+        {
+            if (count > 0)
+                output.push_back(static_cast<char>(bits & 0xFF));
+            bits = 0;
+            count = 0;
+        }
+
+        std::string& output;
+        sf::Uint32   bits;
+        unsigned int count;
+    };
+
+    void writeLittleEndian(std::string& output, sf::Uint32 value)
+    {
+        for (int i = 0; i < 4; ++i)
+            output.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+    }
+
+    unsigned int hash(const sf::Uint8* data)
+    {
+        sf::Uint32 sequence = data[0] | (data[1] << 8) | (data[2] << 16);
+        return (sequence * 2654435761u) >> (32 - hashLog);
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+Inflater::Inflater() :
+m_format   (Deflate),
+m_zlib     (false),
+m_state    (Header),
+m_lastBlock(false),
+m_remaining(0),
+m_input    (),
+m_window   (windowSize),
+m_windowPos(0),
+m_total    (0),
+m_checksum (0)
+{
+    reset(Deflate);
+}
+
+
+////////////////////////////////////////////////////////////
+void Inflater::reset(Format format)
+{
+    m_format = format;
+    m_zlib = false;
+    m_state = Header;
+    m_lastBlock = false;
+    m_remaining = 0;
+    m_input.clear();
+    m_position.byte = 0;
+    m_position.bits = 0;
+    m_position.bitCount = 0;
+    m_windowPos = 0;
+    m_total = 0;
+    m_checksum = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Inflater::update(const char* data, std::size_t size, std::string& output)
+{
+    m_input.insert(m_input.end(), reinterpret_cast<const Uint8*>(data), reinterpret_cast<const Uint8*>(data) + size);
+    std::size_t checked = output.size();
+
+    // Each step returns false when it needs more data (or when the data is corrupted)
+    bool progress = true;
+    while (progress)
+    {
+        switch (m_state)
+        {
+            case Header:      progress = readHeader();                 break;
+            case BlockHeader: progress = readBlockHeader();            break;
+            case Stored:      progress = readStored(output);           break;
+            case Codes:       progress = readCodes(output);            break;
+            case Trailer:     progress = readTrailer(output, checked); break;
+            default:          progress = false;                        break;
+        }
+    }
+
+    // Update the checksum with the data decompressed since the last check
+    updateChecksum(output, checked);
+
+    // Forget the data already decoded
+    m_input.erase(m_input.begin(), m_input.begin() + m_position.byte);
+    m_position.byte = 0;
+
+    return m_state != Corrupted;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Inflater::isFinished() const
+{
+    return m_state == Finished;
+}
+
+
+////////////////////////////////////////////////////////////
+int Inflater::buildHuffman(Huffman& huffman, const Uint8* lengths, unsigned int count)
+{
+    // Count the number of codes of each length
+    std::fill(huffman.count, huffman.count + 16, 0);
+    for (unsigned int i = 0; i < count; ++i)
+        huffman.count[lengths[i]]++;
+    if (huffman.count[0] == count)
+        return 0;
+
+    // Check that the lengths make a valid code: a negative result means over-subscribed, a positive one incomplete
+    int left = 1;
+    for (int length = 1; length < 16; ++length)
+    {
+        left = left * 2 - huffman.count[length];
+        if (left < 0)
+            return left;
+    }
+
+    // Sort the symbols by length, then by value
+    Uint16 offsets[16];
+    offsets[1] = 0;
+    for (int length = 1; length < 15; ++length)
+        offsets[length + 1] = static_cast<Uint16>(offsets[length] + huffman.count[length]);
+
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        if (lengths[i] != 0)
+            huffman.symbol[offsets[lengths[i]]++] = static_cast<Uint16>(i);
+    }
+
+    return left;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Inflater::readBits(unsigned int count, unsigned int& value)
+{
+    while (m_position.bitCount < count)
+    {
+        if (m_position.byte == m_input.size())
+            return false;
+
+        m_position.bits |= static_cast<Uint32>(m_input[m_position.byte++]) << m_position.bitCount;
+        m_position.bitCount += 8;
+    }
+
+    value = m_position.bits & ((1u << count) - 1);
+    m_position.bits >>= count;
+    m_position.bitCount -= count;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Inflater::decodeSymbol(const Huffman& huffman, unsigned int& symbol)
+{
+    // Read the code bit after bit; canonical codes of each length are consecutive integers
+    int code = 0;
+    int first = 0;
+    int index = 0;
+    for (int length = 1; length < 16; ++length)
+    {
+        unsigned int bit;
+        if (!readBits(1, bit))
+            return false;
+
+        code |= static_cast<int>(bit);
+        int count = huffman.count[length];
+        if (code - count < first)
+        {
+            symbol = huffman.symbol[index + (code - first)];
+            return true;
+        }
+
+        index += count;
+        first = (first + count) << 1;
+        code <<= 1;
+    }
+
+    symbol = invalidSymbol;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Inflater::readHeader()
+{
+    const Uint8* data = m_input.empty() ? NULL : &m_input[0];
+    std::size_t size = m_input.size();
+
+    if (m_format == Deflate)
+    {
+        if (size < 2)
+            return false;
+
+        // "deflate" is supposed to be the zlib format, but some servers send raw DEFLATE data:
+        // a valid zlib header (method 8, window up to 32 KB, no dictionary) is very unlikely otherwise
+        m_zlib = ((data[0] & 0x0F) == 8) && ((data[0] >> 4) <= 7) && ((data[0] * 256 + data[1]) % 31 == 0) && !(data[1] & 0x20);
+        m_position.byte = m_zlib ? 2 : 0;
+        m_checksum = 1;
+    }
+    else
+    {
+        if (size < 10)
+            return false;
+
+        if ((data[0] != 0x1F) || (data[1] != 0x8B) || (data[2] != 8))
+        {
+            m_state = Corrupted;
+            return false;
+        }
+
+        // Skip the optional fields: extra data, file name, comment and header checksum
+        Uint8 flags = data[3];
+        std::size_t position = 10;
+        if (flags & 0x04)
+        {
+            if (size < position + 2)
+                return false;
+            position += 2 + (data[position] | (data[position + 1] << 8));
+        }
+        for (Uint8 flag = 0x08; flag <= 0x10; flag <<= 1)
+        {
+            if (flags & flag)
+            {
+                const Uint8* end = (position < size) ? std::find(data + position, data + size, 0) : data + size;
+                if (end == data + size)
+                    return false;
+                position = (end - data) + 1;
+            }
+        }
+        if (flags & 0x02)
+            position += 2;
+        if (position > size)
+            return false;
+
+        m_position.byte = position;
+        m_checksum = 0;
+    }
+
+    m_state = BlockHeader;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Inflater::readBlockHeader()
+{
+    // The whole header is read at once, go back to its beginning if it is incomplete
+    Position start = m_position;
+    unsigned int last;
+    unsigned int type;
+    if (!readBits(1, last) || !readBits(2, type))
+    {
+        m_position = start;
+        return false;
+    }
+
+    m_lastBlock = (last != 0);
+    if (type == 0)
+    {
+        // Stored block: skip to the next byte boundary, then read the length and its complement
+        m_position.bits >>= m_position.bitCount % 8;
+        m_position.bitCount -= m_position.bitCount % 8;
+
+        unsigned int length;
+        unsigned int complement;
+        if (!readBits(16, length) || !readBits(16, complement))
+        {
+            m_position = start;
+            return false;
+        }
+
+        if (length != (~complement & 0xFFFF))
+        {
+            m_state = Corrupted;
+            return false;
+        }
+
+        m_remaining = length;
+        m_state = Stored;
+        return true;
+    }
+    else if (type == 1)
+    {
+        // Fixed Huffman codes
+        Uint8 lengths[288];
+        std::fill(lengths, lengths + 144, 8);
+        std::fill(lengths + 144, lengths + 256, 9);
+        std::fill(lengths + 256, lengths + 280, 7);
+        std::fill(lengths + 280, lengths + 288, 8);
+        buildHuffman(m_lengths, lengths, 288);
+
+        std::fill(lengths, lengths + 30, 5);
+        buildHuffman(m_distances, lengths, 30);
+
+        m_state = Codes;
+        return true;
+    }
+    else if (type == 2)
+    {
+        // Dynamic Huffman codes, themselves compressed with a Huffman code
+        unsigned int lengthCount;
+        unsigned int distanceCount;
+        unsigned int codeCount;
+        if (!readBits(5, lengthCount) || !readBits(5, distanceCount) || !readBits(4, codeCount))
+        {
+            m_position = start;
+            return false;
+        }
+
+        lengthCount += 257;
+        distanceCount += 1;
+        codeCount += 4;
+        if ((lengthCount > 286) || (distanceCount > 30))
+        {
+            m_state = Corrupted;
+            return false;
+        }
+
+        Uint8 lengths[320] = {0};
+        for (unsigned int i = 0; i < codeCount; ++i)
+        {
+            unsigned int length;
+            if (!readBits(3, length))
+            {
+                m_position = start;
+                return false;
+            }
+            lengths[codeLengthOrder[i]] = static_cast<Uint8>(length);
+        }
+
+        Huffman codeLengths;
+        if (buildHuffman(codeLengths, lengths, 19) != 0)
+        {
+            m_state = Corrupted;
+            return false;
+        }
+
+        for (unsigned int i = 0; i < lengthCount + distanceCount;)
+        {
+            unsigned int symbol;
+            if (!decodeSymbol(codeLengths, symbol))
+            {
+                m_position = start;
+                return false;
+            }
+
+            if (symbol < 16)
+            {
+                lengths[i++] = static_cast<Uint8>(symbol);
+                continue;
+            }
+
+            // Repetitions of the previous length (16) or of zeros (17 and 18)
+            unsigned int repeat;
+            unsigned int extra = (symbol == 16) ? 2 : (symbol == 17) ? 3 : 7;
+            if ((symbol > 18) || ((symbol == 16) && (i == 0)))
+            {
+                m_state = Corrupted;
+                return false;
+            }
+            if (!readBits(extra, repeat))
+            {
+                m_position = start;
+                return false;
+            }
+
+            repeat += (symbol == 16) ? 3 : (symbol == 17) ? 3 : 11;
+            if (i + repeat > lengthCount + distanceCount)
+            {
+                m_state = Corrupted;
+                return false;
+            }
+
+            Uint8 length = (symbol == 16) ? lengths[i - 1] : 0;
+            std::fill(lengths + i, lengths + i + repeat, length);
+            i += repeat;
+        }
+
+        // The end-of-block code is mandatory, and only codes made of a single symbol may be incomplete
+        int lengthsLeft = buildHuffman(m_lengths, lengths, lengthCount);
+        int distancesLeft = buildHuffman(m_distances, lengths + lengthCount, distanceCount);
+        if ((lengths[256] == 0) ||
+            (lengthsLeft < 0) || ((lengthsLeft > 0) && (lengthCount - m_lengths.count[0] != 1)) ||
+            (distancesLeft < 0) || ((distancesLeft > 0) && (distanceCount - m_distances.count[0] != 1)))
+        {
+            m_state = Corrupted;
+            return false;
+        }
+
+        m_state = Codes;
+        return true;
+    }
+    else
+    {
+        m_state = Corrupted;
+        return false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Inflater::readStored(std::string& output)
+{
+    // Whole bytes may remain in the bit buffer after the header
+    while ((m_remaining > 0) && (m_position.bitCount >= 8))
+    {
+        Uint8 byte = static_cast<Uint8>(m_position.bits & 0xFF);
+        m_position.bits >>= 8;
+        m_position.bitCount -= 8;
+        write(&byte, 1, output);
+        m_remaining--;
+    }
+
+    std::size_t count = std::min(m_remaining, m_input.size() - m_position.byte);
+    if (count > 0)
+    {
+        write(&m_input[m_position.byte], count, output);
+        m_position.byte += count;
+        m_remaining -= count;
+    }
+
+    if (m_remaining > 0)
+        return false;
+
+    m_state = m_lastBlock ? Trailer : BlockHeader;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Inflater::readCodes(std::string& output)
+{
+    for (;;)
+    {
+        // Symbols are decoded entirely or not at all
+        Position start = m_position;
+        unsigned int symbol;
+        if (!decodeSymbol(m_lengths, symbol))
+        {
+            m_position = start;
+            return false;
+        }
+
+        if (symbol < 256)
+        {
+            // Literal
+            Uint8 byte = static_cast<Uint8>(symbol);
+            write(&byte, 1, output);
+        }
+        else if (symbol == 256)
+        {
+            // End of block
+            m_state = m_lastBlock ? Trailer : BlockHeader;
+            return true;
+        }
+        else
+        {
+            // Back-reference: length, then distance
+            symbol -= 257;
+            if (symbol >= 29)
+            {
+                m_state = Corrupted;
+                return false;
+            }
+
+            unsigned int extra;
+            if (!readBits(lengthExtra[symbol], extra))
+            {
+                m_position = start;
+                return false;
+            }
+            std::size_t length = lengthBase[symbol] + extra;
+
+            if (!decodeSymbol(m_distances, symbol))
+            {
+                m_position = start;
+                return false;
+            }
+            if (symbol >= 30)
+            {
+                m_state = Corrupted;
+                return false;
+            }
+            if (!readBits(distanceExtra[symbol], extra))
+            {
+                m_position = start;
+                return false;
+            }
+            std::size_t distance = distanceBase[symbol] + extra;
+
+            if (distance > std::min(m_total, windowSize))
+            {
+                m_state = Corrupted;
+                return false;
+            }
+
+            // The copy may overlap the bytes it produces
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                Uint8 byte = m_window[(m_windowPos - distance) & (windowSize - 1)];
+                write(&byte, 1, output);
+            }
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Inflater::readTrailer(std::string& output, std::size_t& checked)
+{
+    // The trailer starts at the next byte boundary
+    Position start = m_position;
+    m_position.bits >>= m_position.bitCount % 8;
+    m_position.bitCount -= m_position.bitCount % 8;
+
+    Uint32 values[2] = {0, 0};
+    unsigned int count = m_zlib ? 1 : (m_format == Gzip) ? 2 : 0;
+    for (unsigned int i = 0; i < count * 4; ++i)
+    {
+        unsigned int byte;
+        if (!readBits(8, byte))
+        {
+            m_position = start;
+            return false;
+        }
+        values[i / 4] |= static_cast<Uint32>(byte) << ((i % 4) * 8);
+    }
+
+    updateChecksum(output, checked);
+
+    // zlib stores its checksum in big-endian order, gzip its checksum and size in little-endian order
+    bool valid = true;
+    if (m_zlib)
+        valid = (((values[0] & 0xFF) << 24) | ((values[0] & 0xFF00) << 8) | ((values[0] >> 8) & 0xFF00) | (values[0] >> 24)) == m_checksum;
+    else if (m_format == Gzip)
+        valid = (values[0] == m_checksum) && (values[1] == static_cast<Uint32>(m_total));
+
+    m_state = valid ? Finished : Corrupted;
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void Inflater::write(const Uint8* data, std::size_t size, std::string& output)
+{
+    output.append(reinterpret_cast<const char*>(data), size);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        m_window[m_windowPos] = data[i];
+        m_windowPos = (m_windowPos + 1) & (windowSize - 1);
+    }
+
+    m_total += size;
+}
+
+
+////////////////////////////////////////////////////////////
+void Inflater::updateChecksum(const std::string& output, std::size_t& checked)
+{
+    if (checked < output.size())
+    {
+        const Uint8* data = reinterpret_cast<const Uint8*>(output.data()) + checked;
+        std::size_t size = output.size() - checked;
+
+        if (m_zlib)
+            m_checksum = updateAdler(m_checksum, data, size);
+        else if (m_format == Gzip)
+            m_checksum = updateCrc(m_checksum, data, size);
+    }
+
+    checked = output.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void gzipCompress(const char* data, std::size_t size, std::string& output)
+{
+    const Uint8* input = reinterpret_cast<const Uint8*>(data);
+
+    // Header: magic number, DEFLATE method, no flags, no time, unknown OS
+    const char header[10] = {'\x1F', '\x8B', 8, 0, 0, 0, 0, 0, 0, '\xFF'};
+    output.assign(header, sizeof(header));
+
+    // A single block with the fixed Huffman codes
+    BitWriter writer(output);
+    writer.write(1, 1);
+    writer.write(1, 2);
+
+    // Greedy matching of the sequences found in a hash table of the previous positions (stored + 1, 0 is empty)
+    std::vector<std::size_t> table(1 << hashLog, 0);
+    std::size_t position = 0;
+    while (position < size)
+    {
+        std::size_t length = 0;
+        std::size_t distance = 0;
+        if (position + minMatch <= size)
+        {
+            unsigned int key = hash(input + position);
+            std::size_t candidate = table[key];
+            table[key] = position + 1;
+
+            if ((candidate > 0) && (position - (candidate - 1) <= windowSize))
+            {
+                const Uint8* match = input + candidate - 1;
+                std::size_t limit = std::min(maxMatch, size - position);
+                while ((length < limit) && (match[length] == input[position + length]))
+                    length++;
+                distance = position - (candidate - 1);
+            }
+        }
+
+        if (length < minMatch)
+        {
+            writer.writeSymbol(input[position]);
+            position++;
+            continue;
+        }
+
+        unsigned int code = 28;
+        while (lengthBase[code] > length)
+            code--;
+        writer.writeSymbol(257 + code);
+        writer.write(static_cast<Uint32>(length - lengthBase[code]), lengthExtra[code]);
+
+        code = 29;
+        while (distanceBase[code] > distance)
+            code--;
+        writer.writeCode(code, 5);
+        writer.write(static_cast<Uint32>(distance - distanceBase[code]), distanceExtra[code]);
+
+        // Register the positions inside the match too, for the next matches
+        for (std::size_t i = position + 1; (i < position + length) && (i + minMatch <= size); ++i)
+            table[hash(input + i)] = i + 1;
+        position += length;
+    }
+
+    // End of block, then trailer: CRC-32 and size of the original data
+    writer.writeSymbol(256);
+    writer.flush();
+    writeLittleEndian(output, updateCrc(0, input, size));
+    writeLittleEndian(output, static_cast<Uint32>(size));
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,226 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_DEFLATE_HPP
+#define SFML_DEFLATE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Streaming decoder of DEFLATE data (RFC 1951),
+///        in the zlib (RFC 1950) or gzip (RFC 1952) format
+///
+////////////////////////////////////////////////////////////
+class Inflater
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Container formats of the compressed data
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Format
+    {
+        Deflate, ///< zlib format, or raw DEFLATE data (detected from the first bytes)
+        Gzip     ///< gzip format
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    Inflater();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Prepare the decoder for a new stream
+    ///
+    /// \param format Format of the compressed data
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset(Format format);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode the next part of the compressed data
+    ///
+    /// The data can be split anywhere: what can't be decoded
+    /// yet is kept until the next call. Data following the end
+    /// of the stream is ignored.
+    ///
+    /// \param data   Next part of the compressed data
+    /// \param size   Size of the data, in bytes
+    /// \param output String to append the decompressed data to
+    ///
+    /// \return False if the data is corrupted
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const char* data, std::size_t size, std::string& output);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the end of the stream was decoded
+    ///
+    /// \return True if the whole stream was decoded and its checksum verified
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isFinished() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Canonical Huffman code
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Huffman
+    {
+        Uint16 count[16];   ///< Number of codes of each length
+        Uint16 symbol[288]; ///< Symbols sorted by code
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Position in the input, to go back to when it is incomplete
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Position
+    {
+        std::size_t  byte;     ///< Next byte to read
+        Uint32       bits;     ///< Bits read from the input and not used yet
+        unsigned int bitCount; ///< Number of bits in \a bits
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decoding steps
+    ///
+    ////////////////////////////////////////////////////////////
+    enum State
+    {
+        Header,      ///< zlib or gzip header
+        BlockHeader, ///< Header of the next block, including its Huffman codes
+        Stored,      ///< Contents of an uncompressed block
+        Codes,       ///< Contents of a compressed block
+        Trailer,     ///< Checksum of the data
+        Finished,    ///< End of the stream
+        Corrupted    ///< Invalid data
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Build a canonical Huffman code from the lengths of its symbols
+    ///
+    /// \return 0 if the code is complete, a positive value if it is incomplete, a negative one if it is invalid
+    ///
+    ////////////////////////////////////////////////////////////
+    static int buildHuffman(Huffman& huffman, const Uint8* lengths, unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read bits from the input, lowest bits first
+    ///
+    /// \return False if the input doesn't contain enough bits
+    ///
+    ////////////////////////////////////////////////////////////
+    bool readBits(unsigned int count, unsigned int& value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read a symbol encoded with a Huffman code
+    ///
+    /// Invalid codes give a symbol out of the range of the code.
+    ///
+    /// \return False if the input doesn't contain enough bits
+    ///
+    ////////////////////////////////////////////////////////////
+    bool decodeSymbol(const Huffman& huffman, unsigned int& symbol);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decoding steps
+    ///
+    /// Each step returns false when it can't go further, because
+    /// it needs more input or because the data is corrupted (the
+    /// state is then Corrupted). Incomplete steps are undone, so
+    /// that they can be done again when more input is available.
+    ///
+    ////////////////////////////////////////////////////////////
+    bool readHeader();
+    bool readBlockHeader();
+    bool readStored(std::string& output);
+    bool readCodes(std::string& output);
+    bool readTrailer(std::string& output, std::size_t& checked);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Output decompressed data
+    ///
+    ////////////////////////////////////////////////////////////
+    void write(const Uint8* data, std::size_t size, std::string& output);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the checksum with the output produced since the last update
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateChecksum(const std::string& output, std::size_t& checked);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Format             m_format;     ///< Format of the compressed data
+    bool               m_zlib;       ///< Does the data have a zlib header and trailer?
+    State              m_state;      ///< Current decoding step
+    bool               m_lastBlock;  ///< Is the current block the last one?
+    std::size_t        m_remaining;  ///< Number of bytes left in the current uncompressed block
+    std::vector<Uint8> m_input;      ///< Compressed data not decoded yet
+    Position           m_position;   ///< Current position in the input
+    Huffman            m_lengths;    ///< Code of the literals and lengths of the current block
+    Huffman            m_distances;  ///< Code of the distances of the current block
+    std::vector<Uint8> m_window;     ///< Last 32 KB of decompressed data, for the back-references
+    std::size_t        m_windowPos;  ///< Next position to write in the window
+    std::size_t        m_total;      ///< Total size of the decompressed data
+    Uint32             m_checksum;   ///< Adler-32 (zlib) or CRC-32 (gzip) of the decompressed data
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Compress data to the gzip format
+///
+/// The data is compressed with a simple and fast matcher and
+/// the fixed Huffman codes of DEFLATE, which gives most of the
+/// gain on the text payloads of web APIs.
+///
+/// \param data   Data to compress
+/// \param size   Size of the data, in bytes
+/// \param output String to fill with the compressed data
+///
+////////////////////////////////////////////////////////////
+void gzipCompress(const char* data, std::size_t size, std::string& output);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_DEFLATE_HPP
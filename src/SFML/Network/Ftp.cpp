@@ -27,6 +27,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Ftp.hpp>
 #include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/SocketImpl.hpp>
 #include <SFML/System/Err.hpp>
 #include <algorithm>
 #include <cctype>
@@ -50,11 +51,14 @@ public:
     Ftp::Response open(Ftp::TransferMode mode);
 
     ////////////////////////////////////////////////////////////
-    void send(std::istream& stream);
+    void send(std::FILE* file, std::size_t bufferSize);
 
     ////////////////////////////////////////////////////////////
     void receive(std::ostream& stream);
 
+    ////////////////////////////////////////////////////////////
+    void receive(std::FILE* file, std::size_t bufferSize);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -140,6 +144,14 @@ const std::vector<std::string>& Ftp::ListingResponse::getListing() const
 }
 
 
+////////////////////////////////////////////////////////////
+Ftp::Ftp() :
+m_transferBufferSize(256 * 1024)
+{
+
+}
+
+
 ////////////////////////////////////////////////////////////
 Ftp::~Ftp()
 {
@@ -275,44 +287,65 @@ Ftp::Response Ftp::deleteFile(const std::string& name)
 
 
 ////////////////////////////////////////////////////////////
-Ftp::Response Ftp::download(const std::string& remoteFile, const std::string& localPath, TransferMode mode)
+Ftp::Response Ftp::download(const std::string& remoteFile, const std::string& localPath, TransferMode mode, bool resume)
 {
+    // Extract the filename from the file path
+    std::string filename = remoteFile;
+    std::string::size_type pos = filename.find_last_of("/\\");
+    if (pos != std::string::npos)
+        filename = filename.substr(pos + 1);
+
+    // Make sure the destination path ends with a slash
+    std::string path = localPath;
+    if (!path.empty() && (path[path.size() - 1] != '\\') && (path[path.size() - 1] != '/'))
+        path += "/";
+
+    // Find where to resume the download from
+    Uint64 offset = 0;
+    if (resume)
+    {
+        std::ifstream existing((path + filename).c_str(), std::ios_base::binary | std::ios_base::ate);
+        if (existing)
+            offset = static_cast<Uint64>(existing.tellg());
+    }
+
     // Open a data channel using the given transfer mode
     DataChannel data(*this);
     Response response = data.open(mode);
     if (response.isOk())
     {
+        // Ask the server to skip the part that we already have
+        if (offset > 0)
+        {
+            std::ostringstream out;
+            out << offset;
+            if (sendCommand("REST", out.str()).getStatus() != Response::NeedInformation)
+                offset = 0;
+        }
+
         // Tell the server to start the transfer
         response = sendCommand("RETR", remoteFile);
         if (response.isOk())
         {
-            // Extract the filename from the file path
-            std::string filename = remoteFile;
-            std::string::size_type pos = filename.find_last_of("/\\");
-            if (pos != std::string::npos)
-                filename = filename.substr(pos + 1);
-
-            // Make sure the destination path ends with a slash
-            std::string path = localPath;
-            if (!path.empty() && (path[path.size() - 1] != '\\') && (path[path.size() - 1] != '/'))
-                path += "/";
-
-            // Create the file and truncate it if necessary
-            std::ofstream file((path + filename).c_str(), std::ios_base::binary | std::ios_base::trunc);
+            // Create the file and truncate it if necessary, or append to the part already downloaded
+            std::FILE* file = std::fopen((path + filename).c_str(), offset > 0 ? "ab" : "wb");
             if (!file)
                 return Response(Response::InvalidFile);
 
+            // The data is written by big blocks, no need for another level of buffering
+            std::setvbuf(file, NULL, _IONBF, 0);
+
             // Receive the file data
-            data.receive(file);
+            data.receive(file, m_transferBufferSize);
 
             // Close the file
-            file.close();
+            std::fclose(file);
 
             // Get the response from the server
             response = getResponse();
 
-            // If the download was unsuccessful, delete the partial file
-            if (!response.isOk())
+            // If the download was unsuccessful, delete the partial file (unless it can be resumed)
+            if (!response.isOk() && !resume)
                 std::remove((path + filename).c_str());
         }
     }
@@ -325,7 +358,7 @@ Ftp::Response Ftp::download(const std::string& remoteFile, const std::string& lo
 Ftp::Response Ftp::upload(const std::string& localFile, const std::string& remotePath, TransferMode mode)
 {
     // Get the contents of the file to send
-    std::ifstream file(localFile.c_str(), std::ios_base::binary);
+    std::FILE* file = std::fopen(localFile.c_str(), "rb");
     if (!file)
         return Response(Response::InvalidFile);
 
@@ -350,17 +383,33 @@ Ftp::Response Ftp::upload(const std::string& localFile, const std::string& remot
         if (response.isOk())
         {
             // Send the file data
-            data.send(file);
+            data.send(file, m_transferBufferSize);
 
             // Get the response from the server
             response = getResponse();
         }
     }
 
+    std::fclose(file);
+
     return response;
 }
 
 
+////////////////////////////////////////////////////////////
+void Ftp::setTransferBufferSize(std::size_t size)
+{
+    m_transferBufferSize = std::max<std::size_t>(size, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Ftp::getTransferBufferSize() const
+{
+    return m_transferBufferSize;
+}
+
+
 ////////////////////////////////////////////////////////////
 Ftp::Response Ftp::sendCommand(const std::string& command, const std::string& parameter)
 {
@@ -601,35 +650,50 @@ void Ftp::DataChannel::receive(std::ostream& stream)
 
 
 ////////////////////////////////////////////////////////////
-void Ftp::DataChannel::send(std::istream& stream)
+void Ftp::DataChannel::receive(std::FILE* file, std::size_t bufferSize)
 {
-    // Send data
-    char buffer[1024];
-    std::size_t count;
-
-    for (;;)
+    // Receive data by big blocks
+    std::vector<char> buffer(bufferSize);
+    std::size_t received;
+    while (m_dataSocket.receive(&buffer[0], buffer.size(), received) == Socket::Done)
     {
-        // read some data from the stream
-        stream.read(buffer, sizeof(buffer));
-
-        if (!stream.good() && !stream.eof())
+        if (std::fwrite(&buffer[0], 1, received, file) != received)
         {
-            err() << "FTP Error: Reading from the file has failed" << std::endl;
+            err() << "FTP Error: Writing to the file has failed" << std::endl;
             break;
         }
+    }
+
+    // Close the data socket
+    m_dataSocket.disconnect();
+}
 
-        count = stream.gcount();
 
-        if (count > 0)
+////////////////////////////////////////////////////////////
+void Ftp::DataChannel::send(std::FILE* file, std::size_t bufferSize)
+{
+    // Send the file directly from the disk if the system supports it
+    bool fallback;
+    if (!priv::SocketImpl::sendFile(m_dataSocket.getHandle(), file, fallback) && fallback)
+    {
+        // Otherwise read and send it by big blocks
+        std::vector<char> buffer(bufferSize);
+        std::rewind(file);
+        for (;;)
         {
-            // we could read more data from the stream: send them
-            if (m_dataSocket.send(buffer, count) != Socket::Done)
+            std::size_t count = std::fread(&buffer[0], 1, buffer.size(), file);
+            if (std::ferror(file))
+            {
+                err() << "FTP Error: Reading from the file has failed" << std::endl;
+                break;
+            }
+
+            // No more data: exit the loop
+            if (count == 0)
+                break;
+
+            if (m_dataSocket.send(&buffer[0], count) != Socket::Done)
                 break;
-        }
-        else
-        {
-            // no more data: exit the loop
-            break;
         }
     }
 
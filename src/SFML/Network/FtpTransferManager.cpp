@@ -0,0 +1,345 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/FtpTransferManager.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Thread.hpp>
+#include <fstream>
+
+
+namespace
+{
+    // Get the size of a local file, or 0 if it doesn't exist
+    sf::Uint64 getFileSize(const std::string& path)
+    {
+        std::ifstream file(path.c_str(), std::ios_base::binary | std::ios_base::ate);
+        return file ? static_cast<sf::Uint64>(file.tellg()) : 0;
+    }
+
+    // Get the local path of a downloaded file, the same way as Ftp::download
+    std::string getDownloadedPath(const std::string& remoteFile, const std::string& localPath)
+    {
+        std::string filename = remoteFile;
+        std::string::size_type pos = filename.find_last_of("/\\");
+        if (pos != std::string::npos)
+            filename = filename.substr(pos + 1);
+
+        std::string path = localPath;
+        if (!path.empty() && (path[path.size() - 1] != '\\') && (path[path.size() - 1] != '/'))
+            path += "/";
+
+        return path + filename;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+class FtpTransferManager::Session : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    Session(FtpTransferManager& owner);
+
+    ////////////////////////////////////////////////////////////
+    Ftp::Response connect(const IpAddress& server, unsigned short port, const std::string& name, const std::string& password, Time timeout);
+
+    ////////////////////////////////////////////////////////////
+    void launch();
+
+    ////////////////////////////////////////////////////////////
+    void wait();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    void run();
+
+    ////////////////////////////////////////////////////////////
+    Ftp::Response perform(const Transfer& transfer);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    FtpTransferManager& m_owner;    ///< Manager that owns the session
+    Ftp                 m_ftp;      ///< Connection with the server
+    Thread              m_thread;   ///< Thread running the transfers
+    IpAddress           m_server;   ///< Address of the server, to reconnect
+    unsigned short      m_port;     ///< Port of the server, to reconnect
+    std::string         m_name;     ///< User name, to reconnect
+    std::string         m_password; ///< Password, to reconnect
+    Time                m_timeout;  ///< Connection timeout, to reconnect
+};
+
+
+////////////////////////////////////////////////////////////
+FtpTransferManager::FtpTransferManager() :
+m_stopping(false)
+{
+    m_progress.pending   = 0;
+    m_progress.active    = 0;
+    m_progress.completed = 0;
+    m_progress.failed    = 0;
+    m_progress.bytes     = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+FtpTransferManager::~FtpTransferManager()
+{
+    disconnect();
+}
+
+
+////////////////////////////////////////////////////////////
+Ftp::Response FtpTransferManager::connect(const IpAddress& server, unsigned short port, const std::string& name, const std::string& password, std::size_t sessionCount, Time timeout)
+{
+    disconnect();
+
+    // Open and log in all the sessions first, so that errors are reported here
+    Ftp::Response response;
+    for (std::size_t i = 0; i < sessionCount; ++i)
+    {
+        Session* session = new Session(*this);
+        response = session->connect(server, port, name, password, timeout);
+        if (!response.isOk())
+        {
+            delete session;
+            disconnect();
+            return response;
+        }
+
+        m_sessions.push_back(session);
+    }
+
+    // Start running the queued transfers
+    for (std::vector<Session*>::iterator it = m_sessions.begin(); it != m_sessions.end(); ++it)
+        (*it)->launch();
+
+    return response;
+}
+
+
+////////////////////////////////////////////////////////////
+void FtpTransferManager::disconnect()
+{
+    {
+        Lock lock(m_mutex);
+        m_stopping = true;
+        m_queueChanged.notifyAll();
+    }
+
+    // Wait for the transfers in progress, then close the sessions
+    for (std::vector<Session*>::iterator it = m_sessions.begin(); it != m_sessions.end(); ++it)
+    {
+        (*it)->wait();
+        delete *it;
+    }
+    m_sessions.clear();
+
+    Lock lock(m_mutex);
+    m_stopping = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void FtpTransferManager::addDownload(const std::string& remoteFile, const std::string& localPath, Ftp::TransferMode mode, bool resume)
+{
+    Transfer transfer;
+    transfer.direction   = Download;
+    transfer.source      = remoteFile;
+    transfer.destination = localPath;
+    transfer.mode        = mode;
+    transfer.resume      = resume;
+
+    add(transfer);
+}
+
+
+////////////////////////////////////////////////////////////
+void FtpTransferManager::addUpload(const std::string& localFile, const std::string& remotePath, Ftp::TransferMode mode)
+{
+    Transfer transfer;
+    transfer.direction   = Upload;
+    transfer.source      = localFile;
+    transfer.destination = remotePath;
+    transfer.mode        = mode;
+    transfer.resume      = false;
+
+    add(transfer);
+}
+
+
+////////////////////////////////////////////////////////////
+void FtpTransferManager::wait()
+{
+    Lock lock(m_mutex);
+
+    while (!m_sessions.empty() && ((m_progress.pending > 0) || (m_progress.active > 0)))
+        m_transferEnded.wait(m_mutex);
+}
+
+
+////////////////////////////////////////////////////////////
+FtpTransferManager::Progress FtpTransferManager::getProgress() const
+{
+    Lock lock(m_mutex);
+
+    return m_progress;
+}
+
+
+////////////////////////////////////////////////////////////
+std::vector<FtpTransferManager::Transfer> FtpTransferManager::getFailedTransfers() const
+{
+    Lock lock(m_mutex);
+
+    return m_failed;
+}
+
+
+////////////////////////////////////////////////////////////
+void FtpTransferManager::add(const Transfer& transfer)
+{
+    Lock lock(m_mutex);
+
+    m_queue.push_back(transfer);
+    m_progress.pending++;
+    m_queueChanged.notifyOne();
+}
+
+
+////////////////////////////////////////////////////////////
+FtpTransferManager::Session::Session(FtpTransferManager& owner) :
+m_owner (owner),
+m_thread(&Session::run, this),
+m_port  (0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+Ftp::Response FtpTransferManager::Session::connect(const IpAddress& server, unsigned short port, const std::string& name, const std::string& password, Time timeout)
+{
+    m_server   = server;
+    m_port     = port;
+    m_name     = name;
+    m_password = password;
+    m_timeout  = timeout;
+
+    Ftp::Response response = m_ftp.connect(server, port, timeout);
+    if (response.isOk())
+        response = name.empty() ? m_ftp.login() : m_ftp.login(name, password);
+
+    return response;
+}
+
+
+////////////////////////////////////////////////////////////
+void FtpTransferManager::Session::launch()
+{
+    m_thread.launch();
+}
+
+
+////////////////////////////////////////////////////////////
+void FtpTransferManager::Session::wait()
+{
+    m_thread.wait();
+}
+
+
+////////////////////////////////////////////////////////////
+void FtpTransferManager::Session::run()
+{
+    for (;;)
+    {
+        // Take the next queued transfer, waiting for one if the queue is empty
+        Transfer transfer;
+        {
+            Lock lock(m_owner.m_mutex);
+            while (!m_owner.m_stopping && m_owner.m_queue.empty())
+                m_owner.m_queueChanged.wait(m_owner.m_mutex);
+
+            if (m_owner.m_stopping)
+                return;
+
+            transfer = m_owner.m_queue.front();
+            m_owner.m_queue.pop_front();
+            m_owner.m_progress.pending--;
+            m_owner.m_progress.active++;
+        }
+
+        transfer.response = perform(transfer);
+
+        // The server may close idle control connections: reconnect and try again once
+        if ((transfer.response.getStatus() == Ftp::Response::ConnectionClosed) &&
+            connect(m_server, m_port, m_name, m_password, m_timeout).isOk())
+        {
+            transfer.response = perform(transfer);
+        }
+
+        // Update the progress
+        Uint64 bytes = 0;
+        if (transfer.response.isOk())
+        {
+            if (transfer.direction == Download)
+                bytes = getFileSize(getDownloadedPath(transfer.source, transfer.destination));
+            else
+                bytes = getFileSize(transfer.source);
+        }
+
+        Lock lock(m_owner.m_mutex);
+        m_owner.m_progress.active--;
+        if (transfer.response.isOk())
+        {
+            m_owner.m_progress.completed++;
+            m_owner.m_progress.bytes += bytes;
+        }
+        else
+        {
+            m_owner.m_progress.failed++;
+            m_owner.m_failed.push_back(transfer);
+        }
+        m_owner.m_transferEnded.notifyAll();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Ftp::Response FtpTransferManager::Session::perform(const Transfer& transfer)
+{
+    if (transfer.direction == Download)
+        return m_ftp.download(transfer.source, transfer.destination, transfer.mode, transfer.resume);
+    else
+        return m_ftp.upload(transfer.source, transfer.destination, transfer.mode);
+}
+
+} // namespace sf
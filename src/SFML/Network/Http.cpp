@@ -26,9 +26,12 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Http.hpp>
+#include <SFML/Network/Deflate.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/FileInputStream.hpp>
 #include <cctype>
 #include <algorithm>
+#include <cstdlib>
 #include <iterator>
 #include <sstream>
 #include <limits>
@@ -36,6 +39,9 @@
 
 namespace
 {
+    // Size of the parts of the streamed request bodies
+    const std::size_t bodyPartSize = 64 * 1024;
+
     // Convert a string to lower case
     std::string toLower(std::string str)
     {
@@ -43,13 +49,55 @@ namespace
             *i = static_cast<char>(std::tolower(*i));
         return str;
     }
+
+    // Give a part of a response body to its receiver, or store it, after decoding it if it is compressed
+    bool receiveBody(sf::Http::BodyReceiver* receiver, std::string& body, const char* data, std::size_t size, sf::priv::Inflater* inflater, std::string& decoded)
+    {
+        if (inflater)
+        {
+            decoded.clear();
+            if (!inflater->update(data, size, decoded))
+            {
+                sf::err() << "Failed to decode the body of the HTTP response (corrupted data)" << std::endl;
+                return false;
+            }
+
+            data = decoded.data();
+            size = decoded.size();
+            if (size == 0)
+                return true;
+        }
+
+        if (receiver)
+            return receiver->onBodyData(data, size);
+
+        body.append(data, size);
+        return true;
+    }
+
+    // Delete the files opened to stream request bodies when they are no longer used
+    struct FileGuard
+    {
+        ~FileGuard()
+        {
+            for (std::size_t i = 0; i < files.size(); ++i)
+                delete files[i];
+        }
+
+        std::vector<sf::FileInputStream*> files;
+    };
 }
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
-Http::Request::Request(const std::string& uri, Method method, const std::string& body)
+Http::Request::Request(const std::string& uri, Method method, const std::string& body) :
+m_compressBody  (false),
+m_bodyStream    (NULL),
+m_uploadListener(NULL),
+m_bodyStart     (0),
+m_bodyLength    (-1)
 {
     setMethod(method);
     setUri(uri);
@@ -95,6 +143,40 @@ void Http::Request::setHttpVersion(unsigned int major, unsigned int minor)
 void Http::Request::setBody(const std::string& body)
 {
     m_body = body;
+    m_bodyStream = NULL;
+    m_bodyFile.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::Request::setBody(InputStream& stream)
+{
+    m_body.clear();
+    m_bodyStream = &stream;
+    m_bodyFile.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::Request::setBodyFromFile(const std::string& filename)
+{
+    m_body.clear();
+    m_bodyStream = NULL;
+    m_bodyFile = filename;
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::Request::setUploadListener(UploadListener* listener)
+{
+    m_uploadListener = listener;
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::Request::setBodyCompressed(bool compressed)
+{
+    m_compressBody = compressed;
 }
 
 
@@ -127,7 +209,7 @@ std::string Http::Request::prepare() const
     // Use an extra \r\n to separate the header from the body
     out << "\r\n";
 
-    // Add the body
+    // Add the body (streamed bodies are sent separately)
     out << m_body;
 
     return out.str();
@@ -296,44 +378,89 @@ void Http::Response::parseFields(std::istream &in)
 }
 
 
+////////////////////////////////////////////////////////////
+Http::BodyReceiver::~BodyReceiver()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool Http::BodyReceiver::onResponse(const Response&)
+{
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Http::UploadListener::~UploadListener()
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 Http::Http() :
-m_host(),
-m_port(0)
+m_connected    (false),
+m_host         (),
+m_port         (0),
+m_secure       (false),
+m_tlsBackend   (NULL),
+m_tls          (NULL),
+m_decodeContent(true),
+m_inflater     (NULL)
 {
 
 }
 
 
 ////////////////////////////////////////////////////////////
-Http::Http(const std::string& host, unsigned short port)
+Http::Http(const std::string& host, unsigned short port) :
+m_connected    (false),
+m_secure       (false),
+m_tlsBackend   (NULL),
+m_tls          (NULL),
+m_decodeContent(true),
+m_inflater     (NULL)
 {
     setHost(host, port);
 }
 
 
+////////////////////////////////////////////////////////////
+Http::~Http()
+{
+    disconnect();
+    delete m_inflater;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Http::setHost(const std::string& host, unsigned short port)
 {
+    // A connection kept alive (and its TLS session) belongs to the previous host
+    disconnect();
+    m_tlsSession.clear();
+
     // Check the protocol
     if (toLower(host.substr(0, 7)) == "http://")
     {
         // HTTP protocol
         m_hostName = host.substr(7);
         m_port     = (port != 0 ? port : 80);
+        m_secure   = false;
     }
     else if (toLower(host.substr(0, 8)) == "https://")
     {
-        // HTTPS protocol -- unsupported (requires encryption and certificates and stuff...)
-        err() << "HTTPS protocol is not supported by sf::Http" << std::endl;
-        m_hostName = "";
-        m_port     = 0;
+        // HTTPS protocol -- the encryption is done by the TLS backend
+        m_hostName = host.substr(8);
+        m_port     = (port != 0 ? port : 443);
+        m_secure   = true;
     }
     else
     {
         // Undefined protocol - use HTTP
         m_hostName = host;
         m_port     = (port != 0 ? port : 80);
+        m_secure   = false;
     }
 
     // Remove any trailing '/' from the host name
@@ -344,8 +471,148 @@ void Http::setHost(const std::string& host, unsigned short port)
 }
 
 
+////////////////////////////////////////////////////////////
+void Http::setTlsBackend(TlsBackend* backend)
+{
+    // Sessions can't be shared by different backends
+    if (backend != m_tlsBackend)
+    {
+        disconnect();
+        m_tlsSession.clear();
+        m_tlsBackend = backend;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::setContentDecoding(bool enabled)
+{
+    m_decodeContent = enabled;
+}
+
+
 ////////////////////////////////////////////////////////////
 Http::Response Http::sendRequest(const Http::Request& request, Time timeout)
+{
+    return performRequests(std::vector<Request>(1, request), NULL, timeout)[0];
+}
+
+
+////////////////////////////////////////////////////////////
+Http::Response Http::sendRequest(const Http::Request& request, BodyReceiver& receiver, Time timeout)
+{
+    return performRequests(std::vector<Request>(1, request), &receiver, timeout)[0];
+}
+
+
+////////////////////////////////////////////////////////////
+std::vector<Http::Response> Http::sendRequests(const std::vector<Request>& requests, Time timeout)
+{
+    return performRequests(requests, NULL, timeout);
+}
+
+
+////////////////////////////////////////////////////////////
+std::vector<Http::Response> Http::performRequests(const std::vector<Request>& requests, BodyReceiver* receiver, Time timeout)
+{
+    std::vector<Response> responses(requests.size());
+
+    // Convert the requests to strings, once for all the attempts
+    std::vector<Request> toSend;
+    std::vector<std::string> prepared(requests.size());
+    std::vector<bool> head(requests.size());
+    std::vector<bool> close(requests.size());
+    FileGuard guard;
+    toSend.reserve(requests.size());
+    for (std::size_t i = 0; i < requests.size(); ++i)
+    {
+        Request request = requests[i];
+        if (!request.m_bodyFile.empty())
+        {
+            // Open the files of the streamed bodies, to know their size
+            guard.files.push_back(new FileInputStream);
+            if (!guard.files.back()->open(request.m_bodyFile))
+            {
+                err() << "Failed to open \"" << request.m_bodyFile << "\" to send it in a HTTP request" << std::endl;
+                return responses;
+            }
+            request.m_bodyStream = guard.files.back();
+        }
+
+        toSend.push_back(prepareRequest(request));
+        prepared[i] = toSend[i].prepare();
+        head[i] = (toSend[i].m_method == Request::Head);
+
+        // Without an explicit field, HTTP/1.1 keeps the connection alive and HTTP/1.0 closes it
+        std::string connection = toLower(toSend[i].m_fields["connection"]);
+        close[i] = (toSend[i].m_majorVersion * 10 + toSend[i].m_minorVersion >= 11) ? (connection == "close") : (connection != "keep-alive");
+    }
+
+    std::size_t next = 0;
+    bool retried = false;
+    while (next < requests.size())
+    {
+        // Reuse the connection kept alive by the previous requests, or connect the socket to the host
+        bool reused = m_connected;
+        if (!m_connected && !connect(timeout))
+            return responses;
+
+        // Send all the remaining requests through the connected socket, up to the first one that closes the connection
+        // (the requests with a streamed body are sent as soon as their header is ready)
+        std::size_t last = next;
+        std::string data;
+        bool sent = true;
+        bool aborted = false;
+        do
+        {
+            data += prepared[last];
+            if (toSend[last].m_bodyStream)
+            {
+                sent = sendData(data.data(), data.size()) && sendBody(toSend[last], aborted);
+                data.clear();
+            }
+        }
+        while (sent && !close[last] && (++last < requests.size()));
+        last = std::min(last, requests.size() - 1);
+
+        if (sent && !data.empty())
+            sent = sendData(data.data(), data.size());
+
+        if (aborted)
+        {
+            disconnect();
+            return responses;
+        }
+
+        // Wait for the server's responses
+        std::string buffer;
+        bool keepAlive = sent;
+        std::size_t first = next;
+        while (sent && (next <= last) && keepAlive && receiveResponse(responses[next], buffer, head[next], receiver, keepAlive))
+            next++;
+
+        if (!keepAlive || (next <= last) || close[last])
+        {
+            // Close the connection
+            disconnect();
+        }
+
+        if (next == first)
+        {
+            // A connection kept alive may have been closed by the server in the meantime: try once more with a new one
+            // (unless a part of the response was already received)
+            if (!reused || retried || (responses[first].getStatus() != Response::ConnectionFailed))
+                return responses;
+            retried = true;
+        }
+    }
+
+    return responses;
+}
+
+
+////////////////////////////////////////////////////////////
+Http::Request Http::prepareRequest(const Request& request) const
 {
     // First make sure that the request is valid -- add missing mandatory fields
     Request toSend(request);
@@ -361,7 +628,51 @@ Http::Response Http::sendRequest(const Http::Request& request, Time timeout)
     {
         toSend.setField("Host", m_hostName);
     }
-    if (!toSend.hasField("Content-Length"))
+    if (m_decodeContent && !toSend.hasField("Accept-Encoding"))
+    {
+        toSend.setField("Accept-Encoding", "gzip, deflate");
+    }
+    if (toSend.m_bodyStream)
+    {
+        // Streamed body: send its length if it is known, or use the chunked transfer-encoding
+        toSend.m_bodyStart = toSend.m_bodyStream->tell();
+        Int64 size = toSend.m_bodyStream->getSize();
+        toSend.m_bodyLength = ((toSend.m_bodyStart >= 0) && (size >= toSend.m_bodyStart)) ? size - toSend.m_bodyStart : -1;
+
+        if (toSend.hasField("Transfer-Encoding") && (toLower(toSend.m_fields["transfer-encoding"]) == "chunked"))
+        {
+            toSend.m_bodyLength = -1;
+        }
+        else if (toSend.hasField("Content-Length"))
+        {
+            toSend.m_bodyLength = static_cast<Int64>(std::strtod(toSend.m_fields["content-length"].c_str(), NULL));
+        }
+        else if (toSend.m_bodyLength >= 0)
+        {
+            std::ostringstream out;
+            out << toSend.m_bodyLength;
+            toSend.setField("Content-Length", out.str());
+        }
+        else
+        {
+            // Chunked requests need HTTP/1.1, which keeps the connection alive unless told otherwise
+            if (toSend.m_majorVersion * 10 + toSend.m_minorVersion < 11)
+            {
+                if (!toSend.hasField("Connection"))
+                    toSend.setField("Connection", "close");
+                toSend.setHttpVersion(1, 1);
+            }
+            toSend.setField("Transfer-Encoding", "chunked");
+        }
+    }
+    if (toSend.m_compressBody && !toSend.m_body.empty() && !toSend.hasField("Content-Encoding"))
+    {
+        std::string compressed;
+        priv::gzipCompress(toSend.m_body.data(), toSend.m_body.size(), compressed);
+        toSend.m_body.swap(compressed);
+        toSend.setField("Content-Encoding", "gzip");
+    }
+    if (!toSend.m_bodyStream && !toSend.hasField("Content-Length"))
     {
         std::ostringstream out;
         out << toSend.m_body.size();
@@ -371,44 +682,311 @@ Http::Response Http::sendRequest(const Http::Request& request, Time timeout)
     {
         toSend.setField("Content-Type", "application/x-www-form-urlencoded");
     }
-    if ((toSend.m_majorVersion * 10 + toSend.m_minorVersion >= 11) && !toSend.hasField("Connection"))
+
+    return toSend;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Http::receiveResponse(Response& response, std::string& buffer, bool head, BodyReceiver* receiver, bool& keepAlive)
+{
+    keepAlive = false;
+
+    // Read the header, skipping informational (1xx) responses
+    do
     {
-        toSend.setField("Connection", "close");
-    }
+        std::string::size_type end;
+        while ((end = buffer.find("\r\n\r\n")) == std::string::npos)
+        {
+            if (!receiveMore(buffer))
+                return false;
+        }
 
-    // Prepare the response
-    Response received;
+        response = Response();
+        response.parse(buffer.substr(0, end + 4));
+        buffer.erase(0, end + 4);
 
-    // Connect the socket to the host
-    if (m_connection.connect(m_host, m_port, timeout) == Socket::Done)
+        if (response.m_status == Response::InvalidResponse)
+            return false;
+    }
+    while ((response.m_status >= 100) && (response.m_status < 200));
+
+    // Let the receiver abort the transfer before the body
+    if (receiver && !receiver->onResponse(response))
+        return true;
+
+    // Decode compressed bodies on the fly
+    bool hasBody = !head && (response.m_status != Response::NoContent) && (response.m_status != Response::NotModified);
+    std::string encoding = toLower(response.getField("content-encoding"));
+    priv::Inflater* inflater = NULL;
+    std::string decoded;
+    if (hasBody && m_decodeContent && ((encoding == "gzip") || (encoding == "x-gzip") || (encoding == "deflate")))
     {
-        // Convert the request to string and send it through the connected socket
-        std::string requestStr = toSend.prepare();
+        if (!m_inflater)
+            m_inflater = new priv::Inflater;
+        m_inflater->reset(encoding == "deflate" ? priv::Inflater::Deflate : priv::Inflater::Gzip);
+        inflater = m_inflater;
+    }
 
-        if (!requestStr.empty())
+    // Read the body, delimited according to the header
+    const std::string& length = response.getField("content-length");
+    if (!hasBody)
+    {
+        // No body
+    }
+    else if (toLower(response.getField("transfer-encoding")) == "chunked")
+    {
+        // Chunked: each chunk is preceded by its size, the last one is empty
+        for (;;)
         {
-            // Send it through the socket
-            if (m_connection.send(requestStr.c_str(), requestStr.size()) == Socket::Done)
+            std::string::size_type end;
+            while ((end = buffer.find("\r\n")) == std::string::npos)
             {
-                // Wait for the server's response
-                std::string receivedStr;
-                std::size_t size = 0;
-                char buffer[1024];
-                while (m_connection.receive(buffer, sizeof(buffer), size) == Socket::Done)
-                {
-                    receivedStr.append(buffer, buffer + size);
-                }
-
-                // Build the Response object from the received data
-                received.parse(receivedStr);
+                if (!receiveMore(buffer))
+                    return false;
             }
+
+            // The size may be followed by a chunk-extension, which is ignored
+            std::size_t size = std::strtoul(buffer.c_str(), NULL, 16);
+            buffer.erase(0, end + 2);
+            if (size == 0)
+                break;
+
+            // Give the chunk as it arrives
+            while (size > 0)
+            {
+                if (buffer.empty() && !receiveMore(buffer))
+                    return false;
+
+                std::size_t count = std::min(size, buffer.size());
+                if (!receiveBody(receiver, response.m_body, buffer.data(), count, inflater, decoded))
+                    return true;
+
+                buffer.erase(0, count);
+                size -= count;
+            }
+
+            // Skip the end of the chunk
+            while (buffer.size() < 2)
+            {
+                if (!receiveMore(buffer))
+                    return false;
+            }
+            buffer.erase(0, 2);
+        }
+
+        // Read the trailers, ended by an empty line
+        std::string::size_type end;
+        while (((end = buffer.find("\r\n")) != 0) && ((end = buffer.find("\r\n\r\n")) == std::string::npos))
+        {
+            if (!receiveMore(buffer))
+                return false;
+        }
+
+        if (end == 0)
+        {
+            buffer.erase(0, 2);
+        }
+        else
+        {
+            std::istringstream in(buffer.substr(0, end + 4));
+            response.parseFields(in);
+            buffer.erase(0, end + 4);
+        }
+    }
+    else if (!length.empty())
+    {
+        // Known length: give the body as it arrives
+        std::size_t size = std::strtoul(length.c_str(), NULL, 10);
+        while (size > 0)
+        {
+            if (buffer.empty() && !receiveMore(buffer))
+                return false;
+
+            std::size_t count = std::min(size, buffer.size());
+            if (!receiveBody(receiver, response.m_body, buffer.data(), count, inflater, decoded))
+                return true;
+
+            buffer.erase(0, count);
+            size -= count;
+        }
+    }
+    else
+    {
+        // Unknown length: the body ends with the connection
+        do
+        {
+            if (!receiveBody(receiver, response.m_body, buffer.data(), buffer.size(), inflater, decoded))
+                return true;
+
+            buffer.clear();
+        }
+        while (receiveMore(buffer));
+
+        if (inflater && !inflater->isFinished())
+            err() << "Failed to decode the body of the HTTP response (truncated data)" << std::endl;
+
+        return true;
+    }
+
+    if (inflater && !inflater->isFinished())
+        err() << "Failed to decode the body of the HTTP response (truncated data)" << std::endl;
+
+    // Without an explicit field, HTTP/1.1 servers keep the connection alive and HTTP/1.0 ones close it
+    std::string connection = toLower(response.getField("connection"));
+    if (response.m_majorVersion * 10 + response.m_minorVersion >= 11)
+        keepAlive = (connection != "close");
+    else
+        keepAlive = (connection == "keep-alive");
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Http::receiveMore(std::string& buffer)
+{
+    char data[4096];
+    std::size_t size = 0;
+    Socket::Status status = m_tls ? m_tls->receive(data, sizeof(data), size) : m_connection.receive(data, sizeof(data), size);
+    if (status != Socket::Done)
+        return false;
+
+    buffer.append(data, size);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Http::connect(Time timeout)
+{
+    if (m_secure && !m_tlsBackend)
+    {
+        err() << "HTTPS requires a TLS backend (see sf::Http::setTlsBackend)" << std::endl;
+        return false;
+    }
+
+    if (m_connection.connect(m_host, m_port, timeout) != Socket::Done)
+        return false;
+
+    if (m_secure)
+    {
+        // Resume the previous session if there is one
+        m_tls = m_tlsBackend->connect(m_connection, m_hostName, m_tlsSession);
+        if (!m_tls)
+        {
+            // The session may be the reason of the failure: don't try it again
+            err() << "Failed to establish a TLS connection with " << m_hostName << std::endl;
+            m_tlsSession.clear();
+            m_connection.disconnect();
+            return false;
         }
+    }
 
-        // Close the connection
-        m_connection.disconnect();
+    m_connected = true;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Http::disconnect()
+{
+    if (m_tls)
+    {
+        // Servers may send new session tickets at any time, keep the most recent one
+        std::vector<char> session = m_tls->getSession();
+        if (!session.empty())
+            m_tlsSession.swap(session);
+
+        delete m_tls;
+        m_tls = NULL;
     }
 
-    return received;
+    m_connection.disconnect();
+    m_connected = false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Http::sendBody(const Request& request, bool& aborted)
+{
+    // Start from the beginning of the body, it may have been partly sent on a previous connection
+    InputStream& stream = *request.m_bodyStream;
+    if (stream.seek(request.m_bodyStart) != request.m_bodyStart)
+    {
+        err() << "Failed to send the body of a HTTP request (the stream can't seek to its beginning)" << std::endl;
+        aborted = true;
+        return false;
+    }
+
+    // Each part is sent with its chunk header and trailer when the body is chunked
+    bool chunked = (request.m_bodyLength < 0);
+    std::string part;
+    std::vector<char> buffer(bodyPartSize);
+    Uint64 sent = 0;
+    for (;;)
+    {
+        Int64 size = static_cast<Int64>(buffer.size());
+        if (!chunked)
+            size = std::min(size, request.m_bodyLength - static_cast<Int64>(sent));
+        if (size == 0)
+            break;
+
+        Int64 count = stream.read(&buffer[0], size);
+        if (count < 0)
+        {
+            err() << "Failed to read the body of a HTTP request" << std::endl;
+            aborted = true;
+            return false;
+        }
+        else if (count == 0)
+        {
+            if (chunked)
+                break;
+
+            err() << "Failed to send the body of a HTTP request (the stream is shorter than its length)" << std::endl;
+            aborted = true;
+            return false;
+        }
+
+        if (chunked)
+        {
+            std::ostringstream header;
+            header << std::hex << count << "\r\n";
+            part = header.str();
+            part.append(&buffer[0], static_cast<std::size_t>(count));
+            part += "\r\n";
+            if (!sendData(part.data(), part.size()))
+                return false;
+        }
+        else if (!sendData(&buffer[0], static_cast<std::size_t>(count)))
+        {
+            return false;
+        }
+
+        sent += static_cast<Uint64>(count);
+        if (request.m_uploadListener && !request.m_uploadListener->onUploadProgress(sent, request.m_bodyLength))
+        {
+            aborted = true;
+            return false;
+        }
+    }
+
+    // The last chunk is empty, with no trailer
+    if (chunked)
+        return sendData("0\r\n\r\n", 5);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Http::sendData(const char* data, std::size_t size)
+{
+    if (m_tls)
+        return m_tls->send(data, size) == Socket::Done;
+    else
+        return m_connection.send(data, size) == Socket::Done;
 }
 
 } // namespace sf
@@ -28,45 +28,226 @@
 #include <SFML/Network/IpAddress.hpp>
 #include <SFML/Network/Http.hpp>
 #include <SFML/Network/SocketImpl.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Thread.hpp>
+#include <algorithm>
 #include <cstring>
+#include <deque>
+#include <map>
 
 
 namespace
 {
-    sf::Uint32 resolve(const std::string& address)
+    // Convert a decimal IPv4 address ("xxx.xxx.xxx.xxx") or an IPv6 address, without blocking
+    bool parseNumeric(const std::string& address, sf::IpAddress& ip)
     {
         if (address == "255.255.255.255")
         {
             // The broadcast address needs to be handled explicitly,
             // because it is also the value returned by inet_addr on error
-            return INADDR_BROADCAST;
+            ip = sf::IpAddress(255, 255, 255, 255);
+            return true;
         }
-        else
+
+        sf::Uint32 ipv4 = inet_addr(address.c_str());
+        if (ipv4 != INADDR_NONE)
         {
-            // Try to convert the address as a byte representation ("xxx.xxx.xxx.xxx")
-            sf::Uint32 ip = inet_addr(address.c_str());
-            if (ip != INADDR_NONE)
-                return ip;
+            ip = sf::IpAddress(ntohl(ipv4));
+            return true;
+        }
+
+        // IPv6 addresses contain a colon, which host names can't
+        if (address.find(':') == std::string::npos)
+            return false;
+
+        addrinfo hints;
+        std::memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_INET6;
+        hints.ai_flags  = AI_NUMERICHOST;
+        addrinfo* result = NULL;
+        if ((getaddrinfo(address.c_str(), NULL, &hints, &result) != 0) || !result)
+            return false;
+
+        sockaddr_storage storage;
+        std::memset(&storage, 0, sizeof(storage));
+        std::memcpy(&storage, result->ai_addr, std::min<std::size_t>(result->ai_addrlen, sizeof(storage)));
+        freeaddrinfo(result);
+
+        ip = sf::priv::SocketImpl::getAddress(storage);
+        return true;
+    }
+
+    // Resolve a host name with the system resolver (may block)
+    std::vector<sf::IpAddress> lookUp(const std::string& address)
+    {
+        std::vector<sf::IpAddress> addresses;
+
+        addrinfo hints;
+        std::memset(&hints, 0, sizeof(hints));
+        hints.ai_family   = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* result = NULL;
+        if (getaddrinfo(address.c_str(), NULL, &hints, &result) == 0)
+        {
+            for (addrinfo* info = result; info; info = info->ai_next)
+            {
+                if ((info->ai_family != AF_INET) && (info->ai_family != AF_INET6))
+                    continue;
+
+                sockaddr_storage storage;
+                std::memset(&storage, 0, sizeof(storage));
+                std::memcpy(&storage, info->ai_addr, std::min<std::size_t>(info->ai_addrlen, sizeof(storage)));
+
+                sf::IpAddress ip = sf::priv::SocketImpl::getAddress(storage);
+                if (std::find(addresses.begin(), addresses.end(), ip) == addresses.end())
+                    addresses.push_back(ip);
+            }
+
+            freeaddrinfo(result);
+        }
+
+        return addresses;
+    }
+
+    // Resolve a host name to a single address, preferring IPv4 for compatibility (may block)
+    sf::IpAddress lookUpOne(const std::string& address)
+    {
+        std::vector<sf::IpAddress> addresses = lookUp(address);
+        for (std::vector<sf::IpAddress>::const_iterator it = addresses.begin(); it != addresses.end(); ++it)
+        {
+            if (!it->isIpv6())
+                return *it;
+        }
+
+        return addresses.empty() ? sf::IpAddress() : addresses.front();
+    }
+
+    // Cache of resolved host names, and the threads running asynchronous resolutions
+    const std::size_t workerCount = 4;
+    const std::size_t maxCacheSize = 1024;
+
+    struct Resolver
+    {
+        struct Entry
+        {
+            Entry() : pending(false) {}
+
+            sf::IpAddress address; // Resolved address (None if the resolution failed)
+            sf::Time      expiry;  // Time when the entry becomes invalid
+            bool          pending; // Is an asynchronous resolution running?
+        };
+
+        Resolver() : successDuration(sf::seconds(60)), failureDuration(sf::seconds(10))
+        {
+            for (std::size_t i = 0; i < workerCount; ++i)
+            {
+                workers[i] = NULL;
+                running[i] = false;
+            }
+        }
+
+        sf::Mutex                    mutex;
+        sf::Clock                    clock;
+        std::map<std::string, Entry> entries;
+        std::deque<std::string>      queue;
+        sf::Thread*                  workers[workerCount];
+        bool                         running[workerCount];
+        sf::Time                     successDuration;
+        sf::Time                     failureDuration;
+    };
+
+    // Bytes of the IPv6 loopback address
+    const sf::Uint8 ipv6LocalHost[16] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1};
+
+    // The resolver is never destroyed, so that running lookups can't outlive it at exit
+    Resolver& getResolver()
+    {
+        static Resolver* resolver = new Resolver;
+        return *resolver;
+    }
+
+    // Find a valid entry in the cache; the resolver's mutex must be locked
+    bool findCached(Resolver& resolver, const std::string& address, sf::IpAddress& ip)
+    {
+        std::map<std::string, Resolver::Entry>::const_iterator it = resolver.entries.find(address);
+        if ((it == resolver.entries.end()) || it->second.pending || (it->second.expiry <= resolver.clock.getElapsedTime()))
+            return false;
+
+        ip = it->second.address;
+        return true;
+    }
+
+    // Store the result of a resolution in the cache
+    void storeCached(Resolver& resolver, const std::string& address, const sf::IpAddress& ip)
+    {
+        sf::Lock lock(resolver.mutex);
+
+        sf::Time now = resolver.clock.getElapsedTime();
 
-            // Not a valid address, try to convert it as a host name
-            addrinfo hints;
-            std::memset(&hints, 0, sizeof(hints));
-            hints.ai_family = AF_INET;
-            addrinfo* result = NULL;
-            if (getaddrinfo(address.c_str(), NULL, &hints, &result) == 0)
+        // Keep the cache small: drop the expired entries when it grows too much
+        if (resolver.entries.size() >= maxCacheSize)
+        {
+            std::map<std::string, Resolver::Entry>::iterator it = resolver.entries.begin();
+            while (it != resolver.entries.end())
+            {
+                if (!it->second.pending && (it->second.expiry <= now))
+                    resolver.entries.erase(it++);
+                else
+                    ++it;
+            }
+        }
+
+        Resolver::Entry& entry = resolver.entries[address];
+        entry.address = ip;
+        entry.expiry  = now + (ip != sf::IpAddress() ? resolver.successDuration : resolver.failureDuration);
+        entry.pending = false;
+    }
+
+    // Run the queued asynchronous resolutions, until the queue is empty
+    void runWorker(std::size_t index)
+    {
+        Resolver& resolver = getResolver();
+        for (;;)
+        {
+            std::string address;
             {
-                if (result)
+                sf::Lock lock(resolver.mutex);
+                if (resolver.queue.empty())
                 {
-                    ip = reinterpret_cast<sockaddr_in*>(result->ai_addr)->sin_addr.s_addr;
-                    freeaddrinfo(result);
-                    return ip;
+                    resolver.running[index] = false;
+                    return;
                 }
+
+                address = resolver.queue.front();
+                resolver.queue.pop_front();
             }
 
-            // Not a valid address nor a host name
-            return 0;
+            storeCached(resolver, address, lookUpOne(address));
         }
     }
+
+    // Resolve an address, using the cache
+    sf::IpAddress resolve(const std::string& address)
+    {
+        sf::IpAddress ip;
+        if (parseNumeric(address, ip))
+            return ip;
+
+        Resolver& resolver = getResolver();
+        {
+            sf::Lock lock(resolver.mutex);
+            if (findCached(resolver, address, ip))
+                return ip;
+        }
+
+        // Not a decimal address nor a cached host name: ask the system
+        ip = lookUpOne(address);
+        storeCached(resolver, address, ip);
+
+        return ip;
+    }
 }
 
 
@@ -76,49 +257,93 @@ namespace sf
 const IpAddress IpAddress::None;
 const IpAddress IpAddress::LocalHost(127, 0, 0, 1);
 const IpAddress IpAddress::Broadcast(255, 255, 255, 255);
+const IpAddress IpAddress::Ipv6LocalHost(ipv6LocalHost);
 
 
 ////////////////////////////////////////////////////////////
 IpAddress::IpAddress() :
-m_address(0)
+m_address(0),
+m_isIpv6 (false)
 {
     // We're using 0 (INADDR_ANY) instead of INADDR_NONE to represent the invalid address,
     // because the latter is also the broadcast address (255.255.255.255); it's ok because
     // SFML doesn't publicly use INADDR_ANY (it is always used implicitly)
+    std::memset(m_address6, 0, sizeof(m_address6));
 }
 
 
 ////////////////////////////////////////////////////////////
-IpAddress::IpAddress(const std::string& address) :
-m_address(resolve(address))
+IpAddress::IpAddress(const std::string& address)
 {
+    *this = resolve(address);
 }
 
 
 ////////////////////////////////////////////////////////////
-IpAddress::IpAddress(const char* address) :
-m_address(resolve(address))
+IpAddress::IpAddress(const char* address)
 {
+    *this = resolve(address);
 }
 
 
 ////////////////////////////////////////////////////////////
 IpAddress::IpAddress(Uint8 byte0, Uint8 byte1, Uint8 byte2, Uint8 byte3) :
-m_address(htonl((byte0 << 24) | (byte1 << 16) | (byte2 << 8) | byte3))
+m_address(htonl((byte0 << 24) | (byte1 << 16) | (byte2 << 8) | byte3)),
+m_isIpv6 (false)
 {
+    std::memset(m_address6, 0, sizeof(m_address6));
 }
 
 
 ////////////////////////////////////////////////////////////
 IpAddress::IpAddress(Uint32 address) :
-m_address(htonl(address))
+m_address(htonl(address)),
+m_isIpv6 (false)
 {
+    std::memset(m_address6, 0, sizeof(m_address6));
+}
+
+
+////////////////////////////////////////////////////////////
+IpAddress::IpAddress(const Uint8 (&bytes)[16]) :
+m_address(0),
+m_isIpv6 (true)
+{
+    std::memcpy(m_address6, bytes, sizeof(m_address6));
+
+    // Store IPv4-mapped addresses (::ffff:a.b.c.d) as IPv4 addresses
+    static const Uint8 mappedPrefix[12] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xFF, 0xFF};
+    if (std::memcmp(bytes, mappedPrefix, sizeof(mappedPrefix)) == 0)
+    {
+        *this = IpAddress(bytes[12], bytes[13], bytes[14], bytes[15]);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool IpAddress::isIpv6() const
+{
+    return m_isIpv6;
 }
 
 
 ////////////////////////////////////////////////////////////
 std::string IpAddress::toString() const
 {
+    if (m_isIpv6)
+    {
+        sockaddr_in6 address;
+        std::memset(&address, 0, sizeof(address));
+        address.sin6_family = AF_INET6;
+        std::memcpy(&address.sin6_addr, m_address6, sizeof(m_address6));
+
+        char host[64];
+        if (getnameinfo(reinterpret_cast<sockaddr*>(&address), sizeof(address), host, sizeof(host), NULL, 0, NI_NUMERICHOST) != 0)
+            return "";
+
+        return host;
+    }
+
     in_addr address;
     address.s_addr = m_address;
 
@@ -129,7 +354,25 @@ std::string IpAddress::toString() const
 ////////////////////////////////////////////////////////////
 Uint32 IpAddress::toInteger() const
 {
-    return ntohl(m_address);
+    return m_isIpv6 ? 0 : ntohl(m_address);
+}
+
+
+////////////////////////////////////////////////////////////
+void IpAddress::toIpv6Bytes(Uint8 (&bytes)[16]) const
+{
+    if (m_isIpv6)
+    {
+        std::memcpy(bytes, m_address6, sizeof(m_address6));
+    }
+    else
+    {
+        // IPv4-mapped address
+        std::memset(bytes, 0, 10);
+        bytes[10] = 0xFF;
+        bytes[11] = 0xFF;
+        std::memcpy(bytes + 12, &m_address, 4);
+    }
 }
 
 
@@ -193,10 +436,112 @@ IpAddress IpAddress::getPublicAddress(Time timeout)
 }
 
 
+////////////////////////////////////////////////////////////
+std::vector<IpAddress> IpAddress::resolveAll(const std::string& address)
+{
+    IpAddress ip;
+    if (parseNumeric(address, ip))
+        return std::vector<IpAddress>(1, ip);
+
+    std::vector<IpAddress> addresses = lookUp(address);
+    if (addresses.empty())
+        return addresses;
+
+    // Alternate the address families, starting with the one preferred by the system
+    std::vector<IpAddress> first;
+    std::vector<IpAddress> second;
+    for (std::vector<IpAddress>::const_iterator it = addresses.begin(); it != addresses.end(); ++it)
+    {
+        if (it->isIpv6() == addresses.front().isIpv6())
+            first.push_back(*it);
+        else
+            second.push_back(*it);
+    }
+
+    addresses.clear();
+    for (std::size_t i = 0; i < std::max(first.size(), second.size()); ++i)
+    {
+        if (i < first.size())
+            addresses.push_back(first[i]);
+        if (i < second.size())
+            addresses.push_back(second[i]);
+    }
+
+    return addresses;
+}
+
+
+////////////////////////////////////////////////////////////
+bool IpAddress::resolveAsync(const std::string& address, IpAddress& result)
+{
+    if (parseNumeric(address, result))
+        return true;
+
+    Resolver& resolver = getResolver();
+    Lock lock(resolver.mutex);
+
+    if (findCached(resolver, address, result))
+        return true;
+
+    // Already being resolved?
+    Resolver::Entry& entry = resolver.entries[address];
+    if (entry.pending)
+        return false;
+
+    entry.pending = true;
+    resolver.queue.push_back(address);
+
+    // Start a worker if one is idle (the busy ones will take the address otherwise)
+    for (std::size_t i = 0; i < workerCount; ++i)
+    {
+        if (!resolver.running[i])
+        {
+            if (!resolver.workers[i])
+                resolver.workers[i] = new Thread(&runWorker, i);
+
+            resolver.running[i] = true;
+            resolver.workers[i]->launch();
+            break;
+        }
+    }
+
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void IpAddress::setResolveCacheDuration(Time success, Time failure)
+{
+    Resolver& resolver = getResolver();
+    Lock lock(resolver.mutex);
+
+    resolver.successDuration = success;
+    resolver.failureDuration = failure;
+}
+
+
+////////////////////////////////////////////////////////////
+void IpAddress::clearResolveCache()
+{
+    Resolver& resolver = getResolver();
+    Lock lock(resolver.mutex);
+
+    // Keep the entries being resolved, so that their workers can complete them
+    std::map<std::string, Resolver::Entry>::iterator it = resolver.entries.begin();
+    while (it != resolver.entries.end())
+    {
+        if (!it->second.pending)
+            resolver.entries.erase(it++);
+        else
+            ++it;
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 bool operator ==(const IpAddress& left, const IpAddress& right)
 {
-    return left.toInteger() == right.toInteger();
+    return !(left < right) && !(right < left);
 }
 
 
@@ -210,7 +555,19 @@ bool operator !=(const IpAddress& left, const IpAddress& right)
 ////////////////////////////////////////////////////////////
 bool operator <(const IpAddress& left, const IpAddress& right)
 {
-    return left.toInteger() < right.toInteger();
+    // IPv4 addresses come before IPv6 ones
+    if (left.isIpv6() != right.isIpv6())
+        return right.isIpv6();
+
+    if (!left.isIpv6())
+        return left.toInteger() < right.toInteger();
+
+    Uint8 leftBytes[16];
+    Uint8 rightBytes[16];
+    left.toIpv6Bytes(leftBytes);
+    right.toIpv6Bytes(rightBytes);
+
+    return std::memcmp(leftBytes, rightBytes, 16) < 0;
 }
 
 
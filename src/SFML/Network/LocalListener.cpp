@@ -0,0 +1,152 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/LocalListener.hpp>
+#include <SFML/Network/LocalSocket.hpp>
+#include <SFML/Network/SocketImpl.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+LocalListener::LocalListener() :
+Socket(Local)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+LocalListener::~LocalListener()
+{
+    close();
+}
+
+
+////////////////////////////////////////////////////////////
+const std::string& LocalListener::getPath() const
+{
+    return m_path;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status LocalListener::listen(const std::string& path)
+{
+    // Stop listening to the previous path
+    close();
+
+    sockaddr_storage address;
+    priv::SocketImpl::AddrLength length = priv::SocketImpl::createLocalAddress(path, address);
+    if (length == 0)
+    {
+        err() << "Failed to listen to local socket \"" << path << "\" (invalid path)" << std::endl;
+        return Error;
+    }
+
+    SocketHandle handle = priv::SocketImpl::createLocalSocket();
+    if (handle == priv::SocketImpl::invalidSocket())
+    {
+        err() << "Failed to create a local socket" << std::endl;
+        return Error;
+    }
+
+    create(handle);
+
+    // Bind the socket to the specified path
+    if (bind(getHandle(), reinterpret_cast<sockaddr*>(&address), length) == -1)
+    {
+        // A file left by a listener that didn't close can be replaced, but not the one of a running listener
+        LocalSocket probe;
+        if (probe.connect(path) == Done)
+        {
+            err() << "Failed to listen to local socket \"" << path << "\" (another listener uses it)" << std::endl;
+            Socket::close();
+            return Error;
+        }
+
+        priv::SocketImpl::removeLocalAddress(path);
+        if (bind(getHandle(), reinterpret_cast<sockaddr*>(&address), length) == -1)
+        {
+            err() << "Failed to bind listener socket to \"" << path << "\"" << std::endl;
+            Socket::close();
+            return Error;
+        }
+    }
+    m_path = path;
+
+    // Listen to the bound path, with the largest queue of pending connections the system allows
+    if (::listen(getHandle(), SOMAXCONN) == -1)
+    {
+        err() << "Failed to listen to \"" << path << "\"" << std::endl;
+        close();
+        return Error;
+    }
+
+    return Done;
+}
+
+
+////////////////////////////////////////////////////////////
+void LocalListener::close()
+{
+    Socket::close();
+
+    // Remove the file of the socket, so that the path can be reused
+    if (!m_path.empty())
+    {
+        priv::SocketImpl::removeLocalAddress(m_path);
+        m_path.clear();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status LocalListener::accept(LocalSocket& socket)
+{
+    // Make sure that we're listening
+    if (getHandle() == priv::SocketImpl::invalidSocket())
+    {
+        err() << "Failed to accept a new connection, the socket is not listening" << std::endl;
+        return Error;
+    }
+
+    // Accept a new connection
+    SocketHandle remote = ::accept(getHandle(), NULL, NULL);
+
+    // Check for errors
+    if (remote == priv::SocketImpl::invalidSocket())
+        return priv::SocketImpl::getErrorStatus();
+
+    // Initialize the new connected socket
+    socket.disconnect();
+    socket.create(remote);
+
+    return Done;
+}
+
+} // namespace sf
@@ -0,0 +1,143 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/LocalSocket.hpp>
+#include <SFML/Network/SocketImpl.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Log.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+LocalSocket::LocalSocket() :
+Socket         (Local),
+m_maxPacketSize(0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status LocalSocket::connect(const std::string& path)
+{
+    // Disconnect the socket if it was connected
+    disconnect();
+
+    sockaddr_storage address;
+    priv::SocketImpl::AddrLength length = priv::SocketImpl::createLocalAddress(path, address);
+    if (length == 0)
+    {
+        err() << "Failed to connect to local socket \"" << path << "\" (invalid path)" << std::endl;
+        return Error;
+    }
+
+    SocketHandle handle = priv::SocketImpl::createLocalSocket();
+    if (handle == priv::SocketImpl::invalidSocket())
+    {
+        err() << "Failed to create a local socket" << std::endl;
+        return Error;
+    }
+
+    create(handle);
+
+    // Local connections complete immediately, or fail if the listener's queue is full
+    if (::connect(getHandle(), reinterpret_cast<sockaddr*>(&address), length) == -1)
+    {
+        Status status = priv::SocketImpl::getErrorStatus();
+        close();
+        return status;
+    }
+
+    return Done;
+}
+
+
+////////////////////////////////////////////////////////////
+void LocalSocket::disconnect()
+{
+    // Close the socket
+    close();
+
+    // Reset the pending packet data
+    m_pendingPacket = PendingPacket();
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status LocalSocket::send(const void* data, std::size_t size)
+{
+    if (!isBlocking())
+        SFML_LOG(Log::Warning, "sfml", "Warning: Partial sends might not be handled properly.");
+
+    std::size_t sent;
+
+    return send(data, size, sent);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status LocalSocket::send(const void* data, std::size_t size, std::size_t& sent)
+{
+    return sendStream(data, size, sent);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status LocalSocket::receive(void* data, std::size_t size, std::size_t& received)
+{
+    return receiveStream(data, size, received);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status LocalSocket::send(Packet& packet)
+{
+    return sendStreamPacket(packet);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status LocalSocket::receive(Packet& packet)
+{
+    return receiveStreamPacket(packet, m_pendingPacket, m_maxPacketSize);
+}
+
+
+////////////////////////////////////////////////////////////
+void LocalSocket::setMaxPacketSize(std::size_t size)
+{
+    m_maxPacketSize = size;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t LocalSocket::getMaxPacketSize() const
+{
+    return m_maxPacketSize;
+}
+
+} // namespace sf
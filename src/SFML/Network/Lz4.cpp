@@ -0,0 +1,230 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Lz4.hpp>
+#include <cstring>
+
+
+namespace
+{
+    // Constants of the LZ4 block format
+    const std::size_t minMatch     = 4;  // Shortest match that can be encoded
+    const std::size_t lastLiterals = 5;  // The last bytes of a block are always literals
+    const std::size_t matchLimit   = 12; // The last match must start at least this far from the end
+    const std::size_t maxOffset    = 65535;
+    const unsigned int hashLog     = 12;
+
+    sf::Uint32 read32(const sf::Uint8* pointer)
+    {
+        sf::Uint32 value;
+        std::memcpy(&value, pointer, sizeof(value));
+        return value;
+    }
+
+    unsigned int hash(sf::Uint32 sequence)
+    {
+        return (sequence * 2654435761u) >> (32 - hashLog);
+    }
+
+    sf::Uint8* writeLength(sf::Uint8* output, std::size_t length)
+    {
+        for (; length >= 255; length -= 255)
+            *output++ = 255;
+        *output++ = static_cast<sf::Uint8>(length);
+        return output;
+    }
+
+    bool readLength(const sf::Uint8*& input, const sf::Uint8* end, std::size_t& length)
+    {
+        sf::Uint8 byte;
+        do
+        {
+            if (input == end)
+                return false;
+            byte = *input++;
+            length += byte;
+        }
+        while (byte == 255);
+
+        return true;
+    }
+
+    sf::Uint8* writeSequence(sf::Uint8* output, const sf::Uint8* literals, std::size_t literalCount, std::size_t offset, std::size_t matchLength)
+    {
+        // Token: literal count in the high nibble, match length in the low one
+        sf::Uint8* token = output++;
+        *token = static_cast<sf::Uint8>((literalCount < 15 ? literalCount : 15) << 4);
+        if (literalCount >= 15)
+            output = writeLength(output, literalCount - 15);
+
+        std::memcpy(output, literals, literalCount);
+        output += literalCount;
+
+        // The last sequence only has literals
+        if (matchLength == 0)
+            return output;
+
+        *output++ = static_cast<sf::Uint8>(offset & 0xFF);
+        *output++ = static_cast<sf::Uint8>(offset >> 8);
+
+        matchLength -= minMatch;
+        *token = static_cast<sf::Uint8>(*token | (matchLength < 15 ? matchLength : 15));
+        if (matchLength >= 15)
+            output = writeLength(output, matchLength - 15);
+
+        return output;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+std::size_t lz4CompressBound(std::size_t size)
+{
+    return size + size / 255 + 16;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t lz4Compress(const Uint8* source, std::size_t size, Uint8* destination)
+{
+    Uint8* output = destination;
+    const Uint8* anchor = source;
+
+    if (size > matchLimit)
+    {
+        // Positions of the last occurrences of 4-byte sequences
+        Uint32 table[1 << hashLog];
+        std::memset(table, 0, sizeof(table));
+
+        const Uint8* matchEnd = source + size - lastLiterals;
+        const Uint8* searchEnd = source + size - matchLimit;
+        const Uint8* input = source + 1;
+
+        while (input < searchEnd)
+        {
+            Uint32 sequence = read32(input);
+            unsigned int index = hash(sequence);
+            const Uint8* candidate = source + table[index];
+            table[index] = static_cast<Uint32>(input - source);
+
+            if ((static_cast<std::size_t>(input - candidate) > maxOffset) || (read32(candidate) != sequence))
+            {
+                // Skip faster through data that doesn't compress
+                input += 1 + ((input - anchor) >> 6);
+                continue;
+            }
+
+            // Extend the match backwards over the pending literals, then forwards
+            while ((input > anchor) && (candidate > source) && (input[-1] == candidate[-1]))
+            {
+                --input;
+                --candidate;
+            }
+
+            const Uint8* end = input + minMatch;
+            const Uint8* match = candidate + minMatch;
+            while ((end < matchEnd) && (*end == *match))
+            {
+                ++end;
+                ++match;
+            }
+
+            output = writeSequence(output, anchor, static_cast<std::size_t>(input - anchor),
+                                   static_cast<std::size_t>(input - candidate), static_cast<std::size_t>(end - input));
+            input = end;
+            anchor = end;
+        }
+    }
+
+    // Whatever remains is written as literals
+    output = writeSequence(output, anchor, static_cast<std::size_t>(source + size - anchor), 0, 0);
+
+    return static_cast<std::size_t>(output - destination);
+}
+
+
+////////////////////////////////////////////////////////////
+bool lz4Decompress(const Uint8* source, std::size_t size, Uint8* destination, std::size_t destinationSize)
+{
+    const Uint8* input = source;
+    const Uint8* inputEnd = source + size;
+    Uint8* output = destination;
+    Uint8* outputEnd = destination + destinationSize;
+
+    while (input < inputEnd)
+    {
+        // Literals
+        Uint8 token = *input++;
+        std::size_t literalCount = token >> 4;
+        if ((literalCount == 15) && !readLength(input, inputEnd, literalCount))
+            return false;
+
+        if ((literalCount > static_cast<std::size_t>(inputEnd - input)) || (literalCount > static_cast<std::size_t>(outputEnd - output)))
+            return false;
+
+        std::memcpy(output, input, literalCount);
+        input += literalCount;
+        output += literalCount;
+
+        // The last sequence ends the block after its literals
+        if (input == inputEnd)
+            break;
+
+        // Match
+        if (inputEnd - input < 2)
+            return false;
+
+        std::size_t offset = input[0] | (input[1] << 8);
+        input += 2;
+        if ((offset == 0) || (offset > static_cast<std::size_t>(output - destination)))
+            return false;
+
+        std::size_t matchLength = token & 15;
+        if ((matchLength == 15) && !readLength(input, inputEnd, matchLength))
+            return false;
+        matchLength += minMatch;
+
+        if (matchLength > static_cast<std::size_t>(outputEnd - output))
+            return false;
+
+        // The match may overlap the bytes it produces, so it's copied byte by byte
+        const Uint8* match = output - offset;
+        for (std::size_t i = 0; i < matchLength; ++i)
+            output[i] = match[i];
+        output += matchLength;
+    }
+
+    return output == outputEnd;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_LZ4_HPP
+#define SFML_LZ4_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Get the maximum size of a block compressed with lz4Compress
+///
+/// \param size Size of the data to compress, in bytes
+///
+/// \return Size that the output buffer of lz4Compress must have
+///
+////////////////////////////////////////////////////////////
+std::size_t lz4CompressBound(std::size_t size);
+
+////////////////////////////////////////////////////////////
+/// \brief Compress data to the LZ4 block format
+///
+/// The output is a raw LZ4 block (no frame header), which can
+/// be decoded by any LZ4 implementation.
+///
+/// \param source      Data to compress
+/// \param size        Size of the data to compress, in bytes
+/// \param destination Buffer of at least lz4CompressBound(size) bytes
+///
+/// \return Size of the compressed block, in bytes
+///
+////////////////////////////////////////////////////////////
+std::size_t lz4Compress(const Uint8* source, std::size_t size, Uint8* destination);
+
+////////////////////////////////////////////////////////////
+/// \brief Decompress a block in the LZ4 block format
+///
+/// The block is fully validated, so that corrupted or
+/// malicious data can never make the function read or write
+/// out of the buffers.
+///
+/// \param source          Compressed block
+/// \param size            Size of the compressed block, in bytes
+/// \param destination     Buffer to fill with the decompressed data
+/// \param destinationSize Exact size of the decompressed data, in bytes
+///
+/// \return True if the block was valid and decompressed to exactly \a destinationSize bytes
+///
+////////////////////////////////////////////////////////////
+bool lz4Decompress(const Uint8* source, std::size_t size, Uint8* destination, std::size_t destinationSize);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_LZ4_HPP
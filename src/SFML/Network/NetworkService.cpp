@@ -0,0 +1,359 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/NetworkService.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/Network/SocketImpl.hpp>
+#include <SFML/Network/TcpListener.hpp>
+#include <SFML/Network/TcpSocket.hpp>
+#include <SFML/System/Lock.hpp>
+
+
+namespace
+{
+    // Builds the completion of a new operation
+    sf::NetworkService::Completion makeCompletion(sf::NetworkService::Completion::Operation operation, sf::TcpSocket* socket,
+                                                  sf::TcpListener* listener, sf::Packet* packet, void* userData)
+    {
+        sf::NetworkService::Completion completion;
+        completion.operation = operation;
+        completion.status    = sf::Socket::NotReady;
+        completion.socket    = socket;
+        completion.listener  = listener;
+        completion.packet    = packet;
+        completion.userData  = userData;
+
+        return completion;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+NetworkService::NetworkService() :
+m_thread (&NetworkService::run, this),
+m_running(true)
+{
+    // Posting an operation sends a datagram to this socket, to wake the thread up
+    m_wakeUp.bind(Socket::AnyPort);
+    m_wakeUp.setBlocking(false);
+    m_selector.add(m_wakeUp);
+
+    m_thread.launch();
+}
+
+
+////////////////////////////////////////////////////////////
+NetworkService::~NetworkService()
+{
+    m_running = false;
+
+    char signal = 0;
+    m_wakeUp.send(&signal, sizeof(signal), IpAddress::LocalHost, m_wakeUp.getLocalPort());
+
+    m_thread.wait();
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkService::connect(TcpSocket& socket, const IpAddress& remoteAddress, unsigned short remotePort, Time timeout, void* userData)
+{
+    Pending operation;
+    operation.completion = makeCompletion(Completion::Connect, &socket, NULL, NULL, userData);
+    operation.address    = remoteAddress;
+    operation.port       = remotePort;
+    operation.deadline   = timeout;
+
+    post(operation);
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkService::accept(TcpListener& listener, TcpSocket& socket, void* userData)
+{
+    Pending operation;
+    operation.completion = makeCompletion(Completion::Accept, &socket, &listener, NULL, userData);
+    operation.port       = 0;
+
+    post(operation);
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkService::send(TcpSocket& socket, Packet& packet, void* userData)
+{
+    Pending operation;
+    operation.completion = makeCompletion(Completion::Send, &socket, NULL, &packet, userData);
+    operation.port       = 0;
+
+    post(operation);
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkService::receive(TcpSocket& socket, Packet& packet, void* userData)
+{
+    Pending operation;
+    operation.completion = makeCompletion(Completion::Receive, &socket, NULL, &packet, userData);
+    operation.port       = 0;
+
+    post(operation);
+}
+
+
+////////////////////////////////////////////////////////////
+bool NetworkService::pollCompletion(Completion& completion)
+{
+    Lock lock(m_mutex);
+
+    if (m_completions.empty())
+        return false;
+
+    completion = m_completions.front();
+    m_completions.pop_front();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkService::post(const Pending& operation)
+{
+    bool wasEmpty;
+    {
+        Lock lock(m_mutex);
+        wasEmpty = m_posted.empty();
+        m_posted.push_back(operation);
+    }
+
+    // If operations were already waiting, the thread has already been woken up
+    if (wasEmpty)
+    {
+        char signal = 0;
+        m_wakeUp.send(&signal, sizeof(signal), IpAddress::LocalHost, m_wakeUp.getLocalPort());
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkService::complete(Completion completion, Socket::Status status)
+{
+    completion.status = status;
+
+    Lock lock(m_mutex);
+    m_completions.push_back(completion);
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkService::run()
+{
+    std::vector<Socket*> ready;
+
+    while (m_running)
+    {
+        startOperations();
+        updateWrites();
+
+        // The selector only tells about sockets ready to read: while there are
+        // connections or sends in progress, come back regularly to check them
+        Time timeout = (m_connecting.empty() && m_writes.empty()) ? Time::Zero : milliseconds(1);
+        if (!m_selector.wait(timeout))
+            continue;
+
+        // Copy the ready sockets, since updating them changes the selector
+        ready.clear();
+        for (std::size_t i = 0; i < m_selector.getReadyCount(); ++i)
+            ready.push_back(&m_selector.getReadySocket(i));
+
+        for (std::vector<Socket*>::iterator it = ready.begin(); it != ready.end(); ++it)
+        {
+            if (*it == &m_wakeUp)
+            {
+                // Drain the wake-up datagrams, the new operations are started on the next iteration
+                char buffer[16];
+                std::size_t received;
+                IpAddress address;
+                unsigned short port;
+                while (m_wakeUp.receive(buffer, sizeof(buffer), received, address, port) == Socket::Done)
+                    ;
+            }
+            else
+            {
+                updateReads(*it);
+            }
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkService::startOperations()
+{
+    std::vector<Pending> posted;
+    {
+        Lock lock(m_mutex);
+        posted.swap(m_posted);
+    }
+
+    for (std::vector<Pending>::iterator it = posted.begin(); it != posted.end(); ++it)
+    {
+        Completion& completion = it->completion;
+
+        switch (completion.operation)
+        {
+            case Completion::Connect:
+            {
+                completion.socket->setBlocking(false);
+                Socket::Status status = completion.socket->connect(it->address, it->port);
+
+                if (status == Socket::NotReady)
+                {
+                    if (it->deadline != Time::Zero)
+                        it->deadline += m_clock.getElapsedTime();
+                    m_connecting.push_back(*it);
+                }
+                else
+                {
+                    complete(completion, status);
+                }
+                break;
+            }
+
+            case Completion::Accept:
+            case Completion::Receive:
+            {
+                Socket* socket = completion.listener ? static_cast<Socket*>(completion.listener) : completion.socket;
+                socket->setBlocking(false);
+
+                Queue& queue = m_reads[socket];
+                if (queue.empty())
+                    m_selector.add(*socket);
+                queue.push_back(*it);
+                break;
+            }
+
+            case Completion::Send:
+            {
+                completion.socket->setBlocking(false);
+                m_writes[completion.socket].push_back(*it);
+                break;
+            }
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkService::updateWrites()
+{
+    // Connections
+    Time now = m_clock.getElapsedTime();
+    for (std::size_t i = 0; i < m_connecting.size();)
+    {
+        Pending& operation = m_connecting[i];
+        TcpSocket& socket = *operation.completion.socket;
+
+        Socket::Status status = priv::SocketImpl::getConnectionStatus(socket.getHandle());
+        if ((status == Socket::NotReady) && (operation.deadline != Time::Zero) && (now >= operation.deadline))
+        {
+            socket.disconnect();
+            status = Socket::Error;
+        }
+
+        if (status != Socket::NotReady)
+        {
+            complete(operation.completion, status);
+            m_connecting[i] = m_connecting.back();
+            m_connecting.pop_back();
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    // Sends: send as many packets of each socket as the system accepts
+    for (QueueMap::iterator it = m_writes.begin(); it != m_writes.end();)
+    {
+        Queue& queue = it->second;
+        while (!queue.empty())
+        {
+            Completion& completion = queue.front().completion;
+
+            Socket::Status status = completion.socket->send(*completion.packet);
+            if ((status == Socket::NotReady) || (status == Socket::Partial))
+                break;
+
+            complete(completion, status);
+            queue.pop_front();
+        }
+
+        if (queue.empty())
+            m_writes.erase(it++);
+        else
+            ++it;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkService::updateReads(Socket* socket)
+{
+    QueueMap::iterator it = m_reads.find(socket);
+    if (it == m_reads.end())
+        return;
+
+    // Complete as many operations as the received data allows
+    Queue& queue = it->second;
+    while (!queue.empty())
+    {
+        Completion& completion = queue.front().completion;
+
+        Socket::Status status;
+        if (completion.operation == Completion::Accept)
+            status = completion.listener->accept(*completion.socket);
+        else
+            status = completion.socket->receive(*completion.packet);
+
+        if ((status == Socket::NotReady) || (status == Socket::Partial))
+            break;
+
+        complete(completion, status);
+        queue.pop_front();
+    }
+
+    // Stop watching the socket when nothing is expected from it anymore
+    if (queue.empty())
+    {
+        m_selector.remove(*socket);
+        m_reads.erase(it);
+    }
+}
+
+} // namespace sf
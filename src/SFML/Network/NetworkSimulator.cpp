@@ -0,0 +1,252 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/NetworkSimulator.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+    // Define the low-level send flags, which depend on the OS
+    #ifdef SFML_SYSTEM_LINUX
+        const int flags = MSG_NOSIGNAL;
+    #else
+        const int flags = 0;
+    #endif
+
+    // Datagrams that would wait longer than this for the simulated link are dropped, like in a full router queue
+    const sf::Time maxQueueDelay = sf::seconds(1);
+
+    // Minimum delay of a lost TCP segment, until it is retransmitted
+    const sf::Time minRetransmitDelay = sf::milliseconds(200);
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+NetworkSimulator::NetworkSimulator(const Socket::NetworkConditions& conditions) :
+m_conditions(conditions),
+m_random    (0),
+m_clock     (),
+m_linkFree  (Time::Zero),
+m_lastStream(Time::Zero),
+m_order     (0),
+m_pending   (),
+m_running   (true),
+m_thread    (&NetworkSimulator::run, this)
+{
+    setConditions(conditions);
+    m_thread.launch();
+}
+
+
+////////////////////////////////////////////////////////////
+NetworkSimulator::~NetworkSimulator()
+{
+    {
+        Lock lock(m_mutex);
+        m_running = false;
+        m_pending.clear();
+    }
+
+    m_condition.notifyAll();
+    m_thread.wait();
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkSimulator::setConditions(const Socket::NetworkConditions& conditions)
+{
+    Lock lock(m_mutex);
+
+    m_conditions = conditions;
+
+    // The state of the generator must never be zero
+    m_random = (static_cast<Uint64>(conditions.seed) + 1) * 0x9E3779B97F4A7C15ULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkSimulator::sendDatagram(SocketHandle handle, const sockaddr_storage& address, SocketImpl::AddrLength length, const void* data, std::size_t size)
+{
+    Lock lock(m_mutex);
+
+    // The random numbers are always drawn in the same order, so that a given seed gives the same fates to the datagrams
+    bool lost = (random() < m_conditions.lossRate);
+    bool duplicated = (random() < m_conditions.duplicateRate);
+    if (lost || ((m_conditions.bandwidth > 0) && (m_linkFree - m_clock.getElapsedTime() > maxQueueDelay)))
+        return;
+
+    for (int copy = 0; copy < (duplicated ? 2 : 1); ++copy)
+    {
+        // Reordered datagrams are held back long enough to be overtaken by the next ones
+        Time due = transmit(size) + delay();
+        if (random() < m_conditions.reorderRate)
+            due += std::max(m_conditions.latency + m_conditions.jitter, milliseconds(1));
+
+        Pending& pending = m_pending[Key(due.asMicroseconds(), m_order++)];
+        pending.handle = handle;
+        pending.stream = false;
+        std::memcpy(&pending.address, &address, sizeof(address));
+        pending.length = length;
+        pending.data.assign(static_cast<const char*>(data), static_cast<const char*>(data) + size);
+        pending.sent = 0;
+    }
+
+    m_condition.notifyOne();
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkSimulator::sendStream(SocketHandle handle, const void* first, std::size_t firstSize, const void* second, std::size_t secondSize)
+{
+    Lock lock(m_mutex);
+
+    // TCP hides losses by retransmitting the data, which delays it and everything sent after it
+    Time due = transmit(firstSize + secondSize) + delay();
+    if (random() < m_conditions.lossRate)
+        due += std::max(minRetransmitDelay, m_conditions.latency * 2.f);
+
+    due = std::max(due, m_lastStream);
+    m_lastStream = due;
+
+    Pending& pending = m_pending[Key(due.asMicroseconds(), m_order++)];
+    pending.handle = handle;
+    pending.stream = true;
+    pending.length = 0;
+    pending.data.assign(static_cast<const char*>(first), static_cast<const char*>(first) + firstSize);
+    if (secondSize > 0)
+        pending.data.insert(pending.data.end(), static_cast<const char*>(second), static_cast<const char*>(second) + secondSize);
+    pending.sent = 0;
+
+    m_condition.notifyOne();
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkSimulator::clear()
+{
+    Lock lock(m_mutex);
+
+    m_pending.clear();
+    m_lastStream = Time::Zero;
+}
+
+
+////////////////////////////////////////////////////////////
+void NetworkSimulator::run()
+{
+    Lock lock(m_mutex);
+
+    while (m_running)
+    {
+        if (m_pending.empty())
+        {
+            m_condition.wait(m_mutex);
+            continue;
+        }
+
+        // Wait until the first data is due, or until more data is queued
+        Int64 now = m_clock.getElapsedTime().asMicroseconds();
+        std::map<Key, Pending>::iterator first = m_pending.begin();
+        if (first->first.first > now)
+        {
+            m_condition.wait(m_mutex, microseconds(first->first.first - now));
+            continue;
+        }
+
+        Pending& pending = first->second;
+        if (!pending.stream)
+        {
+            // Errors are ignored: the datagram is simply lost
+            sendto(pending.handle, &pending.data[0], static_cast<int>(pending.data.size()), 0,
+                   reinterpret_cast<sockaddr*>(&pending.address), pending.length);
+            m_pending.erase(first);
+        }
+        else
+        {
+            int result = ::send(pending.handle, &pending.data[0] + pending.sent, static_cast<int>(pending.data.size() - pending.sent), flags);
+            if (result >= 0)
+            {
+                pending.sent += static_cast<std::size_t>(result);
+                if (pending.sent == pending.data.size())
+                    m_pending.erase(first);
+            }
+            else if (SocketImpl::getErrorStatus() == Socket::NotReady)
+            {
+                // The system buffer of a non-blocking socket is full, try again a bit later
+                m_condition.wait(m_mutex, milliseconds(1));
+            }
+            else
+            {
+                // The connection is broken, the socket will report it
+                m_pending.erase(first);
+            }
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+float NetworkSimulator::random()
+{
+    // xorshift64* generator
+    m_random ^= m_random >> 12;
+    m_random ^= m_random << 25;
+    m_random ^= m_random >> 27;
+    return static_cast<float>((m_random * 2685821657736338717ULL) >> 40) / 16777216.f;
+}
+
+
+////////////////////////////////////////////////////////////
+Time NetworkSimulator::transmit(std::size_t size)
+{
+    Time now = m_clock.getElapsedTime();
+    if (m_conditions.bandwidth == 0)
+        return now;
+
+    m_linkFree = std::max(now, m_linkFree) + microseconds(static_cast<Int64>(size * 1000000 / m_conditions.bandwidth));
+    return m_linkFree;
+}
+
+
+////////////////////////////////////////////////////////////
+Time NetworkSimulator::delay()
+{
+    // Latency plus or minus the jitter, uniformly distributed
+    Time delay = m_conditions.latency + m_conditions.jitter * (random() * 2.f - 1.f);
+    return std::max(delay, Time::Zero);
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,189 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_NETWORKSIMULATOR_HPP
+#define SFML_NETWORKSIMULATOR_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/Socket.hpp>
+#include <SFML/Network/SocketImpl.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/ConditionVariable.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Thread.hpp>
+#include <map>
+#include <utility>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Delays, drops and duplicates the data sent by a
+///        socket, to simulate degraded network conditions
+///
+////////////////////////////////////////////////////////////
+class NetworkSimulator : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the simulator and start its thread
+    ///
+    /// \param conditions Conditions to simulate
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit NetworkSimulator(const Socket::NetworkConditions& conditions);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The data not sent yet is discarded.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~NetworkSimulator();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the simulated conditions
+    ///
+    /// The random generator is reseeded with the seed of the
+    /// new conditions. The data already queued is not affected.
+    ///
+    /// \param conditions Conditions to simulate
+    ///
+    ////////////////////////////////////////////////////////////
+    void setConditions(const Socket::NetworkConditions& conditions);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a datagram, which may be dropped, duplicated or reordered
+    ///
+    /// \param handle  UDP socket to send the datagram with
+    /// \param address Address of the recipient
+    /// \param length  Length of the address
+    /// \param data    Contents of the datagram
+    /// \param size    Size of the datagram, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void sendDatagram(SocketHandle handle, const sockaddr_storage& address, SocketImpl::AddrLength length, const void* data, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue data of a stream, which is delivered in order
+    ///
+    /// The data is made of two consecutive parts, so that packets
+    /// can be queued with their size without copying them first.
+    ///
+    /// \param handle     TCP socket to send the data with
+    /// \param first      First part of the data
+    /// \param firstSize  Size of the first part, in bytes
+    /// \param second     Second part of the data
+    /// \param secondSize Size of the second part, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void sendStream(SocketHandle handle, const void* first, std::size_t firstSize, const void* second, std::size_t secondSize);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Discard the data not sent yet
+    ///
+    /// This must be called before the socket handle is closed.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Data waiting to be sent
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Pending
+    {
+        SocketHandle           handle;  ///< Socket to send the data with
+        bool                   stream;  ///< Is it stream data (TCP) rather than a datagram (UDP)?
+        sockaddr_storage       address; ///< Address of the recipient of a datagram
+        SocketImpl::AddrLength length;  ///< Length of the address
+        std::vector<char>      data;    ///< Data to send
+        std::size_t            sent;    ///< Number of bytes of stream data already sent
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Identifier of pending data: time it is due, then order of the sends
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef std::pair<Int64, Uint64> Key;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send the pending data when it is due
+    ///
+    ////////////////////////////////////////////////////////////
+    void run();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw a random number in [0, 1)
+    ///
+    ////////////////////////////////////////////////////////////
+    float random();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the time some data leaves the simulated link
+    ///
+    /// \param size Size of the data, in bytes
+    ///
+    /// \return Time the last byte leaves the link, which can't send faster than the bandwidth
+    ///
+    ////////////////////////////////////////////////////////////
+    Time transmit(std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the delay of some data, latency and jitter included
+    ///
+    ////////////////////////////////////////////////////////////
+    Time delay();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Socket::NetworkConditions m_conditions; ///< Simulated conditions
+    Uint64                    m_random;     ///< State of the random generator
+    Clock                     m_clock;      ///< Clock giving the current time
+    Time                      m_linkFree;   ///< Time the simulated link has sent all the queued data
+    Time                      m_lastStream; ///< Time the last stream data is due, which the next one can't overtake
+    Uint64                    m_order;      ///< Order of the next data queued
+    std::map<Key, Pending>    m_pending;    ///< Data waiting to be sent, sorted by due time
+    bool                      m_running;    ///< Is the thread running?
+    Mutex                     m_mutex;      ///< Mutex protecting the state of the simulator
+    ConditionVariable         m_condition;  ///< Condition notified when data is queued or the simulator stops
+    Thread                    m_thread;     ///< Thread sending the pending data
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_NETWORKSIMULATOR_HPP
@@ -28,22 +28,133 @@
 #include <SFML/Network/Packet.hpp>
 #include <SFML/Network/SocketImpl.hpp>
 #include <SFML/System/String.hpp>
+#include <algorithm>
 #include <cstring>
 #include <cwchar>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SFML_PACKET_SSE2
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define SFML_PACKET_NEON
+#endif
+
+
+namespace
+{
+    // Check whether the host byte order is already the network byte order
+    bool isBigEndian()
+    {
+        return htonl(1) == 1;
+    }
+
+    // Copy values whose size is 2, 4 or 8 bytes, reversing the order of their bytes
+    void copySwapped(const char* input, char* output, std::size_t count, std::size_t size)
+    {
+        std::size_t bytes = count * size;
+        std::size_t i = 0;
+
+    #if defined(SFML_PACKET_SSE2)
+
+        // Swap the bytes of the 16-bit words, then reorder the words within the values
+        for (; i + 16 <= bytes; i += 16)
+        {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+            x = _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+            if (size == 4)
+            {
+                x = _mm_shufflelo_epi16(x, _MM_SHUFFLE(2, 3, 0, 1));
+                x = _mm_shufflehi_epi16(x, _MM_SHUFFLE(2, 3, 0, 1));
+            }
+            else if (size == 8)
+            {
+                x = _mm_shufflelo_epi16(x, _MM_SHUFFLE(0, 1, 2, 3));
+                x = _mm_shufflehi_epi16(x, _MM_SHUFFLE(0, 1, 2, 3));
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), x);
+        }
+
+    #elif defined(SFML_PACKET_NEON)
+
+        for (; i + 16 <= bytes; i += 16)
+        {
+            uint8x16_t x = vld1q_u8(reinterpret_cast<const uint8_t*>(input + i));
+            if (size == 2)
+                x = vrev16q_u8(x);
+            else if (size == 4)
+                x = vrev32q_u8(x);
+            else
+                x = vrev64q_u8(x);
+            vst1q_u8(reinterpret_cast<uint8_t*>(output + i), x);
+        }
+
+    #endif
+
+        for (; i < bytes; i += size)
+        {
+            for (std::size_t j = 0; j < size; ++j)
+                output[i + j] = input[i + size - 1 - j];
+        }
+    }
+}
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 Packet::Packet() :
-m_readPos(0),
-m_sendPos(0),
-m_isValid(true)
+m_external        (NULL),
+m_externalSize    (0),
+m_externalCapacity(0),
+m_view            (NULL),
+m_viewSize        (0),
+m_readPos         (0),
+m_readBitPos      (0),
+m_writeBitPos     (0),
+m_sendPos         (0),
+m_isValid         (true)
 {
 
 }
 
 
+////////////////////////////////////////////////////////////
+Packet::Packet(void* buffer, std::size_t capacity) :
+m_external        (static_cast<char*>(buffer)),
+m_externalSize    (0),
+m_externalCapacity(buffer ? capacity : 0),
+m_view            (NULL),
+m_viewSize        (0),
+m_readPos         (0),
+m_readBitPos      (0),
+m_writeBitPos     (0),
+m_sendPos         (0),
+m_isValid         (true)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+Packet::Packet(const Packet& copy) :
+m_data            (static_cast<const char*>(copy.getData()), static_cast<const char*>(copy.getData()) + copy.getDataSize()),
+m_external        (NULL),
+m_externalSize    (0),
+m_externalCapacity(0),
+m_view            (NULL),
+m_viewSize        (0),
+m_readPos         (copy.m_readPos),
+m_readBitPos      (copy.m_readBitPos),
+m_writeBitPos     (copy.m_writeBitPos),
+m_sendPos         (copy.m_sendPos),
+m_isValid         (copy.m_isValid)
+{
+    // The copy always owns its data, two packets can't write to the same external memory
+}
+
+
 ////////////////////////////////////////////////////////////
 Packet::~Packet()
 {
@@ -51,14 +162,62 @@ Packet::~Packet()
 }
 
 
+////////////////////////////////////////////////////////////
+Packet& Packet::operator =(const Packet& right)
+{
+    if (this != &right)
+    {
+        // Keep using our own memory (external or not), only the contents are copied
+        clear();
+        append(right.getData(), right.getDataSize());
+        m_readPos = right.m_readPos;
+        m_readBitPos = right.m_readBitPos;
+        m_writeBitPos = right.m_writeBitPos;
+        m_sendPos = right.m_sendPos;
+        m_isValid = right.m_isValid;
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+void Packet::swap(Packet& right)
+{
+    if (m_external || right.m_external || m_view || right.m_view)
+    {
+        Packet temp(*this);
+        *this = right;
+        right = temp;
+        return;
+    }
+
+    m_data.swap(right.m_data);
+    std::swap(m_readPos,     right.m_readPos);
+    std::swap(m_readBitPos,  right.m_readBitPos);
+    std::swap(m_writeBitPos, right.m_writeBitPos);
+    std::swap(m_sendPos,     right.m_sendPos);
+    std::swap(m_isValid,     right.m_isValid);
+}
+
+
 ////////////////////////////////////////////////////////////
 void Packet::append(const void* data, std::size_t sizeInBytes)
 {
     if (data && (sizeInBytes > 0))
+        std::memcpy(grow(sizeInBytes), data, sizeInBytes);
+}
+
+
+////////////////////////////////////////////////////////////
+void Packet::openFromMemory(const void* data, std::size_t size)
+{
+    clear();
+
+    if (data && (size > 0))
     {
-        std::size_t start = m_data.size();
-        m_data.resize(start + sizeInBytes);
-        std::memcpy(&m_data[start], data, sizeInBytes);
+        m_view = static_cast<const char*>(data);
+        m_viewSize = size;
     }
 }
 
@@ -67,14 +226,54 @@ void Packet::append(const void* data, std::size_t sizeInBytes)
 void Packet::clear()
 {
     m_data.clear();
+    m_externalSize = 0;
+    m_view = NULL;
+    m_viewSize = 0;
     m_readPos = 0;
+    m_readBitPos = 0;
+    m_writeBitPos = 0;
     m_isValid = true;
 }
 
 
+////////////////////////////////////////////////////////////
+void Packet::reserve(std::size_t capacity)
+{
+    if (m_external)
+    {
+        if (capacity <= m_externalCapacity)
+            return;
+
+        // The external memory is too small: switch to memory owned by the packet
+        m_data.reserve(capacity);
+        m_data.assign(m_external, m_external + m_externalSize);
+        m_external = NULL;
+        m_externalSize = 0;
+        m_externalCapacity = 0;
+    }
+    else
+    {
+        m_data.reserve(capacity);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Packet::getCapacity() const
+{
+    return m_external ? m_externalCapacity : m_data.capacity();
+}
+
+
 ////////////////////////////////////////////////////////////
 const void* Packet::getData() const
 {
+    if (m_view)
+        return m_view;
+
+    if (m_external)
+        return (m_externalSize > 0) ? m_external : NULL;
+
     return !m_data.empty() ? &m_data[0] : NULL;
 }
 
@@ -82,14 +281,17 @@ const void* Packet::getData() const
 ////////////////////////////////////////////////////////////
 std::size_t Packet::getDataSize() const
 {
-    return m_data.size();
+    if (m_view)
+        return m_viewSize;
+
+    return m_external ? m_externalSize : m_data.size();
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Packet::endOfPacket() const
 {
-    return m_readPos >= m_data.size();
+    return m_readPos + (m_readBitPos > 0 ? 1 : 0) >= getDataSize();
 }
 
 
@@ -116,7 +318,7 @@ Packet& Packet::operator >>(Int8& data)
 {
     if (checkSize(sizeof(data)))
     {
-        data = *reinterpret_cast<const Int8*>(&m_data[m_readPos]);
+        data = *reinterpret_cast<const Int8*>(getReadPointer());
         m_readPos += sizeof(data);
     }
 
@@ -129,7 +331,7 @@ Packet& Packet::operator >>(Uint8& data)
 {
     if (checkSize(sizeof(data)))
     {
-        data = *reinterpret_cast<const Uint8*>(&m_data[m_readPos]);
+        data = *reinterpret_cast<const Uint8*>(getReadPointer());
         m_readPos += sizeof(data);
     }
 
@@ -142,7 +344,7 @@ Packet& Packet::operator >>(Int16& data)
 {
     if (checkSize(sizeof(data)))
     {
-        data = ntohs(*reinterpret_cast<const Int16*>(&m_data[m_readPos]));
+        data = ntohs(*reinterpret_cast<const Int16*>(getReadPointer()));
         m_readPos += sizeof(data);
     }
 
@@ -155,7 +357,7 @@ Packet& Packet::operator >>(Uint16& data)
 {
     if (checkSize(sizeof(data)))
     {
-        data = ntohs(*reinterpret_cast<const Uint16*>(&m_data[m_readPos]));
+        data = ntohs(*reinterpret_cast<const Uint16*>(getReadPointer()));
         m_readPos += sizeof(data);
     }
 
@@ -168,7 +370,7 @@ Packet& Packet::operator >>(Int32& data)
 {
     if (checkSize(sizeof(data)))
     {
-        data = ntohl(*reinterpret_cast<const Int32*>(&m_data[m_readPos]));
+        data = ntohl(*reinterpret_cast<const Int32*>(getReadPointer()));
         m_readPos += sizeof(data);
     }
 
@@ -181,7 +383,7 @@ Packet& Packet::operator >>(Uint32& data)
 {
     if (checkSize(sizeof(data)))
     {
-        data = ntohl(*reinterpret_cast<const Uint32*>(&m_data[m_readPos]));
+        data = ntohl(*reinterpret_cast<const Uint32*>(getReadPointer()));
         m_readPos += sizeof(data);
     }
 
@@ -196,7 +398,7 @@ Packet& Packet::operator >>(Int64& data)
     {
         // Since ntohll is not available everywhere, we have to convert
         // to network byte order (big endian) manually
-        const Uint8* bytes = reinterpret_cast<const Uint8*>(&m_data[m_readPos]);
+        const Uint8* bytes = reinterpret_cast<const Uint8*>(getReadPointer());
         data = (static_cast<Int64>(bytes[0]) << 56) |
                (static_cast<Int64>(bytes[1]) << 48) |
                (static_cast<Int64>(bytes[2]) << 40) |
@@ -219,7 +421,7 @@ Packet& Packet::operator >>(Uint64& data)
     {
         // Since ntohll is not available everywhere, we have to convert
         // to network byte order (big endian) manually
-        const Uint8* bytes = reinterpret_cast<const Uint8*>(&m_data[m_readPos]);
+        const Uint8* bytes = reinterpret_cast<const Uint8*>(getReadPointer());
         data = (static_cast<Uint64>(bytes[0]) << 56) |
                (static_cast<Uint64>(bytes[1]) << 48) |
                (static_cast<Uint64>(bytes[2]) << 40) |
@@ -240,7 +442,7 @@ Packet& Packet::operator >>(float& data)
 {
     if (checkSize(sizeof(data)))
     {
-        data = *reinterpret_cast<const float*>(&m_data[m_readPos]);
+        data = *reinterpret_cast<const float*>(getReadPointer());
         m_readPos += sizeof(data);
     }
 
@@ -253,7 +455,7 @@ Packet& Packet::operator >>(double& data)
 {
     if (checkSize(sizeof(data)))
     {
-        data = *reinterpret_cast<const double*>(&m_data[m_readPos]);
+        data = *reinterpret_cast<const double*>(getReadPointer());
         m_readPos += sizeof(data);
     }
 
@@ -271,7 +473,7 @@ Packet& Packet::operator >>(char* data)
     if ((length > 0) && checkSize(length))
     {
         // Then extract characters
-        std::memcpy(data, &m_data[m_readPos], length);
+        std::memcpy(data, getReadPointer(), length);
         data[length] = '\0';
 
         // Update reading position
@@ -293,7 +495,7 @@ Packet& Packet::operator >>(std::string& data)
     if ((length > 0) && checkSize(length))
     {
         // Then extract characters
-        data.assign(&m_data[m_readPos], length);
+        data.assign(getReadPointer(), length);
 
         // Update reading position
         m_readPos += length;
@@ -313,11 +515,18 @@ Packet& Packet::operator >>(wchar_t* data)
     if ((length > 0) && checkSize(length * sizeof(Uint32)))
     {
         // Then extract characters
-        for (Uint32 i = 0; i < length; ++i)
+        if (sizeof(wchar_t) == sizeof(Uint32))
+        {
+            readValues(data, length, sizeof(Uint32), true);
+        }
+        else
         {
-            Uint32 character = 0;
-            *this >> character;
-            data[i] = static_cast<wchar_t>(character);
+            for (Uint32 i = 0; i < length; ++i)
+            {
+                Uint32 character = 0;
+                *this >> character;
+                data[i] = static_cast<wchar_t>(character);
+            }
         }
         data[length] = L'\0';
     }
@@ -337,11 +546,20 @@ Packet& Packet::operator >>(std::wstring& data)
     if ((length > 0) && checkSize(length * sizeof(Uint32)))
     {
         // Then extract characters
-        for (Uint32 i = 0; i < length; ++i)
+        if (sizeof(wchar_t) == sizeof(Uint32))
+        {
+            data.resize(length);
+            readValues(&data[0], length, sizeof(Uint32), true);
+        }
+        else
         {
-            Uint32 character = 0;
-            *this >> character;
-            data += static_cast<wchar_t>(character);
+            data.reserve(length);
+            for (Uint32 i = 0; i < length; ++i)
+            {
+                Uint32 character = 0;
+                *this >> character;
+                data += static_cast<wchar_t>(character);
+            }
         }
     }
 
@@ -360,12 +578,9 @@ Packet& Packet::operator >>(String& data)
     if ((length > 0) && checkSize(length * sizeof(Uint32)))
     {
         // Then extract characters
-        for (Uint32 i = 0; i < length; ++i)
-        {
-            Uint32 character = 0;
-            *this >> character;
-            data += character;
-        }
+        std::basic_string<Uint32> characters(length, 0);
+        readValues(&characters[0], length, sizeof(Uint32), true);
+        data = characters;
     }
 
     return *this;
@@ -527,8 +742,16 @@ Packet& Packet::operator <<(const wchar_t* data)
     *this << length;
 
     // Then insert characters
-    for (const wchar_t* c = data; *c != L'\0'; ++c)
-        *this << static_cast<Uint32>(*c);
+    if (sizeof(wchar_t) == sizeof(Uint32))
+    {
+        writeValues(data, length, sizeof(Uint32), true);
+    }
+    else
+    {
+        reserve(getDataSize() + length * sizeof(Uint32));
+        for (const wchar_t* c = data; *c != L'\0'; ++c)
+            *this << static_cast<Uint32>(*c);
+    }
 
     return *this;
 }
@@ -544,8 +767,16 @@ Packet& Packet::operator <<(const std::wstring& data)
     // Then insert characters
     if (length > 0)
     {
-        for (std::wstring::const_iterator c = data.begin(); c != data.end(); ++c)
-            *this << static_cast<Uint32>(*c);
+        if (sizeof(wchar_t) == sizeof(Uint32))
+        {
+            writeValues(data.c_str(), length, sizeof(Uint32), true);
+        }
+        else
+        {
+            reserve(getDataSize() + length * sizeof(Uint32));
+            for (std::wstring::const_iterator c = data.begin(); c != data.end(); ++c)
+                *this << static_cast<Uint32>(*c);
+        }
     }
 
     return *this;
@@ -561,11 +792,364 @@ Packet& Packet::operator <<(const String& data)
 
     // Then insert characters
     if (length > 0)
+        writeValues(data.getData(), length, sizeof(Uint32), true);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeArray(const bool* data, std::size_t count)
+{
+    if (count > 0)
+    {
+        // Bools are written as bytes, like operator <<
+        char* output = grow(count);
+        for (std::size_t i = 0; i < count; ++i)
+            output[i] = data[i] ? 1 : 0;
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeArray(const Int8* data, std::size_t count)
+{
+    writeValues(data, count, sizeof(*data), false);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeArray(const Uint8* data, std::size_t count)
+{
+    writeValues(data, count, sizeof(*data), false);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeArray(const Int16* data, std::size_t count)
+{
+    writeValues(data, count, sizeof(*data), true);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeArray(const Uint16* data, std::size_t count)
+{
+    writeValues(data, count, sizeof(*data), true);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeArray(const Int32* data, std::size_t count)
+{
+    writeValues(data, count, sizeof(*data), true);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeArray(const Uint32* data, std::size_t count)
+{
+    writeValues(data, count, sizeof(*data), true);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeArray(const Int64* data, std::size_t count)
+{
+    writeValues(data, count, sizeof(*data), true);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeArray(const Uint64* data, std::size_t count)
+{
+    writeValues(data, count, sizeof(*data), true);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeArray(const float* data, std::size_t count)
+{
+    // Floating point values are written as is, like operator <<
+    writeValues(data, count, sizeof(*data), false);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeArray(const double* data, std::size_t count)
+{
+    writeValues(data, count, sizeof(*data), false);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(bool* data, std::size_t count)
+{
+    if ((count > 0) && checkSize(count))
+    {
+        const char* input = getReadPointer();
+        for (std::size_t i = 0; i < count; ++i)
+            data[i] = (input[i] != 0);
+
+        m_readPos += count;
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Int8* data, std::size_t count)
+{
+    readValues(data, count, sizeof(*data), false);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Uint8* data, std::size_t count)
+{
+    readValues(data, count, sizeof(*data), false);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Int16* data, std::size_t count)
+{
+    readValues(data, count, sizeof(*data), true);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Uint16* data, std::size_t count)
+{
+    readValues(data, count, sizeof(*data), true);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Int32* data, std::size_t count)
+{
+    readValues(data, count, sizeof(*data), true);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Uint32* data, std::size_t count)
+{
+    readValues(data, count, sizeof(*data), true);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Int64* data, std::size_t count)
+{
+    readValues(data, count, sizeof(*data), true);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(Uint64* data, std::size_t count)
+{
+    readValues(data, count, sizeof(*data), true);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(float* data, std::size_t count)
+{
+    readValues(data, count, sizeof(*data), false);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readArray(double* data, std::size_t count)
+{
+    readValues(data, count, sizeof(*data), false);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeBits(Uint32 value, unsigned int bitCount)
+{
+    bitCount = std::min(bitCount, 32u);
+
+    while (bitCount > 0)
+    {
+        // Start a new byte when the last one is full
+        if (m_writeBitPos == 0)
+        {
+            Uint8 empty = 0;
+            append(&empty, sizeof(empty));
+        }
+
+        // Fill the free bits of the last byte, lowest bits first
+        unsigned int count = std::min(8 - m_writeBitPos, bitCount);
+        Uint8* last = static_cast<Uint8*>(const_cast<void*>(getData())) + getDataSize() - 1;
+        *last = static_cast<Uint8>(*last | ((value & ((1u << count) - 1)) << m_writeBitPos));
+
+        value >>= count;
+        bitCount -= count;
+        m_writeBitPos = (m_writeBitPos + count) % 8;
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeFloat(float value, float min, float max, unsigned int bitCount)
+{
+    bitCount = std::min(bitCount, 32u);
+    double steps = static_cast<double>(bitCount < 32 ? (1u << bitCount) - 1 : 0xFFFFFFFFu);
+
+    // Clamp the value to the range (NaN goes to min)
+    if (!(value >= min))
+        value = min;
+    else if (value > max)
+        value = max;
+
+    Uint32 quantized = 0;
+    if (max > min)
+        quantized = static_cast<Uint32>((static_cast<double>(value) - min) / (static_cast<double>(max) - min) * steps + 0.5);
+
+    return writeBits(quantized, bitCount);
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeVarUint(Uint64 value)
+{
+    // 7 bits per byte, the highest bit tells whether more bytes follow
+    Uint8 bytes[10];
+    std::size_t count = 0;
+    do
+    {
+        bytes[count] = static_cast<Uint8>(value & 0x7F);
+        value >>= 7;
+        if (value != 0)
+            bytes[count] |= 0x80;
+        count++;
+    }
+    while (value != 0);
+
+    append(bytes, count);
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::writeVarInt(Int64 value)
+{
+    // Zigzag encoding: interleave positive and negative values
+    Uint64 encoded = static_cast<Uint64>(value) << 1;
+    if (value < 0)
+        encoded = ~encoded;
+
+    return writeVarUint(encoded);
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readBits(Uint32& value, unsigned int bitCount)
+{
+    bitCount = std::min(bitCount, 32u);
+
+    // Check that there are enough bits left
+    std::size_t available = (getDataSize() - m_readPos) * 8 - m_readBitPos;
+    m_isValid = m_isValid && (bitCount <= available);
+
+    if (m_isValid)
+    {
+        Uint32 result = 0;
+        for (unsigned int shift = 0; shift < bitCount;)
+        {
+            unsigned int count = std::min(8 - m_readBitPos, bitCount - shift);
+            Uint8 byte = *reinterpret_cast<const Uint8*>(getReadPointer());
+            result |= static_cast<Uint32>((byte >> m_readBitPos) & ((1u << count) - 1)) << shift;
+
+            shift += count;
+            m_readBitPos += count;
+            if (m_readBitPos == 8)
+            {
+                m_readBitPos = 0;
+                m_readPos++;
+            }
+        }
+
+        value = result;
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readFloat(float& value, float min, float max, unsigned int bitCount)
+{
+    bitCount = std::min(bitCount, 32u);
+    double steps = static_cast<double>(bitCount < 32 ? (1u << bitCount) - 1 : 0xFFFFFFFFu);
+
+    Uint32 quantized = 0;
+    if (readBits(quantized, bitCount))
+        value = static_cast<float>(min + quantized / steps * (static_cast<double>(max) - min));
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readVarUint(Uint64& value)
+{
+    Uint64 result = 0;
+    for (unsigned int shift = 0; shift < 64; shift += 7)
     {
-        for (String::ConstIterator c = data.begin(); c != data.end(); ++c)
-            *this << *c;
+        Uint8 byte = 0;
+        if (!(*this >> byte))
+            return *this;
+
+        result |= static_cast<Uint64>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            value = result;
+            return *this;
+        }
     }
 
+    // More than 10 bytes: this is not a valid varint
+    m_isValid = false;
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& Packet::readVarInt(Int64& value)
+{
+    Uint64 encoded = 0;
+    if (readVarUint(encoded))
+        value = static_cast<Int64>(encoded >> 1) ^ -static_cast<Int64>(encoded & 1);
+
     return *this;
 }
 
@@ -573,12 +1157,113 @@ Packet& Packet::operator <<(const String& data)
 ////////////////////////////////////////////////////////////
 bool Packet::checkSize(std::size_t size)
 {
-    m_isValid = m_isValid && (m_readPos + size <= m_data.size());
+    // Bytes are read from the next byte boundary, after the bits read so far
+    if (m_readBitPos > 0)
+    {
+        m_readBitPos = 0;
+        m_readPos++;
+    }
+
+    m_isValid = m_isValid && (m_readPos + size <= getDataSize());
 
     return m_isValid;
 }
 
 
+////////////////////////////////////////////////////////////
+const char* Packet::getReadPointer() const
+{
+    return static_cast<const char*>(getData()) + m_readPos;
+}
+
+
+////////////////////////////////////////////////////////////
+char* Packet::grow(std::size_t sizeInBytes)
+{
+    // Bytes always start at a byte boundary, after the bits written so far
+    m_writeBitPos = 0;
+
+    // The viewed memory is read-only: copy it to the memory of the packet before writing
+    if (m_view)
+    {
+        const char* view = m_view;
+        std::size_t viewSize = m_viewSize;
+        m_view = NULL;
+        m_viewSize = 0;
+
+        reserve(viewSize + sizeInBytes);
+        std::memcpy(grow(viewSize), view, viewSize);
+    }
+
+    if (m_external)
+    {
+        // Write to the external memory as long as the data fits in it
+        if (sizeInBytes <= m_externalCapacity - m_externalSize)
+        {
+            m_externalSize += sizeInBytes;
+            return m_external + m_externalSize - sizeInBytes;
+        }
+
+        // Otherwise move the data to memory owned by the packet
+        reserve(m_externalSize + sizeInBytes);
+    }
+
+    std::size_t start = m_data.size();
+    m_data.resize(start + sizeInBytes);
+    return &m_data[start];
+}
+
+
+////////////////////////////////////////////////////////////
+void Packet::writeValues(const void* data, std::size_t count, std::size_t size, bool swap)
+{
+    if (!data || (count == 0))
+        return;
+
+    char* output = grow(count * size);
+    if (swap && (size > 1) && !isBigEndian())
+        copySwapped(static_cast<const char*>(data), output, count, size);
+    else
+        std::memcpy(output, data, count * size);
+}
+
+
+////////////////////////////////////////////////////////////
+void Packet::readValues(void* data, std::size_t count, std::size_t size, bool swap)
+{
+    if (count == 0)
+        return;
+
+    const char* input = consume(count, size);
+    if (!input)
+        return;
+
+    if (swap && (size > 1) && !isBigEndian())
+        copySwapped(input, static_cast<char*>(data), count, size);
+    else
+        std::memcpy(data, input, count * size);
+}
+
+
+////////////////////////////////////////////////////////////
+const char* Packet::consume(std::size_t count, std::size_t size)
+{
+    // A single check for the whole array (guarding against an overflow of its size)
+    if ((size > 0) && (count > std::numeric_limits<std::size_t>::max() / size))
+        m_isValid = false;
+    else
+        checkSize(count * size);
+
+    if (!m_isValid)
+        return NULL;
+
+    const char* input = getReadPointer();
+    m_readPos += count * size;
+
+    return input;
+}
+
+
 ////////////////////////////////////////////////////////////
 const void* Packet::onSend(std::size_t& size)
 {
@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/PacketPool.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/System/Lock.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+PacketPool::PacketPool(std::size_t packetCapacity) :
+m_packetCapacity(packetCapacity)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+PacketPool::~PacketPool()
+{
+    for (std::vector<Packet*>::iterator it = m_packets.begin(); it != m_packets.end(); ++it)
+        delete *it;
+}
+
+
+////////////////////////////////////////////////////////////
+Packet& PacketPool::acquire()
+{
+    Lock lock(m_mutex);
+
+    if (!m_available.empty())
+    {
+        Packet* packet = m_available.back();
+        m_available.pop_back();
+        return *packet;
+    }
+
+    // No packet to recycle: create a new one
+    Packet* packet = new Packet;
+    packet->reserve(m_packetCapacity);
+    m_packets.push_back(packet);
+
+    // Make sure that releasing it will never have to allocate
+    m_available.reserve(m_packets.size());
+
+    return *packet;
+}
+
+
+////////////////////////////////////////////////////////////
+void PacketPool::release(Packet& packet)
+{
+    packet.clear();
+
+    Lock lock(m_mutex);
+    m_available.push_back(&packet);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t PacketPool::getAvailableCount() const
+{
+    Lock lock(m_mutex);
+
+    return m_available.size();
+}
+
+} // namespace sf
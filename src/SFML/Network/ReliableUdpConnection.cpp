@@ -0,0 +1,765 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/ReliableUdpConnection.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Identifier written at the beginning of every datagram
+    const sf::Uint32 protocolId = 0x53465255; // "SFRU"
+
+    // Datagram header: protocol id, flags, sequence, ack, ack bits
+    const std::size_t headerSize = 4 + 1 + 2 + 2 + 4;
+
+    // Biggest message header: info, channel, reliable id, order, fragment group, index and count, size
+    const std::size_t maxMessageHeaderSize = 1 + 1 + 4 + 4 + 4 + 2 + 2 + 2;
+
+    // Flags of the datagram header
+    const sf::Uint8 hasAck = 1;
+
+    // Flag of the message info byte
+    const sf::Uint8 fragmented = 4;
+
+    // Number of datagrams with messages after which an acknowledgement is sent immediately
+    const std::size_t acknowledgementThreshold = 16;
+
+    // Number of datagrams that carry the acknowledgement of a received message, so that it survives losses
+    const unsigned int acknowledgementRepeats = 3;
+
+    // Time after which a keep-alive datagram is sent
+    const sf::Time keepAliveInterval = sf::milliseconds(250);
+
+    // Time after which an incomplete unreliable message is dropped
+    const sf::Time fragmentTimeout = sf::seconds(1.f);
+
+    // Bounds of the retransmission timeout
+    const sf::Time minRetransmitTimeout = sf::milliseconds(20);
+    const sf::Time maxRetransmitTimeout = sf::seconds(2.f);
+
+    // Number of more recent datagrams that must be acknowledged before an older one is considered lost
+    const sf::Uint16 reorderingThreshold = 3;
+
+    // Bounds of the congestion window
+    const float minCongestionWindow = 2.f;
+    const float maxCongestionWindow = 256.f;
+
+    // Compare two sequence numbers, taking wrap-around into account
+    bool sequenceGreater(sf::Uint16 left, sf::Uint16 right)
+    {
+        return (left != right) && (static_cast<sf::Uint16>(left - right) < 0x8000);
+    }
+
+    // Write integers in network byte order
+    void write16(std::vector<char>& buffer, sf::Uint16 value)
+    {
+        buffer.push_back(static_cast<char>(value >> 8));
+        buffer.push_back(static_cast<char>(value));
+    }
+
+    void write32(std::vector<char>& buffer, sf::Uint32 value)
+    {
+        write16(buffer, static_cast<sf::Uint16>(value >> 16));
+        write16(buffer, static_cast<sf::Uint16>(value));
+    }
+
+    // Read integers in network byte order
+    sf::Uint16 read16(const unsigned char* data)
+    {
+        return static_cast<sf::Uint16>((data[0] << 8) | data[1]);
+    }
+
+    sf::Uint32 read32(const unsigned char* data)
+    {
+        return (static_cast<sf::Uint32>(read16(data)) << 16) | read16(data + 2);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ReliableUdpConnection::Channel::Channel() :
+nextSent    (0),
+nextReceived(0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+ReliableUdpConnection::ReliableUdpConnection(UdpSocket& socket, const IpAddress& remoteAddress, unsigned short remotePort) :
+m_socket             (socket),
+m_remoteAddress      (remoteAddress),
+m_remotePort         (remotePort),
+m_datagramSize       (1200),
+m_timeout            (seconds(10.f)),
+m_lastReceived       (Time::Zero),
+m_lastSent           (Time::Zero),
+m_disconnected       (false),
+m_localSequence      (0),
+m_remoteSequence     (0),
+m_receivedBits       (0),
+m_receivedAny        (false),
+m_unacknowledged     (0),
+m_acknowledgements   (0),
+m_highestAcked       (0),
+m_ackedAny           (false),
+m_nextReliableId     (0),
+m_nextGroup          (0),
+m_reliableBase       (0),
+m_smoothedRtt        (Time::Zero),
+m_rttVariation       (Time::Zero),
+m_retransmitTimeout  (milliseconds(200)),
+m_rttMeasured        (false),
+m_congestionWindow   (8.f),
+m_slowStartThreshold (maxCongestionWindow),
+m_lastReduction      (Time::Zero),
+m_lastAcknowledgement(Time::Zero)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+const IpAddress& ReliableUdpConnection::getRemoteAddress() const
+{
+    return m_remoteAddress;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned short ReliableUdpConnection::getRemotePort() const
+{
+    return m_remotePort;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status ReliableUdpConnection::send(Packet& packet, Delivery delivery, Uint8 channel)
+{
+    if (channel >= ChannelCount)
+    {
+        err() << "Cannot send a packet on channel " << static_cast<int>(channel)
+              << " (sf::ReliableUdpConnection only has " << static_cast<int>(ChannelCount) << " channels)" << std::endl;
+        return Socket::Error;
+    }
+
+    if (m_disconnected)
+        return Socket::Disconnected;
+
+    // Get the data to send from the packet
+    std::size_t size = 0;
+    const char* data = static_cast<const char*>(packet.onSend(size));
+
+    // Split the packet if it doesn't fit in a single datagram
+    std::size_t fragmentSize = m_datagramSize - headerSize - maxMessageHeaderSize;
+    std::size_t count = (size + fragmentSize - 1) / fragmentSize;
+    if (count > 0xFFFF)
+    {
+        err() << "Cannot send a packet of " << size << " bytes with sf::ReliableUdpConnection "
+              << "(it would need more than 65535 datagrams)" << std::endl;
+        return Socket::Error;
+    }
+
+    Uint32 order = (delivery == ReliableOrdered) ? m_channels[channel].nextSent++ : 0;
+
+    if (count <= 1)
+    {
+        queueMessage(delivery, channel, order, data, size, 0, 0, 0);
+    }
+    else
+    {
+        Uint32 group = m_nextGroup++;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::size_t offset = i * fragmentSize;
+            queueMessage(delivery, channel, order, data + offset, std::min(fragmentSize, size - offset),
+                         group, static_cast<Uint16>(i), static_cast<Uint16>(count));
+        }
+    }
+
+    return Socket::Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status ReliableUdpConnection::receive(Packet& packet, Uint8& channel)
+{
+    if (m_receivedQueue.empty())
+        return m_disconnected ? Socket::Disconnected : Socket::NotReady;
+
+    // Let the packet transform the received data
+    Received& received = m_receivedQueue.front();
+    packet.clear();
+    packet.onReceive(received.data.empty() ? NULL : &received.data[0], received.data.size());
+    channel = received.channel;
+    m_receivedQueue.pop_front();
+
+    return Socket::Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status ReliableUdpConnection::update()
+{
+    // Nothing can be received before the socket is bound, explicitly or by the first send
+    if (!m_disconnected && (m_socket.getLocalPort() != 0))
+    {
+        bool blocking = m_socket.isBlocking();
+        m_socket.setBlocking(false);
+
+        m_buffer.resize(UdpSocket::MaxDatagramSize);
+        std::size_t    received = 0;
+        IpAddress      sender;
+        unsigned short port = 0;
+        while (m_socket.receive(&m_buffer[0], m_buffer.size(), received, sender, port) == Socket::Done)
+        {
+            if ((sender == m_remoteAddress) && (port == m_remotePort))
+                processDatagram(&m_buffer[0], received);
+        }
+
+        m_socket.setBlocking(blocking);
+    }
+
+    return flush();
+}
+
+
+////////////////////////////////////////////////////////////
+bool ReliableUdpConnection::processDatagram(const void* data, std::size_t size)
+{
+    if (m_disconnected)
+        return false;
+
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    if ((size < headerSize) || (read32(bytes) != protocolId))
+        return false;
+
+    m_lastReceived = m_clock.getElapsedTime();
+
+    Uint8  flags    = bytes[4];
+    Uint16 sequence = read16(bytes + 5);
+    if (flags & hasAck)
+        processAcks(read16(bytes + 7), read32(bytes + 9));
+
+    // Record the sequence number, so that it is acknowledged, and drop duplicated datagrams
+    if (!m_receivedAny)
+    {
+        m_receivedAny    = true;
+        m_remoteSequence = sequence;
+        m_receivedBits   = 0;
+    }
+    else if (sequenceGreater(sequence, m_remoteSequence))
+    {
+        Uint16 shift = static_cast<Uint16>(sequence - m_remoteSequence);
+        if (shift < 32)
+            m_receivedBits = (m_receivedBits << shift) | (1u << (shift - 1));
+        else
+            m_receivedBits = (shift == 32) ? 0x80000000u : 0;
+        m_remoteSequence = sequence;
+    }
+    else
+    {
+        Uint16 distance = static_cast<Uint16>(m_remoteSequence - sequence);
+        if (distance == 0)
+            return true;
+
+        if (distance <= 32)
+        {
+            Uint32 bit = 1u << (distance - 1);
+            if (m_receivedBits & bit)
+                return true;
+            m_receivedBits |= bit;
+        }
+    }
+
+    // Extract the messages
+    std::size_t position    = headerSize;
+    bool        hasMessages = false;
+    while (position < size)
+    {
+        if (size - position < 2)
+            return false;
+
+        Uint8    info     = bytes[position];
+        Uint8    channel  = bytes[position + 1];
+        Delivery delivery = static_cast<Delivery>(info & 3);
+        if ((delivery > ReliableOrdered) || (channel >= ChannelCount))
+            return false;
+
+        std::size_t messageHeaderSize = 2 + (delivery != Unreliable ? 4 : 0) + (delivery == ReliableOrdered ? 4 : 0) + (info & fragmented ? 8 : 0) + 2;
+        if (size - position < messageHeaderSize)
+            return false;
+
+        position += 2;
+        Uint32 id    = 0;
+        Uint32 order = 0;
+        Uint32 group = 0;
+        Uint16 index = 0;
+        Uint16 count = 0;
+        if (delivery != Unreliable)
+        {
+            id = read32(bytes + position);
+            position += 4;
+        }
+        if (delivery == ReliableOrdered)
+        {
+            order = read32(bytes + position);
+            position += 4;
+        }
+        if (info & fragmented)
+        {
+            group = read32(bytes + position);
+            index = read16(bytes + position + 4);
+            count = read16(bytes + position + 6);
+            position += 8;
+        }
+        std::size_t messageSize = read16(bytes + position);
+        position += 2;
+        if (size - position < messageSize)
+            return false;
+
+        const char* messageData = reinterpret_cast<const char*>(bytes + position);
+        position += messageSize;
+        hasMessages = true;
+
+        // Drop the reliable messages that were already received
+        if (delivery != Unreliable)
+        {
+            if ((id < m_reliableBase) || (m_reliableReceived.find(id) != m_reliableReceived.end()))
+                continue;
+
+            m_reliableReceived.insert(id);
+            while (!m_reliableReceived.empty() && (*m_reliableReceived.begin() == m_reliableBase))
+            {
+                m_reliableReceived.erase(m_reliableReceived.begin());
+                ++m_reliableBase;
+            }
+        }
+
+        std::vector<char> message(messageData, messageData + messageSize);
+        if (info & fragmented)
+        {
+            // Store the fragment until the whole message is received
+            if ((index >= count) || message.empty())
+                return false;
+
+            std::map<Uint32, FragmentGroup>::iterator it = m_fragmentGroups.find(group);
+            if (it == m_fragmentGroups.end())
+            {
+                it = m_fragmentGroups.insert(std::make_pair(group, FragmentGroup())).first;
+                it->second.delivery = delivery;
+                it->second.time     = m_lastReceived;
+                it->second.parts.resize(count);
+                it->second.received = 0;
+            }
+
+            FragmentGroup& fragments = it->second;
+            if ((fragments.parts.size() != count) || !fragments.parts[index].empty())
+                continue;
+
+            fragments.parts[index].swap(message);
+            if (++fragments.received < count)
+                continue;
+
+            // All the fragments are there: reassemble the message
+            for (std::size_t i = 0; i < fragments.parts.size(); ++i)
+                message.insert(message.end(), fragments.parts[i].begin(), fragments.parts[i].end());
+            m_fragmentGroups.erase(it);
+        }
+
+        processMessage(delivery, channel, order, message);
+    }
+
+    if (!hasMessages)
+        return true;
+
+    // Acknowledge without waiting for the next flush if many datagrams were received since the last one
+    m_acknowledgements = acknowledgementRepeats;
+    if (++m_unacknowledged >= acknowledgementThreshold)
+    {
+        std::vector<char>   acknowledgement(headerSize);
+        std::vector<Uint32> reliableIds;
+        sendDatagram(acknowledgement, reliableIds);
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status ReliableUdpConnection::flush()
+{
+    if (m_disconnected)
+        return Socket::Disconnected;
+
+    Time now = m_clock.getElapsedTime();
+    if (now - m_lastReceived > m_timeout)
+    {
+        m_disconnected = true;
+        return Socket::Disconnected;
+    }
+
+    detectLosses();
+
+    // Drop the unreliable messages whose fragments didn't all arrive
+    for (std::map<Uint32, FragmentGroup>::iterator it = m_fragmentGroups.begin(); it != m_fragmentGroups.end();)
+    {
+        if ((it->second.delivery == Unreliable) && (now - it->second.time > fragmentTimeout))
+            m_fragmentGroups.erase(it++);
+        else
+            ++it;
+    }
+
+    // Send as many datagrams as needed for the queued messages; only the ones
+    // with reliable messages are limited by the congestion window
+    bool                sent = false;
+    std::vector<char>   datagram;
+    std::vector<Uint32> reliableIds;
+    while (!m_reliableQueue.empty() || !m_unreliableQueue.empty())
+    {
+        bool reliableAllowed = m_sentDatagrams.size() < static_cast<std::size_t>(m_congestionWindow);
+        if (!reliableAllowed && m_unreliableQueue.empty())
+            break;
+
+        datagram.resize(headerSize);
+        reliableIds.clear();
+
+        while (reliableAllowed && !m_reliableQueue.empty())
+        {
+            // Skip the messages that were acknowledged since they were queued
+            std::map<Uint32, std::vector<char> >::const_iterator it = m_pendingReliable.find(m_reliableQueue.front());
+            if (it == m_pendingReliable.end())
+            {
+                m_reliableQueue.pop_front();
+                continue;
+            }
+
+            if ((datagram.size() + it->second.size() > m_datagramSize) && (datagram.size() > headerSize))
+                break;
+
+            datagram.insert(datagram.end(), it->second.begin(), it->second.end());
+            reliableIds.push_back(it->first);
+            m_reliableQueue.pop_front();
+        }
+
+        while (!m_unreliableQueue.empty())
+        {
+            const std::vector<char>& message = m_unreliableQueue.front();
+            if ((datagram.size() + message.size() > m_datagramSize) && (datagram.size() > headerSize))
+                break;
+
+            datagram.insert(datagram.end(), message.begin(), message.end());
+            m_unreliableQueue.pop_front();
+        }
+
+        if (datagram.size() == headerSize)
+            break;
+
+        Socket::Status status = sendDatagram(datagram, reliableIds);
+        if (status == Socket::Error)
+            return Socket::Error;
+        sent = true;
+        if (status != Socket::Done)
+            break;
+    }
+
+    // Make sure that the peer gets our acknowledgements and knows that we are alive
+    if (!sent && ((m_acknowledgements > 0) || (now - m_lastSent >= keepAliveInterval)))
+    {
+        datagram.resize(headerSize);
+        reliableIds.clear();
+        if (sendDatagram(datagram, reliableIds) == Socket::Error)
+            return Socket::Error;
+    }
+
+    return Socket::Done;
+}
+
+
+////////////////////////////////////////////////////////////
+void ReliableUdpConnection::setMaximumDatagramSize(std::size_t size)
+{
+    m_datagramSize = std::max(std::min(size, static_cast<std::size_t>(UdpSocket::MaxDatagramSize)), headerSize + maxMessageHeaderSize + 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void ReliableUdpConnection::setTimeout(Time timeout)
+{
+    m_timeout = timeout;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ReliableUdpConnection::isDisconnected() const
+{
+    return m_disconnected;
+}
+
+
+////////////////////////////////////////////////////////////
+Time ReliableUdpConnection::getRoundTripTime() const
+{
+    return m_smoothedRtt;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ReliableUdpConnection::getPendingReliableCount() const
+{
+    return m_pendingReliable.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void ReliableUdpConnection::queueMessage(Delivery delivery, Uint8 channel, Uint32 order, const char* data, std::size_t size, Uint32 group, Uint16 index, Uint16 count)
+{
+    std::vector<char> message;
+    message.reserve(maxMessageHeaderSize + size);
+    message.push_back(static_cast<char>(delivery | (count > 0 ? fragmented : 0)));
+    message.push_back(static_cast<char>(channel));
+
+    Uint32 id = 0;
+    if (delivery != Unreliable)
+    {
+        id = m_nextReliableId++;
+        write32(message, id);
+    }
+    if (delivery == ReliableOrdered)
+        write32(message, order);
+    if (count > 0)
+    {
+        write32(message, group);
+        write16(message, index);
+        write16(message, count);
+    }
+    write16(message, static_cast<Uint16>(size));
+    message.insert(message.end(), data, data + size);
+
+    if (delivery != Unreliable)
+    {
+        m_pendingReliable[id].swap(message);
+        m_reliableQueue.push_back(id);
+    }
+    else
+    {
+        m_unreliableQueue.push_back(std::vector<char>());
+        m_unreliableQueue.back().swap(message);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ReliableUdpConnection::processMessage(Delivery delivery, Uint8 channel, Uint32 order, std::vector<char>& data)
+{
+    if (delivery != ReliableOrdered)
+    {
+        m_receivedQueue.push_back(Received());
+        m_receivedQueue.back().channel = channel;
+        m_receivedQueue.back().data.swap(data);
+        return;
+    }
+
+    // Hold the ordered messages that arrive before their predecessors
+    Channel& state = m_channels[channel];
+    if (order != state.nextReceived)
+    {
+        if (order - state.nextReceived < 0x80000000u)
+            state.early[order].swap(data);
+        return;
+    }
+
+    m_receivedQueue.push_back(Received());
+    m_receivedQueue.back().channel = channel;
+    m_receivedQueue.back().data.swap(data);
+    ++state.nextReceived;
+
+    // Deliver the messages that were waiting for this one
+    std::map<Uint32, std::vector<char> >::iterator it;
+    while ((it = state.early.find(state.nextReceived)) != state.early.end())
+    {
+        m_receivedQueue.push_back(Received());
+        m_receivedQueue.back().channel = channel;
+        m_receivedQueue.back().data.swap(it->second);
+        state.early.erase(it);
+        ++state.nextReceived;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ReliableUdpConnection::processAcks(Uint16 ack, Uint32 ackBits)
+{
+    if (!m_ackedAny || sequenceGreater(ack, m_highestAcked))
+    {
+        m_highestAcked = ack;
+        m_ackedAny     = true;
+    }
+
+    for (Uint16 i = 0; i <= 32; ++i)
+    {
+        if ((i > 0) && !(ackBits & (1u << (i - 1))))
+            continue;
+
+        std::map<Uint16, SentDatagram>::iterator it = m_sentDatagrams.find(static_cast<Uint16>(ack - i));
+        if (it != m_sentDatagrams.end())
+            acknowledge(it, i == 0);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ReliableUdpConnection::acknowledge(std::map<Uint16, SentDatagram>::iterator datagram, bool measure)
+{
+    // Update the round-trip time estimate; only the most recent datagram acknowledged
+    // gives a meaningful sample, older ones may have been acknowledged late because
+    // the peer's previous acknowledgements were lost
+    if (measure)
+    {
+        Time sample = m_clock.getElapsedTime() - datagram->second.time;
+        if (!m_rttMeasured)
+        {
+            m_smoothedRtt  = sample;
+            m_rttVariation = sample / 2.f;
+            m_rttMeasured  = true;
+        }
+        else
+        {
+            Time error = (sample > m_smoothedRtt) ? sample - m_smoothedRtt : m_smoothedRtt - sample;
+            m_rttVariation = m_rttVariation * 0.75f + error * 0.25f;
+            m_smoothedRtt  = m_smoothedRtt * 0.875f + sample * 0.125f;
+        }
+        m_retransmitTimeout = std::min(std::max(m_smoothedRtt + m_rttVariation * 4.f, minRetransmitTimeout), maxRetransmitTimeout);
+    }
+
+    // The reliable messages of the datagram don't need to be sent anymore
+    const std::vector<Uint32>& ids = datagram->second.reliableIds;
+    for (std::vector<Uint32>::const_iterator it = ids.begin(); it != ids.end(); ++it)
+        m_pendingReliable.erase(*it);
+    m_sentDatagrams.erase(datagram);
+    m_lastAcknowledgement = m_clock.getElapsedTime();
+
+    // Grow the congestion window: exponentially during the slow start, linearly after
+    if (m_congestionWindow < m_slowStartThreshold)
+        m_congestionWindow += 1.f;
+    else
+        m_congestionWindow += 1.f / m_congestionWindow;
+    m_congestionWindow = std::min(m_congestionWindow, maxCongestionWindow);
+}
+
+
+////////////////////////////////////////////////////////////
+void ReliableUdpConnection::detectLosses()
+{
+    Time now      = m_clock.getElapsedTime();
+    bool lost     = false;
+    bool timedOut = false;
+
+    std::map<Uint16, SentDatagram>::iterator it = m_sentDatagrams.begin();
+    while (it != m_sentDatagrams.end())
+    {
+        // A datagram is lost if it is not acknowledged in time, or if enough
+        // datagrams sent after it were acknowledged
+        bool expired   = now - it->second.time > m_retransmitTimeout;
+        bool overtaken = m_ackedAny && sequenceGreater(m_highestAcked, it->first) && (static_cast<Uint16>(m_highestAcked - it->first) >= reorderingThreshold);
+        if (!expired && !overtaken)
+        {
+            ++it;
+            continue;
+        }
+
+        // Schedule the reliable messages again, before the new ones
+        const std::vector<Uint32>& ids = it->second.reliableIds;
+        for (std::vector<Uint32>::const_reverse_iterator id = ids.rbegin(); id != ids.rend(); ++id)
+        {
+            if (m_pendingReliable.find(*id) != m_pendingReliable.end())
+                m_reliableQueue.push_front(*id);
+        }
+
+        lost     = true;
+        timedOut = timedOut || !overtaken;
+        m_sentDatagrams.erase(it++);
+    }
+
+    if (!lost)
+        return;
+
+    // Halve the congestion window, at most once per round trip
+    if (now - m_lastReduction > m_smoothedRtt)
+    {
+        m_slowStartThreshold = std::max(m_congestionWindow / 2.f, minCongestionWindow);
+        m_congestionWindow   = m_slowStartThreshold;
+        m_lastReduction      = now;
+    }
+
+    // Back off while the peer doesn't answer
+    if (timedOut && (now - m_lastAcknowledgement > m_retransmitTimeout))
+        m_retransmitTimeout = std::min(m_retransmitTimeout * 2.f, maxRetransmitTimeout);
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status ReliableUdpConnection::sendDatagram(std::vector<char>& datagram, std::vector<Uint32>& reliableIds)
+{
+    // Fill the header
+    std::vector<char> header;
+    header.reserve(headerSize);
+    write32(header, protocolId);
+    header.push_back(static_cast<char>(m_receivedAny ? hasAck : 0));
+    write16(header, m_localSequence);
+    write16(header, m_remoteSequence);
+    write32(header, m_receivedBits);
+    std::copy(header.begin(), header.end(), datagram.begin());
+
+    Socket::Status status = m_socket.send(&datagram[0], datagram.size(), m_remoteAddress, m_remotePort);
+
+    // Remember the reliable messages of the datagram even if it couldn't be sent,
+    // it will be detected as lost and its messages will be sent again
+    Time now = m_clock.getElapsedTime();
+    if (!reliableIds.empty())
+    {
+        SentDatagram& sent = m_sentDatagrams[m_localSequence];
+        sent.time = now;
+        sent.reliableIds.swap(reliableIds);
+    }
+
+    ++m_localSequence;
+    m_lastSent       = now;
+    m_unacknowledged = 0;
+    if (m_acknowledgements > 0)
+        --m_acknowledgements;
+
+    return status;
+}
+
+} // namespace sf
@@ -0,0 +1,452 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/SharedMemoryRing.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/System/AtomicInt.hpp>
+#include <SFML/System/Err.hpp>
+#include <cstring>
+#include <new>
+#if defined(SFML_SYSTEM_WINDOWS)
+    #include <windows.h>
+#elif !defined(SFML_SYSTEM_ANDROID)
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+
+namespace
+{
+    // Value identifying an initialized ring ("SFRR")
+    const sf::Int32 ringMagic = 0x53465252;
+
+    // Each message is preceded by its size, and padded so that the next one is aligned
+    const sf::Uint32 recordHeaderSize = 8;
+
+    // Size of the record filling the end of the memory when a message doesn't fit before it
+    const sf::Uint32 paddingRecord = 0xFFFFFFFF;
+
+    // Header of the shared memory, the positions written by each process are on their own cache line
+    struct RingHeader
+    {
+        sf::AtomicInt magic;                           ///< ringMagic once the ring is initialized
+        sf::Uint32    capacity;                        ///< Size of the message area, a power of two
+        char          padding1[64 - sizeof(sf::AtomicInt) - sizeof(sf::Uint32)];
+        sf::AtomicInt head;                            ///< Position of the next message to read, written by the reader
+        char          padding2[64 - sizeof(sf::AtomicInt)];
+        sf::AtomicInt tail;                            ///< Position of the next message to write, written by the writer
+        char          padding3[64 - sizeof(sf::AtomicInt)];
+    };
+
+    // Get the size of the record of a message
+    sf::Uint32 getRecordSize(std::size_t size)
+    {
+        return static_cast<sf::Uint32>((size + recordHeaderSize + 7) & ~static_cast<std::size_t>(7));
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SharedMemoryRing::SharedMemoryRing() :
+m_owner    (false),
+m_mapping  (NULL),
+m_memory   (NULL),
+m_size     (0),
+m_data     (NULL),
+m_capacity (0),
+m_reserved (0),
+m_writeSize(0),
+m_readSize (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SharedMemoryRing::~SharedMemoryRing()
+{
+    close();
+}
+
+
+////////////////////////////////////////////////////////////
+bool SharedMemoryRing::create(const std::string& name, std::size_t capacity)
+{
+    close();
+
+    if (name.empty() || (name.find_first_of("/\\") != std::string::npos))
+    {
+        err() << "Failed to create shared memory ring \"" << name << "\" (invalid name)" << std::endl;
+        return false;
+    }
+
+    if ((capacity == 0) || (capacity > (1u << 30)))
+    {
+        err() << "Failed to create shared memory ring \"" << name << "\" (invalid capacity)" << std::endl;
+        return false;
+    }
+
+    // The positions wrap around, the capacity must be a power of two
+    std::size_t roundedCapacity = 64;
+    while (roundedCapacity < capacity)
+        roundedCapacity *= 2;
+
+    m_name = name;
+    if (!map(roundedCapacity))
+    {
+        err() << "Failed to create shared memory ring \"" << name << "\"" << std::endl;
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SharedMemoryRing::open(const std::string& name)
+{
+    close();
+
+    if (name.empty() || (name.find_first_of("/\\") != std::string::npos))
+    {
+        err() << "Failed to open shared memory ring \"" << name << "\" (invalid name)" << std::endl;
+        return false;
+    }
+
+    m_name = name;
+    if (!map(0))
+    {
+        err() << "Failed to open shared memory ring \"" << name << "\"" << std::endl;
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SharedMemoryRing::close()
+{
+#if defined(SFML_SYSTEM_WINDOWS)
+
+    // The memory is released when the last process closes it
+    if (m_memory)
+        UnmapViewOfFile(m_memory);
+    if (m_mapping)
+        CloseHandle(m_mapping);
+
+#elif !defined(SFML_SYSTEM_ANDROID)
+
+    // The memory is released when the last process unmaps it, once its name is removed
+    if (m_memory)
+        munmap(m_memory, m_size);
+    if (m_owner)
+        shm_unlink(("/" + m_name).c_str());
+
+#endif
+
+    m_name.clear();
+    m_owner     = false;
+    m_mapping   = NULL;
+    m_memory    = NULL;
+    m_size      = 0;
+    m_data      = NULL;
+    m_capacity  = 0;
+    m_writeSize = 0;
+    m_readSize  = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SharedMemoryRing::isOpen() const
+{
+    return m_memory != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SharedMemoryRing::getMaxMessageSize() const
+{
+    // A message must fit after the padding of the end of the memory, which can take up to half of it
+    return m_memory ? m_capacity / 2 - recordHeaderSize : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void* SharedMemoryRing::beginWrite(std::size_t size)
+{
+    if (!m_memory)
+        return NULL;
+
+    if (size > getMaxMessageSize())
+    {
+        err() << "Failed to write a message of " << size << " bytes to shared memory ring \"" << m_name
+              << "\" (the maximum is " << getMaxMessageSize() << " bytes)" << std::endl;
+        return NULL;
+    }
+
+    RingHeader& header = *static_cast<RingHeader*>(m_memory);
+    Uint32 tail = static_cast<Uint32>(header.tail.load());
+    Uint32 head = static_cast<Uint32>(header.head.load());
+    Uint32 available = m_capacity - (tail - head);
+    Uint32 offset = tail & (m_capacity - 1);
+    Uint32 record = getRecordSize(size);
+
+    // Messages are contiguous: skip the end of the memory if the message doesn't fit before it
+    Uint32 skipped = (m_capacity - offset < record) ? m_capacity - offset : 0;
+    if (skipped + record > available)
+        return NULL;
+
+    if (skipped > 0)
+    {
+        *reinterpret_cast<Uint32*>(m_data + offset) = paddingRecord;
+        tail += skipped;
+        offset = 0;
+    }
+
+    // The message is invisible to the reader until the tail is moved by endWrite
+    *reinterpret_cast<Uint32*>(m_data + offset) = static_cast<Uint32>(size);
+    m_reserved = tail;
+    m_writeSize = record;
+
+    return m_data + offset + recordHeaderSize;
+}
+
+
+////////////////////////////////////////////////////////////
+void SharedMemoryRing::endWrite()
+{
+    if (!m_memory || (m_writeSize == 0))
+        return;
+
+    RingHeader& header = *static_cast<RingHeader*>(m_memory);
+    header.tail.store(static_cast<Int32>(m_reserved + m_writeSize));
+    m_writeSize = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SharedMemoryRing::write(const void* data, std::size_t size)
+{
+    void* destination = beginWrite(size);
+    if (!destination)
+        return false;
+
+    if (size > 0)
+        std::memcpy(destination, data, size);
+    endWrite();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SharedMemoryRing::write(Packet& packet)
+{
+    std::size_t size = 0;
+    const void* data = packet.onSend(size);
+
+    return write(data, size);
+}
+
+
+////////////////////////////////////////////////////////////
+const void* SharedMemoryRing::beginRead(std::size_t& size)
+{
+    size = 0;
+    if (!m_memory)
+        return NULL;
+
+    RingHeader& header = *static_cast<RingHeader*>(m_memory);
+    Uint32 head = static_cast<Uint32>(header.head.load());
+    Uint32 tail = static_cast<Uint32>(header.tail.load());
+    if (head == tail)
+        return NULL;
+
+    // Skip the padding of the end of the memory, the message follows at the beginning
+    Uint32 offset = head & (m_capacity - 1);
+    Uint32 length = *reinterpret_cast<const Uint32*>(m_data + offset);
+    if (length == paddingRecord)
+    {
+        head += m_capacity - offset;
+        header.head.store(static_cast<Int32>(head));
+        offset = 0;
+        length = *reinterpret_cast<const Uint32*>(m_data);
+    }
+
+    size = length;
+    m_readSize = getRecordSize(length);
+
+    return m_data + offset + recordHeaderSize;
+}
+
+
+////////////////////////////////////////////////////////////
+void SharedMemoryRing::endRead()
+{
+    if (!m_memory || (m_readSize == 0))
+        return;
+
+    RingHeader& header = *static_cast<RingHeader*>(m_memory);
+    header.head.store(header.head.load() + static_cast<Int32>(m_readSize));
+    m_readSize = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SharedMemoryRing::read(Packet& packet)
+{
+    std::size_t size = 0;
+    const void* data = beginRead(size);
+    if (!data)
+        return false;
+
+    packet.clear();
+    if (size > 0)
+        packet.onReceive(data, size);
+    endRead();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SharedMemoryRing::map(std::size_t capacity)
+{
+    std::size_t size = sizeof(RingHeader) + capacity;
+
+#if defined(SFML_SYSTEM_WINDOWS)
+
+    // Named mappings of the paging file live as long as a process has a handle to them
+    std::string path = "Local\\" + m_name;
+    HANDLE mapping = NULL;
+    if (capacity > 0)
+    {
+        mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, static_cast<DWORD>(size), path.c_str());
+        if (mapping && (GetLastError() == ERROR_ALREADY_EXISTS))
+        {
+            CloseHandle(mapping);
+            return false;
+        }
+    }
+    else
+    {
+        mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, path.c_str());
+    }
+    if (!mapping)
+        return false;
+
+    m_mapping = mapping;
+    m_memory = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, capacity > 0 ? size : 0);
+    if (!m_memory)
+        return false;
+
+    if (capacity == 0)
+    {
+        MEMORY_BASIC_INFORMATION information;
+        if (VirtualQuery(m_memory, &information, sizeof(information)) == 0)
+            return false;
+        size = information.RegionSize;
+    }
+    m_owner = (capacity > 0);
+
+#elif !defined(SFML_SYSTEM_ANDROID)
+
+    // The memory of a new ring is zeroed by the system
+    std::string path = "/" + m_name;
+    int file = shm_open(path.c_str(), capacity > 0 ? O_RDWR | O_CREAT | O_EXCL : O_RDWR, 0600);
+    if (file < 0)
+        return false;
+
+    // From now on, a new ring must be removed if it can't be initialized
+    m_owner = (capacity > 0);
+
+    if (capacity > 0)
+    {
+        if (ftruncate(file, static_cast<off_t>(size)) != 0)
+        {
+            ::close(file);
+            return false;
+        }
+    }
+    else
+    {
+        struct stat status;
+        if (fstat(file, &status) != 0)
+        {
+            ::close(file);
+            return false;
+        }
+        size = static_cast<std::size_t>(status.st_size);
+    }
+
+    // The mapping stays valid after the file is closed
+    void* memory = (size >= sizeof(RingHeader)) ? mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0) : MAP_FAILED;
+    ::close(file);
+    if (memory == MAP_FAILED)
+        return false;
+
+    m_memory = memory;
+
+#else
+
+    // Android doesn't provide named shared memory
+    return false;
+
+#endif
+
+    m_size = size;
+
+    RingHeader* header = static_cast<RingHeader*>(m_memory);
+    if (capacity > 0)
+    {
+        // Publish the magic number last, so that the other process never sees a partly initialized ring
+        new (header) RingHeader;
+        header->capacity = static_cast<Uint32>(capacity);
+        header->magic.store(ringMagic);
+    }
+    else if ((m_size < sizeof(RingHeader)) || (header->magic.load() != ringMagic))
+    {
+        return false;
+    }
+
+    // A corrupted capacity must not make the functions access memory outside of the mapping
+    Uint32 ringCapacity = header->capacity;
+    if ((ringCapacity < 64) || ((ringCapacity & (ringCapacity - 1)) != 0) || (sizeof(RingHeader) + ringCapacity > m_size))
+        return false;
+
+    m_data = static_cast<char*>(m_memory) + sizeof(RingHeader);
+    m_capacity = ringCapacity;
+
+    return true;
+}
+
+} // namespace sf
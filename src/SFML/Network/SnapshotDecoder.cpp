@@ -0,0 +1,195 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/SnapshotDecoder.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+    // Snapshots are compared by blocks of this size
+    const std::size_t blockSize = 8;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SnapshotDecoder::SnapshotDecoder() :
+m_snapshots(),
+m_masks    (),
+m_changes  ()
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+bool SnapshotDecoder::decode(Packet& input, Packet& snapshot)
+{
+    // Read the header: sequence number, distance to the baseline (0 if there is none) and size
+    Uint64 sequence = 0;
+    Uint64 distance = 0;
+    Uint64 size = 0;
+    if (!input.readVarUint(sequence).readVarUint(distance).readVarUint(size))
+    {
+        err() << "Failed to decode snapshot (truncated data)" << std::endl;
+        return false;
+    }
+
+    // Every block takes at least one bit: don't let a forged size allocate more
+    if ((sequence == 0) || (sequence > 0xFFFFFFFF) || (distance > sequence) || (size / blockSize / 8 > input.getDataSize()))
+    {
+        err() << "Failed to decode snapshot (invalid header)" << std::endl;
+        return false;
+    }
+
+    // Read the masks of the changed blocks, then the changed bytes
+    std::size_t blockCount = (static_cast<std::size_t>(size) + blockSize - 1) / blockSize;
+    std::size_t changeCount = 0;
+    m_masks.resize(blockCount);
+    for (std::size_t i = 0; (i < blockCount) && input; ++i)
+    {
+        Uint32 changed = 0;
+        Uint32 mask = 0;
+        if (input.readBits(changed, 1) && changed)
+            input.readBits(mask, blockSize);
+
+        // The mask of the last block must not reach beyond the end of the snapshot
+        std::size_t available = std::min(blockSize, static_cast<std::size_t>(size) - i * blockSize);
+        if (mask >> available)
+        {
+            err() << "Failed to decode snapshot (invalid mask)" << std::endl;
+            return false;
+        }
+
+        m_masks[i] = static_cast<Uint8>(mask);
+        for (; mask != 0; mask &= mask - 1)
+            changeCount++;
+    }
+
+    m_changes.resize(changeCount);
+    if ((changeCount > 0) && input)
+        input.readArray(&m_changes[0], changeCount);
+
+    if (!input)
+    {
+        err() << "Failed to decode snapshot (truncated data)" << std::endl;
+        return false;
+    }
+
+    // Outdated snapshots are valid, but useless
+    if (!m_snapshots.empty() && (sequence <= m_snapshots.back().sequence))
+        return false;
+
+    // Find the baseline
+    std::size_t baseline = 0;
+    if (distance != 0)
+    {
+        for (baseline = 0; baseline < m_snapshots.size(); ++baseline)
+        {
+            if (m_snapshots[baseline].sequence == sequence - distance)
+                break;
+        }
+
+        if (baseline == m_snapshots.size())
+        {
+            err() << "Failed to decode snapshot (unknown baseline)" << std::endl;
+            return false;
+        }
+    }
+
+    // The encoder will never use the snapshots older than the baseline: forget them, as well as
+    // the oldest snapshots (other than the baseline) if there are too many, and recycle their memory
+    std::vector<char> memory;
+    if ((distance != 0) && (baseline > 0))
+    {
+        memory.swap(m_snapshots[baseline - 1].data);
+        m_snapshots.erase(m_snapshots.begin(), m_snapshots.begin() + baseline);
+    }
+    if (m_snapshots.size() >= MaxSnapshots)
+    {
+        std::size_t oldest = (distance != 0) ? 1 : 0;
+        memory.swap(m_snapshots[oldest].data);
+        m_snapshots.erase(m_snapshots.begin() + oldest);
+    }
+
+    // Apply the changes to the baseline (the bytes beyond its end are zeros)
+    memory.resize(static_cast<std::size_t>(size));
+    if (distance != 0)
+    {
+        const std::vector<char>& previous = m_snapshots.front().data;
+        std::size_t copied = std::min(previous.size(), memory.size());
+        if (copied > 0)
+            std::memcpy(&memory[0], &previous[0], copied);
+        if (copied < memory.size())
+            std::memset(&memory[copied], 0, memory.size() - copied);
+    }
+    else if (!memory.empty())
+    {
+        std::memset(&memory[0], 0, memory.size());
+    }
+
+    const Uint8* change = m_changes.empty() ? NULL : &m_changes[0];
+    for (std::size_t i = 0; i < blockCount; ++i)
+    {
+        for (Uint8 mask = m_masks[i], j = 0; mask != 0; mask >>= 1, ++j)
+        {
+            if (mask & 1)
+                memory[i * blockSize + j] = static_cast<char>(memory[i * blockSize + j] ^ *change++);
+        }
+    }
+
+    m_snapshots.push_back(Snapshot());
+    m_snapshots.back().sequence = static_cast<Uint32>(sequence);
+    m_snapshots.back().data.swap(memory);
+
+    const std::vector<char>& data = m_snapshots.back().data;
+    snapshot.clear();
+    snapshot.append(data.empty() ? NULL : &data[0], data.size());
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 SnapshotDecoder::getLastSequence() const
+{
+    return m_snapshots.empty() ? 0 : m_snapshots.back().sequence;
+}
+
+
+////////////////////////////////////////////////////////////
+void SnapshotDecoder::reset()
+{
+    m_snapshots.clear();
+}
+
+} // namespace sf
@@ -0,0 +1,160 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/SnapshotEncoder.hpp>
+#include <SFML/Network/Packet.hpp>
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+    // Snapshots are compared by blocks of this size
+    const std::size_t blockSize = 8;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SnapshotEncoder::SnapshotEncoder() :
+m_nextSequence(1),
+m_baseline    (),
+m_pending     (),
+m_changes     ()
+{
+    m_baseline.sequence = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 SnapshotEncoder::encode(const Packet& snapshot, Packet& output)
+{
+    const Uint8* data = static_cast<const Uint8*>(snapshot.getData());
+    std::size_t size = snapshot.getDataSize();
+    const Uint8* baseline = m_baseline.data.empty() ? NULL : reinterpret_cast<const Uint8*>(&m_baseline.data[0]);
+    std::size_t baselineSize = m_baseline.data.size();
+
+    // 0 means "no snapshot", skip it when the sequence wraps around
+    Uint32 sequence = m_nextSequence++;
+    if (m_nextSequence == 0)
+        m_nextSequence = 1;
+
+    // Header: sequence number, distance to the baseline (0 if there is none) and size
+    output.writeVarUint(sequence);
+    output.writeVarUint(m_baseline.sequence != 0 ? sequence - m_baseline.sequence : 0);
+    output.writeVarUint(size);
+
+    // One bit per block telling whether it changed, followed by the mask of its changed bytes;
+    // the bytes beyond the end of the baseline are compared to zeros
+    m_changes.clear();
+    for (std::size_t offset = 0; offset < size; offset += blockSize)
+    {
+        Uint8 current[blockSize] = {0};
+        Uint8 previous[blockSize] = {0};
+        std::size_t count = std::min(blockSize, size - offset);
+        std::memcpy(current, data + offset, count);
+        if (offset < baselineSize)
+            std::memcpy(previous, baseline + offset, std::min(count, baselineSize - offset));
+
+        if (std::memcmp(current, previous, blockSize) == 0)
+        {
+            output.writeBits(0, 1);
+            continue;
+        }
+
+        Uint32 mask = 0;
+        for (std::size_t i = 0; i < blockSize; ++i)
+        {
+            Uint8 change = static_cast<Uint8>(current[i] ^ previous[i]);
+            if (change != 0)
+            {
+                mask |= 1u << i;
+                m_changes.push_back(change);
+            }
+        }
+
+        output.writeBits(1, 1);
+        output.writeBits(mask, blockSize);
+    }
+
+    // Then the changed bytes, XORed with the baseline
+    if (!m_changes.empty())
+        output.writeArray(&m_changes[0], m_changes.size());
+
+    // Keep the snapshot until it is acknowledged, recycling the memory of the oldest one if there are too many
+    std::vector<char> memory;
+    if (m_pending.size() >= MaxPendingSnapshots)
+    {
+        memory.swap(m_pending.front().data);
+        m_pending.pop_front();
+    }
+
+    m_pending.push_back(Snapshot());
+    Snapshot& sent = m_pending.back();
+    sent.sequence = sequence;
+    sent.data.swap(memory);
+    sent.data.assign(reinterpret_cast<const char*>(data), reinterpret_cast<const char*>(data) + size);
+
+    return sequence;
+}
+
+
+////////////////////////////////////////////////////////////
+void SnapshotEncoder::acknowledge(Uint32 sequence)
+{
+    // The pending snapshots are all more recent than the baseline, older ones are ignored
+    for (std::size_t i = 0; i < m_pending.size(); ++i)
+    {
+        if (m_pending[i].sequence == sequence)
+        {
+            m_baseline.sequence = sequence;
+            m_baseline.data.swap(m_pending[i].data);
+            m_pending.erase(m_pending.begin(), m_pending.begin() + i + 1);
+            return;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 SnapshotEncoder::getBaseline() const
+{
+    return m_baseline.sequence;
+}
+
+
+////////////////////////////////////////////////////////////
+void SnapshotEncoder::reset()
+{
+    // The sequence numbers keep increasing, so that a decoder that was not reset is not confused
+    m_baseline.sequence = 0;
+    m_baseline.data.clear();
+    m_pending.clear();
+}
+
+} // namespace sf
@@ -25,20 +25,142 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <SFML/Network/NetworkSimulator.hpp>
+#include <SFML/Network/Packet.hpp>
 #include <SFML/Network/Socket.hpp>
 #include <SFML/Network/SocketImpl.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <algorithm>
+#include <cstring>
+#include <typeinfo>
+
+
+namespace
+{
+    // Define the low-level send/receive flags, which depend on the OS
+    #ifdef SFML_SYSTEM_LINUX
+        const int flags = MSG_NOSIGNAL;
+    #else
+        const int flags = 0;
+    #endif
+
+    // Names of the socket options, for error messages
+    const char* optionNames[sf::Socket::OptionCount] =
+    {
+        "TCP_NODELAY", "SO_KEEPALIVE", "TCP_KEEPIDLE", "TCP_KEEPINTVL", "TCP_KEEPCNT", "SO_SNDBUF",
+        "SO_RCVBUF", "SO_REUSEADDR", "SO_REUSEPORT", "IP_TOS", "SO_BUSY_POLL"
+    };
+
+    // Global traffic counters
+    bool                   statisticsEnabled = false;
+    sf::Mutex              globalMutex;
+    sf::Socket::Statistics globalStatistics;
+
+    // Add the counters of an operation to a set of statistics
+    void addCounters(sf::Socket::Statistics& statistics, const sf::Socket::Statistics& counters)
+    {
+        statistics.bytesSent        += counters.bytesSent;
+        statistics.bytesReceived    += counters.bytesReceived;
+        statistics.packetsSent      += counters.packetsSent;
+        statistics.packetsReceived  += counters.packetsReceived;
+        statistics.partialSends     += counters.partialSends;
+        statistics.notReadySends    += counters.notReadySends;
+        statistics.notReadyReceives += counters.notReadyReceives;
+        statistics.waitTime         += counters.waitTime;
+    }
+
+    // Check whether an option can be used on a given type of socket
+    bool isTcpOnly(sf::Socket::Option option)
+    {
+        return (option == sf::Socket::NoDelay) || (option == sf::Socket::KeepAlive) || (option == sf::Socket::KeepAliveIdle) ||
+               (option == sf::Socket::KeepAliveInterval) || (option == sf::Socket::KeepAliveCount);
+    }
+}
 
 
 namespace sf
 {
+////////////////////////////////////////////////////////////
+Socket::Statistics::Statistics() :
+bytesSent         (0),
+bytesReceived     (0),
+packetsSent       (0),
+packetsReceived   (0),
+partialSends      (0),
+notReadySends     (0),
+notReadyReceives  (0),
+waitTime          (Time::Zero),
+roundTripTime     (Time::Zero),
+roundTripVariation(Time::Zero)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::NetworkConditions::NetworkConditions() :
+latency      (Time::Zero),
+jitter       (Time::Zero),
+lossRate     (0.f),
+duplicateRate(0.f),
+reorderRate  (0.f),
+bandwidth    (0),
+seed         (0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::PendingPacket::PendingPacket() :
+Size        (0),
+SizeReceived(0),
+DataReceived(0),
+Data        ()
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::SendBuffer::SendBuffer() :
+Data     (),
+Offset   (0),
+Packets  (0),
+Threshold(0),
+Delay    (Time::Zero),
+Age      ()
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::ReceiveBuffer::ReceiveBuffer() :
+Data (),
+Begin(0),
+End  (0)
+{
+
+}
+
+
 ////////////////////////////////////////////////////////////
 Socket::Socket(Type type) :
 m_type      (type),
 m_socket    (priv::SocketImpl::invalidSocket()),
-m_isBlocking(true)
+m_isBlocking(true),
+m_isIpv6    (false),
+m_simulator (NULL)
 {
+    for (int i = 0; i < OptionCount; ++i)
+        m_options[i] = -1;
 
+    // Disable the Nagle algorithm (i.e. removes buffering of TCP packets) by default
+    if (m_type == Tcp)
+        m_options[NoDelay] = 1;
 }
 
 
@@ -47,6 +169,8 @@ Socket::~Socket()
 {
     // Close the socket before it gets destructed
     close();
+
+    delete m_simulator;
 }
 
 
@@ -68,6 +192,92 @@ bool Socket::isBlocking() const
 }
 
 
+////////////////////////////////////////////////////////////
+bool Socket::setOption(Option option, int value)
+{
+    if ((m_type != Tcp) && isTcpOnly(option))
+    {
+        err() << "Socket option \"" << optionNames[option] << "\" is only available on TCP sockets" << std::endl;
+        return false;
+    }
+
+    // Remember the option for when the socket is (re)created
+    m_options[option] = value;
+
+    // Apply if the socket is already created
+    if ((m_socket != priv::SocketImpl::invalidSocket()) && !priv::SocketImpl::setOption(m_socket, option, m_isIpv6, value))
+    {
+        err() << "Failed to set socket option \"" << optionNames[option] << "\" to " << value << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+int Socket::getOption(Option option) const
+{
+    if (m_socket == priv::SocketImpl::invalidSocket())
+        return m_options[option];
+
+    int value = -1;
+    if (!priv::SocketImpl::getOption(m_socket, option, m_isIpv6, value))
+        return -1;
+
+    return value;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Statistics Socket::getStatistics() const
+{
+    Statistics statistics = m_statistics;
+
+    if ((m_type == Tcp) && (m_socket != priv::SocketImpl::invalidSocket()))
+        priv::SocketImpl::getRoundTripTime(m_socket, statistics.roundTripTime, statistics.roundTripVariation);
+
+    return statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::resetStatistics()
+{
+    m_statistics = Statistics();
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::setStatisticsEnabled(bool enabled)
+{
+    statisticsEnabled = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Socket::isStatisticsEnabled()
+{
+    return statisticsEnabled;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Statistics Socket::getGlobalStatistics()
+{
+    Lock lock(globalMutex);
+    return globalStatistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::resetGlobalStatistics()
+{
+    Lock lock(globalMutex);
+    globalStatistics = Statistics();
+}
+
+
 ////////////////////////////////////////////////////////////
 SocketHandle Socket::getHandle() const
 {
@@ -77,12 +287,22 @@ SocketHandle Socket::getHandle() const
 
 ////////////////////////////////////////////////////////////
 void Socket::create()
+{
+    create(false);
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::create(bool ipv6)
 {
     // Don't create the socket if it already exists
     if (m_socket == priv::SocketImpl::invalidSocket())
     {
-        SocketHandle handle = socket(PF_INET, m_type == Tcp ? SOCK_STREAM : SOCK_DGRAM, 0);
+        bool isIpv6;
+        SocketHandle handle = priv::SocketImpl::createSocket(ipv6, m_type == Tcp ? SOCK_STREAM : SOCK_DGRAM, isIpv6);
         create(handle);
+
+        m_isIpv6 = isIpv6;
     }
 }
 
@@ -96,21 +316,28 @@ void Socket::create(SocketHandle handle)
         // Assign the new handle
         m_socket = handle;
 
+        // Find its address family (for accepted sockets)
+        sockaddr_storage address;
+        priv::SocketImpl::AddrLength size = sizeof(address);
+        m_isIpv6 = (getsockname(m_socket, reinterpret_cast<sockaddr*>(&address), &size) != -1) && (address.ss_family == AF_INET6);
+
         // Set the current blocking state
         setBlocking(m_isBlocking);
 
-        if (m_type == Tcp)
+        // Apply the options that were set before the socket was created
+        for (int i = 0; i < OptionCount; ++i)
         {
-            // Disable the Nagle algorithm (i.e. removes buffering of TCP packets)
-            int yes = 1;
-            if (setsockopt(m_socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<char*>(&yes), sizeof(yes)) == -1)
+            if ((m_options[i] >= 0) && !priv::SocketImpl::setOption(m_socket, static_cast<Option>(i), m_isIpv6, m_options[i]))
             {
-                err() << "Failed to set socket option \"TCP_NODELAY\" ; "
-                      << "all your TCP packets will be buffered" << std::endl;
+                err() << "Failed to set socket option \"" << optionNames[i] << "\" to " << m_options[i] << std::endl;
             }
+        }
 
+        if (m_type != Udp)
+        {
             // On Mac OS X, disable the SIGPIPE signal on disconnection
             #ifdef SFML_SYSTEM_MACOS
+                int yes = 1;
                 if (setsockopt(m_socket, SOL_SOCKET, SO_NOSIGPIPE, reinterpret_cast<char*>(&yes), sizeof(yes)) == -1)
                 {
                     err() << "Failed to set socket option \"SO_NOSIGPIPE\"" << std::endl;
@@ -130,9 +357,536 @@ void Socket::create(SocketHandle handle)
 }
 
 
+////////////////////////////////////////////////////////////
+bool Socket::isIpv6() const
+{
+    return m_isIpv6;
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::recordSend(std::size_t bytes, std::size_t packets, Status status)
+{
+    if (!statisticsEnabled)
+        return;
+
+    Statistics counters;
+    counters.bytesSent     = bytes;
+    counters.packetsSent   = packets;
+    counters.partialSends  = (status == Partial) ? 1 : 0;
+    counters.notReadySends = (status == NotReady) ? 1 : 0;
+    addCounters(m_statistics, counters);
+
+    Lock lock(globalMutex);
+    addCounters(globalStatistics, counters);
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::recordReceive(std::size_t bytes, std::size_t packets, Status status)
+{
+    if (!statisticsEnabled)
+        return;
+
+    Statistics counters;
+    counters.bytesReceived    = bytes;
+    counters.packetsReceived  = packets;
+    counters.notReadyReceives = (status == NotReady) ? 1 : 0;
+    addCounters(m_statistics, counters);
+
+    Lock lock(globalMutex);
+    addCounters(globalStatistics, counters);
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::recordWait(Time duration)
+{
+    if (!statisticsEnabled)
+        return;
+
+    m_statistics.waitTime += duration;
+    recordSelectorWait(duration);
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::recordSelectorWait(Time duration)
+{
+    if (!statisticsEnabled)
+        return;
+
+    Lock lock(globalMutex);
+    globalStatistics.waitTime += duration;
+}
+
+
+////////////////////////////////////////////////////////////
+void Socket::setNetworkConditions(const NetworkConditions& conditions)
+{
+    bool perfect = (conditions.latency == Time::Zero) && (conditions.jitter == Time::Zero) &&
+                   (conditions.lossRate <= 0.f) && (conditions.duplicateRate <= 0.f) &&
+                   (conditions.reorderRate <= 0.f) && (conditions.bandwidth == 0);
+
+    if (perfect)
+    {
+        delete m_simulator;
+        m_simulator = NULL;
+    }
+    else if (m_simulator)
+    {
+        m_simulator->setConditions(conditions);
+    }
+    else
+    {
+        m_simulator = new priv::NetworkSimulator(conditions);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+priv::NetworkSimulator* Socket::getNetworkSimulator() const
+{
+    return m_simulator;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status Socket::sendStream(const void* data, std::size_t size, std::size_t& sent)
+{
+    // Check the parameters
+    if (!data || (size == 0))
+    {
+        err() << "Cannot send data over the network (no data to send)" << std::endl;
+        return Error;
+    }
+
+    // Let the simulator delay the data if the network conditions are simulated
+    if (getNetworkSimulator())
+    {
+        getNetworkSimulator()->sendStream(getHandle(), data, size, NULL, 0);
+        sent = size;
+        recordSend(sent, 0, Done);
+        return Done;
+    }
+
+    // Loop until every byte has been sent
+    int result = 0;
+    for (sent = 0; sent < size; sent += result)
+    {
+        // Send a chunk of data
+        result = ::send(getHandle(), static_cast<const char*>(data) + sent, size - sent, flags);
+
+        // Check for errors
+        if (result < 0)
+        {
+            Status status = priv::SocketImpl::getErrorStatus();
+
+            if ((status == NotReady) && sent)
+                status = Partial;
+
+            recordSend(sent, 0, status);
+            return status;
+        }
+    }
+
+    recordSend(sent, 0, Done);
+    return Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status Socket::receiveStream(void* data, std::size_t size, std::size_t& received)
+{
+    // First clear the variables to fill
+    received = 0;
+
+    // Check the destination buffer
+    if (!data)
+    {
+        err() << "Cannot receive data from the network (the destination buffer is invalid)" << std::endl;
+        return Error;
+    }
+
+    // Receive a chunk of bytes
+    int sizeReceived = recv(getHandle(), static_cast<char*>(data), static_cast<int>(size), flags);
+
+    // Check the number of bytes received
+    if (sizeReceived > 0)
+    {
+        received = static_cast<std::size_t>(sizeReceived);
+        recordReceive(received, 0, Done);
+        return Done;
+    }
+    else if (sizeReceived == 0)
+    {
+        return Socket::Disconnected;
+    }
+    else
+    {
+        Status status = priv::SocketImpl::getErrorStatus();
+        recordReceive(0, 0, status);
+        return status;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status Socket::sendStreamPacket(Packet& packet)
+{
+    // TCP and local sockets are stream protocols, they don't preserve messages boundaries.
+    // This means that we have to send the packet size first, so that the
+    // receiver knows the actual end of the packet in the data stream.
+
+    // The size and the data are sent together in a single gathering call,
+    // without copying them to a temporary block. Partial sends still have
+    // to be tracked so that the receiving end doesn't get corrupted data.
+
+    // Get the data to send from the packet
+    std::size_t size = 0;
+    const void* data = packet.onSend(size);
+
+    // First convert the packet size to network byte order
+    Uint32 packetSize = htonl(static_cast<Uint32>(size));
+
+    const char* header = reinterpret_cast<const char*>(&packetSize);
+    const char* body = static_cast<const char*>(data);
+    std::size_t total = sizeof(packetSize) + size;
+
+    // Let the simulator delay what is left of the packet if the network conditions are simulated
+    if (getNetworkSimulator())
+    {
+        std::size_t position = packet.m_sendPos;
+        if (position < sizeof(packetSize))
+            getNetworkSimulator()->sendStream(getHandle(), header + position, sizeof(packetSize) - position, body, size);
+        else
+            getNetworkSimulator()->sendStream(getHandle(), body + position - sizeof(packetSize), total - position, NULL, 0);
+
+        packet.m_sendPos = 0;
+        recordSend(total - position, 1, Done);
+        return Done;
+    }
+
+    // Loop until every byte has been sent, resuming from where the previous call stopped
+    std::size_t sent = 0;
+    int result = 0;
+    for (std::size_t position = packet.m_sendPos; position < total; position += result, sent += result)
+    {
+        // Send what is left of the size header, followed by what is left of the data
+        if (position < sizeof(packetSize))
+            result = priv::SocketImpl::sendBuffers(getHandle(), header + position, sizeof(packetSize) - position, body, size, flags);
+        else
+            result = priv::SocketImpl::sendBuffers(getHandle(), body + position - sizeof(packetSize), total - position, NULL, 0, flags);
+
+        // Check for errors
+        if (result < 0)
+        {
+            Status status = priv::SocketImpl::getErrorStatus();
+
+            // In the case of a partial send, record the location to resume from
+            if ((status == NotReady) && sent)
+            {
+                packet.m_sendPos += sent;
+                status = Partial;
+            }
+
+            recordSend(sent, 0, status);
+            return status;
+        }
+    }
+
+    packet.m_sendPos = 0;
+
+    recordSend(sent, 1, Done);
+    return Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status Socket::receiveStreamPacket(Packet& packet, PendingPacket& pending, std::size_t maxPacketSize)
+{
+    // First clear the variables to fill
+    packet.clear();
+
+    // We start by getting the size of the incoming packet
+    Uint32 packetSize = 0;
+    std::size_t received = 0;
+    if (pending.SizeReceived < sizeof(pending.Size))
+    {
+        // Loop until we've received the entire size of the packet
+        // (even a 4 byte variable may be received in more than one call)
+        while (pending.SizeReceived < sizeof(pending.Size))
+        {
+            char* data = reinterpret_cast<char*>(&pending.Size) + pending.SizeReceived;
+            Status status = receiveStream(data, sizeof(pending.Size) - pending.SizeReceived, received);
+            pending.SizeReceived += received;
+
+            if (status != Done)
+                return status;
+        }
+
+        // The packet size has been fully received
+        packetSize = ntohl(pending.Size);
+
+        // Refuse packets bigger than the limit, the stream can't be resynchronized after that
+        if ((maxPacketSize > 0) && (packetSize > maxPacketSize))
+        {
+            err() << "Received packet size (" << packetSize << " bytes) exceeds the maximum packet size ("
+                  << maxPacketSize << " bytes), disconnecting" << std::endl;
+            close();
+            pending = PendingPacket();
+            return Error;
+        }
+    }
+    else
+    {
+        // The packet size has already been received in a previous call
+        packetSize = ntohl(pending.Size);
+    }
+
+    // Loop until we receive all the packet data, directly into the pending buffer
+    while (pending.DataReceived < packetSize)
+    {
+        // Grow the buffer along with the data actually received rather than
+        // to the announced size, so that a peer can't make us allocate much
+        // more memory than it really sends (at most 1 MB ahead of it)
+        if (pending.DataReceived == pending.Data.size())
+        {
+            std::size_t capacity = std::max<std::size_t>(pending.DataReceived * 2, 1024 * 1024);
+            pending.Data.resize(std::min<std::size_t>(packetSize, capacity));
+        }
+
+        // Receive a chunk of data
+        char* begin = &pending.Data[0] + pending.DataReceived;
+        Status status = receiveStream(begin, pending.Data.size() - pending.DataReceived, received);
+        pending.DataReceived += received;
+
+        if (status != Done)
+            return status;
+    }
+
+    // We have received all the packet data: we can give it to the user packet.
+    // Plain packets take the buffer (and give back their own for the next one),
+    // derived packets may transform the data in onReceive and packets built
+    // over external memory must receive it there
+    if (packetSize > 0)
+    {
+        if ((typeid(packet) == typeid(Packet)) && !packet.m_external)
+            packet.m_data.swap(pending.Data);
+        else
+            packet.onReceive(&pending.Data[0], packetSize);
+    }
+
+    // Clear the pending packet data, but keep the buffer to avoid reallocating it
+    pending.Size = 0;
+    pending.SizeReceived = 0;
+    pending.DataReceived = 0;
+    pending.Data.clear();
+
+    recordReceive(0, 1, Done);
+    return Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status Socket::receiveBufferedPacket(Packet& packet, PendingPacket& pending, ReceiveBuffer& buffer, std::size_t capacity, std::size_t maxPacketSize)
+{
+    packet.clear();
+
+    for (;;)
+    {
+        // A packet which didn't fit in the buffer is finished directly
+        if (pending.SizeReceived > 0)
+            return receiveStreamPacket(packet, pending, maxPacketSize);
+
+        // Parse the next packet if the buffer holds it entirely
+        std::size_t available = buffer.End - buffer.Begin;
+        const char* begin = available > 0 ? &buffer.Data[buffer.Begin] : NULL;
+        std::size_t needed = sizeof(Uint32);
+        if (available >= sizeof(Uint32))
+        {
+            Uint32 packetSize = 0;
+            std::memcpy(&packetSize, begin, sizeof(packetSize));
+            packetSize = ntohl(packetSize);
+
+            // Refuse packets bigger than the limit, the stream can't be resynchronized after that
+            if ((maxPacketSize > 0) && (packetSize > maxPacketSize))
+            {
+                err() << "Received packet size (" << packetSize << " bytes) exceeds the maximum packet size ("
+                      << maxPacketSize << " bytes), disconnecting" << std::endl;
+                close();
+                pending = PendingPacket();
+                buffer.Begin = 0;
+                buffer.End = 0;
+                return Error;
+            }
+
+            needed += packetSize;
+            if (available >= needed)
+            {
+                if (packetSize > 0)
+                    packet.onReceive(begin + sizeof(packetSize), packetSize);
+
+                buffer.Begin += needed;
+                if (buffer.Begin == buffer.End)
+                {
+                    buffer.Begin = 0;
+                    buffer.End = 0;
+                }
+
+                recordReceive(0, 1, Done);
+                return Done;
+            }
+        }
+
+        // A packet bigger than the buffer takes what was read of it, and receives the rest directly
+        if (needed > capacity)
+        {
+            std::size_t header = std::min(available, sizeof(pending.Size));
+            if (header > 0)
+                std::memcpy(&pending.Size, begin, header);
+            pending.SizeReceived = header;
+            pending.Data.assign(begin + header, begin + available);
+            pending.DataReceived = available - header;
+            buffer.Begin = 0;
+            buffer.End = 0;
+
+            return receiveStreamPacket(packet, pending, maxPacketSize);
+        }
+
+        // Move the beginning of the incomplete packet to the front, and read as much as possible after it
+        if (buffer.Begin > 0)
+        {
+            std::memmove(&buffer.Data[0], begin, available);
+            buffer.Begin = 0;
+            buffer.End = available;
+        }
+        if (buffer.Data.size() < capacity)
+            buffer.Data.resize(capacity);
+
+        std::size_t received = 0;
+        Status status = receiveStream(&buffer.Data[buffer.End], capacity - buffer.End, received);
+        buffer.End += received;
+
+        if (status != Done)
+            return status;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status Socket::queueStream(SendBuffer& buffer, const void* data, std::size_t size, const void* next, std::size_t nextSize)
+{
+    // Check the parameters
+    if (!data || (size == 0))
+    {
+        err() << "Cannot send data over the network (no data to send)" << std::endl;
+        return Error;
+    }
+
+    // Don't accept more data while what is already waiting fills the buffer,
+    // so that the buffer doesn't grow without limit when the peer is slow
+    if (buffer.Data.size() - buffer.Offset >= buffer.Threshold)
+    {
+        Status status = flushStream(buffer);
+        if (status != Done)
+        {
+            recordSend(0, 0, NotReady);
+            return (status == Partial) ? NotReady : status;
+        }
+    }
+
+    if (buffer.Data.empty())
+        buffer.Age.restart();
+
+    const char* bytes = static_cast<const char*>(data);
+    buffer.Data.insert(buffer.Data.end(), bytes, bytes + size);
+    if (next && (nextSize > 0))
+    {
+        bytes = static_cast<const char*>(next);
+        buffer.Data.insert(buffer.Data.end(), bytes, bytes + nextSize);
+    }
+
+    // Send the buffer when it is full enough or too old; the data is
+    // accepted anyway, what the socket is not ready to take is sent later
+    if ((buffer.Data.size() - buffer.Offset >= buffer.Threshold) ||
+        ((buffer.Delay > Time::Zero) && (buffer.Age.getElapsedTime() >= buffer.Delay)))
+    {
+        Status status = flushStream(buffer);
+        if ((status == Disconnected) || (status == Error))
+            return status;
+    }
+
+    return Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status Socket::queueStreamPacket(SendBuffer& buffer, Packet& packet)
+{
+    // Get the data to send from the packet
+    std::size_t size = 0;
+    const void* data = packet.onSend(size);
+
+    // The packet is queued with its size in network byte order, like sendStreamPacket does;
+    // a packet partially sent before the coalescing was enabled is queued from where it stopped
+    Uint32 packetSize = htonl(static_cast<Uint32>(size));
+    const char* header = reinterpret_cast<const char*>(&packetSize);
+    const char* body = static_cast<const char*>(data);
+    std::size_t position = packet.m_sendPos;
+
+    Status status;
+    if (position < sizeof(packetSize))
+        status = queueStream(buffer, header + position, sizeof(packetSize) - position, body, size);
+    else
+        status = queueStream(buffer, body + position - sizeof(packetSize), size + sizeof(packetSize) - position);
+
+    if (status == Done)
+    {
+        packet.m_sendPos = 0;
+        ++buffer.Packets;
+    }
+
+    return status;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status Socket::flushStream(SendBuffer& buffer)
+{
+    if (buffer.Offset == buffer.Data.size())
+        return Done;
+
+    std::size_t sent = 0;
+    Status status = sendStream(&buffer.Data[buffer.Offset], buffer.Data.size() - buffer.Offset, sent);
+    buffer.Offset += sent;
+
+    if (buffer.Offset == buffer.Data.size())
+    {
+        // Everything was sent, the packets can be counted; the memory is kept for the next ones
+        recordSend(0, buffer.Packets, Done);
+        buffer.Data.clear();
+        buffer.Offset = 0;
+        buffer.Packets = 0;
+    }
+    else if (buffer.Offset >= buffer.Data.size() / 2)
+    {
+        // Drop the part already sent, so that the data doesn't pile up behind it
+        buffer.Data.erase(buffer.Data.begin(), buffer.Data.begin() + buffer.Offset);
+        buffer.Offset = 0;
+    }
+
+    return status;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Socket::close()
 {
+    // The data still queued by the simulator must not be sent to a handle reused by another socket
+    if (m_simulator)
+        m_simulator->clear();
+
     // Close the socket
     if (m_socket != priv::SocketImpl::invalidSocket())
     {
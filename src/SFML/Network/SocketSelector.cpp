@@ -26,11 +26,34 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/SocketSelector.hpp>
+
+#if defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_ANDROID)
+    #include <sys/epoll.h>
+    #define SFML_SELECTOR_EPOLL
+#elif defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS) || defined(SFML_SYSTEM_FREEBSD)
+    #include <sys/types.h>
+    #include <sys/event.h>
+    #include <sys/time.h>
+    #define SFML_SELECTOR_KQUEUE
+#else
+    // Windows' fd_set is an array of handles, its capacity is set before including winsock2.h
+    #ifndef FD_SETSIZE
+        #define FD_SETSIZE 8192
+    #endif
+    #define SFML_SELECTOR_SELECT
+#endif
+
 #include <SFML/Network/Socket.hpp>
 #include <SFML/Network/SocketImpl.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Err.hpp>
 #include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <map>
 #include <utility>
+#include <vector>
 
 #ifdef _MSC_VER
     #pragma warning(disable: 4127) // "conditional expression is constant" generated by the FD_SET macro
@@ -42,118 +65,234 @@ namespace sf
 ////////////////////////////////////////////////////////////
 struct SocketSelector::SocketSelectorImpl
 {
+    SocketSelectorImpl();
+    ~SocketSelectorImpl();
+
+    bool addHandle(SocketHandle handle);
+    void removeHandle(SocketHandle handle);
+    void clearHandles();
+    void waitForEvents(Time timeout);
+    void setReady(SocketHandle handle);
+
+    std::map<SocketHandle, Socket*> sockets;      ///< Sockets observed by the selector, by handle
+    std::vector<Socket*>            ready;        ///< Sockets that were ready after the last wait
+    std::vector<SocketHandle>       readyHandles; ///< Handles of the ready sockets, sorted for isReady
+
+#if defined(SFML_SELECTOR_EPOLL)
+
+    int                      pollHandle; ///< epoll instance
+    std::vector<epoll_event> events;     ///< Events returned by epoll_wait
+
+#elif defined(SFML_SELECTOR_KQUEUE)
+
+    int                         pollHandle; ///< kqueue instance
+    std::vector<struct kevent> events;     ///< Events returned by kevent
+
+#else
+
     fd_set allSockets;   ///< Set containing all the sockets handles
     fd_set socketsReady; ///< Set containing handles of the sockets that are ready
-    int    maxSocket;    ///< Maximum socket handle
-    int    socketCount;  ///< Number of socket handles
+
+#endif
 };
 
 
 ////////////////////////////////////////////////////////////
-SocketSelector::SocketSelector() :
-m_impl(new SocketSelectorImpl)
+void SocketSelector::SocketSelectorImpl::setReady(SocketHandle handle)
 {
-    clear();
+    std::map<SocketHandle, Socket*>::const_iterator it = sockets.find(handle);
+    if (it != sockets.end())
+    {
+        ready.push_back(it->second);
+        readyHandles.push_back(handle);
+    }
 }
 
 
+#if defined(SFML_SELECTOR_EPOLL)
+
 ////////////////////////////////////////////////////////////
-SocketSelector::SocketSelector(const SocketSelector& copy) :
-m_impl(new SocketSelectorImpl(*copy.m_impl))
+SocketSelector::SocketSelectorImpl::SocketSelectorImpl() :
+pollHandle(epoll_create(1))
 {
+    if (pollHandle < 0)
+        err() << "Failed to create the socket selector (epoll_create failed)" << std::endl;
+}
 
+
+////////////////////////////////////////////////////////////
+SocketSelector::SocketSelectorImpl::~SocketSelectorImpl()
+{
+    if (pollHandle >= 0)
+        ::close(pollHandle);
 }
 
 
 ////////////////////////////////////////////////////////////
-SocketSelector::~SocketSelector()
+bool SocketSelector::SocketSelectorImpl::addHandle(SocketHandle handle)
 {
-    delete m_impl;
+    epoll_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = handle;
+
+    // A closed socket leaves epoll by itself, its handle may be reused by a new one
+    if ((epoll_ctl(pollHandle, EPOLL_CTL_ADD, handle, &event) == 0) ||
+        ((errno == EEXIST) && (epoll_ctl(pollHandle, EPOLL_CTL_MOD, handle, &event) == 0)))
+        return true;
+
+    err() << "The socket can't be added to the selector (epoll_ctl failed)" << std::endl;
+    return false;
 }
 
 
 ////////////////////////////////////////////////////////////
-void SocketSelector::add(Socket& socket)
+void SocketSelector::SocketSelectorImpl::removeHandle(SocketHandle handle)
 {
-    SocketHandle handle = socket.getHandle();
-    if (handle != priv::SocketImpl::invalidSocket())
-    {
+    // The socket may already be closed, in which case it left epoll by itself
+    epoll_event event;
+    epoll_ctl(pollHandle, EPOLL_CTL_DEL, handle, &event);
+}
 
-#if defined(SFML_SYSTEM_WINDOWS)
 
-        if (m_impl->socketCount >= FD_SETSIZE)
-        {
-            err() << "The socket can't be added to the selector because the "
-                  << "selector is full. This is a limitation of your operating "
-                  << "system's FD_SETSIZE setting.";
-            return;
-        }
+////////////////////////////////////////////////////////////
+void SocketSelector::SocketSelectorImpl::clearHandles()
+{
+    for (std::map<SocketHandle, Socket*>::const_iterator it = sockets.begin(); it != sockets.end(); ++it)
+        removeHandle(it->first);
+}
 
-        if (FD_ISSET(handle, &m_impl->allSockets))
-            return;
 
-        m_impl->socketCount++;
+////////////////////////////////////////////////////////////
+void SocketSelector::SocketSelectorImpl::waitForEvents(Time timeout)
+{
+    // Round the timeout up, so that a short wait doesn't become a busy poll
+    Int64 milliseconds = (timeout.asMicroseconds() + 999) / 1000;
+    int time = (timeout == Time::Zero) ? -1 : static_cast<int>(std::min<Int64>(std::max<Int64>(milliseconds, 0), INT_MAX));
 
-#else
+    events.resize(std::max<std::size_t>(sockets.size(), 1));
+    int count = epoll_wait(pollHandle, &events[0], static_cast<int>(events.size()), time);
 
-        if (handle >= FD_SETSIZE)
-        {
-            err() << "The socket can't be added to the selector because its "
-                  << "ID is too high. This is a limitation of your operating "
-                  << "system's FD_SETSIZE setting.";
-            return;
-        }
+    // Errors and hang-ups are reported as readable, like select() does
+    for (int i = 0; i < count; ++i)
+        setReady(events[i].data.fd);
+}
 
-        // SocketHandle is an int in POSIX
-        m_impl->maxSocket = std::max(m_impl->maxSocket, handle);
+#elif defined(SFML_SELECTOR_KQUEUE)
 
-#endif
+////////////////////////////////////////////////////////////
+SocketSelector::SocketSelectorImpl::SocketSelectorImpl() :
+pollHandle(kqueue())
+{
+    if (pollHandle < 0)
+        err() << "Failed to create the socket selector (kqueue failed)" << std::endl;
+}
 
-        FD_SET(handle, &m_impl->allSockets);
-    }
+
+////////////////////////////////////////////////////////////
+SocketSelector::SocketSelectorImpl::~SocketSelectorImpl()
+{
+    if (pollHandle >= 0)
+        ::close(pollHandle);
 }
 
 
 ////////////////////////////////////////////////////////////
-void SocketSelector::remove(Socket& socket)
+bool SocketSelector::SocketSelectorImpl::addHandle(SocketHandle handle)
 {
-    SocketHandle handle = socket.getHandle();
-    if (handle != priv::SocketImpl::invalidSocket())
-    {
+    // A closed socket leaves the queue by itself, its handle may be reused by a new
+    // one; adding an existing filter only modifies it
+    struct kevent change;
+    EV_SET(&change, handle, EVFILT_READ, EV_ADD, 0, 0, NULL);
+    if (kevent(pollHandle, &change, 1, NULL, 0, NULL) == 0)
+        return true;
+
+    err() << "The socket can't be added to the selector (kevent failed)" << std::endl;
+    return false;
+}
 
-#if defined(SFML_SYSTEM_WINDOWS)
 
-        if (!FD_ISSET(handle, &m_impl->allSockets))
-            return;
+////////////////////////////////////////////////////////////
+void SocketSelector::SocketSelectorImpl::removeHandle(SocketHandle handle)
+{
+    // The socket may already be closed, in which case it left the queue by itself
+    struct kevent change;
+    EV_SET(&change, handle, EVFILT_READ, EV_DELETE, 0, 0, NULL);
+    kevent(pollHandle, &change, 1, NULL, 0, NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketSelector::SocketSelectorImpl::clearHandles()
+{
+    for (std::map<SocketHandle, Socket*>::const_iterator it = sockets.begin(); it != sockets.end(); ++it)
+        removeHandle(it->first);
+}
 
-        m_impl->socketCount--;
+
+////////////////////////////////////////////////////////////
+void SocketSelector::SocketSelectorImpl::waitForEvents(Time timeout)
+{
+    timespec time;
+    time.tv_sec  = static_cast<time_t>(timeout.asMicroseconds() / 1000000);
+    time.tv_nsec = static_cast<long>(timeout.asMicroseconds() % 1000000) * 1000;
+
+    events.resize(std::max<std::size_t>(sockets.size(), 1));
+    int count = kevent(pollHandle, NULL, 0, &events[0], static_cast<int>(events.size()), timeout != Time::Zero ? &time : NULL);
+
+    // End of file and errors are reported as readable, like select() does
+    for (int i = 0; i < count; ++i)
+        setReady(static_cast<SocketHandle>(events[i].ident));
+}
 
 #else
 
-        if (handle >= FD_SETSIZE)
-            return;
+////////////////////////////////////////////////////////////
+SocketSelector::SocketSelectorImpl::SocketSelectorImpl()
+{
+    FD_ZERO(&allSockets);
+    FD_ZERO(&socketsReady);
+}
 
-#endif
 
-        FD_CLR(handle, &m_impl->allSockets);
-        FD_CLR(handle, &m_impl->socketsReady);
+////////////////////////////////////////////////////////////
+SocketSelector::SocketSelectorImpl::~SocketSelectorImpl()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketSelector::SocketSelectorImpl::addHandle(SocketHandle handle)
+{
+    if (allSockets.fd_count >= FD_SETSIZE)
+    {
+        err() << "The socket can't be added to the selector because the "
+              << "selector is full. This is a limitation of your operating "
+              << "system's FD_SETSIZE setting." << std::endl;
+        return false;
     }
+
+    FD_SET(handle, &allSockets);
+    return true;
 }
 
 
 ////////////////////////////////////////////////////////////
-void SocketSelector::clear()
+void SocketSelector::SocketSelectorImpl::removeHandle(SocketHandle handle)
 {
-    FD_ZERO(&m_impl->allSockets);
-    FD_ZERO(&m_impl->socketsReady);
+    FD_CLR(handle, &allSockets);
+}
+
 
-    m_impl->maxSocket = 0;
-    m_impl->socketCount = 0;
+////////////////////////////////////////////////////////////
+void SocketSelector::SocketSelectorImpl::clearHandles()
+{
+    FD_ZERO(&allSockets);
 }
 
 
 ////////////////////////////////////////////////////////////
-bool SocketSelector::wait(Time timeout)
+void SocketSelector::SocketSelectorImpl::waitForEvents(Time timeout)
 {
     // Setup the timeout
     timeval time;
@@ -161,37 +300,145 @@ bool SocketSelector::wait(Time timeout)
     time.tv_usec = static_cast<long>(timeout.asMicroseconds() % 1000000);
 
     // Initialize the set that will contain the sockets that are ready
-    m_impl->socketsReady = m_impl->allSockets;
+    // (only copy the used part of the array, which can be large)
+    socketsReady.fd_count = allSockets.fd_count;
+    std::memcpy(socketsReady.fd_array, allSockets.fd_array, allSockets.fd_count * sizeof(SOCKET));
 
     // Wait until one of the sockets is ready for reading, or timeout is reached
     // The first parameter is ignored on Windows
-    int count = select(m_impl->maxSocket + 1, &m_impl->socketsReady, NULL, NULL, timeout != Time::Zero ? &time : NULL);
+    int count = select(0, &socketsReady, NULL, NULL, timeout != Time::Zero ? &time : NULL);
 
-    return count > 0;
+    // On return, the set only contains the ready sockets
+    if (count > 0)
+    {
+        for (u_int i = 0; i < socketsReady.fd_count; ++i)
+            setReady(socketsReady.fd_array[i]);
+    }
 }
 
+#endif
+
 
 ////////////////////////////////////////////////////////////
-bool SocketSelector::isReady(Socket& socket) const
+SocketSelector::SocketSelector() :
+m_impl(new SocketSelectorImpl)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SocketSelector::SocketSelector(const SocketSelector& copy) :
+m_impl(new SocketSelectorImpl)
+{
+    // The system objects can't be copied: observe the same sockets with new ones
+    for (std::map<SocketHandle, Socket*>::const_iterator it = copy.m_impl->sockets.begin(); it != copy.m_impl->sockets.end(); ++it)
+    {
+        if (m_impl->addHandle(it->first))
+            m_impl->sockets.insert(*it);
+    }
+
+    m_impl->ready = copy.m_impl->ready;
+    m_impl->readyHandles = copy.m_impl->readyHandles;
+}
+
+
+////////////////////////////////////////////////////////////
+SocketSelector::~SocketSelector()
+{
+    delete m_impl;
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketSelector::add(Socket& socket)
 {
     SocketHandle handle = socket.getHandle();
     if (handle != priv::SocketImpl::invalidSocket())
     {
+        // Register the handle even if it is already known: it may belong to a
+        // socket which was closed without being removed, and then reused
+        if (m_impl->addHandle(handle))
+            m_impl->sockets[handle] = &socket;
+    }
+}
 
-#if !defined(SFML_SYSTEM_WINDOWS)
 
-        if (handle >= FD_SETSIZE)
-            return false;
+////////////////////////////////////////////////////////////
+void SocketSelector::remove(Socket& socket)
+{
+    SocketHandle handle = socket.getHandle();
+    if (handle != priv::SocketImpl::invalidSocket())
+    {
+        std::map<SocketHandle, Socket*>::iterator it = m_impl->sockets.find(handle);
+        if (it == m_impl->sockets.end())
+            return;
 
-#endif
+        m_impl->removeHandle(handle);
+        m_impl->sockets.erase(it);
 
-        return FD_ISSET(handle, &m_impl->socketsReady) != 0;
+        // Also forget it in the ready list, so that it is not returned by getReadySocket
+        std::vector<SocketHandle>::iterator readyHandle = std::lower_bound(m_impl->readyHandles.begin(), m_impl->readyHandles.end(), handle);
+        if ((readyHandle != m_impl->readyHandles.end()) && (*readyHandle == handle))
+        {
+            m_impl->readyHandles.erase(readyHandle);
+            m_impl->ready.erase(std::find(m_impl->ready.begin(), m_impl->ready.end(), &socket));
+        }
     }
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketSelector::clear()
+{
+    m_impl->clearHandles();
+    m_impl->sockets.clear();
+    m_impl->ready.clear();
+    m_impl->readyHandles.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketSelector::wait(Time timeout)
+{
+    m_impl->ready.clear();
+    m_impl->readyHandles.clear();
+
+    // Wait until one of the sockets is ready for reading, or timeout is reached
+    Clock clock;
+    m_impl->waitForEvents(timeout);
+    Socket::recordSelectorWait(clock.getElapsedTime());
+
+    std::sort(m_impl->readyHandles.begin(), m_impl->readyHandles.end());
+
+    return !m_impl->ready.empty();
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketSelector::isReady(Socket& socket) const
+{
+    SocketHandle handle = socket.getHandle();
+    if (handle != priv::SocketImpl::invalidSocket())
+        return std::binary_search(m_impl->readyHandles.begin(), m_impl->readyHandles.end(), handle);
 
     return false;
 }
 
 
+////////////////////////////////////////////////////////////
+std::size_t SocketSelector::getReadyCount() const
+{
+    return m_impl->ready.size();
+}
+
+
+////////////////////////////////////////////////////////////
+Socket& SocketSelector::getReadySocket(std::size_t index) const
+{
+    return *m_impl->ready[index];
+}
+
+
 ////////////////////////////////////////////////////////////
 SocketSelector& SocketSelector::operator =(const SocketSelector& right)
 {
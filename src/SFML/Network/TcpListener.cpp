@@ -47,11 +47,11 @@ unsigned short TcpListener::getLocalPort() const
     if (getHandle() != priv::SocketImpl::invalidSocket())
     {
         // Retrieve informations about the local end of the socket
-        sockaddr_in address;
+        sockaddr_storage address;
         priv::SocketImpl::AddrLength size = sizeof(address);
         if (getsockname(getHandle(), reinterpret_cast<sockaddr*>(&address), &size) != -1)
         {
-            return ntohs(address.sin_port);
+            return priv::SocketImpl::getPort(address);
         }
     }
 
@@ -63,20 +63,21 @@ unsigned short TcpListener::getLocalPort() const
 ////////////////////////////////////////////////////////////
 Socket::Status TcpListener::listen(unsigned short port)
 {
-    // Create the internal socket if it doesn't exist
-    create();
+    // Create the internal socket if it doesn't exist, dual-stack to accept both IPv4 and IPv6 clients
+    create(true);
 
     // Bind the socket to the specified port
-    sockaddr_in address = priv::SocketImpl::createAddress(INADDR_ANY, port);
-    if (bind(getHandle(), reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1)
+    sockaddr_storage address;
+    priv::SocketImpl::AddrLength length = priv::SocketImpl::createAnyAddress(port, isIpv6(), address);
+    if (bind(getHandle(), reinterpret_cast<sockaddr*>(&address), length) == -1)
     {
         // Not likely to happen, but...
         err() << "Failed to bind listener socket to port " << port << std::endl;
         return Error;
     }
 
-    // Listen to the bound port
-    if (::listen(getHandle(), 0) == -1)
+    // Listen to the bound port, with the largest queue of pending connections the system allows
+    if (::listen(getHandle(), SOMAXCONN) == -1)
     {
         // Oops, socket is deaf
         err() << "Failed to listen to port " << port << std::endl;
@@ -106,7 +107,7 @@ Socket::Status TcpListener::accept(TcpSocket& socket)
     }
 
     // Accept a new connection
-    sockaddr_in address;
+    sockaddr_storage address;
     priv::SocketImpl::AddrLength length = sizeof(address);
     SocketHandle remote = ::accept(getHandle(), reinterpret_cast<sockaddr*>(&address), &length);
 
@@ -0,0 +1,435 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Network/TcpServer.hpp>
+#include <SFML/Network/SocketSelector.hpp>
+#include <SFML/Network/TcpSocket.hpp>
+#include <SFML/Network/UdpSocket.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Thread.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Maximum time a thread waits before checking whether it must stop
+    const sf::Time pollTimeout = sf::milliseconds(100);
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+class TcpServer::Worker : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    Worker(TcpServer& owner) :
+    m_owner (owner),
+    m_thread(&Worker::run, this),
+    m_count (0)
+    {
+    }
+
+    ////////////////////////////////////////////////////////////
+    ~Worker()
+    {
+        for (std::vector<TcpSocket*>::iterator it = m_pending.begin(); it != m_pending.end(); ++it)
+            delete *it;
+    }
+
+    ////////////////////////////////////////////////////////////
+    Socket::Status open(bool listen, unsigned short port)
+    {
+        // The acceptor wakes the worker up with a datagram when it gives it a connection
+        Socket::Status status = m_wakeUp.bind(Socket::AnyPort);
+        if (status != Socket::Done)
+            return status;
+        m_wakeUp.setBlocking(false);
+        m_selector.add(m_wakeUp);
+
+        if (listen)
+        {
+            if (!m_listener.setOption(Socket::ReusePort, 1))
+            {
+                err() << "Failed to start TCP server, sharing a port between listeners is not supported by the system" << std::endl;
+                return Socket::Error;
+            }
+
+            status = m_listener.listen(port);
+            if (status != Socket::Done)
+                return status;
+
+            m_listener.setBlocking(false);
+            m_selector.add(m_listener);
+        }
+
+        return Socket::Done;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void launch()
+    {
+        m_thread.launch();
+    }
+
+    ////////////////////////////////////////////////////////////
+    void wait()
+    {
+        m_thread.wait();
+    }
+
+    ////////////////////////////////////////////////////////////
+    void add(TcpSocket* client, UdpSocket& sender)
+    {
+        {
+            Lock lock(m_mutex);
+            m_pending.push_back(client);
+            ++m_count;
+        }
+
+        wakeUp(sender);
+    }
+
+    ////////////////////////////////////////////////////////////
+    void wakeUp(UdpSocket& sender)
+    {
+        char signal = 0;
+        sender.send(&signal, sizeof(signal), IpAddress::LocalHost, m_wakeUp.getLocalPort());
+    }
+
+    ////////////////////////////////////////////////////////////
+    unsigned short getLocalPort() const
+    {
+        return m_listener.getLocalPort();
+    }
+
+    ////////////////////////////////////////////////////////////
+    std::size_t getConnectionCount() const
+    {
+        Lock lock(m_mutex);
+        return m_count;
+    }
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    void run()
+    {
+        Handler&                handler = *m_owner.m_handler;
+        std::vector<TcpSocket*> added;
+        std::vector<TcpSocket*> closed;
+
+        while (!m_owner.isStopping())
+        {
+            m_selector.wait(pollTimeout);
+
+            // Take the connections given by the acceptor
+            {
+                Lock lock(m_mutex);
+                added.swap(m_pending);
+            }
+
+            // Handle the ready sockets; the selector is only modified after, since
+            // adding or removing sockets would invalidate the ready sockets
+            for (std::size_t i = 0; i < m_selector.getReadyCount(); ++i)
+            {
+                Socket& socket = m_selector.getReadySocket(i);
+                if (&socket == &m_wakeUp)
+                {
+                    char           signal[16];
+                    std::size_t    received;
+                    IpAddress      sender;
+                    unsigned short port;
+                    while (m_wakeUp.receive(signal, sizeof(signal), received, sender, port) == Socket::Done)
+                        ;
+                }
+                else if (&socket == &m_listener)
+                {
+                    TcpSocket* client = new TcpSocket;
+                    while (m_listener.accept(*client) == Socket::Done)
+                    {
+                        added.push_back(client);
+                        client = new TcpSocket;
+
+                        Lock lock(m_mutex);
+                        ++m_count;
+                    }
+                    delete client;
+                }
+                else
+                {
+                    TcpSocket& client = static_cast<TcpSocket&>(socket);
+                    if (!handler.onReceive(client))
+                        closed.push_back(&client);
+                }
+            }
+
+            for (std::vector<TcpSocket*>::iterator it = closed.begin(); it != closed.end(); ++it)
+                close(*it);
+            closed.clear();
+
+            for (std::vector<TcpSocket*>::iterator it = added.begin(); it != added.end(); ++it)
+            {
+                TcpSocket* client = *it;
+                client->setBlocking(false);
+                m_clients.push_back(client);
+                m_selector.add(*client);
+                handler.onConnect(*client);
+            }
+            added.clear();
+        }
+
+        // Close the remaining connections
+        m_listener.close();
+        while (!m_clients.empty())
+            close(m_clients.back());
+    }
+
+    ////////////////////////////////////////////////////////////
+    void close(TcpSocket* client)
+    {
+        m_selector.remove(*client);
+        m_owner.m_handler->onDisconnect(*client);
+        client->disconnect();
+        m_clients.erase(std::find(m_clients.begin(), m_clients.end(), client));
+        delete client;
+
+        Lock lock(m_mutex);
+        --m_count;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    TcpServer&              m_owner;    ///< Server owning the worker
+    Thread                  m_thread;   ///< Thread running the event loop
+    SocketSelector          m_selector; ///< Selector waiting for the sockets of the worker
+    TcpListener             m_listener; ///< Listener of the SharedPort mode
+    UdpSocket               m_wakeUp;   ///< Socket receiving the wake-up signals of the acceptor
+    std::vector<TcpSocket*> m_clients;  ///< Connections served by the worker
+    std::vector<TcpSocket*> m_pending;  ///< Connections given by the acceptor and not served yet
+    std::size_t             m_count;    ///< Number of connections, including the pending ones
+    mutable Mutex           m_mutex;    ///< Mutex protecting the pending connections and the count
+};
+
+
+////////////////////////////////////////////////////////////
+TcpServer::Handler::~Handler()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void TcpServer::Handler::onConnect(TcpSocket&)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void TcpServer::Handler::onDisconnect(TcpSocket&)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TcpServer::TcpServer() :
+m_acceptor(NULL),
+m_handler (NULL),
+m_port    (0),
+m_running (false),
+m_stopping(false)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+TcpServer::~TcpServer()
+{
+    stop();
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status TcpServer::start(unsigned short port, Handler& handler, unsigned int workerCount, AcceptMode mode)
+{
+    stop();
+
+    if (workerCount == 0)
+    {
+        err() << "Failed to start TCP server, it needs at least one worker thread" << std::endl;
+        return Socket::Error;
+    }
+
+    m_handler  = &handler;
+    m_stopping = false;
+
+    // Listen to the port
+    if (mode == SingleAcceptor)
+    {
+        Socket::Status status = m_listener.listen(port);
+        if (status != Socket::Done)
+            return status;
+
+        m_listener.setBlocking(false);
+        port = m_listener.getLocalPort();
+    }
+
+    // Create the workers; with a shared port, the first listener picks the port if needed
+    for (unsigned int i = 0; i < workerCount; ++i)
+    {
+        Worker* worker = new Worker(*this);
+        m_workers.push_back(worker);
+
+        Socket::Status status = worker->open(mode == SharedPort, port);
+        if (status != Socket::Done)
+        {
+            for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+                delete *it;
+            m_workers.clear();
+            m_listener.close();
+            return status;
+        }
+
+        if (mode == SharedPort)
+            port = worker->getLocalPort();
+    }
+
+    // Start the threads
+    m_port    = port;
+    m_running = true;
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+        (*it)->launch();
+
+    if (mode == SingleAcceptor)
+    {
+        m_acceptor = new Thread(&TcpServer::runAcceptor, this);
+        m_acceptor->launch();
+    }
+
+    return Socket::Done;
+}
+
+
+////////////////////////////////////////////////////////////
+void TcpServer::stop()
+{
+    if (!m_running)
+        return;
+
+    {
+        Lock lock(m_mutex);
+        m_stopping = true;
+    }
+
+    // Wake the workers up so that they don't wait for their timeout
+    UdpSocket sender;
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+        (*it)->wakeUp(sender);
+
+    if (m_acceptor)
+    {
+        m_acceptor->wait();
+        delete m_acceptor;
+        m_acceptor = NULL;
+    }
+
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+    {
+        (*it)->wait();
+        delete *it;
+    }
+    m_workers.clear();
+
+    m_listener.close();
+    m_port    = 0;
+    m_running = false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TcpServer::isRunning() const
+{
+    return m_running;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned short TcpServer::getLocalPort() const
+{
+    return m_port;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TcpServer::getConnectionCount() const
+{
+    std::size_t count = 0;
+    for (std::vector<Worker*>::const_iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+        count += (*it)->getConnectionCount();
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+void TcpServer::runAcceptor()
+{
+    SocketSelector selector;
+    selector.add(m_listener);
+
+    UdpSocket   sender;
+    std::size_t next = 0;
+    while (!isStopping())
+    {
+        if (!selector.wait(pollTimeout))
+            continue;
+
+        // Give the new connections to the workers in turn
+        TcpSocket* client = new TcpSocket;
+        while (m_listener.accept(*client) == Socket::Done)
+        {
+            m_workers[next]->add(client, sender);
+            next = (next + 1) % m_workers.size();
+            client = new TcpSocket;
+        }
+        delete client;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool TcpServer::isStopping() const
+{
+    Lock lock(m_mutex);
+    return m_stopping;
+}
+
+} // namespace sf
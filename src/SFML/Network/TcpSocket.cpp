@@ -27,9 +27,10 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/TcpSocket.hpp>
 #include <SFML/Network/IpAddress.hpp>
-#include <SFML/Network/Packet.hpp>
 #include <SFML/Network/SocketImpl.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Log.hpp>
 #include <algorithm>
 #include <cstring>
 
@@ -38,21 +39,13 @@
 #endif
 
 
-namespace
-{
-    // Define the low-level send/receive flags, which depend on the OS
-    #ifdef SFML_SYSTEM_LINUX
-        const int flags = MSG_NOSIGNAL;
-    #else
-        const int flags = 0;
-    #endif
-}
-
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 TcpSocket::TcpSocket() :
-Socket(Tcp)
+Socket         (Tcp),
+m_maxPacketSize(0),
+m_receiveSize  (0)
 {
 
 }
@@ -64,11 +57,11 @@ unsigned short TcpSocket::getLocalPort() const
     if (getHandle() != priv::SocketImpl::invalidSocket())
     {
         // Retrieve informations about the local end of the socket
-        sockaddr_in address;
+        sockaddr_storage address;
         priv::SocketImpl::AddrLength size = sizeof(address);
         if (getsockname(getHandle(), reinterpret_cast<sockaddr*>(&address), &size) != -1)
         {
-            return ntohs(address.sin_port);
+            return priv::SocketImpl::getPort(address);
         }
     }
 
@@ -83,11 +76,11 @@ IpAddress TcpSocket::getRemoteAddress() const
     if (getHandle() != priv::SocketImpl::invalidSocket())
     {
         // Retrieve informations about the remote end of the socket
-        sockaddr_in address;
+        sockaddr_storage address;
         priv::SocketImpl::AddrLength size = sizeof(address);
         if (getpeername(getHandle(), reinterpret_cast<sockaddr*>(&address), &size) != -1)
         {
-            return IpAddress(ntohl(address.sin_addr.s_addr));
+            return priv::SocketImpl::getAddress(address);
         }
     }
 
@@ -102,11 +95,11 @@ unsigned short TcpSocket::getRemotePort() const
     if (getHandle() != priv::SocketImpl::invalidSocket())
     {
         // Retrieve informations about the remote end of the socket
-        sockaddr_in address;
+        sockaddr_storage address;
         priv::SocketImpl::AddrLength size = sizeof(address);
         if (getpeername(getHandle(), reinterpret_cast<sockaddr*>(&address), &size) != -1)
         {
-            return ntohs(address.sin_port);
+            return priv::SocketImpl::getPort(address);
         }
     }
 
@@ -118,18 +111,28 @@ unsigned short TcpSocket::getRemotePort() const
 ////////////////////////////////////////////////////////////
 Socket::Status TcpSocket::connect(const IpAddress& remoteAddress, unsigned short remotePort, Time timeout)
 {
+    // An IPv4 socket can't reach an IPv6 address
+    if (remoteAddress.isIpv6() && !isIpv6())
+        close();
+
     // Create the internal socket if it doesn't exist
-    create();
+    create(remoteAddress.isIpv6());
 
     // Create the remote address
-    sockaddr_in address = priv::SocketImpl::createAddress(remoteAddress.toInteger(), remotePort);
+    sockaddr_storage address;
+    priv::SocketImpl::AddrLength length = priv::SocketImpl::createAddress(remoteAddress, remotePort, isIpv6(), address);
+    if (length == 0)
+    {
+        err() << "Failed to connect to " << remoteAddress << ", IPv6 is not supported by the system" << std::endl;
+        return Error;
+    }
 
     if (timeout <= Time::Zero)
     {
         // ----- We're not using a timeout: just try to connect -----
 
         // Connect the socket
-        if (::connect(getHandle(), reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1)
+        if (::connect(getHandle(), reinterpret_cast<sockaddr*>(&address), length) == -1)
             return priv::SocketImpl::getErrorStatus();
 
         // Connection succeeded
@@ -147,7 +150,7 @@ Socket::Status TcpSocket::connect(const IpAddress& remoteAddress, unsigned short
             setBlocking(false);
 
         // Try to connect to the remote address
-        if (::connect(getHandle(), reinterpret_cast<sockaddr*>(&address), sizeof(address)) >= 0)
+        if (::connect(getHandle(), reinterpret_cast<sockaddr*>(&address), length) >= 0)
         {
             // We got instantly connected! (it may no happen a lot...)
             setBlocking(blocking);
@@ -175,7 +178,10 @@ Socket::Status TcpSocket::connect(const IpAddress& remoteAddress, unsigned short
             time.tv_usec = static_cast<long>(timeout.asMicroseconds() % 1000000);
 
             // Wait for something to write on our socket (which means that the connection request has returned)
-            if (select(static_cast<int>(getHandle() + 1), NULL, &selector, NULL, &time) > 0)
+            Clock clock;
+            int ready = select(static_cast<int>(getHandle() + 1), NULL, &selector, NULL, &time);
+            recordWait(clock.getElapsedTime());
+            if (ready > 0)
             {
                 // At this point the connection may have been either accepted or refused.
                 // To know whether it's a success or a failure, we must check the address of the connected peer
@@ -205,6 +211,147 @@ Socket::Status TcpSocket::connect(const IpAddress& remoteAddress, unsigned short
 }
 
 
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::connect(const std::vector<IpAddress>& remoteAddresses, unsigned short remotePort, Time timeout)
+{
+    // A single address doesn't need racing
+    if (remoteAddresses.empty())
+        return Error;
+    else if (remoteAddresses.size() == 1)
+        return connect(remoteAddresses[0], remotePort, timeout);
+
+    // Delay between two connection attempts, recommended by RFC 8305
+    const Time attemptDelay = milliseconds(250);
+
+    Clock clock;
+    std::vector<SocketHandle> attempts;
+    std::size_t next = 0;
+    Time nextStart = Time::Zero;
+    SocketHandle winner = priv::SocketImpl::invalidSocket();
+    Status status = Error;
+
+    while (winner == priv::SocketImpl::invalidSocket())
+    {
+        Time now = clock.getElapsedTime();
+
+        // Start the next attempt when its turn has come, or right away if all the previous ones failed
+        if ((next < remoteAddresses.size()) && ((now >= nextStart) || attempts.empty()))
+        {
+            const IpAddress& remoteAddress = remoteAddresses[next++];
+            nextStart = now + attemptDelay;
+
+            bool ipv6;
+            SocketHandle handle = priv::SocketImpl::createSocket(remoteAddress.isIpv6(), SOCK_STREAM, ipv6);
+            if (handle == priv::SocketImpl::invalidSocket())
+                continue;
+
+            sockaddr_storage address;
+            priv::SocketImpl::AddrLength length = priv::SocketImpl::createAddress(remoteAddress, remotePort, ipv6, address);
+            if (length == 0)
+            {
+                priv::SocketImpl::close(handle);
+                continue;
+            }
+
+            priv::SocketImpl::setBlocking(handle, false);
+            if (::connect(handle, reinterpret_cast<sockaddr*>(&address), length) >= 0)
+            {
+                // We got instantly connected
+                winner = handle;
+                break;
+            }
+
+            status = priv::SocketImpl::getErrorStatus();
+            if (status == NotReady)
+                attempts.push_back(handle);
+            else
+                priv::SocketImpl::close(handle);
+
+            continue;
+        }
+
+        // All the attempts failed
+        if (attempts.empty())
+            break;
+
+        // Failed to connect before timeout is over
+        if ((timeout > Time::Zero) && (now >= timeout))
+        {
+            status = NotReady;
+            break;
+        }
+
+        // Wait until an attempt completes, the next one has to start or the timeout is over
+        fd_set writable;
+        fd_set failed;
+        FD_ZERO(&writable);
+        FD_ZERO(&failed);
+        SocketHandle maximum = 0;
+        for (std::vector<SocketHandle>::const_iterator it = attempts.begin(); it != attempts.end(); ++it)
+        {
+            FD_SET(*it, &writable);
+            FD_SET(*it, &failed);
+            maximum = std::max(maximum, *it);
+        }
+
+        Time wait = (next < remoteAddresses.size()) ? nextStart - now : Time::Zero;
+        if ((timeout > Time::Zero) && ((wait == Time::Zero) || (timeout - now < wait)))
+            wait = timeout - now;
+
+        timeval time;
+        time.tv_sec  = static_cast<long>(wait.asMicroseconds() / 1000000);
+        time.tv_usec = static_cast<long>(wait.asMicroseconds() % 1000000);
+
+        Clock waitClock;
+        int ready = select(static_cast<int>(maximum + 1), NULL, &writable, &failed, wait > Time::Zero ? &time : NULL);
+        recordWait(waitClock.getElapsedTime());
+        if (ready <= 0)
+            continue;
+
+        // Check the attempts that have completed
+        for (std::size_t i = 0; i < attempts.size();)
+        {
+            if (!FD_ISSET(attempts[i], &writable) && !FD_ISSET(attempts[i], &failed))
+            {
+                ++i;
+                continue;
+            }
+
+            Status result = priv::SocketImpl::getConnectionStatus(attempts[i]);
+            if (result == Done)
+            {
+                winner = attempts[i];
+                attempts.erase(attempts.begin() + i);
+                break;
+            }
+            else if (result != NotReady)
+            {
+                status = result;
+                priv::SocketImpl::close(attempts[i]);
+                attempts.erase(attempts.begin() + i);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    }
+
+    // Cancel the other attempts
+    for (std::vector<SocketHandle>::const_iterator it = attempts.begin(); it != attempts.end(); ++it)
+        priv::SocketImpl::close(*it);
+
+    if (winner == priv::SocketImpl::invalidSocket())
+        return status;
+
+    // Use the winning connection
+    disconnect();
+    create(winner);
+
+    return Done;
+}
+
+
 ////////////////////////////////////////////////////////////
 void TcpSocket::disconnect()
 {
@@ -213,14 +360,23 @@ void TcpSocket::disconnect()
 
     // Reset the pending packet data
     m_pendingPacket = PendingPacket();
+
+    // Drop the queued data, but keep the coalescing settings
+    m_sendBuffer.Data.clear();
+    m_sendBuffer.Offset = 0;
+    m_sendBuffer.Packets = 0;
+
+    // Drop the data read ahead
+    m_receiveBuffer.Begin = 0;
+    m_receiveBuffer.End = 0;
 }
 
 
 ////////////////////////////////////////////////////////////
 Socket::Status TcpSocket::send(const void* data, std::size_t size)
 {
-    if (!isBlocking())
-        err() << "Warning: Partial sends might not be handled properly." << std::endl;
+    if (!isBlocking() && !m_sendBuffer.Threshold)
+        SFML_LOG(Log::Warning, "sfml", "Warning: Partial sends might not be handled properly.");
 
     std::size_t sent;
 
@@ -231,183 +387,107 @@ Socket::Status TcpSocket::send(const void* data, std::size_t size)
 ////////////////////////////////////////////////////////////
 Socket::Status TcpSocket::send(const void* data, std::size_t size, std::size_t& sent)
 {
-    // Check the parameters
-    if (!data || (size == 0))
-    {
-        err() << "Cannot send data over the network (no data to send)" << std::endl;
-        return Error;
-    }
-
-    // Loop until every byte has been sent
-    int result = 0;
-    for (sent = 0; sent < size; sent += result)
+    if (m_sendBuffer.Threshold)
     {
-        // Send a chunk of data
-        result = ::send(getHandle(), static_cast<const char*>(data) + sent, size - sent, flags);
-
-        // Check for errors
-        if (result < 0)
-        {
-            Status status = priv::SocketImpl::getErrorStatus();
-
-            if ((status == NotReady) && sent)
-                return Partial;
-
-            return status;
-        }
+        Status status = queueStream(m_sendBuffer, data, size);
+        sent = (status == Done) ? size : 0;
+        return status;
     }
 
-    return Done;
+    return sendStream(data, size, sent);
 }
 
 
 ////////////////////////////////////////////////////////////
 Socket::Status TcpSocket::receive(void* data, std::size_t size, std::size_t& received)
 {
-    // First clear the variables to fill
-    received = 0;
-
-    // Check the destination buffer
-    if (!data)
+    // Return the data read ahead first, to keep the order of the stream
+    if ((m_receiveBuffer.End > m_receiveBuffer.Begin) && data)
     {
-        err() << "Cannot receive data from the network (the destination buffer is invalid)" << std::endl;
-        return Error;
-    }
-
-    // Receive a chunk of bytes
-    int sizeReceived = recv(getHandle(), static_cast<char*>(data), static_cast<int>(size), flags);
+        received = std::min(size, m_receiveBuffer.End - m_receiveBuffer.Begin);
+        std::memcpy(data, &m_receiveBuffer.Data[m_receiveBuffer.Begin], received);
+        m_receiveBuffer.Begin += received;
+        if (m_receiveBuffer.Begin == m_receiveBuffer.End)
+        {
+            m_receiveBuffer.Begin = 0;
+            m_receiveBuffer.End = 0;
+        }
 
-    // Check the number of bytes received
-    if (sizeReceived > 0)
-    {
-        received = static_cast<std::size_t>(sizeReceived);
         return Done;
     }
-    else if (sizeReceived == 0)
-    {
-        return Socket::Disconnected;
-    }
-    else
-    {
-        return priv::SocketImpl::getErrorStatus();
-    }
+
+    return receiveStream(data, size, received);
 }
 
 
 ////////////////////////////////////////////////////////////
 Socket::Status TcpSocket::send(Packet& packet)
 {
-    // TCP is a stream protocol, it doesn't preserve messages boundaries.
-    // This means that we have to send the packet size first, so that the
-    // receiver knows the actual end of the packet in the data stream.
+    if (m_sendBuffer.Threshold)
+        return queueStreamPacket(m_sendBuffer, packet);
 
-    // We allocate an extra memory block so that the size can be sent
-    // together with the data in a single call. This may seem inefficient,
-    // but it is actually required to avoid partial send, which could cause
-    // data corruption on the receiving end.
-
-    // Get the data to send from the packet
-    std::size_t size = 0;
-    const void* data = packet.onSend(size);
+    return sendStreamPacket(packet);
+}
 
-    // First convert the packet size to network byte order
-    Uint32 packetSize = htonl(static_cast<Uint32>(size));
 
-    // Allocate memory for the data block to send
-    std::vector<char> blockToSend(sizeof(packetSize) + size);
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::receive(Packet& packet)
+{
+    if (m_receiveSize || (m_receiveBuffer.End > m_receiveBuffer.Begin))
+        return receiveBufferedPacket(packet, m_pendingPacket, m_receiveBuffer, m_receiveSize, m_maxPacketSize);
 
-    // Copy the packet size and data into the block to send
-    std::memcpy(&blockToSend[0], &packetSize, sizeof(packetSize));
-    if (size > 0)
-        std::memcpy(&blockToSend[0] + sizeof(packetSize), data, size);
+    return receiveStreamPacket(packet, m_pendingPacket, m_maxPacketSize);
+}
 
-    // Send the data block
-    std::size_t sent;
-    Status status = send(&blockToSend[0] + packet.m_sendPos, blockToSend.size() - packet.m_sendPos, sent);
 
-    // In the case of a partial send, record the location to resume from
-    if (status == Partial)
-    {
-        packet.m_sendPos += sent;
-    }
-    else if (status == Done)
-    {
-        packet.m_sendPos = 0;
-    }
-
-    return status;
+////////////////////////////////////////////////////////////
+void TcpSocket::setMaxPacketSize(std::size_t size)
+{
+    m_maxPacketSize = size;
 }
 
 
 ////////////////////////////////////////////////////////////
-Socket::Status TcpSocket::receive(Packet& packet)
+std::size_t TcpSocket::getMaxPacketSize() const
 {
-    // First clear the variables to fill
-    packet.clear();
+    return m_maxPacketSize;
+}
 
-    // We start by getting the size of the incoming packet
-    Uint32 packetSize = 0;
-    std::size_t received = 0;
-    if (m_pendingPacket.SizeReceived < sizeof(m_pendingPacket.Size))
-    {
-        // Loop until we've received the entire size of the packet
-        // (even a 4 byte variable may be received in more than one call)
-        while (m_pendingPacket.SizeReceived < sizeof(m_pendingPacket.Size))
-        {
-            char* data = reinterpret_cast<char*>(&m_pendingPacket.Size) + m_pendingPacket.SizeReceived;
-            Status status = receive(data, sizeof(m_pendingPacket.Size) - m_pendingPacket.SizeReceived, received);
-            m_pendingPacket.SizeReceived += received;
 
-            if (status != Done)
-                return status;
-        }
+////////////////////////////////////////////////////////////
+void TcpSocket::setSendCoalescing(std::size_t threshold, Time delay)
+{
+    m_sendBuffer.Threshold = threshold;
+    m_sendBuffer.Delay = delay;
 
-        // The packet size has been fully received
-        packetSize = ntohl(m_pendingPacket.Size);
-    }
-    else
-    {
-        // The packet size has already been received in a previous call
-        packetSize = ntohl(m_pendingPacket.Size);
-    }
+    // Without coalescing, the queued data would wait forever
+    if (!threshold)
+        flush();
+}
 
-    // Loop until we receive all the packet data
-    char buffer[1024];
-    while (m_pendingPacket.Data.size() < packetSize)
-    {
-        // Receive a chunk of data
-        std::size_t sizeToGet = std::min(static_cast<std::size_t>(packetSize - m_pendingPacket.Data.size()), sizeof(buffer));
-        Status status = receive(buffer, sizeToGet, received);
-        if (status != Done)
-            return status;
 
-        // Append it into the packet
-        if (received > 0)
-        {
-            m_pendingPacket.Data.resize(m_pendingPacket.Data.size() + received);
-            char* begin = &m_pendingPacket.Data[0] + m_pendingPacket.Data.size() - received;
-            std::memcpy(begin, buffer, received);
-        }
-    }
+////////////////////////////////////////////////////////////
+Socket::Status TcpSocket::flush()
+{
+    return flushStream(m_sendBuffer);
+}
 
-    // We have received all the packet data: we can copy it to the user packet
-    if (!m_pendingPacket.Data.empty())
-        packet.onReceive(&m_pendingPacket.Data[0], m_pendingPacket.Data.size());
 
-    // Clear the pending packet data
-    m_pendingPacket = PendingPacket();
+////////////////////////////////////////////////////////////
+void TcpSocket::setReceiveBuffering(std::size_t size)
+{
+    m_receiveSize = size;
 
-    return Done;
+    // Release the memory when it is not used anymore
+    if (!size && (m_receiveBuffer.End == m_receiveBuffer.Begin))
+        m_receiveBuffer = ReceiveBuffer();
 }
 
 
 ////////////////////////////////////////////////////////////
-TcpSocket::PendingPacket::PendingPacket() :
-Size        (0),
-SizeReceived(0),
-Data        ()
+std::size_t TcpSocket::getReceiveBuffering() const
 {
-
+    return m_receiveSize;
 }
 
 } // namespace sf
@@ -27,18 +27,36 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/UdpSocket.hpp>
 #include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/NetworkSimulator.hpp>
 #include <SFML/Network/Packet.hpp>
 #include <SFML/Network/SocketImpl.hpp>
 #include <SFML/System/Err.hpp>
 #include <algorithm>
+#include <cstring>
+#include <typeinfo>
 
+#if defined(SFML_SYSTEM_LINUX)
+    #include <sys/socket.h>
+    #define SFML_UDP_MMSG
+#endif
+
+
+namespace
+{
+#ifdef SFML_UDP_MMSG
+
+    // Number of datagrams passed to each sendmmsg/recvmmsg call
+    const std::size_t batchSize = 64;
+
+#endif
+}
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 UdpSocket::UdpSocket() :
 Socket  (Udp),
-m_buffer(MaxDatagramSize)
+m_buffer()
 {
 
 }
@@ -50,11 +68,11 @@ unsigned short UdpSocket::getLocalPort() const
     if (getHandle() != priv::SocketImpl::invalidSocket())
     {
         // Retrieve informations about the local end of the socket
-        sockaddr_in address;
+        sockaddr_storage address;
         priv::SocketImpl::AddrLength size = sizeof(address);
         if (getsockname(getHandle(), reinterpret_cast<sockaddr*>(&address), &size) != -1)
         {
-            return ntohs(address.sin_port);
+            return priv::SocketImpl::getPort(address);
         }
     }
 
@@ -66,12 +84,13 @@ unsigned short UdpSocket::getLocalPort() const
 ////////////////////////////////////////////////////////////
 Socket::Status UdpSocket::bind(unsigned short port)
 {
-    // Create the internal socket if it doesn't exist
-    create();
+    // Create the internal socket if it doesn't exist, dual-stack to communicate with both IPv4 and IPv6 peers
+    create(true);
 
     // Bind the socket
-    sockaddr_in address = priv::SocketImpl::createAddress(INADDR_ANY, port);
-    if (::bind(getHandle(), reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1)
+    sockaddr_storage address;
+    priv::SocketImpl::AddrLength length = priv::SocketImpl::createAnyAddress(port, isIpv6(), address);
+    if (::bind(getHandle(), reinterpret_cast<sockaddr*>(&address), length) == -1)
     {
         err() << "Failed to bind socket to port " << port << std::endl;
         return Error;
@@ -93,7 +112,7 @@ void UdpSocket::unbind()
 Socket::Status UdpSocket::send(const void* data, std::size_t size, const IpAddress& remoteAddress, unsigned short remotePort)
 {
     // Create the internal socket if it doesn't exist
-    create();
+    create(true);
 
     // Make sure that all the data will fit in one datagram
     if (size > MaxDatagramSize)
@@ -104,15 +123,34 @@ Socket::Status UdpSocket::send(const void* data, std::size_t size, const IpAddre
     }
 
     // Build the target address
-    sockaddr_in address = priv::SocketImpl::createAddress(remoteAddress.toInteger(), remotePort);
+    sockaddr_storage address;
+    priv::SocketImpl::AddrLength length = priv::SocketImpl::createAddress(remoteAddress, remotePort, isIpv6(), address);
+    if (length == 0)
+    {
+        err() << "Cannot send data to " << remoteAddress << ", IPv6 is not supported by the system" << std::endl;
+        return Error;
+    }
+
+    // Let the simulator delay or drop the datagram if the network conditions are simulated
+    if (getNetworkSimulator())
+    {
+        getNetworkSimulator()->sendDatagram(getHandle(), address, length, data, size);
+        recordSend(size, 1, Done);
+        return Done;
+    }
 
     // Send the data (unlike TCP, all the data is always sent in one call)
-    int sent = sendto(getHandle(), static_cast<const char*>(data), static_cast<int>(size), 0, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    int sent = sendto(getHandle(), static_cast<const char*>(data), static_cast<int>(size), 0, reinterpret_cast<sockaddr*>(&address), length);
 
     // Check for errors
     if (sent < 0)
-        return priv::SocketImpl::getErrorStatus();
+    {
+        Status status = priv::SocketImpl::getErrorStatus();
+        recordSend(0, 0, status);
+        return status;
+    }
 
+    recordSend(size, 1, Done);
     return Done;
 }
 
@@ -133,7 +171,8 @@ Socket::Status UdpSocket::receive(void* data, std::size_t size, std::size_t& rec
     }
 
     // Data that will be filled with the other computer's address
-    sockaddr_in address = priv::SocketImpl::createAddress(INADDR_ANY, 0);
+    sockaddr_storage address;
+    std::memset(&address, 0, sizeof(address));
 
     // Receive a chunk of bytes
     priv::SocketImpl::AddrLength addressSize = sizeof(address);
@@ -141,12 +180,17 @@ Socket::Status UdpSocket::receive(void* data, std::size_t size, std::size_t& rec
 
     // Check for errors
     if (sizeReceived < 0)
-        return priv::SocketImpl::getErrorStatus();
+    {
+        Status status = priv::SocketImpl::getErrorStatus();
+        recordReceive(0, 0, status);
+        return status;
+    }
 
     // Fill the sender informations
     received      = static_cast<std::size_t>(sizeReceived);
-    remoteAddress = IpAddress(ntohl(address.sin_addr.s_addr));
-    remotePort    = ntohs(address.sin_port);
+    recordReceive(received, 1, Done);
+    remoteAddress = priv::SocketImpl::getAddress(address);
+    remotePort    = priv::SocketImpl::getPort(address);
 
     return Done;
 }
@@ -177,8 +221,22 @@ Socket::Status UdpSocket::receive(Packet& packet, IpAddress& remoteAddress, unsi
 {
     // See the detailed comment in send(Packet) above.
 
-    // Receive the datagram
+    // Plain packets built over memory that can hold any datagram receive it there directly
     std::size_t received = 0;
+    if ((typeid(packet) == typeid(Packet)) && packet.m_external && (packet.m_externalCapacity >= MaxDatagramSize))
+    {
+        packet.clear();
+        Status status = receive(packet.m_external, packet.m_externalCapacity, received, remoteAddress, remotePort);
+        if (status == Done)
+            packet.m_externalSize = received;
+
+        return status;
+    }
+
+    // Otherwise receive the datagram in the buffer of the socket, allocated on first use
+    if (m_buffer.empty())
+        m_buffer.resize(MaxDatagramSize);
+
     Status status = receive(&m_buffer[0], m_buffer.size(), received, remoteAddress, remotePort);
 
     // If we received valid data, we can copy it to the user packet
@@ -190,4 +248,211 @@ Socket::Status UdpSocket::receive(Packet& packet, IpAddress& remoteAddress, unsi
 }
 
 
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::sendBatch(const Datagram* datagrams, std::size_t count, std::size_t& sent)
+{
+    sent = 0;
+
+    // Create the internal socket if it doesn't exist
+    create(true);
+
+    // Make sure that all the datagrams are valid before sending any of them
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (datagrams[i].size > MaxDatagramSize)
+        {
+            err() << "Cannot send data over the network "
+                  << "(the number of bytes to send is greater than sf::UdpSocket::MaxDatagramSize)" << std::endl;
+            return Error;
+        }
+
+        if (datagrams[i].address.isIpv6() && !isIpv6())
+        {
+            err() << "Cannot send data to " << datagrams[i].address << ", IPv6 is not supported by the system" << std::endl;
+            return Error;
+        }
+    }
+
+    // The simulator queues the datagrams one by one
+    if (getNetworkSimulator())
+    {
+        for (; sent < count; ++sent)
+            send(datagrams[sent].data, datagrams[sent].size, datagrams[sent].address, datagrams[sent].port);
+
+        return Done;
+    }
+
+#ifdef SFML_UDP_MMSG
+
+    sockaddr_storage addresses[batchSize];
+    iovec            buffers[batchSize];
+    mmsghdr          messages[batchSize];
+
+    while (sent < count)
+    {
+        // Describe the next batch of datagrams
+        unsigned int length = static_cast<unsigned int>(std::min(count - sent, batchSize));
+        for (unsigned int i = 0; i < length; ++i)
+        {
+            const Datagram& datagram = datagrams[sent + i];
+
+            buffers[i].iov_base = datagram.data;
+            buffers[i].iov_len  = datagram.size;
+
+            std::memset(&messages[i], 0, sizeof(messages[i]));
+            messages[i].msg_hdr.msg_name    = &addresses[i];
+            messages[i].msg_hdr.msg_namelen = priv::SocketImpl::createAddress(datagram.address, datagram.port, isIpv6(), addresses[i]);
+            messages[i].msg_hdr.msg_iov     = &buffers[i];
+            messages[i].msg_hdr.msg_iovlen  = 1;
+        }
+
+        // Send them
+        int result = sendmmsg(getHandle(), messages, length, 0);
+
+        // Check for errors
+        if (result < 0)
+        {
+            Status status = priv::SocketImpl::getErrorStatus();
+            if ((status == NotReady) && sent)
+                status = Partial;
+
+            recordSend(0, 0, status);
+            return status;
+        }
+
+        std::size_t bytes = 0;
+        for (int i = 0; i < result; ++i)
+            bytes += datagrams[sent + i].size;
+        recordSend(bytes, static_cast<std::size_t>(result), Done);
+
+        sent += static_cast<std::size_t>(result);
+    }
+
+#else
+
+    for (; sent < count; ++sent)
+    {
+        const Datagram& datagram = datagrams[sent];
+
+        Status status = send(datagram.data, datagram.size, datagram.address, datagram.port);
+        if (status != Done)
+            return ((status == NotReady) && sent) ? Partial : status;
+    }
+
+#endif
+
+    return Done;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status UdpSocket::receiveBatch(Datagram* datagrams, std::size_t count, std::size_t& received)
+{
+    received = 0;
+
+    // Check the destination buffers
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        datagrams[i].received = 0;
+        datagrams[i].address  = IpAddress();
+        datagrams[i].port     = 0;
+
+        if (!datagrams[i].data)
+        {
+            err() << "Cannot receive data from the network (the destination buffer is invalid)" << std::endl;
+            return Error;
+        }
+    }
+
+#ifdef SFML_UDP_MMSG
+
+    sockaddr_storage addresses[batchSize];
+    iovec            buffers[batchSize];
+    mmsghdr          messages[batchSize];
+
+    while (received < count)
+    {
+        // Describe the next batch of buffers
+        unsigned int length = static_cast<unsigned int>(std::min(count - received, batchSize));
+        for (unsigned int i = 0; i < length; ++i)
+        {
+            Datagram& datagram = datagrams[received + i];
+
+            std::memset(&addresses[i], 0, sizeof(addresses[i]));
+            buffers[i].iov_base = datagram.data;
+            buffers[i].iov_len  = datagram.size;
+
+            std::memset(&messages[i], 0, sizeof(messages[i]));
+            messages[i].msg_hdr.msg_name    = &addresses[i];
+            messages[i].msg_hdr.msg_namelen = sizeof(addresses[i]);
+            messages[i].msg_hdr.msg_iov     = &buffers[i];
+            messages[i].msg_hdr.msg_iovlen  = 1;
+        }
+
+        // Only the first batch may block, and only until one datagram is there
+        int flags = (received == 0) ? MSG_WAITFORONE : MSG_DONTWAIT;
+        int result = recvmmsg(getHandle(), messages, length, flags, NULL);
+
+        // Check for errors
+        if (result < 0)
+        {
+            Status status = priv::SocketImpl::getErrorStatus();
+            if (received > 0)
+                return Done;
+
+            recordReceive(0, 0, status);
+            return status;
+        }
+
+        // Fill the sender informations
+        std::size_t bytes = 0;
+        for (int i = 0; i < result; ++i)
+        {
+            Datagram& datagram = datagrams[received + i];
+
+            datagram.received = messages[i].msg_len;
+            datagram.address  = priv::SocketImpl::getAddress(addresses[i]);
+            datagram.port     = priv::SocketImpl::getPort(addresses[i]);
+            bytes += datagram.received;
+        }
+        recordReceive(bytes, static_cast<std::size_t>(result), Done);
+
+        received += static_cast<std::size_t>(result);
+
+        // A short batch means that there's nothing more waiting
+        if (static_cast<unsigned int>(result) < length)
+            break;
+    }
+
+#else
+
+    // A blocking socket would wait for each datagram, so it only receives the first one
+    std::size_t maxCount = isBlocking() ? std::min<std::size_t>(count, 1) : count;
+
+    for (; received < maxCount; ++received)
+    {
+        Datagram& datagram = datagrams[received];
+
+        Status status = receive(datagram.data, datagram.size, datagram.received, datagram.address, datagram.port);
+        if (status != Done)
+            return (received > 0) ? Done : status;
+    }
+
+#endif
+
+    return ((received > 0) || (count == 0)) ? Done : NotReady;
+}
+
+
+////////////////////////////////////////////////////////////
+UdpSocket::Datagram::Datagram() :
+data    (NULL),
+size    (0),
+received(0),
+address (),
+port    (0)
+{
+
+}
+
 } // namespace sf
@@ -28,7 +28,65 @@
 #include <SFML/Network/Unix/SocketImpl.hpp>
 #include <errno.h>
 #include <fcntl.h>
+#include <poll.h>
+#include <algorithm>
+#include <cstddef>
 #include <cstring>
+#if defined(SFML_SYSTEM_LINUX)
+    #include <sys/sendfile.h>
+    #include <pthread.h>
+    #include <signal.h>
+#endif
+#if defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_FREEBSD)
+    #include <sys/stat.h>
+#endif
+
+
+namespace
+{
+    // Find the level and name of a socket option, returns false if it isn't supported
+    bool getOptionName(sf::Socket::Option option, bool ipv6, int& level, int& name)
+    {
+        switch (option)
+        {
+            case sf::Socket::NoDelay:           level = IPPROTO_TCP; name = TCP_NODELAY;  return true;
+            case sf::Socket::KeepAlive:         level = SOL_SOCKET;  name = SO_KEEPALIVE; return true;
+        #if defined(TCP_KEEPIDLE)
+            case sf::Socket::KeepAliveIdle:     level = IPPROTO_TCP; name = TCP_KEEPIDLE; return true;
+        #elif defined(TCP_KEEPALIVE)
+            case sf::Socket::KeepAliveIdle:     level = IPPROTO_TCP; name = TCP_KEEPALIVE; return true;
+        #endif
+        #if defined(TCP_KEEPINTVL)
+            case sf::Socket::KeepAliveInterval: level = IPPROTO_TCP; name = TCP_KEEPINTVL; return true;
+        #endif
+        #if defined(TCP_KEEPCNT)
+            case sf::Socket::KeepAliveCount:    level = IPPROTO_TCP; name = TCP_KEEPCNT;  return true;
+        #endif
+            case sf::Socket::SendBufferSize:    level = SOL_SOCKET;  name = SO_SNDBUF;    return true;
+            case sf::Socket::ReceiveBufferSize: level = SOL_SOCKET;  name = SO_RCVBUF;    return true;
+            case sf::Socket::ReuseAddress:      level = SOL_SOCKET;  name = SO_REUSEADDR; return true;
+        #if defined(SO_REUSEPORT)
+            case sf::Socket::ReusePort:         level = SOL_SOCKET;  name = SO_REUSEPORT; return true;
+        #endif
+            case sf::Socket::TypeOfService:
+                if (ipv6)
+                {
+                    level = IPPROTO_IPV6;
+                    name  = IPV6_TCLASS;
+                }
+                else
+                {
+                    level = IPPROTO_IP;
+                    name  = IP_TOS;
+                }
+                return true;
+        #if defined(SO_BUSY_POLL)
+            case sf::Socket::BusyPoll:          level = SOL_SOCKET;  name = SO_BUSY_POLL; return true;
+        #endif
+            default:                            return false;
+        }
+    }
+}
 
 
 namespace sf
@@ -52,6 +110,156 @@ sockaddr_in SocketImpl::createAddress(Uint32 address, unsigned short port)
 }
 
 
+////////////////////////////////////////////////////////////
+SocketImpl::AddrLength SocketImpl::createAddress(const IpAddress& address, unsigned short port, bool ipv6, sockaddr_storage& result)
+{
+    std::memset(&result, 0, sizeof(result));
+
+    if (ipv6)
+    {
+        Uint8 bytes[16];
+        address.toIpv6Bytes(bytes);
+
+        sockaddr_in6& address6 = reinterpret_cast<sockaddr_in6&>(result);
+        address6.sin6_family = AF_INET6;
+        address6.sin6_port   = htons(port);
+        std::memcpy(&address6.sin6_addr, bytes, sizeof(bytes));
+
+#if defined(SFML_SYSTEM_MACOS)
+        address6.sin6_len = sizeof(address6);
+#endif
+
+        return sizeof(address6);
+    }
+    else
+    {
+        // IPv6 addresses can't be reached from an IPv4 socket
+        if (address.isIpv6())
+            return 0;
+
+        sockaddr_in& address4 = reinterpret_cast<sockaddr_in&>(result);
+        address4 = createAddress(address.toInteger(), port);
+
+        return sizeof(address4);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+SocketImpl::AddrLength SocketImpl::createAnyAddress(unsigned short port, bool ipv6, sockaddr_storage& result)
+{
+    if (ipv6)
+    {
+        // The IPv6 wildcard address (::) is all zeros
+        Uint8 bytes[16] = {0};
+        return createAddress(IpAddress(bytes), port, true, result);
+    }
+
+    std::memset(&result, 0, sizeof(result));
+    reinterpret_cast<sockaddr_in&>(result) = createAddress(INADDR_ANY, port);
+
+    return sizeof(sockaddr_in);
+}
+
+
+////////////////////////////////////////////////////////////
+IpAddress SocketImpl::getAddress(const sockaddr_storage& address)
+{
+    if (address.ss_family == AF_INET6)
+    {
+        Uint8 bytes[16];
+        std::memcpy(bytes, &reinterpret_cast<const sockaddr_in6&>(address).sin6_addr, sizeof(bytes));
+        return IpAddress(bytes);
+    }
+
+    return IpAddress(ntohl(reinterpret_cast<const sockaddr_in&>(address).sin_addr.s_addr));
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned short SocketImpl::getPort(const sockaddr_storage& address)
+{
+    if (address.ss_family == AF_INET6)
+        return ntohs(reinterpret_cast<const sockaddr_in6&>(address).sin6_port);
+
+    return ntohs(reinterpret_cast<const sockaddr_in&>(address).sin_port);
+}
+
+
+////////////////////////////////////////////////////////////
+SocketImpl::AddrLength SocketImpl::createLocalAddress(const std::string& path, sockaddr_storage& result)
+{
+    std::memset(&result, 0, sizeof(result));
+
+    sockaddr_un& address = reinterpret_cast<sockaddr_un&>(result);
+    if (path.empty() || (path.size() >= sizeof(address.sun_path)))
+        return 0;
+
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size());
+
+#if defined(SFML_SYSTEM_LINUX)
+    // Abstract addresses start with a null character, and their length is exactly the one of their name
+    if (path[0] == '@')
+    {
+        address.sun_path[0] = '\0';
+        return static_cast<AddrLength>(offsetof(sockaddr_un, sun_path) + path.size());
+    }
+#endif
+
+#if defined(SFML_SYSTEM_MACOS)
+    address.sun_len = sizeof(address);
+#endif
+
+    return sizeof(address);
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketImpl::removeLocalAddress(const std::string& path)
+{
+#if defined(SFML_SYSTEM_LINUX)
+    if (!path.empty() && (path[0] == '@'))
+        return;
+#endif
+
+    unlink(path.c_str());
+}
+
+
+////////////////////////////////////////////////////////////
+SocketHandle SocketImpl::createSocket(bool ipv6, int type, bool& isIpv6)
+{
+    if (ipv6)
+    {
+        SocketHandle handle = socket(PF_INET6, type, 0);
+        if (handle != invalidSocket())
+        {
+            // Accept IPv4 traffic too (through IPv4-mapped addresses)
+            int no = 0;
+            if (setsockopt(handle, IPPROTO_IPV6, IPV6_V6ONLY, reinterpret_cast<char*>(&no), sizeof(no)) == 0)
+            {
+                isIpv6 = true;
+                return handle;
+            }
+
+            close(handle);
+        }
+    }
+
+    // IPv4 requested, or IPv6 not available
+    isIpv6 = false;
+    return socket(PF_INET, type, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+SocketHandle SocketImpl::createLocalSocket()
+{
+    return socket(PF_UNIX, SOCK_STREAM, 0);
+}
+
+
 ////////////////////////////////////////////////////////////
 SocketHandle SocketImpl::invalidSocket()
 {
@@ -77,6 +285,225 @@ void SocketImpl::setBlocking(SocketHandle sock, bool block)
 }
 
 
+////////////////////////////////////////////////////////////
+bool SocketImpl::setOption(SocketHandle sock, Socket::Option option, bool ipv6, int value)
+{
+    int level = 0;
+    int name  = 0;
+    if (!getOptionName(option, ipv6, level, name))
+        return false;
+
+    // The IPv4 TOS byte also applies to the IPv4 traffic of dual-stack sockets
+    if ((option == Socket::TypeOfService) && ipv6)
+        setsockopt(sock, IPPROTO_IP, IP_TOS, reinterpret_cast<char*>(&value), sizeof(value));
+
+    return setsockopt(sock, level, name, reinterpret_cast<char*>(&value), sizeof(value)) != -1;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketImpl::getOption(SocketHandle sock, Socket::Option option, bool ipv6, int& value)
+{
+    int level = 0;
+    int name  = 0;
+    if (!getOptionName(option, ipv6, level, name))
+        return false;
+
+    socklen_t size = sizeof(value);
+    value = 0;
+    return getsockopt(sock, level, name, reinterpret_cast<char*>(&value), &size) != -1;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketImpl::getRoundTripTime(SocketHandle sock, Time& rtt, Time& variation)
+{
+#if defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_ANDROID) || defined(SFML_SYSTEM_FREEBSD)
+
+    // Times are in microseconds
+    tcp_info info;
+    socklen_t size = sizeof(info);
+    if (getsockopt(sock, IPPROTO_TCP, TCP_INFO, &info, &size) == -1)
+        return false;
+
+    rtt       = microseconds(info.tcpi_rtt);
+    variation = microseconds(info.tcpi_rttvar);
+    return true;
+
+#elif defined(SFML_SYSTEM_MACOS) && defined(TCP_CONNECTION_INFO)
+
+    // Times are in milliseconds
+    tcp_connection_info info;
+    socklen_t size = sizeof(info);
+    if (getsockopt(sock, IPPROTO_TCP, TCP_CONNECTION_INFO, &info, &size) == -1)
+        return false;
+
+    rtt       = milliseconds(info.tcpi_srtt);
+    variation = milliseconds(info.tcpi_rttvar);
+    return true;
+
+#else
+
+    (void)sock;
+    (void)rtt;
+    (void)variation;
+    return false;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+int SocketImpl::sendBuffers(SocketHandle sock, const void* first, std::size_t firstSize, const void* second, std::size_t secondSize, int flags)
+{
+    iovec buffers[2];
+    buffers[0].iov_base = const_cast<void*>(first);
+    buffers[0].iov_len  = firstSize;
+    buffers[1].iov_base = const_cast<void*>(second);
+    buffers[1].iov_len  = secondSize;
+
+    // sendmsg rather than writev, so that flags such as MSG_NOSIGNAL apply
+    msghdr message;
+    std::memset(&message, 0, sizeof(message));
+    message.msg_iov    = buffers;
+    message.msg_iovlen = (secondSize > 0) ? 2 : 1;
+
+    return static_cast<int>(sendmsg(sock, &message, flags));
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketImpl::sendFile(SocketHandle sock, std::FILE* file, bool& fallback)
+{
+    fallback = false;
+
+#if defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_FREEBSD)
+
+    int fd = fileno(file);
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+        fallback = true;
+        return false;
+    }
+
+    off_t size = info.st_size;
+    off_t sent = 0;
+
+    #if defined(SFML_SYSTEM_LINUX)
+
+        // sendfile can't take MSG_NOSIGNAL: block SIGPIPE during the transfer instead
+        sigset_t pipe, previous;
+        sigemptyset(&pipe);
+        sigaddset(&pipe, SIGPIPE);
+        pthread_sigmask(SIG_BLOCK, &pipe, &previous);
+
+        bool success = true;
+        int error = 0;
+        while (sent < size)
+        {
+            off_t offset = sent;
+            ssize_t count = ::sendfile(sock, fd, &offset, static_cast<std::size_t>(std::min<off_t>(size - sent, 1 << 30)));
+            if (count < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+
+                // Files that don't support it (and old kernels) fail before sending anything
+                error = errno;
+                fallback = (sent == 0) && ((error == EINVAL) || (error == ENOSYS));
+                success = false;
+                break;
+            }
+            else if (count == 0)
+            {
+                // The file was truncated in the meantime
+                success = false;
+                break;
+            }
+
+            sent += count;
+        }
+
+        // Discard the SIGPIPE raised by a closed connection, if any, before restoring the signal mask
+        if ((error == EPIPE) && !sigismember(&previous, SIGPIPE))
+        {
+            timespec zero = {0, 0};
+            sigtimedwait(&pipe, NULL, &zero);
+        }
+        pthread_sigmask(SIG_SETMASK, &previous, NULL);
+
+        return success;
+
+    #else
+
+        while (sent < size)
+        {
+            #if defined(SFML_SYSTEM_MACOS)
+                off_t count = size - sent;
+                int result = ::sendfile(fd, sock, sent, &count, NULL, 0);
+            #else
+                off_t count = 0;
+                int result = ::sendfile(fd, sock, sent, static_cast<std::size_t>(size - sent), NULL, &count, 0);
+            #endif
+
+            sent += count;
+            if ((result != 0) && (errno != EINTR))
+            {
+                fallback = (sent == 0) && ((errno == ENOTSOCK) || (errno == EOPNOTSUPP) || (errno == EINVAL));
+                return false;
+            }
+            else if ((result == 0) && (count == 0))
+            {
+                // The file was truncated in the meantime
+                return false;
+            }
+        }
+
+        return true;
+
+    #endif
+
+#else
+
+    // Not supported by the system
+    fallback = true;
+    return false;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status SocketImpl::getConnectionStatus(SocketHandle sock)
+{
+    // The socket becomes writable when the connection is either established or failed
+    pollfd descriptor;
+    descriptor.fd      = sock;
+    descriptor.events  = POLLOUT;
+    descriptor.revents = 0;
+
+    int result = poll(&descriptor, 1, 0);
+    if (result == 0)
+        return Socket::NotReady;
+    if (result < 0)
+        return getErrorStatus();
+
+    // Find out which of the two
+    int error = 0;
+    socklen_t length = sizeof(error);
+    if (getsockopt(sock, SOL_SOCKET, SO_ERROR, &error, &length) == -1)
+        return getErrorStatus();
+
+    if (error == 0)
+        return Socket::Done;
+
+    errno = error;
+    return getErrorStatus();
+}
+
+
+
 ////////////////////////////////////////////////////////////
 Socket::Status SocketImpl::getErrorStatus()
 {
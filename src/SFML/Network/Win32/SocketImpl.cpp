@@ -26,8 +26,74 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Network/Win32/SocketImpl.hpp>
+#include <mswsock.h>
+#include <mstcpip.h>
+#include <io.h>
+#include <algorithm>
 #include <cstring>
 
+// Not defined by older SDKs; dual-stack sockets require Windows Vista or later anyway
+#ifndef IPV6_V6ONLY
+    #define IPV6_V6ONLY 27
+#endif
+
+// Unix domain sockets are supported since Windows 10 version 1803, but afunix.h is not shipped by all the toolchains
+#ifndef AF_UNIX
+    #define AF_UNIX 1
+#endif
+
+
+namespace
+{
+    // Address of a Unix domain socket, as defined by afunix.h
+    struct LocalAddress
+    {
+        ADDRESS_FAMILY family;
+        char           path[108];
+    };
+
+    // Find the level and name of a socket option, returns false if it isn't supported
+    bool getOptionName(sf::Socket::Option option, bool ipv6, int& level, int& name)
+    {
+        switch (option)
+        {
+            case sf::Socket::NoDelay:           level = IPPROTO_TCP; name = TCP_NODELAY;   return true;
+            case sf::Socket::KeepAlive:         level = SOL_SOCKET;  name = SO_KEEPALIVE;  return true;
+        // The keep-alive parameters are socket options since Windows 10 version 1709
+        #if defined(TCP_KEEPIDLE)
+            case sf::Socket::KeepAliveIdle:     level = IPPROTO_TCP; name = TCP_KEEPIDLE;  return true;
+        #endif
+        #if defined(TCP_KEEPINTVL)
+            case sf::Socket::KeepAliveInterval: level = IPPROTO_TCP; name = TCP_KEEPINTVL; return true;
+        #endif
+        #if defined(TCP_KEEPCNT)
+            case sf::Socket::KeepAliveCount:    level = IPPROTO_TCP; name = TCP_KEEPCNT;   return true;
+        #endif
+            case sf::Socket::SendBufferSize:    level = SOL_SOCKET;  name = SO_SNDBUF;     return true;
+            case sf::Socket::ReceiveBufferSize: level = SOL_SOCKET;  name = SO_RCVBUF;     return true;
+            case sf::Socket::ReuseAddress:      level = SOL_SOCKET;  name = SO_REUSEADDR;  return true;
+        #if defined(IPV6_TCLASS)
+            case sf::Socket::TypeOfService:
+                if (ipv6)
+                {
+                    level = IPPROTO_IPV6;
+                    name  = IPV6_TCLASS;
+                }
+                else
+                {
+                    level = IPPROTO_IP;
+                    name  = IP_TOS;
+                }
+                return true;
+        #else
+            case sf::Socket::TypeOfService:     level = IPPROTO_IP;  name = IP_TOS;        return !ipv6;
+        #endif
+            // Windows has no equivalent of SO_REUSEPORT (SO_REUSEADDR doesn't load-balance) and of SO_BUSY_POLL
+            default:                            return false;
+        }
+    }
+}
+
 
 namespace sf
 {
@@ -46,6 +112,134 @@ sockaddr_in SocketImpl::createAddress(Uint32 address, unsigned short port)
 }
 
 
+////////////////////////////////////////////////////////////
+SocketImpl::AddrLength SocketImpl::createAddress(const IpAddress& address, unsigned short port, bool ipv6, sockaddr_storage& result)
+{
+    std::memset(&result, 0, sizeof(result));
+
+    if (ipv6)
+    {
+        Uint8 bytes[16];
+        address.toIpv6Bytes(bytes);
+
+        sockaddr_in6& address6 = reinterpret_cast<sockaddr_in6&>(result);
+        address6.sin6_family = AF_INET6;
+        address6.sin6_port   = htons(port);
+        std::memcpy(&address6.sin6_addr, bytes, sizeof(bytes));
+
+        return sizeof(address6);
+    }
+    else
+    {
+        // IPv6 addresses can't be reached from an IPv4 socket
+        if (address.isIpv6())
+            return 0;
+
+        sockaddr_in& address4 = reinterpret_cast<sockaddr_in&>(result);
+        address4 = createAddress(address.toInteger(), port);
+
+        return sizeof(address4);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+SocketImpl::AddrLength SocketImpl::createAnyAddress(unsigned short port, bool ipv6, sockaddr_storage& result)
+{
+    if (ipv6)
+    {
+        // The IPv6 wildcard address (::) is all zeros
+        Uint8 bytes[16] = {0};
+        return createAddress(IpAddress(bytes), port, true, result);
+    }
+
+    std::memset(&result, 0, sizeof(result));
+    reinterpret_cast<sockaddr_in&>(result) = createAddress(INADDR_ANY, port);
+
+    return sizeof(sockaddr_in);
+}
+
+
+////////////////////////////////////////////////////////////
+IpAddress SocketImpl::getAddress(const sockaddr_storage& address)
+{
+    if (address.ss_family == AF_INET6)
+    {
+        Uint8 bytes[16];
+        std::memcpy(bytes, &reinterpret_cast<const sockaddr_in6&>(address).sin6_addr, sizeof(bytes));
+        return IpAddress(bytes);
+    }
+
+    return IpAddress(ntohl(reinterpret_cast<const sockaddr_in&>(address).sin_addr.s_addr));
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned short SocketImpl::getPort(const sockaddr_storage& address)
+{
+    if (address.ss_family == AF_INET6)
+        return ntohs(reinterpret_cast<const sockaddr_in6&>(address).sin6_port);
+
+    return ntohs(reinterpret_cast<const sockaddr_in&>(address).sin_port);
+}
+
+
+////////////////////////////////////////////////////////////
+SocketImpl::AddrLength SocketImpl::createLocalAddress(const std::string& path, sockaddr_storage& result)
+{
+    std::memset(&result, 0, sizeof(result));
+
+    LocalAddress& address = reinterpret_cast<LocalAddress&>(result);
+    if (path.empty() || (path.size() >= sizeof(address.path)))
+        return 0;
+
+    address.family = AF_UNIX;
+    std::memcpy(address.path, path.c_str(), path.size());
+
+    return sizeof(address);
+}
+
+
+////////////////////////////////////////////////////////////
+void SocketImpl::removeLocalAddress(const std::string& path)
+{
+    DeleteFileA(path.c_str());
+}
+
+
+////////////////////////////////////////////////////////////
+SocketHandle SocketImpl::createSocket(bool ipv6, int type, bool& isIpv6)
+{
+    if (ipv6)
+    {
+        SocketHandle handle = socket(PF_INET6, type, 0);
+        if (handle != invalidSocket())
+        {
+            // Accept IPv4 traffic too (through IPv4-mapped addresses)
+            int no = 0;
+            if (setsockopt(handle, IPPROTO_IPV6, IPV6_V6ONLY, reinterpret_cast<char*>(&no), sizeof(no)) == 0)
+            {
+                isIpv6 = true;
+                return handle;
+            }
+
+            close(handle);
+        }
+    }
+
+    // IPv4 requested, or IPv6 not available
+    isIpv6 = false;
+    return socket(PF_INET, type, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+SocketHandle SocketImpl::createLocalSocket()
+{
+    return socket(AF_UNIX, SOCK_STREAM, 0);
+}
+
+
 ////////////////////////////////////////////////////////////
 SocketHandle SocketImpl::invalidSocket()
 {
@@ -68,6 +262,138 @@ void SocketImpl::setBlocking(SocketHandle sock, bool block)
 }
 
 
+////////////////////////////////////////////////////////////
+bool SocketImpl::setOption(SocketHandle sock, Socket::Option option, bool ipv6, int value)
+{
+    int level = 0;
+    int name  = 0;
+    if (!getOptionName(option, ipv6, level, name))
+        return false;
+
+    return setsockopt(sock, level, name, reinterpret_cast<char*>(&value), sizeof(value)) != SOCKET_ERROR;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketImpl::getOption(SocketHandle sock, Socket::Option option, bool ipv6, int& value)
+{
+    int level = 0;
+    int name  = 0;
+    if (!getOptionName(option, ipv6, level, name))
+        return false;
+
+    int size = sizeof(value);
+    value = 0;
+    return getsockopt(sock, level, name, reinterpret_cast<char*>(&value), &size) != SOCKET_ERROR;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SocketImpl::getRoundTripTime(SocketHandle sock, Time& rtt, Time& variation)
+{
+#if defined(SIO_TCP_INFO)
+
+    // Available since Windows 10 version 1703, times are in microseconds
+    DWORD version = 0;
+    TCP_INFO_v0 info;
+    DWORD size = 0;
+    if (WSAIoctl(sock, SIO_TCP_INFO, &version, sizeof(version), &info, sizeof(info), &size, NULL, NULL) != 0)
+        return false;
+
+    rtt       = microseconds(info.RttUs);
+    variation = Time::Zero;
+    return true;
+
+#else
+
+    (void)sock;
+    (void)rtt;
+    (void)variation;
+    return false;
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+int SocketImpl::sendBuffers(SocketHandle sock, const void* first, std::size_t firstSize, const void* second, std::size_t secondSize, int flags)
+{
+    WSABUF buffers[2];
+    buffers[0].buf = static_cast<char*>(const_cast<void*>(first));
+    buffers[0].len = static_cast<u_long>(firstSize);
+    buffers[1].buf = static_cast<char*>(const_cast<void*>(second));
+    buffers[1].len = static_cast<u_long>(secondSize);
+
+    DWORD sent = 0;
+    if (WSASend(sock, buffers, (secondSize > 0) ? 2 : 1, &sent, static_cast<DWORD>(flags), NULL, NULL) != 0)
+        return -1;
+
+    return static_cast<int>(sent);
+}
+
+////////////////////////////////////////////////////////////
+bool SocketImpl::sendFile(SocketHandle sock, std::FILE* file, bool& fallback)
+{
+    fallback = false;
+
+    HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file)));
+    LARGE_INTEGER size;
+    if ((handle == INVALID_HANDLE_VALUE) || !GetFileSizeEx(handle, &size))
+    {
+        fallback = true;
+        return false;
+    }
+
+    // TransmitFile sends at most 2^31 - 1 bytes per call, from the current file position
+    LONGLONG sent = 0;
+    while (sent < size.QuadPart)
+    {
+        LARGE_INTEGER position;
+        position.QuadPart = sent;
+        if (!SetFilePointerEx(handle, position, NULL, FILE_BEGIN))
+        {
+            fallback = (sent == 0);
+            return false;
+        }
+
+        DWORD count = static_cast<DWORD>(std::min<LONGLONG>(size.QuadPart - sent, 1 << 30));
+        if (!TransmitFile(sock, handle, count, 0, NULL, NULL, 0))
+            return false;
+
+        sent += count;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Socket::Status SocketImpl::getConnectionStatus(SocketHandle sock)
+{
+    // The socket becomes writable when the connection is established,
+    // and goes to the exception set if it failed
+    fd_set writeSet;
+    fd_set exceptSet;
+    FD_ZERO(&writeSet);
+    FD_ZERO(&exceptSet);
+    FD_SET(sock, &writeSet);
+    FD_SET(sock, &exceptSet);
+
+    timeval time;
+    time.tv_sec  = 0;
+    time.tv_usec = 0;
+
+    int result = select(0, NULL, &writeSet, &exceptSet, &time);
+    if (result == 0)
+        return Socket::NotReady;
+    if (result < 0)
+        return getErrorStatus();
+
+    return FD_ISSET(sock, &exceptSet) ? Socket::Error : Socket::Done;
+}
+
+
+
 ////////////////////////////////////////////////////////////
 Socket::Status SocketImpl::getErrorStatus()
 {
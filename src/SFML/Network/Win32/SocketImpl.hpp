@@ -36,7 +36,10 @@
 #endif
 #define _WIN32_WINDOWS 0x0501
 #define _WIN32_WINNT   0x0501
+#include <SFML/Network/IpAddress.hpp>
 #include <SFML/Network/Socket.hpp>
+#include <cstdio>
+#include <string>
 #include <winsock2.h>
 #include <ws2tcpip.h>
 
@@ -70,6 +73,101 @@ public:
     ////////////////////////////////////////////////////////////
     static sockaddr_in createAddress(Uint32 address, unsigned short port);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create an internal address for a socket of a given family
+    ///
+    /// IPv4 addresses are converted to IPv4-mapped addresses
+    /// for IPv6 sockets.
+    ///
+    /// \param address Target address
+    /// \param port    Target port
+    /// \param ipv6    Is the address for an IPv6 socket?
+    /// \param result  Address to fill
+    ///
+    /// \return Size of the address, or 0 if \a address can't be used with the socket family
+    ///
+    ////////////////////////////////////////////////////////////
+    static AddrLength createAddress(const IpAddress& address, unsigned short port, bool ipv6, sockaddr_storage& result);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create an internal wildcard address, to bind a socket to all interfaces
+    ///
+    /// \param port   Port to bind to
+    /// \param ipv6   Is the address for an IPv6 socket?
+    /// \param result Address to fill
+    ///
+    /// \return Size of the address
+    ///
+    ////////////////////////////////////////////////////////////
+    static AddrLength createAnyAddress(unsigned short port, bool ipv6, sockaddr_storage& result);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Extract the IP address from an internal address
+    ///
+    /// IPv4-mapped addresses are converted back to IPv4 addresses.
+    ///
+    /// \param address Internal address (IPv4 or IPv6)
+    ///
+    /// \return IP address
+    ///
+    ////////////////////////////////////////////////////////////
+    static IpAddress getAddress(const sockaddr_storage& address);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Extract the port from an internal address
+    ///
+    /// \param address Internal address (IPv4 or IPv6)
+    ///
+    /// \return Port
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned short getPort(const sockaddr_storage& address);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the internal address of a local socket
+    ///
+    /// On Linux, paths starting with '@' are created in the
+    /// abstract namespace, without a file.
+    ///
+    /// \param path   Path of the local socket
+    /// \param result Address to fill
+    ///
+    /// \return Length of the address, or 0 if the path is too long
+    ///
+    ////////////////////////////////////////////////////////////
+    static AddrLength createLocalAddress(const std::string& path, sockaddr_storage& result);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove the file of a local socket address
+    ///
+    /// \param path Path of the local socket
+    ///
+    ////////////////////////////////////////////////////////////
+    static void removeLocalAddress(const std::string& path);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a socket handle, dual-stack if it is an IPv6 one
+    ///
+    /// If the system can't create a dual-stack IPv6 socket,
+    /// an IPv4 socket is created instead.
+    ///
+    /// \param ipv6   Create an IPv6 socket?
+    /// \param type   Type of socket (SOCK_STREAM or SOCK_DGRAM)
+    /// \param isIpv6 Set to true if an IPv6 socket was created
+    ///
+    /// \return Handle of the new socket, or the invalid socket on error
+    ///
+    ////////////////////////////////////////////////////////////
+    static SocketHandle createSocket(bool ipv6, int type, bool& isIpv6);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a local stream socket handle
+    ///
+    /// \return Handle of the new socket, or the invalid socket on error
+    ///
+    ////////////////////////////////////////////////////////////
+    static SocketHandle createLocalSocket();
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the value of the invalid socket
     ///
@@ -95,6 +193,85 @@ public:
     ////////////////////////////////////////////////////////////
     static void setBlocking(SocketHandle sock, bool block);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the value of a socket option
+    ///
+    /// \param sock   Handle of the socket
+    /// \param option Option to set
+    /// \param ipv6   Is the socket an IPv6 one?
+    /// \param value  New value of the option
+    ///
+    /// \return True on success, false if the option couldn't be set or isn't supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool setOption(SocketHandle sock, Socket::Option option, bool ipv6, int value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the value of a socket option
+    ///
+    /// \param sock   Handle of the socket
+    /// \param option Option to get
+    /// \param ipv6   Is the socket an IPv6 one?
+    /// \param value  Variable to fill with the value of the option
+    ///
+    /// \return True on success, false if the option couldn't be read or isn't supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool getOption(SocketHandle sock, Socket::Option option, bool ipv6, int& value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the round-trip time measured by the system for a TCP socket
+    ///
+    /// \param sock      Handle of the socket
+    /// \param rtt       Variable to fill with the smoothed round-trip time
+    /// \param variation Variable to fill with the variation of the round-trip time
+    ///
+    /// \return True on success, false if the system doesn't provide it
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool getRoundTripTime(SocketHandle sock, Time& rtt, Time& variation);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send two buffers with a single gathering system call
+    ///
+    /// \param sock       Handle of the socket
+    /// \param first      First buffer to send
+    /// \param firstSize  Size of the first buffer, in bytes
+    /// \param second     Second buffer, sent right after the first one
+    /// \param secondSize Size of the second buffer, in bytes (can be 0)
+    /// \param flags      Flags to pass to the system call
+    ///
+    /// \return Number of bytes sent, or -1 on error
+    ///
+    ////////////////////////////////////////////////////////////
+    static int sendBuffers(SocketHandle sock, const void* first, std::size_t firstSize, const void* second, std::size_t secondSize, int flags);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Send the whole contents of a file without copying it to user memory
+    ///
+    /// The socket must be in blocking mode.
+    ///
+    /// \param sock     Handle of the socket
+    /// \param file     File to send, from its beginning
+    /// \param fallback Set to true if the system can't send this file
+    ///                 directly; nothing was sent in this case, and the
+    ///                 caller should send it with regular send calls
+    ///
+    /// \return True if the whole file was sent
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool sendFile(SocketHandle sock, std::FILE* file, bool& fallback);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the state of a connection started on a non-blocking socket
+    ///
+    /// \param sock Handle of the socket
+    ///
+    /// \return Done if connected, NotReady if still in progress, or the error
+    ///
+    ////////////////////////////////////////////////////////////
+    static Socket::Status getConnectionStatus(SocketHandle sock);
+
     ////////////////////////////////////////////////////////////
     /// Get the last socket error status
     ///
@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Allocator.hpp>
+#include <SFML/System/Err.hpp>
+#include <cstdlib>
+
+
+namespace
+{
+    // Default hooks, calling the C allocator
+    void* defaultAllocate(std::size_t size, sf::Allocator::Tag, void*)
+    {
+        return std::malloc(size);
+    }
+
+    void* defaultReallocate(void* block, std::size_t size, sf::Allocator::Tag, void*)
+    {
+        return std::realloc(block, size);
+    }
+
+    void defaultDeallocate(void* block, sf::Allocator::Tag, void*)
+    {
+        std::free(block);
+    }
+
+    // Hooks in use, constructed on first use since static objects may allocate before main()
+    sf::Allocator::Hooks& getCurrentHooks()
+    {
+        static sf::Allocator::Hooks hooks;
+        return hooks;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Allocator::Hooks::Hooks() :
+allocate  (&defaultAllocate),
+reallocate(&defaultReallocate),
+deallocate(&defaultDeallocate),
+userData  (NULL)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Allocator::setHooks(const Hooks& newHooks)
+{
+    if (!newHooks.allocate || !newHooks.reallocate || !newHooks.deallocate)
+    {
+        err() << "Failed to set the allocator hooks (a function is missing)" << std::endl;
+        return;
+    }
+
+    getCurrentHooks() = newHooks;
+}
+
+
+////////////////////////////////////////////////////////////
+const Allocator::Hooks& Allocator::getHooks()
+{
+    return getCurrentHooks();
+}
+
+
+////////////////////////////////////////////////////////////
+void* Allocator::allocate(std::size_t size, Tag tag)
+{
+    const Hooks& hooks = getCurrentHooks();
+    return hooks.allocate(size, tag, hooks.userData);
+}
+
+
+////////////////////////////////////////////////////////////
+void* Allocator::reallocate(void* block, std::size_t size, Tag tag)
+{
+    const Hooks& hooks = getCurrentHooks();
+    return hooks.reallocate(block, size, tag, hooks.userData);
+}
+
+
+////////////////////////////////////////////////////////////
+void Allocator::deallocate(void* block, Tag tag)
+{
+    const Hooks& hooks = getCurrentHooks();
+    hooks.deallocate(block, tag, hooks.userData);
+}
+
+
+////////////////////////////////////////////////////////////
+const char* Allocator::getName(Tag tag)
+{
+    switch (tag)
+    {
+        case General: return "General";
+        case Fonts:   return "Fonts";
+        case Images:  return "Images";
+        default:      return "Unknown";
+    }
+}
+
+} // namespace sf
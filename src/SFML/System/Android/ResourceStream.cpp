@@ -37,19 +37,20 @@ namespace priv
 {
 
 ////////////////////////////////////////////////////////////
-ResourceStream::ResourceStream(const std::string& filename) :
+ResourceStream::ResourceStream(const std::string& filename, bool buffer) :
 m_file (NULL)
 {
     ActivityStates* states = getActivity(NULL);
-    Lock(states->mutex);
-    m_file = AAssetManager_open(states->activity->assetManager, filename.c_str(), AASSET_MODE_UNKNOWN);
+    Lock lock(states->mutex);
+    m_file = AAssetManager_open(states->activity->assetManager, filename.c_str(), buffer ? AASSET_MODE_BUFFER : AASSET_MODE_UNKNOWN);
 }
 
 
 ////////////////////////////////////////////////////////////
 ResourceStream::~ResourceStream()
 {
-    AAsset_close(m_file);
+    if (m_file)
+        AAsset_close(m_file);
 }
 
 
@@ -63,7 +64,7 @@ Int64 ResourceStream::read(void *data, Int64 size)
 ////////////////////////////////////////////////////////////
 Int64 ResourceStream::seek(Int64 position)
 {
-    AAsset_seek(m_file, position, SEEK_SET);
+    return AAsset_seek(m_file, position, SEEK_SET);
 }
 
 
@@ -81,5 +82,12 @@ Int64 ResourceStream::getSize()
 }
 
 
+////////////////////////////////////////////////////////////
+const void* ResourceStream::getBuffer()
+{
+    return m_file ? AAsset_getBuffer(m_file) : NULL;
+}
+
+
 } // namespace priv
 } // namespace sf
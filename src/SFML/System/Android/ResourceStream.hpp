@@ -50,9 +50,10 @@ public:
     /// \brief Default constructor
     ///
     /// \param filename Filename of the asset
+    /// \param buffer   True if the whole asset will be accessed through getBuffer
     ///
     ////////////////////////////////////////////////////////////
-    ResourceStream(const std::string& filename);
+    ResourceStream(const std::string& filename, bool buffer = false);
 
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
@@ -97,6 +98,19 @@ public:
     ////////////////////////////////////////////////////////////
     Int64 getSize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a pointer to the whole content of the asset
+    ///
+    /// Uncompressed assets are mapped in memory straight from
+    /// the APK; compressed ones are inflated in a buffer owned
+    /// by the asset. The pointer stays valid until the stream
+    /// is destroyed.
+    ///
+    /// \return Pointer to the asset data, or NULL on error
+    ///
+    ////////////////////////////////////////////////////////////
+    const void* getBuffer();
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -0,0 +1,634 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Archive.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+#if defined(SFML_SYSTEM_WINDOWS)
+    #include <windows.h>
+#elif !defined(SFML_SYSTEM_ANDROID)
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+
+namespace
+{
+    // Layout of an archive (all the integers are little-endian):
+    //   "SFPK", Uint32 version, Uint32 entry count
+    //   for each entry, sorted by name:
+    //     Uint32 name length, name, Uint64 offset, Uint64 stored size, Uint64 size, Uint32 flags
+    //   data of the entries
+    const char         signature[4]  = {'S', 'F', 'P', 'K'};
+    const sf::Uint32   version       = 1;
+    const sf::Uint32   flagLz4       = 1;
+    const sf::Uint32   maxNameLength = 4096;
+
+    // Non-null address for the streams of empty entries
+    const char emptyEntry = 0;
+
+    // Read a little-endian integer from a stream
+    template <typename T>
+    bool readInteger(sf::InputStream& stream, T& value)
+    {
+        unsigned char bytes[sizeof(T)];
+        if (stream.read(bytes, sizeof(T)) != static_cast<sf::Int64>(sizeof(T)))
+            return false;
+
+        value = 0;
+        for (std::size_t i = 0; i < sizeof(T); ++i)
+            value |= static_cast<T>(bytes[i]) << (8 * i);
+        return true;
+    }
+
+    // Write a little-endian integer to a buffer
+    template <typename T>
+    void writeInteger(std::vector<char>& buffer, T value)
+    {
+        for (std::size_t i = 0; i < sizeof(T); ++i)
+            buffer.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+
+    // Read the length of an LZ4 literal run or match, continued by 255-valued bytes
+    bool readLz4Length(const unsigned char*& input, const unsigned char* end, std::size_t& length)
+    {
+        unsigned char byte;
+        do
+        {
+            if (input == end)
+                return false;
+            byte = *input++;
+            length += byte;
+        }
+        while (byte == 255);
+        return true;
+    }
+
+    // Write the length of an LZ4 literal run or match, after the 15 stored in the token
+    void writeLz4Length(std::vector<char>& output, std::size_t length)
+    {
+        for (; length >= 255; length -= 255)
+            output.push_back(static_cast<char>(255));
+        output.push_back(static_cast<char>(length));
+    }
+
+    // Decompress an LZ4 block, which must decode to exactly outputSize bytes
+    bool decompressLz4(const unsigned char* input, std::size_t inputSize, unsigned char* output, std::size_t outputSize)
+    {
+        const unsigned char* inputEnd = input + inputSize;
+        unsigned char* position = output;
+        unsigned char* outputEnd = output + outputSize;
+
+        while (input < inputEnd)
+        {
+            unsigned char token = *input++;
+
+            // Literals
+            std::size_t literals = token >> 4;
+            if ((literals == 15) && !readLz4Length(input, inputEnd, literals))
+                return false;
+            if ((literals > static_cast<std::size_t>(inputEnd - input)) || (literals > static_cast<std::size_t>(outputEnd - position)))
+                return false;
+            std::memcpy(position, input, literals);
+            input += literals;
+            position += literals;
+
+            // The last sequence has no match
+            if (input == inputEnd)
+                break;
+
+            // Match
+            if (inputEnd - input < 2)
+                return false;
+            std::size_t offset = input[0] | (input[1] << 8);
+            input += 2;
+            if ((offset == 0) || (offset > static_cast<std::size_t>(position - output)))
+                return false;
+
+            std::size_t length = token & 0x0F;
+            if ((length == 15) && !readLz4Length(input, inputEnd, length))
+                return false;
+            length += 4;
+            if (length > static_cast<std::size_t>(outputEnd - position))
+                return false;
+
+            // The match may overlap the bytes it produces, so it is copied byte by byte
+            const unsigned char* match = position - offset;
+            if (offset >= length)
+            {
+                std::memcpy(position, match, length);
+                position += length;
+            }
+            else
+            {
+                for (std::size_t i = 0; i < length; ++i)
+                    *position++ = *match++;
+            }
+        }
+
+        return position == outputEnd;
+    }
+
+    // Compress a buffer into an LZ4 block, with a greedy search of the matches
+    void compressLz4(const unsigned char* input, std::size_t inputSize, std::vector<char>& output)
+    {
+        // The format requires the last 5 bytes to be literals, and the last match to start at least 12 bytes before the end
+        const std::size_t hashBits = 14;
+        std::vector<std::size_t> table(static_cast<std::size_t>(1) << hashBits, 0);
+
+        std::size_t anchor = 0;
+        std::size_t position = 0;
+        while (inputSize >= 13 && position + 12 <= inputSize)
+        {
+            sf::Uint32 sequence;
+            std::memcpy(&sequence, input + position, 4);
+            std::size_t hash = (sequence * 2654435761u) >> (32 - hashBits);
+            std::size_t candidate = table[hash];
+            table[hash] = position + 1;
+
+            sf::Uint32 candidateSequence;
+            if ((candidate == 0) || (position + 1 - candidate > 65535))
+            {
+                ++position;
+                continue;
+            }
+            std::memcpy(&candidateSequence, input + candidate - 1, 4);
+            if (candidateSequence != sequence)
+            {
+                ++position;
+                continue;
+            }
+
+            // Extend the match as far as allowed
+            std::size_t match = candidate - 1;
+            std::size_t length = 4;
+            while ((position + length < inputSize - 5) && (input[match + length] == input[position + length]))
+                ++length;
+
+            // Write the sequence
+            std::size_t literals = position - anchor;
+            output.push_back(static_cast<char>(((literals < 15 ? literals : 15) << 4) | (length - 4 < 15 ? length - 4 : 15)));
+            if (literals >= 15)
+                writeLz4Length(output, literals - 15);
+            output.insert(output.end(), input + anchor, input + position);
+            std::size_t offset = position - match;
+            output.push_back(static_cast<char>(offset & 0xFF));
+            output.push_back(static_cast<char>(offset >> 8));
+            if (length - 4 >= 15)
+                writeLz4Length(output, length - 4 - 15);
+
+            position += length;
+            anchor = position;
+        }
+
+        // Write the remaining bytes as the literals of the last sequence
+        std::size_t literals = inputSize - anchor;
+        output.push_back(static_cast<char>((literals < 15 ? literals : 15) << 4));
+        if (literals >= 15)
+            writeLz4Length(output, literals - 15);
+        output.insert(output.end(), input + anchor, input + inputSize);
+    }
+
+    // Read a whole file into a buffer
+    bool readFile(const std::string& filename, std::vector<char>& buffer)
+    {
+        std::ifstream file(filename.c_str(), std::ios_base::binary);
+        if (!file)
+            return false;
+
+        file.seekg(0, std::ios_base::end);
+        std::streamoff size = file.tellg();
+        file.seekg(0, std::ios_base::beg);
+        if (size < 0)
+            return false;
+
+        buffer.resize(static_cast<std::size_t>(size));
+        if (size > 0)
+            file.read(&buffer[0], size);
+        return !file.fail();
+    }
+
+    // Order of the entries in the index
+    struct EntryLess
+    {
+        template <typename T>
+        bool operator ()(const T& left, const std::string& right) const {return left.name < right;}
+        template <typename T>
+        bool operator ()(const T& left, const T& right) const {return left.name < right.name;}
+    };
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Archive::Archive() :
+m_mapped     (false),
+m_thread     (&Archive::prefetchEntries, this),
+m_prefetching(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Archive::~Archive()
+{
+    close();
+}
+
+
+////////////////////////////////////////////////////////////
+bool Archive::open(const std::string& filename)
+{
+    close();
+
+    // Map the archive if possible, otherwise read it through a file handle
+    m_mapped = m_mapping.open(filename);
+    if (!m_mapped && !m_file.open(filename))
+    {
+        err() << "Failed to open archive \"" << filename << "\"" << std::endl;
+        return false;
+    }
+
+    InputStream& stream = m_mapped ? static_cast<InputStream&>(m_mapping) : static_cast<InputStream&>(m_file);
+    Int64 fileSize = stream.getSize();
+
+    // Read the header
+    char header[4];
+    Uint32 fileVersion = 0;
+    Uint32 count = 0;
+    if ((stream.seek(0) != 0) || (stream.read(header, 4) != 4) || (std::memcmp(header, signature, 4) != 0) ||
+        !readInteger(stream, fileVersion) || (fileVersion != version) || !readInteger(stream, count))
+    {
+        err() << "Failed to open archive \"" << filename << "\" (not an archive or unsupported version)" << std::endl;
+        close();
+        return false;
+    }
+
+    // Read the index
+    for (Uint32 i = 0; i < count; ++i)
+    {
+        Entry entry;
+        Uint32 nameLength = 0;
+        bool valid = readInteger(stream, nameLength) && (nameLength <= maxNameLength);
+        if (valid)
+        {
+            entry.name.resize(nameLength);
+            valid = (nameLength == 0) || (stream.read(&entry.name[0], nameLength) == nameLength);
+        }
+        valid = valid && readInteger(stream, entry.offset) && readInteger(stream, entry.storedSize) &&
+                readInteger(stream, entry.size) && readInteger(stream, entry.flags);
+
+        // Reject entries lying outside of the file, or too large to be addressed
+        valid = valid && (entry.offset <= static_cast<Uint64>(fileSize)) &&
+                (entry.storedSize <= static_cast<Uint64>(fileSize) - entry.offset) &&
+                (entry.size <= static_cast<Uint64>(static_cast<std::size_t>(-1))) &&
+                ((entry.flags & flagLz4) || (entry.storedSize == entry.size));
+        if (!valid)
+        {
+            err() << "Failed to open archive \"" << filename << "\" (corrupted index)" << std::endl;
+            close();
+            return false;
+        }
+
+        m_entries.push_back(entry);
+    }
+
+    std::sort(m_entries.begin(), m_entries.end(), EntryLess());
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Archive::contains(const std::string& name) const
+{
+    return findEntry(name) != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+std::vector<std::string> Archive::getEntryNames() const
+{
+    std::vector<std::string> names;
+    names.reserve(m_entries.size());
+    for (std::vector<Entry>::const_iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+        names.push_back(it->name);
+    return names;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Archive::openEntry(const std::string& name, MemoryInputStream& stream)
+{
+    const Entry* entry = findEntry(name);
+    if (!entry)
+    {
+        err() << "Failed to open archive entry \"" << name << "\" (no such entry)" << std::endl;
+        return false;
+    }
+
+    // Uncompressed entries are read directly from the mapped file
+    if (isInPlace(*entry))
+    {
+        const char* data = static_cast<const char*>(m_mapping.getData()) + entry->offset;
+        stream.open(entry->size > 0 ? data : &emptyEntry, static_cast<std::size_t>(entry->size));
+        return true;
+    }
+
+    const std::vector<char>* buffer = loadEntry(*entry);
+    if (!buffer)
+    {
+        err() << "Failed to open archive entry \"" << name << "\" (corrupted data)" << std::endl;
+        return false;
+    }
+
+    stream.open(buffer->empty() ? &emptyEntry : &(*buffer)[0], buffer->size());
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Archive::prefetch(const std::string& name)
+{
+    const Entry* entry = findEntry(name);
+    if (!entry)
+        return;
+
+    if (isInPlace(*entry))
+    {
+        // Ask the system to read the pages of the entry ahead
+        if (entry->size == 0)
+            return;
+
+        const char* data = static_cast<const char*>(m_mapping.getData()) + entry->offset;
+
+#if defined(SFML_SYSTEM_WINDOWS)
+
+        // PrefetchVirtualMemory only exists since Windows 8
+        struct MemoryRange {PVOID address; SIZE_T size;};
+        typedef BOOL (WINAPI *PrefetchFunc)(HANDLE, ULONG_PTR, MemoryRange*, ULONG);
+        static PrefetchFunc prefetchVirtualMemory = reinterpret_cast<PrefetchFunc>(GetProcAddress(GetModuleHandleA("kernel32.dll"), "PrefetchVirtualMemory"));
+        if (prefetchVirtualMemory)
+        {
+            MemoryRange range = {const_cast<char*>(data), static_cast<SIZE_T>(entry->size)};
+            prefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+        }
+
+#elif !defined(SFML_SYSTEM_ANDROID)
+
+        // The advised range must start on a page boundary
+        std::size_t pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        std::size_t misalignment = reinterpret_cast<std::size_t>(data) % pageSize;
+        posix_madvise(const_cast<char*>(data - misalignment), static_cast<std::size_t>(entry->size) + misalignment, POSIX_MADV_WILLNEED);
+
+#endif
+
+        return;
+    }
+
+    // Queue the entry for the prefetching thread, and start it if it's idle
+    Lock lock(m_mutex);
+    if (m_buffers.find(entry->name) != m_buffers.end())
+        return;
+    if (std::find(m_prefetches.begin(), m_prefetches.end(), entry) != m_prefetches.end())
+        return;
+
+    m_prefetches.push_back(entry);
+    if (!m_prefetching)
+    {
+        m_prefetching = true;
+        m_thread.launch();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Archive::releaseEntry(const std::string& name)
+{
+    Lock lock(m_mutex);
+    m_buffers.erase(name);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Archive::create(const std::string& filename, const std::vector<std::string>& paths, bool compress)
+{
+    // Build the index, sorted by name
+    std::vector<std::pair<std::string, std::string> > files;
+    for (std::vector<std::string>::const_iterator it = paths.begin(); it != paths.end(); ++it)
+    {
+        std::string name = *it;
+        std::replace(name.begin(), name.end(), '\\', '/');
+        files.push_back(std::make_pair(name, *it));
+    }
+    std::sort(files.begin(), files.end());
+
+    std::vector<Entry> entries(files.size());
+    std::vector<char> data;
+    for (std::size_t i = 0; i < files.size(); ++i)
+    {
+        if ((i > 0) && (files[i].first == files[i - 1].first))
+        {
+            err() << "Failed to create archive \"" << filename << "\" (duplicate entry \"" << files[i].first << "\")" << std::endl;
+            return false;
+        }
+
+        std::vector<char> content;
+        if (!readFile(files[i].second, content))
+        {
+            err() << "Failed to create archive \"" << filename << "\" (cannot read \"" << files[i].second << "\")" << std::endl;
+            return false;
+        }
+
+        Entry& entry = entries[i];
+        entry.name = files[i].first;
+        entry.offset = data.size();
+        entry.size = content.size();
+        entry.flags = 0;
+
+        // Keep the compressed data only if it's smaller
+        if (compress && !content.empty())
+        {
+            std::vector<char> compressed;
+            compressed.reserve(content.size());
+            compressLz4(reinterpret_cast<const unsigned char*>(&content[0]), content.size(), compressed);
+            if (compressed.size() < content.size())
+            {
+                content.swap(compressed);
+                entry.flags = flagLz4;
+            }
+        }
+
+        entry.storedSize = content.size();
+        data.insert(data.end(), content.begin(), content.end());
+    }
+
+    // Write the header and the index, with the offsets shifted past them
+    std::vector<char> index(signature, signature + 4);
+    writeInteger(index, version);
+    writeInteger(index, static_cast<Uint32>(entries.size()));
+    Uint64 dataOffset = index.size();
+    for (std::vector<Entry>::const_iterator it = entries.begin(); it != entries.end(); ++it)
+        dataOffset += 4 + it->name.size() + 8 + 8 + 8 + 4;
+
+    for (std::vector<Entry>::const_iterator it = entries.begin(); it != entries.end(); ++it)
+    {
+        writeInteger(index, static_cast<Uint32>(it->name.size()));
+        index.insert(index.end(), it->name.begin(), it->name.end());
+        writeInteger(index, dataOffset + it->offset);
+        writeInteger(index, it->storedSize);
+        writeInteger(index, it->size);
+        writeInteger(index, it->flags);
+    }
+
+    std::ofstream file(filename.c_str(), std::ios_base::binary);
+    if (file)
+    {
+        file.write(&index[0], index.size());
+        if (!data.empty())
+            file.write(&data[0], data.size());
+    }
+
+    if (!file)
+    {
+        err() << "Failed to create archive \"" << filename << "\" (cannot write the file)" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Archive::close()
+{
+    {
+        Lock lock(m_mutex);
+        m_prefetches.clear();
+    }
+    m_thread.wait();
+
+    m_entries.clear();
+    m_buffers.clear();
+    m_mapped = false;
+}
+
+
+////////////////////////////////////////////////////////////
+const Archive::Entry* Archive::findEntry(const std::string& name) const
+{
+    std::vector<Entry>::const_iterator it = std::lower_bound(m_entries.begin(), m_entries.end(), name, EntryLess());
+    return (it != m_entries.end()) && (it->name == name) ? &*it : NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Archive::isInPlace(const Entry& entry) const
+{
+    return m_mapped && !(entry.flags & flagLz4);
+}
+
+
+////////////////////////////////////////////////////////////
+const std::vector<char>* Archive::loadEntry(const Entry& entry)
+{
+    {
+        Lock lock(m_mutex);
+        BufferTable::const_iterator it = m_buffers.find(entry.name);
+        if (it != m_buffers.end())
+            return &it->second;
+    }
+
+    // Get the stored data, from the mapping or from the file
+    std::vector<char> stored;
+    const char* storedData;
+    if (m_mapped)
+    {
+        storedData = static_cast<const char*>(m_mapping.getData()) + entry.offset;
+    }
+    else
+    {
+        stored.resize(static_cast<std::size_t>(entry.storedSize));
+        if (!stored.empty())
+        {
+            Lock lock(m_fileMutex);
+            if ((m_file.seek(entry.offset) != static_cast<Int64>(entry.offset)) ||
+                (m_file.read(&stored[0], entry.storedSize) != static_cast<Int64>(entry.storedSize)))
+                return NULL;
+        }
+        storedData = stored.empty() ? &emptyEntry : &stored[0];
+    }
+
+    // Decompress it
+    std::vector<char> buffer;
+    if (entry.flags & flagLz4)
+    {
+        buffer.resize(static_cast<std::size_t>(entry.size));
+        if (!decompressLz4(reinterpret_cast<const unsigned char*>(storedData), static_cast<std::size_t>(entry.storedSize),
+                           reinterpret_cast<unsigned char*>(buffer.empty() ? NULL : &buffer[0]), buffer.size()))
+            return NULL;
+    }
+    else
+    {
+        buffer.swap(stored);
+    }
+
+    // Another thread may have loaded the same entry in the meantime; keep the first buffer
+    Lock lock(m_mutex);
+    std::vector<char>& slot = m_buffers[entry.name];
+    if (slot.empty())
+        slot.swap(buffer);
+    return &slot;
+}
+
+
+////////////////////////////////////////////////////////////
+void Archive::prefetchEntries()
+{
+    for (;;)
+    {
+        const Entry* entry;
+        {
+            Lock lock(m_mutex);
+            if (m_prefetches.empty())
+            {
+                m_prefetching = false;
+                return;
+            }
+            entry = m_prefetches.front();
+            m_prefetches.pop_front();
+        }
+
+        if (!loadEntry(*entry))
+            err() << "Failed to prefetch archive entry \"" << entry->name << "\" (corrupted data)" << std::endl;
+    }
+}
+
+} // namespace sf
@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/AtomicInt.hpp>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+    #pragma intrinsic(_InterlockedExchangeAdd, _InterlockedExchange, _InterlockedCompareExchange, _ReadWriteBarrier)
+#endif
+
+
+namespace
+{
+    // Atomic primitives with full barriers: compiler intrinsics of Visual C++, __sync builtins of GCC and clang
+    #if defined(_MSC_VER)
+
+        sf::Int32 fetchAddImpl(volatile sf::Int32* value, sf::Int32 add)
+        {
+            return _InterlockedExchangeAdd(reinterpret_cast<volatile long*>(value), add);
+        }
+
+        sf::Int32 exchangeImpl(volatile sf::Int32* value, sf::Int32 desired)
+        {
+            return _InterlockedExchange(reinterpret_cast<volatile long*>(value), desired);
+        }
+
+        sf::Int32 compareExchangeImpl(volatile sf::Int32* value, sf::Int32 expected, sf::Int32 desired)
+        {
+            return _InterlockedCompareExchange(reinterpret_cast<volatile long*>(value), desired, expected);
+        }
+
+        // Plain accesses, ordered by a barrier: x86 loads already acquire and stores already release,
+        // so only the compiler must be prevented from moving accesses; other CPUs need a real barrier
+        void barrierImpl()
+        {
+        #if defined(_M_IX86) || defined(_M_X64)
+            _ReadWriteBarrier();
+        #else
+            __dmb(_ARM_BARRIER_ISH);
+        #endif
+        }
+
+        sf::Int32 loadImpl(const volatile sf::Int32* value)
+        {
+            sf::Int32 result = *value;
+            barrierImpl();
+            return result;
+        }
+
+        void storeImpl(volatile sf::Int32* value, sf::Int32 desired)
+        {
+            barrierImpl();
+            *value = desired;
+        }
+
+    #else
+
+        sf::Int32 fetchAddImpl(volatile sf::Int32* value, sf::Int32 add)
+        {
+            return __sync_fetch_and_add(value, add);
+        }
+
+        sf::Int32 compareExchangeImpl(volatile sf::Int32* value, sf::Int32 expected, sf::Int32 desired)
+        {
+            return __sync_val_compare_and_swap(value, expected, desired);
+        }
+
+        sf::Int32 exchangeImpl(volatile sf::Int32* value, sf::Int32 desired)
+        {
+            // __sync_lock_test_and_set is only an acquire barrier, so loop on a compare-and-swap
+            sf::Int32 previous = fetchAddImpl(value, 0);
+            sf::Int32 current;
+            while ((current = compareExchangeImpl(value, previous, desired)) != previous)
+                previous = current;
+            return previous;
+        }
+
+        #if defined(__ATOMIC_ACQUIRE)
+
+            // Compilers with the __atomic builtins (GCC 4.7, clang 3.1) emit the cheapest instructions of the CPU
+            sf::Int32 loadImpl(const volatile sf::Int32* value)
+            {
+                return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+            }
+
+            void storeImpl(volatile sf::Int32* value, sf::Int32 desired)
+            {
+                __atomic_store_n(value, desired, __ATOMIC_RELEASE);
+            }
+
+        #else
+
+            // Older ones: plain accesses, ordered by a full barrier
+            sf::Int32 loadImpl(const volatile sf::Int32* value)
+            {
+                sf::Int32 result = *value;
+                __sync_synchronize();
+                return result;
+            }
+
+            void storeImpl(volatile sf::Int32* value, sf::Int32 desired)
+            {
+                __sync_synchronize();
+                *value = desired;
+            }
+
+        #endif
+
+    #endif
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+AtomicInt::AtomicInt(Int32 value) :
+m_value(value)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Int32 AtomicInt::load() const
+{
+    return loadImpl(&m_value);
+}
+
+
+////////////////////////////////////////////////////////////
+void AtomicInt::store(Int32 value)
+{
+    storeImpl(&m_value, value);
+}
+
+
+////////////////////////////////////////////////////////////
+Int32 AtomicInt::exchange(Int32 value)
+{
+    return exchangeImpl(&m_value, value);
+}
+
+
+////////////////////////////////////////////////////////////
+bool AtomicInt::compareExchange(Int32& expected, Int32 desired)
+{
+    Int32 previous = compareExchangeImpl(&m_value, expected, desired);
+    if (previous == expected)
+        return true;
+
+    expected = previous;
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+Int32 AtomicInt::fetchAdd(Int32 value)
+{
+    return fetchAddImpl(&m_value, value);
+}
+
+
+////////////////////////////////////////////////////////////
+Int32 AtomicInt::operator ++()
+{
+    return fetchAddImpl(&m_value, 1) + 1;
+}
+
+
+////////////////////////////////////////////////////////////
+Int32 AtomicInt::operator --()
+{
+    return fetchAddImpl(&m_value, -1) - 1;
+}
+
+} // namespace sf
@@ -0,0 +1,279 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/BufferedInputStream.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+    // Maximum amount of data read from the source at once, so that the window is refilled progressively
+    const std::size_t maxReadSize = 64 * 1024;
+}
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+BufferedInputStream::BufferedInputStream() :
+m_source      (NULL),
+m_thread      (&BufferedInputStream::prefetch, this),
+m_mutex       (),
+m_condition   (),
+m_window      (),
+m_prefetchSize(256 * 1024),
+m_head        (0),
+m_count       (0),
+m_position    (0),
+m_size        (-1),
+m_generation  (0),
+m_endReached  (false),
+m_failed      (false),
+m_stopping    (false)
+{
+    m_thread.setName("sfml-read-ahead");
+}
+
+
+////////////////////////////////////////////////////////////
+BufferedInputStream::~BufferedInputStream()
+{
+    close();
+}
+
+
+////////////////////////////////////////////////////////////
+void BufferedInputStream::setPrefetchSize(std::size_t size)
+{
+    m_prefetchSize = std::max<std::size_t>(size, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t BufferedInputStream::getPrefetchSize() const
+{
+    return m_prefetchSize;
+}
+
+
+////////////////////////////////////////////////////////////
+bool BufferedInputStream::open(InputStream& source)
+{
+    close();
+
+    // The size and position are retrieved now, afterwards the source belongs to the thread
+    Int64 size = source.getSize();
+    Int64 position = source.tell();
+    if ((size < 0) || (position < 0))
+        return false;
+
+    m_source = &source;
+    m_window.resize(m_prefetchSize);
+    m_head = 0;
+    m_count = 0;
+    m_position = position;
+    m_size = size;
+    m_endReached = false;
+    m_failed = false;
+    m_stopping = false;
+
+    m_thread.launch();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void BufferedInputStream::close()
+{
+    if (!m_source)
+        return;
+
+    {
+        Lock lock(m_mutex);
+        m_stopping = true;
+        m_condition.notifyAll();
+    }
+    m_thread.wait();
+
+    m_source = NULL;
+    m_window.clear();
+    m_count = 0;
+    m_size = -1;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 BufferedInputStream::read(void* data, Int64 size)
+{
+    if (!m_source)
+        return -1;
+
+    Lock lock(m_mutex);
+
+    // Readers expect the whole size unless the end is reached, so wait for the data as needed
+    char* output = static_cast<char*>(data);
+    Int64 read = 0;
+    while (read < size)
+    {
+        while ((m_count == 0) && !m_endReached && !m_failed)
+            m_condition.wait(m_mutex);
+
+        if (m_count == 0)
+            break;
+
+        // Copy the data up to the end of the window, or up to the end of the ring
+        std::size_t toCopy = static_cast<std::size_t>(std::min<Int64>(size - read, m_count));
+        toCopy = std::min(toCopy, m_window.size() - m_head);
+        std::memcpy(output + read, &m_window[m_head], toCopy);
+
+        m_head = (m_head + toCopy) % m_window.size();
+        m_count -= toCopy;
+        m_position += toCopy;
+        read += toCopy;
+
+        // There's room in the window again
+        m_condition.notifyAll();
+    }
+
+    if ((read == 0) && m_failed)
+        return -1;
+
+    return read;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 BufferedInputStream::seek(Int64 position)
+{
+    if (!m_source || (position < 0) || (position > m_size))
+        return -1;
+
+    Lock lock(m_mutex);
+
+    if ((position >= m_position) && (position <= m_position + static_cast<Int64>(m_count)))
+    {
+        // Skip the data before the new position, the rest of the window is still valid
+        std::size_t skipped = static_cast<std::size_t>(position - m_position);
+        m_head = (m_head + skipped) % m_window.size();
+        m_count -= skipped;
+    }
+    else
+    {
+        // Restart the read-ahead from the new position, and discard what is being read
+        m_head = 0;
+        m_count = 0;
+        m_endReached = false;
+        m_failed = false;
+        ++m_generation;
+    }
+
+    m_position = position;
+    m_condition.notifyAll();
+
+    return position;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 BufferedInputStream::tell()
+{
+    if (!m_source)
+        return -1;
+
+    Lock lock(m_mutex);
+    return m_position;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 BufferedInputStream::getSize()
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+void BufferedInputStream::prefetch()
+{
+    std::vector<char> buffer(std::min(maxReadSize, m_window.size()));
+    Int64 sourcePosition = m_source->tell();
+
+    for (;;)
+    {
+        // Wait until there's room in the window
+        Int64 position;
+        std::size_t toRead;
+        Uint32 generation;
+        {
+            Lock lock(m_mutex);
+            while (!m_stopping && ((m_count == m_window.size()) || m_endReached || m_failed))
+                m_condition.wait(m_mutex);
+
+            if (m_stopping)
+                break;
+
+            position = m_position + static_cast<Int64>(m_count);
+            toRead = std::min(buffer.size(), m_window.size() - m_count);
+            generation = m_generation;
+        }
+
+        // Read the source without blocking the reader
+        Int64 count = 0;
+        if (position != sourcePosition)
+            count = (m_source->seek(position) == position) ? 0 : -1;
+        if (count == 0)
+            count = m_source->read(&buffer[0], static_cast<Int64>(toRead));
+        sourcePosition = (count > 0) ? position + count : -1;
+
+        Lock lock(m_mutex);
+
+        // The reader sought elsewhere meanwhile: this data is useless
+        if (generation != m_generation)
+            continue;
+
+        if (count <= 0)
+        {
+            m_endReached = (count == 0);
+            m_failed = (count < 0);
+        }
+        else
+        {
+            // Append the data after the last byte of the window, wrapping around the ring
+            std::size_t tail = (m_head + m_count) % m_window.size();
+            std::size_t first = std::min(static_cast<std::size_t>(count), m_window.size() - tail);
+            std::memcpy(&m_window[tail], &buffer[0], first);
+            if (static_cast<std::size_t>(count) > first)
+                std::memcpy(&m_window[0], &buffer[first], static_cast<std::size_t>(count) - first);
+            m_count += static_cast<std::size_t>(count);
+        }
+
+        m_condition.notifyAll();
+    }
+}
+
+} // namespace sf
@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/ConditionVariable.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Semaphore.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ConditionVariable::ConditionVariable() :
+m_mutex(Mutex::Fast)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ConditionVariable::wait(Mutex& mutex)
+{
+    // Each waiter sleeps on its own semaphore, so that a notification
+    // can't be taken by a thread which started waiting after it
+    Semaphore semaphore;
+    {
+        Lock lock(m_mutex);
+        m_waiters.push_back(&semaphore);
+    }
+
+    mutex.unlock();
+    semaphore.wait();
+    mutex.lock();
+}
+
+
+////////////////////////////////////////////////////////////
+bool ConditionVariable::wait(Mutex& mutex, Time timeout)
+{
+    Semaphore semaphore;
+    {
+        Lock lock(m_mutex);
+        m_waiters.push_back(&semaphore);
+    }
+
+    mutex.unlock();
+    bool notified = semaphore.wait(timeout);
+    if (!notified)
+    {
+        // If a notification removed us from the list in the meantime, its post is pending: take it
+        Lock lock(m_mutex);
+        std::deque<Semaphore*>::iterator it = std::find(m_waiters.begin(), m_waiters.end(), &semaphore);
+        if (it != m_waiters.end())
+        {
+            m_waiters.erase(it);
+        }
+        else
+        {
+            semaphore.wait();
+            notified = true;
+        }
+    }
+    mutex.lock();
+
+    return notified;
+}
+
+
+////////////////////////////////////////////////////////////
+void ConditionVariable::notifyOne()
+{
+    Lock lock(m_mutex);
+
+    if (!m_waiters.empty())
+    {
+        m_waiters.front()->post();
+        m_waiters.pop_front();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ConditionVariable::notifyAll()
+{
+    Lock lock(m_mutex);
+
+    for (std::deque<Semaphore*>::iterator it = m_waiters.begin(); it != m_waiters.end(); ++it)
+        (*it)->post();
+    m_waiters.clear();
+}
+
+} // namespace sf
@@ -26,72 +26,70 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Log.hpp>
+#include <SFML/System/ThreadLocalPtr.hpp>
 #include <streambuf>
-#include <cstdio>
+#include <string>
 
 
 namespace
 {
 // This class will be used as the default streambuf of sf::Err,
-// it outputs to stderr by default (to keep the default behavior)
+// it turns each line into an error message of the log, which
+// writes it to stderr by default (to keep the default behavior)
 class DefaultErrStreamBuf : public std::streambuf
 {
-public:
-
-    DefaultErrStreamBuf()
-    {
-        // Allocate the write buffer
-        static const int size = 64;
-        char* buffer = new char[size];
-        setp(buffer, buffer + size);
-    }
-
-    ~DefaultErrStreamBuf()
-    {
-        // Synchronize
-        sync();
-
-        // Delete the write buffer
-        delete[] pbase();
-    }
-
 private:
 
+    // The stream is unbuffered: every character goes through overflow or xsputn,
+    // which gather the line of the calling thread so that threads don't mix their lines
     virtual int overflow(int character)
     {
-        if ((character != EOF) && (pptr() != epptr()))
-        {
-            // Valid character
-            return sputc(static_cast<char>(character));
-        }
-        else if (character != EOF)
+        if (!traits_type::eq_int_type(character, traits_type::eof()))
         {
-            // Not enough space in the buffer: synchronize output and try again
-            sync();
-            return overflow(character);
+            char value = static_cast<char>(character);
+            xsputn(&value, 1);
         }
-        else
+
+        return 0;
+    }
+
+    virtual std::streamsize xsputn(const char* data, std::streamsize size)
+    {
+        std::string& line = getLine();
+
+        for (std::streamsize i = 0; i < size; ++i)
         {
-            // Invalid character: synchronize output
-            return sync();
+            if (data[i] == '\n')
+            {
+                // Warnings are logged with an explicit level, everything written here is an error
+                sf::Log::write(sf::Log::Error, "sfml", line);
+                line.clear();
+            }
+            else
+            {
+                line += data[i];
+            }
         }
+
+        return size;
     }
 
-    virtual int sync()
+    // Get the line being written by the calling thread
+    std::string& getLine()
     {
-        // Check if there is something into the write buffer
-        if (pbase() != pptr())
+        std::string* line = m_line;
+        if (!line)
         {
-            // Print the contents of the write buffer into the standard error output
-            std::size_t size = static_cast<int>(pptr() - pbase());
-            fwrite(pbase(), 1, size, stderr);
-
-            // Reset the pointer position to the beginning of the write buffer
-            setp(pbase(), epptr());
+            // Never destroyed, like the thread-local pointer which refers to it
+            line = new std::string;
+            m_line = line;
         }
 
-        return 0;
+        return *line;
     }
+
+    sf::ThreadLocalPtr<std::string> m_line;
 };
 }
 
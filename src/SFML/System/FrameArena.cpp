@@ -0,0 +1,216 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/FrameArena.hpp>
+#include <SFML/System/Allocator.hpp>
+#include <SFML/System/ThreadLocalPtr.hpp>
+#include <algorithm>
+#include <new>
+
+
+namespace
+{
+    // Arenas of the threads, never destroyed since a thread may still use its arena at exit
+    sf::ThreadLocalPtr<sf::FrameArena> threadArena;
+
+    // Size of the header of a block, rounded so that the data keeps the default alignment
+    const std::size_t headerSize = sf::FrameArena::DefaultAlignment;
+
+    // Allocate a block through the allocator hooks, failing like operator new does
+    void* allocateBlock(std::size_t size)
+    {
+        void* block = sf::Allocator::allocate(size, sf::Allocator::General);
+        if (!block)
+            throw std::bad_alloc();
+
+        return block;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+FrameArena::FrameArena(std::size_t blockSize) :
+m_blockSize     (blockSize),
+m_first         (NULL),
+m_current       (NULL),
+m_offset        (0),
+m_previousBlocks(0),
+m_frameSize     (0),
+m_lastFrameSize (0),
+m_peakSize      (0),
+m_capacity      (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+FrameArena::~FrameArena()
+{
+    while (m_first)
+    {
+        Block* next = m_first->next;
+        Allocator::deallocate(m_first, Allocator::General);
+        m_first = next;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void* FrameArena::allocate(std::size_t size, std::size_t alignment)
+{
+    // Align the first free byte of the current block
+    std::size_t padding = 0;
+    if (m_current)
+    {
+        std::size_t address = reinterpret_cast<std::size_t>(getBlockData(m_current) + m_offset);
+        padding = (alignment - address % alignment) % alignment;
+    }
+
+    // Chain a new block if the allocation doesn't fit in the current one
+    if (!m_current || (m_offset + padding + size > m_current->size))
+    {
+        std::size_t blockSize = std::max(m_blockSize, size + alignment);
+        Block* block = static_cast<Block*>(allocateBlock(headerSize + blockSize));
+        block->next = NULL;
+        block->size = blockSize;
+
+        if (m_current)
+        {
+            m_current->next = block;
+            m_previousBlocks += m_offset;
+        }
+        else
+        {
+            m_first = block;
+        }
+
+        m_current = block;
+        m_offset = 0;
+        m_capacity += blockSize;
+
+        std::size_t address = reinterpret_cast<std::size_t>(getBlockData(block));
+        padding = (alignment - address % alignment) % alignment;
+    }
+
+    char* data = getBlockData(m_current) + m_offset + padding;
+    m_offset += padding + size;
+
+    // Update the usage counters
+    std::size_t used = getUsedSize();
+    m_frameSize = std::max(m_frameSize, used);
+    m_peakSize = std::max(m_peakSize, used);
+
+    return data;
+}
+
+
+////////////////////////////////////////////////////////////
+void FrameArena::deallocate(void* data, std::size_t size)
+{
+    // Only the last allocation can be taken back
+    if (m_current && (static_cast<char*>(data) + size == getBlockData(m_current) + m_offset))
+        m_offset = static_cast<std::size_t>(static_cast<char*>(data) - getBlockData(m_current));
+}
+
+
+////////////////////////////////////////////////////////////
+void FrameArena::reset()
+{
+    // If the frame needed several blocks, replace them with a single one large enough for all of them
+    if (m_first && m_first->next)
+    {
+        while (m_first)
+        {
+            Block* next = m_first->next;
+            Allocator::deallocate(m_first, Allocator::General);
+            m_first = next;
+        }
+
+        m_first = static_cast<Block*>(allocateBlock(headerSize + m_capacity));
+        m_first->next = NULL;
+        m_first->size = m_capacity;
+    }
+
+    m_current = m_first;
+    m_offset = 0;
+    m_previousBlocks = 0;
+    m_lastFrameSize = m_frameSize;
+    m_frameSize = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t FrameArena::getUsedSize() const
+{
+    return m_previousBlocks + m_offset;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t FrameArena::getLastFrameSize() const
+{
+    return m_lastFrameSize;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t FrameArena::getPeakSize() const
+{
+    return m_peakSize;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t FrameArena::getCapacity() const
+{
+    return m_capacity;
+}
+
+
+////////////////////////////////////////////////////////////
+FrameArena& FrameArena::getThreadArena()
+{
+    FrameArena* arena = threadArena;
+    if (!arena)
+    {
+        arena = new FrameArena;
+        threadArena = arena;
+    }
+
+    return *arena;
+}
+
+
+////////////////////////////////////////////////////////////
+char* FrameArena::getBlockData(Block* block)
+{
+    return reinterpret_cast<char*>(block) + headerSize;
+}
+
+} // namespace sf
@@ -0,0 +1,200 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/FramePacer.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Bounds of the margin kept for yielding at the end of the frame,
+    // i.e. of the estimated overshoot of the OS sleep
+    const sf::Time minimumOvershoot = sf::microseconds(250);
+    const sf::Time initialOvershoot = sf::milliseconds(2);
+    const sf::Time maximumOvershoot = sf::milliseconds(20);
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+FramePacer::Statistics::Statistics() :
+frameCount     (0),
+missedDeadlines(0),
+averageDuration(Time::Zero),
+medianDuration (Time::Zero),
+p99Duration    (Time::Zero),
+maximumDuration(Time::Zero)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+FramePacer::FramePacer() :
+m_frameTime      (Time::Zero),
+m_deadline       (Time::Zero),
+m_frameStart     (Time::Zero),
+m_sleepOvershoot (initialOvershoot),
+m_frameCount     (0),
+m_missedDeadlines(0)
+{
+    m_durations.reserve(HistorySize);
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::setFrameTime(Time frameTime)
+{
+    m_frameTime = std::max(frameTime, Time::Zero);
+    restart();
+}
+
+
+////////////////////////////////////////////////////////////
+Time FramePacer::getFrameTime() const
+{
+    return m_frameTime;
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::restart()
+{
+    m_frameStart = m_clock.getElapsedTime();
+    m_deadline = m_frameStart + m_frameTime;
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::wait()
+{
+    Time now = m_clock.getElapsedTime();
+
+    // Without a frame time, we only measure
+    if (m_frameTime == Time::Zero)
+    {
+        recordFrame(now);
+        return;
+    }
+
+    bool missed = now > m_deadline;
+
+    if (!missed)
+    {
+        // Sleep for the coarse part of the remaining time
+        Time remaining = m_deadline - now;
+        if (remaining > m_sleepOvershoot)
+        {
+            Time target = m_deadline - m_sleepOvershoot;
+            sleep(remaining - m_sleepOvershoot);
+            now = m_clock.getElapsedTime();
+
+            // Adapt the margin to the precision of the OS sleep: grow it at once
+            // when a sleep overshoots more than expected, and shrink it slowly
+            Time overshoot = now - target;
+            if (overshoot > m_sleepOvershoot)
+                m_sleepOvershoot = std::min(overshoot + overshoot / Int64(4), maximumOvershoot);
+            else
+                m_sleepOvershoot = std::max(m_sleepOvershoot - (m_sleepOvershoot - overshoot) / Int64(16), minimumOvershoot);
+        }
+
+        // Yield the processor until the exact deadline
+        while (now < m_deadline)
+        {
+            sleep(Time::Zero);
+            now = m_clock.getElapsedTime();
+        }
+    }
+    else
+    {
+        ++m_missedDeadlines;
+    }
+
+    recordFrame(now);
+
+    // Keep the deadlines on a regular grid so that small errors don't accumulate,
+    // but don't try to catch up with frames that are more than one frame late
+    if (now - m_deadline > m_frameTime)
+        m_deadline = now + m_frameTime;
+    else
+        m_deadline += m_frameTime;
+}
+
+
+////////////////////////////////////////////////////////////
+FramePacer::Statistics FramePacer::getStatistics() const
+{
+    Statistics statistics;
+    statistics.frameCount = m_frameCount;
+    statistics.missedDeadlines = m_missedDeadlines;
+
+    if (!m_durations.empty())
+    {
+        std::vector<Time> durations(m_durations);
+        std::sort(durations.begin(), durations.end());
+
+        Int64 total = 0;
+        for (std::vector<Time>::const_iterator it = durations.begin(); it != durations.end(); ++it)
+            total += it->asMicroseconds();
+
+        std::size_t count = durations.size();
+        statistics.averageDuration = microseconds(total / static_cast<Int64>(count));
+        statistics.medianDuration = durations[count / 2];
+        statistics.p99Duration = durations[std::min(count * 99 / 100, count - 1)];
+        statistics.maximumDuration = durations.back();
+    }
+
+    return statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::resetStatistics()
+{
+    m_frameCount = 0;
+    m_missedDeadlines = 0;
+    m_durations.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::recordFrame(Time now)
+{
+    Time duration = now - m_frameStart;
+    m_frameStart = now;
+
+    // Overwrite the oldest duration once the history is full
+    if (m_durations.size() < HistorySize)
+        m_durations.push_back(duration);
+    else
+        m_durations[m_frameCount % HistorySize] = duration;
+
+    ++m_frameCount;
+}
+
+} // namespace sf
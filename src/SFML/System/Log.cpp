@@ -0,0 +1,425 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Log.hpp>
+#include <SFML/System/AtomicInt.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/ConditionVariable.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/MpmcQueue.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Semaphore.hpp>
+#include <SFML/System/SharedMutex.hpp>
+#include <SFML/System/Thread.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <map>
+
+
+namespace
+{
+    // Maximum number of messages waiting to be written
+    const std::size_t queueCapacity = 4096;
+
+    // Message waiting to be written
+    struct Message
+    {
+        sf::Log::Level level;
+        std::string    category;
+        std::string    text;
+    };
+
+    // Occurrences of a distinct message in the current rate limiting period
+    struct Repeats
+    {
+        sf::Int64    periodStart;
+        unsigned int count;
+        unsigned int suppressed;
+    };
+
+    // Filters, read by every thread
+    sf::AtomicInt                  globalLevel(sf::Log::Info);
+    sf::AtomicInt                  minimumLevel(sf::Log::Info); // lowest of the global and category levels
+    sf::AtomicInt                  hasCategoryLevels(0);
+    sf::SharedMutex                categoryMutex;
+    std::map<std::string, int>     categoryLevels;
+
+    // Queue of the messages, filled by every thread and emptied by the writer thread
+    sf::MpmcQueue<Message*>        queue(queueCapacity);
+    sf::Semaphore                  wakeUp;
+    sf::AtomicInt                  pushed(0);
+    sf::AtomicInt                  dropped(0);
+    sf::AtomicInt                  asynchronous(0);
+    sf::AtomicInt                  started(0);
+    sf::AtomicInt                  stopped(0);
+    sf::Mutex                      startMutex;
+    sf::Thread*                    writer = NULL;
+
+    // State of the writer thread, protected by the mutex
+    sf::Mutex                      writerMutex;
+    sf::ConditionVariable          writtenCondition;
+    sf::Int32                      written = 0;
+    std::ostream*                  output = NULL;
+    unsigned int                   rateCount = 0;
+    sf::Time                       ratePeriod = sf::seconds(1);
+    sf::Clock                      rateClock;
+    std::map<std::string, Repeats> repeats;
+
+    // Write a line to the output (the writer mutex must be locked, unless the writer is stopped)
+    void writeLine(const std::string& category, const std::string& text)
+    {
+        std::string line = "[" + category + "] " + text + "\n";
+
+        if (output)
+            output->write(line.data(), static_cast<std::streamsize>(line.size()));
+        else
+            std::fwrite(line.data(), 1, line.size(), stderr);
+    }
+
+    // Make sure that the lines written so far reach their destination
+    void flushOutput()
+    {
+        if (output)
+            output->flush();
+        else
+            std::fflush(stderr);
+    }
+
+    // Write the number of times the messages were suppressed, for the periods which have ended
+    void endPeriods(bool all)
+    {
+        sf::Int64 now = rateClock.getElapsedTime().asMicroseconds();
+
+        std::map<std::string, Repeats>::iterator it = repeats.begin();
+        while (it != repeats.end())
+        {
+            if (all || (now - it->second.periodStart >= ratePeriod.asMicroseconds()))
+            {
+                if (it->second.suppressed > 0)
+                {
+                    // The key is the level, the category, a null character and the text
+                    std::string::size_type separator = it->first.find('\0', 1);
+                    std::ostringstream text;
+                    text << it->first.substr(separator + 1) << " (repeated " << it->second.suppressed << " more times)";
+                    writeLine(it->first.substr(1, separator - 1), text.str());
+                }
+
+                repeats.erase(it++);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    // Write a message unless it was repeated too often
+    void process(const Message& message)
+    {
+        if (rateCount == 0)
+        {
+            writeLine(message.category, message.text);
+            return;
+        }
+
+        std::string key = static_cast<char>('0' + message.level) + message.category + '\0' + message.text;
+        std::map<std::string, Repeats>::iterator it = repeats.find(key);
+        if (it == repeats.end())
+        {
+            Repeats occurrences = {rateClock.getElapsedTime().asMicroseconds(), 0, 0};
+            it = repeats.insert(std::make_pair(key, occurrences)).first;
+        }
+
+        if (it->second.count < rateCount)
+        {
+            ++it->second.count;
+            writeLine(message.category, message.text);
+        }
+        else
+        {
+            ++it->second.suppressed;
+        }
+    }
+
+    // Entry point of the writer thread
+    void writeMessages()
+    {
+        bool periodsRunning = false;
+        for (;;)
+        {
+            // Wake up regularly while some rate limiting periods are running, to end them
+            if (periodsRunning)
+                wakeUp.wait(sf::milliseconds(100));
+            else
+                wakeUp.wait();
+
+            sf::Lock lock(writerMutex);
+
+            Message* message;
+            while (queue.pop(message))
+            {
+                process(*message);
+                delete message;
+                ++written;
+            }
+
+            sf::Int32 lost = dropped.exchange(0);
+            if (lost > 0)
+            {
+                std::ostringstream text;
+                text << lost << " messages were dropped (the queue was full)";
+                writeLine("log", text.str());
+            }
+
+            bool stopping = (stopped.load() != 0);
+            endPeriods(stopping);
+            flushOutput();
+
+            writtenCondition.notifyAll();
+            periodsRunning = !repeats.empty();
+
+            if (stopping)
+                break;
+        }
+    }
+
+    // Stops the writer thread at exit, once all the messages are written
+    struct WriterShutdown
+    {
+        ~WriterShutdown()
+        {
+            {
+                sf::Lock lock(startMutex);
+                stopped.store(1);
+            }
+
+            if (writer)
+            {
+                wakeUp.post();
+                writer->wait();
+                delete writer;
+                writer = NULL;
+            }
+
+            // Report the messages suppressed by the synchronous writes
+            sf::Lock lock(writerMutex);
+            endPeriods(true);
+            flushOutput();
+        }
+    };
+
+    WriterShutdown writerShutdown;
+
+    // Recompute the lowest level which passes a filter (the category mutex must be locked)
+    void updateMinimumLevel()
+    {
+        int minimum = globalLevel.load();
+        for (std::map<std::string, int>::const_iterator it = categoryLevels.begin(); it != categoryLevels.end(); ++it)
+            minimum = std::min(minimum, it->second);
+
+        minimumLevel.store(minimum);
+        hasCategoryLevels.store(categoryLevels.empty() ? 0 : 1);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+void Log::setLevel(Level level)
+{
+    categoryMutex.lock();
+    globalLevel.store(level);
+    updateMinimumLevel();
+    categoryMutex.unlock();
+}
+
+
+////////////////////////////////////////////////////////////
+Log::Level Log::getLevel()
+{
+    return static_cast<Level>(globalLevel.load());
+}
+
+
+////////////////////////////////////////////////////////////
+void Log::setCategoryLevel(const std::string& category, Level level)
+{
+    categoryMutex.lock();
+    categoryLevels[category] = level;
+    updateMinimumLevel();
+    categoryMutex.unlock();
+}
+
+
+////////////////////////////////////////////////////////////
+void Log::resetCategoryLevels()
+{
+    categoryMutex.lock();
+    categoryLevels.clear();
+    updateMinimumLevel();
+    categoryMutex.unlock();
+}
+
+
+////////////////////////////////////////////////////////////
+bool Log::isEnabled(Level level, const char* category)
+{
+    // Fast paths: below all the levels, or no category has its own level
+    if ((level >= None) || (level < minimumLevel.load()))
+        return false;
+
+    if (!hasCategoryLevels.load())
+        return level >= globalLevel.load();
+
+    categoryMutex.lockShared();
+    std::map<std::string, int>::const_iterator it = categoryLevels.find(category);
+    int threshold = (it != categoryLevels.end()) ? it->second : globalLevel.load();
+    categoryMutex.unlockShared();
+
+    return level >= threshold;
+}
+
+
+////////////////////////////////////////////////////////////
+void Log::write(Level level, const char* category, const std::string& message)
+{
+    if (!isEnabled(level, category))
+        return;
+
+    std::string text = message;
+    while (!text.empty() && ((text[text.size() - 1] == '\n') || (text[text.size() - 1] == '\r')))
+        text.erase(text.size() - 1);
+
+    // Once the writer is stopped (at exit), the messages are written immediately
+    if (stopped.load())
+    {
+        writeLine(category, text);
+        return;
+    }
+
+    // Errors, and all the messages unless the log is asynchronous, are written by the calling thread before returning
+    if ((level >= Error) || !asynchronous.load())
+    {
+        // The queued messages come first, to keep the order
+        flush();
+
+        Message message = {level, category, text};
+
+        Lock lock(writerMutex);
+        endPeriods(false);
+        process(message);
+        flushOutput();
+        return;
+    }
+
+    // Start the writer thread with the first queued message
+    if (!started.load())
+    {
+        Lock lock(startMutex);
+        if (!writer && !stopped.load())
+        {
+            writer = new Thread(&writeMessages);
+            writer->launch();
+        }
+        started.store(1);
+    }
+
+    Message* queued = new Message;
+    queued->level = level;
+    queued->category = category;
+    queued->text = text;
+
+    if (queue.push(queued))
+    {
+        ++pushed;
+        wakeUp.post();
+    }
+    else
+    {
+        delete queued;
+        ++dropped;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Log::flush()
+{
+    if (!started.load() || stopped.load())
+        return;
+
+    // Wait until the writer has handled as many messages as were pushed so far
+    Int32 target = pushed.load();
+
+    Lock lock(writerMutex);
+    while ((written - target < 0) && !stopped.load())
+    {
+        wakeUp.post();
+        writtenCondition.wait(writerMutex, milliseconds(10));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Log::setOutput(std::ostream* stream)
+{
+    flush();
+
+    Lock lock(writerMutex);
+    output = stream;
+}
+
+
+////////////////////////////////////////////////////////////
+void Log::setAsynchronous(bool enable)
+{
+    asynchronous.store(enable ? 1 : 0);
+
+    // The messages queued so far are written before this function returns
+    if (!enable)
+        flush();
+}
+
+
+////////////////////////////////////////////////////////////
+bool Log::isAsynchronous()
+{
+    return asynchronous.load() != 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void Log::setRateLimit(unsigned int count, Time period)
+{
+    Lock lock(writerMutex);
+    endPeriods(true);
+    rateCount = count;
+    ratePeriod = period;
+}
+
+} // namespace sf
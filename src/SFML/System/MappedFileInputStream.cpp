@@ -0,0 +1,205 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/MappedFileInputStream.hpp>
+#include <cstring>
+#if defined(SFML_SYSTEM_WINDOWS)
+    #include <windows.h>
+#elif defined(SFML_SYSTEM_ANDROID)
+    #include <SFML/System/Android/ResourceStream.hpp>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+MappedFileInputStream::MappedFileInputStream() :
+m_data  (NULL),
+m_size  (0),
+m_offset(0)
+#ifdef SFML_SYSTEM_ANDROID
+, m_asset(NULL)
+#endif
+{
+}
+
+
+////////////////////////////////////////////////////////////
+MappedFileInputStream::~MappedFileInputStream()
+{
+    close();
+}
+
+
+////////////////////////////////////////////////////////////
+bool MappedFileInputStream::open(const std::string& filename)
+{
+    close();
+
+#if defined(SFML_SYSTEM_WINDOWS)
+
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    // The view keeps the file mapped after its handles are closed
+    LARGE_INTEGER size;
+    HANDLE mapping = NULL;
+    if (GetFileSizeEx(file, &size) && (size.QuadPart > 0))
+        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping)
+    {
+        m_data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        m_size = m_data ? static_cast<std::size_t>(size.QuadPart) : 0;
+        CloseHandle(mapping);
+    }
+    CloseHandle(file);
+
+#elif defined(SFML_SYSTEM_ANDROID)
+
+    // The asset manager maps uncompressed assets from the APK, and inflates the others in one go
+    priv::ResourceStream* asset = new priv::ResourceStream(filename, true);
+    const void* data = asset->getBuffer();
+    Int64 size = data ? asset->getSize() : 0;
+    if (size > 0)
+    {
+        m_asset = asset;
+        m_data = const_cast<void*>(data);
+        m_size = static_cast<std::size_t>(size);
+    }
+    else
+    {
+        delete asset;
+    }
+
+#else
+
+    int file = ::open(filename.c_str(), O_RDONLY);
+    if (file < 0)
+        return false;
+
+    // The mapping stays valid after the file is closed
+    struct stat status;
+    if ((fstat(file, &status) == 0) && (status.st_size > 0))
+    {
+        void* data = mmap(NULL, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        if (data != MAP_FAILED)
+        {
+            m_data = data;
+            m_size = static_cast<std::size_t>(status.st_size);
+        }
+    }
+    ::close(file);
+
+#endif
+
+    return m_data != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+const void* MappedFileInputStream::getData() const
+{
+    return m_data;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 MappedFileInputStream::read(void* data, Int64 size)
+{
+    if (!m_data)
+        return -1;
+
+    Int64 endPosition = m_offset + size;
+    Int64 count = endPosition <= static_cast<Int64>(m_size) ? size : static_cast<Int64>(m_size) - m_offset;
+
+    if (count > 0)
+    {
+        std::memcpy(data, static_cast<const char*>(m_data) + m_offset, static_cast<std::size_t>(count));
+        m_offset += count;
+    }
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 MappedFileInputStream::seek(Int64 position)
+{
+    if (!m_data)
+        return -1;
+
+    m_offset = position < static_cast<Int64>(m_size) ? position : static_cast<Int64>(m_size);
+    return m_offset;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 MappedFileInputStream::tell()
+{
+    if (!m_data)
+        return -1;
+
+    return m_offset;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 MappedFileInputStream::getSize()
+{
+    if (!m_data)
+        return -1;
+
+    return static_cast<Int64>(m_size);
+}
+
+
+////////////////////////////////////////////////////////////
+void MappedFileInputStream::close()
+{
+#if defined(SFML_SYSTEM_WINDOWS)
+    if (m_data)
+        UnmapViewOfFile(m_data);
+#elif defined(SFML_SYSTEM_ANDROID)
+    delete m_asset;
+    m_asset = NULL;
+#else
+    if (m_data)
+        munmap(m_data, m_size);
+#endif
+
+    m_data = NULL;
+    m_size = 0;
+    m_offset = 0;
+}
+
+} // namespace sf
@@ -37,9 +37,9 @@
 namespace sf
 {
 ////////////////////////////////////////////////////////////
-Mutex::Mutex()
+Mutex::Mutex(Type type)
 {
-    m_mutexImpl = new priv::MutexImpl;
+    m_mutexImpl = new priv::MutexImpl(type == Recursive);
 }
 
 
@@ -0,0 +1,312 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Profiler.hpp>
+#include <SFML/System/AtomicInt.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/ThreadLocalPtr.hpp>
+#include <deque>
+#include <fstream>
+
+#if defined(SFML_SYSTEM_WINDOWS)
+    #include <SFML/System/Win32/ClockImpl.hpp>
+#else
+    #include <SFML/System/Unix/ClockImpl.hpp>
+#endif
+
+
+namespace
+{
+    // Zones that a thread can keep before a frame collects them (frames may never end)
+    const std::size_t maxPendingZones = 65536;
+
+    // Zone which has begun but not ended yet
+    struct OpenZone
+    {
+        const char* name;
+        sf::Int64   start;
+    };
+
+    // Zones of a thread
+    struct ThreadZones
+    {
+        ThreadZones(unsigned int threadIndex) : index(threadIndex), mutex(sf::Mutex::Fast) {}
+
+        unsigned int                    index;
+        std::vector<OpenZone>           open;      // only accessed by the owning thread
+        sf::Mutex                       mutex;     // protects the completed zones
+        std::vector<sf::Profiler::Zone> completed;
+    };
+
+    sf::AtomicInt                   enabled(1);
+    sf::ThreadLocalPtr<ThreadZones> currentThread;
+
+    // State shared by all the threads, protected by the mutex
+    sf::Mutex                       profilerMutex;
+    std::vector<ThreadZones*>       threads; // never destroyed, since thread-local pointers refer to them
+    std::vector<sf::Profiler::Zone> addedZones;
+    std::vector<sf::Profiler::Zone> lastFrame;
+    std::deque<sf::Profiler::Zone>  history;
+    std::size_t                     historySize = 1048576;
+    sf::Int64                       frameStart = -1;
+
+    // Get the zones of the calling thread
+    ThreadZones& getThreadZones()
+    {
+        ThreadZones* zones = currentThread;
+        if (!zones)
+        {
+            sf::Lock lock(profilerMutex);
+            zones = new ThreadZones(static_cast<unsigned int>(threads.size()) + 1);
+            threads.push_back(zones);
+            currentThread = zones;
+        }
+
+        return *zones;
+    }
+
+    // Drop the oldest zones of the history
+    void trimHistory()
+    {
+        if (history.size() > historySize)
+            history.erase(history.begin(), history.begin() + (history.size() - historySize));
+    }
+
+    // Write a string as a JSON literal
+    void writeJsonString(std::ostream& stream, const char* string)
+    {
+        static const char hex[] = "0123456789abcdef";
+
+        stream << '"';
+        for (const char* c = string; *c; ++c)
+        {
+            unsigned char value = static_cast<unsigned char>(*c);
+            if ((value == '"') || (value == '\\'))
+                stream << '\\' << *c;
+            else if (value < 0x20)
+                stream << "\\u00" << hex[value >> 4] << hex[value & 15];
+            else
+                stream << *c;
+        }
+        stream << '"';
+    }
+
+    // Write a time in nanoseconds as the fractional microseconds of the trace format
+    void writeMicroseconds(std::ostream& stream, sf::Int64 nanoseconds)
+    {
+        if (nanoseconds < 0)
+        {
+            stream << '-';
+            nanoseconds = -nanoseconds;
+        }
+
+        stream << nanoseconds / 1000 << '.';
+        stream << static_cast<char>('0' + nanoseconds / 100 % 10)
+               << static_cast<char>('0' + nanoseconds / 10 % 10)
+               << static_cast<char>('0' + nanoseconds % 10);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Profiler::Scope::Scope(const char* name) :
+m_recording(Profiler::isEnabled())
+{
+    if (m_recording)
+        Profiler::beginZone(name);
+}
+
+
+////////////////////////////////////////////////////////////
+Profiler::Scope::~Scope()
+{
+    if (m_recording)
+        Profiler::endZone();
+}
+
+
+////////////////////////////////////////////////////////////
+void Profiler::setEnabled(bool enable)
+{
+    enabled.store(enable ? 1 : 0);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Profiler::isEnabled()
+{
+    return enabled.load() != 0;
+}
+
+
+////////////////////////////////////////////////////////////
+Int64 Profiler::getTime()
+{
+    return priv::ClockImpl::getCurrentTime().asNanoseconds();
+}
+
+
+////////////////////////////////////////////////////////////
+void Profiler::beginZone(const char* name)
+{
+    OpenZone zone = {name, getTime()};
+    getThreadZones().open.push_back(zone);
+}
+
+
+////////////////////////////////////////////////////////////
+void Profiler::endZone()
+{
+    Int64 end = getTime();
+
+    ThreadZones& zones = getThreadZones();
+    if (zones.open.empty())
+        return;
+
+    OpenZone open = zones.open.back();
+    zones.open.pop_back();
+
+    Zone zone = {open.name, open.start, end - open.start, zones.index, static_cast<unsigned int>(zones.open.size())};
+
+    Lock lock(zones.mutex);
+    if (zones.completed.size() < maxPendingZones)
+        zones.completed.push_back(zone);
+}
+
+
+////////////////////////////////////////////////////////////
+void Profiler::addZone(const Zone& zone)
+{
+    Lock lock(profilerMutex);
+    if (addedZones.size() < maxPendingZones)
+        addedZones.push_back(zone);
+}
+
+
+////////////////////////////////////////////////////////////
+void Profiler::endFrame()
+{
+    Int64 now = getTime();
+    unsigned int caller = getThreadZones().index;
+
+    Lock lock(profilerMutex);
+
+    lastFrame.clear();
+    if (isEnabled() && (frameStart >= 0))
+    {
+        Zone frame = {"Frame", frameStart, now - frameStart, caller, 0};
+        lastFrame.push_back(frame);
+    }
+    frameStart = now;
+
+    // Collect the zones completed by all the threads since the previous frame
+    for (std::vector<ThreadZones*>::iterator it = threads.begin(); it != threads.end(); ++it)
+    {
+        Lock threadLock((*it)->mutex);
+        lastFrame.insert(lastFrame.end(), (*it)->completed.begin(), (*it)->completed.end());
+        (*it)->completed.clear();
+    }
+    lastFrame.insert(lastFrame.end(), addedZones.begin(), addedZones.end());
+    addedZones.clear();
+
+    history.insert(history.end(), lastFrame.begin(), lastFrame.end());
+    trimHistory();
+}
+
+
+////////////////////////////////////////////////////////////
+void Profiler::getLastFrame(std::vector<Zone>& zones)
+{
+    Lock lock(profilerMutex);
+    zones = lastFrame;
+}
+
+
+////////////////////////////////////////////////////////////
+void Profiler::setHistorySize(std::size_t size)
+{
+    Lock lock(profilerMutex);
+    historySize = size;
+    trimHistory();
+}
+
+
+////////////////////////////////////////////////////////////
+void Profiler::clear()
+{
+    Lock lock(profilerMutex);
+    lastFrame.clear();
+    history.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+bool Profiler::saveChromeTrace(const std::string& filename)
+{
+    std::ofstream file(filename.c_str(), std::ios_base::binary);
+    if (!file)
+    {
+        err() << "Failed to save profiler trace \"" << filename << "\" (cannot open file)" << std::endl;
+        return false;
+    }
+
+    Lock lock(profilerMutex);
+
+    // Name the tracks, then write every zone as a complete event
+    file << "{\"traceEvents\":[\n";
+    file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << static_cast<int>(GpuThread) << ",\"args\":{\"name\":\"GPU\"}}";
+    for (std::size_t i = 0; i < threads.size(); ++i)
+        file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threads[i]->index
+             << ",\"args\":{\"name\":\"Thread " << threads[i]->index << "\"}}";
+
+    for (std::deque<Zone>::const_iterator it = history.begin(); it != history.end(); ++it)
+    {
+        file << ",\n{\"name\":";
+        writeJsonString(file, it->name);
+        file << ",\"ph\":\"X\",\"ts\":";
+        writeMicroseconds(file, it->start);
+        file << ",\"dur\":";
+        writeMicroseconds(file, it->duration);
+        file << ",\"pid\":1,\"tid\":" << it->thread << "}";
+    }
+
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    if (!file)
+    {
+        err() << "Failed to save profiler trace \"" << filename << "\" (write error)" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace sf
@@ -0,0 +1,217 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/ResourceMemory.hpp>
+#include <SFML/System/Log.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <iomanip>
+
+
+namespace
+{
+    // Usage of each category and of all of them, protected by the mutex
+    sf::Mutex                   accountingMutex;
+    sf::ResourceMemory::Usage   usages[sf::ResourceMemory::CategoryCount];
+    sf::ResourceMemory::Usage   total;
+    sf::Uint64                  budgets[sf::ResourceMemory::CategoryCount] = {0};
+
+    // Apply a change to a counter, without wrapping below zero if the accounting is unbalanced
+    void apply(sf::Uint64& counter, sf::Int64 change)
+    {
+        if ((change < 0) && (static_cast<sf::Uint64>(-change) > counter))
+            counter = 0;
+        else
+            counter += static_cast<sf::Uint64>(change);
+    }
+
+    // Apply a change to a usage and update its peaks
+    void apply(sf::ResourceMemory::Usage& usage, sf::Int64 objects, sf::Int64 deviceBytes, sf::Int64 hostBytes)
+    {
+        apply(usage.objects, objects);
+        apply(usage.deviceBytes, deviceBytes);
+        apply(usage.hostBytes, hostBytes);
+
+        if (usage.deviceBytes > usage.peakDeviceBytes)
+            usage.peakDeviceBytes = usage.deviceBytes;
+        if (usage.hostBytes > usage.peakHostBytes)
+            usage.peakHostBytes = usage.hostBytes;
+    }
+
+    // Write a size in kilobytes, in a column of the dump
+    void writeSize(std::ostream& stream, sf::Uint64 bytes)
+    {
+        stream << std::setw(12) << (bytes + 1023) / 1024;
+    }
+
+    // Write a line of the dump
+    void writeUsage(std::ostream& stream, const char* name, const sf::ResourceMemory::Usage& usage)
+    {
+        stream << std::left << std::setw(16) << name << std::right << std::setw(8) << usage.objects;
+        writeSize(stream, usage.deviceBytes);
+        writeSize(stream, usage.peakDeviceBytes);
+        writeSize(stream, usage.hostBytes);
+        writeSize(stream, usage.peakHostBytes);
+        stream << '\n';
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ResourceMemory::Usage::Usage() :
+objects        (0),
+deviceBytes    (0),
+hostBytes      (0),
+peakDeviceBytes(0),
+peakHostBytes  (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ResourceMemory::Usage ResourceMemory::getUsage(Category category)
+{
+    Lock lock(accountingMutex);
+    return usages[category];
+}
+
+
+////////////////////////////////////////////////////////////
+ResourceMemory::Usage ResourceMemory::getTotalUsage()
+{
+    Lock lock(accountingMutex);
+    return total;
+}
+
+
+////////////////////////////////////////////////////////////
+void ResourceMemory::resetPeaks()
+{
+    Lock lock(accountingMutex);
+
+    for (int i = 0; i < CategoryCount; ++i)
+    {
+        usages[i].peakDeviceBytes = usages[i].deviceBytes;
+        usages[i].peakHostBytes = usages[i].hostBytes;
+    }
+
+    total.peakDeviceBytes = total.deviceBytes;
+    total.peakHostBytes = total.hostBytes;
+}
+
+
+////////////////////////////////////////////////////////////
+void ResourceMemory::setBudget(Category category, Uint64 bytes)
+{
+    Lock lock(accountingMutex);
+    budgets[category] = bytes;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 ResourceMemory::getBudget(Category category)
+{
+    Lock lock(accountingMutex);
+    return budgets[category];
+}
+
+
+////////////////////////////////////////////////////////////
+bool ResourceMemory::isOverBudget(Category category)
+{
+    Lock lock(accountingMutex);
+    return budgets[category] && (usages[category].deviceBytes + usages[category].hostBytes > budgets[category]);
+}
+
+
+////////////////////////////////////////////////////////////
+void ResourceMemory::dump(std::ostream& stream)
+{
+    Usage copies[CategoryCount];
+    Usage totalCopy;
+    {
+        Lock lock(accountingMutex);
+        for (int i = 0; i < CategoryCount; ++i)
+            copies[i] = usages[i];
+        totalCopy = total;
+    }
+
+    stream << std::left << std::setw(16) << "Category" << std::right << std::setw(8) << "Objects"
+           << std::setw(12) << "Device KB" << std::setw(12) << "Peak" << std::setw(12) << "Host KB" << std::setw(12) << "Peak" << '\n';
+
+    for (int i = 0; i < CategoryCount; ++i)
+        writeUsage(stream, getName(static_cast<Category>(i)), copies[i]);
+
+    writeUsage(stream, "Total", totalCopy);
+    stream.flush();
+}
+
+
+////////////////////////////////////////////////////////////
+const char* ResourceMemory::getName(Category category)
+{
+    switch (category)
+    {
+        case Textures:       return "Textures";
+        case RenderTextures: return "RenderTextures";
+        case Fonts:          return "Fonts";
+        case Shaders:        return "Shaders";
+        case SoundBuffers:   return "SoundBuffers";
+        default:             return "Unknown";
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ResourceMemory::record(Category category, Int64 objects, Int64 deviceBytes, Int64 hostBytes)
+{
+    if ((category < 0) || (category >= CategoryCount))
+        return;
+
+    Uint64 budget = 0;
+    Uint64 used = 0;
+    {
+        Lock lock(accountingMutex);
+
+        Usage& usage = usages[category];
+        Uint64 before = usage.deviceBytes + usage.hostBytes;
+        apply(usage, objects, deviceBytes, hostBytes);
+        apply(total, objects, deviceBytes, hostBytes);
+
+        // Warn only when the budget is crossed, not on every allocation above it
+        used = usage.deviceBytes + usage.hostBytes;
+        if (budgets[category] && (before <= budgets[category]) && (used > budgets[category]))
+            budget = budgets[category];
+    }
+
+    if (budget)
+        SFML_LOG(Log::Warning, "sfml", "Warning: memory budget of " << getName(category) << " exceeded (" << used / 1024
+                                       << " KB used, budget of " << budget / 1024 << " KB)");
+}
+
+} // namespace sf
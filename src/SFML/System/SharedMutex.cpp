@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/SharedMutex.hpp>
+#include <SFML/System/Lock.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SharedMutex::SharedMutex() :
+m_mutex         (Mutex::Fast),
+m_readers       (0),
+m_waitingWriters(0),
+m_writing       (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void SharedMutex::lock()
+{
+    Lock lock(m_mutex);
+
+    m_waitingWriters++;
+    while (m_writing || (m_readers > 0))
+        m_writerAllowed.wait(m_mutex);
+    m_waitingWriters--;
+
+    m_writing = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SharedMutex::unlock()
+{
+    Lock lock(m_mutex);
+
+    m_writing = false;
+
+    // Writers first, then all the readers at once
+    if (m_waitingWriters > 0)
+        m_writerAllowed.notifyOne();
+    else
+        m_readersAllowed.notifyAll();
+}
+
+
+////////////////////////////////////////////////////////////
+void SharedMutex::lockShared()
+{
+    Lock lock(m_mutex);
+
+    while (m_writing || (m_waitingWriters > 0))
+        m_readersAllowed.wait(m_mutex);
+
+    m_readers++;
+}
+
+
+////////////////////////////////////////////////////////////
+void SharedMutex::unlockShared()
+{
+    Lock lock(m_mutex);
+
+    m_readers--;
+    if ((m_readers == 0) && (m_waitingWriters > 0))
+        m_writerAllowed.notifyOne();
+}
+
+} // namespace sf
@@ -27,6 +27,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/System/String.hpp>
 #include <SFML/System/Utf.hpp>
+#include <algorithm>
 #include <iterator>
 #include <cstring>
 
@@ -174,6 +175,22 @@ std::wstring String::toWideString() const
 }
 
 
+////////////////////////////////////////////////////////////
+String String::fromUtf8(const char* begin, const char* end)
+{
+    String string;
+    if (begin < end)
+    {
+        // Every character uses at least one byte, so the input size is an upper bound
+        string.m_string.resize(static_cast<std::size_t>(end - begin));
+        Uint32* last = Utf8::toUtf32(begin, end, &string.m_string[0]);
+        string.m_string.resize(static_cast<std::size_t>(last - string.m_string.data()));
+    }
+
+    return string;
+}
+
+
 ////////////////////////////////////////////////////////////
 std::basic_string<Uint8> String::toUtf8() const
 {
@@ -181,8 +198,15 @@ std::basic_string<Uint8> String::toUtf8() const
     std::basic_string<Uint8> output;
     output.reserve(m_string.length());
 
-    // Convert
-    Utf32::toUtf8(m_string.begin(), m_string.end(), std::back_inserter(output));
+    // Convert by chunks, so that the worst case of 4 bytes per character fits in a small buffer
+    const std::size_t chunkSize = 256;
+    Uint8 buffer[chunkSize * 4];
+    for (std::size_t i = 0; i < m_string.length(); i += chunkSize)
+    {
+        const Uint32* begin = m_string.data() + i;
+        const Uint32* end   = begin + std::min(chunkSize, m_string.length() - i);
+        output.append(buffer, Utf32::toUtf8(begin, end, buffer));
+    }
 
     return output;
 }
@@ -0,0 +1,425 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/TaskScheduler.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Semaphore.hpp>
+#include <SFML/System/ThreadLocal.hpp>
+#include <algorithm>
+#include <deque>
+
+#if defined(SFML_SYSTEM_WINDOWS)
+    #include <windows.h>
+#else
+    #include <unistd.h>
+#endif
+
+
+namespace
+{
+    // Worker of the calling thread, if any
+    sf::ThreadLocal currentWorker;
+
+    // Remove a pointer from a vector, if present
+    template <typename T>
+    void erase(std::vector<T*>& vector, T* value)
+    {
+        vector.erase(std::remove(vector.begin(), vector.end(), value), vector.end());
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct TaskScheduler::Sleeper
+{
+    Semaphore semaphore; ///< Semaphore posted to wake up the thread
+};
+
+
+////////////////////////////////////////////////////////////
+struct TaskScheduler::Task
+{
+    TaskId                id;            ///< Identifier of the task
+    priv::ThreadFunc*     function;      ///< Function to run, NULL for joining tasks
+    unsigned int          dependencies;  ///< Number of unfinished tasks to wait for
+    std::vector<Task*>    continuations; ///< Tasks waiting for this one
+    std::vector<Sleeper*> waiters;       ///< Threads waiting for this task in wait()
+};
+
+
+////////////////////////////////////////////////////////////
+struct TaskScheduler::Worker
+{
+    void run() {owner->work(this);}
+
+    TaskScheduler*    owner;   ///< Scheduler owning the worker
+    std::size_t       index;   ///< Index of the worker in the scheduler
+    Thread*           thread;  ///< Thread of the worker
+    std::deque<Task*> tasks;   ///< Queue of the worker: popped at the back by the worker, stolen at the front by the others
+    Mutex             mutex;   ///< Mutex protecting the queue
+    Sleeper           sleeper; ///< Used when the worker has nothing to do
+};
+
+
+////////////////////////////////////////////////////////////
+TaskScheduler::TaskScheduler(unsigned int workerCount) :
+m_nextId   (1),
+m_nextQueue(0),
+m_stopping (false)
+{
+    if (workerCount == 0)
+        workerCount = getCoreCount();
+
+    for (unsigned int i = 0; i < workerCount; ++i)
+    {
+        Worker* worker = new Worker;
+        worker->owner = this;
+        worker->index = i;
+        worker->thread = new Thread(&Worker::run, worker);
+        m_workers.push_back(worker);
+    }
+
+    // Workers steal from each other, so they must all exist before any starts
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+        (*it)->thread->launch();
+}
+
+
+////////////////////////////////////////////////////////////
+TaskScheduler::~TaskScheduler()
+{
+    waitAll();
+
+    {
+        Lock lock(m_mutex);
+        m_stopping = true;
+        for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+            (*it)->sleeper.semaphore.post();
+    }
+
+    // Stopping workers may still look into the queues of the others, so delete them only once all have stopped
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+        (*it)->thread->wait();
+
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+    {
+        delete (*it)->thread;
+        delete *it;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+TaskScheduler::TaskId TaskScheduler::join(const std::vector<TaskId>& tasks)
+{
+    Task* task = new Task;
+    task->function = NULL;
+    task->dependencies = 0;
+
+    Lock lock(m_mutex);
+    task->id = m_nextId++;
+    for (std::vector<TaskId>::const_iterator it = tasks.begin(); it != tasks.end(); ++it)
+    {
+        TaskTable::iterator dependency = m_tasks.find(*it);
+        if (dependency != m_tasks.end())
+        {
+            dependency->second->continuations.push_back(task);
+            task->dependencies++;
+        }
+    }
+
+    // If everything is already finished, so is the joining task
+    TaskId id = task->id;
+    if (task->dependencies == 0)
+        delete task;
+    else
+        m_tasks[id] = task;
+
+    return id;
+}
+
+
+////////////////////////////////////////////////////////////
+bool TaskScheduler::isFinished(TaskId task) const
+{
+    Lock lock(m_mutex);
+    return m_tasks.find(task) == m_tasks.end();
+}
+
+
+////////////////////////////////////////////////////////////
+void TaskScheduler::wait(TaskId task)
+{
+    Worker* worker = getCurrentWorker();
+    Sleeper local;
+    Sleeper& sleeper = worker ? worker->sleeper : local;
+
+    for (;;)
+    {
+        {
+            Lock lock(m_mutex);
+            if (m_tasks.find(task) == m_tasks.end())
+                return;
+        }
+
+        // Help while waiting
+        Task* other = take(worker);
+        if (other)
+        {
+            run(other);
+            continue;
+        }
+
+        // Nothing to run: sleep until the task finishes or a new task is scheduled.
+        // Registering before checking the queues again ensures that no wake-up is missed.
+        {
+            Lock lock(m_mutex);
+            TaskTable::iterator it = m_tasks.find(task);
+            if (it == m_tasks.end())
+                return;
+            it->second->waiters.push_back(&sleeper);
+            m_sleepers.push_back(&sleeper);
+        }
+
+        other = take(worker);
+        if (!other)
+            sleeper.semaphore.wait();
+
+        {
+            Lock lock(m_mutex);
+            erase(m_sleepers, &sleeper);
+            TaskTable::iterator it = m_tasks.find(task);
+            if (it != m_tasks.end())
+                erase(it->second->waiters, &sleeper);
+        }
+
+        if (other)
+            run(other);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TaskScheduler::waitAll()
+{
+    for (;;)
+    {
+        TaskId task;
+        {
+            Lock lock(m_mutex);
+            if (m_tasks.empty())
+                return;
+            task = m_tasks.begin()->first;
+        }
+
+        wait(task);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TaskScheduler::getWorkerCount() const
+{
+    return static_cast<unsigned int>(m_workers.size());
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TaskScheduler::getCoreCount()
+{
+#if defined(SFML_SYSTEM_WINDOWS)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    long count = static_cast<long>(info.dwNumberOfProcessors);
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+
+    return count > 0 ? static_cast<unsigned int>(count) : 1;
+}
+
+
+////////////////////////////////////////////////////////////
+TaskScheduler::TaskId TaskScheduler::push(priv::ThreadFunc* function, TaskId dependency)
+{
+    Task* task = new Task;
+    task->function = function;
+    task->dependencies = 0;
+
+    Lock lock(m_mutex);
+    task->id = m_nextId++;
+    m_tasks[task->id] = task;
+
+    TaskTable::iterator it = dependency ? m_tasks.find(dependency) : m_tasks.end();
+    if (it != m_tasks.end())
+    {
+        it->second->continuations.push_back(task);
+        task->dependencies = 1;
+    }
+    else
+    {
+        schedule(task);
+    }
+
+    return task->id;
+}
+
+
+////////////////////////////////////////////////////////////
+void TaskScheduler::schedule(Task* task)
+{
+    // Keep the tasks added by a task on its worker, spread the others
+    Worker* worker = getCurrentWorker();
+    if (!worker)
+    {
+        worker = m_workers[m_nextQueue];
+        m_nextQueue = (m_nextQueue + 1) % m_workers.size();
+    }
+
+    {
+        Lock lock(worker->mutex);
+        worker->tasks.push_back(task);
+    }
+
+    if (!m_sleepers.empty())
+    {
+        m_sleepers.back()->semaphore.post();
+        m_sleepers.pop_back();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+TaskScheduler::Task* TaskScheduler::take(Worker* worker)
+{
+    // Newest task of our own queue first, as its data is likely still in the cache
+    if (worker)
+    {
+        Lock lock(worker->mutex);
+        if (!worker->tasks.empty())
+        {
+            Task* task = worker->tasks.back();
+            worker->tasks.pop_back();
+            return task;
+        }
+    }
+
+    // Then steal the oldest task of another queue
+    std::size_t start = worker ? worker->index + 1 : 0;
+    for (std::size_t i = 0; i < m_workers.size(); ++i)
+    {
+        Worker* victim = m_workers[(start + i) % m_workers.size()];
+        if (victim == worker)
+            continue;
+
+        Lock lock(victim->mutex);
+        if (!victim->tasks.empty())
+        {
+            Task* task = victim->tasks.front();
+            victim->tasks.pop_front();
+            return task;
+        }
+    }
+
+    return NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void TaskScheduler::run(Task* task)
+{
+    if (task->function)
+    {
+        task->function->run();
+        delete task->function;
+    }
+
+    Lock lock(m_mutex);
+    m_tasks.erase(task->id);
+
+    for (std::vector<Task*>::iterator it = task->continuations.begin(); it != task->continuations.end(); ++it)
+    {
+        if (--(*it)->dependencies == 0)
+            schedule(*it);
+    }
+
+    for (std::vector<Sleeper*>::iterator it = task->waiters.begin(); it != task->waiters.end(); ++it)
+        (*it)->semaphore.post();
+
+    delete task;
+}
+
+
+////////////////////////////////////////////////////////////
+TaskScheduler::Worker* TaskScheduler::getCurrentWorker() const
+{
+    Worker* worker = static_cast<Worker*>(currentWorker.getValue());
+    return worker && (worker->owner == this) ? worker : NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void TaskScheduler::work(Worker* worker)
+{
+    currentWorker.setValue(worker);
+
+    for (;;)
+    {
+        Task* task = take(worker);
+        if (task)
+        {
+            run(task);
+            continue;
+        }
+
+        // Registering before checking the queues again ensures that no wake-up is missed
+        {
+            Lock lock(m_mutex);
+            if (m_stopping)
+                break;
+            m_sleepers.push_back(&worker->sleeper);
+        }
+
+        task = take(worker);
+        if (!task)
+            worker->sleeper.semaphore.wait();
+
+        {
+            Lock lock(m_mutex);
+            erase(m_sleepers, &worker->sleeper);
+        }
+
+        if (task)
+            run(task);
+    }
+
+    currentWorker.setValue(NULL);
+}
+
+} // namespace sf
@@ -77,6 +77,62 @@ void Thread::terminate()
 }
 
 
+////////////////////////////////////////////////////////////
+void Thread::setPriority(Priority priority)
+{
+    m_priority = priority;
+}
+
+
+////////////////////////////////////////////////////////////
+Thread::Priority Thread::getPriority() const
+{
+    return m_priority;
+}
+
+
+////////////////////////////////////////////////////////////
+void Thread::setAffinity(Uint64 mask)
+{
+    m_affinity = mask;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Thread::getAffinity() const
+{
+    return m_affinity;
+}
+
+
+////////////////////////////////////////////////////////////
+void Thread::setName(const std::string& name)
+{
+    m_name = name;
+}
+
+
+////////////////////////////////////////////////////////////
+const std::string& Thread::getName() const
+{
+    return m_name;
+}
+
+
+////////////////////////////////////////////////////////////
+void Thread::setStackSize(std::size_t size)
+{
+    m_stackSize = size;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Thread::getStackSize() const
+{
+    return m_stackSize;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Thread::run()
 {
@@ -46,15 +46,24 @@ Time ClockImpl::getCurrentTime()
     static mach_timebase_info_data_t frequency = {0, 0};
     if (frequency.denom == 0)
         mach_timebase_info(&frequency);
-    Uint64 nanoseconds = mach_absolute_time() * frequency.numer / frequency.denom;
-    return sf::microseconds(nanoseconds / 1000);
+
+    // The ticks are nanoseconds on Intel; elsewhere they are converted
+    // in two parts, so that the multiplication can't overflow
+    Uint64 ticks = mach_absolute_time();
+    if (frequency.numer == frequency.denom)
+        return sf::nanoseconds(static_cast<Int64>(ticks));
+
+    Uint64 nanoseconds = ticks / frequency.denom * frequency.numer + ticks % frequency.denom * frequency.numer / frequency.denom;
+    return sf::nanoseconds(static_cast<Int64>(nanoseconds));
 
 #else
 
-    // POSIX implementation
+    // POSIX implementation; CLOCK_MONOTONIC is read in user space (vDSO) on Linux
+    // and the BSDs, while CLOCK_MONOTONIC_RAW only is since Linux 5.3 and would be
+    // a system call on older kernels
     timespec time;
     clock_gettime(CLOCK_MONOTONIC, &time);
-    return sf::microseconds(static_cast<Uint64>(time.tv_sec) * 1000000 + time.tv_nsec / 1000);
+    return sf::nanoseconds(static_cast<Int64>(time.tv_sec) * 1000000000 + time.tv_nsec);
 
 #endif
 }
@@ -33,14 +33,27 @@ namespace sf
 namespace priv
 {
 ////////////////////////////////////////////////////////////
-MutexImpl::MutexImpl()
+MutexImpl::MutexImpl(bool recursive)
 {
-    // Make it recursive to follow the expected behavior
     pthread_mutexattr_t attributes;
     pthread_mutexattr_init(&attributes);
-    pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+
+    if (recursive)
+    {
+        pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+    }
+    else
+    {
+        // glibc's adaptive mutexes spin for a while before sleeping
+        #if defined(PTHREAD_ADAPTIVE_MUTEX_INITIALIZER_NP)
+            pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_ADAPTIVE_NP);
+        #else
+            pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_DEFAULT);
+        #endif
+    }
 
     pthread_mutex_init(&m_mutex, &attributes);
+    pthread_mutexattr_destroy(&attributes);
 }
 
 
@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SEMAPHOREIMPL_HPP
+#define SFML_SEMAPHOREIMPL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+#include <pthread.h>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Unix implementation of counting semaphores
+////////////////////////////////////////////////////////////
+class SemaphoreImpl : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param count Initial count
+    ///
+    ////////////////////////////////////////////////////////////
+    SemaphoreImpl(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SemaphoreImpl();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Increment the count, waking up a waiting thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void post();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the count is positive, then decrement it
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the count is positive or a timeout expires
+    ///
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return True if the count was decremented, false on timeout
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wait(Time timeout);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    pthread_mutex_t m_mutex;     ///< Mutex protecting the count
+    pthread_cond_t  m_condition; ///< Condition signaled when the count is incremented
+    unsigned int    m_count;     ///< Number of pending posts
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SEMAPHOREIMPL_HPP
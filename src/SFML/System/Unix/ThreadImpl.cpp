@@ -27,8 +27,18 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/System/Unix/ThreadImpl.hpp>
 #include <SFML/System/Thread.hpp>
+#include <algorithm>
 #include <iostream>
 #include <cassert>
+#include <climits>
+#include <sched.h>
+#include <unistd.h>
+#if defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_ANDROID)
+    #include <sys/resource.h>
+    #include <sys/syscall.h>
+#elif defined(SFML_SYSTEM_FREEBSD)
+    #include <pthread_np.h>
+#endif
 
 
 namespace sf
@@ -39,7 +49,19 @@ namespace priv
 ThreadImpl::ThreadImpl(Thread* owner) :
 m_isActive(true)
 {
-    m_isActive = pthread_create(&m_thread, NULL, &ThreadImpl::entryPoint, owner) == 0;
+    pthread_attr_t attributes;
+    pthread_attr_init(&attributes);
+
+    // Some systems require a whole number of pages, and all have a minimum size
+    if (owner->m_stackSize > 0)
+    {
+        std::size_t pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        std::size_t stackSize = std::max(owner->m_stackSize, static_cast<std::size_t>(PTHREAD_STACK_MIN));
+        pthread_attr_setstacksize(&attributes, (stackSize + pageSize - 1) / pageSize * pageSize);
+    }
+
+    m_isActive = pthread_create(&m_thread, &attributes, &ThreadImpl::entryPoint, owner) == 0;
+    pthread_attr_destroy(&attributes);
 
     if (!m_isActive)
         std::cerr << "Failed to create thread" << std::endl;
@@ -83,12 +105,94 @@ void* ThreadImpl::entryPoint(void* userData)
         pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS, NULL);
     #endif
 
+    // The settings are applied by the thread itself, all systems support it
+    applySettings(*owner);
+
     // Forward to the owner
     owner->run();
 
     return NULL;
 }
 
+
+////////////////////////////////////////////////////////////
+void ThreadImpl::applySettings(const Thread& owner)
+{
+    if (!owner.m_name.empty())
+    {
+        #if defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_ANDROID)
+            // Longer names are rejected rather than truncated
+            pthread_setname_np(pthread_self(), owner.m_name.substr(0, 15).c_str());
+        #elif defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
+            pthread_setname_np(owner.m_name.c_str());
+        #elif defined(SFML_SYSTEM_FREEBSD)
+            pthread_set_name_np(pthread_self(), owner.m_name.c_str());
+        #endif
+    }
+
+    #if defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_ANDROID)
+        if (owner.m_affinity != 0)
+        {
+            cpu_set_t processors;
+            CPU_ZERO(&processors);
+            for (int i = 0; i < 64; ++i)
+            {
+                if (owner.m_affinity & (static_cast<Uint64>(1) << i))
+                    CPU_SET(i, &processors);
+            }
+
+            sched_setaffinity(0, sizeof(processors), &processors);
+        }
+    #endif
+
+    Thread::Priority priority = owner.m_priority;
+    if (priority == Thread::Normal)
+        return;
+
+    if (priority == Thread::RealTime)
+    {
+        // Above the real-time threads of most applications, below the ones of the system
+        sched_param parameters;
+        int lowest = sched_get_priority_min(SCHED_FIFO);
+        int highest = sched_get_priority_max(SCHED_FIFO);
+        parameters.sched_priority = lowest + (highest - lowest) * 3 / 4;
+        if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &parameters) == 0)
+            return;
+
+        // Not allowed: use the highest normal priority instead
+        priority = Thread::High;
+    }
+
+    #if defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_ANDROID)
+
+        // The normal policy has a single priority on Linux, threads are distinguished by their nice value
+        id_t thread = static_cast<id_t>(syscall(SYS_gettid));
+        if (priority == Thread::Low)
+        {
+            setpriority(PRIO_PROCESS, thread, 10);
+        }
+        else if (setpriority(PRIO_PROCESS, thread, -10) != 0)
+        {
+            // Unprivileged threads may still be allowed a lower nice value by RLIMIT_NICE
+            rlimit limit;
+            if ((getrlimit(RLIMIT_NICE, &limit) == 0) && (limit.rlim_cur != RLIM_INFINITY) && (limit.rlim_cur > 20))
+                setpriority(PRIO_PROCESS, thread, std::max(-10, 20 - static_cast<int>(limit.rlim_cur)));
+        }
+
+    #else
+
+        // Use the extreme priorities of the current policy
+        int policy;
+        sched_param parameters;
+        if (pthread_getschedparam(pthread_self(), &policy, &parameters) == 0)
+        {
+            parameters.sched_priority = (priority == Thread::Low) ? sched_get_priority_min(policy) : sched_get_priority_max(policy);
+            pthread_setschedparam(pthread_self(), policy, &parameters);
+        }
+
+    #endif
+}
+
 } // namespace priv
 
 } // namespace sf
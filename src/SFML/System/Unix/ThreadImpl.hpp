@@ -78,6 +78,14 @@ private:
     ////////////////////////////////////////////////////////////
     static void* entryPoint(void* userData);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the name, affinity and priority of a thread to the calling thread
+    ///
+    /// \param owner The Thread instance being run
+    ///
+    ////////////////////////////////////////////////////////////
+    static void applySettings(const Thread& owner);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -0,0 +1,342 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Utf.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SFML_UTF_SSE2
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define SFML_UTF_NEON
+#endif
+
+
+namespace
+{
+    // Return the number of leading ASCII bytes of a sequence
+    std::size_t skipAscii(const char* data, std::size_t size)
+    {
+        std::size_t i = 0;
+
+    #if defined(SFML_UTF_SSE2)
+
+        for (; i + 32 <= size; i += 32)
+        {
+            __m128i first  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 16));
+            if (_mm_movemask_epi8(_mm_or_si128(first, second)) != 0)
+                break;
+        }
+        for (; i + 16 <= size; i += 16)
+        {
+            if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i))) != 0)
+                break;
+        }
+
+    #elif defined(SFML_UTF_NEON)
+
+        for (; i + 16 <= size; i += 16)
+        {
+            uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+            uint8x8_t  both  = vorr_u8(vget_low_u8(bytes), vget_high_u8(bytes));
+            if ((vget_lane_u64(vreinterpret_u64_u8(both), 0) & 0x8080808080808080ULL) != 0)
+                break;
+        }
+
+    #endif
+
+        // Locate the first non-ASCII byte within the last block
+        while ((i < size) && (static_cast<sf::Uint8>(data[i]) < 0x80))
+            ++i;
+
+        return i;
+    }
+
+    // Widen the leading ASCII bytes of a sequence to UTF-32, return how many were converted
+    std::size_t widenAscii(const char* data, std::size_t size, sf::Uint32* output)
+    {
+        std::size_t i = 0;
+
+    #if defined(SFML_UTF_SSE2)
+
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 16 <= size; i += 16)
+        {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            if (_mm_movemask_epi8(bytes) != 0)
+                break;
+
+            __m128i low  = _mm_unpacklo_epi8(bytes, zero);
+            __m128i high = _mm_unpackhi_epi8(bytes, zero);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i),      _mm_unpacklo_epi16(low, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i + 4),  _mm_unpackhi_epi16(low, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i + 8),  _mm_unpacklo_epi16(high, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i + 12), _mm_unpackhi_epi16(high, zero));
+        }
+
+    #elif defined(SFML_UTF_NEON)
+
+        for (; i + 16 <= size; i += 16)
+        {
+            uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+            uint8x8_t  both  = vorr_u8(vget_low_u8(bytes), vget_high_u8(bytes));
+            if ((vget_lane_u64(vreinterpret_u64_u8(both), 0) & 0x8080808080808080ULL) != 0)
+                break;
+
+            uint16x8_t low  = vmovl_u8(vget_low_u8(bytes));
+            uint16x8_t high = vmovl_u8(vget_high_u8(bytes));
+            vst1q_u32(output + i,      vmovl_u16(vget_low_u16(low)));
+            vst1q_u32(output + i + 4,  vmovl_u16(vget_high_u16(low)));
+            vst1q_u32(output + i + 8,  vmovl_u16(vget_low_u16(high)));
+            vst1q_u32(output + i + 12, vmovl_u16(vget_high_u16(high)));
+        }
+
+    #endif
+
+        for (; (i < size) && (static_cast<sf::Uint8>(data[i]) < 0x80); ++i)
+            output[i] = static_cast<sf::Uint8>(data[i]);
+
+        return i;
+    }
+
+    // Narrow the leading ASCII codepoints of a sequence to UTF-8, return how many were converted
+    std::size_t narrowAscii(const sf::Uint32* data, std::size_t size, sf::Uint8* output)
+    {
+        std::size_t i = 0;
+
+    #if defined(SFML_UTF_SSE2)
+
+        const __m128i mask = _mm_set1_epi32(~0x7F);
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 16 <= size; i += 16)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 4));
+            __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 8));
+            __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 12));
+
+            __m128i high = _mm_and_si128(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)), mask);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(high, zero)) != 0xFFFF)
+                break;
+
+            __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), bytes);
+        }
+
+    #elif defined(SFML_UTF_NEON)
+
+        const uint32x4_t mask = vdupq_n_u32(~0x7Fu);
+        for (; i + 16 <= size; i += 16)
+        {
+            uint32x4_t a = vld1q_u32(data + i);
+            uint32x4_t b = vld1q_u32(data + i + 4);
+            uint32x4_t c = vld1q_u32(data + i + 8);
+            uint32x4_t d = vld1q_u32(data + i + 12);
+
+            uint64x2_t high = vreinterpretq_u64_u32(vandq_u32(vorrq_u32(vorrq_u32(a, b), vorrq_u32(c, d)), mask));
+            if ((vgetq_lane_u64(high, 0) | vgetq_lane_u64(high, 1)) != 0)
+                break;
+
+            uint16x8_t low16  = vcombine_u16(vmovn_u32(a), vmovn_u32(b));
+            uint16x8_t high16 = vcombine_u16(vmovn_u32(c), vmovn_u32(d));
+            vst1q_u8(output + i, vcombine_u8(vmovn_u16(low16), vmovn_u16(high16)));
+        }
+
+    #endif
+
+        for (; (i < size) && (data[i] < 0x80); ++i)
+            output[i] = static_cast<sf::Uint8>(data[i]);
+
+        return i;
+    }
+
+    // Decode a single non-ASCII character, exactly like sf::Utf8::decode but small enough to be inlined
+    const char* decodeSequence(const char* begin, const char* end, sf::Uint32& output)
+    {
+        static const sf::Uint32 offsets[6] =
+        {
+            0x00000000, 0x00003080, 0x000E2080, 0x03C82080, 0xFA082080, 0x82082080
+        };
+
+        // Number of trailing bytes of the lead bytes 0x80 to 0xFF, two at a time
+        static const int trailing[64] =
+        {
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 5, 5
+        };
+
+        sf::Uint8 lead = static_cast<sf::Uint8>(*begin);
+        int trailingBytes = trailing[(lead - 0x80) >> 1];
+        if (end - begin <= trailingBytes)
+        {
+            // Incomplete character
+            output = 0;
+            return end;
+        }
+
+        output = lead;
+        switch (trailingBytes)
+        {
+            case 5: output = (output << 6) + static_cast<sf::Uint8>(*++begin);
+            case 4: output = (output << 6) + static_cast<sf::Uint8>(*++begin);
+            case 3: output = (output << 6) + static_cast<sf::Uint8>(*++begin);
+            case 2: output = (output << 6) + static_cast<sf::Uint8>(*++begin);
+            case 1: output = (output << 6) + static_cast<sf::Uint8>(*++begin);
+        }
+        output -= offsets[trailingBytes];
+
+        return begin + 1;
+    }
+
+    // Check that a byte is a continuation byte within [low, high]
+    bool isContinuation(const char* byte, sf::Uint8 low = 0x80, sf::Uint8 high = 0xBF)
+    {
+        sf::Uint8 value = static_cast<sf::Uint8>(*byte);
+        return (value >= low) && (value <= high);
+    }
+
+    // Check a single multi-byte sequence, return the number of bytes it uses (0 if invalid)
+    std::size_t checkSequence(const char* data, std::size_t size)
+    {
+        // Well-formed byte sequences, as listed in table 3-7 of the Unicode standard
+        sf::Uint8 lead = static_cast<sf::Uint8>(data[0]);
+        if ((lead >= 0xC2) && (lead <= 0xDF))
+        {
+            return (size >= 2) && isContinuation(data + 1) ? 2 : 0;
+        }
+        else if ((lead >= 0xE0) && (lead <= 0xEF))
+        {
+            sf::Uint8 low  = (lead == 0xE0) ? 0xA0 : 0x80;
+            sf::Uint8 high = (lead == 0xED) ? 0x9F : 0xBF;
+            return (size >= 3) && isContinuation(data + 1, low, high) && isContinuation(data + 2) ? 3 : 0;
+        }
+        else if ((lead >= 0xF0) && (lead <= 0xF4))
+        {
+            sf::Uint8 low  = (lead == 0xF0) ? 0x90 : 0x80;
+            sf::Uint8 high = (lead == 0xF4) ? 0x8F : 0xBF;
+            return (size >= 4) && isContinuation(data + 1, low, high) && isContinuation(data + 2) && isContinuation(data + 3) ? 4 : 0;
+        }
+
+        // Stray continuation byte, overlong 2-byte sequence or 5/6-byte sequence
+        return 0;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+std::size_t Utf<8>::count(const char* begin, const char* end)
+{
+    std::size_t length = 0;
+    while (begin < end)
+    {
+        if (static_cast<Uint8>(*begin) < 0x80)
+        {
+            std::size_t ascii = skipAscii(begin, static_cast<std::size_t>(end - begin));
+            begin  += ascii;
+            length += ascii;
+        }
+        else
+        {
+            begin = next(begin, end);
+            ++length;
+        }
+    }
+
+    return length;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Utf<8>::isValid(const char* begin, const char* end)
+{
+    while (begin < end)
+    {
+        begin += skipAscii(begin, static_cast<std::size_t>(end - begin));
+        if (begin == end)
+            break;
+
+        std::size_t length = checkSequence(begin, static_cast<std::size_t>(end - begin));
+        if (length == 0)
+            return false;
+
+        begin += length;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32* Utf<8>::toUtf32(const char* begin, const char* end, Uint32* output)
+{
+    while (begin < end)
+    {
+        if (static_cast<Uint8>(*begin) < 0x80)
+        {
+            std::size_t ascii = widenAscii(begin, static_cast<std::size_t>(end - begin), output);
+            begin  += ascii;
+            output += ascii;
+        }
+        else
+        {
+            // Decode the whole run of non-ASCII characters before looking for ASCII again
+            do
+            {
+                begin = decodeSequence(begin, end, *output++);
+            }
+            while ((begin < end) && (static_cast<Uint8>(*begin) >= 0x80));
+        }
+    }
+
+    return output;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint8* Utf<32>::toUtf8(const Uint32* begin, const Uint32* end, Uint8* output)
+{
+    while (begin < end)
+    {
+        if (*begin < 0x80)
+        {
+            std::size_t ascii = narrowAscii(begin, static_cast<std::size_t>(end - begin), output);
+            begin  += ascii;
+            output += ascii;
+        }
+        else
+        {
+            output = Utf<8>::encode(*begin++, output);
+        }
+    }
+
+    return output;
+}
+
+} // namespace sf
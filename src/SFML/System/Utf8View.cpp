@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Utf8View.hpp>
+#include <SFML/System/Utf.hpp>
+#include <cstring>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+Utf8View::Utf8View() :
+m_data(""),
+m_size(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Utf8View::Utf8View(const char* string) :
+m_data(string ? string : ""),
+m_size(string ? std::strlen(string) : 0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Utf8View::Utf8View(const char* data, std::size_t size) :
+m_data(data),
+m_size(size)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+Utf8View::Utf8View(const std::string& string) :
+m_data(string.data()),
+m_size(string.size())
+{
+}
+
+
+////////////////////////////////////////////////////////////
+const char* Utf8View::getData() const
+{
+    return m_data;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Utf8View::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Utf8View::getLength() const
+{
+    return Utf8::count(m_data, m_data + m_size);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Utf8View::isEmpty() const
+{
+    return m_size == 0;
+}
+
+
+////////////////////////////////////////////////////////////
+String Utf8View::toString() const
+{
+    return String::fromUtf8(m_data, m_data + m_size);
+}
+
+} // namespace sf
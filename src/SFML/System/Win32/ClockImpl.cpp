@@ -46,24 +46,21 @@ namespace priv
 ////////////////////////////////////////////////////////////
 Time ClockImpl::getCurrentTime()
 {
-    // Force the following code to run on first core
-    // (see http://msdn.microsoft.com/en-us/library/windows/desktop/ms644904(v=vs.85).aspx)
-    HANDLE currentThread = GetCurrentThread();
-    DWORD_PTR previousMask = SetThreadAffinityMask(currentThread, 1);
-
     // Get the frequency of the performance counter
     // (it is constant across the program lifetime)
     static LARGE_INTEGER frequency = getFrequency();
 
-    // Get the current time
+    // Get the current time; since Windows Vista the performance counter is
+    // synchronized across the cores, so the thread doesn't have to be pinned
+    // to the first one anymore (which cost two system calls per call)
     LARGE_INTEGER time;
     QueryPerformanceCounter(&time);
 
-    // Restore the thread affinity
-    SetThreadAffinityMask(currentThread, previousMask);
-
-    // Return the current time as microseconds
-    return sf::microseconds(1000000 * time.QuadPart / frequency.QuadPart);
+    // Return the current time as nanoseconds, converting the seconds and
+    // the remaining ticks separately so that the multiplication can't overflow
+    Int64 seconds = time.QuadPart / frequency.QuadPart;
+    Int64 ticks = time.QuadPart % frequency.QuadPart;
+    return sf::nanoseconds(seconds * 1000000000 + ticks * 1000000000 / frequency.QuadPart);
 }
 
 } // namespace priv
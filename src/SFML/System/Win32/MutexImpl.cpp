@@ -33,9 +33,13 @@ namespace sf
 namespace priv
 {
 ////////////////////////////////////////////////////////////
-MutexImpl::MutexImpl()
+MutexImpl::MutexImpl(bool recursive)
 {
-    InitializeCriticalSection(&m_mutex);
+    // Critical sections are always recursive; fast ones spin for a while before sleeping
+    if (recursive)
+        InitializeCriticalSection(&m_mutex);
+    else
+        InitializeCriticalSectionAndSpinCount(&m_mutex, 4000);
 }
 
 
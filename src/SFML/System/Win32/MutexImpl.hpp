@@ -46,8 +46,10 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
+    /// \param recursive Can the mutex be locked several times by the same thread?
+    ///
     ////////////////////////////////////////////////////////////
-    MutexImpl();
+    MutexImpl(bool recursive);
 
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
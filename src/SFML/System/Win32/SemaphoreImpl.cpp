@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Win32/SemaphoreImpl.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+SemaphoreImpl::SemaphoreImpl(unsigned int count)
+{
+    m_semaphore = CreateSemaphoreA(NULL, static_cast<LONG>(count), 0x7FFFFFFF, NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+SemaphoreImpl::~SemaphoreImpl()
+{
+    CloseHandle(m_semaphore);
+}
+
+
+////////////////////////////////////////////////////////////
+void SemaphoreImpl::post()
+{
+    ReleaseSemaphore(m_semaphore, 1, NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+void SemaphoreImpl::wait()
+{
+    WaitForSingleObject(m_semaphore, INFINITE);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SemaphoreImpl::wait(Time timeout)
+{
+    Int32 milliseconds = timeout.asMilliseconds();
+    return WaitForSingleObject(m_semaphore, milliseconds > 0 ? static_cast<DWORD>(milliseconds) : 0) == WAIT_OBJECT_0;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -28,10 +28,20 @@
 #include <SFML/System/Win32/ThreadImpl.hpp>
 #include <SFML/System/Thread.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/String.hpp>
 #include <cassert>
 #include <process.h>
 
 
+namespace
+{
+    // Functions of recent versions of Windows, loaded dynamically
+    typedef HRESULT (WINAPI* SetThreadDescriptionFunc)(HANDLE, PCWSTR);
+    typedef HANDLE (WINAPI* AvSetMmThreadCharacteristicsFunc)(LPCWSTR, LPDWORD);
+    typedef BOOL (WINAPI* AvRevertMmThreadCharacteristicsFunc)(HANDLE);
+}
+
+
 namespace sf
 {
 namespace priv
@@ -39,7 +49,10 @@ namespace priv
 ////////////////////////////////////////////////////////////
 ThreadImpl::ThreadImpl(Thread* owner)
 {
-    m_thread = reinterpret_cast<HANDLE>(_beginthreadex(NULL, 0, &ThreadImpl::entryPoint, owner, 0, &m_threadId));
+    // The stack size is only reserved, the memory is committed as the stack grows
+    unsigned int stackSize = static_cast<unsigned int>(owner->m_stackSize);
+    unsigned int flags = stackSize > 0 ? STACK_SIZE_PARAM_IS_A_RESERVATION : 0;
+    m_thread = reinterpret_cast<HANDLE>(_beginthreadex(NULL, stackSize, &ThreadImpl::entryPoint, owner, flags, &m_threadId));
 
     if (!m_thread)
         err() << "Failed to create thread" << std::endl;
@@ -79,15 +92,68 @@ unsigned int __stdcall ThreadImpl::entryPoint(void* userData)
     // The Thread instance is stored in the user data
     Thread* owner = static_cast<Thread*>(userData);
 
+    // The settings are applied by the thread itself
+    applySettings(*owner);
+
+    // Real-time threads are also registered to the multimedia class scheduler, which
+    // boosts them above the other applications (as long as they don't hog the processor)
+    HMODULE avrt = NULL;
+    HANDLE task = NULL;
+    if (owner->m_priority == Thread::RealTime)
+    {
+        avrt = LoadLibraryA("avrt.dll");
+        AvSetMmThreadCharacteristicsFunc setCharacteristics = avrt ? reinterpret_cast<AvSetMmThreadCharacteristicsFunc>(GetProcAddress(avrt, "AvSetMmThreadCharacteristicsW")) : NULL;
+        if (setCharacteristics)
+        {
+            DWORD taskIndex = 0;
+            task = setCharacteristics(L"Pro Audio", &taskIndex);
+        }
+    }
+
     // Forward to the owner
     owner->run();
 
+    if (task)
+    {
+        AvRevertMmThreadCharacteristicsFunc revertCharacteristics = reinterpret_cast<AvRevertMmThreadCharacteristicsFunc>(GetProcAddress(avrt, "AvRevertMmThreadCharacteristics"));
+        if (revertCharacteristics)
+            revertCharacteristics(task);
+    }
+
+    if (avrt)
+        FreeLibrary(avrt);
+
     // Optional, but it is cleaner
     _endthreadex(0);
 
     return 0;
 }
 
+
+////////////////////////////////////////////////////////////
+void ThreadImpl::applySettings(const Thread& owner)
+{
+    // SetThreadDescription is available since Windows 10 1607
+    if (!owner.m_name.empty())
+    {
+        HMODULE kernel32 = GetModuleHandleA("kernel32.dll");
+        SetThreadDescriptionFunc setThreadDescription = kernel32 ? reinterpret_cast<SetThreadDescriptionFunc>(GetProcAddress(kernel32, "SetThreadDescription")) : NULL;
+        if (setThreadDescription)
+            setThreadDescription(GetCurrentThread(), String(owner.m_name).toWideString().c_str());
+    }
+
+    if (owner.m_affinity != 0)
+        SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(owner.m_affinity));
+
+    switch (owner.m_priority)
+    {
+        case Thread::Low:      SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);  break;
+        case Thread::High:     SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST);       break;
+        case Thread::RealTime: SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL); break;
+        default:                                                                                     break;
+    }
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -94,6 +94,14 @@ private:
     ////////////////////////////////////////////////////////////
     ALIGN_STACK static unsigned int __stdcall entryPoint(void* userData);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the name, affinity and priority of a thread to the calling thread
+    ///
+    /// \param owner The Thread instance being run
+    ///
+    ////////////////////////////////////////////////////////////
+    static void applySettings(const Thread& owner);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -47,6 +47,13 @@ void JoystickImpl::cleanup()
 }
 
 
+////////////////////////////////////////////////////////////
+void JoystickImpl::updateConnections()
+{
+    // To implement
+}
+
+
 ////////////////////////////////////////////////////////////
 bool JoystickImpl::isConnected(unsigned int index)
 {
@@ -28,6 +28,8 @@
 #include <SFML/Window/SensorImpl.hpp>
 #include <SFML/System/Time.hpp>
 #include <android/looper.h>
+#include <algorithm>
+#include <deque>
 
 // Define missing constants
 #define ASENSOR_TYPE_GRAVITY             0x00000009
@@ -40,6 +42,10 @@ namespace
     ASensorManager*    sensorManager;
     ASensorEventQueue* sensorEventQueue;
     sf::Vector3f       sensorData[sf::Sensor::Count];
+
+    // Samples received and not read yet, the oldest are dropped beyond the capacity
+    const std::size_t        sampleCapacity = 1024;
+    std::deque<sf::Vector3f> sensorSamples[sf::Sensor::Count];
 }
 
 
@@ -89,11 +95,11 @@ bool SensorImpl::open(Sensor::Type sensor)
     if (!m_sensor)
         return false;
 
-    // Get the minimum delay allowed between events
-    Time minimumDelay = microseconds(ASensor_getMinDelay(m_sensor));
-
-    // Set the event rate (not to consume too much battery)
-    ASensorEventQueue_setEventRate(sensorEventQueue, m_sensor, minimumDelay.asMicroseconds());
+    // Sample as fast as possible by default, without batching; the rate
+    // is applied when the sensor is enabled, since enabling resets it
+    m_interval = microseconds(ASensor_getMinDelay(m_sensor));
+    m_maxLatency = Time::Zero;
+    m_enabled = false;
 
     // Save the index of the sensor
     m_index = static_cast<unsigned int>(sensor);
@@ -123,9 +129,59 @@ Vector3f SensorImpl::update()
 void SensorImpl::setEnabled(bool enabled)
 {
     if (enabled)
+    {
+#if __ANDROID_API__ >= 26
+        // Enable the sensor with its rate and FIFO batching latency at once
+        ASensorEventQueue_registerSensor(sensorEventQueue, m_sensor, static_cast<int32_t>(m_interval.asMicroseconds()),
+                                         m_maxLatency.asMicroseconds());
+#else
+        // Batching is not available to native code before Android 8.0
         ASensorEventQueue_enableSensor(sensorEventQueue, m_sensor);
+        ASensorEventQueue_setEventRate(sensorEventQueue, m_sensor, static_cast<int32_t>(m_interval.asMicroseconds()));
+#endif
+    }
     else
+    {
         ASensorEventQueue_disableSensor(sensorEventQueue, m_sensor);
+
+        // Don't return the samples of a previous session once re-enabled
+        sensorSamples[m_index].clear();
+    }
+
+    m_enabled = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+void SensorImpl::setSamplingRate(Time interval, Time maxLatency)
+{
+    // Sensors can't be sampled faster than their minimum delay
+    Time minimumDelay = microseconds(ASensor_getMinDelay(m_sensor));
+    m_interval = (interval > minimumDelay) ? interval : minimumDelay;
+    m_maxLatency = (maxLatency > Time::Zero) ? maxLatency : Time::Zero;
+
+    // Re-register the sensor for the new rate to be applied
+    if (m_enabled)
+    {
+        ASensorEventQueue_disableSensor(sensorEventQueue, m_sensor);
+        setEnabled(true);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SensorImpl::getSamples(Vector3f* samples, std::size_t maxCount)
+{
+    // Fetch what the hardware delivered so far
+    ALooper_pollAll(0, NULL, NULL, NULL);
+
+    std::deque<Vector3f>& pending = sensorSamples[m_index];
+    std::size_t count = (pending.size() < maxCount) ? pending.size() : maxCount;
+
+    std::copy(pending.begin(), pending.begin() + count, samples);
+    pending.erase(pending.begin(), pending.begin() + count);
+
+    return count;
 }
 
 
@@ -147,63 +203,74 @@ ASensor const* SensorImpl::getDefaultSensor(Sensor::Type sensor)
 ////////////////////////////////////////////////////////////
 int SensorImpl::processSensorEvents(int fd, int events, void* data)
 {
-    ASensorEvent event;
+    // Batched sensors deliver many events at once, read them in blocks
+    ASensorEvent buffer[64];
+    ssize_t count;
 
-    while (ASensorEventQueue_getEvents(sensorEventQueue, &event, 1) > 0)
+    while ((count = ASensorEventQueue_getEvents(sensorEventQueue, buffer, 64)) > 0)
     {
-        unsigned int type = Sensor::Count;
-        Vector3f data;
-
-        switch (event.type)
+        for (ssize_t i = 0; i < count; ++i)
         {
-            case ASENSOR_TYPE_ACCELEROMETER:
-                type = Sensor::Accelerometer;
-                data.x = event.acceleration.x;
-                data.y = event.acceleration.y;
-                data.z = event.acceleration.z;
-                break;
-
-            case ASENSOR_TYPE_GYROSCOPE:
-                type = Sensor::Gyroscope;
-                data.x = event.vector.x;
-                data.y = event.vector.y;
-                data.z = event.vector.z;
-                break;
-
-            case ASENSOR_TYPE_MAGNETIC_FIELD:
-                type = Sensor::Magnetometer;
-                data.x = event.magnetic.x;
-                data.y = event.magnetic.y;
-                data.z = event.magnetic.z;
-                break;
-
-            case ASENSOR_TYPE_GRAVITY:
-                type = Sensor::Gravity;
-                data.x = event.vector.x;
-                data.y = event.vector.y;
-                data.z = event.vector.z;
-                break;
-
-            case ASENSOR_TYPE_LINEAR_ACCELERATION:
-                type = Sensor::UserAcceleration;
-                data.x = event.acceleration.x;
-                data.y = event.acceleration.y;
-                data.z = event.acceleration.z;
-                break;
-
-            case ASENSOR_TYPE_ORIENTATION:
-                type = Sensor::Orientation;
-                data.x = event.vector.x;
-                data.y = event.vector.y;
-                data.z = event.vector.z;
-                break;
+            const ASensorEvent& event = buffer[i];
+            unsigned int type = Sensor::Count;
+            Vector3f data;
+
+            switch (event.type)
+            {
+                case ASENSOR_TYPE_ACCELEROMETER:
+                    type = Sensor::Accelerometer;
+                    data.x = event.acceleration.x;
+                    data.y = event.acceleration.y;
+                    data.z = event.acceleration.z;
+                    break;
+
+                case ASENSOR_TYPE_GYROSCOPE:
+                    type = Sensor::Gyroscope;
+                    data.x = event.vector.x;
+                    data.y = event.vector.y;
+                    data.z = event.vector.z;
+                    break;
+
+                case ASENSOR_TYPE_MAGNETIC_FIELD:
+                    type = Sensor::Magnetometer;
+                    data.x = event.magnetic.x;
+                    data.y = event.magnetic.y;
+                    data.z = event.magnetic.z;
+                    break;
+
+                case ASENSOR_TYPE_GRAVITY:
+                    type = Sensor::Gravity;
+                    data.x = event.vector.x;
+                    data.y = event.vector.y;
+                    data.z = event.vector.z;
+                    break;
+
+                case ASENSOR_TYPE_LINEAR_ACCELERATION:
+                    type = Sensor::UserAcceleration;
+                    data.x = event.acceleration.x;
+                    data.y = event.acceleration.y;
+                    data.z = event.acceleration.z;
+                    break;
+
+                case ASENSOR_TYPE_ORIENTATION:
+                    type = Sensor::Orientation;
+                    data.x = event.vector.x;
+                    data.y = event.vector.y;
+                    data.z = event.vector.z;
+                    break;
+            }
+
+            // An unknown sensor event has been detected, we don't know how to process it
+            if (type == Sensor::Count)
+                continue;
+
+            sensorData[type] = data;
+
+            std::deque<Vector3f>& pending = sensorSamples[type];
+            if (pending.size() == sampleCapacity)
+                pending.pop_front();
+            pending.push_back(data);
         }
-
-        // An unknown sensor event has been detected, we don't know how to process it
-        if (type == Sensor::Count)
-            continue;
-
-        sensorData[type] = data;
     }
 
     return 1;
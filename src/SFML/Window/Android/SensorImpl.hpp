@@ -29,6 +29,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/System/Vector3.hpp>
+#include <SFML/System/Time.hpp>
 #include <android/sensor.h>
 
 
@@ -98,6 +99,26 @@ public:
     ////////////////////////////////////////////////////////////
     void setEnabled(bool enabled);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the sampling rate of the sensor
+    ///
+    /// \param interval   Requested time between two samples
+    /// \param maxLatency Maximum delay before the samples are delivered
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSamplingRate(Time interval, Time maxLatency);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the samples received since the last call
+    ///
+    /// \param samples  Array to fill with the samples
+    /// \param maxCount Maximum number of samples to write
+    ///
+    /// \return Number of samples written
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSamples(Vector3f* samples, std::size_t maxCount);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -125,8 +146,11 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    const ASensor* m_sensor; ///< Android sensor structure
-    unsigned int   m_index;  ///< Index of the sensor
+    const ASensor* m_sensor;     ///< Android sensor structure
+    unsigned int   m_index;      ///< Index of the sensor
+    bool           m_enabled;    ///< Enable state of the sensor
+    Time           m_interval;   ///< Requested time between two samples
+    Time           m_maxLatency; ///< Maximum time that samples can stay in the hardware FIFO
 };
 
 } // namespace priv
@@ -58,6 +58,14 @@ VideoMode VideoModeImpl::getDesktopMode()
     return VideoMode(states->screenSize.x, states->screenSize.y);
 }
 
+
+////////////////////////////////////////////////////////////
+unsigned int VideoModeImpl::getDesktopRefreshRate()
+{
+    // The refresh rate is not available to native code
+    return 0;
+}
+
 } // namespace priv
 
 } // namespace sf
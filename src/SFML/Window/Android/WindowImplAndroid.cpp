@@ -29,9 +29,16 @@
 #include <SFML/Window/WindowStyle.hpp> // important to be included first (conflict with None)
 #include <SFML/Window/Android/WindowImplAndroid.hpp>
 #include <SFML/Window/Event.hpp>
+#include <SFML/Window/VideoModeImpl.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
 #include <android/looper.h>
+#include <algorithm>
+#include <time.h>
+#if __ANDROID_API__ >= 24
+    #include <android/choreographer.h>
+#endif
 
 // Define missing constants
 #define AMOTION_EVENT_ACTION_HOVER_MOVE 0x00000007
@@ -52,6 +59,8 @@ WindowImplAndroid::WindowImplAndroid(WindowHandle handle)
 , m_windowBeingCreated(false)
 , m_windowBeingDestroyed(false)
 , m_hasFocus(false)
+, m_framePending(false)
+, m_frameTime(0)
 {
 }
 
@@ -62,6 +71,8 @@ WindowImplAndroid::WindowImplAndroid(VideoMode mode, const String& title, unsign
 , m_windowBeingCreated(false)
 , m_windowBeingDestroyed(false)
 , m_hasFocus(false)
+, m_framePending(false)
+, m_frameTime(0)
 {
     ActivityStates* states = getActivity(NULL);
     Lock lock(states->mutex);
@@ -95,6 +106,85 @@ WindowHandle WindowImplAndroid::getSystemHandle() const
 }
 
 
+////////////////////////////////////////////////////////////
+bool WindowImplAndroid::waitForRefresh(Time& refreshTime, Time& deadline)
+{
+#if __ANDROID_API__ >= 24
+    // The choreographer is attached to the looper of the thread, prepared by the main of SFML
+    AChoreographer* choreographer = AChoreographer_getInstance();
+    if (!choreographer)
+        return false;
+
+    // A callback may still be pending if the previous wait gave up
+    if (!m_framePending)
+    {
+        m_framePending = true;
+    #if __ANDROID_API__ >= 29
+        AChoreographer_postFrameCallback64(choreographer, &onFrame64, this);
+    #else
+        // The time of this older callback wraps around every 4 seconds on 32-bit devices
+        AChoreographer_postFrameCallback(choreographer, &onFrame, this);
+    #endif
+    }
+
+    // Keep processing the other sources of the looper while waiting, and give up if
+    // the choreographer stops delivering frames (when the activity is paused for example)
+    Clock clock;
+    while (m_framePending && (clock.getElapsedTime() < milliseconds(100)))
+        ALooper_pollOnce(10, NULL, NULL, NULL);
+
+    if (m_framePending)
+        return false;
+
+    // The frame time is on the monotonic clock: convert it to the time line of the events
+    Time now = getEventTime();
+
+    timespec monotonic;
+    clock_gettime(CLOCK_MONOTONIC, &monotonic);
+    Int64 elapsed = static_cast<Int64>(monotonic.tv_sec) * 1000000000 + monotonic.tv_nsec - m_frameTime;
+
+#if __ANDROID_API__ < 29
+    // Undo the wrap around of the 32-bit frame time (the frame is less than a second old)
+    if (sizeof(long) < sizeof(Int64))
+        elapsed = static_cast<Int32>(static_cast<Uint32>(elapsed));
+#endif
+
+    elapsed /= 1000;
+
+    unsigned int refreshRate = VideoModeImpl::getDesktopRefreshRate();
+    if (refreshRate == 0)
+        refreshRate = 60;
+
+    refreshTime = now - microseconds(std::max(elapsed, Int64(0)));
+    deadline    = refreshTime + microseconds(1000000 / refreshRate);
+
+    return true;
+#else
+    // The choreographer is not available to native code before Android 7.0
+    (void)refreshTime;
+    (void)deadline;
+    return false;
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImplAndroid::onFrame(long frameTimeNanos, void* data)
+{
+    onFrame64(frameTimeNanos, data);
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImplAndroid::onFrame64(Int64 frameTimeNanos, void* data)
+{
+    WindowImplAndroid* window = static_cast<WindowImplAndroid*>(data);
+
+    window->m_frameTime    = frameTimeNanos;
+    window->m_framePending = false;
+}
+
+
 ////////////////////////////////////////////////////////////
 void WindowImplAndroid::processEvents()
 {
@@ -434,34 +524,44 @@ void WindowImplAndroid::processMotionEvent(AInputEvent* _event, ActivityStates*
 
     int pointerCount = AMotionEvent_getPointerCount(_event);
 
-    for (int p = 0; p < pointerCount; p++)
-    {
-        int id = AMotionEvent_getPointerId(_event, p);
+    // Fast digitizers sample several positions per frame, the older ones are stored in the
+    // history of the event: deliver them first, so that no intermediate position is lost
+    size_t historySize = AMotionEvent_getHistorySize(_event);
 
-        float x = AMotionEvent_getX(_event, p);
-        float y = AMotionEvent_getY(_event, p);
+    for (size_t h = 0; h <= historySize; h++)
+    {
+        bool historical = (h < historySize);
+        event.timestamp = getMotionTime(historical ? AMotionEvent_getHistoricalEventTime(_event, h) : AMotionEvent_getEventTime(_event));
 
-        if (device == AINPUT_SOURCE_MOUSE)
+        for (int p = 0; p < pointerCount; p++)
         {
-            event.mouseMove.x = x;
-            event.mouseMove.y = y;
+            int id = AMotionEvent_getPointerId(_event, p);
 
-            states->mousePosition = Vector2i(event.mouseMove.x, event.mouseMove.y);
-        }
-        else if (device == AINPUT_SOURCE_TOUCHSCREEN)
-        {
-            if (states->touchEvents[id].x == x && states->touchEvents[id].y == y)
-                continue;
+            float x = historical ? AMotionEvent_getHistoricalX(_event, p, h) : AMotionEvent_getX(_event, p);
+            float y = historical ? AMotionEvent_getHistoricalY(_event, p, h) : AMotionEvent_getY(_event, p);
 
-            event.touch.finger = id;
-            event.touch.x = x;
-            event.touch.y = y;
+            if (device == AINPUT_SOURCE_MOUSE)
+            {
+                event.mouseMove.x = x;
+                event.mouseMove.y = y;
 
-            states->touchEvents[id] = Vector2i(event.touch.x, event.touch.y);
-        }
+                states->mousePosition = Vector2i(event.mouseMove.x, event.mouseMove.y);
+            }
+            else if (device == AINPUT_SOURCE_TOUCHSCREEN)
+            {
+                if (states->touchEvents[id].x == x && states->touchEvents[id].y == y)
+                    continue;
 
-        forwardEvent(event);
-     }
+                event.touch.finger = id;
+                event.touch.x = x;
+                event.touch.y = y;
+
+                states->touchEvents[id] = Vector2i(event.touch.x, event.touch.y);
+            }
+
+            forwardEvent(event);
+        }
+    }
 }
 
 
@@ -478,6 +578,7 @@ void WindowImplAndroid::processPointerEvent(bool isDown, AInputEvent* _event, Ac
     float y = AMotionEvent_getY(_event, index);
 
     Event event;
+    event.timestamp = getMotionTime(AMotionEvent_getEventTime(_event));
 
     if (isDown)
     {
@@ -528,6 +629,19 @@ void WindowImplAndroid::processPointerEvent(bool isDown, AInputEvent* _event, Ac
 }
 
 
+////////////////////////////////////////////////////////////
+Time WindowImplAndroid::getMotionTime(Int64 nanoseconds)
+{
+    // Input events are stamped with the monotonic clock, like the frames of the choreographer
+    timespec monotonic;
+    clock_gettime(CLOCK_MONOTONIC, &monotonic);
+    Int64 elapsed = (static_cast<Int64>(monotonic.tv_sec) * 1000000000 + monotonic.tv_nsec - nanoseconds) / 1000;
+
+    // Zero means "no timestamp", so make sure that we never use it
+    return std::max(getEventTime() - microseconds(std::max(elapsed, Int64(0))), microseconds(1));
+}
+
+
 ////////////////////////////////////////////////////////////
 Keyboard::Key WindowImplAndroid::androidKeyToSF(int32_t key)
 {
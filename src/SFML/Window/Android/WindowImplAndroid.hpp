@@ -169,6 +169,17 @@ public:
     ////////////////////////////////////////////////////////////
     virtual bool hasFocus() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the next refresh of the display
+    ///
+    /// \param refreshTime Filled with the time of the refresh, on the time line of getEventTime
+    /// \param deadline    Filled with the expected time of the next refresh
+    ///
+    /// \return True if the refresh was reported by the choreographer, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool waitForRefresh(Time& refreshTime, Time& deadline);
+
     static void forwardEvent(const Event& event);
     static WindowImplAndroid* singleInstance;
 
@@ -199,6 +210,16 @@ private:
     static void processMotionEvent(AInputEvent* _event, ActivityStates* states);
     static void processPointerEvent(bool isDown, AInputEvent* event, ActivityStates* states);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert the time of an input event to the time line of getEventTime
+    ///
+    /// \param nanoseconds Time of the input event, on the monotonic clock
+    ///
+    /// \return Timestamp of the event
+    ///
+    ////////////////////////////////////////////////////////////
+    static Time getMotionTime(Int64 nanoseconds);
+
     ////////////////////////////////////////////////////////////
     /// \brief Convert a Android key to SFML key code
     ///
@@ -219,10 +240,30 @@ private:
     ////////////////////////////////////////////////////////////
     static int getUnicode(AInputEvent* event);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive a frame from the choreographer
+    ///
+    /// \param frameTimeNanos Time of the refresh, in nanoseconds on the monotonic clock
+    /// \param data           Window which requested the frame
+    ///
+    ////////////////////////////////////////////////////////////
+    static void onFrame(long frameTimeNanos, void* data);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Receive a frame from the choreographer, with a 64-bit time
+    ///
+    /// \param frameTimeNanos Time of the refresh, in nanoseconds on the monotonic clock
+    /// \param data           Window which requested the frame
+    ///
+    ////////////////////////////////////////////////////////////
+    static void onFrame64(Int64 frameTimeNanos, void* data);
+
     Vector2u m_size;
     bool m_windowBeingCreated;
     bool m_windowBeingDestroyed;
     bool m_hasFocus;
+    bool m_framePending; ///< Is a frame callback posted to the choreographer?
+    Int64 m_frameTime;   ///< Time of the last frame received from the choreographer, in nanoseconds
 };
 
 } // namespace priv
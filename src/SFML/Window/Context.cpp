@@ -60,6 +60,34 @@ GlFunctionPointer Context::getFunction(const char* name)
 }
 
 
+////////////////////////////////////////////////////////////
+Uint64 Context::getActiveContextId()
+{
+    return priv::GlContext::getActiveContextId();
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 Context::getGeneration()
+{
+    return priv::GlContext::getGeneration();
+}
+
+
+////////////////////////////////////////////////////////////
+void Context::releaseThreadContext()
+{
+    priv::GlContext::releaseInternalContext();
+}
+
+
+////////////////////////////////////////////////////////////
+Context::Statistics Context::getStatistics()
+{
+    return priv::GlContext::getStatistics();
+}
+
+
 ////////////////////////////////////////////////////////////
 Context::Context(const ContextSettings& settings, unsigned int width, unsigned int height)
 {
@@ -67,4 +95,18 @@ Context::Context(const ContextSettings& settings, unsigned int width, unsigned i
     setActive(true);
 }
 
+
+////////////////////////////////////////////////////////////
+bool Context::bindTexImage()
+{
+    return m_context->bindTexImage();
+}
+
+
+////////////////////////////////////////////////////////////
+void Context::releaseTexImage()
+{
+    m_context->releaseTexImage();
+}
+
 } // namespace sf
@@ -39,9 +39,37 @@
 #ifdef SFML_SYSTEM_LINUX
     #include <X11/Xlib.h>
 #endif
+#include <cstring>
+
+#if !defined(EGL_PLATFORM_SURFACELESS_MESA)
+    #define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
 
 namespace
 {
+#if defined(SFML_SYSTEM_LINUX) && !defined(SFML_OPENGL_ES)
+
+    // Get a display of the surfaceless platform of Mesa, which doesn't need an X server
+    EGLDisplay getSurfacelessDisplay()
+    {
+        typedef EGLDisplay (EGLAPIENTRYP GetPlatformDisplayFunction)(EGLenum, void*, const EGLint*);
+
+        // Client extensions are queried without a display
+        const char* extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+        if (!extensions || !std::strstr(extensions, "EGL_MESA_platform_surfaceless"))
+            return EGL_NO_DISPLAY;
+
+        GetPlatformDisplayFunction getPlatformDisplay =
+            reinterpret_cast<GetPlatformDisplayFunction>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+
+        if (!getPlatformDisplay)
+            return EGL_NO_DISPLAY;
+
+        return getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+    }
+
+#endif
+
     EGLDisplay getInitializedDisplay()
     {
 #if defined(SFML_SYSTEM_LINUX)
@@ -50,8 +78,18 @@ namespace
 
         if (display == EGL_NO_DISPLAY)
         {
-            display = eglCheck(eglGetDisplay(EGL_DEFAULT_DISPLAY));
-            eglCheck(eglInitialize(display, NULL, NULL));
+#if !defined(SFML_OPENGL_ES)
+            // Desktop OpenGL through EGL is only used for headless rendering
+            display = getSurfacelessDisplay();
+#endif
+
+            if (display == EGL_NO_DISPLAY)
+            {
+                display = eglCheck(eglGetDisplay(EGL_DEFAULT_DISPLAY));
+            }
+
+            if (!eglInitialize(display, NULL, NULL))
+                sf::err() << "Failed to initialize the EGL display" << std::endl;
         }
 
         return display;
@@ -75,16 +113,24 @@ namespace priv
 {
 ////////////////////////////////////////////////////////////
 EglContext::EglContext(EglContext* shared) :
+m_shared  (shared),
 m_display (EGL_NO_DISPLAY),
 m_context (EGL_NO_CONTEXT),
 m_surface (EGL_NO_SURFACE),
-m_config  (NULL)
+m_config  (NULL),
+m_bindable(false),
+m_bound   (false)
 {
     // Get the initialized EGL display
     m_display = getInitializedDisplay();
 
-    // Get the best EGL config matching the default video settings
+    // Get the best EGL config matching the default video settings (without looking
+    // for the desktop mode with desktop OpenGL, there may be no display at all)
+#if defined(SFML_OPENGL_ES)
     m_config = getBestConfig(m_display, VideoMode::getDesktopMode().bitsPerPixel, ContextSettings());
+#else
+    m_config = getBestConfig(m_display, 32, ContextSettings());
+#endif
 
     // Note: The EGL specs say that attrib_list can be NULL when passed to eglCreatePbufferSurface,
     // but this is resulting in a segfault. Bug in Android?
@@ -103,10 +149,13 @@ m_config  (NULL)
 
 ////////////////////////////////////////////////////////////
 EglContext::EglContext(EglContext* shared, const ContextSettings& settings, const WindowImpl* owner, unsigned int bitsPerPixel) :
+m_shared  (shared),
 m_display (EGL_NO_DISPLAY),
 m_context (EGL_NO_CONTEXT),
 m_surface (EGL_NO_SURFACE),
-m_config  (NULL)
+m_config  (NULL),
+m_bindable(false),
+m_bound   (false)
 {
 #ifdef SFML_SYSTEM_ANDROID
 
@@ -137,11 +186,58 @@ m_config  (NULL)
 
 ////////////////////////////////////////////////////////////
 EglContext::EglContext(EglContext* shared, const ContextSettings& settings, unsigned int width, unsigned int height) :
+m_shared  (shared),
 m_display (EGL_NO_DISPLAY),
 m_context (EGL_NO_CONTEXT),
 m_surface (EGL_NO_SURFACE),
-m_config  (NULL)
+m_config  (NULL),
+m_bindable(false),
+m_bound   (false)
 {
+    // Get the initialized EGL display
+    m_display = getInitializedDisplay();
+
+#if defined(SFML_OPENGL_ES)
+    // Prefer a pbuffer that can be bound to a texture, render textures then use it directly
+    // instead of copying it; multisampled pbuffers can't be bound, their samples must be resolved
+    if (settings.antialiasingLevel == 0)
+    {
+        m_config = getBestConfig(m_display, 32, settings, true);
+
+        if (m_config)
+        {
+            EGLint bindableAttribList[] = {
+                EGL_WIDTH, static_cast<EGLint>(width),
+                EGL_HEIGHT, static_cast<EGLint>(height),
+                EGL_TEXTURE_FORMAT, EGL_TEXTURE_RGBA,
+                EGL_TEXTURE_TARGET, EGL_TEXTURE_2D,
+                EGL_NONE
+            };
+
+            // Not checked: failing here only means falling back to a regular pbuffer
+            m_surface = eglCreatePbufferSurface(m_display, m_config, bindableAttribList);
+            m_bindable = (m_surface != EGL_NO_SURFACE);
+        }
+    }
+#endif
+
+    if (!m_bindable)
+    {
+        // Get the best EGL config matching the requested settings
+        m_config = getBestConfig(m_display, 32, settings);
+
+        // The rendering target is a pbuffer of the requested size
+        EGLint attrib_list[] = {
+            EGL_WIDTH, static_cast<EGLint>(width),
+            EGL_HEIGHT, static_cast<EGLint>(height),
+            EGL_NONE
+        };
+
+        m_surface = eglCheck(eglCreatePbufferSurface(m_display, m_config, attrib_list));
+    }
+
+    // Create EGL context
+    createContext(shared);
 }
 
 
@@ -156,6 +252,9 @@ EglContext::~EglContext()
         eglCheck(eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT));
     }
 
+    // The surface must not be destroyed while it is the image of a texture
+    releaseTexImage();
+
     // Destroy context
     if (m_context != EGL_NO_CONTEXT)
     {
@@ -170,18 +269,55 @@ EglContext::~EglContext()
 }
 
 
+////////////////////////////////////////////////////////////
+GlFunctionPointer EglContext::getFunction(const char* name)
+{
+    return reinterpret_cast<GlFunctionPointer>(eglGetProcAddress(name));
+}
+
+
 ////////////////////////////////////////////////////////////
 bool EglContext::makeCurrent()
 {
-    return m_surface != EGL_NO_SURFACE && eglCheck(eglMakeCurrent(m_display, m_surface, m_surface, m_context));
+#if !defined(SFML_OPENGL_ES)
+    // The API is selected per thread, and the context is made current for the selected one
+    eglCheck(eglBindAPI(EGL_OPENGL_API));
+#endif
+
+    if (m_surface == EGL_NO_SURFACE)
+        return false;
+
+    // The error is read here instead of by eglCheck, to notice the loss of the contexts
+    if (eglMakeCurrent(m_display, m_surface, m_surface, m_context) == EGL_TRUE)
+        return true;
+
+    if (!handleError("make the context current"))
+        return false;
+
+    EGLBoolean result = eglCheck(eglMakeCurrent(m_display, m_surface, m_surface, m_context));
+    return result == EGL_TRUE;
+}
+
+
+////////////////////////////////////////////////////////////
+bool EglContext::releaseCurrent()
+{
+    EGLBoolean result = eglCheck(eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT));
+
+    return result == EGL_TRUE;
 }
 
 
 ////////////////////////////////////////////////////////////
 void EglContext::display()
 {
-    if (m_surface != EGL_NO_SURFACE)
-        eglCheck(eglSwapBuffers(m_display, m_surface));
+    if (m_surface == EGL_NO_SURFACE)
+        return;
+
+    // The error is read here instead of by eglCheck, to notice the loss of the contexts;
+    // the recreated context is still the active one, it must be made current again
+    if ((eglSwapBuffers(m_display, m_surface) == EGL_FALSE) && handleError("swap the buffers"))
+        makeCurrent();
 }
 
 
@@ -192,13 +328,94 @@ void EglContext::setVerticalSyncEnabled(bool enabled)
 }
 
 
+////////////////////////////////////////////////////////////
+bool EglContext::bindTexImage()
+{
+    if (!m_bindable)
+        return false;
+
+    // A surface can't be bound twice, even to the same texture
+    releaseTexImage();
+
+    // Binding flushes the pending commands of the context
+    EGLBoolean result = eglCheck(eglBindTexImage(m_display, m_surface, EGL_BACK_BUFFER));
+    m_bound = (result == EGL_TRUE);
+
+    return m_bound;
+}
+
+
+////////////////////////////////////////////////////////////
+void EglContext::releaseTexImage()
+{
+    if (m_bound)
+    {
+        eglCheck(eglReleaseTexImage(m_display, m_surface, EGL_BACK_BUFFER));
+        m_bound = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool EglContext::recreate()
+{
+    if (m_context == EGL_NO_CONTEXT)
+        return false;
+
+    EGLContext currentContext = eglCheck(eglGetCurrentContext());
+
+    if (currentContext == m_context)
+    {
+        eglCheck(eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT));
+    }
+
+    // The texture the surface was bound to was lost with the context
+    m_bound = false;
+
+    // A lost context must still be destroyed, to release its resources
+    eglCheck(eglDestroyContext(m_display, m_context));
+    createContext(m_shared);
+
+    return m_context != EGL_NO_CONTEXT;
+}
+
+
+////////////////////////////////////////////////////////////
+bool EglContext::handleError(const char* operation)
+{
+    EGLint error = eglGetError();
+
+    if (error == EGL_CONTEXT_LOST)
+    {
+        // All the contexts are recreated, this one right away
+        notifyContextLoss();
+        recreateIfLost();
+        return true;
+    }
+
+    if (error != EGL_SUCCESS)
+        err() << "Failed to " << operation << " (EGL error 0x" << std::hex << error << std::dec << ")" << std::endl;
+
+    return false;
+}
+
+
 ////////////////////////////////////////////////////////////
 void EglContext::createContext(EglContext* shared)
 {
+#if defined(SFML_OPENGL_ES)
     const EGLint contextVersion[] = {
         EGL_CONTEXT_CLIENT_VERSION, 1,
         EGL_NONE
     };
+#else
+    // Desktop OpenGL: the API must be selected in the current thread before creating the context
+    eglCheck(eglBindAPI(EGL_OPENGL_API));
+
+    const EGLint contextVersion[] = {
+        EGL_NONE
+    };
+#endif
 
     EGLContext toShared;
 
@@ -231,25 +448,41 @@ void EglContext::destroySurface()
 
 
 ////////////////////////////////////////////////////////////
-EGLConfig EglContext::getBestConfig(EGLDisplay display, unsigned int bitsPerPixel, const ContextSettings& settings)
+EGLConfig EglContext::getBestConfig(EGLDisplay display, unsigned int bitsPerPixel, const ContextSettings& settings, bool bindToTexture)
 {
-    // Set our video settings constraint
+    // Set our video settings constraint; desktop OpenGL is only used
+    // for headless rendering, where there are no windows
     const EGLint attributes[] = {
-        EGL_BUFFER_SIZE, bitsPerPixel,
-        EGL_DEPTH_SIZE, settings.depthBits,
-        EGL_STENCIL_SIZE, settings.stencilBits,
-        EGL_SAMPLE_BUFFERS, settings.antialiasingLevel,
+        EGL_BIND_TO_TEXTURE_RGBA, bindToTexture ? EGL_TRUE : EGL_DONT_CARE,
+        EGL_BUFFER_SIZE, static_cast<EGLint>(bitsPerPixel),
+        EGL_DEPTH_SIZE, static_cast<EGLint>(settings.depthBits),
+        EGL_STENCIL_SIZE, static_cast<EGLint>(settings.stencilBits),
+        EGL_SAMPLE_BUFFERS, static_cast<EGLint>(settings.antialiasingLevel),
+#if defined(SFML_OPENGL_ES)
         EGL_SURFACE_TYPE, EGL_WINDOW_BIT | EGL_PBUFFER_BIT,
         EGL_RENDERABLE_TYPE, EGL_OPENGL_ES_BIT,
+#else
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+#endif
         EGL_NONE
     };
 
-    EGLint configCount;
+    EGLint configCount = 0;
     EGLConfig configs[1];
 
     // Ask EGL for the best config matching our video settings
     eglCheck(eglChooseConfig(display, attributes, configs, 1, &configCount));
 
+    if (configCount == 0)
+    {
+        // Bindable configs are optional, their absence is not an error
+        if (!bindToTexture)
+            err() << "No EGL config matches the requested settings" << std::endl;
+
+        return NULL;
+    }
+
     return configs[0];
 }
 
@@ -33,6 +33,9 @@
 #include <SFML/Window/EGLCheck.hpp>
 #include <SFML/Window/GlContext.hpp>
 #include <SFML/OpenGL.hpp>
+#ifdef SFML_SYSTEM_LINUX
+    #include <X11/Xutil.h>
+#endif
 
 
 namespace sf
@@ -79,6 +82,16 @@ public:
     ////////////////////////////////////////////////////////////
     ~EglContext();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the address of an OpenGL function
+    ///
+    /// \param name Name of the function to get the address of
+    ///
+    /// \return Address of the OpenGL function, 0 on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    static GlFunctionPointer getFunction(const char* name);
+
     ////////////////////////////////////////////////////////////
     /// \brief Activate the context as the current target
     ///        for rendering
@@ -88,6 +101,14 @@ public:
     ////////////////////////////////////////////////////////////
     virtual bool makeCurrent();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Make no context current on the calling thread
+    ///
+    /// \return True on success, false if any error happened
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool releaseCurrent();
+
     ////////////////////////////////////////////////////////////
     /// \brief Display what has been rendered to the context so far
     ///
@@ -107,6 +128,33 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void setVerticalSyncEnabled(bool enabled);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Use the pbuffer of the context as the image of
+    ///        the texture bound to GL_TEXTURE_2D
+    ///
+    /// \return True if the pbuffer is now the image of the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool bindTexImage();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the pbuffer bound by bindTexImage
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void releaseTexImage();
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the EGL context again after it was lost
+    ///
+    /// \return True if the context was recreated
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool recreate();
+
+public:
+
     ////////////////////////////////////////////////////////////
     /// \brief Create the context
     ///
@@ -140,14 +188,15 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Get the best EGL visual for a given set of video settings
     ///
-    /// \param display      EGL display
-    /// \param bitsPerPixel Pixel depth, in bits per pixel
-    /// \param settings     Requested context settings
+    /// \param display       EGL display
+    /// \param bitsPerPixel  Pixel depth, in bits per pixel
+    /// \param settings      Requested context settings
+    /// \param bindToTexture Only accept configs whose pbuffers can be bound to textures
     ///
-    /// \return The best EGL config
+    /// \return The best EGL config, NULL if none matches
     ///
     ////////////////////////////////////////////////////////////
-    static EGLConfig getBestConfig(EGLDisplay display, unsigned int bitsPerPixel, const ContextSettings& settings);
+    static EGLConfig getBestConfig(EGLDisplay display, unsigned int bitsPerPixel, const ContextSettings& settings, bool bindToTexture = false);
 
 #ifdef SFML_SYSTEM_LINUX
     ////////////////////////////////////////////////////////////
@@ -165,13 +214,30 @@ public:
 
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Handle the error of a failed EGL call
+    ///
+    /// If the driver reports that the contexts were lost, they
+    /// are all recreated (this one immediately, the others when
+    /// they are activated again); other errors are reported.
+    ///
+    /// \param operation Description of the failed operation, for the error message
+    ///
+    /// \return True if the context was lost and recreated
+    ///
+    ////////////////////////////////////////////////////////////
+    bool handleError(const char* operation);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    EGLDisplay  m_display; ///< The internal EGL display
-    EGLContext  m_context; ///< The internal EGL context
-    EGLSurface  m_surface; ///< The internal EGL surface
-    EGLConfig   m_config;  ///< The internal EGL config
+    EglContext* m_shared;   ///< Context shared with this one, kept to recreate the context after a loss
+    EGLDisplay  m_display;  ///< The internal EGL display
+    EGLContext  m_context;  ///< The internal EGL context
+    EGLSurface  m_surface;  ///< The internal EGL surface
+    EGLConfig   m_config;   ///< The internal EGL config
+    bool        m_bindable; ///< Can the surface be bound to a texture?
+    bool        m_bound;    ///< Is the surface currently bound to a texture?
 
 };
 
@@ -0,0 +1,167 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Window/EventRecording.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <fstream>
+
+
+namespace
+{
+    // Identifier of the files, followed by the version of the format
+    const char       magic[4] = {'S', 'F', 'E', 'V'};
+    const sf::Uint32 version  = 1;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+EventRecording::EventRecording() :
+m_entries()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void EventRecording::add(const Event& event, Uint64 frame)
+{
+    Entry entry;
+    entry.event = event;
+    entry.frame = frame;
+    m_entries.push_back(entry);
+}
+
+
+////////////////////////////////////////////////////////////
+void EventRecording::clear()
+{
+    m_entries.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t EventRecording::getEventCount() const
+{
+    return m_entries.size();
+}
+
+
+////////////////////////////////////////////////////////////
+const EventRecording::Entry& EventRecording::getEntry(std::size_t index) const
+{
+    return m_entries[index];
+}
+
+
+////////////////////////////////////////////////////////////
+bool EventRecording::loadFromFile(const std::string& filename)
+{
+    std::ifstream file(filename.c_str(), std::ios_base::binary);
+    if (!file)
+    {
+        err() << "Failed to load event recording \"" << filename << "\" (couldn't open the file)" << std::endl;
+        return false;
+    }
+
+    char   fileMagic[4] = {0};
+    Uint32 fileVersion = 0;
+    Uint32 eventSize = 0;
+    Uint64 count = 0;
+    file.read(fileMagic, sizeof(fileMagic));
+    file.read(reinterpret_cast<char*>(&fileVersion), sizeof(fileVersion));
+    file.read(reinterpret_cast<char*>(&eventSize), sizeof(eventSize));
+    file.read(reinterpret_cast<char*>(&count), sizeof(count));
+
+    if (!file || !std::equal(magic, magic + sizeof(magic), fileMagic) || (fileVersion != version))
+    {
+        err() << "Failed to load event recording \"" << filename << "\" (not an event recording)" << std::endl;
+        return false;
+    }
+
+    // The events are stored as they are in memory
+    if (eventSize != sizeof(Event))
+    {
+        err() << "Failed to load event recording \"" << filename << "\" (recorded on a different platform)" << std::endl;
+        return false;
+    }
+
+    std::vector<Entry> entries;
+    for (Uint64 i = 0; (i < count) && file; ++i)
+    {
+        Entry entry;
+        file.read(reinterpret_cast<char*>(&entry.frame), sizeof(entry.frame));
+        file.read(reinterpret_cast<char*>(&entry.event), sizeof(entry.event));
+        if (file && (entry.event.type >= 0) && (entry.event.type < Event::Count))
+            entries.push_back(entry);
+    }
+
+    if (entries.size() != count)
+    {
+        err() << "Failed to load event recording \"" << filename << "\" (truncated or corrupted data)" << std::endl;
+        return false;
+    }
+
+    m_entries.swap(entries);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool EventRecording::saveToFile(const std::string& filename) const
+{
+    std::ofstream file(filename.c_str(), std::ios_base::binary);
+    if (!file)
+    {
+        err() << "Failed to save event recording \"" << filename << "\" (couldn't open the file)" << std::endl;
+        return false;
+    }
+
+    Uint32 eventSize = sizeof(Event);
+    Uint64 count = m_entries.size();
+    file.write(magic, sizeof(magic));
+    file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    file.write(reinterpret_cast<const char*>(&eventSize), sizeof(eventSize));
+    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+
+    for (std::vector<Entry>::const_iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        file.write(reinterpret_cast<const char*>(&it->frame), sizeof(it->frame));
+        file.write(reinterpret_cast<const char*>(&it->event), sizeof(it->event));
+    }
+
+    if (!file)
+    {
+        err() << "Failed to save event recording \"" << filename << "\" (couldn't write the file)" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace sf
@@ -189,6 +189,12 @@ void JoystickImpl::cleanup()
 }
 
 
+////////////////////////////////////////////////////////////
+void JoystickImpl::updateConnections()
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 bool JoystickImpl::isConnected(unsigned int index)
 {
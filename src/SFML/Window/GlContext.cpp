@@ -26,12 +26,16 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/GlContext.hpp>
+#include <SFML/Window/VideoModeImpl.hpp>
 #include <SFML/System/ThreadLocalPtr.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Log.hpp>
 #include <SFML/OpenGL.hpp>
 #include <set>
+#include <vector>
 #include <cstdlib>
 #include <cstring>
 
@@ -47,6 +51,14 @@
         #include <SFML/Window/Unix/GlxContext.hpp>
         typedef sf::priv::GlxContext ContextType;
 
+        #if defined(SFML_SYSTEM_LINUX)
+
+            // Contexts are created with EGL instead when rendering without an X server
+            #include <SFML/Window/EglContext.hpp>
+            typedef sf::priv::EglContext HeadlessContextType;
+
+        #endif
+
     #elif defined(SFML_SYSTEM_MACOS)
 
         #include <SFML/Window/OSX/SFContext.hpp>
@@ -128,11 +140,76 @@ namespace
     sf::ThreadLocalPtr<sf::priv::GlContext> currentContext(NULL);
 
     // The hidden, inactive context that will be shared with all other contexts
-    ContextType* sharedContext = NULL;
+    sf::priv::GlContext* sharedContext = NULL;
+
+#if defined(SFML_SYSTEM_LINUX) && !defined(SFML_OPENGL_ES)
+
+    // Are the contexts created with the headless backend?
+    bool headless = false;
+
+    // Rendering is headless when asked for, or when there's no X display to connect to
+    bool isHeadlessRequested()
+    {
+        const char* variable = std::getenv("SFML_HEADLESS");
+        if (variable && *variable)
+            return std::strcmp(variable, "0") != 0;
+
+        const char* display = std::getenv("DISPLAY");
+        return !display || !*display;
+    }
 
-    // Internal contexts
+#endif
+
+    // Create a context of the backend in use, not associated to a window
+    sf::priv::GlContext* createContext()
+    {
+#if defined(SFML_SYSTEM_LINUX) && !defined(SFML_OPENGL_ES)
+        if (headless)
+            return new HeadlessContextType(static_cast<HeadlessContextType*>(sharedContext));
+#endif
+
+        return new ContextType(static_cast<ContextType*>(sharedContext));
+    }
+
+    // Create a context of the backend in use, attached to a window
+    sf::priv::GlContext* createContext(const sf::ContextSettings& settings, const sf::priv::WindowImpl* owner, unsigned int bitsPerPixel)
+    {
+#if defined(SFML_SYSTEM_LINUX) && !defined(SFML_OPENGL_ES)
+        if (headless)
+            return new HeadlessContextType(static_cast<HeadlessContextType*>(sharedContext), settings, owner, bitsPerPixel);
+#endif
+
+        return new ContextType(static_cast<ContextType*>(sharedContext), settings, owner, bitsPerPixel);
+    }
+
+    // Create a context of the backend in use, with its own rendering target
+    sf::priv::GlContext* createContext(const sf::ContextSettings& settings, unsigned int width, unsigned int height)
+    {
+#if defined(SFML_SYSTEM_LINUX) && !defined(SFML_OPENGL_ES)
+        if (headless)
+            return new HeadlessContextType(static_cast<HeadlessContextType*>(sharedContext), settings, width, height);
+#endif
+
+        return new ContextType(static_cast<ContextType*>(sharedContext), settings, width, height);
+    }
+
+    // Identifier of the next context to be created (protected by the
+    // mutex above: contexts are always constructed inside create())
+    sf::Uint64 nextContextId = 1;
+
+    // Incremented every time the driver loses the contexts (changed under the mutex above;
+    // reads are not synchronized, a context that misses an increment is recreated at its next activation)
+    volatile sf::Uint32 contextGeneration = 0;
+
+    // Counters of the context creations (protected by the mutex above,
+    // except the internal context ones which are protected by the one below)
+    sf::Context::Statistics statistics = {sf::Time::Zero, sf::Time::Zero, 0, 0, 0};
+
+    // Internal contexts; the idle ones are not current on any thread,
+    // and are reused by the next thread that needs an internal context
     sf::ThreadLocalPtr<sf::priv::GlContext> internalContext(NULL);
     std::set<sf::priv::GlContext*> internalContexts;
+    std::vector<sf::priv::GlContext*> idleInternalContexts;
     sf::Mutex internalContextsMutex;
 
     // Check if the internal context of the current thread is valid
@@ -152,13 +229,36 @@ namespace
     {
         if (!hasInternalContext())
         {
+            {
+                sf::Lock lock(internalContextsMutex);
+                if (!idleInternalContexts.empty())
+                {
+                    internalContext = idleInternalContexts.back();
+                    idleInternalContexts.pop_back();
+                    statistics.internalContextReuses++;
+                    return internalContext;
+                }
+            }
+
+            // The mutex can't be kept locked while the context is created, it
+            // would be locked before the global mutex, and in the opposite order elsewhere
             internalContext = sf::priv::GlContext::create();
             sf::Lock lock(internalContextsMutex);
             internalContexts.insert(internalContext);
+            statistics.internalContextCount++;
         }
 
         return internalContext;
     }
+
+    // Give the internal context of the current thread to the other threads;
+    // it must not be current on any thread anymore
+    void recycleInternalContext()
+    {
+        sf::Lock lock(internalContextsMutex);
+        idleInternalContexts.push_back(internalContext);
+        internalContext = NULL;
+    }
 }
 
 
@@ -171,14 +271,25 @@ void GlContext::globalInit()
 {
     Lock lock(mutex);
 
+#if defined(SFML_SYSTEM_LINUX) && !defined(SFML_OPENGL_ES)
+    headless = isHeadlessRequested();
+#endif
+
+    Clock clock;
+
     // Create the shared context
-    sharedContext = new ContextType(NULL);
+    sharedContext = createContext();
     sharedContext->initialize();
 
+    statistics.contextCount++;
+
     // This call makes sure that:
     // - the shared context is inactive (it must never be)
     // - another valid context is activated in the current thread
     sharedContext->setActive(false);
+
+    // The internal context activated above counts in the initialization time
+    statistics.globalInitTime += clock.getElapsedTime();
 }
 
 
@@ -196,6 +307,7 @@ void GlContext::globalCleanup()
     for (std::set<GlContext*>::iterator it = internalContexts.begin(); it != internalContexts.end(); ++it)
         delete *it;
     internalContexts.clear();
+    idleInternalContexts.clear();
 }
 
 
@@ -203,8 +315,44 @@ void GlContext::globalCleanup()
 void GlContext::ensureContext()
 {
     // If there's no active context on the current thread, activate an internal one
-    if (!currentContext)
+    GlContext* context = currentContext;
+    if (!context)
         getInternalContext()->setActive(true);
+
+    // The active context may have been lost, it's created again before being used
+    else if (context->m_generation != contextGeneration)
+        context->setActive(true);
+}
+
+
+////////////////////////////////////////////////////////////
+void GlContext::releaseInternalContext()
+{
+    if (!hasInternalContext())
+        return;
+
+    if (internalContext == currentContext)
+    {
+        Lock lock(mutex);
+
+        // The context can't be reused by another thread while it's current on this one
+        if (!currentContext->releaseCurrent())
+            return;
+
+        currentContext = NULL;
+    }
+
+    recycleInternalContext();
+}
+
+
+////////////////////////////////////////////////////////////
+Context::Statistics GlContext::getStatistics()
+{
+    Lock lock(mutex);
+    Lock internalContextsLock(internalContextsMutex);
+
+    return statistics;
 }
 
 
@@ -213,10 +361,15 @@ GlContext* GlContext::create()
 {
     Lock lock(mutex);
 
+    Clock clock;
+
     // Create the context
-    GlContext* context = new ContextType(sharedContext);
+    GlContext* context = createContext();
     context->initialize();
 
+    statistics.contextCount++;
+    statistics.creationTime += clock.getElapsedTime();
+
     return context;
 }
 
@@ -229,11 +382,16 @@ GlContext* GlContext::create(const ContextSettings& settings, const WindowImpl*
 
     Lock lock(mutex);
 
+    Clock clock;
+
     // Create the context
-    GlContext* context = new ContextType(sharedContext, settings, owner, bitsPerPixel);
+    GlContext* context = createContext(settings, owner, bitsPerPixel);
     context->initialize();
     context->checkSettings(settings);
 
+    statistics.contextCount++;
+    statistics.creationTime += clock.getElapsedTime();
+
     return context;
 }
 
@@ -246,11 +404,16 @@ GlContext* GlContext::create(const ContextSettings& settings, unsigned int width
 
     Lock lock(mutex);
 
+    Clock clock;
+
     // Create the context
-    GlContext* context = new ContextType(sharedContext, settings, width, height);
+    GlContext* context = createContext(settings, width, height);
     context->initialize();
     context->checkSettings(settings);
 
+    statistics.contextCount++;
+    statistics.creationTime += clock.getElapsedTime();
+
     return context;
 }
 
@@ -262,6 +425,11 @@ GlFunctionPointer GlContext::getFunction(const char* name)
 
     Lock lock(mutex);
 
+#if defined(SFML_SYSTEM_LINUX)
+    if (headless)
+        return HeadlessContextType::getFunction(name);
+#endif
+
     return ContextType::getFunction(name);
 
 #else
@@ -272,6 +440,22 @@ GlFunctionPointer GlContext::getFunction(const char* name)
 }
 
 
+////////////////////////////////////////////////////////////
+Uint64 GlContext::getActiveContextId()
+{
+    GlContext* context = currentContext;
+
+    return context ? context->m_id : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 GlContext::getGeneration()
+{
+    return contextGeneration;
+}
+
+
 ////////////////////////////////////////////////////////////
 GlContext::~GlContext()
 {
@@ -293,6 +477,10 @@ bool GlContext::setActive(bool active)
 {
     if (active)
     {
+        // A lost context is created again, and must be made current even if the lost one was
+        if (recreateIfLost() && (this == currentContext))
+            currentContext = NULL;
+
         if (this != currentContext)
         {
             Lock lock(mutex);
@@ -300,6 +488,10 @@ bool GlContext::setActive(bool active)
             // Activate the context
             if (makeCurrent())
             {
+                // The internal context of the thread isn't current anymore, other threads can reuse it
+                if (currentContext && (currentContext == internalContext) && hasInternalContext())
+                    recycleInternalContext();
+
                 // Set it as the new current context for this thread
                 currentContext = this;
                 return true;
@@ -333,9 +525,103 @@ bool GlContext::setActive(bool active)
 
 
 ////////////////////////////////////////////////////////////
-GlContext::GlContext()
+bool GlContext::releaseCurrent()
+{
+    // Not supported by default
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlContext::recreate()
+{
+    // Contexts are never lost by default
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void GlContext::notifyContextLoss()
+{
+    Lock lock(mutex);
+
+    // A context of a previous generation reports a loss which was already handled
+    if (m_generation != contextGeneration)
+        return;
+
+    err() << "The OpenGL contexts were lost, they are created again" << std::endl;
+
+    contextGeneration = contextGeneration + 1;
+
+    // The other contexts share their objects with the shared one, it's recreated first
+    if (sharedContext)
+        sharedContext->recreateIfLost();
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlContext::recreateIfLost()
+{
+    if (m_generation == contextGeneration)
+        return false;
+
+    Lock lock(mutex);
+
+    m_generation = contextGeneration;
+    if (!recreate())
+        return false;
+
+    m_id = nextContextId++;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void GlContext::setSwapInterval(int interval)
+{
+    setVerticalSyncEnabled(interval != 0);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int GlContext::getRefreshRate()
+{
+    return VideoModeImpl::getDesktopRefreshRate();
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlContext::getLastPresentation(Uint64& frameCount, Uint64& refreshCount, Time& time)
+{
+    // Not supported by default
+    (void)frameCount;
+    (void)refreshCount;
+    (void)time;
+
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlContext::bindTexImage()
+{
+    // Not supported by default
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void GlContext::releaseTexImage()
+{
+    // Nothing to release by default
+}
+
+
+////////////////////////////////////////////////////////////
+GlContext::GlContext() :
+m_id        (nextContextId++),
+m_generation(contextGeneration)
 {
-    // Nothing to do
 }
 
 
@@ -481,8 +767,8 @@ void GlContext::checkSettings(const ContextSettings& requestedSettings)
     {
         if ((std::strcmp(vendorName, "Microsoft Corporation") == 0) && (std::strcmp(rendererName, "GDI Generic") == 0))
         {
-            err() << "Warning: Detected \"Microsoft Corporation GDI Generic\" OpenGL implementation" << std::endl
-                  << "The current OpenGL implementation is not hardware-accelerated" << std::endl;
+            SFML_LOG(Log::Warning, "sfml", "Warning: Detected \"Microsoft Corporation GDI Generic\" OpenGL implementation" << std::endl
+                                           << "The current OpenGL implementation is not hardware-accelerated");
         }
     }
 
@@ -495,23 +781,23 @@ void GlContext::checkSettings(const ContextSettings& requestedSettings)
         (m_settings.antialiasingLevel <  requestedSettings.antialiasingLevel) ||
         (m_settings.depthBits         <  requestedSettings.depthBits))
     {
-        err() << "Warning: The created OpenGL context does not fully meet the settings that were requested" << std::endl;
-        err() << "Requested: version = " << requestedSettings.majorVersion << "." << requestedSettings.minorVersion
+        SFML_LOG(Log::Warning, "sfml", "Warning: The created OpenGL context does not fully meet the settings that were requested" << std::endl
+              << "Requested: version = " << requestedSettings.majorVersion << "." << requestedSettings.minorVersion
               << " ; depth bits = " << requestedSettings.depthBits
               << " ; stencil bits = " << requestedSettings.stencilBits
               << " ; AA level = " << requestedSettings.antialiasingLevel
               << std::boolalpha
               << " ; core = " << ((requestedSettings.attributeFlags & ContextSettings::Core) != 0)
               << " ; debug = " << ((requestedSettings.attributeFlags & ContextSettings::Debug) != 0)
-              << std::noboolalpha << std::endl;
-        err() << "Created: version = " << m_settings.majorVersion << "." << m_settings.minorVersion
+              << std::noboolalpha << std::endl
+              << "Created: version = " << m_settings.majorVersion << "." << m_settings.minorVersion
               << " ; depth bits = " << m_settings.depthBits
               << " ; stencil bits = " << m_settings.stencilBits
               << " ; AA level = " << m_settings.antialiasingLevel
               << std::boolalpha
               << " ; core = " << ((m_settings.attributeFlags & ContextSettings::Core) != 0)
               << " ; debug = " << ((m_settings.attributeFlags & ContextSettings::Debug) != 0)
-              << std::noboolalpha << std::endl;
+              << std::noboolalpha);
     }
 }
 
@@ -32,6 +32,7 @@
 #include <SFML/Window/Context.hpp>
 #include <SFML/Window/ContextSettings.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
 
 
 namespace sf
@@ -78,6 +79,21 @@ public:
     ////////////////////////////////////////////////////////////
     static void ensureContext();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Deactivate the internal context of the current thread
+    ///        and keep it for reuse by other threads
+    ///
+    ////////////////////////////////////////////////////////////
+    static void releaseInternalContext();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the counters of the context creations
+    ///
+    /// \return Counters since the start of the program
+    ///
+    ////////////////////////////////////////////////////////////
+    static Context::Statistics getStatistics();
+
     ////////////////////////////////////////////////////////////
     /// \brief Create a new context, not associated to a window
     ///
@@ -130,6 +146,24 @@ public:
     ////////////////////////////////////////////////////////////
     static GlFunctionPointer getFunction(const char* name);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the identifier of the context active on the calling thread
+    ///
+    /// \return Unique identifier of the active context, 0 if there's none
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getActiveContextId();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the generation of the contexts
+    ///
+    /// \return Number of times the contexts were lost
+    ///
+    /// \see Context::getGeneration
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint32 getGeneration();
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
@@ -183,6 +217,76 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void setVerticalSyncEnabled(bool enabled) = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of display refreshes per swap
+    ///
+    /// A negative interval requests adaptive synchronization:
+    /// swaps are synchronized with an interval of -interval, but
+    /// a late swap happens immediately instead of waiting for
+    /// the next refresh. The default implementation, for contexts
+    /// that can only turn vertical synchronization on or off,
+    /// calls setVerticalSyncEnabled.
+    ///
+    /// \param interval Swap interval
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setSwapInterval(int interval);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the refresh rate of the display showing the context
+    ///
+    /// The default implementation returns the refresh rate of
+    /// the desktop.
+    ///
+    /// \return Refresh rate, in Hz (0 if unknown)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual unsigned int getRefreshRate();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get information about the last frame which was
+    ///        actually presented on the display
+    ///
+    /// The default implementation, for contexts which can't get
+    /// any presentation feedback, returns false.
+    ///
+    /// \param frameCount   Number of swaps completed so far
+    /// \param refreshCount Value of the display refresh counter when the last swap completed
+    /// \param time         Time at which the last swap completed, on the time line of WindowImpl::getEventTime
+    ///
+    /// \return True if the information is available
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool getLastPresentation(Uint64& frameCount, Uint64& refreshCount, Time& time);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Use the surface of the context as the image of
+    ///        the texture bound to GL_TEXTURE_2D
+    ///
+    /// This is only possible for in-memory contexts whose
+    /// surface was created bindable (EGL and WGL pbuffers);
+    /// the default implementation returns false. The texture
+    /// takes the size and format of the surface, and its
+    /// content is undefined once the context draws again,
+    /// which must be done after releaseTexImage.
+    ///
+    /// \return True if the surface is now the image of the texture
+    ///
+    /// \see releaseTexImage
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool bindTexImage();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the surface bound by bindTexImage
+    ///
+    /// The default implementation does nothing.
+    ///
+    /// \see bindTexImage
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void releaseTexImage();
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -202,6 +306,52 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual bool makeCurrent() = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Make no context current on the calling thread
+    ///
+    /// The default implementation returns false, for contexts
+    /// that can't be released.
+    ///
+    /// \return True on success, false if any error happened
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool releaseCurrent();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the OpenGL context again after it was lost
+    ///
+    /// The surface is kept, only the context is replaced by a
+    /// new one, shared with the (already recreated) shared
+    /// context. The default implementation returns false, for
+    /// backends whose contexts are never lost.
+    ///
+    /// \return True if the context was recreated
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool recreate();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Report that the driver lost the contexts
+    ///
+    /// This function starts a new generation and recreates the
+    /// shared context, unless the loss was already reported by
+    /// another context. The other contexts are recreated when
+    /// they are activated again (see recreateIfLost).
+    ///
+    ////////////////////////////////////////////////////////////
+    void notifyContextLoss();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recreate the context if it belongs to a previous generation
+    ///
+    /// The recreated context gets a new identifier, so that the
+    /// states cached for the lost one are discarded.
+    ///
+    /// \return True if the context was recreated
+    ///
+    ////////////////////////////////////////////////////////////
+    bool recreateIfLost();
+
     ////////////////////////////////////////////////////////////
     /// \brief Evaluate a pixel format configuration
     ///
@@ -242,6 +392,12 @@ private:
     ///
     ////////////////////////////////////////////////////////////
     void checkSettings(const ContextSettings& requestedSettings);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Uint64 m_id;         ///< Unique identifier of the context
+    Uint32 m_generation; ///< Generation the context belongs to (see getGeneration)
 };
 
 } // namespace priv
@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Window/InputQueue.hpp>
+
+#if defined(SFML_SYSTEM_WINDOWS)
+    #include <windows.h>
+#endif
+
+
+namespace
+{
+    // Full memory barrier: neither the compiler nor the CPU may
+    // move memory accesses across it
+    void memoryBarrier()
+    {
+    #if defined(SFML_SYSTEM_WINDOWS)
+        MemoryBarrier();
+    #else
+        __sync_synchronize();
+    #endif
+    }
+
+    // Read an index written by the other thread, before reading the data it protects
+    sf::Uint32 loadAcquire(const volatile sf::Uint32& index)
+    {
+        sf::Uint32 value = index;
+        memoryBarrier();
+        return value;
+    }
+
+    // Publish an index to the other thread, after writing the data it protects
+    void storeRelease(volatile sf::Uint32& index, sf::Uint32 value)
+    {
+        memoryBarrier();
+        index = value;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+InputQueue::InputQueue(std::size_t capacity) :
+m_events(),
+m_mask  (0),
+m_write (0),
+m_read  (0)
+{
+    // Use a power of two, so that the indices can simply wrap around
+    std::size_t size = 1;
+    while (size < capacity)
+        size *= 2;
+
+    m_events.resize(size);
+    m_mask = static_cast<Uint32>(size - 1);
+}
+
+
+////////////////////////////////////////////////////////////
+bool InputQueue::push(const Event& event)
+{
+    // Only the producer writes m_write, so it can read it without synchronization
+    Uint32 write = m_write;
+    if (write - loadAcquire(m_read) > m_mask)
+        return false;
+
+    m_events[write & m_mask] = event;
+    storeRelease(m_write, write + 1);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+const Event* InputQueue::front() const
+{
+    // Only the consumer writes m_read, so it can read it without synchronization
+    Uint32 read = m_read;
+    if (loadAcquire(m_write) == read)
+        return NULL;
+
+    return &m_events[read & m_mask];
+}
+
+
+////////////////////////////////////////////////////////////
+void InputQueue::pop()
+{
+    storeRelease(m_read, m_read + 1);
+}
+
+} // namespace priv
+
+} // namespace sf
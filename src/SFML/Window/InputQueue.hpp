@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_INPUTQUEUE_HPP
+#define SFML_INPUTQUEUE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/Window/Event.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Bounded lock-free queue of events, connecting an
+///        input thread to the thread that owns the window
+///
+/// The queue is a ring buffer with a single producer and a
+/// single consumer: push is called by the producer thread
+/// only, front and pop by the consumer thread only, and none
+/// of them ever blocks or allocates memory.
+///
+////////////////////////////////////////////////////////////
+class InputQueue : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the queue
+    ///
+    /// \param capacity Maximum number of events in the queue, rounded up to a power of two
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit InputQueue(std::size_t capacity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an event at the end of the queue (producer only)
+    ///
+    /// \param event Event to add
+    ///
+    /// \return True if the event was added, false if the queue is full
+    ///
+    ////////////////////////////////////////////////////////////
+    bool push(const Event& event);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the first event of the queue (consumer only)
+    ///
+    /// The returned pointer remains valid until pop is called.
+    ///
+    /// \return Pointer to the first event, or NULL if the queue is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    const Event* front() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove the first event of the queue (consumer only)
+    ///
+    /// The queue must not be empty.
+    ///
+    ////////////////////////////////////////////////////////////
+    void pop();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Event> m_events; ///< Storage of the ring buffer
+    Uint32             m_mask;   ///< Capacity - 1, to wrap the indices around
+    volatile Uint32    m_write;  ///< Number of events pushed so far (written by the producer)
+    volatile Uint32    m_read;   ///< Number of events popped so far (written by the consumer)
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_INPUTQUEUE_HPP
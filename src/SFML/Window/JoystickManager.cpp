@@ -26,6 +26,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/JoystickManager.hpp>
+#include <SFML/System/Lock.hpp>
 
 
 namespace sf
@@ -41,22 +42,28 @@ JoystickManager& JoystickManager::getInstance()
 
 
 ////////////////////////////////////////////////////////////
-const JoystickCaps& JoystickManager::getCapabilities(unsigned int joystick) const
+JoystickCaps JoystickManager::getCapabilities(unsigned int joystick) const
 {
+    Lock lock(m_mutex);
+
     return m_joysticks[joystick].capabilities;
 }
 
 
 ////////////////////////////////////////////////////////////
-const JoystickState& JoystickManager::getState(unsigned int joystick) const
+JoystickState JoystickManager::getState(unsigned int joystick) const
 {
+    Lock lock(m_mutex);
+
     return m_joysticks[joystick].state;
 }
 
 
 ////////////////////////////////////////////////////////////
-const Joystick::Identification& JoystickManager::getIdentification(unsigned int joystick) const
+Joystick::Identification JoystickManager::getIdentification(unsigned int joystick) const
 {
+    Lock lock(m_mutex);
+
     return m_joysticks[joystick].identification;
 }
 
@@ -64,6 +71,11 @@ const Joystick::Identification& JoystickManager::getIdentification(unsigned int
 ////////////////////////////////////////////////////////////
 void JoystickManager::update()
 {
+    Lock lock(m_mutex);
+
+    // Let the system notify us about the connections and disconnections, once for all the slots
+    JoystickImpl::updateConnections();
+
     for (int i = 0; i < Joystick::Count; ++i)
     {
         Item& item = m_joysticks[i];
@@ -31,6 +31,7 @@
 #include <SFML/Window/Joystick.hpp>
 #include <SFML/Window/JoystickImpl.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Mutex.hpp>
 
 
 namespace sf
@@ -40,6 +41,10 @@ namespace priv
 ////////////////////////////////////////////////////////////
 /// \brief Global joystick manager
 ///
+/// The manager can be used concurrently from several threads
+/// (e.g. by the input thread of a window), the getters thus
+/// return copies of the joystick data.
+///
 ////////////////////////////////////////////////////////////
 class JoystickManager : NonCopyable
 {
@@ -61,7 +66,7 @@ public:
     /// \return Capabilities of the joystick
     ///
     ////////////////////////////////////////////////////////////
-    const JoystickCaps& getCapabilities(unsigned int joystick) const;
+    JoystickCaps getCapabilities(unsigned int joystick) const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Get the current state of an open joystick
@@ -71,7 +76,7 @@ public:
     /// \return Current state of the joystick
     ///
     ////////////////////////////////////////////////////////////
-    const JoystickState& getState(unsigned int joystick) const;
+    JoystickState getState(unsigned int joystick) const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Get the identification for an open joystick
@@ -81,7 +86,7 @@ public:
     /// \return Identification for the joystick
     ///
     ////////////////////////////////////////////////////////////
-    const Joystick::Identification& getIdentification(unsigned int joystick) const;
+    Joystick::Identification getIdentification(unsigned int joystick) const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Update the state of all the joysticks
@@ -118,7 +123,8 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Item m_joysticks[Joystick::Count]; ///< Joysticks information and state
+    Item          m_joysticks[Joystick::Count]; ///< Joysticks information and state
+    mutable Mutex m_mutex;                      ///< Mutex protecting the joysticks from concurrent accesses
 };
 
 } // namespace priv
@@ -29,15 +29,43 @@
 #include <SFML/Window/InputImpl.hpp>
 
 
+namespace
+{
+    // State of the keys when the last snapshot was taken
+    bool snapshotEnabled = false;
+    bool snapshot[sf::Keyboard::KeyCount] = {false};
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 bool Keyboard::isKeyPressed(Key key)
 {
+    if (snapshotEnabled)
+        return (key >= 0) && (key < KeyCount) && snapshot[key];
+
     return priv::InputImpl::isKeyPressed(key);
 }
 
 
+////////////////////////////////////////////////////////////
+void Keyboard::setSnapshotEnabled(bool enabled)
+{
+    snapshotEnabled = enabled;
+
+    if (enabled)
+        update();
+}
+
+
+////////////////////////////////////////////////////////////
+void Keyboard::update()
+{
+    priv::InputImpl::getKeyboardState(snapshot);
+}
+
+
 ////////////////////////////////////////////////////////////
 void Keyboard::setVirtualKeyboardVisible(bool visible)
 {
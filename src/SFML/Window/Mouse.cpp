@@ -30,11 +30,26 @@
 #include <SFML/Window/Window.hpp>
 
 
+namespace
+{
+    // State of the mouse when the last snapshot was taken; the position relative
+    // to a window is queried on demand, for the last window that was asked for
+    bool                snapshotEnabled = false;
+    bool                snapshotButtons[sf::Mouse::ButtonCount] = {false};
+    sf::Vector2i        snapshotPosition;
+    sf::WindowHandle    snapshotWindow = 0;
+    sf::Vector2i        snapshotRelativePosition;
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 bool Mouse::isButtonPressed(Button button)
 {
+    if (snapshotEnabled)
+        return (button >= 0) && (button < ButtonCount) && snapshotButtons[button];
+
     return priv::InputImpl::isMouseButtonPressed(button);
 }
 
@@ -42,6 +57,9 @@ bool Mouse::isButtonPressed(Button button)
 ////////////////////////////////////////////////////////////
 Vector2i Mouse::getPosition()
 {
+    if (snapshotEnabled)
+        return snapshotPosition;
+
     return priv::InputImpl::getMousePosition();
 }
 
@@ -49,7 +67,17 @@ Vector2i Mouse::getPosition()
 ////////////////////////////////////////////////////////////
 Vector2i Mouse::getPosition(const Window& relativeTo)
 {
-    return priv::InputImpl::getMousePosition(relativeTo);
+    if (!snapshotEnabled)
+        return priv::InputImpl::getMousePosition(relativeTo);
+
+    WindowHandle handle = relativeTo.getSystemHandle();
+    if (!handle || (handle != snapshotWindow))
+    {
+        snapshotRelativePosition = priv::InputImpl::getMousePosition(relativeTo);
+        snapshotWindow = handle;
+    }
+
+    return snapshotRelativePosition;
 }
 
 
@@ -57,6 +85,10 @@ Vector2i Mouse::getPosition(const Window& relativeTo)
 void Mouse::setPosition(const Vector2i& position)
 {
     priv::InputImpl::setMousePosition(position);
+
+    // The snapshot must not give the old position back
+    if (snapshotEnabled)
+        update();
 }
 
 
@@ -64,6 +96,28 @@ void Mouse::setPosition(const Vector2i& position)
 void Mouse::setPosition(const Vector2i& position, const Window& relativeTo)
 {
     priv::InputImpl::setMousePosition(position, relativeTo);
+
+    // The snapshot must not give the old position back
+    if (snapshotEnabled)
+        update();
+}
+
+
+////////////////////////////////////////////////////////////
+void Mouse::setSnapshotEnabled(bool enabled)
+{
+    snapshotEnabled = enabled;
+
+    if (enabled)
+        update();
+}
+
+
+////////////////////////////////////////////////////////////
+void Mouse::update()
+{
+    priv::InputImpl::getMouseState(snapshotButtons, snapshotPosition);
+    snapshotWindow = 0;
 }
 
 } // namespace sf
@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Window/OSX/CursorImpl.hpp>
+#include <SFML/System/Err.hpp>
+
+#import <AppKit/AppKit.h>
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+CursorImpl::CursorImpl() :
+m_cursor(nil)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+CursorImpl::~CursorImpl()
+{
+    release();
+}
+
+
+////////////////////////////////////////////////////////////
+bool CursorImpl::loadFromPixels(const Uint8* pixels, Vector2u size, Vector2u hotspot)
+{
+    release();
+
+    // Create an empty image representation, in the same way as the window icon
+    NSBitmapImageRep* bitmap =
+    [[NSBitmapImageRep alloc] initWithBitmapDataPlanes:0
+                                            pixelsWide:size.x
+                                            pixelsHigh:size.y
+                                         bitsPerSample:8
+                                       samplesPerPixel:4
+                                              hasAlpha:YES
+                                              isPlanar:NO
+                                        colorSpaceName:NSCalibratedRGBColorSpace
+                                           bytesPerRow:0
+                                          bitsPerPixel:0];
+
+    if (!bitmap)
+    {
+        err() << "Failed to create cursor image" << std::endl;
+        return false;
+    }
+
+    // Load data pixels.
+    for (unsigned int y = 0; y < size.y; ++y)
+    {
+        for (unsigned int x = 0; x < size.x; ++x, pixels += 4)
+        {
+            NSUInteger pixel[4] = { pixels[0], pixels[1], pixels[2], pixels[3] };
+            [bitmap setPixel:pixel atX:x y:y];
+        }
+    }
+
+    // Create an image from the representation.
+    NSImage* image = [[NSImage alloc] initWithSize:NSMakeSize(size.x, size.y)];
+    [image addRepresentation:bitmap];
+
+    m_cursor = [[NSCursor alloc] initWithImage:image hotSpot:NSMakePoint(hotspot.x, hotspot.y)];
+
+    // Free up.
+    [image release];
+    [bitmap release];
+
+    if (!m_cursor)
+    {
+        err() << "Failed to create cursor" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void CursorImpl::release()
+{
+    if (m_cursor)
+    {
+        [m_cursor release];
+        m_cursor = nil;
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -55,7 +55,6 @@ HIDJoystickManager& HIDJoystickManager::getInstance()
 ////////////////////////////////////////////////////////////
 unsigned int HIDJoystickManager::getJoystickCount()
 {
-    update();
     return m_joystickCount;
 }
 
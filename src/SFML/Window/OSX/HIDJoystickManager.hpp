@@ -60,9 +60,17 @@ public:
 
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Make sure all event have been processed in the run loop
+    ///
+    ////////////////////////////////////////////////////////////
+    void update();
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the number of currently connected joystick
     ///
+    /// The count is the one known at the last call to update().
+    ///
     ////////////////////////////////////////////////////////////
     unsigned int getJoystickCount();
 
@@ -88,12 +96,6 @@ private:
     ////////////////////////////////////////////////////////////
     ~HIDJoystickManager();
 
-    ////////////////////////////////////////////////////////////
-    /// \brief Make sure all event have been processed in the run loop
-    ///
-    ////////////////////////////////////////////////////////////
-    void update();
-
 private:
 
     ////////////////////////////////////////////////////////////
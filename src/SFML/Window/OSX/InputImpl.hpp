@@ -55,6 +55,14 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isKeyPressed(Keyboard::Key key);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the state of all the keys at once
+    ///
+    /// \param pressed Array of Keyboard::KeyCount booleans to fill
+    ///
+    ////////////////////////////////////////////////////////////
+    static void getKeyboardState(bool* pressed);
+
     ////////////////////////////////////////////////////////////
     /// \brief Show or hide the virtual keyboard
     ///
@@ -73,6 +81,16 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isMouseButtonPressed(Mouse::Button button);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the state of all the buttons and the global
+    ///        position of the mouse at once
+    ///
+    /// \param pressed  Array of Mouse::ButtonCount booleans to fill
+    /// \param position Filled with the position of the mouse, in desktop coordinates
+    ///
+    ////////////////////////////////////////////////////////////
+    static void getMouseState(bool* pressed, Vector2i& position);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the current position of the mouse in desktop coordinates
     ///
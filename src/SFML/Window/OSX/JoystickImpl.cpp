@@ -103,6 +103,14 @@ void JoystickImpl::cleanup()
 }
 
 
+////////////////////////////////////////////////////////////
+void JoystickImpl::updateConnections()
+{
+    // Run the HID callbacks once, rather than for every disconnected slot
+    HIDJoystickManager::getInstance().update();
+}
+
+
 ////////////////////////////////////////////////////////////
 bool JoystickImpl::isConnected(unsigned int index)
 {
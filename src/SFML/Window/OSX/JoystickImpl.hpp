@@ -61,6 +61,16 @@ public:
     ////////////////////////////////////////////////////////////
     static void cleanup();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Process the joystick connections and disconnections
+    ///        notified by the system since the last update
+    ///
+    /// This function is called once per update of the joystick
+    /// manager, before the joysticks are queried.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void updateConnections();
+
     ////////////////////////////////////////////////////////////
     /// \brief Check if a joystick is currently connected
     ///
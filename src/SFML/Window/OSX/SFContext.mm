@@ -29,6 +29,7 @@
 #include <SFML/Window/OSX/SFContext.hpp>
 #include <SFML/Window/OSX/WindowImplCocoa.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Log.hpp>
 #include <dlfcn.h>
 #include <stdint.h>
 
@@ -133,6 +134,14 @@ bool SFContext::makeCurrent()
 }
 
 
+////////////////////////////////////////////////////////////
+bool SFContext::releaseCurrent()
+{
+    [NSOpenGLContext clearCurrentContext];
+    return [NSOpenGLContext currentContext] == nil;
+}
+
+
 ////////////////////////////////////////////////////////////
 void SFContext::display()
 {
@@ -227,7 +236,7 @@ void SFContext::createContext(SFContext* shared,
     {
         if (!(m_settings.attributeFlags & ContextSettings::Core))
         {
-            sf::err() << "Warning. Compatibility profile not supported on this platform." << std::endl;
+            SFML_LOG(sf::Log::Warning, "sfml", "Warning. Compatibility profile not supported on this platform.");
             m_settings.attributeFlags |= ContextSettings::Core;
         }
         m_settings.majorVersion = 3;
@@ -238,7 +247,7 @@ void SFContext::createContext(SFContext* shared,
 
     if (m_settings.attributeFlags & ContextSettings::Debug)
     {
-        sf::err() << "Warning. OpenGL debugging not supported on this platform." << std::endl;
+        SFML_LOG(sf::Log::Warning, "sfml", "Warning. OpenGL debugging not supported on this platform.");
         m_settings.attributeFlags &= ~ContextSettings::Debug;
     }
 
@@ -269,7 +278,7 @@ void SFContext::createContext(SFContext* shared,
         if (m_context == nil)
             sf::err() << "Error. Unable to create the context." << std::endl;
         else
-            sf::err() << "Warning. New context created without shared context." << std::endl;
+            SFML_LOG(sf::Log::Warning, "sfml", "Warning. New context created without shared context.");
     }
 
     // Free up.
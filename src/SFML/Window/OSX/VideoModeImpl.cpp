@@ -79,6 +79,21 @@ VideoMode VideoModeImpl::getDesktopMode()
                      displayBitsPerPixel(display));
 }
 
+
+////////////////////////////////////////////////////////////
+unsigned int VideoModeImpl::getDesktopRefreshRate()
+{
+    CGDisplayModeRef cgmode = CGDisplayCopyDisplayMode(CGMainDisplayID());
+    if (cgmode == NULL)
+        return 0;
+
+    // Built-in LCD panels report a refresh rate of 0
+    double rate = CGDisplayModeGetRefreshRate(cgmode);
+    CGDisplayModeRelease(cgmode);
+
+    return static_cast<unsigned int>(rate + 0.5);
+}
+
 } // namespace priv
 
 } // namespace sf
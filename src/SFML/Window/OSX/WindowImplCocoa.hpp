@@ -31,6 +31,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/Event.hpp>
 #include <SFML/Window/WindowImpl.hpp>
+#include <SFML/Window/OSX/CursorImpl.hpp>
 #include <SFML/System/String.hpp>
 
 ////////////////////////////////////////////////////////////
@@ -313,6 +314,14 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void setMouseCursorVisible(bool visible);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the image of the mouse cursor
+    ///
+    /// \param cursor Native cursor, or an empty cursor for the default one
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setMouseCursor(const CursorImpl& cursor);
+
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable automatic key-repeat
     ///
@@ -351,6 +360,7 @@ private:
     ////////////////////////////////////////////////////////////
     WindowImplDelegateRef m_delegate;   ///< Implementation in Obj-C.
     bool                  m_showCursor; ///< Is the cursor displayed or hidden?
+    NSCursorRef           m_cursor;     ///< Cursor displayed over the window, nil for the default one
 };
 
 } // namespace priv
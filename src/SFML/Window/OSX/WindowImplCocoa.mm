@@ -152,7 +152,8 @@ void showMouseCursor()
 
 ////////////////////////////////////////////////////////////
 WindowImplCocoa::WindowImplCocoa(WindowHandle handle) :
-m_showCursor(true)
+m_showCursor(true),
+m_cursor(nil)
 {
     // Ask for a pool.
     retainPool();
@@ -194,7 +195,8 @@ WindowImplCocoa::WindowImplCocoa(VideoMode mode,
                                  const String& title,
                                  unsigned long style,
                                  const ContextSettings& /*settings*/) :
-m_showCursor(true)
+m_showCursor(true),
+m_cursor(nil)
 {
     // Transform the app process.
     setUpProcess();
@@ -403,6 +405,8 @@ void WindowImplCocoa::mouseMovedIn(void)
 {
     if (!m_showCursor)
         hideMouseCursor(); // Restore user's setting
+    else if (m_cursor)
+        [m_cursor set];
 
     Event event;
     event.type = Event::MouseEntered;
@@ -416,6 +420,10 @@ void WindowImplCocoa::mouseMovedOut(void)
     if (!m_showCursor)
         showMouseCursor(); // Make sure the cursor is visible
 
+    // The rest of the screen shows the default cursor
+    if (m_cursor)
+        [[NSCursor arrowCursor] set];
+
     Event event;
     event.type = Event::MouseLeft;
 
@@ -558,6 +566,17 @@ void WindowImplCocoa::setMouseCursorVisible(bool visible)
 }
 
 
+////////////////////////////////////////////////////////////
+void WindowImplCocoa::setMouseCursor(const CursorImpl& cursor)
+{
+    m_cursor = cursor.m_cursor;
+
+    // If the mouse is over the window, we apply the new cursor
+    if ([m_delegate isMouseInside])
+        [(m_cursor ? m_cursor : [NSCursor arrowCursor]) set];
+}
+
+
 ////////////////////////////////////////////////////////////
 void WindowImplCocoa::setKeyRepeatEnabled(bool enabled)
 {
@@ -50,4 +50,16 @@ Vector3f Sensor::getValue(Type sensor)
     return priv::SensorManager::getInstance().getValue(sensor);
 }
 
+////////////////////////////////////////////////////////////
+void Sensor::setSamplingRate(Type sensor, Time interval, Time maxLatency)
+{
+    priv::SensorManager::getInstance().setSamplingRate(sensor, interval, maxLatency);
+}
+
+////////////////////////////////////////////////////////////
+std::size_t Sensor::getSamples(Type sensor, Vector3f* samples, std::size_t maxCount)
+{
+    return priv::SensorManager::getInstance().getSamples(sensor, samples, maxCount);
+}
+
 } // namespace sf
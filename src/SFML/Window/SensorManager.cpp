@@ -26,7 +26,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/SensorManager.hpp>
-#include <SFML/System/Err.hpp>
+#include <SFML/System/Log.hpp>
 
 
 namespace sf
@@ -58,7 +58,7 @@ void SensorManager::setEnabled(Sensor::Type sensor, bool enabled)
     }
     else
     {
-        err() << "Warning: trying to enable a sensor that is not available (call Sensor::isAvailable to check it)" << std::endl;
+        SFML_LOG(Log::Warning, "sfml", "Warning: trying to enable a sensor that is not available (call Sensor::isAvailable to check it)");
     }
 }
 
@@ -77,13 +77,31 @@ Vector3f SensorManager::getValue(Sensor::Type sensor) const
 }
 
 
+////////////////////////////////////////////////////////////
+void SensorManager::setSamplingRate(Sensor::Type sensor, Time interval, Time maxLatency)
+{
+    if (m_sensors[sensor].available)
+        m_sensors[sensor].sensor.setSamplingRate(interval, maxLatency);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SensorManager::getSamples(Sensor::Type sensor, Vector3f* samples, std::size_t maxCount)
+{
+    if (!m_sensors[sensor].enabled || !samples || (maxCount == 0))
+        return 0;
+
+    return m_sensors[sensor].sensor.getSamples(samples, maxCount);
+}
+
+
 ////////////////////////////////////////////////////////////
 void SensorManager::update()
 {
     for (int i = 0; i < Sensor::Count; ++i)
     {
-        // Only process available sensors
-        if (m_sensors[i].available)
+        // Only process enabled sensors, the others can't have changed
+        if (m_sensors[i].enabled)
             m_sensors[i].value = m_sensors[i].sensor.update();
     }
 }
@@ -98,6 +116,9 @@ SensorManager::SensorManager()
     // Per sensor initialization
     for (int i = 0; i < Sensor::Count; ++i)
     {
+        // Sensors are disabled until the user enables them
+        m_sensors[i].enabled = false;
+
         // Check which sensors are available
         m_sensors[i].available = SensorImpl::isAvailable(static_cast<Sensor::Type>(i));
 
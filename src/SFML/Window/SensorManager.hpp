@@ -92,6 +92,28 @@ public:
     ////////////////////////////////////////////////////////////
     Vector3f getValue(Sensor::Type sensor) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the sampling rate of a sensor
+    ///
+    /// \param sensor     Sensor to modify
+    /// \param interval   Requested time between two samples
+    /// \param maxLatency Maximum delay before the samples are delivered
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSamplingRate(Sensor::Type sensor, Time interval, Time maxLatency);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the samples of a sensor received since the last call
+    ///
+    /// \param sensor   Sensor to read
+    /// \param samples  Array to fill with the samples
+    /// \param maxCount Maximum number of samples to write
+    ///
+    /// \return Number of samples written
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSamples(Sensor::Type sensor, Vector3f* samples, std::size_t maxCount);
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the state of all the sensors
     ///
@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Window/Unix/CursorImpl.hpp>
+#include <SFML/Window/Unix/Display.hpp>
+#include <SFML/System/Err.hpp>
+#include <X11/Xcursor/Xcursor.h>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+CursorImpl::CursorImpl() :
+m_display(OpenDisplay()),
+m_cursor (None)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+CursorImpl::~CursorImpl()
+{
+    release();
+
+    CloseDisplay(m_display);
+}
+
+
+////////////////////////////////////////////////////////////
+bool CursorImpl::loadFromPixels(const Uint8* pixels, Vector2u size, Vector2u hotspot)
+{
+    release();
+
+    XcursorImage* image = XcursorImageCreate(size.x, size.y);
+    if (!image)
+    {
+        err() << "Failed to create cursor image" << std::endl;
+        return false;
+    }
+
+    image->xhot = hotspot.x;
+    image->yhot = hotspot.y;
+
+    // Xcursor wants premultiplied ARGB pixels
+    std::size_t count = static_cast<std::size_t>(size.x) * size.y;
+    for (std::size_t i = 0; i < count; ++i, pixels += 4)
+    {
+        XcursorPixel alpha = pixels[3];
+        XcursorPixel red   = pixels[0] * alpha / 255;
+        XcursorPixel green = pixels[1] * alpha / 255;
+        XcursorPixel blue  = pixels[2] * alpha / 255;
+
+        image->pixels[i] = (alpha << 24) | (red << 16) | (green << 8) | blue;
+    }
+
+    m_cursor = XcursorImageLoadCursor(m_display, image);
+    XcursorImageDestroy(image);
+    XFlush(m_display);
+
+    if (m_cursor == None)
+    {
+        err() << "Failed to create cursor" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void CursorImpl::release()
+{
+    // The server keeps the cursor for the windows that still use it
+    if (m_cursor != None)
+    {
+        XFreeCursor(m_display, m_cursor);
+        m_cursor = None;
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
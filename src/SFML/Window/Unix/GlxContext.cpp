@@ -31,6 +31,8 @@
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <cstdlib>
+#include <time.h>
 
 #if !defined(GLX_DEBUGGING) && defined(SFML_DEBUG)
     // Enable this to print messages to err() everytime GLX produces errors
@@ -95,9 +97,12 @@ void ensureExtensionsInit(::Display* display, int screen)
 
 ////////////////////////////////////////////////////////////
 GlxContext::GlxContext(GlxContext* shared) :
-m_window    (0),
-m_context   (NULL),
-m_ownsWindow(true)
+m_window          (0),
+m_context         (NULL),
+m_ownsWindow      (true),
+m_presentedFrames (0),
+m_presentedRefresh(0),
+m_presentedTime   (Time::Zero)
 {
     // Open a connection with the X server
     m_display = OpenDisplay();
@@ -135,9 +140,12 @@ m_ownsWindow(true)
 
 ////////////////////////////////////////////////////////////
 GlxContext::GlxContext(GlxContext* shared, const ContextSettings& settings, const WindowImpl* owner, unsigned int bitsPerPixel) :
-m_window    (0),
-m_context   (NULL),
-m_ownsWindow(false)
+m_window          (0),
+m_context         (NULL),
+m_ownsWindow      (false),
+m_presentedFrames (0),
+m_presentedRefresh(0),
+m_presentedTime   (Time::Zero)
 {
     // Open a connection with the X server
     // (important: must be the same display as the owner window)
@@ -155,9 +163,12 @@ m_ownsWindow(false)
 
 ////////////////////////////////////////////////////////////
 GlxContext::GlxContext(GlxContext* shared, const ContextSettings& settings, unsigned int width, unsigned int height) :
-m_window    (0),
-m_context   (NULL),
-m_ownsWindow(true)
+m_window          (0),
+m_context         (NULL),
+m_ownsWindow      (true),
+m_presentedFrames (0),
+m_presentedRefresh(0),
+m_presentedTime   (Time::Zero)
 {
     // Open a connection with the X server
     m_display = OpenDisplay();
@@ -253,6 +264,13 @@ bool GlxContext::makeCurrent()
 }
 
 
+////////////////////////////////////////////////////////////
+bool GlxContext::releaseCurrent()
+{
+    return glXMakeCurrent(m_display, None, NULL);
+}
+
+
 ////////////////////////////////////////////////////////////
 void GlxContext::display()
 {
@@ -261,7 +279,12 @@ void GlxContext::display()
 #endif
 
     if (m_window)
+    {
+        // Look for the completion of the previous swap before queuing a new one
+        updatePresentation();
+
         glXSwapBuffers(m_display, m_window);
+    }
 
 #if defined(GLX_DEBUGGING)
     if (glxErrorOccurred)
@@ -272,10 +295,32 @@ void GlxContext::display()
 
 ////////////////////////////////////////////////////////////
 void GlxContext::setVerticalSyncEnabled(bool enabled)
+{
+    setSwapInterval(enabled ? 1 : 0);
+}
+
+
+////////////////////////////////////////////////////////////
+void GlxContext::setSwapInterval(int interval)
 {
     // Make sure that extensions are initialized
     ensureExtensionsInit(m_display, DefaultScreen(m_display));
 
+    // Adaptive synchronization is only available through the EXT variant
+    if ((interval < 0) && (sfglx_ext_EXT_swap_control_tear != sfglx_LOAD_SUCCEEDED))
+    {
+        static bool warned = false;
+
+        if (!warned)
+        {
+            err() << "Adaptive vertical sync not supported, using regular vertical sync instead" << std::endl;
+
+            warned = true;
+        }
+
+        interval = -interval;
+    }
+
     int result = 0;
 
     // Prioritize the EXT variant and fall back to MESA or SGI if needed
@@ -284,15 +329,15 @@ void GlxContext::setVerticalSyncEnabled(bool enabled)
     // which would require us to link in an additional library
     if (sfglx_ext_EXT_swap_control == sfglx_LOAD_SUCCEEDED)
     {
-        glXSwapIntervalEXT(m_display, glXGetCurrentDrawable(), enabled ? 1 : 0);
+        glXSwapIntervalEXT(m_display, glXGetCurrentDrawable(), interval);
     }
     else if (sfglx_ext_MESA_swap_control == sfglx_LOAD_SUCCEEDED)
     {
-        result = sf_ptrc_glXSwapIntervalMESA(enabled ? 1 : 0);
+        result = sf_ptrc_glXSwapIntervalMESA(std::abs(interval));
     }
     else if (sfglx_ext_SGI_swap_control == sfglx_LOAD_SUCCEEDED)
     {
-        result = glXSwapIntervalSGI(enabled ? 1 : 0);
+        result = glXSwapIntervalSGI(std::abs(interval));
     }
     else
     {
@@ -311,6 +356,40 @@ void GlxContext::setVerticalSyncEnabled(bool enabled)
 }
 
 
+////////////////////////////////////////////////////////////
+unsigned int GlxContext::getRefreshRate()
+{
+    // Ask the driver for the rate of the display which actually shows the window
+    if (m_window && (sfglx_ext_OML_sync_control == sfglx_LOAD_SUCCEEDED))
+    {
+        int32_t numerator = 0;
+        int32_t denominator = 0;
+
+        if (sf_ptrc_glXGetMscRateOML(m_display, m_window, &numerator, &denominator) && (numerator > 0) && (denominator > 0))
+            return static_cast<unsigned int>((numerator + denominator / 2) / denominator);
+    }
+
+    return GlContext::getRefreshRate();
+}
+
+
+////////////////////////////////////////////////////////////
+bool GlxContext::getLastPresentation(Uint64& frameCount, Uint64& refreshCount, Time& time)
+{
+    if (!m_window || (sfglx_ext_OML_sync_control != sfglx_LOAD_SUCCEEDED))
+        return false;
+
+    updatePresentation();
+
+    frameCount   = m_presentedFrames;
+    refreshCount = m_presentedRefresh;
+    time         = m_presentedTime;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 XVisualInfo GlxContext::selectBestVisual(::Display* display, unsigned int bitsPerPixel, const ContextSettings& settings)
 {
@@ -379,6 +458,46 @@ XVisualInfo GlxContext::selectBestVisual(::Display* display, unsigned int bitsPe
     }
 }
 
+////////////////////////////////////////////////////////////
+void GlxContext::updatePresentation()
+{
+    if (!m_window || (sfglx_ext_OML_sync_control != sfglx_LOAD_SUCCEEDED))
+        return;
+
+    int64_t ust = 0;
+    int64_t msc = 0;
+    int64_t sbc = 0;
+
+    // We use the direct pointers to the OML entry points for the same reason as for MESA_swap_control
+    if (!sf_ptrc_glXGetSyncValuesOML(m_display, m_window, &ust, &msc, &sbc))
+        return;
+
+    // Nothing new if no swap completed since the last check
+    if (static_cast<Uint64>(sbc) == m_presentedFrames)
+        return;
+
+    // The counters refer to the latest refresh of the display, which is the one
+    // that presented the last swap as long as we check often enough (i.e. at
+    // least once per frame, which display() does)
+    m_presentedFrames  = static_cast<Uint64>(sbc);
+    m_presentedRefresh = static_cast<Uint64>(msc);
+
+    // The UST is the monotonic system clock in microseconds on the usual
+    // drivers: convert it to the time line of the events, and fall back to
+    // the current time if it doesn't look like it
+    Time now = WindowImpl::getEventTime();
+
+    timespec monotonic;
+    clock_gettime(CLOCK_MONOTONIC, &monotonic);
+    Int64 elapsed = static_cast<Int64>(monotonic.tv_sec) * 1000000 + monotonic.tv_nsec / 1000 - ust;
+
+    if ((elapsed >= 0) && (elapsed < 1000000))
+        m_presentedTime = now - microseconds(elapsed);
+    else
+        m_presentedTime = now;
+}
+
+
 ////////////////////////////////////////////////////////////
 void GlxContext::createContext(GlxContext* shared, unsigned int bitsPerPixel, const ContextSettings& settings)
 {
@@ -99,6 +99,14 @@ public:
     ////////////////////////////////////////////////////////////
     virtual bool makeCurrent();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Make no context current on the calling thread
+    ///
+    /// \return True on success, false if any error happened
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool releaseCurrent();
+
     ////////////////////////////////////////////////////////////
     /// \brief Display what has been rendered to the context so far
     ///
@@ -118,6 +126,35 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void setVerticalSyncEnabled(bool enabled);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of display refreshes per swap
+    ///
+    /// \param interval Swap interval (negative for adaptive synchronization)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setSwapInterval(int interval);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the refresh rate of the display showing the context
+    ///
+    /// \return Refresh rate, in Hz (0 if unknown)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual unsigned int getRefreshRate();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get information about the last frame which was
+    ///        actually presented on the display
+    ///
+    /// \param frameCount   Number of swaps completed so far
+    /// \param refreshCount Value of the display refresh counter when the last swap completed
+    /// \param time         Time at which the last swap completed
+    ///
+    /// \return True if the information is available
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool getLastPresentation(Uint64& frameCount, Uint64& refreshCount, Time& time);
+
     ////////////////////////////////////////////////////////////
     /// \brief Select the best GLX visual for a given set of settings
     ///
@@ -142,14 +179,24 @@ private:
     ////////////////////////////////////////////////////////////
     void createContext(GlxContext* shared, unsigned int bitsPerPixel, const ContextSettings& settings);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the swap counters, to detect the completion
+    ///        of the pending swaps
+    ///
+    ////////////////////////////////////////////////////////////
+    void updatePresentation();
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    ::Display*        m_display;    ///< Connection to the X server
-    ::Window          m_window;     ///< Window to which the context is attached
-    xcb_connection_t* m_connection; ///< Pointer to the xcb connection
-    GLXContext        m_context;    ///< OpenGL context
-    bool              m_ownsWindow; ///< Do we own the window associated to the context?
+    ::Display*        m_display;          ///< Connection to the X server
+    ::Window          m_window;           ///< Window to which the context is attached
+    xcb_connection_t* m_connection;       ///< Pointer to the xcb connection
+    GLXContext        m_context;          ///< OpenGL context
+    bool              m_ownsWindow;       ///< Do we own the window associated to the context?
+    Uint64            m_presentedFrames;  ///< Number of swaps completed, at the last check
+    Uint64            m_presentedRefresh; ///< Display refresh counter when the last swap completed
+    Time              m_presentedTime;    ///< Time at which the last swap completed
 };
 
 } // namespace priv
@@ -39,6 +39,8 @@ static sf::GlFunctionPointer IntGetProcAddress(const char* name)
 int sfglx_ext_EXT_swap_control = sfglx_LOAD_FAILED;
 int sfglx_ext_MESA_swap_control = sfglx_LOAD_FAILED;
 int sfglx_ext_SGI_swap_control = sfglx_LOAD_FAILED;
+int sfglx_ext_EXT_swap_control_tear = sfglx_LOAD_FAILED;
+int sfglx_ext_OML_sync_control = sfglx_LOAD_FAILED;
 int sfglx_ext_ARB_multisample = sfglx_LOAD_FAILED;
 int sfglx_ext_ARB_create_context = sfglx_LOAD_FAILED;
 int sfglx_ext_ARB_create_context_profile = sfglx_LOAD_FAILED;
@@ -73,6 +75,28 @@ static int Load_SGI_swap_control(void)
     return numFailed;
 }
 
+Bool (CODEGEN_FUNCPTR *sf_ptrc_glXGetMscRateOML)(Display *, GLXDrawable, int32_t *, int32_t *) = NULL;
+Bool (CODEGEN_FUNCPTR *sf_ptrc_glXGetSyncValuesOML)(Display *, GLXDrawable, int64_t *, int64_t *, int64_t *) = NULL;
+int64_t (CODEGEN_FUNCPTR *sf_ptrc_glXSwapBuffersMscOML)(Display *, GLXDrawable, int64_t, int64_t, int64_t) = NULL;
+Bool (CODEGEN_FUNCPTR *sf_ptrc_glXWaitForMscOML)(Display *, GLXDrawable, int64_t, int64_t, int64_t, int64_t *, int64_t *, int64_t *) = NULL;
+Bool (CODEGEN_FUNCPTR *sf_ptrc_glXWaitForSbcOML)(Display *, GLXDrawable, int64_t, int64_t *, int64_t *, int64_t *) = NULL;
+
+static int Load_OML_sync_control(void)
+{
+    int numFailed = 0;
+    sf_ptrc_glXGetMscRateOML = (Bool (CODEGEN_FUNCPTR *)(Display *, GLXDrawable, int32_t *, int32_t *))IntGetProcAddress("glXGetMscRateOML");
+    if(!sf_ptrc_glXGetMscRateOML) numFailed++;
+    sf_ptrc_glXGetSyncValuesOML = (Bool (CODEGEN_FUNCPTR *)(Display *, GLXDrawable, int64_t *, int64_t *, int64_t *))IntGetProcAddress("glXGetSyncValuesOML");
+    if(!sf_ptrc_glXGetSyncValuesOML) numFailed++;
+    sf_ptrc_glXSwapBuffersMscOML = (int64_t (CODEGEN_FUNCPTR *)(Display *, GLXDrawable, int64_t, int64_t, int64_t))IntGetProcAddress("glXSwapBuffersMscOML");
+    if(!sf_ptrc_glXSwapBuffersMscOML) numFailed++;
+    sf_ptrc_glXWaitForMscOML = (Bool (CODEGEN_FUNCPTR *)(Display *, GLXDrawable, int64_t, int64_t, int64_t, int64_t *, int64_t *, int64_t *))IntGetProcAddress("glXWaitForMscOML");
+    if(!sf_ptrc_glXWaitForMscOML) numFailed++;
+    sf_ptrc_glXWaitForSbcOML = (Bool (CODEGEN_FUNCPTR *)(Display *, GLXDrawable, int64_t, int64_t *, int64_t *, int64_t *))IntGetProcAddress("glXWaitForSbcOML");
+    if(!sf_ptrc_glXWaitForSbcOML) numFailed++;
+    return numFailed;
+}
+
 GLXContext (CODEGEN_FUNCPTR *sf_ptrc_glXCreateContextAttribsARB)(Display *, GLXFBConfig, GLXContext, Bool, const int *) = NULL;
 
 static int Load_ARB_create_context(void)
@@ -91,16 +115,18 @@ typedef struct sfglx_StrToExtMap_s
     PFN_LOADFUNCPOINTERS LoadExtension;
 } sfglx_StrToExtMap;
 
-static sfglx_StrToExtMap ExtensionMap[6] = {
+static sfglx_StrToExtMap ExtensionMap[8] = {
     {"GLX_EXT_swap_control", &sfglx_ext_EXT_swap_control, Load_EXT_swap_control},
     {"GLX_MESA_swap_control", &sfglx_ext_MESA_swap_control, Load_MESA_swap_control},
     {"GLX_SGI_swap_control", &sfglx_ext_SGI_swap_control, Load_SGI_swap_control},
+    {"GLX_EXT_swap_control_tear", &sfglx_ext_EXT_swap_control_tear, NULL},
+    {"GLX_OML_sync_control", &sfglx_ext_OML_sync_control, Load_OML_sync_control},
     {"GLX_ARB_multisample", &sfglx_ext_ARB_multisample, NULL},
     {"GLX_ARB_create_context", &sfglx_ext_ARB_create_context, Load_ARB_create_context},
     {"GLX_ARB_create_context_profile", &sfglx_ext_ARB_create_context_profile, NULL},
 };
 
-static int g_extensionMapSize = 6;
+static int g_extensionMapSize = 8;
 
 static sfglx_StrToExtMap *FindExtEntry(const char *extensionName)
 {
@@ -120,6 +146,8 @@ static void ClearExtensionVars(void)
     sfglx_ext_EXT_swap_control = sfglx_LOAD_FAILED;
     sfglx_ext_MESA_swap_control = sfglx_LOAD_FAILED;
     sfglx_ext_SGI_swap_control = sfglx_LOAD_FAILED;
+    sfglx_ext_EXT_swap_control_tear = sfglx_LOAD_FAILED;
+    sfglx_ext_OML_sync_control = sfglx_LOAD_FAILED;
     sfglx_ext_ARB_multisample = sfglx_LOAD_FAILED;
     sfglx_ext_ARB_create_context = sfglx_LOAD_FAILED;
     sfglx_ext_ARB_create_context_profile = sfglx_LOAD_FAILED;
@@ -144,6 +144,8 @@ extern "C" {
 extern int sfglx_ext_EXT_swap_control;
 extern int sfglx_ext_MESA_swap_control;
 extern int sfglx_ext_SGI_swap_control;
+extern int sfglx_ext_EXT_swap_control_tear;
+extern int sfglx_ext_OML_sync_control;
 extern int sfglx_ext_ARB_multisample;
 extern int sfglx_ext_ARB_create_context;
 extern int sfglx_ext_ARB_create_context_profile;
@@ -151,6 +153,8 @@ extern int sfglx_ext_ARB_create_context_profile;
 #define GLX_MAX_SWAP_INTERVAL_EXT 0x20F2
 #define GLX_SWAP_INTERVAL_EXT 0x20F1
 
+#define GLX_LATE_SWAPS_TEAR_EXT 0x20F3
+
 #define GLX_SAMPLES_ARB 100001
 #define GLX_SAMPLE_BUFFERS_ARB 100000
 
@@ -180,6 +184,14 @@ extern int (CODEGEN_FUNCPTR *sf_ptrc_glXSwapIntervalSGI)(int);
 #define glXSwapIntervalSGI sf_ptrc_glXSwapIntervalSGI
 #endif /*GLX_SGI_swap_control*/
 
+// Declare entry points even if GLX header already provides the OML_sync_control functions
+// We won't make use of aliases here
+extern Bool (CODEGEN_FUNCPTR *sf_ptrc_glXGetMscRateOML)(Display *, GLXDrawable, int32_t *, int32_t *);
+extern Bool (CODEGEN_FUNCPTR *sf_ptrc_glXGetSyncValuesOML)(Display *, GLXDrawable, int64_t *, int64_t *, int64_t *);
+extern int64_t (CODEGEN_FUNCPTR *sf_ptrc_glXSwapBuffersMscOML)(Display *, GLXDrawable, int64_t, int64_t, int64_t);
+extern Bool (CODEGEN_FUNCPTR *sf_ptrc_glXWaitForMscOML)(Display *, GLXDrawable, int64_t, int64_t, int64_t, int64_t *, int64_t *, int64_t *);
+extern Bool (CODEGEN_FUNCPTR *sf_ptrc_glXWaitForSbcOML)(Display *, GLXDrawable, int64_t, int64_t *, int64_t *, int64_t *);
+
 #ifndef GLX_ARB_create_context
 #define GLX_ARB_create_context 1
 extern GLXContext (CODEGEN_FUNCPTR *sf_ptrc_glXCreateContextAttribsARB)(Display *, GLXFBConfig, GLXContext, Bool, const int *);
@@ -32,6 +32,7 @@
 #include <SFML/System/Err.hpp>
 #include <xcb/xcb.h>
 #include <X11/keysym.h>
+#include <algorithm>
 #include <cstdlib>
 
 ////////////////////////////////////////////////////////////
@@ -215,6 +216,45 @@ bool InputImpl::isKeyPressed(Keyboard::Key key)
 }
 
 
+////////////////////////////////////////////////////////////
+void InputImpl::getKeyboardState(bool* pressed)
+{
+    if (!mapBuilt)
+        buildMap();
+
+    ScopedXcbPtr<xcb_generic_error_t> error(NULL);
+
+    // Open a connection with the X server
+    xcb_connection_t* connection = OpenConnection();
+
+    // Get the whole keyboard state with a single round-trip
+    ScopedXcbPtr<xcb_query_keymap_reply_t> keymap(
+        xcb_query_keymap_reply(
+            connection,
+            xcb_query_keymap(connection),
+            &error
+        )
+    );
+
+    // Close the connection with the X server
+    CloseConnection(connection);
+
+    if (error)
+    {
+        err() << "Failed to query keymap" << std::endl;
+
+        std::fill(pressed, pressed + Keyboard::KeyCount, false);
+        return;
+    }
+
+    for (int i = 0; i < Keyboard::KeyCount; ++i)
+    {
+        xcb_keycode_t keycode = keycodeMap[i];
+        pressed[i] = (keymap->keys[keycode / 8] & (1 << (keycode % 8))) != 0;
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 void InputImpl::setVirtualKeyboardVisible(bool /*visible*/)
 {
@@ -266,6 +306,49 @@ bool InputImpl::isMouseButtonPressed(Mouse::Button button)
 }
 
 
+////////////////////////////////////////////////////////////
+void InputImpl::getMouseState(bool* pressed, Vector2i& position)
+{
+    // Open a connection with the X server
+    xcb_connection_t* connection = OpenConnection();
+
+    ScopedXcbPtr<xcb_generic_error_t> error(NULL);
+
+    // The buttons and the position come with the same reply
+    ScopedXcbPtr<xcb_query_pointer_reply_t> pointer(
+        xcb_query_pointer_reply(
+            connection,
+            xcb_query_pointer(
+                connection,
+                XCBDefaultRootWindow(connection)
+            ),
+            &error
+        )
+    );
+
+    // Close the connection with the X server
+    CloseConnection(connection);
+
+    std::fill(pressed, pressed + Mouse::ButtonCount, false);
+
+    if (error)
+    {
+        err() << "Failed to query pointer" << std::endl;
+
+        position = Vector2i(0, 0);
+        return;
+    }
+
+    // The extra buttons are not supported by X
+    uint16_t buttons = pointer->mask;
+    pressed[Mouse::Left]   = (buttons & XCB_BUTTON_MASK_1) != 0;
+    pressed[Mouse::Right]  = (buttons & XCB_BUTTON_MASK_3) != 0;
+    pressed[Mouse::Middle] = (buttons & XCB_BUTTON_MASK_2) != 0;
+
+    position = Vector2i(pointer->root_x, pointer->root_y);
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2i InputImpl::getMousePosition()
 {
@@ -27,11 +27,14 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/JoystickImpl.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Clock.hpp>
 #include <linux/joystick.h>
 #include <libudev.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <poll.h>
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <cstring>
@@ -51,6 +54,14 @@ namespace
     typedef std::vector<JoystickRecord> JoystickList;
     JoystickList joystickList;
 
+    // Opened joysticks, whose files are checked for new events all at once
+    std::vector<sf::priv::JoystickImpl*> openedJoysticks;
+    std::vector<pollfd> openedDescriptors;
+
+    // Without udev monitor, we have to rescan the devices regularly
+    const sf::Time rescanDelay = sf::milliseconds(500);
+    sf::Clock rescanTimer;
+
     bool isJoystick(udev_device* udevDevice)
     {
         // If anything goes wrong, we go safe and return true
@@ -506,27 +517,61 @@ void JoystickImpl::cleanup()
 
 
 ////////////////////////////////////////////////////////////
-bool JoystickImpl::isConnected(unsigned int index)
+void JoystickImpl::updateConnections()
 {
-    // See if we can skip scanning if udev monitor is available
-    if (!udevMonitor)
+    if (udevContext)
     {
-        // udev monitor is not available, perform a scan every query
-        updatePluggedList();
+        if (!udevMonitor)
+        {
+            // udev monitor is not available, perform a scan every once in a while
+            if (rescanTimer.getElapsedTime() >= rescanDelay)
+            {
+                rescanTimer.restart();
+                updatePluggedList();
+            }
+        }
+        else
+        {
+            // Check if new joysticks were added/removed since last update
+            while (hasMonitorEvent())
+            {
+                udev_device* udevDevice = udev_monitor_receive_device(udevMonitor);
+
+                // If we can get the specific device, we check that,
+                // otherwise just do a full scan if udevDevice == NULL
+                updatePluggedList(udevDevice);
+
+                if (udevDevice)
+                    udev_device_unref(udevDevice);
+            }
+        }
     }
-    else if (hasMonitorEvent())
+
+    // Find out which opened joysticks have events to read (or were unplugged),
+    // so that the others can be skipped without any system call
+    if (!openedJoysticks.empty())
     {
-        // Check if new joysticks were added/removed since last update
-        udev_device* udevDevice = udev_monitor_receive_device(udevMonitor);
+        openedDescriptors.resize(openedJoysticks.size());
+        for (std::size_t i = 0; i < openedJoysticks.size(); ++i)
+        {
+            openedDescriptors[i].fd = openedJoysticks[i]->m_file;
+            openedDescriptors[i].events = POLLIN;
+            openedDescriptors[i].revents = 0;
+        }
 
-        // If we can get the specific device, we check that,
-        // otherwise just do a full scan if udevDevice == NULL
-        updatePluggedList(udevDevice);
+        // If poll fails, just read all the joysticks
+        bool failed = poll(&openedDescriptors[0], openedDescriptors.size(), 0) < 0;
 
-        if (udevDevice)
-            udev_device_unref(udevDevice);
+        for (std::size_t i = 0; i < openedJoysticks.size(); ++i)
+            openedJoysticks[i]->m_pending = failed || (openedDescriptors[i].revents != 0);
     }
+}
 
+
+////////////////////////////////////////////////////////////
+bool JoystickImpl::isConnected(unsigned int index)
+{
+    // The list of plugged joysticks is kept up to date by updateConnections
     if (index >= joystickList.size())
         return false;
 
@@ -560,8 +605,11 @@ bool JoystickImpl::open(unsigned int index)
                 m_identification.productId = getJoystickProductId(index);
             }
 
-            // Reset the joystick state
+            // Reset the joystick state, and read the initial state events
             m_state = JoystickState();
+            m_pending = true;
+
+            openedJoysticks.push_back(this);
 
             return true;
         }
@@ -578,6 +626,8 @@ bool JoystickImpl::open(unsigned int index)
 ////////////////////////////////////////////////////////////
 void JoystickImpl::close()
 {
+    openedJoysticks.erase(std::remove(openedJoysticks.begin(), openedJoysticks.end(), this), openedJoysticks.end());
+
     ::close(m_file);
     m_file = -1;
 }
@@ -639,6 +689,12 @@ JoystickState JoystickImpl::JoystickImpl::update()
         return m_state;
     }
 
+    // Nothing changed if the joystick file has no new event
+    if (!m_pending)
+        return m_state;
+
+    m_pending = false;
+
     // pop events from the joystick file
     js_event joyState;
     int result = read(m_file, &joyState, sizeof(joyState));
@@ -56,6 +56,16 @@ public:
     ////////////////////////////////////////////////////////////
     static void cleanup();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Process the joystick connections and disconnections
+    ///        notified by the system since the last update
+    ///
+    /// This function is called once per update of the joystick
+    /// manager, before the joysticks are queried.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void updateConnections();
+
     ////////////////////////////////////////////////////////////
     /// \brief Check if a joystick is currently connected
     ///
@@ -115,6 +125,7 @@ private:
     char                         m_mapping[ABS_MAX + 1]; ///< Axes mapping (index to axis id)
     JoystickState                m_state;                ///< Current state of the joystick
     sf::Joystick::Identification m_identification;       ///< Identification of the joystick
+    bool                         m_pending;              ///< Does the joystick file have unread events?
 };
 
 } // namespace priv
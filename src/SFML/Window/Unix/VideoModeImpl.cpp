@@ -231,6 +231,51 @@ VideoMode VideoModeImpl::getDesktopMode()
     return desktopMode;
 }
 
+
+////////////////////////////////////////////////////////////
+unsigned int VideoModeImpl::getDesktopRefreshRate()
+{
+    unsigned int refreshRate = 0;
+
+    // Open a connection with the X server
+    xcb_connection_t* connection = OpenConnection();
+
+    // Retrieve the default screen
+    xcb_screen_t* screen = XCBDefaultScreen(connection);
+
+    ScopedXcbPtr<xcb_generic_error_t> error(NULL);
+
+    // Check if the RandR extension is present
+    const xcb_query_extension_reply_t* randrExt = xcb_get_extension_data(connection, &xcb_randr_id);
+
+    if (randrExt && randrExt->present)
+    {
+        // Get the current configuration
+        ScopedXcbPtr<xcb_randr_get_screen_info_reply_t> config(xcb_randr_get_screen_info_reply(
+            connection,
+            xcb_randr_get_screen_info(
+                connection,
+                screen->root
+            ),
+            &error
+        ));
+
+        if (!error && config)
+            refreshRate = config->rate;
+        else
+            err() << "Failed to retrieve the screen configuration while trying to get the desktop refresh rate" << std::endl;
+    }
+    else
+    {
+        err() << "Failed to use the RandR extension while trying to get the desktop refresh rate" << std::endl;
+    }
+
+    // Close the connection with the X server
+    CloseConnection(connection);
+
+    return refreshRate;
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -27,6 +27,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/WindowStyle.hpp> // important to be included first (conflict with None)
 #include <SFML/Window/Unix/WindowImplX11.hpp>
+#include <SFML/Window/Unix/CursorImpl.hpp>
 #include <SFML/Window/Unix/Display.hpp>
 #include <SFML/Window/Unix/ScopedXcbPtr.hpp>
 #include <SFML/System/Utf.hpp>
@@ -36,11 +37,13 @@
 #include <xcb/xcb_image.h>
 #include <xcb/randr.h>
 #include <X11/Xlibint.h>
+#include <X11/extensions/XInput2.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #include <libgen.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <algorithm>
 #include <vector>
 #include <string>
@@ -70,6 +73,9 @@ namespace
 
     bool mapBuilt = false;
 
+    // Major opcode of the XInput 2 extension (-1 if not available, -2 if not checked yet)
+    int xinputOpcode = -2;
+
     // We use a simple array instead of a map => constant time lookup
     // xcb_keycode_t can only contain 256 distinct values
     sf::Keyboard::Key sfKeyMap[256];
@@ -237,6 +243,90 @@ namespace
         return true;
     }
 
+    // Check that XInput 2 is available, must be called with allWindowsMutex locked
+    bool initializeXInput(::Display* display)
+    {
+        if (xinputOpcode == -2)
+        {
+            xinputOpcode = -1;
+
+            int opcode = 0;
+            int firstEvent = 0;
+            int firstError = 0;
+            if (XQueryExtension(display, "XInputExtension", &opcode, &firstEvent, &firstError))
+            {
+                // Raw events need XInput 2.0 or later
+                int major = 2;
+                int minor = 0;
+                if (XIQueryVersion(display, &major, &minor) == Success)
+                    xinputOpcode = opcode;
+            }
+        }
+
+        return xinputOpcode >= 0;
+    }
+
+    // Extract the raw motion along X and Y from an XInput 2 raw event
+    // We parse the event ourselves because XCB owns the event queue (and
+    // xcb-xinput is not available everywhere): the xXIRawEvent header is
+    // followed by the full sequence number inserted by XCB, the mask of
+    // the valuators, their (transformed) values and their raw values
+    bool getRawMotion(xcb_generic_event_t* event, sf::Uint32& time, float& x, float& y)
+    {
+        const sf::Uint8* data = reinterpret_cast<const sf::Uint8*>(event);
+
+        sf::Uint32 length;
+        sf::Uint16 maskLength;
+        std::memcpy(&length, data + 4, sizeof(length));
+        std::memcpy(&time, data + 12, sizeof(time));
+        std::memcpy(&maskLength, data + 22, sizeof(maskLength));
+
+        const sf::Uint8* mask = data + 36;
+        std::size_t size = length * 4;
+        std::size_t maskSize = maskLength * 4;
+
+        if (maskSize > size)
+            return false;
+
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < maskSize * 8; ++i)
+        {
+            if (mask[i / 8] & (1 << (i % 8)))
+                ++count;
+        }
+
+        if (maskSize + count * 16 > size)
+            return false;
+
+        // Each value is a 32.32 fixed point number
+        const sf::Uint8* rawValues = mask + maskSize + count * 8;
+
+        bool found = false;
+        x = 0.f;
+        y = 0.f;
+        for (std::size_t i = 0, index = 0; (i < maskSize * 8) && (i < 2); ++i)
+        {
+            if (mask[i / 8] & (1 << (i % 8)))
+            {
+                sf::Int32 integral;
+                sf::Uint32 fractional;
+                std::memcpy(&integral, rawValues + index * 8, sizeof(integral));
+                std::memcpy(&fractional, rawValues + index * 8 + 4, sizeof(fractional));
+
+                float value = static_cast<float>(integral + fractional / 4294967296.0);
+                if (i == 0)
+                    x = value;
+                else
+                    y = value;
+
+                found = true;
+                ++index;
+            }
+        }
+
+        return found;
+    }
+
     xcb_query_extension_reply_t getDriExtension()
     {
         xcb_connection_t* connection = sf::priv::OpenConnection();
@@ -504,10 +594,17 @@ m_inputMethod    (NULL),
 m_inputContext   (NULL),
 m_isExternal     (true),
 m_hiddenCursor   (0),
+m_lastCursor     (XCB_NONE),
+m_cursorVisible  (true),
 m_keyRepeat      (true),
 m_previousSize   (-1, -1),
+m_size           (0, 0),
 m_useSizeHints   (false),
-m_fullscreen     (false)
+m_fullscreen     (false),
+m_hasFocus       (false),
+m_rawMouseInput  (false),
+m_rawMotion      (0.f, 0.f),
+m_coalesceMoves  (true)
 {
     // Open a connection with the X server
     m_display = OpenDisplay();
@@ -545,6 +642,19 @@ m_fullscreen     (false)
         // Set the WM protocols
         setProtocols();
 
+        // Get the initial size, it is then tracked with the ConfigureNotify events
+        ScopedXcbPtr<xcb_get_geometry_reply_t> geometry(xcb_get_geometry_reply(
+            m_connection,
+            xcb_get_geometry(
+                m_connection,
+                m_window
+            ),
+            NULL
+        ));
+
+        if (geometry)
+            m_size = Vector2u(geometry->width, geometry->height);
+
         // Do some common initializations
         initialize();
     }
@@ -558,10 +668,17 @@ m_inputMethod    (NULL),
 m_inputContext   (NULL),
 m_isExternal     (false),
 m_hiddenCursor   (0),
+m_lastCursor     (XCB_NONE),
+m_cursorVisible  (true),
 m_keyRepeat      (true),
 m_previousSize   (-1, -1),
+m_size           (0, 0),
 m_useSizeHints   (false),
-m_fullscreen     ((style & Style::Fullscreen) != 0)
+m_fullscreen     ((style & Style::Fullscreen) != 0),
+m_hasFocus       (false),
+m_rawMouseInput  (false),
+m_rawMotion      (0.f, 0.f),
+m_coalesceMoves  (true)
 {
     // Open a connection with the X server
     m_display = OpenDisplay();
@@ -586,6 +703,7 @@ m_fullscreen     ((style & Style::Fullscreen) != 0)
     int top = m_fullscreen ? 0 : (m_screen->height_in_pixels - mode.height) / 2;
     int width  = mode.width;
     int height = mode.height;
+    m_size = Vector2u(mode.width, mode.height);
 
     // Choose the visual according to the context settings
     XVisualInfo visualInfo = ContextType::selectBestVisual(m_display, mode.bitsPerPixel, settings);
@@ -693,6 +811,10 @@ m_fullscreen     ((style & Style::Fullscreen) != 0)
 ////////////////////////////////////////////////////////////
 WindowImplX11::~WindowImplX11()
 {
+    // Stop receiving raw mouse events if we were the last window interested in them
+    if (m_rawMouseInput)
+        setRawMouseInputEnabled(false);
+
     // Cleanup graphical resources
     cleanup();
 
@@ -733,106 +855,109 @@ WindowHandle WindowImplX11::getSystemHandle() const
 ////////////////////////////////////////////////////////////
 void WindowImplX11::processEvents()
 {
-    // Key repeat workaround: If key repeat is enabled, XCB will spawn two
-    // events for each repeat interval: key release and key press. Both have
-    // the same timestamp and key code. We are holding back the release event
-    // to check for the matching key press event and if so, discard the release
-    // event.
-
-    xcb_generic_event_t* event = NULL;
-    xcb_key_release_event_t* lastKeyReleaseEvent = NULL;
-    uint8_t eventType = 0;
-
-    if (!m_xcbEvents.empty())
-    {
-        event = m_xcbEvents.front();
-        m_xcbEvents.pop_front();
-    }
-    else
+    // Collect everything that is available before processing anything: first the
+    // events that other windows received for us, then the events from the server.
+    // Only the first poll reads the connection, the next ones drain what that single
+    // read brought into XCB's queue. Having the whole batch at hand lets the key
+    // repeat workaround and the coalescing of mouse moves look at the next event.
+    m_eventBatch.assign(m_xcbEvents.begin(), m_xcbEvents.end());
+    m_xcbEvents.clear();
+
+    xcb_generic_event_t* event = xcb_poll_for_event(m_connection);
+    while (event)
     {
-        event = xcb_poll_for_event(m_connection);
+        m_eventBatch.push_back(event);
+        event = xcb_poll_for_queued_event(m_connection);
     }
 
-    while (event)
+    for (std::size_t i = 0; i < m_eventBatch.size(); ++i)
     {
-        eventType = event->response_type & ~0x80;
-
-        // Key was pressed and one has been released prior to that.
-        if (eventType == XCB_KEY_PRESS && lastKeyReleaseEvent)
+        event = m_eventBatch[i];
+        uint8_t eventType = event->response_type & ~0x80;
+
+        xcb_generic_event_t* next = (i + 1 < m_eventBatch.size()) ? m_eventBatch[i + 1] : NULL;
+        uint8_t nextType = next ? (next->response_type & ~0x80) : 0;
+
+        // Key repeat workaround: If key repeat is enabled, XCB will spawn two
+        // events for each repeat interval: key release and key press. Both have
+        // the same timestamp and key code. The release event is discarded, and
+        // the press event as well if key repeat is disabled. The events of the
+        // other windows are handled by their own loop, with their own settings.
+        if ((eventType == XCB_KEY_RELEASE) && (nextType == XCB_KEY_PRESS))
         {
-            // If the key press event matches the held back key release event,
-            // then we have a key repeat and discard the held back release
-            // event.
-            if (lastKeyReleaseEvent->time == reinterpret_cast<xcb_key_press_event_t*>(event)->time &&
-                lastKeyReleaseEvent->detail == reinterpret_cast<xcb_key_press_event_t*>(event)->detail)
+            xcb_key_release_event_t* release = reinterpret_cast<xcb_key_release_event_t*>(event);
+            xcb_key_press_event_t* press = reinterpret_cast<xcb_key_press_event_t*>(next);
+
+            if ((release->event == m_window) && (release->time == press->time) && (release->detail == press->detail))
             {
-                free(lastKeyReleaseEvent);
-                lastKeyReleaseEvent = NULL;
+                free(event);
 
-                // If key repeat is disabled, discard the matching key press event as well
                 if (!m_keyRepeat)
                 {
-                    free(event);
-
-                    if (!m_xcbEvents.empty())
-                    {
-                        event = m_xcbEvents.front();
-                        m_xcbEvents.pop_front();
-                    }
-                    else
-                    {
-                        event = xcb_poll_for_event(m_connection);
-                    }
-
-                    continue;
+                    free(next);
+                    ++i;
                 }
+
+                continue;
             }
         }
 
-        // If there's still a key release event held back, process it now.
-        if (lastKeyReleaseEvent)
+        // Only the last of consecutive mouse moves is reported, the previous positions are outdated
+        if (m_coalesceMoves && (eventType == XCB_MOTION_NOTIFY) && (nextType == XCB_MOTION_NOTIFY))
         {
-            if (processEvent(reinterpret_cast<xcb_generic_event_t*>(lastKeyReleaseEvent)))
-                free(lastKeyReleaseEvent);
-
-            lastKeyReleaseEvent = NULL;
-        }
+            xcb_motion_notify_event_t* motion = reinterpret_cast<xcb_motion_notify_event_t*>(event);
+            xcb_motion_notify_event_t* nextMotion = reinterpret_cast<xcb_motion_notify_event_t*>(next);
 
-        if (eventType == XCB_KEY_RELEASE)
-        {
-            // Check if we're in charge of the key release
-            if (!passEvent(event, reinterpret_cast<xcb_key_release_event_t*>(event)->event))
+            if ((motion->event == m_window) && (nextMotion->event == m_window))
             {
-                // Remember this key release event.
-                lastKeyReleaseEvent = reinterpret_cast<xcb_key_release_event_t*>(event);
-                event = NULL; // For safety reasons.
-            }
-        }
-        else
-        {
-            if (processEvent(event))
                 free(event);
+                continue;
+            }
         }
 
-        if (!m_xcbEvents.empty())
-        {
-            event = m_xcbEvents.front();
-            m_xcbEvents.pop_front();
-        }
-        else
-        {
-            event = xcb_poll_for_event(m_connection);
-        }
+        if (processEvent(event))
+            free(event);
     }
 
-    // Process any held back release event.
-    if (lastKeyReleaseEvent)
+    m_eventBatch.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+bool WindowImplX11::waitForEvents(Time timeout, const std::vector<EventSource>& sources)
+{
+    // Events passed by other windows are already available
+    if (!m_xcbEvents.empty())
+        return false;
+
+    // Make sure that the server got all our requests before going to sleep
+    xcb_flush(m_connection);
+
+    // Wait for the connection to the X server along with the external sources
+    std::vector<pollfd> descriptors(sources.size() + 1);
+    descriptors[0].fd = xcb_get_file_descriptor(m_connection);
+    descriptors[0].events = POLLIN;
+    descriptors[0].revents = 0;
+    for (std::size_t i = 0; i < sources.size(); ++i)
     {
-        if (processEvent(reinterpret_cast<xcb_generic_event_t*>(lastKeyReleaseEvent)))
-            free(lastKeyReleaseEvent);
+        descriptors[i + 1].fd = sources[i];
+        descriptors[i + 1].events = POLLIN;
+        descriptors[i + 1].revents = 0;
+    }
 
-        lastKeyReleaseEvent = NULL;
+    // Round the timeout up, so that we don't spin when less than a millisecond is left
+    int delay = static_cast<int>((timeout.asMicroseconds() + 999) / 1000);
+
+    if (poll(&descriptors[0], descriptors.size(), delay) <= 0)
+        return false;
+
+    for (std::size_t i = 1; i < descriptors.size(); ++i)
+    {
+        if (descriptors[i].revents & (POLLIN | POLLHUP | POLLERR | POLLNVAL))
+            return true;
     }
+
+    return false;
 }
 
 
@@ -900,9 +1025,8 @@ void WindowImplX11::setPosition(const Vector2i& position)
 ////////////////////////////////////////////////////////////
 Vector2u WindowImplX11::getSize() const
 {
-    ScopedXcbPtr<xcb_get_geometry_reply_t> reply(xcb_get_geometry_reply(m_connection, xcb_get_geometry(m_connection, m_window), NULL));
-
-    return Vector2u(reply->width, reply->height);
+    // The size is tracked with the ConfigureNotify events, there's no need for a round-trip
+    return m_size;
 }
 
 
@@ -925,18 +1049,16 @@ void WindowImplX11::setSize(const Vector2u& size)
 
     uint32_t values[] = {size.x, size.y};
 
-    ScopedXcbPtr<xcb_generic_error_t> configureWindowError(xcb_request_check(
+    // Don't wait for the server to check the request, errors are reported through the event loop
+    xcb_configure_window(
         m_connection,
-        xcb_configure_window(
-            m_connection,
-            m_window,
-            XCB_CONFIG_WINDOW_WIDTH | XCB_CONFIG_WINDOW_HEIGHT,
-            values
-        )
-    ));
+        m_window,
+        XCB_CONFIG_WINDOW_WIDTH | XCB_CONFIG_WINDOW_HEIGHT,
+        values
+    );
 
-    if (configureWindowError)
-        err() << "Failed to set window size" << std::endl;
+    // Report the new size right away, the window manager will correct it if it didn't accept it
+    m_size = size;
 
     xcb_flush(m_connection);
 }
@@ -1170,25 +1292,33 @@ void WindowImplX11::setVisible(bool visible)
 ////////////////////////////////////////////////////////////
 void WindowImplX11::setMouseCursorVisible(bool visible)
 {
-    const uint32_t values = visible ? XCB_NONE : m_hiddenCursor;
+    m_cursorVisible = visible;
 
-    ScopedXcbPtr<xcb_generic_error_t> error(xcb_request_check(
-        m_connection,
-        xcb_change_window_attributes(
-            m_connection,
-            m_window,
-            XCB_CW_CURSOR,
-            &values
-        )
-    ));
+    const uint32_t values = visible ? m_lastCursor : m_hiddenCursor;
 
-    if (error)
-        err() << "Failed to change mouse cursor visibility" << std::endl;
+    // Don't wait for the server to check the request, errors are reported through the event loop
+    xcb_change_window_attributes(
+        m_connection,
+        m_window,
+        XCB_CW_CURSOR,
+        &values
+    );
 
     xcb_flush(m_connection);
 }
 
 
+////////////////////////////////////////////////////////////
+void WindowImplX11::setMouseCursor(const CursorImpl& cursor)
+{
+    m_lastCursor = cursor.m_cursor;
+
+    // The hidden cursor stays until the cursor is shown again
+    if (m_cursorVisible)
+        setMouseCursorVisible(true);
+}
+
+
 ////////////////////////////////////////////////////////////
 void WindowImplX11::setKeyRepeatEnabled(bool enabled)
 {
@@ -1294,6 +1424,50 @@ bool WindowImplX11::hasFocus() const
 }
 
 
+////////////////////////////////////////////////////////////
+void WindowImplX11::setRawMouseInputEnabled(bool enabled)
+{
+    Lock lock(allWindowsMutex);
+
+    if (!initializeXInput(m_display))
+    {
+        if (enabled)
+            err() << "XInput 2 is not available, raw mouse input is not supported" << std::endl;
+
+        return;
+    }
+
+    m_rawMouseInput = enabled;
+    m_rawMotion = Vector2f(0.f, 0.f);
+
+    // Raw events are only reported on the root window, so we select them
+    // there for as long as one of our windows wants them
+    bool selected = false;
+    for (std::vector<WindowImplX11*>::iterator i = allWindows.begin(); i != allWindows.end(); ++i)
+        selected = selected || (*i)->m_rawMouseInput;
+
+    unsigned char maskBits[XIMaskLen(XI_LASTEVENT)];
+    std::memset(maskBits, 0, sizeof(maskBits));
+    if (selected)
+        XISetMask(maskBits, XI_RawMotion);
+
+    XIEventMask mask;
+    mask.deviceid = XIAllMasterDevices;
+    mask.mask_len = sizeof(maskBits);
+    mask.mask = maskBits;
+
+    XISelectEvents(m_display, XCBDefaultRootWindow(m_connection), &mask, 1);
+    XFlush(m_display);
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImplX11::setMouseMoveCoalescingEnabled(bool enabled)
+{
+    m_coalesceMoves = enabled;
+}
+
+
 ////////////////////////////////////////////////////////////
 void WindowImplX11::grabFocus()
 {
@@ -1541,19 +1715,16 @@ void WindowImplX11::switchToFullscreen()
         event.data.data32[2] = 0; // No second property
         event.data.data32[3] = 1; // Normal window
 
-        ScopedXcbPtr<xcb_generic_error_t> wmStateError(xcb_request_check(
+        // Don't wait for the server to check the request, errors are reported through the event loop
+        xcb_send_event(
             m_connection,
-            xcb_send_event_checked(
-                m_connection,
-                0,
-                XCBDefaultRootWindow(m_connection),
-                XCB_EVENT_MASK_SUBSTRUCTURE_NOTIFY | XCB_EVENT_MASK_SUBSTRUCTURE_REDIRECT,
-                reinterpret_cast<char*>(&event)
-            )
-        ));
+            0,
+            XCBDefaultRootWindow(m_connection),
+            XCB_EVENT_MASK_SUBSTRUCTURE_NOTIFY | XCB_EVENT_MASK_SUBSTRUCTURE_REDIRECT,
+            reinterpret_cast<char*>(&event)
+        );
 
-        if (wmStateError)
-            err() << "Setting fullscreen failed. Could not send \"_NET_WM_STATE\" event" << std::endl;
+        xcb_flush(m_connection);
     }
 }
 
@@ -1845,8 +2016,15 @@ void WindowImplX11::cleanup()
 ////////////////////////////////////////////////////////////
 bool WindowImplX11::processEvent(xcb_generic_event_t* windowEvent)
 {
+    // Input events carry the time at which they occurred (they all store it at the same place)
+    uint8_t eventType = windowEvent->response_type & ~0x80;
+    if ((eventType >= XCB_KEY_PRESS) && (eventType <= XCB_LEAVE_NOTIFY))
+        setEventTimestamp(reinterpret_cast<xcb_key_press_event_t*>(windowEvent)->time);
+    else
+        clearEventTimestamp();
+
     // Convert the X11 event to a sf::Event
-    switch (windowEvent->response_type & ~0x80)
+    switch (eventType)
     {
         // Destroy event
         case XCB_DESTROY_NOTIFY:
@@ -1865,6 +2043,8 @@ bool WindowImplX11::processEvent(xcb_generic_event_t* windowEvent)
             if (passEvent(windowEvent, reinterpret_cast<xcb_focus_in_event_t*>(windowEvent)->event))
                 return false;
 
+            m_hasFocus = true;
+
             // Update the input context
             if (m_inputContext)
                 XSetICFocus(m_inputContext);
@@ -1910,6 +2090,8 @@ bool WindowImplX11::processEvent(xcb_generic_event_t* windowEvent)
             if (passEvent(windowEvent, reinterpret_cast<xcb_focus_out_event_t*>(windowEvent)->event))
                 return false;
 
+            m_hasFocus = false;
+
             // Update the input context
             if (m_inputContext)
                 XUnsetICFocus(m_inputContext);
@@ -1927,6 +2109,8 @@ bool WindowImplX11::processEvent(xcb_generic_event_t* windowEvent)
                 return false;
 
             xcb_configure_notify_event_t* e = reinterpret_cast<xcb_configure_notify_event_t*>(windowEvent);
+            m_size = Vector2u(e->width, e->height);
+
             Event event;
             event.type        = Event::Resized;
             event.size.width  = e->width;
@@ -2176,6 +2360,9 @@ bool WindowImplX11::processEvent(xcb_generic_event_t* windowEvent)
             if (passEvent(windowEvent, reinterpret_cast<xcb_motion_notify_event_t*>(windowEvent)->event))
                 return false;
 
+            if (!isEventEnabled(Event::MouseMoved))
+                break;
+
             xcb_motion_notify_event_t* e = reinterpret_cast<xcb_motion_notify_event_t*>(windowEvent);
             Event event;
             event.type        = Event::MouseMoved;
@@ -2251,6 +2438,57 @@ bool WindowImplX11::processEvent(xcb_generic_event_t* windowEvent)
 
             // Handle any extension events first
 
+            // XInput 2 raw motion
+            xcb_ge_generic_event_t* genericEvent = reinterpret_cast<xcb_ge_generic_event_t*>(windowEvent);
+            if ((responseType == XCB_GE_GENERIC) && (xinputOpcode >= 0) &&
+                (genericEvent->extension == xinputOpcode) && (genericEvent->event_type == XI_RawMotion))
+            {
+                // Raw events are reported on the root window: pass them
+                // to the focused window that wants them, if it's not us
+                if (!m_rawMouseInput || !m_hasFocus)
+                {
+                    Lock lock(allWindowsMutex);
+
+                    for (std::vector<WindowImplX11*>::iterator i = allWindows.begin(); i != allWindows.end(); ++i)
+                    {
+                        if (((*i) != this) && (*i)->m_rawMouseInput && (*i)->m_hasFocus)
+                        {
+                            (*i)->m_xcbEvents.push_back(windowEvent);
+                            return false;
+                        }
+                    }
+
+                    // Nobody wants the event
+                    break;
+                }
+
+                Uint32 time;
+                Vector2f motion;
+                if (getRawMotion(windowEvent, time, motion.x, motion.y))
+                {
+                    setEventTimestamp(time);
+
+                    // Keep the fractional part of the motion for the next events,
+                    // so that slow motions of high resolution mice are not lost
+                    m_rawMotion += motion;
+                    int deltaX = static_cast<int>(m_rawMotion.x);
+                    int deltaY = static_cast<int>(m_rawMotion.y);
+                    m_rawMotion.x -= deltaX;
+                    m_rawMotion.y -= deltaY;
+
+                    if (deltaX || deltaY)
+                    {
+                        Event event;
+                        event.type                = Event::MouseMovedRaw;
+                        event.mouseMoveRaw.deltaX = deltaX;
+                        event.mouseMoveRaw.deltaY = deltaY;
+                        pushEvent(event);
+                    }
+                }
+
+                break;
+            }
+
             // DRI2
             static xcb_query_extension_reply_t driExtension = getDriExtension();
             if (driExtension.present)
@@ -34,6 +34,7 @@
 #include <X11/Xlib-xcb.h>
 #include <xcb/randr.h>
 #include <deque>
+#include <vector>
 
 
 namespace sf
@@ -147,6 +148,14 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void setMouseCursorVisible(bool visible);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the image of the mouse cursor
+    ///
+    /// \param cursor Native cursor, or an empty cursor for the default one
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setMouseCursor(const CursorImpl& cursor);
+
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable automatic key-repeat
     ///
@@ -170,6 +179,22 @@ public:
     ////////////////////////////////////////////////////////////
     virtual bool hasFocus() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the raw mouse motion events
+    ///
+    /// \param enabled True to enable, false to disable
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setRawMouseInputEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the coalescing of mouse moves
+    ///
+    /// \param enabled True to enable, false to disable
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setMouseMoveCoalescingEnabled(bool enabled);
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -178,6 +203,18 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void processEvents();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the X server has new events for the
+    ///        window, or an external event source is ready
+    ///
+    /// \param timeout Maximum time to wait
+    /// \param sources External file descriptors to wait for
+    ///
+    /// \return True if one of the external event sources is readable
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool waitForEvents(Time timeout, const std::vector<EventSource>& sources);
+
 private:
 
     struct WMHints
@@ -324,13 +361,21 @@ private:
     XIM                               m_inputMethod;     ///< Input method linked to the X display
     XIC                               m_inputContext;    ///< Input context used to get unicode input in our window
     std::deque<xcb_generic_event_t*>  m_xcbEvents;       ///< Events that were received in another window's loop
+    std::vector<xcb_generic_event_t*> m_eventBatch;      ///< Events being processed by processEvents (kept to reuse its memory)
     bool                              m_isExternal;      ///< Tell whether the window has been created externally or by SFML
     xcb_randr_get_screen_info_reply_t m_oldVideoMode;    ///< Video mode in use before we switch to fullscreen
-    Cursor                            m_hiddenCursor;    ///< As X11 doesn't provide cursor hidding, we must create a transparent one
+    ::Cursor                          m_hiddenCursor;    ///< As X11 doesn't provide cursor hidding, we must create a transparent one
+    ::Cursor                          m_lastCursor;      ///< Cursor displayed when the cursor is visible, None for the default one
+    bool                              m_cursorVisible;   ///< Is the mouse cursor visible?
     bool                              m_keyRepeat;       ///< Is the KeyRepeat feature enabled?
     Vector2i                          m_previousSize;    ///< Previous size of the window, to find if a ConfigureNotify event is a resize event (could be a move event only)
+    Vector2u                          m_size;            ///< Size of the window, as of the last ConfigureNotify event or call to setSize
     bool                              m_useSizeHints;    ///< Is the size of the window fixed with size hints?
     bool                              m_fullscreen;      ///< Is window in fullscreen?
+    bool                              m_hasFocus;        ///< Does the window have the input focus (as of the last focus event)?
+    bool                              m_rawMouseInput;   ///< Are raw mouse motion events enabled?
+    Vector2f                          m_rawMotion;       ///< Fractional part of the raw mouse motion not reported yet
+    bool                              m_coalesceMoves;   ///< Are consecutive mouse moves merged into a single event?
 };
 
 } // namespace priv
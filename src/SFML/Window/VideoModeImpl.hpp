@@ -58,6 +58,14 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     static VideoMode getDesktopMode();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the refresh rate of the desktop display
+    ///
+    /// \return Refresh rate, in Hz, or 0 if it is unknown
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getDesktopRefreshRate();
 };
 
 } // namespace priv
@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2015 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Window/Win32/CursorImpl.hpp>
+#include <SFML/System/Err.hpp>
+#include <cstring>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+CursorImpl::CursorImpl() :
+m_cursor(NULL)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+CursorImpl::~CursorImpl()
+{
+    release();
+}
+
+
+////////////////////////////////////////////////////////////
+bool CursorImpl::loadFromPixels(const Uint8* pixels, Vector2u size, Vector2u hotspot)
+{
+    release();
+
+    // Top-down 32-bit image with an alpha channel
+    BITMAPV5HEADER bitmapHeader;
+    std::memset(&bitmapHeader, 0, sizeof(bitmapHeader));
+
+    bitmapHeader.bV5Size        = sizeof(bitmapHeader);
+    bitmapHeader.bV5Width       = size.x;
+    bitmapHeader.bV5Height      = -static_cast<LONG>(size.y);
+    bitmapHeader.bV5Planes      = 1;
+    bitmapHeader.bV5BitCount    = 32;
+    bitmapHeader.bV5Compression = BI_BITFIELDS;
+    bitmapHeader.bV5RedMask     = 0x00ff0000;
+    bitmapHeader.bV5GreenMask   = 0x0000ff00;
+    bitmapHeader.bV5BlueMask    = 0x000000ff;
+    bitmapHeader.bV5AlphaMask   = 0xff000000;
+
+    Uint32* bitmapData = NULL;
+
+    HDC screenDC = GetDC(NULL);
+    HBITMAP color = CreateDIBSection(
+        screenDC,
+        reinterpret_cast<const BITMAPINFO*>(&bitmapHeader),
+        DIB_RGB_COLORS,
+        reinterpret_cast<void**>(&bitmapData),
+        NULL,
+        0
+    );
+    ReleaseDC(NULL, screenDC);
+
+    if (!color)
+    {
+        err() << "Failed to create cursor color bitmap" << std::endl;
+        return false;
+    }
+
+    // Convert the RGBA pixels to BGRA
+    std::size_t count = static_cast<std::size_t>(size.x) * size.y;
+    for (std::size_t i = 0; i < count; ++i, pixels += 4)
+        bitmapData[i] = (pixels[3] << 24) | (pixels[0] << 16) | (pixels[1] << 8) | pixels[2];
+
+    // The mask is ignored when the color bitmap has an alpha channel, but it is still required
+    HBITMAP mask = CreateBitmap(size.x, size.y, 1, 1, NULL);
+
+    if (!mask)
+    {
+        DeleteObject(color);
+        err() << "Failed to create cursor mask bitmap" << std::endl;
+        return false;
+    }
+
+    ICONINFO cursorInfo;
+    std::memset(&cursorInfo, 0, sizeof(cursorInfo));
+
+    cursorInfo.fIcon    = FALSE;
+    cursorInfo.xHotspot = hotspot.x;
+    cursorInfo.yHotspot = hotspot.y;
+    cursorInfo.hbmColor = color;
+    cursorInfo.hbmMask  = mask;
+
+    m_cursor = reinterpret_cast<HCURSOR>(CreateIconIndirect(&cursorInfo));
+
+    // The bitmaps are copied into the cursor
+    DeleteObject(color);
+    DeleteObject(mask);
+
+    if (!m_cursor)
+    {
+        err() << "Failed to create cursor" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void CursorImpl::release()
+{
+    if (m_cursor)
+    {
+        DestroyIcon(reinterpret_cast<HICON>(m_cursor));
+        m_cursor = NULL;
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
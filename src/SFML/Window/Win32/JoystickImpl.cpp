@@ -173,6 +173,13 @@ void JoystickImpl::cleanup()
 }
 
 
+////////////////////////////////////////////////////////////
+void JoystickImpl::updateConnections()
+{
+    // Nothing to do, the connection states are cached in isConnected
+}
+
+
 ////////////////////////////////////////////////////////////
 bool JoystickImpl::isConnected(unsigned int index)
 {
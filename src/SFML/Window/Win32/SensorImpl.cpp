@@ -83,6 +83,20 @@ void SensorImpl::setEnabled(bool /*enabled*/)
     // To be implemented
 }
 
+////////////////////////////////////////////////////////////
+void SensorImpl::setSamplingRate(Time /*interval*/, Time /*maxLatency*/)
+{
+    // To be implemented
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SensorImpl::getSamples(Vector3f* /*samples*/, std::size_t /*maxCount*/)
+{
+    // To be implemented
+    return 0;
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -91,6 +91,26 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     void setEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the sampling rate of the sensor
+    ///
+    /// \param interval   Requested time between two samples
+    /// \param maxLatency Maximum delay before the samples are delivered
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSamplingRate(Time interval, Time maxLatency);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the samples received since the last call
+    ///
+    /// \param samples  Array to fill with the samples
+    /// \param maxCount Maximum number of samples to write
+    ///
+    /// \return Number of samples written
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSamples(Vector3f* samples, std::size_t maxCount);
 };
 
 } // namespace priv
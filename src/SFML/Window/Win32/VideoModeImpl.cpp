@@ -66,6 +66,19 @@ VideoMode VideoModeImpl::getDesktopMode()
     return VideoMode(win32Mode.dmPelsWidth, win32Mode.dmPelsHeight, win32Mode.dmBitsPerPel);
 }
 
+
+////////////////////////////////////////////////////////////
+unsigned int VideoModeImpl::getDesktopRefreshRate()
+{
+    DEVMODE win32Mode;
+    win32Mode.dmSize = sizeof(win32Mode);
+    if (!EnumDisplaySettings(NULL, ENUM_CURRENT_SETTINGS, &win32Mode))
+        return 0;
+
+    // 0 and 1 mean "default refresh rate of the hardware"
+    return win32Mode.dmDisplayFrequency > 1 ? win32Mode.dmDisplayFrequency : 0;
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -69,9 +69,11 @@ String getErrorString(DWORD errorCode)
 ////////////////////////////////////////////////////////////
 WglContext::WglContext(WglContext* shared) :
 m_window       (NULL),
+m_pbuffer      (NULL),
 m_deviceContext(NULL),
 m_context      (NULL),
-m_ownsWindow   (true)
+m_ownsWindow   (true),
+m_bound        (false)
 {
     // Creating a dummy window is mandatory: we could create a memory DC but then
     // its pixel format wouldn't match the regular contexts' format, and thus
@@ -91,9 +93,11 @@ m_ownsWindow   (true)
 ////////////////////////////////////////////////////////////
 WglContext::WglContext(WglContext* shared, const ContextSettings& settings, const WindowImpl* owner, unsigned int bitsPerPixel) :
 m_window       (NULL),
+m_pbuffer      (NULL),
 m_deviceContext(NULL),
 m_context      (NULL),
-m_ownsWindow   (false)
+m_ownsWindow   (false),
+m_bound        (false)
 {
     // Get the owner window and its device context
     m_window = owner->getSystemHandle();
@@ -108,19 +112,59 @@ m_ownsWindow   (false)
 ////////////////////////////////////////////////////////////
 WglContext::WglContext(WglContext* shared, const ContextSettings& settings, unsigned int width, unsigned int height) :
 m_window       (NULL),
+m_pbuffer      (NULL),
 m_deviceContext(NULL),
 m_context      (NULL),
-m_ownsWindow   (true)
+m_ownsWindow   (true),
+m_bound        (false)
 {
-    // The target of the context is a hidden window.
-    // We can't create a memory DC (the resulting context wouldn't be compatible
-    // with other contexts), and we don't add the extra complexity of P-Buffers;
-    // we can still support them in the future if this solution is not good enough.
+    // The target of the context is a pbuffer that can be bound to a texture, so that
+    // render textures use it directly instead of copying it, or a hidden window when
+    // the extensions are missing. We can't create a memory DC (the resulting context
+    // wouldn't be compatible with other contexts). Multisampled pbuffers can't be
+    // bound, their samples are resolved by the copy of the hidden window instead.
+    if (shared && shared->m_deviceContext && (settings.antialiasingLevel == 0))
+    {
+        ensureExtensionsInit(shared->m_deviceContext);
 
-    // Create the hidden window
-    m_window = CreateWindowA("STATIC", "", WS_POPUP | WS_DISABLED, 0, 0, width, height, NULL, NULL, GetModuleHandle(NULL), NULL);
-    ShowWindow(m_window, SW_HIDE);
-    m_deviceContext = GetDC(m_window);
+        if ((sfwgl_ext_ARB_pixel_format == sfwgl_LOAD_SUCCEEDED) &&
+            (sfwgl_ext_ARB_pbuffer == sfwgl_LOAD_SUCCEEDED) &&
+            (sfwgl_ext_ARB_render_texture == sfwgl_LOAD_SUCCEEDED))
+        {
+            int format = selectBestPixelFormat(shared->m_deviceContext, VideoMode::getDesktopMode().bitsPerPixel, settings, true);
+
+            if (format)
+            {
+                const int attributes[] =
+                {
+                    WGL_TEXTURE_FORMAT_ARB, WGL_TEXTURE_RGBA_ARB,
+                    WGL_TEXTURE_TARGET_ARB, WGL_TEXTURE_2D_ARB,
+                    0,                      0
+                };
+
+                m_pbuffer = wglCreatePbufferARB(shared->m_deviceContext, format, static_cast<int>(width), static_cast<int>(height), attributes);
+            }
+
+            if (m_pbuffer)
+            {
+                m_deviceContext = wglGetPbufferDCARB(m_pbuffer);
+
+                if (!m_deviceContext)
+                {
+                    wglDestroyPbufferARB(m_pbuffer);
+                    m_pbuffer = NULL;
+                }
+            }
+        }
+    }
+
+    if (!m_pbuffer)
+    {
+        // Create the hidden window
+        m_window = CreateWindowA("STATIC", "", WS_POPUP | WS_DISABLED, 0, 0, width, height, NULL, NULL, GetModuleHandle(NULL), NULL);
+        ShowWindow(m_window, SW_HIDE);
+        m_deviceContext = GetDC(m_window);
+    }
 
     // Create the context
     if (m_deviceContext)
@@ -131,6 +175,9 @@ m_ownsWindow   (true)
 ////////////////////////////////////////////////////////////
 WglContext::~WglContext()
 {
+    // The pbuffer must not be destroyed while it is the image of a texture
+    releaseTexImage();
+
     // Destroy the OpenGL context
     if (m_context)
     {
@@ -139,9 +186,18 @@ WglContext::~WglContext()
         wglDeleteContext(m_context);
     }
 
-    // Destroy the device context
-    if (m_deviceContext)
+    // Destroy the device context, and the pbuffer if there is one
+    if (m_pbuffer)
+    {
+        if (m_deviceContext)
+            wglReleasePbufferDCARB(m_pbuffer, m_deviceContext);
+
+        wglDestroyPbufferARB(m_pbuffer);
+    }
+    else if (m_deviceContext)
+    {
         ReleaseDC(m_window, m_deviceContext);
+    }
 
     // Destroy the window if we own it
     if (m_window && m_ownsWindow)
@@ -182,6 +238,13 @@ bool WglContext::makeCurrent()
 }
 
 
+////////////////////////////////////////////////////////////
+bool WglContext::releaseCurrent()
+{
+    return wglMakeCurrent(NULL, NULL) == TRUE;
+}
+
+
 ////////////////////////////////////////////////////////////
 void WglContext::display()
 {
@@ -192,13 +255,35 @@ void WglContext::display()
 
 ////////////////////////////////////////////////////////////
 void WglContext::setVerticalSyncEnabled(bool enabled)
+{
+    setSwapInterval(enabled ? 1 : 0);
+}
+
+
+////////////////////////////////////////////////////////////
+void WglContext::setSwapInterval(int interval)
 {
     // Make sure that extensions are initialized
     ensureExtensionsInit(m_deviceContext);
 
+    // Negative intervals (adaptive synchronization) require WGL_EXT_swap_control_tear
+    if ((interval < 0) && (sfwgl_ext_EXT_swap_control_tear != sfwgl_LOAD_SUCCEEDED))
+    {
+        static bool warned = false;
+
+        if (!warned)
+        {
+            err() << "Adaptive vertical sync not supported, using regular vertical sync instead" << std::endl;
+
+            warned = true;
+        }
+
+        interval = -interval;
+    }
+
     if (sfwgl_ext_EXT_swap_control == sfwgl_LOAD_SUCCEEDED)
     {
-        if (wglSwapIntervalEXT(enabled ? 1 : 0) == FALSE)
+        if (wglSwapIntervalEXT(interval) == FALSE)
             err() << "Setting vertical sync failed" << std::endl;
     }
     else
@@ -217,14 +302,47 @@ void WglContext::setVerticalSyncEnabled(bool enabled)
 
 
 ////////////////////////////////////////////////////////////
-int WglContext::selectBestPixelFormat(HDC deviceContext, unsigned int bitsPerPixel, const ContextSettings& settings)
+bool WglContext::bindTexImage()
+{
+    if (!m_pbuffer)
+        return false;
+
+    // A pbuffer can't be bound twice, even to the same texture
+    releaseTexImage();
+
+    // The rendering must be complete before the pbuffer is used as a texture
+    glFlush();
+
+    // The pbuffer is single-buffered, the rendering is in its front buffer
+    m_bound = (wglBindTexImageARB(m_pbuffer, WGL_FRONT_LEFT_ARB) == TRUE);
+
+    if (!m_bound)
+        err() << "Failed to bind the pbuffer to a texture: " << getErrorString(GetLastError()).toAnsiString() << std::endl;
+
+    return m_bound;
+}
+
+
+////////////////////////////////////////////////////////////
+void WglContext::releaseTexImage()
+{
+    if (m_bound)
+    {
+        wglReleaseTexImageARB(m_pbuffer, WGL_FRONT_LEFT_ARB);
+        m_bound = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+int WglContext::selectBestPixelFormat(HDC deviceContext, unsigned int bitsPerPixel, const ContextSettings& settings, bool pbuffer)
 {
     // Let's find a suitable pixel format -- first try with wglChoosePixelFormatARB
     int bestFormat = 0;
     if (sfwgl_ext_ARB_pixel_format == sfwgl_LOAD_SUCCEEDED)
     {
         // Define the basic attributes we want for our window
-        int intAttributes[] =
+        int windowAttributes[] =
         {
             WGL_DRAW_TO_WINDOW_ARB, GL_TRUE,
             WGL_SUPPORT_OPENGL_ARB, GL_TRUE,
@@ -233,10 +351,21 @@ int WglContext::selectBestPixelFormat(HDC deviceContext, unsigned int bitsPerPix
             0,                      0
         };
 
+        // Pbuffers are single-buffered and must be bindable as RGBA textures
+        int pbufferAttributes[] =
+        {
+            WGL_DRAW_TO_PBUFFER_ARB,      GL_TRUE,
+            WGL_BIND_TO_TEXTURE_RGBA_ARB, GL_TRUE,
+            WGL_SUPPORT_OPENGL_ARB,       GL_TRUE,
+            WGL_DOUBLE_BUFFER_ARB,        GL_FALSE,
+            WGL_PIXEL_TYPE_ARB,           WGL_TYPE_RGBA_ARB,
+            0,                            0
+        };
+
         // Let's check how many formats are supporting our requirements
         int   formats[512];
         UINT  nbFormats;
-        bool  isValid = wglChoosePixelFormatARB(deviceContext, intAttributes, NULL, 512, formats, &nbFormats) != 0;
+        bool  isValid = wglChoosePixelFormatARB(deviceContext, pbuffer ? pbufferAttributes : windowAttributes, NULL, 512, formats, &nbFormats) != 0;
 
         // Get the best format among the returned ones
         if (isValid && (nbFormats > 0))
@@ -294,7 +423,8 @@ int WglContext::selectBestPixelFormat(HDC deviceContext, unsigned int bitsPerPix
     }
 
     // Find a pixel format with ChoosePixelFormat, if wglChoosePixelFormatARB is not supported
-    if (bestFormat == 0)
+    // (pbuffers can't be described without it)
+    if ((bestFormat == 0) && !pbuffer)
     {
         // Setup a pixel format descriptor from the rendering settings
         PIXELFORMATDESCRIPTOR descriptor;
@@ -328,7 +458,8 @@ void WglContext::createContext(WglContext* shared, unsigned int bitsPerPixel, co
     if (shared)
         ensureExtensionsInit(m_deviceContext);
 
-    int bestFormat = selectBestPixelFormat(m_deviceContext, bitsPerPixel, settings);
+    // The pixel format of a pbuffer was chosen when it was created
+    int bestFormat = m_pbuffer ? GetPixelFormat(m_deviceContext) : selectBestPixelFormat(m_deviceContext, bitsPerPixel, settings);
 
     if (bestFormat == 0)
     {
@@ -388,7 +519,7 @@ void WglContext::createContext(WglContext* shared, unsigned int bitsPerPixel, co
     }
 
     // Set the chosen pixel format
-    if (!SetPixelFormat(m_deviceContext, bestFormat, &actualFormat))
+    if (!m_pbuffer && !SetPixelFormat(m_deviceContext, bestFormat, &actualFormat))
     {
         err() << "Failed to set pixel format for device context: " << getErrorString(GetLastError()).toAnsiString() << std::endl
               << "Cannot create OpenGL context" << std::endl;
@@ -28,6 +28,7 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <SFML/Window/Win32/WglExtensions.hpp> // included first, it must come before any other WGL header
 #include <SFML/Window/GlContext.hpp>
 #include <SFML/OpenGL.hpp>
 #include <windows.h>
@@ -99,6 +100,14 @@ public:
     ////////////////////////////////////////////////////////////
     virtual bool makeCurrent();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Make no context current on the calling thread
+    ///
+    /// \return True on success, false if any error happened
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool releaseCurrent();
+
     ////////////////////////////////////////////////////////////
     /// \brief Display what has been rendered to the context so far
     ///
@@ -118,17 +127,41 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void setVerticalSyncEnabled(bool enabled);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of display refreshes per swap
+    ///
+    /// \param interval Swap interval (negative for adaptive synchronization)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setSwapInterval(int interval);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Use the pbuffer of the context as the image of
+    ///        the texture bound to GL_TEXTURE_2D
+    ///
+    /// \return True if the pbuffer is now the image of the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool bindTexImage();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the pbuffer bound by bindTexImage
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void releaseTexImage();
+
     ////////////////////////////////////////////////////////////
     /// \brief Select the best pixel format for a given set of settings
     ///
     /// \param deviceContext Device context
     /// \param bitsPerPixel  Pixel depth, in bits per pixel
     /// \param settings      Requested context settings
+    /// \param pbuffer       Select a format for a pbuffer that can be bound to a texture, instead of a window
     ///
-    /// \return The best pixel format
+    /// \return The best pixel format, 0 if none matches
     ///
     ////////////////////////////////////////////////////////////
-    static int selectBestPixelFormat(HDC deviceContext, unsigned int bitsPerPixel, const ContextSettings& settings);
+    static int selectBestPixelFormat(HDC deviceContext, unsigned int bitsPerPixel, const ContextSettings& settings, bool pbuffer = false);
 
 private:
 
@@ -145,10 +178,12 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    HWND  m_window;        ///< Window to which the context is attached
-    HDC   m_deviceContext; ///< Device context associated to the context
-    HGLRC m_context;       ///< OpenGL context
-    bool  m_ownsWindow;    ///< Do we own the target window?
+    HWND        m_window;        ///< Window to which the context is attached
+    HPBUFFERARB m_pbuffer;       ///< Pbuffer to which the context is attached, instead of a window
+    HDC         m_deviceContext; ///< Device context associated to the context
+    HGLRC       m_context;       ///< OpenGL context
+    bool        m_ownsWindow;    ///< Do we own the target window?
+    bool        m_bound;         ///< Is the pbuffer currently bound to a texture?
 };
 
 } // namespace priv
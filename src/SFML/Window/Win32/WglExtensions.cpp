@@ -37,10 +37,13 @@ static sf::GlFunctionPointer IntGetProcAddress(const char* name)
 }
 
 int sfwgl_ext_EXT_swap_control = sfwgl_LOAD_FAILED;
+int sfwgl_ext_EXT_swap_control_tear = sfwgl_LOAD_FAILED;
 int sfwgl_ext_ARB_multisample = sfwgl_LOAD_FAILED;
 int sfwgl_ext_ARB_pixel_format = sfwgl_LOAD_FAILED;
 int sfwgl_ext_ARB_create_context = sfwgl_LOAD_FAILED;
 int sfwgl_ext_ARB_create_context_profile = sfwgl_LOAD_FAILED;
+int sfwgl_ext_ARB_pbuffer = sfwgl_LOAD_FAILED;
+int sfwgl_ext_ARB_render_texture = sfwgl_LOAD_FAILED;
 
 int (CODEGEN_FUNCPTR *sf_ptrc_wglGetSwapIntervalEXT)(void) = NULL;
 BOOL (CODEGEN_FUNCPTR *sf_ptrc_wglSwapIntervalEXT)(int) = NULL;
@@ -81,6 +84,44 @@ static int Load_ARB_create_context(void)
     return numFailed;
 }
 
+HPBUFFERARB (CODEGEN_FUNCPTR *sf_ptrc_wglCreatePbufferARB)(HDC, int, int, int, const int *) = NULL;
+BOOL (CODEGEN_FUNCPTR *sf_ptrc_wglDestroyPbufferARB)(HPBUFFERARB) = NULL;
+HDC (CODEGEN_FUNCPTR *sf_ptrc_wglGetPbufferDCARB)(HPBUFFERARB) = NULL;
+BOOL (CODEGEN_FUNCPTR *sf_ptrc_wglQueryPbufferARB)(HPBUFFERARB, int, int *) = NULL;
+int (CODEGEN_FUNCPTR *sf_ptrc_wglReleasePbufferDCARB)(HPBUFFERARB, HDC) = NULL;
+
+static int Load_ARB_pbuffer(void)
+{
+    int numFailed = 0;
+    sf_ptrc_wglCreatePbufferARB = (HPBUFFERARB (CODEGEN_FUNCPTR *)(HDC, int, int, int, const int *))IntGetProcAddress("wglCreatePbufferARB");
+    if(!sf_ptrc_wglCreatePbufferARB) numFailed++;
+    sf_ptrc_wglDestroyPbufferARB = (BOOL (CODEGEN_FUNCPTR *)(HPBUFFERARB))IntGetProcAddress("wglDestroyPbufferARB");
+    if(!sf_ptrc_wglDestroyPbufferARB) numFailed++;
+    sf_ptrc_wglGetPbufferDCARB = (HDC (CODEGEN_FUNCPTR *)(HPBUFFERARB))IntGetProcAddress("wglGetPbufferDCARB");
+    if(!sf_ptrc_wglGetPbufferDCARB) numFailed++;
+    sf_ptrc_wglQueryPbufferARB = (BOOL (CODEGEN_FUNCPTR *)(HPBUFFERARB, int, int *))IntGetProcAddress("wglQueryPbufferARB");
+    if(!sf_ptrc_wglQueryPbufferARB) numFailed++;
+    sf_ptrc_wglReleasePbufferDCARB = (int (CODEGEN_FUNCPTR *)(HPBUFFERARB, HDC))IntGetProcAddress("wglReleasePbufferDCARB");
+    if(!sf_ptrc_wglReleasePbufferDCARB) numFailed++;
+    return numFailed;
+}
+
+BOOL (CODEGEN_FUNCPTR *sf_ptrc_wglBindTexImageARB)(HPBUFFERARB, int) = NULL;
+BOOL (CODEGEN_FUNCPTR *sf_ptrc_wglReleaseTexImageARB)(HPBUFFERARB, int) = NULL;
+BOOL (CODEGEN_FUNCPTR *sf_ptrc_wglSetPbufferAttribARB)(HPBUFFERARB, const int *) = NULL;
+
+static int Load_ARB_render_texture(void)
+{
+    int numFailed = 0;
+    sf_ptrc_wglBindTexImageARB = (BOOL (CODEGEN_FUNCPTR *)(HPBUFFERARB, int))IntGetProcAddress("wglBindTexImageARB");
+    if(!sf_ptrc_wglBindTexImageARB) numFailed++;
+    sf_ptrc_wglReleaseTexImageARB = (BOOL (CODEGEN_FUNCPTR *)(HPBUFFERARB, int))IntGetProcAddress("wglReleaseTexImageARB");
+    if(!sf_ptrc_wglReleaseTexImageARB) numFailed++;
+    sf_ptrc_wglSetPbufferAttribARB = (BOOL (CODEGEN_FUNCPTR *)(HPBUFFERARB, const int *))IntGetProcAddress("wglSetPbufferAttribARB");
+    if(!sf_ptrc_wglSetPbufferAttribARB) numFailed++;
+    return numFailed;
+}
+
 
 static const char * (CODEGEN_FUNCPTR *sf_ptrc_wglGetExtensionsStringARB)(HDC) = NULL;
 
@@ -92,15 +133,18 @@ typedef struct sfwgl_StrToExtMap_s
     PFN_LOADFUNCPOINTERS LoadExtension;
 } sfwgl_StrToExtMap;
 
-static sfwgl_StrToExtMap ExtensionMap[5] = {
+static sfwgl_StrToExtMap ExtensionMap[8] = {
     {"WGL_EXT_swap_control", &sfwgl_ext_EXT_swap_control, Load_EXT_swap_control},
+    {"WGL_EXT_swap_control_tear", &sfwgl_ext_EXT_swap_control_tear, NULL},
     {"WGL_ARB_multisample", &sfwgl_ext_ARB_multisample, NULL},
     {"WGL_ARB_pixel_format", &sfwgl_ext_ARB_pixel_format, Load_ARB_pixel_format},
     {"WGL_ARB_create_context", &sfwgl_ext_ARB_create_context, Load_ARB_create_context},
     {"WGL_ARB_create_context_profile", &sfwgl_ext_ARB_create_context_profile, NULL},
+    {"WGL_ARB_pbuffer", &sfwgl_ext_ARB_pbuffer, Load_ARB_pbuffer},
+    {"WGL_ARB_render_texture", &sfwgl_ext_ARB_render_texture, Load_ARB_render_texture},
 };
 
-static int g_extensionMapSize = 5;
+static int g_extensionMapSize = 8;
 
 static sfwgl_StrToExtMap *FindExtEntry(const char *extensionName)
 {
@@ -118,10 +162,13 @@ static sfwgl_StrToExtMap *FindExtEntry(const char *extensionName)
 static void ClearExtensionVars(void)
 {
     sfwgl_ext_EXT_swap_control = sfwgl_LOAD_FAILED;
+    sfwgl_ext_EXT_swap_control_tear = sfwgl_LOAD_FAILED;
     sfwgl_ext_ARB_multisample = sfwgl_LOAD_FAILED;
     sfwgl_ext_ARB_pixel_format = sfwgl_LOAD_FAILED;
     sfwgl_ext_ARB_create_context = sfwgl_LOAD_FAILED;
     sfwgl_ext_ARB_create_context_profile = sfwgl_LOAD_FAILED;
+    sfwgl_ext_ARB_pbuffer = sfwgl_LOAD_FAILED;
+    sfwgl_ext_ARB_render_texture = sfwgl_LOAD_FAILED;
 }
 
 
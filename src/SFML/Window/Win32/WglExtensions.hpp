@@ -93,10 +93,13 @@ extern "C" {
 #endif /*__cplusplus*/
 
 extern int sfwgl_ext_EXT_swap_control;
+extern int sfwgl_ext_EXT_swap_control_tear;
 extern int sfwgl_ext_ARB_multisample;
 extern int sfwgl_ext_ARB_pixel_format;
 extern int sfwgl_ext_ARB_create_context;
 extern int sfwgl_ext_ARB_create_context_profile;
+extern int sfwgl_ext_ARB_pbuffer;
+extern int sfwgl_ext_ARB_render_texture;
 
 #define WGL_SAMPLES_ARB 0x2042
 #define WGL_SAMPLE_BUFFERS_ARB 0x2041
@@ -164,6 +167,49 @@ extern int sfwgl_ext_ARB_create_context_profile;
 #define WGL_CONTEXT_PROFILE_MASK_ARB 0x9126
 #define WGL_ERROR_INVALID_PROFILE_ARB 0x2096
 
+#define WGL_DRAW_TO_PBUFFER_ARB 0x202D
+#define WGL_MAX_PBUFFER_HEIGHT_ARB 0x2030
+#define WGL_MAX_PBUFFER_PIXELS_ARB 0x202E
+#define WGL_MAX_PBUFFER_WIDTH_ARB 0x202F
+#define WGL_PBUFFER_HEIGHT_ARB 0x2035
+#define WGL_PBUFFER_LARGEST_ARB 0x2033
+#define WGL_PBUFFER_LOST_ARB 0x2036
+#define WGL_PBUFFER_WIDTH_ARB 0x2034
+
+#define WGL_AUX0_ARB 0x2087
+#define WGL_AUX1_ARB 0x2088
+#define WGL_AUX2_ARB 0x2089
+#define WGL_AUX3_ARB 0x208A
+#define WGL_AUX4_ARB 0x208B
+#define WGL_AUX5_ARB 0x208C
+#define WGL_AUX6_ARB 0x208D
+#define WGL_AUX7_ARB 0x208E
+#define WGL_AUX8_ARB 0x208F
+#define WGL_AUX9_ARB 0x2090
+#define WGL_BACK_LEFT_ARB 0x2085
+#define WGL_BACK_RIGHT_ARB 0x2086
+#define WGL_BIND_TO_TEXTURE_RGBA_ARB 0x2071
+#define WGL_BIND_TO_TEXTURE_RGB_ARB 0x2070
+#define WGL_CUBE_MAP_FACE_ARB 0x207C
+#define WGL_FRONT_LEFT_ARB 0x2083
+#define WGL_FRONT_RIGHT_ARB 0x2084
+#define WGL_MIPMAP_LEVEL_ARB 0x207B
+#define WGL_MIPMAP_TEXTURE_ARB 0x2074
+#define WGL_NO_TEXTURE_ARB 0x2077
+#define WGL_TEXTURE_1D_ARB 0x2079
+#define WGL_TEXTURE_2D_ARB 0x207A
+#define WGL_TEXTURE_CUBE_MAP_ARB 0x2078
+#define WGL_TEXTURE_CUBE_MAP_NEGATIVE_X_ARB 0x207E
+#define WGL_TEXTURE_CUBE_MAP_NEGATIVE_Y_ARB 0x2080
+#define WGL_TEXTURE_CUBE_MAP_NEGATIVE_Z_ARB 0x2082
+#define WGL_TEXTURE_CUBE_MAP_POSITIVE_X_ARB 0x207D
+#define WGL_TEXTURE_CUBE_MAP_POSITIVE_Y_ARB 0x207F
+#define WGL_TEXTURE_CUBE_MAP_POSITIVE_Z_ARB 0x2081
+#define WGL_TEXTURE_FORMAT_ARB 0x2072
+#define WGL_TEXTURE_RGBA_ARB 0x2076
+#define WGL_TEXTURE_RGB_ARB 0x2075
+#define WGL_TEXTURE_TARGET_ARB 0x2073
+
 #ifndef WGL_EXT_swap_control
 #define WGL_EXT_swap_control 1
 extern int (CODEGEN_FUNCPTR *sf_ptrc_wglGetSwapIntervalEXT)(void);
@@ -189,6 +235,30 @@ extern HGLRC (CODEGEN_FUNCPTR *sf_ptrc_wglCreateContextAttribsARB)(HDC, HGLRC, c
 #define wglCreateContextAttribsARB sf_ptrc_wglCreateContextAttribsARB
 #endif /*WGL_ARB_create_context*/
 
+#ifndef WGL_ARB_pbuffer
+#define WGL_ARB_pbuffer 1
+extern HPBUFFERARB (CODEGEN_FUNCPTR *sf_ptrc_wglCreatePbufferARB)(HDC, int, int, int, const int *);
+#define wglCreatePbufferARB sf_ptrc_wglCreatePbufferARB
+extern BOOL (CODEGEN_FUNCPTR *sf_ptrc_wglDestroyPbufferARB)(HPBUFFERARB);
+#define wglDestroyPbufferARB sf_ptrc_wglDestroyPbufferARB
+extern HDC (CODEGEN_FUNCPTR *sf_ptrc_wglGetPbufferDCARB)(HPBUFFERARB);
+#define wglGetPbufferDCARB sf_ptrc_wglGetPbufferDCARB
+extern BOOL (CODEGEN_FUNCPTR *sf_ptrc_wglQueryPbufferARB)(HPBUFFERARB, int, int *);
+#define wglQueryPbufferARB sf_ptrc_wglQueryPbufferARB
+extern int (CODEGEN_FUNCPTR *sf_ptrc_wglReleasePbufferDCARB)(HPBUFFERARB, HDC);
+#define wglReleasePbufferDCARB sf_ptrc_wglReleasePbufferDCARB
+#endif /*WGL_ARB_pbuffer*/
+
+#ifndef WGL_ARB_render_texture
+#define WGL_ARB_render_texture 1
+extern BOOL (CODEGEN_FUNCPTR *sf_ptrc_wglBindTexImageARB)(HPBUFFERARB, int);
+#define wglBindTexImageARB sf_ptrc_wglBindTexImageARB
+extern BOOL (CODEGEN_FUNCPTR *sf_ptrc_wglReleaseTexImageARB)(HPBUFFERARB, int);
+#define wglReleaseTexImageARB sf_ptrc_wglReleaseTexImageARB
+extern BOOL (CODEGEN_FUNCPTR *sf_ptrc_wglSetPbufferAttribARB)(HPBUFFERARB, const int *);
+#define wglSetPbufferAttribARB sf_ptrc_wglSetPbufferAttribARB
+#endif /*WGL_ARB_render_texture*/
+
 
 enum sfwgl_LoadStatus
 {
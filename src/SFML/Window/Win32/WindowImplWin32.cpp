@@ -35,6 +35,7 @@
 #define _WIN32_WINNT   0x0501
 #define WINVER         0x0501
 #include <SFML/Window/Win32/WindowImplWin32.hpp>
+#include <SFML/Window/Win32/CursorImpl.hpp>
 #include <SFML/Window/WindowStyle.hpp>
 #include <GL/gl.h>
 #include <SFML/System/Err.hpp>
@@ -127,12 +128,14 @@ WindowImplWin32::WindowImplWin32(WindowHandle handle) :
 m_handle          (handle),
 m_callback        (0),
 m_cursor          (NULL),
+m_lastCursor      (LoadCursorW(NULL, IDC_ARROW)),
 m_icon            (NULL),
 m_keyRepeatEnabled(true),
 m_lastSize        (0, 0),
 m_resizing        (false),
 m_surrogate       (0),
-m_mouseInside     (false)
+m_mouseInside     (false),
+m_rawMouseInput   (false)
 {
     // Set that this process is DPI aware and can handle DPI scaling
     setProcessDpiAware();
@@ -151,12 +154,14 @@ WindowImplWin32::WindowImplWin32(VideoMode mode, const String& title, Uint32 sty
 m_handle          (NULL),
 m_callback        (0),
 m_cursor          (NULL),
+m_lastCursor      (LoadCursorW(NULL, IDC_ARROW)),
 m_icon            (NULL),
 m_keyRepeatEnabled(true),
 m_lastSize        (mode.width, mode.height),
 m_resizing        (false),
 m_surrogate       (0),
-m_mouseInside     (false)
+m_mouseInside     (false),
+m_rawMouseInput   (false)
 {
     // Set that this process is DPI aware and can handle DPI scaling
     setProcessDpiAware();
@@ -215,6 +220,10 @@ m_mouseInside     (false)
 ////////////////////////////////////////////////////////////
 WindowImplWin32::~WindowImplWin32()
 {
+    // Stop sending the raw mouse input to this window
+    if (m_rawMouseInput)
+        setRawMouseInputEnabled(false);
+
     // Destroy the custom icon, if any
     if (m_icon)
         DestroyIcon(m_icon);
@@ -263,6 +272,29 @@ void WindowImplWin32::processEvents()
 }
 
 
+////////////////////////////////////////////////////////////
+bool WindowImplWin32::waitForEvents(Time timeout, const std::vector<EventSource>& sources)
+{
+    // The thread's message queue takes one of the wait slots
+    DWORD count = static_cast<DWORD>(sources.size());
+    if (count > MAXIMUM_WAIT_OBJECTS - 1)
+    {
+        err() << "Too many event sources to wait for (" << count << "), only the first "
+              << MAXIMUM_WAIT_OBJECTS - 1 << " are used" << std::endl;
+        count = MAXIMUM_WAIT_OBJECTS - 1;
+    }
+
+    // Round the timeout up, so that we don't spin when less than a millisecond is left
+    DWORD delay = static_cast<DWORD>((timeout.asMicroseconds() + 999) / 1000);
+
+    // MWMO_INPUTAVAILABLE also wakes up for messages that were already in the queue
+    DWORD result = MsgWaitForMultipleObjectsEx(count, count ? &sources[0] : NULL,
+                                               delay, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+
+    return (result >= WAIT_OBJECT_0) && (result < WAIT_OBJECT_0 + count);
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2i WindowImplWin32::getPosition() const
 {
@@ -354,15 +386,23 @@ void WindowImplWin32::setVisible(bool visible)
 ////////////////////////////////////////////////////////////
 void WindowImplWin32::setMouseCursorVisible(bool visible)
 {
-    if (visible)
-        m_cursor = LoadCursorW(NULL, IDC_ARROW);
-    else
-        m_cursor = NULL;
+    m_cursor = visible ? m_lastCursor : NULL;
 
     SetCursor(m_cursor);
 }
 
 
+////////////////////////////////////////////////////////////
+void WindowImplWin32::setMouseCursor(const CursorImpl& cursor)
+{
+    m_lastCursor = cursor.m_cursor ? cursor.m_cursor : LoadCursorW(NULL, IDC_ARROW);
+
+    // The hidden cursor stays until the cursor is shown again
+    if (m_cursor)
+        setMouseCursorVisible(true);
+}
+
+
 ////////////////////////////////////////////////////////////
 void WindowImplWin32::setKeyRepeatEnabled(bool enabled)
 {
@@ -404,6 +444,23 @@ bool WindowImplWin32::hasFocus() const
 }
 
 
+////////////////////////////////////////////////////////////
+void WindowImplWin32::setRawMouseInputEnabled(bool enabled)
+{
+    // Raw input devices are registered for the whole process, with a single target window
+    RAWINPUTDEVICE device;
+    device.usUsagePage = 0x01; // Generic desktop controls
+    device.usUsage     = 0x02; // Mouse
+    device.dwFlags     = enabled ? 0 : RIDEV_REMOVE;
+    device.hwndTarget  = enabled ? m_handle : NULL;
+
+    if (RegisterRawInputDevices(&device, 1, sizeof(device)))
+        m_rawMouseInput = enabled;
+    else
+        err() << "Failed to " << (enabled ? "register" : "unregister") << " the raw mouse input device" << std::endl;
+}
+
+
 ////////////////////////////////////////////////////////////
 void WindowImplWin32::registerWindowClass()
 {
@@ -492,6 +549,14 @@ void WindowImplWin32::processEvent(UINT message, WPARAM wParam, LPARAM lParam)
     if (m_handle == NULL)
         return;
 
+    // Input messages carry the time at which they were posted
+    if (((message >= WM_KEYFIRST) && (message <= WM_KEYLAST)) ||
+        ((message >= WM_MOUSEFIRST) && (message <= WM_MOUSELAST)) ||
+        (message == WM_INPUT))
+        setEventTimestamp(static_cast<Uint32>(GetMessageTime()));
+    else
+        clearEventTimestamp();
+
     switch (message)
     {
         // Destroy event
@@ -885,6 +950,9 @@ void WindowImplWin32::processEvent(UINT message, WPARAM wParam, LPARAM lParam)
             }
 
             // Generate a MouseMove event
+            if (!isEventEnabled(Event::MouseMoved))
+                break;
+
             Event event;
             event.type        = Event::MouseMoved;
             event.mouseMove.x = x;
@@ -892,6 +960,31 @@ void WindowImplWin32::processEvent(UINT message, WPARAM wParam, LPARAM lParam)
             pushEvent(event);
             break;
         }
+
+        // Raw input event
+        case WM_INPUT:
+        {
+            if (!m_rawMouseInput || !isEventEnabled(Event::MouseMovedRaw))
+                break;
+
+            RAWINPUT input;
+            UINT size = sizeof(input);
+            if (GetRawInputData(reinterpret_cast<HRAWINPUT>(lParam), RID_INPUT, &input, &size, sizeof(RAWINPUTHEADER)) == static_cast<UINT>(-1))
+                break;
+
+            // Only report relative motion: absolute devices (tablets, remote desktop) are better handled through the cursor position
+            if ((input.header.dwType == RIM_TYPEMOUSE) && !(input.data.mouse.usFlags & MOUSE_MOVE_ABSOLUTE) &&
+                (input.data.mouse.lLastX || input.data.mouse.lLastY))
+            {
+                Event event;
+                event.type                = Event::MouseMovedRaw;
+                event.mouseMoveRaw.deltaX = input.data.mouse.lLastX;
+                event.mouseMoveRaw.deltaY = input.data.mouse.lLastY;
+                pushEvent(event);
+            }
+
+            break;
+        }
     }
 }
 
@@ -145,6 +145,14 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void setMouseCursorVisible(bool visible);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the image of the mouse cursor
+    ///
+    /// \param cursor Native cursor, or an empty cursor for the default one
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setMouseCursor(const CursorImpl& cursor);
+
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable automatic key-repeat
     ///
@@ -168,6 +176,14 @@ public:
     ////////////////////////////////////////////////////////////
     virtual bool hasFocus() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the raw mouse motion events
+    ///
+    /// \param enabled True to enable, false to disable
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setRawMouseInputEnabled(bool enabled);
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -176,6 +192,18 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual void processEvents();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the thread has new messages, or an
+    ///        external event source is signaled
+    ///
+    /// \param timeout Maximum time to wait
+    /// \param sources External waitable handles to wait for
+    ///
+    /// \return True if one of the external event sources is signaled
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool waitForEvents(Time timeout, const std::vector<EventSource>& sources);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -246,12 +274,14 @@ private:
     HWND     m_handle;           ///< Win32 handle of the window
     LONG_PTR m_callback;         ///< Stores the original event callback function of the control
     HCURSOR  m_cursor;           ///< The system cursor to display into the window
+    HCURSOR  m_lastCursor;       ///< Cursor displayed when the cursor is visible
     HICON    m_icon;             ///< Custom icon assigned to the window
     bool     m_keyRepeatEnabled; ///< Automatic key-repeat state for keydown events
     Vector2u m_lastSize;         ///< The last handled size of the window
     bool     m_resizing;         ///< Is the window being resized?
     Uint16   m_surrogate;        ///< First half of the surrogate pair, in case we're receiving a Unicode character in two events
     bool     m_mouseInside;      ///< Mouse is inside the window?
+    bool     m_rawMouseInput;    ///< Is the window the target of the raw mouse input?
 };
 
 } // namespace priv
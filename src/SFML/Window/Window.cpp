@@ -26,10 +26,15 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/Window.hpp>
+#include <SFML/Window/Cursor.hpp>
 #include <SFML/Window/GlContext.hpp>
 #include <SFML/Window/WindowImpl.hpp>
+#include <SFML/Window/VideoModeImpl.hpp>
 #include <SFML/System/Sleep.hpp>
+#include <SFML/System/Profiler.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/FrameArena.hpp>
+#include <algorithm>
 
 
 namespace
@@ -42,10 +47,9 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 Window::Window() :
-m_impl          (NULL),
-m_context       (NULL),
-m_frameTimeLimit(Time::Zero),
-m_size          (0, 0)
+m_impl   (NULL),
+m_context(NULL),
+m_size   (0, 0)
 {
 
 }
@@ -53,10 +57,9 @@ m_size          (0, 0)
 
 ////////////////////////////////////////////////////////////
 Window::Window(VideoMode mode, const String& title, Uint32 style, const ContextSettings& settings) :
-m_impl          (NULL),
-m_context       (NULL),
-m_frameTimeLimit(Time::Zero),
-m_size          (0, 0)
+m_impl   (NULL),
+m_context(NULL),
+m_size   (0, 0)
 {
     create(mode, title, style, settings);
 }
@@ -64,10 +67,9 @@ m_size          (0, 0)
 
 ////////////////////////////////////////////////////////////
 Window::Window(WindowHandle handle, const ContextSettings& settings) :
-m_impl          (NULL),
-m_context       (NULL),
-m_frameTimeLimit(Time::Zero),
-m_size          (0, 0)
+m_impl   (NULL),
+m_context(NULL),
+m_size   (0, 0)
 {
     create(handle, settings);
 }
@@ -209,6 +211,42 @@ bool Window::waitEvent(Event& event)
 }
 
 
+////////////////////////////////////////////////////////////
+bool Window::waitEvent(Event& event, Time timeout)
+{
+    if (m_impl && m_impl->waitEvent(event, timeout, m_eventSources))
+    {
+        return filterEvent(event);
+    }
+    else
+    {
+        return false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Window::addEventSource(EventSource source)
+{
+    if (std::find(m_eventSources.begin(), m_eventSources.end(), source) == m_eventSources.end())
+        m_eventSources.push_back(source);
+}
+
+
+////////////////////////////////////////////////////////////
+void Window::removeEventSource(EventSource source)
+{
+    m_eventSources.erase(std::remove(m_eventSources.begin(), m_eventSources.end(), source), m_eventSources.end());
+}
+
+
+////////////////////////////////////////////////////////////
+Time Window::getEventTime()
+{
+    return priv::WindowImpl::getEventTime();
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2i Window::getPosition() const
 {
@@ -256,6 +294,14 @@ void Window::setTitle(const String& title)
 }
 
 
+////////////////////////////////////////////////////////////
+void Window::setTitle(const Utf8View& title)
+{
+    if (m_impl)
+        m_impl->setTitle(title.toString());
+}
+
+
 ////////////////////////////////////////////////////////////
 void Window::setIcon(unsigned int width, unsigned int height, const Uint8* pixels)
 {
@@ -280,6 +326,63 @@ void Window::setVerticalSyncEnabled(bool enabled)
 }
 
 
+////////////////////////////////////////////////////////////
+void Window::setSwapInterval(int interval)
+{
+    if (setActive())
+        m_context->setSwapInterval(interval);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Window::getRefreshRate() const
+{
+    return m_context ? m_context->getRefreshRate() : priv::VideoModeImpl::getDesktopRefreshRate();
+}
+
+
+////////////////////////////////////////////////////////////
+Window::Presentation Window::getLastPresentation() const
+{
+    Presentation presentation;
+    presentation.frameCount   = 0;
+    presentation.refreshCount = 0;
+    presentation.time         = Time::Zero;
+    presentation.available    = m_context && m_context->getLastPresentation(presentation.frameCount, presentation.refreshCount, presentation.time);
+
+    return presentation;
+}
+
+
+////////////////////////////////////////////////////////////
+Window::FrameTiming Window::waitForNextFrame()
+{
+    FrameTiming timing;
+    timing.refreshTime  = Time::Zero;
+    timing.deadline     = Time::Zero;
+    timing.synchronized = m_impl && m_impl->waitForRefresh(timing.refreshTime, timing.deadline);
+
+    if (!timing.synchronized)
+    {
+        // Estimate the refreshes on a regular grid of the refresh period
+        unsigned int refreshRate = getRefreshRate();
+        if (refreshRate == 0)
+            refreshRate = 60;
+
+        Int64 period = 1000000 / refreshRate;
+        Int64 now = priv::WindowImpl::getEventTime().asMicroseconds();
+        Int64 next = (now / period + 1) * period;
+
+        sleep(microseconds(next - now));
+
+        timing.refreshTime = microseconds(next);
+        timing.deadline    = microseconds(next + period);
+    }
+
+    return timing;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Window::setMouseCursorVisible(bool visible)
 {
@@ -288,6 +391,14 @@ void Window::setMouseCursorVisible(bool visible)
 }
 
 
+////////////////////////////////////////////////////////////
+void Window::setMouseCursor(const Cursor& cursor)
+{
+    if (m_impl)
+        m_impl->setMouseCursor(cursor.getImpl());
+}
+
+
 ////////////////////////////////////////////////////////////
 void Window::setKeyRepeatEnabled(bool enabled)
 {
@@ -296,13 +407,70 @@ void Window::setKeyRepeatEnabled(bool enabled)
 }
 
 
+////////////////////////////////////////////////////////////
+void Window::setRawMouseInputEnabled(bool enabled)
+{
+    if (m_impl)
+        m_impl->setRawMouseInputEnabled(enabled);
+}
+
+
+////////////////////////////////////////////////////////////
+void Window::setMouseMoveCoalescingEnabled(bool enabled)
+{
+    if (m_impl)
+        m_impl->setMouseMoveCoalescingEnabled(enabled);
+}
+
+
+////////////////////////////////////////////////////////////
+void Window::setInputThreadEnabled(bool enabled)
+{
+    if (m_impl)
+        m_impl->setInputThreadEnabled(enabled);
+}
+
+
 ////////////////////////////////////////////////////////////
 void Window::setFramerateLimit(unsigned int limit)
 {
     if (limit > 0)
-        m_frameTimeLimit = seconds(1.f / limit);
+        m_framePacer.setFrameTime(microseconds(1000000 / limit));
+    else
+        m_framePacer.setFrameTime(Time::Zero);
+}
+
+
+////////////////////////////////////////////////////////////
+void Window::setFrameInterval(unsigned int interval)
+{
+    if (interval > 0)
+    {
+        // Assume a common refresh rate if the system can't tell us
+        unsigned int refreshRate = getRefreshRate();
+        if (refreshRate == 0)
+            refreshRate = 60;
+
+        m_framePacer.setFrameTime(microseconds(Int64(1000000) * interval / refreshRate));
+    }
     else
-        m_frameTimeLimit = Time::Zero;
+    {
+        m_framePacer.setFrameTime(Time::Zero);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+FramePacer::Statistics Window::getFrameStatistics() const
+{
+    return m_framePacer.getStatistics();
+}
+
+
+////////////////////////////////////////////////////////////
+void Window::resetFrameStatistics()
+{
+    m_framePacer.resetStatistics();
 }
 
 
@@ -314,6 +482,44 @@ void Window::setJoystickThreshold(float threshold)
 }
 
 
+////////////////////////////////////////////////////////////
+void Window::setEventEnabled(Event::EventType type, bool enabled)
+{
+    if (m_impl)
+        m_impl->setEventEnabled(type, enabled);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Window::isEventEnabled(Event::EventType type) const
+{
+    return m_impl ? m_impl->isEventEnabled(type) : true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Window::setEventRecording(EventRecording* recording)
+{
+    if (m_impl)
+        m_impl->setEventRecording(recording);
+}
+
+
+////////////////////////////////////////////////////////////
+void Window::replayEvents(const EventRecording* recording, bool realTime)
+{
+    if (m_impl)
+        m_impl->replayEvents(recording, realTime);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Window::isReplayingEvents() const
+{
+    return m_impl ? m_impl->isReplayingEvents() : false;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Window::setActive(bool active) const
 {
@@ -355,16 +561,26 @@ bool Window::hasFocus() const
 
 void Window::display()
 {
-    // Display the backbuffer on screen
-    if (setActive())
-        m_context->display();
-
-    // Limit the framerate if needed
-    if (m_frameTimeLimit != Time::Zero)
     {
-        sleep(m_frameTimeLimit - m_clock.getElapsedTime());
-        m_clock.restart();
+        SFML_PROFILE_SCOPE("Window::display");
+
+        // Display the backbuffer on screen
+        if (setActive())
+            m_context->display();
+
+        // Limit the framerate if needed (this also measures the frame time)
+        m_framePacer.wait();
     }
+
+    // Count the frames for the recording and the replay of the events
+    if (m_impl)
+        m_impl->endFrame();
+
+    // The temporary memory of this frame can be reused
+    FrameArena::getThreadArena().reset();
+
+    // The zones of this frame are complete
+    SFML_PROFILE_FRAME();
 }
 
 
@@ -421,7 +637,7 @@ void Window::initialize()
     m_size = m_impl->getSize();
 
     // Reset frame time
-    m_clock.restart();
+    m_framePacer.restart();
 
     // Activate the window
     setActive();
@@ -27,9 +27,12 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/WindowImpl.hpp>
 #include <SFML/Window/Event.hpp>
+#include <SFML/Window/EventRecording.hpp>
 #include <SFML/Window/JoystickManager.hpp>
 #include <SFML/Window/SensorManager.hpp>
 #include <SFML/System/Sleep.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Lock.hpp>
 #include <algorithm>
 #include <cmath>
 
@@ -61,6 +64,17 @@
 #endif
 
 
+namespace
+{
+    // Clock defining the time line of the event timestamps
+    sf::Clock& getEventClock()
+    {
+        static sf::Clock clock;
+        return clock;
+    }
+}
+
+
 namespace sf
 {
 namespace priv
@@ -79,10 +93,41 @@ WindowImpl* WindowImpl::create(WindowHandle handle)
 }
 
 
+////////////////////////////////////////////////////////////
+Time WindowImpl::getEventTime()
+{
+    return getEventClock().getElapsedTime();
+}
+
+
 ////////////////////////////////////////////////////////////
 WindowImpl::WindowImpl() :
-m_joystickThreshold(0.1f)
+m_inputEvents        (1024),
+m_inputThread        (NULL),
+m_inputThreadStopping(false),
+m_joystickThreshold  (0.1f),
+m_eventTimestamp     (Time::Zero),
+m_systemTimeValid    (false),
+m_lastSystemTime     (0),
+m_systemTime         (0),
+m_systemTimeOffset   (0),
+m_frameCount         (0),
+m_recording          (NULL),
+m_recordingStart     (Time::Zero),
+m_recordingStartFrame(0),
+m_replay             (NULL),
+m_replayIndex        (0),
+m_replayRealTime     (true),
+m_replayStart        (Time::Zero),
+m_replayStartFrame   (0)
 {
+    // Make sure that the time line of the events starts now at the latest
+    getEventClock();
+
+    // All the events are generated by default
+    for (int i = 0; i < Event::Count; ++i)
+        m_eventEnabled[i] = true;
+
     // Get the initial joystick states
     JoystickManager::getInstance().update();
     for (unsigned int i = 0; i < Joystick::Count; ++i)
@@ -97,7 +142,8 @@ m_joystickThreshold(0.1f)
 ////////////////////////////////////////////////////////////
 WindowImpl::~WindowImpl()
 {
-    // Nothing to do
+    // Stop the input thread, if any
+    setInputThreadEnabled(false);
 }
 
 
@@ -108,16 +154,98 @@ void WindowImpl::setJoystickThreshold(float threshold)
 }
 
 
+////////////////////////////////////////////////////////////
+void WindowImpl::setEventEnabled(Event::EventType type, bool enabled)
+{
+    // The window needs the resize events to keep track of its size
+    if ((type >= 0) && (type < Event::Count) && (type != Event::Resized))
+        m_eventEnabled[type] = enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool WindowImpl::isEventEnabled(Event::EventType type) const
+{
+    return (type >= 0) && (type < Event::Count) && m_eventEnabled[type];
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImpl::setInputThreadEnabled(bool enabled)
+{
+    if (enabled && !m_inputThread)
+    {
+        m_inputThreadStopping = false;
+        m_inputThread = new Thread(&WindowImpl::runInputThread, this);
+        m_inputThread->launch();
+    }
+    else if (!enabled && m_inputThread)
+    {
+        {
+            Lock lock(m_inputThreadMutex);
+            m_inputThreadStopping = true;
+        }
+
+        // The events already read by the thread remain in its queue until they are popped
+        m_inputThread->wait();
+        delete m_inputThread;
+        m_inputThread = NULL;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImpl::setEventRecording(EventRecording* recording)
+{
+    m_recording = recording;
+    m_recordingStart = getEventTime();
+    m_recordingStartFrame = m_frameCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImpl::replayEvents(const EventRecording* recording, bool realTime)
+{
+    m_replay = (recording && (recording->getEventCount() > 0)) ? recording : NULL;
+    m_replayIndex = 0;
+    m_replayRealTime = realTime;
+    m_replayStart = getEventTime();
+    m_replayStartFrame = m_frameCount;
+}
+
+
+////////////////////////////////////////////////////////////
+bool WindowImpl::isReplayingEvents() const
+{
+    return m_replay != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImpl::endFrame()
+{
+    ++m_frameCount;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool WindowImpl::popEvent(Event& event, bool block)
 {
+    // Recorded events replace the events of the system until the end of the replay
+    if (m_replay)
+    {
+        if (replayEvent(event, block))
+            return true;
+
+        if (m_replay)
+            return false;
+    }
+
     // If the event queue is empty, let's first check if new events are available from the OS
-    if (m_events.empty())
+    if (!hasEvents())
     {
         // Get events from the system
-        processJoystickEvents();
-        processSensorEvents();
-        processEvents();
+        fetchEvents();
 
         // In blocking mode, we must process events until one is triggered
         if (block)
@@ -125,33 +253,327 @@ bool WindowImpl::popEvent(Event& event, bool block)
             // Here we use a manual wait loop instead of the optimized
             // wait-event provided by the OS, so that we don't skip joystick
             // events (which require polling)
-            while (m_events.empty())
+            while (!hasEvents())
             {
                 sleep(milliseconds(10));
-                processJoystickEvents();
-                processSensorEvents();
-                processEvents();
+                fetchEvents();
             }
         }
     }
 
     // Pop the first event of the queue, if it is not empty
-    if (!m_events.empty())
+    if (!takeEvent(event))
+        return false;
+
+    recordEvent(event);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool WindowImpl::waitEvent(Event& event, Time timeout, const std::vector<EventSource>& sources)
+{
+    Clock clock;
+
+    for (;;)
+    {
+        if (m_replay)
+        {
+            // Recorded events replace the events of the system until the end of the replay
+            if (replayEvent(event, false))
+                return true;
+        }
+        else
+        {
+            // If the event queue is empty, let's first check if new events are available from the OS
+            if (!hasEvents())
+                fetchEvents();
+
+            // Pop the first event of the queue, if it is not empty
+            if (takeEvent(event))
+            {
+                recordEvent(event);
+                return true;
+            }
+        }
+
+        // Joysticks and sensors have to be polled: wake up often while they are
+        // in use, and check at least once per second for new joystick connections;
+        // a replay checks often whether its next event is due
+        Time slice = (m_replay || needsPolling()) ? milliseconds(10) : seconds(1);
+        if (timeout != Time::Zero)
+        {
+            Time remaining = timeout - clock.getElapsedTime();
+            if (remaining <= Time::Zero)
+                return false;
+
+            slice = std::min(slice, remaining);
+        }
+
+        // Sleep until the system has something for us, and let the caller handle its
+        // own sources as soon as one of them is ready
+        if (waitForEvents(slice, sources))
+            return false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool WindowImpl::replayEvent(Event& event, bool block)
+{
+    for (;;)
+    {
+        // Keep the system responsive, but discard its events
+        fetchEvents();
+        Event discarded;
+        while (takeEvent(discarded))
+            ;
+
+        if (m_replayIndex >= m_replay->getEventCount())
+        {
+            // End of the recording: the events of the system take over again
+            m_replay = NULL;
+            return false;
+        }
+
+        const EventRecording::Entry& entry = m_replay->getEntry(m_replayIndex);
+
+        if (m_replayRealTime)
+        {
+            // Replay the event when the recorded time has elapsed since the start of the replay
+            Time remaining = entry.event.timestamp - (getEventTime() - m_replayStart);
+            if (remaining <= Time::Zero)
+            {
+                event = entry.event;
+                event.timestamp = m_replayStart + entry.event.timestamp;
+                ++m_replayIndex;
+                return true;
+            }
+
+            if (!block)
+                return false;
+
+            sleep(std::min(remaining, milliseconds(10)));
+        }
+        else
+        {
+            // Replay the event in the frame where it was recorded, or right
+            // away when the caller waits for it (nothing else could happen)
+            if (block || (m_frameCount - m_replayStartFrame >= entry.frame))
+            {
+                event = entry.event;
+                event.timestamp = getEventTime();
+                ++m_replayIndex;
+                return true;
+            }
+
+            return false;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImpl::recordEvent(const Event& event)
+{
+    if (!m_recording)
+        return;
+
+    Event recorded = event;
+    recorded.timestamp = event.timestamp - m_recordingStart;
+    m_recording->add(recorded, m_frameCount - m_recordingStartFrame);
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImpl::pushEvent(const Event& event)
+{
+    if (!m_eventEnabled[event.type])
+        return;
+
+    m_events.push(event);
+
+    // Stamp the events that don't have a more precise timestamp with the current time
+    Event& pushed = m_events.back();
+    if (pushed.timestamp == Time::Zero)
+        pushed.timestamp = (m_eventTimestamp != Time::Zero) ? m_eventTimestamp : getEventTime();
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImpl::setEventTimestamp(Uint32 milliseconds)
+{
+    // Unwrap the 32-bit system time (it wraps around every 49.7 days)
+    if (m_systemTimeValid)
+        m_systemTime += static_cast<Int32>(milliseconds - m_lastSystemTime) * Int64(1000);
+    else
+        m_systemTime = milliseconds * Int64(1000);
+
+    m_lastSystemTime = milliseconds;
+
+    // Events are never received before they occur, so the smallest difference
+    // between the time of reception and the system time is the best estimate of
+    // the offset between the two clocks; let it slowly increase as well, so that
+    // it can follow a drift between the clocks
+    Time now = getEventTime();
+    Int64 offset = now.asMicroseconds() - m_systemTime;
+    if (!m_systemTimeValid || (offset < m_systemTimeOffset))
+        m_systemTimeOffset = offset;
+    else
+        m_systemTimeOffset += (offset - m_systemTimeOffset) / 256;
+
+    m_systemTimeValid = true;
+
+    // Zero means "no timestamp", so make sure that we never use it
+    m_eventTimestamp = std::max(std::min(microseconds(m_systemTime + m_systemTimeOffset), now), microseconds(1));
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImpl::clearEventTimestamp()
+{
+    m_eventTimestamp = Time::Zero;
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImpl::fetchEvents()
+{
+    // The input thread takes care of the joysticks when it is running
+    if (!m_inputThread)
+        processJoystickEvents();
+
+    processSensorEvents();
+    processEvents();
+
+    // The timestamp of the last system event doesn't apply to what comes next
+    clearEventTimestamp();
+}
+
+
+////////////////////////////////////////////////////////////
+bool WindowImpl::hasEvents() const
+{
+    return !m_events.empty() || m_inputEvents.front();
+}
+
+
+////////////////////////////////////////////////////////////
+bool WindowImpl::takeEvent(Event& event)
+{
+    const Event* input = m_inputEvents.front();
+
+    if (m_events.empty() && !input)
+        return false;
+
+    // Return the oldest of the two queues' first events, so that
+    // the joystick events are correctly ordered with the others
+    if (!m_events.empty() && (!input || (m_events.front().timestamp <= input->timestamp)))
     {
         event = m_events.front();
         m_events.pop();
+    }
+    else
+    {
+        event = *input;
+        m_inputEvents.pop();
+    }
 
-        return true;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImpl::pushJoystickEvent(const Event& event)
+{
+    if (!m_eventEnabled[event.type])
+        return;
+
+    if (!m_inputThread)
+    {
+        pushEvent(event);
+        return;
     }
 
+    // We are in the input thread: stamp the event right away, and
+    // wait for the window's thread to make room in the queue if needed
+    Event stamped = event;
+    stamped.timestamp = getEventTime();
+
+    while (!m_inputEvents.push(stamped))
+    {
+        if (isInputThreadStopping())
+            return;
+
+        sleep(milliseconds(1));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImpl::runInputThread()
+{
+    // Sample the joysticks at about 1 kHz, so that their events get
+    // accurate timestamps and short button presses are never missed
+    while (!isInputThreadStopping())
+    {
+        processJoystickEvents();
+        sleep(milliseconds(1));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool WindowImpl::isInputThreadStopping()
+{
+    Lock lock(m_inputThreadMutex);
+
+    return m_inputThreadStopping;
+}
+
+
+////////////////////////////////////////////////////////////
+bool WindowImpl::waitForEvents(Time timeout, const std::vector<EventSource>& sources)
+{
+    // We can't wait for the system events here, so just make sure that we check them again soon
+    (void)sources;
+    sleep(std::min(timeout, milliseconds(10)));
+
     return false;
 }
 
 
 ////////////////////////////////////////////////////////////
-void WindowImpl::pushEvent(const Event& event)
+void WindowImpl::setMouseCursor(const CursorImpl& cursor)
 {
-    m_events.push(event);
+    // Not supported by default
+    (void)cursor;
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImpl::setRawMouseInputEnabled(bool enabled)
+{
+    // Not supported by default
+    (void)enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImpl::setMouseMoveCoalescingEnabled(bool enabled)
+{
+    // Not supported by default
+    (void)enabled;
+}
+
+
+////////////////////////////////////////////////////////////
+bool WindowImpl::waitForRefresh(Time& refreshTime, Time& deadline)
+{
+    // Not supported by default
+    (void)refreshTime;
+    (void)deadline;
+    return false;
 }
 
 
@@ -175,13 +597,13 @@ void WindowImpl::processJoystickEvents()
             Event event;
             event.type = connected ? Event::JoystickConnected : Event::JoystickDisconnected;
             event.joystickButton.joystickId = i;
-            pushEvent(event);
+            pushJoystickEvent(event);
         }
 
         if (connected)
         {
-            // Axes
-            for (unsigned int j = 0; j < Joystick::AxisCount; ++j)
+            // Axes (the most frequent events, skipped entirely when they are disabled)
+            for (unsigned int j = 0; (j < Joystick::AxisCount) && m_eventEnabled[Event::JoystickMoved]; ++j)
             {
                 if (caps.axes[j])
                 {
@@ -195,7 +617,7 @@ void WindowImpl::processJoystickEvents()
                         event.joystickMove.joystickId = i;
                         event.joystickMove.axis = axis;
                         event.joystickMove.position = currPos;
-                        pushEvent(event);
+                        pushJoystickEvent(event);
                     }
                 }
             }
@@ -212,7 +634,7 @@ void WindowImpl::processJoystickEvents()
                     event.type = currPressed ? Event::JoystickButtonPressed : Event::JoystickButtonReleased;
                     event.joystickButton.joystickId = i;
                     event.joystickButton.button = j;
-                    pushEvent(event);
+                    pushJoystickEvent(event);
                 }
             }
         }
@@ -238,7 +660,7 @@ void WindowImpl::processSensorEvents()
             m_sensorValue[i] = SensorManager::getInstance().getValue(sensor);
 
             // If the value has changed, trigger an event
-            if (m_sensorValue[i] != previousValue) // @todo use a threshold?
+            if ((m_sensorValue[i] != previousValue) && m_eventEnabled[Event::SensorChanged]) // @todo use a threshold?
             {
                 Event event;
                 event.type = Event::SensorChanged;
@@ -252,6 +674,29 @@ void WindowImpl::processSensorEvents()
     }
 }
 
+
+////////////////////////////////////////////////////////////
+bool WindowImpl::needsPolling() const
+{
+    // The events of the input thread can arrive at any time
+    if (m_inputThread)
+        return true;
+
+    for (unsigned int i = 0; i < Joystick::Count; ++i)
+    {
+        if (m_joystickStates[i].connected)
+            return true;
+    }
+
+    for (unsigned int i = 0; i < Sensor::Count; ++i)
+    {
+        if (SensorManager::getInstance().isEnabled(static_cast<Sensor::Type>(i)))
+            return true;
+    }
+
+    return false;
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -29,9 +29,13 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Config.hpp>
+#include <SFML/System/Mutex.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/String.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/Time.hpp>
 #include <SFML/Window/Event.hpp>
+#include <SFML/Window/InputQueue.hpp>
 #include <SFML/Window/Joystick.hpp>
 #include <SFML/Window/JoystickImpl.hpp>
 #include <SFML/Window/Sensor.hpp>
@@ -41,13 +45,17 @@
 #include <SFML/Window/ContextSettings.hpp>
 #include <queue>
 #include <set>
+#include <vector>
 
 namespace sf
 {
+class EventRecording;
 class WindowListener;
 
 namespace priv
 {
+class CursorImpl;
+
 ////////////////////////////////////////////////////////////
 /// \brief Abstract base class for OS-specific window implementation
 ///
@@ -79,6 +87,16 @@ public:
     ////////////////////////////////////////////////////////////
     static WindowImpl* create(WindowHandle handle);
 
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current time on the time line of the event timestamps
+    ///
+    /// \return Current event time
+    ///
+    ////////////////////////////////////////////////////////////
+    static Time getEventTime();
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -96,6 +114,80 @@ public:
     ////////////////////////////////////////////////////////////
     void setJoystickThreshold(float threshold);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the generation of a type of events
+    ///
+    /// Resized events can't be disabled.
+    ///
+    /// \param type    Type of events
+    /// \param enabled True to generate the events, false to drop them
+    ///
+    ////////////////////////////////////////////////////////////
+    void setEventEnabled(Event::EventType type, bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a type of events is generated
+    ///
+    /// The implementations can check it to skip the translation
+    /// of frequent system events that would be dropped.
+    ///
+    /// \param type Type of events
+    ///
+    /// \return True if the events are generated
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isEventEnabled(Event::EventType type) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the input thread of the window
+    ///
+    /// When the input thread is enabled, the joysticks are read
+    /// by a dedicated thread at a high rate, and their events are
+    /// passed to the window through a lock-free queue; the events
+    /// of the operating system are still processed by the thread
+    /// which owns the window, and both are merged by timestamp.
+    ///
+    /// \param enabled True to enable, false to disable
+    ///
+    ////////////////////////////////////////////////////////////
+    void setInputThreadEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start or stop recording the events returned by the window
+    ///
+    /// \param recording Recording to append the events to (NULL to stop)
+    ///
+    ////////////////////////////////////////////////////////////
+    void setEventRecording(EventRecording* recording);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start or stop replaying recorded events in place
+    ///        of the events of the system
+    ///
+    /// \param recording Events to replay (NULL to stop)
+    /// \param realTime  True to replay at the recorded speed, false to
+    ///                  replay each event in its recorded frame
+    ///
+    ////////////////////////////////////////////////////////////
+    void replayEvents(const EventRecording* recording, bool realTime);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether recorded events are being replayed
+    ///
+    /// \return True until the last recorded event has been returned
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isReplayingEvents() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Notify the window that a frame has been displayed
+    ///
+    /// The frames are counted to record and replay the events
+    /// in the frames where they were returned.
+    ///
+    ////////////////////////////////////////////////////////////
+    void endFrame();
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the next window event available
     ///
@@ -112,6 +204,20 @@ public:
     ////////////////////////////////////////////////////////////
     bool popEvent(Event& event, bool block);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the next window event, waiting at most
+    ///        \a timeout for it or for an external event source
+    ///
+    /// \param event   Event to be returned
+    /// \param timeout Maximum time to wait (Time::Zero for infinity)
+    /// \param sources External event sources to wait for
+    ///
+    /// \return True if an event was returned, false if an event
+    ///         source became ready or the timeout expired
+    ///
+    ////////////////////////////////////////////////////////////
+    bool waitEvent(Event& event, Time timeout, const std::vector<EventSource>& sources);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the OS-specific handle of the window
     ///
@@ -186,6 +292,17 @@ public:
     ////////////////////////////////////////////////////////////
     virtual void setMouseCursorVisible(bool visible) = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the image of the mouse cursor
+    ///
+    /// The default implementation does nothing, for platforms
+    /// that don't support custom cursors.
+    ///
+    /// \param cursor Native cursor, or an empty cursor for the default one
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setMouseCursor(const CursorImpl& cursor);
+
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable automatic key-repeat
     ///
@@ -209,6 +326,42 @@ public:
     ////////////////////////////////////////////////////////////
     virtual bool hasFocus() const = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the raw mouse motion events
+    ///
+    /// The default implementation does nothing, for platforms
+    /// that don't support raw mouse input.
+    ///
+    /// \param enabled True to enable, false to disable
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setRawMouseInputEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the coalescing of mouse moves
+    ///
+    /// The default implementation does nothing, for platforms
+    /// that don't coalesce mouse moves.
+    ///
+    /// \param enabled True to enable, false to disable
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void setMouseMoveCoalescingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the next refresh of the display
+    ///
+    /// The default implementation returns false, for platforms
+    /// that don't report the refreshes of the display.
+    ///
+    /// \param refreshTime Filled with the time of the refresh, on the time line of getEventTime
+    /// \param deadline    Filled with the expected time of the next refresh
+    ///
+    /// \return True if the refresh was reported by the system, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool waitForRefresh(Time& refreshTime, Time& deadline);
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -229,14 +382,124 @@ protected:
     ////////////////////////////////////////////////////////////
     void pushEvent(const Event& event);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the timestamp of the system event being processed
+    ///
+    /// Events pushed after a call to this function get the
+    /// corresponding timestamp, converted to the time line of
+    /// getEventTime, until clearEventTimestamp is called (or the
+    /// processEvents function returns). Events pushed without a
+    /// system timestamp are stamped with the time of the push.
+    ///
+    /// \param milliseconds Time of the system event, in milliseconds
+    ///                     on a monotonic system clock (may wrap around)
+    ///
+    ////////////////////////////////////////////////////////////
+    void setEventTimestamp(Uint32 milliseconds);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop using the timestamp set with setEventTimestamp
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearEventTimestamp();
+
     ////////////////////////////////////////////////////////////
     /// \brief Process incoming events from the operating system
     ///
     ////////////////////////////////////////////////////////////
     virtual void processEvents() = 0;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the operating system has new events for
+    ///        the window, or an external event source is ready
+    ///
+    /// This function is called by waitEvent when the event queue
+    /// is empty. Derived classes that can block on their event
+    /// source override it; the default implementation, which
+    /// can't observe the system events, only sleeps for a short
+    /// time and ignores the external sources.
+    ///
+    /// \param timeout Maximum time to wait
+    /// \param sources External event sources to wait for
+    ///
+    /// \return True if one of the external event sources is ready
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool waitForEvents(Time timeout, const std::vector<EventSource>& sources);
+
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the pending events of all the sources
+    ///
+    ////////////////////////////////////////////////////////////
+    void fetchEvents();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether an event is available in one of the queues
+    ///
+    /// \return True if an event is available
+    ///
+    ////////////////////////////////////////////////////////////
+    bool hasEvents() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove the oldest available event from the queues
+    ///
+    /// \param event Event to be returned
+    ///
+    /// \return True if an event was returned, false if the queues are empty
+    ///
+    ////////////////////////////////////////////////////////////
+    bool takeEvent(Event& event);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the next recorded event, if it is due
+    ///
+    /// The events of the system are discarded while replaying.
+    /// The replay stops when the end of the recording is reached.
+    ///
+    /// \param event Event to be returned
+    /// \param block Use true to wait until the next recorded event is due
+    ///
+    /// \return True if an event was returned
+    ///
+    ////////////////////////////////////////////////////////////
+    bool replayEvent(Event& event, bool block);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append an event returned by the window to the recording, if any
+    ///
+    /// \param event Event returned by the window
+    ///
+    ////////////////////////////////////////////////////////////
+    void recordEvent(const Event& event);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Push a new event generated by the joysticks
+    ///
+    /// The event goes to the queue of the input thread if it is
+    /// running, and to the regular queue otherwise.
+    ///
+    /// \param event Event to push
+    ///
+    ////////////////////////////////////////////////////////////
+    void pushJoystickEvent(const Event& event);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Main function of the input thread
+    ///
+    ////////////////////////////////////////////////////////////
+    void runInputThread();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether the input thread has been asked to stop
+    ///
+    /// \return True if the input thread must stop
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isInputThreadStopping();
+
     ////////////////////////////////////////////////////////////
     /// \brief Read the joysticks state and generate the appropriate events
     ///
@@ -249,13 +512,41 @@ private:
     ////////////////////////////////////////////////////////////
     void processSensorEvents();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether a joystick or a sensor currently
+    ///        needs to be polled regularly
+    ///
+    /// \return True if a joystick is connected or a sensor is enabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool needsPolling() const;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    std::queue<Event> m_events;                          ///< Queue of available events
-    JoystickState     m_joystickStates[Joystick::Count]; ///< Previous state of the joysticks
-    Vector3f          m_sensorValue[Sensor::Count];      ///< Previous value of the sensors
-    float             m_joystickThreshold;               ///< Joystick threshold (minimum motion for "move" event to be generated)
+    std::queue<Event>     m_events;                          ///< Queue of available events
+    InputQueue            m_inputEvents;                     ///< Queue of the events generated by the input thread
+    Thread*               m_inputThread;                     ///< Thread reading the joysticks (NULL if disabled)
+    bool                  m_inputThreadStopping;             ///< Has the input thread been asked to stop?
+    Mutex                 m_inputThreadMutex;                ///< Mutex protecting m_inputThreadStopping
+    JoystickState         m_joystickStates[Joystick::Count]; ///< Previous state of the joysticks
+    Vector3f              m_sensorValue[Sensor::Count];      ///< Previous value of the sensors
+    float                 m_joystickThreshold;               ///< Joystick threshold (minimum motion for "move" event to be generated)
+    bool                  m_eventEnabled[Event::Count];      ///< Is each type of events generated?
+    Time                  m_eventTimestamp;                  ///< Timestamp of the system event being processed (zero if none)
+    bool                  m_systemTimeValid;                 ///< Have we received a system timestamp yet?
+    Uint32                m_lastSystemTime;                  ///< Last system timestamp received, in milliseconds
+    Int64                 m_systemTime;                      ///< Last system timestamp received, unwrapped, in microseconds
+    Int64                 m_systemTimeOffset;                ///< Estimated offset between the system time and the event time, in microseconds
+    Uint64                m_frameCount;                      ///< Number of frames displayed since the creation of the window
+    EventRecording*       m_recording;                       ///< Recording receiving the returned events (NULL if not recording)
+    Time                  m_recordingStart;                  ///< Event time at which the recording started
+    Uint64                m_recordingStartFrame;             ///< Frame at which the recording started
+    const EventRecording* m_replay;                          ///< Recording being replayed (NULL if not replaying)
+    std::size_t           m_replayIndex;                     ///< Index of the next event to replay
+    bool                  m_replayRealTime;                  ///< Are the events replayed at the recorded speed?
+    Time                  m_replayStart;                     ///< Event time at which the replay started
+    Uint64                m_replayStartFrame;                ///< Frame at which the replay started
 };
 
 } // namespace priv
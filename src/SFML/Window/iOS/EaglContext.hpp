@@ -131,6 +131,14 @@ protected:
     ////////////////////////////////////////////////////////////
     virtual bool makeCurrent();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Make no context current on the calling thread
+    ///
+    /// \return True on success, false if any error happened
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool releaseCurrent();
+
 private:
 
     ////////////////////////////////////////////////////////////
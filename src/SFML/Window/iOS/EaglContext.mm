@@ -173,6 +173,13 @@ bool EaglContext::makeCurrent()
 }
 
 
+////////////////////////////////////////////////////////////
+bool EaglContext::releaseCurrent()
+{
+    return [EAGLContext setCurrentContext:nil];
+}
+
+
 ////////////////////////////////////////////////////////////
 void EaglContext::display()
 {
@@ -44,6 +44,15 @@ bool InputImpl::isKeyPressed(Keyboard::Key key)
 }
 
 
+////////////////////////////////////////////////////////////
+void InputImpl::getKeyboardState(bool* pressed)
+{
+    // Querying the keys one by one is cheap on this system
+    for (int i = 0; i < Keyboard::KeyCount; ++i)
+        pressed[i] = isKeyPressed(static_cast<Keyboard::Key>(i));
+}
+
+
 ////////////////////////////////////////////////////////////
 void InputImpl::setVirtualKeyboardVisible(bool visible)
 {
@@ -59,6 +68,16 @@ bool InputImpl::isMouseButtonPressed(Mouse::Button button)
 }
 
 
+////////////////////////////////////////////////////////////
+void InputImpl::getMouseState(bool* pressed, Vector2i& position)
+{
+    for (int i = 0; i < Mouse::ButtonCount; ++i)
+        pressed[i] = isMouseButtonPressed(static_cast<Mouse::Button>(i));
+
+    position = getMousePosition();
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2i InputImpl::getMousePosition()
 {
@@ -46,6 +46,13 @@ void JoystickImpl::cleanup()
 }
 
 
+////////////////////////////////////////////////////////////
+void JoystickImpl::updateConnections()
+{
+    // Not implemented
+}
+
+
 ////////////////////////////////////////////////////////////
 bool JoystickImpl::isConnected(unsigned int index)
 {
@@ -49,6 +49,25 @@
 ////////////////////////////////////////////////////////////
 - (id)initWithFrame:(CGRect)frame andContentScaleFactor:(CGFloat)factor;
 
+////////////////////////////////////////////////////////////
+/// \brief Wait until the next refresh of the display
+///
+/// The run loop keeps processing the other events while waiting.
+///
+/// \param timestamp Filled with the time of the refresh (on the CACurrentMediaTime clock)
+/// \param deadline  Filled with the expected time of the next refresh
+///
+/// \return True if the refresh was received, false if it timed out
+///
+////////////////////////////////////////////////////////////
+- (bool)waitForRefresh:(CFTimeInterval*)timestamp deadline:(CFTimeInterval*)deadline;
+
+////////////////////////////////////////////////////////////
+/// \brief Stop receiving the refreshes of the display
+///
+////////////////////////////////////////////////////////////
+- (void)invalidateDisplayLink;
+
 ////////////////////////////////////////////////////////////
 // Member data
 ////////////////////////////////////////////////////////////
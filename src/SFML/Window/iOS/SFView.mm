@@ -34,6 +34,8 @@
 @interface SFView()
 
 @property (nonatomic) NSMutableArray* touches;
+@property (nonatomic) CADisplayLink* displayLink;
+@property (nonatomic) bool refreshReceived;
 
 @end
 
@@ -203,4 +205,59 @@
 }
 
 
+////////////////////////////////////////////////////////////
+- (void)displayLinkFired:(CADisplayLink*)link
+{
+    self.refreshReceived = true;
+
+    // Don't wake the application up at every refresh if it doesn't wait for them
+    link.paused = YES;
+}
+
+
+////////////////////////////////////////////////////////////
+- (bool)waitForRefresh:(CFTimeInterval*)timestamp deadline:(CFTimeInterval*)deadline
+{
+    if (!self.displayLink)
+    {
+        self.displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(displayLinkFired:)];
+        [self.displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSDefaultRunLoopMode];
+    }
+
+    self.refreshReceived = false;
+    self.displayLink.paused = NO;
+
+    // Run the loop until the refresh arrives; give up if the display link stops
+    // delivering refreshes (when the application is in background for example)
+    CFTimeInterval start = CACurrentMediaTime();
+    while (!self.refreshReceived && (CACurrentMediaTime() - start < 0.1))
+        CFRunLoopRunInMode(kCFRunLoopDefaultMode, 0.01, true);
+
+    if (!self.refreshReceived)
+    {
+        self.displayLink.paused = YES;
+        return false;
+    }
+
+    *timestamp = self.displayLink.timestamp;
+
+    // The target timestamp is only available since iOS 10
+    if ([self.displayLink respondsToSelector:@selector(targetTimestamp)])
+        *deadline = self.displayLink.targetTimestamp;
+    else
+        *deadline = self.displayLink.timestamp + self.displayLink.duration;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+- (void)invalidateDisplayLink
+{
+    // The display link retains the view, it must be invalidated to release it
+    [self.displayLink invalidate];
+    self.displayLink = nil;
+}
+
+
 @end
@@ -97,13 +97,34 @@ public:
     ////////////////////////////////////////////////////////////
     void setEnabled(bool enabled);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the sampling rate of the sensor
+    ///
+    /// \param interval   Requested time between two samples
+    /// \param maxLatency Maximum delay before the samples are delivered
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSamplingRate(Time interval, Time maxLatency);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the samples received since the last call
+    ///
+    /// \param samples  Array to fill with the samples
+    /// \param maxCount Maximum number of samples to write
+    ///
+    /// \return Number of samples written
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSamples(Vector3f* samples, std::size_t maxCount);
+
 private:
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Sensor::Type m_sensor; ///< Type of the sensor
-    bool m_enabled;        ///< Enable state of the sensor
+    Sensor::Type m_sensor;        ///< Type of the sensor
+    bool         m_enabled;       ///< Enable state of the sensor
+    double       m_lastTimestamp; ///< Timestamp of the last sample returned by getSamples
 };
 
 } // namespace priv
@@ -91,32 +91,10 @@ bool SensorImpl::open(Sensor::Type sensor)
 
     // The sensor is disabled by default
     m_enabled = false;
+    m_lastTimestamp = 0;
 
-    // Set the refresh rate (use the maximum allowed)
-    static const NSTimeInterval updateInterval = 1. / 60.;
-    switch (sensor)
-    {
-        case Sensor::Accelerometer:
-            [SFAppDelegate getInstance].motionManager.accelerometerUpdateInterval = updateInterval;
-            break;
-
-        case Sensor::Gyroscope:
-            [SFAppDelegate getInstance].motionManager.gyroUpdateInterval = updateInterval;
-            break;
-
-        case Sensor::Magnetometer:
-            [SFAppDelegate getInstance].motionManager.magnetometerUpdateInterval = updateInterval;
-            break;
-
-        case Sensor::Gravity:
-        case Sensor::UserAcceleration:
-        case Sensor::Orientation:
-            [SFAppDelegate getInstance].motionManager.deviceMotionUpdateInterval = updateInterval;
-            break;
-
-        default:
-            break;
-    }
+    // Set the default refresh rate
+    setSamplingRate(seconds(1.f / 60.f), Time::Zero);
 
     return true;
 }
@@ -180,6 +158,78 @@ Vector3f SensorImpl::update()
 }
 
 
+////////////////////////////////////////////////////////////
+void SensorImpl::setSamplingRate(Time interval, Time /*maxLatency*/)
+{
+    // Core Motion has no control over the batching of the hardware
+    NSTimeInterval updateInterval = interval.asSeconds();
+    switch (m_sensor)
+    {
+        case Sensor::Accelerometer:
+            [SFAppDelegate getInstance].motionManager.accelerometerUpdateInterval = updateInterval;
+            break;
+
+        case Sensor::Gyroscope:
+            [SFAppDelegate getInstance].motionManager.gyroUpdateInterval = updateInterval;
+            break;
+
+        case Sensor::Magnetometer:
+            [SFAppDelegate getInstance].motionManager.magnetometerUpdateInterval = updateInterval;
+            break;
+
+        case Sensor::Gravity:
+        case Sensor::UserAcceleration:
+        case Sensor::Orientation:
+            [SFAppDelegate getInstance].motionManager.deviceMotionUpdateInterval = updateInterval;
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SensorImpl::getSamples(Vector3f* samples, std::size_t /*maxCount*/)
+{
+    // The motion manager only keeps the latest sample: return it if it's new
+    CMMotionManager* manager = [SFAppDelegate getInstance].motionManager;
+    CMLogItem* data = nil;
+
+    switch (m_sensor)
+    {
+        case Sensor::Accelerometer:
+            data = manager.accelerometerData;
+            break;
+
+        case Sensor::Gyroscope:
+            data = manager.gyroData;
+            break;
+
+        case Sensor::Magnetometer:
+            data = manager.magnetometerData;
+            break;
+
+        case Sensor::Gravity:
+        case Sensor::UserAcceleration:
+        case Sensor::Orientation:
+            data = manager.deviceMotion;
+            break;
+
+        default:
+            break;
+    }
+
+    if (!data || (data.timestamp == m_lastTimestamp))
+        return 0;
+
+    m_lastTimestamp = data.timestamp;
+    samples[0] = update();
+
+    return 1;
+}
+
+
 ////////////////////////////////////////////////////////////
 void SensorImpl::setEnabled(bool enabled)
 {
@@ -54,6 +54,14 @@ VideoMode VideoModeImpl::getDesktopMode()
     return VideoMode(bounds.size.width * backingScale, bounds.size.height * backingScale);
 }
 
+
+////////////////////////////////////////////////////////////
+unsigned int VideoModeImpl::getDesktopRefreshRate()
+{
+    // Displays of iOS devices always refresh at 60 Hz
+    return 60;
+}
+
 } // namespace priv
 
 } // namespace sf
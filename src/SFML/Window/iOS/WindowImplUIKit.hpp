@@ -172,6 +172,17 @@ public:
     ////////////////////////////////////////////////////////////
     virtual bool hasFocus() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the next refresh of the display
+    ///
+    /// \param refreshTime Filled with the time of the refresh, on the time line of getEventTime
+    /// \param deadline    Filled with the expected time of the next refresh
+    ///
+    /// \return True if the refresh was reported by the display link, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool waitForRefresh(Time& refreshTime, Time& deadline);
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -94,6 +94,7 @@ WindowImplUIKit::WindowImplUIKit(VideoMode mode,
 ////////////////////////////////////////////////////////////
 WindowImplUIKit::~WindowImplUIKit()
 {
+    [m_view invalidateDisplayLink];
 }
 
 
@@ -197,6 +198,25 @@ void WindowImplUIKit::requestFocus()
 }
 
 
+////////////////////////////////////////////////////////////
+bool WindowImplUIKit::waitForRefresh(Time& refreshTime, Time& deadline)
+{
+    CFTimeInterval refreshTimestamp;
+    CFTimeInterval deadlineTimestamp;
+    if (![m_view waitForRefresh:&refreshTimestamp deadline:&deadlineTimestamp])
+        return false;
+
+    // The timestamps are on the same clock as sf::Clock, only the origin differs
+    Time now = getEventTime();
+    CFTimeInterval current = CACurrentMediaTime();
+
+    refreshTime = now - seconds(static_cast<float>(current - refreshTimestamp));
+    deadline    = now + seconds(static_cast<float>(deadlineTimestamp - current));
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool WindowImplUIKit::hasFocus() const
 {